@@ -16,6 +16,7 @@
 
 #include <cuda_bf16.h>
 #include <cuda_fp16.h>
+#include <cuda_fp8.h>
 #include <dlpack/dlpack.h>
 #include <stdint.h>
 #include <tvm/runtime/logging.h>
@@ -168,6 +169,156 @@ static __global__ void oneShotAllReduceKernel(AllReduceParams params) {
   }
 }
 
+template <typename T>
+inline __device__ float toFloat(T v);
+
+template <>
+inline __device__ float toFloat<float>(float v) {
+  return v;
+}
+
+template <>
+inline __device__ float toFloat<half>(half v) {
+  return __half2float(v);
+}
+
+template <>
+inline __device__ float toFloat<__nv_bfloat16>(__nv_bfloat16 v) {
+  return __bfloat162float(v);
+}
+
+template <typename T>
+inline __device__ T fromFloat(float v);
+
+template <>
+inline __device__ float fromFloat<float>(float v) {
+  return v;
+}
+
+template <>
+inline __device__ half fromFloat<half>(float v) {
+  return __float2half_rn(v);
+}
+
+template <>
+inline __device__ __nv_bfloat16 fromFloat<__nv_bfloat16>(float v) {
+  return __float2bfloat16_rn(v);
+}
+
+template <>
+inline __device__ __nv_fp8_e4m3 fromFloat<__nv_fp8_e4m3>(float v) {
+  // The conversion saturates to the finite range of e4m3.
+  return __nv_fp8_e4m3(v);
+}
+
+// Sum a value over all the threads of the block. blockDim.x must be a multiple of WARP_SIZE.
+__inline__ __device__ float blockReduceSum(float val) {
+  __shared__ float shared[WARP_SIZE];
+  int const lane = threadIdx.x % WARP_SIZE;
+  int const wid = threadIdx.x / WARP_SIZE;
+#pragma unroll
+  for (int mask = WARP_SIZE / 2; mask > 0; mask >>= 1) {
+    val += __shfl_xor_sync(0xffffffff, val, mask);
+  }
+  if (lane == 0) {
+    shared[wid] = val;
+  }
+  __syncthreads();
+  // Every warp reduces the per-warp partial sums, so that all threads get the total.
+  val = lane < blockDim.x / WARP_SIZE ? shared[lane] : 0.f;
+#pragma unroll
+  for (int mask = WARP_SIZE / 2; mask > 0; mask >>= 1) {
+    val += __shfl_xor_sync(0xffffffff, val, mask);
+  }
+  // Make sure the shared buffer can be reused by the next call.
+  __syncthreads();
+  return val;
+}
+
+template <typename T, typename OutT, int RANKS_PER_NODE>
+static __global__ void oneShotAllReduceResidualRMSNormKernel(AllReduceParams params,
+                                                             AllReduceFusionParams fusion) {
+  int const bidx = blockIdx.x;
+  int const tidx = threadIdx.x;
+
+  // The number of elements packed into one for comms
+  static constexpr int NUM_ELTS = 16 / sizeof(T);
+
+  // Packed data type for comms
+  using PackedStruct = typename PackedOn16Bytes<T>::Type;
+
+  if (RANKS_PER_NODE > 1) {
+    multi_gpu_barrier(params.peer_barrier_ptrs_in, params.barrier_flag, params.local_rank,
+                      RANKS_PER_NODE, tidx, bidx);
+  }
+
+  // The source pointers. Distributed round-robin for the different warps.
+  T const* src_d[RANKS_PER_NODE];
+#pragma unroll
+  for (int ii = 0; ii < RANKS_PER_NODE; ++ii) {
+    int rank = (params.local_rank + ii) % RANKS_PER_NODE;
+    src_d[ii] = reinterpret_cast<T*>(params.peer_comm_buffer_ptrs[rank]);
+  }
+  T const* residual_in = reinterpret_cast<T const*>(fusion.residual_in);
+  T const* weight = reinterpret_cast<T const*>(fusion.weight);
+  T* residual_out = reinterpret_cast<T*>(fusion.residual_out);
+  OutT* out = reinterpret_cast<OutT*>(fusion.out);
+  float const inv_scale = fusion.scale == nullptr ? 1.f : 1.f / *fusion.scale;
+
+  // Each block normalizes whole rows, so that the sum of squares stays within the block.
+  size_t const num_rows = params.elts_total / fusion.hidden_size;
+  for (size_t row = bidx; row < num_rows; row += gridDim.x) {
+    size_t const row_offset = row * fusion.hidden_size;
+    float sum_sq = 0.f;
+    for (size_t col = tidx * NUM_ELTS; col < fusion.hidden_size; col += blockDim.x * NUM_ELTS) {
+      size_t const offset = row_offset + col;
+      // Iterate over the different ranks/devices on the node to load the values.
+      PackedStruct vals[RANKS_PER_NODE];
+#pragma unroll
+      for (int ii = 0; ii < RANKS_PER_NODE; ++ii) {
+        vals[ii].packed = *reinterpret_cast<int4 const*>(&src_d[ii][offset]);
+      }
+
+      // Sum the values from the different ranks and the residual.
+      PackedStruct sums;
+      sums.packed = {0, 0, 0, 0};
+#pragma unroll
+      for (int ii = 0; ii < RANKS_PER_NODE; ++ii) {
+        sums.packed = add128b(sums, vals[ii]);
+      }
+      PackedStruct residual;
+      residual.packed = *reinterpret_cast<int4 const*>(&residual_in[offset]);
+      sums.packed = add128b(sums, residual);
+      *reinterpret_cast<int4*>(&residual_out[offset]) = sums.packed;
+
+      T const* elts = reinterpret_cast<T const*>(&sums);
+#pragma unroll
+      for (int jj = 0; jj < NUM_ELTS; ++jj) {
+        float v = toFloat(elts[jj]);
+        sum_sq += v * v;
+      }
+    }
+
+    float const rms_rcp = rsqrtf(blockReduceSum(sum_sq) / fusion.hidden_size + fusion.eps);
+
+    // Each thread reads back exactly the elements it has written above.
+    for (size_t col = tidx * NUM_ELTS; col < fusion.hidden_size; col += blockDim.x * NUM_ELTS) {
+      size_t const offset = row_offset + col;
+      PackedStruct sums;
+      sums.packed = *reinterpret_cast<int4 const*>(&residual_out[offset]);
+      PackedStruct weights;
+      weights.packed = *reinterpret_cast<int4 const*>(&weight[col]);
+      T const* elts = reinterpret_cast<T const*>(&sums);
+      T const* w = reinterpret_cast<T const*>(&weights);
+#pragma unroll
+      for (int jj = 0; jj < NUM_ELTS; ++jj) {
+        out[offset + jj] =
+            fromFloat<OutT>(toFloat(elts[jj]) * rms_rcp * toFloat(w[jj]) * inv_scale);
+      }
+    }
+  }
+}
+
 template <typename T, int RANKS_PER_NODE>
 static __global__ void twoShotAllReduceKernel(AllReduceParams params) {
   // The block index.
@@ -393,4 +544,80 @@ void customAllReduce(AllReduceParams& params, void* data, size_t elts, DLDataTyp
   }
 }
 
+template <typename T, typename OutT>
+void invokeOneShotAllReduceResidualRMSNormKernel(AllReduceParams& param,
+                                                 AllReduceFusionParams& fusion,
+                                                 cudaStream_t stream) {
+  size_t elts_per_thread = 16 / sizeof(T);
+  ICHECK(fusion.hidden_size % elts_per_thread == 0);
+  ICHECK(param.elts_total % fusion.hidden_size == 0);
+
+  size_t const num_rows = param.elts_total / fusion.hidden_size;
+  size_t const threads_per_row = fusion.hidden_size / elts_per_thread;
+  int threads_per_block =
+      std::min(static_cast<int>(DEFAULT_BLOCK_SIZE),
+               static_cast<int>(WARP_SIZE * divUp(threads_per_row, WARP_SIZE)));
+  int blocks_per_grid =
+      std::min(static_cast<int>(MAX_ALL_REDUCE_BLOCKS), static_cast<int>(num_rows));
+  if (blocks_per_grid == 0) {
+    return;
+  }
+  switch (param.ranks_per_node) {
+    case 1:
+      oneShotAllReduceResidualRMSNormKernel<T, OutT, 1>
+          <<<blocks_per_grid, threads_per_block, 0, stream>>>(param, fusion);
+      break;
+    case 2:
+      oneShotAllReduceResidualRMSNormKernel<T, OutT, 2>
+          <<<blocks_per_grid, threads_per_block, 0, stream>>>(param, fusion);
+      break;
+    case 4:
+      oneShotAllReduceResidualRMSNormKernel<T, OutT, 4>
+          <<<blocks_per_grid, threads_per_block, 0, stream>>>(param, fusion);
+      break;
+    case 6:
+      oneShotAllReduceResidualRMSNormKernel<T, OutT, 6>
+          <<<blocks_per_grid, threads_per_block, 0, stream>>>(param, fusion);
+      break;
+    case 8:
+      oneShotAllReduceResidualRMSNormKernel<T, OutT, 8>
+          <<<blocks_per_grid, threads_per_block, 0, stream>>>(param, fusion);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported number of ranks for customAllReduceResidualRMSNorm: "
+                 << param.ranks_per_node;
+  }
+  auto last_error = cudaGetLastError();
+  if (last_error != cudaSuccess) {
+    LOG(INFO) << "cuda error:" << cudaGetErrorString(last_error);
+  }
+}
+
+template <typename T>
+void dispatchResidualRMSNormOutType(AllReduceParams& params, AllReduceFusionParams& fusion,
+                                    DLDataType outType, cudaStream_t stream) {
+  if (outType.code == kDLFloat8_e4m3fn && outType.bits == 8) {
+    invokeOneShotAllReduceResidualRMSNormKernel<T, __nv_fp8_e4m3>(params, fusion, stream);
+  } else {
+    invokeOneShotAllReduceResidualRMSNormKernel<T, T>(params, fusion, stream);
+  }
+}
+
+void customAllReduceResidualRMSNorm(AllReduceParams& params, AllReduceFusionParams& fusion,
+                                    size_t elts, DLDataType dataType, DLDataType outType,
+                                    cudaStream_t stream) {
+  params.local_output_buffer_ptr = fusion.residual_out;
+  params.elts_total = elts;
+
+  if (dataType.code == kDLFloat && dataType.bits == 32) {
+    dispatchResidualRMSNormOutType<float>(params, fusion, outType, stream);
+  } else if (dataType.code == kDLFloat && dataType.bits == 16) {
+    dispatchResidualRMSNormOutType<half>(params, fusion, outType, stream);
+  } else if (dataType.code == kDLBfloat && dataType.bits == 16) {
+    dispatchResidualRMSNormOutType<__nv_bfloat16>(params, fusion, outType, stream);
+  } else {
+    LOG(FATAL) << ("Unsupported dataType for customAllReduceResidualRMSNorm");
+  }
+}
+
 }  // namespace tensorrt_llm
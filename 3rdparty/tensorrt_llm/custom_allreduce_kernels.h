@@ -44,6 +44,20 @@ struct AllReduceParams {
   void* local_output_buffer_ptr;
 };
 
+// Parameters of the epilogue fused into the one-shot all-reduce:
+//   residual_out = allreduce(input) + residual_in
+//   out = quantize(rms_norm(residual_out) * weight), where quantize divides by *scale when the
+//   output is FP8 and is the identity otherwise.
+struct AllReduceFusionParams {
+  size_t hidden_size;
+  float eps;
+  void const* residual_in;
+  void const* weight;
+  float const* scale;
+  void* residual_out;
+  void* out;
+};
+
 inline size_t GetMaxRequiredWorkspaceSize(int world_size) {
   if (world_size <= 2) {
     return 16 * 1000 * 1000;
@@ -78,4 +92,10 @@ inline AllReduceStrategyType SelectImplementation(size_t message_size, int world
 void customAllReduce(AllReduceParams& params, void* data, size_t elts, DLDataType dataType,
                      AllReduceStrategyType strat, cudaStream_t stream);
 
+// One-shot all-reduce fused with residual add and RMSNorm. When params.ranks_per_node is 1,
+// params.peer_comm_buffer_ptrs[0] holds the already all-reduced input and only the epilogue runs.
+void customAllReduceResidualRMSNorm(AllReduceParams& params, AllReduceFusionParams& fusion,
+                                    size_t elts, DLDataType dataType, DLDataType outType,
+                                    cudaStream_t stream);
+
 }  // namespace tensorrt_llm
@@ -36,12 +36,15 @@ namespace {
 int mkdir(const char* path, int /* ignored */) { return _mkdir(path); }
 }  // namespace
 #endif
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "../../src/support/process_id.h"
 #include "../../src/support/utils.h"
 #include "rpc_env.h"
 
@@ -63,6 +66,28 @@ std::string GenerateUntarCommand(const std::string& tar_file, const std::string&
   return untar_cmd;
 }
 
+/*!
+ * \brief The path of an artifact in the cache, keyed by the hash of its content.
+ * \param cache_dir The directory of the artifact cache.
+ * \param hash The hex digest of the artifact content.
+ * \param file_name The file name of the artifact, whose extension selects the loader.
+ */
+std::string ArtifactCachePath(const std::string& cache_dir, const std::string& hash,
+                              const std::string& file_name) {
+  TVM_FFI_CHECK(!hash.empty() && hash.find_first_not_of("0123456789abcdef") == std::string::npos,
+                ValueError)
+      << "Invalid artifact hash: " << hash;
+  size_t last_slash = file_name.find_last_of("/\\");
+  std::string base_name =
+      last_slash == std::string::npos ? file_name : file_name.substr(last_slash + 1);
+  return cache_dir + "/" + hash + "-" + base_name;
+}
+
+bool FileExists(const std::string& path) {
+  struct stat statbuf;
+  return stat(path.c_str(), &statbuf) == 0;
+}
+
 }  // Anonymous namespace
 
 namespace tvm {
@@ -142,9 +167,51 @@ RPCEnv::RPCEnv(const std::string& wd) {
                              return os.str();
                            }));
 
+  // The artifact cache outlives the work path, which is cleaned up after each session.
+  if (const char* cache_dir = getenv("TVM_RPC_ARTIFACT_CACHE_DIR")) {
+    artifact_cache_dir_ = cache_dir;
+  } else {
+    artifact_cache_dir_ = base_ + "_artifacts";
+  }
+  mkdir(artifact_cache_dir_.c_str(), 0777);
+
+  ffi::Function::SetGlobal(
+      "tvm.rpc.server.artifact_cache_lookup",
+      ffi::Function::FromTyped([this](const std::string& hash, const std::string& file_name) {
+        std::string path = ArtifactCachePath(artifact_cache_dir_, hash, file_name);
+        return FileExists(path) ? path : std::string();
+      }));
+
+  ffi::Function::SetGlobal(
+      "tvm.rpc.server.artifact_cache_upload",
+      ffi::Function::FromTyped([this](const std::string& hash, const std::string& file_name,
+                                      const std::string& data) {
+        std::string path = ArtifactCachePath(artifact_cache_dir_, hash, file_name);
+        // Write to a private file first, so that a concurrent lookup never sees a partial file.
+        std::string tmp_path = path + "." + std::to_string(support::GetProcessId()) + ".part";
+        {
+          std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+          TVM_FFI_ICHECK(!fs.fail()) << "Cannot open " << tmp_path;
+          fs.write(data.data(), data.size());
+        }
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+          // Another session cached the same artifact first.
+          TVM_FFI_ICHECK(FileExists(path)) << "Cannot cache artifact " << path;
+          std::remove(tmp_path.c_str());
+        }
+        LOG(INFO) << "Cache artifact " << path;
+        return path;
+      }));
+
   ffi::Function::SetGlobal("tvm.rpc.server.load_module",
                            ffi::Function::FromTyped([this](const std::string& path) {
                              std::string file_name = this->GetPath(path);
+                             // Cached artifacts never change, so they are linked only once.
+                             std::string cache_prefix = artifact_cache_dir_ + "/";
+                             if (support::StartsWith(file_name, cache_prefix.c_str()) &&
+                                 FileExists(file_name + ".so")) {
+                               file_name += ".so";
+                             }
                              file_name = BuildSharedLibrary(file_name);
                              LOG(INFO) << "Load module from " << file_name << " ...";
                              return ffi::Module::LoadFromFile(file_name);
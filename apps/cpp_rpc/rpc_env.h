@@ -56,6 +56,10 @@ struct RPCEnv {
    * \brief Holds the environment path.
    */
   std::string base_;
+  /*!
+   * \brief Holds the directory of the artifact cache shared by the sessions.
+   */
+  std::string artifact_cache_dir_;
 };  // RPCEnv
 
 }  // namespace runtime
@@ -188,6 +188,12 @@ set(USE_OPENMP none)
 # Whether use contrib.random in runtime
 set(USE_RANDOM ON)
 
+# Whether to build the MetricCollector of the Linux perf event CPU counters, for profiling
+set(USE_PERF_EVENT OFF)
+
+# Whether to build with zstd, to load the tensor-cache shards compressed with zstd
+set(USE_ZSTD OFF)
+
 # Possible values:
 # - ON: enable cuDNN with CMake's auto search in CUDA directory
 # - OFF: disable cuDNN
@@ -298,6 +304,12 @@ set(TVM_FFI_BACKTRACE_ON_SEGFAULT ON)
 # predefined variables to specify the path to the GTest package if needed.
 set(USE_GTEST AUTO)
 
+# Whether to build the C++ runtime micro-benchmarks in tests/cpp/benchmark with Google Benchmark.
+# The package `benchmark` is required for CMake to succeed when it is ON. The benchmarks are
+# built by the `cppbenchmark` target, and the `cppbenchmark_json` target runs them and writes
+# the results to cppbenchmark.json in the build directory.
+set(USE_BENCHMARK OFF)
+
 # Enable using CUTLASS as a BYOC backend
 # Need to have USE_CUDA=ON
 set(USE_CUTLASS OFF)
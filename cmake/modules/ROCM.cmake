@@ -39,6 +39,10 @@ if(USE_ROCM)
     list(APPEND TVM_RUNTIME_LINKER_LIBS ${ROCM_HSA_LIBRARY})
   endif()
 
+  # Add HIP builtins to RelaxVM
+  tvm_file_glob(GLOB VM_ROCM_BUILTIN_SRC_CC src/runtime/vm/rocm/*.cc)
+  list(APPEND RUNTIME_SRCS ${VM_ROCM_BUILTIN_SRC_CC})
+
   if(USE_HIPBLAS)
     message(STATUS "Build with HIPBLAS support")
     tvm_file_glob(GLOB HIPBLAS_CONTRIB_SRC src/relax/backend/contrib/hipblas/*.cc)
@@ -0,0 +1,26 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+if(USE_ZSTD)
+  find_path(ZSTD_INCLUDE_DIR zstd.h REQUIRED)
+  find_library(ZSTD_LIBRARY zstd REQUIRED)
+  message(STATUS "Build with zstd for the compressed tensor-cache shards: ${ZSTD_LIBRARY}")
+  include_directories(SYSTEM ${ZSTD_INCLUDE_DIR})
+  set_source_files_properties(src/runtime/vm/tensor_cache_support.cc
+    PROPERTIES COMPILE_DEFINITIONS "TVM_ZSTD_ENABLED=1")
+  list(APPEND TVM_RUNTIME_LINKER_LIBS ${ZSTD_LIBRARY})
+endif(USE_ZSTD)
@@ -74,6 +74,11 @@ enum class ProofStrength : int {
    * \brief Prove using symbolic bound analysis
    */
   kSymbolicBound = 1,
+  /*!
+   * \brief Additionally bound the affine regions with Presburger sets in region analysis.
+   *  Behaves as kSymbolicBound when TVM is built without MLIR.
+   */
+  kPresburger = 2,
 };
 
 /*!
@@ -652,6 +657,7 @@ class TVM_DLL Analyzer {
   TransitiveComparisonAnalyzer transitive_comparisons;
   /*! \brief constructor */
   Analyzer();
+  ~Analyzer();
   /*!
    * \brief Mark the value as non-negative value globally in analyzer.
    *
@@ -784,6 +790,34 @@ class TVM_DLL Analyzer {
    * \note Analyzer will call into sub-analyzers to get the result.
    */
   PrimExpr Simplify(const PrimExpr& expr, int steps = 2);
+
+  /*!
+   * \brief Enable or disable the memo table of Simplify.
+   *
+   * When enabled, Simplify returns the result it already computed for the same expression
+   * object with the same steps under the same constraints, without running the simplifiers.
+   * The entries are keyed by the identity of the expression and the epoch of the innermost
+   * ConstraintContext, so the results of a constraint scope are not reused outside of it.
+   * Bind and MarkGlobalNonNegValue clear the table.
+   *
+   * \note The table is opt-in because the updates made directly to a sub-analyzer, such as
+   * `const_int_bound.Update`, are not visible to it. Call ClearSimplifyCache after them.
+   *
+   * \param enable Whether to enable the memo table.
+   */
+  void EnableSimplifyCache(bool enable = true);
+  /*! \brief Drop the entries of the memo table of Simplify. */
+  void ClearSimplifyCache();
+  /*! \brief Get the number of hits, misses and entries of the memo table of Simplify. */
+  ffi::Map<ffi::String, int64_t> GetSimplifyCacheStats() const;
+
+ private:
+  friend class ConstraintContext;
+  struct SimplifyCache;
+  /*! \brief Run the simplifiers, see Simplify. */
+  PrimExpr SimplifyImpl(const PrimExpr& expr, int steps);
+  /*! \brief The memo table of Simplify, only allocated when enabled. */
+  std::unique_ptr<SimplifyCache> simplify_cache_;
 };
 
 }  // namespace arith
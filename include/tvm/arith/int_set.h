@@ -37,6 +37,7 @@ using tir::Var;
 using tir::VarNode;
 
 class Analyzer;
+enum class ProofStrength : int;
 
 //-----------------------------------------------
 // Integer set data structure.
@@ -333,6 +334,24 @@ TVM_DLL ffi::Array<IntSet> EstimateRegionUpperBound(const ffi::Array<Range>& reg
                                                     const PrimExpr& predicate,
                                                     arith::Analyzer* analyzer);
 
+/*!
+ * \brief Analyze the region as EstimateRegionUpperBound, with the given proof strength.
+ *  With ProofStrength::kPresburger, the affine dimensions of the region are further tightened
+ *  with Presburger sets when TVM is built with MLIR, which accounts for the affine conjuncts of
+ *  the predicate that couple several variables.
+ * \param region The region to be analyzed
+ * \param var_dom The ranges of the variables
+ * \param predicate The predicate for the affine map
+ * \param analyzer The analyzer used
+ * \param strength The proof strength of the analysis
+ * \return an array of arith::IntSet as the result of analysis
+ */
+TVM_DLL ffi::Array<IntSet> EstimateRegionUpperBound(const ffi::Array<Range>& region,
+                                                    const ffi::Map<Var, Range>& var_dom,
+                                                    const PrimExpr& predicate,
+                                                    arith::Analyzer* analyzer,
+                                                    ProofStrength strength);
+
 }  // namespace arith
 }  // namespace tvm
 #endif  // TVM_ARITH_INT_SET_H_
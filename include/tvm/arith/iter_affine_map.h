@@ -308,6 +308,44 @@ IterMapResult DetectIterMap(const ffi::Array<PrimExpr>& indices,
                             IterMapLevel check_level, arith::Analyzer* analyzer,
                             bool simplify_trivial_iterators = true);
 
+/*!
+ * \brief Update an iter map after one of its input iterators is split into new loops.
+ *
+ * The marks of the split iterator are rewritten in terms of the new loops, instead of detecting
+ * the map again from the rewritten indices. A split of the iterator covered by a single new loop
+ * becomes a split of that loop, e.g. `i // 4` of `i = io * 4 + ii` becomes `io`.
+ *
+ * \param result The iter map detected by DetectIterMap.
+ * \param loop The split input iterator.
+ * \param new_loops The new loops, from the outermost one, with `loop = sum(new_loops[i] *
+ *        prod(new_extents[i+1:]))`. All loops start at zero.
+ * \param new_extents The extents of the new loops.
+ * \param analyzer Analyzer used to get context information.
+ *
+ * \return The updated result. When the split is not perfect, it has errors and empty indices,
+ * and DetectIterMap has to be called on the rewritten indices.
+ */
+IterMapResult UpdateIterMapForSplit(const IterMapResult& result, const Var& loop,
+                                    const ffi::Array<Var>& new_loops,
+                                    const ffi::Array<PrimExpr>& new_extents,
+                                    arith::Analyzer* analyzer);
+
+/*!
+ * \brief Update an iter map after some of its input iterators are fused into one loop.
+ *
+ * \param result The iter map detected by DetectIterMap.
+ * \param loops The fused input iterators, from the outermost one. All loops start at zero.
+ * \param extents The extents of the fused input iterators.
+ * \param fused The fused loop, with `loops[i] = fused // prod(extents[i+1:]) % extents[i]`.
+ * \param analyzer Analyzer used to get context information.
+ *
+ * \return The updated result. When the splits of an inner iterator do not tile it, it has errors
+ * and empty indices, and DetectIterMap has to be called on the rewritten indices.
+ */
+IterMapResult UpdateIterMapForFuse(const IterMapResult& result, const ffi::Array<Var>& loops,
+                                   const ffi::Array<PrimExpr>& extents, const Var& fused,
+                                   arith::Analyzer* analyzer);
+
 /*!
  * \brief Use IterVarMap detector to rewrite and simplify the indices
  *
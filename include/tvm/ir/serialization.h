@@ -29,6 +29,7 @@
 
 #include <tvm/ffi/extra/json.h>
 #include <tvm/ffi/extra/serialization.h>
+#include <tvm/ir/module.h>
 #include <tvm/runtime/base.h>
 
 #include <string>
@@ -51,5 +52,38 @@ TVM_DLL std::string SaveJSON(ffi::Any node);
  */
 TVM_DLL ffi::Any LoadJSON(std::string json_str);
 
+/*!
+ * \brief Save a module in the compact binary format.
+ *
+ * The binary holds a string table shared by all the nodes, the module without its functions,
+ * and an index of the functions, each serialized on its own so that it can be loaded without
+ * decoding the others. The values are varint encoded.
+ *
+ * \param mod The module to save.
+ * \return The binary representation of the module.
+ */
+TVM_DLL std::string SaveModuleBinary(const IRModule& mod);
+
+/*!
+ * \brief Load a module saved by SaveModuleBinary.
+ *
+ * \param data The binary representation of the module.
+ * \param function_names The names of the functions to load, all of them if not defined. The
+ *        references to the other functions are kept, but they are not in the returned module.
+ * \return The loaded module.
+ */
+TVM_DLL IRModule LoadModuleBinary(
+    const std::string& data,
+    ffi::Optional<ffi::Array<ffi::String>> function_names = std::nullopt);
+
+/*!
+ * \brief The names of the functions of a module saved by SaveModuleBinary, read from its
+ *  index without decoding the functions.
+ *
+ * \param data The binary representation of the module.
+ * \return The names of the functions, in the order of the module.
+ */
+TVM_DLL ffi::Array<ffi::String> ModuleBinaryFunctionNames(const std::string& data);
+
 }  // namespace tvm
 #endif  // TVM_IR_SERIALIZATION_H_
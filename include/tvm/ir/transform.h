@@ -65,6 +65,7 @@
 #include <tvm/ir/module.h>
 #include <tvm/support/with.h>
 
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -330,6 +331,15 @@ class PassInfoNode : public Object {
   /*! \brief The passes that are required to perform the current pass. */
   ffi::Array<ffi::String> required;
 
+  /*!
+   * \brief Whether the function-level pass can transform the functions of a module in parallel.
+   *
+   * A thread-safe pass only reads the module, guards the state it shares between the functions,
+   * and does not report through the diagnostic context. The worker threads enter the current
+   * PassContext and Target, but no other thread-local scope.
+   */
+  bool thread_safe{false};
+
   PassInfoNode() = default;
 
   static void RegisterReflection() {
@@ -338,7 +348,8 @@ class PassInfoNode : public Object {
         .def_ro("opt_level", &PassInfoNode::opt_level)
         .def_ro("name", &PassInfoNode::name)
         .def_ro("required", &PassInfoNode::required)
-        .def_ro("traceable", &PassInfoNode::traceable);
+        .def_ro("traceable", &PassInfoNode::traceable)
+        .def_ro("thread_safe", &PassInfoNode::thread_safe);
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("transform.PassInfo", PassInfoNode, Object);
 };
@@ -355,9 +366,10 @@ class PassInfo : public ObjectRef {
    * \param name Name of the pass.
    * \param required  The passes that are required to perform the current pass.
    * \param traceable Boolean that tells whether the pass is traceable.
+   * \param thread_safe Whether the function-level pass can run on functions in parallel.
    */
   TVM_DLL PassInfo(int opt_level, ffi::String name, ffi::Array<ffi::String> required,
-                   bool traceable);
+                   bool traceable, bool thread_safe = false);
 
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(PassInfo, ObjectRef, PassInfoNode);
 };
@@ -554,6 +566,23 @@ TVM_DLL Pass CreateModulePass(std::function<IRModule(IRModule, PassContext)> pas
 TVM_DLL Pass ApplyPassToFunction(Pass pass, ffi::String func_name_regex,
                                  bool error_if_no_function_matches_regex = false);
 
+/*!
+ * \brief Run a task for each function transformed by a function-level pass.
+ *
+ * The tasks run in parallel when the pass is thread-safe, with at most the number of threads of
+ * the "transform.num_function_pass_threads" config, by default the number of hardware threads.
+ * Each task is expected to write its result to its own slot, so that the caller merges the
+ * results in the order of the functions. If tasks fail, the error of the first failed function
+ * is rethrown after all the tasks finished.
+ *
+ * \param pass_info The information of the function-level pass.
+ * \param pass_ctx The pass context the pass runs in.
+ * \param num_functions The number of functions to transform.
+ * \param f The task transforming the function of the given index.
+ */
+TVM_DLL void ParallelForFunctions(const PassInfo& pass_info, const PassContext& pass_ctx,
+                                  int num_functions, const std::function<void(int)>& f);
+
 /*!
  * \brief A special trace pass that prints the header and IR to LOG(INFO).
  * \param header The header to be attached to the output.
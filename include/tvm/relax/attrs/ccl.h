@@ -66,6 +66,60 @@ struct AllGatherAttrs : public tvm::AttrsNodeReflAdapter<AllGatherAttrs> {
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.attrs.AllGatherAttrs", AllGatherAttrs, BaseAttrsNode);
 };  // struct AllGatherAttrs
 
+/*! \brief Attributes used in reduce-scatter operators */
+struct ReduceScatterAttrs : public tvm::AttrsNodeReflAdapter<ReduceScatterAttrs> {
+  ffi::String op_type;
+  int num_workers;
+  bool in_group;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<ReduceScatterAttrs>()
+        .def_ro("op_type", &ReduceScatterAttrs::op_type,
+                "The type of reduction operation to be applied to the input data.")
+        .def_ro("num_workers", &ReduceScatterAttrs::num_workers,
+                "The number of workers, also the number of parts the reduced buffer should be "
+                "chunked into.")
+        .def_ro("in_group", &ReduceScatterAttrs::in_group,
+                "Whether the reduce-scatter operation performs in group or globally or in group "
+                "as default.");
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.attrs.ReduceScatterAttrs", ReduceScatterAttrs,
+                                    BaseAttrsNode);
+};  // struct ReduceScatterAttrs
+
+/*! \brief Attributes used in all-to-all operators */
+struct AllToAllAttrs : public tvm::AttrsNodeReflAdapter<AllToAllAttrs> {
+  int num_workers;
+  bool in_group;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<AllToAllAttrs>()
+        .def_ro("num_workers", &AllToAllAttrs::num_workers,
+                "The number of workers, also the number of parts the given buffer should be "
+                "chunked into.")
+        .def_ro("in_group", &AllToAllAttrs::in_group,
+                "Whether the all-to-all operation performs in group or globally or in group as "
+                "default.");
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.attrs.AllToAllAttrs", AllToAllAttrs, BaseAttrsNode);
+};  // struct AllToAllAttrs
+
+/*! \brief Attributes used in ring exchange operators */
+struct RingSendRecvAttrs : public tvm::AttrsNodeReflAdapter<RingSendRecvAttrs> {
+  bool in_group;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<RingSendRecvAttrs>().def_ro(
+        "in_group", &RingSendRecvAttrs::in_group,
+        "Whether the ring is formed by the workers of the group or by all the workers.");
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.attrs.RingSendRecvAttrs", RingSendRecvAttrs,
+                                    BaseAttrsNode);
+};  // struct RingSendRecvAttrs
+
 /*! \brief Attributes used in scatter operators */
 struct ScatterCollectiveAttrs : public tvm::AttrsNodeReflAdapter<ScatterCollectiveAttrs> {
   int num_workers;
@@ -398,6 +398,41 @@ class AxisGroupGraph {
     }
   }
 
+  /*!
+   * \brief Get the axis groups, the connected components of the graph. A sharding spec added at
+   *        any axis of a group propagates to the whole group when no cut point stops it.
+   *
+   * \return The axes of each group
+   */
+  std::vector<std::vector<Axis>> GetAxisGroups() const {
+    std::vector<std::vector<Axis>> groups;
+    std::unordered_set<Axis, AxisHash> visited;
+    for (const auto& pr : graph_) {
+      if (visited.count(pr.first)) {
+        continue;
+      }
+      std::vector<Axis> group;
+      std::vector<Axis> stack{pr.first};
+      visited.insert(pr.first);
+      while (!stack.empty()) {
+        Axis axis = stack.back();
+        stack.pop_back();
+        group.push_back(axis);
+        auto it = graph_.find(axis);
+        if (it == graph_.end()) {
+          continue;
+        }
+        for (const auto& edge : it->second) {
+          if (visited.insert(edge.dst).second) {
+            stack.push_back(edge.dst);
+          }
+        }
+      }
+      groups.push_back(std::move(group));
+    }
+    return groups;
+  }
+
  private:
   void AddEdge(Axis src, Axis dst, EdgeType type) {
     if (!graph_.count(src)) {
@@ -26,6 +26,7 @@
 
 #include <tvm/ir/transform.h>
 #include <tvm/relax/dataflow_pattern.h>
+#include <tvm/relax/distributed/global_info.h>
 #include <tvm/relax/expr.h>
 #include <tvm/relax/transform.h>
 #include <tvm/tir/function.h>
@@ -46,9 +47,14 @@ using tvm::transform::CreateModulePass;
 /*!
  * \brief Propagate sharding information.
  *
+ * \param auto_sharding_mesh When defined, the functions without sharding annotation are sharded
+ *        over this device mesh too, by the plan of minimum estimated cost that a search finds.
+ * \param memory_budget The memory, in bytes, that the search tries to keep the parameters and the
+ *        largest intermediate tensor of a function under on each device. 0 means no budget.
  * \return The Pass.
  */
-TVM_DLL Pass PropagateSharding();
+TVM_DLL Pass PropagateSharding(ffi::Optional<DeviceMesh> auto_sharding_mesh = std::nullopt,
+                               int64_t memory_budget = 0);
 
 /*!
  * \brief Lower global view TensorIR into local view.
@@ -57,6 +63,15 @@ TVM_DLL Pass PropagateSharding();
  */
 TVM_DLL Pass LowerGlobalViewToLocalView();
 
+/*!
+ * \brief Merge and simplify the redistributions of DistIR: merge chains of redistribute, cancel
+ *        the redistributes to the placement a tensor already has, sink the gathers past the
+ *        elementwise ops, and fuse an allreduce with the slice that follows it into reduce-scatter.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass SimplifyRedistribute();
+
 /*!
  * \brief Legalize redistribute op to ccl op.
  *
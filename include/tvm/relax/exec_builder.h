@@ -133,6 +133,20 @@ class ExecBuilderNode : public Object {
    * \param scope The memory scope.
    */
   void SaveMemoryScope(vm::Instruction::Arg idx, ffi::String scope);
+  /*!
+   * \brief Annotate the instructions emitted since `begin` with the Relax binding they compute.
+   *  The instructions annotated already, e.g. by the bindings nested in them, keep their names.
+   * \param begin The index of the first instruction to annotate.
+   * \param name The name of the binding.
+   */
+  void AnnotateInstrs(vm::Index begin, const std::string& name);
+  /*!
+   * \brief Record the estimated costs of a call of a PrimFunc, for the profiler.
+   * \param func_name The name of the PrimFunc.
+   * \param flops The estimated FLOPs.
+   * \param nbytes The estimated DRAM bytes.
+   */
+  void SetKernelCost(const std::string& func_name, double flops, double nbytes);
   /*!
    * \brief Raw access to underlying executable build in progress.
    */
@@ -51,12 +51,15 @@ using LayoutCb = ffi::TypedFunction<ffi::Map<ffi::String, ffi::Array<ffi::String
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
  * \param traceable Boolean variable whether the dataflowblock pass is traceable.
+ * \param thread_safe Whether pass_func may run on several functions of a module in parallel,
+ *        see PassInfoNode::thread_safe.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreateFunctionPass(std::function<Function(Function, IRModule, PassContext)> pass_func,
                                 int opt_level, ffi::String name,
-                                tvm::ffi::Array<ffi::String> required, bool traceable = false);
+                                tvm::ffi::Array<ffi::String> required, bool traceable = false,
+                                bool thread_safe = false);
 
 /*!
  * \brief Create a dataflowblock pass.
@@ -121,6 +124,17 @@ TVM_DLL Pass CallTIRRewrite();
  */
 TVM_DLL Pass RewriteDataflowReshape();
 
+/*!
+ * \brief Convert the call_tir that copy a contiguous range of their input to relax.memory.view
+ * calls, when their binding vars are DataflowVars. Here the copies include the strided_slice with
+ * unit strides whose outer axes have a single index, and the split along such an axis.
+ *
+ * \return The Pass.
+ * \note The views whose byte offset is not a multiple of the allocation alignment are not
+ * created, since the kernels taking them would need a copy to an offset of zero.
+ */
+TVM_DLL Pass RewriteDataflowSlice();
+
 /*!
  * \brief The static memory planning pass on BindingBlock level.
  * The pass will reuse allocated memory to its best effort, in order to
@@ -353,6 +367,12 @@ TVM_DLL Pass AnnotateTIROpPattern();
  * function being manipulated into function calls to the new grouped function.
  *
  * A follow-up pass named "FuseTIR" will generate a TIR PrimFunc for each grouped function.
+ *
+ * The pattern rules may be overridden by a function set as the "relax.FuseOps.fusion_policy"
+ * config of the pass context, e.g. to query a cost model. It is called with the module, the
+ * value of the binding to fuse and the value of the binding it would be fused into, and returns
+ * whether to fuse them, or None to leave the decision to the rules.
+ *
  * \param fuse_opt_level The level of fuse optimization.
  *        -1 indicates that the level will be inferred from pass context.
  * \return The Pass.
@@ -512,6 +532,38 @@ TVM_DLL Pass Gradient(ffi::String func_name,
                       ffi::Optional<ffi::Array<Var>> require_grads = std::nullopt,
                       int target_index = 0);
 
+/*!
+ * \brief Recompute cheap tensors near their late uses instead of keeping them alive, to lower
+ * the peak memory of training graphs produced by the Gradient pass.
+ *
+ * Only the results of `R.call_tir` of PrimFuncs whose "op_pattern" is at most injective are
+ * recomputed, and only when the inputs of the recomputation are still alive at its site.
+ *
+ * \param memory_budget The number of bytes of live tensors in a binding block to fit within,
+ * or -1 to lower the peak as much as possible.
+ * \return The Pass.
+ *
+ * \note The pass expects AnnotateTIROpPattern to have been applied, and is to be run before
+ * StaticPlanBlockMemory.
+ */
+TVM_DLL Pass Rematerialize(int64_t memory_budget = -1);
+
+/*!
+ * \brief Group the independent small kernels of each dataflow block, so that FuseTIR merges each
+ * group into a single PrimFunc launch.
+ *
+ * Kernels are `R.call_tir` of PrimFuncs whose "op_pattern" is at most a reduction. Kernels at the
+ * same dependency depth in the block, with the same kind of pattern, output rank and dtype, are
+ * grouped.
+ *
+ * \param max_group_size The maximum number of kernels in a group.
+ * \return The Pass.
+ *
+ * \note The pass expects AnnotateTIROpPattern to have been applied, and is usually run after
+ * FuseOps and before FuseTIR.
+ */
+TVM_DLL Pass HorizontalFuseOps(int max_group_size = 8);
+
 /*!
  * \brief Apply pattern matching to each function in the given module, and group matched
  * expressions into a new function. The end result is similar to FuseOps, but fusion is driven
@@ -614,6 +666,22 @@ TVM_DLL Pass AlterOpImpl(
 TVM_DLL Pass ConvertLayout(ffi::Map<ffi::String, ffi::Array<ffi::String>> desired_layouts,
                            LayoutCb layout_cb);
 
+/*!
+ * \brief Layout conversion pass that selects the layout of each op among candidates by cost.
+ * \param candidate_layouts The candidate layouts of some operators, each in the format of the
+ * desired layouts of ConvertLayout, ranked by preference.
+ * \param op_cost The cost of an op call in a candidate layout. If not defined, the k-th candidate
+ * costs k times the number of elements of the output.
+ * \param fold_constants Whether to fold the layout transforms of constants.
+ * \return The Pass.
+ * \note The layouts minimize the cost of the ops plus the number of elements moved by the layout
+ * transforms of non-constant tensors, searched by coordinate descent. Operates only on dataflow
+ * blocks. ConvertToDataflow may need to be called first.
+ */
+TVM_DLL Pass AutoConvertLayout(
+    ffi::Map<ffi::String, ffi::Array<ffi::Array<ffi::String>>> candidate_layouts,
+    ffi::Optional<ffi::Function> op_cost = std::nullopt, bool fold_constants = true);
+
 /*!
  * \brief A pass that converts consecutive dataflow operations
  *   inside binding blocks into dataflow blocks.
@@ -646,7 +714,8 @@ TVM_DLL Pass DeadCodeElimination(ffi::Array<ffi::String> entry_functions = {});
  * (generally, these are elementwise operations) in dataflow blocks into in-place implementations.
  * Supported operators will be replaced by calls to `call_tir_inplace` that invoke in-place
  * PrimFunc implementations of those operators (which are based on the legalizations of those
- * operators).
+ * operators). The calls to `call_tir` of a PrimFunc that can write its output to one of its inputs,
+ * e.g. a fused elementwise function, are made in-place as well.
  * \note ConvertToDataflow may need to be called first to provide dataflow blocks.
  * \return The pass.
  */
@@ -658,13 +727,19 @@ TVM_DLL Pass DataflowUseInplaceCalls();
  * \param out_dtype The output data type of gemm/conv, which is the data type of the accumulator.
  * \param fp16_input_names The names of function parameters whose dtype should become fp16. The
  * function signature would change accordingly.
+ * \param op_policy The policy of each op to override, by op name, which is one of "always",
+ * "follow" and "never".
+ * \param fp32_bindings The names of the vars bound to the op calls to keep in their original
+ * precision, e.g. the ops that a calibration run finds too inaccurate in fp16.
  * \return The Pass.
  *
  * \note Mainly operates within dataflow blocks. ConvertToDataflow may need to be called first.
  */
 TVM_DLL Pass
 ToMixedPrecision(const DataType& out_dtype,
-                 ffi::Optional<ffi::Array<ffi::String>> fp16_input_names = std::nullopt);
+                 ffi::Optional<ffi::Array<ffi::String>> fp16_input_names = std::nullopt,
+                 ffi::Optional<ffi::Map<ffi::String, ffi::String>> op_policy = std::nullopt,
+                 ffi::Optional<ffi::Array<ffi::String>> fp32_bindings = std::nullopt);
 
 /*!
  * \brief Rewrite a Relax module for executing with CUDA graph. This pass identifies
@@ -673,6 +748,23 @@ ToMixedPrecision(const DataType& out_dtype,
  */
 TVM_DLL Pass RewriteCUDAGraph();
 
+/*!
+ * \brief Run the independent kernels of the lowered functions on several streams, with events
+ *  for the dependencies across the streams. The pass runs after memory planning, and is enabled
+ *  by the pass config "relax.backend.max_num_streams" greater than 1.
+ * \return The Pass.
+ */
+TVM_DLL Pass AssignStreams();
+
+/*!
+ * \brief Place the intermediate storages of the lowered functions in the VTCM of Hexagon, so that
+ *  the tensors passed between the kernels stay in VTCM rather than going through DDR. The pass
+ *  runs after memory planning, and is enabled by the "vtcm-capacity" of the Hexagon target, or
+ *  the pass config "tir.vtcm_capacity".
+ * \return The Pass.
+ */
+TVM_DLL Pass PlanVTCMStorage();
+
 /*!
  * \brief The pass is designed for few shot tuning for static shape PrimFuncs. It examines all the
  *  blocks within the PrimFunc and conducts loop fusion, splitting, and other transformations based
@@ -692,6 +784,19 @@ TVM_DLL Pass FewShotTuning(int valid_count, bool benchmark);
  */
 TVM_DLL Pass SpecializePrimFuncBasedOnCallSite();
 
+/*!
+ * \brief Specialize the symbolic shapes of the PrimFuncs called by call_tir to the constant
+ * shapes of the call sites.
+ *
+ * The shapes that become constant after e.g. BindParams or LiftTransformParams stay symbolic
+ * in the PrimFuncs, which keeps them from being vectorized and partitioned statically. This
+ * pass clones a specialized PrimFunc for each distinct set of constants passed to it, and
+ * removes the original PrimFunc if it is no longer used and not externally visible.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass SpecializePrimFuncShapes();
+
 }  // namespace transform
 }  // namespace relax
 }  // namespace tvm
@@ -34,6 +34,39 @@ TVM_DLL float __gnu_h2f_ieee(uint16_t);
 TVM_DLL uint16_t __truncsfhf2(float v);
 TVM_DLL uint16_t __truncdfhf2(double v);
 TVM_DLL float __extendhfsf2(uint16_t v);
+
+/*!
+ * \brief Convert n floats to fp16, with the F16C or NEON instructions when the CPU has them.
+ * \param src The source floats.
+ * \param dst The destination fp16 values.
+ * \param n The number of elements.
+ */
+TVM_DLL void TVMConvertFloatToHalf(const float* src, uint16_t* dst, int64_t n);
+
+/*!
+ * \brief Convert n fp16 values to floats, with the F16C or NEON instructions when the CPU has
+ *  them.
+ * \param src The source fp16 values.
+ * \param dst The destination floats.
+ * \param n The number of elements.
+ */
+TVM_DLL void TVMConvertHalfToFloat(const uint16_t* src, float* dst, int64_t n);
+
+/*!
+ * \brief Convert n floats to bf16, rounding to the nearest even.
+ * \param src The source floats.
+ * \param dst The destination bf16 values.
+ * \param n The number of elements.
+ */
+TVM_DLL void TVMConvertFloatToBFloat16(const float* src, uint16_t* dst, int64_t n);
+
+/*!
+ * \brief Convert n bf16 values to floats.
+ * \param src The source bf16 values.
+ * \param dst The destination floats.
+ * \param n The number of elements.
+ */
+TVM_DLL void TVMConvertBFloat16ToFloat(const uint16_t* src, float* dst, int64_t n);
 }
 
 #endif  // TVM_RUNTIME_BUILTIN_FP16_H_
@@ -108,6 +108,24 @@ typedef int (*FTVMParallelLambda)(int task_id, TVMParallelGroupEnv* penv, void*
  */
 TVM_DLL int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task);
 
+/*!
+ * \brief Backend function for running parallel jobs with dynamic load balancing.
+ *
+ *  The iteration space is split into num_chunk chunks. flambda is invoked once per chunk
+ *  with task_id in [0, num_chunk) and penv->num_task equal to the number of chunks, and
+ *  workers that finish early keep claiming the unprocessed chunks. Chunks may execute
+ *  in any order, so TVMBackendParallelBarrier cannot be used inside flambda.
+ *
+ * \param flambda The parallel function to be launched.
+ * \param cdata The closure data.
+ * \param num_chunk Number of chunks to split the job into, can be 0, means a multiple
+ *           of the number of available threads.
+ *
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendParallelLaunchChunked(FTVMParallelLambda flambda, void* cdata,
+                                            int num_chunk);
+
 /*!
  * \brief BSP barrrier between parallel threads
  * \param task_id the task id of the function.
@@ -35,6 +35,11 @@
  * can be NULL, which indicates the default one.
  */
 typedef void* TVMStreamHandle;
+/*!
+ * \brief The event that marks a point of the work submitted to a stream, created by
+ * DeviceAPI::CreateEvent.
+ */
+typedef void* TVMEventHandle;
 
 namespace tvm {
 
@@ -245,6 +250,46 @@ class TVM_DLL DeviceAPI {
    * \param event_dst The destination stream to synchronize.
    */
   virtual void SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst);
+  /*!
+   * \brief Create an event, which marks a point of the work of a stream once recorded.
+   *
+   * The events let the work of one stream, or the host, wait for a point of the work of
+   * another stream without waiting for the work submitted after it, e.g. a copy waiting for the
+   * kernel that produces its source while the next kernels run. The default implementation
+   * records the stream only, and waits for all the work of the stream instead.
+   *
+   * \param dev The device of the event.
+   * \return The created event.
+   */
+  virtual TVMEventHandle CreateEvent(Device dev);
+  /*!
+   * \brief Free an event.
+   * \param dev The device of the event.
+   * \param event The event to be freed.
+   */
+  virtual void FreeEvent(Device dev, TVMEventHandle event);
+  /*!
+   * \brief Record an event at the end of the work submitted to a stream so far. Recording an event
+   * again moves it to the new point.
+   * \param dev The device of the stream.
+   * \param event The event to record.
+   * \param stream The stream to record the event in.
+   */
+  virtual void RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream);
+  /*!
+   * \brief Make the work submitted to a stream from now on wait for an event, without blocking
+   * the host.
+   * \param dev The device of the stream.
+   * \param stream The stream that waits.
+   * \param event The recorded event to wait for.
+   */
+  virtual void StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event);
+  /*!
+   * \brief Block the host until the work before an event is done.
+   * \param dev The device of the event.
+   * \param event The recorded event to wait for.
+   */
+  virtual void EventSync(Device dev, TVMEventHandle event);
   /*!
    * \brief Allocate temporal workspace for backend execution.
    *
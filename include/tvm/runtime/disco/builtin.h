@@ -86,6 +86,82 @@ TVM_DLL void AllReduce(Tensor send, ReduceKind reduce_kind, bool in_group, Tenso
  * \param recv The array receives the outcome of allgather
  */
 TVM_DLL void AllGather(Tensor send, bool in_group, Tensor recv);
+/*!
+ * \brief Launch an allreduce operation on the dedicated communication stream of the worker,
+ * so that independent computation on the default stream can overlap with it.
+ * The collective is ordered after the work enqueued so far on the default stream,
+ * and `recv` must not be read before the returned handle is waited via `WaitCollective`.
+ * \param send The array send to perform allreduce on
+ * \param reduce_kind The kind of reduction operation (e.g. sum, avg, min, max)
+ * \param in_group Whether the allreduce operation performs globally or in group as default.
+ * \param recv The array receives the outcome of allreduce
+ * \return The handle of the asynchronous collective
+ */
+TVM_DLL int64_t AllReduceAsync(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv);
+/*!
+ * \brief Launch an allgather operation on the dedicated communication stream of the worker.
+ * The semantics of ordering are the same as `AllReduceAsync`.
+ * \param send The array send to perform allgather on
+ * \param in_group Whether the allgather operation performs globally or in group as default.
+ * \param recv The array receives the outcome of allgather
+ * \return The handle of the asynchronous collective
+ */
+TVM_DLL int64_t AllGatherAsync(Tensor send, bool in_group, Tensor recv);
+/*!
+ * \brief Make the default stream wait for an asynchronous collective. It does not block the host.
+ * \param handle The handle returned by the asynchronous collective, which can be waited only once
+ */
+TVM_DLL void WaitCollective(int64_t handle);
+/*!
+ * \brief Perform a reduce-scatter operation using the underlying communication library.
+ * The reduced outcome is chunked into equal parts, and each worker receives one of them.
+ * \param send The array send to perform reduce-scatter on
+ * \param reduce_kind The kind of reduction operation (e.g. sum, avg, min, max)
+ * \param in_group Whether the reduce-scatter operation performs globally or in group as default.
+ * \param recv The array receives the shard of the reduced outcome, whose size must be the size
+ * of `send` divided by the number of workers
+ */
+TVM_DLL void ReduceScatter(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv);
+/*!
+ * \brief Perform an all-to-all operation using the underlying communication library.
+ * Worker i sends its j-th chunk of `send` to worker j, which stores it as its i-th chunk of `recv`.
+ * \param send The array to be exchanged
+ * \param send_splits The number of rows (along axis 0) of `send` sent to each worker.
+ * If empty, `send` is chunked into equal parts.
+ * \param recv_splits The number of rows (along axis 0) of `recv` received from each worker.
+ * It must be empty if and only if `send_splits` is empty.
+ * \param in_group Whether the all-to-all operation performs globally or in group as default.
+ * \param recv The array receives the outcome of all-to-all
+ */
+TVM_DLL void AllToAll(Tensor send, ffi::Shape send_splits, ffi::Shape recv_splits, bool in_group,
+                      Tensor recv);
+/*!
+ * \brief Perform a step of a ring exchange: each worker sends `send` to the next worker of the
+ * ring, and receives `recv` from the previous one.
+ * \param send The array sent to the next worker
+ * \param in_group Whether the ring is formed by the workers of the group or by all the workers.
+ * \param recv The array receives the one sent by the previous worker
+ */
+TVM_DLL void RingSendRecv(Tensor send, bool in_group, Tensor recv);
+/*!
+ * \brief Launch a step of a ring exchange on the dedicated communication stream of the worker.
+ * The semantics of ordering are the same as `AllReduceAsync`.
+ * \param send The array sent to the next worker
+ * \param in_group Whether the ring is formed by the workers of the group or by all the workers.
+ * \param recv The array receives the one sent by the previous worker
+ * \return The handle of the asynchronous collective
+ */
+TVM_DLL int64_t RingSendRecvAsync(Tensor send, bool in_group, Tensor recv);
+/*!
+ * \brief Wait for the ring exchange launched from `send` to `recv` by `RingSendRecvAsync`, and
+ * copy `recv` to `out`. It lets compiled code, which has no handle, order the wait after the
+ * computation it overlaps with, by passing the result of that computation as `after`.
+ * \param send The array sent by the ring exchange
+ * \param recv The array received by the ring exchange
+ * \param after An array the wait is ordered after, otherwise unused
+ * \param out The array receives a copy of `recv`
+ */
+TVM_DLL void RingSendRecvWait(Tensor send, Tensor recv, Tensor after, Tensor out);
 /*!
  * \brief Perform a broadcast operation from worker-0
  * \param send The buffer to be broadcasted
@@ -146,6 +222,28 @@ TVM_DLL int WorkerId();
  * cudaStreamSynchronize is complete.
  */
 TVM_DLL void SyncWorker();
+/*!
+ * \brief Run micro-batches through pipeline stages, where each worker group is a stage.
+ * At tick `t`, stage `s` runs micro-batch `t - s` and sends its output to the next stage,
+ * so that all stages are busy once the pipeline is filled.
+ * \param mod The module containing the stage functions.
+ * \param stage_funcs The name of the function of each stage. A stage function takes the
+ * activation of a micro-batch and returns the activation passed to the next stage.
+ * \param num_micro_batches The number of micro-batches.
+ * \param input The input split along axis 0 into micro-batches. Only used by the first stage.
+ * \param activation_shape The shape of the activation received by the stages except the first.
+ * \param activation_dtype The dtype of the activation received by the stages except the first.
+ * \param output The output split along axis 0 into micro-batches. Only used by the last stage.
+ * \param measure_time Whether to measure the compute and communication time, which
+ * synchronizes the device around each step.
+ * \return The statistics of the current worker as
+ * `(num_ticks, busy_ticks, compute_us, comm_us)`, where the bubble ratio of the stage is
+ * `1 - busy_ticks / num_ticks`.
+ */
+TVM_DLL ffi::Shape PipelineForward(ffi::Module mod, ffi::Array<ffi::String> stage_funcs,
+                                   int64_t num_micro_batches, ffi::Optional<Tensor> input,
+                                   ffi::Shape activation_shape, DataType activation_dtype,
+                                   ffi::Optional<Tensor> output, bool measure_time);
 
 }  // namespace runtime
 }  // namespace tvm
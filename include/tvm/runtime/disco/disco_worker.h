@@ -55,6 +55,7 @@ class DiscoWorker {
         local_worker_id(worker_id),
         num_workers(num_workers),
         num_groups(num_groups),
+        num_workers_per_node(num_workers),
         default_device(Device{DLDeviceType::kDLCPU, 0}),
         worker_zero_data(worker_zero_data),
         channel(channel),
@@ -76,6 +77,12 @@ class DiscoWorker {
   int num_workers;
   /*! \brief Total number of workers */
   int num_groups;
+  /*!
+   * \brief The number of workers on each node. It equals `num_workers` unless the session
+   * spans multiple nodes, where workers `[i * num_workers_per_node, (i + 1) *
+   * num_workers_per_node)` are on node `i`.
+   */
+  int num_workers_per_node;
   /*! \brief The default device to allocate data if not specified */
   Device default_device;
   /*! \brief The name of the underlying collective communication library. */
@@ -99,6 +99,7 @@ enum class DiscoAction : int32_t {
   kCopyToWorker0 = 6,
   kDebugGetFromRemote = 7,
   kDebugSetRegister = 8,
+  kCallBatch = 9,
 };
 
 /*! \brief Converts the enum class `DiscoAction` to string */
@@ -122,6 +123,8 @@ inline std::string DiscoAction2String(DiscoAction action) {
       return "kDebugGetFromRemote";
     case DiscoAction::kDebugSetRegister:
       return "kDebugSetRegister";
+    case DiscoAction::kCallBatch:
+      return "kCallBatch";
   }
   TVM_FFI_THROW(ValueError) << "Unknown DiscoAction: " << static_cast<int>(action);
 }
@@ -253,6 +256,19 @@ class SessionObj : public Object {
    * \param worker_id The id of the worker to be set.
    */
   TVM_DLL virtual void DebugSetRegister(int64_t reg_id, ffi::AnyView value, int worker_id) = 0;
+  /*!
+   * \brief Start recording a batch of commands. Until `SubmitBatch` is called, the commands
+   * issued to the session are recorded instead of being sent to the workers, and the returned
+   * DRefs can be used as arguments of later commands in the same batch.
+   * \note Commands that wait for a reply from workers, such as `SyncWorker`, cannot be issued
+   * while a batch is being recorded.
+   */
+  TVM_DLL virtual void BeginBatch() = 0;
+  /*!
+   * \brief Send the recorded batch of commands to the workers as a single message, where the
+   * workers execute the commands in the order they were recorded.
+   */
+  TVM_DLL virtual void SubmitBatch() = 0;
 
   struct FFI;
   friend struct SessionObj::FFI;
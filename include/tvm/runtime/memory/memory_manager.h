@@ -33,6 +33,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -42,6 +43,9 @@ namespace memory {
 enum AllocatorType {
   kNaive = 1,
   kPooled,
+  kPooledBestFit,
+  /*! \brief Stream-ordered allocation, only available on devices that support it (CUDA). */
+  kStreamOrdered,
 };
 
 struct Buffer {
@@ -55,6 +59,20 @@ struct Buffer {
   AllocatorType alloc_type;
 };
 
+/*! \brief Runtime statistics of an allocator. */
+struct AllocatorStats {
+  /*! \brief Allocations served from the calling thread's cache. */
+  int64_t thread_cache_hits{0};
+  /*! \brief Allocations that missed the calling thread's cache. */
+  int64_t thread_cache_misses{0};
+  /*! \brief Allocations served from the shared pool. */
+  int64_t pool_hits{0};
+  /*! \brief Allocations served by taking a buffer cached by another thread. */
+  int64_t thread_cache_steals{0};
+  /*! \brief Allocations that went to the device. */
+  int64_t device_allocs{0};
+};
+
 class Allocator {
  public:
   explicit Allocator(AllocatorType type) : type_(type) {}
@@ -117,6 +135,14 @@ class Allocator {
    *  \return The amount of memory currently allocated.
    */
   TVM_DLL virtual size_t UsedMemory() const = 0;
+  /*! \brief The runtime statistics of the allocator.
+   *  \return The statistics, all zero if the allocator does not track them.
+   */
+  TVM_DLL virtual AllocatorStats GetStats() const { return AllocatorStats(); }
+  /*! \brief The blocks held from the device but not in use, available for reuse.
+   *  \return Pairs of (block size, number of cached blocks of that size).
+   */
+  TVM_DLL virtual std::vector<std::pair<size_t, size_t>> CachedBlocks() const { return {}; }
 
  protected:
   /*! \brief Check if the given memory scope is allowed to allocate by the allocator. */
@@ -143,8 +169,43 @@ class MemoryManager {
    * \return The memory allocator.
    */
   TVM_DLL static Allocator* GetAllocator(Device dev, AllocatorType type);
+  /*!
+   * \brief Get the statistics of an allocator.
+   * \param dev The TVM device
+   * \param type The allocator type
+   * \return The statistics of the allocator.
+   */
+  TVM_DLL static AllocatorStats GetStats(Device dev, AllocatorType type);
   /*! \brief Clear the allocators. */
   static void Clear();
+  /*!
+   * \brief Enable or disable the tracking of live allocations.
+   * \note Only buffers handed out via Storage and Allocator::Empty are tracked.
+   * \param enable Whether to track.
+   */
+  TVM_DLL static void SetAllocationTracking(bool enable);
+  /*! \brief Whether live allocations are tracked. */
+  TVM_DLL static bool AllocationTrackingEnabled();
+  /*!
+   * \brief Record a buffer handed out to a user, attributed to the current AllocationTagScope.
+   * \param buffer The buffer.
+   */
+  TVM_DLL static void TrackAlloc(const Buffer& buffer);
+  /*!
+   * \brief Record that a tracked buffer is released. No-op for untracked buffers.
+   * \param buffer The buffer.
+   */
+  TVM_DLL static void TrackFree(const Buffer& buffer);
+  /*!
+   * \brief Generate a memory report of all allocators.
+   *
+   * For each device the report contains the bytes held by each allocator, the
+   * cached bytes and their size histogram, the bytes in use and its peak, and
+   * the live bytes per allocation call site when tracking is enabled.
+   *
+   * \return The report in JSON format.
+   */
+  TVM_DLL static std::string MemoryReport();
 
  private:
   MemoryManager() {}
@@ -155,6 +216,21 @@ class MemoryManager {
       allocators_;
 };
 
+/*!
+ * \brief RAII scope that attributes the tracked allocations of the current thread to a call site.
+ * \sa MemoryManager::SetAllocationTracking
+ */
+class AllocationTagScope {
+ public:
+  TVM_DLL explicit AllocationTagScope(std::string tag);
+  TVM_DLL ~AllocationTagScope();
+  /*! \brief The tag of the innermost scope on this thread, empty if none. */
+  TVM_DLL static const std::string& Current();
+
+ private:
+  std::string prev_;
+};
+
 /*! \brief An object representing a storage allocation. */
 class StorageObj : public Object {
  public:
@@ -172,6 +248,7 @@ class StorageObj : public Object {
 
   ~StorageObj() {
     if (allocator) {
+      MemoryManager::TrackFree(buffer);
       allocator->Free(buffer);
     }
   }
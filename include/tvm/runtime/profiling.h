@@ -185,7 +185,8 @@ class ReportNode : public Object {
    * Each element is a mapping from metric name to value. Some metrics that
    * appear in every call are "Name" (the function name), "Argument Shapes",
    * and "Duration (us)". Values are one of `String`, `PercentNode`,
-   * `DurationNode`, or `CountNode`.
+   * `DurationNode`, or `CountNode`. The calls of the estimated "FLOPs" and
+   * "DRAM Bytes" also have their achieved "GFLOP/s" and "GB/s".
    */
   ffi::Array<ffi::Map<ffi::String, ffi::Any>> calls;
   /*! \brief Metrics collected for the entire run of the model on a per-device basis.
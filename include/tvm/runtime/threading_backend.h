@@ -149,6 +149,42 @@ TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode,
  */
 TVM_DLL int32_t NumThreads();
 
+/*!
+ * \return The number of NUMA nodes of the system, 1 when the topology is unknown.
+ */
+TVM_DLL int NumaNodeCount();
+/*!
+ * \brief Get the NUMA node which a logical CPU belongs to.
+ * \param cpu The logical CPU id.
+ * \return The NUMA node id, 0 when the topology is unknown.
+ */
+TVM_DLL int NumaNodeOfCpu(unsigned int cpu);
+/*!
+ * \return The NUMA node of the CPU the calling thread is currently running on.
+ */
+TVM_DLL int CurrentNumaNode();
+/*!
+ * \brief Place the pages of a host memory range on one NUMA node.
+ *
+ *  Only the pages fully covered by the range are affected, pages that are already
+ *  populated are migrated.
+ * \param ptr The start of the memory range.
+ * \param size The size of the memory range in bytes.
+ * \param node The NUMA node to bind the pages to.
+ * \return Whether the memory policy was applied.
+ */
+TVM_DLL bool BindMemoryToNumaNode(void* ptr, size_t size, int node);
+/*!
+ * \brief Interleave the pages of a host memory range across all NUMA nodes.
+ *
+ *  Used for read-only data such as constant weights that all workers access, so that
+ *  the memory bandwidth of every node is used instead of the one of the loading thread.
+ * \param ptr The start of the memory range.
+ * \param size The size of the memory range in bytes.
+ * \return Whether the memory policy was applied.
+ */
+TVM_DLL bool InterleaveMemoryAcrossNumaNodes(void* ptr, size_t size);
+
 }  // namespace threading
 
 /*!
@@ -29,6 +29,7 @@
 #include <tvm/support/io.h>
 #include <tvm/support/serializer.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -42,6 +43,11 @@
 #define VM_VERSION "0.14"
 
 namespace tvm {
+namespace support {
+class BytesInStream;
+class BytesOutStream;
+}  // namespace support
+
 namespace runtime {
 namespace vm {
 
@@ -145,7 +151,8 @@ class VMExecutable : public ffi::ModuleObj {
   /*! \brief Check if the VMExecutable contains a specific function. */
   bool HasFunction(const ffi::String& name) const;
   /*!
-   * \brief Load VMExecutable from the file.
+   * \brief Load VMExecutable from the file. The file is mapped into memory, and the tensors of the
+   *  constant pool view the mapping, so that only the constants being used are read from disk.
    * \param file_name The path of the file that load the executable from.
    * \return The loaded executable, in the form of a `runtime::Module`.
    */
@@ -163,6 +170,17 @@ class VMExecutable : public ffi::ModuleObj {
   std::vector<Index> instr_offset;
   /*! \brief The byte data of instruction. */
   std::vector<ExecWord> instr_data;
+  /*!
+   * \brief The name of the Relax binding computed by each instruction, empty for the instructions
+   *  of no binding. It may be shorter than instr_offset, e.g. for the executables without it.
+   */
+  std::vector<std::string> instr_debug_names;
+  /*!
+   * \brief The estimated FLOPs and DRAM bytes of a call of each PrimFunc, by name, from which the
+   *  profiler reports the achieved throughput of the calls. It may miss PrimFuncs, e.g. the ones of
+   *  symbolic shapes.
+   */
+  std::unordered_map<std::string, std::pair<double, double>> kernel_costs;
 
   virtual ~VMExecutable() {}
 
@@ -176,6 +194,15 @@ class VMExecutable : public ffi::ModuleObj {
   TVM_MODULE_VTABLE_END();
 
  private:
+  /*!
+   * \brief Load VMExecutable from the memory holding its serialized form.
+   * \param data The beginning of the memory.
+   * \param size The size of the memory.
+   * \param owner The owner of the memory, kept alive by the constants viewing it.
+   * \return The loaded executable, in the form of a `runtime::Module`.
+   */
+  static ffi::Module LoadFromMemory(const char* data, size_t size,
+                                    const std::shared_ptr<void>& owner);
   /*!
    * \brief Save the globals.
    * \param strm The input stream.
@@ -187,15 +214,25 @@ class VMExecutable : public ffi::ModuleObj {
    */
   void SaveMemoryScopeSection(support::Stream* strm) const;
   /*!
-   * \brief Save the constant pool.
-   * \param strm The input stream.
+   * \brief Save the constant pool, with the payloads of the tensors aligned in the output.
+   * \param strm The output stream, which holds the whole executable.
    */
-  void SaveConstantSection(support::Stream* strm) const;
+  void SaveConstantSection(support::BytesOutStream* strm) const;
   /*!
    * \brief Save the instructions.
    * \param strm The input stream.
    */
   void SaveCodeSection(support::Stream* strm) const;
+  /*!
+   * \brief Save the debug info of the instructions.
+   * \param strm The output stream.
+   */
+  void SaveDebugSection(support::Stream* strm) const;
+  /*!
+   * \brief Save the estimated costs of the PrimFuncs.
+   * \param strm The output stream.
+   */
+  void SaveCostSection(support::Stream* strm) const;
   /*!
    * \brief Save the packed functions.
    * \param strm The input stream.
@@ -213,14 +250,28 @@ class VMExecutable : public ffi::ModuleObj {
   void LoadMemoryScopeSection(support::Stream* strm);
   /*!
    * \brief Load the constant pool.
-   * \param strm The input stream.
+   * \param strm The input stream, which reads the whole executable.
+   * \param aligned_payloads Whether the payloads of the tensors are aligned, as saved since the
+   *  third version of the format. The tensors then view the memory read by the stream.
+   * \param owner The owner of the memory read by the stream, kept alive by the tensors viewing it.
    */
-  void LoadConstantSection(support::Stream* strm);
+  void LoadConstantSection(support::BytesInStream* strm, bool aligned_payloads,
+                           const std::shared_ptr<void>& owner);
   /*!
    * \brief Load the instructions.
    * \param strm The input stream.
    */
   void LoadCodeSection(support::Stream* strm);
+  /*!
+   * \brief Load the debug info of the instructions.
+   * \param strm The input stream.
+   */
+  void LoadDebugSection(support::Stream* strm);
+  /*!
+   * \brief Load the estimated costs of the PrimFuncs.
+   * \param strm The input stream.
+   */
+  void LoadCostSection(support::Stream* strm);
   /*!
    * \brief Save the packed functions.
    * \param strm The input stream.
@@ -23,6 +23,7 @@
 #include <tvm/ffi/function.h>
 #include <tvm/runtime/tensor.h>
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -49,6 +50,17 @@ struct TensorCacheMetadata {
       TVM_DLL Tensor Load(Device device, const std::string* raw_data,
                           ffi::Optional<Tensor>* staging_buffer = nullptr) const;
 
+      /*!
+       * \brief Load the parameter from the raw data of the whole file, e.g. a memory-mapped file.
+       * Only the `nbytes` bytes starting from `byte_offset` are read.
+       * \param device The device to load the parameter onto.
+       * \param raw_data The beginning of the raw data of the file
+       * \param staging_buffer The buffer to be used to avoid extra OpenCL copies. Pass in a nullptr
+       * in other cases
+       */
+      TVM_DLL Tensor Load(Device device, const char* raw_data,
+                          ffi::Optional<Tensor>* staging_buffer = nullptr) const;
+
       /*! \brief Name of the parameter */
       std::string name;
       /*! \brief Shape of the parameter */
@@ -63,18 +75,46 @@ struct TensorCacheMetadata {
       int64_t byte_offset;
     };
 
+    /*!
+     * \brief The compression of a file. Its raw data is split into chunks of `chunk_nbytes`
+     * bytes, which are compressed independently, so that they are decompressed in parallel and
+     * a parameter is decompressed from the chunks covering it only.
+     */
+    struct Compression {
+      /*! \brief The codec of the chunks, i.e. "zstd" */
+      std::string codec;
+      /*!
+       * \brief The element size in bytes of the byte shuffle of each chunk before its
+       * compression, e.g. 2 for bf16, or 0 if the chunks are not shuffled.
+       */
+      int64_t byte_shuffle = 0;
+      /*! \brief The number of raw bytes of each chunk, but the last one */
+      int64_t chunk_nbytes = 0;
+      /*! \brief The number of compressed bytes of each chunk, in their order in the file */
+      std::vector<int64_t> chunks;
+    };
+
     /*! \brief Load a FileRecord into memory */
     TVM_DLL ffi::Array<Tensor> Load(Device device,                   //
                                     const std::string& path_prefix,  //
                                     std::string* raw_data_buffer,    //
                                     ffi::Optional<Tensor>* staging_buffer = nullptr) const;
 
+    /*!
+     * \brief Read the raw data of the file, decompressing it if the file is compressed.
+     * \param file_path The path to the bin file.
+     * \param raw_data The `nbytes` bytes of raw data of the file.
+     */
+    TVM_DLL void ReadRawData(const std::string& file_path, std::string* raw_data) const;
+
     /*! \brief Relative path to the bin file */
     std::string data_path;
     /*! \brief Format of the file */
     std::string format;
-    /*! \brief Size of the file */
+    /*! \brief Size of the raw data of the file, which is the size of the file if uncompressed */
     int64_t nbytes;
+    /*! \brief The compression of the file, if it is compressed */
+    std::optional<Compression> compression;
     /*! \brief The parameters in the file */
     std::vector<ParamRecord> records;
   };
@@ -111,6 +111,15 @@ TVM_DLL double EstimateTIRFlops(const Stmt& stmt);
  */
 TVM_DLL double EstimateTIRFlops(const IRModule& mod);
 
+/*!
+ * \brief Estimate the DRAM traffic of a PrimFunc, i.e. the bytes of its buffer parameters, each
+ *  read and written once. It is the compulsory traffic of the call, taken as the memory term of
+ *  its roofline.
+ * \param func The PrimFunc to be estimated.
+ * \return The estimated bytes, or std::nullopt if a buffer accessed has a symbolic shape.
+ */
+TVM_DLL ffi::Optional<int64_t> EstimateTIRMemoryTraffic(const PrimFunc& func);
+
 /*!
  * \brief Analyze the side effect of a function
  * \param func The function to be checked.
@@ -26,6 +26,7 @@
 #include <tvm/ffi/string.h>
 #include <tvm/runtime/object.h>
 #include <tvm/s_tir/meta_schedule/arg_info.h>
+#include <tvm/s_tir/meta_schedule/feature_extractor.h>
 #include <tvm/s_tir/meta_schedule/measure_candidate.h>
 #include <tvm/s_tir/meta_schedule/runner.h>
 #include <tvm/s_tir/schedule/schedule.h>
@@ -155,6 +156,24 @@ class CostModel : public runtime::ObjectRef {
                                        PyCostModelNode::FUpdate f_update,    //
                                        PyCostModelNode::FPredict f_predict,  //
                                        PyCostModelNode::FAsString f_as_string);
+  /*!
+   * \brief Create a gradient-boosted decision tree cost model trained and evaluated in C++.
+   * \param extractor The feature extractor of the model.
+   * \param num_warmup_samples The number of samples before the predictions stop being random.
+   * \param adaptive_training Whether to retrain only when the data has grown by 20%.
+   * \param num_rounds The number of boosting rounds.
+   * \param max_depth The maximum depth of a tree.
+   * \param learning_rate The shrinkage applied to the output of each tree.
+   * \param reg_lambda The L2 regularization on the leaf outputs.
+   * \param min_child_weight The minimum sum of hessians in a child of a split.
+   * \param max_bin The maximum number of histogram bins per feature, at most 255.
+   * \param seed The random seed of the predictions before warmup, -1 for a random one.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel GBDTCostModel(FeatureExtractor extractor, int num_warmup_samples,
+                                         bool adaptive_training, int num_rounds, int max_depth,
+                                         double learning_rate, double reg_lambda,
+                                         double min_child_weight, int max_bin, int64_t seed);
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(CostModel, ObjectRef, CostModelNode);
 };
 
@@ -263,6 +263,19 @@ class DatabaseNode : public runtime::Object {
    */
   virtual ffi::Optional<IRModule> QueryIRModule(const IRModule& mod, const Target& target,
                                                 const ffi::String& workload_name);
+  /*!
+   * \brief Query the best records of other workloads whose anchor block has the same structure as
+   *  the one of the given module, up to loop extents and buffer shapes, e.g. the same operator
+   *  with a different hidden size. Their traces are replayed onto the given module with the tile
+   *  sizes rescaled to its loop extents, and the records that cannot be replayed are skipped.
+   * \param mod The IRModule to be searched for.
+   * \param target The target to be searched for.
+   * \param top_k The maximum number of records to be returned.
+   * \return The adapted records, best first. They have no running time, since they have not been
+   *  measured on the given module.
+   */
+  ffi::Array<TuningRecord> QueryFuzzyTuningRecords(const IRModule& mod, const Target& target,
+                                                   int top_k);
   /*!
    * \brief Prune the database and dump it a given database.
    * \param destination The destination database to be dumped to.
@@ -496,6 +509,15 @@ class Database : public runtime::ObjectRef {
    */
   TVM_DLL static Database JSONDatabase(ffi::String path_workload, ffi::String path_tuning_record,
                                        bool allow_missing, ffi::String mod_eq_name = "structural");
+  /*!
+   * \brief Create a database that keeps an append-only index of binary tuning records on disk.
+   * Opening it only reads the index, while workloads and tuning records are loaded on demand.
+   * \param path The path to the directory of the database.
+   * \param allow_missing Whether to create the database when the given path is not found.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database IndexedDatabase(ffi::String path, bool allow_missing,
+                                          ffi::String mod_eq_name = "structural");
   /*!
    * \brief A database composed of multiple databases, allowing users to guide IR rewriting using
    * combined knowledge of those databases. To each query, it returns the best record among all the
@@ -53,6 +53,17 @@ class FeatureExtractorNode : public runtime::Object {
    */
   virtual ffi::Array<tvm::runtime::Tensor> ExtractFrom(
       const TuneContext& context, const ffi::Array<MeasureCandidate>& candidates) = 0;
+  /*!
+   * \brief Extract features from the given measure candidates into a single contiguous matrix.
+   * \param context The tuning context for feature extraction.
+   * \param candidates The measure candidates to extract features from.
+   * \return A pair of tensors. The first is the float32 matrix of the features of all the
+   *  candidates, concatenated along the first dimension. The second is the int64 vector of length
+   *  `len(candidates) + 1` whose i-th and (i+1)-th elements delimit the rows of the i-th
+   *  candidate. The default implementation concatenates the results of `ExtractFrom`.
+   */
+  virtual ffi::Array<tvm::runtime::Tensor> ExtractBatch(
+      const TuneContext& context, const ffi::Array<MeasureCandidate>& candidates);
   TVM_FFI_DECLARE_OBJECT_INFO("s_tir.meta_schedule.FeatureExtractor", FeatureExtractorNode, Object);
 };
 
@@ -131,6 +131,17 @@ class MeasureCallback : public runtime::ObjectRef {
    * \return The measure callback created.
    */
   TVM_DLL static MeasureCallback UpdateCostModel();
+  /*!
+   * \brief Create a measure callback that appends the metrics of every round of every task to a
+   *  JSON-lines file: the number of candidates measured or failed, the best latency, the
+   *  counters of the search strategy, and the rank correlation of the cost model predictions
+   *  with the measured throughputs.
+   * \param path The path of the JSON-lines file.
+   * \return The measure callback created.
+   * \note To evaluate the cost model on unseen candidates, the callback is expected to be placed
+   *  before `UpdateCostModel`.
+   */
+  TVM_DLL static MeasureCallback LogMetrics(ffi::String path);
   /*!
    * \brief Create a measure callback with customized methods on the python-side.
    * \param f_apply The packed function of `Apply`.
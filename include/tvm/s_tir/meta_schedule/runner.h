@@ -75,6 +75,8 @@ class RunnerResultNode : public runtime::Object {
  public:
   /*! \brief The run time in seconds.*/
   ffi::Optional<ffi::Array<FloatImm>> run_secs;
+  /*! \brief The sample variance of the run time in seconds squared, if there are 2+ runs. */
+  ffi::Optional<FloatImm> run_secs_variance;
   /*! \brief The error message, if any. */
   ffi::Optional<ffi::String> error_msg;
 
@@ -82,6 +84,7 @@ class RunnerResultNode : public runtime::Object {
     namespace refl = tvm::ffi::reflection;
     refl::ObjectDef<RunnerResultNode>()
         .def_ro("run_secs", &RunnerResultNode::run_secs)
+        .def_ro("run_secs_variance", &RunnerResultNode::run_secs_variance)
         .def_ro("error_msg", &RunnerResultNode::error_msg);
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.RunnerResult", RunnerResultNode,
@@ -254,6 +254,37 @@ class ScheduleRule : public runtime::ObjectRef {
    * \return The schedule rule created
    */
   TVM_DLL static ScheduleRule CrossThreadReduction(ffi::Array<Integer> thread_extents);
+  /*!
+   * \brief Create a schedule rule which splits the reduction of the reduction blocks with too
+   * little spatial parallelism into partial reductions on a persistent grid of thread blocks, and
+   * reduces the partial results in the same kernel after a grid-wide barrier
+   * \param thread_extent The number of threads of each thread block
+   * \param split_factors Candidates of the number of splits of the reduction
+   * \param max_concurrent_blocks The maximum number of thread blocks that are resident on the
+   * device at once, which bounds the grid as all the blocks have to reach the barrier
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule StreamK(int thread_extent, ffi::Array<Integer> split_factors,
+                                      int max_concurrent_blocks);
+  /*!
+   * \brief Create a schedule rule which pads the iterators of an einsum reduction block, e.g. a
+   * GEMM of an irregular shape, up to a multiple of a tile size, so that the tiling that follows
+   * has no partial tiles. The copies of the padded inputs are inlined into the read caches of the
+   * tiling on GPUs, and decomposed into a fill and an in-bound copy on CPUs
+   * \param tile_sizes Candidates of the tile size, one design space each
+   * \param max_overhead The maximum ratio of the padded iteration space to the original one,
+   * minus one, of the candidates
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule PadToTile(ffi::Array<Integer> tile_sizes, double max_overhead);
+  /*!
+   * \brief Create a schedule rule which fuses a chain of convolutions or poolings on CPU: the
+   * producers of the intermediate tensors are computed a tile of rows at a time under the loops of
+   * their consumer, and their outputs are folded into rolling line buffers of the rows in flight
+   * \param max_rows_per_tile The maximum number of rows of the consumer computed per tile
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule RollingBufferFusion(int max_rows_per_tile);
   /*!
    * \brief A rule that randomly select a compute-at location for a free block
    * \return The schedule rule created
@@ -276,6 +307,14 @@ class ScheduleRule : public runtime::ObjectRef {
                                                          int max_vectorize_extent,              //
                                                          ffi::Array<Integer> unroll_max_steps,  //
                                                          bool unroll_explicit);
+  /*!
+   * \brief Mark the software prefetch distance to the root block. The mark will be applied to the
+   * innermost loop of each block that is not vectorized in a follow-up post processor.
+   * \param prefetch_distances The options of the prefetch distance in loop iterations, where 0
+   * disables prefetching.
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule SoftwarePrefetch(ffi::Array<Integer> prefetch_distances);
   /*!
    * \brief Auto bind loops around the block to BlockIdx and ThreadIdx
    * \param max_threadblocks The maximum number of threadblock on GPU
@@ -302,7 +341,7 @@ class ScheduleRule : public runtime::ObjectRef {
 
   /*! \brief Create default schedule rules for LLVM */
   TVM_DLL static ffi::Array<ScheduleRule, void> DefaultLLVM();
-  /*! \brief Create default schedule rules for x86 (AVX512 and VNNI) */
+  /*! \brief Create default schedule rules for x86 (AVX512, VNNI and AMX) */
   TVM_DLL static ffi::Array<ScheduleRule, void> DefaultX86(const ffi::String& type);
   /*! \brief Create default schedule rules for CUDA */
   TVM_DLL static ffi::Array<ScheduleRule, void> DefaultCUDA();
@@ -20,6 +20,7 @@
 #define TVM_S_TIR_META_SCHEDULE_SEARCH_STRATEGY_H_
 
 #include <tvm/ffi/container/array.h>
+#include <tvm/ffi/container/map.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/optional.h>
 #include <tvm/ffi/reflection/registry.h>
@@ -130,6 +131,13 @@ class SearchStrategyNode : public runtime::Object {
    */
   virtual SearchStrategy Clone() const = 0;
 
+  /*!
+   * \brief Get the counters of how the measure candidates were produced since pre-tuning, e.g.
+   *  the number of schedules sampled, rejected by postprocessors or dropped as duplicates.
+   * \return The counters keyed by their names, empty if the strategy does not keep any.
+   */
+  virtual ffi::Map<ffi::String, int64_t> GetStats() const { return {}; }
+
   static constexpr const bool _type_mutable = true;
   TVM_FFI_DECLARE_OBJECT_INFO("s_tir.meta_schedule.SearchStrategy", SearchStrategyNode, Object);
 };
@@ -207,6 +215,10 @@ class SearchStrategy : public runtime::ObjectRef {
    * \param genetic_mutate_prob The probability of mutation.
    * \param genetic_max_fail_count The maximum number to try evolving the given trace.
    * \param eps_greedy The ratio to select samples in a greedy fashion via their predicted score.
+   * \param pipelined Whether to evolve the next batch while the current one is being built and
+   *  measured, using a cost model that lags behind by one batch.
+   * \param transfer_records Whether to seed the initial population with the adapted best records
+   *  of workloads that only differ in loop extents, when the tuned one has too few records.
    */
   TVM_DLL static SearchStrategy EvolutionarySearch(int population_size,         //
                                                    double init_measured_ratio,  //
@@ -215,7 +227,9 @@ class SearchStrategy : public runtime::ObjectRef {
                                                    int genetic_num_iters,       //
                                                    double genetic_mutate_prob,  //
                                                    int genetic_max_fail_count,  //
-                                                   double eps_greedy);
+                                                   double eps_greedy,           //
+                                                   bool pipelined,              //
+                                                   bool transfer_records);
 
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(SearchStrategy, ObjectRef, SearchStrategyNode);
 };
@@ -275,10 +275,18 @@ class TaskScheduler : public runtime::ObjectRef {
    * \param logger The tuning task's logging function.
    * \param alpha The parameter alpha to control gradient computation.
    * \param window_size The parameter to control backward window size.
+   * \param plateau_rounds The number of rounds without improvement after which a task is retired
+   *  and its remaining trials are left to the other tasks, or 0 to never retire a task early.
+   * \param plateau_tolerance The relative improvement below which a round does not count as an
+   *  improvement. The measurement noise of the task is used instead if it is larger.
+   * \param time_budget_secs The wall-clock budget of the whole tuning in seconds, or non-positive
+   *  for no limit. Every task is measured at least once.
    * \param seed The random seed.
    * \return The task scheduler created.
    */
   TVM_DLL static TaskScheduler GradientBased(ffi::Function logger, double alpha, int window_size,
+                                             int plateau_rounds, double plateau_tolerance,
+                                             double time_budget_secs,
                                              support::LinearCongruentialEngine::TRandState seed);
   /*!
    * \brief Create a task scheduler with customized methods on the python-side.
@@ -448,6 +448,35 @@ class ScheduleNode : public runtime::Object {
    * \param loop_rv The loop to be unrolled
    */
   virtual void Unroll(const LoopRV& loop_rv) = 0;
+  /*!
+   * \brief Specialize the warps of a serial loop under the threadIdx.x binding into producers,
+   * which run the copies of its body into shared memory, and consumers, which run the rest of its
+   * body. The producers are additional threads, and the shared memory buffers they write have
+   * `num_stages` versions that are handed over with mbarriers.
+   * \param loop_rv The loop to be warp specialized
+   * \param num_producer_threads The number of producer threads, a multiple of the warp size
+   * \param num_stages The number of stages of the shared memory buffers
+   */
+  virtual void WarpSpecialize(const LoopRV& loop_rv, int num_producer_threads,
+                              int num_stages) = 0;
+  /*!
+   * \brief Double buffer the register fragments loaded in a serial loop, e.g. the tensor core
+   * fragments loaded by ldmatrix in a k loop, so that the fragments of the next iteration are
+   * loaded from shared memory while the current iteration computes. The leading statements of
+   * the loop body, which load the fragments, are pipelined one iteration ahead of the rest.
+   * \param loop_rv The loop whose fragments are double buffered
+   */
+  virtual void DoubleBufferFragments(const LoopRV& loop_rv) = 0;
+  /*!
+   * \brief Merge two adjacent kernels, whose outermost loops are bound to the same block index
+   * with the same range, into one kernel that runs the second after a global barrier. The nested
+   * thread bindings of the kernels are merged as well, so they have to match. All the thread
+   * blocks of the merged kernel have to be resident on the device at the same time.
+   * \param first_loop_rv The outermost loop of the first kernel
+   * \param second_loop_rv The outermost loop of the second kernel
+   * \return The outermost loop of the merged kernel
+   */
+  virtual LoopRV MergeKernels(const LoopRV& first_loop_rv, const LoopRV& second_loop_rv) = 0;
   /******** Schedule: Insert cache stages ********/
   /*!
    * \brief Create a block that reads a buffer region into a read cache. It requires:
@@ -44,6 +44,12 @@ constexpr const char* meta_schedule_tiling_structure = "meta_schedule.tiling_str
  */
 constexpr const char* meta_schedule_cooperative_fetch = "meta_schedule.cooperative_fetch";
 
+/*! \brief Mark that the block is inlined into the read cache added by multi-level tiling */
+constexpr const char* meta_schedule_inline_into_cache_read = "meta_schedule.inline_into_cache_read";
+
+/*! \brief Mark the loop of a rolling buffer, whose iterations are run in order */
+constexpr const char* meta_schedule_rolling_buffer = "meta_schedule.rolling_buffer";
+
 /*! \brief The allowed range of thread extent in thread bindings */
 constexpr const char* meta_schedule_thread_extent_low_inclusive =
     "meta_schedule.thread_extent_low_inclusive";
@@ -68,6 +74,9 @@ constexpr const char* meta_schedule_unroll_explicit = "meta_schedule.unroll_expl
 /*! \brief Mark auto-unroll setting on the block. */
 constexpr const char* meta_schedule_unroll_implicit = "meta_schedule.unroll_implicit";
 
+/*! \brief Mark auto software prefetch setting on the block. */
+constexpr const char* meta_schedule_software_prefetch = "meta_schedule.software_prefetch";
+
 /*! \brief Mark that a block should be further rewritten using tensorization. */
 constexpr const char* meta_schedule_auto_tensorize = "meta_schedule.auto_tensorize";
 
@@ -129,6 +138,28 @@ constexpr const char* software_pipeline_order = "software_pipeline_order";
  */
 constexpr const char* software_pipeline_async_stages = "software_pipeline_async_stages";
 
+/*!
+ * \brief Mark a loop whose iterations are split between producer warps, which run its copies
+ *  into shared memory, and consumer warps, which run the rest of it.
+ *  The value is the number of producer threads.
+ */
+constexpr const char* warp_specialize_producer_threads = "warp_specialize_producer_threads";
+
+/*! \brief The number of shared memory stages of a warp specialized loop */
+constexpr const char* warp_specialize_num_stages = "warp_specialize_num_stages";
+
+/*!
+ * \brief Mark a CPU loop whose global buffer loads are prefetched ahead of time.
+ *  The value is the prefetch distance in iterations of the loop.
+ */
+constexpr const char* software_prefetch_distance = "software_prefetch_distance";
+
+/*!
+ * \brief Mark a kernel merged from several kernels by the merge_kernels schedule primitive,
+ *  whose stages are separated by global barriers.
+ */
+constexpr const char* pragma_global_barrier = "pragma_global_barrier";
+
 /*! \brief Mark the buffers which is const access and can be transformed layout. */
 constexpr const char* layout_free_buffers = "layout_free_buffers";
 
@@ -167,7 +198,8 @@ constexpr const char* vector_bytes = "vector_bytes";
 
 /*!
  * \brief Mark that a block is executed by a warp. This implies the extend of threadIdx.x is
- * warp size.
+ * warp size. The value is the number of warps executing the block together, e.g. 4 for the
+ * warpgroups of wgmma, in which case the extent of threadIdx.x is 4 times the warp size.
  */
 constexpr const char* warp_execution = "warp_execution";
 
@@ -127,6 +127,8 @@ TVM_DLL Pass LiftThreadBinding();
  * \param is_strict ensure the compacted shape always smaller than the original shape.
  *   otherwise it allows to grow the shape to match actual accessed buffer regions.
  * \return The pass.
+ * \note The "s_tir.compact_buffer_region_proof_strength" config selects the arith::ProofStrength
+ *   of the region analysis; kPresburger tightens the affine regions with Presburger sets.
  */
 TVM_DLL Pass CompactBufferAllocation(bool is_strict = true);
 
@@ -143,7 +145,8 @@ TVM_DLL Pass LowerMatchBuffer();
 TVM_DLL Pass InjectPermutedLayout();
 
 /*!
- * \brief Transform Mma scope (m16n8k8.matrixA/B/C) to local scope with layout transformation.
+ * \brief Transform Mma scope (m16n8k8.matrixA/B/C and wgmma.accumulator) to local scope with
+ *  layout transformation.
  * \return The pass.
  */
 TVM_DLL Pass TransformMmaBufferLayout();
@@ -204,6 +207,36 @@ TVM_DLL Pass UnifyThreadBinding();
  */
 TVM_DLL Pass InjectSoftwarePipeline();
 
+/*!
+ * \brief Prefetch the global buffer loads of the loops annotated with
+ *  `software_prefetch_distance` the given number of iterations ahead.
+ *
+ * The loads whose address only depends on the loop variable and the variables defined outside
+ * the loop, including the indirect ones such as the gathers B[idx[i]], are prefetched at the
+ * beginning of the loop body with the `prefetch` builtin, the iteration of the address being
+ * clamped to the last iteration of the loop. The loads in the vectorized loops of the body are
+ * prefetched at the address of their first lane. Only the functions of the CPU targets are
+ * rewritten.
+ *
+ * \return The IR transform pass.
+ * \note Run this pass after FlattenBuffer.
+ */
+TVM_DLL Pass InjectSoftwarePrefetch();
+
+/*!
+ * \brief Merge the consecutive parallel loops of the CPU functions into one parallel launch, and
+ *  run the parallel launches with little work serially.
+ *
+ * With the pass config `s_tir.merge_parallel_launch`, the consecutive parallel loops are run in
+ * a single launch of the thread pool, with a barrier between the loops. With the pass config
+ * `s_tir.parallel_launch_min_work`, a launch whose estimated number of executed statements is
+ * below the threshold at runtime runs its loops serially instead.
+ *
+ * \return The IR transform pass.
+ * \note Run this pass after FlattenBuffer.
+ */
+TVM_DLL Pass MergeParallelLaunch();
+
 /*!
  * \brief Automatically do memory optimizations for auto copy blocks
  * \return The pass.
@@ -262,6 +295,20 @@ TVM_DLL Pass HoistIfThenElse(tvm::ffi::String variant = "");
  */
 TVM_DLL Pass HoistExpression();
 
+/*!
+ * \brief Hoist the loop-invariant offsets of the affine indices of the global buffers out of
+ *  each loop level.
+ *
+ * Each index that is affine in a loop variable is split into an offset bound above the loop and
+ * the scaled loop variable, and the offsets of the inner loops are split in turn by the outer
+ * loops. Each loop level then only adds its own term to the offset of the enclosing level,
+ * instead of recomputing the full flattened index in the innermost loop.
+ *
+ * \return The pass.
+ * \note Run this pass after FlattenBuffer and the last Simplify, which inlines the offsets back.
+ */
+TVM_DLL Pass HoistIndexOffset();
+
 /*!
  * \brief Renormalize the split pattern from floordiv(floormod()) to floormod(floordiv()).
  * \return The pass.
@@ -306,6 +353,13 @@ TVM_DLL Pass LowerVtcmAlloc();
  */
 TVM_DLL Pass ThreadSync(tvm::ffi::String storage_scope);
 
+/*!
+ * \brief Insert the global barriers between the conflicting global buffer accesses of the kernels
+ *  marked with `pragma_global_barrier` by the merge_kernels schedule primitive.
+ * \return The pass.
+ */
+TVM_DLL Pass InjectGlobalBarrier();
+
 /*!
  * \brief Infer the TensorCore fragment information using tensor intrinsics.
  * \return The pass.
@@ -330,8 +384,41 @@ TVM_DLL Pass LowerAsyncDMA();
  */
 TVM_DLL Pass InjectPTXAsyncCopy();
 
+/*!
+ * \brief Split the threads of the kernels with a warp specialized loop into producers and
+ *  consumers.
+ *
+ * The producers are additional threadIdx.x threads that run the copies of the loop from global
+ * to shared memory, into a version of the shared memory buffers for each stage. The consumers
+ * run the rest of the kernel, and wait for the copies of each stage on an mbarrier, while the
+ * producers wait for the consumers to release the stage before overwriting it. The shared
+ * memory barriers of the consumers become named barriers.
+ *
+ * It should run after ThreadSync, on the flattened buffers.
+ *
+ * \return The pass.
+ * \sa s_tir::attr::warp_specialize_producer_threads
+ */
+TVM_DLL Pass InjectWarpSpecialization();
+
+/*!
+ * \brief Create the TMA descriptors of the ptx_tma_load tile copies on the host, and lower the
+ *  copies to ptx_cp_async_bulk_tensor, which reads the descriptors passed to the kernel.
+ *
+ * It should run before SplitHostDevice, so that the descriptors become kernel parameters.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass LowerTMADescriptors();
+
 /*!
  * \brief Merge multiple TIR-level shared memory allocations into one.
+ *
+ * With the "s_tir.merge_shared_memory_interval_packing" config, the dynamic shared memory
+ * buffers of constant sizes are placed by interval packing of their live ranges, which end at
+ * the first barrier after the last access. The "s_tir.merge_shared_memory_report" config logs
+ * the resulting footprint of each kernel.
+ *
  * \return The pass.
  */
 TVM_DLL Pass MergeSharedMemoryAllocations();
@@ -61,8 +61,10 @@ TVM_DLL std::vector<std::vector<int>> rr_partitioner(int begin, int end, int ste
  * \param step The traversal step to the index.
  * \param partitioner A partition function to split tasks to different threads. Use Round-robin
  * partitioner by default.
- * \note 1. Currently do not support nested parallel_for; 2. The order of execution in each thread
- * is not guaranteed, the for loop task should be thread independent and thread safe.
+ * \note 1. The partitions run on a worker pool shared by the whole process together with the
+ * calling thread. Nested parallel_for calls are supported: the nested call runs its own
+ * partitions inline and idle workers help in; 2. The order of execution in each thread is not
+ * guaranteed, the for loop task should be thread independent and thread safe.
  */
 TVM_DLL void parallel_for(int begin, int end, const std::function<void(int)>& f, int step = 1,
                           const PartitionerFuncType partitioner = rr_partitioner);
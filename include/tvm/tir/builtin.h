@@ -638,6 +638,43 @@ TVM_DLL const Op& ptx_mma_sp();
  */
 TVM_DLL const Op& ptx_ldmatrix();
 
+/*!
+ * \brief tvm intrinsic for ptx warpgroup mma with both multiplicands in shared memory.
+ *
+ * void ptx_wgmma_ss(StringImm shape, StringImm A_dtype, StringImm B_dtype, StringImm C_dtype,
+ *                   Var a_smem, Expr a_offset, int a_leading_byte_offset,
+ *                   int a_stride_byte_offset,
+ *                   Var b_smem, Expr b_offset, int b_leading_byte_offset,
+ *                   int b_stride_byte_offset,
+ *                   int swizzle_kind, Var accumulator, Expr c_offset, Expr scale_d);
+ *
+ * The multiplicands are K-major, and are described to wgmma.mma_async by shared memory matrix
+ * descriptors with the given byte offsets and swizzle kind, which uses the encoding of
+ * CUtensorMapSwizzle like ptx_tma_load. Each of the 128 threads of the warpgroup holds
+ * 64 * N / 128 elements of the accumulator. The accumulator is overwritten if scale_d is zero.
+ */
+TVM_DLL const Op& ptx_wgmma_ss();
+
+/*!
+ * \brief tvm intrinsics for ordering the register accesses of wgmma, and for committing and
+ *  waiting for the groups of wgmma.
+ *
+ * void ptx_wgmma_fence();
+ * void ptx_wgmma_commit_group();
+ * void ptx_wgmma_wait_group(int num);
+ */
+TVM_DLL const Op& ptx_wgmma_fence();
+TVM_DLL const Op& ptx_wgmma_commit_group();
+TVM_DLL const Op& ptx_wgmma_wait_group();
+
+/*!
+ * \brief tvm intrinsic for making the shared memory writes of the generic proxy visible to the
+ *  async proxy, i.e. wgmma and TMA, using fence.proxy.async.
+ *
+ * void ptx_fence_proxy_async();
+ */
+TVM_DLL const Op& ptx_fence_proxy_async();
+
 /*!
  * \brief tvm intrinsics for ptx async copy from global to shared memory using cp.async
  *
@@ -661,6 +698,39 @@ TVM_DLL const Op& ptx_cp_async();
  */
 TVM_DLL const Op& ptx_cp_async_bulk();
 
+/*!
+ * \brief tvm intrinsics for ptx async copy of a tile from global to shared memory using the
+ *  Tensor Memory Accelerator (TMA), i.e. cp.async.bulk.tensor
+ *
+ * void ptx_cp_async_bulk_tensor(Var shared_ptr,
+ *                               Expr shared_offset,
+ *                               Var tensor_map,
+ *                               int barrier_id,
+ *                               Expr coord_0, ..., Expr coord_{rank-1});
+ *
+ * The tensor map is a CUtensorMap descriptor passed to the kernel, and the coordinates of the
+ * tile are given from the outermost to the innermost dimension.
+ */
+TVM_DLL const Op& ptx_cp_async_bulk_tensor();
+
+/*!
+ * \brief tvm intrinsics for a TMA copy of a tile from a global tensor to shared memory
+ *
+ * void ptx_tma_load(Var shared_ptr,
+ *                   Expr shared_offset,
+ *                   Var global_ptr,
+ *                   int barrier_id,
+ *                   int swizzle_kind,
+ *                   int rank,
+ *                   Expr global_shape_0, ..., Expr global_shape_{rank-1},
+ *                   int box_shape_0, ..., int box_shape_{rank-1},
+ *                   Expr coord_0, ..., Expr coord_{rank-1});
+ *
+ * The global tensor is dense and row-major. LowerTMADescriptors creates the tensor map of the
+ * global tensor and the box shape on the host, and lowers this to ptx_cp_async_bulk_tensor.
+ */
+TVM_DLL const Op& ptx_tma_load();
+
 /*!
  * \brief tvm intrinsics for ptx async copy commit and wait.
  *
@@ -703,14 +773,34 @@ TVM_DLL const Op& ptx_arrive_barrier();
  */
 TVM_DLL const Op& ptx_arrive_barrier_expect_tx();
 
+/*!
+ * \brief tvm intrinsic for increasing the expected tx count of a ptx barrier without arrival
+ *  using mbarrier.expect_tx
+ *
+ * ptx_barrier_expect_tx(int barrier_id, int byte_count)
+ *
+ */
+TVM_DLL const Op& ptx_barrier_expect_tx();
+
 /*!
  * \brief tvm intrinsics for ptx barrier wait using mbarrier.try_wait
  *
- * ptx_wait_barrier(int barrier_id)
+ * ptx_wait_barrier(int barrier_id, int phase = 0)
  *
+ * The wait completes when the phase of the given parity is complete.
  */
 TVM_DLL const Op& ptx_wait_barrier();
 
+/*!
+ * \brief tvm intrinsic for synchronizing a subset of the threads of a block on a named
+ *  barrier using bar.sync
+ *
+ * ptx_bar_sync(int barrier_id, int thread_count)
+ *
+ * The thread count is a multiple of the warp size, and barrier 0 is used by __syncthreads.
+ */
+TVM_DLL const Op& ptx_bar_sync();
+
 /*!
  * \brief tvm intrinsics to create N barriers
  *
@@ -958,6 +1048,35 @@ TVM_DLL const Op& vscale();
  */
 TVM_DLL const Op& get_active_lane_mask();
 
+/*!
+ * \brief Reduce the lanes of a vector with addition into a scalar of its element type.
+ *
+ * It will be lowered to the llvm.vector.reduce.add and llvm.vector.reduce.fadd intrinsics, the
+ * latter allowing reassociation.
+ */
+TVM_DLL const Op& vector_reduce_add();
+
+/*!
+ * \brief Reduce the lanes of a vector with multiplication into a scalar of its element type.
+ *
+ * It will be lowered to the llvm.vector.reduce.mul and llvm.vector.reduce.fmul intrinsics.
+ */
+TVM_DLL const Op& vector_reduce_mul();
+
+/*!
+ * \brief Reduce the lanes of a vector to their minimum.
+ *
+ * It will be lowered to the llvm.vector.reduce.{s,u,f}min intrinsics.
+ */
+TVM_DLL const Op& vector_reduce_min();
+
+/*!
+ * \brief Reduce the lanes of a vector to their maximum.
+ *
+ * It will be lowered to the llvm.vector.reduce.{s,u,f}max intrinsics.
+ */
+TVM_DLL const Op& vector_reduce_max();
+
 /*! \brief Annotate a predicate not be considered as target condition of loop partition. */
 TVM_DLL const Op& ignore_loop_partition();
 
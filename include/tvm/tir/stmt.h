@@ -1043,6 +1043,12 @@ constexpr const char* fragment_layout = "fragment_layout";
  */
 constexpr const char* pragma_loop_partition_hint = "pragma_loop_partition_hint";
 
+/*!
+ * \brief Mark that a parallel loop is split into chunks that idle CPU workers
+ *  can steal, overriding the "parallel-work-stealing" target option.
+ */
+constexpr const char* parallel_work_stealing = "parallel_work_stealing";
+
 /*!
  * \brief Check if attr_key is a pragma key extension
  * \param attr_key The attr key to be compared
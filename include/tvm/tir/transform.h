@@ -52,12 +52,16 @@ using tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param traceable Whether the function pass is traceable.
+ * \param thread_safe Whether pass_func may run on several PrimFuncs of a module in parallel,
+ *        see PassInfoNode::thread_safe.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreatePrimFuncPass(std::function<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
                                 int opt_level, ffi::String name,
-                                tvm::ffi::Array<ffi::String> required, bool traceable = false);
+                                tvm::ffi::Array<ffi::String> required, bool traceable = false,
+                                bool thread_safe = false);
 
 /*!
  * \brief Lower vectorization loops.
@@ -82,6 +86,11 @@ TVM_DLL Pass StorageRewrite();
  * \brief unroll the constant loop marked by unroll.
  * This pass also automatically attach pragma unroll tag to loops which meets the standard.
  *
+ * When the unrolling is not tuned, i.e. neither by the config of tir.UnrollLoop nor by
+ * pragma_auto_unroll_max_step, the innermost loops are unrolled by a cost model of the target
+ * of the function, which bounds the estimated instructions of the unrolled loop, and on GPU the
+ * estimated registers of a thread. The decisions are logged under tir.unroll_loop_report.
+ *
  * \return The pass.
  */
 TVM_DLL Pass UnrollLoop();
@@ -256,6 +265,19 @@ TVM_DLL Pass NarrowDataType(int target_bits);
  */
 TVM_DLL Pass ForceNarrowIndexToInt32();
 
+/*!
+ * \brief Compute the int64 index expressions of the kernels in int32 where it is provably safe.
+ *
+ * Unlike NarrowDataType, which narrows a variable only if all the expressions containing it fit
+ * into int32, each index is narrowed on its own: its sub-expressions of which every node fits
+ * into int32 are computed in int32, and only the terms that may not fit, e.g. the base offsets
+ * into large buffers, are kept in int64.
+ *
+ * \return The pass.
+ * \note Run this pass after FlattenBuffer. Only the indices under thread_extent are rewritten.
+ */
+TVM_DLL Pass NarrowIndexArithmetic();
+
 /*!
  * \brief Legalize bf16 compute Ops. Add a cast to fp32
  *   before Ops, then add a cast back to bf16.
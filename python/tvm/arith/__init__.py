@@ -37,4 +37,6 @@ from .iter_affine_map import (
     normalize_to_iter_sum,
     subspace_divide,
     inverse_affine_iter_map,
+    update_iter_map_for_split,
+    update_iter_map_for_fuse,
 )
@@ -33,6 +33,7 @@ class ProofStrength(enum.IntEnum):
 
     DEFAULT = 0
     SYMBOLIC_BOUND = 1
+    PRESBURGER = 2
 
 
 class Extension(enum.Flag):
@@ -118,6 +119,8 @@ class Analyzer:
         self._rewrite_simplify = _mod("rewrite_simplify")
         self._get_rewrite_simplify_stats = _mod("get_rewrite_simplify_stats")
         self._reset_rewrite_simplify_stats = _mod("reset_rewrite_simplify_stats")
+        self._enable_simplify_cache = _mod("enable_simplify_cache")
+        self._get_simplify_cache_stats = _mod("get_simplify_cache_stats")
         self._canonical_simplify = _mod("canonical_simplify")
         self._int_set = _mod("int_set")
         self._enter_constraint_context = _mod("enter_constraint_context")
@@ -213,6 +216,25 @@ class Analyzer:
     def reset_rewrite_simplify_stats(self):
         self._reset_rewrite_simplify_stats()
 
+    def enable_simplify_cache(self, enable: bool = True) -> None:
+        """Enable or disable the memo table of simplify.
+
+        When enabled, simplify returns the result it already computed for the same expression
+        object with the same steps under the same constraints. The table is cleared by bind,
+        and the results computed in a constraint scope are not reused outside of it.
+
+        Parameters
+        ----------
+        enable : bool
+            Whether to enable the memo table.
+        """
+        self._enable_simplify_cache(enable)
+
+    @property
+    def simplify_cache_stats(self):
+        """The number of hits, misses and entries of the memo table of simplify."""
+        return self._get_simplify_cache_stats()
+
     def canonical_simplify(self, expr: tir.PrimExpr) -> tir.PrimExpr:
         """Simplify expression via canonicalization.
 
@@ -139,7 +139,7 @@ def estimate_region_strict_bound(region, var_dom, predicate):
     return _ffi_api.EstimateRegionStrictBound(region, var_dom, predicate)
 
 
-def estimate_region_upper_bound(region, var_dom, predicate):
+def estimate_region_upper_bound(region, var_dom, predicate, strength=0):
     """Analyze the region with affine map, given the domain of variables and their predicate
     Relaxation of the region may be used in upper-bound analysis,
     i.e. some extra region may be added to the result.
@@ -155,12 +155,16 @@ def estimate_region_upper_bound(region, var_dom, predicate):
     predicate : PrimExpr
         The predicate for the affine map
 
+    strength : ProofStrength
+        The proof strength of the analysis. With ProofStrength.PRESBURGER, the affine dimensions
+        are further tightened with Presburger sets when TVM is built with MLIR.
+
     Returns
     ----------
     region_int_set : List[IntSet]
         an array of IntSets as the result of analysis
     """
-    return _ffi_api.EstimateRegionUpperBound(region, var_dom, predicate)
+    return _ffi_api.EstimateRegionUpperBound(region, var_dom, predicate, int(strength))
 
 
 def pos_inf():
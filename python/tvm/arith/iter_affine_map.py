@@ -341,3 +341,53 @@ def inverse_affine_iter_map(iter_map, outputs):
         The map from the input to the transformed result.
     """
     return _ffi_api.InverseAffineIterMap(iter_map, outputs)
+
+
+def update_iter_map_for_split(result, loop, new_loops, new_extents):
+    """Update an iter map after one of its input iterators is split into new loops,
+    without detecting the map again.
+
+    See also :any:`detect_iter_map`.
+
+    Parameters
+    ----------
+    result : IterMapResult
+        The iter map detected by detect_iter_map.
+    loop : Var
+        The split input iterator.
+    new_loops : List[Var]
+        The new loops, from the outermost one.
+    new_extents : List[PrimExpr]
+        The extents of the new loops.
+
+    Returns
+    -------
+    results : IterMapResult
+        The updated result, with errors when the split is not perfect.
+    """
+    return _ffi_api.UpdateIterMapForSplit(result, loop, new_loops, new_extents)
+
+
+def update_iter_map_for_fuse(result, loops, extents, fused):
+    """Update an iter map after some of its input iterators are fused into one loop,
+    without detecting the map again.
+
+    See also :any:`detect_iter_map`.
+
+    Parameters
+    ----------
+    result : IterMapResult
+        The iter map detected by detect_iter_map.
+    loops : List[Var]
+        The fused input iterators, from the outermost one.
+    extents : List[PrimExpr]
+        The extents of the fused input iterators.
+    fused : Var
+        The fused loop.
+
+    Returns
+    -------
+    results : IterMapResult
+        The updated result, with errors when an inner iterator is not tiled by its splits.
+    """
+    return _ffi_api.UpdateIterMapForFuse(result, loops, extents, fused)
@@ -354,7 +354,8 @@ def instantiate_gemm_template(attrs):
 """
     op_type = attrs["op_type"]
     has_bias = "bias" in op_type
-    is_gelu = "gelu" in op_type
+    # The GeLU and SiLU epilogues are generic linear combinations, scaling the bias by beta
+    is_generic_epilogue = "gelu" in op_type or "silu" in op_type
     batched = "batch" in attrs
     has_residual_block = "residual" in op_type
     aux_map = {"kernel": "Gemm"}
@@ -373,13 +374,14 @@ def instantiate_gemm_template(attrs):
     else:
         aux_map.update({"bias_decl": "", "ptr_c": "ptr_out", "c_stride": attrs["ldc"]})
 
-    if is_gelu or has_residual_block:
-        # GeLU epilogue does not compile with NoBetaScaling, so we explicitly specify the scale.
+    if is_generic_epilogue or has_residual_block:
+        # GeLU and SiLU epilogues do not compile with NoBetaScaling, so we explicitly specify the
+        # scale.
         aux_map["beta"] = 1
     else:
         aux_map["beta"] = 0
 
-    if has_bias and not is_gelu and not has_residual_block:
+    if has_bias and not is_generic_epilogue and not has_residual_block:
         aux_map["alpha_beta"] = "alpha"
     else:
         aux_map["alpha_beta"] = "alpha, beta"
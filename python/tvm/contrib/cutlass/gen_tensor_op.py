@@ -372,10 +372,12 @@ EPILOGUE_MAP = {
     "cutlass.matmul_bias": (EpilogueFunctor.LinearCombinationBias, True),
     "cutlass.matmul_bias_relu": (EpilogueFunctor.LinearCombinationRelu, True),
     "cutlass.matmul_bias_gelu": (EpilogueFunctor.LinearCombinationGelu, False),
+    "cutlass.matmul_bias_silu": (EpilogueFunctor.LinearCombinationSilu, False),
     "cutlass.matmul_transposed": (EpilogueFunctor.LinearCombination, False),
     "cutlass.matmul_transposed_bias": (EpilogueFunctor.LinearCombinationBias, True),
     "cutlass.matmul_transposed_bias_relu": (EpilogueFunctor.LinearCombinationRelu, True),
     "cutlass.matmul_transposed_bias_gelu": (EpilogueFunctor.LinearCombinationGelu, False),
+    "cutlass.matmul_transposed_bias_silu": (EpilogueFunctor.LinearCombinationSilu, False),
     "cutlass.batch_matmul": (EpilogueFunctor.LinearCombination, False),
     "cutlass.conv2d_bias_hardswish": (EpilogueFunctor.LinearCombinationHardSwish, False),
     "cutlass.conv2d_bias_silu": (EpilogueFunctor.LinearCombinationSilu, False),
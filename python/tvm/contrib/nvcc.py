@@ -784,6 +784,13 @@ def tvm_callback_cuda_compile(code, target):  # pylint: disable=unused-argument
         - "nvcc": Use nvcc subprocess, generates fatbin
         - "nvrtc": Use NVRTC via cuda-python for faster JIT, generates cubin
 
+    Pass Config
+    -----------
+    cuda.fatbin_archs : list of str
+        With nvcc, the architectures, e.g. ["sm_80", "sm_90"], to embed pre-linked cubins for
+        in the fatbin, so that the driver does not JIT compile PTX when the module is loaded.
+        The PTX of the newest architecture is embedded too, for the GPUs that are newer still.
+
     Parameters
     ----------
     code : str
@@ -801,11 +808,44 @@ def tvm_callback_cuda_compile(code, target):  # pylint: disable=unused-argument
     if compiler == "nvrtc":
         return compile_cuda(code, target_format="cubin", compiler="nvrtc")
     if compiler == "nvcc":
-        return compile_cuda(code, target_format="fatbin", compiler="nvcc")
+        pass_context = tvm_ffi.get_global_func("transform.GetCurrentPassContext")()
+        archs = (
+            pass_context.config["cuda.fatbin_archs"]
+            if "cuda.fatbin_archs" in pass_context.config
+            else None
+        )
+        arch = get_fatbin_gencode(list(archs)) if archs else None
+        return compile_cuda(code, target_format="fatbin", arch=arch, compiler="nvcc")
 
     raise ValueError(f"Invalid TVM_CUDA_COMPILE_MODE: {compiler}. Expected 'nvcc' or 'nvrtc'.")
 
 
+def get_fatbin_gencode(archs):
+    """Get the nvcc options to embed the cubins of several architectures into a fatbin.
+
+    Parameters
+    ----------
+    archs : list of str
+        The architectures, such as "sm_80" or "sm_90a".
+
+    Returns
+    -------
+    gencode : list of str
+        The -gencode options, with the PTX of the newest architecture embedded too.
+    """
+    gencode = []
+    versions = []
+    for arch in archs:
+        if not arch.startswith("sm_"):
+            raise ValueError(f"Expect the architectures in the form sm_XX, but got {arch}")
+        version = arch[len("sm_") :]
+        versions.append(version)
+        gencode += ["-gencode", f"arch=compute_{version},code=sm_{version}"]
+    newest = max(versions, key=lambda v: int("".join(c for c in v if c.isdigit())))
+    gencode += ["-gencode", f"arch=compute_{newest},code=compute_{newest}"]
+    return gencode
+
+
 @tvm_ffi.register_global_func("tvm_callback_libdevice_path")
 def find_libdevice_path(arch):
     """Utility function to find libdevice
@@ -114,4 +114,84 @@ def normal(loc, scale, size):
     )
 
 
+def philox_uniform(seed, offset, low, high, size):
+    """Draw samples from a uniform distribution with the Philox4x32-10 counter-based engine.
+
+    The sample at the position i of the output is the position offset + i of the
+    stream of the seed, regardless of the number of threads or of the device that
+    generate it. Two calls with the same seed and disjoint ranges of the stream draw
+    independent samples, e.g. ``offset`` can advance by the number of samples drawn.
+
+    Parameters
+    ----------
+    seed : int
+        The seed of the stream.
+    offset : int
+        The position in the stream of the first sample.
+    low : float
+        Lower boundary of the output interval.
+    high : float
+        Upper boundary of the output interval, excluded.
+    size : tuple of ints
+        Output shape.
+
+    Returns
+    -------
+    out : Tensor
+        A float32 tensor of the given shape.
+    """
+    return te.extern(
+        size,
+        [],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.random.philox_uniform",
+            int(seed),
+            int(offset),
+            float(low),
+            float(high),
+            outs[0],
+        ),
+        dtype="float32",
+    )
+
+
+def philox_normal(seed, offset, loc, scale, size):
+    """Draw samples from a normal distribution with the Philox4x32-10 counter-based engine.
+
+    The samples are deterministic functions of (seed, offset + i) as for
+    :py:func:`philox_uniform`.
+
+    Parameters
+    ----------
+    seed : int
+        The seed of the stream.
+    offset : int
+        The position in the stream of the first sample.
+    loc : float
+        Mean of the distribution.
+    scale : float
+        Standard deviation of the distribution.
+    size : tuple of ints
+        Output shape.
+
+    Returns
+    -------
+    out : Tensor
+        A float32 tensor of the given shape.
+    """
+    return te.extern(
+        size,
+        [],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.random.philox_normal",
+            int(seed),
+            int(offset),
+            float(loc),
+            float(scale),
+            outs[0],
+        ),
+        dtype="float32",
+    )
+
+
 tvm_ffi.init_ffi_api("tvm.contrib.random")
@@ -0,0 +1,63 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Utilities for the TensorRT runtime."""
+
+import os
+
+_CACHE_DIR_ENV = "TVM_TENSORRT_CACHE_DIR"
+
+
+def build_engine_cache(func, sample_inputs, cache_dir):
+    """Build the TensorRT engines of a compiled model ahead of its deployment.
+
+    The TensorRT runtime builds the engine of a subgraph at its first call, which can
+    take minutes for large subgraphs. With ``TVM_TENSORRT_CACHE_DIR`` set, it saves the
+    engines it builds to that directory, and loads them when the module is initialized.
+
+    This function runs the model once per sample to build and save its engines, e.g.
+    once per batch size to deploy. Deployments running with ``TVM_TENSORRT_CACHE_DIR``
+    set to a copy of ``cache_dir`` then load the engines instead of building them. The
+    engines are keyed by a hash of the subgraph and its weights, the TensorRT version,
+    the GPU architecture and the precision flags, so the cache should be built on the
+    GPU and with the TensorRT version of the deployment.
+
+    Parameters
+    ----------
+    func : Callable
+        The compiled model, e.g. ``relax.VirtualMachine(ex, dev)["main"]``.
+    sample_inputs : List[List[tvm.runtime.Tensor]]
+        The inputs of the runs that build the engines.
+    cache_dir : str
+        The directory to save the engines to.
+
+    Returns
+    -------
+    plans : List[str]
+        The names of the serialized engines in cache_dir.
+    """
+    os.makedirs(cache_dir, exist_ok=True)
+    previous = os.environ.get(_CACHE_DIR_ENV)
+    os.environ[_CACHE_DIR_ENV] = cache_dir
+    try:
+        for inputs in sample_inputs:
+            func(*inputs)
+    finally:
+        if previous is None:
+            del os.environ[_CACHE_DIR_ENV]
+        else:
+            os.environ[_CACHE_DIR_ENV] = previous
+    return sorted(name for name in os.listdir(cache_dir) if name.endswith(".plan"))
@@ -66,6 +66,70 @@ def _convert_bf16_to_f32(value):
     return (data.astype("uint32") << 16).view("float32")
 
 
+# The number of raw bytes of each independently compressed chunk of a compressed shard, which
+# bounds the parallelism of the decompression of a shard and what a parameter read decompresses.
+_COMPRESSION_CHUNK_NBYTES = 4 << 20
+
+
+def _byte_shuffle(data, elem_size):
+    num_elems = len(data) // elem_size
+    planes = np.frombuffer(data, dtype="uint8", count=num_elems * elem_size)
+    return planes.reshape(num_elems, elem_size).T.tobytes() + bytes(data[num_elems * elem_size :])
+
+
+def _byte_unshuffle(data, elem_size):
+    num_elems = len(data) // elem_size
+    planes = np.frombuffer(data, dtype="uint8", count=num_elems * elem_size)
+    return planes.reshape(elem_size, num_elems).T.tobytes() + bytes(data[num_elems * elem_size :])
+
+
+def _import_zstandard():
+    try:
+        import zstandard  # pylint: disable=import-outside-toplevel
+    except ImportError as err:
+        raise ImportError("The zstd compression of the shards requires zstandard") from err
+    return zstandard
+
+
+def _compress_shard(data, byte_shuffle):
+    """Compress the raw data of a shard into independently compressed chunks, each of which
+    is byte-shuffled first if `byte_shuffle` is an element size greater than 1."""
+    compressor = _import_zstandard().ZstdCompressor()
+    compressed = bytearray()
+    chunks = []
+    for begin in range(0, len(data), _COMPRESSION_CHUNK_NBYTES):
+        chunk = bytes(data[begin : begin + _COMPRESSION_CHUNK_NBYTES])
+        if byte_shuffle > 1:
+            chunk = _byte_shuffle(chunk, byte_shuffle)
+        chunk = compressor.compress(chunk)
+        compressed += chunk
+        chunks.append(len(chunk))
+    compression = {
+        "codec": "zstd",
+        "byteShuffle": byte_shuffle,
+        "chunkNbytes": _COMPRESSION_CHUNK_NBYTES,
+        "chunks": chunks,
+    }
+    return compressed, compression
+
+
+def _decompress_shard(data, shard_rec):
+    compression = shard_rec["compression"]
+    if compression["codec"] != "zstd":
+        raise ValueError(f"Unsupported compression of the shards: {compression['codec']}")
+    decompressor = _import_zstandard().ZstdDecompressor()
+    assert sum(compression["chunks"]) == len(data)
+    raw_data = bytearray()
+    offset = 0
+    for nbytes in compression["chunks"]:
+        chunk = decompressor.decompress(data[offset : offset + nbytes])
+        if compression.get("byteShuffle", 0) > 1:
+            chunk = _byte_unshuffle(chunk, compression["byteShuffle"])
+        raw_data += chunk
+        offset += nbytes
+    return bytes(raw_data)
+
+
 def _calculate_md5(filename):
     hash_md5 = hashlib.md5()
     with open(filename, "rb") as file:
@@ -83,8 +147,10 @@ class TensorCacheShardingManager:
         prefix: str,
         shard_cap_nbytes: int,
         initial_shard_records: Mapping[str, Any] | None = None,
+        compression: str | None = None,
     ):
         self.cache_dir = cache_dir
+        self.compression = compression
         self.prefix = prefix
         self.curr_records = []
         self.curr_data = bytearray()
@@ -156,6 +222,8 @@ class TensorCacheShardingManager:
         idx, old_rec = self.name_to_record[name]
         if old_rec["nbytes"] != rec["nbytes"]:
             raise ValueError(f"Cannot update record {name}, size mismatch.")
+        if "compression" in self.shard_records[idx]:
+            raise ValueError(f"Cannot update record {name} in place, its shard is compressed.")
         data_path = self.shard_records[idx]["dataPath"]
         full_path = os.path.join(self.cache_dir, data_path)
         with open(full_path, "r+b") as outfile:
@@ -183,16 +251,21 @@ class TensorCacheShardingManager:
         data_path = f"{self.prefix}_{self.counter}.bin"
         full_path = os.path.join(self.cache_dir, data_path)
         self.counter += 1
-        with open(full_path, "wb") as outfile:
-            outfile.write(data)
-
         shard_record = {
             "dataPath": data_path,
             "format": "raw-shard",
             "nbytes": len(data),
             "records": records,
-            "md5sum": _calculate_md5(full_path),
         }
+        if self.compression == "zstd":
+            # The bytes of the elements are shuffled when the parameters share an element size,
+            # e.g. all bf16, which groups their exponent bytes and compresses them better.
+            elem_sizes = {rec["nbytes"] // max(math.prod(rec["shape"]), 1) for rec in records}
+            byte_shuffle = elem_sizes.pop() if len(elem_sizes) == 1 else 0
+            data, shard_record["compression"] = _compress_shard(data, byte_shuffle)
+        with open(full_path, "wb") as outfile:
+            outfile.write(data)
+        shard_record["md5sum"] = _calculate_md5(full_path)
         self.shard_records.append(shard_record)
 
     @property
@@ -210,6 +283,7 @@ def dump_tensor_cache(
     shard_cap_mb=32,
     show_progress: bool = True,
     update_if_exists: bool = False,
+    compression: str | None = None,
 ):
     """Dump parameters to Tensor cache.
 
@@ -240,9 +314,17 @@ def dump_tensor_cache(
     update_if_exists: bool
         If the cache already exists, update the cache. When set to False, it will overwrite the
         existing files.
+
+    compression: Optional[str]
+        The compression of the shards, "zstd" or None for none. The shards are compressed in
+        independent chunks, which the runtime decompresses in parallel, and the bytes of the
+        elements of the shards whose parameters share an element size, e.g. bf16, are shuffled
+        before the compression. Loading a compressed shard requires TVM built with USE_ZSTD.
     """
     if encode_format not in ("raw", "f32-to-bf16"):
         raise ValueError(f"Invalie encode_format {encode_format}")
+    if compression not in (None, "zstd"):
+        raise ValueError(f"Invalid compression {compression}")
 
     records = []
     from_generator = isinstance(params, GeneratorType)
@@ -267,7 +349,11 @@ def dump_tensor_cache(
             records = old_data["records"]
 
     shard_manager = TensorCacheShardingManager(
-        cache_dir, "params_shard", shard_cap_nbytes, initial_shard_records=records
+        cache_dir,
+        "params_shard",
+        shard_cap_nbytes,
+        initial_shard_records=records,
+        compression=compression,
     )
 
     param_generator = params.items() if not from_generator else params
@@ -356,6 +442,8 @@ def load_tensor_cache(cachepath: str, device: tvm.runtime.Device):
         full_data_path = os.path.join(cachedir, data_path)
         raw_data = open(full_data_path, "rb").read()
         assert shard_rec["format"] == "raw-shard"
+        if "compression" in shard_rec:
+            raw_data = _decompress_shard(raw_data, shard_rec)
         assert shard_rec["nbytes"] == len(raw_data)
 
         for rec in shard_rec["records"]:
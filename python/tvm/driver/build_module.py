@@ -75,6 +75,7 @@ def compile(  # pylint: disable=redefined-builtin
     *,
     relax_pipeline: tvm.transform.Pass | Callable | str | None = "default",
     tir_pipeline: tvm.transform.Pass | Callable | str | None = "default",
+    exec_mode: str = "bytecode",
 ) -> Executable:
     """
     Compile an IRModule to a runtime executable.
@@ -94,6 +95,10 @@ def compile(  # pylint: disable=redefined-builtin
         Only used if the module contains Relax functions.
     tir_pipeline : Optional[Union[tvm.transform.Pass, Callable, str]]
         The compilation pipeline to use for TIR functions.
+    exec_mode : {"bytecode", "compiled"}
+        The execution mode of the Relax functions. "compiled" lowers them ahead of time to
+        native host code that calls the kernels directly, instead of running them in the VM
+        interpreter. Only used if the module contains Relax functions.
 
     Returns
     -------
@@ -107,6 +112,7 @@ def compile(  # pylint: disable=redefined-builtin
             target,
             relax_pipeline=relax_pipeline,
             tir_pipeline=tir_pipeline,
+            exec_mode=exec_mode,
         )
     lib = tvm.tir.build(mod, target, pipeline=tir_pipeline)
     return Executable(lib)
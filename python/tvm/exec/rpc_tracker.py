@@ -25,7 +25,13 @@ from ..rpc.tracker import Tracker
 
 def main(args):
     """Main function"""
-    tracker = Tracker(args.host, port=args.port, port_end=args.port_end, silent=args.silent)
+    tracker = Tracker(
+        args.host,
+        port=args.port,
+        port_end=args.port_end,
+        silent=args.silent,
+        scheduler=args.scheduler,
+    )
     tracker.proc.join()
 
 
@@ -37,6 +43,14 @@ if __name__ == "__main__":
     parser.add_argument("--port", type=int, default=9190, help="The port of the RPC")
     parser.add_argument("--port-end", type=int, default=9199, help="The end search port of the RPC")
     parser.add_argument("--silent", action="store_true", help="Whether run in silent mode.")
+    parser.add_argument(
+        "--scheduler",
+        type=str,
+        default="priority",
+        choices=["priority", "load_balance"],
+        help="The scheduler of the devices of each key, load_balance assigns the faster "
+        "devices first and reports the throughput of each device.",
+    )
     args = parser.parse_args()
     logging.basicConfig(level=logging.INFO)
     main(args)
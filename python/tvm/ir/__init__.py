@@ -28,7 +28,10 @@ from .base import (
     SequentialSpan,
     assert_structural_equal,
     load_json,
+    load_module_binary,
+    module_binary_function_names,
     save_json,
+    save_module_binary,
     structural_equal,
     structural_hash,
 )
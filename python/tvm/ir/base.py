@@ -152,6 +152,62 @@ def save_json(node) -> str:
     return _ffi_node_api.SaveJSON(node)
 
 
+def save_module_binary(mod) -> bytes:
+    """Save an IRModule in the compact binary format.
+
+    The binary format is much smaller and faster to load than the JSON one, and each function
+    is stored on its own, so that :py:func:`load_module_binary` can load only some of them.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The module to be saved.
+
+    Returns
+    -------
+    data : bytes
+        The binary representation of the module.
+    """
+    return bytes(_ffi_node_api.SaveModuleBinary(mod))
+
+
+def load_module_binary(data: bytes, function_names=None):
+    """Load an IRModule saved by :py:func:`save_module_binary`.
+
+    Parameters
+    ----------
+    data : bytes
+        The binary representation of the module.
+
+    function_names : Optional[List[str]]
+        The names of the functions to load, all of them if None. The other functions are not
+        decoded, and are not in the returned module.
+
+    Returns
+    -------
+    mod : IRModule
+        The loaded module.
+    """
+    return _ffi_node_api.LoadModuleBinary(data, function_names)
+
+
+def module_binary_function_names(data: bytes):
+    """The names of the functions of a module saved by :py:func:`save_module_binary`, read
+    without decoding the functions.
+
+    Parameters
+    ----------
+    data : bytes
+        The binary representation of the module.
+
+    Returns
+    -------
+    names : List[str]
+        The names of the functions, in the order of the module.
+    """
+    return list(_ffi_node_api.ModuleBinaryFunctionNames(data))
+
+
 def structural_equal(lhs, rhs, map_free_vars=False):
     """Check structural equality of lhs and rhs.
 
@@ -259,6 +259,60 @@ class PassTimingInstrument(tvm.runtime.Object):
         return _ffi_instrument_api.RenderTimePassProfiles()
 
 
+@tvm_ffi.register_object("instrument.PassInstrument")
+class PassMetricsInstrument(tvm.runtime.Object):
+    """A pass instrument implemented in C++ that measures the time, the memory and the IR size of
+    each pass.
+
+    For each pass invocation, it records the time spent in the pass by itself and with its
+    sub-passes, how much the pass raised the peak resident set size of the process, and the
+    number of statement and expression nodes of each function before and after the pass.
+    """
+
+    def __init__(self):
+        self.__init_handle_by_constructor__(_ffi_instrument_api.MakePassMetricsInstrument)
+
+    @staticmethod
+    def render():
+        """Retrieve the table of the pass metrics, the passes that took the most time by
+        themselves first. Each pass is followed by the functions whose number of nodes changed.
+
+        Returns
+        -------
+        string : string
+            The rendered table of the pass metrics
+
+        Examples
+        --------
+
+        .. code-block:: python
+
+            metrics_inst = PassMetricsInstrument()
+            with tvm.transform.PassContext(instruments=[metrics_inst]):
+                relax_mod = relax.get_pipeline()(relax_mod)
+                # before exiting the context, get the metrics.
+                print(metrics_inst.render())
+        """
+        return _ffi_instrument_api.RenderPassMetrics()
+
+    @staticmethod
+    def get_metrics():
+        """Retrieve the metrics of each pass invocation, in the order the passes were entered.
+
+        Returns
+        -------
+        metrics : List[Dict[str, Union[str, int, float]]]
+            For each pass invocation, its "name", the time spent by itself "self_ms" and with its
+            sub-passes "total_ms", how much it raised the peak resident set size
+            "peak_rss_delta_kb", and the number of nodes of the module "nodes_before" and
+            "nodes_after" the pass.
+        """
+        return [
+            {key: value for key, value in metrics.items()}
+            for metrics in _ffi_instrument_api.GetPassMetrics()
+        ]
+
+
 @pass_instrument
 class PassPrintingInstrument:
     """A pass instrument to print if before or
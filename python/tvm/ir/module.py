@@ -309,3 +309,51 @@ class IRModule(Node, Scriptable):
             attr_map = attr_map._dict()
 
         return _ffi_api.Module_WithAttrs(self, attr_map)
+
+    def parallel_script(self, *, num_threads: int = 0, **kwargs) -> str:
+        """Print the IRModule into TVMScript, printing its functions in parallel.
+
+        The text is the same as the one of :py:meth:`script`, but only the docs of the functions
+        being printed are kept in memory, which makes it faster for the large modules.  The
+        modules that need the metadata, line numbers or underlines are printed by
+        :py:meth:`script`.
+
+        Parameters
+        ----------
+        num_threads : int
+            The number of threads printing the functions, or 0 for all the cores.
+
+        kwargs
+            The options of the printer, the same as the ones of :py:meth:`script`.
+
+        Returns
+        -------
+        script : str
+            The TVMScript of the IRModule.
+        """
+        # pylint: disable=import-outside-toplevel
+        from tvm.runtime.script_printer import PrinterConfig
+
+        func = tvm_ffi.get_global_func("script.printer.IRModuleScriptParallel")
+        return func(self, PrinterConfig(**kwargs), num_threads)
+
+    def write_script(self, path: str, *, num_threads: int = 0, **kwargs) -> None:
+        """Print the IRModule into a TVMScript file, printing its functions in parallel, as
+        :py:meth:`parallel_script` does.  The file is parsed back by `tvm.script.from_source`.
+
+        Parameters
+        ----------
+        path : str
+            The path of the file.
+
+        num_threads : int
+            The number of threads printing the functions, or 0 for all the cores.
+
+        kwargs
+            The options of the printer, the same as the ones of :py:meth:`script`.
+        """
+        # pylint: disable=import-outside-toplevel
+        from tvm.runtime.script_printer import PrinterConfig
+
+        func = tvm_ffi.get_global_func("script.printer.IRModuleScriptToFile")
+        func(self, PrinterConfig(**kwargs), num_threads, path)
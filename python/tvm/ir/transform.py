@@ -44,11 +44,17 @@ class PassInfo(tvm.runtime.Object):
 
     required : List[str]
         The list of passes that are required by a certain pass.
+
+    traceable : bool
+        Whether the pass is traceable.
+
+    thread_safe : bool
+        Whether the function-level pass can transform the functions of a module in parallel.
     """
 
-    def __init__(self, opt_level, name, required=None, traceable=False):
+    def __init__(self, opt_level, name, required=None, traceable=False, thread_safe=False):
         self.__init_handle_by_constructor__(
-            _ffi_transform_api.PassInfo, opt_level, name, required, traceable
+            _ffi_transform_api.PassInfo, opt_level, name, required, traceable, thread_safe
         )
 
 
@@ -47,3 +47,4 @@ from .analysis import (
     well_formed,
 )
 from .estimate_memory_usage import estimate_memory_usage
+from .warmup_shapes import get_warmup_shapes
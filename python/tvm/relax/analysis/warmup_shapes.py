@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""The representative input shapes of the Relax functions, to warm up a VM before traffic."""
+
+import tvm
+from tvm import tir
+from tvm.ir.module import IRModule
+
+from ..expr import Function
+from ..struct_info import TensorStructInfo
+
+
+def get_warmup_shapes(
+    mod: IRModule, var_values: dict[str, int] | None = None
+) -> dict[str, list[tuple[tuple[int, ...], str]]]:
+    """Get the input shapes and dtypes of the public Relax functions of a module, which
+    `VirtualMachine.warmup` runs on dummy inputs of these shapes.
+
+    The symbolic dimensions take their values in `var_values`, or else the upper bounds of the
+    "tir_var_upper_bound" attributes of the functions, i.e. the largest shape bucket. The
+    functions with other parameters than tensors, or with a symbolic dimension without a value,
+    are skipped, and can be given their inputs explicitly.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The Relax module, before it is compiled.
+
+    var_values : Optional[Dict[str, int]]
+        The values of the symbolic variables, by their names, to warm up the other buckets.
+
+    Returns
+    -------
+    shapes : Dict[str, List[Tuple[Tuple[int, ...], str]]]
+        The (shape, dtype) of each parameter, by the global symbols of the functions.
+    """
+    analyzer = tvm.arith.Analyzer()
+    result = {}
+    for _, func in mod.functions_items():
+        if not isinstance(func, Function) or func.attrs is None:
+            continue
+        if "global_symbol" not in func.attrs:
+            continue
+        values = {}
+        if "tir_var_upper_bound" in func.attrs:
+            values.update({k: int(v) for k, v in func.attrs["tir_var_upper_bound"].items()})
+        values.update(var_values or {})
+
+        def _dim(expr, values=values):
+            vmap = {}
+            for var in tir.analysis.undefined_vars(expr):
+                if var.name not in values:
+                    return None
+                vmap[var] = tir.const(values[var.name], var.dtype)
+            expr = analyzer.simplify(tir.stmt_functor.substitute(expr, vmap))
+            return int(expr) if isinstance(expr, tir.IntImm) else None
+
+        args = []
+        for param in func.params:
+            sinfo = param.struct_info
+            if not isinstance(sinfo, TensorStructInfo) or sinfo.shape is None or not sinfo.dtype:
+                break
+            if sinfo.shape.struct_info.values is None:
+                break
+            shape = tuple(_dim(dim) for dim in sinfo.shape.struct_info.values)
+            if any(dim is None for dim in shape):
+                break
+            args.append((shape, sinfo.dtype))
+        else:
+            result[str(func.attrs["global_symbol"])] = args
+    return result
@@ -18,6 +18,7 @@
 """Relax backends"""
 
 from . import contrib, cpu_generic, cuda, gpu_generic, metal, rocm, adreno
+from .dispatch_grouped_gemm import DispatchGroupedGEMM
 from .dispatch_sampling import DispatchSampling
 from .dispatch_sort_scan import DispatchSortScan
 from .pattern_registry import get_pattern, get_patterns_with_prefix
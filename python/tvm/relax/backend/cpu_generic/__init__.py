@@ -18,6 +18,7 @@
 """The Relax CPU backend compilation pipeline and other passes."""
 
 from .pipeline import (
+    conv_chain_fusion_passes,
     finalize_passes,
     get_default_pipeline,
     legalize_passes,
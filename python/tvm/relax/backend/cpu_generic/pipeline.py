@@ -18,6 +18,7 @@
 
 import tvm
 from tvm import relax
+from tvm.relax.dpl import is_op, wildcard
 
 
 def library_dispatch_passes(target: tvm.target.Target):  # pylint: disable=unused-argument
@@ -25,14 +26,51 @@ def library_dispatch_passes(target: tvm.target.Target):  # pylint: disable=unuse
     return []
 
 
+def _conv2d_chain_pattern():
+    conv2d = is_op("relax.nn.conv2d")(wildcard(), wildcard())
+    biased = conv2d | is_op("relax.add")(conv2d, wildcard())
+    activated = (
+        biased
+        | is_op("relax.nn.relu")(biased)
+        | is_op("relax.clip")(biased, wildcard(), wildcard())
+    )
+    return is_op("relax.nn.conv2d")(activated, wildcard())
+
+
+def conv_chain_fusion_passes(target: tvm.target.Target):  # pylint: disable=unused-argument
+    """The passes fusing the chains of two 2D convolutions, e.g. the depthwise and pointwise
+    convolutions of a mobile network, with the bias and activation between them, into one
+    PrimFunc. They run before the legalization passes, when the module is tuned with the
+    RollingBufferFusion schedule rule of meta schedule, which computes the first convolution
+    under the rows of the second one in line buffers. They are not in the default pipeline, as
+    the untuned schedule of the fused PrimFunc does not keep the intermediate tensor in cache.
+    """
+    return [
+        relax.transform.FuseOpsByPattern(
+            [("cpu_generic.conv2d_chain", _conv2d_chain_pattern())],
+            bind_constants=False,
+            annotate_codegen=False,
+        ),
+    ]
+
+
 def legalize_passes(target: tvm.target.Target):  # pylint: disable=unused-argument
-    """The default legalization passes for CPU backend."""
+    """The default legalization passes for CPU backend. The PrimFuncs that are not scheduled yet,
+    e.g. not tuned, get the default CPU schedules of the embedding bags, the transposes and the
+    other injective operators."""
+    from tvm.s_tir import dlight as dl  # pylint: disable=import-outside-toplevel
+
     return [
         tvm.relax.transform.LegalizeOps(),
         tvm.relax.transform.AnnotateTIROpPattern(),
         tvm.relax.transform.FoldConstant(),
         tvm.relax.transform.FuseOps(),
         tvm.relax.transform.FuseTIR(),
+        dl.ApplyDefaultSchedule(
+            dl.cpu.EmbeddingBag(),
+            dl.cpu.Transpose(),
+            dl.cpu.Injective(),
+        ),
     ]
 
 
@@ -40,6 +78,8 @@ def dataflow_lower_passes(target: tvm.target.Target):  # pylint: disable=unused-
     """The default dataflow lowering passes for CPU backend."""
     return [
         relax.transform.RewriteDataflowReshape(),
+        relax.transform.RewriteDataflowSlice(),
+        relax.transform.DataflowUseInplaceCalls(),
         relax.transform.ToNonDataflow(),
         relax.transform.RemovePurityChecking(),
         relax.transform.CallTIRRewrite(),
@@ -31,8 +31,9 @@ from ..patterns import (
     make_matmul_dequantize_pattern,
     make_matmul_multiply_pattern,
     make_matmul_pattern,
+    make_residual_block_pattern,
 )
-from ..utils import has_leaking_intermediate_variables
+from ..utils import has_dependency, has_leaking_intermediate_variables
 
 
 def _is_supported_dtype(lhs_dtype, rhs_dtype, out_dtype):
@@ -128,6 +129,30 @@ def _check_matmul(context: PatternCheckContext) -> bool:
 
     analyzer = Analyzer()
 
+    if "residual" in context.annotated_expr:
+        if lhs_dtype in ["int8", "float8_e4m3fn"]:
+            # The residual is passed as the C matrix of the GEMM, which IGEMM and FP8 GEMM with
+            # the output types supported here do not accept
+            return False
+        residual = context.annotated_expr["residual"]
+        if not isinstance(residual, tvm.relax.Var):
+            if residual not in context.value_to_bound_var:
+                return False
+            residual = context.value_to_bound_var[residual]
+        root_var = context.value_to_bound_var[matmul_call]
+        if has_dependency(from_var=residual, to_var=root_var, var_usages=context.var_usages):
+            return False
+        out_sinfo = context.matched_expr.struct_info
+        if residual.struct_info.dtype != out_sinfo.dtype:
+            return False
+        # cuBLAS only adds a residual of the same shape as the output
+        residual_shape = residual.struct_info.shape.values
+        out_shape = out_sinfo.shape.values
+        if len(residual_shape) != len(out_shape) or not all(
+            analyzer.can_prove_equal(r, o) for r, o in zip(residual_shape, out_shape)
+        ):
+            return False
+
     # cuBLASLt does not seem to support batched GEMM with one of matrices having
     # one batch (with batch_stride 0). So for batched GEMM, the two batch counts
     # must be equal. If lhs is batched but rhs is not, we can use the regular GEMM by
@@ -206,6 +231,31 @@ register_patterns(
             ),
             _check_matmul,
         ),
+        *[
+            (
+                f"cublas.{name}_{activation.split('.')[-1]}",
+                *make_matmul_pattern(
+                    with_bias=False,
+                    activation=activation,
+                    transposed_rhs=transposed_rhs,
+                ),
+                _check_matmul,
+            )
+            for name, transposed_rhs in [("matmul", False), ("matmul_transposed", True)]
+            for activation in ["relax.nn.relu", "relax.nn.gelu"]
+        ],
+        # The residual is passed as the C matrix of the GEMM, and accumulated with beta = 1.
+        *[
+            (
+                f"cublas.{name}{'_bias' if with_bias else ''}_residual_add",
+                *make_residual_block_pattern(
+                    make_matmul_pattern(with_bias=with_bias, transposed_rhs=transposed_rhs)
+                ),
+                _check_matmul,
+            )
+            for name, transposed_rhs in [("matmul", False), ("matmul_transposed", True)]
+            for with_bias in [False, True]
+        ],
         (
             "cublas.matmul_transposed_dequantize",
             *make_matmul_dequantize_pattern(transposed_rhs=True),
@@ -25,6 +25,7 @@ def library_dispatch_passes(target: tvm.target.Target):  # pylint: disable=unuse
     return [
         relax.backend.DispatchSampling(),
         relax.backend.DispatchSortScan(),
+        relax.backend.DispatchGroupedGEMM(),
     ]
 
 
@@ -39,6 +40,7 @@ def legalize_passes(target: tvm.target.Target):  # pylint: disable=unused-argume
         tvm.relax.transform.FuseOps(),
         tvm.relax.transform.FuseTIR(),
         dl.ApplyDefaultSchedule(
+            dl.gpu.EmbeddingBag(),
             dl.gpu.Matmul(),
             dl.gpu.GEMV(),
             dl.gpu.Reduction(),
@@ -52,6 +54,8 @@ def dataflow_lower_passes(target: tvm.target.Target):  # pylint: disable=unused-
     """The default dataflow lowering passes for CUDA backend."""
     return [
         relax.transform.RewriteDataflowReshape(),
+        relax.transform.RewriteDataflowSlice(),
+        relax.transform.DataflowUseInplaceCalls(),
         relax.transform.ToNonDataflow(),
         relax.transform.RemovePurityChecking(),
         relax.transform.CallTIRRewrite(),
@@ -65,6 +69,7 @@ def finalize_passes(target: tvm.target.Target):  # pylint: disable=unused-argume
         relax.transform.RewriteCUDAGraph(),
         relax.transform.LowerAllocTensor(),
         relax.transform.KillAfterLastUse(),
+        relax.transform.AssignStreams(),
         relax.transform.LowerRuntimeBuiltin(),
         relax.transform.ComputePrimValue(),
         relax.transform.VMShapeLower(),
@@ -0,0 +1,92 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, unused-argument, redefined-argument-from-local
+"""Dispatch grouped matmul to the CUTLASS grouped GEMM kernels."""
+
+from tvm import relax
+from tvm.contrib.nvcc import get_target_compute_version, parse_compute_version
+from tvm.ir import Op
+from tvm.ir.module import IRModule
+from tvm.ir.transform import PassContext, module_pass
+from tvm.relax import expr_functor
+from tvm.runtime import get_global_func
+from tvm.target import Target
+
+from .utils import BackendDispatcher
+
+# The workspace of the device-side arguments and of the CUTLASS kernels.
+_CUTLASS_GROUP_GEMM_WORKSPACE_SIZE = 4 * 1024 * 1024
+
+
+def can_use_cutlass_group_gemm(target: Target, dtype: str) -> bool:
+    """Whether grouped matmul can run on the CUTLASS grouped GEMM kernels of a target.
+
+    The kernels need sm90 or later, are built with USE_CUTLASS, and are only used when
+    "cutlass" is in the libs of the target.
+    """
+    if target.kind.name != "cuda" or "cutlass" not in list(target.attrs.get("libs", [])):
+        return False
+    if dtype not in ["float16", "bfloat16"]:
+        return False
+    if not get_global_func("cutlass.group_gemm", allow_missing=True):
+        return False
+    major, _ = parse_compute_version(get_target_compute_version(target))
+    return major >= 9
+
+
+@expr_functor.mutator
+class GroupedGemmDispatcher(BackendDispatcher):
+    """Dispatcher to dispatch grouped matmul."""
+
+    def visit_call_(self, call: relax.Call) -> relax.Expr:
+        if not isinstance(call.op, Op) or call.op.name != "relax.grouped_matmul":
+            return super().visit_call_(call)
+
+        x, weight, indptr = call.args
+        tgt = self._get_target(call.struct_info)
+        _, dtype = self.get_shape_dtype(x)
+        _, indptr_dtype = self.get_shape_dtype(indptr)
+        if not can_use_cutlass_group_gemm(tgt, dtype):
+            return super().visit_call_(call)
+        if indptr_dtype != "int64":
+            indptr = self.builder_.emit(relax.op.astype(indptr, "int64"))
+        workspace = self.builder_.emit(
+            relax.op.builtin.alloc_tensor(
+                relax.ShapeExpr((_CUTLASS_GROUP_GEMM_WORKSPACE_SIZE,)),
+                "uint8",
+                runtime_device_index=0,
+            )
+        )
+        return relax.call_dps_packed(
+            "cutlass.group_gemm", [x, weight, indptr, workspace], out_sinfo=call.struct_info
+        )
+
+
+@module_pass(opt_level=0, name="DispatchGroupedGEMM")
+class DispatchGroupedGEMM:
+    """Pass to dispatch grouped matmul to the CUTLASS grouped GEMM kernels where they apply.
+
+    The other grouped matmuls are legalized to TIR by LegalizeOps.
+    """
+
+    def transform_module(self, mod: IRModule, ctx: PassContext) -> IRModule:
+        dispatcher = GroupedGemmDispatcher(mod)
+        for gv, func in mod.functions_items():
+            if isinstance(func, relax.Function):
+                func = dispatcher.visit_expr(func)
+                dispatcher.builder_.update_func(gv, func)
+        return dispatcher.builder_.finalize()
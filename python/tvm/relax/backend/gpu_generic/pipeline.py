@@ -39,6 +39,7 @@ def legalize_passes(target: tvm.target.Target):  # pylint: disable=unused-argume
         tvm.relax.transform.FuseOps(),
         tvm.relax.transform.FuseTIR(),
         dl.ApplyDefaultSchedule(
+            dl.gpu.EmbeddingBag(),
             dl.gpu.Matmul(),
             dl.gpu.GEMV(),
             dl.gpu.Reduction(),
@@ -52,6 +53,8 @@ def dataflow_lower_passes(target: tvm.target.Target):  # pylint: disable=unused-
     """The default dataflow lowering passes for generic GPU backend."""
     return [
         relax.transform.RewriteDataflowReshape(),
+        relax.transform.RewriteDataflowSlice(),
+        relax.transform.DataflowUseInplaceCalls(),
         relax.transform.ToNonDataflow(),
         relax.transform.RemovePurityChecking(),
         relax.transform.CallTIRRewrite(),
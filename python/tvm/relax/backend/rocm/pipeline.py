@@ -39,6 +39,7 @@ def legalize_passes(target: tvm.target.Target):  # pylint: disable=unused-argume
         tvm.relax.transform.FuseOps(),
         tvm.relax.transform.FuseTIR(),
         dl.ApplyDefaultSchedule(
+            dl.gpu.EmbeddingBag(),
             dl.gpu.Matmul(),
             dl.gpu.GEMV(),
             dl.gpu.Reduction(),
@@ -52,6 +53,8 @@ def dataflow_lower_passes(target: tvm.target.Target):  # pylint: disable=unused-
     """The default dataflow lowering passes for ROCm backend."""
     return [
         relax.transform.RewriteDataflowReshape(),
+        relax.transform.RewriteDataflowSlice(),
+        relax.transform.DataflowUseInplaceCalls(),
         relax.transform.ToNonDataflow(),
         relax.transform.RemovePurityChecking(),
         relax.transform.CallTIRRewrite(),
@@ -62,8 +65,10 @@ def finalize_passes(target: tvm.target.Target):  # pylint: disable=unused-argume
     """The default finalization passes for ROCm backend."""
     return [
         relax.transform.StaticPlanBlockMemory(),
+        relax.transform.RewriteCUDAGraph(),
         relax.transform.LowerAllocTensor(),
         relax.transform.KillAfterLastUse(),
+        relax.transform.AssignStreams(),
         relax.transform.LowerRuntimeBuiltin(),
         relax.transform.ComputePrimValue(),
         relax.transform.VMShapeLower(),
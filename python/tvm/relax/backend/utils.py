@@ -17,8 +17,10 @@
 # pylint: disable=invalid-name
 """Utils for BYOC pattern matching"""
 
+from collections.abc import Mapping, Sequence
+
 from tvm import relax
-from tvm.relax import DataflowVar, PyExprMutator
+from tvm.relax import DataflowVar, PyExprMutator, Var
 from tvm.relax.transform import PatternCheckContext
 from tvm.target import Target
 
@@ -93,3 +95,25 @@ def has_leaking_intermediate_variables(context: PatternCheckContext) -> bool:
             return True
 
     return False
+
+
+def has_dependency(from_var: Var, to_var: Var, var_usages: Mapping[Var, Sequence[Var]]) -> bool:
+    """
+    Check whether `from_var` depends on `to_var`, i.e. is `to_var` itself or one of its
+    transitive users.
+    """
+    if from_var == to_var:
+        return True
+
+    checked = set()
+    vars_to_check = [to_var]
+    while vars_to_check:
+        current_var = vars_to_check.pop()
+        for user in var_usages.get(current_var, []):
+            if user == from_var:
+                return True
+            if user not in checked:
+                checked.add(user)
+                vars_to_check.append(user)
+
+    return False
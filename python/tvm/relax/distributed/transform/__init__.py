@@ -20,6 +20,7 @@
 from .transform import (
     PropagateSharding,
     LowerGlobalViewToLocalView,
+    SimplifyRedistribute,
     LegalizeRedistribute,
     LowerDistIR,
 )
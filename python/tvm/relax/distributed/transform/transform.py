@@ -19,18 +19,34 @@
 
 import tvm.ir
 
+from ..global_info import DeviceMesh
 from . import _ffi_api
 
 
-def PropagateSharding() -> tvm.ir.transform.Pass:
+def PropagateSharding(
+    auto_sharding_mesh: DeviceMesh | None = None, memory_budget: int = 0
+) -> tvm.ir.transform.Pass:
     """Propagate sharding information.
 
+    Parameters
+    ----------
+    auto_sharding_mesh : Optional[DeviceMesh]
+        When given, the functions without sharding annotation are sharded over this device mesh
+        too. A greedy search shards the axis groups of the function, one at a time, by the plan
+        of minimum estimated cost: the compute of each device plus the allreduces that sharded
+        reductions need.
+
+    memory_budget : int
+        The memory, in bytes, that the search tries to keep the parameters and the largest
+        intermediate tensor of a function under on each device, before minimizing the cost.
+        0 means no budget.
+
     Returns
     -------
     ret : tvm.transform.Pass
         The registered pass
     """
-    return _ffi_api.PropagateSharding()  # type: ignore
+    return _ffi_api.PropagateSharding(auto_sharding_mesh, memory_budget)  # type: ignore
 
 
 def LowerGlobalViewToLocalView() -> tvm.ir.transform.Pass:
@@ -44,6 +60,22 @@ def LowerGlobalViewToLocalView() -> tvm.ir.transform.Pass:
     return _ffi_api.LowerGlobalViewToLocalView()  # type: ignore
 
 
+def SimplifyRedistribute() -> tvm.ir.transform.Pass:
+    """Merge and simplify the redistributions of DistIR, so that fewer bytes go through the
+    collectives. It merges the chains of redistribute, cancels the redistributes to the placement
+    a tensor already has, and moves the gathers past the elementwise ops which are their only use.
+    It also fuses an allreduce with the slice of its result each worker keeps into a
+    reduce-scatter, so it is worth running both before LegalizeRedistribute and after
+    LowerGlobalViewToLocalView, which inserts the allreduces.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass
+    """
+    return _ffi_api.SimplifyRedistribute()  # type: ignore
+
+
 def LegalizeRedistribute() -> tvm.ir.transform.Pass:
     """Legalize redistribute op to ccl op.
     S->R: R.ccl.allgather
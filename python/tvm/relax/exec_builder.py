@@ -100,6 +100,11 @@ class ExecBuilder(tvm_ffi.core.Object):
         _ffi_api.ExecBuilderEmitFunction(self, func_name, num_inputs, param_names)  # type: ignore
         return VMFuncScope(lambda: _ffi_api.ExecBuilderEndFunction(self, func_name))  # type: ignore
 
+    def set_kernel_cost(self, func_name: str, flops: float, nbytes: float) -> None:
+        """Record the estimated FLOPs and DRAM bytes of a call of a PrimFunc, from which the
+        profiler reports the achieved throughput of its calls."""
+        _ffi_api.ExecBuilderSetKernelCost(self, func_name, flops, nbytes)  # type: ignore
+
     def _check_scope(self) -> None:
         if len(VMFuncScope.stack) == 0:
             raise ValueError("emit should happen in a function scope")
@@ -17,7 +17,9 @@
 # under the License.
 """LLM support for PyTorch-like API to build IRModules."""
 
-from . import kv_cache, position_embedding
+from . import kv_cache, lora, position_embedding
 from .position_embedding import llama_rope
+from .ring_attn import ring_attn
 from .tree_attn import tree_attn
 from .kv_cache import PagedKVCache
+from .lora import lora_bgmv
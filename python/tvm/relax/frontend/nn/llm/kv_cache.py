@@ -532,6 +532,8 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
         dtype: str,
         target: Target,
         name: str = "paged_kv_cache",
+        kv_dtype: str | None = None,
+        enable_cuda_graph: bool = False,
     ) -> None:
         """Create a paged KV cache object with TIR kernels.
 
@@ -578,6 +580,15 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             Whether to enable disaggregation in the KV cache.
         target : Target
             The target to build the model to.
+        kv_dtype : Optional[str]
+            The data type of the KV data stored in pages, e.g. "float8_e4m3fn".
+            KV data is cast from ``dtype`` when appended and back to ``dtype``
+            when loaded by attention. Defaults to ``dtype``.
+        enable_cuda_graph : bool
+            Whether to create the KV cache in CUDA graph mode, where the auxiliary
+            arrays have fixed device addresses and are synchronized to device in
+            BeginForward, so that attention with unchanged batch size can be captured
+            into CUDA graphs. Sliding window and KV transfer are not supported in this mode.
         """
         rope_scaling = _prepare_yarn_rope_scaling(rope_scaling, rope_theta)
         attn_kind_single = attn_kind[0] if isinstance(attn_kind, list) else attn_kind
@@ -614,7 +625,9 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             rx.op.zeros((), dtype),
             # pylint: disable=line-too-long
             bb.add_func(
-                _kv_cache_transpose_append(num_key_value_heads, qk_head_dim, dtype),
+                _kv_cache_transpose_append(
+                    num_key_value_heads, qk_head_dim, dtype, kv_dtype=kv_dtype
+                ),
                 "kv_cache_transpose_append",
             ),
             bb.add_func(
@@ -631,18 +644,18 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             args.extend(
                 [
                     rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill_ragged_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, v_head_dim, dtype, rope_scaling), "tir_attention_prefill_ragged_cpu")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling), "tir_attention_prefill_cpu")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling), "tir_attention_decode_cpu")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling), "tir_attention_prefill_cpu_sliding_window")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling), "tir_attention_decode_cpu_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, kv_dtype=kv_dtype), "tir_attention_prefill_cpu")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, kv_dtype=kv_dtype), "tir_attention_decode_cpu")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, kv_dtype=kv_dtype), "tir_attention_prefill_cpu_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, kv_dtype=kv_dtype), "tir_attention_decode_cpu_sliding_window")]),
                     rx.Tuple([rx.StringImm("tir"), bb.add_func(tree_attn_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling), "tir_attention_prefill_with_tree_mask_cpu")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(tree_attn_with_paged_kv_cache_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache_cpu")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(tree_attn_with_paged_kv_cache_cpu(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, kv_dtype=kv_dtype), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache_cpu")]),
                     rx.Tuple([]),  # f_mla_prefill
                     rx.Tuple([bb.add_func(_merge_state_inplace_cpu(dtype), "tir_attention_merge_state_cpu")]),
                     bb.add_func(llama_rope_with_position_map(rope_theta, rope_scale, qk_head_dim, num_attention_heads, num_key_value_heads, dtype, rope_scaling, rotary_dim), "tir_split_rotary"),
-                    bb.add_func(_copy_single_page_cpu(num_key_value_heads, page_size, qk_head_dim, dtype), "kv_cache_copy_single_page_cpu"),
-                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype), "kv_cache_debug_get_kv"),
-                    bb.add_func(_compact_kv_copy_cpu(num_key_value_heads, qk_head_dim, dtype), "kv_cache_compact_kv_copy_cpu"),
+                    bb.add_func(_copy_single_page_cpu(num_key_value_heads, page_size, qk_head_dim, kv_dtype or dtype), "kv_cache_copy_single_page_cpu"),
+                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype, kv_dtype), "kv_cache_debug_get_kv"),
+                    bb.add_func(_compact_kv_copy_cpu(num_key_value_heads, qk_head_dim, kv_dtype or dtype), "kv_cache_compact_kv_copy_cpu"),
                 ]
             )
             # fmt: on
@@ -655,11 +668,11 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
             args.append(rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill_ragged(num_key_value_heads if attn_kind_single == "mha" else num_attention_heads, num_attention_heads, ragged_qk_head_dim, ragged_v_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_ragged")]))
             mha_functions = (
                 [
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target), "tir_attention_prefill")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target), "tir_attention_decode")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target), "tir_attention_prefill_sliding_window")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target), "tir_attention_decode_sliding_window")]),
-                    rx.Tuple([rx.StringImm("tir"), bb.add_func(tree_attn_with_paged_kv_cache(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target, kv_dtype=kv_dtype), "tir_attention_prefill")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, False, rope_scaling, target, kv_dtype=kv_dtype), "tir_attention_decode")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_prefill(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target, kv_dtype=kv_dtype), "tir_attention_prefill_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(_attention_decode(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, True, rope_scaling, target, kv_dtype=kv_dtype), "tir_attention_decode_sliding_window")]),
+                    rx.Tuple([rx.StringImm("tir"), bb.add_func(tree_attn_with_paged_kv_cache(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, target, kv_dtype=kv_dtype), "tir_attention_prefill_with_tree_mask_with_paged_kv_cache")]),
                     rx.Tuple([rx.StringImm("tir"), bb.add_func(tree_attn(num_key_value_heads, num_attention_heads, qk_head_dim, dtype, rope_scaling, target), "tir_attention_prefill_with_tree_mask")]),
                 ]
                 if attn_kind_single == "mha"
@@ -677,13 +690,17 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
                 [
                     rx.Tuple(attn_merge_functions),
                     bb.add_func(llama_rope_with_position_map(rope_theta, rope_scale, qk_head_dim, num_attention_heads, num_key_value_heads, dtype, rope_scaling, rotary_dim), "tir_split_rotary"),
-                    bb.add_func(_copy_single_page(num_key_value_heads, page_size, qk_head_dim, dtype, target) if attn_kind_single == "mha" else _copy_single_page_mla(page_size, qk_head_dim, dtype, target), "kv_cache_copy_single_page"),
-                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype), "kv_cache_debug_get_kv"),
-                    bb.add_func(_compact_kv_copy(num_key_value_heads, qk_head_dim, dtype, target), "kv_cache_compact_kv_copy"),
+                    bb.add_func(_copy_single_page(num_key_value_heads, page_size, qk_head_dim, kv_dtype or dtype, target) if attn_kind_single == "mha" else _copy_single_page_mla(page_size, qk_head_dim, dtype, target), "kv_cache_copy_single_page"),
+                    bb.add_func(_kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, qk_head_dim, dtype, kv_dtype), "kv_cache_debug_get_kv"),
+                    bb.add_func(_compact_kv_copy(num_key_value_heads, qk_head_dim, kv_dtype or dtype, target), "kv_cache_compact_kv_copy"),
                 ]
             )
             # fmt: on
             # pylint: enable=line-too-long
+        if kv_dtype is not None or enable_cuda_graph:
+            args.append(rx.DataTypeImm(kv_dtype or dtype))
+        if enable_cuda_graph:
+            args.append(rx.PrimValue(True))
 
         super().__init__(
             _expr=rx.call_pure_packed(
@@ -699,8 +716,11 @@ class TIRPagedKVCache(PagedKVCache):  # pylint: disable=too-few-public-methods
 # pylint: disable=too-many-locals
 
 
-def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size: int = 16):
+def _kv_cache_transpose_append(
+    num_key_value_heads, head_dim, dtype, page_size: int = 16, kv_dtype: str | None = None
+):
     """Return the TIR function that appends new k/v data to PagedKVCache."""
+    kv_dtype = kv_dtype or dtype
 
     # pylint: disable=line-too-long
     # fmt: off
@@ -716,7 +736,7 @@ def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size:
         num_pages = T.int64()
         pages_elem_offset = T.int64()
         position_map_elem_offset = T.int32()
-        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), dtype, elem_offset=pages_elem_offset)
+        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), kv_dtype, elem_offset=pages_elem_offset)
         k_data = T.match_buffer(var_k_data, (ntoken, num_key_value_heads, head_dim), dtype)
         v_data = T.match_buffer(var_v_data, (ntoken, num_key_value_heads, head_dim), dtype)
         position_map = T.match_buffer(
@@ -729,13 +749,13 @@ def _kv_cache_transpose_append(num_key_value_heads, head_dim, dtype, page_size:
                     T.reads(position_map[vgpos], k_data[vgpos, vh, vf])
                     T.writes(pages[position_map[vgpos] // page_size, 0, vh, position_map[vgpos] % page_size, vf])
                     position: T.int32 = position_map[vgpos]  # type: ignore
-                    pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vf] = k_data[vgpos, vh, vf]
+                    pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vf] = k_data[vgpos, vh, vf].astype(kv_dtype)
                 with T.sblock("v_transpose_append"):
                     vgpos, vh, vf = T.axis.remap("SSS", [global_pos, h, f])
                     T.reads(position_map[vgpos], v_data[vgpos, vh, vf])
                     T.writes(pages[position_map[vgpos] // page_size, 1, vh, position_map[vgpos] % page_size, vf])
                     position: T.int32 = position_map[vgpos] # type: ignore[name-defined,no-redef]
-                    pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vf] = v_data[vgpos, vh, vf]
+                    pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vf] = v_data[vgpos, vh, vf].astype(kv_dtype)
     # fmt: on
     # pylint: enable=line-too-long
 
@@ -777,8 +797,11 @@ def _kv_cache_transpose_append_mla(d_qk: int, dtype, page_size: int = 16):
     return tir_kv_cache_transpose_append_mla
 
 
-def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dtype):
+def _kv_cache_debug_get_kv(
+    num_hidden_layers, num_key_value_heads, head_dim, dtype, kv_dtype: str | None = None
+):
     """Return the TIR function that fetches the k/v data on given positions and layer."""
+    kv_dtype = kv_dtype or dtype
 
     # pylint: disable=line-too-long
     # fmt: off
@@ -796,7 +819,7 @@ def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dty
         num_pages = T.int64()
         pages_elem_offset = T.int64()
         position_map_elem_offset = T.int64()
-        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), dtype,elem_offset=pages_elem_offset)
+        pages = T.match_buffer(var_pages, (num_pages, 2, num_key_value_heads, page_size, head_dim), kv_dtype, elem_offset=pages_elem_offset)
         position_map = T.match_buffer(
             var_position_map, (seqlen,), "int32", elem_offset=position_map_elem_offset
         )
@@ -808,8 +831,8 @@ def _kv_cache_debug_get_kv(num_hidden_layers, num_key_value_heads, head_dim, dty
                 T.reads(position_map[vp], pages[position_map[vp] // page_size, 0:2, vh, position_map[vp] % page_size, vd])
                 T.writes(k_data[layer_id, vp, vh, vd], v_data[layer_id, vp, vh, vd])
                 position: T.int32 = position_map[vp] # type: ignore[name-defined]
-                k_data[layer_id, vp, vh, vd] = pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vd]
-                v_data[layer_id, vp, vh, vd] = pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vd]
+                k_data[layer_id, vp, vh, vd] = pages[T.floordiv(position, page_size), 0, vh, T.floormod(position, page_size), vd].astype(dtype)
+                v_data[layer_id, vp, vh, vd] = pages[T.floordiv(position, page_size), 1, vh, T.floormod(position, page_size), vd].astype(dtype)
     # fmt: on
     # pylint: enable=line-too-long
 
@@ -869,9 +892,9 @@ def _rope(
     cos = cos_freq * buffer[indices].astype("float32")
     sin = sin_freq * tir.if_then_else(
         d < rotary_dim // 2,
-        -buffer[indices[:-1] + (d + rotary_dim // 2,)],
-        buffer[indices[:-1] + (d - rotary_dim // 2,)],
-    ).astype("float32")
+        -buffer[indices[:-1] + (d + rotary_dim // 2,)].astype("float32"),
+        buffer[indices[:-1] + (d - rotary_dim // 2,)].astype("float32"),
+    )
     expr = (cos + sin).astype(qkv_dtype)
     for var, value in var_map.items():
         expr = tir.Let(var, value, expr)
@@ -922,8 +945,16 @@ def _get_seq_offset(pos, seq_id, length_info, sliding_window):
 
 
 def _attention_prefill_cpu(
-    h_kv, h_q, d, dtype, sliding_window: bool, rope_scaling: dict[str, Any], page_size: int = 16
+    h_kv,
+    h_q,
+    d,
+    dtype,
+    sliding_window: bool,
+    rope_scaling: dict[str, Any],
+    page_size: int = 16,
+    kv_dtype: str | None = None,
 ):
+    kv_dtype = kv_dtype or dtype
     global_symbol = "batch_prefill_paged_kv_cpu"
     if sliding_window:
         global_symbol += "_sliding_window"
@@ -964,7 +995,7 @@ def _attention_prefill_cpu(
 
         q = T.match_buffer(var_q, (total_len, h_q, d), dtype)
         q_indptr = T.match_buffer(var_q_indptr, (batch_size + 1,), "int32", elem_offset=q_indptr_elem_offset)
-        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, page_size, d), dtype)
+        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, page_size, d), kv_dtype)
         page_indptr = T.match_buffer(var_page_indptr, (batch_size + 1,), "int32", elem_offset=page_indptr_elem_offset)
         page_values = T.match_buffer(var_page_values, (nnz_pages,), "int32", elem_offset=page_values_elem_offset)
         k_rope_pos_offset = T.match_buffer(var_k_rope_pos_offset, (batch_size,), "int32", elem_offset=k_rope_pos_offset_elem_offset)
@@ -1035,9 +1066,9 @@ def _attention_prefill_cpu(
                                     K_local[d_idx] = T.if_then_else(
                                         rotary_mode == 1,
                                         _rope(pages, k_rope_pos_offset[b_idx] + row_idx, d, rope_theta, rope_scale, (page_no, 0, h_qo // group_size, page_offset, d_idx), dtype, rope_scaling),
-                                        pages[page_no, 0, h_qo // group_size, page_offset, d_idx]
+                                        pages[page_no, 0, h_qo // group_size, page_offset, d_idx].astype(dtype)
                                     )
-                                    V_local[d_idx] = pages[page_no, 1, h_qo // group_size, page_offset, d_idx]
+                                    V_local[d_idx] = pages[page_no, 1, h_qo // group_size, page_offset, d_idx].astype(dtype)
 
                                 # Compute S
                                 # Q[i] * K[i] * sm_scale
@@ -1230,7 +1261,9 @@ def _attention_prefill(
     rope_scaling: dict[str, Any],
     target: Target,
     page_size: int = 16,
+    kv_dtype: str | None = None,
 ):
+    kv_dtype = kv_dtype or dtype
     (
         NUM_BLKS,
         LOAD_VEC,
@@ -1281,7 +1314,7 @@ def _attention_prefill(
 
         q = T.match_buffer(var_q, (total_len, h_q, d), dtype)
         q_indptr = T.match_buffer(var_q_indptr, (batch_size + 1,), "int32", elem_offset=q_indptr_elem_offset)
-        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, page_size, d), dtype, elem_offset=pages_elem_offset)
+        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, page_size, d), kv_dtype, elem_offset=pages_elem_offset)
         page_indptr = T.match_buffer(var_page_indptr, (batch_size + 1,), "int32", elem_offset=page_indptr_elem_offset)
         page_values = T.match_buffer(var_page_values, (nnz_pages,), "int32", elem_offset=page_values_elem_offset)
         k_rope_pos_offset = T.match_buffer(var_k_rope_pos_offset, (batch_size,), "int32", elem_offset=k_rope_pos_offset_elem_offset)
@@ -1405,7 +1438,7 @@ def _attention_prefill(
                                                     K_smem[i, j] = T.if_then_else(
                                                         rotary_mode == 1,
                                                         _rope(pages, k_rope_pos_offset[b_idx] + cur_L, d, rope_theta, rope_scale, (page_no, 0, by, page_offset, j), dtype, rope_scaling),
-                                                        pages[page_no, 0, by, page_offset, j]
+                                                        pages[page_no, 0, by, page_offset, j].astype(dtype)
                                                     )
                                                 else:
                                                     K_smem[i, j] = 0.0
@@ -1420,7 +1453,7 @@ def _attention_prefill(
                                                     seq_offset: T.int32(is_size_var=True) = _get_seq_offset(cur_L, b_idx, length_info, sliding_window)  # type: ignore
                                                     page_no: T.int32(is_size_var=True) = page_values[cur_page_indptr_begin + T.floordiv(seq_offset, page_size)]  # type: ignore
                                                     page_offset: T.int32(is_size_var=True) = T.floormod(seq_offset, page_size)  # type: ignore
-                                                    V_smem[i, j] = pages[page_no, 1, by, page_offset, j]
+                                                    V_smem[i, j] = pages[page_no, 1, by, page_offset, j].astype(dtype)
                                                 else:
                                                     V_smem[i, j] = 0.0
                                         T.tvm_storage_sync("shared")
@@ -1531,7 +1564,9 @@ def _attention_decode_cpu(
     sliding_window: bool,
     rope_scaling: dict[str, Any],
     page_size: int = 16,
+    kv_dtype: str | None = None,
 ):
+    kv_dtype = kv_dtype or qkv_dtype
     H_qo = num_qo_heads
     H_kv = num_kv_heads
     D = head_dim
@@ -1570,7 +1605,7 @@ def _attention_decode_cpu(
         length_info_elem_offset = T.int32(is_size_var=True)
 
         Q = T.match_buffer(Q_handle, (B, H_qo, D), qkv_dtype)
-        pages = T.match_buffer(pages_handle, (max_num_pages, 2, H_kv, page_size, D), qkv_dtype)
+        pages = T.match_buffer(pages_handle, (max_num_pages, 2, H_kv, page_size, D), kv_dtype)
         page_table_indptr = T.match_buffer(
             page_table_indptr_handle, (B + 1,), "int32", elem_offset=page_indptr_elem_offset
         )
@@ -1645,7 +1680,7 @@ def _attention_decode_cpu(
                             K_local[d] = T.if_then_else(
                                 rotary_mode == 1,
                                 _rope(pages, k_rope_pos_offset[b] + row_idx, head_dim, rope_theta, rope_scale, (page_no, 0, h_qo // group_size, page_offset, d), qkv_dtype, rope_scaling),
-                                pages[page_no, 0, h_qo // group_size, page_offset, d],
+                                pages[page_no, 0, h_qo // group_size, page_offset, d].astype(qkv_dtype),
                             )
                         S_val[0] = 0.0
                         for d in T.serial(D):
@@ -1664,7 +1699,7 @@ def _attention_decode_cpu(
 
                         m_val[0] = new_m[0]
                         for d in T.serial(D):
-                            V_local[d] = pages[page_no, 1, h_qo // group_size, page_offset, d]
+                            V_local[d] = pages[page_no, 1, h_qo // group_size, page_offset, d].astype(qkv_dtype)
 
                         factor[0] = T.exp2(S_val[0] - m_val[0])
                         for d in T.serial(D):
@@ -1688,7 +1723,9 @@ def _attention_decode(
     rope_scaling: dict[str, Any],
     target: Target,
     page_size: int = 16,
+    kv_dtype: str | None = None,
 ):
+    kv_dtype = kv_dtype or qkv_dtype
     qkv_dtype_bytes = 2
     H_qo = num_qo_heads
     H_kv = num_kv_heads
@@ -1753,7 +1790,7 @@ def _attention_decode(
 
         Q = T.match_buffer(Q_handle, (B, H_qo, D), qkv_dtype)
         pages = T.match_buffer(
-            pages_handle, (max_num_pages, 2, H_kv, page_size, D), qkv_dtype, elem_offset=pages_elem_offset
+            pages_handle, (max_num_pages, 2, H_kv, page_size, D), kv_dtype, elem_offset=pages_elem_offset
         )
         page_table_indptr = T.match_buffer(page_table_indptr_handle, (B + 1,), "int32", elem_offset=page_indptr_elem_offset)
         page_table_values = T.match_buffer(page_table_values_handle, (nnz_pages,), "int32", elem_offset=page_values_elem_offset)
@@ -1842,9 +1879,9 @@ def _attention_decode(
                                                     K_smem[tile_start_s + j, tx * VEC_SIZE + vec] = T.if_then_else(
                                                         rotary_mode == 1,
                                                         _rope(pages, k_rope_pos_offset[batch_idx] + row_g, head_dim, rope_theta, rope_scale, (page_no, 0, by, page_offset, tx * VEC_SIZE + vec), qkv_dtype, rope_scaling),
-                                                        pages[page_no, 0, by, page_offset, tx * VEC_SIZE + vec]
+                                                        pages[page_no, 0, by, page_offset, tx * VEC_SIZE + vec].astype(qkv_dtype)
                                                     )
-                                                    V_smem[tile_start_s + j, tx * VEC_SIZE + vec] = pages[page_no, 1, by, page_offset, tx * VEC_SIZE + vec]
+                                                    V_smem[tile_start_s + j, tx * VEC_SIZE + vec] = pages[page_no, 1, by, page_offset, tx * VEC_SIZE + vec].astype(qkv_dtype)
                                             else:
                                                 for vec in T.vectorized(VEC_SIZE):
                                                     K_smem[tile_start_s + j, tx * VEC_SIZE + vec] = 0.0
@@ -2697,6 +2734,35 @@ def _attention_prefill_ragged(
     return sch.mod["main"].with_attr("tir.is_scheduled", True)
 
 
+def _attention_prefill_ragged_no_rope(
+    h_kv: int,
+    h_q: int,
+    d_qk: int,
+    d_v: int,
+    dtype: str,
+    causal: bool,
+    sm_scale: float,
+    target: Target,
+) -> tir.PrimFunc:
+    """The ragged prefill kernel of the target, with the causal mask and the scale fixed and
+    without rotary embedding, for the attention outside of the KV cache. The kernel computes
+    the softmax online over the tiles of keys, without materializing the attention scores."""
+    if str(target.kind) == "llvm":
+        func = _attention_prefill_ragged_cpu(h_kv, h_q, d_qk, d_v, dtype, {})
+    else:
+        func = _attention_prefill_ragged(h_kv, h_q, d_qk, d_v, dtype, {}, target)
+    causal_var, rotary_mode, rope_scale, rope_theta, sm_scale_var = func.params[-5:]
+    return func.specialize(
+        {
+            causal_var: tir.IntImm("int32", int(causal)),
+            rotary_mode: tir.IntImm("int32", 0),
+            rope_scale: tir.FloatImm("float32", 1.0),
+            rope_theta: tir.FloatImm("float32", 1e4),
+            sm_scale_var: tir.FloatImm("float32", sm_scale),
+        }
+    )
+
+
 def _attention_prefill_mla(
     h_q,
     d_latent,
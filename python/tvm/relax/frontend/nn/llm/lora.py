@@ -0,0 +1,106 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Batched LoRA, which applies a different adapter of the LoRA adapter pool to each token."""
+
+from tvm import te, tir
+from tvm.relax.frontend.nn import Tensor, op
+
+
+def lora_bgmv(
+    x: Tensor,
+    adapter_ids: Tensor,
+    lora_a: Tensor,
+    lora_b: Tensor,
+    scaling: float = 1.0,
+    name: str = "lora_bgmv",
+) -> Tensor:
+    """The batched gather matrix-vector product of LoRA, the low-rank update of each token by the
+    adapter of its request, so that a batch whose requests use different adapters runs in one
+    step. The weights of the adapters are the slots of the weights of the LoRA adapter pool
+    of the runtime, `vm.builtin.lora_adapter_pool_*`, and the slot of each token is gathered
+    from them. The update is computed in two steps, the shrink to the rank of the adapters and
+    the expand from it, accumulated in float32.
+
+    Parameters
+    ----------
+    x : Tensor
+        The input of the layer, of shape (..., d_in).
+
+    adapter_ids : Tensor
+        The slot of the adapter of each token, of shape (n,), int32, with n the number of
+        tokens of x. The tokens of slot -1 use no adapter, and their update is zero.
+
+    lora_a : Tensor
+        The A matrices of the slots, of shape (num_slots, r, d_in). The adapters of a smaller rank
+        are zero-padded to r.
+
+    lora_b : Tensor
+        The B matrices of the slots, of shape (num_slots, d_out, r).
+
+    scaling : float
+        The scale of the update, e.g. alpha / r, when it is not folded into B.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+        The update of the output of the layer, of shape (..., d_out), to be added to the output
+        of the base weight.
+    """
+    *batch_shape, d_in = x.shape
+    _, rank, _ = lora_a.shape
+    _, d_out, _ = lora_b.shape
+    dtype = x.dtype
+
+    def _shrink(x: te.Tensor, adapter_ids: te.Tensor, lora_a: te.Tensor):
+        k = te.reduce_axis((0, d_in), name="k")
+        return te.compute(
+            (x.shape[0], rank),
+            lambda i, j: te.sum(
+                x[i, k].astype("float32")
+                * lora_a[tir.max(adapter_ids[i], 0), j, k].astype("float32"),
+                axis=k,
+            ),
+            name="lora_shrink",
+        )
+
+    def _expand(shrunk: te.Tensor, adapter_ids: te.Tensor, lora_b: te.Tensor):
+        j = te.reduce_axis((0, rank), name="j")
+        update = te.compute(
+            (shrunk.shape[0], d_out),
+            lambda i, o: te.sum(
+                shrunk[i, j] * lora_b[tir.max(adapter_ids[i], 0), o, j].astype("float32"),
+                axis=j,
+            ),
+            name="lora_expand",
+        )
+        return te.compute(
+            update.shape,
+            lambda i, o: tir.Select(
+                adapter_ids[i] >= 0,
+                (update[i, o] * tir.const(scaling, "float32")).astype(dtype),
+                tir.const(0, dtype),
+            ),
+            name="lora_update",
+        )
+
+    x_flat = op.reshape(x, (-1, d_in))
+    shrunk = op.tensor_expr_op(_shrink, f"{name}_shrink", [x_flat, adapter_ids, lora_a])
+    update = op.tensor_expr_op(_expand, f"{name}_expand", [shrunk, adapter_ids, lora_b])
+    return op.reshape(update, (*batch_shape, d_out))
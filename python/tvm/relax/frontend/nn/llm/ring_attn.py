@@ -0,0 +1,167 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Ring attention, which computes attention over a sequence sharded across the workers."""
+
+import math
+
+from tvm import relax as rx
+from tvm import te, tir
+from tvm.relax.frontend.nn import Tensor, op
+from tvm.target import Target
+
+from .kv_cache import (
+    _attention_prefill_ragged_no_rope,
+    _merge_state_inplace,
+    _merge_state_inplace_cpu,
+)
+
+# pylint: disable=too-many-arguments,too-many-locals
+
+
+def _worker_rank() -> tir.Var:
+    """The rank of the worker running the function, as a symbolic variable."""
+    bb = rx.BlockBuilder.current()
+    rank = tir.Var("worker_rank", "int64")
+    value = bb.emit(
+        rx.call_pure_packed("runtime.disco.worker_rank", sinfo_args=rx.PrimStructInfo("int64"))
+    )
+    bb.match_cast(value, rx.PrimStructInfo(value=rank))
+    return rank
+
+
+def ring_attn(
+    q: Tensor,
+    k: Tensor,
+    v: Tensor,
+    num_workers: int,
+    target: Target,
+    sm_scale: float | None = None,
+    causal: bool = False,
+    in_group: bool = True,
+    name: str = "ring_attn",
+) -> Tensor:
+    """Ring attention, the sequence parallel attention of long sequences. The queries, keys
+    and values are sharded along the sequence across the workers, worker i holding the i-th
+    contiguous chunk. At each of the `num_workers` steps, every worker attends its queries to
+    the keys and values it holds, while passing them to the next worker of the ring, and merges
+    the partial results by their log-sum-exp. The exchange of a step runs on the communication
+    stream and overlaps with the attention of the step.
+
+    Parameters
+    ----------
+    q : Tensor
+        The shard of the queries, of shape (b, s, h_q, d).
+
+    k : Tensor
+        The shard of the keys, of shape (b, s_kv, h_kv, d).
+
+    v : Tensor
+        The shard of the values, of shape (b, s_kv, h_kv, d).
+
+    num_workers : int
+        The number of workers of the ring.
+
+    target : Target
+        The target to build the attention kernels for.
+
+    sm_scale : Optional[float]
+        The scale of the attention scores, 1 / sqrt(d) by default.
+
+    causal : bool
+        Whether the attention is causal. It requires s == s_kv. The workers of higher rank then
+        have more keys to attend to, and the blocks of keys that are fully masked for a worker
+        are still computed, then discarded.
+
+    in_group : bool
+        Whether the ring is formed by the workers of the group or by all the workers.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+        The shard of the attention output, of shape (b, s, h_q, d).
+    """
+    b, s_q, h_q, d = q.shape
+    _, s_kv, h_kv, _ = k.shape
+    dtype = q.dtype
+    if sm_scale is None:
+        sm_scale = 1.0 / math.sqrt(d)
+    if causal:
+        assert s_q == s_kv, "Causal ring attention requires queries and keys of the same length."
+
+    def _indptr(x: te.Tensor):
+        return te.compute(
+            (x.shape[0] + 1,), lambda i: (i * x.shape[1]).astype("int32"), name="indptr"
+        )
+
+    def _mask_later_block(lse: te.Tensor, rank: tir.PrimExpr, step: int):
+        # The keys of step `step` come from rank - step, which is later in the sequence than the
+        # queries when the ring wraps around.
+        return te.compute(
+            lse.shape,
+            lambda i, h: tir.Select(step <= rank, lse[i, h], tir.const(-5e4, "float32")),
+            name="mask_later_block",
+        )
+
+    q_flat = op.reshape(q, (b * s_q, h_q, d))
+    k_cur = op.reshape(k, (b * s_kv, h_kv, d))
+    v_cur = op.reshape(v, (b * s_kv, h_kv, d))
+    q_indptr = op.tensor_expr_op(_indptr, f"{name}_indptr", [q])
+    kv_indptr = op.tensor_expr_op(_indptr, f"{name}_indptr", [k])
+    q_rope_position = op.zeros((b * s_q,), "int32")
+    k_rope_pos_offset = op.zeros((b,), "int32")
+    out = [
+        Tensor.placeholder((b * s_q, h_q, d), dtype),
+        Tensor.placeholder((b * s_q, h_q), "float32"),
+    ]
+    if str(target.kind) == "llvm":
+        merge_func = _merge_state_inplace_cpu(dtype)
+    else:
+        merge_func = _merge_state_inplace(h_q, d, dtype, target)
+    rank = _worker_rank() if causal and num_workers > 1 else None
+
+    o = lse = None
+    for step in range(num_workers):
+        if step + 1 < num_workers:
+            k_next = op.ccl_ring_send_recv_start(k_cur, in_group)
+            v_next = op.ccl_ring_send_recv_start(v_cur, in_group)
+        # The keys of step 0 are the worker's own, the only block that is partially masked.
+        prefill_func = _attention_prefill_ragged_no_rope(
+            h_kv, h_q, d, d, dtype, causal and step == 0, sm_scale, target
+        )
+        o_step, lse_step = op.tensor_ir_op(
+            prefill_func,
+            f"{name}_prefill",
+            [q_flat, q_indptr, k_cur, v_cur, kv_indptr, q_rope_position, k_rope_pos_offset],
+            out,
+        )
+        if rank is not None and step > 0:
+            lse_step = op.tensor_expr_op(
+                _mask_later_block, f"{name}_mask", [lse_step, rank, step]
+            )
+        if o is None:
+            o, lse = o_step, lse_step
+        else:
+            o, lse = op.tensor_ir_inplace_op(
+                merge_func, f"{name}_merge", [o, lse, o_step, lse_step], [0, 1], out
+            )
+        if step + 1 < num_workers:
+            k_cur = op.ccl_ring_send_recv_wait(k_cur, k_next, after=o_step)
+            v_cur = op.ccl_ring_send_recv_wait(v_cur, v_next, after=o_step)
+    return op.reshape(o, (b, s_q, h_q, d))
@@ -54,9 +54,9 @@ def _rope(
     cos = cos_freq * buffer[indices].astype("float32")
     sin = sin_freq * tir.if_then_else(
         d < rotary_dim // 2,
-        -buffer[indices[:-1] + (d + rotary_dim // 2,)],
-        buffer[indices[:-1] + (d - rotary_dim // 2,)],
-    ).astype("float32")
+        -buffer[indices[:-1] + (d + rotary_dim // 2,)].astype("float32"),
+        buffer[indices[:-1] + (d - rotary_dim // 2,)].astype("float32"),
+    )
     expr = (cos + sin).astype(qkv_dtype)
     for var, value in var_map.items():
         expr = tir.Let(var, value, expr)
@@ -651,7 +651,9 @@ def tree_attn(h_kv, h_q, d, dtype, rope_scaling: dict[str, Any], target: Target)
     return sch.mod["main"].with_attr("tir.is_scheduled", True)
 
 
-def tree_attn_with_paged_kv_cache_cpu(h_kv, h_q, d, dtype, rope_scaling: dict[str, Any]):
+def tree_attn_with_paged_kv_cache_cpu(
+    h_kv, h_q, d, dtype, rope_scaling: dict[str, Any], kv_dtype: str | None = None
+):
     """Generate tree attention kernel for batched tree attention with paged key-value cache.
 
     Parameters
@@ -666,6 +668,8 @@ def tree_attn_with_paged_kv_cache_cpu(h_kv, h_q, d, dtype, rope_scaling: dict[st
         Data type.
     target : Target
         The target device.
+    kv_dtype : Optional[str]
+        Data type of the KV cache pages. Defaults to ``dtype``.
 
     Returns
     -------
@@ -675,6 +679,8 @@ def tree_attn_with_paged_kv_cache_cpu(h_kv, h_q, d, dtype, rope_scaling: dict[st
     # pylint: disable=import-outside-toplevel
     from .kv_cache import _declare_length_info, _get_kv_chunk_len, _get_seq_offset
 
+    kv_dtype = kv_dtype or dtype
+
     global_symbol = "tree_attn_paged_kv_cpu"
     sliding_window = False
     group_size = h_q // h_kv
@@ -716,7 +722,7 @@ def tree_attn_with_paged_kv_cache_cpu(h_kv, h_q, d, dtype, rope_scaling: dict[st
 
         q = T.match_buffer(var_q, (total_len, h_q, d), dtype)
         q_indptr = T.match_buffer(var_q_indptr, (batch_size + 1,), "int32", elem_offset=q_indptr_elem_offset)
-        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, 16, d), dtype)
+        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, 16, d), kv_dtype)
         page_indptr = T.match_buffer(var_page_indptr, (batch_size + 1,), "int32", elem_offset=page_indptr_elem_offset)
         page_values = T.match_buffer(var_page_values, (nnz_pages,), "int32", elem_offset=page_values_elem_offset)
         k_rope_pos_offset = T.match_buffer(var_k_rope_pos_offset, (batch_size,), "int32", elem_offset=k_rope_pos_offset_elem_offset)
@@ -801,9 +807,9 @@ def tree_attn_with_paged_kv_cache_cpu(h_kv, h_q, d, dtype, rope_scaling: dict[st
                                     K_local[d_idx] = T.if_then_else(
                                         rotary_mode == 1,
                                         _rope(pages, k_rope_pos_offset[b_idx] + row_idx, d, rope_theta, rope_scale, (page_no, 0, h_qo // group_size, page_offset, d_idx), dtype, rope_scaling),
-                                        pages[page_no, 0, h_qo // group_size, page_offset, d_idx]
+                                        pages[page_no, 0, h_qo // group_size, page_offset, d_idx].astype(dtype)
                                     )
-                                    V_local[d_idx] = pages[page_no, 1, h_qo // group_size, page_offset, d_idx]
+                                    V_local[d_idx] = pages[page_no, 1, h_qo // group_size, page_offset, d_idx].astype(dtype)
 
                                 # Compute S
                                 S_val[0] = 0.0
@@ -847,7 +853,7 @@ def tree_attn_with_paged_kv_cache_cpu(h_kv, h_q, d, dtype, rope_scaling: dict[st
 
 
 def tree_attn_with_paged_kv_cache(
-    h_kv, h_q, d, dtype, rope_scaling: dict[str, Any], target: Target
+    h_kv, h_q, d, dtype, rope_scaling: dict[str, Any], target: Target, kv_dtype: str | None = None
 ):
     """Generate tree attention kernel for batched tree attention with paged key-value cache.
 
@@ -863,6 +869,8 @@ def tree_attn_with_paged_kv_cache(
         Data type.
     target : Target
         The target device.
+    kv_dtype : Optional[str]
+        Data type of the KV cache pages. Defaults to ``dtype``.
 
     Returns
     -------
@@ -877,6 +885,8 @@ def tree_attn_with_paged_kv_cache(
         check_thread_limits,
     )
 
+    kv_dtype = kv_dtype or dtype
+
     # pylint: disable=invalid-name, line-too-long
     NUM_BLKS = 16
     LOAD_VEC = 8 // ((DataType(dtype).bits + 7) // 8)  # 8 bytes
@@ -947,7 +957,7 @@ def tree_attn_with_paged_kv_cache(
         q_indptr = T.match_buffer(
             var_q_indptr, (batch_size + 1,), "int32", elem_offset=q_indptr_elem_offset
         )
-        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, 16, d), dtype)
+        pages = T.match_buffer(var_pages, (max_num_pages, 2, h_kv, 16, d), kv_dtype)
         page_indptr = T.match_buffer(
             var_page_indptr, (batch_size + 1,), "int32", elem_offset=page_indptr_elem_offset
         )
@@ -1122,7 +1132,7 @@ def tree_attn_with_paged_kv_cache(
                                                     page_offset: T.int32(is_size_var=True) = T.floormod(seq_offset, 16)  # type: ignore
                                                     K_smem[i, j] = pages[
                                                         page_no, 0, by, page_offset, j
-                                                    ]
+                                                    ].astype(dtype)
                                                 else:
                                                     K_smem[i, j] = 0.0
 
@@ -1139,7 +1149,7 @@ def tree_attn_with_paged_kv_cache(
                                                     page_offset: T.int32(is_size_var=True) = T.floormod(seq_offset, 16)  # type: ignore
                                                     V_smem[i, j] = pages[
                                                         page_no, 1, by, page_offset, j
-                                                    ]
+                                                    ].astype(dtype)
                                                 else:
                                                     V_smem[i, j] = 0.0
                                         T.tvm_storage_sync("shared")
@@ -1973,6 +1973,178 @@ def ccl_allgather(x: Tensor, num_workers: int, name="ccl_allgather"):
     return wrap_nested(_op.ccl.allgather(x._expr, num_workers), name)
 
 
+def ccl_reduce_scatter(
+    x: Tensor,
+    num_workers: int,
+    op_type: str = "sum",
+    in_group: bool = True,
+    name="ccl_reduce_scatter",
+):
+    """CCL ReduceScatter operator
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The input tensor.
+
+    num_workers : int
+      Number of workers.
+
+    op_type : str
+      The type of reduction operation to be applied to the input data.
+      Now "sum", "prod", "min", "max" and "avg" are supported.
+
+    in_group : bool
+      Whether the reduction operation performs globally or in group as default.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+      The shard of the reduced tensor received by the current worker.
+    """
+    return wrap_nested(_op.ccl.reduce_scatter(x._expr, num_workers, op_type, in_group), name)
+
+
+def ccl_all_to_all(x: Tensor, num_workers: int, in_group: bool = True, name="ccl_all_to_all"):
+    """CCL AllToAll operator
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The input tensor.
+
+    num_workers : int
+      Number of workers.
+
+    in_group : bool
+      Whether the all-to-all operation performs globally or in group as default.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+      The result tensor of all-to-all.
+    """
+    return wrap_nested(_op.ccl.all_to_all(x._expr, num_workers, in_group), name)
+
+
+def ccl_moe_dispatch(
+    x: Tensor, num_workers: int, in_group: bool = True, name="ccl_moe_dispatch"
+) -> Tensor:
+    """Dispatch the tokens routed to each expert to the worker holding the expert, in expert
+    parallelism where the experts are sharded along axis 0 over the workers.
+
+    Parameters
+    ----------
+    x : Tensor
+      The tokens of each expert, of shape (experts, capacity, ...).
+
+    num_workers : int
+      The number of workers, which must divide the number of experts.
+
+    in_group : bool
+      Whether the all-to-all operation performs globally or in group as default.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+      The tokens of the local experts from all the workers, of shape
+      (experts / num_workers, num_workers * capacity, ...).
+    """
+    return wrap_nested(_op.ccl.moe_dispatch(x._expr, num_workers, in_group), name)
+
+
+def ccl_moe_combine(
+    x: Tensor, num_workers: int, in_group: bool = True, name="ccl_moe_combine"
+) -> Tensor:
+    """Combine the outputs of the local experts back to the workers of their tokens, the
+    inverse of `ccl_moe_dispatch`.
+
+    Parameters
+    ----------
+    x : Tensor
+      The outputs of the local experts, of shape (local_experts, num_workers * capacity, ...).
+
+    num_workers : int
+      The number of workers.
+
+    in_group : bool
+      Whether the all-to-all operation performs globally or in group as default.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+      The outputs of all the experts for the local tokens, of shape
+      (local_experts * num_workers, capacity, ...).
+    """
+    return wrap_nested(_op.ccl.moe_combine(x._expr, num_workers, in_group), name)
+
+
+def ccl_ring_send_recv_start(
+    x: Tensor, in_group: bool = True, name="ccl_ring_send_recv_start"
+) -> Tensor:
+    """Start sending a tensor to the next worker of the ring, and receiving the one of the
+    previous worker, on the communication stream.
+
+    Parameters
+    ----------
+    x : Tensor
+      The tensor sent to the next worker.
+
+    in_group : bool
+      Whether the ring is formed by the workers of the group or by all the workers.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+      The buffer receiving the tensor of the previous worker, to be read only through
+      `ccl_ring_send_recv_wait`.
+    """
+    return wrap_nested(_op.ccl.ring_send_recv_start(x._expr, in_group), name)
+
+
+def ccl_ring_send_recv_wait(
+    x: Tensor, recv: Tensor, after: Tensor, name="ccl_ring_send_recv_wait"
+) -> Tensor:
+    """Wait for the ring exchange started by `ccl_ring_send_recv_start`, after the computation
+    of `after`, which overlaps with the exchange.
+
+    Parameters
+    ----------
+    x : Tensor
+      The tensor sent by the ring exchange.
+
+    recv : Tensor
+      The result of `ccl_ring_send_recv_start`.
+
+    after : Tensor
+      The tensor whose computation overlaps with the exchange.
+
+    name : str
+        Name hint for this operation.
+
+    Returns
+    -------
+    result : Tensor
+      The tensor received from the previous worker.
+    """
+    return wrap_nested(_op.ccl.ring_send_recv_wait(x._expr, recv._expr, after._expr), name)
+
+
 def ccl_broadcast_from_worker0(x: Tensor, name="broadcast_from_worker"):
     """Broadcast data from worker-0 to all other workers.
 
@@ -2944,3 +3116,203 @@ def renormalize_top_p_top_k_prob(prob, sorted_prob, top_p, top_k):
     )
     renorm_prob = filtered_prob / sum(filtered_prob, axis=1, keepdims=True)
     return renorm_prob
+
+
+def renormalize_min_p_prob(prob: Tensor, min_p: Tensor):
+    """Renormalizes probabilities after filtering out the tokens whose probability
+    is below `min_p` times the largest probability of the row, ensuring they sum up to 1.
+
+    Parameters
+    ----------
+    prob : Tensor
+        A 2-D tensor of shape (batch, vocab_size) representing probability distributions.
+
+    min_p : Tensor
+        The relative probability threshold with shape (batch, 1). A row with min_p 0
+        keeps all of its tokens.
+
+    Returns
+    -------
+    result : Tensor
+        The filtered and nomalized tensor with the sampe shape as input prob.
+    """
+    max_prob = max(prob, axis=1, keepdims=True)
+    filtered_prob = tensor_expr_op(
+        lambda prob, max_prob, min_p: te.compute(
+            prob.shape,
+            lambda i, j: _tir.Select(
+                prob[i, j] >= max_prob[i, 0] * min_p[i, 0], prob[i, j], _tir.const(0, prob.dtype)
+            ),
+            name="filter_with_min_p",
+        ),
+        "filter_with_min_p",
+        args=[prob, max_prob, min_p],
+    )
+    renorm_prob = filtered_prob / sum(filtered_prob, axis=1, keepdims=True)
+    return renorm_prob
+
+
+def softmax_with_temperature(logits: Tensor, temperature: Tensor, eps: float = 1e-5):
+    """Computes the softmax of a batch of logits, each row scaled by its own temperature.
+
+    Parameters
+    ----------
+    logits : Tensor
+        A 2-D tensor of shape (batch, vocab_size).
+
+    temperature : Tensor
+        The temperature with shape (batch, 1). Temperatures below `eps` are clamped to
+        `eps`, which makes the distribution of the row effectively one-hot on its argmax,
+        so greedy and random sampling requests can share one batch.
+
+    eps : float
+        The lower bound of the temperature.
+
+    Returns
+    -------
+    result : Tensor
+        The probability tensor with the same shape as input logits.
+    """
+    scaled_logits = tensor_expr_op(
+        lambda logits, temperature: te.compute(
+            logits.shape,
+            lambda i, j: logits[i, j]
+            / _tir.max(temperature[i, 0], _tir.const(eps, temperature.dtype)),
+            name="scale_with_temperature",
+        ),
+        "scale_with_temperature",
+        args=[logits, temperature],
+    )
+    return softmax(scaled_logits, axis=-1)
+
+
+def apply_penalty_inplace(
+    logits: Tensor,
+    pos2seq_id: Tensor,
+    token_ids: Tensor,
+    token_cnt: Tensor,
+    penalties: Tensor,
+):
+    """Applies the presence, frequency and repetition penalties to a batch of logits
+    in place. The appeared tokens of all rows are packed into flat arrays, so that the
+    penalties of the whole batch are applied by a single kernel on the device.
+
+    Parameters
+    ----------
+    logits : Tensor
+        A 2-D tensor of shape (batch, vocab_size).
+
+    pos2seq_id : Tensor
+        The int32 tensor with shape (num_token,). pos2seq_id[i] is the row of logits
+        which the ith appeared token belongs to.
+
+    token_ids : Tensor
+        The int32 tensor with shape (num_token,) of the appeared token ids. The pairs
+        (pos2seq_id[i], token_ids[i]) must be distinct.
+
+    token_cnt : Tensor
+        The int32 tensor with shape (num_token,). token_cnt[i] is the number of times
+        token_ids[i] has appeared in its row.
+
+    penalties : Tensor
+        The tensor with shape (batch, 3), where each row holds the presence penalty,
+        the frequency penalty and the repetition penalty of the corresponding row of
+        logits. Penalties of 0, 0 and 1 leave the row unchanged.
+
+    Returns
+    -------
+    result : Tensor
+        The penalized logits, which alias the input logits.
+    """
+    dtype = logits.dtype
+
+    @T.prim_func(private=True)
+    def _apply_penalty_inplace(
+        var_logits: T.handle,
+        var_pos2seq_id: T.handle,
+        var_token_ids: T.handle,
+        var_token_cnt: T.handle,
+        var_penalties: T.handle,
+    ):
+        batch, vocab_size = T.int64(is_size_var=True), T.int64(is_size_var=True)
+        num_token = T.int64(is_size_var=True)
+        logits = T.match_buffer(var_logits, (batch, vocab_size), dtype)
+        pos2seq_id = T.match_buffer(var_pos2seq_id, (num_token,), "int32")
+        token_ids = T.match_buffer(var_token_ids, (num_token,), "int32")
+        token_cnt = T.match_buffer(var_token_cnt, (num_token,), "int32")
+        penalties = T.match_buffer(var_penalties, (batch, 3), dtype)
+        for p in range(num_token):
+            with T.sblock("apply_penalty"):
+                vp = T.axis.spatial(num_token, p)
+                logits[pos2seq_id[vp], token_ids[vp]] -= penalties[
+                    pos2seq_id[vp], 0
+                ] + T.Cast(dtype, token_cnt[vp]) * penalties[pos2seq_id[vp], 1]
+                logits[pos2seq_id[vp], token_ids[vp]] = T.if_then_else(
+                    logits[pos2seq_id[vp], token_ids[vp]] <= T.Cast(dtype, 0),
+                    logits[pos2seq_id[vp], token_ids[vp]] * penalties[pos2seq_id[vp], 2],
+                    logits[pos2seq_id[vp], token_ids[vp]] / penalties[pos2seq_id[vp], 2],
+                )
+
+    return tensor_ir_inplace_op(
+        _apply_penalty_inplace,
+        "apply_penalty_inplace",
+        args=[logits, pos2seq_id, token_ids, token_cnt, penalties],
+        inplace_indices=[0],
+        out=Tensor.placeholder(logits.shape, dtype),
+    )
+
+
+def apply_bitmask_inplace(logits: Tensor, seq_ids: Tensor, bitmask: Tensor):
+    """Masks out the tokens disallowed by the packed bitmasks of the constrained decoding,
+    e.g. by a JSON schema or a grammar, in a batch of logits in place, so that the masks are
+    applied on the device and the logits are not copied to the host. The masked logits are set
+    to the lowest value of their dtype, so a fully masked row still has a valid softmax. Apply
+    it before `softmax_with_temperature`.
+
+    Parameters
+    ----------
+    logits : Tensor
+        A 2-D tensor of shape (batch, vocab_size).
+
+    seq_ids : Tensor
+        The int32 tensor with shape (num_seq,). seq_ids[i] is the row of logits which the ith
+        bitmask applies to, so that only the constrained rows of the batch have masks.
+
+    bitmask : Tensor
+        The int32 tensor with shape (num_seq, ceildiv(vocab_size, 32)). Bit j % 32 of
+        bitmask[i, j // 32] is 1 if token j is allowed in row seq_ids[i].
+
+    Returns
+    -------
+    result : Tensor
+        The masked logits, which alias the input logits.
+    """
+    dtype = logits.dtype
+
+    @T.prim_func(private=True)
+    def _apply_bitmask_inplace(
+        var_logits: T.handle,
+        var_seq_ids: T.handle,
+        var_bitmask: T.handle,
+    ):
+        batch, vocab_size = T.int64(is_size_var=True), T.int64(is_size_var=True)
+        num_seq = T.int64(is_size_var=True)
+        logits = T.match_buffer(var_logits, (batch, vocab_size), dtype)
+        seq_ids = T.match_buffer(var_seq_ids, (num_seq,), "int32")
+        bitmask = T.match_buffer(var_bitmask, (num_seq, (vocab_size + 31) // 32), "int32")
+        for i, j in T.grid(num_seq, vocab_size):
+            with T.sblock("apply_bitmask"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                logits[seq_ids[vi], vj] = T.if_then_else(
+                    (bitmask[vi, vj // 32] >> T.Cast("int32", vj % 32)) & 1 == 1,
+                    logits[seq_ids[vi], vj],
+                    T.min_value(dtype),
+                )
+
+    return tensor_ir_inplace_op(
+        _apply_bitmask_inplace,
+        "apply_bitmask_inplace",
+        args=[logits, seq_ids, bitmask],
+        inplace_indices=[0],
+        out=Tensor.placeholder(logits.shape, dtype),
+    )
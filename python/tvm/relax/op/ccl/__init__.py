@@ -17,4 +17,15 @@
 # under the License.
 """CCL related operators."""
 
-from .ccl import allgather, allreduce, broadcast_from_worker0, scatter_from_worker0
+from .ccl import (
+    all_to_all,
+    allgather,
+    allreduce,
+    broadcast_from_worker0,
+    moe_combine,
+    moe_dispatch,
+    reduce_scatter,
+    ring_send_recv_start,
+    ring_send_recv_wait,
+    scatter_from_worker0,
+)
@@ -70,6 +70,158 @@ def allgather(x, num_workers: int, in_group: bool = True):  # pylint: disable=in
     return _ffi_api.allgather(x, num_workers, in_group)  # type: ignore # pylint: disable=no-member
 
 
+def reduce_scatter(x: Expr, num_workers: int, op_type: str = "sum", in_group: bool = True) -> Expr:
+    """ReduceScatter operator. The input tensor is reduced across workers, chunked into
+    equal parts along axis 0, and each worker receives one of the parts.
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The input tensor.
+
+    num_workers : int
+      The number of workers, i.e. the number of parts the reduced tensor is chunked into.
+
+    op_type : str
+      The type of reduction operation to be applied to the input data.
+      Now "sum", "prod", "min", "max" and "avg" are supported.
+
+    in_group : bool
+      Whether the reduction operation performs globally or in group as default.
+
+    Returns
+    -------
+    result : relax.Expr
+      The shard of the reduced tensor received by the current worker.
+    """
+    supported_op_types = ["sum", "prod", "min", "max", "avg"]
+    assert op_type in supported_op_types, (
+        "ReduceScatter only supports limited reduction operations, "
+        f"including {supported_op_types}, but got {op_type}."
+    )
+    return _ffi_api.reduce_scatter(  # type: ignore # pylint: disable=no-member
+        x, op_type, num_workers, in_group
+    )
+
+
+def all_to_all(x: Expr, num_workers: int, in_group: bool = True) -> Expr:
+    """AllToAll operator. The input tensor is chunked into equal parts along axis 0,
+    and the i-th part is sent to worker i, which stores it as the j-th part of its
+    output, where j is the id of the sending worker.
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The input tensor.
+
+    num_workers : int
+      The number of workers, i.e. the number of parts the given tensor is chunked into.
+
+    in_group : bool
+      Whether the all-to-all operation performs globally or in group as default.
+
+    Returns
+    -------
+    result : relax.Expr
+      The result of all-to-all, which has the same shape as the input.
+    """
+    return _ffi_api.all_to_all(x, num_workers, in_group)  # type: ignore # pylint: disable=no-member
+
+
+def moe_dispatch(x: Expr, num_workers: int, in_group: bool = True) -> Expr:
+    """Dispatch the tokens routed to the experts to the workers holding the experts, in
+    expert parallelism. The experts are sharded along axis 0 over the workers. Each worker
+    sends the tokens of the experts of worker j to worker j, and receives the tokens of its
+    own experts from all the workers, the ones of worker i in the i-th part of axis 1.
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The tokens of each expert, of shape (experts, capacity, ...).
+
+    num_workers : int
+      The number of workers, which must divide the number of experts.
+
+    in_group : bool
+      Whether the all-to-all operation performs globally or in group as default.
+
+    Returns
+    -------
+    result : relax.Expr
+      The tokens of the local experts, of shape (experts / num_workers, num_workers * capacity,
+      ...).
+    """
+    return _ffi_api.moe_dispatch(x, num_workers, in_group)  # type: ignore
+
+
+def moe_combine(x: Expr, num_workers: int, in_group: bool = True) -> Expr:
+    """Combine the outputs of the experts back to the workers of their tokens, in expert
+    parallelism. It is the inverse of `moe_dispatch`.
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The outputs of the local experts, of shape (local_experts, num_workers * capacity, ...).
+
+    num_workers : int
+      The number of workers, which must divide axis 1 of the input.
+
+    in_group : bool
+      Whether the all-to-all operation performs globally or in group as default.
+
+    Returns
+    -------
+    result : relax.Expr
+      The outputs of all the experts for the local tokens, of shape
+      (local_experts * num_workers, capacity, ...).
+    """
+    return _ffi_api.moe_combine(x, num_workers, in_group)  # type: ignore
+
+
+def ring_send_recv_start(x: Expr, in_group: bool = True) -> Expr:
+    """Start a step of a ring exchange: each worker sends the input tensor to the next worker
+    of the ring, and receives the one of the previous worker. The exchange runs on the
+    communication stream, and its result must only be read through `ring_send_recv_wait`.
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The input tensor sent to the next worker.
+
+    in_group : bool
+      Whether the ring is formed by the workers of the group or by all the workers.
+
+    Returns
+    -------
+    result : relax.Expr
+      The buffer receiving the tensor of the previous worker.
+    """
+    return _ffi_api.ring_send_recv_start(x, in_group)  # type: ignore # pylint: disable=no-member
+
+
+def ring_send_recv_wait(x: Expr, recv: Expr, after: Expr) -> Expr:
+    """Wait for the ring exchange started by `ring_send_recv_start`. The wait is ordered after
+    the computation of `after`, which can thus overlap with the exchange.
+
+    Parameters
+    ----------
+    x : relax.Expr
+      The input tensor of `ring_send_recv_start`.
+
+    recv : relax.Expr
+      The result of `ring_send_recv_start`.
+
+    after : relax.Expr
+      The tensor whose computation overlaps with the exchange.
+
+    Returns
+    -------
+    result : relax.Expr
+      The tensor received from the previous worker.
+    """
+    return _ffi_api.ring_send_recv_wait(x, recv, after)  # type: ignore # pylint: disable=no-member
+
+
 def broadcast_from_worker0(x: Expr) -> Expr:
     """Broadcast data from worker-0 to all other workers.
 
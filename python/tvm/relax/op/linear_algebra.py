@@ -137,3 +137,31 @@ def outer(x1: Expr, x2: Expr) -> Expr:
         The resulting expression representing the outer product.
     """
     return _ffi_api.outer(x1, x2)
+
+
+def grouped_matmul(x: Expr, weight: Expr, indptr: Expr) -> Expr:
+    """Grouped matrix multiplication, as in mixture-of-experts layers.
+
+    The rows of ``x`` are split into consecutive groups, the group ``g`` ending before
+    the row ``indptr[g]``, and the rows of the group ``g`` are multiplied with
+    ``weight[g]`` transposed. The rows past the last group are zeros. The group sizes
+    are read by the kernel, so ``indptr`` may be computed on the device without any
+    synchronization with the host.
+
+    Parameters
+    ----------
+    x : relax.Expr
+        The rows of all the groups, of shape ``(m, k)``.
+
+    weight : relax.Expr
+        The weight of each group, of shape ``(groups, n, k)``.
+
+    indptr : relax.Expr
+        The end row of each group, an integer tensor of shape ``(groups,)``.
+
+    Returns
+    -------
+    result : relax.Expr
+        The computed result, of shape ``(m, n)``.
+    """
+    return _ffi_api.grouped_matmul(x, weight, indptr)  # type: ignore
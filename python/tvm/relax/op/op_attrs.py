@@ -321,6 +321,21 @@ class AllGatherAttrs(Attrs):
     """Attributes used in allgather operator"""
 
 
+@tvm_ffi.register_object("relax.attrs.ReduceScatterAttrs")
+class ReduceScatterAttrs(Attrs):
+    """Attributes used in reduce_scatter operator"""
+
+
+@tvm_ffi.register_object("relax.attrs.AllToAllAttrs")
+class AllToAllAttrs(Attrs):
+    """Attributes used in all_to_all operator"""
+
+
+@tvm_ffi.register_object("relax.attrs.RingSendRecvAttrs")
+class RingSendRecvAttrs(Attrs):
+    """Attributes used in ring exchange operators"""
+
+
 @tvm_ffi.register_object("relax.attrs.WrapParamAttrs")
 class WrapParamAttrs(Attrs):
     """Attributes used in wrap_param operator"""
@@ -86,15 +86,21 @@ def default_build_pipeline():
             [
                 backend.DispatchSampling(),
                 backend.DispatchSortScan(),
+                backend.DispatchGroupedGEMM(),
                 transform.LegalizeOps(),
+                transform.SpecializePrimFuncShapes(),
                 transform.RewriteDataflowReshape(),
+                transform.RewriteDataflowSlice(),
+                transform.DataflowUseInplaceCalls(),
                 transform.ToNonDataflow(),
                 transform.RemovePurityChecking(),
                 transform.CallTIRRewrite(),
                 transform.StaticPlanBlockMemory(),
+                transform.PlanVTCMStorage(),
                 transform.RewriteCUDAGraph(),
                 transform.LowerAllocTensor(),
                 transform.KillAfterLastUse(),
+                transform.AssignStreams(),
                 transform.LowerRuntimeBuiltin(),
                 transform.ComputePrimValue(),
                 transform.VMShapeLower(),
@@ -209,12 +215,80 @@ def static_shape_tuning_pipeline(
     return _pipeline
 
 
+def dynamic_shape_tuning_pipeline(
+    total_trials: int,
+    target: str | tvm.target.Target,
+    symbolic_var_buckets: dict[str, list[int]],
+    work_dir: str = "tuning_logs",
+    max_trials_per_task: int | None = None,
+):
+    """Tune the dynamic shape model over buckets of its symbolic variables and store the log to
+    database.
+
+    Every TIR function whose shape depends on one of the symbolic variables is specialized to
+    each bucket value by :py:func:`relax.transform.SpecializeSymbolicVarBuckets`, so one schedule
+    is tuned per bucket, and the model dispatches to the specialized functions at runtime. Other
+    values of the variables fall back to the dynamic functions.
+
+    Parameters
+    ----------
+    total_trials : int
+        Total number of trials to run.
+
+    target : Union[str, tvm.target.Target]
+        The target device to tune the model.
+
+    symbolic_var_buckets : Dict[str, List[int]]
+        The representative values to tune for each symbolic variable, e.g.
+        `{"seq_len": [128, 256, 512, 1024]}` for the prefill kernels of an LLM.
+
+    work_dir : str
+        The directory to store the tuning logs.
+
+    max_trials_per_task : Optional[int]
+        The maximum number of trials to run per task. Each bucket is a separate task.
+    """
+
+    @tvm.transform.module_pass(opt_level=0)
+    def _pipeline(mod: tvm.ir.IRModule, _ctx: tvm.transform.PassContext) -> tvm.ir.IRModule:
+        bucketing = [
+            transform.SpecializeSymbolicVarBuckets(var_name, buckets)
+            for var_name, buckets in symbolic_var_buckets.items()
+        ]
+        with tvm.target.Target(target):
+            mod = tvm.transform.Sequential(
+                [
+                    transform.DecomposeOpsForInference(),
+                    transform.CanonicalizeBindings(),
+                    zero_pipeline(),
+                    *bucketing,
+                    # Skip tuning if total_trials is 0
+                    (
+                        transform.MetaScheduleTuneIRMod(
+                            params={},
+                            work_dir=work_dir,
+                            max_trials_global=total_trials,
+                            max_trials_per_task=max_trials_per_task,
+                        )
+                        if total_trials > 0
+                        else tvm.transform.Sequential([])
+                    ),
+                    transform.MetaScheduleApplyDatabase(work_dir),
+                ]
+            )(mod)
+
+        return mod
+
+    return _pipeline
+
+
 # global map of pre-built pipelines
 PIPELINE_MAP = {
     "zero": zero_pipeline,
     "default": default_build_pipeline,
     "default_build": default_build_pipeline,
     "static_shape_tuning": static_shape_tuning_pipeline,
+    "dynamic_shape_tuning": dynamic_shape_tuning_pipeline,
 }
 
 
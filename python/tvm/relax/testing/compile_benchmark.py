@@ -0,0 +1,340 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,missing-docstring
+"""Compile-time benchmark of representative workloads through the lowering pipeline.
+
+Each workload is built with `relax.build` under a PassMetricsInstrument, which records the time
+and memory of each pass. The results can be saved as a baseline and later runs compared against
+it, so that compile-time regressions of individual passes are caught:
+
+.. code-block:: bash
+
+    python -m tvm.relax.testing.compile_benchmark --output baseline.json
+    python -m tvm.relax.testing.compile_benchmark --baseline baseline.json
+"""
+
+import argparse
+import json
+import math
+import sys
+import time
+from collections.abc import Callable
+
+import tvm
+from tvm import relax
+from tvm.ir import IRModule
+from tvm.ir.instrument import PassMetricsInstrument
+from tvm.relax.frontend import nn
+from tvm.relax.frontend.nn import op, spec
+
+
+class _Attention(nn.Module):
+    def __init__(self, hidden_size: int, num_heads: int):
+        self.num_heads = num_heads
+        self.head_dim = hidden_size // num_heads
+        self.q_proj = nn.Linear(hidden_size, hidden_size, bias=False)
+        self.k_proj = nn.Linear(hidden_size, hidden_size, bias=False)
+        self.v_proj = nn.Linear(hidden_size, hidden_size, bias=False)
+        self.o_proj = nn.Linear(hidden_size, hidden_size, bias=False)
+
+    def forward(self, x: nn.Tensor):
+        batch, seq_len, hidden_size = x.shape
+
+        def heads(t):
+            t = t.reshape(batch, seq_len, self.num_heads, self.head_dim)
+            return t.permute_dims(0, 2, 1, 3)
+
+        q, k, v = heads(self.q_proj(x)), heads(self.k_proj(x)), heads(self.v_proj(x))
+        scores = op.matmul(q, k.permute_dims(0, 1, 3, 2)) / math.sqrt(self.head_dim)
+        out = op.matmul(op.softmax(scores, axis=-1), v)
+        out = out.permute_dims(0, 2, 1, 3).reshape(batch, seq_len, hidden_size)
+        return self.o_proj(out)
+
+
+class _LlamaDecoderLayer(nn.Module):
+    def __init__(self, hidden_size: int, num_heads: int, intermediate_size: int):
+        self.input_norm = nn.RMSNorm(hidden_size, axes=-1, bias=False)
+        self.attn = _Attention(hidden_size, num_heads)
+        self.post_attention_norm = nn.RMSNorm(hidden_size, axes=-1, bias=False)
+        self.gate_proj = nn.Linear(hidden_size, intermediate_size, bias=False)
+        self.up_proj = nn.Linear(hidden_size, intermediate_size, bias=False)
+        self.down_proj = nn.Linear(intermediate_size, hidden_size, bias=False)
+
+    def forward(self, x: nn.Tensor):
+        x = x + self.attn(self.input_norm(x))
+        h = self.post_attention_norm(x)
+        return x + self.down_proj(op.silu(self.gate_proj(h)) * self.up_proj(h))
+
+
+class _Llama(nn.Module):
+    def __init__(self, num_layers, hidden_size, num_heads, intermediate_size):
+        self.layers = nn.ModuleList(
+            [
+                _LlamaDecoderLayer(hidden_size, num_heads, intermediate_size)
+                for _ in range(num_layers)
+            ]
+        )
+        self.norm = nn.RMSNorm(hidden_size, axes=-1, bias=False)
+
+    def forward(self, x: nn.Tensor):
+        for layer in self.layers:
+            x = layer(x)
+        return self.norm(x)
+
+
+class _BasicBlock(nn.Module):
+    def __init__(self, in_channels: int, channels: int, stride: int):
+        self.conv1 = nn.Conv2D(in_channels, channels, 3, stride, padding=1, bias=False)
+        self.conv2 = nn.Conv2D(channels, channels, 3, padding=1, bias=False)
+        self.downsample = None
+        if stride != 1 or in_channels != channels:
+            self.downsample = nn.Conv2D(in_channels, channels, 1, stride, bias=False)
+
+    def forward(self, x: nn.Tensor):
+        out = self.conv2(op.relu(self.conv1(x)))
+        identity = x if self.downsample is None else self.downsample(x)
+        return op.relu(out + identity)
+
+
+class _ResNet(nn.Module):
+    def __init__(self, widths, num_classes):
+        self.stem = nn.Conv2D(3, widths[0], 7, stride=2, padding=3, bias=False)
+        blocks = []
+        in_channels = widths[0]
+        for i, channels in enumerate(widths):
+            blocks.append(_BasicBlock(in_channels, channels, stride=1 if i == 0 else 2))
+            blocks.append(_BasicBlock(channels, channels, stride=1))
+            in_channels = channels
+        self.blocks = nn.ModuleList(blocks)
+        self.fc = nn.Linear(in_channels, num_classes)
+
+    def forward(self, x: nn.Tensor):
+        x = op.relu(self.stem(x))
+        for block in self.blocks:
+            x = block(x)
+        _, _, height, width = x.shape
+        return self.fc(op.sum(x, axis=[2, 3]) / float(height * width))
+
+
+class _ViTLayer(nn.Module):
+    def __init__(self, hidden_size: int, num_heads: int, mlp_size: int):
+        self.norm1 = nn.LayerNorm(hidden_size)
+        self.attn = _Attention(hidden_size, num_heads)
+        self.norm2 = nn.LayerNorm(hidden_size)
+        self.fc1 = nn.Linear(hidden_size, mlp_size)
+        self.fc2 = nn.Linear(mlp_size, hidden_size)
+
+    def forward(self, x: nn.Tensor):
+        x = x + self.attn(self.norm1(x))
+        return x + self.fc2(op.gelu(self.fc1(self.norm2(x))))
+
+
+class _ViT(nn.Module):
+    def __init__(self, patch_size, num_layers, hidden_size, num_heads, mlp_size, num_classes):
+        self.patch_embed = nn.Conv2D(3, hidden_size, patch_size, stride=patch_size)
+        self.layers = nn.ModuleList(
+            [_ViTLayer(hidden_size, num_heads, mlp_size) for _ in range(num_layers)]
+        )
+        self.norm = nn.LayerNorm(hidden_size)
+        self.head = nn.Linear(hidden_size, num_classes)
+
+    def forward(self, x: nn.Tensor):
+        x = self.patch_embed(x)
+        batch, hidden_size, height, width = x.shape
+        x = x.reshape(batch, hidden_size, height * width).permute_dims(0, 2, 1)
+        for layer in self.layers:
+            x = layer(x)
+        return self.head(op.sum(self.norm(x), axis=1) / float(height * width))
+
+
+def llama_decoder(
+    num_layers: int = 2,
+    hidden_size: int = 512,
+    num_heads: int = 8,
+    intermediate_size: int = 1376,
+    seq_len: int = 128,
+) -> IRModule:
+    """The decoder layers of a Llama model, for a prefill of `seq_len` tokens."""
+    model = _Llama(num_layers, hidden_size, num_heads, intermediate_size)
+    mod, _ = model.export_tvm(
+        spec={"forward": {"x": spec.Tensor((1, seq_len, hidden_size), "float32")}}
+    )
+    return mod
+
+
+def resnet(widths=(64, 128, 256, 512), num_classes: int = 1000, image_size: int = 224) -> IRModule:
+    """A ResNet-18 with the given widths of its stages."""
+    model = _ResNet(list(widths), num_classes)
+    mod, _ = model.export_tvm(
+        spec={"forward": {"x": spec.Tensor((1, 3, image_size, image_size), "float32")}}
+    )
+    return mod
+
+
+def vit(
+    patch_size: int = 16,
+    num_layers: int = 4,
+    hidden_size: int = 384,
+    num_heads: int = 6,
+    mlp_size: int = 1536,
+    num_classes: int = 1000,
+    image_size: int = 224,
+) -> IRModule:
+    """A vision transformer over `patch_size` x `patch_size` patches."""
+    model = _ViT(patch_size, num_layers, hidden_size, num_heads, mlp_size, num_classes)
+    mod, _ = model.export_tvm(
+        spec={"forward": {"x": spec.Tensor((1, 3, image_size, image_size), "float32")}}
+    )
+    return mod
+
+
+WORKLOADS: dict[str, Callable[..., IRModule]] = {
+    "llama_decoder": llama_decoder,
+    "resnet": resnet,
+    "vit": vit,
+}
+
+
+def _peak_rss_mb() -> float:
+    try:
+        import resource  # pylint: disable=import-outside-toplevel
+    except ImportError:
+        return 0.0
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # ru_maxrss is in bytes on macOS, and in KB elsewhere.
+    return peak / (1024.0 * 1024.0) if sys.platform == "darwin" else peak / 1024.0
+
+
+def benchmark(mod: IRModule, target: str | tvm.target.Target = "llvm", repeat: int = 1) -> dict:
+    """Build `mod` with `relax.build` and measure the time of the build and of each pass.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The workload to build.
+
+    target : Union[str, tvm.target.Target]
+        The target to build for.
+
+    repeat : int
+        The number of builds. The fastest one is reported.
+
+    Returns
+    -------
+    result : dict
+        The wall time of the build "total_ms", the peak resident set size of the process
+        "peak_rss_mb", and for each pass name "passes", the time spent in its invocations by
+        themselves, excluding their sub-passes, in milliseconds.
+    """
+    best = None
+    for _ in range(max(repeat, 1)):
+        metrics = PassMetricsInstrument()
+        with tvm.transform.PassContext(opt_level=3, instruments=[metrics]):
+            start = time.perf_counter()
+            relax.build(mod, target=target)
+            total_ms = (time.perf_counter() - start) * 1000.0
+            records = metrics.get_metrics()
+        if best is not None and best["total_ms"] <= total_ms:
+            continue
+        passes = {}
+        for record in records:
+            passes[record["name"]] = passes.get(record["name"], 0.0) + record["self_ms"]
+        best = {"total_ms": total_ms, "passes": passes}
+    best["peak_rss_mb"] = _peak_rss_mb()
+    return best
+
+
+def compare(
+    result: dict, baseline: dict, tolerance: float = 0.2, min_delta_ms: float = 5.0
+) -> list[str]:
+    """Compare the results of benchmark against a baseline.
+
+    Parameters
+    ----------
+    result : dict
+        The results of the workloads, by workload name.
+
+    baseline : dict
+        The baseline results of the workloads, by workload name. The workloads that are absent
+        from either are not compared.
+
+    tolerance : float
+        The relative slowdown of a build or a pass over the baseline that is a regression.
+
+    min_delta_ms : float
+        The slowdowns smaller than it are not regressions, so that the fast passes do not report
+        noise.
+
+    Returns
+    -------
+    regressions : List[str]
+        The description of each regression.
+    """
+
+    def regressed(value, base):
+        return value > base * (1.0 + tolerance) and value - base >= min_delta_ms
+
+    regressions = []
+    for name in sorted(set(result) & set(baseline)):
+        current, base = result[name], baseline[name]
+        if regressed(current["total_ms"], base["total_ms"]):
+            regressions.append(
+                f"{name}: build took {current['total_ms']:.1f} ms, "
+                f"baseline {base['total_ms']:.1f} ms"
+            )
+        for pass_name, self_ms in sorted(current["passes"].items()):
+            base_ms = base["passes"].get(pass_name)
+            if base_ms is not None and regressed(self_ms, base_ms):
+                regressions.append(
+                    f"{name}: {pass_name} took {self_ms:.1f} ms, baseline {base_ms:.1f} ms"
+                )
+    return regressions
+
+
+def main(argv=None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--workloads", nargs="+", default=list(WORKLOADS), choices=list(WORKLOADS))
+    parser.add_argument("--target", default="llvm")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--output", help="The file to save the results to, e.g. as a baseline.")
+    parser.add_argument("--baseline", help="The file of the results to compare against.")
+    parser.add_argument("--tolerance", type=float, default=0.2)
+    parser.add_argument("--min-delta-ms", type=float, default=5.0)
+    args = parser.parse_args(argv)
+
+    results = {}
+    for name in args.workloads:
+        results[name] = benchmark(WORKLOADS[name](), args.target, args.repeat)
+        slowest = sorted(results[name]["passes"].items(), key=lambda item: -item[1])[:5]
+        print(f"{name}: {results[name]['total_ms']:.1f} ms")
+        for pass_name, self_ms in slowest:
+            print(f"    {pass_name}: {self_ms:.1f} ms")
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, args.tolerance, args.min_delta_ms)
+        for regression in regressions:
+            print(f"REGRESSION {regression}")
+        return 1 if regressions else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -27,7 +27,7 @@ import tvm
 from ..block_builder import BlockBuilder
 from ..expr import Function, TupleGetItem, Var, const
 from ..expr import Tuple as RxTuple
-from ..op import add, divide, multiply, sqrt, subtract
+from ..op import add, concat, divide, multiply, reshape, split, sqrt, subtract
 from ..struct_info import TensorStructInfo, TupleStructInfo
 
 
@@ -41,6 +41,14 @@ class Optimizer:
     name : str
         The name of the optimizer function. This parameter is provided by subclasses.
 
+    fused : bool
+        Whether to update all the parameters at once, as in the multi-tensor optimizers of other
+        frameworks. The parameters, the gradients and the states of the parameters are
+        concatenated into flat tensors, the update is computed once on them, and its results are
+        split back into the tensors of the parameters. The optimizer step then takes a few
+        kernels for any number of parameters, instead of a few kernels for each of them, at the
+        cost of copying the tensors into and out of the flat tensors.
+
     Attributes
     ----------
     dtype : str
@@ -101,11 +109,13 @@ class Optimizer:
 
     dtype: str
     name: str
+    fused: bool
     param_list: list[Var]
     state: tvm.ir.Array
 
-    def __init__(self, name: str) -> None:
+    def __init__(self, name: str, fused: bool = False) -> None:
         self.name = name
+        self.fused = fused
         self.param_list = None
         self.state = None
         self.dtype = None
@@ -175,6 +185,34 @@ class Optimizer:
         if self.param_list is None or self.state is None or self.dtype is None:
             raise RuntimeError("Please call init() for the optimizer before calling get_function()")
 
+    def _use_fused(self) -> bool:
+        """Whether the update of the parameters is fused. A single parameter is never fused, as
+        there is nothing to fuse it with."""
+        return self.fused and len(self.param_list) > 1
+
+    def _emit_flatten(self, builder: BlockBuilder, tuple_var: Var, offset: int, name: str) -> Var:
+        """Concatenate the fields of a tuple of the tensors of the parameters, starting from the
+        given field, flattened, into one 1-D tensor."""
+        flat = [
+            reshape(TupleGetItem(tuple_var, offset + i), (int(np.prod(_get_shape_as_int_list(p))),))
+            for i, p in enumerate(self.param_list)
+        ]
+        return builder.emit(concat(flat, axis=0), name)
+
+    def _emit_unflatten(self, builder: BlockBuilder, flat: Var, suffix: str) -> list[Var]:
+        """Split a flat tensor back into tensors of the shapes of the parameters, named by the
+        parameters with the given suffix."""
+        sizes = [int(np.prod(_get_shape_as_int_list(p))) for p in self.param_list]
+        parts = builder.emit(
+            split(flat, np.cumsum(sizes)[:-1].tolist(), axis=0), "fused" + suffix + "_split"
+        )
+        return [
+            builder.emit(
+                reshape(TupleGetItem(parts, i), _get_shape_as_int_list(p)), p.name_hint + suffix
+            )
+            for i, p in enumerate(self.param_list)
+        ]
+
     def get_function(self) -> Function:
         """Use blockbuilder to construct an optimizer function that executes updates of the
         parameters and the optimizer state.
@@ -261,10 +299,13 @@ class SGD(Optimizer):
 
     weight_decay : float
         weight decay (L2 penalty) (default: 0)
+
+    fused : bool
+        Whether to update all the parameters at once. See `Optimizer`. (default: False)
     """
 
-    def __init__(self, lr: float, weight_decay: float = 0) -> None:
-        super().__init__("SGD")
+    def __init__(self, lr: float, weight_decay: float = 0, fused: bool = False) -> None:
+        super().__init__("SGD", fused)
         self.lr = float(lr)
         self.weight_decay = float(weight_decay)
 
@@ -333,14 +374,21 @@ class SGD(Optimizer):
                 state_list_new.append(num_steps_new)
 
                 # computation logics
-                for i in range(len_param):
-                    name = self.param_list[i].name_hint
-                    p = builder.emit(TupleGetItem(param_var, i), name)
-                    g = builder.emit(TupleGetItem(grad_var, i), name + "_grad")
+                def update(name, p, g):
                     if self.weight_decay:
                         g = builder.emit(add(multiply(weight_decay, p), g), name + "_grad_new")
-                    p_new = builder.emit(subtract(p, multiply(lr, g)), name + "_new")
-                    param_list_new.append(p_new)
+                    return builder.emit(subtract(p, multiply(lr, g)), name + "_new")
+
+                if self._use_fused():
+                    p = self._emit_flatten(builder, param_var, 0, "fused")
+                    g = self._emit_flatten(builder, grad_var, 0, "fused_grad")
+                    param_list_new = self._emit_unflatten(builder, update("fused", p, g), "_new")
+                else:
+                    for i in range(len_param):
+                        name = self.param_list[i].name_hint
+                        p = builder.emit(TupleGetItem(param_var, i), name)
+                        g = builder.emit(TupleGetItem(grad_var, i), name + "_grad")
+                        param_list_new.append(update(name, p, g))
 
                 # handle return values
                 params_new = builder.emit_output(RxTuple(param_list_new), "params_new")
@@ -392,6 +440,9 @@ class MomentumSGD(Optimizer):
 
     nesterov : bool
         enables Nesterov momentum (default: False)
+
+    fused : bool
+        Whether to update all the parameters at once. See `Optimizer`. (default: False)
     """
 
     def __init__(
@@ -401,8 +452,9 @@ class MomentumSGD(Optimizer):
         dampening: float = 0,
         weight_decay: float = 0,
         nesterov: bool = False,
+        fused: bool = False,
     ) -> None:
-        super().__init__("MomentumSGD")
+        super().__init__("MomentumSGD", fused)
         self.lr = float(lr)
         self.momentum = float(momentum)
         self.weight_decay = float(weight_decay)
@@ -484,11 +536,7 @@ class MomentumSGD(Optimizer):
                 state_list_new.append(num_steps_new)
 
                 # computation logics
-                for i in range(len_param):
-                    name = self.param_list[i].name_hint
-                    p = builder.emit(TupleGetItem(param_var, i), name)
-                    g = builder.emit(TupleGetItem(grad_var, i), name + "_grad")
-                    v = builder.emit(TupleGetItem(state_var, i + 1), name + "_v")
+                def update(name, p, g, v):
                     if self.weight_decay:
                         g = builder.emit(add(multiply(weight_decay, p), g), name + "_grad_new")
                     damp_g = multiply(dampening_inv, g) if self.dampening else g
@@ -499,8 +547,24 @@ class MomentumSGD(Optimizer):
                         else v_new
                     )
                     p_new = builder.emit(subtract(p, multiply(lr, g_new)), name + "_new")
-                    param_list_new.append(p_new)
-                    state_list_new.append(v_new)
+                    return p_new, v_new
+
+                if self._use_fused():
+                    p = self._emit_flatten(builder, param_var, 0, "fused")
+                    g = self._emit_flatten(builder, grad_var, 0, "fused_grad")
+                    v = self._emit_flatten(builder, state_var, 1, "fused_v")
+                    p_new, v_new = update("fused", p, g, v)
+                    param_list_new = self._emit_unflatten(builder, p_new, "_new")
+                    state_list_new += self._emit_unflatten(builder, v_new, "_v_new")
+                else:
+                    for i in range(len_param):
+                        name = self.param_list[i].name_hint
+                        p = builder.emit(TupleGetItem(param_var, i), name)
+                        g = builder.emit(TupleGetItem(grad_var, i), name + "_grad")
+                        v = builder.emit(TupleGetItem(state_var, i + 1), name + "_v")
+                        p_new, v_new = update(name, p, g, v)
+                        param_list_new.append(p_new)
+                        state_list_new.append(v_new)
 
                 # handle return values
                 params_new = builder.emit_output(RxTuple(param_list_new), "params_new")
@@ -556,6 +620,9 @@ class Adam(Optimizer):
 
     weight_decay : float
         weight decay (L2 penalty) (default: 0)
+
+    fused : bool
+        Whether to update all the parameters at once. See `Optimizer`. (default: False)
     """
 
     def __init__(
@@ -564,8 +631,9 @@ class Adam(Optimizer):
         betas: tuple[float, float] = (0.9, 0.999),
         eps: float = 1e-08,
         weight_decay: float = 0,
+        fused: bool = False,
     ) -> None:
-        super().__init__("Adam")
+        super().__init__("Adam", fused)
         self.lr = float(lr)
         self.beta1 = float(betas[0])
         self.beta2 = float(betas[1])
@@ -679,12 +747,7 @@ class Adam(Optimizer):
                 state_list_new[2] = beta2_prod
 
                 # computation logics
-                for i in range(len_param):
-                    name = self.param_list[i].name_hint
-                    p = builder.emit(TupleGetItem(param_var, i), name)
-                    g = builder.emit(TupleGetItem(grad_var, i), name + "_grad")
-                    m = builder.emit(TupleGetItem(state_var, i + 3), name + "_m")
-                    v = builder.emit(TupleGetItem(state_var, i + 3 + len_param), name + "_v")
+                def update(name, p, g, m, v):
                     if self.weight_decay:
                         g = builder.emit(add(multiply(weight_decay, p), g), name + "_grad_new")
                     m_new = builder.emit(
@@ -704,9 +767,29 @@ class Adam(Optimizer):
                         subtract(p, multiply(lr, divide(m_hat, add(sqrt(v_hat), eps)))),
                         name + "_new",
                     )
-                    param_list_new.append(p_new)
-                    state_list_new[i + 3] = m_new
-                    state_list_new[i + 3 + len_param] = v_new
+                    return p_new, m_new, v_new
+
+                if self._use_fused():
+                    p = self._emit_flatten(builder, param_var, 0, "fused")
+                    g = self._emit_flatten(builder, grad_var, 0, "fused_grad")
+                    m = self._emit_flatten(builder, state_var, 3, "fused_m")
+                    v = self._emit_flatten(builder, state_var, 3 + len_param, "fused_v")
+                    p_new, m_new, v_new = update("fused", p, g, m, v)
+                    param_list_new = self._emit_unflatten(builder, p_new, "_new")
+                    m_list_new = self._emit_unflatten(builder, m_new, "_m_new")
+                    v_list_new = self._emit_unflatten(builder, v_new, "_v_new")
+                    state_list_new[3:] = m_list_new + v_list_new
+                else:
+                    for i in range(len_param):
+                        name = self.param_list[i].name_hint
+                        p = builder.emit(TupleGetItem(param_var, i), name)
+                        g = builder.emit(TupleGetItem(grad_var, i), name + "_grad")
+                        m = builder.emit(TupleGetItem(state_var, i + 3), name + "_m")
+                        v = builder.emit(TupleGetItem(state_var, i + 3 + len_param), name + "_v")
+                        p_new, m_new, v_new = update(name, p, g, m, v)
+                        param_list_new.append(p_new)
+                        state_list_new[i + 3] = m_new
+                        state_list_new[i + 3 + len_param] = v_new
 
                 # handle return values
                 params_new = builder.emit_output(RxTuple(param_list_new), "params_new")
@@ -22,8 +22,10 @@ from .transform import (
     AllocateWorkspace,
     AlterOpImpl,
     AnnotateTIROpPattern,
+    AssignStreams,
     AttachAttrLayoutFreeBuffers,
     AttachGlobalSymbol,
+    AutoConvertLayout,
     BindParams,
     BindSymbolicVars,
     BundleModelParams,
@@ -49,6 +51,7 @@ from .transform import (
     FuseTIR,
     FusionPattern,
     Gradient,
+    HorizontalFuseOps,
     InlinePrivateFunctions,
     KillAfterLastUse,
     LambdaLift,
@@ -65,7 +68,9 @@ from .transform import (
     Normalize,
     NormalizeGlobalVar,
     PatternCheckContext,
+    PlanVTCMStorage,
     RealizeVDevice,
+    Rematerialize,
     RemovePurityChecking,
     RemoveUnusedOutputs,
     RemoveUnusedParameters,
@@ -73,6 +78,7 @@ from .transform import (
     ReorderTakeAfterMatmul,
     RewriteCUDAGraph,
     RewriteDataflowReshape,
+    RewriteDataflowSlice,
     RunCodegen,
     SplitCallTIRByPattern,
     SplitLayoutRewritePreproc,
@@ -85,19 +91,24 @@ from .transform import (
     VMBuiltinLower,
     VMShapeLower,
     SpecializePrimFuncBasedOnCallSite,
+    SpecializePrimFuncShapes,
     dataflowblock_pass,
     function_pass,
 )
 
 from .attach_external_modules import AttachExternModules
 from .fast_math import FastMathTransform
+from .fuse_embedding_bag import FuseEmbeddingBag
 from .fuse_transpose_matmul import FuseTransposeMatmul
 from .ipc_allreduce_rewrite import IPCAllReduceRewrite
 from .lazy_transform_params import LazyTransformParams
 from .lower_gpu_ipc_alloc_storage import LowerGPUIPCAllocStorage
 from .optimize_layout_transform import OptimizeLayoutTransform
+from .quantize_weights import QuantizeWeights
+from .sparsify_weights import SparsifyWeights
 from .fold_batch_norm_to_conv2d_for_inference import FoldBatchnormToConv2D
 from .remove_redundant_reshape import RemoveRedundantReshape
+from .specialize_symbolic_var_buckets import SpecializeSymbolicVarBuckets
 
 # Import to register the legalization functions.
 from . import legalize_ops
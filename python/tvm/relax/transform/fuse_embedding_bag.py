@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Fusion of the gathers of the embedding rows and their pooling into embedding bags."""
+
+import tvm
+from tvm import relax, topi
+from tvm.ir.module import IRModule
+from tvm.relax.expr_functor import PyExprMutator, mutator
+
+
+@tvm.transform.module_pass(opt_level=0, name="FuseEmbeddingBag")
+class FuseEmbeddingBag:
+    """Rewrite the sums and means over the bag axis of the rows gathered from an embedding
+    table, i.e. `R.sum(R.take(weight, indices, axis=0), axis=[-2])` with the bags of indices of
+    shape (..., bag_size), into the embedding bag kernels of `topi.nn.embedding_bag`, which
+    pool the gathered rows without materializing them.
+
+    The kernels are scheduled by the `EmbeddingBag` rules of dlight in the default pipelines,
+    which prefetch the gathered rows on CPU and pool each bag by a warp on GPU. Only the takes
+    of the "fast" mode are rewritten, as the negative indices are the padding of the bags in
+    the kernels. The gathered rows of half precision are accumulated in float32. Run the pass
+    before LegalizeOps.
+    """
+
+    def transform_module(self, mod: IRModule, _ctx: tvm.transform.PassContext) -> IRModule:
+        """IRModule-level transformation"""
+        fuser = _EmbeddingBagFuser(mod)
+        for g_var, func in mod.functions_items():
+            if not isinstance(func, relax.Function) or "Codegen" in (func.attrs or {}):
+                continue
+            new_func = fuser.visit_expr(func)
+            if not new_func.same_as(func):
+                new_func = relax.analysis.remove_all_unused(new_func)
+            fuser.builder_.update_func(g_var, new_func)
+        return fuser.builder_.get()
+
+
+# pylint: disable=missing-docstring,invalid-name
+
+
+@mutator
+class _EmbeddingBagFuser(PyExprMutator):  # pylint: disable=abstract-method
+    def __init__(self, mod: IRModule):
+        super().__init__(mod)
+        self.take_op = tvm.ir.Op.get("relax.take")
+        self.pool_ops = {tvm.ir.Op.get("relax.sum"): "sum", tvm.ir.Op.get("relax.mean"): "mean"}
+
+    def visit_call_(self, call: relax.Call) -> relax.Expr:  # pylint: disable=arguments-renamed
+        call = self.builder_.normalize(super().visit_call_(call))
+        if call.op not in self.pool_ops or call.attrs.keepdims or call.attrs.axis is None:
+            return call
+        if not isinstance(call.args[0], relax.Var):
+            return call
+        take = self.lookup_binding(call.args[0])
+        if not isinstance(take, relax.Call) or take.op != self.take_op:
+            return call
+        if take.attrs.mode != "fast" or take.attrs.axis is None:
+            return call
+        weight, indices = take.args
+        weight_sinfo, indices_sinfo = weight.struct_info, indices.struct_info
+        if not isinstance(weight_sinfo, relax.TensorStructInfo) or not isinstance(
+            indices_sinfo, relax.TensorStructInfo
+        ):
+            return call
+        if weight_sinfo.ndim != 2 or weight_sinfo.dtype not in ["float16", "bfloat16", "float32"]:
+            return call
+        if indices_sinfo.ndim < 2 or not indices_sinfo.dtype.startswith("int"):
+            return call
+        if int(take.attrs.axis) not in (0, -2):
+            return call
+        # The bag axis of the gathered rows is the last axis of the indices.
+        ndim = indices_sinfo.ndim + 1
+        if len(call.attrs.axis) != 1 or int(call.attrs.axis[0]) % ndim != ndim - 2:
+            return call
+        return self.builder_.call_te(
+            topi.nn.embedding_bag,
+            weight,
+            indices,
+            mode=self.pool_ops[call.op],
+            primfunc_name_hint="embedding_bag",
+        )
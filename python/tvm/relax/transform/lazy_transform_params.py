@@ -364,6 +364,11 @@ class LazyTransformParams:
         The given parameters will be placed before index and value.
         For example, if extra_set_item_params is [param1, param2], then the pass will generate
         call_packed(fset_item, [param1, param2, index, value])
+
+    To stream the parameters from a Tensor cache, use
+    ``fget_item="vm.builtin.tensor_cache.stream_get"`` with the stream created by
+    ``vm.builtin.tensor_cache.stream_create`` as the only extra get_item parameter. The stream
+    reads the next parameters from disk while the current one is transformed.
     """
 
     def __init__(
@@ -74,6 +74,100 @@ def _allgather(_bb: BlockBuilder, call: Call) -> Expr:
     )
 
 
+@register_legalize("relax.ccl.reduce_scatter")
+def _reduce_scatter(_bb: BlockBuilder, call: Call) -> Expr:
+    op_type_str = call.attrs.op_type
+    op_type_map = {
+        "sum": 0,
+        "prod": 1,
+        "min": 2,
+        "max": 3,
+        "avg": 4,
+    }
+    if op_type_str not in op_type_map:
+        raise ValueError(
+            f"Unsupported reduction operation: {op_type_str}. "
+            f"Supported operations are {op_type_map.keys()}."
+        )
+    return call_dps_packed(
+        "runtime.disco.reduce_scatter",
+        [call.args[0], ShapeExpr([op_type_map[op_type_str]]), call.attrs.in_group],
+        out_sinfo=call.struct_info,
+    )
+
+
+@register_legalize("relax.ccl.all_to_all")
+def _all_to_all(_bb: BlockBuilder, call: Call) -> Expr:
+    # Empty split sizes make the runtime exchange equal chunks along axis 0.
+    return call_dps_packed(
+        "runtime.disco.all_to_all",
+        [call.args[0], ShapeExpr([]), ShapeExpr([]), call.attrs.in_group],
+        out_sinfo=call.args[0].struct_info,
+    )
+
+
+def _all_to_all_equal_chunks(_bb: BlockBuilder, expr: Expr, in_group: bool) -> Expr:
+    return _bb.emit(
+        call_dps_packed(
+            "runtime.disco.all_to_all",
+            [expr, ShapeExpr([]), ShapeExpr([]), in_group],
+            out_sinfo=expr.struct_info,
+        )
+    )
+
+
+@register_legalize("relax.ccl.moe_dispatch")
+def _moe_dispatch(_bb: BlockBuilder, call: Call) -> Expr:
+    # (E, C, ...) -> (n, E / n, C, ...), whose i-th chunk goes to worker i. The chunks received
+    # are then interleaved into axis 1: (E / n, n * C, ...).
+    num_workers = call.attrs.num_workers
+    num_experts, capacity, *rest = call.args[0].struct_info.shape.values
+    x = _bb.emit_te(
+        topi.reshape,
+        call.args[0],
+        [num_workers, tir.div(num_experts, num_workers), capacity] + rest,
+    )
+    x = _all_to_all_equal_chunks(_bb, x, call.attrs.in_group)
+    x = _bb.emit_te(topi.transpose, x, [1, 0] + list(range(2, len(rest) + 3)))
+    return _bb.call_te(topi.reshape, x, call.struct_info.shape.values)
+
+
+@register_legalize("relax.ccl.moe_combine")
+def _moe_combine(_bb: BlockBuilder, call: Call) -> Expr:
+    # The inverse of moe_dispatch: (E / n, n * C, ...) -> (n, E / n, C, ...), whose i-th chunk
+    # goes back to worker i, which merges the chunks received into the experts.
+    num_workers = call.attrs.num_workers
+    local_experts, tokens, *rest = call.args[0].struct_info.shape.values
+    x = _bb.emit_te(
+        topi.reshape,
+        call.args[0],
+        [local_experts, num_workers, tir.div(tokens, num_workers)] + rest,
+    )
+    x = _bb.emit_te(topi.transpose, x, [1, 0] + list(range(2, len(rest) + 3)))
+    x = _all_to_all_equal_chunks(_bb, x, call.attrs.in_group)
+    return _bb.call_te(topi.reshape, x, call.struct_info.shape.values)
+
+
+@register_legalize("relax.ccl.ring_send_recv_start")
+def _ring_send_recv_start(_bb: BlockBuilder, call: Call) -> Expr:
+    return call_dps_packed(
+        "runtime.disco.ring_send_recv_start",
+        [call.args[0], call.attrs.in_group],
+        out_sinfo=call.args[0].struct_info,
+    )
+
+
+@register_legalize("relax.ccl.ring_send_recv_wait")
+def _ring_send_recv_wait(_bb: BlockBuilder, call: Call) -> Expr:
+    # The received buffer is copied out, as the VM memory planner does not track outputs that
+    # alias the inputs of packed functions.
+    return call_dps_packed(
+        "runtime.disco.ring_send_recv_wait",
+        list(call.args),
+        out_sinfo=call.args[1].struct_info,
+    )
+
+
 @register_legalize("relax.ccl.broadcast_from_worker0")
 def _broadcast_from_worker0(_bb: BlockBuilder, call: Call) -> Expr:
     return call_dps_packed(
@@ -136,3 +136,29 @@ def _outer(bb: BlockBuilder, call: Call) -> Expr:
 
     lhs, rhs = call.args
     return bb.call_te(te_outer, lhs, rhs, primfunc_name_hint="outer")
+
+
+@register_legalize("relax.grouped_matmul")
+def _grouped_matmul(bb: BlockBuilder, call: Call) -> Expr:
+    def te_grouped_matmul(x: te.Tensor, weight: te.Tensor, indptr: te.Tensor) -> te.Tensor:
+        m, k = x.shape
+        num_groups, n, _ = weight.shape
+        # The group of a row is the number of groups that end before or at it.
+        g = te.reduce_axis((0, num_groups), name="g")
+        group = te.compute(
+            (m,),
+            lambda i: te.sum(
+                tir.Select(indptr[g] <= i.astype(indptr.dtype), tir.const(1, "int32"), 0), axis=g
+            ),
+            name="group",
+        )
+        r = te.reduce_axis((0, k), name="k")
+
+        def compute_fn(i, j):
+            in_group = group[i] < num_groups
+            w = weight[tir.min(group[i], num_groups - 1), j, r]
+            return te.sum(tir.Select(in_group, x[i, r] * w, tir.const(0, x.dtype)), axis=r)
+
+        return te.compute((m, n), compute_fn, name="grouped_matmul")
+
+    return bb.call_te(te_grouped_matmul, *call.args, primfunc_name_hint="grouped_matmul")
@@ -20,10 +20,13 @@
 import logging
 import math
 
-from tvm import s_tir, te, tir, topi
+from tvm import arith, relax, s_tir, te, tir, topi
+from tvm.relax.op.base import call_tir
+from tvm.relax.struct_info import TensorStructInfo
+from tvm.target import Target
 
 from ...block_builder import BlockBuilder
-from ...expr import Call, Expr
+from ...expr import Call, Expr, TupleGetItem
 from .common import _call_topi_without_attr, register_legalize
 
 
@@ -709,11 +712,88 @@ def _te_attention(
     return topi.transpose(o, [0, 2, 1, 3])
 
 
+def _flash_attention(bb: BlockBuilder, call: Call) -> Expr | None:
+    """Legalize the attention into the ragged prefill kernel of the KV cache, which computes the
+    softmax online over the tiles of keys, instead of materializing the attention scores. It
+    applies when the attention is built for a CPU or GPU target, with static numbers of heads
+    and head dimensions, and returns None otherwise."""
+    target = Target.current(allow_none=True)
+    if target is None or (str(target.kind) != "llvm" and "gpu" not in target.keys):
+        return None
+    q, k, v = call.args
+    dtype = q.struct_info.dtype
+    batch_size, seq_len, num_head, head_dim = q.struct_info.shape.values
+    _, seq_len_kv, num_head_kv, _ = k.struct_info.shape.values
+    head_dim_v = v.struct_info.shape.values[3]
+    if dtype not in ("float16", "float32") or not all(
+        isinstance(x, tir.IntImm) for x in [num_head, num_head_kv, head_dim, head_dim_v]
+    ):
+        return None
+    if num_head.value % num_head_kv.value != 0:
+        return None
+    # The kernel aligns the causal mask to the bottom right, as the decoding does.
+    if call.attrs.causal_mask == "TopLeft":
+        if not arith.Analyzer().can_prove_equal(seq_len, seq_len_kv):
+            return None
+    elif call.attrs.causal_mask not in (None, "BottomRight"):
+        return None
+    if call.attrs.scale is not None:
+        scale = float(call.attrs.scale.value)
+    else:
+        scale = 1.0 / math.sqrt(head_dim.value)
+
+    # pylint: disable-next=import-outside-toplevel
+    from tvm.relax.frontend.nn.llm.kv_cache import _attention_prefill_ragged_no_rope
+
+    func = _attention_prefill_ragged_no_rope(
+        num_head_kv.value,
+        num_head.value,
+        head_dim.value,
+        head_dim_v.value,
+        dtype,
+        call.attrs.causal_mask is not None,
+        scale,
+        target,
+    )
+    gvar = bb.add_func(func, "attention_prefill")
+
+    def _indptr(x: te.Tensor):
+        return te.compute(
+            (x.shape[0] + 1,), lambda i: (i * x.shape[1]).astype("int32"), name="indptr"
+        )
+
+    # The batch is a ragged batch of sequences of the same length.
+    total_len = batch_size * seq_len
+    total_len_kv = batch_size * seq_len_kv
+    out = bb.emit(
+        call_tir(
+            gvar,
+            [
+                bb.emit(relax.op.reshape(q, (total_len, num_head, head_dim))),
+                bb.emit_te(_indptr, q, primfunc_name_hint="attention_indptr"),
+                bb.emit(relax.op.reshape(k, (total_len_kv, num_head_kv, head_dim))),
+                bb.emit(relax.op.reshape(v, (total_len_kv, num_head_kv, head_dim_v))),
+                bb.emit_te(_indptr, k, primfunc_name_hint="attention_indptr"),
+                bb.emit(relax.op.zeros((total_len,), "int32")),
+                bb.emit(relax.op.zeros((batch_size,), "int32")),
+            ],
+            out_sinfo=[
+                TensorStructInfo((total_len, num_head, head_dim_v), dtype),
+                TensorStructInfo((total_len, num_head), "float32"),
+            ],
+        )
+    )
+    return relax.op.reshape(TupleGetItem(out, 0), (batch_size, seq_len, num_head, head_dim_v))
+
+
 @register_legalize("relax.nn.attention")
 def _nn_attention(bb: BlockBuilder, call: Call) -> Expr:
     assert call.attrs.window_size is None, (
         "Legalization for sliding-window attention is not supported yet."
     )
+    flash = _flash_attention(bb, call)
+    if flash is not None:
+        return flash
     return bb.call_te(
         _te_attention,
         call.args[0],
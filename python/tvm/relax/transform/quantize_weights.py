@@ -0,0 +1,273 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Weight-only quantization of the matmul weights into INT4, INT8 or FP8."""
+
+from collections.abc import Mapping
+
+import numpy as np
+
+import tvm
+from tvm import relax, te, tir
+from tvm.ir.module import IRModule
+from tvm.relax.expr_functor import PyExprMutator, mutator
+
+# The largest magnitude of a quantized value of each dtype
+_QMAX = {"int4": 7.0, "int8": 127.0, "float8_e4m3fn": 448.0}
+
+
+@tvm.transform.module_pass(opt_level=0, name="QuantizeWeights")
+class QuantizeWeights:
+    """Quantize the weights of `R.matmul` into INT4, INT8 or FP8 with group-wise scales, and
+    compute the matmuls with kernels that decode the weights on the fly.
+
+    The weights are the right-hand sides of `R.matmul(x, w)` and of the linear layers
+    `R.matmul(x, R.permute_dims(w))` that are either constants or the weight parameters of a
+    function, i.e. the parameters after its "num_input" attribute. Each weight is rewritten to
+
+    - an `encode` kernel that produces the quantized weight in the (out_features, in_features)
+      layout and the scales of each group of `group_size` consecutive input features, scaled so
+      that the largest magnitude of the group maps to the largest quantized value. INT4 values
+      are offset by 8 and packed by eight into `uint32` words along the input features.
+    - a `decode_matmul` kernel that dequantizes the weight while computing the matmul, and
+      accumulates in float32.
+
+    The `encode` kernels only depend on the weights, so LiftTransformParams moves them to the
+    weight-preparation function and the quantization happens once, while the inference function
+    only reads the quantized weights and their scales. The weights of constants are quantized at
+    compile time by FoldConstant.
+
+    Parameters
+    ----------
+    dtype : str
+        The quantized dtype, one of "int4", "int8" and "float8_e4m3fn".
+
+    group_size : int
+        The number of consecutive input features that share a scale. The weights whose number
+        of input features is not a multiple of it are left alone.
+
+    channel_scales : Optional[Mapping[str, np.ndarray]]
+        The calibration hook for activation-aware quantization (AWQ): for the name of a weight
+        parameter, the scales of its input features computed from calibration activations. The
+        input features of the weight are multiplied by them before quantization and the
+        activations are divided by them, which protects the salient channels from the
+        quantization error.
+
+    skip : Optional[Callable[[str], bool]]
+        Whether to leave the weight of the given name unquantized, e.g. the LM head.
+    """
+
+    def __init__(
+        self,
+        dtype: str = "int4",
+        group_size: int = 128,
+        channel_scales: Mapping[str, np.ndarray] | None = None,
+        skip=None,
+    ):
+        if dtype not in _QMAX:
+            raise ValueError(f"QuantizeWeights expects one of {list(_QMAX)}, but got {dtype}")
+        if group_size <= 0 or (dtype == "int4" and group_size % 8 != 0):
+            raise ValueError(
+                f"QuantizeWeights expects a positive group size, and a multiple of 8 for int4, "
+                f"but got {group_size}"
+            )
+        self.dtype = dtype
+        self.group_size = group_size
+        self.channel_scales = dict(channel_scales or {})
+        self.skip = skip
+
+    def transform_module(self, mod: IRModule, _ctx: tvm.transform.PassContext) -> IRModule:
+        """IRModule-level transformation"""
+        quantizer = _WeightQuantizer(mod, self)
+        for g_var, func in mod.functions_items():
+            if not isinstance(func, relax.Function) or "Codegen" in (func.attrs or {}):
+                continue
+            num_input = 0
+            if func.attrs and "num_input" in func.attrs:
+                num_input = int(func.attrs["num_input"])
+            quantizer.weights = set(func.params[num_input:])
+            new_func = quantizer.visit_expr(func)
+            if not new_func.same_as(func):
+                new_func = relax.analysis.remove_all_unused(new_func)
+            quantizer.builder_.update_func(g_var, new_func)
+        return quantizer.builder_.get()
+
+
+def _encode(weight: te.Tensor, dtype: str, group_size: int, transposed: bool, scale_dtype: str):
+    """Quantize a weight, given in the (in, out) layout if `transposed` and (out, in) otherwise."""
+    if transposed:
+        in_features, out_features = weight.shape
+    else:
+        out_features, in_features = weight.shape
+    num_groups = in_features // group_size
+
+    def w_at(n, k):
+        return (weight[k, n] if transposed else weight[n, k]).astype("float32")
+
+    j = te.reduce_axis((0, group_size), name="j")
+    max_abs = te.compute(
+        (out_features, num_groups),
+        lambda n, g: te.max(te.abs(w_at(n, g * group_size + j)), axis=j),
+        name="max_abs",
+    )
+    scale = te.compute(
+        (out_features, num_groups),
+        lambda n, g: tir.Max(max_abs[n, g], tir.const(1e-12, "float32")) / _QMAX[dtype],
+        name="scale",
+    )
+
+    def clipped(n, k):
+        value = te.round(w_at(n, k) / scale[n, k // group_size])
+        qmax = tir.const(_QMAX[dtype], "float32")
+        return tir.Max(tir.Min(value, qmax), -qmax)
+
+    if dtype == "int8":
+        quantized = te.compute(
+            (out_features, in_features), lambda n, k: clipped(n, k).astype("int8"), name="encode"
+        )
+    elif dtype == "int4":
+        i = te.reduce_axis((0, 8), name="i")
+        quantized = te.compute(
+            (out_features, in_features // 8),
+            lambda n, k: te.sum(
+                (clipped(n, k * 8 + i) + 8).astype("uint32") << (i * 4).astype("uint32"), axis=i
+            ),
+            name="encode",
+        )
+    else:
+        quantized = te.compute(
+            (out_features, in_features),
+            lambda n, k: (w_at(n, k) / scale[n, k // group_size]).astype(dtype),
+            name="encode",
+        )
+    scale_out = te.compute(
+        (out_features, num_groups), lambda n, g: scale[n, g].astype(scale_dtype), name="scale_out"
+    )
+    return [quantized, scale_out]
+
+
+def _decode_matmul(
+    x: te.Tensor, quantized: te.Tensor, scale: te.Tensor, dtype: str, group_size: int, out_dtype
+):
+    """Compute the matmul of `x` with the transpose of the dequantized weight."""
+    in_features = x.shape[-1]
+    out_features = quantized.shape[0]
+
+    def w_at(n, k):
+        if dtype == "int4":
+            word = quantized[n, k // 8]
+            nibble = (word >> ((k % 8) * 4).astype("uint32")) & tir.const(15, "uint32")
+            value = nibble.astype("float32") - 8.0
+        else:
+            value = quantized[n, k].astype("float32")
+        return value * scale[n, k // group_size].astype("float32")
+
+    k = te.reduce_axis((0, in_features), name="k")
+    out_shape = [*x.shape[:-1], out_features]
+    out = te.compute(
+        out_shape,
+        lambda *idx: te.sum(x(*idx[:-1], k).astype("float32") * w_at(idx[-1], k), axis=k),
+        name="decode_matmul",
+    )
+    if out_dtype != "float32":
+        out = te.compute(out_shape, lambda *idx: out(*idx).astype(out_dtype), name="cast")
+    return out
+
+
+# pylint: disable=missing-docstring,invalid-name
+
+
+@mutator
+class _WeightQuantizer(PyExprMutator):  # pylint: disable=abstract-method
+    def __init__(self, mod: IRModule, config: QuantizeWeights):
+        super().__init__(mod)
+        self.config = config
+        self.weights = set()
+
+    def _is_weight(self, expr: relax.Expr) -> bool:
+        if not isinstance(expr, relax.Constant) and expr not in self.weights:
+            return False
+        sinfo = expr.struct_info
+        if not isinstance(sinfo, relax.TensorStructInfo) or sinfo.ndim != 2:
+            return False
+        if sinfo.dtype not in ["float16", "bfloat16", "float32"] or sinfo.shape is None:
+            return False
+        return all(isinstance(dim, tir.IntImm) for dim in sinfo.shape.values)
+
+    def visit_call_(self, call: relax.Call) -> relax.Expr:  # pylint: disable=arguments-renamed
+        call = self.builder_.normalize(super().visit_call_(call))
+        if call.op != tvm.ir.Op.get("relax.matmul"):
+            return call
+        x, weight = call.args
+        transposed = True
+        if isinstance(weight, relax.Var):
+            binding = self.lookup_binding(weight)
+            if (
+                isinstance(binding, relax.Call)
+                and binding.op == tvm.ir.Op.get("relax.permute_dims")
+                and (binding.attrs.axes is None or [int(a) for a in binding.attrs.axes] == [1, 0])
+            ):
+                weight = binding.args[0]
+                transposed = False
+        if not self._is_weight(weight) or not isinstance(x.struct_info, relax.TensorStructInfo):
+            return call
+
+        name = weight.name_hint if isinstance(weight, relax.Var) else ""
+        if self.config.skip is not None and self.config.skip(name):
+            return call
+        shape = [int(dim) for dim in weight.struct_info.shape.values]
+        in_features = shape[0] if transposed else shape[1]
+        if in_features % self.config.group_size != 0:
+            return call
+
+        x_dtype = x.struct_info.dtype
+        if name in self.config.channel_scales:
+            scales = np.asarray(self.config.channel_scales[name]).astype(x_dtype)
+            if scales.shape != (in_features,):
+                raise ValueError(
+                    f"QuantizeWeights expects the channel scales of {name} to have shape "
+                    f"({in_features},), but got {scales.shape}"
+                )
+            w_scales = scales.reshape(in_features, 1) if transposed else scales
+            weight = self.builder_.emit(
+                relax.op.multiply(weight, relax.const(w_scales.astype(weight.struct_info.dtype)))
+            )
+            x = self.builder_.emit(relax.op.divide(x, relax.const(scales)))
+
+        dtype = self.config.dtype
+        encoded = self.builder_.emit(
+            self.builder_.call_te(
+                _encode,
+                weight,
+                dtype=dtype,
+                group_size=self.config.group_size,
+                transposed=transposed,
+                scale_dtype=x_dtype,
+                primfunc_name_hint=f"encode_{dtype}",
+            )
+        )
+        quantized = self.builder_.emit(relax.TupleGetItem(encoded, 0))
+        scale = self.builder_.emit(relax.TupleGetItem(encoded, 1))
+        return self.builder_.call_te(
+            _decode_matmul,
+            x,
+            quantized,
+            scale,
+            dtype=dtype,
+            group_size=self.config.group_size,
+            out_dtype=call.struct_info.dtype,
+            primfunc_name_hint=f"decode_matmul_{dtype}",
+        )
@@ -0,0 +1,207 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Packing of the matmul weights with 2:4 structured sparsity."""
+
+import tvm
+from tvm import relax, te, tir
+from tvm.ir.module import IRModule
+from tvm.relax.expr_functor import PyExprMutator, mutator
+
+
+@tvm.transform.module_pass(opt_level=0, name="SparsifyWeights")
+class SparsifyWeights:
+    """Pack the weights of `R.matmul` with 2:4 structured sparsity, i.e. with at most two
+    non-zero values in each group of four consecutive input features, and compute the matmuls
+    with kernels that only read and multiply the kept values.
+
+    The weights are matched as in QuantizeWeights: the right-hand sides of `R.matmul(x, w)` and
+    of the linear layers `R.matmul(x, R.permute_dims(w))` that are either constants or the
+    weight parameters of a function. Each weight is rewritten to
+
+    - an `encode_2in4` kernel that keeps the two values of largest magnitude of each group, i.e.
+      the non-zero values of a weight pruned to 2:4, in the (out_features, in_features / 2)
+      layout, and their metadata: the 2-bit index in its group of each kept value, packed by
+      sixteen into `uint32` words along the input features, as in the metadata of `mma.sp`.
+    - a `sparse_matmul` kernel that gathers the input features of the kept values while
+      computing the matmul, and accumulates in float32.
+
+    The weights that are not 2:4 sparse are pruned to 2:4 by magnitude, so the pass is meant for
+    the models pruned to 2:4. As in QuantizeWeights, LiftTransformParams moves the `encode_2in4`
+    kernels to the weight-preparation function, and FoldConstant packs the constant weights.
+
+    Parameters
+    ----------
+    skip : Optional[Callable[[str], bool]]
+        Whether to leave the weight of the given name dense, e.g. the LM head.
+    """
+
+    def __init__(self, skip=None):
+        self.skip = skip
+
+    def transform_module(self, mod: IRModule, _ctx: tvm.transform.PassContext) -> IRModule:
+        """IRModule-level transformation"""
+        sparsifier = _WeightSparsifier(mod, self)
+        for g_var, func in mod.functions_items():
+            if not isinstance(func, relax.Function) or "Codegen" in (func.attrs or {}):
+                continue
+            num_input = 0
+            if func.attrs and "num_input" in func.attrs:
+                num_input = int(func.attrs["num_input"])
+            sparsifier.weights = set(func.params[num_input:])
+            new_func = sparsifier.visit_expr(func)
+            if not new_func.same_as(func):
+                new_func = relax.analysis.remove_all_unused(new_func)
+            sparsifier.builder_.update_func(g_var, new_func)
+        return sparsifier.builder_.get()
+
+
+def _encode_2in4(weight: te.Tensor, transposed: bool):
+    """Pack a weight, given in the (in, out) layout if `transposed` and (out, in) otherwise."""
+    if transposed:
+        in_features, out_features = weight.shape
+    else:
+        out_features, in_features = weight.shape
+
+    def w_at(n, k):
+        return weight[k, n] if transposed else weight[n, k]
+
+    def is_kept(n, g, i):
+        # A value is kept when fewer than two values of the group are larger in magnitude,
+        # with the ties broken by the index.
+        magnitude = te.abs(w_at(n, g * 4 + i))
+        num_larger = 0
+        for j in range(4):
+            if j == i:
+                continue
+            other = te.abs(w_at(n, g * 4 + j))
+            larger = tir.Or(other > magnitude, other == magnitude) if j < i else other > magnitude
+            num_larger = num_larger + larger.astype("int32")
+        return num_larger < 2
+
+    def index_in_group(n, g, s):
+        # The first kept value is one of the first three, and the second of the last three.
+        first = tir.Select(is_kept(n, g, 0), 0, tir.Select(is_kept(n, g, 1), 1, 2))
+        second = tir.Select(is_kept(n, g, 3), 3, tir.Select(is_kept(n, g, 2), 2, 1))
+        return tir.Select(s == 0, first, second)
+
+    indices = te.compute(
+        (out_features, in_features // 2),
+        lambda n, k: index_in_group(n, k // 2, k % 2),
+        name="indices",
+    )
+    values = te.compute(
+        (out_features, in_features // 2),
+        lambda n, k: w_at(n, k // 2 * 4 + indices[n, k]),
+        name="encode",
+    )
+    i = te.reduce_axis((0, 16), name="i")
+    metadata = te.compute(
+        (out_features, in_features // 32),
+        lambda n, k: te.sum(
+            indices[n, k * 16 + i].astype("uint32") << (i * 2).astype("uint32"), axis=i
+        ),
+        name="metadata",
+    )
+    return [values, metadata]
+
+
+def _sparse_matmul(x: te.Tensor, values: te.Tensor, metadata: te.Tensor, out_dtype: str):
+    """Compute the matmul of `x` with the transpose of the 2:4 sparse weight."""
+    out_features, num_kept = values.shape
+
+    def index_in_group(n, k):
+        word = metadata[n, k // 16]
+        return ((word >> ((k % 16) * 2).astype("uint32")) & tir.const(3, "uint32")).astype("int32")
+
+    k = te.reduce_axis((0, num_kept), name="k")
+    out_shape = [*x.shape[:-1], out_features]
+    out = te.compute(
+        out_shape,
+        lambda *idx: te.sum(
+            x(*idx[:-1], k // 2 * 4 + index_in_group(idx[-1], k)).astype("float32")
+            * values[idx[-1], k].astype("float32"),
+            axis=k,
+        ),
+        name="sparse_matmul",
+    )
+    if out_dtype != "float32":
+        out = te.compute(out_shape, lambda *idx: out(*idx).astype(out_dtype), name="cast")
+    return out
+
+
+# pylint: disable=missing-docstring,invalid-name
+
+
+@mutator
+class _WeightSparsifier(PyExprMutator):  # pylint: disable=abstract-method
+    def __init__(self, mod: IRModule, config: SparsifyWeights):
+        super().__init__(mod)
+        self.config = config
+        self.weights = set()
+
+    def _is_weight(self, expr: relax.Expr) -> bool:
+        if not isinstance(expr, relax.Constant) and expr not in self.weights:
+            return False
+        sinfo = expr.struct_info
+        if not isinstance(sinfo, relax.TensorStructInfo) or sinfo.ndim != 2:
+            return False
+        if sinfo.dtype not in ["float16", "bfloat16", "float32"] or sinfo.shape is None:
+            return False
+        return all(isinstance(dim, tir.IntImm) for dim in sinfo.shape.values)
+
+    def visit_call_(self, call: relax.Call) -> relax.Expr:  # pylint: disable=arguments-renamed
+        call = self.builder_.normalize(super().visit_call_(call))
+        if call.op != tvm.ir.Op.get("relax.matmul"):
+            return call
+        x, weight = call.args
+        transposed = True
+        if isinstance(weight, relax.Var):
+            binding = self.lookup_binding(weight)
+            if (
+                isinstance(binding, relax.Call)
+                and binding.op == tvm.ir.Op.get("relax.permute_dims")
+                and (binding.attrs.axes is None or [int(a) for a in binding.attrs.axes] == [1, 0])
+            ):
+                weight = binding.args[0]
+                transposed = False
+        if not self._is_weight(weight) or not isinstance(x.struct_info, relax.TensorStructInfo):
+            return call
+
+        name = weight.name_hint if isinstance(weight, relax.Var) else ""
+        if self.config.skip is not None and self.config.skip(name):
+            return call
+        shape = [int(dim) for dim in weight.struct_info.shape.values]
+        in_features = shape[0] if transposed else shape[1]
+        # Each metadata word holds the indices of the kept values of 32 input features.
+        if in_features % 32 != 0:
+            return call
+
+        encoded = self.builder_.emit(
+            self.builder_.call_te(
+                _encode_2in4, weight, transposed=transposed, primfunc_name_hint="encode_2in4"
+            )
+        )
+        values = self.builder_.emit(relax.TupleGetItem(encoded, 0))
+        metadata = self.builder_.emit(relax.TupleGetItem(encoded, 1))
+        return self.builder_.call_te(
+            _sparse_matmul,
+            x,
+            values,
+            metadata,
+            out_dtype=call.struct_info.dtype,
+            primfunc_name_hint="sparse_matmul",
+        )
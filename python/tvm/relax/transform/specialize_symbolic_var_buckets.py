@@ -0,0 +1,184 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Specialize dynamic-shape TIR functions over buckets of a symbolic variable."""
+
+from collections.abc import Sequence
+
+import tvm
+from tvm import relax, tir
+from tvm.ir.module import IRModule
+from tvm.relax.expr_functor import PyExprMutator, mutator
+
+
+@tvm.transform.module_pass(opt_level=0, name="SpecializeSymbolicVarBuckets")
+class SpecializeSymbolicVarBuckets:
+    """Specialize the TIR functions that depend on a symbolic variable to a set of bucket values,
+    and dispatch to the specialized functions at runtime.
+
+    For every PrimFunc whose buffer shapes contain the symbolic variable `var_name`, one copy
+    with the variable bound to each bucket value is added to the module. Every `R.call_tir` of
+    the original function is then replaced by a chain of `R.If` that calls the copy matching
+    the runtime value of the variable, and the original dynamic function otherwise.
+
+    The specialized copies have static shapes, so MetaSchedule tunes one schedule per bucket
+    when the pass runs before tuning. Callers that pad their inputs to the bucket values, e.g.
+    the prefill chunks of an LLM, always hit a tuned kernel. Applying the pass once per
+    symbolic variable specializes over the product of their buckets.
+
+    As `R.If` may not appear in a dataflow block, the functions of a module the pass rewrites
+    are converted out of dataflow form, so the pass is expected to run after operator fusion.
+
+    Parameters
+    ----------
+    var_name : str
+        The name of the symbolic variable in the TIR functions.
+
+    buckets : Sequence[int]
+        The representative values of the symbolic variable.
+    """
+
+    def __init__(self, var_name: str, buckets: Sequence[int]):
+        if not buckets:
+            raise ValueError("SpecializeSymbolicVarBuckets expects at least one bucket")
+        self.var_name = var_name
+        self.buckets = sorted({int(b) for b in buckets})
+
+    def transform_module(self, mod: IRModule, _ctx: tvm.transform.PassContext) -> IRModule:
+        """IRModule-level transformation"""
+        variants = {}
+        for g_var, func in mod.functions_items():
+            if isinstance(func, tir.PrimFunc):
+                specialized = _specialize(func, self.var_name, self.buckets)
+                if specialized is not None:
+                    variants[g_var] = specialized
+        if not variants:
+            return mod
+        mod = relax.transform.ToNonDataflow()(mod)
+        return _Dispatcher(mod, self.var_name, variants).transform()
+
+
+def _find_symbolic_var(func: tir.PrimFunc, var_name: str):
+    """Find a buffer parameter whose shape contains the symbolic variable named `var_name`."""
+    for param in func.params:
+        if param not in func.buffer_map:
+            continue
+        buf = func.buffer_map[param]
+        for dim in buf.shape:
+            if isinstance(dim, tir.Var) and dim.name == var_name:
+                return param, buf, dim
+    return None
+
+
+def _specialize(func: tir.PrimFunc, var_name: str, buckets: list[int]):
+    """Return the symbolic variable of `func` named `var_name` and the copies of `func`
+    specialized to each bucket, or None if `func` is not dynamic in `var_name`.
+
+    Functions taking the variable as a scalar parameter are not specialized, since
+    specialization removes the parameter and the `tir_vars` of their callers would mismatch.
+    """
+    found = _find_symbolic_var(func, var_name)
+    if found is None:
+        return None
+    param, buf, var = found
+    if any(p.same_as(var) for p in func.params):
+        return None
+    result = []
+    for value in buckets:
+        shape = [tir.IntImm(dim.dtype, value) if dim.same_as(var) else dim for dim in buf.shape]
+        specific_buf = tir.decl_buffer(
+            shape,
+            buf.dtype,
+            buf.name,
+            data=buf.data,
+            strides=buf.strides,
+            elem_offset=buf.elem_offset,
+            scope=buf.scope(),
+            data_alignment=buf.data_alignment,
+            offset_factor=buf.offset_factor,
+            axis_separators=buf.axis_separators,
+        )
+        result.append((value, func.specialize({param: specific_buf})))
+    return var, result
+
+
+@mutator
+class _Dispatcher(PyExprMutator):
+    def __init__(self, mod: IRModule, var_name: str, variants) -> None:
+        super().__init__(mod)
+        self.mod = mod
+        self.call_tir_op = tvm.ir.Op.get("relax.call_tir")
+        # Maps each dynamic function to its symbolic var and the GlobalVars of its buckets
+        self.dispatch = {}
+        for g_var, (var, specialized) in variants.items():
+            buckets = []
+            for value, func in specialized:
+                name = f"{g_var.name_hint}_{var_name}{value}"
+                buckets.append((value, self.builder_.add_func(func, name)))
+            self.dispatch[g_var] = (var, buckets)
+
+    def transform(self) -> IRModule:
+        """Entry point"""
+        for g_var, func in self.mod.functions_items():
+            if isinstance(func, relax.Function):
+                updated_func = self.visit_expr(func)
+                self.builder_.update_func(g_var, updated_func)
+        return self.builder_.get()
+
+    def visit_call_(self, call: relax.Call) -> relax.Expr:  # pylint: disable=arguments-renamed
+        call = super().visit_call_(call)
+        if call.op != self.call_tir_op or call.args[0] not in self.dispatch:
+            return call
+        var, buckets = self.dispatch[call.args[0]]
+        value = self._relax_value_of(call, var)
+        if value is None:
+            return call
+
+        def call_bucket(g_var):
+            return relax.Call(call.op, [g_var, *call.args[1:]], call.attrs, call.sinfo_args)
+
+        if isinstance(value, tir.IntImm):
+            # The caller is already static, no runtime dispatch is needed
+            for bucket, g_var in buckets:
+                if bucket == value.value:
+                    return call_bucket(g_var)
+            return call
+        result = call
+        for bucket, g_var in reversed(buckets):
+            cond = relax.PrimValue(tir.EQ(value, tir.IntImm(value.dtype, bucket)))
+            result = relax.If(cond, call_bucket(g_var), result)
+        return result
+
+    def _relax_value_of(self, call: relax.Call, var: tir.Var):
+        """The expression the caller binds to the symbolic variable `var` of the callee."""
+        func = self.mod[call.args[0]]
+        inputs = call.args[1].fields if isinstance(call.args[1], relax.Tuple) else [call.args[1]]
+        sinfo_out = call.sinfo_args[0]
+        outputs = (
+            sinfo_out.fields if isinstance(sinfo_out, relax.TupleStructInfo) else [sinfo_out]
+        )
+        sinfos = [arg.struct_info for arg in inputs] + list(outputs)
+        for param, sinfo in zip(func.params, sinfos):
+            if param not in func.buffer_map:
+                continue
+            if not isinstance(sinfo, relax.TensorStructInfo) or sinfo.shape is None:
+                continue
+            if not isinstance(sinfo.shape, relax.ShapeExpr):
+                continue
+            for dim, value in zip(func.buffer_map[param].shape, sinfo.shape.values):
+                if dim.same_as(var):
+                    return value
+        return None
@@ -289,6 +289,12 @@ def DataflowUseInplaceCalls() -> tvm.ir.transform.Pass:
     in-place PrimFunc implementations of those operators (which are based on the legalizations of
     those operators).
 
+    The calls to `call_tir` of a PrimFunc that can write its output to one of its inputs, e.g. a
+    fused elementwise function or the residual add of a fused matmul, are made in-place as well,
+    when the input is a view or value that is not used after the call. The PrimFunc can write its
+    output to an input that it reads only before the output is written, or elementwise by the block
+    writing the output.
+
     Note: ConvertToDataflow may need to be called first to provide dataflow blocks.
 
     Returns
@@ -517,6 +523,77 @@ def RewriteDataflowReshape() -> tvm.ir.transform.Pass:
     return _ffi_api.RewriteDataflowReshape()  # type: ignore
 
 
+def RewriteDataflowSlice() -> tvm.ir.transform.Pass:
+    """Convert the call_tir that copy a contiguous range of their input to views of the input,
+    which are created at runtime instead of copying the data. It covers the strided slices with
+    unit strides whose outer axes have a single index, e.g. a range of rows, and the splits along
+    such an axis, e.g. the split of the fused QKV projection of a single token.
+
+    The byte offset of a view is required to keep the alignment of the allocations, so that the
+    kernels reading it can take it without a copy.
+
+    Note: Operates only in dataflow blocks. ConvertToDataflow may need to be called first.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+    """
+    return _ffi_api.RewriteDataflowSlice()  # type: ignore
+
+
+def HorizontalFuseOps(max_group_size: int = 8) -> tvm.ir.transform.Pass:
+    """Group the independent small kernels of each dataflow block, so that :py:func:`FuseTIR`
+    merges each group into a single PrimFunc launch.
+
+    :py:func:`FuseOps` fuses producers into their consumers, and leaves independent kernels,
+    e.g. the norms or rotary embeddings of Q and K in a decode step, as separate launches that
+    each underutilize the device. This pass groups the `R.call_tir` of PrimFuncs whose
+    "op_pattern" is at most a reduction, when they are at the same dependency depth in the
+    dataflow block and have the same kind of pattern (injective or reduction), output rank and
+    dtype. Bindings at the same depth never depend on each other, so the grouping is acyclic.
+
+    The pass expects :py:func:`AnnotateTIROpPattern` to have been applied, and is usually run
+    after :py:func:`FuseOps` and before :py:func:`FuseTIR`.
+
+    Parameters
+    ----------
+    max_group_size : int
+        The maximum number of kernels in a group.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+    """
+    return _ffi_api.HorizontalFuseOps(max_group_size)  # type: ignore
+
+
+def Rematerialize(memory_budget: int | None = None) -> tvm.ir.transform.Pass:
+    """Recompute cheap tensors near their late uses instead of keeping them alive.
+
+    Training graphs produced by :py:func:`Gradient` keep every forward activation alive until
+    its use in the backward pass. Within each binding block, this pass repeatedly picks a tensor
+    alive without use across the memory peak, and recomputes it right before its next use. Only
+    tensors computed by `R.call_tir` of a PrimFunc whose "op_pattern" is at most injective are
+    recomputed, preferring those freeing the most memory for the memory traffic of their
+    recomputation, and only when the inputs of the recomputation are still alive there.
+
+    The pass expects the module to be legalized and annotated by
+    :py:func:`AnnotateTIROpPattern`, and is to be run before :py:func:`StaticPlanBlockMemory`.
+
+    Parameters
+    ----------
+    memory_budget : Optional[int]
+        The number of bytes of live tensors in a block to fit within. The pass stops
+        rematerializing once the estimated peak is within the budget. If not specified, the peak
+        is lowered as much as possible.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+    """
+    return _ffi_api.Rematerialize(-1 if memory_budget is None else memory_budget)  # type: ignore
+
+
 def StaticPlanBlockMemory() -> tvm.ir.transform.Pass:
     """The static memory planning pass on BindingBlock level.
     The pass will reuse allocated memory to its best effort, in order to
@@ -535,6 +612,22 @@ def StaticPlanBlockMemory() -> tvm.ir.transform.Pass:
     signature will have upper bound 1024. And we will use 1024 as its value
     during memory planning.
 
+    With the pass config :code:`"relax.StaticPlanBlockMemory.arena"` enabled, the
+    constant-size tensors of the top-level non-dataflow blocks of each function are
+    instead packed by their lifetimes into a single arena storage per device, and
+    allocated at the computed offsets in the arena.
+
+    The pass config :code:`"relax.StaticPlanBlockMemory.shared_arena_funcs"` lists the
+    functions of the module that never run concurrently, e.g. the prefill and decode
+    functions of an LLM, and that do not call each other. Their arenas share one
+    workspace per device, which the VM keeps alive across calls, so that the resident
+    memory is the largest of their arenas instead of the sum.
+
+    With the pass config :code:`"relax.StaticPlanBlockMemory.dynamic_arena"` enabled, the
+    arenas holding dynamic-shape tensors with annotated upper bounds get symbolic offsets
+    and sizes computed from the actual tensor shapes. The VM keeps such an arena across
+    calls, allocates it at the actual size on the first call and grows it geometrically.
+
     Returns
     -------
     ret : tvm.ir.transform.Pass
@@ -618,6 +711,10 @@ def VMBuiltinLower() -> tvm.ir.transform.Pass:
 def VMShapeLower(*, emit_err_ctx: bool = True) -> tvm.ir.transform.Pass:
     """Lower the symbolic shape and argument and match-cast structinfo matching.
 
+    The runtime checks of the struct info can be stripped for trusted deployments, whose inputs
+    are known to match, with the `relax.VMShapeLower.skip_checks` option of the PassContext. The
+    shapes are then only matched to populate the symbolic variables.
+
     Parameters
     ----------
     emit_err_ctx: Optional[bool]
@@ -732,6 +829,11 @@ def FoldConstant() -> tvm.ir.transform.Pass:
 
     Note: ConvertToDataflow may need to be called first to provide dataflow blocks.
 
+    The kernels built to evaluate the folded calls are cached by structural equality across
+    the runs of the pass. The pass config ``relax.FoldConstant.max_output_bytes`` skips folding
+    the calls whose output is larger than the given number of bytes, e.g. large broadcasts that
+    would bloat the module with constants. It is unlimited by default.
+
     Returns
     -------
     ret: tvm.ir.transform.Pass
@@ -799,6 +901,27 @@ def FuseOps(fuse_opt_level=-1) -> tvm.ir.transform.Pass:
 
     Note: ConvertToDataflow may need to be called first to provide dataflow blocks.
 
+    The fusion of each binding into its immediate post-dominator is decided by the op patterns.
+    A fusion policy, e.g. one querying an analytical or MetaSchedule cost model, can override
+    these rules through the ``"relax.FuseOps.fusion_policy"`` config of the pass context. It is
+    called as ``policy(mod, producer, consumer)`` with the values of the two bindings, and
+    returns True to fuse them, False to keep them apart, or None to leave the decision to the
+    pattern rules. Opaque bindings are never fused.
+
+    .. code-block:: python
+
+        call_tir = tvm.ir.Op.get("relax.call_tir")
+
+        def policy(mod, producer, consumer):
+            # Keep the tuned matmul kernels free of their epilogues
+            if isinstance(producer, relax.Call) and producer.op == call_tir:
+                if producer.args[0].name_hint.startswith("matmul"):
+                    return False
+            return None
+
+        with tvm.transform.PassContext(config={"relax.FuseOps.fusion_policy": policy}):
+            mod = relax.transform.FuseOps()(mod)
+
     Parameters
     ----------
     fuse_opt_level : int
@@ -1397,6 +1520,41 @@ def ConvertLayout(
     return _ffi_api.ConvertLayout(desired_layouts, layout_cb)  # type: ignore
 
 
+def AutoConvertLayout(
+    candidate_layouts: dict[str, list[list[str]]],
+    op_cost: Callable | None = None,
+    fold_constants: bool = True,
+) -> tvm.ir.transform.Pass:
+    """Layout conversion pass that selects the layout of each op among candidates by cost.
+
+    The layouts are chosen to minimize the cost of the ops plus the number of elements moved
+    by the inserted layout transforms. The transforms of constants, such as weights, are free
+    since they are folded at compile time. The assignment is searched by coordinate descent from
+    each uniform assignment, measuring the transforms on the rewritten dataflow block.
+
+    Parameters
+    ----------
+    candidate_layouts : Dict[str, List[List[str]]]
+        The candidate layouts of some operators, each in the format of the desired layouts of
+        ConvertLayout, ranked by preference. For example, to let conv2d choose between NHWC, NCHW
+        and the blocked NCHW4c layout for CPU, ``{"relax.nn.conv2d": [["NHWC", "OHWI"],
+        ["NCHW", "OIHW"], ["NCHW4c", "OIHW4o"]]}``.
+    op_cost : Optional[Callable[[relax.Call, List[str]], float]]
+        The cost of an op call in a candidate layout. By default, the k-th candidate costs k
+        times the number of elements of the output.
+    fold_constants : bool
+        Whether to run FoldConstant afterwards, folding the layout transforms of constants.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass for layout selection.
+    """
+    return _ffi_api.AutoConvertLayout(  # type: ignore
+        candidate_layouts, op_cost, fold_constants
+    )
+
+
 def DeadCodeElimination(entry_functions: list[str] | None = None) -> tvm.ir.transform.Pass:
     """Remove dead code in the IRModule.
     Currently it removes:
@@ -1428,7 +1586,10 @@ def DeadCodeElimination(entry_functions: list[str] | None = None) -> tvm.ir.tran
 
 
 def ToMixedPrecision(
-    out_dtype="float32", fp16_input_names: list[str] | None = None
+    out_dtype="float32",
+    fp16_input_names: list[str] | None = None,
+    op_policy: dict[str, str] | None = None,
+    fp32_bindings: list[str] | None = None,
 ) -> tvm.ir.transform.Pass:
     """Automatic mixed precision pass. Currently the pass assumes the input module to be fp32
     only, and will automatically cast fp32 to fp16 for certain ops.
@@ -1442,13 +1603,23 @@ def ToMixedPrecision(
     fp16_input_names : List[str]
         The names of function parameters whose dtype should become fp16. The  function signature
         would change accordingly.
+    op_policy : Dict[str, str]
+        The mixed precision policy of each op to override, by op name, e.g.
+        ``{"relax.matmul": "never"}``. The policy is one of "always" (compute in fp16),
+        "follow" (compute in fp16 if all the inputs are fp16) and "never" (compute in the
+        original precision).
+    fp32_bindings : List[str]
+        The names of the vars bound to the op calls to keep in their original precision, e.g.
+        the ops whose error in fp16 exceeds the accuracy budget in a calibration run.
 
     Returns
     -------
     ret : tvm.transform.Pass
         The registered pass for mixed precision.
     """
-    return _ffi_api.ToMixedPrecision(out_dtype, fp16_input_names)  # type: ignore
+    return _ffi_api.ToMixedPrecision(  # type: ignore
+        out_dtype, fp16_input_names, op_policy, fp32_bindings
+    )
 
 
 def SplitCallTIRByPattern(patterns: list[PrimFunc], fcodegen: Callable) -> tvm.ir.transform.Pass:
@@ -1597,6 +1768,7 @@ def CombineParallelMatmul(check=None):
 def RewriteCUDAGraph() -> tvm.ir.transform.Pass:
     """Rewrite a Relax module for executing with CUDA graph. This pass identifies the regions that
     can be executed with CUDA graph and lifts them into new functions for runtime graph capturing.
+    Under a ROCm target, the regions are launched with HIP graphs instead.
 
     Returns
     -------
@@ -1606,6 +1778,40 @@ def RewriteCUDAGraph() -> tvm.ir.transform.Pass:
     return _ffi_api.RewriteCUDAGraph()  # type: ignore
 
 
+def AssignStreams() -> tvm.ir.transform.Pass:
+    """Run the independent kernels of the lowered Relax functions on several streams, with
+    events for the dependencies across the streams.
+
+    The pass is enabled by the pass config "relax.backend.max_num_streams" greater than 1, and
+    works on the functions after memory planning, such that the kernels sharing a storage are
+    ordered too. The kernels run on several streams of the first device of the VM.
+
+    Returns
+    -------
+    ret: tvm.ir.transform.Pass
+        The registered pass for assigning the kernels to streams
+    """
+    return _ffi_api.AssignStreams()  # type: ignore
+
+
+def PlanVTCMStorage() -> tvm.ir.transform.Pass:
+    """Place the intermediate storages of the lowered Relax functions in the VTCM of Hexagon,
+    so that the tensors passed between the kernels stay in VTCM rather than going through DDR.
+
+    The pass works on the functions after memory planning. The storages of constant size that
+    are only used by kernels are placed greedily, the shortest-lived first, while they fit in
+    the VTCM capacity along with the VTCM the kernels allocate themselves. The capacity is the
+    "vtcm-capacity" of the current Hexagon target, or the pass config "tir.vtcm_capacity". The
+    pass does nothing for the other targets, or when the capacity is unknown.
+
+    Returns
+    -------
+    ret: tvm.ir.transform.Pass
+        The registered pass for placing the storages in VTCM
+    """
+    return _ffi_api.PlanVTCMStorage()  # type: ignore
+
+
 def AllocateWorkspace() -> tvm.ir.transform.Pass:
     """Allocate a workspace, represented by a tensor of size big enough for all external
     functions that require a temporary storage, and append it to the arguments of external
@@ -1634,6 +1840,23 @@ def SpecializePrimFuncBasedOnCallSite() -> tvm.ir.transform.Pass:
     return _ffi_api.SpecializePrimFuncBasedOnCallSite()  # type: ignore
 
 
+def SpecializePrimFuncShapes() -> tvm.ir.transform.Pass:
+    """Specialize the symbolic shapes of the PrimFuncs called by call_tir to the constant
+    shapes of the call sites.
+
+    The shapes that become constant after e.g. BindParams or LiftTransformParams stay symbolic
+    in the PrimFuncs, which keeps them from being vectorized and partitioned statically. This
+    pass clones a specialized PrimFunc for each distinct set of constants passed to it, and
+    removes the original PrimFunc if it is no longer used and not externally visible.
+
+    Returns
+    -------
+    ret: tvm.ir.transform.Pass
+        The registered pass for specializing the shapes of PrimFuncs.
+    """
+    return _ffi_api.SpecializePrimFuncShapes()  # type: ignore
+
+
 def _wrap_class_function_pass(pass_cls, pass_info):
     """Wrap a python class as function pass."""
 
@@ -21,6 +21,7 @@ import tvm
 from tvm import relax
 from tvm.ir.module import IRModule
 from tvm.runtime import Executable
+from tvm.s_tir.analysis import estimate_tir_roofline
 from tvm.tir.function import PrimFunc
 
 from . import _ffi_api
@@ -153,6 +154,9 @@ def _vmlink(
     relax_ext_libs = []
     tir_ext_libs = []
     if tir_mod is not None and len(tir_mod.get_global_vars()) > 0:
+        # The costs of the calls are estimated on the PrimFuncs before lowering, for the profiler.
+        for name, cost in estimate_tir_roofline(tir_mod).items():
+            builder.set_kernel_cost(name, cost["flops"], cost["bytes"])
         tir_mod = _auto_attach_system_lib_prefix(tir_mod, target, system_lib)
         lib = tvm.tir.build(tir_mod, target=target, pipeline=tir_pipeline)
     for ext_mod in ext_libs:
@@ -18,6 +18,9 @@
 # ruff: noqa: F401
 """RPC client tools"""
 
+import hashlib
+import json
+import logging
 import os
 import socket
 import stat
@@ -34,6 +37,32 @@ from tvm.contrib import utils
 from . import _ffi_api, base, server
 
 
+class RPCFuture:
+    """The pending result of a pipelined RPC request.
+
+    Do not directly create the object, it is returned by the pipelined
+    methods of :py:class:`RPCSession`.
+    """
+
+    def __init__(self, fwait):
+        self._fwait = fwait
+
+    def result(self):
+        """Wait for the request, and all the requests issued before it, to complete.
+
+        Returns
+        -------
+        value : object
+            The return value of the request.
+
+        Raises
+        ------
+        RPCError
+            If the request raised an error on the remote.
+        """
+        return self._fwait()
+
+
 class RPCSession:
     """RPC Client session module
 
@@ -119,6 +148,54 @@ class RPCSession:
             self._remote_funcs["upload"] = self.get_function("tvm.rpc.server.upload")
         self._remote_funcs["upload"](target, blob)
 
+    def upload_cached(self, data, target=None):
+        """Upload a file to the artifact cache of the remote, unless the remote already has it.
+
+        The artifact is looked up by the hash of its content, so uploading the same artifact
+        again, possibly from another session, does not transfer it. Remotes without an
+        artifact cache receive the file in their temp folder as with `upload`.
+
+        Parameters
+        ----------
+        data : str or bytearray
+            The file name or binary in local to upload.
+
+        target : str, optional
+            The file name in remote, used to keep the file extension of the artifact.
+
+        Returns
+        -------
+        path : str
+            The path of the artifact in remote, to be passed to e.g. `load_module`.
+        """
+        if isinstance(data, bytearray):
+            if not target:
+                raise ValueError("target must present when file is a bytearray")
+            blob = data
+        else:
+            blob = bytearray(open(data, "rb").read())
+            if not target:
+                target = os.path.basename(data)
+
+        if "artifact_cache_lookup" not in self._remote_funcs:
+            try:
+                lookup = self.get_function("tvm.rpc.server.artifact_cache_lookup")
+                upload = self.get_function("tvm.rpc.server.artifact_cache_upload")
+            except AttributeError:
+                lookup, upload = None, None
+            self._remote_funcs["artifact_cache_lookup"] = lookup
+            self._remote_funcs["artifact_cache_upload"] = upload
+        lookup = self._remote_funcs["artifact_cache_lookup"]
+        if lookup is None:
+            self.upload(blob, target)
+            return target
+
+        content_hash = hashlib.sha256(blob).hexdigest()
+        path = lookup(content_hash, target)
+        if not path:
+            path = self._remote_funcs["artifact_cache_upload"](content_hash, target, blob)
+        return str(path)
+
     def download(self, path):
         """Download file from remote temp folder.
 
@@ -180,6 +257,137 @@ class RPCSession:
         """
         return _ffi_api.LoadRemoteModule(self._sess, path)
 
+    def time_evaluate_batch(
+        self,
+        funcs,
+        dev,
+        number=10,
+        repeat=1,
+        min_repeat_ms=0,
+        limit_zero_time_iterations=100,
+        cooldown_interval_ms=0,
+        repeats_to_cooldown=1,
+        cache_flush_bytes=0,
+        f_preproc="",
+        f_fill="tvm.contrib.random.random_fill_for_measure",
+        alloc_repeat=1,
+    ):
+        """Time several remote functions in a single round trip.
+
+        The remote allocates the arguments of each function, fills them with `f_fill`,
+        and times the function as `Module.time_evaluator` does.
+
+        Parameters
+        ----------
+        funcs : List[Tuple[Module, str, List]]
+            The functions to be timed, as (remote module, function name, arguments info)
+            where the arguments info is a list of ["TENSOR", dtype, shape].
+
+        dev : Device
+            The remote device to run the functions on.
+
+        number, repeat, min_repeat_ms, limit_zero_time_iterations, cooldown_interval_ms,
+        repeats_to_cooldown, cache_flush_bytes, f_preproc :
+            The time evaluator configuration, see `Module.time_evaluator`.
+
+        f_fill : str
+            The name of the remote function used to fill the arguments, or an empty string
+            to leave them uninitialized.
+
+        alloc_repeat : int
+            The number of times the arguments of each function are allocated and timed.
+
+        Returns
+        -------
+        results : List[Tuple[Optional[List[float]], Optional[str]]]
+            For each function, either (costs, None) with the durations in seconds of every
+            repeat of every allocation, or (None, error message).
+        """
+        if "batch_time_evaluator" not in self._remote_funcs:
+            self._remote_funcs["batch_time_evaluator"] = self.get_function(
+                "runtime.RPCBatchTimeEvaluator"
+            )
+        flat_funcs = []
+        for mod, func_name, _ in funcs:
+            flat_funcs += [mod, func_name]
+        blob = self._remote_funcs["batch_time_evaluator"](
+            dev.dlpack_device_type() % base.RPC_SESS_MASK,
+            dev.index,
+            number,
+            repeat,
+            min_repeat_ms,
+            limit_zero_time_iterations,
+            cooldown_interval_ms,
+            repeats_to_cooldown,
+            cache_flush_bytes,
+            f_preproc,
+            f_fill,
+            alloc_repeat,
+            json.dumps([list(args_info) for _, _, args_info in funcs]),
+            *flat_funcs,
+        )
+        return [(result.get("costs"), result.get("error")) for result in json.loads(str(blob))]
+
+    def call_async(self, func, *args):
+        """Call a remote function without waiting for its return.
+
+        The remote handles the requests of a session in the order they are issued,
+        so several calls and copies can be kept in flight to overlap their transfers
+        with the remote work. A synchronous request on the session first waits for
+        all the pipelined ones.
+
+        Parameters
+        ----------
+        func : Function
+            The remote function, e.g. from :py:meth:`get_function` or a remote module.
+
+        args : list
+            The arguments, which are sent before the method returns.
+
+        Returns
+        -------
+        future : RPCFuture
+            The future of the return value.
+        """
+        return RPCFuture(_ffi_api.CallPipelined(func, *args))
+
+    def copy_to_remote_async(self, source, target):
+        """Copy a host tensor into a remote tensor without waiting for the copy to complete.
+
+        Parameters
+        ----------
+        source : tvm.runtime.Tensor
+            The host tensor, whose content is sent before the method returns.
+
+        target : tvm.runtime.Tensor
+            The remote tensor of this session, with the same size as the source.
+
+        Returns
+        -------
+        future : RPCFuture
+            The future of the target tensor.
+        """
+        return RPCFuture(_ffi_api.CopyToRemotePipelined(source, target))
+
+    def copy_from_remote_async(self, source, target):
+        """Copy a remote tensor into a host tensor without waiting for the copy to complete.
+
+        Parameters
+        ----------
+        source : tvm.runtime.Tensor
+            The remote tensor of this session.
+
+        target : tvm.runtime.Tensor
+            The host tensor, with the same size as the source. Its content is
+            only valid once the future completes.
+
+        Returns
+        -------
+        future : RPCFuture
+            The future of the target tensor.
+        """
+        return RPCFuture(_ffi_api.CopyFromRemotePipelined(source, target))
+
     def download_linked_module(self, path):
         """Link a module in the remote and download it.
 
@@ -267,7 +475,7 @@ class LocalSession(RPCSession):
 
 
 @tvm_ffi.register_global_func("rpc.PopenSession")
-def _popen_session(binary):
+def _popen_session(binary, shm_capacity=1 << 24):
     temp = utils.tempdir()
 
     if isinstance(binary, bytes | bytearray):
@@ -283,8 +491,9 @@ def _popen_session(binary):
         if not os.access(path_exec, os.X_OK):
             raise RuntimeError(f"{path_exec} is not executable.")
 
-    sess = _ffi_api.CreatePipeClient(path_exec)
-    return sess
+    if shm_capacity:
+        return _ffi_api.CreateShmPipeClient(shm_capacity, path_exec)
+    return _ffi_api.CreatePipeClient(path_exec)
 
 
 class PopenSession(RPCSession):
@@ -294,10 +503,16 @@ class PopenSession(RPCSession):
     ----------
     binary : List[Union[str, bytes]]
         The binary to be executed.
+
+    shm_capacity : int
+        The capacity in bytes of the shared-memory ring buffers that carry the traffic
+        in each direction, instead of the pipes. The server must support the
+        shared-memory handshake, as the servers built by :py:func:`tvm.rpc.with_minrpc` do.
+        Pass 0 to only use the pipes.
     """
 
-    def __init__(self, binary):
-        RPCSession.__init__(self, _popen_session(binary))
+    def __init__(self, binary, shm_capacity=1 << 24):
+        RPCSession.__init__(self, _popen_session(binary, shm_capacity))
 
 
 class TrackerSession:
@@ -380,6 +595,25 @@ class TrackerSession:
             if total or pending:
                 res += f"{k:<{max_key_len}}   {total:<5d}  {free:<4d}  {pending:<7d}\n"
         res += separate_line
+
+        # the throughput of the devices, reported by the load balancing scheduler
+        devices = [(k, dev) for k in keys for dev in queue_info[k].get("devices", [])]
+        if devices:
+            res += "\n"
+            res += "Device Throughput\n"
+            title = (
+                f"{'key':<{max_key_len}s}   {'device-address':21s}  sessions  timeouts"
+                "  mean-sec  sessions/min\n"
+            )
+            separate_line = "-" * len(title) + "\n"
+            res += separate_line + title + separate_line
+            for k, dev in devices:
+                res += (
+                    f"{k:<{max_key_len}}   {dev['addr'] or '':21s}  {dev['sessions']:<8d}  "
+                    f"{dev['timeouts']:<8d}  {dev['mean_session_sec']:<8.2f}  "
+                    f"{dev['sessions_per_min']:<12.2f}\n"
+                )
+            res += separate_line
         return res
 
     def request(
@@ -418,7 +652,11 @@ class TrackerSession:
             try:
                 if self._sock is None:
                     self._connect()
-                base.sendjson(self._sock, [base.TrackerCode.REQUEST, key, "", priority])
+                # the trackers before the session timeouts of the requests ignore them
+                base.sendjson(
+                    self._sock,
+                    [base.TrackerCode.REQUEST, key, "", priority, session_timeout or None],
+                )
                 value = base.recvjson(self._sock)
                 if value[0] != base.TrackerCode.SUCCESS:
                     raise RuntimeError(f"Invalid return value {value!s}")
@@ -437,11 +675,15 @@ class TrackerSession:
                 last_err = err
         raise RuntimeError(f"Cannot request {key} after {max_retry} retry, last_error:{last_err!s}")
 
-    def request_and_run(self, key, func, priority=1, session_timeout=0, max_retry=2):
+    def request_and_run(
+        self, key, func, priority=1, session_timeout=0, max_retry=2, max_requeue=0
+    ):
         """Request a resource from tracker and run the func.
 
         This function safe-guard rare server node dropout during execution.
         In such case, a new resource will be requested and func will be ran again.
+        The runs killed by the session timeout are requeued up to max_requeue times, so that
+        another device of the key can run them.
 
         Parameters
         ----------
@@ -461,9 +703,13 @@ class TrackerSession:
 
         max_retry : int, optional
             Maximum number of times to retry the function before give up.
+
+        max_requeue : int, optional
+            Maximum number of times to requeue the function after a session timeout.
         """
         last_err = None
-        for _ in range(max_retry):
+        num_retry = 0
+        while num_retry < max_retry:
             try:
                 sess = self.request(key, priority=priority, session_timeout=session_timeout)
                 tstart = time.time()
@@ -472,8 +718,13 @@ class TrackerSession:
                 duration = time.time() - tstart
                 # roughly estimate if the error is due to timeout termination
                 if session_timeout and duration >= session_timeout * 0.95:
-                    raise RuntimeError(f"Session timeout when running {func.__name__}")
+                    if max_requeue <= 0:
+                        raise RuntimeError(f"Session timeout when running {func.__name__}")
+                    max_requeue -= 1
+                    logging.warning("Session timeout on %s, requeue %s", key, func.__name__)
+                    continue
                 last_err = err
+                num_retry += 1
         raise RuntimeError(
             f"Failed to run on {key} after {max_retry} retry, last_error:{last_err!s}"
         )
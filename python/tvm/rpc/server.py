@@ -33,6 +33,7 @@ import logging
 import multiprocessing
 import os
 import select
+import shutil
 import socket
 import struct
 import sys
@@ -63,6 +64,23 @@ logger.setLevel(logging.INFO)
 logger.propagate = False
 
 
+def _artifact_cache_dir():
+    """The directory of the artifact cache shared by the RPC sessions of this host."""
+    cache_dir = os.environ.get("TVM_RPC_ARTIFACT_CACHE_DIR")
+    if not cache_dir:
+        cache_dir = os.path.join(
+            os.environ.get("XDG_CACHE_HOME", os.path.expanduser("~/.cache")), "tvm", "rpc_artifacts"
+        )
+    return os.path.abspath(cache_dir)
+
+
+def _artifact_cache_path(cache_dir, content_hash, file_name):
+    """The path of an artifact in the cache, keyed by the hash of its content."""
+    if not content_hash or not all(c in "0123456789abcdef" for c in content_hash):
+        raise ValueError(f"Invalid artifact hash: {content_hash}")
+    return os.path.join(cache_dir, content_hash + "-" + os.path.basename(file_name))
+
+
 def _server_env(load_library, work_path=None):
     """Server environment function return temp dir"""
     if work_path:
@@ -75,14 +93,45 @@ def _server_env(load_library, work_path=None):
     def get_workpath(path):
         return temp.relpath(path)
 
+    cache_dir = _artifact_cache_dir()
+
     @tvm_ffi.register_global_func("tvm.rpc.server.load_module", override=True)
     def load_module(file_name):
         """Load module from remote side."""
         path = temp.relpath(file_name)
+        if os.path.dirname(path) == cache_dir and path.endswith((".o", ".tar")):
+            # Cached artifacts never change, so they are linked only once.
+            linked_path = path + ".so"
+            if not os.path.exists(linked_path):
+                # Link a private copy first, as other servers may share the cache.
+                tmp_path = temp.relpath(os.path.basename(path))
+                shutil.copyfile(path, tmp_path)
+                _load_module(tmp_path)
+                os.replace(tmp_path + ".so", linked_path)
+            path = linked_path
         m = _load_module(path)
         logger.info("load_module %s", path)
         return m
 
+    @tvm_ffi.register_global_func("tvm.rpc.server.artifact_cache_lookup", override=True)
+    def artifact_cache_lookup(content_hash, file_name):
+        """Return the path of a cached artifact, or an empty string if it is not cached."""
+        path = _artifact_cache_path(cache_dir, content_hash, file_name)
+        return path if os.path.exists(path) else ""
+
+    @tvm_ffi.register_global_func("tvm.rpc.server.artifact_cache_upload", override=True)
+    def artifact_cache_upload(content_hash, file_name, blob):
+        """Save an artifact in the cache and return its path."""
+        path = _artifact_cache_path(cache_dir, content_hash, file_name)
+        os.makedirs(cache_dir, exist_ok=True)
+        # Write to a private file first, so that a concurrent lookup never sees a partial file.
+        tmp_path = temp.relpath(os.path.basename(path) + ".part")
+        with open(tmp_path, "wb") as f:
+            f.write(blob)
+        os.replace(tmp_path, path)
+        logger.info("cache artifact %s", path)
+        return path
+
     @tvm_ffi.register_global_func("tvm.rpc.server.download_linked_module", override=True)
     def download_linked_module(file_name):
         """Load module from remote side."""
@@ -36,8 +36,10 @@ List of available APIs:
   - return: TrackerCode.SUCCESS
   - note: match-key is a randomly generated identify the resource during connection.
 - REQUEST: request a new resource from tracker
-  - input: [TrackerCode.REQUEST, [key, user, priority]]
+  - input: [TrackerCode.REQUEST, [key, user, priority, timeout]]
   - return: [TrackerCode.SUCCESS, [url, port, match-key]]
+  - note: the optional timeout is the session timeout of the request in seconds, which the
+    load balancing scheduler uses to detect the devices timing out.
 """
 # pylint: disable=invalid-name
 
@@ -50,6 +52,7 @@ import socket
 import struct
 import sys
 import threading
+import time
 
 from tvm.contrib.popen_pool import PopenWorker
 
@@ -93,7 +96,7 @@ class Scheduler:
         """
         raise NotImplementedError()
 
-    def request(self, user, priority, callback):
+    def request(self, user, priority, callback, timeout=None):
         """Request a resource.
 
         Parameters
@@ -107,6 +110,9 @@ class Scheduler:
         callback : function: value->bool
             Callback function to receive an resource when ready
             returns True if the resource is consumed.
+
+        timeout : float, optional
+            The session timeout of the request in seconds, None or 0 if it has no timeout.
         """
         raise NotImplementedError()
 
@@ -148,9 +154,9 @@ class PriorityScheduler(Scheduler):
         self._values.append(value)
         self._schedule()
 
-    def request(self, user, priority, callback):
+    def request(self, user, priority, callback, timeout=None):
         with self._lock:
-            heapq.heappush(self._requests, (-priority, self._request_cnt, callback))
+            heapq.heappush(self._requests, (-priority, self._request_cnt, timeout, callback))
             self._request_cnt += 1
         self._schedule()
 
@@ -164,6 +170,107 @@ class PriorityScheduler(Scheduler):
         return {"free": len(self._values), "pending": len(self._requests)}
 
 
+class _DeviceStats:
+    """The sessions served by a device, i.e. by the connection of an RPC server."""
+
+    def __init__(self):
+        self.addr = None
+        self.registered = time.time()
+        self.sessions = 0
+        self.timeouts = 0
+        self.busy_sec = 0.0
+        self.expected_sec = 0.0
+        self.start = None
+        self.timeout = None
+
+    def begin(self, timeout):
+        self.start = time.time()
+        self.timeout = timeout
+
+    def end(self):
+        """End the running session, if any, when the device becomes free again."""
+        if self.start is None:
+            return
+        duration = time.time() - self.start
+        self.sessions += 1
+        self.busy_sec += duration
+        if self.sessions == 1:
+            self.expected_sec = duration
+        else:
+            weight = LoadBalanceScheduler.EMA_WEIGHT
+            self.expected_sec = weight * duration + (1 - weight) * self.expected_sec
+        # The server kills the sessions running longer than their timeouts.
+        if self.timeout and duration >= self.timeout:
+            self.timeouts += 1
+        self.start = None
+        self.timeout = None
+
+    def summary(self):
+        elapsed_min = max(time.time() - self.registered, 1e-6) / 60
+        return {
+            "addr": self.addr,
+            "busy": self.start is not None,
+            "sessions": self.sessions,
+            "timeouts": self.timeouts,
+            "mean_session_sec": self.busy_sec / self.sessions if self.sessions else 0.0,
+            "sessions_per_min": self.sessions / elapsed_min,
+        }
+
+
+class LoadBalanceScheduler(PriorityScheduler):
+    """Scheduler balancing the requests over the equivalent devices of a key.
+
+    The requests are still served by priority and then FIFO, but each one is assigned to the
+    free device with the shortest expected session, the moving average of its past sessions, so
+    that the slow devices and the devices timing out serve fewer requests of a batch. The devices
+    not measured yet are tried first. The summary also reports the throughput of each device.
+    """
+
+    # The weight of the latest session in the expected session time of a device.
+    EMA_WEIGHT = 0.3
+
+    def __init__(self, key):
+        super().__init__(key)
+        self._devices = {}
+
+    def _device(self, conn):
+        if conn not in self._devices:
+            self._devices[conn] = _DeviceStats()
+        return self._devices[conn]
+
+    def _schedule(self):
+        while self._requests and self._values:
+            value = min(self._values, key=lambda v: self._device(v[0]).expected_sec)
+            self._values.remove(value)
+            item = heapq.heappop(self._requests)
+            callback = item[-1]
+            if callback(value[1:]):
+                value[0].pending_matchkeys.remove(value[-1])
+                self._device(value[0]).begin(item[2])
+            else:
+                self._values.append(value)
+
+    def put(self, value):
+        device = self._device(value[0])
+        device.addr = f"{value[1]}:{value[2]}"
+        device.end()
+        super().put(value)
+
+    def remove(self, value):
+        super().remove(value)
+        self._devices.pop(value[0], None)
+
+    def summary(self):
+        """Get summary information of the scheduler."""
+        res = super().summary()
+        res["devices"] = [device.summary() for device in self._devices.values()]
+        return res
+
+
+# The schedulers of the tracker, by their names.
+SCHEDULERS = {"priority": PriorityScheduler, "load_balance": LoadBalanceScheduler}
+
+
 class TCPEventHandler(tornado_util.TCPHandler):
     """Base asynchronize message handler.
 
@@ -260,6 +367,7 @@ class TCPEventHandler(tornado_util.TCPHandler):
             key = args[1]
             user = args[2]
             priority = args[3]
+            timeout = args[4] if len(args) >= 5 else None
 
             def _cb(value):
                 # if the connection is already closed
@@ -271,7 +379,7 @@ class TCPEventHandler(tornado_util.TCPHandler):
                     return False
                 return True
 
-            self._tracker.request(key, user, priority, _cb)
+            self._tracker.request(key, user, priority, _cb, timeout)
         elif code == TrackerCode.PING:
             self.ret_value(TrackerCode.SUCCESS)
         elif code == TrackerCode.GET_PENDING_MATCHKEYS:
@@ -308,8 +416,9 @@ class TCPEventHandler(tornado_util.TCPHandler):
 class TrackerServerHandler:
     """Tracker that tracks the resources."""
 
-    def __init__(self, sock, stop_key):
+    def __init__(self, sock, stop_key, scheduler="priority"):
         self._scheduler_map = {}
+        self._scheduler = scheduler
         self._sock = sock
         self._sock.setblocking(0)
         self._ioloop = ioloop.IOLoop.current()
@@ -332,7 +441,7 @@ class TrackerServerHandler:
 
     def create_scheduler(self, key):
         """Create a new scheduler."""
-        return PriorityScheduler(key)
+        return SCHEDULERS[self._scheduler](key)
 
     def put(self, key, value):
         """Report a new resource to the tracker."""
@@ -340,11 +449,11 @@ class TrackerServerHandler:
             self._scheduler_map[key] = self.create_scheduler(key)
         self._scheduler_map[key].put(value)
 
-    def request(self, key, user, priority, callback):
+    def request(self, key, user, priority, callback, timeout=None):
         """Request a new resource."""
         if key not in self._scheduler_map:
             self._scheduler_map[key] = self.create_scheduler(key)
-        self._scheduler_map[key].request(user, priority, callback)
+        self._scheduler_map[key].request(user, priority, callback, timeout)
 
     def close(self, conn):
         self._connections.remove(conn)
@@ -379,9 +488,9 @@ class TrackerServerHandler:
         self._ioloop.start()
 
 
-def _tracker_server(listen_sock, stop_key):
+def _tracker_server(listen_sock, stop_key, scheduler):
     asyncio.set_event_loop(asyncio.new_event_loop())
-    handler = TrackerServerHandler(listen_sock, stop_key)
+    handler = TrackerServerHandler(listen_sock, stop_key, scheduler)
     handler.run()
 
 
@@ -390,7 +499,16 @@ class PopenTrackerServerState:
 
     current = None
 
-    def __init__(self, host, port=9190, port_end=9199, silent=False, reuse_addr=True, timeout=None):
+    def __init__(
+        self,
+        host,
+        port=9190,
+        port_end=9199,
+        silent=False,
+        reuse_addr=True,
+        timeout=None,
+        scheduler="priority",
+    ):
         if silent:
             logger.setLevel(logging.WARN)
 
@@ -419,18 +537,26 @@ class PopenTrackerServerState:
             raise ValueError(f"cannot bind to any port in [{port}, {port_end})")
         logger.info("bind to %s:%d", host, self.port)
         sock.listen(1)
-        self.thread = threading.Thread(target=_tracker_server, args=(sock, self.stop_key))
+        self.thread = threading.Thread(
+            target=_tracker_server, args=(sock, self.stop_key, scheduler)
+        )
         self.thread.start()
         self.host = host
 
 
 def _popen_start_tracker_server(
-    host, port=9190, port_end=9199, silent=False, reuse_addr=True, timeout=None
+    host,
+    port=9190,
+    port_end=9199,
+    silent=False,
+    reuse_addr=True,
+    timeout=None,
+    scheduler="priority",
 ):
     # This is a function that will be sent to the
     # Popen worker to run on a separate process.
     # Create and start the server in a different thread
-    state = PopenTrackerServerState(host, port, port_end, silent, reuse_addr, timeout)
+    state = PopenTrackerServerState(host, port, port_end, silent, reuse_addr, timeout, scheduler)
     PopenTrackerServerState.current = state
     # returns the port so that the main can get the port number.
     return (state.port, state.stop_key)
@@ -461,17 +587,33 @@ class Tracker:
     timeout: float, optional
          set a timeout for all operations on the socket
 
+    scheduler: str, optional
+        The scheduler of the devices of each key, "priority" to assign them FIFO, or
+        "load_balance" to assign the faster devices first and report their throughput.
+
     """
 
     def __init__(
-        self, host="0.0.0.0", port=9190, port_end=9199, silent=False, reuse_addr=True, timeout=None
+        self,
+        host="0.0.0.0",
+        port=9190,
+        port_end=9199,
+        silent=False,
+        reuse_addr=True,
+        timeout=None,
+        scheduler="priority",
     ):
+        if scheduler not in SCHEDULERS:
+            raise ValueError(
+                f"Unknown tracker scheduler {scheduler}, expected one of {list(SCHEDULERS)}"
+            )
         if silent:
             logger.setLevel(logging.WARN)
         self.proc = PopenWorker()
         # send the function
         self.proc.send(
-            _popen_start_tracker_server, [host, port, port_end, silent, reuse_addr, timeout]
+            _popen_start_tracker_server,
+            [host, port, port_end, silent, reuse_addr, timeout, scheduler],
         )
         # receive the port
         self.port, self.stop_key = self.proc.recv()
@@ -309,6 +309,65 @@ class Device(tvm_ffi.core.Device):
         """
         _ffi_api.Device_SetStream(self, stream)
 
+    def create_raw_event(self):
+        """Create a new runtime event at the context.
+
+        User should free the event after use.
+
+        Returns
+        -------
+        event : TVMEventHandle
+            The created runtime event.
+        """
+        return _ffi_api.Device_EventCreate(self)
+
+    def free_raw_event(self, event):
+        """Free a created event handle.
+
+        Parameters
+        ----------
+        event : TVMEventHandle
+            The event which should to be released.
+        """
+        _ffi_api.Device_EventFree(self, event)
+
+    def record_event(self, event, stream=None):
+        """Record an event at the end of the jobs submitted to a stream so far.
+
+        Parameters
+        ----------
+        event : TVMEventHandle
+            The event to record.
+
+        stream : TVMStreamHandle
+            The stream to record the event in, the default stream if None.
+        """
+        _ffi_api.Device_EventRecord(self, event, stream or 0)
+
+    def stream_wait_event(self, event, stream=None):
+        """Make the jobs submitted to a stream from now on wait for a recorded event, without
+        blocking the host.
+
+        Parameters
+        ----------
+        event : TVMEventHandle
+            The event to wait for.
+
+        stream : TVMStreamHandle
+            The stream that waits, the default stream if None.
+        """
+        _ffi_api.Device_StreamWaitEvent(self, stream or 0, event)
+
+    def sync_event(self, event):
+        """Synchronize until the jobs before a recorded event finished.
+
+        Parameters
+        ----------
+        event : TVMEventHandle
+            The event to wait for.
+        """
+        _ffi_api.Device_EventSync(self, event)
+
     def sync(self, stream=None):
         """Synchronize until jobs finished at the context.
 
@@ -18,6 +18,7 @@
 """TVM distributed runtime API."""
 
 from .session import (
+    DiscoTrace,
     DModule,
     DPackedFunc,
     DRef,
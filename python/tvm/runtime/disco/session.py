@@ -19,10 +19,13 @@
 with the distributed runtime.
 """
 
+import contextlib
+import json
 import logging
 import os
 import pickle
-from collections.abc import Callable, Sequence
+import time
+from collections.abc import Callable, Iterator, Sequence
 from typing import Any, Optional, Union
 
 import numpy as np
@@ -100,6 +103,96 @@ class DModule(DRef):
         return DPackedFunc(func(self, name, False), self.session)
 
 
+class DiscoTrace:
+    """The merged timeline of a traced Disco session.
+
+    Attributes
+    ----------
+    events : List[Dict[str, Any]]
+        The recorded regions. Each event has the keys "worker", "name", "cat" ("call" for
+        commands sent by the controller, "ccl" for collective communication), "ts" (start time
+        in microseconds, on the controller's clock) and "dur" (duration in microseconds).
+
+    clock_offsets : List[float]
+        The estimated offset, in microseconds, of each worker's clock relative to the
+        controller's clock.
+    """
+
+    def __init__(self, events: list[dict[str, Any]], clock_offsets: list[float]) -> None:
+        self.events = events
+        self.clock_offsets = clock_offsets
+
+    def chrome_trace(self) -> dict[str, Any]:
+        """Return the timeline in the Chrome trace event format, with one track per worker.
+        The result can be dumped as JSON and loaded in chrome://tracing or Perfetto."""
+        trace_events = []
+        for worker_id in sorted({event["worker"] for event in self.events}):
+            trace_events.append(
+                {
+                    "name": "process_name",
+                    "ph": "M",
+                    "pid": worker_id,
+                    "args": {"name": f"worker {worker_id}"},
+                }
+            )
+        for event in self.events:
+            trace_events.append(
+                {
+                    "name": event["name"],
+                    "cat": event["cat"],
+                    "ph": "X",
+                    "ts": event["ts"],
+                    "dur": event["dur"],
+                    "pid": event["worker"],
+                    "tid": 0,
+                }
+            )
+        return {"traceEvents": trace_events, "displayTimeUnit": "ms"}
+
+    def save_chrome_trace(self, path: str) -> None:
+        """Save the timeline in the Chrome trace event format.
+
+        Parameters
+        ----------
+        path : str
+            The path of the JSON file to be written.
+        """
+        with open(path, "w") as f:
+            json.dump(self.chrome_trace(), f)
+
+    def report(self) -> Object:
+        """Return the recorded regions as a profiling report.
+
+        Returns
+        -------
+        report : tvm.runtime.profiling.Report
+            A report with one call per region, where "Device" is the worker. Use
+            `report.table(aggregate=True)` to aggregate the calls by name and worker.
+        """
+        # pylint: disable=import-outside-toplevel
+        from ..profiling import Count, Duration, Report
+
+        calls = []
+        totals: dict[str, float] = {}
+        for event in self.events:
+            device = f"worker{event['worker']}"
+            calls.append(
+                {
+                    "Name": event["name"],
+                    "Device": device,
+                    "Category": event["cat"],
+                    "Duration (us)": Duration(float(event["dur"])),
+                    "Count": Count(1),
+                }
+            )
+            if event["cat"] == "call":
+                totals[device] = totals.get(device, 0.0) + event["dur"]
+        device_metrics = {
+            device: {"Duration (us)": Duration(total)} for device, total in totals.items()
+        }
+        return Report(calls, device_metrics, {"Executor": "Disco"})
+
+
 @register_object("runtime.disco.Session")
 class Session(Object):
     """A Disco interactive session. It allows users to interact with the Disco command queue with
@@ -224,6 +317,90 @@ class Session(Object):
         """
         return _ffi_api.SessionCallPacked(self, 0, 0, func, *args)  # type: ignore # pylint: disable=no-member
 
+    def begin_batch(self) -> None:
+        """Start recording a batch of commands. Until `submit_batch` is called, the commands
+        issued to the session are recorded instead of being sent to the workers. The DRefs
+        returned by recorded commands can be used as arguments of later commands in the batch.
+
+        Note
+        ----
+        Commands that wait for a reply from the workers, such as `sync_worker_0` and
+        `DRef.debug_get_from_remote`, cannot be issued while a batch is being recorded.
+        """
+        _ffi_api.SessionBeginBatch(self)  # type: ignore # pylint: disable=no-member
+
+    def submit_batch(self) -> None:
+        """Send the recorded batch of commands to the workers as a single message. The workers
+        execute the commands in the order they were recorded."""
+        _ffi_api.SessionSubmitBatch(self)  # type: ignore # pylint: disable=no-member
+
+    @contextlib.contextmanager
+    def batch(self) -> Iterator[None]:
+        """Record the commands issued inside the context as a batch, and submit the batch when
+        leaving the context.
+
+        Examples
+        --------
+        .. code-block:: python
+
+            with sess.batch():
+                y = sess.call_packed(f0, x)
+                z = sess.call_packed(f1, y)
+            sess.sync_worker_0()
+        """
+        self.begin_batch()
+        try:
+            yield
+        finally:
+            self.submit_batch()
+
+    def start_trace(self) -> None:
+        """Start recording the timeline of every worker. Until `stop_trace` is called, each
+        command sent by the controller and each collective communication is timed on the
+        workers.
+
+        Note
+        ----
+        While tracing, the workers synchronize their device before and after each recorded
+        region, so the traced run is slower than an untraced one and overlaps less.
+        """
+        self._get_cached_method("runtime.disco.trace_start")()
+
+    def stop_trace(self, num_clock_samples: int = 5) -> DiscoTrace:
+        """Stop recording and merge the timelines of all workers on the controller.
+
+        Parameters
+        ----------
+        num_clock_samples : int
+            The number of round trips used to estimate the clock offset of each worker.
+            The sample with the shortest round trip is kept.
+
+        Returns
+        -------
+        trace : DiscoTrace
+            The merged timeline, with all timestamps on the controller's clock.
+        """
+        timelines = self._get_cached_method("runtime.disco.trace_stop")()
+        clock = self._get_cached_method("runtime.disco.trace_clock_us")
+        clock_offsets = []
+        for worker_id in range(self.num_workers):
+            best_rtt, best_offset = None, 0.0
+            for _ in range(num_clock_samples):
+                start = time.time_ns() / 1000
+                worker_us = clock().debug_get_from_remote(worker_id)
+                end = time.time_ns() / 1000
+                if best_rtt is None or end - start < best_rtt:
+                    best_rtt, best_offset = end - start, worker_us - (start + end) / 2
+            clock_offsets.append(best_offset)
+        events = []
+        for worker_id in range(self.num_workers):
+            for event in json.loads(str(timelines.debug_get_from_remote(worker_id))):
+                event["worker"] = worker_id
+                event["ts"] = event["ts"] - clock_offsets[worker_id]
+                events.append(event)
+        events.sort(key=lambda event: event["ts"])
+        return DiscoTrace(events, clock_offsets)
+
     def _sync_worker(self, worker_id: int) -> None:
         """Synchronize the controller with a worker, and it will wait until the worker finishes
         executing all the existing instructions. This function is usually used for worker-0, because
@@ -523,6 +700,260 @@ class Session(Object):
         func = self._get_cached_method("runtime.disco.allgather")
         func(src, in_group, dst)
 
+    def allreduce_async(
+        self,
+        src: DRef,
+        dst: DRef,
+        op: str = "sum",  # pylint: disable=invalid-name
+        in_group: bool = True,
+    ) -> DRef:
+        """Launch an allreduce operation on the dedicated communication stream of each
+        worker, so that independent computation can overlap with it. `dst` must not be
+        read before the returned handle is waited via `wait`.
+
+        Parameters
+        ----------
+        src : DRef
+            The array to be reduced.
+
+        dst : DRef
+            The array to receive the reduced outcome.
+
+        op : str = "sum"
+            The reduce operation to be performed. Available options are the same as
+            `allreduce`.
+
+        in_group : bool
+            Whether the reduce operation performs globally or in group as default.
+
+        Returns
+        -------
+        handle : DRef
+            The handle of the asynchronous collective on each worker.
+        """
+        if op not in REDUCE_OPS:
+            raise ValueError(f"Unsupported reduce op: {op}. Available ops are: {REDUCE_OPS.keys()}")
+        op = ShapeTuple([REDUCE_OPS[op]])
+        func = self._get_cached_method("runtime.disco.allreduce_async")
+        return func(src, op, in_group, dst)
+
+    def allgather_async(
+        self,
+        src: DRef,
+        dst: DRef,
+        in_group: bool = True,
+    ) -> DRef:
+        """Launch an allgather operation on the dedicated communication stream of each
+        worker. `dst` must not be read before the returned handle is waited via `wait`.
+
+        Parameters
+        ----------
+        src : DRef
+            The array to be gathered from.
+
+        dst : DRef
+            The array to be gathered to.
+
+        in_group : bool
+            Whether the gather operation performs globally or in group as default.
+
+        Returns
+        -------
+        handle : DRef
+            The handle of the asynchronous collective on each worker.
+        """
+        func = self._get_cached_method("runtime.disco.allgather_async")
+        return func(src, in_group, dst)
+
+    def wait(self, handle: DRef) -> None:
+        """Make the default stream of each worker wait for an asynchronous collective.
+        It does not block the host, and each handle can be waited only once.
+
+        Parameters
+        ----------
+        handle : DRef
+            The handle returned by `allreduce_async` or `allgather_async`.
+        """
+        func = self._get_cached_method("runtime.disco.wait")
+        func(handle)
+
+    def reduce_scatter(
+        self,
+        src: DRef,
+        dst: DRef,
+        op: str = "sum",  # pylint: disable=invalid-name
+        in_group: bool = True,
+    ) -> DRef:
+        """Perform a reduce-scatter operation on an array. The reduced array is chunked
+        into equal parts along its flattened layout, and each worker receives one of them.
+
+        Parameters
+        ----------
+        src : DRef
+            The array to be reduced.
+
+        dst : DRef
+            The array to receive the shard of the reduced array. Its size must be the size
+            of `src` divided by the number of workers.
+
+        op : str = "sum"
+            The reduce operation to be performed. Available options are:
+            - "sum"
+            - "prod"
+            - "min"
+            - "max"
+            - "avg"
+
+        in_group : bool
+            Whether the reduce operation performs globally or in group as default.
+        """
+        if op not in REDUCE_OPS:
+            raise ValueError(f"Unsupported reduce op: {op}. Available ops are: {REDUCE_OPS.keys()}")
+        op = ShapeTuple([REDUCE_OPS[op]])
+        func = self._get_cached_method("runtime.disco.reduce_scatter")
+        func(src, op, in_group, dst)
+
+    def all_to_all(
+        self,
+        src: DRef,
+        dst: DRef,
+        send_splits: Optional[Sequence[int]] = None,
+        recv_splits: Optional[Sequence[int]] = None,
+        in_group: bool = True,
+    ) -> DRef:
+        """Perform an all-to-all operation on an array. Worker i sends its j-th chunk of
+        `src` to worker j, which stores it as its i-th chunk of `dst`.
+
+        Parameters
+        ----------
+        src : DRef
+            The array to be exchanged.
+
+        dst : DRef
+            The array to receive the exchanged chunks.
+
+        send_splits : Optional[Sequence[int]]
+            The number of rows (along axis 0) of `src` sent to each worker.
+            When None, `src` is chunked into equal parts.
+
+        recv_splits : Optional[Sequence[int]]
+            The number of rows (along axis 0) of `dst` received from each worker.
+            It must be provided if and only if `send_splits` is provided.
+
+        in_group : bool
+            Whether the all-to-all operation performs globally or in group as default.
+        """
+        if (send_splits is None) != (recv_splits is None):
+            raise ValueError("send_splits and recv_splits must be both provided or both None")
+        send_splits = ShapeTuple(send_splits if send_splits is not None else [])
+        recv_splits = ShapeTuple(recv_splits if recv_splits is not None else [])
+        func = self._get_cached_method("runtime.disco.all_to_all")
+        func(src, send_splits, recv_splits, in_group, dst)
+
+    def ring_send_recv(self, src: DRef, dst: DRef, in_group: bool = True) -> None:
+        """Perform a step of a ring exchange. Worker i sends `src` to worker (i + 1) % n, and
+        receives `dst` from worker (i - 1) % n, where n is the number of workers of the ring.
+
+        Parameters
+        ----------
+        src : DRef
+            The array sent to the next worker.
+
+        dst : DRef
+            The array to receive the one sent by the previous worker.
+
+        in_group : bool
+            Whether the ring is formed by the workers of each group or by all the workers.
+        """
+        func = self._get_cached_method("runtime.disco.ring_send_recv")
+        func(src, in_group, dst)
+
+    def ring_send_recv_async(self, src: DRef, dst: DRef, in_group: bool = True) -> DRef:
+        """Launch a step of a ring exchange on the dedicated communication stream of each
+        worker. `dst` must not be read before the returned handle is waited via `wait`.
+
+        Parameters
+        ----------
+        src : DRef
+            The array sent to the next worker.
+
+        dst : DRef
+            The array to receive the one sent by the previous worker.
+
+        in_group : bool
+            Whether the ring is formed by the workers of each group or by all the workers.
+
+        Returns
+        -------
+        handle : DRef
+            The handle of the asynchronous collective on each worker.
+        """
+        func = self._get_cached_method("runtime.disco.ring_send_recv_async")
+        return func(src, in_group, dst)
+
+    def pipeline_forward(  # pylint: disable=too-many-arguments
+        self,
+        module: DModule,
+        stage_funcs: Sequence[str],
+        num_micro_batches: int,
+        input: DRef | None,  # pylint: disable=redefined-builtin
+        activation_shape: Sequence[int],
+        activation_dtype: str,
+        output: DRef | None,
+        measure_time: bool = False,
+    ) -> DRef:
+        """Run micro-batches through pipeline stages, where each worker group is a stage.
+        At tick `t`, stage `s` runs micro-batch `t - s` and sends its output to the next
+        stage, so that all stages are busy once the pipeline is filled.
+
+        Parameters
+        ----------
+        module : DModule
+            The module containing the stage functions.
+
+        stage_funcs : Sequence[str]
+            The name of the function of each stage. A stage function takes the activation
+            of a micro-batch and returns the activation passed to the next stage.
+
+        num_micro_batches : int
+            The number of micro-batches.
+
+        input : Optional[DRef]
+            The input split along axis 0 into micro-batches. Only used by the first stage.
+
+        activation_shape : Sequence[int]
+            The shape of the activation received by the stages except the first.
+
+        activation_dtype : str
+            The dtype of the activation received by the stages except the first.
+
+        output : Optional[DRef]
+            The output split along axis 0 into micro-batches. Only used by the last stage.
+
+        measure_time : bool
+            Whether to measure the compute and communication time, which synchronizes
+            the device around each step.
+
+        Returns
+        -------
+        stats : DRef
+            The statistics of each worker as a ShapeTuple of
+            `(num_ticks, busy_ticks, compute_us, comm_us)`, where the bubble ratio of
+            the stage is `1 - busy_ticks / num_ticks`.
+        """
+        stage_funcs = self.call_packed(self.get_global_func("ffi.Array"), *stage_funcs)
+        func = self._get_cached_method("runtime.disco.pipeline_forward")
+        return func(
+            module,
+            stage_funcs,
+            num_micro_batches,
+            input,
+            ShapeTuple(activation_shape),
+            activation_dtype,
+            output,
+            measure_time,
+        )
+
     def _clear_ipc_memory_pool(self):
         # Clear the IPC memory allocator when the allocator exists.
         name = "runtime.disco.cuda_ipc.cuda_ipc_memory_allocator_clear"
@@ -545,7 +976,7 @@ class ThreadedSession(Session):
 
 @register_object("runtime.disco.ProcessSession")
 class ProcessSession(Session):
-    """A Disco session backed by pipe-based multi-processing."""
+    """A Disco session backed by multi-processing, with shared-memory or pipe channels."""
 
     def __init__(
         self,
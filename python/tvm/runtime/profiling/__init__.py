@@ -211,6 +211,25 @@ class MetricCollector(Object):
     """Interface for user defined profiling metric collection."""
 
 
+@_ffi.register_object("runtime.profiling.PerfEventMetricCollector")
+class PerfEventMetricCollector(MetricCollector):
+    """Collects the CPU hardware counters of Linux perf events for each CPU call, along with the
+    IPC and the cache miss rates they give. Requires TVM built with ``USE_PERF_EVENT``.
+
+    Parameters
+    ----------
+    events: Optional[List[str]]
+        The perf events to count, e.g. ``"cycles"``, ``"instructions"``, ``"cache-misses"`` or
+        ``"LLC-load-misses"``. Defaults to the cycles, instructions, cache references and cache
+        misses.
+    """
+
+    def __init__(self, events: Optional[Sequence[str]] = None):
+        if events is None:
+            events = ["cycles", "instructions", "cache-references", "cache-misses"]
+        self.__init_handle_by_constructor__(_ffi_api.PerfEventMetricCollector, events)
+
+
 @_ffi.register_object("runtime.profiling.DeviceWrapper")
 class DeviceWrapper(Object):
     """Wraps a tvm.runtime.Device"""
@@ -237,7 +256,7 @@ def profile_function(mod, dev, collectors, func_name=None, warmup_iters=10):
         prof = tvm.runtime.profiling.profile_function(
             f,
             tvm.cpu(),
-            [tvm.runtime.profiling.PAPIMetricCollector({tvm.cpu(): ["PAPI_FP_OPS"]}),
+            [tvm.runtime.profiling.PerfEventMetricCollector(["cycles", "instructions"])],
         )
         counters = prof(*args)
         print(counters)
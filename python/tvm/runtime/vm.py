@@ -18,6 +18,7 @@
 # ruff: noqa: RUF005
 """The Relax virtual machine."""
 
+import time
 from collections.abc import Callable
 from enum import IntEnum
 from numbers import Integral, Number
@@ -39,11 +40,28 @@ class VMInstrumentReturnKind(IntEnum):
     SKIP_RUN = 1
 
 
+class VMFuture:
+    """The future of an asynchronous call of a VM function, see `VirtualMachine.invoke_async`."""
+
+    def __init__(self, handle: Object) -> None:
+        self.handle = handle
+
+    def done(self) -> bool:
+        """Whether the work of the call on the devices is done."""
+        return bool(tvm.get_global_func("vm.builtin.future_is_done")(self.handle))
+
+    def wait(self) -> Any:
+        """Wait for the work of the call on the devices to be done, and return its result."""
+        return tvm.get_global_func("vm.builtin.future_wait")(self.handle)
+
+
 class VirtualMachine:
     """Relax VM runtime."""
 
     NAIVE_ALLOCATOR = 1
     POOLED_ALLOCATOR = 2
+    POOLED_BEST_FIT_ALLOCATOR = 3
+    STREAM_ORDERED_ALLOCATOR = 4
 
     def __init__(
         self,
@@ -65,11 +83,14 @@ class VirtualMachine:
 
         memory_cfg : Optional[Union[str, Dict[Device, str]]]
             Config the type of memory allocator. The allocator type can be ["naive",
-            "pooled"]. If memory_cfg is None, all devices will use pooled allocator
-            by default. If memory_cfg is string, all devices will use the specified
-            allocator type. If memory_cfg is a dict, each device uses the allocator
-            type specified in the dict, or pooled allocator if not specified in the
-            dict.
+            "pooled", "pooled_best_fit", "stream_ordered"]. If memory_cfg is None, all devices will use
+            pooled allocator by default. If memory_cfg is string, all devices will use
+            the specified allocator type. If memory_cfg is a dict, each device uses the
+            allocator type specified in the dict, or pooled allocator if not specified
+            in the dict. The "pooled_best_fit" allocator reuses cached blocks of
+            different sizes, which suits dynamic-shape workloads. The "stream_ordered"
+            allocator uses the CUDA stream-ordered memory pools and is only available
+            on CUDA devices.
 
         profile : Optional[bool]
             Whether or not to enable profiling.
@@ -81,7 +102,13 @@ class VirtualMachine:
                 raise ValueError("Expect the rt_mod to be an runtime.Module")
 
         load_exec = "vm_profiler_load_executable" if profile else "vm_load_executable"
+        self._rt_mod = rt_mod
         self.module = rt_mod[load_exec]()
+        self._bind_functions()
+        self._setup_device(device, memory_cfg)
+
+    def _bind_functions(self) -> None:
+        """cache the functions of the VM module."""
         self._invoke_closure = self.module["invoke_closure"]
         self._save_function = self.module["save_function"]
         self._set_input = self.module["set_input"]
@@ -91,7 +118,6 @@ class VirtualMachine:
         self._get_function_arity = self.module["get_function_arity"]
         self._get_function_param_name = self.module["get_function_param_name"]
         self._set_instrument = self.module["set_instrument"]
-        self._setup_device(device, memory_cfg)
 
     def _setup_device(self, dev: Device, memory_cfg: str | dict[Device, str]) -> None:
         """init devices and allocators."""
@@ -109,9 +135,13 @@ class VirtualMachine:
         if memory_cfg is None:
             memory_cfg = {}
         elif isinstance(memory_cfg, str):
-            assert memory_cfg in ["naive", "pooled"]
+            assert memory_cfg in ["naive", "pooled", "pooled_best_fit", "stream_ordered"]
             if memory_cfg == "naive":
                 default_alloc_type = VirtualMachine.NAIVE_ALLOCATOR
+            elif memory_cfg == "pooled_best_fit":
+                default_alloc_type = VirtualMachine.POOLED_BEST_FIT_ALLOCATOR
+            elif memory_cfg == "stream_ordered":
+                default_alloc_type = VirtualMachine.STREAM_ORDERED_ALLOCATOR
             memory_cfg = {}
         elif not isinstance(memory_cfg, dict):
             raise TypeError(
@@ -123,8 +153,33 @@ class VirtualMachine:
             init_args.append(device.dlpack_device_type() % RPC_SESS_MASK)
             init_args.append(device.index)
             alloc_type = memory_cfg[device] if device in memory_cfg else default_alloc_type
+            if (
+                alloc_type == VirtualMachine.STREAM_ORDERED_ALLOCATOR
+                and device.dlpack_device_type() % RPC_SESS_MASK != tvm.cuda().dlpack_device_type()
+            ):
+                # stream-ordered allocation is CUDA only, other devices keep the pooled allocator
+                alloc_type = VirtualMachine.POOLED_ALLOCATOR
             init_args.append(alloc_type)
         self.module["vm_initialization"](*init_args)
+        self._devices = devs
+
+    def fork(self) -> "VirtualMachine":
+        """Create a VM that shares the program of this VM, i.e. its constants on the devices,
+        its functions and its allocators, and has its own state of execution, such as the
+        inputs, the outputs and the instrument. It is created without initializing the program
+        again, and runs concurrently with this VM, e.g. one VM for each thread serving requests.
+
+        Returns
+        -------
+        vm : VirtualMachine
+            The forked VM.
+        """
+        vm = VirtualMachine.__new__(VirtualMachine)
+        vm.module = self.module["fork"]()
+        vm._rt_mod = self._rt_mod  # pylint: disable=protected-access
+        vm._devices = self._devices  # pylint: disable=protected-access
+        vm._bind_functions()  # pylint: disable=protected-access
+        return vm
 
     def __getitem__(self, key: str) -> PackedFunc:
         return self.module[key]
@@ -297,6 +352,36 @@ class VirtualMachine:
         """
         self._invoke_stateful(func_name)
 
+    def invoke_async(
+        self, func_name: str, *args: Any, callback: Callable[[Any], None] | None = None
+    ) -> VMFuture:
+        """
+        Call the named function from the VM module without waiting for its work on the devices.
+        The host code of the function runs in the calling thread, which returns once the kernels
+        are submitted to the current streams of the devices. The future is done when the streams
+        are done with them, and the callback is then called with the result in another thread.
+
+        The calls of a VM are submitted to the same streams. To keep several streams busy from
+        one thread, run the calls on forks of the VM that use different streams.
+
+        Parameters
+        ----------
+        func_name: str
+            The name of the function to call.
+
+        args: List[Any]
+            The arguments to the function.
+
+        callback: Optional[Callable[[Any], None]]
+            The function called with the result when the call is done.
+
+        Returns
+        -------
+        future: VMFuture
+            The future of the call, whose `wait` returns the result.
+        """
+        return VMFuture(self.module["invoke_async"](func_name, callback, *args))
+
     def get_outputs(self, func_name: str) -> tvm.Object | tuple[Any]:
         """
         Get the value output by the function by the given name
@@ -368,6 +453,127 @@ class VirtualMachine:
         """
         self._set_instrument(instrument)
 
+    def set_nvtx_ranges(self, enable: bool = True) -> None:
+        """Put each call instruction of the VM in an NVTX range, named after its callee and the
+        Relax binding it computes, e.g. ``RelaxVM: matmul (lv3)``, so that the kernels in an
+        Nsight trace can be traced back to the bindings. The ranges are no-ops when TVM is not
+        built with NVTX.
+
+        Parameters
+        ----------
+        enable: bool
+            Whether to put the instructions in NVTX ranges.
+        """
+        self.module["set_nvtx_ranges"](enable)
+
+    def warmup(
+        self,
+        shapes: dict[str, list[Any]],
+        device: Device | None = None,
+    ) -> dict[str, Any]:
+        """Run the functions on dummy inputs, e.g. at load, so that the lazy initialization of
+        their first calls, i.e. the loading and the JIT compilation of the device modules, the
+        creation of the library handles, the allocation of the workspaces and the pools, and the
+        heuristics of the libraries, happens before the traffic. Each call is run twice, the
+        second run measuring its steady state.
+
+        Parameters
+        ----------
+        shapes : Dict[str, List[Any]]
+            The inputs of the functions, by their names, e.g. from
+            `tvm.relax.analysis.get_warmup_shapes`. The inputs of a call are a list of
+            (shape, dtype) pairs, for zero tensors, or of the tensors themselves. A function is
+            called once for each list of inputs when given a list of these lists, e.g. to warm
+            up each shape bucket.
+
+        device : Optional[Device]
+            The device of the dummy inputs, the first device of the VM by default.
+
+        Returns
+        -------
+        report : Dict[str, Any]
+            The seconds spent in each component of the warmup: "module_load" for the device
+            modules, "input_alloc" for the dummy inputs, "first_call" for the first calls and
+            "lazy_init" for the time of the first calls above their steady state. "calls" has
+            the "first_call" and "steady_call" seconds of each call, by its "func" and "shapes".
+        """
+        device = device or self._devices[0]
+
+        def _is_input(value):
+            if isinstance(value, tvm.runtime.Tensor | np.ndarray):
+                return True
+            return isinstance(value, list | tuple) and len(value) == 2 and isinstance(value[1], str)
+
+        def _sync():
+            for dev in self._devices:
+                dev.sync()
+
+        report: dict[str, Any] = {
+            "module_load": 0.0,
+            "input_alloc": 0.0,
+            "first_call": 0.0,
+            "lazy_init": 0.0,
+            "calls": [],
+        }
+        # The device modules are loaded lazily at their first launches, on each device.
+        module_warmups = {
+            tvm.cuda().dlpack_device_type(): "runtime.cuda_module_warmup",
+            tvm.rocm().dlpack_device_type(): "runtime.rocm_module_warmup",
+        }
+        tic = time.perf_counter()
+        for dev_type, fname in module_warmups.items():
+            fwarmup = tvm.get_global_func(fname, allow_missing=True)
+            device_ids = [
+                dev.index for dev in self._devices if dev.dlpack_device_type() == dev_type
+            ]
+            if fwarmup is not None and device_ids:
+                fwarmup(self._rt_mod, device_ids)
+        report["module_load"] = time.perf_counter() - tic
+
+        for func_name, calls in shapes.items():
+            if not calls or _is_input(calls[0]):
+                calls = [calls]
+            for inputs in calls:
+                tic = time.perf_counter()
+                args = []
+                for value in inputs:
+                    if not _is_input(value):
+                        raise TypeError(f"Invalid warmup input {value} of {func_name}")
+                    if isinstance(value, tvm.runtime.Tensor):
+                        args.append(value)
+                        continue
+                    if isinstance(value, np.ndarray):
+                        args.append(tvm.runtime.tensor(value, device))
+                        continue
+                    shape, dtype = value
+                    try:
+                        args.append(tvm.runtime.tensor(np.zeros(shape, dtype=dtype), device))
+                    except TypeError:
+                        # The dtypes unknown to numpy stay uninitialized.
+                        args.append(tvm.runtime.empty(shape, dtype, device))
+                _sync()
+                report["input_alloc"] += time.perf_counter() - tic
+
+                func = self.module[func_name]
+                durations = []
+                for _ in range(2):
+                    tic = time.perf_counter()
+                    func(*args)
+                    _sync()
+                    durations.append(time.perf_counter() - tic)
+                first_call, steady_call = durations
+                report["first_call"] += first_call
+                report["lazy_init"] += max(first_call - steady_call, 0.0)
+                report["calls"].append(
+                    {
+                        "func": func_name,
+                        "shapes": [tuple(arg.shape) for arg in args],
+                        "first_call": first_call,
+                        "steady_call": steady_call,
+                    }
+                )
+        return report
+
     def time_evaluator(
         self,
         func_name: str,
@@ -477,7 +683,7 @@ class VirtualMachine:
             f_preproc=f_preproc,
         )
 
-    def profile(self, func_name: str, *args):
+    def profile(self, func_name: str, *args, collectors=None):
         """Profile a function call.
 
         Parameters
@@ -488,6 +694,10 @@ class VirtualMachine:
         args: List of Tensor or other objects supported by PackedFunc.
             The arguments to the function.
 
+        collectors: Optional[Sequence[tvm.runtime.profiling.MetricCollector]]
+            Extra metric collectors, e.g. of hardware counters, whose metrics are reported for
+            each call along with its duration. They cannot be used over RPC.
+
         Returns
         -------
         report: tvm.runtime.profiling.Report
@@ -498,6 +708,8 @@ class VirtualMachine:
         for arg in args:
             self._convert(arg, cargs)
 
+        if collectors is not None:
+            self.module["set_profiler_collectors"](list(collectors))
         report_json = self.module["profile"](func_name, *cargs)
         return Report.from_json(report_json)
 
@@ -183,6 +183,62 @@ def estimate_tir_flops(stmt_or_mod: Stmt | IRModule) -> float:
     return _ffi_api.EstimateTIRFlops(stmt_or_mod)  # type: ignore # pylint: disable=no-member
 
 
+def estimate_tir_memory_traffic(func: PrimFunc) -> int | None:
+    """Estimate the DRAM traffic of a PrimFunc, i.e. the bytes of its buffer parameters, each
+    read and written once.
+
+    It is the compulsory traffic of a call of the function, taken as the memory term of its
+    roofline, i.e. the caches are assumed to keep the data reused by the call.
+
+    Parameters
+    ----------
+    func: PrimFunc
+        The PrimFunc to be estimated.
+
+    Returns
+    -------
+    nbytes: Optional[int]
+        The estimated bytes, or None if a buffer accessed has a symbolic shape.
+    """
+    return _ffi_api.EstimateTIRMemoryTraffic(func)  # type: ignore # pylint: disable=no-member
+
+
+def estimate_tir_roofline(mod: IRModule) -> dict[str, dict[str, float]]:
+    """Estimate the roofline terms of the PrimFuncs of an IRModule.
+
+    Parameters
+    ----------
+    mod: IRModule
+        The IRModule to be estimated.
+
+    Returns
+    -------
+    result : Dict[str, Dict[str, float]]
+        The "flops", the DRAM "bytes" and the "arithmetic_intensity", i.e. FLOPs per byte, of a
+        call of each PrimFunc, by its global symbol. The PrimFuncs accessing the buffers of
+        symbolic shapes, or whose FLOPs cannot be estimated, are omitted.
+    """
+    result = {}
+    for g_var, func in mod.functions_items():
+        if not isinstance(func, PrimFunc):
+            continue
+        nbytes = estimate_tir_memory_traffic(func)
+        if nbytes is None:
+            continue
+        try:
+            flops = estimate_tir_flops(IRModule({g_var: func}))
+        except tvm.error.InternalError:
+            # The nodes the FLOP estimator does not know, e.g. of the PrimFuncs lowered already.
+            continue
+        name = (func.attrs or {}).get("global_symbol", g_var.name_hint)
+        result[str(name)] = {
+            "flops": flops,
+            "bytes": float(nbytes),
+            "arithmetic_intensity": flops / nbytes if nbytes > 0 else 0.0,
+        }
+    return result
+
+
 def OOBChecker():
     """Detect out of bounds memory access in arrays.
 
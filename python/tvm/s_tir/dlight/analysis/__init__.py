@@ -28,6 +28,7 @@ from .common_analysis import (
     get_root_block,
     get_sblock_info,
 )
+from .embedding_bag import EmbeddingBagBlocks, match_embedding_bag
 from .gemv import (
     is_gemv,
     normalize,
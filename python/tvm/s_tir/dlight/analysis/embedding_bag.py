@@ -0,0 +1,106 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Analysis for the embedding bags, i.e. the reductions of the rows gathered from a table."""
+
+from typing import NamedTuple
+
+from tvm import s_tir, tir
+
+from .common_analysis import SBlockInfo
+
+
+class EmbeddingBagBlocks(NamedTuple):
+    """The blocks of an embedding bag, e.g. of `topi.nn.embedding_bag`."""
+
+    pool: SBlockInfo
+    """The reduction of the gathered rows of each bag, of the iteration domain (..., dim, bag)."""
+    count: SBlockInfo | None
+    """The reduction counting the indices of each bag for the mean, of the domain (..., bag)."""
+    epilogue: SBlockInfo | None
+    """The spatial block computing the output from the pooled rows, e.g. the mean or cast."""
+
+
+def _has_gathered_row(block: tir.SBlock, dim_var: tir.Var) -> bool:
+    """Whether the block reads the row of a 2-D table at an index loaded from another buffer,
+    along the given iteration variable."""
+    found = False
+
+    def _visit(node):
+        nonlocal found
+        if not isinstance(node, tir.BufferLoad) or len(node.indices) != 2:
+            return
+        if not node.indices[1].same_as(dim_var):
+            return
+        has_load = False
+
+        def _visit_index(index_node):
+            nonlocal has_load
+            if isinstance(index_node, tir.BufferLoad):
+                has_load = True
+
+        tir.stmt_functor.post_order_visit(node.indices[0], _visit_index)
+        found = found or has_load
+
+    tir.stmt_functor.post_order_visit(block.body, _visit)
+    return found
+
+
+def match_embedding_bag(
+    sch: s_tir.Schedule, block_infos: list[SBlockInfo]
+) -> EmbeddingBagBlocks | None:
+    """Match the blocks of a PrimFunc to an embedding bag.
+
+    Parameters
+    ----------
+    sch : s_tir.Schedule
+        The schedule
+
+    block_infos : List[SBlockInfo]
+        The blocks of the normalized PrimFunc
+
+    Returns
+    -------
+    ret : Optional[EmbeddingBagBlocks]
+        The blocks of the embedding bag if the PrimFunc is one, otherwise None.
+    """
+    pool, count, epilogue = None, None, None
+    for block_info in block_infos:
+        dom_kind = block_info.dom_kind()
+        if block_info.is_injective():
+            if epilogue is not None:
+                return None
+            epilogue = block_info
+            continue
+        if not block_info.is_reduction() or dom_kind != "S" * (len(dom_kind) - 1) + "R":
+            return None
+        block = sch.get(block_info.block_rv)
+        if len(dom_kind) >= 2 and _has_gathered_row(block, block.iter_vars[-2].var):
+            if pool is not None:
+                return None
+            pool = block_info
+        elif count is None:
+            count = block_info
+        else:
+            return None
+    if pool is None or (epilogue is not None and epilogue is not block_infos[-1]):
+        return None
+    num_spatial = len(pool.iters) - 1
+    if count is not None and (epilogue is None or len(count.iters) != num_spatial):
+        return None
+    if epilogue is not None and len(epilogue.iters) != num_spatial:
+        return None
+    return EmbeddingBagBlocks(pool, count, epilogue)
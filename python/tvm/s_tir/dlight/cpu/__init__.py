@@ -19,4 +19,7 @@
 CPU-generic schedule rules.
 """
 
+from .embedding_bag import EmbeddingBag
 from .gemv import GEMV
+from .injective import Injective
+from .transpose import Transpose
@@ -16,7 +16,9 @@
 # under the License.
 """Base schedule rule for CPU operators."""
 
+from tvm import DataType
 from tvm.target import Target
+from tvm.target.codegen import llvm_get_vector_width
 
 from ..base import ScheduleRule
 
@@ -38,3 +40,25 @@ class CPUScheduleRule(ScheduleRule):  # pylint: disable=too-few-public-methods
             Whether the target is available for this rule.
         """
         return super().is_target_available(target) and "llvm" == target.kind.name
+
+
+def get_vector_lanes(target: Target, dtype: str) -> int:
+    """Get the number of elements of the given dtype in a native vector of the target.
+
+    Parameters
+    ----------
+    target : Target
+        The compilation target.
+
+    dtype : str
+        The dtype of the elements.
+
+    Returns
+    -------
+    lanes : int
+        The number of elements in a vector register.
+    """
+    vector_width = llvm_get_vector_width(target)
+    if vector_width <= 0:
+        vector_width = 128
+    return max(1, vector_width // 8 // DataType(dtype).itemsize)
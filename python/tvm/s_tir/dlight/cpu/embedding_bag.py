@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A rule for the embedding bags, e.g. `topi.nn.embedding_bag`."""
+
+from tvm import s_tir, tir
+from tvm.target import Target
+
+from ..analysis import match_embedding_bag, normalize_prim_func
+from ..base import get_extent, try_inline
+from .base import CPUScheduleRule, get_vector_lanes
+from .injective import MIN_PARALLEL_ELEMENTS
+
+# The number of indices of a bag whose rows are prefetched ahead of the one being pooled.
+PREFETCH_DISTANCE = 8
+
+
+class EmbeddingBag(CPUScheduleRule):
+    """A rule for the PrimFuncs pooling the rows of a table gathered by the bags of indices.
+
+    The bags are parallelized. Each vector of the rows is pooled over the indices of a bag in a
+    local accumulator, i.e. in registers, and the rows of the indices `PREFETCH_DISTANCE` ahead
+    are prefetched by InjectSoftwarePrefetch, as the gathered rows are usually not in cache.
+    """
+
+    def apply(  # pylint: disable=too-many-locals
+        self,
+        func: tir.PrimFunc,
+        target: Target,
+        _: bool,
+    ) -> None | s_tir.Schedule | list[s_tir.Schedule]:
+        if not isinstance(func, tir.PrimFunc) or not self.is_target_available(target):
+            return None
+        sch = s_tir.Schedule(func)
+        block_infos = normalize_prim_func(sch)
+        if block_infos is None:
+            return None
+        block_infos = try_inline(sch, block_infos)
+        blocks = match_embedding_bag(sch, block_infos)
+        if blocks is None:
+            return None
+
+        pool = blocks.pool.block_rv
+        if blocks.epilogue is None:
+            epilogue = sch.cache_write(pool, 0, "local")
+        else:
+            epilogue = blocks.epilogue.block_rv
+            sch.set_scope(pool, 0, "local")
+        *batch_loops, dim_loop = sch.get_loops(epilogue)
+        dim = get_extent(sch, dim_loop)
+        if not batch_loops or not isinstance(dim, int):
+            return None
+        num_elements = dim
+        for loop in batch_loops:
+            num_elements *= get_extent(sch, loop)
+
+        # The pooled rows are computed under the loops of the output, so that the partial sums
+        # of a vector of the rows stay in registers over the indices of a bag.
+        lanes = get_vector_lanes(target, sch.get(pool).writes[0].buffer.dtype)
+        outer = sch.fuse(*batch_loops) if len(batch_loops) > 1 else batch_loops[0]
+        if dim > lanes and dim % lanes == 0:
+            dim_loop, _ = sch.split(dim_loop, factors=[None, lanes])
+        else:
+            dim_loop = outer
+        sch.compute_at(pool, dim_loop, preserve_unit_loops=True)
+        if blocks.count is not None:
+            sch.compute_at(blocks.count.block_rv, outer)
+            sch.set_scope(blocks.count.block_rv, 0, "local")
+        vec, bag_loop = sch.get_loops(pool)[-2:]
+        sch.reorder(bag_loop, vec)
+        init = sch.decompose_reduction(pool, bag_loop)
+
+        # The tails of the rows would be scalarized, and then not prefetched.
+        if dim <= lanes or dim % lanes == 0:
+            for block in [pool, init, epilogue]:
+                sch.vectorize(sch.get_loops(block)[-1])
+        bag_size = get_extent(sch, bag_loop)
+        if not isinstance(bag_size, int) or bag_size > 1:
+            sch.annotate(bag_loop, "software_prefetch_distance", PREFETCH_DISTANCE)
+        if not isinstance(num_elements, int) or num_elements >= MIN_PARALLEL_ELEMENTS:
+            sch.parallel(outer)
+        return sch
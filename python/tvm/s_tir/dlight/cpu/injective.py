@@ -0,0 +1,80 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A rule for the injective operators, e.g. take, gather, concatenate and layout_transform."""
+
+from tvm import s_tir, tir
+from tvm.target import Target
+
+from ..analysis import normalize_prim_func
+from ..base import get_extent, try_inline
+from .base import CPUScheduleRule, get_vector_lanes
+
+# The number of elements below which a loop nest is not worth the launch of the parallel tasks.
+MIN_PARALLEL_ELEMENTS = 1 << 14
+
+
+class Injective(CPUScheduleRule):
+    """A rule for the PrimFuncs whose blocks are all spatial once inlined, e.g. the elementwise
+    and transform operators. The innermost loop of each block, along the last axis of the output,
+    is vectorized, so that the contiguous reads and writes become vector loads and stores and
+    the others, e.g. the indices of take and gather, vector gathers. The outer loops are fused
+    and parallelized.
+    """
+
+    def apply(  # pylint: disable=too-many-locals
+        self,
+        func: tir.PrimFunc,
+        target: Target,
+        _: bool,
+    ) -> None | s_tir.Schedule | list[s_tir.Schedule]:
+        if not isinstance(func, tir.PrimFunc) or not self.is_target_available(target):
+            return None
+        sch = s_tir.Schedule(func)
+        block_infos = normalize_prim_func(sch)
+        if block_infos is None:
+            return None
+        block_infos = try_inline(sch, block_infos)
+        if not block_infos or not all(block_info.is_injective() for block_info in block_infos):
+            return None
+
+        for block_info in block_infos:
+            block = block_info.block_rv
+            loops = sch.get_loops(block)
+            # the loops shared with a block already scheduled are left as they are
+            if not loops or any(sch.get(loop).kind != tir.ForKind.SERIAL for loop in loops):
+                continue
+            num_elements = 1
+            for loop in loops:
+                num_elements *= get_extent(sch, loop)
+
+            lanes = get_vector_lanes(target, sch.get(block).writes[0].buffer.dtype)
+            len_inner = get_extent(sch, loops[-1])
+            if isinstance(len_inner, int) and len_inner > 1:
+                # A tail would be scalarized, so only the multiples of the vector are split.
+                if len_inner <= lanes:
+                    sch.vectorize(loops[-1])
+                    loops = loops[:-1]
+                elif len_inner % lanes == 0:
+                    inner, vec = sch.split(loops[-1], factors=[None, lanes])
+                    sch.vectorize(vec)
+                    loops = [*loops[:-1], inner]
+            if not loops:
+                continue
+            outer = sch.fuse(*loops) if len(loops) > 1 else loops[0]
+            if not isinstance(num_elements, int) or num_elements >= MIN_PARALLEL_ELEMENTS:
+                sch.parallel(outer)
+        return sch
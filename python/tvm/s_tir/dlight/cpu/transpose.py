@@ -0,0 +1,103 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A rule for the transposes that move the innermost axis."""
+
+from tvm import s_tir, tir
+from tvm.target import Target
+
+from ..analysis import normalize_prim_func
+from ..base import get_extent, try_inline
+from .base import CPUScheduleRule, get_vector_lanes
+from .injective import MIN_PARALLEL_ELEMENTS
+
+
+class Transpose(CPUScheduleRule):
+    """A rule for the transposes whose innermost axis of the output is not the innermost axis of
+    the input, which read the input with a stride when written along the output. The two axes are
+    tiled by the vector length: each tile of the input is read into registers with vector loads
+    along its rows, and written with vector stores along its columns, for which LLVM shuffles the
+    registers. The tiles are parallelized.
+    """
+
+    def apply(  # pylint: disable=too-many-locals,too-many-return-statements
+        self,
+        func: tir.PrimFunc,
+        target: Target,
+        _: bool,
+    ) -> None | s_tir.Schedule | list[s_tir.Schedule]:
+        if not isinstance(func, tir.PrimFunc) or not self.is_target_available(target):
+            return None
+        sch = s_tir.Schedule(func)
+        block_infos = normalize_prim_func(sch)
+        if block_infos is None:
+            return None
+        block_infos = try_inline(sch, block_infos)
+        if len(block_infos) != 1 or not block_infos[0].is_injective():
+            return None
+        block_info = block_infos[0]
+        block = sch.get(block_info.block_rv)
+
+        # out[..., i, ..., j] = inp[..., j, ..., i], with the block vars in the order of the loops
+        store = block.body
+        if not isinstance(store, tir.BufferStore) or not isinstance(store.value, tir.BufferLoad):
+            return None
+        load = store.value
+        iter_vars = [iter_info.var for iter_info in block_info.iters]
+        if len(block.reads) != 1 or len(store.indices) != len(iter_vars):
+            return None
+        if any(not index.same_as(var) for index, var in zip(store.indices, iter_vars)):
+            return None
+        axes = [
+            next((axis for axis, var in enumerate(iter_vars) if index.same_as(var)), -1)
+            for index in load.indices
+        ]
+        if sorted(axes) != list(range(len(iter_vars))):
+            return None
+        in_axis, out_axis = axes[-1], len(iter_vars) - 1
+        if in_axis == out_axis:
+            return None
+
+        tile = min(get_vector_lanes(target, store.buffer.dtype), 16)
+        if tile < 2:
+            return None
+        loops = block_info.get_loops()
+        extents = [get_extent(sch, loop) for loop in loops]
+        if any(
+            not isinstance(extents[axis], int) or extents[axis] % tile != 0
+            for axis in [in_axis, out_axis]
+        ):
+            return None
+
+        io, ii = sch.split(loops[in_axis], factors=[None, tile])
+        jo, ji = sch.split(loops[out_axis], factors=[None, tile])
+        others = [loop for axis, loop in enumerate(loops) if axis not in [in_axis, out_axis]]
+        sch.reorder(*others, io, jo, ii, ji)
+
+        # the tile of the input, read along its innermost axis
+        cache = sch.cache_read(block_info.block_rv, read_buffer_index=0, storage_scope="local")
+        sch.compute_at(cache, jo, preserve_unit_loops=True)
+        sch.vectorize(sch.get_loops(cache)[-1])
+        sch.unroll(ii)
+        sch.vectorize(ji)
+
+        outer = sch.fuse(*others, io, jo)
+        num_elements = 1
+        for extent in extents:
+            num_elements *= extent
+        if not isinstance(num_elements, int) or num_elements >= MIN_PARALLEL_ELEMENTS:
+            sch.parallel(outer)
+        return sch
@@ -20,6 +20,7 @@ GPU-generic schedule rules.
 For CUDA/ROCm/Vulkan/Metal-specific rules, use `tvm.s_tir.dlight.cuda/rocm/vulkan/metal` instead
 """
 
+from .embedding_bag import EmbeddingBag
 from .gemv import GEMV
 from .low_batch_gemv import LowBatchGEMV
 from .fallback import Fallback
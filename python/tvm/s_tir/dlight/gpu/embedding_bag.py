@@ -0,0 +1,83 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A rule for the embedding bags, e.g. `topi.nn.embedding_bag`."""
+
+from tvm import s_tir, tir
+from tvm.target import Target
+
+from ..analysis import match_embedding_bag, normalize_prim_func
+from ..base import get_extent, try_inline
+from .base import GPUScheduleRule
+
+# The number of threads of a thread block.
+NUM_THREADS = 128
+
+
+class EmbeddingBag(GPUScheduleRule):
+    """A rule for the PrimFuncs pooling the rows of a table gathered by the bags of indices.
+
+    Each bag is pooled by a warp, whose threads read consecutive elements of each gathered row,
+    so that the reads of a row are coalesced. The partial sums of a thread are kept in local
+    memory, and the bags of a thread block are independent, so no reduction across the threads
+    is needed.
+    """
+
+    def apply(  # pylint: disable=too-many-locals
+        self,
+        func: tir.PrimFunc,
+        target: Target,
+        _: bool,
+    ) -> None | s_tir.Schedule | list[s_tir.Schedule]:
+        if not isinstance(func, tir.PrimFunc) or not self.is_target_available(target):
+            return None
+        sch = s_tir.Schedule(func)
+        block_infos = normalize_prim_func(sch)
+        if block_infos is None:
+            return None
+        block_infos = try_inline(sch, block_infos)
+        blocks = match_embedding_bag(sch, block_infos)
+        if blocks is None:
+            return None
+
+        pool = blocks.pool.block_rv
+        if blocks.epilogue is None:
+            epilogue = sch.cache_write(pool, 0, "local")
+        else:
+            epilogue = blocks.epilogue.block_rv
+            sch.set_scope(pool, 0, "local")
+        *batch_loops, dim_loop = sch.get_loops(epilogue)
+        dim = get_extent(sch, dim_loop)
+        if not batch_loops or not isinstance(dim, int):
+            return None
+        # The rows narrower than a warp are pooled by a part of a warp.
+        num_tx = min(int(target.thread_warp_size), dim)
+        num_ty = max(1, NUM_THREADS // num_tx)
+
+        batch = sch.fuse(*batch_loops) if len(batch_loops) > 1 else batch_loops[0]
+        bx, ty = sch.split(batch, factors=[None, num_ty])
+        dim_outer, tx = sch.split(dim_loop, factors=[None, num_tx])
+        sch.reorder(tx, dim_outer)
+        sch.bind(bx, "blockIdx.x")
+        sch.bind(ty, "threadIdx.y")
+        sch.bind(tx, "threadIdx.x")
+
+        sch.compute_at(pool, tx, preserve_unit_loops=True)
+        if blocks.count is not None:
+            sch.compute_at(blocks.count.block_rv, ty)
+            sch.set_scope(blocks.count.block_rv, 0, "local")
+        sch.decompose_reduction(pool, sch.get_loops(pool)[-2])
+        return sch
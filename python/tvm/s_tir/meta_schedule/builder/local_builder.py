@@ -17,6 +17,7 @@
 # ruff: noqa: F401
 """Local builder that compile on the local host"""
 
+import functools
 import os
 import tempfile
 from collections.abc import Callable
@@ -68,6 +69,8 @@ class LocalBuilder(PyBuilder):
         The timeout in seconds for the build.
     initializer: Optional[Callable[[], None]]
         The initializer function for each popen worker.
+    maximum_process_uses: Optional[int]
+        The number of builds after which a worker process is recycled.
     f_build : Union[None, str, T_BUILD]
         Name of the build function to be used.
         Defaults to `meta_schedule.builder.default_build`.
@@ -103,11 +106,16 @@ class LocalBuilder(PyBuilder):
     The worker process is only aware of functions registered in TVM package,
     if there are extra functions to be registered,
     please send the registration logic via initializer.
+
+    The worker processes are kept alive across calls to `build`, so that the imports
+    and the LLVM initialization of a worker are paid once rather than per batch.
+    A worker is recycled after `maximum_process_uses` builds to bound its memory growth.
     """
 
     max_workers: int
     timeout_sec: float
     initializer: Callable[[], None] | None
+    maximum_process_uses: int | None
     f_build: None | str | T_BUILD
     f_export: None | str | T_EXPORT
 
@@ -119,6 +127,7 @@ class LocalBuilder(PyBuilder):
         f_build: None | str | T_BUILD = None,
         f_export: None | str | T_EXPORT = None,
         initializer: Callable[[], None] | None = None,
+        maximum_process_uses: int | None = 64,
     ) -> None:
         """Constructor.
 
@@ -137,6 +146,9 @@ class LocalBuilder(PyBuilder):
             Defaults to `meta_schedule.builder.default_export`.
         initializer : Optional[Callable[[], None]]
             The initializer to be used for the worker processes.
+        maximum_process_uses : Optional[int]
+            The number of builds after which a worker process is recycled.
+            None means a worker is only restarted after a timeout or a crash.
         """
         super().__init__()
 
@@ -147,25 +159,18 @@ class LocalBuilder(PyBuilder):
         self.max_workers = max_workers
         self.timeout_sec = timeout_sec
         self.initializer = initializer
+        self.maximum_process_uses = maximum_process_uses
         self.f_build = f_build
         self.f_export = f_export
+        self._pool: PopenPoolExecutor | None = None
         self._sanity_check()
 
     def build(self, build_inputs: list[BuilderInput]) -> list[BuilderResult]:
         results: list[BuilderResult] = []
         map_result: MapResult
 
-        # Here we restart the PopenPool everytime because of a known memory leak issue with the
-        # PopenPool workers after a couple times of usage. We don't apply the same to runners to
-        # avoid potential problem caused by async behaviour.
-        pool = PopenPoolExecutor(
-            max_workers=self.max_workers,
-            timeout=self.timeout_sec,
-            initializer=self.initializer,
-        )
-
         # Dispatch the build inputs to the worker processes.
-        for map_result in pool.map_with_error_catching(
+        for map_result in self._get_pool().map_with_error_catching(
             lambda x: _worker_func(*x),
             [
                 (
@@ -196,23 +201,42 @@ class LocalBuilder(PyBuilder):
                 )
             else:
                 raise ValueError("Unreachable: unexpected result: {map_result}")
-        pool.shutdown()
         return results
 
+    def _get_pool(self) -> PopenPoolExecutor:
+        # The workers leak memory after a number of builds, which is why they are recycled
+        # after `maximum_process_uses` builds instead of living forever.
+        if self._pool is None:
+            self._pool = PopenPoolExecutor(
+                max_workers=self.max_workers,
+                timeout=self.timeout_sec,
+                initializer=functools.partial(_worker_initializer, self.initializer),
+                maximum_process_uses=self.maximum_process_uses,
+            )
+        return self._pool
+
     def _sanity_check(self) -> None:
         def _check(f_build, f_export) -> None:
             get_global_func_with_default_on_worker(name=f_build, default=None)
             get_global_func_with_default_on_worker(name=f_export, default=None)
 
-        # Same reason for the single use PopenPool as mentioned above
-        pool = PopenPoolExecutor(
-            max_workers=self.max_workers,
-            timeout=self.timeout_sec,
-            initializer=self.initializer,
-        )
-        value = pool.submit(_check, self.f_build, self.f_export)
+        value = self._get_pool().submit(_check, self.f_build, self.f_export)
         value.result()
-        pool.shutdown()
+
+
+def _worker_initializer(initializer: Callable[[], None] | None) -> None:
+    if initializer is not None:
+        initializer()
+    # Warm up the worker, so that the first build does not pay for the imports
+    # of the build pipeline and the initialization of LLVM.
+    # pylint: disable=import-outside-toplevel,unused-import
+    import tvm.driver
+    import tvm.s_tir.tensor_intrin
+    from tvm.runtime import enabled
+
+    # pylint: enable=import-outside-toplevel,unused-import
+    if enabled("llvm"):
+        Target("llvm")
 
 
 def _worker_func(
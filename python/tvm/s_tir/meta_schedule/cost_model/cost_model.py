@@ -42,7 +42,7 @@ from ..utils import _get_default_str
 class CostModel(Object):
     """Cost model."""
 
-    CostModelType = Union["CostModel", Literal["xgb", "mlp", "random"]]
+    CostModelType = Union["CostModel", Literal["xgb", "gbdt", "mlp", "random"]]
 
     def load(self, path: str) -> None:
         """Load the cost model from given file location.
@@ -110,7 +110,7 @@ class CostModel(Object):
 
     @staticmethod
     def create(
-        kind: Literal["xgb", "mlp", "random", "none"],
+        kind: Literal["xgb", "gbdt", "mlp", "random", "none"],
         *args,
         **kwargs,
     ) -> "CostModel":
@@ -118,15 +118,19 @@ class CostModel(Object):
 
         Parameters
         ----------
-        kind : Literal["xgb", "mlp", "random", "none"]
-            The kind of the cost model. Can be "xgb", "mlp", "random" or "none".
+        kind : Literal["xgb", "gbdt", "mlp", "random", "none"]
+            The kind of the cost model. Can be "xgb", "gbdt", "mlp", "random" or "none".
 
         Returns
         -------
         cost_model : CostModel
             The created cost model.
         """
-        from . import RandomModel, XGBModel  # pylint: disable=import-outside-toplevel
+        from . import (  # pylint: disable=import-outside-toplevel
+            GBDTModel,
+            RandomModel,
+            XGBModel,
+        )
 
         if kind == "xgb":
             return XGBModel(*args, **kwargs)  # type: ignore
@@ -138,6 +142,8 @@ class CostModel(Object):
             if param in kwargs:
                 kwargs.pop(param)
 
+        if kind == "gbdt":
+            return GBDTModel(*args, **kwargs)  # type: ignore
         if kind == "random":
             return RandomModel(*args, **kwargs)  # type: ignore
         if kind == "mlp":
@@ -0,0 +1,97 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Gradient-boosted decision tree cost model trained and evaluated natively."""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from ..feature_extractor import FeatureExtractor
+from .cost_model import CostModel
+
+
+@register_object("s_tir.meta_schedule.GBDTCostModel")
+class GBDTModel(CostModel):
+    """Gradient-boosted decision tree cost model.
+
+    Unlike XGBModel, the features, the training and the predictions stay in C++, so that the
+    search does not call back into Python to score candidates. The trees fit the same pack-sum
+    squared error objective as XGBModel, on features bucketed into quantile histograms, and are
+    retrained from scratch when enough new data is collected.
+
+    Parameters
+    ----------
+    extractor : FeatureExtractor.FeatureExtractorType
+        The feature extractor for the model.
+    num_warmup_samples : int
+        The number of samples before the model gives predictions other than random ones.
+    adaptive_training : bool
+        Whether to retrain only when the data has grown by 20% since the last training.
+    num_rounds : int
+        The number of boosting rounds, i.e. of trees.
+    max_depth : int
+        The maximum depth of a tree.
+    learning_rate : float
+        The shrinkage applied to the output of each tree.
+    reg_lambda : float
+        The L2 regularization on the leaf outputs.
+    min_child_weight : float
+        The minimum sum of hessians in a child of a split.
+    max_bin : int
+        The maximum number of histogram bins per feature, at most 255.
+    seed : int
+        The random seed of the predictions before warmup, -1 for a random one.
+    """
+
+    extractor: FeatureExtractor
+    num_warmup_samples: int
+    adaptive_training: bool
+    num_rounds: int
+    max_depth: int
+    learning_rate: float
+    reg_lambda: float
+    min_child_weight: float
+    max_bin: int
+
+    def __init__(
+        self,
+        *,
+        extractor: FeatureExtractor.FeatureExtractorType = "per-store-feature",
+        num_warmup_samples: int = 100,
+        adaptive_training: bool = True,
+        num_rounds: int = 100,
+        max_depth: int = 10,
+        learning_rate: float = 0.2,
+        reg_lambda: float = 1.0,
+        min_child_weight: float = 0.001,
+        max_bin: int = 64,
+        seed: int = -1,
+    ):
+        if not isinstance(extractor, FeatureExtractor):
+            extractor = FeatureExtractor.create(extractor)
+        self.__init_handle_by_constructor__(
+            _ffi_api.CostModelGBDTCostModel,  # type: ignore # pylint: disable=no-member
+            extractor,
+            num_warmup_samples,
+            adaptive_training,
+            num_rounds,
+            max_depth,
+            learning_rate,
+            reg_lambda,
+            min_child_weight,
+            max_bin,
+            seed,
+        )
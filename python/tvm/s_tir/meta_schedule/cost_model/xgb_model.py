@@ -26,7 +26,6 @@ from typing import TYPE_CHECKING, Any, Literal, NamedTuple, Optional
 import numpy as np  # type: ignore
 
 from ....contrib.tar import tar, untar
-from ....runtime import Tensor
 from ..cost_model import PyCostModel
 from ..feature_extractor import FeatureExtractor
 from ..logging import get_logger
@@ -484,15 +483,12 @@ class XGBModel(PyCostModel):
         group = self.data.get(new_group_hash, None)
 
         # Step 2. Extract features
-        def _feature(x: Tensor) -> np.ndarray:
-            return x.numpy().astype("float32")
-
         def _mean_cost(x: RunnerResult) -> float:
             if not x.run_secs:
                 return 1e10
             return float(np.median([float(s) for s in x.run_secs]))
 
-        new_features = [_feature(x) for x in self.extractor.extract_from(context, candidates)]
+        new_features = self._extract_features(context, candidates)
         new_mean_costs = [_mean_cost(x) for x in results]
 
         # Filter instances with no features
@@ -569,15 +565,7 @@ class XGBModel(PyCostModel):
             The predicted normalized score.
         """
         if self.data_size >= self.num_warmup_samples and self.booster is not None:
-            ret = self._predict(
-                xs=[
-                    x.numpy().astype("float32")
-                    for x in self.extractor.extract_from(
-                        context,
-                        candidates,
-                    )
-                ]
-            )
+            ret = self._predict(xs=self._extract_features(context, candidates))
         else:
             ret = np.random.uniform(
                 low=0,
@@ -586,6 +574,17 @@ class XGBModel(PyCostModel):
             )
         return ret.astype("float64")
 
+    def _extract_features(
+        self,
+        context: "TuneContext",
+        candidates: list[MeasureCandidate],
+    ) -> list[np.ndarray]:
+        """Extract the float32 features of each candidate as views of a single matrix."""
+        if not candidates:
+            return []
+        features, row_offsets = self.extractor.extract_batch(context, candidates)
+        return np.split(features.numpy(), row_offsets.numpy()[1:-1])
+
     def _train(  # type: ignore # pylint: disable=invalid-name
         self,
         xs: list[np.ndarray],
@@ -21,6 +21,7 @@ The database that stores serialized tuning records and workloads
 """
 
 from .database import Database, PyDatabase, TuningRecord, Workload, create
+from .indexed_database import IndexedDatabase
 from .json_database import JSONDatabase
 from .memory_database import MemoryDatabase
 from .ordered_union_database import OrderedUnionDatabase
@@ -317,6 +317,34 @@ class Database(Object):
         """
         return _ffi_api.DatabaseQueryIRModule(self, mod, target, workload_name)  # type: ignore # pylint: disable=no-member
 
+    def query_fuzzy_tuning_records(
+        self,
+        mod: IRModule,
+        target: Target,
+        top_k: int,
+    ) -> list[TuningRecord]:
+        """Query the best records of other workloads whose anchor block has the same structure as
+        the one of the given module up to loop extents and buffer shapes, with their traces
+        replayed onto the given module and their tile sizes rescaled to its loop extents.
+
+        Parameters
+        ----------
+        mod : IRModule
+            The IRModule to be searched for.
+        target : Target
+            The target to be searched for.
+        top_k : int
+            The maximum number of records to be returned.
+
+        Returns
+        -------
+        tuning_records : List[TuningRecord]
+            The adapted records, best first, without running time.
+        """
+        return _ffi_api.DatabaseQueryFuzzyTuningRecords(  # type: ignore # pylint: disable=no-member
+            self, mod, target, top_k
+        )
+
     def dump_pruned(self, destination: "Database") -> None:
         """Dump the pruned database to files of JSONDatabase format.
 
@@ -378,7 +406,8 @@ class Database(Object):
     @staticmethod
     def create(  # pylint: disable=keyword-arg-before-vararg
         kind: (
-            Literal["json", "memory", "union", "ordered_union"] | Callable[[Schedule], bool]
+            Literal["json", "indexed", "memory", "union", "ordered_union"]
+            | Callable[[Schedule], bool]
         ) = "json",
         *args,
         **kwargs,
@@ -387,10 +416,10 @@ class Database(Object):
 
         Parameters
         ----------
-        kind : str = "json" | "memory" | "union" | "ordered_union" | Callable[[tvm.s_tir.Schedule],
-        bool]
+        kind : str = "json" | "indexed" | "memory" | "union" | "ordered_union" |
+        Callable[[tvm.s_tir.Schedule], bool]
             The kind of the database to be created. The following kinds are supported:
-            "json", "memory", "union", "ordered_union", and a custom schedule function.
+            "json", "indexed", "memory", "union", "ordered_union", and a custom schedule function.
 
         Returns
         -------
@@ -398,6 +427,7 @@ class Database(Object):
             The created database.
         """
         from . import (  # pylint: disable=import-outside-toplevel
+            IndexedDatabase,
             JSONDatabase,
             MemoryDatabase,
             OrderedUnionDatabase,
@@ -409,6 +439,8 @@ class Database(Object):
             return ScheduleFnDatabase(kind, *args, **kwargs)  # type: ignore
         if kind == "json":
             return JSONDatabase(*args, **kwargs)
+        if kind == "indexed":
+            return IndexedDatabase(*args, **kwargs)  # type: ignore
         if kind == "memory":
             return MemoryDatabase(*args, **kwargs)  # type: ignore
         if kind == "union":
@@ -0,0 +1,79 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""The database that keeps an append-only index of binary tuning records on disk"""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from .database import Database
+
+
+@register_object("s_tir.meta_schedule.IndexedDatabase")
+class IndexedDatabase(Database):
+    """Database class backed by an on-disk index of binary tuning records.
+
+    Unlike JSONDatabase, opening the database only reads a compact index of the tuning records.
+    Workloads and tuning records are loaded when they are queried, so opening a large database is
+    fast and the memory used is proportional to the workloads queried.
+
+    Multiple processes, e.g. concurrent tuning jobs, may share the same database directory.
+    Commits are serialized by a file lock, and queries see the records committed by the other
+    processes without reopening the database.
+
+    Parameters
+    ----------
+    path : str
+        The path to the directory of the database.
+    module_equality : Optional[str]
+        A string to specify the module equality testing and hashing method.
+        It must be one of the followings:
+          - "structural": Use StructuralEqual/Hash
+          - "ignore-tensor": Same as "structural", but ignore tensor raw data during
+                              equality testing and hashing.
+          - "anchor-block": Apply equality testing and hashing on the anchor block extracted from a
+                            given module. The "ignore-tensor" varint is used for the extracted
+                            blocks or in case no anchor block is found.
+                            For the definition of the anchor block, see tir/analysis/analysis.py.
+        A database can only be reopened with the module equality it was created with.
+    """
+
+    path: str
+
+    def __init__(
+        self,
+        path: str,
+        *,
+        allow_missing: bool = True,
+        module_equality: str = "structural",
+    ) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        path : str
+            The path to the directory of the database.
+        allow_missing : bool
+            Whether to create the database when the given path is not found.
+        module_equality : str
+            A string to specify the module equality testing and hashing method.
+        """
+        self.__init_handle_by_constructor__(
+            _ffi_api.DatabaseIndexedDatabase,  # type: ignore # pylint: disable=no-member
+            path,
+            allow_missing,
+            module_equality,
+        )
@@ -64,6 +64,33 @@ class FeatureExtractor(Object):
         )
         return result
 
+    def extract_batch(
+        self, context: TuneContext, candidates: list[MeasureCandidate]
+    ) -> tuple[Tensor, Tensor]:
+        """Extract features from the given measure candidates into a single contiguous matrix.
+
+        Parameters
+        ----------
+        context : TuneContext
+            The tuning context for feature extraction.
+        candidates : List[MeasureCandidate]
+            The measure candidates to extract features from.
+
+        Returns
+        -------
+        features : Tensor
+            The float32 matrix of the features of all the candidates, concatenated along the
+            first dimension.
+        row_offsets : Tensor
+            The int64 vector of length `len(candidates) + 1`. The rows of the i-th candidate are
+            `features[row_offsets[i] : row_offsets[i + 1]]`.
+        """
+        result = _ffi_api.FeatureExtractorExtractBatch(  # type: ignore # pylint: disable=no-member
+            self, context, candidates
+        )
+        features, row_offsets = result
+        return features, row_offsets
+
     @staticmethod
     def create(
         kind: Literal["per-store-feature"],
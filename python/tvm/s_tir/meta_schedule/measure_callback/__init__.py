@@ -18,6 +18,7 @@
 """The tvm.s_tir.meta_schedule.measure_callback package."""
 
 from .add_to_database import AddToDatabase
+from .log_metrics import LogMetrics
 from .measure_callback import MeasureCallback, PyMeasureCallback
 from .remove_build_artifact import RemoveBuildArtifact
 from .update_cost_model import UpdateCostModel
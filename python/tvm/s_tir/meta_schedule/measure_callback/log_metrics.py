@@ -0,0 +1,49 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A measure callback that logs the metrics of every tuning round"""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from .measure_callback import MeasureCallback
+
+
+@register_object("s_tir.meta_schedule.LogMetrics")
+class LogMetrics(MeasureCallback):
+    def __init__(self, path: str) -> None:
+        """A measure callback that appends the metrics of every round of every task to a
+        JSON-lines file.
+
+        Each line holds the task id and name, the round index, the seconds elapsed, the number
+        of candidates, build failures, run failures and successful measurements, the best
+        latency of the round and of the task so far, the counters of the search strategy under
+        `search`, and `cost_model_rank_corr`, the Spearman correlation of the cost model
+        predictions with the measured throughputs.
+
+        To evaluate the cost model on candidates it has not been trained on, place the callback
+        before `UpdateCostModel`, e.g.
+        `[LogMetrics(path), *MeasureCallback.create("default")]`.
+
+        Parameters
+        ----------
+        path : str
+            The path of the JSON-lines file.
+        """
+        self.__init_handle_by_constructor__(
+            _ffi_api.MeasureCallbackLogMetrics,  # type: ignore # pylint: disable=no-member
+            path,
+        )
@@ -42,6 +42,14 @@ class EvaluatorConfig(NamedTuple):
         increase the number of runs to the given time (in ms) to reduce the measurement error.
     enable_cpu_cache_flush: bool
         Whether to flush the cache on CPU.
+    enable_gpu_cache_flush: bool
+        Whether to flush the L2 cache on CUDA GPUs before every repeat.
+    max_median_ci: Optional[float]
+        If set, keep measuring until the half-width of the 95% confidence interval of the median
+        latency, relative to the median, is at most this value, or `max_measure_ms` is reached.
+        None means the measurement is run exactly once.
+    max_measure_ms: int
+        The maximum time in ms spent measuring one candidate when `max_median_ci` is set.
 
     Note
     ----
@@ -53,6 +61,18 @@ class EvaluatorConfig(NamedTuple):
     repeat: int = 1
     min_repeat_ms: int = 100
     enable_cpu_cache_flush: bool = False
+    enable_gpu_cache_flush: bool = False
+    max_median_ci: float | None = None
+    max_measure_ms: int = 1000
+
+    @property
+    def f_preproc(self) -> str:
+        """The name of the function the time evaluator calls before every repeat."""
+        if self.enable_cpu_cache_flush:
+            return "cache_flush_cpu_non_first_arg"
+        if self.enable_gpu_cache_flush:
+            return "l2_cache_flush_cuda"
+        return ""
 
     @staticmethod
     def _normalized(config: Optional["EvaluatorConfig"]) -> "EvaluatorConfig":
@@ -63,7 +83,14 @@ class EvaluatorConfig(NamedTuple):
             repeat=config.repeat,
             min_repeat_ms=config.min_repeat_ms,
             enable_cpu_cache_flush=config.enable_cpu_cache_flush,
+            enable_gpu_cache_flush=config.enable_gpu_cache_flush,
+            max_median_ci=config.max_median_ci,
+            max_measure_ms=config.max_measure_ms,
         )
+        if config.enable_cpu_cache_flush and config.enable_gpu_cache_flush:
+            raise ValueError("Only one of the CPU and the GPU cache can be flushed")
+        if config.max_median_ci is not None and config.max_median_ci <= 0:
+            raise ValueError(f"max_median_ci must be positive, got {config.max_median_ci}")
         return config
 
 
@@ -82,6 +109,10 @@ class RPCConfig(NamedTuple):
         Timeout of the RPC session
     session_priority: int
         Priority of the RPC session
+    session_max_requeue: int
+        The maximum number of times to requeue a measurement to another device of the key after
+        its session timed out. Use it with the "load_balance" scheduler of the tracker, which
+        assigns the devices timing out last.
     """
 
     tracker_host: str | None = None
@@ -89,6 +120,7 @@ class RPCConfig(NamedTuple):
     tracker_key: str | None = None
     session_priority: int = 1
     session_timeout_sec: int = 10
+    session_max_requeue: int = 0
 
     def _sanity_check(self) -> None:
         err_str = (
@@ -117,6 +149,7 @@ class RPCConfig(NamedTuple):
             tracker_key=tracker_key,
             session_priority=config.session_priority,
             session_timeout_sec=config.session_timeout_sec,
+            session_max_requeue=config.session_max_requeue,
         )
         config._sanity_check()  # pylint: disable=protected-access
         return config
@@ -18,9 +18,12 @@
 
 import concurrent.futures
 import os.path as osp
+import time
 from collections.abc import Callable
 from contextlib import contextmanager
+from typing import TypeVar
 
+from tvm.base import TVMError
 from tvm.contrib.popen_pool import PopenPoolExecutor
 from tvm.rpc import RPCSession
 from tvm.runtime import Device, Module
@@ -38,11 +41,15 @@ from .utils import (
     T_ARG_INFO_JSON_OBJ_LIST,
     T_ARGUMENT_LIST,
     alloc_argument_common,
+    check_clock_drift,
+    median_ci_ratio,
     run_evaluator_common,
 )
 
 logger = get_logger(__name__)  # pylint: disable=invalid-name
 
+T = TypeVar("T")  # pylint: disable=invalid-name
+
 
 T_CREATE_SESSION = Callable[  # pylint: disable=invalid-name
     [RPCConfig],  # The RPC configuration
@@ -132,6 +139,31 @@ class RPCRunnerFuture(PyRunnerFuture):
         return RunnerResult(run_secs, None)
 
 
+class _BatchItemFuture:
+    """The future of one input of a batch, backed by the future of the whole batch.
+
+    Parameters
+    ----------
+    future: concurrent.futures.Future
+        The future of the batch, whose result is a list of (costs, error message).
+    index: int
+        The index of the input in the batch.
+    """
+
+    def __init__(self, future: concurrent.futures.Future, index: int) -> None:
+        self.future = future
+        self.index = index
+
+    def done(self) -> bool:
+        return self.future.done()
+
+    def result(self) -> list[float]:
+        costs, error_msg = self.future.result()[self.index]
+        if error_msg is not None:
+            raise RuntimeError(error_msg)
+        return costs
+
+
 @derived_object
 class RPCRunner(PyRunner):
     """RPC based runner
@@ -156,6 +188,10 @@ class RPCRunner(PyRunner):
         The function name to run the evaluator or the function itself.
     f_cleanup: Optional[str, Callable]
         The function name to cleanup the session or the function itself.
+    max_batch_size: int
+        The maximum number of inputs measured in a single RPC session. Batched inputs are
+        timed in a single round trip, with their arguments allocated on the server, so
+        `f_alloc_argument` and `f_run_evaluator` are not used.
     pool: PopenPoolExecutor
         The popen pool executor.
 
@@ -230,6 +266,7 @@ class RPCRunner(PyRunner):
     f_alloc_argument: T_ALLOC_ARGUMENT | str | None
     f_run_evaluator: T_RUN_EVALUATOR | str | None
     f_cleanup: T_CLEANUP | str | None
+    max_batch_size: int
 
     pool: PopenPoolExecutor
 
@@ -246,6 +283,7 @@ class RPCRunner(PyRunner):
         f_cleanup: T_CLEANUP | str | None = None,
         max_workers: int | None = None,
         initializer: Callable[[], None] | None = None,
+        max_batch_size: int = 1,
     ) -> None:
         """Constructor
 
@@ -273,6 +311,11 @@ class RPCRunner(PyRunner):
             The maximum number of connections. Defaults to 1.
         initializer: Optional[Callable[[], None]]
             The initializer function.
+        max_batch_size: int
+            The maximum number of inputs measured in a single RPC session. If greater than
+            one, the inputs of a batch are timed in a single round trip with the arguments
+            allocated and randomly filled on the server, and `f_alloc_argument` and
+            `f_run_evaluator` are not used.
         """
         super().__init__()
         self.rpc_config = RPCConfig._normalized(rpc_config)
@@ -284,6 +327,7 @@ class RPCRunner(PyRunner):
         self.f_alloc_argument = f_alloc_argument
         self.f_run_evaluator = f_run_evaluator
         self.f_cleanup = f_cleanup
+        self.max_batch_size = max_batch_size
         if max_workers is None:
             max_workers = 1
         logger.info("RPCRunner: max_workers = %d", max_workers)
@@ -294,6 +338,8 @@ class RPCRunner(PyRunner):
         self._sanity_check()
 
     def run(self, runner_inputs: list[RunnerInput]) -> list[RunnerFuture]:
+        if self.max_batch_size > 1:
+            return self._run_batched(runner_inputs)
         results: list[RunnerFuture] = []
         for runner_input in runner_inputs:
             future = RPCRunnerFuture(
@@ -316,6 +362,37 @@ class RPCRunner(PyRunner):
             results.append(future)  # type: ignore
         return results
 
+    def _run_batched(self, runner_inputs: list[RunnerInput]) -> list[RunnerFuture]:
+        # Inputs of a batch share a device, so group them by device type first.
+        groups: dict[str, list[int]] = {}
+        for i, runner_input in enumerate(runner_inputs):
+            groups.setdefault(str(runner_input.device_type), []).append(i)
+        results: list[RunnerFuture | None] = [None] * len(runner_inputs)
+        for device_type, indices in groups.items():
+            for begin in range(0, len(indices), self.max_batch_size):
+                batch = indices[begin : begin + self.max_batch_size]
+                future = self.pool.submit(
+                    _batch_worker_func,
+                    self.f_create_session,
+                    self.f_upload_module,
+                    self.f_cleanup,
+                    self.rpc_config,
+                    self.evaluator_config,
+                    self.alloc_repeat,
+                    tuple(str(runner_inputs[i].artifact_path) for i in batch),
+                    device_type,
+                    tuple(
+                        tuple(arg_info.as_json() for arg_info in runner_inputs[i].args_info)
+                        for i in batch
+                    ),
+                )
+                for index_in_batch, i in enumerate(batch):
+                    results[i] = RPCRunnerFuture(
+                        future=_BatchItemFuture(future, index_in_batch),
+                        timeout_sec=self.rpc_config.session_timeout_sec,
+                    )
+        return results  # type: ignore
+
     def _sanity_check(self) -> None:
         def _check(
             f_create_session,
@@ -368,47 +445,172 @@ def _worker_func(
         _f_run_evaluator, default_run_evaluator
     )
     f_cleanup: T_CLEANUP = get_global_func_with_default_on_worker(_f_cleanup, default_cleanup)
-    # Managed resources
-    session: RPCSession | None = None
-    remote_path: str | None = None
 
-    @contextmanager
-    def resource_handler():
+    def _run() -> list[float]:
+        # Managed resources
+        session: RPCSession | None = None
+        remote_path: str | None = None
+
+        @contextmanager
+        def resource_handler():
+            try:
+                yield
+            finally:
+                # Final step. Always clean up
+                with Profiler.timeit("RPCRunner/cleanup"):
+                    f_cleanup(session, remote_path)
+
+        with resource_handler():
+            # Step 1. Create session
+            with Profiler.timeit("RPCRunner/create_session"):
+                session = f_create_session(rpc_config)
+                device = session.device(device_type, 0)
+            # Step 2. Upload the module
+            with Profiler.timeit("RPCRunner/upload_module"):
+                _, remote_path = osp.split(artifact_path)
+                local_path: str = artifact_path
+                rt_mod: Module = f_upload_module(session, local_path, remote_path)
+            # Step 3: Allocate input arguments
+            with Profiler.timeit("RPCRunner/alloc_argument"):
+                repeated_args: list[T_ARGUMENT_LIST] = f_alloc_argument(
+                    session,
+                    device,
+                    args_info,
+                    alloc_repeat,
+                )
+            # Step 4: Run time_evaluator
+            with Profiler.timeit("LocalRunner/run_evaluator"):
+                costs: list[float] = f_run_evaluator(
+                    session,
+                    rt_mod,
+                    device,
+                    evaluator_config,
+                    repeated_args,
+                )
+        return costs
+
+    return _run_with_requeue(rpc_config, _run)
+
+
+def _batch_worker_func(
+    _f_create_session: T_CREATE_SESSION | str | None,
+    _f_upload_module: T_UPLOAD_MODULE | str | None,
+    _f_cleanup: T_CLEANUP | str | None,
+    rpc_config: RPCConfig,
+    evaluator_config: EvaluatorConfig,
+    alloc_repeat: int,
+    artifact_paths: tuple[str, ...],
+    device_type: str,
+    args_infos: tuple[T_ARG_INFO_JSON_OBJ_LIST, ...],
+) -> list[tuple[list[float] | None, str | None]]:
+    # Step 0. Get the registered functions
+    f_create_session: T_CREATE_SESSION = get_global_func_with_default_on_worker(
+        _f_create_session, default_create_session
+    )
+    f_upload_module: T_UPLOAD_MODULE = get_global_func_with_default_on_worker(
+        _f_upload_module, default_upload_module
+    )
+    f_cleanup: T_CLEANUP = get_global_func_with_default_on_worker(_f_cleanup, default_cleanup)
+
+    def _run() -> list[tuple[list[float] | None, str | None]]:
+        # Managed resources
+        session: RPCSession | None = None
+        remote_paths: list[str] = []
+
+        @contextmanager
+        def resource_handler():
+            try:
+                yield
+            finally:
+                # Final step. Always clean up
+                with Profiler.timeit("RPCRunner/cleanup"):
+                    for remote_path in remote_paths or [None]:
+                        f_cleanup(session, remote_path)
+
+        results: list[tuple[list[float] | None, str | None]] = [(None, None)] * len(artifact_paths)
+        with resource_handler():
+            # Step 1. Create session
+            with Profiler.timeit("RPCRunner/create_session"):
+                session = f_create_session(rpc_config)
+                device = session.device(device_type, 0)
+            # Step 2. Upload the modules, a failed upload only fails its own input
+            funcs = []
+            indices = []
+            with Profiler.timeit("RPCRunner/upload_module"):
+                for i, artifact_path in enumerate(artifact_paths):
+                    _, remote_path = osp.split(artifact_path)
+                    remote_paths.append(remote_path)
+                    try:
+                        rt_mod: Module = f_upload_module(session, artifact_path, remote_path)
+                    except Exception as exception:  # pylint: disable=broad-except
+                        results[i] = (None, str(exception))
+                        continue
+                    funcs.append((rt_mod, rt_mod.entry_name, args_infos[i]))
+                    indices.append(i)
+            # Step 3. Allocate the arguments and run the time evaluator on the server
+            with Profiler.timeit("RPCRunner/run_evaluator"):
+                # With `max_median_ci` set, the inputs whose median is not stable yet are measured
+                # again, with the same time budget per input as a standalone measurement
+                deadline = time.perf_counter() + (
+                    evaluator_config.max_measure_ms / 1000.0 * len(artifact_paths)
+                )
+                while funcs:
+                    batch_results = session.time_evaluate_batch(
+                        funcs,
+                        device,
+                        number=evaluator_config.number,
+                        repeat=evaluator_config.repeat,
+                        min_repeat_ms=evaluator_config.min_repeat_ms,
+                        f_preproc=evaluator_config.f_preproc,
+                        alloc_repeat=alloc_repeat,
+                    )
+                    for i, (costs, error_msg) in zip(indices, batch_results):
+                        prev_costs = results[i][0]
+                        if costs is not None and prev_costs is not None:
+                            costs = prev_costs + costs
+                        results[i] = (costs, error_msg)
+                    if evaluator_config.max_median_ci is None or time.perf_counter() >= deadline:
+                        break
+                    pending = [
+                        k
+                        for k, i in enumerate(indices)
+                        if results[i][0] is not None
+                        and median_ci_ratio(results[i][0]) > evaluator_config.max_median_ci
+                    ]
+                    funcs = [funcs[k] for k in pending]
+                    indices = [indices[k] for k in pending]
+                if evaluator_config.max_median_ci is not None:
+                    for costs, _ in results:
+                        if costs is not None:
+                            check_clock_drift(costs, evaluator_config.max_median_ci)
+        return results
+
+    return _run_with_requeue(rpc_config, _run)
+
+
+def _run_with_requeue(rpc_config: RPCConfig, run: Callable[[], T]) -> T:
+    """Run a measurement, and requeue it to another device of the key after a session timeout,
+    at most `rpc_config.session_max_requeue` times."""
+    num_requeue = 0
+    while True:
+        start = time.perf_counter()
         try:
-            yield
-        finally:
-            # Final step. Always clean up
-            with Profiler.timeit("RPCRunner/cleanup"):
-                f_cleanup(session, remote_path)
-
-    with resource_handler():
-        # Step 1. Create session
-        with Profiler.timeit("RPCRunner/create_session"):
-            session = f_create_session(rpc_config)
-            device = session.device(device_type, 0)
-        # Step 2. Upload the module
-        with Profiler.timeit("RPCRunner/upload_module"):
-            _, remote_path = osp.split(artifact_path)
-            local_path: str = artifact_path
-            rt_mod: Module = f_upload_module(session, local_path, remote_path)
-        # Step 3: Allocate input arguments
-        with Profiler.timeit("RPCRunner/alloc_argument"):
-            repeated_args: list[T_ARGUMENT_LIST] = f_alloc_argument(
-                session,
-                device,
-                args_info,
-                alloc_repeat,
-            )
-        # Step 4: Run time_evaluator
-        with Profiler.timeit("LocalRunner/run_evaluator"):
-            costs: list[float] = f_run_evaluator(
-                session,
-                rt_mod,
-                device,
-                evaluator_config,
-                repeated_args,
+            return run()
+        except TVMError:
+            duration = time.perf_counter() - start
+            # roughly estimate if the error is due to timeout termination
+            timeout_sec = rpc_config.session_timeout_sec
+            if not timeout_sec or duration < timeout_sec * 0.95:
+                raise
+            if num_requeue >= rpc_config.session_max_requeue:
+                raise
+            num_requeue += 1
+            logger.warning(
+                "RPCRunner: Session timeout after %.1f seconds, requeue %d of %d",
+                duration,
+                num_requeue,
+                rpc_config.session_max_requeue,
             )
-    return costs
 
 
 def default_create_session(rpc_config: RPCConfig) -> RPCSession:
@@ -448,7 +650,8 @@ def default_upload_module(
     rt_mod : Module
         The runtime module
     """
-    session.upload(local_path, remote_path)
+    # Candidates that build to the same artifact are only sent to the remote once.
+    remote_path = session.upload_cached(local_path, remote_path)
     rt_mod: Module = session.load_module(remote_path)
     return rt_mod
 
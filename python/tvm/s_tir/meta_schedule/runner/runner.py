@@ -84,11 +84,14 @@ class RunnerResult(Object):
     ----------
     run_secs : Optional[List[float]]
         The run time in seconds.
+    run_secs_variance : Optional[float]
+        The sample variance of the run time, computed from `run_secs` if it has 2+ runs.
     error_msg : Optional[str]
         The error message, if any.
     """
 
     run_secs: list[float] | None
+    run_secs_variance: float | None
     error_msg: str | None
 
     def __init__(
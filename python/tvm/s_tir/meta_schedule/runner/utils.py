@@ -17,14 +17,20 @@
 """Runner utility functions"""
 
 import itertools
+import math
+import statistics
+import time
 from collections.abc import Callable
 from typing import Any
 
 import tvm.runtime
 
 from ....runtime import Device, Module
+from ..logging import get_logger
 from .config import EvaluatorConfig
 
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
 T_ARG_INFO_JSON_OBJ = list[Any]  # pylint: disable=invalid-name
 T_ARG_INFO_JSON_OBJ_LIST = list[T_ARG_INFO_JSON_OBJ]  # pylint: disable=invalid-name
 T_ARGUMENT = Any  # pylint: disable=invalid-name
@@ -111,14 +117,110 @@ def run_evaluator_common(
         number=evaluator_config.number,
         repeat=evaluator_config.repeat,
         min_repeat_ms=evaluator_config.min_repeat_ms,
-        f_preproc="cache_flush_cpu_non_first_arg"
-        if evaluator_config.enable_cpu_cache_flush
-        else "",
+        f_preproc=evaluator_config.f_preproc,
     )
-    repeated_costs: list[list[float]] = []
-    for args in repeated_args:
-        device.sync()
-        profile_result = evaluator(*args)
-        repeated_costs.append(profile_result.results)
-    costs = [float(cost) for cost in itertools.chain.from_iterable(repeated_costs)]
+
+
+    def _measure() -> list[float]:
+        repeated_costs: list[list[float]] = []
+        for args in repeated_args:
+            device.sync()
+            profile_result = evaluator(*args)
+            repeated_costs.append(profile_result.results)
+        return [float(cost) for cost in itertools.chain.from_iterable(repeated_costs)]
+
+    return measure_until_stable(_measure, evaluator_config)
+
+
+def median_ci_ratio(costs: list[float]) -> float:
+    """The half-width of the distribution-free 95% confidence interval of the median of the
+    costs, relative to the median.
+
+    Parameters
+    ----------
+    costs: List[float]
+        The measured costs
+
+    Returns
+    -------
+    ratio: float
+        The relative half-width, or infinity if there are fewer than two costs
+    """
+    n = len(costs)
+    if n < 2:
+        return math.inf
+    costs = sorted(costs)
+    median = statistics.median(costs)
+    if median <= 0:
+        return 0.0
+    # The ranks of the bounds follow the normal approximation of the binomial distribution
+    half = 0.98 * math.sqrt(n)
+    lo = max(0, math.floor(n / 2 - half))
+    hi = min(n - 1, math.ceil(n / 2 + half))
+    return (costs[hi] - costs[lo]) / (2 * median)
+
+
+def measure_until_stable(
+    f_measure: Callable[[], list[float]],
+    evaluator_config: EvaluatorConfig,
+) -> list[float]:
+    """Repeat a measurement until the median is stable, as configured by `max_median_ci` and
+    `max_measure_ms` of the evaluator config.
+
+    Parameters
+    ----------
+    f_measure: Callable[[], List[float]]
+        The function running one measurement and returning its costs
+    evaluator_config: EvaluatorConfig
+        The evaluator config
+
+    Returns
+    -------
+    costs: List[float]
+        The costs of all the measurements
+    """
+    start = time.perf_counter()
+    costs = f_measure()
+    if evaluator_config.max_median_ci is None:
+        return costs
+    deadline = start + evaluator_config.max_measure_ms / 1000.0
+    while (
+        median_ci_ratio(costs) > evaluator_config.max_median_ci and time.perf_counter() < deadline
+    ):
+        costs += f_measure()
+    check_clock_drift(costs, evaluator_config.max_median_ci)
     return costs
+
+
+def check_clock_drift(costs: list[float], tolerance: float) -> bool:
+    """Check whether the costs drift during the measurement more than the tolerance, which is a
+    sign that the clock of the device is not locked, e.g. it boosts or throttles. A warning is
+    logged if so.
+
+    Parameters
+    ----------
+    costs: List[float]
+        The costs in the order they are measured
+    tolerance: float
+        The relative difference between the medians of the first and the last third of the costs
+        that is considered noise
+
+    Returns
+    -------
+    drifted: bool
+        Whether the costs drift
+    """
+    n = len(costs) // 3
+    if n == 0:
+        return False
+    first = statistics.median(costs[:n])
+    last = statistics.median(costs[-n:])
+    drift = abs(last - first) / max(first, last)
+    if drift <= 2 * tolerance:
+        return False
+    logger.warning(
+        "The latency drifts by %.1f%% during the measurement, the device clock may not be "
+        "locked and the result may be unreliable",
+        drift * 100,
+    )
+    return True
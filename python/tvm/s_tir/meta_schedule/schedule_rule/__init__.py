@@ -33,6 +33,10 @@ from .multi_level_tiling import (
     MultiLevelTilingWithIntrin,
     ReuseType,
 )
+from .pad_to_tile import PadToTile
 from .parallel_vectorize_unroll import ParallelizeVectorizeUnroll
 from .random_compute_location import RandomComputeLocation
+from .rolling_buffer_fusion import RollingBufferFusion
 from .schedule_rule import PyScheduleRule, ScheduleRule
+from .software_prefetch import SoftwarePrefetch
+from .stream_k import StreamK
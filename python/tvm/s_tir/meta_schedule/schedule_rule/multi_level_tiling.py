@@ -156,7 +156,9 @@ class MultiLevelTilingTensorCore(ScheduleRule):
         "load_b", "compute", "store", which represent the tensor intrin for initialization,
         loading operand A, loading operand B, tensor core computation, storing the result.
         The value of the map should be names of tensor intrinsics, must be registerd via
-        TensorIntrin.register(...) beforehand
+        TensorIntrin.register(...) beforehand. The groups of wgmma, e.g. from
+        `get_wgmma_intrin_group`, have no "load_a" and "load_b", since wgmma reads both operands
+        from the shared memory.
     structure : str
         The tiling structure. Recommended:
         - 'SSSRRSRS' on GPU
@@ -0,0 +1,57 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Rule that pads the einsum blocks of irregular shapes to a multiple of the tile size"""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("s_tir.meta_schedule.PadToTile")
+class PadToTile(ScheduleRule):
+    """Rule that pads the iterators of the einsum reduction blocks, e.g. GEMMs of shapes like
+    4097, up to a multiple of a tile size with pad_einsum, so that the multi-level tiling that
+    follows samples the tiles of the padded extents and produces no partial tiles.
+
+    Each tile size that pads the block within the overhead gives a design space, next to the
+    unpadded one, so the padding is tuned together with the tiling. On GPUs, the copies of the
+    padded inputs are inlined into the shared memory read caches of the tiling. On CPUs, they
+    are decomposed with decompose_padding into a fill of the padding and an in-bound copy.
+
+    Parameters
+    ----------
+    tile_sizes : Optional[List[int]]
+        Candidates of the tile size that the iterators are padded to a multiple of. The
+        iterators shorter than the tile size are not padded.
+    max_overhead : float
+        The maximum ratio of the padded iteration space to the original one, minus one, of the
+        candidate paddings.
+    """
+
+    def __init__(
+        self,
+        tile_sizes: list[int] | None = None,
+        max_overhead: float = 0.25,
+    ) -> None:
+        if tile_sizes is None:
+            tile_sizes = [16, 32, 64, 128]
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRulePadToTile,  # type: ignore # pylint: disable=no-member
+            tile_sizes,
+            max_overhead,
+        )
@@ -0,0 +1,49 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Rule that fuses the chains of convolutions with rolling line buffers"""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("s_tir.meta_schedule.RollingBufferFusion")
+class RollingBufferFusion(ScheduleRule):
+    """Rule that fuses a chain of convolutions or poolings, e.g. the depthwise and pointwise
+    convolutions of a mobile network fused into one PrimFunc, so that its intermediate tensors
+    stay in the CPU caches. The rows of the consumer are split into tiles, the producers are
+    computed under the loop of the tiles with compute_at, and their outputs are folded with
+    rolling_buffer into line buffers of the rows that a tile reads, the rows shared with the
+    next tile being kept instead of recomputed.
+
+    The number of rows per tile is sampled, and tuned along with the other tile sizes. The
+    unfused design space is kept next to the fused one. The rule is applied before the
+    multi-level tiling, which does not tile the fused blocks, and after the inlining of the
+    paddings of the consumer.
+
+    Parameters
+    ----------
+    max_rows_per_tile : int
+        The maximum number of rows of the consumer computed per tile.
+    """
+
+    def __init__(self, max_rows_per_tile: int = 8) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleRollingBufferFusion,  # type: ignore # pylint: disable=no-member
+            max_rows_per_tile,
+        )
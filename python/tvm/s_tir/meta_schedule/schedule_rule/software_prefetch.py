@@ -0,0 +1,44 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Rule that marks the software prefetch distance to the root block. The mark will be applied to
+each block in a follow-up post processor"""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("s_tir.meta_schedule.SoftwarePrefetch")
+class SoftwarePrefetch(ScheduleRule):
+    """Rule that marks the software prefetch distance to the root block. The mark will be applied
+    to the innermost loop of each block that is not vectorized in the post processor
+    RewriteParallelVectorizeUnroll, and lowered to prefetches by InjectSoftwarePrefetch on CPU.
+
+    Parameters
+    ----------
+    prefetch_distances: Optional[List[int]]
+        The options of the prefetch distance in loop iterations, where 0 disables prefetching.
+    """
+
+    def __init__(self, prefetch_distances: list[int] | None = None) -> None:
+        if prefetch_distances is None:
+            prefetch_distances = [0, 4, 8, 16]
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleSoftwarePrefetch,  # type: ignore # pylint: disable=no-member
+            prefetch_distances,
+        )
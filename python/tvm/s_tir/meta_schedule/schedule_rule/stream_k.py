@@ -0,0 +1,55 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Rule that splits the reduction of low-parallelism reduction blocks over a persistent grid"""
+
+from tvm_ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("s_tir.meta_schedule.StreamK")
+class StreamK(ScheduleRule):
+    """Rule that splits the reduction of the reduction blocks whose spatial loops cannot occupy
+    the device into partial reductions, computed by a persistent grid of thread blocks, and
+    reduces the partial results in the same kernel after a grid-wide barrier.
+
+    Parameters
+    ----------
+    max_concurrent_blocks : int
+        The maximum number of thread blocks that are resident on the device at once. All the
+        thread blocks have to reach the barrier, so the grid is never larger than this.
+    thread_extent : int
+        The number of threads of each thread block.
+    split_factors : Optional[List[int]]
+        Candidates of the number of splits of the reduction.
+    """
+
+    def __init__(
+        self,
+        max_concurrent_blocks: int,
+        thread_extent: int = 128,
+        split_factors: list[int] | None = None,
+    ) -> None:
+        if split_factors is None:
+            split_factors = [2, 4, 8]
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleStreamK,  # type: ignore # pylint: disable=no-member
+            thread_extent,
+            split_factors,
+            max_concurrent_blocks,
+        )
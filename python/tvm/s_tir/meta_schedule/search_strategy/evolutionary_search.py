@@ -46,6 +46,15 @@ class EvolutionarySearch(SearchStrategy):
         The maximum number to retry mutation.
     eps_greedy : float
         The ratio of greedy selected samples in the final picks.
+    pipelined : bool
+        Whether to evolve the next batch of candidates in the background while the current batch
+        is being built and measured. The next batch is then selected by a cost model that has not
+        seen the results of the current batch yet, i.e. it is stale by exactly one batch.
+    transfer_records : bool
+        Whether to fill up the measured part of the initial population with the best records of
+        workloads whose anchor block only differs from the tuned one in loop extents and buffer
+        shapes, e.g. the same layer with another hidden size. Their traces are replayed onto the
+        tuned workload with tile sizes rescaled to its loop extents.
     """
 
     population_size: int
@@ -55,6 +64,8 @@ class EvolutionarySearch(SearchStrategy):
     genetic_mutate_prob: float
     genetic_max_fail_count: int
     eps_greedy: float
+    pipelined: bool
+    transfer_records: bool
 
     def __init__(
         self,
@@ -67,6 +78,8 @@ class EvolutionarySearch(SearchStrategy):
         genetic_mutate_prob: float = 0.85,
         genetic_max_fail_count: int = 10,
         eps_greedy: float = 0.05,
+        pipelined: bool = False,
+        transfer_records: bool = False,
     ) -> None:
         """Constructor"""
         self.__init_handle_by_constructor__(
@@ -79,4 +92,6 @@ class EvolutionarySearch(SearchStrategy):
             genetic_mutate_prob,
             genetic_max_fail_count,
             eps_greedy,
+            pipelined,
+            transfer_records,
         )
@@ -194,6 +194,18 @@ class SearchStrategy(Object):
         """
         return _ffi_api.SearchStrategyClone(self)  # type: ignore # pylint: disable=no-member
 
+    def get_stats(self) -> dict[str, int]:
+        """Get the counters of how the measure candidates were produced since pre-tuning.
+
+        Returns
+        -------
+        stats : Dict[str, int]
+            The counters keyed by their names, e.g. `num_sampled`, `num_postproc_failed`,
+            `num_duplicated` and `num_picked`. Empty if the strategy does not keep any.
+        """
+        stats = _ffi_api.SearchStrategyGetStats(self)  # type: ignore # pylint: disable=no-member
+        return {str(k): int(v) for k, v in stats.items()}
+
     @staticmethod
     def create(  # pylint: disable=keyword-arg-before-vararg
         kind: Literal[
@@ -16,6 +16,8 @@
 # under the License.
 """Gradient Based Task Scheduler"""
 
+from typing import Optional
+
 from tvm_ffi import register_object
 
 from .. import _ffi_api
@@ -34,6 +36,9 @@ class GradientBased(TaskScheduler):
         *,
         alpha: float = 0.2,
         window_size: int = 3,
+        plateau_rounds: int = 0,
+        plateau_tolerance: float = 0.01,
+        time_budget_secs: Optional[float] = None,
         seed: int = -1,
     ) -> None:
         """Constructor.
@@ -44,6 +49,15 @@ class GradientBased(TaskScheduler):
             The parameter alpha in gradient computation.
         window_size : int = 3
             The parameter to control backward window size in gradient computation.
+        plateau_rounds : int = 0
+            The number of rounds without improvement after which a task is retired, leaving its
+            remaining trials to the other tasks. 0 means tasks are never retired early.
+        plateau_tolerance : float = 0.01
+            The relative improvement below which a round does not count as an improvement. The
+            measurement noise of the task is used instead if it is larger.
+        time_budget_secs : Optional[float] = None
+            The wall-clock budget of the whole tuning in seconds. Every task is measured at
+            least once. None means no limit.
         seed : int = -1
             The random seed.
         """
@@ -52,5 +66,8 @@ class GradientBased(TaskScheduler):
             get_logging_func(logger),
             alpha,
             window_size,
+            plateau_rounds,
+            plateau_tolerance,
+            -1.0 if time_budget_secs is None else time_budget_secs,
             seed,
         )
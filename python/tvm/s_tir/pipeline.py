@@ -52,6 +52,7 @@ def default_s_tir_pipeline():
             tir.transform.FlattenBuffer(),
             tir.transform.BF16ComputeLegalize(),
             tir.transform.NarrowDataType(32),
+            s_tir.transform.InjectSoftwarePrefetch(),
             s_tir.transform.LoopPartition(),
             tir.transform.VectorizeLoop(not bool(config.get("tir.disable_vectorize", False))),
             s_tir.transform.InjectVirtualThread(),
@@ -69,6 +70,9 @@ def default_s_tir_pipeline():
                 tir.transform.Simplify(),
                 tir.transform.RemoveNoOp(),
                 s_tir.transform.RewriteUnsafeSelect(),
+                s_tir.transform.HoistIndexOffset(),
+                tir.transform.NarrowIndexArithmetic(),
+                s_tir.transform.MergeParallelLaunch(),
             ]
         )
         # Additional passes based on configuration.
@@ -95,6 +99,7 @@ def default_s_tir_pipeline():
                 tir.transform.AnnotateEntryFunc(),
             ]
         )
+        passes.append(s_tir.transform.InjectGlobalBarrier())
         if bool(config.get("tir.detect_global_barrier", False)):
             passes.append(s_tir.transform.ThreadSync("global"))
         passes.extend(
@@ -104,6 +109,7 @@ def default_s_tir_pipeline():
                 s_tir.transform.ThreadSync("warp"),
                 s_tir.transform.InferFragment(),
                 s_tir.transform.LowerThreadAllreduce(),
+                s_tir.transform.InjectWarpSpecialization(),
             ]
         )
         if bool(config.get("tir.use_async_copy", False)):
@@ -112,6 +118,7 @@ def default_s_tir_pipeline():
             passes.append(s_tir.transform.InjectPTXLDG32())
         passes.extend(
             [
+                s_tir.transform.LowerTMADescriptors(),
                 tir.transform.AnnotateDeviceRegions(),
                 tir.transform.SplitHostDevice(),
                 # MergeSharedMemoryAllocations must follow SplitHostDevice.
@@ -1345,6 +1345,129 @@ class Schedule(Object):
         """
         _ffi_api.ScheduleUnroll(self, loop)  # type: ignore # pylint: disable=no-member
 
+    @type_checked
+    def warp_specialize(
+        self, loop: LoopRV, num_producer_threads: int = 128, num_stages: int = 2
+    ) -> None:
+        """Specialize the warps of a serial loop under the threadIdx.x binding into producers and
+        consumers.
+
+        The producers are `num_producer_threads` additional threads along threadIdx.x that run
+        the statements of the loop body copying into shared memory, e.g. the cache reads and
+        the TMA loads. The consumers are the original threads, which run the rest of the loop
+        body and the rest of the kernel. The shared memory buffers written by the producers get
+        `num_stages` versions, and the producers and consumers hand them over with mbarriers, so
+        the copies of the next stages overlap with the computation of the current. The barriers
+        of the consumers within the kernel become named barriers among the consumers.
+
+        The actual rewrite is done by the InjectWarpSpecialization pass during lowering, after
+        the shared memory barriers are inserted.
+
+        Parameters
+        ----------
+        loop : LoopRV
+            The loop to be warp specialized, a serial loop under a loop bound to threadIdx.x.
+
+        num_producer_threads : int
+            The number of producer threads, a positive multiple of the warp size.
+
+        num_stages : int
+            The number of versions of the shared memory buffers written by the producers.
+
+        Examples
+        --------
+
+        .. code-block:: python
+
+            sch = tvm.s_tir.Schedule(gemm)
+            _, _, k_outer, _ = sch.get_loops(sch.get_sblock("C"))
+            sch.warp_specialize(k_outer, num_producer_threads=128, num_stages=3)
+
+        The loop gets the annotations
+        ``{"warp_specialize_producer_threads": 128, "warp_specialize_num_stages": 3}``.
+        """
+        _ffi_api.ScheduleWarpSpecialize(  # type: ignore # pylint: disable=no-member
+            self, loop, num_producer_threads, num_stages
+        )
+
+    @type_checked
+    def double_buffer_fragments(self, loop: LoopRV) -> None:
+        """Double buffer the register fragments loaded in a serial loop, so that the fragments
+        of the next iteration are loaded while the current iteration computes.
+
+        The body of the loop must be a sequence of statements whose leading statements load
+        register fragments from shared memory, e.g. the tensor core fragments loaded by
+        ldmatrix in the k loop of a GEMM, and whose other statements compute with them. The
+        loads are pipelined one iteration ahead of the computation, and the
+        InjectSoftwarePipeline pass allocates two versions of the fragments during lowering.
+
+        Parameters
+        ----------
+        loop : LoopRV
+            The loop whose fragments are double buffered.
+
+        Examples
+        --------
+
+        .. code-block:: python
+
+            sch = tvm.s_tir.Schedule(gemm)
+            ...  # cache_read to shared memory and to the fragments, computed at k_inner
+            sch.double_buffer_fragments(k_inner)
+
+        With two fragment loads followed by the tensor core computation, the loop gets the
+        annotations ``{"software_pipeline_stage": [0, 0, 1]}`` and
+        ``{"software_pipeline_order": [0, 1, 2]}``.
+        """
+        _ffi_api.ScheduleDoubleBufferFragments(  # type: ignore # pylint: disable=no-member
+            self, loop
+        )
+
+    @type_checked
+    def merge_kernels(self, first_loop: LoopRV, second_loop: LoopRV) -> LoopRV:
+        """Merge two adjacent kernels into one kernel that runs the second after a global barrier.
+
+        The outermost loops of the kernels have to be bound to the same block index with the
+        same range, and the second has to directly follow the first. The nested thread bindings
+        of the kernels are merged as well, so they have to match. The merged loop gets the
+        annotation ``{"pragma_global_barrier": 1}``, and the global barriers are inserted by the
+        InjectGlobalBarrier pass during lowering, where the accesses to the global buffers of the
+        stages conflict.
+
+        It is used for the in-kernel fixup of split-K reductions, where the partial sums of the
+        first kernel are reduced by the second. All the thread blocks of the merged kernel have
+        to be resident on the device at the same time, otherwise the barrier never completes.
+
+        Parameters
+        ----------
+        first_loop : LoopRV
+            The outermost loop of the first kernel.
+
+        second_loop : LoopRV
+            The outermost loop of the second kernel.
+
+        Returns
+        -------
+        merged_loop : LoopRV
+            The outermost loop of the merged kernel.
+
+        Examples
+        --------
+
+        .. code-block:: python
+
+            sch = tvm.s_tir.Schedule(gemv)
+            i, k = sch.get_loops(sch.get_sblock("C"))
+            ko, ki = sch.split(k, [4, None])
+            rf = sch.rfactor(ko, 0)
+            # Bind the loops of the blocks "C_rf" and "C" to the same block and thread extents.
+            ...
+            sch.merge_kernels(bx_rf, bx)
+        """
+        return _ffi_api.ScheduleMergeKernels(  # type: ignore # pylint: disable=no-member
+            self, first_loop, second_loop
+        )
+
     ########## Schedule: Insert cache stages ##########
 
     @type_checked
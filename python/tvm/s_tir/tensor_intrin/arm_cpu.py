@@ -163,6 +163,54 @@ def get_dotprod_intrin(in_dtype, out_dtype):
     return dot_prod_desc, dot_prod_impl
 
 
+def get_bf16_dotprod_intrin():
+    """Dot product of bf16 pairs accumulated into float32 lanes with the BF16 extension."""
+
+    @T.prim_func
+    def dot_prod_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(a, (2,), dtype="bfloat16", offset_factor=1)
+        B = T.match_buffer(b, (4, 2), dtype="bfloat16", offset_factor=1)
+        C = T.match_buffer(c, (4,), dtype="float32", offset_factor=1)
+        with T.sblock("root"):
+            T.reads(C[0:4], A[0:2], B[0:4, 0:2])
+            T.writes(C[0:4])
+            for i in T.serial(0, 4):
+                for k in T.serial(0, 2):
+                    with T.sblock("update"):
+                        vi, vk = T.axis.remap("SR", [i, k])
+                        C[vi] = C[vi] + T.cast(A[vk], dtype="float32") * T.cast(
+                            B[vi, vk], dtype="float32"
+                        )
+
+    @T.prim_func
+    def dot_prod_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(a, (2,), dtype="bfloat16", offset_factor=1)
+        B = T.match_buffer(b, (4, 2), dtype="bfloat16", offset_factor=1)
+        C = T.match_buffer(c, (4,), dtype="float32", offset_factor=1)
+        with T.sblock("root"):
+            T.reads(C[0:4], A[0:2], B[0:4, 0:2])
+            T.writes(C[0:4])
+
+            A_bf16x2 = A.vload([0], "bfloat16x2")
+            A_i32 = T.reinterpret(A_bf16x2, dtype="int32")
+            vec_ai32 = T.broadcast(A_i32, 4)
+            vec_a = T.reinterpret(vec_ai32, dtype="bfloat16x8")
+
+            vec_b = B.vload([0, 0], dtype="bfloat16x8")
+
+            vec_c = C.vload([0], dtype="float32x4")
+
+            C[T.ramp(T.int32(0), 1, 4)] = T.call_llvm_pure_intrin(
+                T.llvm_lookup_intrinsic_id("llvm.aarch64.neon.bfdot.v4f32.v8bf16"),
+                vec_c,
+                vec_a,
+                vec_b,
+                dtype="float32x4",
+            )
+
+    return dot_prod_desc, dot_prod_impl
+
+
 def _create_ptrue_mask(dtype):
     """
     Creates a mask that enables all lanes of a scalable vector.
@@ -747,11 +795,13 @@ ARM_DOT_4x4_i8_NEON_INTRIN = "dot_4x4_i8i8s32_neon"
 ARM_DOT_4x4_i8_SDOT_INTRIN = "dot_4x4_i8i8s32_sdot"
 ARM_DOT_4x4_u8_UDOT_INTRIN = "dot_4x4_u8u8u32_udot"
 ARM_DOT_4x4_u8_HDOT_INTRIN = "dot_4x4_u8u8i32_hdot"
+ARM_DOT_4x2_BF16_BFDOT_INTRIN = "dot_4x2_bf16bf16f32_bfdot"
 
 TensorIntrin.register(ARM_DOT_4x4_i8_NEON_INTRIN, neon_4x4_i8i8i32_desc, neon_4x4_i8i8i32_impl)
 TensorIntrin.register(ARM_DOT_4x4_i8_SDOT_INTRIN, *get_dotprod_intrin("int8", "int32"))
 TensorIntrin.register(ARM_DOT_4x4_u8_UDOT_INTRIN, *get_dotprod_intrin("uint8", "uint32"))
 TensorIntrin.register(ARM_DOT_4x4_u8_HDOT_INTRIN, *get_dotprod_intrin("uint8", "int32"))
+TensorIntrin.register(ARM_DOT_4x2_BF16_BFDOT_INTRIN, *get_bf16_dotprod_intrin())
 
 ARM_SME_INIT = "sme_init"
 ARM_SME_2SVLx2SVL_FP32_TRANSPOSE_INTERLEAVE = "sme_2svlx2svl_fp32_transpose_interleave"
@@ -1753,3 +1753,276 @@ TensorIntrin.register(
 def index_map_m16n8k8_matrixC(ind):
     i, j = ind[0], ind[1]
     return convert([(i // 8) // 2, j // 8, (i // 8) % 2, (j % 8) % 2])
+
+
+######## WGMMA intrinsics ########
+
+WARPGROUP_SIZE = 128
+WGMMA_M_DIM = 64
+# The bytes of a row of the K-major multiplicands in shared memory, which is the row of the
+# 128B swizzle, i.e. the layout InjectPermutedLayout produces for rows of 64 fp16 elements.
+WGMMA_SWIZZLE_BYTES = 128
+
+
+def get_index_wgmma_C(elem_offset, stride):
+    i = elem_offset // stride
+    j = elem_offset % stride
+    return (i // WGMMA_M_DIM) * (stride // 8) * 4 + (j // 8) * 4
+
+
+def get_wgmma_fill_intrin(n_dim: int, dtype: str) -> tuple[PrimFunc, PrimFunc]:
+    """Generator of wgmma fill intrins"""
+    zero = IntImm("int32", 0).astype(dtype)
+    m_dim = WGMMA_M_DIM
+
+    @T.prim_func
+    def wgmma_fill_desc(c: T.handle) -> None:
+        dst = T.match_buffer(
+            c, (m_dim, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        with T.sblock("root"):
+            T.reads()
+            T.writes(dst[0:m_dim, 0:n_dim])
+            for i, j in T.grid(m_dim, n_dim):
+                with T.sblock("init"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    dst[vi, vj] = zero
+
+    @T.prim_func
+    def wgmma_fill_impl(c: T.handle) -> None:
+        dst = T.match_buffer(
+            c, (m_dim, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        with T.sblock("root"):
+            T.reads()
+            T.writes(dst[0:m_dim, 0:n_dim])
+            for tx in T.thread_binding(0, WARPGROUP_SIZE, "threadIdx.x"):
+                for b, r in T.grid(n_dim // 8, 2):
+                    for v in T.vectorized(2):
+                        dst[tx // 32 * 16 + r * 8 + tx % 32 // 4, b * 8 + tx % 4 * 2 + v] = zero
+
+    return wgmma_fill_desc, wgmma_fill_impl
+
+
+def get_wgmma_store_intrin(n_dim: int, dtype: str, scope: str) -> tuple[PrimFunc, PrimFunc]:
+    """Generator of wgmma store intrins"""
+    m_dim = WGMMA_M_DIM
+
+    @T.prim_func
+    def wgmma_store_desc(a: T.handle, c: T.handle) -> None:
+        src = T.match_buffer(
+            a, (m_dim, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        dst = T.match_buffer(c, (m_dim, n_dim), dtype, align=64, offset_factor=1, scope=scope)
+        with T.sblock("root"):
+            T.reads(src[0:m_dim, 0:n_dim])
+            T.writes(dst[0:m_dim, 0:n_dim])
+            for i, j in T.grid(m_dim, n_dim):
+                with T.sblock("store"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    dst[vi, vj] = src[vi, vj]
+
+    @T.prim_func
+    def wgmma_store_impl(a: T.handle, c: T.handle) -> None:
+        src = T.match_buffer(
+            a, (m_dim, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        s0 = T.int32()
+        s1 = T.int32()
+        dst = T.match_buffer(
+            c, (m_dim, n_dim), dtype, align=64, offset_factor=1, scope=scope, strides=[s0, s1]
+        )
+        with T.sblock("root"):
+            T.reads(src[0:m_dim, 0:n_dim])
+            T.writes(dst[0:m_dim, 0:n_dim])
+            for tx in T.thread_binding(0, WARPGROUP_SIZE, "threadIdx.x"):
+                for b, r in T.grid(n_dim // 8, 2):
+                    for v in T.vectorized(2):
+                        dst[tx // 32 * 16 + r * 8 + tx % 32 // 4, b * 8 + tx % 4 * 2 + v] = src[
+                            tx // 32 * 16 + r * 8 + tx % 32 // 4, b * 8 + tx % 4 * 2 + v
+                        ]
+
+    return wgmma_store_desc, wgmma_store_impl
+
+
+def get_wgmma_sync_intrin(
+    n_dim: int, in_dtype: str, out_dtype: str, shared_scope: str = "shared.dyn"
+) -> tuple[PrimFunc, PrimFunc]:
+    """Generator of wgmma sync intrins.
+
+    Both multiplicands are K-major in shared memory, in rows of 128 bytes with the 128B swizzle,
+    and the tiles of 8 rows are 1024-byte aligned. The shared memory writes are made visible to
+    wgmma, and the wgmma is waited for before returning.
+    """
+    assert in_dtype in ["float16", "bfloat16"]
+    assert out_dtype in ["float16", "float32"]
+    m_dim = WGMMA_M_DIM
+    k_dim = 16
+    elem_bytes = 2
+    # The leading byte offset is unused by the swizzled K-major layouts, and the stride byte
+    # offset is the distance of the tiles of 8 rows.
+    lbo = 16
+    sbo = 8 * WGMMA_SWIZZLE_BYTES
+    swizzle_128b = 3
+    assert WGMMA_SWIZZLE_BYTES % (k_dim * elem_bytes) == 0
+
+    def maybe_cast(v):
+        if in_dtype != out_dtype:
+            return Cast(out_dtype, v)
+        return v
+
+    @T.prim_func
+    def wgmma_sync_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(
+            a, (m_dim, k_dim), in_dtype, align=64, offset_factor=1, scope=shared_scope
+        )
+        B = T.match_buffer(
+            b, (n_dim, k_dim), in_dtype, align=64, offset_factor=1, scope=shared_scope
+        )
+        C = T.match_buffer(
+            c, (m_dim, n_dim), out_dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        with T.sblock("root"):
+            T.reads(C[0:m_dim, 0:n_dim], A[0:m_dim, 0:k_dim], B[0:n_dim, 0:k_dim])
+            T.writes(C[0:m_dim, 0:n_dim])
+            for i, j, k in T.grid(m_dim, n_dim, k_dim):
+                with T.sblock("wgmma_sync"):
+                    vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                    C[vi, vj] = C[vi, vj] + maybe_cast(A[vi, vk]) * maybe_cast(B[vj, vk])
+
+    @T.prim_func
+    def wgmma_sync_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        a0 = T.int32()
+        a1 = T.int32()
+        A = T.match_buffer(
+            a,
+            (m_dim, k_dim),
+            in_dtype,
+            align=64,
+            offset_factor=1,
+            scope=shared_scope,
+            strides=[a0, a1],
+        )
+        b0 = T.int32()
+        b1 = T.int32()
+        B = T.match_buffer(
+            b,
+            (n_dim, k_dim),
+            in_dtype,
+            align=64,
+            offset_factor=1,
+            scope=shared_scope,
+            strides=[b0, b1],
+        )
+        c0 = T.int32()
+        c1 = T.int32()
+        C = T.match_buffer(
+            c,
+            (m_dim, n_dim),
+            out_dtype,
+            align=64,
+            offset_factor=1,
+            scope="wgmma.accumulator",
+            strides=[c0, c1],
+        )
+        with T.sblock("root"):
+            T.reads(C[0:m_dim, 0:n_dim], A[0:m_dim, 0:k_dim], B[0:n_dim, 0:k_dim])
+            T.writes(C[0:m_dim, 0:n_dim])
+            T.evaluate(T.ptx_fence_proxy_async())
+            T.evaluate(T.ptx_wgmma_fence())
+            T.evaluate(
+                T.ptx_wgmma_ss(
+                    f"m{m_dim}n{n_dim}k{k_dim}",
+                    in_dtype,
+                    in_dtype,
+                    out_dtype,
+                    A.access_ptr("r"),
+                    0,
+                    lbo,
+                    sbo,
+                    B.access_ptr("r"),
+                    0,
+                    lbo,
+                    sbo,
+                    swizzle_128b,
+                    C.data,
+                    get_index_wgmma_C(C.elem_offset, c0),
+                    True,
+                    dtype=out_dtype,
+                )
+            )
+            T.evaluate(T.ptx_wgmma_commit_group())
+            T.evaluate(T.ptx_wgmma_wait_group(0))
+
+    return wgmma_sync_desc, wgmma_sync_impl
+
+
+WGMMA_N_DIMS = [64, 128, 256]
+
+for _n in WGMMA_N_DIMS:
+    TensorIntrin.register(f"wgmma_fill_64x{_n}_f16", *get_wgmma_fill_intrin(_n, "float16"))
+    TensorIntrin.register(f"wgmma_fill_64x{_n}_f32", *get_wgmma_fill_intrin(_n, "float32"))
+    TensorIntrin.register(
+        f"wgmma_sync_64x{_n}x16_f16f16f16", *get_wgmma_sync_intrin(_n, "float16", "float16")
+    )
+    TensorIntrin.register(
+        f"wgmma_sync_64x{_n}x16_f16f16f32", *get_wgmma_sync_intrin(_n, "float16", "float32")
+    )
+    TensorIntrin.register(
+        f"wgmma_sync_64x{_n}x16_bf16bf16f32", *get_wgmma_sync_intrin(_n, "bfloat16", "float32")
+    )
+    for _dtype in ["float16", "float32"]:
+        for _scope in ["global", "shared", "shared.dyn"]:
+            TensorIntrin.register(
+                f"wgmma_store_64x{_n}_{_dtype[0]}{_dtype[-2:]}_{_scope.replace('.', '_')}",
+                *get_wgmma_store_intrin(_n, _dtype, _scope),
+            )
+
+
+def get_wgmma_intrin_group(
+    store_scope: Literal["global", "shared", "shared.dyn"],
+    in_dtype: Literal["float16", "bfloat16"],
+    out_dtype: Literal["float16", "float32"],
+    n_dim: int = 128,
+) -> dict[str, str]:
+    """Get a group of intrinsics for wgmma tensor core with the given configurations.
+
+    wgmma reads both multiplicands from shared memory, so the group has no load intrinsics, and
+    MultiLevelTilingTensorCore caches them in the shared memory with the 128B swizzle.
+
+    Parameters
+    ----------
+    store_scope : Literal["global", "shared", "shared.dyn"]
+        The memory scope of the result buffer.
+
+    in_dtype : str
+        The input data type.
+
+    out_dtype : str
+        The output data dtype.
+
+    n_dim : int
+        The N dimension of the wgmma instruction, one of 64, 128 and 256.
+
+    Returns
+    -------
+    ret : Dict[str, str]
+        A group of tensor intrinsics.
+    """
+    assert store_scope in ["global", "shared", "shared.dyn"]
+    assert in_dtype in ["float16", "bfloat16"]
+    assert out_dtype in ["float16", "float32"]
+    assert n_dim in WGMMA_N_DIMS
+    assert in_dtype == "float16" or out_dtype == "float32"
+
+    in_dtype = "f16" if in_dtype == "float16" else "bf16"
+    out_dtype = "f16" if out_dtype == "float16" else "f32"
+    store_scope = store_scope.replace(".", "_")
+    return {
+        # e.g. wgmma_fill_64x128_f32
+        "init": f"wgmma_fill_64x{n_dim}_{out_dtype}",
+        # e.g. wgmma_sync_64x128x16_f16f16f32
+        "compute": f"wgmma_sync_64x{n_dim}x16_{in_dtype}{in_dtype}{out_dtype}",
+        # e.g. wgmma_store_64x128_f32_shared_dyn
+        "store": f"wgmma_store_64x{n_dim}_{out_dtype}_{store_scope}",
+    }
@@ -110,3 +110,150 @@ AVX512_DOT_16x4_INTRIN = "dot_16x4_avx512"
 TensorIntrin.register(
     AVX512_DOT_16x4_INTRIN, dot_product_16x4_u8i8i32_desc, dot_product_16x4_u8i8i32_avx512
 )
+
+
+# Tensorized intrinsic description and AVX512-BF16 implementation. The bf16 operands are kept
+# in bf16 by the BF16 legalization, since they are passed to an LLVM intrinsic, and vdpbf16ps
+# accumulates the products of each pair of bf16 elements into a float32 lane.
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_desc(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.sblock("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+        for i in T.serial(0, 16):
+            for k in T.serial(0, 2):
+                with T.sblock("update"):
+                    vi, vk = T.axis.remap("SR", [i, k])
+                    C[vi] = C[vi] + T.cast(A[vk], "float32") * T.cast(B[vi, vk], "float32")
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_avx512bf16(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.sblock("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+
+        A_bf16x2 = A.vload([0], "bfloat16x2")
+        A_i32 = T.reinterpret(A_bf16x2, dtype="int32")
+        A_bf16x32 = T.reinterpret(T.broadcast(A_i32, 16), dtype="bfloat16x32")
+
+        B_bf16x32 = B.vload([0, 0], dtype="bfloat16x32")
+        C_f32x16 = C.vload([0], dtype="float32x16")
+
+        C[T.ramp(T.int32(0), 1, 16)] = T.call_llvm_pure_intrin(
+            T.llvm_lookup_intrinsic_id("llvm.x86.avx512bf16.dpbf16ps.512"),
+            C_f32x16,
+            A_bf16x32,
+            B_bf16x32,
+            dtype="float32x16",
+        )
+
+
+AVX512_BF16_DOT_16x2_INTRIN = "dot_16x2_avx512bf16"
+
+TensorIntrin.register(
+    AVX512_BF16_DOT_16x2_INTRIN,
+    dot_product_16x2_bf16bf16f32_desc,
+    dot_product_16x2_bf16bf16f32_avx512bf16,
+)
+
+
+# Tensorized intrinsic description and AMX-specific implementation. The weight is expected in the
+# same packed layout as for VNNI, (N // 16, K // 4, 16, 4), so that a B tile of 16 rows is made
+# of 16 groups of 4 consecutive elements along the reduction axis.
+# Note that Linux requires a process to request the permission to use AMX once, for example by
+# calling the global function "runtime.amx_init", before running tensorized kernels.
+
+
+@T.prim_func
+def dot_product_16x16x64_u8i8i32_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+    A = T.match_buffer(a, (16, 64), "uint8", offset_factor=1)
+    B = T.match_buffer(b, (16, 16, 4), "int8", offset_factor=1)
+    C = T.match_buffer(c, (16, 16), "int32", offset_factor=1)
+    with T.sblock("root"):
+        T.reads(C[0:16, 0:16], A[0:16, 0:64], B[0:16, 0:16, 0:4])
+        T.writes(C[0:16, 0:16])
+        for i, j, k in T.grid(16, 16, 64):
+            with T.sblock("update"):
+                vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                C[vi, vj] = C[vi, vj] + T.cast(A[vi, vk], "int32") * T.cast(
+                    B[vk // 4, vj, vk % 4], "int32"
+                )
+
+
+@T.prim_func
+def dot_product_16x16x64_u8i8i32_amx(a: T.handle, b: T.handle, c: T.handle) -> None:
+    A = T.match_buffer(a, (16, 64), "uint8", offset_factor=1, strides=[T.int32(), 1])
+    B = T.match_buffer(
+        b, (16, 16, 4), "int8", offset_factor=1, strides=[T.int32(), T.int32(), 1]
+    )
+    C = T.match_buffer(c, (16, 16), "int32", offset_factor=1, strides=[T.int32(), 1])
+    with T.sblock("root"):
+        T.reads(C[0:16, 0:16], A[0:16, 0:64], B[0:16, 0:16, 0:4])
+        T.writes(C[0:16, 0:16])
+        # The tile configuration is per thread, so it is loaded by every call: tiles 0, 1 and 2
+        # hold C, A and B, each of 16 rows of 64 bytes, in palette 1.
+        cfg = T.decl_buffer((64,), "uint8", scope="local")
+        for t in T.serial(64):
+            cfg[t] = T.uint8(0)
+        cfg[0] = T.uint8(1)
+        for t in T.serial(3):
+            cfg[16 + t * 2] = T.uint8(64)
+            cfg[48 + t] = T.uint8(16)
+        T.evaluate(T.call_llvm_intrin("void", "llvm.x86.ldtilecfg", T.address_of(cfg[0])))
+        T.evaluate(
+            T.call_llvm_intrin(
+                "void",
+                "llvm.x86.tileloadd64",
+                T.uint8(0),
+                C.access_ptr("r"),
+                T.Cast("int64", C.strides[0] * 4),
+            )
+        )
+        T.evaluate(
+            T.call_llvm_intrin(
+                "void",
+                "llvm.x86.tileloadd64",
+                T.uint8(1),
+                A.access_ptr("r"),
+                T.Cast("int64", A.strides[0]),
+            )
+        )
+        T.evaluate(
+            T.call_llvm_intrin(
+                "void",
+                "llvm.x86.tileloadd64",
+                T.uint8(2),
+                B.access_ptr("r"),
+                T.Cast("int64", B.strides[0]),
+            )
+        )
+        T.evaluate(
+            T.call_llvm_intrin("void", "llvm.x86.tdpbusd", T.uint8(0), T.uint8(1), T.uint8(2))
+        )
+        T.evaluate(
+            T.call_llvm_intrin(
+                "void",
+                "llvm.x86.tilestored64",
+                T.uint8(0),
+                C.access_ptr("w"),
+                T.Cast("int64", C.strides[0] * 4),
+            )
+        )
+
+
+AMX_DOT_16x16x64_INTRIN = "dot_16x16x64_amx"
+
+TensorIntrin.register(
+    AMX_DOT_16x16x64_INTRIN, dot_product_16x16x64_u8i8i32_desc, dot_product_16x16x64_u8i8i32_amx
+)
@@ -104,6 +104,13 @@ def CompactBufferAllocation(is_strict: bool = True):
         Ensure the compacted shape to be always smaller than the original shape.
         Otherwise it allows to grow the shape to match actual accessed buffer regions.
 
+    Note
+    ----
+    The "s_tir.compact_buffer_region_proof_strength" config of the PassContext selects the
+    :py:class:`tvm.arith.ProofStrength` of the region analysis. With ``PRESBURGER``, the affine
+    regions are tightened with Presburger sets when TVM is built with MLIR, e.g. for the
+    accesses guarded by predicates that couple several loop variables.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -179,6 +186,42 @@ def InjectSoftwarePipeline():
     return _ffi_api.InjectSoftwarePipeline()  # type: ignore
 
 
+def InjectSoftwarePrefetch():
+    """Prefetch the global buffer loads of the loops annotated with
+    `software_prefetch_distance` the given number of iterations ahead.
+
+    The loads whose address only depends on the loop variable and the variables defined outside
+    the loop, including indirect ones such as the gathers ``B[idx[i]]``, are prefetched at the
+    beginning of the loop body, the iteration of the address being clamped to the last iteration
+    of the loop. The loads in the vectorized loops of the body are prefetched at the address of
+    their first lane, e.g. the rows ``A[idx[i], 0:n]`` gathered by an embedding bag. Only the
+    functions of the CPU targets are rewritten.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectSoftwarePrefetch()  # type: ignore
+
+
+def MergeParallelLaunch():
+    """Merge the consecutive parallel loops of the CPU functions into one parallel launch, and
+    run the parallel launches with little work serially.
+
+    With the pass config ``s_tir.merge_parallel_launch``, the consecutive parallel loops are run
+    in a single launch of the thread pool, with a barrier between the loops. With the pass config
+    ``s_tir.parallel_launch_min_work``, a launch whose estimated number of executed statements is
+    below the threshold at runtime runs its loops serially instead.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.MergeParallelLaunch()  # type: ignore
+
+
 def LowerAutoCopy():
     """Automatically do memory optimizations for auto copy blocks
 
@@ -288,6 +331,27 @@ def HoistExpression():
     return _ffi_api.HoistExpression()  # type: ignore
 
 
+def HoistIndexOffset():
+    """Hoist the loop-invariant offsets of the affine indices of the global buffers out of
+    each loop level.
+
+    Each index that is affine in a loop variable is split into an offset bound above the loop
+    and the scaled loop variable, and the offsets of the inner loops are split in turn by the
+    outer loops, so that each loop level only adds its own term to the offset of the enclosing
+    level.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+
+    Note
+    ----
+    Run this pass after FlattenBuffer and the last Simplify, which inlines the offsets back.
+    """
+    return _ffi_api.HoistIndexOffset()  # type: ignore
+
+
 def RenormalizeSplitPattern():
     """Renormalize the split pattern from floordiv(floormod()) to floormod(floordiv())
 
@@ -388,6 +452,18 @@ def ThreadSync(storage_scope):
     return _ffi_api.ThreadSync(storage_scope)  # type: ignore
 
 
+def InjectGlobalBarrier():
+    """Insert the global barriers between the conflicting global buffer accesses of the kernels
+    marked with `pragma_global_barrier` by the merge_kernels schedule primitive.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectGlobalBarrier()  # type: ignore
+
+
 def InferFragment():
     """Infer the TensorCore fragment information using tensor intrinsics.
 
@@ -432,10 +508,49 @@ def InjectPTXAsyncCopy():
     return _ffi_api.InjectPTXAsyncCopy()  # type: ignore
 
 
+def InjectWarpSpecialization():
+    """Split the threads of the kernels with a loop marked by the `warp_specialize` schedule
+    primitive into producers and consumers.
+
+    The producers are additional threadIdx.x threads that run the copies of the loop from global
+    to shared memory, into a version of the shared memory buffers for each stage. The consumers
+    run the rest of the kernel, and wait for the copies of each stage on an mbarrier, while the
+    producers wait for the consumers to release the stage before overwriting it. The shared
+    memory barriers of the consumers become named barriers.
+
+    It should run after ThreadSync, on the flattened buffers.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectWarpSpecialization()  # type: ignore
+
+
+def LowerTMADescriptors():
+    """Create the TMA descriptors of the `ptx_tma_load` tile copies on the host, and lower the
+    copies to `ptx_cp_async_bulk_tensor`, which reads the descriptors passed to the kernel.
+
+    It should run before SplitHostDevice, so that the descriptors become kernel parameters.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.LowerTMADescriptors()  # type: ignore
+
+
 def MergeSharedMemoryAllocations():
     """This pass merges multiple TIR-level shared memory allocations
     into one allocation.
 
+    With the ``s_tir.merge_shared_memory_interval_packing`` config, the dynamic shared memory
+    buffers of constant sizes are placed by interval packing of their live ranges, which end at
+    the first barrier after their last access. The ``s_tir.merge_shared_memory_report`` config
+    logs the resulting footprint of each kernel.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -102,6 +102,7 @@ from tvm.relax.op import (
     grad,
     greater,
     greater_equal,
+    grouped_matmul,
     hamming_window,
     hint_on_device,
     image,
@@ -880,6 +881,7 @@ __all__ = [
     "grad",
     "greater",
     "greater_equal",
+    "grouped_matmul",
     "hamming_window",
     "hexagon",
     "hint_on_device",
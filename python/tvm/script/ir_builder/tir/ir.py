@@ -1940,7 +1940,9 @@ ptx_cp_async_barrier = _op_wrapper(_tir_op.ptx_cp_async_barrier)
 ptx_init_barrier_thread_count = _op_wrapper(_tir_op.ptx_init_barrier_thread_count)
 ptx_arrive_barrier = _op_wrapper(_tir_op.ptx_arrive_barrier)
 ptx_arrive_barrier_expect_tx = _op_wrapper(_tir_op.ptx_arrive_barrier_expect_tx)
+ptx_barrier_expect_tx = _op_wrapper(_tir_op.ptx_barrier_expect_tx)
 ptx_wait_barrier = _op_wrapper(_tir_op.ptx_wait_barrier)
+ptx_bar_sync = _op_wrapper(_tir_op.ptx_bar_sync)
 make_filled_simdgroup_matrix = _op_wrapper(_tir_op.make_filled_simdgroup_matrix)
 simdgroup_load = _op_wrapper(_tir_op.simdgroup_load)
 simdgroup_store = _op_wrapper(_tir_op.simdgroup_store)
@@ -1979,14 +1981,25 @@ call_pure_extern = _dtype_forward(_tir_op.call_pure_extern)
 ptx_mma = _dtype_forward(_tir_op.ptx_mma)
 ptx_mma_sp = _dtype_forward(_tir_op.ptx_mma_sp)
 ptx_ldmatrix = _dtype_forward(_tir_op.ptx_ldmatrix)
+ptx_wgmma_ss = _dtype_forward(_tir_op.ptx_wgmma_ss)
+ptx_wgmma_fence = _op_wrapper(_tir_op.ptx_wgmma_fence)
+ptx_wgmma_commit_group = _op_wrapper(_tir_op.ptx_wgmma_commit_group)
+ptx_wgmma_wait_group = _op_wrapper(_tir_op.ptx_wgmma_wait_group)
+ptx_fence_proxy_async = _op_wrapper(_tir_op.ptx_fence_proxy_async)
 ptx_cp_async = _dtype_forward(_tir_op.ptx_cp_async)
 ptx_cp_async_bulk = _dtype_forward(_tir_op.ptx_cp_async_bulk)
+ptx_cp_async_bulk_tensor = _dtype_forward(_tir_op.ptx_cp_async_bulk_tensor)
+ptx_tma_load = _dtype_forward(_tir_op.ptx_tma_load)
 mma_store = _dtype_forward(_tir_op.mma_store)
 mma_fill = _dtype_forward(_tir_op.mma_fill)
 vectorlow = _dtype_forward(_tir_op.vectorlow)
 vectorhigh = _dtype_forward(_tir_op.vectorhigh)
 vectorcombine = _dtype_forward(_tir_op.vectorcombine)
 get_active_lane_mask = _dtype_forward(_tir_op.get_active_lane_mask)
+vector_reduce_add = _dtype_forward(_tir_op.vector_reduce_add)
+vector_reduce_mul = _dtype_forward(_tir_op.vector_reduce_mul)
+vector_reduce_min = _dtype_forward(_tir_op.vector_reduce_min)
+vector_reduce_max = _dtype_forward(_tir_op.vector_reduce_max)
 dp4a = _dtype_forward(_tir_op.dp4a)
 
 
@@ -2222,15 +2235,24 @@ __all__ = float_types + [
     "ptx_mma",
     "ptx_mma_sp",
     "ptx_ldmatrix",
+    "ptx_wgmma_ss",
+    "ptx_wgmma_fence",
+    "ptx_wgmma_commit_group",
+    "ptx_wgmma_wait_group",
+    "ptx_fence_proxy_async",
     "ptx_cp_async",
     "ptx_cp_async_bulk",
+    "ptx_cp_async_bulk_tensor",
+    "ptx_tma_load",
     "ptx_wait_group",
     "ptx_commit_group",
     "ptx_cp_async_barrier",
     "ptx_init_barrier_thread_count",
     "ptx_arrive_barrier",
     "ptx_arrive_barrier_expect_tx",
+    "ptx_barrier_expect_tx",
     "ptx_wait_barrier",
+    "ptx_bar_sync",
     "make_filled_simdgroup_matrix",
     "simdgroup_load",
     "simdgroup_store",
@@ -2304,6 +2326,10 @@ __all__ = float_types + [
     "Range",
     "vscale",
     "get_active_lane_mask",
+    "vector_reduce_add",
+    "vector_reduce_mul",
+    "vector_reduce_min",
+    "vector_reduce_max",
     "call_kernel",
     "ignore_loop_partition",
 ]
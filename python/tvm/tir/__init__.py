@@ -66,15 +66,24 @@ from .op import (
 from .op import ptx_mma, ptx_mma_sp, mma_store, mma_fill
 from .op import (
     ptx_ldmatrix,
+    ptx_wgmma_ss,
+    ptx_wgmma_fence,
+    ptx_wgmma_commit_group,
+    ptx_wgmma_wait_group,
+    ptx_fence_proxy_async,
     ptx_cp_async,
     ptx_cp_async_bulk,
+    ptx_cp_async_bulk_tensor,
+    ptx_tma_load,
     ptx_commit_group,
     ptx_wait_group,
     ptx_cp_async_barrier,
     ptx_init_barrier_thread_count,
     ptx_arrive_barrier,
     ptx_arrive_barrier_expect_tx,
+    ptx_barrier_expect_tx,
     ptx_wait_barrier,
+    ptx_bar_sync,
     create_barriers,
 )
 from .op import (
@@ -110,6 +119,7 @@ from .op import q_multiply_shift, q_multiply_shift_per_axis, shift_left, shift_r
 from .op import TVMBackendAllocWorkspace, TVMBackendFreeWorkspace
 from .op import start_profile_intrinsic, end_profile_intrinsic
 from .op import vscale, get_active_lane_mask, get_vscale_expr
+from .op import vector_reduce_add, vector_reduce_mul, vector_reduce_min, vector_reduce_max
 from .op import dp4a
 from .op import ignore_loop_partition
 from .generic import add, subtract, multiply
@@ -120,14 +120,16 @@ def split_host_device_mods(mod: IRModule) -> tuple[IRModule, dict[Target, IRModu
 
 
 def codegen_build(mod: IRModule, target: Target) -> tvm.runtime.Module:
-    """Build a runtime module from an IRModule and a Target."""
-    if tvm.ir.transform.PassContext.current().config.get("tir.disable_assert", False):
-        mod = tvm.tir.transform.SkipAssert()(mod)
+    """Build a runtime module from an IRModule and a Target.
+
+    When the pass config `target.build_cache_dir` is set, the generated modules are cached in
+    that directory, keyed by the structural hash of `mod`, the target and the pass config, so
+    that rebuilding unchanged kernels, possibly in another process, skips the code generation.
+    """
     build_f_name = "target.build." + target.kind.name
-    bf = tvm.get_global_func(build_f_name)
-    if bf is None:
+    if tvm.get_global_func(build_f_name, allow_missing=True) is None:
         raise ValueError(f"{build_f_name} is not enabled")
-    return bf(mod, target)
+    return tvm.get_global_func("target.Build")(mod, target)
 
 
 def tir_to_runtime(
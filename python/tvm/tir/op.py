@@ -1364,6 +1364,164 @@ def ptx_ldmatrix(dtype, trans, num, type, local_ptr, local_offset, smem_ptr, sme
     )
 
 
+
+def ptx_wgmma_ss(
+    dtype,
+    shape,
+    A_dtype,
+    B_dtype,
+    C_dtype,
+    a_smem,
+    a_offset,
+    a_leading_byte_offset,
+    a_stride_byte_offset,
+    b_smem,
+    b_offset,
+    b_leading_byte_offset,
+    b_stride_byte_offset,
+    swizzle_kind,
+    accumulator,
+    c_offset,
+    scale_d=True,
+):
+    """TVM intrinsic for ptx warpgroup mma with both multiplicands in shared memory
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-mma-async
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the result.
+
+    shape : str
+        The shape of the mma fragment, m64nNkK.
+
+    A_dtype : str
+        The data type of multiplicand A.
+
+    B_dtype : str
+        The data type of multiplicand B.
+
+    C_dtype : str
+        The data type of the accumulator.
+
+    a_smem : Var
+        The shared memory pointer of the K-major multiplicand A.
+
+    a_offset : Expr
+        The offset of the first element of A.
+
+    a_leading_byte_offset : int
+        The leading dimension byte offset of the matrix descriptor of A.
+
+    a_stride_byte_offset : int
+        The stride dimension byte offset of the matrix descriptor of A.
+
+    b_smem : Var
+        The shared memory pointer of the K-major multiplicand B.
+
+    b_offset : Expr
+        The offset of the first element of B.
+
+    b_leading_byte_offset : int
+        The leading dimension byte offset of the matrix descriptor of B.
+
+    b_stride_byte_offset : int
+        The stride dimension byte offset of the matrix descriptor of B.
+
+    swizzle_kind : int
+        The swizzle kind of A and B, in the encoding of CUtensorMapSwizzle, i.e. 0 for no
+        swizzle, and 1, 2 and 3 for 32B, 64B and 128B swizzle.
+
+    accumulator : Var
+        The accumulator registers, of which each thread of the warpgroup holds 64 * N / 128.
+
+    c_offset : Expr
+        The offset of the first element of the accumulator.
+
+    scale_d : Expr
+        Whether to accumulate into the accumulator, otherwise it is overwritten.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        dtype,
+        "tir.ptx_wgmma_ss",
+        shape,
+        A_dtype,
+        B_dtype,
+        C_dtype,
+        a_smem,
+        a_offset,
+        a_leading_byte_offset,
+        a_stride_byte_offset,
+        b_smem,
+        b_offset,
+        b_leading_byte_offset,
+        b_stride_byte_offset,
+        swizzle_kind,
+        accumulator,
+        c_offset,
+        scale_d,
+    )
+
+
+def ptx_wgmma_fence():
+    """TVM intrinsic for ordering the register accesses of the accumulators before wgmma
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-fence
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wgmma_fence")
+
+
+def ptx_wgmma_commit_group():
+    """TVM intrinsic for committing the prior wgmma of the warpgroup into a group
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-commit-group
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wgmma_commit_group")
+
+
+def ptx_wgmma_wait_group(num):
+    """TVM intrinsic for waiting until at most `num` groups of wgmma are pending
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-wait-group
+
+    Parameters
+    ----------
+    num : int
+        The number of the most recent groups that may be pending.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wgmma_wait_group", num)
+
+
+def ptx_fence_proxy_async():
+    """TVM intrinsic for making the shared memory writes of the generic proxy visible to the
+    async proxy, which wgmma and TMA read shared memory through
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-membar
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_fence_proxy_async")
+
+
 def ptx_cp_async(dtype, shared_ptr, shared_offset, global_ptr, global_offset, bytes):
     """TVM intrinsic for ptx async copy from global to shared memory using cp.async
     https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-cp-async
@@ -1450,6 +1608,99 @@ def ptx_cp_async_bulk(
     )
 
 
+def ptx_cp_async_bulk_tensor(dtype, shared_ptr, shared_offset, tensor_map, barrier_id, *coords):
+    """TVM intrinsic for ptx async copy of a tile from global to shared memory using the Tensor
+    Memory Accelerator (TMA), i.e. cp.async.bulk.tensor
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-cp-async-bulk-tensor
+
+    Parameters
+    ----------
+    dtype : str
+       The data type of the result.
+
+    shared_ptr : Var
+        The shared memory pointer variable.
+
+    shared_offset : Expr
+        The offset of shared memory pointer.
+
+    tensor_map : Var
+        The CUtensorMap descriptor of the global tensor, passed to the kernel.
+
+    barrier_id : int
+        The ID of the barrier shared memory pointer.
+
+    coords : Expr
+        The coordinates of the tile, from the outermost to the innermost dimension.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        dtype,
+        "tir.ptx_cp_async_bulk_tensor",
+        shared_ptr,
+        shared_offset,
+        tensor_map,
+        barrier_id,
+        *coords,
+    )
+
+
+def ptx_tma_load(
+    dtype, shared_ptr, shared_offset, global_ptr, barrier_id, swizzle_kind, rank, *args
+):
+    """TVM intrinsic for a TMA copy of a tile from a dense row-major global tensor to shared
+    memory. The LowerTMADescriptors pass creates the descriptor of the tensor on the host and
+    lowers it to :py:func:`ptx_cp_async_bulk_tensor`.
+
+    Parameters
+    ----------
+    dtype : str
+       The data type of the tensor.
+
+    shared_ptr : Var
+        The shared memory pointer variable.
+
+    shared_offset : Expr
+        The offset of shared memory pointer.
+
+    global_ptr : Var
+        The pointer of the global tensor, a parameter of the function.
+
+    barrier_id : int
+        The ID of the barrier shared memory pointer.
+
+    swizzle_kind : int
+        The CUtensorMapSwizzle of the tile in shared memory.
+
+    rank : int
+        The number of dimensions of the tensor.
+
+    args : Expr
+        The `rank` dimensions of the global tensor, then the `rank` constant dimensions of the
+        tile, then the `rank` coordinates of the tile, all from the outermost dimension.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        dtype,
+        "tir.ptx_tma_load",
+        shared_ptr,
+        shared_offset,
+        global_ptr,
+        barrier_id,
+        swizzle_kind,
+        rank,
+        *args,
+    )
+
+
 def ptx_commit_group():
     """TVM intrinsic for ptx async copy commit
     https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-cp-async-commit-group
@@ -1555,7 +1806,29 @@ def ptx_arrive_barrier_expect_tx(barrier_id, byte_count):
     return call_intrin("", "tir.ptx_arrive_barrier_expect_tx", barrier_id, byte_count)
 
 
-def ptx_wait_barrier(barrier_id):
+def ptx_barrier_expect_tx(barrier_id, byte_count):
+    """TVM intrinsic for increasing the expected tx count of a ptx barrier without arriving on
+    it, using mbarrier.expect_tx
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-mbarrier-expect-tx
+
+    Parameters
+    ----------
+    barrier_id : int
+        The ID of the barrier shared memory pointer.
+
+    byte_count : int
+        Increases the tx count of the mbarrier object to track completion of
+        addtional async transactions.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_barrier_expect_tx", barrier_id, byte_count)
+
+
+def ptx_wait_barrier(barrier_id, phase=None):
     """TVM intrinsic for ptx barrier wait using mbarrier.try_wait
     https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-mbarrier-test-wait-mbarrier-try-wait
 
@@ -1564,12 +1837,38 @@ def ptx_wait_barrier(barrier_id):
     barrier_id : int
         The ID of the barrier shared memory pointer.
 
+    phase : Optional[int]
+        The parity of the phase to wait for, 0 if not given.
+
     Returns
     -------
     call : PrimExpr
         The call expression.
     """
-    return call_intrin("", "tir.ptx_wait_barrier", barrier_id)
+    if phase is None:
+        return call_intrin("", "tir.ptx_wait_barrier", barrier_id)
+    return call_intrin("", "tir.ptx_wait_barrier", barrier_id, phase)
+
+
+def ptx_bar_sync(barrier_id, thread_count):
+    """TVM intrinsic for synchronizing a subset of the threads of a block on a named barrier
+    using bar.sync
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-bar
+
+    Parameters
+    ----------
+    barrier_id : int
+        The ID of the named barrier, where 0 is used by __syncthreads.
+
+    thread_count : int
+        The number of threads that synchronize, a multiple of the warp size.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_bar_sync", barrier_id, thread_count)
 
 
 def create_barriers(barrier_count):
@@ -3671,6 +3970,90 @@ def get_active_lane_mask(dtype, base, limit):
     return call_intrin(dtype, "tir.get_active_lane_mask", base, limit)
 
 
+def vector_reduce_add(dtype, vec):
+    """Sum the lanes of a vector, i.e. a horizontal reduction.
+
+    It will be lowered to the llvm.vector.reduce.* intrinsics.
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the result, the element type of the vector.
+
+    vec : PrimExpr
+        The input vector.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.vector_reduce_add", vec)
+
+
+def vector_reduce_mul(dtype, vec):
+    """Multiply the lanes of a vector, i.e. a horizontal reduction.
+
+    It will be lowered to the llvm.vector.reduce.* intrinsics.
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the result, the element type of the vector.
+
+    vec : PrimExpr
+        The input vector.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.vector_reduce_mul", vec)
+
+
+def vector_reduce_min(dtype, vec):
+    """Get the minimum of the lanes of a vector, i.e. a horizontal reduction.
+
+    It will be lowered to the llvm.vector.reduce.* intrinsics.
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the result, the element type of the vector.
+
+    vec : PrimExpr
+        The input vector.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.vector_reduce_min", vec)
+
+
+def vector_reduce_max(dtype, vec):
+    """Get the maximum of the lanes of a vector, i.e. a horizontal reduction.
+
+    It will be lowered to the llvm.vector.reduce.* intrinsics.
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the result, the element type of the vector.
+
+    vec : PrimExpr
+        The input vector.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.vector_reduce_max", vec)
+
+
 def get_vscale_expr(dtype: str | tvm_ffi.dtype, min_size: int = 128) -> PrimExpr:
     """
     Create a datatype dependent scalable expression.
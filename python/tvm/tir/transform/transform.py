@@ -116,6 +116,15 @@ def UnrollLoop():
 
     This pass also automatically attach pragma unroll tag to loops which meets the standard.
 
+    When the unrolling is not tuned, i.e. neither `auto_max_step` nor `auto_max_extent` of the
+    "tir.UnrollLoop" config is set and the loops are not under `pragma_auto_unroll_max_step`,
+    the innermost loops of constant extents are unrolled by a cost model of the target of the
+    function. It bounds the estimated instructions of the unrolled loop, and on GPU the estimated
+    registers of a thread, i.e. the local allocations and the values loaded ahead by the unrolled
+    loop, by the registers left to each thread of the thread block. The cost model is disabled by
+    `auto_unroll_heuristic` of the config, and its decisions of each loop are logged when the
+    "tir.unroll_loop_report" config is set.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -417,6 +426,26 @@ def ForceNarrowIndexToInt32():
     return _ffi_api.ForceNarrowIndexToInt32()  # type: ignore
 
 
+def NarrowIndexArithmetic():
+    """Compute the int64 index expressions of the kernels in int32 where it is provably safe.
+
+    Unlike NarrowDataType, which narrows a variable only if all the expressions containing it
+    fit into int32, each index is narrowed on its own, so that a single large buffer does not
+    keep all the index arithmetic of a kernel in int64. Only the terms that may not fit into
+    int32, e.g. the base offsets into large buffers, are kept in int64.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+
+    Note
+    ----
+    Run this pass after FlattenBuffer. Only the indices under thread_extent are rewritten.
+    """
+    return _ffi_api.NarrowIndexArithmetic()  # type: ignore
+
+
 def VerifyMemory():
     """Verify if func contains illegal host side direct memory access.
 
@@ -853,6 +853,55 @@ def sort_thrust(data, axis=-1, is_ascend=1, workspace=None):
     return out
 
 
+def segmented_sort_thrust(data, offsets, is_ascend=1, dtype="int32", workspace=None):
+    """Sorts each segment of a 1-D array, e.g. the candidates of each sequence of a batch in
+    sampling, and returns the sorted values and their indices within their segment.
+
+    Parameters
+    ----------
+    data: tvm.te.Tensor
+        The 1-D input array.
+
+    offsets: tvm.te.Tensor
+        The 1-D int32 or int64 array of the (num_segments + 1) segment boundaries: the segment s
+        is data[offsets[s]:offsets[s + 1]]. The elements outside of all the segments are not
+        written to the outputs.
+
+    is_ascend : boolean, optional
+        Whether to sort in ascending or descending order.
+
+    dtype : str, optional
+        The data type of the output indices, int32 or int64.
+
+    workspace: Optional[tvm.te.Tensor]
+        A buffer to store intermediate results. The size of the workspace should be sufficiently
+        large, this can be obtained by overestimation or memory usage profiling. If None, it will
+        fallback to use thrust internal memory allocation.
+
+    Returns
+    -------
+    out : List[tvm.te.Tensor]
+        The sorted values and their indices within their segment.
+    """
+    value_buf = tvm.tir.decl_buffer(data.shape, data.dtype, "value_buf", data_alignment=8)
+    indices_buf = tvm.tir.decl_buffer(data.shape, dtype, "out_buf", data_alignment=8)
+
+    def f_compute(ins, outs):
+        args = ["tvm.contrib.thrust.segmented_sort", ins[0], ins[1], outs[0], outs[1], is_ascend]
+        if workspace is not None:
+            args.append(ins[2])
+        return tvm.tir.call_packed(*args)
+
+    return te.extern(
+        [data.shape, data.shape],
+        [data, offsets] if workspace is None else [data, offsets, workspace],
+        f_compute,
+        out_buffers=[value_buf, indices_buf],
+        name="segmented_sort_gpu",
+        tag="segmented_sort_gpu",
+    )
+
+
 def argsort(data, axis=-1, is_ascend=1, dtype="float32", ret_type="indices"):
     """Performs sorting along the given axis and returns an array of indices
     having same shape as an input array that index data in sorted order.
@@ -55,3 +55,4 @@ from .space_to_batch_nd import *
 from .batch_to_space_nd import *
 from .loss import *
 from .lstm import *
+from .embedding_bag import embedding_bag
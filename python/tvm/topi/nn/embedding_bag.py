@@ -0,0 +1,100 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Embedding bag operator."""
+
+from tvm import te, tir
+
+
+def embedding_bag(weight, indices, offsets=None, mode="sum"):
+    """Pool the rows of an embedding table gathered by the bags of indices, without
+    materializing the gathered rows.
+
+    output{i_1, ..., i_k, d} = pool_j(weight{indices{i_1, ..., i_k, j}, d})
+
+    The bags have a fixed size, and are padded with negative indices, whose rows are skipped.
+    With `offsets`, the table is the concatenation of the tables of the axis before the bag
+    axis, e.g. the tables of the sparse features of a recommendation model, and the indices of
+    table t are offset by offsets{t}, so that all the tables are pooled by one kernel.
+
+    Parameters
+    ----------
+    weight : tvm.te.Tensor
+        2-D with shape (num_rows, dim)
+
+    indices : tvm.te.Tensor
+        (k+1)-D with shape (i_1, ..., i_k, bag_size), int32 or int64
+
+    offsets : Optional[tvm.te.Tensor]
+        1-D with shape (i_k,), the first row of each table in weight
+
+    mode : str
+        The pooling of the rows of a bag, "sum" or "mean". The mean of a bag of padding
+        only is zero.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        (k+1)-D with shape (i_1, ..., i_k, dim)
+    """
+    if mode not in ("sum", "mean"):
+        raise ValueError(f"Unsupported embedding bag mode: {mode}")
+    *batch_shape, bag_size = indices.shape
+    dim = weight.shape[1]
+    dtype = weight.dtype
+    # Half-precision rows are accumulated in float32.
+    acc_dtype = "float32" if dtype in ("float16", "bfloat16") else dtype
+    has_epilogue = mode == "mean" or acc_dtype != dtype
+
+    def _pool(*idx):
+        # The row of a padding index is clamped to the first row of its table and loaded
+        # unconditionally, so that the rows can be prefetched ahead of the condition.
+        row = te.max(indices(*idx[:-1], j), 0)
+        if offsets is not None:
+            row = row + offsets[idx[-2]].astype(row.dtype)
+        value = tir.Var("value", acc_dtype)
+        return tir.Let(
+            value,
+            weight[row, idx[-1]].astype(acc_dtype),
+            tir.Select(indices(*idx[:-1], j) >= 0, value, tir.const(0, acc_dtype)),
+        )
+
+    j = te.reduce_axis((0, bag_size), name="j")
+    pooled = te.compute(
+        (*batch_shape, dim),
+        lambda *idx: te.sum(_pool(*idx), axis=j),
+        name="embedding_bag_pool" if has_epilogue else "embedding_bag",
+    )
+    if not has_epilogue:
+        return pooled
+    if mode == "sum":
+        return te.compute(
+            pooled.shape, lambda *idx: pooled(*idx).astype(dtype), name="embedding_bag"
+        )
+
+    k = te.reduce_axis((0, bag_size), name="k")
+    count = te.compute(
+        batch_shape,
+        lambda *idx: te.sum((indices(*idx, k) >= 0).astype(acc_dtype), axis=k),
+        name="embedding_bag_count",
+    )
+    return te.compute(
+        pooled.shape,
+        lambda *idx: (
+            pooled(*idx) / te.max(count(*idx[:-1]), tir.const(1, acc_dtype))
+        ).astype(dtype),
+        name="embedding_bag",
+    )
@@ -26,6 +26,12 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../support/utils.h"
 #include "./scalable_expression.h"
 #include "const_fold.h"
 #include "product_normal_form.h"
@@ -33,6 +39,39 @@
 namespace tvm {
 namespace arith {
 
+/*!
+ * \brief The memo table of Analyzer::Simplify.
+ *
+ * Each ConstraintContext gets a fresh epoch, and the entries are keyed by the expression, the
+ * number of steps and the epoch of the innermost context. The key holds a reference to the
+ * expression, so its address is not reused while the entry lives.
+ */
+struct Analyzer::SimplifyCache {
+  using Key = std::tuple<const Object*, int, uint64_t>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t hash = std::hash<const Object*>()(std::get<0>(key));
+      hash = support::HashCombine(hash, std::hash<int>()(std::get<1>(key)));
+      return support::HashCombine(hash, std::hash<uint64_t>()(std::get<2>(key)));
+    }
+  };
+
+  /*! \brief The maximum number of entries, beyond which the table is cleared. */
+  static constexpr size_t kMaxNumEntries = 1 << 16;
+
+  /*! \brief The epochs of the active constraint contexts, the outermost scope first. */
+  std::vector<uint64_t> epochs{0};
+  /*! \brief The next fresh epoch. */
+  uint64_t next_epoch{1};
+  /*! \brief The cached expressions and their simplified results. */
+  std::unordered_map<Key, std::pair<PrimExpr, PrimExpr>, KeyHash> table;
+  /*! \brief The number of lookups that returned a cached result. */
+  int64_t num_hits{0};
+  /*! \brief The number of lookups that ran the simplifiers. */
+  int64_t num_misses{0};
+};
+
 Analyzer::Analyzer()
     : const_int_bound(this),
       modular_set(this),
@@ -40,7 +79,10 @@ Analyzer::Analyzer()
       canonical_simplify(this),
       int_set(this) {}
 
+Analyzer::~Analyzer() = default;
+
 void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
+  ClearSimplifyCache();
   PrimExpr new_expr = expr;
   new_expr = this->canonical_simplify(new_expr);
   new_expr = this->rewrite_simplify(new_expr);
@@ -55,6 +97,7 @@ void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
 
 void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
   TVM_FFI_ICHECK(range.defined());
+  ClearSimplifyCache();
   if (tir::is_one(range->extent)) {
     this->Bind(var, range->min, allow_override);
   } else {
@@ -67,6 +110,7 @@ void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
 }
 
 void Analyzer::MarkGlobalNonNegValue(const PrimExpr& value) {
+  ClearSimplifyCache();
   // decompose value as symbol * scale + offset
   int64_t offset = 0;
   PrimExpr symbol_scale = tir::make_const(value.dtype(), 0);
@@ -130,6 +174,22 @@ void ConstraintContext::EnterWithScope() {
   recovery_functions_.push_back(analyzer_->rewrite_simplify.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->int_set.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->transitive_comparisons.EnterConstraint(constraint_));
+  // The results simplified under the constraint must not be reused after the scope exits.
+  bool has_epoch = analyzer_->simplify_cache_ != nullptr;
+  if (has_epoch) {
+    auto* cache = analyzer_->simplify_cache_.get();
+    cache->epochs.push_back(cache->next_epoch++);
+  }
+  recovery_functions_.push_back([analyzer = analyzer_, has_epoch]() {
+    if (auto* cache = analyzer->simplify_cache_.get()) {
+      if (has_epoch && cache->epochs.size() > 1) {
+        cache->epochs.pop_back();
+      } else {
+        // The table was enabled within the scope, its entries may depend on the constraint.
+        cache->table.clear();
+      }
+    }
+  });
 }
 
 void ConstraintContext::ExitWithScope() {
@@ -250,6 +310,48 @@ bool Analyzer::CanProve(const PrimExpr& expr, ProofStrength strength) {
 }
 
 PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
+  SimplifyCache* cache = simplify_cache_.get();
+  if (cache == nullptr || expr->IsInstance<IntImmNode>()) {
+    return SimplifyImpl(expr, steps);
+  }
+  SimplifyCache::Key key{expr.get(), steps, cache->epochs.back()};
+  if (auto it = cache->table.find(key); it != cache->table.end()) {
+    ++cache->num_hits;
+    return it->second.second;
+  }
+  ++cache->num_misses;
+  PrimExpr res = SimplifyImpl(expr, steps);
+  if (cache->table.size() >= SimplifyCache::kMaxNumEntries) {
+    cache->table.clear();
+  }
+  cache->table.emplace(key, std::make_pair(expr, res));
+  return res;
+}
+
+void Analyzer::EnableSimplifyCache(bool enable) {
+  if (!enable) {
+    simplify_cache_.reset();
+  } else if (simplify_cache_ == nullptr) {
+    simplify_cache_ = std::make_unique<SimplifyCache>();
+  }
+}
+
+void Analyzer::ClearSimplifyCache() {
+  if (simplify_cache_ != nullptr) {
+    simplify_cache_->table.clear();
+  }
+}
+
+ffi::Map<ffi::String, int64_t> Analyzer::GetSimplifyCacheStats() const {
+  if (simplify_cache_ == nullptr) {
+    return {{"num_hits", 0}, {"num_misses", 0}, {"num_entries", 0}};
+  }
+  return {{"num_hits", simplify_cache_->num_hits},
+          {"num_misses", simplify_cache_->num_misses},
+          {"num_entries", static_cast<int64_t>(simplify_cache_->table.size())}};
+}
+
+PrimExpr Analyzer::SimplifyImpl(const PrimExpr& expr, int steps) {
   PrimExpr res = expr;
 
   // Always starts with a canonical simplification, as some structural property
@@ -316,6 +418,14 @@ TVM_FFI_STATIC_INIT_BLOCK() {
         return ffi::Function([self](ffi::PackedArgs args, ffi::Any* ret) {
           self->rewrite_simplify.ResetStatsCounters();
         });
+      } else if (name == "enable_simplify_cache") {
+        return ffi::Function([self](ffi::PackedArgs args, ffi::Any* ret) {
+          self->EnableSimplifyCache(args[0].cast<bool>());
+        });
+      } else if (name == "get_simplify_cache_stats") {
+        return ffi::Function([self](ffi::PackedArgs args, ffi::Any* ret) {
+          *ret = self->GetSimplifyCacheStats();
+        });
       } else if (name == "canonical_simplify") {
         return ffi::Function([self](ffi::PackedArgs args, ffi::Any* ret) {
           *ret = self->canonical_simplify(args[0].cast<PrimExpr>());
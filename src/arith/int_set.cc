@@ -1257,10 +1257,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
              return EstimateRegionStrictBound(region, var_dom, predicate, &analyzer);
            })
       .def("arith.EstimateRegionUpperBound",
-           [](ffi::Array<Range> region, ffi::Map<Var, Range> var_dom,
-              PrimExpr predicate) -> ffi::Optional<ffi::Array<IntSet>> {
+           [](ffi::Array<Range> region, ffi::Map<Var, Range> var_dom, PrimExpr predicate,
+              int strength) -> ffi::Optional<ffi::Array<IntSet>> {
              Analyzer analyzer;
-             return EstimateRegionUpperBound(region, var_dom, predicate, &analyzer);
+             return EstimateRegionUpperBound(region, var_dom, predicate, &analyzer,
+                                             static_cast<ProofStrength>(strength));
            })
       .def("arith.PosInf", []() { return SymbolicLimits::pos_inf_; })
       .def("arith.NegInf", []() { return SymbolicLimits::neg_inf_; })
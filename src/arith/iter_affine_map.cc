@@ -29,7 +29,10 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <functional>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "../support/utils.h"
 #include "const_fold.h"
@@ -2675,5 +2678,197 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def("arith.InverseAffineIterMap", InverseAffineIterMap);
 }
 
+/*!
+ * \brief Rewrite the splits of the marks of some input iterators of an iter map.
+ *
+ * The marks whose source is a fused sum are rebuilt once each, so the marks shared by the
+ * indices of the map stay shared after the rewrite.
+ */
+class IterMapInputRewriter {
+ public:
+  using FRewriteSplit = std::function<IterSplitExpr(const IterSplitExpr&)>;
+
+  explicit IterMapInputRewriter(std::unordered_map<const VarNode*, FRewriteSplit> frewrite)
+      : frewrite_(std::move(frewrite)) {}
+
+  IterSumExpr Rewrite(const IterSumExpr& sum) {
+    ffi::Array<IterSplitExpr> args = sum->args.Map(
+        [this](const IterSplitExpr& split) -> IterSplitExpr { return Rewrite(split); });
+    return args.same_as(sum->args) ? sum : IterSumExpr(args, sum->base);
+  }
+
+ private:
+  IterSplitExpr Rewrite(const IterSplitExpr& split) {
+    if (const auto* var = split->source->source.as<VarNode>()) {
+      auto it = frewrite_.find(var);
+      return it != frewrite_.end() ? it->second(split) : split;
+    }
+    IterMark mark = Rewrite(split->source);
+    if (mark.same_as(split->source)) {
+      return split;
+    }
+    return IterSplitExpr(mark, split->lower_factor, split->extent, split->scale);
+  }
+
+  IterMark Rewrite(const IterMark& mark) {
+    if (auto it = marks_.find(mark.get()); it != marks_.end()) {
+      return it->second;
+    }
+    IterMark new_mark = mark;
+    if (const auto* sum = mark->source.as<IterSumExprNode>()) {
+      IterSumExpr new_sum = Rewrite(ffi::GetRef<IterSumExpr>(sum));
+      if (!new_sum.same_as(mark->source)) {
+        new_mark = IterMark(new_sum, mark->extent);
+      }
+    }
+    marks_[mark.get()] = new_mark;
+    return new_mark;
+  }
+
+  /*! \brief The rewrite of the splits of each input iterator. */
+  std::unordered_map<const VarNode*, FRewriteSplit> frewrite_;
+  /*! \brief The rewritten marks. */
+  std::unordered_map<const IterMarkNode*, IterMark> marks_;
+};
+
+/*!
+ * \brief Apply a rewrite of the input iterators to an iter map result.
+ * \param result The iter map result to update.
+ * \param frewrite The rewrite of the splits of the marks of the replaced iterators.
+ * \param vmap The expressions of the replaced iterators in the new iterators.
+ * \param errors The errors found by the rewrite.
+ * \param analyzer The analyzer to simplify the padding predicate.
+ */
+static IterMapResult RewriteIterMapInputs(
+    const IterMapResult& result,
+    std::unordered_map<const VarNode*, IterMapInputRewriter::FRewriteSplit> frewrite,
+    const ffi::Map<Var, PrimExpr>& vmap, const ffi::Array<ffi::String>* errors,
+    Analyzer* analyzer) {
+  if (!result->errors.empty() || result->indices.empty()) {
+    return result;
+  }
+  IterMapInputRewriter rewriter(std::move(frewrite));
+  ffi::Array<IterSumExpr> indices = result->indices.Map(
+      [&rewriter](const IterSumExpr& sum) -> IterSumExpr { return rewriter.Rewrite(sum); });
+  IterMapResult updated;
+  if (!errors->empty()) {
+    updated->errors = *errors;
+    return updated;
+  }
+  updated->indices = std::move(indices);
+  if (result->padding_predicate.defined()) {
+    updated->padding_predicate = analyzer->Simplify(Substitute(result->padding_predicate, vmap));
+  }
+  return updated;
+}
+
+IterMapResult UpdateIterMapForSplit(const IterMapResult& result, const Var& loop,
+                                    const ffi::Array<Var>& new_loops,
+                                    const ffi::Array<PrimExpr>& new_extents,
+                                    arith::Analyzer* analyzer) {
+  TVM_FFI_ICHECK_EQ(new_loops.size(), new_extents.size());
+  // The components of the split loop, loop = sum(new_loops[i] * strides[i]).
+  std::vector<PrimExpr> strides(new_loops.size());
+  std::vector<IterMark> marks;
+  ffi::Array<IterSplitExpr> components;
+  PrimExpr stride = make_const(loop.dtype(), 1);
+  PrimExpr loop_value = make_const(loop.dtype(), 0);
+  for (size_t i = new_loops.size(); i > 0; --i) {
+    strides[i - 1] = stride;
+    marks.insert(marks.begin(), IterMark(new_loops[i - 1], new_extents[i - 1]));
+    if (!is_one(new_extents[i - 1])) {
+      components.insert(components.begin(), IterSplitExpr(marks.front(), stride));
+    }
+    loop_value = loop_value + new_loops[i - 1] * stride;
+    stride = analyzer->Simplify(stride * new_extents[i - 1]);
+  }
+  PrimExpr total_extent = stride;
+
+  ffi::Array<ffi::String> errors;
+  std::unordered_map<const IterMarkNode*, IterMark> fused_marks;
+  auto frewrite = [&](const IterSplitExpr& split) -> IterSplitExpr {
+    const IterMark& mark = split->source;
+    if (!analyzer->CanProveEqual(mark->extent, total_extent)) {
+      errors.push_back("The split of the loop " + std::string(loop->name_hint) +
+                       " is not perfect");
+      return split;
+    }
+    // A split covered by a single new loop is a split of that loop.
+    for (size_t i = 0; i < marks.size(); ++i) {
+      if (!analyzer->CanProveEqual(floormod(split->lower_factor, strides[i]), 0)) {
+        continue;
+      }
+      PrimExpr lower_factor = analyzer->Simplify(floordiv(split->lower_factor, strides[i]));
+      if (analyzer->CanProveEqual(floormod(new_extents[i], lower_factor * split->extent), 0)) {
+        return IterSplitExpr(marks[i], lower_factor, split->extent, split->scale);
+      }
+    }
+    auto it = fused_marks.find(mark.get());
+    if (it == fused_marks.end()) {
+      IterMark fused(IterSumExpr(components, make_const(loop.dtype(), 0)), mark->extent);
+      it = fused_marks.emplace(mark.get(), fused).first;
+    }
+    return IterSplitExpr(it->second, split->lower_factor, split->extent, split->scale);
+  };
+  return RewriteIterMapInputs(result, {{loop.get(), frewrite}}, {{loop, loop_value}}, &errors,
+                              analyzer);
+}
+
+IterMapResult UpdateIterMapForFuse(const IterMapResult& result, const ffi::Array<Var>& loops,
+                                   const ffi::Array<PrimExpr>& extents, const Var& fused,
+                                   arith::Analyzer* analyzer) {
+  TVM_FFI_ICHECK_EQ(loops.size(), extents.size());
+  PrimExpr fused_extent = make_const(fused.dtype(), 1);
+  for (const PrimExpr& extent : extents) {
+    fused_extent = fused_extent * extent;
+  }
+  IterMark fused_mark(fused, analyzer->Simplify(fused_extent));
+
+  ffi::Array<ffi::String> errors;
+  std::unordered_map<const VarNode*, IterMapInputRewriter::FRewriteSplit> frewrite;
+  ffi::Map<Var, PrimExpr> vmap;
+  // The loops are given from the outermost one, loops[i] = fused // inner_extent % extents[i].
+  PrimExpr inner_extent = make_const(fused.dtype(), 1);
+  for (size_t i = loops.size(); i > 0; --i) {
+    const Var& loop = loops[i - 1];
+    const PrimExpr& extent = extents[i - 1];
+    PrimExpr lower_factor = inner_extent;
+    bool is_outermost = i == 1;
+    frewrite[loop.get()] = [&errors, analyzer, fused_mark, loop, extent, lower_factor,
+                            is_outermost](const IterSplitExpr& split) -> IterSplitExpr {
+      if (!analyzer->CanProveEqual(split->source->extent, extent) ||
+          (!is_outermost && !analyzer->CanProveEqual(
+                                floormod(extent, split->lower_factor * split->extent), 0))) {
+        errors.push_back("The loop " + std::string(loop->name_hint) +
+                         " does not tile the fused loop");
+        return split;
+      }
+      return IterSplitExpr(fused_mark, analyzer->Simplify(split->lower_factor * lower_factor),
+                           split->extent, split->scale);
+    };
+    PrimExpr value = floordiv(fused, inner_extent);
+    vmap.Set(loop, is_outermost ? value : floormod(value, extent));
+    inner_extent = analyzer->Simplify(inner_extent * extent);
+  }
+  return RewriteIterMapInputs(result, std::move(frewrite), vmap, &errors, analyzer);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("arith.UpdateIterMapForSplit",
+           [](const IterMapResult& result, const Var& loop, const ffi::Array<Var>& new_loops,
+              const ffi::Array<PrimExpr>& new_extents) {
+             arith::Analyzer ana;
+             return UpdateIterMapForSplit(result, loop, new_loops, new_extents, &ana);
+           })
+      .def("arith.UpdateIterMapForFuse",
+           [](const IterMapResult& result, const ffi::Array<Var>& loops,
+              const ffi::Array<PrimExpr>& extents, const Var& fused) {
+             arith::Analyzer ana;
+             return UpdateIterMapForFuse(result, loops, extents, fused, &ana);
+           });
+}
+
 }  // namespace arith
 }  // namespace tvm
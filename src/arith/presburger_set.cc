@@ -33,6 +33,8 @@
 #include <tvm/tir/stmt_functor.h>
 
 #include <algorithm>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -260,6 +262,134 @@ IntSet EvalSet(const PrimExpr& e, const PresburgerSet& set) {
   return result;
 }
 
+/*!
+ * \brief The integer coefficients of an affine expression of the vars, ending with the constant
+ *  term, or std::nullopt when it is not affine with constant coefficients.
+ */
+static std::optional<std::vector<int64_t>> AffineCoefficients(const PrimExpr& e,
+                                                              const ffi::Array<Var>& vars) {
+  if (!e.dtype().is_int() && !e.dtype().is_uint()) return std::nullopt;
+  ffi::Array<PrimExpr> coeffs = DetectLinearEquation(e, vars);
+  if (coeffs.empty()) return std::nullopt;
+  std::vector<int64_t> int_coeffs;
+  int_coeffs.reserve(coeffs.size());
+  for (const PrimExpr& coeff : coeffs) {
+    const int64_t* value = as_const_int(coeff);
+    if (value == nullptr) return std::nullopt;
+    int_coeffs.push_back(*value);
+  }
+  return int_coeffs;
+}
+
+/*!
+ * \brief Make the set of the variables with constant ranges, constrained by the affine conjuncts
+ *  of the predicate, or std::nullopt when it is empty or has no variables.
+ */
+static ffi::Optional<PresburgerSet> MakeRegionSet(const ffi::Map<Var, Range>& var_dom,
+                                                  const PrimExpr& predicate) {
+  ffi::Array<Var> vars;
+  for (const auto& [var, range] : var_dom) {
+    if (as_const_int(range->min) && as_const_int(range->extent)) {
+      vars.push_back(var);
+    }
+  }
+  if (vars.empty()) return std::nullopt;
+  // Each inequality is `coeffs . (vars, 1) >= 0` and each equality is `coeffs . (vars, 1) == 0`.
+  std::vector<std::vector<int64_t>> inequalities;
+  std::vector<std::vector<int64_t>> equalities;
+  // Add `a + offset <= b`, which is dropped when it is not affine.
+  auto add_le = [&](const PrimExpr& a, const PrimExpr& b, int64_t offset) {
+    if (auto coeffs = AffineCoefficients(b - a, vars)) {
+      coeffs->back() -= offset;
+      inequalities.push_back(std::move(*coeffs));
+    }
+  };
+  for (const Var& var : vars) {
+    Range range = var_dom.at(var);
+    add_le(range->min, var, 0);
+    add_le(var, range->min + range->extent, 1);
+  }
+  for (const PrimExpr& constraint : ExtractConstraints(predicate, false)) {
+    if (const auto* op = constraint.as<LENode>()) {
+      add_le(op->a, op->b, 0);
+    } else if (const auto* op = constraint.as<LTNode>()) {
+      add_le(op->a, op->b, 1);
+    } else if (const auto* op = constraint.as<GENode>()) {
+      add_le(op->b, op->a, 0);
+    } else if (const auto* op = constraint.as<GTNode>()) {
+      add_le(op->b, op->a, 1);
+    } else if (const auto* op = constraint.as<EQNode>()) {
+      if (auto coeffs = AffineCoefficients(op->a - op->b, vars)) {
+        equalities.push_back(std::move(*coeffs));
+      }
+    }
+  }
+  auto space = PresburgerSpace::getRelationSpace(vars.size(), 0, 0, 0);
+  IntegerRelation relation(inequalities.size(), equalities.size(), vars.size() + 1, space);
+  for (const std::vector<int64_t>& coeffs : inequalities) {
+    relation.addInequality(coeffs);
+  }
+  for (const std::vector<int64_t>& coeffs : equalities) {
+    relation.addEquality(coeffs);
+  }
+  if (relation.isEmpty()) return std::nullopt;
+  return PresburgerSet({relation}, vars);
+}
+
+/*! \brief The results of EstimateRegionPresburgerBound, which is cleared when it is full. */
+struct RegionBoundCache {
+  static constexpr size_t kMaxSize = 4096;
+
+  static RegionBoundCache* Global() {
+    static RegionBoundCache* inst = new RegionBoundCache();
+    return inst;
+  }
+
+  std::mutex mutex;
+  std::unordered_map<ffi::Array<ObjectRef>, std::vector<ffi::Optional<IntSet>>,
+                     ffi::StructuralHash, ffi::StructuralEqual>
+      table;
+};
+
+std::vector<ffi::Optional<IntSet>> EstimateRegionPresburgerBound(
+    const ffi::Array<Range>& region, const ffi::Map<Var, Range>& var_dom,
+    const PrimExpr& predicate) {
+  RegionBoundCache* cache = RegionBoundCache::Global();
+  ffi::Array<ObjectRef> key{region, var_dom, predicate};
+  {
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    auto it = cache->table.find(key);
+    if (it != cache->table.end()) return it->second;
+  }
+  std::vector<ffi::Optional<IntSet>> result;
+  result.reserve(region.size());
+  ffi::Optional<PresburgerSet> set = MakeRegionSet(var_dom, predicate);
+  for (const Range& range : region) {
+    const int64_t* extent = as_const_int(range->extent);
+    if (!set.defined() || extent == nullptr ||
+        !AffineCoefficients(range->min, set.value()->GetVars())) {
+      result.push_back(std::nullopt);
+      continue;
+    }
+    IntSet bound = EvalSet(range->min, set.value());
+    const int64_t* min_value = as_const_int(bound.min());
+    const int64_t* max_value = as_const_int(bound.max());
+    if (min_value == nullptr || max_value == nullptr) {
+      result.push_back(std::nullopt);
+      continue;
+    }
+    DataType dtype = range->min.dtype();
+    result.push_back(IntSet::Interval(make_const(dtype, *min_value),
+                                      make_const(dtype, *max_value + *extent - 1)));
+  }
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  if (cache->table.size() >= RegionBoundCache::kMaxSize) {
+    cache->table.clear();
+  }
+  cache->table.emplace(key, result);
+  return result;
+}
+
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<PresburgerSetNode>([](const ObjectRef& node, ReprPrinter* p) {
       auto set = node.as<PresburgerSetNode>();
@@ -274,6 +404,12 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
 
 PresburgerSet MakePresburgerSet(const PrimExpr& constraint) { return PresburgerSet(constraint); }
 
+std::vector<ffi::Optional<IntSet>> EstimateRegionPresburgerBound(
+    const ffi::Array<Range>& region, const ffi::Map<Var, Range>& var_dom,
+    const PrimExpr& predicate) {
+  return std::vector<ffi::Optional<IntSet>>(region.size(), std::nullopt);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   PresburgerSetNode::RegisterReflection();
@@ -282,5 +418,23 @@ TVM_FFI_STATIC_INIT_BLOCK() {
 
 #endif  // defined(TVM_MLIR_VERSION) && TVM_MLIR_VERSION >= 150
 
+ffi::Array<IntSet> EstimateRegionUpperBound(const ffi::Array<Range>& region,
+                                            const ffi::Map<Var, Range>& var_dom,
+                                            const PrimExpr& predicate, Analyzer* analyzer,
+                                            ProofStrength strength) {
+  ffi::Array<IntSet> result = EstimateRegionUpperBound(region, var_dom, predicate, analyzer);
+  if (strength < ProofStrength::kPresburger) {
+    return result;
+  }
+  std::vector<ffi::Optional<IntSet>> bounds =
+      EstimateRegionPresburgerBound(region, var_dom, predicate);
+  for (size_t i = 0; i < bounds.size(); ++i) {
+    if (bounds[i].defined()) {
+      result.Set(i, Intersect(ffi::Array<IntSet>{result[i], bounds[i].value()}));
+    }
+  }
+  return result;
+}
+
 }  // namespace arith
 }  // namespace tvm
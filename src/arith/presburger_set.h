@@ -193,6 +193,24 @@ PresburgerSet Intersect(const ffi::Array<PresburgerSet>& sets);
  */
 IntSet EvalSet(const PrimExpr& e, const PresburgerSet& set);
 
+/*!
+ * \brief Bound each dimension of a region with Presburger sets, given the ranges of the
+ *  variables and a predicate on them.
+ *
+ * The set is built from the constant ranges of the variables and the affine conjuncts of the
+ * predicate; the other conjuncts are dropped, so the bounds always cover the region. The results
+ * are cached, as the same region is analyzed for each access of a buffer.
+ *
+ * \param region The region to be analyzed.
+ * \param var_dom The ranges of the variables.
+ * \param predicate The predicate on the variables.
+ * \return For each dimension, its bound, or std::nullopt when it is not affine with a constant
+ *  extent. All the bounds are std::nullopt when MLIR is not enabled.
+ */
+std::vector<ffi::Optional<IntSet>> EstimateRegionPresburgerBound(
+    const ffi::Array<Range>& region, const ffi::Map<Var, Range>& var_dom,
+    const PrimExpr& predicate);
+
 }  // namespace arith
 }  // namespace tvm
 
@@ -26,9 +26,24 @@
 #include <tvm/ir/instrument.h>
 #include <tvm/ir/transform.h>
 #include <tvm/node/repr_printer.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
 
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <stack>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../support/table_printer.h"
 
 namespace tvm {
 namespace instrument {
@@ -338,5 +353,240 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       });
 }
 
+/*! \brief PassMetrics stores the time, memory and IR size of a pass invocation. */
+struct PassMetrics {
+  using Clock = std::chrono::steady_clock;
+  using Duration = std::chrono::duration<double, std::milli>;
+
+  /*! \brief The IR size of a function before and after the pass, -1 if it is absent. */
+  struct FunctionSize {
+    ffi::String name;
+    int64_t before{-1};
+    int64_t after{-1};
+  };
+
+  /*! \brief The name of the pass. */
+  ffi::String name;
+  /*! \brief The time when the pass was entered. */
+  Clock::time_point start;
+  /*! \brief The duration of the pass, including its sub-passes. */
+  Duration duration{0};
+  /*! \brief The duration of the sub-passes. */
+  Duration children_duration{0};
+  /*! \brief The peak resident set size in KB when the pass was entered. */
+  int64_t start_peak_rss_kb{0};
+  /*! \brief How much the pass raised the peak resident set size, in KB. */
+  int64_t peak_rss_delta_kb{0};
+  /*! \brief The IR size of each function, in the order of the module. */
+  std::vector<FunctionSize> functions;
+};
+
+struct PassMetricsThreadLocalEntry {
+  /*! \brief The metrics of the passes that completed, in the order they were entered. */
+  std::vector<PassMetrics> completed;
+  /*! \brief The indices in `completed` of the passes currently running, innermost last. */
+  std::vector<size_t> running;
+  /*!
+   * \brief The number of nodes of the functions seen so far. The functions are kept alive, so
+   *  that the functions a pass leaves unchanged are counted once.
+   */
+  std::unordered_map<const Object*, std::pair<BaseFunc, int64_t>> node_counts;
+
+  /*! \brief The number of statement and expression nodes of a function. */
+  int64_t CountNodes(const BaseFunc& func) {
+    auto it = node_counts.find(func.get());
+    if (it != node_counts.end()) {
+      return it->second.second;
+    }
+    int64_t count = 0;
+    if (auto prim_func = func.as<tir::PrimFuncNode>()) {
+      tir::PostOrderVisit(prim_func->body, [&count](const ObjectRef&) { ++count; });
+    } else if (auto relax_func = func.as<relax::Function>()) {
+      relax::PostOrderVisit(relax_func.value(), [&count](const RelaxExpr&) { ++count; });
+    }
+    node_counts.emplace(func.get(), std::make_pair(func, count));
+    return count;
+  }
+
+  /*! \brief Excludes the time spent by the instrument since `since` from the running passes. */
+  void ExcludeFrom(PassMetrics::Clock::time_point since) {
+    PassMetrics::Clock::duration elapsed = PassMetrics::Clock::now() - since;
+    for (size_t index : running) {
+      completed[index].start += elapsed;
+    }
+  }
+};
+
+/*! \brief Thread local store to hold the pass metrics. */
+static PassMetricsThreadLocalEntry* PassMetricsThreadLocalStoreGet() {
+  static thread_local PassMetricsThreadLocalEntry inst;
+  return &inst;
+}
+
+/*! \brief The peak resident set size of the process in KB, 0 if it is not available. */
+static int64_t PeakResidentSetSizeKB() {
+#if defined(_WIN32)
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  // ru_maxrss is in bytes on macOS, and in KB elsewhere.
+  return static_cast<int64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<int64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+ffi::String RenderPassMetrics() {
+  PassMetricsThreadLocalEntry* entry = PassMetricsThreadLocalStoreGet();
+  TVM_FFI_ICHECK(entry->running.empty()) << "cannot print pass metrics while still in a pass!";
+
+  if (entry->completed.empty()) {
+    LOG(WARNING) << "no passes have been measured, did you enable the pass metrics instrument?";
+    return ffi::String();
+  }
+
+  // The passes that spend the most time by themselves, excluding sub-passes, come first.
+  std::vector<const PassMetrics*> passes;
+  for (const PassMetrics& metrics : entry->completed) {
+    passes.push_back(&metrics);
+  }
+  auto self_duration = [](const PassMetrics* metrics) {
+    return metrics->duration - metrics->children_duration;
+  };
+  std::stable_sort(passes.begin(), passes.end(),
+                   [&](const PassMetrics* a, const PassMetrics* b) {
+                     return self_duration(a) > self_duration(b);
+                   });
+
+  auto size_str = [](int64_t size) { return size < 0 ? std::string("-") : std::to_string(size); };
+  support::TablePrinter p;
+  p.Row() << "Pass"
+          << "Function"
+          << "Self (ms)"
+          << "Total (ms)"
+          << "Peak RSS +(MB)"
+          << "Nodes before"
+          << "Nodes after";
+  p.Separator();
+  for (const PassMetrics* metrics : passes) {
+    int64_t nodes_before = 0, nodes_after = 0;
+    for (const auto& func : metrics->functions) {
+      nodes_before += std::max<int64_t>(func.before, 0);
+      nodes_after += std::max<int64_t>(func.after, 0);
+    }
+    p.Row() << std::string(metrics->name) << "*" << self_duration(metrics).count()
+            << metrics->duration.count() << metrics->peak_rss_delta_kb / 1024.0 << nodes_before
+            << nodes_after;
+    // Only the functions whose size changed are listed, the largest changes first.
+    std::vector<const PassMetrics::FunctionSize*> changed;
+    for (const auto& func : metrics->functions) {
+      if (func.before != func.after) {
+        changed.push_back(&func);
+      }
+    }
+    std::stable_sort(changed.begin(), changed.end(), [](const auto* a, const auto* b) {
+      return std::abs(a->after - a->before) > std::abs(b->after - b->before);
+    });
+    for (const auto* func : changed) {
+      p.Row() << "" << std::string(func->name) << ""
+              << ""
+              << "" << size_str(func->before) << size_str(func->after);
+    }
+  }
+  return p.AsStr();
+}
+
+/*!
+ * \brief The metrics of each pass invocation, in the order the passes were entered, e.g. to
+ *  compare them against a baseline.
+ */
+ffi::Array<ffi::Map<ffi::String, ffi::Any>> GetPassMetrics() {
+  PassMetricsThreadLocalEntry* entry = PassMetricsThreadLocalStoreGet();
+  TVM_FFI_ICHECK(entry->running.empty()) << "cannot get pass metrics while still in a pass!";
+  ffi::Array<ffi::Map<ffi::String, ffi::Any>> result;
+  for (const PassMetrics& metrics : entry->completed) {
+    int64_t nodes_before = 0, nodes_after = 0;
+    for (const auto& func : metrics.functions) {
+      nodes_before += std::max<int64_t>(func.before, 0);
+      nodes_after += std::max<int64_t>(func.after, 0);
+    }
+    result.push_back({{"name", metrics.name},
+                      {"self_ms", (metrics.duration - metrics.children_duration).count()},
+                      {"total_ms", metrics.duration.count()},
+                      {"peak_rss_delta_kb", metrics.peak_rss_delta_kb},
+                      {"nodes_before", nodes_before},
+                      {"nodes_after", nodes_after}});
+  }
+  return result;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("instrument.GetPassMetrics", GetPassMetrics)
+      .def("instrument.RenderPassMetrics", RenderPassMetrics)
+      .def("instrument.MakePassMetricsInstrument", []() {
+        auto run_before_pass = [](const IRModule& mod, const transform::PassInfo& pass_info) {
+          PassMetrics::Clock::time_point begin = PassMetrics::Clock::now();
+          PassMetricsThreadLocalEntry* entry = PassMetricsThreadLocalStoreGet();
+          PassMetrics metrics;
+          metrics.name = pass_info->name;
+          for (const auto& [gvar, func] : mod->functions) {
+            metrics.functions.push_back({gvar->name_hint, entry->CountNodes(func), -1});
+          }
+          metrics.start_peak_rss_kb = PeakResidentSetSizeKB();
+          // The counting is neither attributed to the enclosing passes nor to this one.
+          entry->ExcludeFrom(begin);
+          metrics.start = PassMetrics::Clock::now();
+          entry->running.push_back(entry->completed.size());
+          entry->completed.push_back(std::move(metrics));
+          return true;
+        };
+
+        auto run_after_pass = [](const IRModule& mod, const transform::PassInfo& pass_info) {
+          PassMetrics::Clock::time_point end = PassMetrics::Clock::now();
+          PassMetricsThreadLocalEntry* entry = PassMetricsThreadLocalStoreGet();
+          TVM_FFI_ICHECK(!entry->running.empty()) << "mismatched enter/exit for pass metrics";
+          size_t index = entry->running.back();
+          entry->running.pop_back();
+          PassMetrics& metrics = entry->completed[index];
+          metrics.duration = std::chrono::duration_cast<PassMetrics::Duration>(end - metrics.start);
+          metrics.peak_rss_delta_kb = PeakResidentSetSizeKB() - metrics.start_peak_rss_kb;
+          if (!entry->running.empty()) {
+            entry->completed[entry->running.back()].children_duration += metrics.duration;
+          }
+          std::unordered_map<std::string, size_t> index_of;
+          for (size_t i = 0; i < metrics.functions.size(); ++i) {
+            index_of[metrics.functions[i].name] = i;
+          }
+          for (const auto& [gvar, func] : mod->functions) {
+            int64_t count = entry->CountNodes(func);
+            auto it = index_of.find(gvar->name_hint);
+            if (it != index_of.end()) {
+              metrics.functions[it->second].after = count;
+            } else {
+              metrics.functions.push_back({gvar->name_hint, -1, count});
+            }
+          }
+          entry->ExcludeFrom(end);
+        };
+
+        auto exit_pass_ctx = []() {
+          PassMetricsThreadLocalEntry* entry = PassMetricsThreadLocalStoreGet();
+          entry->completed.clear();
+          entry->node_counts.clear();
+        };
+
+        return BasePassInstrument("PassMetricsInstrument",
+                                  /* enter_pass_ctx */ nullptr, exit_pass_ctx,
+                                  /* should_run */ nullptr, run_before_pass, run_after_pass);
+      });
+}
+
 }  // namespace instrument
 }  // namespace tvm
@@ -24,7 +24,20 @@
 #include <tvm/ffi/extra/json.h>
 #include <tvm/ffi/extra/serialization.h>
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/replace_global_vars.h>
+#include <tvm/ir/serialization.h>
+#include <tvm/relax/expr_functor.h>
 #include <tvm/runtime/base.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace tvm {
 
@@ -40,8 +53,446 @@ Any LoadJSON(std::string json_str) {
   return ffi::FromJSONGraph(jgraph);
 }
 
+namespace {
+
+/*! \brief "TVMIRBIN" in little endian, the first bytes of the binary format. */
+constexpr uint64_t kModuleBinaryMagic = 0x4E49425249564D54;
+constexpr uint64_t kModuleBinaryVersion = 1;
+
+/*! \brief The tags of the JSON values in the binary format. */
+enum BinaryTag : uint8_t {
+  kNull = 0,
+  kFalse = 1,
+  kTrue = 2,
+  kInt = 3,
+  kFloat = 4,
+  kString = 5,
+  kArray = 6,
+  kObject = 7,
+};
+
+/*! \brief Appends varints, zigzag varints, doubles and length-prefixed bytes to a buffer. */
+class BinaryWriter {
+ public:
+  void WriteByte(uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      WriteByte(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    WriteByte(static_cast<uint8_t>(value));
+  }
+
+  void WriteInt(int64_t value) {
+    WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+
+  void WriteFixed64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      WriteByte(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  }
+
+  void WriteFloat(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteFixed64(bits);
+  }
+
+  void WriteBytes(const char* data, size_t size) {
+    WriteVarint(size);
+    buffer_.append(data, size);
+  }
+
+  std::string& buffer() { return buffer_; }
+
+ private:
+  std::string buffer_;
+};
+
+/*! \brief Reads what BinaryWriter writes, and fails on truncated or malformed data. */
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  uint8_t ReadByte() {
+    Require(1);
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = ReadByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    TVM_FFI_THROW(ValueError) << "Malformed IRModule binary: varint is too long";
+  }
+
+  int64_t ReadInt() {
+    uint64_t value = ReadVarint();
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+
+  uint64_t ReadFixed64() {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+      value |= static_cast<uint64_t>(ReadByte()) << (i * 8);
+    }
+    return value;
+  }
+
+  double ReadFloat() {
+    uint64_t bits = ReadFixed64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  /*! \brief Reads length-prefixed bytes, and returns their offset in the data. */
+  std::pair<size_t, size_t> ReadBytes() {
+    uint64_t size = ReadVarint();
+    Require(size);
+    size_t offset = pos_;
+    pos_ += size;
+    return {offset, size};
+  }
+
+  const char* data() const { return data_; }
+
+ private:
+  void Require(uint64_t size) const {
+    if (size > size_ - pos_) {
+      TVM_FFI_THROW(ValueError) << "Malformed IRModule binary: the data is truncated";
+    }
+  }
+
+  const char* data_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+/*!
+ * \brief Encodes the JSON graphs of the parts of a module, with a string table shared between
+ *  them so that the type keys and the field names are stored once.
+ */
+class JSONBinaryEncoder {
+ public:
+  std::string Encode(const ffi::json::Value& value) {
+    BinaryWriter writer;
+    Encode(value, &writer);
+    return std::move(writer.buffer());
+  }
+
+  uint64_t StringIndex(const ffi::String& str) {
+    auto [it, inserted] = string_index_.emplace(std::string(str), strings_.size());
+    if (inserted) {
+      strings_.push_back(&it->first);
+    }
+    return it->second;
+  }
+
+  void WriteStringTable(BinaryWriter* writer) const {
+    writer->WriteVarint(strings_.size());
+    for (const std::string* str : strings_) {
+      writer->WriteBytes(str->data(), str->size());
+    }
+  }
+
+ private:
+  void Encode(const ffi::json::Value& value, BinaryWriter* writer) {
+    switch (value.type_index()) {
+      case ffi::TypeIndex::kTVMFFINone: {
+        writer->WriteByte(kNull);
+        break;
+      }
+      case ffi::TypeIndex::kTVMFFIBool: {
+        writer->WriteByte(value.cast<bool>() ? kTrue : kFalse);
+        break;
+      }
+      case ffi::TypeIndex::kTVMFFIInt: {
+        writer->WriteByte(kInt);
+        writer->WriteInt(value.cast<int64_t>());
+        break;
+      }
+      case ffi::TypeIndex::kTVMFFIFloat: {
+        writer->WriteByte(kFloat);
+        writer->WriteFloat(value.cast<double>());
+        break;
+      }
+      case ffi::TypeIndex::kTVMFFISmallStr:
+      case ffi::TypeIndex::kTVMFFIStr: {
+        writer->WriteByte(kString);
+        writer->WriteVarint(StringIndex(value.cast<ffi::String>()));
+        break;
+      }
+      case ffi::TypeIndex::kTVMFFIArray: {
+        ffi::json::Array arr = value.cast<ffi::json::Array>();
+        writer->WriteByte(kArray);
+        writer->WriteVarint(arr.size());
+        for (const ffi::json::Value& elem : arr) {
+          Encode(elem, writer);
+        }
+        break;
+      }
+      case ffi::TypeIndex::kTVMFFIMap: {
+        ffi::json::Object obj = value.cast<ffi::json::Object>();
+        writer->WriteByte(kObject);
+        writer->WriteVarint(obj.size());
+        for (const auto& [key, elem] : obj) {
+          writer->WriteVarint(StringIndex(key.cast<ffi::String>()));
+          Encode(elem, writer);
+        }
+        break;
+      }
+      default: {
+        TVM_FFI_THROW(InternalError) << "Unexpected JSON value of type " << value.GetTypeKey();
+      }
+    }
+  }
+
+  std::unordered_map<std::string, uint64_t> string_index_;
+  std::vector<const std::string*> strings_;
+};
+
+/*! \brief Decodes the parts of a module, with the strings materialized on first use. */
+class JSONBinaryDecoder {
+ public:
+  explicit JSONBinaryDecoder(BinaryReader* reader) : reader_(reader) {
+    uint64_t num_strings = reader->ReadVarint();
+    for (uint64_t i = 0; i < num_strings; ++i) {
+      string_spans_.push_back(reader->ReadBytes());
+    }
+    strings_.resize(string_spans_.size());
+  }
+
+  ffi::json::Value Decode(std::pair<size_t, size_t> span) {
+    BinaryReader reader(reader_->data() + span.first, span.second);
+    return Decode(&reader);
+  }
+
+  const ffi::String& GetString(uint64_t index) {
+    if (index >= strings_.size()) {
+      TVM_FFI_THROW(ValueError) << "Malformed IRModule binary: string " << index
+                                << " is out of range";
+    }
+    if (!strings_[index].has_value()) {
+      auto [offset, size] = string_spans_[index];
+      strings_[index] = ffi::String(reader_->data() + offset, size);
+    }
+    return strings_[index].value();
+  }
+
+ private:
+  ffi::json::Value Decode(BinaryReader* reader) {
+    uint8_t tag = reader->ReadByte();
+    switch (tag) {
+      case kNull:
+        return nullptr;
+      case kFalse:
+        return false;
+      case kTrue:
+        return true;
+      case kInt:
+        return reader->ReadInt();
+      case kFloat:
+        return reader->ReadFloat();
+      case kString:
+        return GetString(reader->ReadVarint());
+      case kArray: {
+        uint64_t size = reader->ReadVarint();
+        ffi::json::Array arr;
+        arr.reserve(size);
+        for (uint64_t i = 0; i < size; ++i) {
+          arr.push_back(Decode(reader));
+        }
+        return arr;
+      }
+      case kObject: {
+        uint64_t size = reader->ReadVarint();
+        ffi::json::Object obj;
+        for (uint64_t i = 0; i < size; ++i) {
+          ffi::String key = GetString(reader->ReadVarint());
+          obj.Set(key, Decode(reader));
+        }
+        return obj;
+      }
+      default:
+        TVM_FFI_THROW(ValueError) << "Malformed IRModule binary: unknown tag " << int(tag);
+    }
+  }
+
+  BinaryReader* reader_;
+  std::vector<std::pair<size_t, size_t>> string_spans_;
+  std::vector<std::optional<ffi::String>> strings_;
+};
+
+/*!
+ * \brief The GlobalVars a function refers to. The function is serialized together with them, so
+ *  that they can be replaced by the GlobalVars of the module when it is loaded on its own.
+ */
+ffi::Array<GlobalVar> CollectGlobalVars(const BaseFunc& func) {
+  ffi::Array<GlobalVar> gvars;
+  std::unordered_set<const Object*> visited;
+  auto add = [&](const ObjectRef& node) {
+    if (auto gvar = node.as<GlobalVar>(); gvar && visited.insert(node.get()).second) {
+      gvars.push_back(gvar.value());
+    }
+  };
+  if (auto prim_func = func.as<tir::PrimFuncNode>()) {
+    tir::PostOrderVisit(prim_func->body, [&](const ObjectRef& node) {
+      if (auto call = node.as<tir::CallNode>()) {
+        add(call->op);
+      }
+    });
+  } else if (auto relax_func = func.as<relax::Function>()) {
+    relax::PostOrderVisit(relax_func.value(), [&](const RelaxExpr& expr) { add(expr); });
+  }
+  return gvars;
+}
+
+/*! \brief The index of the functions of a module binary, and the decoder of its parts. */
+class ModuleBinaryReader {
+ public:
+  ModuleBinaryReader(const char* data, size_t size)
+      : reader_(data, size), decoder_(ReadPreamble(&reader_)) {
+    header_ = reader_.ReadBytes();
+    uint64_t num_functions = reader_.ReadVarint();
+    for (uint64_t i = 0; i < num_functions; ++i) {
+      ffi::String name = decoder_.GetString(reader_.ReadVarint());
+      functions_.emplace_back(name, reader_.ReadBytes());
+    }
+  }
+
+  ffi::Array<ffi::String> FunctionNames() const {
+    ffi::Array<ffi::String> names;
+    for (const auto& [name, span] : functions_) {
+      names.push_back(name);
+    }
+    return names;
+  }
+
+  IRModule Load(const ffi::Optional<ffi::Array<ffi::String>>& function_names) {
+    ffi::Array<ffi::Any> header = FromJSONGraph(decoder_.Decode(header_)).cast<ffi::Array<Any>>();
+    IRModule header_mod = header[0].cast<IRModule>();
+    std::unordered_map<std::string, GlobalVar> module_gvars;
+    for (const GlobalVar& gvar : header[1].cast<ffi::Array<GlobalVar>>()) {
+      module_gvars.emplace(gvar->name_hint, gvar);
+    }
+
+    std::unordered_set<std::string> selected;
+    if (function_names.has_value()) {
+      for (const ffi::String& name : function_names.value()) {
+        if (!module_gvars.count(name)) {
+          TVM_FFI_THROW(ValueError) << "The IRModule binary has no function named " << name;
+        }
+        selected.insert(name);
+      }
+    }
+
+    const auto& replacer = transform::GlobalVarReplacer::vtable();
+    ffi::Map<GlobalVar, BaseFunc> functions;
+    for (const auto& [name, span] : functions_) {
+      if (function_names.has_value() && !selected.count(name)) {
+        continue;
+      }
+      ffi::Array<ffi::Any> parts = FromJSONGraph(decoder_.Decode(span)).cast<ffi::Array<Any>>();
+      BaseFunc func = parts[0].cast<BaseFunc>();
+      ffi::Map<GlobalVar, GlobalVar> replacements;
+      for (const GlobalVar& gvar : parts[1].cast<ffi::Array<GlobalVar>>()) {
+        if (auto it = module_gvars.find(gvar->name_hint); it != module_gvars.end()) {
+          replacements.Set(gvar, it->second);
+        }
+      }
+      if (!replacements.empty() && replacer.can_dispatch(func)) {
+        func = replacer(func, replacements);
+      }
+      functions.Set(module_gvars.at(name), func);
+    }
+    return IRModule(functions, header_mod->source_map, header_mod->attrs,
+                    header_mod->global_infos);
+  }
+
+ private:
+  static BinaryReader* ReadPreamble(BinaryReader* reader) {
+    if (reader->ReadFixed64() != kModuleBinaryMagic) {
+      TVM_FFI_THROW(ValueError) << "The data is not an IRModule binary";
+    }
+    uint64_t version = reader->ReadVarint();
+    if (version != kModuleBinaryVersion) {
+      TVM_FFI_THROW(ValueError) << "Unsupported IRModule binary version " << version
+                                << ", expected " << kModuleBinaryVersion;
+    }
+    return reader;
+  }
+
+  BinaryReader reader_;
+  JSONBinaryDecoder decoder_;
+  std::pair<size_t, size_t> header_;
+  std::vector<std::pair<ffi::String, std::pair<size_t, size_t>>> functions_;
+};
+
+}  // namespace
+
+std::string SaveModuleBinary(const IRModule& mod) {
+  ffi::json::Object metadata{{"tvm_version", TVM_VERSION}};
+  JSONBinaryEncoder encoder;
+
+  // The header holds everything but the functions, and the GlobalVars of the module.
+  ffi::Array<GlobalVar> gvars;
+  for (const auto& [gvar, func] : mod->functions) {
+    gvars.push_back(gvar);
+  }
+  IRModule header_mod({}, mod->source_map, mod->attrs, mod->global_infos);
+  std::string header =
+      encoder.Encode(ffi::ToJSONGraph(ffi::Array<Any>{header_mod, gvars}, metadata));
+
+  std::vector<std::pair<uint64_t, std::string>> functions;
+  for (const auto& [gvar, func] : mod->functions) {
+    ffi::Array<Any> parts{func, CollectGlobalVars(func)};
+    functions.emplace_back(encoder.StringIndex(gvar->name_hint),
+                           encoder.Encode(ffi::ToJSONGraph(parts, metadata)));
+  }
+
+  BinaryWriter writer;
+  writer.WriteFixed64(kModuleBinaryMagic);
+  writer.WriteVarint(kModuleBinaryVersion);
+  encoder.WriteStringTable(&writer);
+  writer.WriteBytes(header.data(), header.size());
+  writer.WriteVarint(functions.size());
+  for (const auto& [name_index, blob] : functions) {
+    writer.WriteVarint(name_index);
+    writer.WriteBytes(blob.data(), blob.size());
+  }
+  return std::move(writer.buffer());
+}
+
+IRModule LoadModuleBinary(const std::string& data,
+                          ffi::Optional<ffi::Array<ffi::String>> function_names) {
+  return ModuleBinaryReader(data.data(), data.size()).Load(function_names);
+}
+
+ffi::Array<ffi::String> ModuleBinaryFunctionNames(const std::string& data) {
+  return ModuleBinaryReader(data.data(), data.size()).FunctionNames();
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("node.SaveJSON", SaveJSON).def("node.LoadJSON", LoadJSON);
+  refl::GlobalDef()
+      .def("node.SaveJSON", SaveJSON)
+      .def("node.LoadJSON", LoadJSON)
+      .def("node.SaveModuleBinary",
+           [](const IRModule& mod) { return ffi::Bytes(SaveModuleBinary(mod)); })
+      .def("node.LoadModuleBinary",
+           [](const ffi::Bytes& data, ffi::Optional<ffi::Array<ffi::String>> function_names) {
+             return ModuleBinaryReader(data.data(), data.size()).Load(function_names);
+           })
+      .def("node.ModuleBinaryFunctionNames", [](const ffi::Bytes& data) {
+        return ModuleBinaryReader(data.data(), data.size()).FunctionNames();
+      });
 }
 }  // namespace tvm
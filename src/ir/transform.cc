@@ -29,8 +29,14 @@
 #include <tvm/node/repr_printer.h>
 #include <tvm/relax/expr.h>
 #include <tvm/runtime/device_api.h>
+#include <tvm/support/parallel_for.h>
+#include <tvm/target/target.h>
 
+#include <algorithm>
+#include <exception>
 #include <stack>
+#include <thread>
+#include <vector>
 
 namespace tvm {
 namespace transform {
@@ -39,6 +45,7 @@ using tvm::ReprPrinter;
 using tvm::ffi::Any;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("testing.immutable_module", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("transform.num_function_pass_threads", Integer);
 
 struct PassContextThreadLocalEntry {
   /*! \brief The default pass context. */
@@ -374,15 +381,64 @@ class ModulePass : public Pass {
 };
 
 PassInfo::PassInfo(int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-                   bool traceable) {
+                   bool traceable, bool thread_safe) {
   auto pass_info = ffi::make_object<PassInfoNode>();
   pass_info->opt_level = opt_level;
   pass_info->name = std::move(name);
   pass_info->required = std::move(required);
   pass_info->traceable = std::move(traceable);
+  pass_info->thread_safe = thread_safe;
   data_ = std::move(pass_info);
 }
 
+void ParallelForFunctions(const PassInfo& pass_info, const PassContext& pass_ctx,
+                          int num_functions, const std::function<void(int)>& f) {
+  int num_threads = 1;
+  if (pass_info->thread_safe && num_functions > 1) {
+    int num_hardware_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    num_threads = pass_ctx->GetConfig<Integer>("transform.num_function_pass_threads")
+                      .value_or(Integer(num_hardware_threads))
+                      ->value;
+    num_threads = std::min(num_threads, num_functions);
+  }
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_functions; ++i) {
+      f(i);
+    }
+    return;
+  }
+  // The scopes are thread-local, so each worker enters the ones of the calling thread. The pass
+  // context is pushed without running the instruments, which only run once per pass.
+  Target target = Target::Current(/*allow_not_defined=*/true);
+  std::thread::id caller = std::this_thread::get_id();
+  std::vector<std::exception_ptr> errors(num_functions);
+  support::parallel_for_dynamic(0, num_functions, num_threads, [&](int thread_id, int i) {
+    bool is_worker = std::this_thread::get_id() != caller;
+    PassContextThreadLocalEntry* entry = PassContextThreadLocalStoreGet();
+    if (is_worker) {
+      entry->context_stack.push(pass_ctx);
+    }
+    try {
+      if (is_worker && target.defined()) {
+        With<Target> target_scope(target);
+        f(i);
+      } else {
+        f(i);
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+    if (is_worker) {
+      entry->context_stack.pop();
+    }
+  });
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 ModulePass::ModulePass(std::function<IRModule(IRModule, PassContext)> pass_func,
                        PassInfo pass_info) {
   auto n = ffi::make_object<ModulePassNode>();
@@ -498,7 +554,9 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef()
       .def("transform.PassInfo",
            [](int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-              bool traceable) { return PassInfo(opt_level, name, required, traceable); })
+              bool traceable, bool thread_safe) {
+             return PassInfo(opt_level, name, required, traceable, thread_safe);
+           })
       .def_packed("transform.Info", [](ffi::PackedArgs args, ffi::Any* ret) {
         Pass pass = args[0].cast<Pass>();
         *ret = pass->Info();
@@ -285,6 +285,43 @@ size_t GraphPartitioner::CountFusedArgs(const IndexedForwardGraph& graph,
   return args_num;
 }
 
+void GraphPartitioner::CollectRootsUptoSink_(IndexedForwardGraph::Node* src,
+                                             IndexedForwardGraph::Node* sink,
+                                             std::unordered_set<Group*>* roots) {
+  if (src == sink || visited_.count(src)) return;
+  visited_.insert(src);
+  roots->insert(groups_[src->index]->FindRoot());
+  for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+    CollectRootsUptoSink_(link->value.node, sink, roots);
+  }
+}
+
+bool GraphPartitioner::CanMergeUptoSink(IndexedForwardGraph::Node* src,
+                                        IndexedForwardGraph::Node* sink) {
+  Group* target = groups_[sink->index]->FindRoot();
+  std::unordered_set<Group*> roots;
+  visited_.clear();
+  CollectRootsUptoSink_(src, sink, &roots);
+  roots.erase(target);
+  int num_anchors = target->anchor_ref != nullptr;
+  for (Group* root : roots) {
+    if (root->anchor_ref != nullptr) {
+      ++num_anchors;
+      if (target->pattern > kBroadcast) return false;
+    }
+  }
+  return num_anchors <= 1;
+}
+
+std::optional<bool> GraphPartitioner::GetFusionDecision(IndexedForwardGraph::Node* node,
+                                                        IndexedForwardGraph::Node* sink) {
+  auto it = fusion_decisions_.find(node);
+  if (it == fusion_decisions_.end()) {
+    it = fusion_decisions_.emplace(node, fusion_policy_(node, sink)).first;
+  }
+  return it->second;
+}
+
 void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
   auto args_counter = [](const tvm::Object* obj) {
     size_t args_num = 0;
@@ -365,6 +402,13 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
       }
     }
 
+    // The fusion policy, if any, may refuse the fusion in every phase
+    std::optional<bool> decision;
+    if (fusion_policy_ != nullptr) {
+      decision = GetFusionDecision(graph_node, dom_node->parent->gnode);
+      if (decision.has_value() && !decision.value()) continue;
+    }
+
     if (phase == 2) {
       // Fuse injective ops into intermediate tuples, if any
       if (group_node->pattern > kInjective) continue;
@@ -391,6 +435,19 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
     }
     // Do not fuse into tuple for now
     if (groups_[dom_parent_gindex]->pattern == kTuple) continue;
+    // The fusions the policy accepts are committed in the first phase, regardless of the
+    // patterns, as long as no opaque node is on the path.
+    if (decision.has_value()) {
+      if (phase != 0) continue;
+      auto fcond = [](OpPatternKind kind, bool is_sink) {
+        return is_sink ? kind != kOpaque : kind <= kInjective;
+      };
+      if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+          CanMergeUptoSink(graph_node, dom_node->parent->gnode)) {
+        CommitFuse(graph_node, dom_node->parent->gnode);
+      }
+      continue;
+    }
     // Try to fuse current node to its post-dominator.
     if (group_node->pattern == kOutEWiseFusable) {
       if (phase != 0) continue;
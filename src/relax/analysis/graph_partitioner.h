@@ -28,6 +28,8 @@
 #include <tvm/relax/op_attr_types.h>
 #include <tvm/relax/type.h>
 
+#include <functional>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -163,12 +165,21 @@ class DominatorTree {
  */
 class GraphPartitioner {
  public:
+  /*!
+   * \brief The policy consulted before fusing a node into its immediate post-dominator.
+   * It returns true to fuse, false to refuse, or std::nullopt to leave the decision to the
+   * pattern rules.
+   */
+  using FusionPolicy = std::function<std::optional<bool>(const IndexedForwardGraph::Node* node,
+                                                         const IndexedForwardGraph::Node* sink)>;
+
   explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
-                            size_t max_function_args)
+                            size_t max_function_args, FusionPolicy fusion_policy = nullptr)
       : arena_(arena),
         opt_level_(opt_level),
         max_fuse_depth_(max_fuse_depth),
-        max_function_args_(max_function_args) {}
+        max_function_args_(max_function_args),
+        fusion_policy_(std::move(fusion_policy)) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -216,6 +227,10 @@ class GraphPartitioner {
   size_t max_fuse_depth_;
   /*! \brief The maximum number of arguments in one fused function */
   size_t max_function_args_;
+  /*! \brief The optional policy overriding the pattern rules. */
+  FusionPolicy fusion_policy_;
+  /*! \brief The decisions of the fusion policy, as each node has a single post-dominator. */
+  std::unordered_map<const IndexedForwardGraph::Node*, std::optional<bool>> fusion_decisions_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -293,6 +308,17 @@ class GraphPartitioner {
   // limit will be exceeded.
   size_t CountFusedArgs(const IndexedForwardGraph& graph, IndexedForwardGraph::Node* child);
 
+  // Collect the roots of the groups between src and sink, sink excluded.
+  void CollectRootsUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink,
+                             std::unordered_set<Group*>* roots);
+  // Check whether the groups between src and sink can be merged into the group of sink, as
+  // MergeFromTo supports at most one anchor in a group, which either already is the root of
+  // the group or is merged into a group of broadcast ops.
+  bool CanMergeUptoSink(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
+  // Get the decision of the fusion policy for fusing node into its post-dominator sink.
+  std::optional<bool> GetFusionDecision(IndexedForwardGraph::Node* node,
+                                        IndexedForwardGraph::Node* sink);
+
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph);
 
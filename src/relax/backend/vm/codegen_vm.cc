@@ -113,6 +113,7 @@ class CodeGenVM : public ExprFunctor<Instruction::Arg(const Expr&)> {
       for (Binding binding : block->bindings) {
         Expr expr = GetBoundValue(binding);
 
+        Index instr_begin = builder_->exec()->instr_offset.size();
         Instruction::Arg value = VisitExpr(expr);
         if (expr.as<VarNode>()) {
           // For a normalized relax module, there should be one
@@ -124,6 +125,7 @@ class CodeGenVM : public ExprFunctor<Instruction::Arg(const Expr&)> {
           builder_->EmitCall("vm.builtin.copy", {value}, new_reg);
           value = Instruction::Arg::Register(new_reg);
         }
+        builder_->AnnotateInstrs(instr_begin, binding->var->name_hint());
 
         this->var_arg_map_.insert({binding->var, value});
       }
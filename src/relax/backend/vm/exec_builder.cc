@@ -51,6 +51,20 @@ void ExecBuilderNode::SaveMemoryScope(vm::Instruction::Arg idx, ffi::String scop
   exec_->memory_scopes[idx.value()] = scope;
 }
 
+void ExecBuilderNode::AnnotateInstrs(vm::Index begin, const std::string& name) {
+  std::vector<std::string>& names = exec_->instr_debug_names;
+  names.resize(exec_->instr_offset.size());
+  for (size_t i = begin; i < names.size(); ++i) {
+    if (names[i].empty()) {
+      names[i] = name;
+    }
+  }
+}
+
+void ExecBuilderNode::SetKernelCost(const std::string& func_name, double flops, double nbytes) {
+  exec_->kernel_costs[func_name] = {flops, nbytes};
+}
+
 vm::Instruction::Arg ExecBuilderNode::ConvertConstant_(Any cvalue) {
   // emit constant immediate as immediate.
   if (auto opt_int = cvalue.as<int64_t>()) {
@@ -343,6 +357,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
              builder->EmitFunction(func, num_inputs, param_names);
            })
       .def_method("relax.ExecBuilderEndFunction", &ExecBuilderNode::EndFunction)
+      .def_method("relax.ExecBuilderSetKernelCost", &ExecBuilderNode::SetKernelCost)
       .def("relax.ExecBuilderDeclareFunction",
            [](ExecBuilder builder, ffi::String name, int32_t kind) {
              builder->DeclareFunction(name, static_cast<VMFuncInfo::FuncKind>(kind));
@@ -203,8 +203,8 @@ class VMShapeLowerMutator
       public StructInfoFunctor<void(const StructInfo&, Expr, bool, bool, const ffi::String&,
                                     std::vector<MatchShapeTodoItem>*)> {
  public:
-  static IRModule Lower(IRModule mod, bool emit_err_ctx) {
-    VMShapeLowerMutator mutator(mod, emit_err_ctx);
+  static IRModule Lower(IRModule mod, bool emit_err_ctx, bool emit_checks) {
+    VMShapeLowerMutator mutator(mod, emit_err_ctx, emit_checks);
 
     for (auto& kv : mod->functions) {
       if (auto* func = kv.second.as<FunctionNode>()) {
@@ -216,8 +216,8 @@ class VMShapeLowerMutator
   }
 
  private:
-  explicit VMShapeLowerMutator(IRModule mod, bool emit_err_ctx)
-      : ExprMutator(mod), emit_err_ctx_(emit_err_ctx) {}
+  explicit VMShapeLowerMutator(IRModule mod, bool emit_err_ctx, bool emit_checks)
+      : ExprMutator(mod), emit_err_ctx_(emit_err_ctx), emit_checks_(emit_checks) {}
 
   using ExprMutator::VisitExpr_;
 
@@ -502,6 +502,7 @@ class VMShapeLowerMutator
     for (const MatchShapeTodoItem& item : match_todos) {
       bool all_nop = true;
       bool any_nop = false;
+      bool any_store = false;
 
       ffi::Array<Expr> args = {item.input, shape_heap_};
 
@@ -518,6 +519,12 @@ class VMShapeLowerMutator
         auto [code, rvalue] = MakeMatchArgs(expr, require_value_computed);
         all_nop = all_nop && code == MatchShapeCode::kNoOp;
         any_nop = any_nop || code == MatchShapeCode::kNoOp;
+        any_store = any_store || code == MatchShapeCode::kStoreToHeap;
+        if (!emit_checks_ && (code == MatchShapeCode::kAssertEqualToImm ||
+                              code == MatchShapeCode::kAssertEqualToLoad)) {
+          code = MatchShapeCode::kNoOp;
+          rvalue = PrimValue::Int64(0);
+        }
         args.push_back(PrimValue::Int64(static_cast<int>(code)));
         args.push_back(rvalue);
       }
@@ -525,7 +532,8 @@ class VMShapeLowerMutator
         outstanding_todos.push_back(item);
       }
       args.push_back(GetErrContext(item.err_ctx));
-      if (!all_nop) {
+      // Without checks, a match is only needed to populate the heap.
+      if (emit_checks_ ? !all_nop : any_store) {
         Call call(match_op, args, Attrs(), {void_sinfo_});
         builder_->Emit(call, "_");
       }
@@ -648,7 +656,8 @@ class VMShapeLowerMutator
                         bool dynamic_only, const ffi::String& err_ctx,
                         std::vector<MatchShapeTodoItem>* match_todos) final {
     // emit runtime check of shape
-    if (always_check || !IsBaseOf(PrimStructInfo(op->dtype), GetStructInfo(value))) {
+    if (emit_checks_ &&
+        (always_check || !IsBaseOf(PrimStructInfo(op->dtype), GetStructInfo(value)))) {
       // check_shape_info(value, ndim, err_ctx)
       Call call(builtin_check_prim_value_info_,
                 {value, DataTypeImm(op->dtype), GetErrContext(err_ctx)}, Attrs(), {void_sinfo_});
@@ -667,7 +676,8 @@ class VMShapeLowerMutator
                         bool dynamic_only, const ffi::String& err_ctx,
                         std::vector<MatchShapeTodoItem>* match_todos) final {
     // emit runtime check of shape
-    if (always_check || !IsBaseOf(ShapeStructInfo(op->ndim), GetStructInfo(value))) {
+    if (emit_checks_ &&
+        (always_check || !IsBaseOf(ShapeStructInfo(op->ndim), GetStructInfo(value)))) {
       // check_shape_info(value, ndim, err_ctx)
       Call call(builtin_check_shape_info_,
                 {value, PrimValue::Int64(op->ndim), GetErrContext(err_ctx)}, Attrs(),
@@ -694,7 +704,8 @@ class VMShapeLowerMutator
       // if we only check dynamic shapes, and the shape is static, we can skip.
       return;
     }
-    if (always_check || !IsBaseOf(TensorStructInfo(op->dtype, op->ndim), GetStructInfo(value))) {
+    if (emit_checks_ && (always_check || !IsBaseOf(TensorStructInfo(op->dtype, op->ndim),
+                                                   GetStructInfo(value)))) {
       // check_tensor_info(value, ndim, dtype, err_ctx)
       Call call(builtin_check_tensor_info_,
                 {value, PrimValue::Int64(op->ndim), DataTypeImm(op->dtype), GetErrContext(err_ctx)},
@@ -743,7 +754,7 @@ class VMShapeLowerMutator
       TVM_FFI_CHECK_EQ(value_tinfo->fields.size(), op->fields.size(), TypeError)
           << err_ctx << " during match-cast we find tuple size mismatch";
     }
-    if (always_check || !value_tinfo) {
+    if (emit_checks_ && (always_check || !value_tinfo)) {
       // check_tuple_info(value, tuple_size)
       Call call(builtin_check_tuple_info_,
                 {value, PrimValue::Int64(static_cast<int64_t>(op->fields.size())),
@@ -762,7 +773,7 @@ class VMShapeLowerMutator
                         bool dynamic_only, const ffi::String& err_ctx,
                         std::vector<MatchShapeTodoItem>* match_todos) final {
     // we only check function is callable.
-    if (!always_check && MatchStructInfo<FuncStructInfo>(value)) return;
+    if (!emit_checks_ || (!always_check && MatchStructInfo<FuncStructInfo>(value))) return;
     // check_func_info(value, err_ctx)
     Call call(builtin_check_func_info_, {value, GetErrContext(err_ctx)}, Attrs(), {void_sinfo_});
     builder_->Emit(call, "_");
@@ -773,6 +784,12 @@ class VMShapeLowerMutator
   //-------------------------------------------------------
   /*! \brief whether to emit error context, can be turned off for testing purposes. */
   bool emit_err_ctx_{true};
+  /*!
+   * \brief Whether to emit the runtime checks of the struct info, can be turned off for trusted
+   *  deployments whose inputs are known to match. The shapes are still matched to populate the
+   *  symbolic variables.
+   */
+  bool emit_checks_{true};
   /*! \brief heap ptr to store the PrimExpr slots. */
   Var shape_heap_;
   /*! \brief heap size. */
@@ -809,9 +826,13 @@ class VMShapeLowerMutator
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.VMShapeLower.skip_checks", Bool);
+
 Pass VMShapeLower(bool emit_err_ctx) {
   auto pass_func = [=](IRModule mod, PassContext pc) {
-    return VMShapeLowerMutator::Lower(mod, emit_err_ctx);
+    bool skip_checks =
+        pc->GetConfig<Bool>("relax.VMShapeLower.skip_checks").value_or(Bool(false))->value;
+    return VMShapeLowerMutator::Lower(mod, emit_err_ctx, !skip_checks);
   };
   return CreateModulePass(pass_func, 0, "VMShapeLower", {});
 }
@@ -76,7 +76,7 @@ class RedistributeLegalizer : public ExprMutator {
       // dimension
       TVM_FFI_ICHECK(ffi::StructuralEqual()(input_sinfo->device_mesh, attrs->device_mesh));
       TVM_FFI_ICHECK(input_sinfo->device_mesh->shape.size() == 1);
-      // only support "S[x]"-> "R" and "R" -> "S[x]"
+      // only support "S[x]"-> "R", "R" -> "S[x]" and "S[1]" <-> "S[0]"
       PlacementSpec input_spec = input_sinfo->placement->dim_specs[0];
       PlacementSpec output_spec = attrs->placement->dim_specs[0];
       if (input_spec->kind == PlacementSpecKind::kReplica &&
@@ -86,11 +86,19 @@ class RedistributeLegalizer : public ExprMutator {
       } else if (input_spec->kind == PlacementSpecKind::kSharding &&
                  output_spec->kind == PlacementSpecKind::kSharding) {
         // "S[x]" -> "S[y]"
-        if (input_spec->axis != output_spec->axis) {
-          TVM_FFI_THROW(InternalError) << "AlltoAll not implemented yet";
-        } else {
+        if (input_spec->axis == output_spec->axis) {
           return call->args[0];
         }
+        // The all-to-alls exchanging the tokens of the experts of expert parallelism
+        int num_workers = attrs->device_mesh->shape[0];
+        if (input_spec->axis == 1 && output_spec->axis == 0) {
+          return moe_dispatch(call->args[0], num_workers, /*in_group=*/false);
+        } else if (input_spec->axis == 0 && output_spec->axis == 1) {
+          return moe_combine(call->args[0], num_workers, /*in_group=*/false);
+        } else {
+          TVM_FFI_THROW(InternalError) << "AlltoAll between the sharding axes " << input_spec->axis
+                                       << " and " << output_spec->axis << " not implemented yet";
+        }
       } else if (input_spec->kind == PlacementSpecKind::kSharding &&
                  output_spec->kind == PlacementSpecKind::kReplica) {
         // "S[x]" -> "R"
@@ -31,6 +31,7 @@
 #include <tvm/relax/distributed/transform.h>
 #include <tvm/relax/expr_functor.h>
 
+#include <algorithm>
 #include <numeric>
 
 #include "../../op/distributed/distributed.h"
@@ -338,18 +339,365 @@ class ShardingConflictHandler : public ExprVisitor {
   AxisGroupGraph* axis_group_graph_;
 };
 
+/*!
+ * \brief Search the sharding of a function without sharding annotation, and add it to the axis
+ *  group graph as source sharding points.
+ *
+ * A plan shards each axis group, a connected component of the axis group graph, along one
+ * dimension of the device mesh or along none. Its cost estimates the time of the function on a
+ * device, in flops: the work of each call divided among the devices that its sharded axes split it
+ * over, plus a ring allreduce of its output for each mesh dimension that shards an input of the
+ * call but not its output (a sharded reduction, as in a row parallel matmul). Its memory is the
+ * local size of the parameters and of the largest intermediate tensor.
+ *
+ * From the replicated plan, the search shards one axis group at a time, the one whose sharding
+ * most decreases the memory over the budget and then the cost, until no sharding decreases them.
+ */
+class AutoShardingPlanner : public ExprVisitor {
+ public:
+  static void Plan(AxisGroupGraph* axis_group_graph, const Function& func, DeviceMesh device_mesh,
+                   int64_t memory_budget) {
+    AutoShardingPlanner planner(axis_group_graph, device_mesh, memory_budget);
+    planner.CollectTensors(func);
+    planner.Search();
+    planner.AddShardingPoints();
+  }
+
+ private:
+  /*! \brief The flops a device computes in the time it sends one byte to another. */
+  static constexpr double kFlopsPerCommByte = 1000.0;
+
+  struct TensorInfo {
+    /*! \brief The axis -1 of the tensor, which identifies it. */
+    Axis axis;
+    /*! \brief The extent of each axis, -1 if it is symbolic. */
+    std::vector<int64_t> extents;
+    /*! \brief The number of elements, where a symbolic extent counts as 1. */
+    double numel = 1;
+    double bytes = 0;
+    /*! \brief The axis group of each axis, -1 if the axis is in none. */
+    std::vector<int> groups;
+    bool is_param = false;
+  };
+
+  struct CallInfo {
+    std::vector<int> inputs;
+    std::vector<int> outputs;
+    double work = 0;
+  };
+
+  struct GroupInfo {
+    int component;
+    std::vector<int> tensors;
+    int64_t extent_gcd = 0;
+    bool shardable = true;
+  };
+
+  /*! \brief The memory over the budget and the cost of a plan, compared in this order. */
+  using Score = std::pair<double, double>;
+
+  AutoShardingPlanner(AxisGroupGraph* axis_group_graph, DeviceMesh device_mesh,
+                      int64_t memory_budget)
+      : axis_group_graph_(axis_group_graph),
+        device_mesh_(device_mesh),
+        memory_budget_(memory_budget) {
+    for (const auto& extent : device_mesh->shape) {
+      mesh_shape_.push_back(extent);
+    }
+  }
+
+  void CollectTensors(const Function& func) {
+    components_ = axis_group_graph_->GetAxisGroups();
+    for (int i = 0; i < static_cast<int>(components_.size()); i++) {
+      for (const Axis& axis : components_[i]) {
+        component_of_.emplace(axis, i);
+      }
+    }
+    for (const Var& param : func->params) {
+      for (int tensor : AddTensors(param.get())) {
+        tensors_[tensor].is_param = true;
+      }
+    }
+    VisitExpr(func->body);
+    // The groups collect their tensors last, as a group may have axes of tensors met nowhere else.
+    for (int g = 0; g < static_cast<int>(groups_.size()); g++) {
+      std::unordered_set<int> tensors;
+      for (const Axis& axis : components_[groups_[g].component]) {
+        if (axis.dim < 0 || axis.tensor->IsInstance<ConstantNode>()) {
+          groups_[g].shardable = false;
+          continue;
+        }
+        int tensor = GetTensor(axis.tensor, axis.tuple_index);
+        if (tensor < 0 || axis.dim >= static_cast<int>(tensors_[tensor].extents.size()) ||
+            !tensors.insert(tensor).second) {
+          // Two axes of a tensor cannot be sharded along the same mesh dimension.
+          groups_[g].shardable = false;
+          continue;
+        }
+        groups_[g].tensors.push_back(tensor);
+        int64_t extent = tensors_[tensor].extents[axis.dim];
+        if (extent < 0) {
+          groups_[g].shardable = false;
+        } else {
+          groups_[g].extent_gcd = std::gcd(groups_[g].extent_gcd, extent);
+        }
+      }
+    }
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const CallNode* val) final {
+    static const Op& matmul_op = Op::Get("relax.matmul");
+    CallInfo info;
+    for (const Expr& arg : GetCallArgs(ffi::GetRef<Call>(val))) {
+      if ((arg->IsInstance<VarNode>() || arg->IsInstance<ConstantNode>()) &&
+          GetStructInfoAs<TensorStructInfoNode>(arg)) {
+        info.inputs.push_back(GetTensor(arg.get(), 0));
+      }
+    }
+    info.outputs = AddTensors(binding->var.get());
+    for (int tensor : info.inputs) {
+      info.work = std::max(info.work, tensors_[tensor].numel);
+    }
+    for (int tensor : info.outputs) {
+      info.work = std::max(info.work, tensors_[tensor].numel);
+    }
+    if (val->op.same_as(matmul_op) && info.inputs.size() == 2 && info.outputs.size() == 1) {
+      const std::vector<int64_t>& x1_extents = tensors_[info.inputs[0]].extents;
+      int64_t reduction_length = x1_extents.empty() ? 1 : x1_extents.back();
+      info.work = tensors_[info.outputs[0]].numel * std::max<int64_t>(reduction_length, 1);
+    }
+    calls_.push_back(std::move(info));
+    ExprVisitor::VisitBinding_(binding, val);
+  }
+
+  void VisitBinding_(const VarBindingNode* binding) final {
+    if (!binding->value->IsInstance<CallNode>()) {
+      AddTensors(binding->var.get());
+    }
+    ExprVisitor::VisitBinding_(binding);
+  }
+
+  std::vector<int> AddTensors(const VarNode* var) {
+    std::vector<int> tensors;
+    if (var->struct_info_.as<TensorStructInfoNode>()) {
+      tensors.push_back(GetTensor(var, 0));
+    } else if (const auto* tuple_sinfo = var->struct_info_.as<TupleStructInfoNode>()) {
+      for (int i = 0; i < static_cast<int>(tuple_sinfo->fields.size()); i++) {
+        if (tuple_sinfo->fields[i].as<TensorStructInfoNode>()) {
+          tensors.push_back(GetTensor(var, i));
+        }
+      }
+    }
+    return tensors;
+  }
+
+  /*! \brief Get the id of a tensor, or of a field of a tuple, -1 if it is not a tensor. */
+  int GetTensor(const ExprNode* expr, int tuple_index) {
+    Axis key(expr, -1, tuple_index);
+    auto it = tensor_ids_.find(key);
+    if (it != tensor_ids_.end()) {
+      return it->second;
+    }
+    const TensorStructInfoNode* sinfo = nullptr;
+    if (const auto* tuple_sinfo = expr->struct_info_.as<TupleStructInfoNode>()) {
+      if (tuple_index < static_cast<int>(tuple_sinfo->fields.size())) {
+        sinfo = tuple_sinfo->fields[tuple_index].as<TensorStructInfoNode>();
+      }
+    } else {
+      sinfo = expr->struct_info_.as<TensorStructInfoNode>();
+    }
+    const auto* shape = sinfo ? sinfo->shape.as<ShapeExprNode>() : nullptr;
+    if (shape == nullptr) {
+      tensor_ids_.emplace(key, -1);
+      return -1;
+    }
+    TensorInfo info{key};
+    for (int i = 0; i < static_cast<int>(shape->values.size()); i++) {
+      const auto* extent = shape->values[i].as<IntImmNode>();
+      info.extents.push_back(extent ? extent->value : -1);
+      info.numel *= extent ? static_cast<double>(extent->value) : 1.0;
+      auto component = component_of_.find(Axis(expr, i, tuple_index));
+      if (component == component_of_.end()) {
+        info.groups.push_back(-1);
+        continue;
+      }
+      auto group = group_of_component_.find(component->second);
+      if (group == group_of_component_.end()) {
+        group = group_of_component_.emplace(component->second, groups_.size()).first;
+        groups_.push_back({component->second});
+      }
+      info.groups.push_back(group->second);
+    }
+    info.bytes = info.numel * ((sinfo->dtype.bits() * sinfo->dtype.lanes() + 7) / 8);
+    int id = tensors_.size();
+    tensors_.push_back(std::move(info));
+    tensor_ids_.emplace(key, id);
+    return id;
+  }
+
+  /*! \brief The mesh dimensions that shard an axis of a tensor, as a bit mask. */
+  uint64_t ShardedDims(int tensor) const {
+    uint64_t dims = 0;
+    for (int group : tensors_[tensor].groups) {
+      if (group >= 0 && plan_[group] >= 0) {
+        dims |= uint64_t(1) << plan_[group];
+      }
+    }
+    return dims;
+  }
+
+  double Split(uint64_t dims) const {
+    double split = 1;
+    for (int d = 0; d < static_cast<int>(mesh_shape_.size()); d++) {
+      if (dims >> d & 1) {
+        split *= mesh_shape_[d];
+      }
+    }
+    return split;
+  }
+
+  Score Evaluate() const {
+    double param_bytes = 0;
+    double max_intermediate_bytes = 0;
+    for (int i = 0; i < static_cast<int>(tensors_.size()); i++) {
+      double bytes = tensors_[i].bytes / Split(ShardedDims(i));
+      if (tensors_[i].is_param) {
+        param_bytes += bytes;
+      } else {
+        max_intermediate_bytes = std::max(max_intermediate_bytes, bytes);
+      }
+    }
+    double cost = 0;
+    for (const CallInfo& call : calls_) {
+      uint64_t input_dims = 0;
+      uint64_t output_dims = 0;
+      double output_bytes = 0;
+      for (int tensor : call.inputs) {
+        input_dims |= ShardedDims(tensor);
+      }
+      for (int tensor : call.outputs) {
+        uint64_t dims = ShardedDims(tensor);
+        output_dims |= dims;
+        output_bytes += tensors_[tensor].bytes / Split(dims);
+      }
+      cost += call.work / Split(input_dims | output_dims);
+      for (int d = 0; d < static_cast<int>(mesh_shape_.size()); d++) {
+        if ((input_dims >> d & 1) && !(output_dims >> d & 1)) {
+          double num_devices = mesh_shape_[d];
+          cost += kFlopsPerCommByte * 2 * (num_devices - 1) / num_devices * output_bytes;
+        }
+      }
+    }
+    double memory = param_bytes + max_intermediate_bytes;
+    double excess = memory_budget_ > 0 ? std::max(0.0, memory - memory_budget_) : 0.0;
+    return {excess, cost};
+  }
+
+  bool CanShard(int group, int dim) const {
+    const GroupInfo& info = groups_[group];
+    if (!info.shardable || mesh_shape_[dim] <= 1 || info.extent_gcd % mesh_shape_[dim] != 0) {
+      return false;
+    }
+    for (int tensor : info.tensors) {
+      for (int other : tensors_[tensor].groups) {
+        if (other >= 0 && other != group && plan_[other] == dim) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void Search() {
+    plan_.assign(groups_.size(), -1);
+    Score score = Evaluate();
+    while (true) {
+      Score best_score = score;
+      int best_group = -1;
+      int best_dim = -1;
+      for (int g = 0; g < static_cast<int>(groups_.size()); g++) {
+        if (plan_[g] >= 0) {
+          continue;
+        }
+        for (int d = 0; d < static_cast<int>(mesh_shape_.size()); d++) {
+          if (!CanShard(g, d)) {
+            continue;
+          }
+          plan_[g] = d;
+          Score new_score = Evaluate();
+          plan_[g] = -1;
+          if (new_score < best_score) {
+            best_score = new_score;
+            best_group = g;
+            best_dim = d;
+          }
+        }
+      }
+      if (best_group < 0) {
+        break;
+      }
+      plan_[best_group] = best_dim;
+      score = best_score;
+    }
+    if (score.first > 0) {
+      LOG(WARNING) << "The automatic sharding plan found exceeds the memory budget of "
+                   << memory_budget_ << " bytes per device by " << score.first << " bytes";
+    }
+  }
+
+  void AddShardingPoints() {
+    for (int g = 0; g < static_cast<int>(groups_.size()); g++) {
+      if (plan_[g] >= 0) {
+        axis_group_graph_->AddSrcShardingPoint(components_[groups_[g].component].front(),
+                                               {device_mesh_, plan_[g]});
+      }
+    }
+    // Every tensor is placed on the device mesh. One source point suffices in each component.
+    std::unordered_set<int> placed_components;
+    for (const TensorInfo& tensor : tensors_) {
+      auto it = component_of_.find(tensor.axis);
+      if (it == component_of_.end() || placed_components.insert(it->second).second) {
+        axis_group_graph_->AddSrcShardingPoint(tensor.axis, {device_mesh_, -1});
+      }
+    }
+  }
+
+  AxisGroupGraph* axis_group_graph_;
+  DeviceMesh device_mesh_;
+  int64_t memory_budget_;
+  std::vector<int64_t> mesh_shape_;
+  std::vector<std::vector<Axis>> components_;
+  std::unordered_map<Axis, int, AxisHash> component_of_;
+  std::unordered_map<int, int> group_of_component_;
+  std::unordered_map<Axis, int, AxisHash> tensor_ids_;
+  std::vector<TensorInfo> tensors_;
+  std::vector<CallInfo> calls_;
+  std::vector<GroupInfo> groups_;
+  /*! \brief The mesh dimension that shards each axis group, -1 if none does. */
+  std::vector<int> plan_;
+};
+
 /*!
  * \brief Build distributed IR from given sharding annotation
  */
 class DistributedIRBuilder : public ExprMutator {
  public:
-  explicit DistributedIRBuilder(const IRModule& module) : ExprMutator(module) {}
+  explicit DistributedIRBuilder(const IRModule& module,
+                                ffi::Optional<DeviceMesh> auto_sharding_mesh = std::nullopt,
+                                int64_t memory_budget = 0)
+      : ExprMutator(module),
+        auto_sharding_mesh_(auto_sharding_mesh),
+        memory_budget_(memory_budget) {}
 
   IRModule BuildDistributedIR() {
     auto mod = builder_->GetContextIRModule();
     for (const auto& [gv, base_func] : mod->functions) {
       const auto* func_ = base_func.as<FunctionNode>();
-      if (func_ == nullptr || !IsShardingAnnotatedFunc(ffi::GetRef<Function>(func_))) {
+      if (func_ == nullptr) {
+        continue;
+      }
+      if (!IsShardingAnnotatedFunc(ffi::GetRef<Function>(func_)) &&
+          !(auto_sharding_mesh_.defined() && !IsDistIRFunc(ffi::GetRef<Function>(func_)))) {
         continue;
       }
       Function func = RewriteFunction(ffi::GetRef<Function>(func_), mod);
@@ -416,8 +764,13 @@ class DistributedIRBuilder : public ExprMutator {
   Function RewriteFunction(Function func, IRModule mod) {
     // Step 1. Construct AxisGroupGraph
     AxisGroupGraphBuilder::BuildAxisGroupGraph(&axis_group_graph_, func, mod);
-    // Step 2. Collect Sharding Annotation
-    ShardingAnnotationCollector::CollectShardingAnnotation(&axis_group_graph_, func);
+    // Step 2. Collect Sharding Annotation, or search the sharding of an unannotated function
+    if (IsShardingAnnotatedFunc(func)) {
+      ShardingAnnotationCollector::CollectShardingAnnotation(&axis_group_graph_, func);
+    } else {
+      AutoShardingPlanner::Plan(&axis_group_graph_, func, auto_sharding_mesh_.value(),
+                                memory_budget_);
+    }
     // Step 3. Handle Sharding Conflict
     ShardingConflictHandler::HandleShardingConflict(&axis_group_graph_, func);
     // Step 4. Rewrite Function
@@ -610,12 +963,14 @@ class DistributedIRBuilder : public ExprMutator {
   std::unordered_map<TupleGetItem, Var, ffi::StructuralHash, ffi::StructuralEqual>
       tuple_getitem_remap_;
   AxisGroupGraph axis_group_graph_;
+  ffi::Optional<DeviceMesh> auto_sharding_mesh_;
+  int64_t memory_budget_;
 };
 namespace transform {
 
-Pass PropagateSharding() {
+Pass PropagateSharding(ffi::Optional<DeviceMesh> auto_sharding_mesh, int64_t memory_budget) {
   auto pass_func = [=](IRModule m, PassContext pc) {
-    return DistributedIRBuilder(m).BuildDistributedIR();
+    return DistributedIRBuilder(m, auto_sharding_mesh, memory_budget).BuildDistributedIR();
   };
   return CreateModulePass(pass_func, 1, "PropagateSharding", {});
 }
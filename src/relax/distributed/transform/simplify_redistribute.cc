@@ -0,0 +1,279 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/relax/distributed/transform/simplify_redistribute.cc
+ * \brief Pass for merging and simplifying the redistributions of DistIR, so that fewer bytes go
+ *  through the collectives.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/attrs/ccl.h>
+#include <tvm/relax/attrs/distributed.h>
+#include <tvm/relax/distributed/transform.h>
+#include <tvm/relax/expr_functor.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../op/ccl/ccl.h"
+#include "../../op/distributed/distributed.h"
+#include "utils.h"
+
+namespace tvm {
+namespace relax {
+namespace distributed {
+
+/*!
+ * \brief Merge the chains of redistribute: redistributing a redistributed tensor is redistributing
+ *  its source, and a redistribute to the placement its input already has is the input.
+ */
+class RedistributeChainMerger : public ExprMutator {
+ public:
+  static Function Merge(const Function& func) {
+    return Downcast<Function>(RedistributeChainMerger().VisitExpr(func));
+  }
+
+ private:
+  using ExprMutator::VisitExpr_;
+
+  void VisitBinding_(const VarBindingNode* binding, const CallNode* val) final {
+    static const Op& redistribute_op = Op::Get("relax.dist.redistribute");
+    Call call = Downcast<Call>(VisitExpr(ffi::GetRef<Call>(val)));
+    if (!call->op.same_as(redistribute_op)) {
+      ReEmitBinding(binding, builder_->Normalize(call));
+      return;
+    }
+    const auto* attrs = call->attrs.as<DistributionAttrs>();
+    TVM_FFI_ICHECK(attrs);
+    Expr input = call->args[0];
+    if (const auto* var = input.as<VarNode>()) {
+      auto it = redistribute_source_.find(var);
+      if (it != redistribute_source_.end()) {
+        input = it->second;
+      }
+    }
+    const auto* input_sinfo = GetStructInfoAs<DTensorStructInfoNode>(input);
+    TVM_FFI_ICHECK(input_sinfo);
+    bool same_mesh = ffi::StructuralEqual()(input_sinfo->device_mesh, attrs->device_mesh);
+    if (same_mesh && ffi::StructuralEqual()(input_sinfo->placement, attrs->placement) &&
+        input->IsInstance<VarNode>()) {
+      var_remap_[binding->var->vid] = Downcast<Var>(input);
+      return;
+    }
+    if (!same_mesh) {
+      input = call->args[0];
+    }
+    ReEmitBinding(binding, builder_->Normalize(redistribute(input, attrs->device_mesh,
+                                                            attrs->placement)));
+    // The source recorded is never a redistribute: a chain of any length merges in one walk.
+    auto it = var_remap_.find(binding->var->vid);
+    const VarNode* new_var = it != var_remap_.end() ? it->second.get() : binding->var.get();
+    redistribute_source_[new_var] = input;
+  }
+
+  /*! \brief The tensor each redistribute emitted redistributes. */
+  std::unordered_map<const VarNode*, Expr> redistribute_source_;
+};
+
+/*!
+ * \brief Move the redistributes that gather a tensor after the elementwise op which is their only
+ *  use, so that the op computes on the shards. The gather then often meets the redistribute back
+ *  to the sharded placement and cancels with it.
+ */
+class GatherSinker : public ExprMutator {
+ public:
+  static Function Sink(const Function& func, bool* changed) {
+    GatherSinker sinker(func);
+    Function new_func = Downcast<Function>(sinker.VisitExpr(func));
+    *changed = sinker.changed_;
+    return new_func;
+  }
+
+ private:
+  explicit GatherSinker(const Function& func) : usage_(CollectVarUsage(func)) {}
+
+  using ExprMutator::VisitExpr_;
+
+  static bool IsElementwise(const Op& op) {
+    static const std::vector<std::string> elementwise_op_names = {
+        "abs", "acos", "acosh", "asin", "asinh", "atan", "atanh", "ceil", "cos", "cosh",
+        "erf", "exp", "floor", "log", "negative", "round", "rsqrt", "sigmoid", "sign", "sin",
+        "sinh", "square", "sqrt", "tan", "tanh", "nn.relu", "nn.gelu", "nn.gelu_tanh",
+        "nn.silu"};
+    for (const auto& op_name : elementwise_op_names) {
+      if (op.same_as(Op::Get("relax." + op_name))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*! \brief Whether a redistribute changes a sharded mesh dimension of its input. */
+  static bool IsGather(const Call& redistribute_call) {
+    const auto* attrs = redistribute_call->attrs.as<DistributionAttrs>();
+    const auto* input_sinfo = GetStructInfoAs<DTensorStructInfoNode>(redistribute_call->args[0]);
+    if (!input_sinfo || !ffi::StructuralEqual()(input_sinfo->device_mesh, attrs->device_mesh)) {
+      return false;
+    }
+    for (int i = 0; i < static_cast<int>(attrs->placement->dim_specs.size()); i++) {
+      const PlacementSpec& input_spec = input_sinfo->placement->dim_specs[i];
+      const PlacementSpec& output_spec = attrs->placement->dim_specs[i];
+      if (input_spec->kind == PlacementSpecKind::kSharding &&
+          (output_spec->kind != PlacementSpecKind::kSharding ||
+           output_spec->axis != input_spec->axis)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool HasSingleUse(const Var& var) const {
+    auto it = usage_.downstream_usage.find(var);
+    if (it == usage_.downstream_usage.end() || (*it).second.size() != 1) {
+      return false;
+    }
+    for (const Var& output : usage_.outputs) {
+      if (output.same_as(var)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const CallNode* val) final {
+    static const Op& redistribute_op = Op::Get("relax.dist.redistribute");
+    const auto* op = val->op.as<OpNode>();
+    if (op && IsElementwise(ffi::GetRef<Op>(op)) && val->args.size() == 1 &&
+        val->args[0]->IsInstance<VarNode>()) {
+      Var input = Downcast<Var>(val->args[0]);
+      ffi::Optional<Expr> input_value = usage_.bound_values.Get(input);
+      const auto* input_call = input_value ? input_value.value().as<CallNode>() : nullptr;
+      if (input_call && input_call->op.same_as(redistribute_op) && HasSingleUse(input) &&
+          IsGather(ffi::GetRef<Call>(input_call))) {
+        const auto* attrs = input_call->attrs.as<DistributionAttrs>();
+        Var local = builder_->Emit(
+            Call(val->op, {VisitExpr(input_call->args[0])}, val->attrs, val->sinfo_args));
+        ReEmitBinding(binding, builder_->Normalize(
+                                   redistribute(local, attrs->device_mesh, attrs->placement)));
+        changed_ = true;
+        return;
+      }
+    }
+    ExprMutator::VisitBinding_(binding, val);
+  }
+
+  VarUsageInfo usage_;
+  bool changed_ = false;
+};
+
+/*!
+ * \brief Fuse an allreduce and the slice of its result that each worker keeps into a
+ *  reduce-scatter, which sends half of the bytes.
+ */
+class ReduceScatterFuser : public ExprMutator {
+ public:
+  static Function Fuse(const Function& func) {
+    return Downcast<Function>(ReduceScatterFuser(func).VisitExpr(func));
+  }
+
+ private:
+  explicit ReduceScatterFuser(const Function& func) : usage_(CollectVarUsage(func)) {}
+
+  using ExprMutator::VisitExpr_;
+
+  /*! \brief The number of workers when the call scatters its input along axis 0, 0 otherwise. */
+  static int GetScatterAxis0Workers(const CallNode* call) {
+    static const Op& redistribute_op = Op::Get("relax.dist.redistribute");
+    static const Op& replica_to_shard_op = Op::Get("relax.dist.redistribute_replica_to_shard");
+    if (call->op.same_as(replica_to_shard_op)) {
+      const auto* attrs = call->attrs.as<ScatterCollectiveAttrs>();
+      return attrs->axis == 0 ? attrs->num_workers : 0;
+    }
+    if (call->op.same_as(redistribute_op)) {
+      const auto* attrs = call->attrs.as<DistributionAttrs>();
+      const auto* input_sinfo = GetStructInfoAs<DTensorStructInfoNode>(call->args[0]);
+      if (!input_sinfo || attrs->device_mesh->shape.size() != 1 ||
+          !ffi::StructuralEqual()(input_sinfo->device_mesh, attrs->device_mesh)) {
+        return 0;
+      }
+      const PlacementSpec& input_spec = input_sinfo->placement->dim_specs[0];
+      const PlacementSpec& output_spec = attrs->placement->dim_specs[0];
+      if (input_spec->kind == PlacementSpecKind::kReplica &&
+          output_spec->kind == PlacementSpecKind::kSharding && output_spec->axis == 0) {
+        return attrs->device_mesh->shape[0];
+      }
+    }
+    return 0;
+  }
+
+  void VisitBinding_(const VarBindingNode* binding, const CallNode* val) final {
+    static const Op& allreduce_op = Op::Get("relax.ccl.allreduce");
+    int num_workers = GetScatterAxis0Workers(val);
+    if (num_workers > 0 && val->args[0]->IsInstance<VarNode>()) {
+      Var input = Downcast<Var>(val->args[0]);
+      ffi::Optional<Expr> input_value = usage_.bound_values.Get(input);
+      const auto* input_call = input_value ? input_value.value().as<CallNode>() : nullptr;
+      auto it = usage_.downstream_usage.find(input);
+      bool single_use = it != usage_.downstream_usage.end() && (*it).second.size() == 1;
+      for (const Var& output : usage_.outputs) {
+        single_use = single_use && !output.same_as(input);
+      }
+      if (input_call && input_call->op.same_as(allreduce_op) && single_use) {
+        const auto* attrs = input_call->attrs.as<AllReduceAttrs>();
+        ReEmitBinding(binding,
+                      builder_->Normalize(reduce_scatter(VisitExpr(input_call->args[0]),
+                                                         attrs->op_type, num_workers,
+                                                         attrs->in_group)));
+        return;
+      }
+    }
+    ExprMutator::VisitBinding_(binding, val);
+  }
+
+  VarUsageInfo usage_;
+};
+
+namespace transform {
+
+Pass SimplifyRedistribute() {
+  auto pass_func = [=](Function func, IRModule m, PassContext pc) {
+    if (!IsDistIRFunc(func)) {
+      return func;
+    }
+    bool changed = true;
+    while (changed) {
+      func = Downcast<Function>(RemoveAllUnused(RedistributeChainMerger::Merge(func)));
+      func = Downcast<Function>(RemoveAllUnused(GatherSinker::Sink(func, &changed)));
+    }
+    return Downcast<Function>(RemoveAllUnused(ReduceScatterFuser::Fuse(func)));
+  };
+  return relax::transform::CreateFunctionPass(pass_func, 1, "SimplifyRedistribute", {});
+}
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.distributed.transform.SimplifyRedistribute", SimplifyRedistribute);
+}
+}  // namespace transform
+
+}  // namespace distributed
+}  // namespace relax
+}  // namespace tvm
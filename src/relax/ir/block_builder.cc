@@ -541,6 +541,11 @@ class Normalizer : public BlockBuilderImpl, private ExprFunctor<Expr(const Expr&
              "normalization must not be nullptr. However, this Expr does not have struct_info_: "
           << normalized;
     }
+    if (normalized->IsInstance<CallNode>() || normalized->IsInstance<TupleNode>() ||
+        normalized->IsInstance<TupleGetItemNode>() || normalized->IsInstance<SeqExprNode>() ||
+        normalized->IsInstance<IfNode>() || normalized->IsInstance<FunctionNode>()) {
+      normalized_.insert(normalized);
+    }
 
     return normalized;
   }
@@ -562,7 +567,7 @@ class Normalizer : public BlockBuilderImpl, private ExprFunctor<Expr(const Expr&
       }
     }
     // skip visit expr's cache, normalize arg
-    Expr post = ExprFunctor::VisitExpr(arg);
+    Expr post = normalized_.count(arg) ? arg : ExprFunctor::VisitExpr(arg);
 
     if (!IsLeafOrTuple(arg)) {
       TVM_FFI_ICHECK(!block_stack_.empty()) << "Cannot normalize non-leaf without a scope";
@@ -614,6 +619,9 @@ class Normalizer : public BlockBuilderImpl, private ExprFunctor<Expr(const Expr&
         return it->second;
       }
     }
+    if (normalized_.count(expr)) {
+      return expr;
+    }
     return ExprFunctor::VisitExpr(expr);
   }
 
@@ -1037,6 +1045,18 @@ class Normalizer : public BlockBuilderImpl, private ExprFunctor<Expr(const Expr&
 
   /*! \brief Whether the FNormalize function should be applied */
   bool apply_f_normalize_{true};
+
+  /*!
+   * \brief The non-leaf expressions returned by Normalize, which are normalized again as they
+   *  are, without visiting their sub-expressions.
+   *
+   * ExprMutator normalizes each expression after it visits it, so without this an unchanged
+   * sub-graph is walked again by the normalization of each of its enclosing expressions. The
+   * references keep the expressions alive, and prevent copy-on-write from mutating them in
+   * place, so an expression of the set is unchanged since it was normalized. The bindings it
+   * contains were recorded in the binding table when it was first normalized.
+   */
+  std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual> normalized_;
 };
 
 BlockBuilder BlockBuilder::Create(ffi::Optional<IRModule> mod) {
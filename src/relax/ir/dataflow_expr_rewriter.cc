@@ -34,6 +34,7 @@
 #include <tvm/tir/op.h>
 
 #include <algorithm>
+#include <vector>
 
 #include "../transform/utils.h"
 #include "dataflow_matcher.h"
@@ -218,9 +219,12 @@ TVM_FFI_STATIC_INIT_BLOCK() {
 RewriteSpec ExprPatternRewriterNode::RewriteBindings(const ffi::Array<Binding>& bindings) const {
   ffi::Map<Var, Expr> variable_rewrites;
   ffi::Map<Var, Expr> binding_lookup;
+  PatternRootIndex root_index(pattern);
   for (const auto& binding : bindings) {
     auto bound_value = GetBoundValue(binding);
-    if (auto new_expr = RewriteExpr(bound_value, binding_lookup)) {
+    if (!root_index.MayMatch(bound_value, binding_lookup)) {
+      binding_lookup.Set(binding->var, bound_value);
+    } else if (auto new_expr = RewriteExpr(bound_value, binding_lookup)) {
       variable_rewrites.Set(binding->var, new_expr.value());
     } else {
       binding_lookup.Set(binding->var, bound_value);
@@ -469,6 +473,23 @@ ffi::Map<Var, Expr> TupleRewriterNode::GenerateVariableRewrites(
     return true;
   };
 
+  // Only run the matcher for the patterns whose root ops the expression calls.
+  std::vector<PatternRootIndex> root_indices;
+  for (const DFPattern& pat : patterns) {
+    root_indices.emplace_back(pat);
+  }
+  auto match_patterns = [&](const Expr& expr) {
+    ffi::Array<ffi::Optional<ffi::Map<DFPattern, Expr>>> matches;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      if (root_indices[i].MayMatch(expr, binding_lookup)) {
+        matches.push_back(ExtractMatchedExpr(patterns[i], expr, binding_lookup));
+      } else {
+        matches.push_back(std::nullopt);
+      }
+    }
+    return matches;
+  };
+
   for (size_t i_binding = 0; i_binding < bindings.size(); i_binding++) {
     const auto& binding = bindings[i_binding];
 
@@ -479,8 +500,7 @@ ffi::Map<Var, Expr> TupleRewriterNode::GenerateVariableRewrites(
     info_vec.push_back(VarInfo{
         binding->var,
         expr,
-        patterns.Map(
-            [&](const DFPattern& pat) { return ExtractMatchedExpr(pat, expr, binding_lookup); }),
+        match_patterns(expr),
         std::unordered_set<Var>(),
         false,
     });
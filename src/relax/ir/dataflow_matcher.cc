@@ -137,6 +137,83 @@ Expr DFPatternMatcher::UnwrapBindings(Expr expr, const ffi::Map<Var, Expr>& var2
   return expr;
 }
 
+namespace {
+
+using RootOps = std::optional<std::unordered_set<const Object*>>;
+
+RootOps Union(RootOps lhs, const RootOps& rhs) {
+  if (!lhs || !rhs) {
+    return std::nullopt;
+  }
+  lhs->insert(rhs->begin(), rhs->end());
+  return lhs;
+}
+
+/*! \brief The ops matched by the op pattern of a CallPattern. */
+RootOps OpsOfOpPattern(const DFPattern& pattern) {
+  if (auto* expr_pattern = pattern.as<ExprPatternNode>()) {
+    if (expr_pattern->expr->IsInstance<OpNode>()) {
+      return std::unordered_set<const Object*>{expr_pattern->expr.get()};
+    }
+  } else if (auto* or_pattern = pattern.as<OrPatternNode>()) {
+    return Union(OpsOfOpPattern(or_pattern->left), OpsOfOpPattern(or_pattern->right));
+  }
+  return std::nullopt;
+}
+
+/*! \brief The ops called by the root of the expressions the pattern matches. */
+RootOps OpsOfRoot(const DFPattern& pattern) {
+  if (auto* call = pattern.as<CallPatternNode>()) {
+    RootOps ops = OpsOfOpPattern(call->op);
+    if (ops) {
+      // The matcher reassociates multiply and divide, so either one may be at the root.
+      static const Op& multiply = Op::Get("relax.multiply");
+      static const Op& divide = Op::Get("relax.divide");
+      if (ops->count(multiply.get()) || ops->count(divide.get())) {
+        ops->insert({multiply.get(), divide.get()});
+      }
+    }
+    return ops;
+  } else if (auto* or_pattern = pattern.as<OrPatternNode>()) {
+    return Union(OpsOfRoot(or_pattern->left), OpsOfRoot(or_pattern->right));
+  } else if (auto* and_pattern = pattern.as<AndPatternNode>()) {
+    RootOps lhs = OpsOfRoot(and_pattern->left);
+    RootOps rhs = OpsOfRoot(and_pattern->right);
+    if (lhs && rhs) {
+      std::unordered_set<const Object*> both;
+      for (const Object* op : *lhs) {
+        if (rhs->count(op)) {
+          both.insert(op);
+        }
+      }
+      return both;
+    }
+    return lhs ? lhs : rhs;
+  } else if (auto* attr = pattern.as<AttrPatternNode>()) {
+    return OpsOfRoot(attr->pattern);
+  } else if (auto* dtype = pattern.as<DataTypePatternNode>()) {
+    return OpsOfRoot(dtype->pattern);
+  } else if (auto* shape = pattern.as<ShapePatternNode>()) {
+    return OpsOfRoot(shape->pattern);
+  } else if (auto* sinfo = pattern.as<StructInfoPatternNode>()) {
+    return OpsOfRoot(sinfo->pattern);
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+PatternRootIndex::PatternRootIndex(const DFPattern& pattern) : root_ops_(OpsOfRoot(pattern)) {}
+
+bool PatternRootIndex::MayMatch(const Expr& expr, const ffi::Map<Var, Expr>& bindings) const {
+  if (!root_ops_) {
+    return true;
+  }
+  Expr root = DFPatternMatcher::UnwrapBindings(expr, bindings);
+  auto* call = root.as<CallNode>();
+  return call && root_ops_->count(call->op.get());
+}
+
 void DFPatternMatcher::ClearMap(size_t watermark) {
   for (size_t i = watermark; i < matched_nodes_.size(); ++i) {
     memo_.erase(matched_nodes_[i]);
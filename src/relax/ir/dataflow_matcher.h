@@ -29,7 +29,9 @@
 #include <tvm/relax/dataflow_pattern.h>
 #include <tvm/relax/dataflow_pattern_functor.h>
 
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -98,6 +100,30 @@ class DFPatternMatcher : public DFPatternFunctor<bool(const DFPattern&, const Ex
   bool memoize_ = true;
 };
 
+/*!
+ * \brief A discrimination index on the op that the root of a pattern calls.
+ *
+ * Matching a pattern costs much more than comparing the op of a call, so the passes that try
+ * patterns at every binding of a graph first check with the index whether the pattern can
+ * match there at all, and only run the matcher on the bindings that call one of its root ops.
+ */
+class PatternRootIndex {
+ public:
+  explicit PatternRootIndex(const DFPattern& pattern);
+
+  /*!
+   * \brief Whether a match of the pattern can be rooted at the expression.
+   * \param expr The expression to match.
+   * \param bindings The bindings the matcher looks through.
+   * \return False if the pattern cannot match the expression, true if it may.
+   */
+  bool MayMatch(const Expr& expr, const ffi::Map<Var, Expr>& bindings = {}) const;
+
+ private:
+  /*! \brief The ops a matched root calls, or std::nullopt if the pattern accepts any root. */
+  std::optional<std::unordered_set<const Object*>> root_ops_;
+};
+
 }  // namespace relax
 }  // namespace tvm
 
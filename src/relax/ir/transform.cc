@@ -30,6 +30,9 @@
 #include <tvm/relax/struct_info_functor.h>
 #include <tvm/relax/transform.h>
 
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace relax {
 namespace transform {
@@ -135,11 +138,14 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   for (const auto& it : updated_mod->functions) {
     // only picks up relax::Function
     if (auto* n = it.second.as<FunctionNode>()) {
-      Function func = ffi::GetRef<Function>(n);
-      auto updated_func = pass_func(func, updated_mod, pass_ctx);
-      updates.push_back({it.first, updated_func});
+      updates.push_back({it.first, ffi::GetRef<Function>(n)});
     }
   }
+  // Runs across the functions in parallel when the pass is thread-safe, the updates keep the
+  // order of the module either way.
+  ParallelForFunctions(pass_info, pass_ctx, updates.size(), [&](int i) {
+    updates[i].second = pass_func(updates[i].second, updated_mod, pass_ctx);
+  });
 
   for (const auto& pair : updates) {
     updated_mod->Add(pair.first, pair.second, true);
@@ -158,8 +164,8 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreateFunctionPass(std::function<Function(Function, IRModule, PassContext)> pass_func,
                         int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-                        bool traceable) {
-  PassInfo pass_info = PassInfo(opt_level, name, required, traceable);
+                        bool traceable, bool thread_safe) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, traceable, thread_safe);
   return FunctionPass(std::move(pass_func), pass_info);
 }
 
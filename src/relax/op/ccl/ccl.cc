@@ -31,6 +31,9 @@ namespace relax {
 TVM_FFI_STATIC_INIT_BLOCK() {
   AllReduceAttrs::RegisterReflection();
   AllGatherAttrs::RegisterReflection();
+  ReduceScatterAttrs::RegisterReflection();
+  AllToAllAttrs::RegisterReflection();
+  RingSendRecvAttrs::RegisterReflection();
   ScatterCollectiveAttrs::RegisterReflection();
 }
 
@@ -100,6 +103,240 @@ TVM_REGISTER_OP("relax.ccl.allgather")
     .set_attr<FRelaxInferLayout>("FRelaxInferLayout", InferLayoutUnaryEwise)
     .set_attr<Bool>("FPurity", Bool(true));
 
+/* relax.ccl.reduce_scatter */
+
+Expr reduce_scatter(Expr x, ffi::String op_type, int num_workers, bool in_group) {
+  ObjectPtr<ReduceScatterAttrs> attrs = ffi::make_object<ReduceScatterAttrs>();
+  attrs->op_type = std::move(op_type);
+  attrs->num_workers = std::move(num_workers);
+  attrs->in_group = std::move(in_group);
+
+  static const Op& op = Op::Get("relax.ccl.reduce_scatter");
+  return Call(op, {std::move(x)}, Attrs{attrs}, {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.op.ccl.reduce_scatter", reduce_scatter);
+}
+
+StructInfo InferStructInfoReduceScatter(const Call& call, const BlockBuilder& ctx) {
+  TensorStructInfo input_sinfo = GetUnaryInputTensorStructInfo(call, ctx);
+
+  const auto* attrs = call->attrs.as<ReduceScatterAttrs>();
+  int num_workers = attrs->num_workers;
+
+  auto input_shape = input_sinfo->GetShape();
+  if (!input_shape.defined()) {
+    return input_sinfo;
+  }
+  if (input_shape.value().empty()) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "reduce_scatter expects the input tensor to have at least one dimension.");
+  }
+  arith::Analyzer* analyzer = ctx->GetAnalyzer();
+  if (analyzer->CanProve(floormod(input_shape.value()[0], PrimExpr(num_workers)) != 0)) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "reduce_scatter expects the size of axis 0 of input tensor to be "
+                        "divisible by the num_workers. However, the input shape is "
+                     << input_shape.value() << " while num_workers is " << num_workers);
+  }
+  ffi::Array<PrimExpr> output_shape = input_shape.value();
+  output_shape.Set(0, div(output_shape[0], num_workers));
+  return TensorStructInfo(ShapeExpr(output_shape), input_sinfo->dtype, input_sinfo->vdevice);
+}
+
+TVM_REGISTER_OP("relax.ccl.reduce_scatter")
+    .set_attrs_type<ReduceScatterAttrs>()
+    .set_num_inputs(1)
+    .add_argument("x", "Tensor", "Input to which reduce-scatter will be applied.")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoReduceScatter)
+    .set_attr<Bool>("FPurity", Bool(true));
+
+/* relax.ccl.all_to_all */
+
+Expr all_to_all(Expr x, int num_workers, bool in_group) {
+  ObjectPtr<AllToAllAttrs> attrs = ffi::make_object<AllToAllAttrs>();
+  attrs->num_workers = std::move(num_workers);
+  attrs->in_group = std::move(in_group);
+
+  static const Op& op = Op::Get("relax.ccl.all_to_all");
+  return Call(op, {std::move(x)}, Attrs{attrs}, {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.op.ccl.all_to_all", all_to_all);
+}
+
+StructInfo InferStructInfoAllToAll(const Call& call, const BlockBuilder& ctx) {
+  TensorStructInfo input_sinfo = GetUnaryInputTensorStructInfo(call, ctx);
+
+  const auto* attrs = call->attrs.as<AllToAllAttrs>();
+  int num_workers = attrs->num_workers;
+
+  auto input_shape = input_sinfo->GetShape();
+  if (!input_shape.defined()) {
+    return input_sinfo;
+  }
+  if (input_shape.value().empty()) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "all_to_all expects the input tensor to have at least one dimension.");
+  }
+  arith::Analyzer* analyzer = ctx->GetAnalyzer();
+  if (analyzer->CanProve(floormod(input_shape.value()[0], PrimExpr(num_workers)) != 0)) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "all_to_all expects the size of axis 0 of input tensor to be "
+                        "divisible by the num_workers. However, the input shape is "
+                     << input_shape.value() << " while num_workers is " << num_workers);
+  }
+  return input_sinfo;
+}
+
+TVM_REGISTER_OP("relax.ccl.all_to_all")
+    .set_attrs_type<AllToAllAttrs>()
+    .set_num_inputs(1)
+    .add_argument("x", "Tensor", "Input to which all-to-all will be applied.")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoAllToAll)
+    .set_attr<Bool>("FPurity", Bool(true));
+
+/* relax.ccl.moe_dispatch */
+
+Expr moe_dispatch(Expr x, int num_workers, bool in_group) {
+  ObjectPtr<AllToAllAttrs> attrs = ffi::make_object<AllToAllAttrs>();
+  attrs->num_workers = num_workers;
+  attrs->in_group = in_group;
+
+  static const Op& op = Op::Get("relax.ccl.moe_dispatch");
+  return Call(op, {std::move(x)}, Attrs{attrs}, {});
+}
+
+/* relax.ccl.moe_combine */
+
+Expr moe_combine(Expr x, int num_workers, bool in_group) {
+  ObjectPtr<AllToAllAttrs> attrs = ffi::make_object<AllToAllAttrs>();
+  attrs->num_workers = num_workers;
+  attrs->in_group = in_group;
+
+  static const Op& op = Op::Get("relax.ccl.moe_combine");
+  return Call(op, {std::move(x)}, Attrs{attrs}, {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("relax.op.ccl.moe_dispatch", moe_dispatch)
+      .def("relax.op.ccl.moe_combine", moe_combine);
+}
+
+/*!
+ * \brief The struct info of moe_dispatch and moe_combine, which divide the axis `split_axis` of
+ *  the input by the number of workers and multiply the other of the axes 0 and 1 by it.
+ */
+StructInfo InferStructInfoMoEExchange(const Call& call, const BlockBuilder& ctx, int split_axis) {
+  TensorStructInfo input_sinfo = GetUnaryInputTensorStructInfo(call, ctx);
+  const auto* attrs = call->attrs.as<AllToAllAttrs>();
+  int num_workers = attrs->num_workers;
+  ffi::String op_name = Downcast<Op>(call->op)->name;
+
+  if (!input_sinfo->IsUnknownNdim() && input_sinfo->ndim < 2) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << op_name << " expects the input tensor to have at least two dimensions, "
+                     << "the experts and the tokens. However, the input has "
+                     << input_sinfo->ndim << " dimensions.");
+  }
+  auto input_shape = input_sinfo->GetShape();
+  if (!input_shape.defined()) {
+    return TensorStructInfo(input_sinfo->dtype, input_sinfo->ndim, input_sinfo->vdevice);
+  }
+  ffi::Array<PrimExpr> output_shape = input_shape.value();
+  arith::Analyzer* analyzer = ctx->GetAnalyzer();
+  if (analyzer->CanProve(floormod(output_shape[split_axis], PrimExpr(num_workers)) != 0)) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << op_name << " expects the size of axis " << split_axis
+                     << " of input tensor to be divisible by the num_workers. However, the input "
+                     << "shape is " << output_shape << " while num_workers is " << num_workers);
+  }
+  int merge_axis = 1 - split_axis;
+  output_shape.Set(split_axis, floordiv(output_shape[split_axis], num_workers));
+  output_shape.Set(merge_axis, output_shape[merge_axis] * num_workers);
+  return TensorStructInfo(ShapeExpr(output_shape), input_sinfo->dtype, input_sinfo->vdevice);
+}
+
+StructInfo InferStructInfoMoEDispatch(const Call& call, const BlockBuilder& ctx) {
+  return InferStructInfoMoEExchange(call, ctx, /*split_axis=*/0);
+}
+
+StructInfo InferStructInfoMoECombine(const Call& call, const BlockBuilder& ctx) {
+  return InferStructInfoMoEExchange(call, ctx, /*split_axis=*/1);
+}
+
+TVM_REGISTER_OP("relax.ccl.moe_dispatch")
+    .set_attrs_type<AllToAllAttrs>()
+    .set_num_inputs(1)
+    .add_argument("x", "Tensor", "The tokens of each expert, of shape (experts, capacity, ...).")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoMoEDispatch)
+    .set_attr<Bool>("FPurity", Bool(true));
+
+TVM_REGISTER_OP("relax.ccl.moe_combine")
+    .set_attrs_type<AllToAllAttrs>()
+    .set_num_inputs(1)
+    .add_argument("x", "Tensor", "The outputs of the local experts for the tokens of all workers.")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoMoECombine)
+    .set_attr<Bool>("FPurity", Bool(true));
+
+/* relax.ccl.ring_send_recv_start */
+
+Expr ring_send_recv_start(Expr x, bool in_group) {
+  ObjectPtr<RingSendRecvAttrs> attrs = ffi::make_object<RingSendRecvAttrs>();
+  attrs->in_group = in_group;
+
+  static const Op& op = Op::Get("relax.ccl.ring_send_recv_start");
+  return Call(op, {std::move(x)}, Attrs{attrs}, {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.op.ccl.ring_send_recv_start", ring_send_recv_start);
+}
+
+StructInfo InferStructInfoRingSendRecvStart(const Call& call, const BlockBuilder& ctx) {
+  TensorStructInfo input_sinfo = GetUnaryInputTensorStructInfo(call, ctx);
+  return input_sinfo;
+}
+
+TVM_REGISTER_OP("relax.ccl.ring_send_recv_start")
+    .set_attrs_type<RingSendRecvAttrs>()
+    .set_num_inputs(1)
+    .add_argument("x", "Tensor", "Input to be sent to the next worker of the ring.")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoRingSendRecvStart)
+    .set_attr<Bool>("FPurity", Bool(true));
+
+/* relax.ccl.ring_send_recv_wait */
+
+Expr ring_send_recv_wait(Expr x, Expr recv, Expr after) {
+  static const Op& op = Op::Get("relax.ccl.ring_send_recv_wait");
+  return Call(op, {std::move(x), std::move(recv), std::move(after)}, {}, {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.op.ccl.ring_send_recv_wait", ring_send_recv_wait);
+}
+
+StructInfo InferStructInfoRingSendRecvWait(const Call& call, const BlockBuilder& ctx) {
+  ffi::Array<TensorStructInfo> input_sinfo = GetInputTensorStructInfo(call, ctx);
+  return input_sinfo[1];
+}
+
+TVM_REGISTER_OP("relax.ccl.ring_send_recv_wait")
+    .set_num_inputs(3)
+    .add_argument("x", "Tensor", "The input sent by the ring exchange.")
+    .add_argument("recv", "Tensor", "The result of the ring exchange to wait for.")
+    .add_argument("after", "Tensor", "The tensor the wait is ordered after.")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoRingSendRecvWait)
+    .set_attr<Bool>("FPurity", Bool(true));
+
 /* relax.ccl.broadcast_from_worker0 */
 Expr broadcast_from_worker0(Expr x) {
   static const Op& op = Op::Get("relax.ccl.broadcast_from_worker0");
@@ -38,6 +38,30 @@ Expr allreduce(Expr data, ffi::String op_type, bool in_group);
 /*! \brief AllGather. */
 Expr allgather(Expr data, int num_workers, bool in_group);
 
+/*! \brief ReduceScatter. */
+Expr reduce_scatter(Expr data, ffi::String op_type, int num_workers, bool in_group);
+
+/*! \brief AllToAll, exchanging equal chunks of the given buffer between all workers. */
+Expr all_to_all(Expr data, int num_workers, bool in_group);
+
+/*!
+ * \brief Dispatch the tokens of all the experts to the workers holding the experts. The input
+ *  of shape (experts, capacity, ...) is split along the experts, and each worker receives the
+ *  tokens of its experts from all the workers, as a tensor of shape
+ *  (experts / num_workers, num_workers * capacity, ...).
+ */
+Expr moe_dispatch(Expr data, int num_workers, bool in_group);
+
+/*! \brief Combine the outputs of the experts back to the workers of the tokens: the inverse of
+ *  moe_dispatch. */
+Expr moe_combine(Expr data, int num_workers, bool in_group);
+
+/*! \brief Start sending data to the next worker of the ring and receiving from the previous one. */
+Expr ring_send_recv_start(Expr data, bool in_group);
+
+/*! \brief Wait for the ring exchange started from data to recv, ordered after `after`. */
+Expr ring_send_recv_wait(Expr data, Expr recv, Expr after);
+
 /*! \brief Broadcast data from worker-0 to all other workers. */
 Expr broadcast_from_worker0(Expr data);
 
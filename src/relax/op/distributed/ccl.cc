@@ -16,6 +16,8 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <string>
+
 #include "tvm/relax/attrs/ccl.h"
 
 #include "utils.h"
@@ -38,6 +40,57 @@ StructInfo InferDistStructInfoAllReduce(const Call& call, const BlockBuilder& ct
 TVM_REGISTER_OP("relax.ccl.allreduce")
     .set_attr<FInferStructInfo>("dist.FInferStructInfo", InferDistStructInfoAllReduce);
 
+StructInfo InferDistStructInfoReduceScatter(const Call& call, const BlockBuilder& ctx) {
+  ffi::Array<DTensorStructInfo> input_dtensor_sinfos = GetInputDTensorStructInfo(call, ctx);
+  TVM_FFI_ICHECK(input_dtensor_sinfos.size() == 1);
+  DTensorStructInfo input_dtensor_sinfo = input_dtensor_sinfos[0];
+  DeviceMesh device_mesh = input_dtensor_sinfo->device_mesh;
+  TVM_FFI_ICHECK(device_mesh->shape.size() == 1)
+      << "reduce_scatter over a device mesh of more than 1 dimension is not supported yet";
+  // The reduced tensor is scattered along axis 0 over the workers.
+  return DTensorStructInfo(input_dtensor_sinfo->tensor_sinfo, device_mesh,
+                           Placement::FromText("S[0]"));
+}
+
+TVM_REGISTER_OP("relax.ccl.reduce_scatter")
+    .set_attr<FInferStructInfo>("dist.FInferStructInfo", InferDistStructInfoReduceScatter);
+
+/*!
+ * \brief The dist struct info of moe_dispatch and moe_combine. They keep the global tensor and move
+ *  its sharding from the axis `input_axis` to the other of the axes 0 and 1.
+ */
+StructInfo InferDistStructInfoMoEExchange(const Call& call, const BlockBuilder& ctx,
+                                          int input_axis) {
+  ffi::Array<DTensorStructInfo> input_dtensor_sinfos = GetInputDTensorStructInfo(call, ctx);
+  TVM_FFI_ICHECK(input_dtensor_sinfos.size() == 1);
+  DTensorStructInfo input_dtensor_sinfo = input_dtensor_sinfos[0];
+  DeviceMesh device_mesh = input_dtensor_sinfo->device_mesh;
+  ffi::String op_name = Downcast<Op>(call->op)->name;
+  TVM_FFI_ICHECK(device_mesh->shape.size() == 1)
+      << op_name << " over a device mesh of more than 1 dimension is not supported yet";
+  const PlacementSpec& input_spec = input_dtensor_sinfo->placement->dim_specs[0];
+  TVM_FFI_ICHECK(input_spec->kind == PlacementSpecKind::kSharding &&
+                 input_spec->axis == input_axis)
+      << op_name << " expects its input to be sharded along axis " << input_axis << ", but got "
+      << input_dtensor_sinfo->placement;
+  return DTensorStructInfo(input_dtensor_sinfo->tensor_sinfo, device_mesh,
+                           Placement::FromText("S[" + std::to_string(1 - input_axis) + "]"));
+}
+
+StructInfo InferDistStructInfoMoEDispatch(const Call& call, const BlockBuilder& ctx) {
+  return InferDistStructInfoMoEExchange(call, ctx, /*input_axis=*/1);
+}
+
+StructInfo InferDistStructInfoMoECombine(const Call& call, const BlockBuilder& ctx) {
+  return InferDistStructInfoMoEExchange(call, ctx, /*input_axis=*/0);
+}
+
+TVM_REGISTER_OP("relax.ccl.moe_dispatch")
+    .set_attr<FInferStructInfo>("dist.FInferStructInfo", InferDistStructInfoMoEDispatch);
+
+TVM_REGISTER_OP("relax.ccl.moe_combine")
+    .set_attr<FInferStructInfo>("dist.FInferStructInfo", InferDistStructInfoMoECombine);
+
 }  // namespace distributed
 }  // namespace relax
 }  // namespace tvm
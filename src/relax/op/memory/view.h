@@ -34,7 +34,7 @@ Expr view(Expr x, ffi::Optional<Expr> shape, ffi::Optional<Expr> dtype,
           ffi::Optional<Expr> relative_byte_offset);
 
 /*! \brief Ensure the tensor has elem_offset == 0. A copy will be made if necessary. */
-Expr ensure_aligned(const Expr& x);
+Expr ensure_zero_offset(const Expr& x);
 
 }  // namespace relax
 }  // namespace tvm
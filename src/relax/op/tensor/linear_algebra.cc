@@ -302,5 +302,81 @@ TVM_REGISTER_OP("relax.outer")
     .set_attr<TMixedPrecisionPolicy>("TMixedPrecisionPolicy", MixedPrecisionPolicyKind::kAlways)
     .set_attr<Bool>("FPurity", Bool(true));
 
+/* relax.grouped_matmul */
+
+Expr grouped_matmul(Expr x, Expr weight, Expr indptr) {
+  static const Op& op = Op::Get("relax.grouped_matmul");
+  return Call(op, {std::move(x), std::move(weight), std::move(indptr)}, {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.op.grouped_matmul", grouped_matmul);
+}
+
+StructInfo InferStructInfoGroupedMatmul(const Call& call, const BlockBuilder& ctx) {
+  ffi::Array<TensorStructInfo> input_sinfo = GetInputTensorStructInfo(call, ctx);
+  TensorStructInfo x_sinfo = input_sinfo[0];
+  TensorStructInfo weight_sinfo = input_sinfo[1];
+  TensorStructInfo indptr_sinfo = input_sinfo[2];
+
+  if ((!x_sinfo->IsUnknownNdim() && x_sinfo->ndim != 2) ||
+      (!weight_sinfo->IsUnknownNdim() && weight_sinfo->ndim != 3) ||
+      (!indptr_sinfo->IsUnknownNdim() && indptr_sinfo->ndim != 1)) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "GroupedMatmul requires x to be 2-D, weight to be 3-D and indptr to be "
+                        "1-D. However, the given inputs have "
+                     << x_sinfo->ndim << ", " << weight_sinfo->ndim << " and "
+                     << indptr_sinfo->ndim << " dimensions");
+  }
+  if (!indptr_sinfo->IsUnknownDtype() && !indptr_sinfo->dtype.is_int()) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "GroupedMatmul requires indptr to be an integer tensor. However, the "
+                        "given indptr has dtype "
+                     << indptr_sinfo->dtype);
+  }
+  DataType out_dtype = x_sinfo->dtype;
+  if (!x_sinfo->IsUnknownDtype() && !weight_sinfo->IsUnknownDtype() &&
+      x_sinfo->dtype != weight_sinfo->dtype) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "GroupedMatmul requires x and weight to have the same dtype. However, "
+                        "the given dtypes are "
+                     << x_sinfo->dtype << " and " << weight_sinfo->dtype);
+  }
+  ffi::Optional<VDevice> vdevice = x_sinfo->vdevice;
+
+  const auto* x_shape = x_sinfo->shape.as<ShapeExprNode>();
+  const auto* weight_shape = weight_sinfo->shape.as<ShapeExprNode>();
+  const auto* indptr_shape = indptr_sinfo->shape.as<ShapeExprNode>();
+  if (x_shape == nullptr || weight_shape == nullptr) {
+    return TensorStructInfo(out_dtype, /*ndim=*/2, vdevice);
+  }
+
+  arith::Analyzer* analyzer = ctx->GetAnalyzer();
+  if (analyzer->CanProve(x_shape->values[1] != weight_shape->values[2])) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "GroupedMatmul requires the reduction length of x and weight to match. "
+                        "However, the given x has shape "
+                     << x_sinfo->shape << " and weight has shape " << weight_sinfo->shape);
+  }
+  if (indptr_shape != nullptr &&
+      analyzer->CanProve(indptr_shape->values[0] != weight_shape->values[0])) {
+    ctx->ReportFatal(Diagnostic::Error(call)
+                     << "GroupedMatmul requires indptr to have one element per group of weight. "
+                        "However, the given indptr has shape "
+                     << indptr_sinfo->shape << " and weight has shape " << weight_sinfo->shape);
+  }
+  ffi::Array<PrimExpr> output_shape = {x_shape->values[0], weight_shape->values[1]};
+  return TensorStructInfo(ShapeExpr(output_shape), out_dtype, vdevice);
+}
+
+TVM_REGISTER_OP("relax.grouped_matmul")
+    .set_num_inputs(3)
+    .add_argument("x", "Tensor", "The rows of all the groups, group after group.")
+    .add_argument("weight", "Tensor", "The weight of each group, of shape (groups, n, k).")
+    .add_argument("indptr", "Tensor", "The end row of each group in x.")
+    .set_attr<FInferStructInfo>("FInferStructInfo", InferStructInfoGroupedMatmul)
+    .set_attr<Bool>("FPurity", Bool(true));
+
 }  // namespace relax
 }  // namespace tvm
@@ -59,6 +59,17 @@ Expr einsum(Expr operands, ffi::String subscripts);
  */
 Expr outer(Expr x1, Expr x2);
 
+/*!
+ * \brief Grouped matrix multiplication, as in mixture-of-experts layers. The rows of x are
+ * split into consecutive groups, and the rows of the group g are multiplied with weight[g].
+ * \param x The rows of all the groups, of shape (m, k).
+ * \param weight The weight of each group, of shape (groups, n, k).
+ * \param indptr The 1-D integer tensor of the end row of each group in x, which may only be
+ * known on the device. The rows past the last group are zeros.
+ * \return The computed result, of shape (m, n).
+ */
+Expr grouped_matmul(Expr x, Expr weight, Expr indptr);
+
 }  // namespace relax
 }  // namespace tvm
 
@@ -0,0 +1,359 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/assign_streams.cc
+ * \brief Run the independent kernels of the lowered Relax functions on several streams.
+ *
+ * The pass works on the functions after memory planning, where the kernels are the calls to
+ * PrimFuncs with explicit outputs. Two kernels depend on each other when one of them writes a
+ * storage that the other one reads or writes, so that the storages reused by memory planning are
+ * dependencies too. Each run of kernels, between the bindings that are neither kernels nor memory
+ * allocations, is split into chains that are assigned to the streams. The streams fork from the
+ * stream 0 at the beginning of the run, wait on events for the dependencies across the streams,
+ * and join into the stream 0 at the end of the run.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.backend.max_num_streams", Integer);
+
+/*! \brief Collect the parameters of a PrimFunc that may be written. */
+class WrittenParamCollector : public tir::StmtExprVisitor {
+ public:
+  static std::vector<bool> Collect(const tir::PrimFunc& func) {
+    WrittenParamCollector collector;
+    collector(func->body);
+    std::vector<bool> written;
+    for (const tir::Var& param : func->params) {
+      const tir::VarNode* data = param.get();
+      if (auto buffer = func->buffer_map.Get(param)) {
+        data = buffer.value()->data.get();
+      }
+      written.push_back(collector.written_data_.count(data) > 0);
+    }
+    return written;
+  }
+
+ private:
+  void VisitStmt_(const tir::BufferStoreNode* op) final {
+    written_data_.insert(op->buffer->data.get());
+    tir::StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitStmt_(const tir::DeclBufferNode* op) final {
+    written_data_.insert(op->buffer->data.get());
+    tir::StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitStmt_(const tir::SBlockNode* op) final {
+    // The regions matched by sub-buffers may be written through them.
+    for (const tir::MatchBufferRegion& match : op->match_buffers) {
+      written_data_.insert(match->source->buffer->data.get());
+    }
+    tir::StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitExpr_(const tir::VarNode* op) final {
+    // The data pointers used other than by buffer accesses, e.g. passed to an extern call.
+    written_data_.insert(op);
+  }
+
+  std::unordered_set<const tir::VarNode*> written_data_;
+};
+
+class StreamAssigner : public ExprMutator {
+ public:
+  StreamAssigner(IRModule mod, int max_num_streams)
+      : ExprMutator(mod), mod_(mod), max_num_streams_(max_num_streams) {}
+
+  using ExprMutator::VisitBindingBlock_;
+
+  BindingBlock VisitBindingBlock_(const BindingBlockNode* block) final {
+    builder_->BeginBindingBlock();
+    std::vector<Binding> run;
+    for (const Binding& binding : block->bindings) {
+      if (IsKernel(binding) || IsHostAllocation(binding) || IsKill(binding)) {
+        run.push_back(binding);
+        continue;
+      }
+      EmitRun(run);
+      run.clear();
+      VisitBinding(binding);
+    }
+    EmitRun(run);
+    return builder_->EndBlock();
+  }
+
+ private:
+  /*! \brief A kernel call, i.e. a call to a PrimFunc. */
+  struct Kernel {
+    /*! \brief The storages the kernel reads. */
+    std::vector<const Object*> reads;
+    /*! \brief The storages the kernel writes. */
+    std::vector<const Object*> writes;
+    /*! \brief The stream the kernel is assigned to. */
+    int stream = 0;
+  };
+
+  /*! \brief Get the callee and the arguments of a kernel call, if the binding is one. */
+  bool GetKernelCall(const Binding& binding, tir::PrimFunc* func, ffi::Array<Expr>* args) const {
+    static const Op& call_tir_dyn_op = Op::Get("relax.vm.call_tir_dyn");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    const auto* call = var_binding ? var_binding->value.as<CallNode>() : nullptr;
+    if (call == nullptr) return false;
+    Expr callee = call->op;
+    *args = call->args;
+    if (call->op.same_as(call_tir_dyn_op)) {
+      callee = call->args[0];
+      *args = Downcast<Tuple>(call->args[1])->fields;
+    }
+    const auto* gvar = callee.as<GlobalVarNode>();
+    if (gvar == nullptr) return false;
+    auto opt_func = mod_->Lookup(ffi::GetRef<GlobalVar>(gvar)).as<tir::PrimFunc>();
+    if (!opt_func) return false;
+    *func = opt_func.value();
+    return true;
+  }
+
+  bool IsKernel(const Binding& binding) const {
+    tir::PrimFunc func;
+    ffi::Array<Expr> args;
+    return GetKernelCall(binding, &func, &args);
+  }
+
+  /*! \brief Whether the binding only allocates memory on the host side. */
+  static bool IsHostAllocation(const Binding& binding) {
+    static const Op& mem_alloc_storage = Op::Get("relax.memory.alloc_storage");
+    static const Op& mem_alloc_tensor = Op::Get("relax.memory.alloc_tensor");
+    static const Op& vm_alloc_storage = Op::Get("relax.vm.alloc_storage");
+    static const Op& vm_alloc_tensor = Op::Get("relax.vm.alloc_tensor");
+    static const Op& builtin_alloc_tensor = Op::Get("relax.builtin.alloc_tensor");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    if (var_binding && var_binding->value.as<VarNode>()) {
+      // The aliases that memory planning leaves, e.g. `lv = alloc`.
+      return true;
+    }
+    const auto* call = var_binding ? var_binding->value.as<CallNode>() : nullptr;
+    return call && (call->op.same_as(mem_alloc_storage) || call->op.same_as(mem_alloc_tensor) ||
+                    call->op.same_as(vm_alloc_storage) || call->op.same_as(vm_alloc_tensor) ||
+                    call->op.same_as(builtin_alloc_tensor));
+  }
+
+  /*! \brief Whether the binding frees memory, which is deferred to the end of the run. */
+  static bool IsKill(const Binding& binding) {
+    static const Op& mem_kill_tensor = Op::Get("relax.memory.kill_tensor");
+    static const Op& mem_kill_storage = Op::Get("relax.memory.kill_storage");
+    static const Op& vm_kill_object = Op::Get("relax.vm.kill_object");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    const auto* call = var_binding ? var_binding->value.as<CallNode>() : nullptr;
+    return call && (call->op.same_as(mem_kill_tensor) || call->op.same_as(mem_kill_storage) ||
+                    call->op.same_as(vm_kill_object));
+  }
+
+  /*! \brief Get the storage a tensor lives in, the tensor itself if it is not a view. */
+  const Object* GetStorage(const Expr& expr) const {
+    if (const auto* var = expr.as<VarNode>()) {
+      auto it = storage_of_.find(var);
+      return it != storage_of_.end() ? it->second : var;
+    }
+    return nullptr;
+  }
+
+  void RecordAllocation(const Binding& binding) {
+    static const Op& mem_alloc_tensor = Op::Get("relax.memory.alloc_tensor");
+    static const Op& vm_alloc_tensor = Op::Get("relax.vm.alloc_tensor");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    if (var_binding->value.as<VarNode>()) {
+      storage_of_[var_binding->var.get()] = GetStorage(var_binding->value);
+      return;
+    }
+    const auto* call = var_binding->value.as<CallNode>();
+    if (call->op.same_as(mem_alloc_tensor) || call->op.same_as(vm_alloc_tensor)) {
+      if (const Object* storage = GetStorage(call->args[0])) {
+        storage_of_[var_binding->var.get()] = storage;
+      }
+    }
+  }
+
+  /*! \brief Whether a kernel has to run after another one. */
+  static bool DependsOn(const Kernel& kernel, const Kernel& prev) {
+    auto overlaps = [](const std::vector<const Object*>& a, const std::vector<const Object*>& b) {
+      return std::any_of(a.begin(), a.end(), [&b](const Object* storage) {
+        return std::find(b.begin(), b.end(), storage) != b.end();
+      });
+    };
+    return overlaps(kernel.reads, prev.writes) || overlaps(kernel.writes, prev.reads) ||
+           overlaps(kernel.writes, prev.writes);
+  }
+
+  void EmitStreamCall(const char* builtin, ffi::Array<Expr> args) {
+    static const Op& call_builtin_with_ctx_op = Op::Get("relax.call_builtin_with_ctx");
+    // The kernels run on the first device of the VM.
+    args.insert(args.begin(), PrimValue::Int64(0));
+    builder_->Emit(Call(call_builtin_with_ctx_op, {ExternFunc(builtin), Tuple(args)}, Attrs(),
+                        {TupleStructInfo(ffi::Array<StructInfo>())}),
+                   "_");
+  }
+
+  void EmitSetStream(int stream) {
+    EmitStreamCall("vm.builtin.stream.set", {PrimValue::Int64(stream)});
+  }
+
+  void EmitWait(int src, int dst) {
+    EmitStreamCall("vm.builtin.stream.wait", {PrimValue::Int64(src), PrimValue::Int64(dst)});
+  }
+
+  /*! \brief Emit a run of kernels, allocations and kills, on several streams if possible. */
+  void EmitRun(const std::vector<Binding>& run) {
+    // Assign the kernels to the streams. A kernel runs on the first stream of the kernels it
+    // depends on, so that the chains join into the stream 0, and a kernel that depends on no
+    // kernel of the run starts a chain on the next stream.
+    std::vector<Kernel> kernels;
+    std::vector<int> kernel_of(run.size(), -1);
+    int next_stream = 0;
+    for (size_t i = 0; i < run.size(); ++i) {
+      if (IsHostAllocation(run[i])) {
+        RecordAllocation(run[i]);
+      }
+      tir::PrimFunc func;
+      ffi::Array<Expr> args;
+      if (!GetKernelCall(run[i], &func, &args)) continue;
+      std::vector<bool> written = WrittenParamCollector::Collect(func);
+      Kernel kernel;
+      for (size_t k = 0; k < args.size(); ++k) {
+        if (const Object* storage = GetStorage(args[k])) {
+          bool is_written = k >= written.size() || written[k];
+          (is_written ? kernel.writes : kernel.reads).push_back(storage);
+        }
+      }
+      int stream = -1;
+      for (const Kernel& prev : kernels) {
+        if (DependsOn(kernel, prev) && (stream == -1 || prev.stream < stream)) {
+          stream = prev.stream;
+        }
+      }
+      if (stream == -1) {
+        stream = next_stream;
+        next_stream = (next_stream + 1) % max_num_streams_;
+      }
+      kernel.stream = stream;
+      kernel_of[i] = kernels.size();
+      kernels.push_back(std::move(kernel));
+    }
+
+    std::vector<bool> used(max_num_streams_, false);
+    for (const Kernel& kernel : kernels) {
+      used[kernel.stream] = true;
+    }
+    bool multi_stream = std::count(used.begin() + 1, used.end(), true) > 0;
+    if (!multi_stream) {
+      for (const Binding& binding : run) {
+        VisitBinding(binding);
+      }
+      return;
+    }
+
+    // Fork the side streams from the stream 0.
+    for (int s = 1; s < max_num_streams_; ++s) {
+      if (used[s]) EmitWait(0, s);
+    }
+    // synced[src][dst] is the index of the last kernel on src that dst has waited for.
+    std::vector<std::vector<int>> synced(max_num_streams_, std::vector<int>(max_num_streams_, -1));
+    std::vector<int> last_on_stream(max_num_streams_, -1);
+    std::vector<Binding> kills;
+    int current_stream = 0;
+    for (size_t i = 0; i < run.size(); ++i) {
+      if (IsKill(run[i])) {
+        kills.push_back(run[i]);
+        continue;
+      }
+      if (kernel_of[i] == -1) {
+        VisitBinding(run[i]);
+        continue;
+      }
+      int index = kernel_of[i];
+      const Kernel& kernel = kernels[index];
+      for (int j = 0; j < index; ++j) {
+        int src = kernels[j].stream;
+        if (src == kernel.stream || !DependsOn(kernel, kernels[j]) ||
+            synced[src][kernel.stream] >= j) {
+          continue;
+        }
+        EmitWait(src, kernel.stream);
+        synced[src][kernel.stream] = last_on_stream[src];
+      }
+      if (kernel.stream != current_stream) {
+        EmitSetStream(kernel.stream);
+        current_stream = kernel.stream;
+      }
+      VisitBinding(run[i]);
+      last_on_stream[kernel.stream] = index;
+    }
+    // Join the side streams into the stream 0, before the memory is freed.
+    if (current_stream != 0) {
+      EmitSetStream(0);
+    }
+    for (int s = 1; s < max_num_streams_; ++s) {
+      if (used[s] && synced[s][0] < last_on_stream[s]) EmitWait(s, 0);
+    }
+    for (const Binding& binding : kills) {
+      VisitBinding(binding);
+    }
+  }
+
+  /*! \brief The module. */
+  IRModule mod_;
+  /*! \brief The maximum number of streams. */
+  int max_num_streams_;
+  /*! \brief The storages of the tensors allocated in the storages. */
+  std::unordered_map<const VarNode*, const Object*> storage_of_;
+};
+
+namespace transform {
+
+Pass AssignStreams() {
+  auto pass_func = [=](Function func, IRModule mod, PassContext pc) {
+    int max_num_streams =
+        pc->GetConfig<Integer>("relax.backend.max_num_streams").value_or(Integer(1))->value;
+    if (max_num_streams <= 1) {
+      return func;
+    }
+    return Downcast<Function>(StreamAssigner(mod, max_num_streams).VisitExpr(func));
+  };
+  return CreateFunctionPass(pass_func, /*opt_level=*/0, "AssignStreams", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.AssignStreams", AssignStreams);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -29,6 +29,10 @@
 #include <tvm/relax/transform.h>
 #include <tvm/tir/index_map.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include "../op/tensor/manipulate.h"
 #include "infer_layout_utils.h"
 #include "utils.h"
@@ -352,6 +356,177 @@ DataflowBlock ConvertLayoutPass(const DataflowBlock& df_block,
   return Downcast<DataflowBlock>(mutator.VisitBindingBlock(df_block));
 }
 
+/*!
+ * \brief Select the layouts of the ops with candidate layouts in a dataflow block by cost.
+ *
+ * The ops of the block whose name has candidate layouts are the anchors of the selection. An
+ * assignment picks one candidate for each anchor, and its cost is the sum of
+ * - the cost of each anchor in its candidate layout, given by the `op_cost` callback or, by
+ *   default, the index of the candidate times the number of elements of the output, so the
+ *   candidates are ranked by preference;
+ * - the number of elements moved by the layout transforms that LayoutConvertMutator inserts for
+ *   the assignment, except the transforms of constants, which are folded at compile time.
+ *
+ * The transforms are counted on the block rewritten for the assignment, so the cost accounts for
+ * the propagation through the layout-agnostic ops exactly as FRelaxInferLayout does it. The
+ * assignment is searched by coordinate descent: starting from each uniform assignment (every
+ * anchor takes its k-th candidate), the candidate of one anchor at a time is changed as long as
+ * the cost strictly decreases, and the cheapest local minimum is kept.
+ */
+class LayoutSelector {
+ public:
+  using CandidateMap = ffi::Map<ffi::String, ffi::Array<ffi::Array<ffi::String>>>;
+
+  static DataflowBlock Run(const DataflowBlock& block, const CandidateMap& candidate_layouts,
+                           const ffi::Optional<ffi::Function>& op_cost) {
+    LayoutSelector selector(block, candidate_layouts, op_cost);
+    if (selector.anchors_.empty()) {
+      return block;
+    }
+    return selector.Convert(selector.Select());
+  }
+
+ private:
+  struct Anchor {
+    /*! \brief The call of the anchor in the original block. */
+    const CallNode* call;
+    /*! \brief The candidate layouts of the anchor. */
+    ffi::Array<ffi::Array<ffi::String>> candidates;
+    /*! \brief The cost of the anchor in each candidate layout. */
+    std::vector<double> costs;
+  };
+
+  LayoutSelector(DataflowBlock block, const CandidateMap& candidate_layouts,
+                 const ffi::Optional<ffi::Function>& op_cost)
+      : block_(std::move(block)) {
+    for (const Binding& binding : block_->bindings) {
+      const auto* var_binding = binding.as<VarBindingNode>();
+      const auto* call = var_binding ? var_binding->value.as<CallNode>() : nullptr;
+      const auto* op = call ? call->op.as<OpNode>() : nullptr;
+      if (op == nullptr || !candidate_layouts.count(op->name)) {
+        continue;
+      }
+      Anchor anchor{call, candidate_layouts.at(op->name), {}};
+      TVM_FFI_CHECK(!anchor.candidates.empty(), ValueError)
+          << "AutoConvertLayout expects at least one candidate layout for " << op->name;
+      for (size_t i = 0; i < anchor.candidates.size(); ++i) {
+        anchor.costs.push_back(op_cost.defined()
+                                   ? op_cost.value()(ffi::GetRef<Call>(call), anchor.candidates[i])
+                                         .cast<double>()
+                                   : i * NumElements(GetStructInfo(binding->var)));
+      }
+      anchors_.push_back(std::move(anchor));
+    }
+  }
+
+  /*! \brief Get the number of elements of a tensor or a tuple, counting symbolic dims as 1. */
+  static double NumElements(const StructInfo& sinfo) {
+    if (const auto* tuple = sinfo.as<TupleStructInfoNode>()) {
+      double num = 0;
+      for (const StructInfo& field : tuple->fields) {
+        num += NumElements(field);
+      }
+      return num;
+    }
+    const auto* tensor = sinfo.as<TensorStructInfoNode>();
+    if (tensor == nullptr || tensor->IsUnknownNdim()) {
+      return 0;
+    }
+    double num = 1;
+    if (auto shape = tensor->GetShape()) {
+      for (const PrimExpr& dim : shape.value()) {
+        if (const auto* int_dim = dim.as<IntImmNode>()) {
+          num *= int_dim->value;
+        }
+      }
+    }
+    return num;
+  }
+
+  std::vector<int> Select() {
+    size_t max_num_candidates = 0;
+    for (const Anchor& anchor : anchors_) {
+      max_num_candidates = std::max(max_num_candidates, anchor.candidates.size());
+    }
+    std::vector<int> best;
+    double best_cost = 0;
+    for (size_t k = 0; k < max_num_candidates; ++k) {
+      std::vector<int> assignment;
+      for (const Anchor& anchor : anchors_) {
+        assignment.push_back(std::min(k, anchor.candidates.size() - 1));
+      }
+      double cost = Descend(&assignment);
+      if (best.empty() || cost < best_cost) {
+        best = std::move(assignment);
+        best_cost = cost;
+      }
+    }
+    return best;
+  }
+
+  /*! \brief Improve an assignment by coordinate descent, and return its cost. */
+  double Descend(std::vector<int>* assignment) {
+    double cost = Cost(*assignment);
+    bool improved = true;
+    while (improved) {
+      improved = false;
+      for (size_t i = 0; i < anchors_.size(); ++i) {
+        for (int k = 0; k < static_cast<int>(anchors_[i].candidates.size()); ++k) {
+          int current = (*assignment)[i];
+          if (k == current) {
+            continue;
+          }
+          (*assignment)[i] = k;
+          double new_cost = Cost(*assignment);
+          if (new_cost < cost) {
+            cost = new_cost;
+            improved = true;
+          } else {
+            (*assignment)[i] = current;
+          }
+        }
+      }
+    }
+    return cost;
+  }
+
+  double Cost(const std::vector<int>& assignment) {
+    static const Op& permute_dims_op = Op::Get("relax.permute_dims");
+    static const Op& layout_transform_op = Op::Get("relax.layout_transform");
+    double cost = 0;
+    for (size_t i = 0; i < anchors_.size(); ++i) {
+      cost += anchors_[i].costs[assignment[i]];
+    }
+    for (const Binding& binding : Convert(assignment)->bindings) {
+      const auto* var_binding = binding.as<VarBindingNode>();
+      const auto* call = var_binding ? var_binding->value.as<CallNode>() : nullptr;
+      if (call && (call->op.same_as(permute_dims_op) || call->op.same_as(layout_transform_op)) &&
+          !call->args[0]->IsInstance<ConstantNode>()) {
+        cost += NumElements(GetStructInfo(call->args[0]));
+      }
+    }
+    return cost;
+  }
+
+  DataflowBlock Convert(const std::vector<int>& assignment) {
+    std::unordered_map<const CallNode*, ffi::Map<ffi::String, ffi::Array<ffi::String>>> layouts;
+    for (size_t i = 0; i < anchors_.size(); ++i) {
+      layouts[anchors_[i].call] = {{Downcast<Op>(anchors_[i].call->op)->name,
+                                    anchors_[i].candidates[assignment[i]]}};
+    }
+    LayoutCb layout_cb = [&layouts](Call call) -> ffi::Map<ffi::String, ffi::Array<ffi::String>> {
+      auto it = layouts.find(call.get());
+      return it != layouts.end() ? it->second : ffi::Map<ffi::String, ffi::Array<ffi::String>>();
+    };
+    return ConvertLayoutPass(block_, {}, layout_cb);
+  }
+
+  /*! \brief The dataflow block to convert. */
+  DataflowBlock block_;
+  /*! \brief The anchors of the selection, in the order of the bindings. */
+  std::vector<Anchor> anchors_;
+};
+
 namespace transform {
 
 Pass ConvertLayout(ffi::Map<ffi::String, ffi::Array<ffi::String>> desired_layouts,
@@ -368,6 +543,24 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def("relax.transform.ConvertLayout", ConvertLayout);
 }
 
+Pass AutoConvertLayout(ffi::Map<ffi::String, ffi::Array<ffi::Array<ffi::String>>> candidate_layouts,
+                       ffi::Optional<ffi::Function> op_cost, bool fold_constants) {
+  ffi::TypedFunction<DataflowBlock(DataflowBlock, IRModule, PassContext)> pass_func =
+      [=](DataflowBlock df_block, IRModule m, PassContext pc) {
+        return LayoutSelector::Run(df_block, candidate_layouts, op_cost);
+      };
+  Pass pass = CreateDataflowBlockPass(pass_func, 0, "AutoConvertLayout", {});
+  if (!fold_constants) {
+    return pass;
+  }
+  return tvm::transform::Sequential({pass, FoldConstant()}, "AutoConvertLayout");
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.AutoConvertLayout", AutoConvertLayout);
+}
+
 }  // namespace transform
 }  // namespace relax
 }  // namespace tvm
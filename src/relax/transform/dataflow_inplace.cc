@@ -23,6 +23,7 @@
  *   into in-place versions.
  */
 
+#include <tvm/arith/iter_affine_map.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ir/transform.h>
 #include <tvm/relax/analysis.h>
@@ -94,6 +95,10 @@ std::unordered_map<Var, std::pair<int, int>> AnalyzeLiveness(const DataflowBlock
   return ret;
 }
 
+// ops whose result is a view of their first argument
+static std::unordered_set<std::string> VIEW_OPS = {
+    "relax.reshape", "relax.memory.view", "relax.memory.ensure_zero_offset"};
+
 class AliasAnalyzer {
  public:
   AliasAnalyzer() : alias_map_(), tuple_map_(), mem_idx_(0) {}
@@ -273,6 +278,31 @@ class AliasAnalyzer {
           } else {
             ret.insert(get_fresh_idx());
           }
+        } else if (VIEW_OPS.count(op_node->name)) {
+          // a view shares the memory of the viewed tensor
+          return GetAliasSet(call_node->args[0], bound_var);
+        } else if (op_node->name == "relax.call_tir_inplace") {
+          // the in-place outputs are the arguments they are written to
+          auto* attrs = call_node->attrs.as<CallTIRInplaceAttrs>();
+          auto args = Downcast<Tuple>(call_node->args[1])->fields;
+          auto output_aliases = [&](int output_idx) -> std::unordered_set<int> {
+            int arg_idx = attrs->inplace_indices[output_idx].IntValue();
+            if (arg_idx == -1) {
+              return {get_fresh_idx()};
+            }
+            return GetAliasSet(args[arg_idx], bound_var);
+          };
+          if (auto* tuple_struct_info = call_node->sinfo_args[0].as<TupleStructInfoNode>()) {
+            int tup_idx = get_fresh_idx();
+            ret.insert(tup_idx);
+            std::vector<std::unordered_set<int>> new_tuple_map;
+            for (size_t i = 0; i < tuple_struct_info->fields.size(); i++) {
+              new_tuple_map.push_back(output_aliases(i));
+            }
+            tuple_map_[tup_idx] = new_tuple_map;
+          } else {
+            return output_aliases(0);
+          }
         } else {
           // We are assuming most op calls return fresh values.
           // We may have to track more exceptions
@@ -516,6 +546,218 @@ static std::unordered_set<std::string> SUPPORTED_OPS = {"relax.add",      "relax
                                                         "relax.nn.silu",  "relax.nn.relu"};
 bool OpSupportsInplace(const Op& op) { return SUPPORTED_OPS.count(op->name); }
 
+// Collects the accesses of a PrimFunc statement to the input buffers that a call_tir may write its
+// output to and to the output buffer, with the innermost block and the loops around each access.
+// Any other use of the buffers (a store to an input, a buffer aliasing them, a use of their data
+// pointer) makes the accesses opaque.
+class InplaceAccessCollector : public tir::StmtExprVisitor {
+ public:
+  struct Access {
+    const tir::BufferStoreNode* store;
+    ffi::Array<PrimExpr> indices;
+    // null if the access is not in a block, or in a block nested in another block
+    const tir::SBlockRealizeNode* realize;
+    std::vector<const tir::ForNode*> loops;
+  };
+
+  InplaceAccessCollector(const std::vector<tir::Buffer>& inputs, const tir::Buffer& output)
+      : output_(output) {
+    for (const tir::Buffer& input : inputs) {
+      inputs_.insert(input.get());
+      data_vars_.insert(input->data.get());
+    }
+    data_vars_.insert(output->data.get());
+  }
+
+  std::vector<Access> loads;
+  std::vector<Access> stores;
+  bool opaque = false;
+
+ private:
+  Access MakeAccess(const tir::BufferStoreNode* store, const ffi::Array<PrimExpr>& indices) {
+    return Access{store, indices, nested_ ? nullptr : realize_, loops_};
+  }
+
+  void VisitStmt_(const tir::ForNode* op) final {
+    loops_.push_back(op);
+    tir::StmtExprVisitor::VisitStmt_(op);
+    loops_.pop_back();
+  }
+
+  void VisitStmt_(const tir::SBlockRealizeNode* op) final {
+    auto old_realize = realize_;
+    auto old_nested = nested_;
+    nested_ = realize_ != nullptr;
+    realize_ = op;
+    tir::StmtExprVisitor::VisitStmt_(op);
+    realize_ = old_realize;
+    nested_ = old_nested;
+  }
+
+  void VisitStmt_(const tir::SBlockNode* op) final {
+    for (const tir::MatchBufferRegion& match : op->match_buffers) {
+      opaque = opaque || data_vars_.count(match->source->buffer->data.get());
+    }
+    tir::StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const tir::DeclBufferNode* op) final {
+    opaque = opaque || data_vars_.count(op->buffer->data.get());
+    tir::StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const tir::BufferStoreNode* op) final {
+    if (op->buffer.same_as(output_)) {
+      stores.push_back(MakeAccess(op, op->indices));
+    } else if (inputs_.count(op->buffer.get())) {
+      opaque = true;
+    }
+    tir::StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const tir::BufferLoadNode* op) final {
+    if (inputs_.count(op->buffer.get())) {
+      loads.push_back(MakeAccess(nullptr, op->indices));
+    }
+    tir::StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const tir::VarNode* op) final {
+    opaque = opaque || data_vars_.count(op);
+  }
+
+  tir::Buffer output_;
+  std::unordered_set<const tir::BufferNode*> inputs_;
+  std::unordered_set<const tir::VarNode*> data_vars_;
+  const tir::SBlockRealizeNode* realize_ = nullptr;
+  bool nested_ = false;
+  std::vector<const tir::ForNode*> loops_;
+};
+
+// Check that the store is the whole body of a spatial block, which each instance of the block
+// executes at a distinct element, and that the loads are in the same block at the same element.
+bool IsElementwiseStore(const InplaceAccessCollector::Access& store,
+                        const std::vector<InplaceAccessCollector::Access>& loads) {
+  const tir::SBlockRealizeNode* realize = store.realize;
+  if (realize == nullptr || realize->block->body.get() != store.store ||
+      realize->block->init.defined() || store.indices.size() != realize->block->iter_vars.size()) {
+    return false;
+  }
+  std::unordered_set<const tir::VarNode*> iter_vars;
+  for (const tir::IterVar& iter_var : realize->block->iter_vars) {
+    if (iter_var->iter_type != tir::kDataPar) {
+      return false;
+    }
+    iter_vars.insert(iter_var->var.get());
+  }
+  // the indices are a permutation of the block vars
+  for (const PrimExpr& index : store.indices) {
+    auto* var = index.as<tir::VarNode>();
+    if (var == nullptr || !iter_vars.erase(var)) {
+      return false;
+    }
+  }
+  // the loops map to the instances of the block one to one
+  ffi::Map<tir::Var, Range> loop_iters;
+  for (const tir::ForNode* loop : store.loops) {
+    loop_iters.Set(loop->loop_var, Range::FromMinExtent(loop->min, loop->extent));
+  }
+  arith::Analyzer analyzer;
+  if (arith::DetectIterMap(realize->iter_values, loop_iters, realize->predicate,
+                           arith::IterMapLevel::Bijective, &analyzer)
+          ->indices.empty()) {
+    return false;
+  }
+  for (const auto& load : loads) {
+    if (load.realize != realize || !StructuralEqual()(load.indices, store.indices)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check that the PrimFunc computes the same output when the output buffer is replaced with the
+// input buffers (several when the same tensor is passed to several params): each statement of the
+// body that reads the inputs must come before the output is written, or write the output in a
+// single block that reads the inputs at the element it writes (e.g. the residual add of a fused
+// matmul, or the last block of a fused elementwise function).
+bool CanWriteOutputInplace(const tir::PrimFunc& func, const std::vector<tir::Buffer>& inputs,
+                           const tir::Buffer& output) {
+  for (const tir::Buffer& input : inputs) {
+    if (input->dtype != output->dtype || !input->strides.empty() || !output->strides.empty() ||
+        !StructuralEqual()(input->shape, output->shape)) {
+      return false;
+    }
+  }
+  tir::Stmt body = func->body;
+  if (auto* realize = body.as<tir::SBlockRealizeNode>()) {
+    if (realize->block->iter_vars.empty()) {
+      body = realize->block->body;
+    }
+  }
+  ffi::Array<tir::Stmt> stmts = {body};
+  if (auto* seq = body.as<tir::SeqStmtNode>()) {
+    stmts = seq->seq;
+  }
+  bool output_written = false;
+  for (const tir::Stmt& stmt : stmts) {
+    InplaceAccessCollector collector(inputs, output);
+    collector(stmt);
+    if (collector.opaque) {
+      return false;
+    }
+    if (!collector.loads.empty()) {
+      bool elementwise = collector.stores.empty() ||
+                         (collector.stores.size() == 1 &&
+                          IsElementwiseStore(collector.stores[0], collector.loads));
+      if (output_written || !elementwise) {
+        return false;
+      }
+    }
+    output_written = output_written || !collector.stores.empty();
+  }
+  return true;
+}
+
+// Given a call_tir with a single output, return the indices of the arguments whose buffer the
+// called PrimFunc can write the output to.
+std::unordered_set<int> GetInplaceCallTIRArgs(const CallNode* call, const IRModule& mod) {
+  std::unordered_set<int> ret;
+  auto* gvar = call->args[0].as<GlobalVarNode>();
+  auto* args = call->args[1].as<TupleNode>();
+  if (gvar == nullptr || args == nullptr || !mod->functions.count(ffi::GetRef<GlobalVar>(gvar)) ||
+      !call->sinfo_args[0].as<TensorStructInfoNode>()) {
+    return ret;
+  }
+  auto func = mod->Lookup(ffi::GetRef<GlobalVar>(gvar)).as<tir::PrimFunc>();
+  size_t num_inputs = args->fields.size();
+  if (!func || func.value()->params.size() <= num_inputs) {
+    return ret;
+  }
+  auto output = func.value()->buffer_map.Get(func.value()->params[num_inputs]);
+  if (!output) {
+    return ret;
+  }
+  for (size_t i = 0; i < num_inputs; i++) {
+    if (!args->fields[i].as<VarNode>()) {
+      continue;
+    }
+    // once the output is written, every param the tensor is passed to sees it
+    std::vector<tir::Buffer> inputs;
+    for (size_t j = 0; j < num_inputs; j++) {
+      if (args->fields[j].same_as(args->fields[i])) {
+        if (auto buffer = func.value()->buffer_map.Get(func.value()->params[j])) {
+          inputs.push_back(buffer.value());
+        }
+      }
+    }
+    if (!inputs.empty() && CanWriteOutputInplace(func.value(), inputs, output.value())) {
+      ret.insert(static_cast<int>(i));
+    }
+  }
+  return ret;
+}
+
 /*! \brief Corresponds to a binding where at least one argument meets the conditions to be
  *  made in-place. Contains the binding index and indices of the applicable arguments
  */
@@ -548,6 +790,24 @@ class InplaceOpportunity : public ObjectRef {
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(InplaceOpportunity, ObjectRef, InplaceOpportunityNode);
 };
 
+// Check if the target is a constant or a var that may alias one of the given constants
+bool AliasesConstant(const std::unordered_map<Var, std::unordered_set<int>>& alias_sets,
+                     const std::unordered_set<int>& constant_aliases, const Expr& target) {
+  if (target.as<ConstantNode>()) {
+    return true;
+  }
+  auto* var_node = target.as<VarNode>();
+  if (var_node == nullptr || !alias_sets.count(ffi::GetRef<Var>(var_node))) {
+    return false;
+  }
+  for (int alias_idx : alias_sets.at(ffi::GetRef<Var>(var_node))) {
+    if (constant_aliases.count(alias_idx)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Check for in-place eligibility:
 //  1. see if there's an arg big enough to hold the result
 //  2. see if the arg is live past the call
@@ -560,10 +820,12 @@ class InplaceOpportunity : public ObjectRef {
 //    and *exactly* matches the shape of the result.
 // For both lists, each element is a list of ints of the following format:
 //   The first element is the index of the *binding* in the block.
-//   All remaining elements are the indices of *eligible arguments* in that call.
+//   All remaining elements are the indices of *eligible arguments* in that call
+//   (for a call_tir, the indices in its argument tuple).
 std::pair<std::vector<InplaceOpportunity>, std::vector<InplaceOpportunity>>
 FindInplaceOpportunities(const DataflowBlock& block, const ffi::Array<Var>& inputs,
                          const BlockBuilder& ctx) {
+  static const Op& call_tir_op = Op::Get("relax.call_tir");
   auto live_ranges = AnalyzeLiveness(block);
   AliasAnalyzer analyzer;
   auto alias_info = analyzer.Analyze(block, inputs);
@@ -583,6 +845,14 @@ FindInplaceOpportunities(const DataflowBlock& block, const ffi::Array<Var>& inpu
               return live_ranges[var1].first < live_ranges[var2].first;
             });
 
+  std::unordered_set<int> constant_aliases;
+  for (const Binding& binding : block->bindings) {
+    if (GetBoundValue(binding).as<ConstantNode>()) {
+      auto alias_set = alias_sets[binding->var];
+      constant_aliases.insert(alias_set.begin(), alias_set.end());
+    }
+  }
+
   std::unordered_set<Var> currently_live;
   int last_live = 0;
 
@@ -617,7 +887,18 @@ FindInplaceOpportunities(const DataflowBlock& block, const ffi::Array<Var>& inpu
 
     if (auto* call_node = value.as<CallNode>()) {
       if (auto* op_node = call_node->op.as<OpNode>()) {
-        if (!OpSupportsInplace(ffi::GetRef<Op>(op_node))) {
+        // For a call_tir, the candidates are the arguments whose buffer the PrimFunc can write
+        // the output to, and whose indices are that of the argument tuple.
+        bool is_call_tir = op_node == call_tir_op.get();
+        std::unordered_set<int> call_tir_candidates;
+        ffi::Array<Expr> args = call_node->args;
+        if (is_call_tir) {
+          call_tir_candidates = GetInplaceCallTIRArgs(call_node, ctx->GetContextIRModule());
+          if (call_tir_candidates.empty()) {
+            continue;
+          }
+          args = Downcast<Tuple>(call_node->args[1])->fields;
+        } else if (!OpSupportsInplace(ffi::GetRef<Op>(op_node))) {
           continue;
         }
 
@@ -631,8 +912,11 @@ FindInplaceOpportunities(const DataflowBlock& block, const ffi::Array<Var>& inpu
         }
 
         // Check that at least one argument matches size with the result
-        for (size_t j = 0; j < call_node->args.size(); j++) {
-          auto arg = call_node->args[j];
+        for (size_t j = 0; j < args.size(); j++) {
+          if (is_call_tir && !call_tir_candidates.count(static_cast<int>(j))) {
+            continue;
+          }
+          auto arg = args[j];
           for (auto target : target_sinfo) {
             auto [matches_size, matches_exactly] = SizeMatches(target, GetStructInfo(arg), ctx);
             if (matches_size) {
@@ -648,11 +932,12 @@ FindInplaceOpportunities(const DataflowBlock& block, const ffi::Array<Var>& inpu
         }
 
         // Make sure at least one candidate is not live past this point and does not have an alias
-        // live past this point
+        // live past this point (nor is a constant, which is shared by the calls of the function)
         std::unordered_set<int> remove_candidates;
         for (auto candidate : candidates) {
           if (!InplaceConditionsMet(live_ranges, alias_sets, tuple_map, currently_live,
-                                    call_node->args[candidate], i)) {
+                                    args[candidate], i) ||
+              AliasesConstant(alias_sets, constant_aliases, args[candidate])) {
             remove_candidates.insert(candidate);
           }
         }
@@ -788,6 +1073,23 @@ class ModuleInplaceTransformer : public ExprMutator {
     for (auto gv : legalizers_added) {
       ret->Remove(gv);
     }
+    // the private PrimFuncs replaced with in-place versions may no longer be called
+    std::unordered_set<const GlobalVarNode*> used_gvars;
+    for (auto kv : ret->functions) {
+      if (auto func = kv.second.as<Function>()) {
+        PostOrderVisit(func.value(), [&used_gvars](const Expr& node) {
+          if (auto* gvar = node.as<GlobalVarNode>()) {
+            used_gvars.insert(gvar);
+          }
+        });
+      }
+    }
+    for (auto gv : primfuncs_replaced) {
+      if (!used_gvars.count(gv.get()) && ret->functions.count(gv) &&
+          !ret->Lookup(gv)->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol)) {
+        ret->Remove(gv);
+      }
+    }
     return ret;
   }
 
@@ -855,16 +1157,26 @@ class ModuleInplaceTransformer : public ExprMutator {
   // (Made public for testing.)
   Call CreateInplaceCall(const Call& call, const ffi::Array<Integer>& inplace_indices) {
     static const auto& legalize_map = Op::GetAttrMap<FLegalize>("FLegalize");
+    static const auto& call_tir_op = Op::Get("relax.call_tir");
     static const auto& call_tir_inplace_op = Op::Get("relax.call_tir_inplace");
 
-    auto op = Downcast<Op>(call->op);
-    auto legalized_call = Downcast<Call>(legalize_map[op](builder_, call));
+    // A call_tir is made in-place directly, other ops are legalized first
+    bool is_call_tir = call->op.same_as(call_tir_op);
+    auto legalized_call = call;
+    if (!is_call_tir) {
+      auto op = Downcast<Op>(call->op);
+      legalized_call = Downcast<Call>(legalize_map[op](builder_, call));
+    }
     auto* legalized_call_cow = legalized_call.CopyOnWrite();
 
     // The legalized call should be call_tir. We will replace it with call_tir_inplace
     // and replace the called PrimFunc with an inplace version
     auto legal_op = Downcast<GlobalVar>(legalized_call->args[0]);
-    legalizers_added.push_back(legal_op);
+    if (is_call_tir) {
+      primfuncs_replaced.push_back(legal_op);
+    } else {
+      legalizers_added.push_back(legal_op);
+    }
     auto inline_legal_op_name = legal_op->name_hint + "_inplace";
 
     auto mod = builder_->GetContextIRModule();
@@ -873,7 +1185,8 @@ class ModuleInplaceTransformer : public ExprMutator {
     tir::Stmt new_body = old_primfunc->body;
 
     size_t num_outs = inplace_indices.size();
-    size_t num_params = old_primfunc->params.size();
+    // the outputs come after the inputs (and before the symbolic vars, if any)
+    size_t num_inputs = Downcast<Tuple>(legalized_call->args[1])->fields.size();
 
     // the replacement we must make:
     // 1. For each output var, replace its corresponding buffers with the corresponding inplace
@@ -886,7 +1199,7 @@ class ModuleInplaceTransformer : public ExprMutator {
     ffi::Map<tir::Var, tir::Var> var_subst_map;
     for (size_t i = 0; i < num_outs; i++) {
       // we will substitute output i with the corresponding param indicated by inplace indices
-      auto output_var = old_primfunc->params[num_params - num_outs + i];
+      auto output_var = old_primfunc->params[num_inputs + i];
       auto inplace_var = old_primfunc->params[inplace_indices[i].IntValue()];
       var_subst_map.Set(output_var, inplace_var);
 
@@ -910,13 +1223,16 @@ class ModuleInplaceTransformer : public ExprMutator {
     // remove the now-unused outputs from the buffer map
     auto new_buffer_map = old_primfunc->buffer_map;
     for (size_t i = 0; i < num_outs; i++) {
-      new_buffer_map.erase(old_primfunc->params[num_params - num_outs + i]);
+      new_buffer_map.erase(old_primfunc->params[num_inputs + i]);
     }
 
-    // now get rid of the last num_outputs arguments
+    // now get rid of the num_outputs output arguments
     // (couldn't do earlier or else it would have thrown off the indexing)
     ffi::Array<tir::Var> new_params(old_primfunc->params.begin(),
-                                    old_primfunc->params.begin() + (num_params - num_outs));
+                                    old_primfunc->params.begin() + num_inputs);
+    for (size_t i = num_inputs + num_outs; i < old_primfunc->params.size(); i++) {
+      new_params.push_back(old_primfunc->params[i]);
+    }
 
     tir::PrimFunc new_primfunc(new_params, new_body, old_primfunc->ret_type, new_buffer_map,
                                old_primfunc->attrs, old_primfunc->span);
@@ -946,6 +1262,8 @@ class ModuleInplaceTransformer : public ExprMutator {
   const IRModule& mod_;
   // Keep track of legalizers we add so we can clean up at the end.
   ffi::Array<GlobalVar> legalizers_added;
+  // Keep track of the PrimFuncs of the call_tir made in-place, to remove those no longer called.
+  ffi::Array<GlobalVar> primfuncs_replaced;
   // The current function's params will be treated as non-aliased
   // (we are assuming good behavior on the user's part).
   ffi::Array<Var> func_params;
@@ -28,19 +28,83 @@
 #include <tvm/tir/function.h>
 #include <tvm/tir/op.h>
 
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace tvm {
 namespace relax {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FoldConstant.max_output_bytes", Integer);
+
+/*!
+ * \brief The process-wide cache of the kernels built for constant folding, so that the same
+ * PrimFunc is built once across the functions, the modules and the runs of FoldConstant.
+ */
+class FoldKernelCache {
+ public:
+  static FoldKernelCache* Global() {
+    static FoldKernelCache* inst = new FoldKernelCache();
+    return inst;
+  }
+
+  /*!
+   * \brief The key of a PrimFunc in the cache, which does not depend on its global symbol.
+   * \param func The PrimFunc to be built.
+   * \return The PrimFunc with the global symbol of the folding kernels.
+   */
+  static tir::PrimFunc Key(tir::PrimFunc func) {
+    return WithAttr(std::move(func), tvm::attr::kGlobalSymbol, ffi::String("tir_function"));
+  }
+
+  /*!
+   * \brief Look up a kernel in the cache.
+   * \param key The key of the PrimFunc.
+   * \param result The built kernel, or nullopt if the PrimFunc cannot be built.
+   * \return Whether the PrimFunc is in the cache.
+   */
+  bool Lookup(const tir::PrimFunc& key, ffi::Optional<ffi::Function>* result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = kernels_.find(key);
+    if (it == kernels_.end()) return false;
+    *result = it->second;
+    return true;
+  }
+
+  /*! \brief Insert a kernel into the cache, which is cleared when it is full. */
+  void Insert(const tir::PrimFunc& key, ffi::Optional<ffi::Function> kernel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (kernels_.size() >= kMaxNumKernels) {
+      kernels_.clear();
+    }
+    kernels_[key] = std::move(kernel);
+  }
+
+ private:
+  /*! \brief The maximum number of the kernels kept by the cache. */
+  static constexpr size_t kMaxNumKernels = 1024;
+
+  std::mutex mutex_;
+  std::unordered_map<tir::PrimFunc, ffi::Optional<ffi::Function>, ffi::StructuralHash,
+                     ffi::StructuralEqual>
+      kernels_;
+};
+
 class ConstantFolder : public ExprMutator {
  public:
-  static Function Fold(Function func, IRModule ctx_module) {
-    ConstantFolder folder(std::move(ctx_module));
+  static Function Fold(Function func, IRModule ctx_module, int64_t max_output_bytes) {
+    ConstantFolder folder(std::move(ctx_module), max_output_bytes);
+    folder.PrebuildKernels(func);
     func = Downcast<Function>(RemoveAllUnused(folder(func)));
     return func;
   }
 
  private:
-  explicit ConstantFolder(IRModule ctx_module) : ExprMutator(ctx_module) {}
+  explicit ConstantFolder(IRModule ctx_module, int64_t max_output_bytes)
+      : ExprMutator(ctx_module), max_output_bytes_(max_output_bytes) {}
 
   /*!
    * \brief Pattern match the shape inside the given struct info to a
@@ -102,15 +166,11 @@ class ConstantFolder : public ExprMutator {
    * \return The cached func, nullopt if func cannot be built.
    */
   ffi::Optional<ffi::Function> GetCachedBuild(tir::PrimFunc func) {
-    // TODO(tvm-team): consider another way of bulk extract and build PrimFunc once
-    // would be helpful for future cases where PrimFunc recursively call into each other
-    Target eval_cpu_target{"llvm"};
-
-    auto it = func_build_cache_.find(func);
-    if (it != func_build_cache_.end()) {
-      return it->second;
-    }
+    tir::PrimFunc key = FoldKernelCache::Key(func);
     ffi::Optional<ffi::Function> build_func = std::nullopt;
+    if (FoldKernelCache::Global()->Lookup(key, &build_func)) {
+      return build_func;
+    }
 
     try {
       // Not all the primfunc can be directly built via llvm, for example, if a function is
@@ -118,17 +178,87 @@ class ConstantFolder : public ExprMutator {
       // now
       // TODO(Hongyi): further check and narrow the scope of foldable function
       const auto pf = tvm::ffi::Function::GetGlobalRequired("tir.build");
-      func = WithAttr(func, tvm::attr::kGlobalSymbol, ffi::String("tir_function"));
-      ffi::Module rt_module = pf(func, eval_cpu_target).cast<ffi::Module>();
+      ffi::Module rt_module = pf(key, Target("llvm")).cast<ffi::Module>();
       build_func = rt_module->GetFunction("tir_function");
     } catch (const tvm::Error& err) {
       // build failure may happen in which case we skip
       DLOG(WARNING) << "Build failure for function " << func << ", Error message: " << err.what();
     }
-    func_build_cache_[func] = build_func;
+    FoldKernelCache::Global()->Insert(key, build_func);
     return build_func;
   }
 
+  /*!
+   * \brief Build the kernels that folding a function is expected to run in one module, instead
+   * of one build for each kernel. These are the PrimFuncs of the call_tir whose arguments are
+   * constants or the results of such calls. The kernels of the legalized operators, and those
+   * of a module that fails to build, are still built on demand by GetCachedBuild.
+   * \param func The function to be folded.
+   */
+  void PrebuildKernels(const Function& func) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    const auto* seq = func->body.as<SeqExprNode>();
+    if (seq == nullptr) return;
+
+    std::unordered_set<const VarNode*> maybe_const;
+    auto is_maybe_const = [&](const Expr& expr) {
+      const auto* var = expr.as<VarNode>();
+      return expr->IsInstance<ConstantNode>() || (var != nullptr && maybe_const.count(var));
+    };
+    std::vector<tir::PrimFunc> keys;
+    std::unordered_set<tir::PrimFunc, ffi::StructuralHash, ffi::StructuralEqual> seen_keys;
+    for (const BindingBlock& block : seq->blocks) {
+      for (const Binding& binding : block->bindings) {
+        const auto* var_binding = binding.as<VarBindingNode>();
+        if (var_binding == nullptr) continue;
+        const Expr& value = var_binding->value;
+        if (const auto* get_item = value.as<TupleGetItemNode>()) {
+          if (is_maybe_const(get_item->tuple)) maybe_const.insert(var_binding->var.get());
+          continue;
+        }
+        if (value->IsInstance<ConstantNode>()) {
+          maybe_const.insert(var_binding->var.get());
+          continue;
+        }
+        const auto* call = value.as<CallNode>();
+        if (call == nullptr || !call->op.same_as(call_tir_op) || call->args.size() < 2) continue;
+        const auto* args = call->args[1].as<TupleNode>();
+        if (args == nullptr || !call->args[0]->IsInstance<GlobalVarNode>() ||
+            !std::all_of(args->fields.begin(), args->fields.end(), is_maybe_const) ||
+            !ShouldBeFolded(value)) {
+          continue;
+        }
+        ffi::Optional<tir::PrimFunc> prim_func = MatchPrimFunc(call->args[0]);
+        if (!prim_func) continue;
+        maybe_const.insert(var_binding->var.get());
+        tir::PrimFunc key = FoldKernelCache::Key(prim_func.value());
+        ffi::Optional<ffi::Function> cached;
+        if (!FoldKernelCache::Global()->Lookup(key, &cached) && seen_keys.insert(key).second) {
+          keys.push_back(key);
+        }
+      }
+    }
+    if (keys.size() < 2) return;
+
+    IRModule kernel_mod;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      std::string name = "tir_function_" + std::to_string(i);
+      kernel_mod->Add(GlobalVar(name), WithAttr(keys[i], tvm::attr::kGlobalSymbol,
+                                                ffi::String(name)));
+    }
+    try {
+      const auto pf = tvm::ffi::Function::GetGlobalRequired("tir.build");
+      ffi::Module rt_module = pf(kernel_mod, Target("llvm")).cast<ffi::Module>();
+      for (size_t i = 0; i < keys.size(); ++i) {
+        FoldKernelCache::Global()->Insert(
+            keys[i], rt_module->GetFunction("tir_function_" + std::to_string(i)));
+      }
+    } catch (const tvm::Error& err) {
+      // One kernel that cannot be built fails the whole module, so leave them to GetCachedBuild.
+      DLOG(WARNING) << "Build failure for the kernels to fold, Error message: " << err.what();
+    }
+  }
+
   /*!
    * \brief Checks if it is useful to fold \p expr.
    * \details Folding an expr is a trade-off - we are materializing a constant in the IRModule and
@@ -150,6 +280,32 @@ class ConstantFolder : public ExprMutator {
     return false;
   }
 
+  /*!
+   * \brief Get the number of bytes of an output, or -1 if it is not known at compile time.
+   */
+  static int64_t GetOutputBytes(const StructInfo& sinfo) {
+    if (const auto* tuple_sinfo = sinfo.as<TupleStructInfoNode>()) {
+      int64_t total = 0;
+      for (const StructInfo& field : tuple_sinfo->fields) {
+        int64_t nbytes = GetOutputBytes(field);
+        if (nbytes < 0) return -1;
+        total += nbytes;
+      }
+      return total;
+    }
+    const auto* tensor_sinfo = sinfo.as<TensorStructInfoNode>();
+    if (!tensor_sinfo || tensor_sinfo->IsUnknownDtype()) return -1;
+    auto opt_shape = tensor_sinfo->GetShape();
+    if (!opt_shape) return -1;
+    int64_t nbytes = (tensor_sinfo->dtype.bits() * tensor_sinfo->dtype.lanes() + 7) / 8;
+    for (const auto& dim : opt_shape.value()) {
+      const auto* int_dim = dim.as<IntImmNode>();
+      if (!int_dim) return -1;
+      nbytes *= int_dim->value;
+    }
+    return nbytes;
+  }
+
   bool ShouldBeFolded(Expr expr) {
     // Skip folding for creation ops (no tensor inputs) that produce large outputs.
     // These ops (e.g., zeros, ones, full, arange) are cheap to compute at runtime,
@@ -159,6 +315,12 @@ class ConstantFolder : public ExprMutator {
     const auto* call = expr.as<CallNode>();
     if (!call) return true;
 
+    // Skip folding for any op whose output is larger than the configured threshold, e.g. the
+    // broadcasts of small constants to the shape of a large activation.
+    if (max_output_bytes_ >= 0 && GetOutputBytes(GetStructInfo(expr)) > max_output_bytes_) {
+      return false;
+    }
+
     const auto* tensor_sinfo = call->struct_info_.as<TensorStructInfoNode>();
     if (!tensor_sinfo) return true;
 
@@ -411,17 +573,17 @@ class ConstantFolder : public ExprMutator {
     return ExprMutator::VisitExpr_(op);
   }
 
-  // cache for function build, via structural equality
-  std::unordered_map<tir::PrimFunc, ffi::Optional<ffi::Function>, ffi::StructuralHash,
-                     ffi::StructuralEqual>
-      func_build_cache_;
+  /*! \brief The maximum number of bytes of the output of a folded op, or -1 for no limit. */
+  int64_t max_output_bytes_;
 };
 
 namespace transform {
 
 Pass FoldConstant() {
   auto pass_func = [=](Function f, IRModule m, PassContext pc) {
-    return ConstantFolder::Fold(f, m);
+    int64_t max_output_bytes =
+        pc->GetConfig<Integer>("relax.FoldConstant.max_output_bytes").value_or(Integer(-1))->value;
+    return ConstantFolder::Fold(f, m, max_output_bytes);
   };
   return CreateFunctionPass(pass_func, 0, "FoldConstant", {});
 }
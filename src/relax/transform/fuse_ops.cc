@@ -42,6 +42,7 @@
 
 #include "../../support/arena.h"
 #include "../analysis/graph_partitioner.h"
+#include "../ir/dataflow_matcher.h"
 #include "tvm/relax/expr.h"
 #include "utils.h"
 
@@ -98,6 +99,7 @@ using support::LinkNode;
 constexpr uint32_t kMaxFusedOps = 256;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.max_depth", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.fusion_policy", ffi::Function);
 
 class GraphCreator : public ExprVisitor {
  public:
@@ -1039,15 +1041,47 @@ class OperatorFusor : public ExprMutator {
   bool lift_constants_{true};
 };
 
-IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth) {
+/*!
+ * \brief Wrap a fusion policy function of the pass context for the graph partitioner.
+ * \details The function is called with the module, the value bound to the node to fuse and the
+ * value bound to its immediate post-dominator, and returns a boolean, or None to leave the
+ * decision to the pattern rules.
+ */
+GraphPartitioner::FusionPolicy MakeFusionPolicy(const IRModule& mod, ffi::Function policy) {
+  ffi::Map<Var, Expr> var2value = AnalyzeVar2Value(mod);
+  auto value_of = [var2value](const IndexedForwardGraph::Node* node) -> Expr {
+    Expr expr = Downcast<Expr>(ffi::GetRef<ObjectRef>(node->ref));
+    if (const auto* var = expr.as<VarNode>()) {
+      return var2value.Get(ffi::GetRef<Var>(var)).value_or(expr);
+    }
+    return expr;
+  };
+  return [=](const IndexedForwardGraph::Node* node,
+             const IndexedForwardGraph::Node* sink) -> std::optional<bool> {
+    auto decision =
+        policy(mod, value_of(node), value_of(sink)).cast<ffi::Optional<bool>>();
+    if (!decision.has_value()) {
+      return std::nullopt;
+    }
+    return decision.value();
+  };
+}
+
+IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth,
+                 ffi::Optional<ffi::Function> fusion_policy) {
   support::Arena arena;
 
   // Step 1. Create the indexed-forward graph according to the input IRModule.
   IndexedForwardGraph graph = GraphCreator::Create(mod, &arena);
 
   // Step 2. Partition the graph by applying the fusion algorithm.
+  GraphPartitioner::FusionPolicy policy = nullptr;
+  if (fusion_policy.has_value()) {
+    policy = MakeFusionPolicy(mod, fusion_policy.value());
+  }
   std::vector<GraphPartitioner::Group*> groups =
-      GraphPartitioner(&arena, opt_level, max_fuse_depth, /*max_function_args=*/0).Partition(graph);
+      GraphPartitioner(&arena, opt_level, max_fuse_depth, /*max_function_args=*/0, policy)
+          .Partition(graph);
 
   // Step 3. Transform the IRModule by fusing the operators in accordance with the graph partition
   // results.
@@ -1088,6 +1122,7 @@ class PatternBasedPartitioner : ExprVisitor {
                           support::Arena* arena, FAttrsGetter attrs_getter)
       : pat_name_(pattern_name),
         pat_(pattern),
+        pat_root_index_(pattern),
         annotation_pat_(annotation_patterns),
         check_(check),
         arena_(arena),
@@ -1115,6 +1150,9 @@ class PatternBasedPartitioner : ExprVisitor {
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call) final {
     VisitVarDef(binding->var);
+    if (!pat_root_index_.MayMatch(ffi::GetRef<Call>(call))) {
+      return;
+    }
     if (auto matches_opt = ExtractMatchedExpr(pat_, ffi::GetRef<Call>(call), bindings_)) {
       const auto& context = CreatePatternCheckContext(call, matches_opt.value());
       if (check_ != nullptr && !check_(context)) {
@@ -1235,6 +1273,8 @@ class PatternBasedPartitioner : ExprVisitor {
 
   ffi::String pat_name_;
   DFPattern pat_;
+  /*! \brief The root ops of pat_, to skip the bindings it cannot match without matching. */
+  PatternRootIndex pat_root_index_;
   ffi::Map<ffi::String, DFPattern> annotation_pat_;
   FCheckMatch check_;
   support::Arena* arena_;
@@ -1440,7 +1480,8 @@ Pass FuseOps(int fuse_opt_level) {
       [=](IRModule m, PassContext pc) {
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relax.FuseOps.max_depth", Integer(kMaxFusedOps));
-        return relax::FuseOps(m, opt_level, max_fuse_depth.value().IntValue());
+        auto fusion_policy = pc->GetConfig<ffi::Function>("relax.FuseOps.fusion_policy");
+        return relax::FuseOps(m, opt_level, max_fuse_depth.value().IntValue(), fusion_policy);
       };
   return CreateModulePass(/*pass_function=*/pass_func,  //
                           /*opt_level=*/0,              //
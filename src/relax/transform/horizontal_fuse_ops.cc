@@ -0,0 +1,210 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/transform/horizontal_fuse_ops.cc
+ * \brief Group independent small kernels of a dataflow block into one grouped function, so that
+ * FuseTIR merges them into a single PrimFunc.
+ * \details
+ * FuseOps fuses producers with their consumers. The kernels that do not depend on each other,
+ * such as the norms or the rotary embeddings of Q and K, are left as separate launches that
+ * each underutilize the device. This pass groups such kernels horizontally:
+ * - The candidates are `R.call_tir` of PrimFuncs whose "op_pattern" is at most a reduction,
+ *   with one tensor output bound to a dataflow var.
+ * - Each binding of a dataflow block is assigned the length of the longest chain of bindings
+ *   it depends on in the block. Bindings at the same depth never depend on each other, and all
+ *   dependencies between the groups go from a smaller depth to a larger one, so grouping at
+ *   equal depth cannot create a cycle.
+ * - Candidates of the same depth and the same shape class, i.e. the same kind of pattern
+ *   (injective or reduction), the same output rank and dtype, are grouped in chunks of at most
+ *   `max_group_size` bindings.
+ *
+ * The groups are turned into grouped functions by the same machinery as FuseOpsByPattern.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/op_attr_types.h>
+#include <tvm/relax/transform.h>
+#include <tvm/tir/function.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "../../support/arena.h"
+#include "../analysis/graph_partitioner.h"
+#include "utils.h"
+
+namespace tvm {
+namespace relax {
+
+class HorizontalPartitioner : public ExprVisitor {
+ public:
+  using Group = GraphPartitioner::Group;
+  using GroupMap = std::unordered_map<const Object*, Group*>;
+
+  static GroupMap Run(const IRModule& mod, const Function& func, support::Arena* arena,
+                      int max_group_size) {
+    HorizontalPartitioner partitioner(mod, arena, max_group_size);
+    partitioner.VisitExpr(func);
+    return partitioner.group_map_;
+  }
+
+ private:
+  HorizontalPartitioner(IRModule mod, support::Arena* arena, int max_group_size)
+      : mod_(std::move(mod)), arena_(arena), max_group_size_(max_group_size) {}
+
+  using ExprVisitor::VisitExpr_;
+
+  void VisitVarDef(const Var& var) final { group_map_[var.get()] = arena_->make<Group>(); }
+
+  void VisitBindingBlock_(const DataflowBlockNode* block) final {
+    ExprVisitor::VisitBindingBlock_(block);
+
+    // The candidates of each depth and shape class, in the order of the bindings.
+    struct Bucket {
+      int depth;
+      int pattern;
+      TensorStructInfo sinfo;
+      std::vector<const VarNode*> vars;
+    };
+    std::vector<Bucket> buckets;
+    std::unordered_map<const VarNode*, int> depth;
+    for (const Binding& binding : block->bindings) {
+      int binding_depth = 0;
+      Expr value = binding.as<VarBindingNode>() ? Downcast<VarBinding>(binding)->value
+                                                : Downcast<MatchCast>(binding)->value;
+      for (const Var& var : FreeVars(value)) {
+        if (auto it = depth.find(var.get()); it != depth.end()) {
+          binding_depth = std::max(binding_depth, it->second + 1);
+        }
+      }
+      depth[binding->var.get()] = binding_depth;
+
+      int pattern = GetCandidatePattern(binding);
+      if (pattern < 0) {
+        continue;
+      }
+      TensorStructInfo sinfo = Downcast<TensorStructInfo>(GetStructInfo(binding->var));
+      auto it = std::find_if(buckets.begin(), buckets.end(), [&](const Bucket& bucket) {
+        return bucket.depth == binding_depth && bucket.pattern == pattern &&
+               bucket.sinfo->ndim == sinfo->ndim && bucket.sinfo->dtype == sinfo->dtype;
+      });
+      if (it == buckets.end()) {
+        it = buckets.insert(buckets.end(), Bucket{binding_depth, pattern, sinfo, {}});
+      }
+      it->vars.push_back(binding->var.get());
+    }
+
+    for (const Bucket& bucket : buckets) {
+      for (size_t begin = 0; begin < bucket.vars.size(); begin += max_group_size_) {
+        size_t end = std::min(bucket.vars.size(), begin + max_group_size_);
+        if (end - begin < 2) {
+          continue;
+        }
+        Group* group = group_map_[bucket.vars[begin]];
+        for (size_t i = begin + 1; i < end; ++i) {
+          Group* member = group_map_[bucket.vars[i]];
+          member->parent = group;
+          --member->num_nodes;
+          ++group->num_nodes;
+        }
+      }
+    }
+  }
+
+  /*!
+   * \brief Get the pattern class of a candidate binding, 0 for an injective kernel and 1 for a
+   * reduction, or -1 if the binding is not a candidate.
+   */
+  int GetCandidatePattern(const Binding& binding) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    if (var_binding == nullptr || !var_binding->var->IsInstance<DataflowVarNode>()) {
+      return -1;
+    }
+    const auto* call = var_binding->value.as<CallNode>();
+    // Calls with symbolic vars as extra arguments are left alone.
+    if (call == nullptr || !call->op.same_as(call_tir_op) || call->args.size() != 2) {
+      return -1;
+    }
+    if (GetStructInfoAs<TensorStructInfoNode>(var_binding->var) == nullptr) {
+      return -1;
+    }
+    const auto* gv = call->args[0].as<GlobalVarNode>();
+    if (gv == nullptr || !mod_->ContainGlobalVar(gv->name_hint)) {
+      return -1;
+    }
+    const auto* prim_func = mod_->Lookup(ffi::GetRef<GlobalVar>(gv)).as<tir::PrimFuncNode>();
+    if (prim_func == nullptr) {
+      return -1;
+    }
+    ffi::Optional<Integer> pattern = prim_func->GetAttr<Integer>("op_pattern");
+    if (!pattern.has_value() || pattern.value()->value > static_cast<int>(kCommReduce)) {
+      return -1;
+    }
+    return pattern.value()->value == static_cast<int>(kCommReduce) ? 1 : 0;
+  }
+
+  /*! \brief The module, to look up the op patterns of the PrimFuncs. */
+  IRModule mod_;
+  /*! \brief The arena to allocate the groups. */
+  support::Arena* arena_;
+  /*! \brief The maximum number of kernels in a group. */
+  int max_group_size_;
+  /*! \brief The group of each var. */
+  GroupMap group_map_;
+};
+
+namespace transform {
+
+Pass HorizontalFuseOps(int max_group_size) {
+  auto pass_func = [=](IRModule mod, PassContext pc) {
+    TVM_FFI_CHECK(max_group_size >= 2, ValueError)
+        << "HorizontalFuseOps expects groups of at least two kernels, but got max_group_size "
+        << max_group_size;
+    support::Arena arena;
+    HorizontalPartitioner::GroupMap group_map;
+    for (const auto& [gv, base_func] : mod->functions) {
+      const auto* func = base_func.as<FunctionNode>();
+      if (func == nullptr || func->HasNonzeroAttr(attr::kPrimitive) ||
+          func->GetAttr<ffi::String>(attr::kCodegen).has_value()) {
+        continue;
+      }
+      auto map = HorizontalPartitioner::Run(mod, ffi::GetRef<Function>(func), &arena,
+                                            max_group_size);
+      group_map.insert(map.begin(), map.end());
+    }
+    return MakeGroupedFunctions(mod, group_map);
+  };
+  return CreateModulePass(/*pass_function=*/pass_func,
+                          /*opt_level=*/0,
+                          /*pass_name=*/"HorizontalFuseOps",
+                          /*required=*/{});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.HorizontalFuseOps", HorizontalFuseOps);
+}
+
+}  // namespace transform
+
+}  // namespace relax
+}  // namespace tvm
@@ -0,0 +1,345 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/plan_vtcm_storage.cc
+ * \brief Keep the intermediate tensors of Hexagon kernels in VTCM across the kernels.
+ *
+ * The pass works on the functions after memory planning. The storages allocated at the top level
+ * of a function with a constant size, and only used by kernels, i.e. calls to PrimFuncs, are the
+ * candidates. The lifetime of a storage spans from its allocation to the last use of the storage
+ * or of the tensors in it, as the storages are freed after their last use by KillAfterLastUse.
+ *
+ * The candidates are placed in VTCM greedily, the shortest-lived first, such that the tensors
+ * passed from a kernel to the next one come first. A candidate is placed if, all along its
+ * lifetime, the storages placed so far, plus the VTCM that the running kernel allocates itself,
+ * leave room for it in the VTCM capacity. The capacity is the "vtcm-capacity" of the Hexagon
+ * target, or the pass config "tir.vtcm_capacity".
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+/*! \brief The VTCM allocation granularity of the Hexagon runtime, see kHexagonAllocAlignment. */
+constexpr int64_t kVTCMAllocAlignment = 2048;
+
+/*! \brief Get the bytes of VTCM a PrimFunc allocates itself. */
+int64_t KernelVTCMBytes(const tir::PrimFunc& func) {
+  int64_t nbytes = 0;
+  auto add_buffer = [&nbytes](const tir::Buffer& buffer) {
+    if (buffer.scope().find("global.vtcm") == std::string::npos) return;
+    int64_t size = buffer->dtype.bytes() * buffer->dtype.lanes();
+    for (const PrimExpr& dim : buffer->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      // A dynamic allocation may take any of the VTCM.
+      if (imm == nullptr) {
+        nbytes = std::numeric_limits<int64_t>::max() / 2;
+        return;
+      }
+      size *= imm->value;
+    }
+    nbytes += size;
+  };
+  // The buffers of all the blocks are summed, a bound of the VTCM in use at once.
+  tir::PostOrderVisit(func->body, [&](const ObjectRef& obj) {
+    if (const auto* block = obj.as<tir::SBlockNode>()) {
+      for (const tir::Buffer& buffer : block->alloc_buffers) {
+        add_buffer(buffer);
+      }
+    } else if (const auto* alloc = obj.as<tir::AllocateNode>()) {
+      const auto* ptr = alloc->buffer_var->type_annotation.as<PointerTypeNode>();
+      if (ptr == nullptr || ptr->storage_scope.find("global.vtcm") == std::string::npos) return;
+      int64_t size = alloc->ConstantAllocationSize();
+      nbytes += size > 0 ? size * alloc->dtype.bytes() * alloc->dtype.lanes()
+                         : std::numeric_limits<int64_t>::max() / 2;
+    }
+  });
+  return nbytes;
+}
+
+class VTCMStoragePlanner : public ExprMutator {
+ public:
+  VTCMStoragePlanner(IRModule mod, int64_t vtcm_capacity)
+      : ExprMutator(mod), mod_(mod), vtcm_capacity_(vtcm_capacity) {}
+
+  Function Plan(const Function& func) {
+    const auto* seq = func->body.as<SeqExprNode>();
+    if (seq == nullptr) return func;
+    std::vector<Binding> bindings;
+    for (const BindingBlock& block : seq->blocks) {
+      bindings.insert(bindings.end(), block->bindings.begin(), block->bindings.end());
+    }
+    for (size_t i = 0; i < bindings.size(); ++i) {
+      VisitTopLevelBinding(bindings[i], i);
+    }
+    // The storages of the results live beyond the function.
+    PostOrderVisit(seq->body, [this](const ObjectRef& obj) {
+      if (const auto* var = obj.as<VarNode>()) MarkEscaped(var);
+    });
+
+    std::vector<const Candidate*> candidates;
+    for (const auto& kv : candidates_) {
+      if (!kv.second.escaped) candidates.push_back(&kv.second);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate* a, const Candidate* b) {
+      int64_t length_a = a->last_use - a->begin;
+      int64_t length_b = b->last_use - b->begin;
+      if (length_a != length_b) return length_a < length_b;
+      return a->begin < b->begin;
+    });
+    std::vector<int64_t> used(bindings.size(), 0);
+    for (size_t i = 0; i < bindings.size(); ++i) {
+      used[i] = GetKernelVTCMBytes(bindings[i]);
+    }
+    for (const Candidate* candidate : candidates) {
+      bool fits = true;
+      for (int64_t i = candidate->begin; i <= candidate->last_use && fits; ++i) {
+        fits = used[i] + candidate->nbytes <= vtcm_capacity_;
+      }
+      if (!fits) continue;
+      for (int64_t i = candidate->begin; i <= candidate->last_use; ++i) {
+        used[i] += candidate->nbytes;
+      }
+      planned_.insert(candidate->alloc);
+    }
+    if (planned_.empty()) return func;
+    return Downcast<Function>(VisitExpr(func));
+  }
+
+  using ExprMutator::VisitExpr_;
+
+  Expr VisitExpr_(const CallNode* call) final {
+    if (!planned_.count(call)) {
+      return ExprMutator::VisitExpr_(call);
+    }
+    ffi::Array<Expr> args = call->args;
+    args.Set(2, StringImm("global.vtcm"));
+    return Call(call->op, args, call->attrs, call->sinfo_args, call->span);
+  }
+
+ private:
+  /*! \brief A storage that may be placed in VTCM. */
+  struct Candidate {
+    /*! \brief The allocation of the storage. */
+    const CallNode* alloc = nullptr;
+    /*! \brief The bytes of VTCM the storage takes. */
+    int64_t nbytes = 0;
+    /*! \brief The index of the binding allocating the storage. */
+    int64_t begin = 0;
+    /*! \brief The index of the last binding using the storage. */
+    int64_t last_use = 0;
+    /*! \brief Whether the storage is used other than by kernels. */
+    bool escaped = false;
+  };
+
+  /*! \brief Get the callee and the arguments of a kernel call, if the expression is one. */
+  bool GetKernelCall(const Expr& expr, tir::PrimFunc* func, ffi::Array<Expr>* args) const {
+    static const Op& call_tir_dyn_op = Op::Get("relax.vm.call_tir_dyn");
+    const auto* call = expr.as<CallNode>();
+    if (call == nullptr) return false;
+    Expr callee = call->op;
+    *args = call->args;
+    if (call->op.same_as(call_tir_dyn_op)) {
+      callee = call->args[0];
+      *args = Downcast<Tuple>(call->args[1])->fields;
+    }
+    const auto* gvar = callee.as<GlobalVarNode>();
+    if (gvar == nullptr) return false;
+    auto opt_func = mod_->Lookup(ffi::GetRef<GlobalVar>(gvar)).as<tir::PrimFunc>();
+    if (!opt_func) return false;
+    *func = opt_func.value();
+    return true;
+  }
+
+  /*! \brief Get the bytes of VTCM the kernel of a binding allocates, if the binding is one. */
+  int64_t GetKernelVTCMBytes(const Binding& binding) {
+    const auto* var_binding = binding.as<VarBindingNode>();
+    tir::PrimFunc func;
+    ffi::Array<Expr> args;
+    if (var_binding == nullptr || !GetKernelCall(var_binding->value, &func, &args)) return 0;
+    auto it = kernel_vtcm_bytes_.find(func.get());
+    if (it == kernel_vtcm_bytes_.end()) {
+      it = kernel_vtcm_bytes_.emplace(func.get(), KernelVTCMBytes(func)).first;
+    }
+    return it->second;
+  }
+
+  /*! \brief Whether a storage is allocated on a device other than Hexagon. */
+  bool IsOnOtherDevice(int64_t vdevice_index) const {
+    if (vdevice_index < 0) return true;
+    auto vdevices = mod_->global_infos.Get("vdevice");
+    if (!vdevices || vdevice_index >= static_cast<int64_t>(vdevices.value().size())) return false;
+    auto vdevice = vdevices.value()[vdevice_index].as<VDeviceNode>();
+    return vdevice && vdevice->target.defined() && vdevice->target->kind->name != "hexagon";
+  }
+
+  void VisitTopLevelBinding(const Binding& binding, int64_t index) {
+    static const Op& mem_alloc_storage = Op::Get("relax.memory.alloc_storage");
+    static const Op& mem_alloc_tensor = Op::Get("relax.memory.alloc_tensor");
+    static const Op& mem_kill_tensor = Op::Get("relax.memory.kill_tensor");
+    static const Op& mem_kill_storage = Op::Get("relax.memory.kill_storage");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    if (var_binding == nullptr) {
+      PostOrderVisit(binding.as<MatchCastNode>()->value, [this](const ObjectRef& obj) {
+        if (const auto* var = obj.as<VarNode>()) MarkEscaped(var);
+      });
+      return;
+    }
+    const VarNode* var = var_binding->var.get();
+    const Expr& value = var_binding->value;
+
+    // The aliases that memory planning leaves, e.g. `lv = alloc`.
+    if (const auto* alias = value.as<VarNode>()) {
+      if (Candidate* candidate = GetCandidate(alias)) {
+        storage_of_[var] = candidate->alloc;
+        candidate->last_use = index;
+      }
+      return;
+    }
+    const auto* call = value.as<CallNode>();
+    if (call != nullptr && call->op.same_as(mem_alloc_storage)) {
+      const auto* shape = call->args[0].as<ShapeExprNode>();
+      const auto* vdevice_index = call->args[1].as<PrimValueNode>();
+      const auto* scope = call->args[2].as<StringImmNode>();
+      if (shape == nullptr || shape->values.size() != 1 || vdevice_index == nullptr ||
+          scope == nullptr || scope->value != "global") {
+        return;
+      }
+      const auto* nbytes = shape->values[0].as<IntImmNode>();
+      const auto* device = vdevice_index->value.as<IntImmNode>();
+      if (nbytes == nullptr || device == nullptr || IsOnOtherDevice(device->value)) return;
+      Candidate candidate;
+      candidate.alloc = call;
+      candidate.nbytes =
+          (nbytes->value + kVTCMAllocAlignment - 1) / kVTCMAllocAlignment * kVTCMAllocAlignment;
+      candidate.begin = index;
+      candidate.last_use = index;
+      candidates_[call] = candidate;
+      storage_of_[var] = call;
+      return;
+    }
+    if (call != nullptr && call->op.same_as(mem_alloc_tensor)) {
+      if (Candidate* candidate = GetCandidate(call->args[0].as<VarNode>())) {
+        storage_of_[var] = candidate->alloc;
+        candidate->last_use = index;
+      }
+      for (size_t i = 1; i < call->args.size(); ++i) {
+        MarkEscapedIn(call->args[i]);
+      }
+      return;
+    }
+    if (call != nullptr &&
+        (call->op.same_as(mem_kill_tensor) || call->op.same_as(mem_kill_storage))) {
+      if (Candidate* candidate = GetCandidate(call->args[0].as<VarNode>())) {
+        candidate->last_use = index;
+      }
+      return;
+    }
+    tir::PrimFunc func;
+    ffi::Array<Expr> args;
+    if (GetKernelCall(value, &func, &args)) {
+      for (const Expr& arg : args) {
+        if (Candidate* candidate = GetCandidate(arg.as<VarNode>())) {
+          candidate->last_use = index;
+        } else {
+          MarkEscapedIn(arg);
+        }
+      }
+      return;
+    }
+    MarkEscapedIn(value);
+  }
+
+  Candidate* GetCandidate(const VarNode* var) {
+    if (var == nullptr) return nullptr;
+    auto it = storage_of_.find(var);
+    return it != storage_of_.end() ? &candidates_.at(it->second) : nullptr;
+  }
+
+  void MarkEscaped(const VarNode* var) {
+    if (Candidate* candidate = GetCandidate(var)) {
+      candidate->escaped = true;
+    }
+  }
+
+  void MarkEscapedIn(const Expr& expr) {
+    PostOrderVisit(expr, [this](const ObjectRef& obj) {
+      if (const auto* var = obj.as<VarNode>()) MarkEscaped(var);
+    });
+  }
+
+  /*! \brief The module. */
+  IRModule mod_;
+  /*! \brief The bytes of VTCM to plan the storages in. */
+  int64_t vtcm_capacity_;
+  /*! \brief The candidates, by their allocation. */
+  std::unordered_map<const CallNode*, Candidate> candidates_;
+  /*! \brief The allocations of the storages of the storage variables and the tensors in them. */
+  std::unordered_map<const VarNode*, const CallNode*> storage_of_;
+  /*! \brief The bytes of VTCM the kernels allocate. */
+  std::unordered_map<const Object*, int64_t> kernel_vtcm_bytes_;
+  /*! \brief The allocations placed in VTCM. */
+  std::unordered_set<const CallNode*> planned_;
+};
+
+namespace transform {
+
+Pass PlanVTCMStorage() {
+  auto pass_func = [=](Function func, IRModule mod, PassContext pc) {
+    int64_t vtcm_capacity = 0;
+    Target target = Target::Current(/*allow_not_defined=*/true);
+    if (target.defined()) {
+      if (target->kind->name != "hexagon") {
+        return func;
+      }
+      vtcm_capacity = target->GetAttr<Integer>("vtcm-capacity").value_or(Integer(0))->value;
+    }
+    if (vtcm_capacity <= 0) {
+      vtcm_capacity = pc->GetConfig<Integer>("tir.vtcm_capacity", Integer(0)).value()->value;
+    }
+    if (vtcm_capacity <= 0) {
+      return func;
+    }
+    return VTCMStoragePlanner(mod, vtcm_capacity).Plan(func);
+  };
+  return CreateFunctionPass(pass_func, /*opt_level=*/0, "PlanVTCMStorage", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.PlanVTCMStorage", PlanVTCMStorage);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -0,0 +1,326 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/transform/rematerialize.cc
+ * \brief Recompute cheap tensors near their late uses instead of keeping them alive.
+ * \details
+ * Training graphs produced by the Gradient pass keep every forward activation
+ * alive until its use in the backward pass. For each binding block, this pass
+ * estimates the memory profile of the tensors alive at each binding, and
+ * repeatedly picks, among the tensors alive without use across the peak, the
+ * one that is cheapest to recompute for the memory it frees. A tensor is only
+ * recomputed when
+ * - it is computed by a `R.call_tir` of a PrimFunc whose "op_pattern" (see
+ *   AnnotateTIROpPattern) is at most injective, so that recomputing it costs a
+ *   pass over memory rather than a GEMM or a reduction, and
+ * - the inputs of the computation are still alive at the recomputation site,
+ *   so that the recomputation does not extend other lifetimes.
+ *
+ * The uses of the tensor after the gap are rewritten to a copy of its binding
+ * placed right before the first of them. The planning stops when the peak is
+ * below the memory budget, or when no candidate can lower the peak.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/op_attr_types.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/utils.h>
+#include <tvm/tir/function.h>
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+namespace {
+
+/*! \brief The number of bytes of a tensor of static shape, or 0 for other values. */
+int64_t StaticTensorBytes(const StructInfo& sinfo) {
+  const auto* tensor = sinfo.as<TensorStructInfoNode>();
+  if (tensor == nullptr || tensor->IsUnknownDtype()) {
+    return 0;
+  }
+  const auto* shape = tensor->shape.as<ShapeExprNode>();
+  if (shape == nullptr) {
+    return 0;
+  }
+  int64_t bytes = tensor->dtype.bytes() * tensor->dtype.lanes();
+  for (const PrimExpr& dim : shape->values) {
+    const auto* int_dim = dim.as<IntImmNode>();
+    if (int_dim == nullptr) {
+      return 0;
+    }
+    bytes *= int_dim->value;
+  }
+  return bytes;
+}
+
+/*! \brief The bound value of a binding. */
+Expr BoundValue(const Binding& binding) {
+  if (const auto* var_binding = binding.as<VarBindingNode>()) {
+    return var_binding->value;
+  }
+  return Downcast<MatchCast>(binding)->value;
+}
+
+class Rematerializer {
+ public:
+  Rematerializer(IRModule mod, int64_t memory_budget)
+      : mod_(std::move(mod)), memory_budget_(memory_budget) {}
+
+  Function Transform(Function func) {
+    const auto* seq = func->body.as<SeqExprNode>();
+    if (seq == nullptr) {
+      return func;
+    }
+    // The vars used after each block never die inside the block.
+    std::vector<std::unordered_set<const VarNode*>> used_after(seq->blocks.size());
+    std::unordered_set<const VarNode*> used;
+    for (const Var& var : FreeVars(seq->body)) {
+      used.insert(var.get());
+    }
+    for (int i = static_cast<int>(seq->blocks.size()) - 1; i >= 0; --i) {
+      used_after[i] = used;
+      for (const Binding& binding : seq->blocks[i]->bindings) {
+        for (const Var& var : FreeVars(BoundValue(binding))) {
+          used.insert(var.get());
+        }
+      }
+    }
+
+    ffi::Array<BindingBlock> blocks;
+    bool changed = false;
+    for (size_t i = 0; i < seq->blocks.size(); ++i) {
+      BindingBlock block = seq->blocks[i];
+      std::vector<Binding> bindings(block->bindings.begin(), block->bindings.end());
+      if (Plan(&bindings, used_after[i], block->IsInstance<DataflowBlockNode>())) {
+        changed = true;
+        if (block->IsInstance<DataflowBlockNode>()) {
+          block = DataflowBlock(bindings, block->span);
+        } else {
+          block = BindingBlock(bindings, block->span);
+        }
+      }
+      blocks.push_back(block);
+    }
+    if (!changed) {
+      return func;
+    }
+    func.CopyOnWrite()->body = SeqExpr(blocks, seq->body, seq->span);
+    return func;
+  }
+
+ private:
+  /*! \brief The liveness of the tensors defined in a block. */
+  struct Liveness {
+    /*! \brief The binding indices of the uses of each var defined in the block. */
+    std::unordered_map<const VarNode*, std::vector<int>> uses;
+    /*! \brief The number of bytes alive at each binding. */
+    std::vector<int64_t> profile;
+  };
+
+  /*! \brief A tensor to recompute before the binding `site`, with the cost of doing so. */
+  struct Candidate {
+    int def;
+    int site;
+    double score;
+  };
+
+  /*!
+   * \brief Rematerialize the tensors of a block in place.
+   * \return Whether any tensor is rematerialized.
+   */
+  bool Plan(std::vector<Binding>* bindings, const std::unordered_set<const VarNode*>& used_after,
+            bool is_dataflow) {
+    bool changed = false;
+    for (size_t iter = 0; iter < bindings->size(); ++iter) {
+      Liveness liveness = Analyze(*bindings, used_after);
+      if (liveness.profile.empty()) {
+        break;
+      }
+      int peak = std::max_element(liveness.profile.begin(), liveness.profile.end()) -
+                 liveness.profile.begin();
+      if (memory_budget_ >= 0 && liveness.profile[peak] <= memory_budget_) {
+        break;
+      }
+      std::optional<Candidate> best;
+      for (int i = 0; i < static_cast<int>(bindings->size()); ++i) {
+        std::optional<Candidate> candidate = GetCandidate(*bindings, liveness, used_after, i, peak);
+        if (candidate.has_value() && (!best.has_value() || candidate->score > best->score)) {
+          best = candidate;
+        }
+      }
+      if (!best.has_value()) {
+        break;
+      }
+      Apply(bindings, best->def, best->site, is_dataflow);
+      changed = true;
+    }
+    return changed;
+  }
+
+  Liveness Analyze(const std::vector<Binding>& bindings,
+                   const std::unordered_set<const VarNode*>& used_after) {
+    Liveness liveness;
+    int n = bindings.size();
+    for (int i = 0; i < n; ++i) {
+      liveness.uses[bindings[i]->var.get()];
+      for (const Var& var : FreeVars(BoundValue(bindings[i]))) {
+        auto it = liveness.uses.find(var.get());
+        if (it != liveness.uses.end()) {
+          it->second.push_back(i);
+        }
+      }
+    }
+    // Accumulate the differences of the live bytes between consecutive bindings.
+    std::vector<int64_t> delta(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+      const Var& var = bindings[i]->var;
+      int64_t bytes = StaticTensorBytes(GetStructInfo(var));
+      const std::vector<int>& uses = liveness.uses[var.get()];
+      int last = used_after.count(var.get()) ? n - 1 : (uses.empty() ? i : uses.back());
+      delta[i] += bytes;
+      delta[last + 1] -= bytes;
+    }
+    liveness.profile.resize(n);
+    int64_t live_bytes = 0;
+    for (int i = 0; i < n; ++i) {
+      live_bytes += delta[i];
+      liveness.profile[i] = live_bytes;
+    }
+    return liveness;
+  }
+
+  /*!
+   * \brief Check if the tensor bound at `def` can be recomputed after the peak, so that it is
+   * not alive at the peak, and get the cost of doing so.
+   */
+  std::optional<Candidate> GetCandidate(const std::vector<Binding>& bindings,
+                                        const Liveness& liveness,
+                                        const std::unordered_set<const VarNode*>& used_after,
+                                        int def, int peak) {
+    const Var& var = bindings[def]->var;
+    int64_t bytes = StaticTensorBytes(GetStructInfo(var));
+    if (bytes == 0 || used_after.count(var.get()) || def >= peak) {
+      return std::nullopt;
+    }
+    const auto* binding = bindings[def].as<VarBindingNode>();
+    if (binding == nullptr || !IsCheapCallTIR(binding->value)) {
+      return std::nullopt;
+    }
+    // The tensor must have no use from the peak to the recomputation site.
+    const std::vector<int>& uses = liveness.uses.at(var.get());
+    auto it_site = std::upper_bound(uses.begin(), uses.end(), peak);
+    if (it_site == uses.end() || (it_site != uses.begin() && *std::prev(it_site) == peak)) {
+      return std::nullopt;
+    }
+    int site = *it_site;
+    // The inputs must still be alive at the recomputation site.
+    int64_t input_bytes = 0;
+    for (const Var& input : FreeVars(binding->value)) {
+      auto it = liveness.uses.find(input.get());
+      if (it == liveness.uses.end()) {
+        // Defined outside of the block, and thus alive throughout.
+        continue;
+      }
+      if (!used_after.count(input.get()) && (it->second.empty() || it->second.back() < site)) {
+        return std::nullopt;
+      }
+      input_bytes += StaticTensorBytes(GetStructInfo(input));
+    }
+    // The memory freed at the peak per byte of memory traffic of the recomputation.
+    double score = static_cast<double>(bytes) / static_cast<double>(bytes + input_bytes);
+    return Candidate{def, site, score};
+  }
+
+  /*! \brief Check if a value is a call_tir of a PrimFunc that is at most injective. */
+  bool IsCheapCallTIR(const Expr& value) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    const auto* call = value.as<CallNode>();
+    if (call == nullptr || !call->op.same_as(call_tir_op)) {
+      return false;
+    }
+    const auto* gv = call->args[0].as<GlobalVarNode>();
+    if (gv == nullptr || !mod_->ContainGlobalVar(gv->name_hint)) {
+      return false;
+    }
+    const auto* prim_func = mod_->Lookup(ffi::GetRef<GlobalVar>(gv)).as<tir::PrimFuncNode>();
+    if (prim_func == nullptr) {
+      return false;
+    }
+    ffi::Optional<Integer> pattern = prim_func->GetAttr<Integer>("op_pattern");
+    return pattern.has_value() && pattern.value()->value <= static_cast<int>(kInjective);
+  }
+
+  /*! \brief Recompute the tensor bound at `def` right before `site`, for the uses from there. */
+  void Apply(std::vector<Binding>* bindings, int def, int site, bool is_dataflow) {
+    const auto* binding = (*bindings)[def].as<VarBindingNode>();
+    const Var& var = binding->var;
+    ffi::String name = var->name_hint() + "_remat";
+    Var new_var = is_dataflow && var->IsInstance<DataflowVarNode>()
+                      ? DataflowVar(name, GetStructInfo(var))
+                      : Var(name, GetStructInfo(var));
+    ffi::Map<Var, Expr> remap{{var, new_var}};
+    for (size_t i = site; i < bindings->size(); ++i) {
+      const Binding& use = (*bindings)[i];
+      if (const auto* var_binding = use.as<VarBindingNode>()) {
+        (*bindings)[i] = VarBinding(var_binding->var, Bind(var_binding->value, remap),
+                                    var_binding->span);
+      } else {
+        MatchCast match_cast = Downcast<MatchCast>(use);
+        (*bindings)[i] = MatchCast(match_cast->var, Bind(match_cast->value, remap),
+                                   match_cast->struct_info, match_cast->span);
+      }
+    }
+    bindings->insert(bindings->begin() + site, VarBinding(new_var, binding->value));
+  }
+
+  /*! \brief The module, to look up the op patterns of the PrimFuncs. */
+  IRModule mod_;
+  /*! \brief The memory budget in bytes, or -1 to lower the peak as much as possible. */
+  int64_t memory_budget_;
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass Rematerialize(int64_t memory_budget) {
+  auto pass_func = [=](Function func, IRModule mod, PassContext pc) {
+    return Rematerializer(mod, memory_budget).Transform(std::move(func));
+  };
+  return CreateFunctionPass(/*pass_function=*/pass_func,
+                            /*opt_level=*/0,
+                            /*pass_name=*/"Rematerialize",
+                            /*required=*/{});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.Rematerialize", Rematerialize);
+}
+
+}  // namespace transform
+
+}  // namespace relax
+}  // namespace tvm
@@ -48,15 +48,28 @@
  *
  * 2. Lift the regions identified in step 1 to a separate function and rewrite the original function
  * with `CUDAGraphRewriter`.
+ *
+ * Regions that depend on symbolic variables are captured once per value of the variables. When a
+ * function annotates buckets for a variable with the
+ * 'relax.rewrite_cuda_graph.capture_symbolic_var_buckets' attribute, e.g. the padded batch sizes
+ * of a decode function, only the bucket values are captured and the other values run the region
+ * without CUDA graph. The 'relax.rewrite_cuda_graph.max_num_graphs' attribute bounds the number
+ * of graphs kept for each region, evicting the least recently launched one. Note that the
+ * storage of the region must still be static, e.g. planned with the upper bounds of the variables.
+ *
+ * Under a ROCm target, the lifted regions are launched with HIP graphs by the
+ * 'vm.builtin.hip_graph' builtins instead of the 'vm.builtin.cuda_graph' ones.
  */
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/relax/analysis.h>
 #include <tvm/relax/backend.h>
 #include <tvm/relax/expr_functor.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/expr_functor.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -68,6 +81,12 @@ namespace relax {
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relax.backend.use_cuda_graph", Bool);
 
+/*! \brief The function attribute of the buckets of the captured symbolic variables. */
+constexpr const char* kCaptureSymbolicVarBuckets =
+    "relax.rewrite_cuda_graph.capture_symbolic_var_buckets";
+/*! \brief The function attribute of the maximum number of graphs kept for each region. */
+constexpr const char* kMaxNumGraphs = "relax.rewrite_cuda_graph.max_num_graphs";
+
 /*! \brief The rewriting plan of lifting a region for either allocation or capturing for cuda graph
  * execution
  */
@@ -311,7 +330,16 @@ class CUDAGraphRewritePlanner : public ExprVisitor {
         func->attrs
             .GetAttr<ffi::Array<ffi::String>>("relax.rewrite_cuda_graph.capture_symbolic_vars")
             .value_or(ffi::Array<ffi::String>());
-    return {symbolic_var_names.begin(), symbolic_var_names.end()};
+    std::unordered_set<ffi::String> hints{symbolic_var_names.begin(), symbolic_var_names.end()};
+    // The bucketed variables are captured as well
+    if (auto buckets =
+            func->attrs.GetAttr<ffi::Map<ffi::String, ffi::Array<Integer>>>(
+                kCaptureSymbolicVarBuckets)) {
+      for (const auto& [name, _] : buckets.value()) {
+        hints.insert(name);
+      }
+    }
+    return hints;
   }
 
   /*!
@@ -736,7 +764,13 @@ Function MergeAllocationPlans(const std::vector<LiftedFunctionRewritePlan*>& all
 /*! \brief The rewriter for CUDA graph */
 class CUDAGraphRewriter : public ExprMutator {
  public:
-  explicit CUDAGraphRewriter(const IRModule& mod) : ExprMutator(mod) {}
+  explicit CUDAGraphRewriter(const IRModule& mod) : ExprMutator(mod) {
+    // The regions of ROCm are launched with HIP graphs by the builtins of the same interface.
+    Target target = Target::Current(/*allow_not_defined=*/true);
+    if (target.defined() && target->kind->name == "rocm") {
+      builtin_prefix_ = "vm.builtin.hip_graph";
+    }
+  }
 
   IRModule Rewrite() {
     CUDAGraphRewritePlanner planner(builder_->GetContextIRModule(), &arena_);
@@ -773,9 +807,8 @@ class CUDAGraphRewriter : public ExprMutator {
 
   void LaunchSubgraph(const VarBindingNode* op, const LiftedFunctionRewritePlan* plan) {
     static const auto& call_builtin_with_ctx_op = Op::Get("relax.call_builtin_with_ctx");
-    static const auto& builtin_run_or_capture = ExternFunc("vm.builtin.cuda_graph.run_or_capture");
-    static const auto& builtin_get_cached_alloc =
-        ExternFunc("vm.builtin.cuda_graph.get_cached_alloc");
+    ExternFunc builtin_run_or_capture(builtin_prefix_ + ".run_or_capture");
+    ExternFunc builtin_get_cached_alloc(builtin_prefix_ + ".get_cached_alloc");
 
     Expr launch_subgraph;
     if (plan->is_alloc) {
@@ -815,11 +848,35 @@ class CUDAGraphRewriter : public ExprMutator {
       // Arguments of builtin_run_or_capture
       ffi::Array<Expr> tuple_arg_fields{gv_func, Tuple(args),
                                         PrimValue(IntImm(DataType::Int(64), index_capture_++))};
-      if (plan->propogated_tir_vars.defined()) {
+      auto func =
+          Downcast<Function>(builder_->GetContextIRModule()->Lookup(current_func_.value()));
+      auto buckets =
+          func->GetAttr<ffi::Map<ffi::String, ffi::Array<Integer>>>(kCaptureSymbolicVarBuckets);
+      auto max_num_graphs = func->GetAttr<Integer>(kMaxNumGraphs);
+      if (plan->propogated_tir_vars.defined() || max_num_graphs.has_value()) {
         // The shape expr is explicitly passed twice, one as the last argument of the lifted
         // function, one as the last argument of builtin_run_or_capture as the cache key. Explicitly
         // passing it twice simplifies the handling during the capture phase.
-        tuple_arg_fields.push_back(plan->propogated_tir_vars.value());
+        tuple_arg_fields.push_back(plan->propogated_tir_vars.value_or(ShapeExpr({})));
+      }
+      if (buckets.has_value() || max_num_graphs.has_value()) {
+        // The buckets of each symbolic variable of the shape expr, empty for any value
+        ffi::Array<Expr> var_buckets;
+        if (plan->propogated_tir_vars.defined()) {
+          for (const PrimExpr& value : plan->propogated_tir_vars.value()->values) {
+            ffi::Array<PrimExpr> bucket_values;
+            auto name = Downcast<tir::Var>(value)->name_hint;
+            if (buckets.has_value() && buckets.value().count(name)) {
+              for (const Integer& bucket : buckets.value().at(name)) {
+                bucket_values.push_back(IntImm(DataType::Int(64), bucket->value));
+              }
+            }
+            var_buckets.push_back(ShapeExpr(bucket_values));
+          }
+        }
+        tuple_arg_fields.push_back(Tuple(var_buckets));
+        tuple_arg_fields.push_back(
+            PrimValue(IntImm(DataType::Int(64), max_num_graphs.value_or(Integer(0))->value)));
       }
       launch_subgraph =
           Call(call_builtin_with_ctx_op, {builtin_run_or_capture, Tuple(tuple_arg_fields)}, Attrs(),
@@ -876,6 +933,8 @@ class CUDAGraphRewriter : public ExprMutator {
   support::Arena arena_;
   ffi::Optional<GlobalVar> gv_global_alloc_ = std::nullopt;
   ffi::Optional<GlobalVar> current_func_ = std::nullopt;
+  /*! \brief The prefix of the VM builtins launching the lifted regions with the graphs */
+  std::string builtin_prefix_ = "vm.builtin.cuda_graph";
 };
 
 IRModule RewriteCUDAGraph(IRModule mod) {
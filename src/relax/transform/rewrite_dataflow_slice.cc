@@ -0,0 +1,279 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/transform/rewrite_dataflow_slice.cc
+ * \brief Transform the slices of a contiguous range of a tensor within dataflow blocks to views
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "../op/memory/view.h"
+
+namespace tvm {
+namespace relax {
+
+std::vector<size_t> GetUsedTensorArgIndices(const tir::PrimFunc& fn, size_t num_args);
+
+/*!
+ * \brief Get the offset in the source buffer of each destination buffer, in number of elements,
+ *  when the PrimFunc only copies a contiguous range of the source to each destination. It is the
+ *  case of the strided_slice with unit strides whose outer axes have a single index, e.g. the slice
+ *  of a range of rows, and of the split along such an axis, e.g. the QKV split of a single token.
+ * \return The offsets, or std::nullopt if the PrimFunc is not such a copy.
+ */
+ffi::Optional<ffi::Array<PrimExpr>> GetContiguousCopyOffsets(const tir::PrimFunc& func,
+                                                             const tir::Buffer& src,
+                                                             const ffi::Array<tir::Buffer>& dsts) {
+  std::unordered_map<const tir::BufferNode*, const tir::SBlockNode*> copy_blocks;
+  int num_stores = 0;
+  tir::PostOrderVisit(func->body, [&](const ObjectRef& node) {
+    if (node->IsInstance<tir::BufferStoreNode>()) {
+      ++num_stores;
+    } else if (const auto* block = node.as<tir::SBlockNode>()) {
+      if (const auto* store = block->body.as<tir::BufferStoreNode>()) {
+        copy_blocks[store->buffer.get()] = block;
+      }
+    }
+  });
+  // Each destination is written by a single block, and nothing else is written.
+  if (num_stores != static_cast<int>(dsts.size())) {
+    return std::nullopt;
+  }
+  auto f_flatten = [](const tir::Buffer& buffer, const ffi::Array<PrimExpr>& indices) {
+    PrimExpr idx = IntImm(DataType::Int(64), 0);
+    for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+      idx = idx * buffer->shape[i] + indices[i];
+    }
+    return idx;
+  };
+  ffi::Array<PrimExpr> offsets;
+  for (const tir::Buffer& dst : dsts) {
+    auto it = copy_blocks.find(dst.get());
+    if (it == copy_blocks.end()) {
+      return std::nullopt;
+    }
+    const tir::SBlockNode* block = it->second;
+    const auto* store = block->body.as<tir::BufferStoreNode>();
+    const auto* load = store->value.as<tir::BufferLoadNode>();
+    if (block->init.defined() || load == nullptr || !load->buffer.same_as(src) ||
+        store->indices.size() != block->iter_vars.size() ||
+        store->indices.size() != dst->shape.size()) {
+      return std::nullopt;
+    }
+    // The block writes every element of the destination once, in order.
+    arith::Analyzer analyzer;
+    for (int i = 0; i < static_cast<int>(block->iter_vars.size()); ++i) {
+      const tir::IterVar& iter = block->iter_vars[i];
+      if (iter->iter_type != tir::IterVarType::kDataPar || !store->indices[i].same_as(iter->var) ||
+          !analyzer.CanProveEqual(iter->dom->min, 0) ||
+          !analyzer.CanProveEqual(iter->dom->extent, dst->shape[i])) {
+        return std::nullopt;
+      }
+      analyzer.Bind(iter->var, iter->dom);
+    }
+    // The element read is at a constant distance of the element written in the flattened buffers,
+    // so that the destination is the contiguous range of the source starting at that distance.
+    PrimExpr offset =
+        analyzer.Simplify(f_flatten(src, load->indices) - f_flatten(dst, store->indices));
+    for (const tir::IterVar& iter : block->iter_vars) {
+      if (tir::UsesVar(offset, [&](const tir::VarNode* var) { return var == iter->var.get(); })) {
+        return std::nullopt;
+      }
+    }
+    offsets.push_back(offset);
+  }
+  return offsets;
+}
+
+class DataflowSliceRewriter : public ExprMutator {
+ public:
+  explicit DataflowSliceRewriter(const IRModule& mod) : mod_(mod) {}
+
+ private:
+  using ExprMutator::VisitExpr_;
+
+  BindingBlock VisitBindingBlock(const BindingBlock& block) final {
+    // We only rewrite the bindings inside dataflow blocks.
+    if (const auto* dataflow_block = block.as<DataflowBlockNode>()) {
+      return VisitBindingBlock_(dataflow_block);
+    } else {
+      return block;
+    }
+  }
+
+  void VisitBinding_(const VarBindingNode* binding) final {
+    // As for the reshapes, the views are only created for the bindings that are not dataflow
+    // output, so that a tensor returned never aliases another one.
+    if (!binding->var->IsInstance<DataflowVarNode>()) {
+      this->builder_->EmitNormalized(ffi::GetRef<VarBinding>(binding));
+    } else {
+      ExprMutator::VisitBinding_(binding);
+    }
+  }
+
+  Expr VisitExpr_(const CallNode* call) final {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    if (call->op != call_tir_op) {
+      return ffi::GetRef<Call>(call);
+    }
+    auto prim_fn = Downcast<tir::PrimFunc>(mod_->Lookup(Downcast<GlobalVar>(call->args[0])));
+    auto arg_tuple = Downcast<Tuple>(call->args[1])->fields;
+    auto used_tensor_arg_indices = GetUsedTensorArgIndices(prim_fn, arg_tuple.size());
+    if (used_tensor_arg_indices.size() != 1) {
+      return ffi::GetRef<Call>(call);
+    }
+    Expr arg = arg_tuple[used_tensor_arg_indices[0]];
+    const auto* arg_sinfo = GetStructInfoAs<TensorStructInfoNode>(arg);
+    if (arg_sinfo == nullptr || arg_sinfo->IsUnknownDtype() || arg_sinfo->dtype.lanes() != 1 ||
+        arg_sinfo->dtype.bits() % 8 != 0) {
+      return ffi::GetRef<Call>(call);
+    }
+
+    ffi::Array<TensorStructInfo> res_sinfos;
+    if (const auto* tuple_sinfo = GetStructInfoAs<TupleStructInfoNode>(ffi::GetRef<Call>(call))) {
+      for (const StructInfo& field : tuple_sinfo->fields) {
+        res_sinfos.push_back(Downcast<TensorStructInfo>(field));
+      }
+    } else {
+      res_sinfos.push_back(Downcast<TensorStructInfo>(GetStructInfo(ffi::GetRef<Call>(call))));
+    }
+    size_t num_buffers = arg_tuple.size() + res_sinfos.size();
+    if (prim_fn->params.size() < num_buffers) {
+      return ffi::GetRef<Call>(call);
+    }
+
+    // The symbolic shapes of the PrimFunc are the ones of the call site.
+    ffi::Map<tir::Var, PrimExpr> var_map;
+    auto f_bind_shape = [&var_map](const tir::Buffer& buffer, const TensorStructInfo& sinfo) {
+      ffi::Optional<ffi::Array<PrimExpr>> shape = sinfo->GetShape();
+      if (!shape.defined() || shape.value().size() != buffer->shape.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < buffer->shape.size(); ++i) {
+        if (const auto* var = buffer->shape[i].as<tir::VarNode>()) {
+          if (!var_map.count(ffi::GetRef<tir::Var>(var))) {
+            var_map.Set(ffi::GetRef<tir::Var>(var), shape.value()[i]);
+          }
+        }
+      }
+      return true;
+    };
+    ffi::Optional<tir::Buffer> src =
+        prim_fn->buffer_map.Get(prim_fn->params[used_tensor_arg_indices[0]]);
+    if (!src || !f_bind_shape(src.value(), ffi::GetRef<TensorStructInfo>(arg_sinfo))) {
+      return ffi::GetRef<Call>(call);
+    }
+    ffi::Array<tir::Buffer> dsts;
+    for (size_t i = 0; i < res_sinfos.size(); ++i) {
+      ffi::Optional<tir::Buffer> dst =
+          prim_fn->buffer_map.Get(prim_fn->params[arg_tuple.size() + i]);
+      if (!dst || dst.value()->dtype != src.value()->dtype ||
+          res_sinfos[i]->dtype != arg_sinfo->dtype || !f_bind_shape(dst.value(), res_sinfos[i])) {
+        return ffi::GetRef<Call>(call);
+      }
+      dsts.push_back(dst.value());
+    }
+    if (call->args.size() > 2) {
+      ffi::Array<PrimExpr> tir_vars = Downcast<ShapeExpr>(call->args[2])->values;
+      for (size_t i = 0; i < tir_vars.size() && num_buffers + i < prim_fn->params.size(); ++i) {
+        var_map.Set(prim_fn->params[num_buffers + i], tir_vars[i]);
+      }
+    }
+
+    ffi::Optional<ffi::Array<PrimExpr>> offsets =
+        GetContiguousCopyOffsets(prim_fn, src.value(), dsts);
+    if (!offsets.defined()) {
+      return ffi::GetRef<Call>(call);
+    }
+    arith::Analyzer analyzer;
+    IntImm data_bytes(DataType::Int(64), arg_sinfo->dtype.bytes());
+    IntImm alignment(DataType::Int(64), runtime::kAllocAlignment);
+    ffi::Array<PrimExpr> byte_offsets;
+    for (const PrimExpr& offset : offsets.value()) {
+      for (const tir::Var& var : tir::UndefinedVars(offset)) {
+        if (!var_map.count(var)) {
+          return ffi::GetRef<Call>(call);
+        }
+      }
+      PrimExpr byte_offset =
+          analyzer.Simplify(cast(DataType::Int(64), tir::Substitute(offset, var_map)) * data_bytes);
+      // The kernels require the tensors to start at an offset of zero from their data pointer,
+      // which a view then gets without a copy only if its offset keeps the alignment.
+      if (!analyzer.CanProveEqual(floormod(byte_offset, alignment), 0)) {
+        return ffi::GetRef<Call>(call);
+      }
+      byte_offsets.push_back(byte_offset);
+    }
+
+    // The copies are brought to views of the input, which are lowered to the ExternFunc
+    // runtime.TVMTensorCreateView in the LowerRuntimeBuiltin pass.
+    ffi::Array<Expr> views;
+    for (size_t i = 0; i < res_sinfos.size(); ++i) {
+      Expr view_expr = view(arg, ShapeExpr(res_sinfos[i]->GetShape().value()), std::nullopt,
+                            PrimValue(byte_offsets[i]));
+      if (!analyzer.CanProveEqual(byte_offsets[i], 0)) {
+        view_expr = ensure_zero_offset(builder_->Emit(view_expr));
+      }
+      views.push_back(view_expr);
+    }
+    if (views.size() == 1 && !call->struct_info_.as<TupleStructInfoNode>()) {
+      return views[0];
+    }
+    ffi::Array<Expr> fields;
+    for (const Expr& view_expr : views) {
+      fields.push_back(builder_->Emit(view_expr));
+    }
+    return Tuple(fields);
+  }
+
+  const IRModule& mod_;
+};
+
+Expr RewriteDataflowSlice(const Function& f, const IRModule& mod) {
+  return DataflowSliceRewriter(mod)(f);
+}
+
+namespace transform {
+
+Pass RewriteDataflowSlice() {
+  auto pass_func = [=](Function f, IRModule m, PassContext pc) {
+    return Downcast<Function>(RewriteDataflowSlice(f, m));
+  };
+  return CreateFunctionPass(pass_func, 0, "RewriteDataflowSlice", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.RewriteDataflowSlice", RewriteDataflowSlice);
+}
+
+}  // namespace transform
+
+}  // namespace relax
+}  // namespace tvm
@@ -0,0 +1,232 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/specialize_primfunc_shapes.cc
+ * \brief Specialize the symbolic shapes of the PrimFuncs to the constant shapes of their call
+ *  sites.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/structural_equal.h>
+#include <tvm/ir/structural_hash.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+using tvm::tir::Buffer;
+
+class PrimFuncShapeSpecializer : public ExprMutator {
+ public:
+  explicit PrimFuncShapeSpecializer(IRModule mod) : ExprMutator(mod), mod_(mod) {}
+
+  IRModule Run() {
+    for (const auto& [gvar, func] : mod_->functions) {
+      if (const auto* relax_func = func.as<FunctionNode>()) {
+        if (relax_func->HasNonzeroAttr(attr::kPrimitive)) {
+          continue;
+        }
+        auto new_func = Downcast<Function>(VisitExpr(ffi::GetRef<Function>(relax_func)));
+        if (!new_func.same_as(func)) {
+          builder_->UpdateFunction(gvar, new_func);
+        }
+      }
+    }
+    RemoveUnusedCallees();
+    return builder_->GetContextIRModule();
+  }
+
+  using ExprMutator::VisitExpr_;
+
+  Expr VisitExpr_(const CallNode* op) final {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    Call call = Downcast<Call>(ExprMutator::VisitExpr_(op));
+    if (!call->op.same_as(call_tir_op)) {
+      return call;
+    }
+    auto gvar = Downcast<GlobalVar>(call->args[0]);
+    auto opt_func = mod_->Lookup(gvar).as<tir::PrimFunc>();
+    if (!opt_func) {
+      return call;
+    }
+    tir::PrimFunc func = opt_func.value();
+
+    // The struct info of the tensors passed to the parameters, the inputs then the outputs.
+    ffi::Array<StructInfo> tensor_sinfo;
+    for (const Expr& arg : Downcast<Tuple>(call->args[1])->fields) {
+      tensor_sinfo.push_back(GetStructInfo(arg));
+    }
+    if (const auto* tuple = call->sinfo_args[0].as<TupleStructInfoNode>()) {
+      for (const StructInfo& field : tuple->fields) {
+        tensor_sinfo.push_back(field);
+      }
+    } else {
+      tensor_sinfo.push_back(call->sinfo_args[0]);
+    }
+    if (tensor_sinfo.size() > func->params.size()) {
+      return call;
+    }
+
+    ffi::Map<tir::Var, ffi::Variant<Buffer, PrimExpr>> param_map;
+    std::unordered_map<const tir::VarNode*, int64_t> var_values;
+    for (size_t i = 0; i < tensor_sinfo.size(); ++i) {
+      auto opt_buffer = func->buffer_map.Get(func->params[i]);
+      const auto* sinfo = tensor_sinfo[i].as<TensorStructInfoNode>();
+      if (!opt_buffer || !sinfo) {
+        return call;
+      }
+      ffi::Optional<ffi::Array<PrimExpr>> shape = sinfo->GetShape();
+      Buffer buffer = opt_buffer.value();
+      if (!shape || shape.value().size() != buffer->shape.size()) {
+        return call;
+      }
+      ffi::Array<PrimExpr> new_shape;
+      for (size_t k = 0; k < buffer->shape.size(); ++k) {
+        const auto* var = buffer->shape[k].as<tir::VarNode>();
+        const auto* value = shape.value()[k].as<IntImmNode>();
+        if (var == nullptr || value == nullptr) {
+          new_shape.push_back(buffer->shape[k]);
+          continue;
+        }
+        auto [it, inserted] = var_values.emplace(var, value->value);
+        if (!inserted && it->second != value->value) {
+          // The call site disagrees with itself, leave it to the well-formed checks.
+          return call;
+        }
+        new_shape.push_back(IntImm(var->dtype, value->value));
+      }
+      if (!new_shape.same_as(buffer->shape)) {
+        ObjectPtr<tir::BufferNode> n = ffi::make_object<tir::BufferNode>(*buffer.get());
+        n->shape = new_shape;
+        param_map.Set(func->params[i], Buffer(n));
+      }
+    }
+    if (param_map.empty()) {
+      return call;
+    }
+
+    // The symbolic variables that are passed as tir_vars are removed from the parameters once
+    // they are specialized, so they are removed from the call too.
+    ffi::Array<Expr> new_args = {call->args[0], call->args[1]};
+    if (call->args.size() > 2) {
+      auto tir_vars = Downcast<ShapeExpr>(call->args[2])->values;
+      size_t num_tensors = tensor_sinfo.size();
+      if (num_tensors + tir_vars.size() != func->params.size()) {
+        return call;
+      }
+      ffi::Array<PrimExpr> new_tir_vars;
+      for (size_t i = 0; i < tir_vars.size(); ++i) {
+        if (!var_values.count(func->params[num_tensors + i].get())) {
+          new_tir_vars.push_back(tir_vars[i]);
+        }
+      }
+      if (new_tir_vars.size()) {
+        new_args.push_back(ShapeExpr(new_tir_vars));
+      }
+    }
+
+    GlobalVar new_gvar = GetSpecializedFunc(gvar, tir::Specialize(func, param_map));
+    new_args.Set(0, new_gvar);
+    specialized_callees_.insert(gvar);
+    return Call(call->op, new_args, call->attrs, call->sinfo_args, call->span);
+  }
+
+ private:
+  /*! \brief Get the GlobalVar of a specialized PrimFunc, adding it if it is not added yet. */
+  GlobalVar GetSpecializedFunc(const GlobalVar& gvar, tir::PrimFunc func) {
+    auto it = specialized_funcs_.find(func);
+    if (it != specialized_funcs_.end()) {
+      return it->second;
+    }
+    std::string name = std::string(gvar->name_hint) + "_specialized";
+    GlobalVar new_gvar = builder_->AddFunction(func, name);
+    specialized_funcs_.emplace(func, new_gvar);
+    // The global symbol has to be unique, and to match the name of the variable.
+    if (func->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol)) {
+      builder_->UpdateFunction(new_gvar, WithAttr(std::move(func), tvm::attr::kGlobalSymbol,
+                                                  new_gvar->name_hint));
+    }
+    return new_gvar;
+  }
+
+  /*! \brief Remove the specialized PrimFuncs that are neither called nor externally visible. */
+  void RemoveUnusedCallees() {
+    IRModule mod = builder_->GetContextIRModule();
+    std::unordered_set<const GlobalVarNode*> used;
+    for (const auto& [gvar, func] : mod->functions) {
+      if (const auto* relax_func = func.as<FunctionNode>()) {
+        PostOrderVisit(ffi::GetRef<Function>(relax_func), [&used](const Expr& e) {
+          if (const auto* callee = e.as<GlobalVarNode>()) {
+            used.insert(callee);
+          }
+        });
+      } else if (const auto* prim_func = func.as<tir::PrimFuncNode>()) {
+        tir::PostOrderVisit(prim_func->body, [&used](const ObjectRef& node) {
+          if (const auto* call = node.as<tir::CallNode>()) {
+            if (const auto* callee = call->op.as<GlobalVarNode>()) {
+              used.insert(callee);
+            }
+          }
+        });
+      }
+    }
+    for (const GlobalVar& gvar : specialized_callees_) {
+      if (!used.count(gvar.get()) &&
+          !mod->Lookup(gvar)->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol)) {
+        mod->Remove(gvar);
+      }
+    }
+  }
+
+  /*! \brief The input module. */
+  IRModule mod_;
+  /*! \brief The specialized PrimFuncs, deduplicated across the call sites. */
+  std::unordered_map<tir::PrimFunc, GlobalVar, StructuralHash, StructuralEqual> specialized_funcs_;
+  /*! \brief The PrimFuncs that have a specialized version. */
+  std::unordered_set<GlobalVar, ObjectPtrHash, ObjectPtrEqual> specialized_callees_;
+};
+
+namespace transform {
+
+Pass SpecializePrimFuncShapes() {
+  auto pass_func = [=](IRModule mod, PassContext pc) {
+    return PrimFuncShapeSpecializer(mod).Run();
+  };
+  return CreateModulePass(/*pass_function=*/pass_func,
+                          /*opt_level=*/0,
+                          /*pass_name=*/"SpecializePrimFuncShapes",
+                          /*required=*/{});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.SpecializePrimFuncShapes", SpecializePrimFuncShapes);
+}
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -52,6 +52,34 @@
  * including dynamically-sized tensors, without requiring that
  * `StaticPlanBlockMemory` track these dynamic-sized tensors.
  *
+ * When the pass config "relax.StaticPlanBlockMemory.arena" is enabled, the
+ * constant-size global tensors allocated in the non-dataflow binding blocks at
+ * the top level of a function are planned differently. Each of them gets its
+ * own token, whose lifetime spans from its allocation to its release. After a
+ * function is visited, the tokens are packed into one arena per device by
+ * placing the largest tokens first, each at the tightest gap among the tokens
+ * whose lifetimes overlap with it. The rewrite then emits a single
+ * `memory.alloc_storage` of the arena, and each `memory.alloc_tensor` takes
+ * its computed offset in the arena.
+ *
+ * With the pass config "relax.StaticPlanBlockMemory.shared_arena_funcs"
+ * listing the functions of a module that never run concurrently (e.g. the
+ * prefill and decode entry points of an LLM), the arenas of these functions
+ * are planned as above and share one workspace per device, sized to the
+ * largest of their arenas. The workspace is obtained through the VM builtin
+ * `vm.builtin.alloc_shared_workspace`, which keeps it alive across calls, so
+ * that the resident memory is the maximum rather than the sum of the arenas.
+ * The listed functions must not call each other.
+ *
+ * With the pass config "relax.StaticPlanBlockMemory.dynamic_arena" enabled,
+ * arena planning also computes symbolic offsets and sizes for the arenas that
+ * hold tensors of dynamic shapes. The placement is decided on the upper bounds
+ * of the tensor sizes, and each tensor is then offset right above the actual
+ * sizes of the overlapping tensors placed below it. Such an arena is
+ * obtained as a workspace of `vm.builtin.alloc_shared_workspace`, which is
+ * allocated at the actual size on the first call and grown geometrically, so
+ * that short sequences do not pay for the upper bounds.
+ *
  * The memory planning pass "supports" dynamic shape in the way of TIR variable
  * upper bound annotation. To be more specific, we can annotate the attribute
  * "tir_var_upper_bound" to Relax functions. The attribute value is a dict from
@@ -66,15 +94,20 @@
  * during memory planning.
  */
 #include <tvm/arith/analyzer.h>
+#include <tvm/ffi/extra/structural_equal.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/relax/analysis.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/nested_msg.h>
 #include <tvm/relax/transform.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "../../runtime/texture.h"
@@ -112,6 +145,11 @@ class StorageTokenNode : public Object {
   ffi::Optional<VDevice> vdevice;
   /*! \brief The storage id, reserved for debug and demo use. */
   int storage_id{-1};
+  /*!
+   * \brief The number of bytes at the actual tensor shape when it is symbolic,
+   * in which case `bytes` is its upper bound.
+   */
+  ffi::Optional<PrimExpr> symbolic_bytes;
 
   /*! \brief Get the constant number of bytes that this token requires, or -1 if the number of bytes
    * is symbolic */
@@ -653,6 +691,14 @@ class StorageAllocatorInit : public StorageAllocatorBaseVisitor {
     ffi::Optional<VDevice> vdevice = GetGlobalVDevice(ctx_mod_, vdevice_index);
 
     StorageToken token(upper_bounded_shape, sinfo->dtype, storage_scope->value, vdevice);
+    if (!IsStaticShape(shape->values) && token->storage_scope == "global") {
+      PrimExpr bytes =
+          tir::make_const(DataType::Int(64), sinfo->dtype.bytes() * sinfo->dtype.lanes());
+      for (const PrimExpr& dim_len : shape->values) {
+        bytes *= cast(DataType::Int(64), dim_len);
+      }
+      token->symbolic_bytes = analyzer_->Simplify(bytes);
+    }
 
     Tokens tokens(token);
     SetTokens(call, tokens);
@@ -749,20 +795,68 @@ class StorageAllocatorInit : public StorageAllocatorBaseVisitor {
 class StorageAllocator : public StorageAllocatorBaseVisitor {
  public:
   explicit StorageAllocator(std::unordered_map<const ExprNode*, Tokens> token_map,
-                            arith::Analyzer* analyzer)
-      : allocator_(analyzer) {
+                            arith::Analyzer* analyzer, bool arena, bool dynamic_arena,
+                            std::unordered_set<std::string> shared_arena_funcs)
+      : allocator_(analyzer),
+        analyzer_(analyzer),
+        arena_(arena || dynamic_arena),
+        dynamic_arena_(dynamic_arena),
+        shared_arena_funcs_(std::move(shared_arena_funcs)) {
     this->token_map_ = std::move(token_map);
   }
 
   void Allocate(const IRModule& mod) {
+    // The VDevice and the size in bytes of each shared workspace.
+    std::vector<std::pair<ffi::Optional<VDevice>, int64_t>> workspaces;
+    std::vector<StorageToken> shared_arenas;
+    std::vector<StorageToken> dynamic_arenas;
     for (auto it : mod->functions) {
       const auto* func = it.second.as<FunctionNode>();
       if (func == nullptr) {
         continue;
       }
+      bool shared = shared_arena_funcs_.count(it.first->name_hint);
       // Clear the allocator to make the planning of different functions independent.
       allocator_.Clear();
+      arena_blocks_.clear();
+      if (const auto* seq = func->body.as<SeqExprNode>(); (arena_ || shared) && seq != nullptr) {
+        for (const BindingBlock& block : seq->blocks) {
+          if (!block->IsInstance<DataflowBlockNode>()) {
+            arena_blocks_.insert(block.get());
+          }
+        }
+      }
       this->VisitExpr_(func);
+      // Shared workspaces are sized statically, to the largest upper bound of their arenas.
+      std::vector<StorageToken> arenas = this->PlanArenas(dynamic_arena_ && !shared);
+      if (!shared) {
+        for (const StorageToken& arena : arenas) {
+          if (arena->const_bytes() == -1) {
+            dynamic_arenas.push_back(arena);
+          }
+        }
+        continue;
+      }
+      for (const StorageToken& arena : arenas) {
+        auto it_ws = std::find_if(workspaces.begin(), workspaces.end(), [&](const auto& ws) {
+          return ffi::StructuralEqual()(ws.first, arena->vdevice);
+        });
+        if (it_ws == workspaces.end()) {
+          it_ws = workspaces.insert(workspaces.end(), {arena->vdevice, int64_t{0}});
+        }
+        it_ws->second = std::max(it_ws->second, arena->const_bytes());
+        arena2workspace[arena.get()] = it_ws - workspaces.begin();
+        shared_arenas.push_back(arena);
+      }
+    }
+    // Every arena of a shared workspace requests the size of the workspace.
+    for (StorageToken& arena : shared_arenas) {
+      arena->bytes =
+          tir::make_const(DataType::Int(64), workspaces[arena2workspace[arena.get()]].second);
+    }
+    // Each dynamic arena has a workspace of its own, kept by the VM to be grown on demand.
+    for (size_t i = 0; i < dynamic_arenas.size(); ++i) {
+      arena2workspace[dynamic_arenas[i].get()] = workspaces.size() + i;
     }
   }
 
@@ -773,8 +867,19 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
   std::unordered_map<const ExprNode*, StorageToken> alloc_tensor2token;
   /*! \brief The mapping from each binding block to the storage tokens that are create inside. */
   std::unordered_map<const BindingBlockNode*, std::vector<const StorageTokenNode*>> block2tokens;
+  /*! \brief The mapping from each arena-planned token to its arena and its offset in the arena. */
+  std::unordered_map<const StorageTokenNode*, std::pair<StorageToken, PrimExpr>> token2arena;
+  /*! \brief The mapping from each arena obtained as a VM workspace to the workspace index. */
+  std::unordered_map<const StorageTokenNode*, int> arena2workspace;
 
  private:
+  /*! \brief An arena token, with the binding indices of its allocation and its release. */
+  struct ArenaItem {
+    StorageToken token;
+    int start;
+    int end;
+  };
+
   using ExprVisitor::VisitBinding_;
   using ExprVisitor::VisitExpr_;
 
@@ -789,6 +894,7 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call) final {
     static const Op& alloc_tensor_op = Op::Get("relax.builtin.alloc_tensor");
+    ++binding_index_;
     if (call->op == alloc_tensor_op) {
       auto it = token_map_.find(call);
       TVM_FFI_ICHECK(it != token_map_.end());
@@ -841,6 +947,12 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
 
   /*! \brief Request a storage reuse, or allocate storage if no appropriate storage is reusable. */
   StorageToken RequestReuseOrAlloc(StorageToken prototype) {
+    if (IsArenaCandidate(prototype)) {
+      // Arena tokens are never reused, their sharing is decided by the arena packing.
+      StorageToken token = allocator_.Alloc(prototype, this->n_storage_++);
+      arena_items_[token.get()] = {token, binding_index_, binding_index_};
+      return token;
+    }
     ffi::Optional<StorageToken> token = allocator_.RequestReuse(prototype);
     if (!token.defined()) {
       return allocator_.Alloc(prototype, this->n_storage_++);
@@ -859,19 +971,150 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
     TVM_FFI_ICHECK_GE(token->ref_counter, 0);
 
     if (token->ref_counter == 0) {
-      allocator_.Release(token);
+      if (auto it = arena_items_.find(token.get()); it != arena_items_.end()) {
+        it->second.end = binding_index_;
+      } else {
+        allocator_.Release(token);
+      }
       auto it = token2cur_tensor_.find(token.get());
       TVM_FFI_ICHECK(it != token2cur_tensor_.end());
       token2cur_tensor_.erase(it);
     }
   }
 
+  /*! \brief Check if a prototype token is planned into an arena instead of the token pool. */
+  bool IsArenaCandidate(const StorageToken& prototype) const {
+    TVM_FFI_ICHECK(!block_stack_.empty());
+    return arena_blocks_.count(block_stack_.back()) && prototype->const_bytes() > 0 &&
+           prototype->storage_scope == "global" &&
+           (!prototype->vdevice.defined() || prototype->vdevice.value()->memory_scope == "global");
+  }
+
+  /*!
+   * \brief Pack the arena tokens of the function just visited into one arena per VDevice.
+   * \details Tokens are placed from the largest one. Each token is placed at the lowest offset of
+   * the smallest gap that fits it among the placed tokens whose lifetimes overlap with its own, or
+   * after all of them if no gap fits.
+   * \param symbolic Whether to compute symbolic offsets and sizes from the actual sizes of the
+   * dynamic-shape tokens, instead of using the placement on their upper bounds.
+   * \return The arenas of the function.
+   */
+  std::vector<StorageToken> PlanArenas(bool symbolic) {
+    std::vector<StorageToken> arenas;
+    std::unordered_map<const Object*, std::vector<ArenaItem>> groups;
+    for (const auto& kv : arena_items_) {
+      groups[kv.second.token->vdevice.get()].push_back(kv.second);
+    }
+    arena_items_.clear();
+    auto align = [](int64_t offset) {
+      return (offset + runtime::kAllocAlignment - 1) / runtime::kAllocAlignment *
+             runtime::kAllocAlignment;
+    };
+    for (auto& kv : groups) {
+      std::vector<ArenaItem>& items = kv.second;
+      std::sort(items.begin(), items.end(), [](const ArenaItem& a, const ArenaItem& b) {
+        int64_t a_bytes = a.token->const_bytes();
+        int64_t b_bytes = b.token->const_bytes();
+        return a_bytes != b_bytes ? a_bytes > b_bytes : a.token->storage_id < b.token->storage_id;
+      });
+      // The placed tokens, as pairs of offset and item.
+      std::vector<std::pair<int64_t, const ArenaItem*>> placed;
+      int64_t arena_bytes = 0;
+      for (const ArenaItem& item : items) {
+        int64_t bytes = item.token->const_bytes();
+        std::vector<std::pair<int64_t, const ArenaItem*>> conflicts;
+        for (const auto& p : placed) {
+          if (p.second->start <= item.end && item.start <= p.second->end) {
+            conflicts.push_back(p);
+          }
+        }
+        std::sort(conflicts.begin(), conflicts.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        int64_t offset = -1;
+        int64_t best_gap = std::numeric_limits<int64_t>::max();
+        int64_t cur = 0;
+        for (const auto& [conflict_offset, conflict] : conflicts) {
+          int64_t gap = conflict_offset - cur;
+          if (gap >= bytes && gap < best_gap) {
+            offset = cur;
+            best_gap = gap;
+          }
+          cur = std::max(cur, align(conflict_offset + conflict->token->const_bytes()));
+        }
+        if (offset == -1) {
+          offset = cur;
+        }
+        placed.push_back({offset, &item});
+        arena_bytes = std::max(arena_bytes, offset + bytes);
+      }
+      StorageToken arena({tir::make_const(DataType::Int(64), arena_bytes)}, DataType::UInt(8),
+                         "global", items[0].token->vdevice);
+      arena->storage_id = this->n_storage_++;
+      bool has_symbolic = std::any_of(items.begin(), items.end(), [](const ArenaItem& item) {
+        return item.token->symbolic_bytes.defined();
+      });
+      if (symbolic && has_symbolic) {
+        // Following the placement order from the bottom of the arena, each token is offset above
+        // the overlapping tokens placed below it. This keeps the overlapping tokens disjoint for
+        // any actual sizes within the upper bounds.
+        std::stable_sort(placed.begin(), placed.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        std::vector<PrimExpr> ends;
+        PrimExpr size = tir::make_const(DataType::Int(64), 0);
+        for (size_t i = 0; i < placed.size(); ++i) {
+          const ArenaItem* item = placed[i].second;
+          PrimExpr offset = tir::make_const(DataType::Int(64), 0);
+          for (size_t j = 0; j < i; ++j) {
+            const ArenaItem* below = placed[j].second;
+            if (placed[j].first < placed[i].first && below->start <= item->end &&
+                item->start <= below->end) {
+              offset = max(offset, AlignSymbolic(ends[j]));
+            }
+          }
+          offset = analyzer_->Simplify(offset);
+          ends.push_back(analyzer_->Simplify(
+              offset + item->token->symbolic_bytes.value_or(item->token->bytes)));
+          size = max(size, ends.back());
+          token2arena.insert({item->token.get(), {arena, offset}});
+        }
+        arena->bytes = analyzer_->Simplify(size);
+      } else {
+        for (const auto& [offset, item] : placed) {
+          token2arena.insert(
+              {item->token.get(), {arena, tir::make_const(DataType::Int(64), offset)}});
+        }
+      }
+      arenas.push_back(arena);
+    }
+    return arenas;
+  }
+
+  /*! \brief Round a symbolic offset up to the allocation alignment. */
+  static PrimExpr AlignSymbolic(PrimExpr offset) {
+    PrimExpr alignment = tir::make_const(DataType::Int(64), runtime::kAllocAlignment);
+    return floordiv(offset + alignment - 1, alignment) * alignment;
+  }
+
   /*! \brief Number of allocated storages. */
   int n_storage_{0};
   /*! \brief The 1D memory allocator. */
   TokenAllocatorMixed allocator_;
+  /*! \brief The arithmetic analyzer. */
+  arith::Analyzer* analyzer_;
   /*! \brief The mapping from each token to the tensors that are currently using it. */
   std::unordered_map<const StorageTokenNode*, std::vector<Var>> token2cur_tensor_;
+  /*! \brief Whether to pack the constant-size tokens of the top-level blocks into arenas. */
+  bool arena_;
+  /*! \brief Whether to size the arenas of dynamic-shape tokens symbolically. */
+  bool dynamic_arena_;
+  /*! \brief The names of the functions whose arenas share one workspace. */
+  std::unordered_set<std::string> shared_arena_funcs_;
+  /*! \brief The top-level non-dataflow blocks of the current function. */
+  std::unordered_set<const BindingBlockNode*> arena_blocks_;
+  /*! \brief The arena tokens of the current function, whose packing is not planned yet. */
+  std::unordered_map<const StorageTokenNode*, ArenaItem> arena_items_;
+  /*! \brief The index of the current call binding in the function. */
+  int binding_index_{0};
 };
 
 /*!
@@ -885,10 +1128,14 @@ class StorageAllocationRewriter : public ExprMutator {
   explicit StorageAllocationRewriter(
       IRModule mod, std::unordered_map<const ExprNode*, StorageToken> alloc_tensor2token,
       std::unordered_map<const BindingBlockNode*, std::vector<const StorageTokenNode*>>
-          block2tokens)
+          block2tokens,
+      std::unordered_map<const StorageTokenNode*, std::pair<StorageToken, PrimExpr>> token2arena,
+      std::unordered_map<const StorageTokenNode*, int> arena2workspace)
       : ExprMutator(std::move(mod)),
         alloc_tensor2token_(std::move(alloc_tensor2token)),
-        block2tokens_(std::move(block2tokens)) {}
+        block2tokens_(std::move(block2tokens)),
+        token2arena_(std::move(token2arena)),
+        arena2workspace_(std::move(arena2workspace)) {}
 
   IRModule Rewrite() {
     const IRModule& mod = builder_->GetContextIRModule();
@@ -932,6 +1179,11 @@ class StorageAllocationRewriter : public ExprMutator {
       // If the token is visited for the first time, create a storage variable using
       // `memory.alloc_storage` for it.
       StorageToken token = it->second;
+      PrimValue offset = PrimValue::Int64(0);
+      if (auto it_arena = token2arena_.find(token.get()); it_arena != token2arena_.end()) {
+        token = it_arena->second.first;
+        offset = PrimValue(it_arena->second.second);
+      }
       Var storage_var{nullptr};
       auto it_token = token2storage_var_.find(token.get());
       if (it_token == token2storage_var_.end()) {
@@ -942,6 +1194,18 @@ class StorageAllocationRewriter : public ExprMutator {
                            {std::move(size), virtual_device_index, StringImm(token->storage_scope),
                             DataTypeImm(dtype)},
                            Attrs());
+        if (auto it_ws = arena2workspace_.find(token.get()); it_ws != arena2workspace_.end()) {
+          // The storage of a workspace is held by the VM across the function calls.
+          static const Op& call_builtin_with_ctx_op = Op::Get("relax.call_builtin_with_ctx");
+          static const ExternFunc builtin_alloc_shared_workspace(
+              "vm.builtin.alloc_shared_workspace");
+          ffi::Array<Expr> args = alloc_storage->args;
+          args.push_back(PrimValue::Int64(it_ws->second));
+          alloc_storage = Call(call_builtin_with_ctx_op,
+                               {builtin_alloc_shared_workspace,
+                                Tuple({args[0], args[1], args[3], args[2], args[4]})},
+                               Attrs(), {ObjectStructInfo()});
+        }
         storage_var = builder_->Emit(alloc_storage, "storage");
         token2storage_var_[token.get()] = storage_var;
       } else {
@@ -949,7 +1213,6 @@ class StorageAllocationRewriter : public ExprMutator {
       }
 
       // And always create a `memory.alloc_tensor` for the old `builtin.alloc_tensor`.
-      PrimValue offset = PrimValue::Int64(0);
       DataType dtype = sinfo->dtype;
       return Call(mem_alloc_tensor,
                   {storage_var, offset, sinfo->shape.value(), DataTypeImm(dtype), call->args[2]},
@@ -1004,31 +1267,60 @@ class StorageAllocationRewriter : public ExprMutator {
   std::unordered_map<const ExprNode*, StorageToken> alloc_tensor2token_;
   /*! \brief The mapping from each binding block to the storage tokens that are create inside. */
   std::unordered_map<const BindingBlockNode*, std::vector<const StorageTokenNode*>> block2tokens_;
+  /*! \brief The mapping from each arena-planned token to its arena and its offset in the arena. */
+  std::unordered_map<const StorageTokenNode*, std::pair<StorageToken, PrimExpr>> token2arena_;
+  /*! \brief The mapping from each arena obtained as a VM workspace to the workspace index. */
+  std::unordered_map<const StorageTokenNode*, int> arena2workspace_;
   /*! \brief The mapping from each token to its corresponding storage var in each function. */
   std::unordered_map<const StorageTokenNode*, Var> token2storage_var_;
 };
 
-IRModule StaticPlanBlockMemory(IRModule mod) {
+IRModule StaticPlanBlockMemory(IRModule mod, bool arena, bool dynamic_arena,
+                               const ffi::Array<ffi::String>& shared_arena_funcs) {
+  std::unordered_set<std::string> shared_funcs;
+  for (const ffi::String& name : shared_arena_funcs) {
+    TVM_FFI_CHECK(mod->ContainGlobalVar(name), ValueError)
+        << "The module has no function " << name << " to share the memory workspace";
+    shared_funcs.insert(name);
+  }
+
   arith::Analyzer ana;
 
   // Step 1. Initialize.
   std::unordered_map<const ExprNode*, Tokens> token_map =
       StorageAllocatorInit::Initialize(mod, &ana);
   // Step 2. Collect the memory allocation info.
-  StorageAllocator allocator(std::move(token_map), &ana);
+  StorageAllocator allocator(std::move(token_map), &ana, arena, dynamic_arena,
+                             std::move(shared_funcs));
   allocator.Allocate(mod);
   // Step 3. Rewrite the function.
   StorageAllocationRewriter rewriter(std::move(mod),  //
                                      std::move(allocator.alloc_tensor2token),
-                                     std::move(allocator.block2tokens));
+                                     std::move(allocator.block2tokens),
+                                     std::move(allocator.token2arena),
+                                     std::move(allocator.arena2workspace));
   return rewriter.Rewrite();
 }
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.StaticPlanBlockMemory.arena", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.StaticPlanBlockMemory.dynamic_arena", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.StaticPlanBlockMemory.shared_arena_funcs",
+                                ffi::Array<ffi::String>);
+
 Pass StaticPlanBlockMemory() {
   auto pass_func = [=](IRModule m, PassContext pc) {
-    return relax::StaticPlanBlockMemory(std::move(m));
+    bool arena =
+        pc->GetConfig<Bool>("relax.StaticPlanBlockMemory.arena").value_or(Bool(false))->value;
+    ffi::Array<ffi::String> shared_arena_funcs =
+        pc->GetConfig<ffi::Array<ffi::String>>("relax.StaticPlanBlockMemory.shared_arena_funcs")
+            .value_or({});
+    bool dynamic_arena =
+        pc->GetConfig<Bool>("relax.StaticPlanBlockMemory.dynamic_arena")
+            .value_or(Bool(false))
+            ->value;
+    return relax::StaticPlanBlockMemory(std::move(m), arena, dynamic_arena, shared_arena_funcs);
   };
   return CreateModulePass(pass_func, /*opt_level=*/0, "StaticPlanBlockMemory", {});
 }
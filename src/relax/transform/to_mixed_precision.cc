@@ -28,6 +28,8 @@
 
 #include <array>
 #include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "../op/nn/convolution.h"
@@ -49,6 +51,53 @@ int GetMixedPrecisionInfo(const CallNode* call_node) {
   return attr_map.count(op) ? attr_map[op] : MixedPrecisionPolicyKind::kNever;
 }
 
+/*!
+ * \brief The overrides of the mixed precision policies registered for the ops, e.g. to keep the
+ * ops that a calibration run finds too inaccurate in fp16 in their original precision.
+ */
+class MixedPrecisionPolicyOverrides {
+ public:
+  /*!
+   * \param op_policy The policy of each op to override, by op name, which is one of "always",
+   * "follow" and "never".
+   * \param fp32_bindings The names of the vars bound to the calls that keep their original
+   * precision, as if their ops had the "never" policy.
+   */
+  MixedPrecisionPolicyOverrides(const ffi::Map<ffi::String, ffi::String>& op_policy,
+                                const ffi::Array<ffi::String>& fp32_bindings)
+      : fp32_bindings_(fp32_bindings.begin(), fp32_bindings.end()) {
+    static const std::unordered_map<std::string, int> kPolicies = {
+        {"always", kAlways}, {"follow", kFollow}, {"never", kNever}};
+    static const auto& finfer_map = Op::GetAttrMap<FInferMixedPrecision>("FInferMixedPrecision");
+    for (const auto& [op_name, policy_name] : op_policy) {
+      auto it = kPolicies.find(policy_name);
+      TVM_FFI_CHECK(it != kPolicies.end(), ValueError)
+          << "Unknown mixed precision policy \"" << policy_name << "\" of op " << op_name
+          << ", which should be one of \"always\", \"follow\" and \"never\"";
+      TVM_FFI_CHECK(it->second != kAlways || finfer_map.count(Op::Get(op_name)), ValueError)
+          << "Op " << op_name << " cannot use the \"always\" policy, as it has no "
+          << "FInferMixedPrecision";
+      op_policy_[Op::Get(op_name)] = it->second;
+    }
+  }
+
+  /*!
+   * \brief Get the policy of a binding of an op call.
+   * \return The policy, or -1 if the call is not an op call.
+   */
+  int GetPolicy(const VarBindingNode* binding, const CallNode* call_node) const {
+    int policy = GetMixedPrecisionInfo(call_node);
+    if (policy == -1) return policy;
+    if (fp32_bindings_.count(binding->var->name_hint())) return kNever;
+    auto it = op_policy_.find(Downcast<Op>(call_node->op));
+    return it != op_policy_.end() ? it->second : policy;
+  }
+
+ private:
+  std::unordered_map<Op, int, ObjectPtrHash, ObjectPtrEqual> op_policy_;
+  std::unordered_set<std::string> fp32_bindings_;
+};
+
 /*!
  * \brief Main logic to automatically cast fp32 input modules to fp16 for certain ops.
  *
@@ -97,6 +146,9 @@ int GetMixedPrecisionInfo(const CallNode* call_node) {
  *   be more friendly to inlining and operator fusion. We will store the var to fp16 if it's only
  *   used in kAlways ops, otherwise we will store it as the natural output dtype of the op.
  *
+ * The policy of an op can be overridden for the whole pass, and the calls bound to some vars can be
+ * kept in fp32 (kNever), see MixedPrecisionPolicyOverrides.
+ *
  * The information of each op is registered in the
  * Op::GetAttr<FInferMixedPrecision>("FInferMixedPrecision"). The registered function has signature:
  * FInferMixedPrecision. We will call the registered function with the original call and the global
@@ -115,10 +167,13 @@ int GetMixedPrecisionInfo(const CallNode* call_node) {
  */
 class DTypeDecisionCollector : public ExprVisitor {
  public:
-  explicit DTypeDecisionCollector(DataType output_dtype) : output_dtype_(output_dtype) {}
+  explicit DTypeDecisionCollector(DataType output_dtype,
+                                  const MixedPrecisionPolicyOverrides* overrides)
+      : output_dtype_(output_dtype), overrides_(overrides) {}
 
-  static VarDTypeMap Collect(Function func, DataType output_dtype) {
-    DTypeDecisionCollector collector(output_dtype);
+  static VarDTypeMap Collect(Function func, DataType output_dtype,
+                             const MixedPrecisionPolicyOverrides* overrides) {
+    DTypeDecisionCollector collector(output_dtype, overrides);
     collector.VisitExpr(func);
     return std::move(collector.only_fp16_map_);
   }
@@ -190,7 +245,7 @@ class DTypeDecisionCollector : public ExprVisitor {
   void VisitExpr_(const VarNode* op) final { VisitVars_(op); }
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
-    auto policy = GetMixedPrecisionInfo(call_node);
+    auto policy = overrides_->GetPolicy(binding, call_node);
     if (policy == -1) {
       ExprVisitor::VisitBinding_(binding, call_node);
       return;
@@ -266,16 +321,19 @@ class DTypeDecisionCollector : public ExprVisitor {
   DataType fp16_ = DataType(DataType::TypeCode::kFloat, 16, 1);
   DataType fp32_ = DataType(DataType::TypeCode::kFloat, 32, 1);
   DataType output_dtype_;
+  const MixedPrecisionPolicyOverrides* overrides_;
   VarDTypeMap only_fp16_map_;
 };
 
 class ToMixedPrecisionRewriter : public ExprMutator {
  public:
   explicit ToMixedPrecisionRewriter(const VarDTypeMap* only_fp16_map, DataType output_dtype,
-                                    const std::unordered_set<std::string>& fp16_input_names)
+                                    const std::unordered_set<std::string>& fp16_input_names,
+                                    const MixedPrecisionPolicyOverrides* overrides)
       : only_fp16_map_(only_fp16_map),
         output_dtype_(output_dtype),
-        fp16_input_names_(fp16_input_names) {}
+        fp16_input_names_(fp16_input_names),
+        overrides_(overrides) {}
 
  private:
   Var GetRemapped(const Var& var) {
@@ -455,7 +513,7 @@ class ToMixedPrecisionRewriter : public ExprMutator {
       ExprMutator::VisitBinding_(binding, call_node);
       return;
     }
-    auto policy = GetMixedPrecisionInfo(call_node);
+    auto policy = overrides_->GetPolicy(binding, call_node);
     if (policy == -1) {
       // not an op call
       ExprMutator::VisitBinding_(binding, call_node);
@@ -595,27 +653,34 @@ class ToMixedPrecisionRewriter : public ExprMutator {
   DataType output_dtype_;
   ffi::Array<Var> params_;
   std::unordered_set<std::string> fp16_input_names_;
+  const MixedPrecisionPolicyOverrides* overrides_;
 
   const Op& wrap_param_op = Op::Get("relax.wrap_param");
 };
 
 Expr ToMixedPrecision(const Function& f, const DataType& out_dtype,
-                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names) {
-  VarDTypeMap only_fp16_map = DTypeDecisionCollector::Collect(f, out_dtype);
+                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names,
+                      const MixedPrecisionPolicyOverrides& overrides) {
+  VarDTypeMap only_fp16_map = DTypeDecisionCollector::Collect(f, out_dtype, &overrides);
   std::unordered_set<std::string> fp16_input_names_set;
   if (fp16_input_names) {
     fp16_input_names_set.insert(fp16_input_names.value().begin(), fp16_input_names.value().end());
   }
-  ToMixedPrecisionRewriter mutator(&only_fp16_map, out_dtype, fp16_input_names_set);
+  ToMixedPrecisionRewriter mutator(&only_fp16_map, out_dtype, fp16_input_names_set, &overrides);
   return mutator(f);
 }
 
 namespace transform {
 
 Pass ToMixedPrecision(const DataType& out_dtype,
-                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names) {
+                      ffi::Optional<ffi::Array<ffi::String>> fp16_input_names,
+                      ffi::Optional<ffi::Map<ffi::String, ffi::String>> op_policy,
+                      ffi::Optional<ffi::Array<ffi::String>> fp32_bindings) {
   auto pass_func = [=](Function f, IRModule m, PassContext pc) {
-    return Downcast<Function>(ToMixedPrecision(f, out_dtype, fp16_input_names));
+    MixedPrecisionPolicyOverrides overrides(
+        op_policy.value_or(ffi::Map<ffi::String, ffi::String>()),
+        fp32_bindings.value_or(ffi::Array<ffi::String>()));
+    return Downcast<Function>(ToMixedPrecision(f, out_dtype, fp16_input_names, overrides));
   };
   return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {});
 }
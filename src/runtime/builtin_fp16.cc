@@ -23,6 +23,90 @@
  */
 #include <builtin_fp16.h>
 #include <tvm/runtime/base.h>
+#include <tvm/runtime/builtin_fp16.h>
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TVM_FP16_USE_F16C 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define TVM_FP16_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+#ifdef TVM_FP16_USE_F16C
+/*! \brief Whether the CPU has F16C, and the OS saves the AVX state the instructions use. */
+bool CPUHasF16C() {
+  static const bool has_f16c = []() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    bool osxsave = ecx & (1U << 27), avx = ecx & (1U << 28), f16c = ecx & (1U << 29);
+    if (!osxsave || !avx || !f16c) return false;
+    unsigned xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    return (xcr0_lo & 0x6) == 0x6;
+  }();
+  return has_f16c;
+}
+
+__attribute__((target("avx,f16c"))) int64_t FloatToHalfF16C(const float* src, uint16_t* dst,
+                                                             int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+  }
+  return i;
+}
+
+__attribute__((target("avx,f16c"))) int64_t HalfToFloatF16C(const uint16_t* src, float* dst,
+                                                             int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  return i;
+}
+#endif
+
+/*! \brief Convert the leading elements with SIMD, and return the number of converted ones. */
+int64_t FloatToHalfSIMD(const float* src, uint16_t* dst, int64_t n) {
+#if defined(TVM_FP16_USE_F16C)
+  if (CPUHasF16C()) return FloatToHalfF16C(src, dst, n);
+  return 0;
+#elif defined(TVM_FP16_USE_NEON)
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+  return i;
+#else
+  return 0;
+#endif
+}
+
+/*! \brief Convert the leading elements with SIMD, and return the number of converted ones. */
+int64_t HalfToFloatSIMD(const uint16_t* src, float* dst, int64_t n) {
+#if defined(TVM_FP16_USE_F16C)
+  if (CPUHasF16C()) return HalfToFloatF16C(src, dst, n);
+  return 0;
+#elif defined(TVM_FP16_USE_NEON)
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+  }
+  return i;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
 
 extern "C" {
 
@@ -56,4 +140,36 @@ TVM_DLL uint16_t __truncdfhf2(double a) {
 }
 
 #endif
+
+void TVMConvertFloatToHalf(const float* src, uint16_t* dst, int64_t n) {
+  for (int64_t i = FloatToHalfSIMD(src, dst, n); i < n; ++i) {
+    dst[i] = __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(src[i]);
+  }
+}
+
+void TVMConvertHalfToFloat(const uint16_t* src, float* dst, int64_t n) {
+  for (int64_t i = HalfToFloatSIMD(src, dst, n); i < n; ++i) {
+    dst[i] = __extendXfYf2__<uint16_t, uint16_t, 10, float, uint32_t, 23>(src[i]);
+  }
+}
+
+// The bf16 conversions are plain bit manipulations without branches, which the compilers
+// vectorize for the SIMD width of the build.
+void TVMConvertFloatToBFloat16(const float* src, uint16_t* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    uint32_t bits;
+    std::memcpy(&bits, src + i, sizeof(bits));
+    uint32_t rounded = (bits + 0x7FFFU + ((bits >> 16) & 1U)) >> 16;
+    // Keep NaNs quiet NaNs instead of rounding them to infinity.
+    uint32_t nan = (bits >> 16) | 0x40U;
+    dst[i] = static_cast<uint16_t>((bits & 0x7FFFFFFFU) > 0x7F800000U ? nan : rounded);
+  }
+}
+
+void TVMConvertBFloat16ToFloat(const uint16_t* src, float* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    uint32_t bits = static_cast<uint32_t>(src[i]) << 16;
+    std::memcpy(dst + i, &bits, sizeof(bits));
+  }
+}
 }
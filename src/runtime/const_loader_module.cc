@@ -37,6 +37,10 @@
 #include <tvm/support/io.h>
 
 #include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <utility>
 
 #include "../support/bytes_io.h"
 
@@ -74,12 +78,20 @@ class ConstLoaderModuleObj : public ffi::ModuleObj {
     // Initialize and memoize the module.
     // Usually, we have some warmup runs. The module initialization should be
     // done at this stage. Therefore, runtime overhead is not a concern.
-    if (initialized_.count(name) && !initialized_.at(name)) {
-      this->InitSubModule(name);
-      initialized_[name] = true;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (initialized_.count(name) && !initialized_.at(name)) {
+        this->InitSubModule(name);
+        initialized_[name] = true;
+      }
     }
     ObjectRef _self = ffi::GetRef<ObjectRef>(this);
 
+    if (name == "init_all_submodules") {
+      return ffi::Function(
+          [_self, this](ffi::PackedArgs args, ffi::Any* rv) { this->InitAllSubModules(); });
+    }
+
     if (name == "get_const_var_tensor") {
       return ffi::Function([_self, this](ffi::PackedArgs args, ffi::Any* rv) {
         ffi::Map<ffi::String, ffi::Any> ret_map;
@@ -138,19 +150,76 @@ class ConstLoaderModuleObj : public ffi::ModuleObj {
    *  found module accordingly by passing the needed constants into it.
    */
   void InitSubModule(const std::string& symbol) {
+    ffi::Optional<ffi::Function> init = GetInitFunction(symbol);
+    if (init.has_value()) {
+      // Initialize the module with constants.
+      int ret = (*init)(GetRequiredConstants(symbol)).cast<int>();
+      // Report the error if initialization is failed.
+      TVM_FFI_ICHECK_EQ(ret, 0) << "Failed to initialize the module of function '" << symbol << "'";
+    }
+  }
+
+  /*!
+   * rief Initialize all the imported modules that are not initialized yet, in parallel, so
+   * that the initialization of the modules, e.g. the build of the TensorRT engines, is done when
+   * the model is loaded rather than at the first call of each function.
+   *
+   * 
+ote The modules are independent of each other, and each one is initialized by one thread.
+   */
+  void InitAllSubModules() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The functions are looked up serially, as the imported modules may cache them.
+    std::vector<std::pair<std::string, ffi::Function>> inits;
+    for (auto& kv : initialized_) {
+      if (kv.second) {
+        continue;
+      }
+      ffi::Optional<ffi::Function> init = GetInitFunction(kv.first);
+      if (init.has_value()) {
+        inits.emplace_back(kv.first, init.value());
+      } else {
+        kv.second = true;
+      }
+    }
+    std::vector<std::future<int>> results;
+    for (const auto& init : inits) {
+      ffi::Array<Tensor> consts = GetRequiredConstants(init.first);
+      results.push_back(std::async(std::launch::async, [f = init.second, consts]() {
+        return f(consts).cast<int>();
+      }));
+    }
+    // All the threads are joined before an error is reported.
+    std::vector<int> rets;
+    std::exception_ptr error = nullptr;
+    for (std::future<int>& result : results) {
+      try {
+        rets.push_back(result.get());
+      } catch (...) {
+        rets.push_back(-1);
+        error = error ? error : std::current_exception();
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    for (size_t i = 0; i < inits.size(); ++i) {
+      TVM_FFI_ICHECK_EQ(rets[i], 0)
+          << "Failed to initialize the module of function '" << inits[i].first << "'";
+      initialized_[inits[i].first] = true;
+    }
+  }
+
+  /*! \brief Get the initialization function of the symbol from the imported modules. */
+  ffi::Optional<ffi::Function> GetInitFunction(const std::string& symbol) {
+    std::string init_name = "__init_" + symbol;
     for (const Any& it : this->imports_) {
-      // Get the initialization function from the imported modules.
-      std::string init_name = "__init_" + symbol;
       ffi::Optional<ffi::Function> init = it.cast<ffi::Module>()->GetFunction(init_name, false);
       if (init.has_value()) {
-        auto md = GetRequiredConstants(symbol);
-        // Initialize the module with constants.
-        int ret = (*init)(md).cast<int>();
-        // Report the error if initialization is failed.
-        TVM_FFI_ICHECK_EQ(ret, 0);
-        break;
+        return init;
       }
     }
+    return std::nullopt;
   }
 
   ffi::Bytes SaveToBytes() const final {
@@ -246,6 +315,8 @@ class ConstLoaderModuleObj : public ffi::ModuleObj {
   std::unordered_map<std::string, Tensor> const_var_tensor_;
   /*! \brief Symbol name to required constant variables mapping. */
   std::unordered_map<std::string, std::vector<std::string>> const_vars_by_symbol_;
+  /*! \brief The mutex of the initialization, as the functions may be looked up concurrently. */
+  std::mutex mutex_;
 };
 
 ffi::Module ConstLoaderModuleCreate(
@@ -24,6 +24,7 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/threading_backend.h>
 
 extern "C" {
 #include <cblas.h>
@@ -59,6 +60,24 @@ struct CblasDgemmOp {
   }
 };
 
+// The number of multiply-adds of a GEMM below which the BLAS library barely parallelizes it.
+constexpr int64_t kMaxSmallGemmSize = 1 << 18;
+
+// Run gemm(i) for each matrix i of a batch. The small matrices of a batch, e.g. those of the
+// heads of an attention, are split across the threads of the runtime thread pool, as the BLAS
+// library would run each of them on one thread anyway.
+template <typename FGemm>
+void ForEachGemmOfBatch(int batch_size, int M, int N, int K, FGemm gemm) {
+  int64_t gemm_size = static_cast<int64_t>(M) * N * K;
+  if (batch_size > 1 && gemm_size <= kMaxSmallGemmSize && threading::NumThreads() > 1) {
+    parallel_for_with_threading_backend(gemm, 0, batch_size);
+    return;
+  }
+  for (int64_t i = 0; i < batch_size; ++i) {
+    gemm(i);
+  }
+}
+
 struct CblasSgemmBatchOp {
   typedef float TDatatype;
   void operator()(int batch_size, bool ta, bool tb, int M, int N, int K, float alpha, float* A,
@@ -66,12 +85,10 @@ struct CblasSgemmBatchOp {
                   int c_stride, int ldc) {
     CBLAS_TRANSPOSE trans_a = CBLASBooleanToTranspose(ta);
     CBLAS_TRANSPOSE trans_b = CBLASBooleanToTranspose(tb);
-    for (int i = 0; i < batch_size; ++i) {
-      cblas_sgemm(CblasColMajor, trans_a, trans_b, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
-      A += a_stride;
-      B += b_stride;
-      C += c_stride;
-    }
+    ForEachGemmOfBatch(batch_size, M, N, K, [&](int64_t i) {
+      cblas_sgemm(CblasColMajor, trans_a, trans_b, M, N, K, alpha, A + i * a_stride, lda,
+                  B + i * b_stride, ldb, beta, C + i * c_stride, ldc);
+    });
   }
 };
 
@@ -98,12 +115,10 @@ struct CblasDgemmBatchOp {
                   int c_stride, int ldc) {
     CBLAS_TRANSPOSE trans_a = CBLASBooleanToTranspose(ta);
     CBLAS_TRANSPOSE trans_b = CBLASBooleanToTranspose(tb);
-    for (int i = 0; i < batch_size; ++i) {
-      cblas_dgemm(CblasColMajor, trans_a, trans_b, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
-      A += a_stride;
-      B += b_stride;
-      C += c_stride;
-    }
+    ForEachGemmOfBatch(batch_size, M, N, K, [&](int64_t i) {
+      cblas_dgemm(CblasColMajor, trans_a, trans_b, M, N, K, alpha, A + i * a_stride, lda,
+                  B + i * b_stride, ldb, beta, C + i * c_stride, ldc);
+    });
   }
 };
 
@@ -26,7 +26,11 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/logging.h>
 
+#include <algorithm>
+#include <limits>
+
 #include "../../3rdparty/compiler-rt/builtin_fp16.h"
+#include "../../cuda/cuda_common.h"
 #include "../cblas/gemm_common.h"
 #include "cublas_utils.h"
 
@@ -138,12 +142,47 @@ int roundoff(int v, int d) { return (v + d - 1) / d * d; }
 
 #if CUDART_VERSION >= 10010
 
+/*!
+ * \brief Benchmark the heuristic results of a matmul on a stream, and return the fastest
+ * algorithm. The results that fail to run are skipped.
+ */
+template <typename FRun>
+cublasLtMatmulAlgo_t SelectFastestAlgo(const cublasLtMatmulHeuristicResult_t* results,
+                                       int num_results, cudaStream_t stream, FRun run) {
+  constexpr int kNumRepeats = 5;
+  cudaEvent_t start, stop;
+  CUDA_CALL(cudaEventCreate(&start));
+  CUDA_CALL(cudaEventCreate(&stop));
+  cublasLtMatmulAlgo_t best_algo = results[0].algo;
+  float best_time = std::numeric_limits<float>::infinity();
+  for (int i = 0; i < num_results; ++i) {
+    if (results[i].state != CUBLAS_STATUS_SUCCESS) continue;
+    // Warm up, and skip the algorithms that do not run on this problem.
+    if (run(results[i].algo) != CUBLAS_STATUS_SUCCESS) continue;
+    CUDA_CALL(cudaEventRecord(start, stream));
+    for (int r = 0; r < kNumRepeats; ++r) {
+      run(results[i].algo);
+    }
+    CUDA_CALL(cudaEventRecord(stop, stream));
+    CUDA_CALL(cudaEventSynchronize(stop));
+    float time = 0;
+    CUDA_CALL(cudaEventElapsedTime(&time, start, stop));
+    if (time < best_time) {
+      best_time = time;
+      best_algo = results[i].algo;
+    }
+  }
+  CUDA_CALL(cudaEventDestroy(start));
+  CUDA_CALL(cudaEventDestroy(stop));
+  return best_algo;
+}
+
 void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
                   cublasLtMatmulPreference_t matmul_pref_desc, const DLTensor* A, const DLTensor* B,
                   const DLTensor* bias, const DLTensor* scaleA, const DLTensor* scaleB,
                   const DLTensor* C, bool transa, bool transb, void* workspace_ptr,
                   size_t workspace_size, cublasLtEpilogue_t epilogue,
-                  std::optional<float> dq_scale) {
+                  std::optional<float> dq_scale, const DLTensor* residual) {
   TVM_FFI_ICHECK(TypeEqual(A->dtype, B->dtype));
   // Reversed strides indicates an in-place transpose operation.
   transa = IsInPlaceTransposed(A) ? !transa : transa;
@@ -185,6 +224,11 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
     alpha = &one_i32;
     beta = &zero_i32;
   }
+  if (residual != nullptr) {
+    TVM_FFI_ICHECK(TypeEqual(residual->dtype, C->dtype));
+    TVM_FFI_ICHECK(!TypeMatch(C->dtype, kDLInt, 32)) << "IGEMM does not support a residual";
+    beta = &one_fp32;
+  }
 
   cublasLtMatmulDesc_t op_desc;
   cublasOperation_t op_transa = CUBLASBooleanToTranspose(transa);
@@ -284,22 +328,74 @@ void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
   auto A_data = static_cast<char*>(A->data) + A->byte_offset;
   auto B_data = static_cast<char*>(B->data) + B->byte_offset;
   auto C_data = static_cast<char*>(C->data) + C->byte_offset;
+  // The residual is read as the C matrix of cuBLASLt, and the output written as its D matrix.
+  auto residual_data =
+      residual != nullptr ? static_cast<char*>(residual->data) + residual->byte_offset : C_data;
 
   cublasLtMatmulPreferenceSetAttribute(matmul_pref_desc, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
                                        &workspace_size, sizeof(size_t));
 
-  cublasLtMatmulHeuristicResult_t heuristic_result = {};
-  int returned_result = 0;
-  CHECK_CUBLAS_ERROR(cublasLtMatmulAlgoGetHeuristic(hdl, op_desc, A_desc, B_desc, C_desc, C_desc,
-                                                    matmul_pref_desc, 1, &heuristic_result,
-                                                    &returned_result));
-  if (returned_result == 0) {
-    CHECK_CUBLAS_ERROR(CUBLAS_STATUS_NOT_SUPPORTED);
+  auto run = [&](const cublasLtMatmulAlgo_t& algo) {
+    return cublasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc, beta,
+                          residual_data, C_desc, C_data, C_desc, &algo, workspace_ptr,
+                          workspace_size, stream);
+  };
+
+  CublasLtAlgoCache* algo_cache = CublasLtAlgoCache::Global();
+  // The heuristic depends on the alignment of the pointers, up to 16 bytes.
+  auto alignment = [](const void* ptr) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    return static_cast<int64_t>(address & 15 ? address & -address : 16);
+  };
+  int64_t batch_count = 0;
+  if (use_batched_gemm) {
+    batch_count = 1;
+    for (int i = 0; i < C->ndim - 2; ++i) {
+      batch_count *= C->shape[i];
+    }
+  }
+  CublasLtAlgoKey key;
+  key.fields = {M,
+                N,
+                K,
+                batch_count,
+                static_cast<int64_t>(ab_type),
+                static_cast<int64_t>(c_type),
+                static_cast<int64_t>(compute_type),
+                static_cast<int64_t>(op_transa),
+                static_cast<int64_t>(op_transb),
+                static_cast<int64_t>(epilogue),
+                (bias != nullptr) * 4 + (scaleA != nullptr) * 2 + (scaleB != nullptr),
+                std::min({alignment(A_data), alignment(B_data), alignment(C_data),
+                          alignment(residual_data)}),
+                static_cast<int64_t>(workspace_size),
+                CublasLtAlgoCache::CurrentDeviceArch(),
+                static_cast<int64_t>(cublasLtGetVersion()),
+                0};
+
+  cublasLtMatmulAlgo_t algo;
+  if (!algo_cache->Get(key, &algo)) {
+    // Benchmarking cannot run while the stream is captured into a CUDA graph.
+    cudaStreamCaptureStatus capture_status = cudaStreamCaptureStatusNone;
+    CUDA_CALL(cudaStreamIsCapturing(stream, &capture_status));
+    bool tune = algo_cache->autotune() && capture_status == cudaStreamCaptureStatusNone;
+    constexpr int kMaxCandidates = 8;
+    cublasLtMatmulHeuristicResult_t heuristic_results[kMaxCandidates] = {};
+    int returned_result = 0;
+    CHECK_CUBLAS_ERROR(cublasLtMatmulAlgoGetHeuristic(
+        hdl, op_desc, A_desc, B_desc, C_desc, C_desc, matmul_pref_desc, tune ? kMaxCandidates : 1,
+        heuristic_results, &returned_result));
+    if (returned_result == 0) {
+      CHECK_CUBLAS_ERROR(CUBLAS_STATUS_NOT_SUPPORTED);
+    }
+    algo = heuristic_results[0].algo;
+    if (tune && returned_result > 1) {
+      algo = SelectFastestAlgo(heuristic_results, returned_result, stream, run);
+    }
+    algo_cache->Set(key, algo, tune);
   }
 
-  CHECK_CUBLAS_ERROR(cublasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc, beta,
-                                    C_data, C_desc, C_data, C_desc, &heuristic_result.algo,
-                                    workspace_ptr, workspace_size, stream));
+  CHECK_CUBLAS_ERROR(run(algo));
 
   cublasLtMatmulDescDestroy(op_desc);
   cublasLtMatrixLayoutDestroy(A_desc);
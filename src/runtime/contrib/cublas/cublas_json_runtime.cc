@@ -100,15 +100,21 @@ class CublasJSONRuntime : public JSONRuntimeBase {
       return dl_tensors[eid];
     };
 
-    auto get_inputs = [=](const JSONGraphNode& node, bool has_bias, bool has_scale) {
-      const DLTensor *bias = nullptr, *scaleA = nullptr, *scaleB = nullptr;
+    auto get_inputs = [=](const JSONGraphNode& node, bool has_bias, bool has_scale,
+                          bool has_residual) {
+      const DLTensor *bias = nullptr, *scaleA = nullptr, *scaleB = nullptr, *residual = nullptr;
+      int idx = 2;
       if (has_bias) {
-        bias = get_input(node, 2);
+        bias = get_input(node, idx++);
       } else if (has_scale) {
-        scaleA = get_input(node, 2);
-        scaleB = get_input(node, 3);
+        scaleA = get_input(node, idx++);
+        scaleB = get_input(node, idx++);
       }
-      return std::make_tuple(get_input(node, 0), get_input(node, 1), bias, scaleA, scaleB);
+      if (has_residual) {
+        residual = get_input(node, idx++);
+      }
+      return std::make_tuple(get_input(node, 0), get_input(node, 1), bias, scaleA, scaleB,
+                             residual);
     };
 
     for (size_t i = 0; i < nodes_.size(); ++i) {
@@ -125,17 +131,19 @@ class CublasJSONRuntime : public JSONRuntimeBase {
           transb = true;
         }
 
+        bool has_bias = op_name.find("bias") != std::string::npos;
         if (op_name.find("relu") != std::string::npos) {
-          epilogue = CUBLASLT_EPILOGUE_RELU_BIAS;
+          epilogue = has_bias ? CUBLASLT_EPILOGUE_RELU_BIAS : CUBLASLT_EPILOGUE_RELU;
         } else if (op_name.find("gelu") != std::string::npos) {
-          epilogue = CUBLASLT_EPILOGUE_GELU_BIAS;
-        } else if (op_name.find("bias") != std::string::npos) {
+          epilogue = has_bias ? CUBLASLT_EPILOGUE_GELU_BIAS : CUBLASLT_EPILOGUE_GELU;
+        } else if (has_bias) {
           epilogue = CUBLASLT_EPILOGUE_BIAS;
         }
 
         bool has_scale = op_name.find("multiply") != std::string::npos;
-        auto [a_ptr, b_ptr, bias_ptr, scaleA_ptr, scaleB_ptr] =
-            get_inputs(node, epilogue != CUBLASLT_EPILOGUE_DEFAULT, has_scale);
+        bool has_residual = op_name.find("residual") != std::string::npos;
+        auto [a_ptr, b_ptr, bias_ptr, scaleA_ptr, scaleB_ptr, residual_ptr] =
+            get_inputs(node, has_bias, has_scale, has_residual);
 
         std::optional<float> dq_scale = std::nullopt;
         if (op_name.find("dequantize") != std::string::npos) {
@@ -145,7 +153,7 @@ class CublasJSONRuntime : public JSONRuntimeBase {
         tvm::contrib::CallCublasLt(entry_ptr->handle, stream, entry_ptr->matmul_pref_desc, a_ptr,
                                    b_ptr, bias_ptr, scaleA_ptr, scaleB_ptr, out_ptr, transa, transb,
                                    entry_ptr->workspace_ptr, entry_ptr->workspace_size, epilogue,
-                                   dq_scale);
+                                   dq_scale, residual_ptr);
       }
     }
   }
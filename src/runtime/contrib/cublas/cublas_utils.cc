@@ -25,6 +25,11 @@
 #include <tvm/ffi/extra/c_env_api.h>
 #include <tvm/ffi/function.h>
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "../../../support/env.h"
 #include "../../cuda/cuda_common.h"
 
 namespace tvm {
@@ -74,5 +79,87 @@ CuBlasLtThreadEntry* CuBlasLtThreadEntry::ThreadLocal(DLDevice curr_device) {
   return &inst;
 }
 
+#if CUDART_VERSION >= 10010
+CublasLtAlgoCache::CublasLtAlgoCache() {
+  autotune_ = support::GetEnv("TVM_CUBLASLT_AUTOTUNE", false);
+  path_ = support::GetEnv("TVM_CUBLASLT_ALGO_CACHE", std::string(""));
+  if (!path_.empty()) {
+    Load();
+  }
+}
+
+CublasLtAlgoCache* CublasLtAlgoCache::Global() {
+  static CublasLtAlgoCache* inst = new CublasLtAlgoCache();
+  return inst;
+}
+
+bool CublasLtAlgoCache::Get(const CublasLtAlgoKey& key, cublasLtMatmulAlgo_t* algo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  *algo = it->second.algo;
+  return true;
+}
+
+void CublasLtAlgoCache::Set(const CublasLtAlgoKey& key, const cublasLtMatmulAlgo_t& algo,
+                            bool tuned) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[key] = Entry{algo, tuned};
+  if (tuned && !path_.empty()) {
+    Save();
+  }
+}
+
+int CublasLtAlgoCache::CurrentDeviceArch() {
+  // The architecture of each device, by device id.
+  static thread_local std::unordered_map<int, int> arch_of_device;
+  int device_id;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  auto it = arch_of_device.find(device_id);
+  if (it != arch_of_device.end()) return it->second;
+  int major, minor;
+  CUDA_CALL(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device_id));
+  CUDA_CALL(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device_id));
+  return arch_of_device[device_id] = major * 10 + minor;
+}
+
+// The cache file has a line per tuned problem: the fields of its key, then the words of its
+// algorithm.
+void CublasLtAlgoCache::Load() {
+  std::ifstream file(path_);
+  if (!file.good()) return;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream is(line);
+    CublasLtAlgoKey key;
+    cublasLtMatmulAlgo_t algo;
+    for (int64_t& field : key.fields) is >> field;
+    for (uint64_t& word : algo.data) is >> word;
+    if (!is.fail()) {
+      entries_[key] = Entry{algo, true};
+    }
+  }
+}
+
+void CublasLtAlgoCache::Save() {
+  std::ostringstream os;
+  for (const auto& kv : entries_) {
+    if (!kv.second.tuned) continue;
+    for (int64_t field : kv.first.fields) os << field << " ";
+    for (uint64_t word : kv.second.algo.data) os << word << " ";
+    os << "\n";
+  }
+  // Write to a temporary file first, so that a concurrent process never reads a partial cache.
+  std::string tmp_path = path_ + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    file << os.str();
+  }
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    LOG(WARNING) << "Failed to save the cuBLASLt algorithm cache to " << path_;
+  }
+}
+#endif  // CUDART_VERSION >= 10010
+
 }  // namespace contrib
 }  // namespace tvm
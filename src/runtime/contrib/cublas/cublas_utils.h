@@ -30,11 +30,16 @@
 #include <dlpack/dlpack.h>
 #include <tvm/runtime/logging.h>
 
+#include <array>
 #include <cstdint>
+#include <functional>
 #if CUDART_VERSION >= 10010
 #include <cublasLt.h>
 #endif  // CUDART_VERSION >= 10010
+#include <mutex>
 #include <optional>
+#include <string>
+#include <unordered_map>
 
 namespace tvm {
 namespace contrib {
@@ -125,13 +130,80 @@ inline cudaDataType_t GetCudaDataType(DLDataType type) {
   TVM_FFI_THROW(InternalError) << "Unsupported CUDA type";
 }
 
-/*! \brief Execute matrix multiply followed by the specified epilogue, using cuBLASLt. */
+#if CUDART_VERSION >= 10010
+/*!
+ * \brief The problem a cuBLASLt algorithm is chosen for: the sizes, types, layouts and epilogue
+ * of a matmul, the GPU architecture and the cuBLASLt version.
+ */
+struct CublasLtAlgoKey {
+  static constexpr const int kNumFields = 16;
+  std::array<int64_t, kNumFields> fields{};
+
+  bool operator==(const CublasLtAlgoKey& other) const { return fields == other.fields; }
+};
+
+struct CublasLtAlgoKeyHash {
+  size_t operator()(const CublasLtAlgoKey& key) const {
+    size_t hash = 0;
+    for (int64_t field : key.fields) {
+      hash ^= std::hash<int64_t>()(field) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+};
+
+/*!
+ * \brief The process-wide cache of the cuBLASLt algorithm of each matmul problem, so that the
+ * heuristics are queried once per problem rather than once per call.
+ *
+ * By default the algorithm of a problem is the top heuristic result. With TVM_CUBLASLT_AUTOTUNE=1,
+ * the top heuristic results are benchmarked once instead, and the fastest one is kept. The tuned
+ * algorithms are persisted to the file TVM_CUBLASLT_ALGO_CACHE when it is set, and loaded from it
+ * at first use.
+ */
+class CublasLtAlgoCache {
+ public:
+  static CublasLtAlgoCache* Global();
+
+  /*! \brief Whether the algorithms of new problems are chosen by benchmarking. */
+  bool autotune() const { return autotune_; }
+
+  /*! \brief Get the algorithm of a problem, returns false if it has none yet. */
+  bool Get(const CublasLtAlgoKey& key, cublasLtMatmulAlgo_t* algo);
+
+  /*! \brief Set the algorithm of a problem, and persist it if it was tuned. */
+  void Set(const CublasLtAlgoKey& key, const cublasLtMatmulAlgo_t& algo, bool tuned);
+
+  /*! \brief The compute capability of the current device, as 10 * major + minor. */
+  static int CurrentDeviceArch();
+
+ private:
+  CublasLtAlgoCache();
+  void Load();
+  void Save();
+
+  struct Entry {
+    cublasLtMatmulAlgo_t algo;
+    bool tuned;
+  };
+  std::unordered_map<CublasLtAlgoKey, Entry, CublasLtAlgoKeyHash> entries_;
+  std::mutex mutex_;
+  std::string path_;
+  bool autotune_{false};
+};
+#endif  // CUDART_VERSION >= 10010
+
+/*!
+ * \brief Execute matrix multiply followed by the specified epilogue, using cuBLASLt.
+ * The residual, if any, has the shape of the output C and is added to the product.
+ */
 void CallCublasLt(cublasLtHandle_t hdl, cudaStream_t stream,
                   cublasLtMatmulPreference_t matmul_pref_desc, const DLTensor* A, const DLTensor* B,
                   const DLTensor* bias, const DLTensor* scaleA, const DLTensor* scaleB,
                   const DLTensor* C, bool transa, bool transb, void* workspace_ptr,
                   size_t workspace_size, cublasLtEpilogue_t epilogue = CUBLASLT_EPILOGUE_DEFAULT,
-                  std::optional<float> dq_scale = std::nullopt);
+                  std::optional<float> dq_scale = std::nullopt,
+                  const DLTensor* residual = nullptr);
 
 }  // namespace contrib
 }  // namespace tvm
@@ -45,6 +45,17 @@ typedef struct {
   void** data;
 } DnnlPackedArgs;
 
+// The CPU engine, and a stream per thread, shared by all the calls rather than created per call.
+inline const engine& CPUEngine() {
+  static engine eng(engine::kind::cpu, 0);
+  return eng;
+}
+
+inline stream& CPUStream() {
+  thread_local stream s(CPUEngine());
+  return s;
+}
+
 inline dnnl::memory::desc GenDNNLMemDescByShape(const dnnl::memory::dims& shape,
                                                 memory::data_type dtype) {
   using tag = memory::format_tag;
@@ -85,8 +96,8 @@ void dnnl_conv2d_common(float* data, float* weights, float* bias, float* out, in
                         bool channel_last, bool pre_cast, bool post_cast) {
   using tag = memory::format_tag;
   using dt = memory::data_type;
-  engine eng(engine::kind::cpu, 0);
-  stream s(eng);
+  const engine& eng = CPUEngine();
+  stream& s = CPUStream();
 
   memory::dims conv2d_src_tz = {p_N_, p_C_, p_H_, p_W_};
   memory::dims conv2d_weights_tz = {p_O_, p_C_, p_Kh_, p_Kw_};
@@ -211,8 +222,8 @@ extern "C" void dnnl_dense(float* data, float* weight, float* out, int p_B_, int
   using tag = memory::format_tag;
   using dt = memory::data_type;
 
-  engine eng(engine::kind::cpu, 0);
-  stream s(eng);
+  const engine& eng = CPUEngine();
+  stream& s = CPUStream();
 
   memory::dims data_tz = {p_B_, p_I_};
   memory::dims weight_tz = {p_O_, p_I_};
@@ -247,8 +258,8 @@ extern "C" void dnnl_dense(float* data, float* weight, float* out, int p_B_, int
 extern "C" void dnnl_relu(float* data, float* out, std::vector<int64_t> shape) {
   using dt = memory::data_type;
 
-  engine eng(engine::kind::cpu, 0);
-  stream s(eng);
+  const engine& eng = CPUEngine();
+  stream& s = CPUStream();
 
   auto data_md = GenDNNLMemDescByShape(shape, dt::f32);
 
@@ -272,8 +283,8 @@ extern "C" void dnnl_bn(float* data, float* gamma, float* beta, float* mean, flo
   using tag = memory::format_tag;
   using dt = memory::data_type;
 
-  engine eng(engine::kind::cpu, 0);
-  stream s(eng);
+  const engine& eng = CPUEngine();
+  stream& s = CPUStream();
 
   memory::dims data_tz = {p_N_, p_C_, p_H_, p_W_};
 
@@ -314,8 +325,8 @@ extern "C" void dnnl_binary_op(float* data, float* weight, float* out, int algo_
                                std::vector<int64_t> shape) {
   using dt = memory::data_type;
 
-  engine eng(engine::kind::cpu, 0);
-  stream s(eng);
+  const engine& eng = CPUEngine();
+  stream& s = CPUStream();
 
   auto data_md = GenDNNLMemDescByShape(shape, dt::f32);
 
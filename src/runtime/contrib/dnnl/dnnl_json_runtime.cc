@@ -27,7 +27,10 @@
 #include <tvm/runtime/tensor.h>
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "../../../runtime/regex.h"
@@ -75,7 +78,8 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   /* Thread safe implementation of Run. Keep runtime instance immutable */
   void Run(const ffi::PackedArgs& args) const {
     auto arg_data_provider = makeIODataProvider(args);
-    auto mem_solver = tensor_registry_.MakeSolver(arg_data_provider);
+    auto tmp_mems = AcquireTmpMemories();
+    auto mem_solver = tensor_registry_.MakeSolver(arg_data_provider, *tmp_mems);
     // Execute primitives one by one
     for (const auto& act : net_) {
       auto prim = std::get<0>(act);
@@ -97,6 +101,7 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
       prim.execute(stream_, mem_args);
     }
+    ReleaseTmpMemories(std::move(tmp_mems));
   }
 
   /* Override GetFunction to reimplement Run method */
@@ -902,6 +907,28 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
 
   uint32_t GenUniqueEid() { return next_unique_eid_offset_++; }
 
+  /*!
+   * \brief Take a set of intermediate buffers that no other execution uses, so that the
+   * intermediates and scratchpads are not reallocated on each call.
+   */
+  std::unique_ptr<TensorRegistry::TmpMemories> AcquireTmpMemories() const {
+    {
+      std::lock_guard<std::mutex> lock(tmp_mems_mutex_);
+      if (!free_tmp_mems_.empty()) {
+        auto tmp_mems = std::move(free_tmp_mems_.back());
+        free_tmp_mems_.pop_back();
+        return tmp_mems;
+      }
+    }
+    return std::make_unique<TensorRegistry::TmpMemories>(tensor_registry_.AllocateTmpMemories());
+  }
+
+  /*! \brief Return a set of intermediate buffers taken by AcquireTmpMemories(). */
+  void ReleaseTmpMemories(std::unique_ptr<TensorRegistry::TmpMemories> tmp_mems) const {
+    std::lock_guard<std::mutex> lock(tmp_mems_mutex_);
+    free_tmp_mems_.push_back(std::move(tmp_mems));
+  }
+
   /* The dnnl engine. */
   dnnl::engine engine_;
   /* The dnnl stream. */
@@ -914,6 +941,10 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   uint32_t next_unique_eid_offset_;
   /* Map of Run arg idx to corresponding eid */
   std::vector<uint32_t> run_arg_eid_;
+  /* The intermediate buffers that are not in use, one set per concurrent execution so far */
+  mutable std::vector<std::unique_ptr<TensorRegistry::TmpMemories>> free_tmp_mems_;
+  /* Guard of free_tmp_mems_ */
+  mutable std::mutex tmp_mems_mutex_;
 };
 
 ffi::Module DNNLJSONRuntimeCreate(ffi::String symbol_name, ffi::String graph_json,
@@ -521,6 +521,7 @@ class TensorRegistry {
   using ActionQue = std::vector<Action>;
   using DLTensorProvider = std::function<const DLTensor*(uint32_t)>;
   using MemSolver = std::function<const dnnl::memory(ArgId)>;
+  using TmpMemories = std::vector<dnnl::memory>;
 
   TensorRegistry() = default;
   TensorRegistry(const dnnl::engine& eng, const std::set<uint32_t>& ext_io_eid)
@@ -600,8 +601,37 @@ class TensorRegistry {
    * \return memory solver object to match ArgId to dnnl::memory objects
    */
   MemSolver MakeSolver(const DLTensorProvider& ext_provider) const {
-    return MemSolverImpl(eng_, ext_provider, const_mem_collection_, ext_mem_collection_,
-                         tmp_mem_collection_, tmp_mem_mapping_);
+    return MakeSolver(ext_provider, AllocateTmpMemories());
+  }
+
+  /*!
+   * \brief Construct memory solver which uses provided intermediate buffers.
+   * \param ext_provider callback to resolve external IO buffers
+   * \param tmp_mems intermediate buffers, as allocated by AllocateTmpMemories()
+   * \return memory solver object to match ArgId to dnnl::memory objects
+   */
+  MemSolver MakeSolver(const DLTensorProvider& ext_provider, const TmpMemories& tmp_mems) const {
+    TVM_FFI_ICHECK_EQ(tmp_mems.size(), tmp_mem_collection_.size());
+    return MemSolverImpl(eng_, ext_provider, const_mem_collection_, ext_mem_collection_, tmp_mems);
+  }
+
+  /*!
+   * \brief Allocate the intermediate buffers of all registered TRs. The buffers can be reused by
+   * any number of sequential executions.
+   */
+  TmpMemories AllocateTmpMemories() const {
+    TmpMemories tmp_mems(tmp_mem_collection_.size());
+    for (size_t i = 0; i < tmp_mem_collection_.size(); i++) {
+      auto found = tmp_mem_mapping_.find(i);
+
+      if (found != tmp_mem_mapping_.end()) {
+        auto reuse_hdl = tmp_mems[found->second].get_data_handle();
+        tmp_mems[i] = dnnl::memory(tmp_mem_collection_[i], eng_, reuse_hdl);
+      } else {
+        tmp_mems[i] = dnnl::memory(tmp_mem_collection_[i], eng_);
+      }
+    }
+    return tmp_mems;
   }
 
   void MarkInplace(const TensorRequisite& tr, const TensorRequisite& shared) {
@@ -661,26 +691,12 @@ class TensorRegistry {
     MemSolverImpl(const dnnl::engine& eng, const DLTensorProvider& ext_data_provider,
                   const std::vector<dnnl::memory>& const_mems,
                   const std::vector<std::pair<uint32_t, dnnl::memory::desc>>& ext_mems,
-                  const std::vector<dnnl::memory::desc>& tmp_mem_descs,
-                  const std::map<size_t, size_t>& tmp_mem_mapping)
+                  const TmpMemories& tmp_mems)
         : eng_(eng),
           ext_data_provider_(ext_data_provider),
           const_mems_(const_mems),
-          ext_mems_(ext_mems) {
-      // Construct temp memory objects on the fly. While we have no scratchpads
-      // support on VM/GraphExecutor level.
-      tmp_mems_.resize(tmp_mem_descs.size());
-      for (size_t i = 0; i < tmp_mem_descs.size(); i++) {
-        auto found = tmp_mem_mapping.find(i);
-
-        if (found != tmp_mem_mapping.end()) {
-          auto reuse_hdl = tmp_mems_[found->second].get_data_handle();
-          tmp_mems_[i] = dnnl::memory(tmp_mem_descs[i], eng_, reuse_hdl);
-        } else {
-          tmp_mems_[i] = dnnl::memory(tmp_mem_descs[i], eng_);
-        }
-      }
-    }
+          ext_mems_(ext_mems),
+          tmp_mems_(tmp_mems) {}
 
     /*! \brief Find memory object associated with provided ArgId */
     dnnl::memory operator()(const ArgId& ar) const {
@@ -129,7 +129,7 @@ void CallHipblasLt(hipblasLtHandle_t hdl, hipStream_t stream,
                    hipblasLtMatmulPreference_t matmul_pref_desc, const DLTensor* A,
                    const DLTensor* B, const DLTensor* bias, const DLTensor* C, bool transa,
                    bool transb, void* workspace_ptr, size_t workspace_size,
-                   hipblasLtEpilogue_t epilogue) {
+                   hipblasLtEpilogue_t epilogue, const DLTensor* residual) {
   TVM_FFI_ICHECK(TypeEqual(A->dtype, B->dtype));
   // Reversed strides indicates an in-place transpose operation.
   transa = IsInPlaceTransposed(A) ? !transa : transa;
@@ -161,6 +161,11 @@ void CallHipblasLt(hipblasLtHandle_t hdl, hipStream_t stream,
     alpha = &one_i32;
     beta = &zero_i32;
   }
+  if (residual != nullptr) {
+    TVM_FFI_ICHECK(TypeEqual(residual->dtype, C->dtype));
+    TVM_FFI_ICHECK(!TypeMatch(C->dtype, kDLInt, 32)) << "IGEMM does not support a residual";
+    beta = &one_fp32;
+  }
 
   hipblasLtMatmulDesc_t op_desc;
   hipblasOperation_t op_transa = HIPBLASBooleanToTranspose(transa);
@@ -250,6 +255,9 @@ void CallHipblasLt(hipblasLtHandle_t hdl, hipStream_t stream,
   auto A_data = static_cast<char*>(A->data) + A->byte_offset;
   auto B_data = static_cast<char*>(B->data) + B->byte_offset;
   auto C_data = static_cast<char*>(C->data) + C->byte_offset;
+  // The residual is read as the C matrix of hipBLASLt, and the output written as its D matrix.
+  auto residual_data =
+      residual != nullptr ? static_cast<char*>(residual->data) + residual->byte_offset : C_data;
 
   hipblasLtMatmulPreferenceSetAttribute(matmul_pref_desc, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
                                         &workspace_size, sizeof(size_t));
@@ -264,7 +272,7 @@ void CallHipblasLt(hipblasLtHandle_t hdl, hipStream_t stream,
   }
 
   CHECK_HIPBLAS_ERROR(hipblasLtMatmul(hdl, op_desc, alpha, B_data, A_desc, A_data, B_desc, beta,
-                                      C_data, C_desc, C_data, C_desc, &heuristic_result.algo,
+                                      residual_data, C_desc, C_data, C_desc, &heuristic_result.algo,
                                       workspace_ptr, workspace_size, stream));
 
   hipblasLtMatmulDescDestroy(op_desc);
@@ -98,12 +98,16 @@ class HipblasJSONRuntime : public JSONRuntimeBase {
       return dl_tensors[eid];
     };
 
-    auto get_inputs = [=](const JSONGraphNode& node, bool has_bias) {
-      const DLTensor* bias = nullptr;
+    auto get_inputs = [=](const JSONGraphNode& node, bool has_bias, bool has_residual) {
+      const DLTensor *bias = nullptr, *residual = nullptr;
+      int idx = 2;
       if (has_bias) {
-        bias = get_input(node, 2);
+        bias = get_input(node, idx++);
       }
-      return std::make_tuple(get_input(node, 0), get_input(node, 1), bias);
+      if (has_residual) {
+        residual = get_input(node, idx++);
+      }
+      return std::make_tuple(get_input(node, 0), get_input(node, 1), bias, residual);
     };
 
     for (size_t i = 0; i < nodes_.size(); ++i) {
@@ -120,19 +124,22 @@ class HipblasJSONRuntime : public JSONRuntimeBase {
           transb = true;
         }
 
+        bool has_bias = op_name.find("bias") != std::string::npos;
         if (op_name.find("relu") != std::string::npos) {
-          epilogue = HIPBLASLT_EPILOGUE_RELU_BIAS;
+          epilogue = has_bias ? HIPBLASLT_EPILOGUE_RELU_BIAS : HIPBLASLT_EPILOGUE_RELU;
         } else if (op_name.find("gelu") != std::string::npos) {
-          epilogue = HIPBLASLT_EPILOGUE_GELU_BIAS;
-        } else if (op_name.find("bias") != std::string::npos) {
+          epilogue = has_bias ? HIPBLASLT_EPILOGUE_GELU_BIAS : HIPBLASLT_EPILOGUE_GELU;
+        } else if (has_bias) {
           epilogue = HIPBLASLT_EPILOGUE_BIAS;
         }
 
-        auto [a_ptr, b_ptr, bias_ptr] = get_inputs(node, epilogue != HIPBLASLT_EPILOGUE_DEFAULT);
+        bool has_residual = op_name.find("residual") != std::string::npos;
+        auto [a_ptr, b_ptr, bias_ptr, residual_ptr] = get_inputs(node, has_bias, has_residual);
 
         tvm::contrib::CallHipblasLt(entry_ptr->handle, stream, entry_ptr->matmul_pref_desc, a_ptr,
                                     b_ptr, bias_ptr, out_ptr, transa, transb,
-                                    entry_ptr->workspace_ptr, entry_ptr->workspace_size, epilogue);
+                                    entry_ptr->workspace_ptr, entry_ptr->workspace_size, epilogue,
+                                    residual_ptr);
       }
     }
   }
@@ -142,12 +142,16 @@ inline hipblasDatatype_t GetHipBlasDataType(DLDataType type) {
   TVM_FFI_THROW(InternalError) << "Unsupported hip type";
 }
 
-/*! \brief Execute matrix multiply followed by the specified epilogue, using hipBLASLt. */
+/*!
+ * \brief Execute matrix multiply followed by the specified epilogue, using hipBLASLt.
+ * The residual, if any, has the shape of the output C and is added to the product.
+ */
 void CallHipblasLt(hipblasLtHandle_t hdl, hipStream_t stream,
                    hipblasLtMatmulPreference_t matmul_pref_desc, const DLTensor* A,
                    const DLTensor* B, const DLTensor* bias, const DLTensor* C, bool transa,
                    bool transb, void* workspace_ptr, size_t workspace_size,
-                   hipblasLtEpilogue_t epilogue = HIPBLASLT_EPILOGUE_DEFAULT);
+                   hipblasLtEpilogue_t epilogue = HIPBLASLT_EPILOGUE_DEFAULT,
+                   const DLTensor* residual = nullptr);
 
 }  // namespace contrib
 
@@ -31,6 +31,7 @@
 #include <tvm/runtime/tensor.h>
 #include <tvm/support/io.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <mutex>
 #include <string>
@@ -204,12 +205,19 @@ class JSONRuntimeBase : public ffi::ModuleObj {
    * \brief Set up the input and output buffers by binding their DLTensor pointers to the
    * corresponding data entry.
    *
+   * The DLTensors are only valid during the call, but backends usually bind the memory they
+   * point to into their engine. The data pointer, device, dtype and shape of each argument are
+   * recorded, and IOBindingsChanged() tells the backend whether any of them changed since the
+   * previous call, so that it can reuse the bindings of that call otherwise.
+   *
    * \param args The packed args.
    */
   void SetInputOutputBuffers(const ffi::PackedArgs& args) {
     TVM_FFI_ICHECK_EQ(args.size(), input_var_eid_.size() + outputs_.size())
         << "Found mismatch in the number of provided data entryies and required.";
 
+    io_bindings_changed_ = io_bindings_.size() != static_cast<size_t>(args.size());
+    io_bindings_.resize(args.size());
     for (size_t i = 0; i < static_cast<size_t>(args.size()); i++) {
       auto eid = i < input_var_eid_.size() ? input_var_eid_[i]
                                            : EntryID(outputs_[i - input_var_eid_.size()]);
@@ -225,9 +233,19 @@ class JSONRuntimeBase : public ffi::ModuleObj {
       // Assign input/output the Tensor pointers to data entry so that we can directly
       // read/write host buffers.
       data_entry_[eid] = arg;
+      if (!io_bindings_[i].Matches(arg)) {
+        io_bindings_[i].Record(arg);
+        io_bindings_changed_ = true;
+      }
     }
   }
 
+  /*!
+   * \brief Whether the memory, dtype or shape of an input or output differs from the previous
+   * call, or there was no previous call. Valid after SetInputOutputBuffers.
+   */
+  bool IOBindingsChanged() const { return io_bindings_changed_; }
+
   /*!
    * \brief Load the graph and record the entries for inputs and constants.
    *
@@ -330,6 +348,32 @@ class JSONRuntimeBase : public ffi::ModuleObj {
   uint32_t NumEntries() const { return node_row_ptr_.back(); }
 
  protected:
+  /*! \brief What an input or output of the previous call was bound to. */
+  struct IOBinding {
+    void* data{nullptr};
+    uint64_t byte_offset{0};
+    DLDevice device{};
+    DLDataType dtype{};
+    std::vector<int64_t> shape;
+
+    bool Matches(const DLTensor* tensor) const {
+      return data == tensor->data && byte_offset == tensor->byte_offset &&
+             device.device_type == tensor->device.device_type &&
+             device.device_id == tensor->device.device_id && dtype.code == tensor->dtype.code &&
+             dtype.bits == tensor->dtype.bits && dtype.lanes == tensor->dtype.lanes &&
+             shape.size() == static_cast<size_t>(tensor->ndim) &&
+             std::equal(shape.begin(), shape.end(), tensor->shape);
+    }
+
+    void Record(const DLTensor* tensor) {
+      data = tensor->data;
+      byte_offset = tensor->byte_offset;
+      device = tensor->device;
+      dtype = tensor->dtype;
+      shape.assign(tensor->shape, tensor->shape + tensor->ndim);
+    }
+  };
+
   /*! \brief The only subgraph name for this module. */
   std::string symbol_name_;
   /*! \brief The graph. */
@@ -350,6 +394,10 @@ class JSONRuntimeBase : public ffi::ModuleObj {
   std::vector<uint32_t> input_var_eid_;
   /*! \brief input const node index. */
   std::vector<uint32_t> const_idx_;
+  /*! \brief The inputs and outputs of the previous call, in the order of the arguments. */
+  std::vector<IOBinding> io_bindings_;
+  /*! \brief Whether the inputs and outputs differ from the previous call. */
+  bool io_bindings_changed_{true};
   /*! \brief Indicate if the engine has been initialized. */
   bool initialized_{false};
   /*! \brief Initializer mutex*/
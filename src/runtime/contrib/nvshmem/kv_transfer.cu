@@ -330,9 +330,19 @@ int _KVTransferPageToPage(DLTensor* remote_pages, DLTensor* local_pages,
   return 0;
 }
 
+bool _KVTransferQueryDone(TVMStreamHandle transfer_stream) {
+  cudaError_t status = cudaStreamQuery(static_cast<cudaStream_t>(transfer_stream));
+  if (status == cudaErrorNotReady) {
+    return false;
+  }
+  CHECK_EQ(status, cudaSuccess) << "CUDA error: " << cudaGetErrorString(status);
+  return true;
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
       .def("nvshmem.KVTransfer", _KVTransfer)
-      .def("nvshmem.KVTransferPageToPage", _KVTransferPageToPage);
+      .def("nvshmem.KVTransferPageToPage", _KVTransferPageToPage)
+      .def("nvshmem.KVTransferQueryDone", _KVTransferQueryDone);
 }
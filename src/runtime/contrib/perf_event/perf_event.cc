@@ -0,0 +1,222 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/contrib/perf_event/perf_event.cc
+ * \brief A MetricCollector of the CPU hardware counters of Linux perf events.
+ *
+ * The counters are opened once, on the thread that creates the profiler, with `inherit` set: the
+ * threads of the runtime thread pool, which the profiler recreates after the initialization of
+ * its collectors, are then counted along with it. The counters keep running, and a call is
+ * measured by the difference of their values at its start and at its end.
+ */
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/profiling.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*! \brief The perf event type and config of each supported counter name. */
+static const std::unordered_map<std::string, std::pair<uint32_t, uint64_t>>& PerfEventConfigs() {
+  auto cache_event = [](uint64_t cache, uint64_t op, uint64_t result) {
+    return std::make_pair(static_cast<uint32_t>(PERF_TYPE_HW_CACHE),
+                          cache | (op << 8) | (result << 16));
+  };
+  static const std::unordered_map<std::string, std::pair<uint32_t, uint64_t>> configs = {
+      {"cycles", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES}},
+      {"instructions", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS}},
+      {"cache-references", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES}},
+      {"cache-misses", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}},
+      {"branches", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS}},
+      {"branch-misses", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}},
+      {"stalled-cycles-frontend", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND}},
+      {"stalled-cycles-backend", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}},
+      {"L1-dcache-loads", cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                      PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+      {"L1-dcache-load-misses", cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                            PERF_COUNT_HW_CACHE_RESULT_MISS)},
+      {"LLC-loads", cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+      {"LLC-load-misses", cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                      PERF_COUNT_HW_CACHE_RESULT_MISS)},
+      {"task-clock", {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK}},
+      {"page-faults", {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}},
+      {"context-switches", {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}},
+  };
+  return configs;
+}
+
+/*! \brief The counter values at the start of a call. */
+struct PerfEventStartNode : public Object {
+  std::vector<uint64_t> values;
+
+  explicit PerfEventStartNode(std::vector<uint64_t> values) : values(std::move(values)) {}
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO("runtime.profiling.PerfEventStart", PerfEventStartNode, Object);
+};
+
+/*! \brief MetricCollectorNode of Linux perf events, for the CPU devices only. */
+struct PerfEventMetricCollectorNode final : public MetricCollectorNode {
+  explicit PerfEventMetricCollectorNode(ffi::Array<ffi::String> events) {
+    for (const auto& event : events) {
+      event_names_.push_back(event);
+    }
+  }
+
+  /*! \brief Open a counter for each event.
+   * \param devs The devices this collector will be running on.
+   */
+  void Init(ffi::Array<DeviceWrapper> devs) final {
+    bool has_cpu = false;
+    for (const auto& wrapped : devs) {
+      has_cpu = has_cpu || wrapped->device.device_type == kDLCPU;
+    }
+    if (!has_cpu || !fds_.empty()) return;
+
+    const auto& configs = PerfEventConfigs();
+    for (const auto& name : event_names_) {
+      auto it = configs.find(name);
+      if (it == configs.end()) {
+        std::string supported;
+        for (const auto& kv : configs) {
+          supported += " " + kv.first;
+        }
+        TVM_FFI_THROW(ValueError) << "Unknown perf event " << name << ". Supported events are:"
+                                  << supported;
+      }
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = it->second.first;
+      attr.config = it->second.second;
+      attr.inherit = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      // The times let Read() scale the counts when the counters are multiplexed.
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fd < 0) {
+        TVM_FFI_THROW(RuntimeError)
+            << "perf_event_open failed for " << name << ": " << std::strerror(errno)
+            << ". Counting may need a lower /proc/sys/kernel/perf_event_paranoid.";
+      }
+      fds_.push_back(fd);
+    }
+  }
+
+  ObjectRef Start(Device dev) final {
+    if (dev.device_type != kDLCPU || fds_.empty()) return ObjectRef(nullptr);
+    return ObjectRef(ffi::make_object<PerfEventStartNode>(Read()));
+  }
+
+  ffi::Map<ffi::String, ffi::Any> Stop(ObjectRef obj) final {
+    const PerfEventStartNode* start = obj.as<PerfEventStartNode>();
+    std::vector<uint64_t> values = Read();
+    ffi::Map<ffi::String, ffi::Any> metrics;
+    std::unordered_map<std::string, int64_t> counts;
+    for (size_t i = 0; i < values.size(); ++i) {
+      int64_t count = static_cast<int64_t>(values[i] - start->values[i]);
+      counts[event_names_[i]] = count;
+      metrics.Set(event_names_[i], ObjectRef(ffi::make_object<CountNode>(count)));
+    }
+    // Derived ratios, when the events they need are counted.
+    auto set_ratio = [&](const char* name, const char* numerator, const char* denominator) {
+      auto num = counts.find(numerator);
+      auto den = counts.find(denominator);
+      if (num != counts.end() && den != counts.end() && den->second > 0) {
+        double ratio = static_cast<double>(num->second) / den->second;
+        metrics.Set(name, ObjectRef(ffi::make_object<RatioNode>(ratio)));
+      }
+    };
+    set_ratio("IPC", "instructions", "cycles");
+    set_ratio("Cache Miss Rate", "cache-misses", "cache-references");
+    set_ratio("LLC Load Miss Rate", "LLC-load-misses", "LLC-loads");
+    return metrics;
+  }
+
+  ~PerfEventMetricCollectorNode() final {
+    for (int fd : fds_) {
+      close(fd);
+    }
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO("runtime.profiling.PerfEventMetricCollector",
+                              PerfEventMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  /*! \brief The values of the counters, scaled up for the time they were not scheduled. */
+  std::vector<uint64_t> Read() const {
+    std::vector<uint64_t> values;
+    for (int fd : fds_) {
+      // value, time enabled, time running
+      uint64_t data[3] = {0, 0, 0};
+      if (read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+        TVM_FFI_THROW(RuntimeError) << "Failed to read a perf event counter: "
+                                    << std::strerror(errno);
+      }
+      if (data[2] != 0 && data[2] < data[1]) {
+        data[0] = static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+      }
+      values.push_back(data[0]);
+    }
+    return values;
+  }
+
+  /*! \brief The names of the counted events. */
+  std::vector<std::string> event_names_;
+  /*! \brief The file descriptor of the counter of each event. */
+  std::vector<int> fds_;
+};
+
+/*! \brief Wrapper for `PerfEventMetricCollectorNode`. */
+class PerfEventMetricCollector : public MetricCollector {
+ public:
+  explicit PerfEventMetricCollector(ffi::Array<ffi::String> events) {
+    data_ = ffi::make_object<PerfEventMetricCollectorNode>(events);
+  }
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(PerfEventMetricCollector, MetricCollector,
+                                             PerfEventMetricCollectorNode);
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::ObjectDef<PerfEventMetricCollectorNode>();
+  refl::GlobalDef().def("runtime.profiling.PerfEventMetricCollector",
+                        [](ffi::Array<ffi::String> events) {
+                          return PerfEventMetricCollector(events);
+                        });
+}
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file random/philox.h
+ * \brief Philox4x32-10 counter-based random numbers, shared by the host and the device code.
+ *
+ * The number at the position p of a stream is a function of (seed, p) only: it is the word
+ * p % 4 of Philox4x32-10 applied to the counter p / 4 under the key seed. Any range of a stream
+ * can thus be generated independently of the others, by any number of threads, with the same
+ * result.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+#define TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define TVM_PHILOX_FUNC __host__ __device__ inline
+#else
+#define TVM_PHILOX_FUNC inline
+#endif
+
+namespace tvm {
+namespace contrib {
+namespace philox {
+
+/*! \brief The four 32-bit words of a counter or of its random output. */
+struct Words {
+  uint32_t w[4];
+};
+
+/*! \brief Philox4x32-10, the random words of a 128-bit counter under a 64-bit key. */
+TVM_PHILOX_FUNC Words Philox4x32(Words ctr, uint64_t key) {
+  uint32_t key0 = static_cast<uint32_t>(key);
+  uint32_t key1 = static_cast<uint32_t>(key >> 32);
+  for (int round = 0; round < 10; ++round) {
+    uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * ctr.w[0];
+    uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * ctr.w[2];
+    Words next;
+    next.w[0] = static_cast<uint32_t>(product1 >> 32) ^ ctr.w[1] ^ key0;
+    next.w[1] = static_cast<uint32_t>(product1);
+    next.w[2] = static_cast<uint32_t>(product0 >> 32) ^ ctr.w[3] ^ key1;
+    next.w[3] = static_cast<uint32_t>(product0);
+    ctr = next;
+    key0 += 0x9E3779B9u;
+    key1 += 0xBB67AE85u;
+  }
+  return ctr;
+}
+
+/*! \brief The random words of the block of 4 positions of a stream, from the position 4 * block. */
+TVM_PHILOX_FUNC Words Block(uint64_t seed, uint64_t block) {
+  Words ctr;
+  ctr.w[0] = static_cast<uint32_t>(block);
+  ctr.w[1] = static_cast<uint32_t>(block >> 32);
+  ctr.w[2] = 0;
+  ctr.w[3] = 0;
+  return Philox4x32(ctr, seed);
+}
+
+/*! \brief A float in [0, 1) from the 24 high bits of a random word. */
+TVM_PHILOX_FUNC float ToUniform(uint32_t word) {
+  return static_cast<float>(word >> 8) * (1.0f / 16777216.0f);
+}
+
+/*!
+ * \brief A standard normal float of the word `lane` of a block, by the Box-Muller transform of
+ *  the pair of words of the lane.
+ */
+TVM_PHILOX_FUNC float ToNormal(const Words& words, int lane) {
+  // u1 is in (0, 1] so that the log is finite.
+  float u1 = static_cast<float>((words.w[lane & ~1] >> 8) + 1) * (1.0f / 16777216.0f);
+  float u2 = ToUniform(words.w[lane | 1]);
+  float radius = sqrtf(-2.0f * logf(u1));
+  float theta = 6.28318530717958647692f * u2;
+  return (lane & 1) ? radius * sinf(theta) : radius * cosf(theta);
+}
+
+}  // namespace philox
+}  // namespace contrib
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file random/philox_random.cu
+ * \brief CUDA kernels of the Philox random fills of random.cc.
+ */
+#include <dlpack/dlpack.h>
+#include <tvm/ffi/extra/c_env_api.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+
+#include "../../cuda/cuda_common.h"
+#include "./philox.h"
+
+namespace tvm {
+namespace contrib {
+
+// Each thread generates one block of 4 positions of the stream, from the position 4 * block.
+__global__ void PhiloxFillKernel(float* out, int64_t size, uint64_t seed, uint64_t offset,
+                                 float a, float b, bool normal) {
+  int64_t first_block = offset / 4;
+  int64_t block = first_block + static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if ((block - first_block) * 4 >= size + static_cast<int64_t>(offset % 4)) return;
+  philox::Words words = philox::Block(seed, block);
+  for (int lane = 0; lane < 4; ++lane) {
+    int64_t i = block * 4 + lane - static_cast<int64_t>(offset);
+    if (i < 0 || i >= size) continue;
+    out[i] = normal ? a + b * philox::ToNormal(words, lane)
+                    : a + (b - a) * philox::ToUniform(words.w[lane]);
+  }
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def(
+      "tvm.contrib.random.philox_fill_cuda",
+      [](DLTensor* out, int64_t seed, int64_t offset, double a, double b, bool normal) {
+        int64_t size = 1;
+        for (int i = 0; i < out->ndim; ++i) {
+          size *= out->shape[i];
+        }
+        if (size == 0) return;
+        int64_t num_blocks = (size + offset % 4 + 3) / 4;
+        int threads = 256;
+        int64_t grid = (num_blocks + threads - 1) / threads;
+        CUDA_CALL(cudaSetDevice(out->device.device_id));
+        cudaStream_t stream =
+            static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, out->device.device_id));
+        PhiloxFillKernel<<<grid, threads, 0, stream>>>(
+            reinterpret_cast<float*>(static_cast<char*>(out->data) + out->byte_offset), size,
+            static_cast<uint64_t>(seed), static_cast<uint64_t>(offset), static_cast<float>(a),
+            static_cast<float>(b), normal);
+        CUDA_CALL(cudaGetLastError());
+      });
+}
+
+}  // namespace contrib
+}  // namespace tvm
@@ -27,8 +27,10 @@
 #include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <vector>
 
 #include "mt_random_engine.cc"
+#include "philox.h"
 
 #define DLPACK_INTEGER_TYPE_SWITCH(type, DType, ...)     \
   if (type.code == kDLInt && type.bits == 32) {          \
@@ -80,9 +82,83 @@ RandomThreadLocalEntry* RandomThreadLocalEntry::ThreadLocal() {
   return &inst;
 }
 
+// The number of elements below which a Philox fill is not split across threads.
+constexpr int64_t kMinParallelFillSize = 1 << 14;
+
+/*!
+ * \brief Fill a float32 CPU tensor with the positions [offset, offset + size) of the Philox stream
+ *  of a seed: uniform in [a, b) or, if normal is set, normal of mean a and standard deviation b.
+ *
+ * Each element only depends on its position, so the ranges of the tensor are filled on the
+ * threads of the runtime thread pool with the same result as a serial fill.
+ */
+void PhiloxFillCPU(DLTensor* out, uint64_t seed, uint64_t offset, float a, float b, bool normal) {
+  float* data = reinterpret_cast<float*>(static_cast<char*>(out->data) + out->byte_offset);
+  int64_t size = ffi::GetDataSize(*out) / sizeof(float);
+  auto fill_range = [&](int64_t begin, int64_t end) {
+    philox::Words words;
+    for (int64_t i = begin; i < end; ++i) {
+      uint64_t pos = offset + i;
+      int lane = static_cast<int>(pos % 4);
+      if (i == begin || lane == 0) {
+        words = philox::Block(seed, pos / 4);
+      }
+      data[i] = normal ? a + b * philox::ToNormal(words, lane)
+                       : a + (b - a) * philox::ToUniform(words.w[lane]);
+    }
+  };
+  int64_t num_ranges = std::min<int64_t>(threading::NumThreads(), size / kMinParallelFillSize);
+  if (num_ranges <= 1) {
+    fill_range(0, size);
+    return;
+  }
+  parallel_for_with_threading_backend(
+      [&](int64_t r) { fill_range(r * size / num_ranges, (r + 1) * size / num_ranges); }, 0,
+      num_ranges);
+}
+
+/*!
+ * \brief Fill a float32 tensor of any device from the Philox stream of a seed, with a CUDA kernel
+ *  on CUDA devices when it is built, or on the host and copied to the device otherwise.
+ */
+void PhiloxFill(DLTensor* out, int64_t seed, int64_t offset, double a, double b, bool normal) {
+  TVM_FFI_ICHECK(ffi::IsContiguous(*out));
+  TVM_FFI_ICHECK(out->dtype.code == kDLFloat && out->dtype.bits == 32 && out->dtype.lanes == 1)
+      << "The Philox random functions only support float32, but got "
+      << ffi::DLDataTypeToString(out->dtype);
+  TVM_FFI_ICHECK_GE(offset, 0) << "The offset of a Philox stream should not be negative";
+  if (out->device.device_type == kDLCPU) {
+    PhiloxFillCPU(out, static_cast<uint64_t>(seed), static_cast<uint64_t>(offset),
+                  static_cast<float>(a), static_cast<float>(b), normal);
+    return;
+  }
+  if (out->device.device_type == kDLCUDA) {
+    const auto fill_cuda = tvm::ffi::Function::GetGlobal("tvm.contrib.random.philox_fill_cuda");
+    if (fill_cuda.has_value()) {
+      (*fill_cuda)(out, seed, offset, a, b, normal);
+      return;
+    }
+  }
+  runtime::Tensor local = runtime::Tensor::Empty(
+      std::vector<int64_t>{out->shape, out->shape + out->ndim}, out->dtype, {kDLCPU, 0});
+  const DLTensor* tensor = local.GetDLTensorPtr();
+  PhiloxFillCPU(const_cast<DLTensor*>(tensor), static_cast<uint64_t>(seed),
+                static_cast<uint64_t>(offset), static_cast<float>(a), static_cast<float>(b),
+                normal);
+  runtime::Tensor::CopyFromTo(tensor, out);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
+      .def("tvm.contrib.random.philox_uniform",
+           [](int64_t seed, int64_t offset, double low, double high, DLTensor* out) {
+             PhiloxFill(out, seed, offset, low, high, false);
+           })
+      .def("tvm.contrib.random.philox_normal",
+           [](int64_t seed, int64_t offset, double loc, double scale, DLTensor* out) {
+             PhiloxFill(out, seed, offset, loc, scale, true);
+           })
       .def_packed("tvm.contrib.random.randint",
                   [](ffi::PackedArgs args, ffi::Any* ret) {
                     RandomThreadLocalEntry* entry = RandomThreadLocalEntry::ThreadLocal();
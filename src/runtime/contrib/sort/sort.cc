@@ -26,6 +26,7 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
 #include <vector>
@@ -159,16 +160,80 @@ void RegisterArgsortNMS() {
       });
 }
 
+// The number of elements below which sorting is not worth splitting across threads.
+constexpr int64_t kMinParallelSortSize = 1 << 16;
+
+// Run f(begin, end) over ranges of [0, n) on the threads of the runtime thread pool,
+// with at least min_range_size items per range.
+template <typename F>
+void ParallelRanges(int64_t n, int64_t min_range_size, F f) {
+  int64_t num_ranges = std::min<int64_t>(threading::NumThreads(), n / min_range_size);
+  if (num_ranges <= 1) {
+    f(0, n);
+    return;
+  }
+  parallel_for_with_threading_backend(
+      [&](int64_t r) { f(r * n / num_ranges, (r + 1) * n / num_ranges); }, 0, num_ranges);
+}
+
+// Stable sort of a large array on several threads: the chunks of the array are sorted in
+// parallel, then adjacent sorted chunks are merged pairwise until one is left.
+template <typename T, typename Compare>
+void ParallelStableSort(std::vector<T>* data, Compare cmp) {
+  int64_t n = data->size();
+  int64_t num_chunks = std::min<int64_t>(threading::NumThreads(), n / kMinParallelSortSize);
+  if (num_chunks <= 1) {
+    std::stable_sort(data->begin(), data->end(), cmp);
+    return;
+  }
+  std::vector<int64_t> bounds;
+  for (int64_t c = 0; c <= num_chunks; ++c) {
+    bounds.push_back(c * n / num_chunks);
+  }
+  T* src = data->data();
+  parallel_for_with_threading_backend(
+      [&](int64_t c) { std::stable_sort(src + bounds[c], src + bounds[c + 1], cmp); }, 0,
+      num_chunks);
+
+  std::vector<T> buffer(n);
+  T* dst = buffer.data();
+  while (bounds.size() > 2) {
+    int64_t num_merges = bounds.size() / 2;
+    parallel_for_with_threading_backend(
+        [&](int64_t m) {
+          size_t c = 2 * m;
+          if (c + 2 < bounds.size()) {
+            // std::merge takes the elements of the first range first on ties, which keeps it
+            // stable.
+            std::merge(src + bounds[c], src + bounds[c + 1], src + bounds[c + 1],
+                       src + bounds[c + 2], dst + bounds[c], cmp);
+          } else {
+            std::copy(src + bounds[c], src + bounds[c + 1], dst + bounds[c]);
+          }
+        },
+        0, num_merges);
+    std::vector<int64_t> merged_bounds;
+    for (size_t c = 0; c + 1 < bounds.size(); c += 2) {
+      merged_bounds.push_back(bounds[c]);
+    }
+    merged_bounds.push_back(n);
+    bounds = std::move(merged_bounds);
+    std::swap(src, dst);
+  }
+  if (src != data->data()) {
+    std::copy(src, src + n, data->data());
+  }
+}
+
 template <typename DataType, typename OutType>
 void sort_impl(
     DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend,
     std::function<void(OutType*, size_t, const std::pair<int64_t, DataType>&)> epilogue) {
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
 
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
   for (int i = 0; i < input->ndim; ++i) {
     if (i < axis) {
       axis_mul_before *= input->shape[i];
@@ -176,23 +241,49 @@ void sort_impl(
       axis_mul_after *= input->shape[i];
     }
   }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
-      }
+  int64_t axis_size = input->shape[axis];
+  int64_t num_rows = axis_mul_before * axis_mul_after;
+
+  auto sort_row = [&](int64_t row, std::vector<std::pair<int64_t, DataType>>* sorter,
+                      bool parallel) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t base_idx = i * axis_size * axis_mul_after + j;
+    sorter->clear();
+    for (int64_t k = 0; k < axis_size; ++k) {
+      int64_t full_idx = base_idx + k * axis_mul_after;
+      sorter->emplace_back(std::make_pair(k, data_ptr[full_idx]));
+    }
+    if (parallel) {
       if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
+        ParallelStableSort(sorter, CompareAscend<DataType>);
       } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
+        ParallelStableSort(sorter, CompareDescend<DataType>);
       }
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        epilogue(out_ptr, base_idx + k * axis_mul_after, sorter[k]);
+    } else if (is_ascend) {
+      std::stable_sort(sorter->begin(), sorter->end(), CompareAscend<DataType>);
+    } else {
+      std::stable_sort(sorter->begin(), sorter->end(), CompareDescend<DataType>);
+    }
+    for (int64_t k = 0; k < axis_size; ++k) {
+      epilogue(out_ptr, base_idx + k * axis_mul_after, (*sorter)[k]);
+    }
+  };
+
+  if (num_rows >= threading::NumThreads() || axis_size < 2 * kMinParallelSortSize) {
+    // Enough rows to keep the threads busy: each thread sorts a range of the rows.
+    int64_t min_rows_per_range = std::max<int64_t>(1, kMinParallelSortSize / (axis_size + 1));
+    ParallelRanges(num_rows, min_rows_per_range, [&](int64_t begin, int64_t end) {
+      std::vector<std::pair<int64_t, DataType>> sorter;
+      for (int64_t row = begin; row < end; ++row) {
+        sort_row(row, &sorter, /*parallel=*/false);
       }
+    });
+  } else {
+    // A few large rows: the threads sort each row together.
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    for (int64_t row = 0; row < num_rows; ++row) {
+      sort_row(row, &sorter, /*parallel=*/true);
     }
   }
 }
@@ -359,23 +450,75 @@ void RegisterSort() {
   });
 }
 
-template <typename DataType, typename IndicesType>
-void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, int axis,
-          bool is_ascend) {
+template <typename DataType, bool is_ascend>
+bool CompareTopk(const std::pair<int64_t, DataType>& lhs, const std::pair<int64_t, DataType>& rhs) {
+  if constexpr (is_ascend) {
+    return CompareAscend<DataType, true>(lhs, rhs);
+  } else {
+    return CompareDescend<DataType, true>(lhs, rhs);
+  }
+}
+
+// Collect the top-k elements of the range [begin, end) of a row into a heap, whose top is the
+// last of the top-k elements.
+template <typename DataType, bool is_ascend>
+void TopkRange(const DataType* row_ptr, int64_t stride, int64_t begin, int64_t end, int64_t k,
+               std::vector<std::pair<int64_t, DataType>>* heap) {
+  constexpr auto cmp = CompareTopk<DataType, is_ascend>;
+  // The number of contiguous elements compared to the top of the heap at once.
+  constexpr int64_t kBlockSize = 16;
+
+  heap->clear();
+  int64_t index = begin;
+  for (; index < end && static_cast<int64_t>(heap->size()) < k; ++index) {
+    heap->emplace_back(std::make_pair(index, row_ptr[index * stride]));
+  }
+  if (heap->empty()) return;
+  std::make_heap(heap->begin(), heap->end(), cmp);
+
+  while (index < end) {
+    int64_t block_end = std::min(index + kBlockSize, end);
+    if (stride == 1 && block_end - index == kBlockSize) {
+      // The elements come after the ones in the heap, so only the elements strictly beyond the
+      // top of the heap enter it. Blocks without such elements are skipped with a branch-free
+      // loop, which the compiler vectorizes.
+      DataType threshold = (*heap)[0].second;
+      bool any = false;
+      for (int64_t t = index; t < block_end; ++t) {
+        if constexpr (is_ascend) {
+          any |= row_ptr[t] < threshold;
+        } else {
+          any |= row_ptr[t] > threshold;
+        }
+      }
+      if (!any) {
+        index = block_end;
+        continue;
+      }
+    }
+    for (; index < block_end; ++index) {
+      std::pair<int64_t, DataType> cur_val = {index, row_ptr[index * stride]};
+      if (cmp(cur_val, (*heap)[0])) {
+        heap->push_back(cur_val);
+        std::push_heap(heap->begin(), heap->end(), cmp);
+        std::pop_heap(heap->begin(), heap->end(), cmp);
+        heap->pop_back();
+      }
+    }
+  }
+}
+
+template <typename DataType, typename IndicesType, bool is_ascend>
+void topk_impl(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, int axis) {
+  constexpr auto cmp = CompareTopk<DataType, is_ascend>;
   DataType* data_ptr = static_cast<DataType*>(input->data);
   DataType* values_ptr =
       (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
 
-  // Maintain a min/max containing the top-k elements
-  std::vector<std::pair<int64_t, DataType>> running_heap;
-
-  // Need +1 when inserting new element before maintaining heap invariant
-  running_heap.reserve(k + 1);
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
   for (int i = 0; i < input->ndim; ++i) {
     if (i < axis) {
       axis_mul_before *= input->shape[i];
@@ -383,65 +526,81 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       axis_mul_after *= input->shape[i];
     }
   }
+  int64_t axis_size = input->shape[axis];
   if (k < 1) {
-    k = input->shape[axis];
+    k = axis_size;
   }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      running_heap.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
-      int64_t dst_base_idx = i * k * axis_mul_after + j;
-
-      // Start by creating min/max heap with fixed-k elements
-      int cur_axis_index = 0;
-      for (; cur_axis_index < k && cur_axis_index < input->shape[axis]; cur_axis_index++) {
-        int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        running_heap.emplace_back(std::make_pair(cur_axis_index, data_ptr[full_idx]));
+  int64_t num_rows = axis_mul_before * axis_mul_after;
+
+  // Write the sorted top-k elements of a row.
+  auto write_row = [&](int64_t row, std::vector<std::pair<int64_t, DataType>>* top) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t dst_base_idx = i * k * axis_mul_after + j;
+    std::sort(top->begin(), top->end(), cmp);
+    for (size_t kk = 0; kk < top->size(); ++kk) {
+      if (indices_ptr != nullptr) {
+        indices_ptr[dst_base_idx + kk * axis_mul_after] =
+            static_cast<IndicesType>((*top)[kk].first);
       }
-      if (!is_ascend) {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-      } else {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
+      if (values_ptr != nullptr) {
+        values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>((*top)[kk].second);
       }
-
-      // Iterate through all elements, adding to heap along the way
-      for (; cur_axis_index < input->shape[axis]; cur_axis_index++) {
-        int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        std::pair<int64_t, DataType> cur_val = {cur_axis_index, data_ptr[full_idx]};
-
-        // Eq. to cur_val.second > running_heap.second
-        if (!is_ascend && CompareDescend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          running_heap.pop_back();
-        } else if (is_ascend && CompareAscend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          running_heap.pop_back();
-        }
-      }
-
-      // finally sort heap and deliver results
-      if (is_ascend) {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-      } else {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
+    }
+  };
+  auto row_ptr = [&](int64_t row) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    return data_ptr + i * axis_size * axis_mul_after + j;
+  };
+
+  if (num_rows >= threading::NumThreads() || axis_size < 2 * kMinParallelSortSize) {
+    // Enough rows to keep the threads busy: each thread takes a range of the rows.
+    int64_t min_rows_per_range = std::max<int64_t>(1, kMinParallelSortSize / (axis_size + 1));
+    ParallelRanges(num_rows, min_rows_per_range, [&](int64_t begin, int64_t end) {
+      // Need +1 when inserting new element before maintaining heap invariant
+      std::vector<std::pair<int64_t, DataType>> heap;
+      heap.reserve(std::min<int64_t>(k, axis_size) + 1);
+      for (int64_t row = begin; row < end; ++row) {
+        TopkRange<DataType, is_ascend>(row_ptr(row), axis_mul_after, 0, axis_size, k, &heap);
+        write_row(row, &heap);
       }
+    });
+    return;
+  }
 
-      for (uint32_t kk = 0; kk < running_heap.size(); ++kk) {
-        if (indices_ptr != nullptr) {
-          indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(running_heap[kk].first);
-        }
-        if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<DataType>(running_heap[kk].second);
-        }
-      }
+  // A few large rows: the threads find the top-k of ranges of each row, which are merged. The
+  // order is total, so the result is the same as the one of a single thread.
+  int64_t num_ranges = std::min<int64_t>(threading::NumThreads(), axis_size / kMinParallelSortSize);
+  std::vector<std::vector<std::pair<int64_t, DataType>>> heaps(num_ranges);
+  std::vector<std::pair<int64_t, DataType>> top;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    const DataType* ptr = row_ptr(row);
+    parallel_for_with_threading_backend(
+        [&](int64_t r) {
+          TopkRange<DataType, is_ascend>(ptr, axis_mul_after, r * axis_size / num_ranges,
+                                         (r + 1) * axis_size / num_ranges, k, &heaps[r]);
+        },
+        0, num_ranges);
+    top.clear();
+    for (const auto& heap : heaps) {
+      top.insert(top.end(), heap.begin(), heap.end());
+    }
+    if (static_cast<int64_t>(top.size()) > k) {
+      std::nth_element(top.begin(), top.begin() + k, top.end(), cmp);
+      top.resize(k);
     }
+    write_row(row, &top);
+  }
+}
+
+template <typename DataType, typename IndicesType>
+void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, int axis,
+          bool is_ascend) {
+  if (is_ascend) {
+    topk_impl<DataType, IndicesType, true>(input, out_values, out_indices, k, axis);
+  } else {
+    topk_impl<DataType, IndicesType, false>(input, out_values, out_indices, k, axis);
   }
 }
 
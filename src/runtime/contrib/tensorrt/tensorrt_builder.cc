@@ -193,11 +193,17 @@ TensorRTEngineAndContext TensorRTBuilder::BuildEngine() {
                                  data_entry_[entry_id]->shape + data_entry_[entry_id]->ndim);
       auto dims = VectorToTrtDims(shape);
 
+      const bool dynamic_batch = network_->getInput(i)->getDimensions().nbDims >= 1 &&
+                                 network_->getInput(i)->getDimensions().d[0] == -1;
+
       profile->setDimensions(name, nvinfer1::OptProfileSelector::kOPT, dims);
+      // Allow batch sizes up to batch_size_ when dynamic batching is used.
+      if (dynamic_batch && dims.nbDims >= 1 && dims.d[0] < batch_size_) {
+        dims.d[0] = batch_size_;
+      }
       profile->setDimensions(name, nvinfer1::OptProfileSelector::kMAX, dims);
       // Set minimum batch size to 1 when dynamic batching is used.
-      if (network_->getInput(i)->getDimensions().nbDims >= 1 &&
-          network_->getInput(i)->getDimensions().d[0] == -1) {
+      if (dynamic_batch) {
         dims.d[0] = 1;
       }
       profile->setDimensions(name, nvinfer1::OptProfileSelector::kMIN, dims);
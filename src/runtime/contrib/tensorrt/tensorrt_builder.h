@@ -69,7 +69,8 @@ class TensorRTBuilder {
    * \param max_workspace_size Workspace size parameter for TensorRT engine build phase.
    * \param use_implicit_batch Whether to use implicit batch mode (default)
    * \param use_fp16 Whether to automatically convert a model to fp16
-   * \param batch_size If use_implicit_batch,
+   * \param batch_size If use_implicit_batch, the max batch size of the engine. Else, the
+   * largest batch size of the optimization profile of inputs with a dynamic batch dimension.
    */
   TensorRTBuilder(TensorRTLogger* logger, const std::vector<const DLTensor*>& data_entry,
                   size_t max_workspace_size, bool use_implicit_batch, bool use_fp16, int batch_size,
@@ -27,8 +27,11 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/tensor.h>
 
-#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -39,6 +42,7 @@
 #include "../json/json_runtime.h"
 
 #ifdef TVM_GRAPH_EXECUTOR_TENSORRT
+#include "../../cuda/cuda_common.h"
 #include "NvInfer.h"
 #include "tensorrt_builder.h"
 #include "tensorrt_calibrator.h"
@@ -74,10 +78,12 @@ class TensorRTRuntime : public JSONRuntimeBase {
         use_implicit_batch_(true),
         max_workspace_size_(size_t(1) << 30),
         max_batch_size_(-1),
+        max_dynamic_batch_size_(0),
         multi_engine_mode_(false),
         use_fp16_(false) {
     const bool use_int8 = support::GetEnv("TVM_TENSORRT_USE_INT8", false);
     multi_engine_mode_ = support::GetEnv("TVM_TENSORRT_MULTI_ENGINE", false);
+    max_dynamic_batch_size_ = support::GetEnv("TVM_TENSORRT_MAX_DYNAMIC_BATCH_SIZE", 0);
     num_calibration_batches_remaining_ = support::GetEnv("TENSORRT_NUM_CALI_INT8", 0);
     if (use_int8) {
       TVM_FFI_ICHECK(num_calibration_batches_remaining_ != 0)
@@ -152,6 +158,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
       it.second.engine->destroy();
     }
     trt_engine_cache_.clear();
+    bound_engine_ = nullptr;
   }
 
   ~TensorRTRuntime() override {
@@ -165,11 +172,78 @@ class TensorRTRuntime : public JSONRuntimeBase {
     auto& engine_and_context = GetOrBuildEngine();
     int batch_size = GetBatchSize();
     if (batch_size == 0) return;
+    auto context = engine_and_context.context;
+    // The bindings of the previous call still hold when the same engine runs on the same
+    // buffers, which skips the binding lookups and the shape setup.
+    if (IOBindingsChanged() || engine_and_context.engine != bound_engine_) {
+      BindEngine(engine_and_context);
+    }
+    // Copy inputs to GPU buffers if needed.
+    for (const auto& binding : engine_bindings_) {
+      if (binding.is_input && binding.device_buffer.defined()) {
+        binding.device_buffer.CopyFrom(data_entry_[binding.entry_id]);
+      }
+    }
+
+    // add batch data to calibrator
+    if (num_calibration_batches_remaining_ > 0) {
+      if (calibrator_ != nullptr) {
+        LOG(INFO) << "Starting adding last " << num_calibration_batches_remaining_
+                  << "-th batch data to the calibrator";
+        calibrator_->AddBatchData(bindings_, binding_sizes_);
+        num_calibration_batches_remaining_--;
+      }
+      return;
+    }
+
+#if TRT_VERSION_GE(6, 0, 1)
+    if (use_implicit_batch_) {
+      TVM_FFI_ICHECK(context->execute(batch_size, bindings_.data())) << "Running TensorRT failed.";
+    } else {
+      TVM_FFI_ICHECK(context->executeV2(bindings_.data())) << "Running TensorRT failed.";
+    }
+#else
+    TVM_FFI_ICHECK(context->execute(batch_size, bindings_.data())) << "Running TensorRT failed.";
+#endif
+
+    // Copy outputs from GPU buffers if needed.
+    for (const auto& binding : engine_bindings_) {
+      if (!binding.is_input && binding.device_buffer.defined()) {
+        binding.device_buffer.CopyTo(const_cast<DLTensor*>(data_entry_[binding.entry_id]));
+      }
+    }
+  }
+
+ private:
+  /*! \brief An input or output entry, bound to an engine. */
+  struct EngineBinding {
+    uint32_t entry_id;
+    bool is_input;
+    /*! \brief The GPU buffer standing for the entry if it is not on the GPU, undefined else. */
+    Tensor device_buffer;
+  };
+
+  /*!
+   * \brief Bind the current inputs and outputs to an engine: set the binding pointers to the
+   * entries on the GPU, or to GPU buffers for the others, and the input shapes of the context.
+   */
+  void BindEngine(const TensorRTEngineAndContext& engine_and_context) {
     auto engine = engine_and_context.engine;
     auto context = engine_and_context.context;
     const int num_bindings = engine->getNbBindings();
-    std::vector<void*> bindings(num_bindings, nullptr);
-    std::vector<size_t> binding_sizes(num_bindings, 0);
+    bindings_.assign(num_bindings, nullptr);
+    binding_sizes_.assign(num_bindings, 0);
+    engine_bindings_.clear();
+    auto bind = [&](uint32_t eid, int binding_index, bool is_input) {
+      EngineBinding binding{eid, is_input, Tensor()};
+      if (data_entry_[eid]->device.device_type == kDLCUDA) {
+        bindings_[binding_index] = data_entry_[eid]->data;
+      } else {
+        binding.device_buffer = GetOrAllocateDeviceBuffer(eid, binding_index);
+        bindings_[binding_index] = binding.device_buffer->data;
+      }
+      engine_bindings_.push_back(std::move(binding));
+    };
     // Setup input bindings.
     for (size_t i = 0; i < input_nodes_.size(); ++i) {
       auto nid = input_nodes_[i];
@@ -187,71 +261,26 @@ class TensorRTRuntime : public JSONRuntimeBase {
             TVM_FFI_ICHECK(context->setBindingDimensions(binding_index, dims));
           }
 #endif
-          if (data_entry_[eid]->device.device_type == kDLCUDA) {
-            bindings[binding_index] = data_entry_[eid]->data;
-          } else {
-            auto device_buffer = GetOrAllocateDeviceBuffer(eid, binding_index);
-            device_buffer.CopyFrom(data_entry_[eid]);
-            bindings[binding_index] = device_buffer->data;
-          }
+          bind(eid, binding_index, true);
 
           auto dims = engine->getBindingDimensions(binding_index);
           int num_elements = 1;
           for (int i = 0; i < dims.nbDims; ++i) num_elements *= dims.d[i];
-          binding_sizes[binding_index] = num_elements;
+          binding_sizes_[binding_index] = num_elements;
         }
       }
     }
-
-    // add batch data to calibrator
-    if (num_calibration_batches_remaining_ > 0) {
-      if (calibrator_ != nullptr) {
-        LOG(INFO) << "Starting adding last " << num_calibration_batches_remaining_
-                  << "-th batch data to the calibrator";
-        calibrator_->AddBatchData(bindings, binding_sizes);
-        num_calibration_batches_remaining_--;
-      }
-      return;
-    }
-
     // Setup output bindings.
     for (size_t i = 0; i < outputs_.size(); ++i) {
       uint32_t eid = EntryID(outputs_[i]);
       const std::string& name = engine_and_context.outputs[i];
       int binding_index = engine->getBindingIndex(name.c_str());
       TVM_FFI_ICHECK_NE(binding_index, -1);
-      if (data_entry_[eid]->device.device_type == kDLCUDA) {
-        bindings[binding_index] = data_entry_[eid]->data;
-      } else {
-        auto device_buffer = GetOrAllocateDeviceBuffer(eid, binding_index);
-        bindings[binding_index] = device_buffer->data;
-      }
-    }
-
-#if TRT_VERSION_GE(6, 0, 1)
-    if (use_implicit_batch_) {
-      TVM_FFI_ICHECK(context->execute(batch_size, bindings.data())) << "Running TensorRT failed.";
-    } else {
-      TVM_FFI_ICHECK(context->executeV2(bindings.data())) << "Running TensorRT failed.";
-    }
-#else
-    TVM_FFI_ICHECK(context->execute(batch_size, bindings.data())) << "Running TensorRT failed.";
-#endif
-
-    // Copy outputs from GPU buffers if needed.
-    for (size_t i = 0; i < outputs_.size(); ++i) {
-      uint32_t eid = EntryID(outputs_[i]);
-      const std::string& name = engine_and_context.outputs[i];
-      int binding_index = engine->getBindingIndex(name.c_str());
-      TVM_FFI_ICHECK_NE(binding_index, -1);
-      if (data_entry_[eid]->device.device_type != kDLCUDA) {
-        auto device_buffer = GetOrAllocateDeviceBuffer(eid, binding_index);
-        device_buffer.CopyTo(const_cast<DLTensor*>(data_entry_[eid]));
-      }
+      bind(eid, binding_index, false);
     }
+    bound_engine_ = engine;
   }
 
- private:
   /*! \brief Get batch size for engine from the runtime input shapes. */
   int GetBatchSize() {
     return data_entry_[input_var_eid_[0]]->ndim == 0 ? 1 : data_entry_[input_var_eid_[0]]->shape[0];
@@ -293,6 +322,11 @@ class TensorRTRuntime : public JSONRuntimeBase {
       return trt_engine_cache_.at(std::make_pair(symbol_name_, compatible_engine_batch_size));
     }
 
+    // In single engine mode with explicit batch, the optimization profile of the engine covers
+    // the batch sizes up to max_dynamic_batch_size_, so that larger batches do not rebuild it.
+    if (!multi_engine_mode_ && !use_implicit_batch_ && !use_int8) {
+      batch_size = std::max(batch_size, max_dynamic_batch_size_);
+    }
     // For single engine mode, remove previous engine and update max_batch_size.
     if (!multi_engine_mode_) {
       DestroyEngines();
@@ -318,7 +352,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
     VLOG(1) << "Finished building TensorRT engine for subgraph " << symbol_name_
             << " with batch size " << batch_size;
-    CacheEngineToDisk();
+    CacheEngineToDisk(batch_size);
     return trt_engine_cache_.at(std::make_pair(symbol_name_, batch_size));
   }
 
@@ -357,18 +391,36 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will check that directory for
    * already built TRT engines and load into trt_engine_cache_ so they don't
-   * have to be built at first inference.
+   * have to be built at first inference. In single engine mode, only the engine of the largest
+   * batch size is loaded.
    */
   bool GetCachedEnginesFromDisk() {
     std::string cache_dir = support::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return false;
-    std::string key = GetSubgraphKey();
-    std::string path = cache_dir + "/" + key + ".plan";
-    // Check if engine is in the cache.
-    std::ifstream infile(path, std::ios::binary);
-    if (!infile.good()) return false;
+    const std::string prefix = GetSubgraphKey() + "_b";
+    std::vector<std::pair<int, std::string>> plans;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir, error)) {
+      std::string file_name = entry.path().filename().string();
+      if (file_name.rfind(prefix, 0) != 0 || entry.path().extension() != ".plan") continue;
+      std::string batch = entry.path().stem().string().substr(prefix.size());
+      if (batch.empty() || batch.find_first_not_of("0123456789") != std::string::npos) continue;
+      plans.emplace_back(std::stoi(batch), entry.path().string());
+    }
+    if (plans.empty()) return false;
+    std::sort(plans.begin(), plans.end());
+    if (!multi_engine_mode_) {
+      plans.erase(plans.begin(), plans.end() - 1);
+    }
+    for (const auto& plan : plans) {
+      LoadEngineFromDisk(plan.second);
+    }
+    return true;
+  }
+
+  /*! \brief Load a serialized engine and its metadata into trt_engine_cache_. */
+  void LoadEngineFromDisk(const std::string& path) {
     LOG(INFO) << "Loading cached TensorRT engine from " << path;
-    infile.close();
     std::string serialized_engine;
     LoadBinaryFromFile(path, &serialized_engine);
     // Deserialize engine
@@ -376,10 +428,12 @@ class TensorRTRuntime : public JSONRuntimeBase {
     TensorRTEngineAndContext engine_and_context;
     engine_and_context.engine =
         runtime->deserializeCudaEngine(&serialized_engine[0], serialized_engine.size(), nullptr);
+    TVM_FFI_ICHECK(engine_and_context.engine)
+        << "Failed to deserialize the TensorRT engine of " << path;
     engine_and_context.context = engine_and_context.engine->createExecutionContext();
     // Load metadata
     namespace json = ::tvm::ffi::json;
-    std::string meta_path = cache_dir + "/" + key + ".meta";
+    std::string meta_path = path.substr(0, path.size() - 5) + ".meta";
     std::string serialized_meta;
     LoadBinaryFromFile(meta_path, &serialized_meta);
     auto meta_obj = json::Parse(serialized_meta).cast<json::Object>();
@@ -403,19 +457,17 @@ class TensorRTRuntime : public JSONRuntimeBase {
     // Read batch_size
     batch_size = static_cast<int>(meta_obj.at(ffi::String("batch_size")).cast<int64_t>());
     trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
-    max_batch_size_ = batch_size;
+    max_batch_size_ = std::max(max_batch_size_, batch_size);
     LOG(INFO) << "finished loading engine and context ... ";
-    return true;
   }
 
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will save the engine to that
    * directory so it can be loaded later.
    */
-  void CacheEngineToDisk() {
-    int batch_size = GetBatchSize();
+  void CacheEngineToDisk(int batch_size) {
     std::string cache_dir = support::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return;
-    std::string key = GetSubgraphKey();
+    std::string key = GetSubgraphKey() + "_b" + std::to_string(batch_size);
     std::string path = cache_dir + "/" + key + ".plan";
     DLOG(INFO) << "Caching TensorRT engine to " << path;
     // Serialize engine to disk
@@ -446,11 +498,46 @@ class TensorRTRuntime : public JSONRuntimeBase {
     SaveBinaryToFile(meta_path, std::string(json::Stringify(meta_obj)));
   }
 
+  /*! \brief Mix bytes into a 64-bit FNV-1a hash. */
+  static uint64_t HashBytes(const void* data, size_t size, uint64_t hash) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+  }
+
+  /*!
+   * \brief The key of the engines of the subgraph in TVM_TENSORRT_CACHE_DIR. It hashes the graph
+   * and its constants, and names the TensorRT version, the GPU architecture and the builder flags
+   * the engines depend on, so that models, GPUs and configs can share a cache directory. The
+   * constants are hashed once, as the module is initialized.
+   */
   std::string GetSubgraphKey() {
-    // Using this key will only allow a single model per TVM_TENSORRT_CACHE_DIR directory. We could
-    // instead use a hash of graph_json and all weights to allow many models in the same directory,
-    // but the cost of computing the hash is high.
-    return symbol_name_ + (support::GetEnv("TVM_TENSORRT_USE_FP16", false) ? "_fp16" : "_fp32");
+    if (!subgraph_key_.empty()) return subgraph_key_;
+    uint64_t hash = HashBytes(graph_json_.data(), graph_json_.size(), 0xCBF29CE484222325ULL);
+    for (uint32_t nid : const_idx_) {
+      const DLTensor* tensor = data_entry_[EntryID(nid, 0)];
+      hash = HashBytes(tensor->shape, tensor->ndim * sizeof(int64_t), hash);
+      hash = HashBytes(&tensor->dtype, sizeof(tensor->dtype), hash);
+      if (tensor->device.device_type == kDLCPU) {
+        hash = HashBytes(static_cast<const char*>(tensor->data) + tensor->byte_offset,
+                         GetDataSize(*tensor), hash);
+      }
+    }
+    int device_id = 0, major = 0, minor = 0;
+    CUDA_CALL(cudaGetDevice(&device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device_id));
+    const bool use_fp16 = support::GetEnv("TVM_TENSORRT_USE_FP16", false) || use_fp16_;
+    const bool use_int8 = support::GetEnv("TVM_TENSORRT_USE_INT8", false);
+    std::ostringstream os;
+    os << symbol_name_ << "_" << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec
+       << "_trt" << NV_TENSORRT_MAJOR << "." << NV_TENSORRT_MINOR << "." << NV_TENSORRT_PATCH
+       << "_sm" << major << minor << (use_int8 ? "_int8" : (use_fp16 ? "_fp16" : "_fp32"))
+       << (use_implicit_batch_ ? "_implicit" : "_explicit");
+    subgraph_key_ = os.str();
+    return subgraph_key_;
   }
 
   /*! \brief Retreive a GPU buffer for input or output or allocate if needed. */
@@ -499,9 +586,24 @@ class TensorRTRuntime : public JSONRuntimeBase {
    * used by all engines. */
   std::unordered_map<int, Tensor> device_buffers_;
 
+  /*! \brief The engine the inputs and outputs of the previous call are bound to. */
+  nvinfer1::ICudaEngine* bound_engine_ = nullptr;
+
+  /*! \brief The binding pointers of bound_engine_, by binding index. */
+  std::vector<void*> bindings_;
+
+  /*! \brief The number of elements of the input bindings of bound_engine_, by binding index. */
+  std::vector<size_t> binding_sizes_;
+
+  /*! \brief The inputs and outputs bound to bound_engine_. */
+  std::vector<EngineBinding> engine_bindings_;
+
   /*! \brief TensorRT logger. */
   TensorRTLogger logger_;
 
+  /*! \brief The key of the engines in TVM_TENSORRT_CACHE_DIR, computed at first use. */
+  std::string subgraph_key_;
+
 #else   // TVM_GRAPH_EXECUTOR_TENSORRT
   void Run() override {
     TVM_FFI_THROW(InternalError) << "TensorRT runtime is not enabled. "
@@ -515,7 +617,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
   bool GetCachedEnginesFromDisk() { return false; }
 
-  void CacheEngineToDisk() {}
+  void CacheEngineToDisk(int batch_size) {}
 #endif  // TVM_GRAPH_EXECUTOR_TENSORRT
 
   bool use_implicit_batch_;
@@ -529,6 +631,11 @@ class TensorRTRuntime : public JSONRuntimeBase {
    * (multi_engine_mode=false). */
   int max_batch_size_;
 
+  /*! \brief The batch size up to which the optimization profile of an engine built for a dynamic
+   * batch dimension ranges, in single-engine mode with explicit batch. Set by
+   * TVM_TENSORRT_MAX_DYNAMIC_BATCH_SIZE; 0 to only cover the batch sizes seen so far. */
+  int max_dynamic_batch_size_;
+
   /*! \brief The strategy to use for dynamic batching. With multi_engine_mode=true, a new TensorRT
    * engine is created for each unique batch size encountered. With multi_engine_mode=false, only
    * one TensorRT engine is alive at any given time. It is replaced if a higher batch size is
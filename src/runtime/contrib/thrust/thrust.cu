@@ -22,6 +22,9 @@
  */
 
 #include <dlpack/dlpack.h>
+#if defined(__CUDACC__)
+#include <cub/device/device_segmented_radix_sort.cuh>
+#endif
 #include <thrust/device_ptr.h>
 #include <thrust/device_vector.h>
 #include <thrust/gather.h>
@@ -38,7 +41,9 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "../../cuda/cuda_common.h"
@@ -92,12 +97,48 @@ class WorkspaceMemoryResource : public thrust::mr::memory_resource<void*> {
   size_t workspace_size = 0;
 };
 
-auto get_thrust_exec_policy(WorkspaceMemoryResource* memory_resouce) {
+cudaStream_t get_current_stream() {
   int device_id;
   CUDA_CALL(cudaGetDevice(&device_id));
-  cudaStream_t stream = static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, device_id));
-  return thrust::cuda::par_nosync(memory_resouce).on(stream);
+  return static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, device_id));
+}
+
+auto get_thrust_exec_policy(WorkspaceMemoryResource* memory_resouce) {
+  return thrust::cuda::par_nosync(memory_resouce).on(get_current_stream());
+}
+
+#if defined(__CUDACC__)
+// Sorts the segments [begin_offsets[s], end_offsets[s]) of keys_in along with values_in, with the
+// segmented radix sort of cub, in one pass over all the segments. The temporary storage of cub is
+// taken from the memory resource, i.e. from the workspace when one is provided.
+template <typename KeyType, typename ValueType, typename OffsetIterator>
+void cub_segmented_sort_pairs(const KeyType* keys_in, KeyType* keys_out, const ValueType* values_in,
+                              ValueType* values_out, int64_t num_items, int64_t num_segments,
+                              OffsetIterator begin_offsets, OffsetIterator end_offsets,
+                              bool is_ascend, WorkspaceMemoryResource* mr) {
+  TVM_FFI_ICHECK_LE(num_items, std::numeric_limits<int>::max());
+  TVM_FFI_ICHECK_LE(num_segments, std::numeric_limits<int>::max());
+  cudaStream_t stream = get_current_stream();
+  auto sort = [&](void* temp_storage, size_t& temp_storage_bytes) {
+    if (is_ascend) {
+      return cub::DeviceSegmentedRadixSort::SortPairs(
+          temp_storage, temp_storage_bytes, keys_in, keys_out, values_in, values_out,
+          static_cast<int>(num_items), static_cast<int>(num_segments), begin_offsets, end_offsets,
+          0, sizeof(KeyType) * 8, stream);
+    }
+    return cub::DeviceSegmentedRadixSort::SortPairsDescending(
+        temp_storage, temp_storage_bytes, keys_in, keys_out, values_in, values_out,
+        static_cast<int>(num_items), static_cast<int>(num_segments), begin_offsets, end_offsets, 0,
+        sizeof(KeyType) * 8, stream);
+  };
+  constexpr size_t kAlignment = 256;
+  size_t temp_storage_bytes = 0;
+  CUDA_CALL(sort(nullptr, temp_storage_bytes));
+  void* temp_storage = mr->do_allocate(temp_storage_bytes, kAlignment);
+  CUDA_CALL(sort(temp_storage, temp_storage_bytes));
+  mr->do_deallocate(temp_storage, temp_storage_bytes, kAlignment);
 }
+#endif
 
 // Performs sorting along axis -1 and returns both sorted values and indices.
 template <typename DataType, typename IndicesType>
@@ -114,10 +155,9 @@ void thrust_sort(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, b
   for (int i = 0; i < input->ndim; ++i) {
     size *= input->shape[i];
   }
-  thrust::copy(policy, data_ptr, data_ptr + size, values_ptr);
-
   if (size == static_cast<size_t>(input->shape[input->ndim - 1])) {
     // A fast path for single segment case
+    thrust::copy(policy, data_ptr, data_ptr + size, values_ptr);
     thrust::sequence(indices_ptr, indices_ptr + n_values);
     if (is_ascend) {
       thrust::sort_by_key(policy, values_ptr, values_ptr + n_values, indices_ptr);
@@ -126,6 +166,25 @@ void thrust_sort(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, b
                           thrust::greater<DataType>());
     }
   } else {
+#if defined(__CUDACC__)
+    // Sort all the rows at once, with the indices 0, 1, 2 ... 0, 1, 2 ... of their elements.
+    IndicesType* init_indices = static_cast<IndicesType*>(
+        mr.do_allocate(sizeof(IndicesType) * size, std::max(sizeof(IndicesType), sizeof(int))));
+    auto counting_iter = thrust::counting_iterator<int64_t>(0);
+    thrust::transform(policy, counting_iter, counting_iter + size,
+                      thrust::device_ptr<IndicesType>(init_indices),
+                      [n_values] __host__ __device__(int64_t i) {
+                        return static_cast<IndicesType>(i % n_values);
+                      });  // NOLINT(*)
+    auto row_offsets = thrust::make_transform_iterator(
+        thrust::counting_iterator<int>(0),
+        [n_values] __host__ __device__(int r) { return r * n_values; });  // NOLINT(*)
+    cub_segmented_sort_pairs(static_cast<const DataType*>(input->data),
+                             static_cast<DataType*>(out_values->data), init_indices,
+                             static_cast<IndicesType*>(out_indices->data), size, size / n_values,
+                             row_offsets, row_offsets + 1, is_ascend, &mr);
+#else
+    thrust::copy(policy, data_ptr, data_ptr + size, values_ptr);
     // segmented sort by key
     // Follow the back-to-back stable_sort_by_key strategy explained below
     // https://groups.google.com/g/thrust-users/c/BoLsxO6b4FY
@@ -168,6 +227,7 @@ void thrust_sort(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, b
     // in the segment do not change and hence they remain sorted.
     auto key_val_zip = thrust::make_zip_iterator(thrust::make_tuple(values_ptr, indices_ptr));
     thrust::stable_sort_by_key(policy, segment_ids, segment_ids + size, key_val_zip);
+#endif
   }
 }
 
@@ -261,6 +321,115 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   });
 }
 
+#if defined(__CUDACC__)
+// Sorts each segment [offsets[s], offsets[s + 1]) of a 1-D input, e.g. the candidates of each
+// sequence of a batch in sampling. The indices are relative to the start of their segment. The
+// elements outside of all the segments are not written to the outputs.
+template <typename DataType, typename IndicesType, typename OffsetType>
+void thrust_segmented_sort(DLTensor* input, DLTensor* offsets, DLTensor* out_values,
+                           DLTensor* out_indices, bool is_ascend, DLTensor* workspace) {
+  TVM_FFI_ICHECK_EQ(input->ndim, 1) << "segmented_sort expects a 1-D input";
+  TVM_FFI_ICHECK_EQ(offsets->ndim, 1) << "segmented_sort expects 1-D offsets";
+  int64_t num_items = input->shape[0];
+  int64_t num_segments = offsets->shape[0] - 1;
+  if (num_items == 0 || num_segments <= 0) return;
+
+  WorkspaceMemoryResource mr(workspace);
+  auto policy = get_thrust_exec_policy(&mr);
+  const OffsetType* offsets_ptr = static_cast<const OffsetType*>(offsets->data);
+
+  IndicesType* init_indices = static_cast<IndicesType*>(mr.do_allocate(
+      sizeof(IndicesType) * num_items, std::max(sizeof(IndicesType), sizeof(int))));
+  auto counting_iter = thrust::counting_iterator<int64_t>(0);
+  thrust::transform(policy, counting_iter, counting_iter + num_items,
+                    thrust::device_ptr<IndicesType>(init_indices),
+                    [offsets_ptr, num_segments] __device__(int64_t i) {
+                      // The segment of i is the last segment that starts at or before i.
+                      int64_t lo = 0, hi = num_segments;
+                      while (hi - lo > 1) {
+                        int64_t mid = (lo + hi) / 2;
+                        if (offsets_ptr[mid] <= i) {
+                          lo = mid;
+                        } else {
+                          hi = mid;
+                        }
+                      }
+                      return static_cast<IndicesType>(i - offsets_ptr[lo]);
+                    });
+  cub_segmented_sort_pairs(static_cast<const DataType*>(input->data),
+                           static_cast<DataType*>(out_values->data), init_indices,
+                           static_cast<IndicesType*>(out_indices->data), num_items, num_segments,
+                           offsets_ptr, offsets_ptr + 1, is_ascend, &mr);
+}
+
+template <typename DataType, typename IndicesType>
+void thrust_segmented_sort_offsets(DLTensor* input, DLTensor* offsets, DLTensor* out_values,
+                                   DLTensor* out_indices, bool is_ascend, DLTensor* workspace) {
+  auto offset_dtype = ffi::DLDataTypeToString(offsets->dtype);
+  if (offset_dtype == "int32") {
+    thrust_segmented_sort<DataType, IndicesType, int32_t>(input, offsets, out_values, out_indices,
+                                                          is_ascend, workspace);
+  } else if (offset_dtype == "int64") {
+    thrust_segmented_sort<DataType, IndicesType, int64_t>(input, offsets, out_values, out_indices,
+                                                          is_ascend, workspace);
+  } else {
+    LOG(FATAL) << "Unsupported offset dtype: " << offset_dtype;
+  }
+}
+
+template <typename DataType>
+void thrust_segmented_sort_indices(DLTensor* input, DLTensor* offsets, DLTensor* out_values,
+                                   DLTensor* out_indices, bool is_ascend, DLTensor* workspace) {
+  auto out_dtype = ffi::DLDataTypeToString(out_indices->dtype);
+  if (out_dtype == "int32") {
+    thrust_segmented_sort_offsets<DataType, int32_t>(input, offsets, out_values, out_indices,
+                                                     is_ascend, workspace);
+  } else if (out_dtype == "int64") {
+    thrust_segmented_sort_offsets<DataType, int64_t>(input, offsets, out_values, out_indices,
+                                                     is_ascend, workspace);
+  } else {
+    LOG(FATAL) << "Unsupported output dtype: " << out_dtype;
+  }
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def_packed(
+      "tvm.contrib.thrust.segmented_sort", [](ffi::PackedArgs args, ffi::Any* ret) {
+        TVM_FFI_ICHECK_GE(args.size(), 5);
+        auto input = args[0].cast<DLTensor*>();
+        auto offsets = args[1].cast<DLTensor*>();
+        auto values_out = args[2].cast<DLTensor*>();
+        auto indices_out = args[3].cast<DLTensor*>();
+        bool is_ascend = args[4].cast<bool>();
+        DLTensor* workspace = nullptr;
+        if (args.size() == 6) {
+          workspace = args[5].cast<DLTensor*>();
+        }
+
+        auto data_dtype = ffi::DLDataTypeToString(input->dtype);
+        if (data_dtype == "float16") {
+          thrust_segmented_sort_indices<half>(input, offsets, values_out, indices_out, is_ascend,
+                                              workspace);
+        } else if (data_dtype == "float32") {
+          thrust_segmented_sort_indices<float>(input, offsets, values_out, indices_out, is_ascend,
+                                               workspace);
+        } else if (data_dtype == "float64") {
+          thrust_segmented_sort_indices<double>(input, offsets, values_out, indices_out, is_ascend,
+                                                workspace);
+        } else if (data_dtype == "int32") {
+          thrust_segmented_sort_indices<int32_t>(input, offsets, values_out, indices_out,
+                                                 is_ascend, workspace);
+        } else if (data_dtype == "int64") {
+          thrust_segmented_sort_indices<int64_t>(input, offsets, values_out, indices_out,
+                                                 is_ascend, workspace);
+        } else {
+          LOG(FATAL) << "Unsupported input dtype: " << data_dtype;
+        }
+      });
+}
+#endif
+
 template <typename KeyType, typename ValueType>
 void thrust_stable_sort_by_key(DLTensor* keys_in, DLTensor* values_in, DLTensor* keys_out,
                                DLTensor* values_out, bool for_scatter,
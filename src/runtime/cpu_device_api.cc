@@ -24,10 +24,12 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <cstdlib>
 #include <cstring>
 
+#include "../support/env.h"
 #include "workspace_pool.h"
 
 #ifdef __ANDROID__
@@ -139,7 +141,10 @@ class CPUDeviceAPI final : public DeviceAPI {
 };
 
 struct CPUWorkspacePool : public WorkspacePool {
-  CPUWorkspacePool() : WorkspacePool(kDLCPU, CPUDeviceAPI::Global()) {}
+  // Workspaces are NUMA-node local unless disabled with TVM_NUMA_AWARE_WORKSPACE=0.
+  CPUWorkspacePool()
+      : WorkspacePool(kDLCPU, CPUDeviceAPI::Global(),
+                      support::GetEnv("TVM_NUMA_AWARE_WORKSPACE", true)) {}
 };
 
 static CPUWorkspacePool* CPUWorkspacePoolThreadLocal() {
@@ -244,6 +244,34 @@ class CUDADeviceAPI final : public DeviceAPI {
     CUDA_CALL(cudaEventDestroy(evt));
   }
 
+  TVMEventHandle CreateEvent(Device dev) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    cudaEvent_t evt;
+    CUDA_CALL(cudaEventCreateWithFlags(&evt, cudaEventDisableTiming));
+    return static_cast<TVMEventHandle>(evt);
+  }
+
+  void FreeEvent(Device dev, TVMEventHandle event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaEventDestroy(static_cast<cudaEvent_t>(event)));
+  }
+
+  void RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaEventRecord(static_cast<cudaEvent_t>(event), static_cast<cudaStream_t>(stream)));
+  }
+
+  void StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaStreamWaitEvent(static_cast<cudaStream_t>(stream),
+                                  static_cast<cudaEvent_t>(event), 0));
+  }
+
+  void EventSync(Device dev, TVMEventHandle event) final {
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    CUDA_CALL(cudaEventSynchronize(static_cast<cudaEvent_t>(event)));
+  }
+
   void StreamSync(Device dev, TVMStreamHandle stream) final {
     CUDA_CALL(cudaSetDevice(dev.device_id));
     CUDA_CALL(cudaStreamSynchronize(static_cast<cudaStream_t>(stream)));
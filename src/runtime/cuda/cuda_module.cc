@@ -32,6 +32,7 @@
 #include <array>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "../../support/bytes_io.h"
@@ -112,9 +113,11 @@ class CUDAModuleNode : public ffi::ModuleObj {
     }
   }
 
-  // get a CUfunction from primary context in device_id
-  CUfunction GetFunc(int device_id, const std::string& func_name) {
-    std::lock_guard<std::mutex> lock(mutex_);
+  /*!
+   * \brief Load the module on a device, which JIT compiles the PTX if there is no cubin for it.
+   * \note The caller holds the lock of the device.
+   */
+  void LoadModule(int device_id) {
     // must recheck under the lock scope
     if (module_[device_id] == nullptr) {
       CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), data_.c_str()));
@@ -123,6 +126,16 @@ class CUDAModuleNode : public ffi::ModuleObj {
         (*nvshmem_init_hook)(static_cast<void*>(module_[device_id]));
       }
     }
+  }
+  /*! \brief Load the module on a device ahead of its first launch. */
+  void Warmup(int device_id) {
+    std::lock_guard<std::mutex> lock(mutex_[device_id]);
+    LoadModule(device_id);
+  }
+  // get a CUfunction from primary context in device_id
+  CUfunction GetFunc(int device_id, const std::string& func_name) {
+    std::lock_guard<std::mutex> lock(mutex_[device_id]);
+    LoadModule(device_id);
     CUfunction func;
     CUresult result = cuModuleGetFunction(&func, module_[device_id], func_name.c_str());
     if (result != CUDA_SUCCESS) {
@@ -135,15 +148,8 @@ class CUDAModuleNode : public ffi::ModuleObj {
   }
   // get a global var from primary context in device_id
   CUdeviceptr GetGlobal(int device_id, const std::string& global_name, size_t expect_nbytes) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    // must recheck under the lock scope
-    if (module_[device_id] == nullptr) {
-      CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), data_.c_str()));
-      static auto nvshmem_init_hook = ffi::Function::GetGlobal("runtime.nvshmem.cumodule_init");
-      if (nvshmem_init_hook.has_value()) {
-        (*nvshmem_init_hook)(static_cast<void*>(module_[device_id]));
-      }
-    }
+    std::lock_guard<std::mutex> lock(mutex_[device_id]);
+    LoadModule(device_id);
     CUdeviceptr global;
     size_t nbytes;
 
@@ -169,8 +175,8 @@ class CUDAModuleNode : public ffi::ModuleObj {
   std::string cuda_source_;
   // the internal modules per GPU, to be lazily initialized.
   std::array<CUmodule, kMaxNumGPUs> module_;
-  // internal mutex when updating the module
-  std::mutex mutex_;
+  // internal mutex per GPU when updating the module, so that the GPUs load it in parallel
+  std::array<std::mutex, kMaxNumGPUs> mutex_;
 };
 
 // a wrapped function class to get packed func.
@@ -183,6 +189,7 @@ class CUDAWrappedFunc {
     sptr_ = sptr;
     func_name_ = func_name;
     std::fill(fcache_.begin(), fcache_.end(), nullptr);
+    std::fill(dyn_shmem_cache_.begin(), dyn_shmem_cache_.end(), 0);
     launch_param_config_.Init(num_void_args, launch_param_tags);
   }
   // invoke the function with void arguments
@@ -193,16 +200,18 @@ class CUDAWrappedFunc {
 
     if (fcache_[device_id] == nullptr) {
       fcache_[device_id] = m_->GetFunc(device_id, func_name_);
-      if (wl.dyn_shmem_size >= (48 << 10)) {
-        // Assumption: dyn_shmem_size doesn't change across different invocations of
-        // fcache_[device_id]
-        CUresult result = cuFuncSetAttribute(
-            fcache_[device_id], CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES, wl.dyn_shmem_size);
-        if (result != CUDA_SUCCESS) {
-          TVM_FFI_THROW(InternalError)
-              << "Failed to set the allowed dynamic shared memory size to " << wl.dyn_shmem_size;
-        }
+    }
+    // The attribute is only raised when a launch needs more dynamic shared memory than any launch
+    // before it on the device, e.g. for a larger dynamic shape, so the common launches of the
+    // same shapes do not pay for it.
+    if (wl.dyn_shmem_size >= (48 << 10) && wl.dyn_shmem_size > dyn_shmem_cache_[device_id]) {
+      CUresult result = cuFuncSetAttribute(
+          fcache_[device_id], CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES, wl.dyn_shmem_size);
+      if (result != CUDA_SUCCESS) {
+        TVM_FFI_THROW(InternalError)
+            << "Failed to set the allowed dynamic shared memory size to " << wl.dyn_shmem_size;
       }
+      dyn_shmem_cache_[device_id] = wl.dyn_shmem_size;
     }
     CUstream strm = static_cast<CUstream>(TVMFFIEnvGetStream(kDLCUDA, device_id));
     CUresult result;
@@ -264,6 +273,8 @@ class CUDAWrappedFunc {
   // Device function cache per device.
   // mark as mutable, to enable lazy initialization
   mutable std::array<CUfunction, kMaxNumGPUs> fcache_;
+  // The allowed dynamic shared memory size of the function per device.
+  mutable std::array<size_t, kMaxNumGPUs> dyn_shmem_cache_;
   // launch parameters configuration
   LaunchParamConfig launch_param_config_;
 };
@@ -335,9 +346,65 @@ ffi::Module CUDAModuleLoadFromBytes(const ffi::Bytes& bytes) {
   return CUDAModuleCreate(data, fmt, fmap, std::string());
 }
 
+/*! \brief Collect the CUDA modules of a module and of its imports. */
+void CollectCUDAModules(const ffi::Module& mod, std::vector<CUDAModuleNode*>* cuda_modules) {
+  if (std::string(mod->kind()) == "cuda") {
+    cuda_modules->push_back(static_cast<CUDAModuleNode*>(mod.operator->()));
+  }
+  for (const Any& import : mod->imports()) {
+    CollectCUDAModules(import.cast<ffi::Module>(), cuda_modules);
+  }
+}
+
+/*!
+ * \brief Load the CUDA modules of a module on the devices, one thread per device, so that the
+ *  driver JIT compilation, if any, is paid ahead of the first launch and not serialized.
+ * \param mod The module, whose imports are warmed up too.
+ * \param device_ids The devices, all the visible devices when empty.
+ */
+void CUDAModuleWarmup(ffi::Module mod, ffi::Array<int64_t> device_ids) {
+  std::vector<CUDAModuleNode*> cuda_modules;
+  CollectCUDAModules(mod, &cuda_modules);
+  if (cuda_modules.empty()) return;
+  if (device_ids.empty()) {
+    int num_devices = 0;
+    CUDA_CALL(cudaGetDeviceCount(&num_devices));
+    for (int i = 0; i < num_devices; ++i) {
+      device_ids.push_back(i);
+    }
+  }
+  std::vector<std::thread> threads;
+  std::vector<std::string> errors(device_ids.size());
+  for (size_t i = 0; i < device_ids.size(); ++i) {
+    int device_id = static_cast<int>(device_ids[i]);
+    TVM_FFI_ICHECK(device_id >= 0 && device_id < kMaxNumGPUs)
+        << "ValueError: Invalid CUDA device " << device_id;
+    threads.emplace_back([&cuda_modules, &errors, i, device_id]() {
+      try {
+        CUDA_CALL(cudaSetDevice(device_id));
+        for (CUDAModuleNode* m : cuda_modules) {
+          m->Warmup(device_id);
+        }
+      } catch (const std::exception& e) {
+        errors[i] = e.what();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < errors.size(); ++i) {
+    if (!errors[i].empty()) {
+      TVM_FFI_THROW(CUDAError) << "Failed to load the CUDA modules on device " << device_ids[i]
+                               << ": " << errors[i];
+    }
+  }
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
+      .def("runtime.cuda_module_warmup", CUDAModuleWarmup)
       .def("ffi.Module.load_from_file.cuda", CUDAModuleLoadFile)
       .def("ffi.Module.load_from_file.ptx", CUDAModuleLoadFile)
       .def("ffi.Module.load_from_file.cubin", CUDAModuleLoadFile)
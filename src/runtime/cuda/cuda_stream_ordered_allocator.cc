@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cuda_stream_ordered_allocator.cc
+ * \brief Stream-ordered allocator backed by the CUDA memory pools.
+ *
+ * Allocations and frees are enqueued on the current stream of the device
+ * (cudaMallocAsync/cudaFreeAsync), so a buffer freed by the host while
+ * kernels using it are still in flight can be safely reused by later work
+ * on the same stream without synchronization. Unused memory is kept in the
+ * device's default memory pool up to a tunable release threshold.
+ *
+ * \note A buffer is freed on the stream that is current at free time; all of
+ *       its uses must be ordered before that stream.
+ */
+#include <cuda_runtime.h>
+#include <tvm/ffi/extra/c_env_api.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/memory/memory_manager.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "../../support/env.h"
+#include "cuda_common.h"
+
+namespace tvm {
+namespace runtime {
+
+using memory::Allocator;
+using memory::AllocatorType;
+using memory::Buffer;
+
+class CUDAStreamOrderedAllocator final : public Allocator {
+ public:
+  /*!
+   * \param dev The CUDA device the allocator serves.
+   * \param release_threshold Bytes of unused memory the pool keeps before
+   *        returning memory to the OS at synchronization points.
+   */
+  CUDAStreamOrderedAllocator(Device dev, uint64_t release_threshold)
+      : Allocator(AllocatorType::kStreamOrdered), device_(dev), used_memory_(0) {
+    TVM_FFI_ICHECK_EQ(dev.device_type, kDLCUDA)
+        << "The stream-ordered allocator only supports CUDA devices";
+    int supported = 0;
+    CUDA_CALL(cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported, dev.device_id));
+    TVM_FFI_ICHECK(supported) << "CUDA device " << dev.device_id
+                              << " does not support stream-ordered memory pools";
+    CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool_, dev.device_id));
+    SetReleaseThreshold(release_threshold);
+  }
+
+  Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
+    TVM_FFI_ICHECK_EQ(256 % alignment, 0U) << "CUDA space is aligned at 256 bytes";
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    cudaStream_t stream = CurrentStream(dev);
+    Buffer buf;
+    buf.device = dev;
+    buf.size = nbytes;
+    buf.alloc_type = AllocatorType::kStreamOrdered;
+    cudaError_t err = cudaMallocFromPoolAsync(&buf.data, nbytes, pool_, stream);
+    if (err == cudaErrorMemoryAllocation) {
+      // Return the unused pool memory and retry once.
+      (void)cudaGetLastError();
+      LOG(WARNING) << "CUDAStreamOrderedAllocator ran out of memory, trimming the pool and "
+                      "reallocating...";
+      CUDA_CALL(cudaStreamSynchronize(stream));
+      CUDA_CALL(cudaMemPoolTrimTo(pool_, 0));
+      err = cudaMallocFromPoolAsync(&buf.data, nbytes, pool_, stream);
+    }
+    CUDA_CALL(err);
+    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    VLOG(1) << "stream-ordered allocate " << nbytes << " B, used memory " << used_memory_ << " B";
+    return buf;
+  }
+
+  void Free(const Buffer& buffer) final {
+    CUDA_CALL(cudaSetDevice(buffer.device.device_id));
+    CUDA_CALL(cudaFreeAsync(buffer.data, CurrentStream(buffer.device)));
+    used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
+    VLOG(1) << "stream-ordered free " << buffer.size << " B, used memory " << used_memory_ << " B";
+  }
+
+  void Clear() final {
+    CUDA_CALL(cudaSetDevice(device_.device_id));
+    CUDA_CALL(cudaStreamSynchronize(CurrentStream(device_)));
+    CUDA_CALL(cudaMemPoolTrimTo(pool_, 0));
+  }
+
+  size_t UsedMemory() const final { return used_memory_.load(std::memory_order_relaxed); }
+
+  void SetReleaseThreshold(uint64_t release_threshold) {
+    CUDA_CALL(
+        cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &release_threshold));
+  }
+
+ private:
+  static cudaStream_t CurrentStream(Device dev) {
+    return static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, dev.device_id));
+  }
+
+  Device device_;
+  cudaMemPool_t pool_;
+  std::atomic<size_t> used_memory_;
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def_packed("DeviceAllocator.cuda",
+                  [](ffi::PackedArgs args, ffi::Any* rv) {
+                    Device dev = args[0].cast<Device>();
+                    AllocatorType type = AllocatorType(args[1].cast<int>());
+                    // Other allocator types use the generic implementations.
+                    if (type != AllocatorType::kStreamOrdered) {
+                      *rv = static_cast<void*>(nullptr);
+                      return;
+                    }
+                    uint64_t release_threshold =
+                        support::GetEnv("TVM_CUDA_MEMPOOL_RELEASE_THRESHOLD",
+                                        std::numeric_limits<uint64_t>::max());
+                    Allocator* alloc = new CUDAStreamOrderedAllocator(dev, release_threshold);
+                    *rv = static_cast<void*>(alloc);
+                  })
+      .def("runtime.cuda.set_mempool_release_threshold", [](Device dev, int64_t threshold) {
+        auto* alloc = static_cast<CUDAStreamOrderedAllocator*>(
+            memory::MemoryManager::GetOrCreateAllocator(dev, AllocatorType::kStreamOrdered));
+        alloc->SetReleaseThreshold(static_cast<uint64_t>(threshold));
+      });
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -176,6 +176,38 @@ TVMStreamHandle DeviceAPI::GetCurrentStream(Device dev) {
 void DeviceAPI::SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst) {
 }
 
+namespace {
+/*! \brief The event of the devices without native events, i.e. the stream it is recorded in. */
+struct StreamEvent {
+  TVMStreamHandle stream = nullptr;
+  bool recorded = false;
+};
+}  // namespace
+
+TVMEventHandle DeviceAPI::CreateEvent(Device dev) { return new StreamEvent(); }
+
+void DeviceAPI::FreeEvent(Device dev, TVMEventHandle event) {
+  delete static_cast<StreamEvent*>(event);
+}
+
+void DeviceAPI::RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) {
+  auto* evt = static_cast<StreamEvent*>(event);
+  evt->stream = stream;
+  evt->recorded = true;
+}
+
+void DeviceAPI::StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) {
+  auto* evt = static_cast<StreamEvent*>(event);
+  TVM_FFI_ICHECK(evt->recorded) << "The event to wait for is not recorded";
+  SyncStreamFromTo(dev, evt->stream, stream);
+}
+
+void DeviceAPI::EventSync(Device dev, TVMEventHandle event) {
+  auto* evt = static_cast<StreamEvent*>(event);
+  TVM_FFI_ICHECK(evt->recorded) << "The event to wait for is not recorded";
+  StreamSync(dev, evt->stream);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -195,9 +227,33 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            [](DLDevice dev, int64_t stream) {
              DeviceAPIManager::Get(dev)->StreamSync(dev, reinterpret_cast<TVMStreamHandle>(stream));
            })
-      .def("runtime.Device_StreamSyncFromTo", [](DLDevice dev, int64_t src, int64_t dst) {
-        DeviceAPIManager::Get(dev)->SyncStreamFromTo(dev, reinterpret_cast<TVMStreamHandle>(src),
-                                                     reinterpret_cast<TVMStreamHandle>(dst));
+      .def("runtime.Device_StreamSyncFromTo",
+           [](DLDevice dev, int64_t src, int64_t dst) {
+             DeviceAPIManager::Get(dev)->SyncStreamFromTo(dev,
+                                                          reinterpret_cast<TVMStreamHandle>(src),
+                                                          reinterpret_cast<TVMStreamHandle>(dst));
+           })
+      .def("runtime.Device_EventCreate",
+           [](DLDevice dev) {
+             return reinterpret_cast<int64_t>(DeviceAPIManager::Get(dev)->CreateEvent(dev));
+           })
+      .def("runtime.Device_EventFree",
+           [](DLDevice dev, int64_t event) {
+             DeviceAPIManager::Get(dev)->FreeEvent(dev, reinterpret_cast<TVMEventHandle>(event));
+           })
+      .def("runtime.Device_EventRecord",
+           [](DLDevice dev, int64_t event, int64_t stream) {
+             DeviceAPIManager::Get(dev)->RecordEvent(dev, reinterpret_cast<TVMEventHandle>(event),
+                                                     reinterpret_cast<TVMStreamHandle>(stream));
+           })
+      .def("runtime.Device_StreamWaitEvent",
+           [](DLDevice dev, int64_t stream, int64_t event) {
+             DeviceAPIManager::Get(dev)->StreamWaitEvent(
+                 dev, reinterpret_cast<TVMStreamHandle>(stream),
+                 reinterpret_cast<TVMEventHandle>(event));
+           })
+      .def("runtime.Device_EventSync", [](DLDevice dev, int64_t event) {
+        DeviceAPIManager::Get(dev)->EventSync(dev, reinterpret_cast<TVMEventHandle>(event));
       });
 }
 
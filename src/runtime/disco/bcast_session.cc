@@ -22,6 +22,8 @@
 #include <tvm/runtime/disco/session.h>
 
 #include <sstream>
+#include <utility>
+#include <vector>
 
 namespace tvm {
 namespace runtime {
@@ -34,7 +36,7 @@ struct BcastSessionObj::Internal {
     ffi::AnyView packed_args[kNumArgs];
     ffi::PackedArgs::Fill(packed_args, static_cast<int>(action), reg_id,
                           std::forward<Args>(args)...);
-    self->BroadcastPacked(ffi::PackedArgs(packed_args, kNumArgs));
+    self->BroadcastOrRecord(ffi::PackedArgs(packed_args, kNumArgs));
   }
 
   static DRef MakeDRef(int reg_id, Session session) {
@@ -64,6 +66,9 @@ void BcastSessionObj::CopyToWorker0(const Tensor& host_array, const DRef& remote
 }
 
 void BcastSessionObj::Shutdown() {
+  if (recording_batch_) {
+    this->SubmitBatch();
+  }
   BcastSessionObj::Internal::BroadcastUnpacked(this, DiscoAction::kShutDown, 0);
 }
 
@@ -76,6 +81,7 @@ void BcastSessionObj::InitCCL(ffi::String ccl, ffi::Shape device_ids) {
 }
 
 void BcastSessionObj::SyncWorker(int worker_id) {
+  CheckNotRecordingBatch("SyncWorker");
   BcastSessionObj::Internal::BroadcastUnpacked(this, DiscoAction::kSyncWorker, worker_id);
   ffi::PackedArgs args = this->RecvReplyPacked(worker_id);
   TVM_FFI_ICHECK_EQ(args.size(), 2);
@@ -97,10 +103,53 @@ DRef BcastSessionObj::CallWithPacked(const ffi::PackedArgs& args) {
     args_vec[1] = reg_id;
     args_vec[2] = func->reg_id;
   }
-  this->BroadcastPacked(ffi::PackedArgs(args_vec, args.size()));
+  this->BroadcastOrRecord(ffi::PackedArgs(args_vec, args.size()));
   return BcastSessionObj::Internal::MakeDRef(reg_id, ffi::GetRef<Session>(this));
 }
 
+void BcastSessionObj::BeginBatch() {
+  TVM_FFI_CHECK(!recording_batch_, ValueError) << "A batch of commands is already being recorded";
+  recording_batch_ = true;
+}
+
+void BcastSessionObj::SubmitBatch() {
+  TVM_FFI_CHECK(recording_batch_, ValueError) << "No batch of commands is being recorded";
+  recording_batch_ = false;
+  // Move the recorded arguments out first, so that DRefs released along with them are killed
+  // after the batch instead of being recorded into it.
+  std::vector<ffi::Any> batch_args = std::move(batch_args_);
+  int64_t num_commands = batch_num_commands_;
+  batch_args_.clear();
+  batch_num_commands_ = 0;
+  if (num_commands == 0) {
+    return;
+  }
+  std::vector<ffi::AnyView> packed_args(2 + batch_args.size());
+  packed_args[0] = static_cast<int>(DiscoAction::kCallBatch);
+  packed_args[1] = num_commands;
+  std::copy(batch_args.begin(), batch_args.end(), packed_args.begin() + 2);
+  this->BroadcastPacked(ffi::PackedArgs(packed_args.data(), packed_args.size()));
+}
+
+void BcastSessionObj::BroadcastOrRecord(const ffi::PackedArgs& args) {
+  if (!recording_batch_) {
+    this->BroadcastPacked(args);
+    return;
+  }
+  batch_args_.reserve(batch_args_.size() + 1 + args.size());
+  batch_args_.emplace_back(static_cast<int64_t>(args.size()));
+  for (int i = 0; i < args.size(); ++i) {
+    batch_args_.emplace_back(args[i]);
+  }
+  ++batch_num_commands_;
+}
+
+void BcastSessionObj::CheckNotRecordingBatch(const char* command) const {
+  TVM_FFI_CHECK(!recording_batch_, ValueError)
+      << "Cannot call " << command << " while a batch of commands is being recorded. "
+      << "Please submit the batch first";
+}
+
 void BcastSessionObj::DeallocReg(int reg_id) {
   BcastSessionObj::Internal::BroadcastUnpacked(this, DiscoAction::kKillReg, reg_id);
   this->free_regs_.push_back(reg_id);
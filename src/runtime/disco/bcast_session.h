@@ -44,6 +44,8 @@ class BcastSessionObj : public SessionObj {
   void InitCCL(ffi::String ccl, IntTuple device_ids) override;
   ffi::Any DebugGetFromRemote(int64_t reg_id, int worker_id) override = 0;
   void DebugSetRegister(int64_t reg_id, ffi::AnyView value, int worker_id) override = 0;
+  void BeginBatch() override;
+  void SubmitBatch() override;
 
  protected:
   /*! \brief Deallocate a register id, kill it on all workers, and append it to `free_regs_`. */
@@ -65,6 +67,14 @@ class BcastSessionObj : public SessionObj {
    * \param ffi::PackedArgs The input arguments in TVM's ffi::Function calling convention
    */
   virtual void BroadcastPacked(const ffi::PackedArgs& args) = 0;
+  /*!
+   * \brief Broadcast a command to all workers, or record it into the current batch if a batch
+   * is being recorded.
+   * \param args The command in the same calling convention as `BroadcastPacked`.
+   */
+  void BroadcastOrRecord(const ffi::PackedArgs& args);
+  /*! \brief Check that no batch is being recorded, used by commands that wait for a reply. */
+  void CheckNotRecordingBatch(const char* command) const;
 
   /*!
    * \brief Send a packed sequence to a worker. This function is usually called by the controler to
@@ -90,6 +100,15 @@ class BcastSessionObj : public SessionObj {
   int reg_count_ = 1;
   /*! \brief The regsiter ids that have been deallocated */
   std::vector<int64_t> free_regs_;
+  /*! \brief Whether a batch of commands is being recorded */
+  bool recording_batch_ = false;
+  /*! \brief The number of commands in the batch being recorded */
+  int64_t batch_num_commands_ = 0;
+  /*!
+   * \brief The commands in the batch being recorded, flattened as the number of arguments of
+   * each command followed by its arguments.
+   */
+  std::vector<ffi::Any> batch_args_;
 
   struct Internal;
   friend struct Internal;
@@ -27,6 +27,7 @@
 
 #include <sstream>
 
+#include "./trace.h"
 #include "./utils.h"
 
 namespace tvm {
@@ -85,37 +86,94 @@ ffi::Function GetCCLFunc(const char* name) {
 }
 
 void AllReduce(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
-  GetCCLFunc("allreduce")(send, static_cast<int>(reduce_kind), in_group, recv);
+  DiscoTracer::ThreadLocal()->Trace("allreduce", "ccl", [&]() {
+    GetCCLFunc("allreduce")(send, static_cast<int>(reduce_kind), in_group, recv);
+  });
 }
 
 void AllGather(Tensor send, bool in_group, Tensor recv) {
-  GetCCLFunc("allgather")(send, in_group, recv);
+  DiscoTracer::ThreadLocal()->Trace("allgather", "ccl",
+                                    [&]() { GetCCLFunc("allgather")(send, in_group, recv); });
+}
+
+int64_t AllReduceAsync(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
+  return GetCCLFunc("allreduce_async")(send, static_cast<int>(reduce_kind), in_group, recv)
+      .cast<int64_t>();
+}
+
+int64_t AllGatherAsync(Tensor send, bool in_group, Tensor recv) {
+  return GetCCLFunc("allgather_async")(send, in_group, recv).cast<int64_t>();
+}
+
+void WaitCollective(int64_t handle) { GetCCLFunc("wait")(handle); }
+
+void ReduceScatter(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
+  DiscoTracer::ThreadLocal()->Trace("reduce_scatter", "ccl", [&]() {
+    GetCCLFunc("reduce_scatter")(send, static_cast<int>(reduce_kind), in_group, recv);
+  });
+}
+
+void AllToAll(Tensor send, ffi::Shape send_splits, ffi::Shape recv_splits, bool in_group,
+              Tensor recv) {
+  DiscoTracer::ThreadLocal()->Trace("all_to_all", "ccl", [&]() {
+    GetCCLFunc("all_to_all")(send, send_splits, recv_splits, in_group, recv);
+  });
+}
+
+void RingSendRecv(Tensor send, bool in_group, Tensor recv) {
+  DiscoTracer::ThreadLocal()->Trace("ring_send_recv", "ccl",
+                                    [&]() { GetCCLFunc("ring_send_recv")(send, in_group, recv); });
+}
+
+int64_t RingSendRecvAsync(Tensor send, bool in_group, Tensor recv) {
+  return GetCCLFunc("ring_send_recv_async")(send, in_group, recv).cast<int64_t>();
+}
+
+void RingSendRecvWait(Tensor send, Tensor recv, Tensor after, Tensor out) {
+  GetCCLFunc("ring_send_recv_wait")(send, recv, after, out);
 }
 
 TVM_DLL void BroadcastFromWorker0(Tensor send, bool in_group, Tensor recv) {
-  GetCCLFunc("broadcast_from_worker0")(send, in_group, recv);
+  DiscoTracer::ThreadLocal()->Trace("broadcast_from_worker0", "ccl", [&]() {
+    GetCCLFunc("broadcast_from_worker0")(send, in_group, recv);
+  });
 }
 
 TVM_DLL void ScatterFromWorker0(ffi::Optional<Tensor> send, bool in_group, Tensor recv) {
-  GetCCLFunc("scatter_from_worker0")(send, in_group, recv);
+  DiscoTracer::ThreadLocal()->Trace("scatter_from_worker0", "ccl", [&]() {
+    GetCCLFunc("scatter_from_worker0")(send, in_group, recv);
+  });
 }
 
 void GatherToWorker0(Tensor send, bool in_group, ffi::Optional<Tensor> recv) {
-  GetCCLFunc("gather_to_worker0")(send, in_group, recv);
+  DiscoTracer::ThreadLocal()->Trace("gather_to_worker0", "ccl", [&]() {
+    GetCCLFunc("gather_to_worker0")(send, in_group, recv);
+  });
 }
 
-void RecvFromWorker0(Tensor buffer) { GetCCLFunc("recv_from_worker0")(buffer); }
+void RecvFromWorker0(Tensor buffer) {
+  DiscoTracer::ThreadLocal()->Trace("recv_from_worker0", "ccl",
+                                    [&]() { GetCCLFunc("recv_from_worker0")(buffer); });
+}
 
-void SendToNextGroup(Tensor buffer) { GetCCLFunc("send_to_next_group")(buffer); }
+void SendToNextGroup(Tensor buffer) {
+  DiscoTracer::ThreadLocal()->Trace("send_to_next_group", "ccl",
+                                    [&]() { GetCCLFunc("send_to_next_group")(buffer); });
+}
 
-void RecvFromPrevGroup(Tensor buffer) { GetCCLFunc("recv_from_prev_group")(buffer); }
+void RecvFromPrevGroup(Tensor buffer) {
+  DiscoTracer::ThreadLocal()->Trace("recv_from_prev_group", "ccl",
+                                    [&]() { GetCCLFunc("recv_from_prev_group")(buffer); });
+}
 
 void SendToWorker(Tensor buffer, int receiver_id) {
-  GetCCLFunc("send_to_worker")(buffer, receiver_id);
+  DiscoTracer::ThreadLocal()->Trace("send_to_worker", "ccl",
+                                    [&]() { GetCCLFunc("send_to_worker")(buffer, receiver_id); });
 }
 
 void RecvFromWorker(Tensor buffer, int sender_id) {
-  GetCCLFunc("recv_from_worker")(buffer, sender_id);
+  DiscoTracer::ThreadLocal()->Trace("recv_from_worker", "ccl",
+                                    [&]() { GetCCLFunc("recv_from_worker")(buffer, sender_id); });
 }
 
 int WorkerId() { return DiscoWorker::ThreadLocal()->worker_id; }
@@ -151,6 +209,29 @@ TVM_FFI_STATIC_INIT_BLOCK() {
              AllReduce(send, static_cast<ReduceKind>(kind), in_group, recv);
            })
       .def("runtime.disco.allgather", AllGather)
+      .def("runtime.disco.allreduce_async",
+           [](Tensor send, ffi::Shape reduce_kind, bool in_group, Tensor recv) -> int64_t {
+             int kind = IntegerFromShape(reduce_kind);
+             TVM_FFI_CHECK(0 <= kind && kind <= 4, ValueError) << "Unknown ReduceKind: " << kind;
+             return AllReduceAsync(send, static_cast<ReduceKind>(kind), in_group, recv);
+           })
+      .def("runtime.disco.allgather_async", AllGatherAsync)
+      .def("runtime.disco.wait", WaitCollective)
+      .def("runtime.disco.reduce_scatter",
+           [](Tensor send, ffi::Shape reduce_kind, bool in_group, Tensor recv) {
+             int kind = IntegerFromShape(reduce_kind);
+             TVM_FFI_CHECK(0 <= kind && kind <= 4, ValueError) << "Unknown ReduceKind: " << kind;
+             ReduceScatter(send, static_cast<ReduceKind>(kind), in_group, recv);
+           })
+      .def("runtime.disco.all_to_all", AllToAll)
+      .def("runtime.disco.ring_send_recv", RingSendRecv)
+      .def("runtime.disco.ring_send_recv_async", RingSendRecvAsync)
+      .def("runtime.disco.ring_send_recv_start",
+           [](Tensor send, bool in_group, Tensor recv) {
+             // The handle is dropped: `ring_send_recv_wait` finds the exchange by its buffers.
+             RingSendRecvAsync(send, in_group, recv);
+           })
+      .def("runtime.disco.ring_send_recv_wait", RingSendRecvWait)
       .def("runtime.disco.broadcast_from_worker0", BroadcastFromWorker0)
       .def("runtime.disco.scatter_from_worker0", ScatterFromWorker0)
       .def("runtime.disco.gather_to_worker0", GatherToWorker0)
@@ -159,6 +240,9 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("runtime.disco.recv_from_prev_group", RecvFromPrevGroup)
       .def("runtime.disco.send_to_worker", SendToWorker)
       .def("runtime.disco.recv_from_worker", RecvFromWorker)
+      .def("runtime.disco.trace_start", []() { DiscoTracer::ThreadLocal()->Start(); })
+      .def("runtime.disco.trace_stop", []() { return DiscoTracer::ThreadLocal()->Stop(); })
+      .def("runtime.disco.trace_clock_us", []() { return DiscoTracer::NowUs(); })
       .def("runtime.disco.worker_id", []() -> ffi::Shape { return ffi::Shape({WorkerId()}); })
       .def("runtime.disco.worker_rank", []() -> int64_t { return WorkerId(); })
       .def("runtime.disco.device",
@@ -57,6 +57,27 @@ inline bool CanApplyTwoShotAllReduce(int64_t num_elements, DLDataType dtype, int
   return (num_elements / num_workers) % (16 / ((dtype.bits * dtype.lanes + 7) / 8)) == 0;
 }
 
+/*! \brief Initialize the all-reduce kernel arguments from the CUDA IPC memory of `send`. */
+inline tensorrt_llm::AllReduceParams InitAllReduceParams(nccl::CCLThreadLocalContext* ctx,
+                                                         DLTensor* send) {
+  tensorrt_llm::AllReduceParams params;
+  params.ranks_per_node = ctx->worker->num_workers;
+  params.rank = ctx->worker->worker_id;
+  params.local_rank = ctx->worker->worker_id;
+  CUDAIPCMemory ipc_memory = CUDAIPCMemory::GetIPCMemoryFromDevicePtr(send->data);
+  params.barrier_flag = ipc_memory->barrier_flag++;
+  for (int i = 0; i < ctx->worker->num_workers; ++i) {
+    params.peer_comm_buffer_ptrs[i] = ipc_memory->remote_data[i];
+  }
+  for (int i = 0; i < ctx->worker->num_workers; ++i) {
+    params.peer_barrier_ptrs_in[i] = reinterpret_cast<uint32_t*>(ipc_memory->barrier_in[i]);
+  }
+  for (int i = 0; i < ctx->worker->num_workers; ++i) {
+    params.peer_barrier_ptrs_out[i] = reinterpret_cast<uint32_t*>(ipc_memory->barrier_out[i]);
+  }
+  return params;
+}
+
 /*!
  * \brief Customized all-reduce kernel backed by CUDA IPC memory.
  * \param send The input tensor of all-reduce.
@@ -86,22 +107,7 @@ void CustomAllReduce(DLTensor* send, int strategy, DLTensor* recv) {
     return;
   }
 
-  // Initialize the all-reduce kernel arguments.
-  tensorrt_llm::AllReduceParams params;
-  params.ranks_per_node = ctx->worker->num_workers;
-  params.rank = ctx->worker->worker_id;
-  params.local_rank = ctx->worker->worker_id;
-  CUDAIPCMemory ipc_memory = CUDAIPCMemory::GetIPCMemoryFromDevicePtr(send->data);
-  params.barrier_flag = ipc_memory->barrier_flag++;
-  for (int i = 0; i < ctx->worker->num_workers; ++i) {
-    params.peer_comm_buffer_ptrs[i] = ipc_memory->remote_data[i];
-  }
-  for (int i = 0; i < ctx->worker->num_workers; ++i) {
-    params.peer_barrier_ptrs_in[i] = reinterpret_cast<uint32_t*>(ipc_memory->barrier_in[i]);
-  }
-  for (int i = 0; i < ctx->worker->num_workers; ++i) {
-    params.peer_barrier_ptrs_out[i] = reinterpret_cast<uint32_t*>(ipc_memory->barrier_out[i]);
-  }
+  tensorrt_llm::AllReduceParams params = InitAllReduceParams(ctx, send);
 
   if (!CanApplyTwoShotAllReduce(num_elements, send->dtype, ctx->worker->num_workers)) {
     // Two-shot all-reduce does not support this case.
@@ -113,9 +119,98 @@ void CustomAllReduce(DLTensor* send, int strategy, DLTensor* recv) {
                                 ctx->GetDefaultStream());
 }
 
+/*!
+ * \brief Customized all-reduce fused with residual add and RMSNorm, backed by CUDA IPC memory.
+ * It computes `residual_out = allreduce(send) + residual` and
+ * `out = rms_norm(residual_out, weight, eps)`, optionally quantized to float8_e4m3fn.
+ * \param send The input tensor of all-reduce, whose last dimension is the normalized dimension.
+ * It is overwritten by the all-reduce outcome under the ring strategy.
+ * \param residual The residual tensor added to the all-reduce outcome. It may alias residual_out.
+ * \param weight The 1-D RMSNorm weight, whose length is the last dimension of `send`.
+ * \param scale The single-element float32 quantization scale, which must be defined if and only
+ * if `out` is float8_e4m3fn. The output is quantized as `rms_norm(...) / scale`.
+ * \param eps The epsilon of RMSNorm.
+ * \param strategy The all-reduce strategy. See AllReduceStrategyType for detail. The fused
+ * epilogue is applied to the one-shot kernel, and the ring strategy runs an in-place nccl
+ * AllReduce on `send` followed by the fused epilogue.
+ * \param residual_out The output tensor of all-reduce plus residual.
+ * \param out The output tensor of RMSNorm.
+ */
+void CustomAllReduceResidualRMSNorm(DLTensor* send, DLTensor* residual, DLTensor* weight,
+                                    ffi::Optional<Tensor> scale, double eps, int strategy,
+                                    DLTensor* residual_out, DLTensor* out) {
+  int64_t num_elements = TensorSize(send);
+  nccl::CCLThreadLocalContext* ctx = nccl::CCLThreadLocalContext::Get();
+  TVM_FFI_ICHECK_EQ(ctx->worker->num_groups, 1)
+      << "Custom AllReduce for multiple group is not yet implemented.";
+  TVM_FFI_ICHECK_GE(send->ndim, 1);
+  int64_t hidden_size = send->shape[send->ndim - 1];
+  TVM_FFI_ICHECK_EQ(TensorSize(residual), num_elements);
+  TVM_FFI_ICHECK_EQ(TensorSize(residual_out), num_elements);
+  TVM_FFI_ICHECK_EQ(TensorSize(out), num_elements);
+  TVM_FFI_ICHECK_EQ(TensorSize(weight), hidden_size);
+  DataType dtype(send->dtype);
+  TVM_FFI_ICHECK(DataType(residual->dtype) == dtype && DataType(weight->dtype) == dtype &&
+                 DataType(residual_out->dtype) == dtype)
+      << "The residual, weight and residual_out must have the same dtype as the input " << dtype;
+  DataType out_dtype(out->dtype);
+  bool quantize = out_dtype == DataType::Float8E4M3FN();
+  TVM_FFI_ICHECK(quantize || out_dtype == dtype)
+      << "The output dtype must be either the input dtype " << dtype
+      << " or float8_e4m3fn, but got " << out_dtype;
+  TVM_FFI_ICHECK_EQ(quantize, scale.defined())
+      << "The quantization scale must be provided if and only if the output is float8_e4m3fn.";
+  if (quantize) {
+    TVM_FFI_ICHECK(scale.value().DataType() == DataType::Float(32) &&
+                   scale.value().Shape().Product() == 1)
+        << "The quantization scale must be a single-element float32 tensor.";
+  }
+  TVM_FFI_CHECK(CanApplyCustomAllReduce(hidden_size, send->dtype), ValueError)
+      << "The fused all-reduce requires the last dimension " << hidden_size
+      << " to be a multiple of 16 bytes.";
+
+  tensorrt_llm::AllReduceFusionParams fusion;
+  fusion.hidden_size = hidden_size;
+  fusion.eps = static_cast<float>(eps);
+  fusion.residual_in = residual->data;
+  fusion.weight = weight->data;
+  fusion.scale = quantize ? static_cast<const float*>(scale.value()->data) : nullptr;
+  fusion.residual_out = residual_out->data;
+  fusion.out = out->data;
+
+  tensorrt_llm::AllReduceStrategyType strategy_ =
+      static_cast<tensorrt_llm::AllReduceStrategyType>(strategy);
+  if (strategy_ == tensorrt_llm::AllReduceStrategyType::AUTO) {
+    strategy_ = tensorrt_llm::SelectImplementation(
+        num_elements * ((send->dtype.bits * send->dtype.lanes + 7) / 8), ctx->worker->num_workers);
+  }
+
+  deviceStream_t stream = ctx->GetDefaultStream();
+  tensorrt_llm::AllReduceParams params;
+  if (strategy_ == tensorrt_llm::AllReduceStrategyType::RING) {
+    // All-reduce in place with nccl, since `residual` may alias `residual_out`,
+    // and then apply the epilogue on the local outcome only.
+    NCCL_CALL(ncclAllReduce(send->data, send->data, num_elements,
+                            /*datatype=*/nccl::AsNCCLDataType(dtype),
+                            /*op=*/ncclSum, ctx->global_comm, stream));
+    params.ranks_per_node = 1;
+    params.rank = 0;
+    params.local_rank = 0;
+    params.peer_comm_buffer_ptrs[0] = send->data;
+  } else {
+    // The two-shot kernel splits rows across ranks, so the fused epilogue uses one-shot.
+    params = InitAllReduceParams(ctx, send);
+  }
+  tensorrt_llm::customAllReduceResidualRMSNorm(params, fusion, num_elements, send->dtype,
+                                               out->dtype, stream);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("runtime.disco.cuda_ipc.custom_allreduce", CustomAllReduce);
+  refl::GlobalDef()
+      .def("runtime.disco.cuda_ipc.custom_allreduce", CustomAllReduce)
+      .def("runtime.disco.cuda_ipc.custom_allreduce_residual_rms_norm",
+           CustomAllReduceResidualRMSNorm);
 }
 
 }  // namespace cuda_ipc
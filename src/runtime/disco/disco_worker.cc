@@ -23,6 +23,7 @@
 
 #include "../../support/process_id.h"
 #include "./protocol.h"
+#include "./trace.h"
 
 namespace tvm {
 namespace runtime {
@@ -52,54 +53,93 @@ struct DiscoWorker::Impl {
     using namespace tvm;
     while (true) {
       ffi::PackedArgs args = self->channel->Recv();
-      DiscoAction action = static_cast<DiscoAction>(args[0].cast<int>());
-      int64_t reg_id = args[1].cast<int64_t>();
-      switch (action) {
-        case DiscoAction::kShutDown: {
-          Shutdown(self);
-          return;
-        }
-        case DiscoAction::kKillReg: {
-          GetReg(self, reg_id) = nullptr;
-          break;
-        }
-        case DiscoAction::kGetGlobalFunc: {
-          GetGlobalFunc(self, reg_id, args[2].cast<std::string>());
-          break;
-        }
-        case DiscoAction::kCallPacked: {
-          int func_reg_id = args[2].cast<int>();
-          TVM_FFI_ICHECK_LT(func_reg_id, self->register_file.size());
-          ffi::Function func = GetReg(self, func_reg_id).cast<ffi::Function>();
-          TVM_FFI_ICHECK(func.defined());
+      if (!Dispatch(self, args)) {
+        return;
+      }
+    }
+  }
+
+  /*!
+   * \brief Execute a command received from the controler.
+   * \return Whether the worker should continue receiving commands.
+   */
+  static bool Dispatch(DiscoWorker* self, const ffi::PackedArgs& args) {
+    DiscoAction action = static_cast<DiscoAction>(args[0].cast<int>());
+    int64_t reg_id = args[1].cast<int64_t>();
+    switch (action) {
+      case DiscoAction::kShutDown: {
+        Shutdown(self);
+        return false;
+      }
+      case DiscoAction::kKillReg: {
+        GetReg(self, reg_id) = nullptr;
+        DiscoTracer::ThreadLocal()->ClearFuncName(reg_id);
+        break;
+      }
+      case DiscoAction::kGetGlobalFunc: {
+        GetGlobalFunc(self, reg_id, args[2].cast<std::string>());
+        break;
+      }
+      case DiscoAction::kCallPacked: {
+        int func_reg_id = args[2].cast<int>();
+        TVM_FFI_ICHECK_LT(func_reg_id, self->register_file.size());
+        ffi::Function func = GetReg(self, func_reg_id).cast<ffi::Function>();
+        TVM_FFI_ICHECK(func.defined());
+        DiscoTracer* tracer = DiscoTracer::ThreadLocal();
+        tracer->OnCall(reg_id, func_reg_id, args.Slice(3));
+        if (tracer->enabled()) {
+          tracer->Trace(tracer->GetFuncName(func_reg_id), "call",
+                        [&]() { CallPacked(self, reg_id, func, args.Slice(3)); });
+        } else {
           CallPacked(self, reg_id, func, args.Slice(3));
-          break;
-        }
-        case DiscoAction::kCopyFromWorker0: {
-          CopyFromWorker0(self, reg_id);
-          break;
-        }
-        case DiscoAction::kCopyToWorker0: {
-          CopyToWorker0(self, reg_id);
-          break;
-        }
-        case DiscoAction::kSyncWorker: {
-          SyncWorker(self, reg_id);
-          break;
-        }
-        case DiscoAction::kDebugGetFromRemote: {
-          int worker_id = args[2].cast<int>();
-          DebugGetFromRemote(self, reg_id, worker_id);
-          break;
-        }
-        case DiscoAction::kDebugSetRegister: {
-          int worker_id = args[2].cast<int>();
-          ffi::AnyView value = args[3];
-          DebugSetRegister(self, reg_id, worker_id, value);
-          break;
         }
+        break;
+      }
+      case DiscoAction::kCopyFromWorker0: {
+        CopyFromWorker0(self, reg_id);
+        break;
+      }
+      case DiscoAction::kCopyToWorker0: {
+        CopyToWorker0(self, reg_id);
+        break;
+      }
+      case DiscoAction::kSyncWorker: {
+        SyncWorker(self, reg_id);
+        break;
+      }
+      case DiscoAction::kDebugGetFromRemote: {
+        int worker_id = args[2].cast<int>();
+        DebugGetFromRemote(self, reg_id, worker_id);
+        break;
+      }
+      case DiscoAction::kDebugSetRegister: {
+        int worker_id = args[2].cast<int>();
+        ffi::AnyView value = args[3];
+        DebugSetRegister(self, reg_id, worker_id, value);
+        break;
+      }
+      case DiscoAction::kCallBatch: {
+        // The register id slot carries the number of commands in the batch.
+        return CallBatch(self, reg_id, args.Slice(2));
+      }
+    }
+    return true;
+  }
+
+  static bool CallBatch(DiscoWorker* self, int64_t num_commands, const ffi::PackedArgs& args) {
+    int offset = 0;
+    for (int64_t i = 0; i < num_commands; ++i) {
+      int num_args = args[offset].cast<int>();
+      ffi::PackedArgs command(args.data() + offset + 1, num_args);
+      TVM_FFI_ICHECK(static_cast<DiscoAction>(command[0].cast<int>()) != DiscoAction::kCallBatch)
+          << "Batches of commands cannot be nested";
+      if (!Dispatch(self, command)) {
+        return false;
       }
+      offset += 1 + num_args;
     }
+    TVM_FFI_ICHECK_EQ(offset, args.size());
+    return true;
   }
 
   static void Shutdown(DiscoWorker* self) {}
@@ -109,6 +149,7 @@ struct DiscoWorker::Impl {
     TVM_FFI_CHECK(pf.has_value(), ValueError) << "Cannot find global function: " << name;
     if (reg_id != 0) {
       GetReg(self, reg_id) = *pf;
+      DiscoTracer::ThreadLocal()->SetFuncName(reg_id, name);
     }
   }
 
@@ -147,7 +188,8 @@ struct DiscoWorker::Impl {
   static void DebugGetFromRemote(DiscoWorker* self, int reg_id, int worker_id) {
     if (worker_id == self->worker_id) {
       ffi::Any rv = GetReg(self, reg_id);
-      if (rv.as<ObjectRef>()) {
+      // Strings and bytes are natively supported by the disco protocol.
+      if (rv.as<ObjectRef>() && !rv.as<ffi::String>() && !rv.as<ffi::Bytes>()) {
         rv = DiscoDebugObject::Wrap(rv);
       }
       ffi::AnyView packed_args[2];
@@ -98,6 +98,7 @@ class SocketSessionObj : public BcastSessionObj {
   int64_t GetNumWorkers() final { return num_nodes_ * num_workers_per_node_; }
 
   ffi::Any DebugGetFromRemote(int64_t reg_id, int worker_id) final {
+    CheckNotRecordingBatch("DebugGetFromRemote");
     int node_id = worker_id / num_workers_per_node_;
     if (node_id == 0) {
       return local_session_->DebugGetFromRemote(reg_id, worker_id);
@@ -117,6 +118,7 @@ class SocketSessionObj : public BcastSessionObj {
   }
 
   void DebugSetRegister(int64_t reg_id, AnyView value, int worker_id) final {
+    CheckNotRecordingBatch("DebugSetRegister");
     int node_id = worker_id / num_workers_per_node_;
     if (node_id == 0) {
       local_session_->DebugSetRegister(reg_id, value, worker_id);
@@ -142,13 +144,15 @@ class SocketSessionObj : public BcastSessionObj {
   }
 
   void BroadcastPacked(const ffi::PackedArgs& args) final {
-    local_session_->BroadcastPacked(args);
+    // Fan out to the remote nodes first, each of which broadcasts to its own workers, so that
+    // the network latency overlaps with the broadcast to the local workers.
     std::vector<AnyView> packed_args(args.size() + 2);
     ffi::PackedArgs::Fill(packed_args.data(), static_cast<int>(DiscoSocketAction::kSend), -1);
     std::copy(args.data(), args.data() + args.size(), packed_args.begin() + 2);
     for (auto& channel : remote_channels_) {
       channel->Send(ffi::PackedArgs(packed_args.data(), packed_args.size()));
     }
+    local_session_->BroadcastPacked(args);
   }
 
   void SendPacked(int worker_id, const ffi::PackedArgs& args) final {
@@ -321,6 +325,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
              worker->num_groups = num_groups;
              worker->worker_id = worker->worker_id + node_id * num_workers_per_node;
              worker->num_workers = num_nodes * num_workers_per_node;
+             worker->num_workers_per_node = num_workers_per_node;
            });
 }
 
@@ -24,6 +24,7 @@
 #include <tvm/runtime/vm/tensor_cache_support.h>
 
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -114,6 +115,16 @@ class ShardLoaderObj : public Object {
   /*! \brief Load all the parameters */
   ffi::Array<Tensor> LoadAll() const;
 
+  /*!
+   * \brief Load the i-th parameter on every worker from its own mapping of the weight files,
+   * without loading on worker-0 and then broadcasting or scattering.
+   * It requires all workers to have access to the weight files.
+   */
+  Tensor LoadLocal(int weight_index) const;
+
+  /*! \brief Load all the parameters on every worker from its own mapping of the weight files */
+  ffi::Array<Tensor> LoadAllLocal() const;
+
   Tensor ApplyShardFunc(const ShardInfo::ShardFunc& shard_func, const Tensor& param) const;
 
   /*! \brief Load all the pre-sharded parameters */
@@ -143,10 +154,21 @@ class ShardLoaderObj : public Object {
   std::unordered_map<std::string, int> param_name_to_index_;
   /*! \brief The current file opened to load weights in it */
   mutable const FileRecord* current_file_;
-  /*! \brief The context of the current file to be loaded from */
-  mutable std::string current_file_stream_;
+  /*! \brief The memory mapping of the current file to be loaded from */
+  mutable std::unique_ptr<MappedFile> current_file_mapping_;
+  /*! \brief The raw data of the current file if it is compressed, which cannot be mapped */
+  mutable std::string current_file_data_;
 
  private:
+  /*!
+   * \brief Get the raw data of the given file, mapping it into memory if it is not the current
+   * file, and hint the OS to read ahead the parameter after the given one. A compressed file is
+   * decompressed into host memory instead.
+   * \param weight_index The index of the parameter to be loaded from the file
+   * \returns The beginning of the raw data of the file
+   */
+  const char* GetFileData(int weight_index) const;
+
   /*! \brief Load the i-th parameter without post-processing
    *
    * This function should not be called externally, as it does not
@@ -230,19 +252,9 @@ Tensor ShardLoaderObj::LoadParamOnWorker0(int weight_index) const {
   int param_index = param_name_to_index_.at("param_" + std::to_string(weight_index));
   const ParamInfo& param_info = param_info_.at(param_index);
   const ParamRecord* param = param_info.param;
-  const FileRecord* file = param_info.file;
-
-  auto load = [this, param, device, file]() {
-    if (file != current_file_) {
-      current_file_ = file;
-      std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
-      LoadBinaryFromFile(file_name, &this->current_file_stream_);
-    }
-    return param->Load(device, &this->current_file_stream_);
-  };
 
   if (worker_id == 0) {
-    Tensor w = load();
+    Tensor w = param->Load(device, GetFileData(param_index));
     return w;
   } else {
     Tensor w = Tensor::Empty(param->shape, param->dtype, device);
@@ -272,20 +284,43 @@ std::tuple<int, int> ParseParamShardingInfo(const ParamRecord* param) {
   return {num_shards, worker_id};
 }
 
-Tensor ShardLoaderObj::LoadDirect(int weight_index) const {
-  const ParamInfo& param_info = param_info_.at(weight_index);
-  const ParamRecord* param = param_info.param;
-  const FileRecord* file = param_info.file;
-
-  DiscoWorker* worker = DiscoWorker::ThreadLocal();
-  Device device = worker->default_device;
-
+const char* ShardLoaderObj::GetFileData(int weight_index) const {
+  const FileRecord* file = param_info_.at(weight_index).file;
   if (file != current_file_) {
-    current_file_ = file;
+    // Release the previous mapping first, so that at most one file is mapped at a time.
+    current_file_mapping_.reset();
+    current_file_data_.clear();
+    current_file_ = nullptr;
     std::string file_name = GetSiblingPath(this->metadata_.path, file->data_path);
-    LoadBinaryFromFile(file_name, &this->current_file_stream_);
+    if (file->compression.has_value()) {
+      file->ReadRawData(file_name, &current_file_data_);
+    } else {
+      auto mapping = std::make_unique<MappedFile>(file_name);
+      TVM_FFI_CHECK_EQ(static_cast<int64_t>(mapping->size()), file->nbytes, ValueError)
+          << "Encountered an corrupted parameter shard " << file_name
+          << ". It means it is not downloaded completely or downloading is interrupted. "
+          << "Please try to download again.";
+      current_file_mapping_ = std::move(mapping);
+    }
+    current_file_ = file;
   }
-  return param->Load(device, &this->current_file_stream_);
+  if (file->compression.has_value()) {
+    return current_file_data_.data();
+  }
+  // Parameters are usually loaded in order, so read ahead the next one in the same file.
+  if (weight_index + 1 < static_cast<int>(param_info_.size()) &&
+      param_info_[weight_index + 1].file == file) {
+    const ParamRecord* next = param_info_[weight_index + 1].param;
+    current_file_mapping_->Prefetch(next->byte_offset, next->nbytes);
+  }
+  return current_file_mapping_->data();
+}
+
+Tensor ShardLoaderObj::LoadDirect(int weight_index) const {
+  const ParamRecord* param = param_info_.at(weight_index).param;
+  DiscoWorker* worker = DiscoWorker::ThreadLocal();
+  Device device = worker->default_device;
+  return param->Load(device, GetFileData(weight_index));
 }
 
 Tensor ShardLoaderObj::Load(int weight_index) const {
@@ -341,6 +376,47 @@ ffi::Array<Tensor> ShardLoaderObj::LoadAll() const {
   return shards;
 }
 
+Tensor ShardLoaderObj::LoadLocal(int weight_index) const {
+  DiscoWorker* worker = DiscoWorker::ThreadLocal();
+  int worker_id = worker->worker_id;
+  int num_shards = worker->num_workers;
+  const ParamInfo& param_info = param_info_.at(weight_index);
+
+  Tensor w = LoadDirect(weight_index);
+  if (param_info.shard_info.funcs.empty()) {
+    return w;
+  }
+  ffi::Shape shape = param_info.shard_info.funcs.back().output_info.shape;
+  DataType dtype = param_info.shard_info.funcs.back().output_info.dtype;
+  TVM_FFI_CHECK(shape.size() >= 1 && shape[0] == num_shards, ValueError)
+      << "The first dimension of the "
+      << "output shape must be equal to the "
+      << "number of shards, but got: " << shape << " and num_shards = " << num_shards;
+  // The sharding functions are opaque, so each worker applies them to the full parameter,
+  // and keeps its own slice along the first dimension.
+  for (const ShardInfo::ShardFunc& shard_func : param_info.shard_info.funcs) {
+    w = this->ApplyShardFunc(shard_func, w);
+  }
+  ffi::Shape shard_shape(shape.begin() + 1, shape.end());
+  uint64_t shard_nbytes = shard_shape->Product() * dtype.bytes();
+  Tensor recv = Tensor::Empty(shard_shape, dtype, w->device);
+  recv.CopyFrom(w.CreateView(shard_shape, dtype, worker_id * shard_nbytes));
+  return recv;
+}
+
+ffi::Array<Tensor> ShardLoaderObj::LoadAllLocal() const {
+  int n = static_cast<int>(param_info_.size());
+  ffi::Array<Tensor> shards;
+  shards.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    std::string param_name = "param_" + std::to_string(i);
+    TVM_FFI_ICHECK(this->param_name_to_index_.count(param_name));
+    int shard_id = this->param_name_to_index_.at(param_name);
+    shards.push_back(this->LoadLocal(shard_id));
+  }
+  return shards;
+}
+
 Tensor ShardLoaderObj::LoadPresharded(int weight_index) const {
   DiscoWorker* worker = DiscoWorker::ThreadLocal();
   int worker_id = worker->worker_id;
@@ -401,6 +477,13 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                  << "Expected ShardLoaderObj, but gets: " << loader_obj->GetTypeKey();
              return loader->Load(IntegerFromShape(weight_index));
            })
+      .def("runtime.disco.ShardLoaderLoadLocal",
+           [](ObjectRef loader_obj, ffi::Shape weight_index) {
+             const auto* loader = loader_obj.as<ShardLoaderObj>();
+             TVM_FFI_CHECK(loader != nullptr, TypeError)
+                 << "Expected ShardLoaderObj, but gets: " << loader_obj->GetTypeKey();
+             return loader->LoadLocal(IntegerFromShape(weight_index));
+           })
       .def("runtime.disco.ShardLoaderLoadPresharded",
            [](ObjectRef loader_obj, ffi::Shape weight_index) {
              const auto* loader = loader_obj.as<ShardLoaderObj>();
@@ -415,6 +498,13 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                  << "Expected ShardLoaderObj, but gets: " << loader_obj->GetTypeKey();
              return loader->LoadAll();
            })
+      .def("runtime.disco.ShardLoaderLoadAllLocal",
+           [](ObjectRef loader_obj) {
+             const auto* loader = loader_obj.as<ShardLoaderObj>();
+             TVM_FFI_CHECK(loader != nullptr, TypeError)
+                 << "Expected ShardLoaderObj, but gets: " << loader_obj->GetTypeKey();
+             return loader->LoadAllLocal();
+           })
       .def("runtime.disco.ShardLoaderLoadAllPresharded",
            [](ObjectRef loader_obj) {
              const auto* loader = loader_obj.as<ShardLoaderObj>();
@@ -22,6 +22,7 @@
 #include <cstring>
 #include <mutex>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 #include "../../../support/process_id.h"
@@ -114,6 +115,67 @@ void InitCCLPerWorker(ffi::Shape device_ids, std::string unique_id_bytes) {
     NCCL_CALL(ncclCommSplit(ctx->global_comm, worker->worker_id / group_size,
                             worker->worker_id % group_size, &ctx->group_comm, NULL));
   }
+  int num_workers_per_node = worker->num_workers_per_node;
+  if (num_workers_per_node < worker->num_workers) {
+    // The session spans multiple nodes, where collectives over all workers run within each
+    // node first and then across nodes, so that only one node-level share crosses the network.
+    TVM_FFI_ICHECK_EQ(worker->num_workers % num_workers_per_node, 0);
+    NCCL_CALL(ncclCommSplit(ctx->global_comm, worker->worker_id / num_workers_per_node,
+                            worker->worker_id % num_workers_per_node, &ctx->node_comm, NULL));
+    NCCL_CALL(ncclCommSplit(ctx->global_comm, worker->worker_id % num_workers_per_node,
+                            worker->worker_id / num_workers_per_node, &ctx->cross_node_comm,
+                            NULL));
+  }
+}
+
+/*!
+ * \brief Allreduce within each node, then across nodes. The buffer is reduce-scattered within
+ * the node, each chunk is allreduced across nodes by the workers of the same local rank, and
+ * the chunks are finally allgathered within the node.
+ */
+void HierarchicalAllReduce(CCLThreadLocalContext* ctx, const Tensor& send, ncclRedOp_t op,
+                           const Tensor& recv, deviceStream_t stream) {
+  int num_workers_per_node = ctx->worker->num_workers_per_node;
+  int local_rank = ctx->worker->worker_id % num_workers_per_node;
+  int64_t chunk_numel = send.Shape().Product() / num_workers_per_node;
+  ncclDataType_t dtype = AsNCCLDataType(DataType(send->dtype));
+  int64_t elem_bytes = (send->dtype.bits * send->dtype.lanes + 7) / 8;
+  void* recv_chunk = static_cast<char*>(recv->data) + local_rank * chunk_numel * elem_bytes;
+  NCCL_CALL(ncclReduceScatter(send->data, recv_chunk, chunk_numel, dtype, op, ctx->node_comm,
+                              stream));
+  NCCL_CALL(
+      ncclAllReduce(recv_chunk, recv_chunk, chunk_numel, dtype, op, ctx->cross_node_comm, stream));
+  NCCL_CALL(ncclAllGather(recv_chunk, recv->data, chunk_numel, dtype, ctx->node_comm, stream));
+}
+
+/*!
+ * \brief Allgather across nodes, then within each node. Each worker first gathers the buffers of
+ * the workers with the same local rank on every node, and the gathered buffers are then
+ * allgathered within the node and reordered into the worker order.
+ */
+void HierarchicalAllGather(CCLThreadLocalContext* ctx, const Tensor& send, const Tensor& recv,
+                           deviceStream_t stream) {
+  int num_workers_per_node = ctx->worker->num_workers_per_node;
+  int num_nodes = ctx->worker->num_workers / num_workers_per_node;
+  int64_t numel = send.Shape().Product();
+  ncclDataType_t dtype = AsNCCLDataType(DataType(send->dtype));
+  int64_t elem_bytes = (send->dtype.bits * send->dtype.lanes + 7) / 8;
+  int64_t send_bytes = numel * elem_bytes;
+  // The scratch holds the cross-node result laid out as [node], followed by the node-level
+  // result laid out as [local_rank][node].
+  char* cross_node = static_cast<char*>(
+      ctx->GetHierarchicalScratch(send_bytes * (num_nodes + ctx->worker->num_workers)));
+  char* node_level = cross_node + send_bytes * num_nodes;
+  NCCL_CALL(ncclAllGather(send->data, cross_node, numel, dtype, ctx->cross_node_comm, stream));
+  NCCL_CALL(
+      ncclAllGather(cross_node, node_level, numel * num_nodes, dtype, ctx->node_comm, stream));
+  // Reorder [local_rank][node] into [node][local_rank], which is the worker order.
+  for (int local_rank = 0; local_rank < num_workers_per_node; ++local_rank) {
+    Memcpy2DAsync(static_cast<char*>(recv->data) + local_rank * send_bytes,
+                  send_bytes * num_workers_per_node,
+                  node_level + local_rank * num_nodes * send_bytes, send_bytes, send_bytes,
+                  num_nodes, stream);
+  }
 }
 
 void AllReduce(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
@@ -126,6 +188,10 @@ void AllReduce(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv)
     TVM_FFI_THROW(InternalError)
         << "Float8 data type cannot be allreduced, as nccl does not support this data type.";
   }
+  if (ctx->UseHierarchicalComm(in_group) && numel % ctx->worker->num_workers_per_node == 0) {
+    HierarchicalAllReduce(ctx, send, AsNCCLRedOp(reduce_kind), recv, stream);
+    return;
+  }
   NCCL_CALL(ncclAllReduce(send->data, recv->data, numel,
                           /*datatype=*/AsNCCLDataType(dtype),
                           /*op=*/AsNCCLRedOp(reduce_kind),
@@ -137,9 +203,186 @@ void AllGather(Tensor send, bool in_group, Tensor recv) {
   ffi::Shape shape = send.Shape();
   int64_t numel = shape->Product();
   deviceStream_t stream = ctx->GetDefaultStream();
+  if (ctx->UseHierarchicalComm(in_group)) {
+    HierarchicalAllGather(ctx, send, recv, stream);
+    return;
+  }
+  NCCL_CALL(ncclAllGather(send->data, recv->data, numel,
+                          /*datatype=*/AsNCCLDataType(DataType(send->dtype)),
+                          in_group ? ctx->group_comm : ctx->global_comm, stream));
+}
+
+int64_t AllReduceAsync(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int64_t numel = send.Shape().Product();
+  DataType dtype = DataType(send->dtype);
+  if (dtype == DataType::Float8E4M3FN() || dtype == DataType::Float8E5M2()) {
+    TVM_FFI_THROW(InternalError)
+        << "Float8 data type cannot be allreduced, as nccl does not support this data type.";
+  }
+  deviceStream_t stream = ctx->BeginAsyncCollective();
+  NCCL_CALL(ncclAllReduce(send->data, recv->data, numel,
+                          /*datatype=*/AsNCCLDataType(dtype),
+                          /*op=*/AsNCCLRedOp(reduce_kind),
+                          in_group ? ctx->group_comm : ctx->global_comm, stream));
+  return ctx->EndAsyncCollective({send, recv});
+}
+
+int64_t AllGatherAsync(Tensor send, bool in_group, Tensor recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int64_t numel = send.Shape().Product();
+  deviceStream_t stream = ctx->BeginAsyncCollective();
   NCCL_CALL(ncclAllGather(send->data, recv->data, numel,
                           /*datatype=*/AsNCCLDataType(DataType(send->dtype)),
                           in_group ? ctx->group_comm : ctx->global_comm, stream));
+  return ctx->EndAsyncCollective({send, recv});
+}
+
+void WaitCollective(int64_t handle) { CCLThreadLocalContext::Get()->WaitAsyncCollective(handle); }
+
+void ReduceScatter(Tensor send, ReduceKind reduce_kind, bool in_group, Tensor recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int num_workers = ctx->worker->num_workers;
+  int num_peers = in_group ? num_workers / ctx->worker->num_groups : num_workers;
+  int64_t send_numel = send.Shape().Product();
+  int64_t recv_numel = recv.Shape().Product();
+  TVM_FFI_CHECK_EQ(send_numel, recv_numel * num_peers, ValueError)
+      << "ReduceScatter requires the number of elements in buffer `send` to be the number of "
+         "elements in buffer `recv` times the number of workers, but got `send.size` = "
+      << send_numel << ", `recv.size` = " << recv_numel << " and " << num_peers << " workers.";
+  deviceStream_t stream = ctx->GetDefaultStream();
+  DataType dtype = DataType(send->dtype);
+  if (dtype == DataType::Float8E4M3FN() || dtype == DataType::Float8E5M2()) {
+    TVM_FFI_THROW(InternalError)
+        << "Float8 data type cannot be reduce-scattered, as nccl does not support this data type.";
+  }
+  NCCL_CALL(ncclReduceScatter(send->data, recv->data, recv_numel,
+                              /*datatype=*/AsNCCLDataType(dtype),
+                              /*op=*/AsNCCLRedOp(reduce_kind),
+                              in_group ? ctx->group_comm : ctx->global_comm, stream));
+}
+
+// Returns the (element offset, element count) exchanged with each peer. An empty `splits`
+// chunks the buffer evenly, otherwise `splits[i]` rows along axis 0 go to/come from peer i.
+static std::vector<std::pair<int64_t, int64_t>> GetAllToAllChunks(const Tensor& buffer,
+                                                                  const ffi::Shape& splits,
+                                                                  int num_peers,
+                                                                  const char* name) {
+  int64_t numel = buffer.Shape().Product();
+  std::vector<std::pair<int64_t, int64_t>> chunks;
+  chunks.reserve(num_peers);
+  if (splits.empty()) {
+    TVM_FFI_CHECK_EQ(numel % num_peers, 0, ValueError)
+        << "AllToAll without split sizes requires that the number of elements in buffer `" << name
+        << "` to be divisible by the number of workers, but got numel = " << numel << " and "
+        << num_peers << " workers.";
+    int64_t numel_per_chunk = numel / num_peers;
+    for (int i = 0; i < num_peers; ++i) {
+      chunks.emplace_back(i * numel_per_chunk, numel_per_chunk);
+    }
+    return chunks;
+  }
+  TVM_FFI_CHECK_EQ(static_cast<int>(splits.size()), num_peers, ValueError)
+      << "The split sizes of buffer `" << name << "` must have one entry per worker, but got "
+      << splits.size() << " entries and " << num_peers << " workers.";
+  TVM_FFI_CHECK_GE(buffer->ndim, 1, ValueError)
+      << "AllToAll with split sizes requires buffer `" << name << "` to have at least one dim.";
+  int64_t num_rows = buffer->shape[0];
+  int64_t numel_per_row = num_rows == 0 ? 0 : numel / num_rows;
+  int64_t row_offset = 0;
+  for (int i = 0; i < num_peers; ++i) {
+    TVM_FFI_CHECK_GE(splits[i], 0, ValueError)
+        << "The split sizes of buffer `" << name << "` must be non-negative, but got " << splits;
+    chunks.emplace_back(row_offset * numel_per_row, splits[i] * numel_per_row);
+    row_offset += splits[i];
+  }
+  TVM_FFI_CHECK_EQ(row_offset, num_rows, ValueError)
+      << "The split sizes of buffer `" << name << "` must sum up to its first dimension "
+      << num_rows << ", but got " << splits;
+  return chunks;
+}
+
+void AllToAll(Tensor send, ffi::Shape send_splits, ffi::Shape recv_splits, bool in_group,
+              Tensor recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int num_workers = ctx->worker->num_workers;
+  int num_peers = in_group ? num_workers / ctx->worker->num_groups : num_workers;
+  TVM_FFI_CHECK_EQ(send_splits.empty(), recv_splits.empty(), ValueError)
+      << "The split sizes of `send` and `recv` must be either both provided or both empty.";
+  TVM_FFI_CHECK(DataType(send->dtype) == DataType(recv->dtype), ValueError)
+      << "AllToAll requires `send` and `recv` to have the same dtype, but got "
+      << DataType(send->dtype) << " and " << DataType(recv->dtype);
+  std::vector<std::pair<int64_t, int64_t>> send_chunks =
+      GetAllToAllChunks(send, send_splits, num_peers, "send");
+  std::vector<std::pair<int64_t, int64_t>> recv_chunks =
+      GetAllToAllChunks(recv, recv_splits, num_peers, "recv");
+  DataType dtype(send->dtype);
+  int64_t elem_bytes = dtype.bytes();
+  uint8_t* send_data = static_cast<uint8_t*>(send->data);
+  uint8_t* recv_data = static_cast<uint8_t*>(recv->data);
+  ncclComm_t comm = in_group ? ctx->group_comm : ctx->global_comm;
+  deviceStream_t stream = ctx->GetDefaultStream();
+  NCCL_CALL(ncclGroupStart());
+  for (int i = 0; i < num_peers; ++i) {
+    NCCL_CALL(ncclSend(send_data + send_chunks[i].first * elem_bytes, send_chunks[i].second,
+                       AsNCCLDataType(dtype), i, comm, stream));
+    NCCL_CALL(ncclRecv(recv_data + recv_chunks[i].first * elem_bytes, recv_chunks[i].second,
+                       AsNCCLDataType(dtype), i, comm, stream));
+  }
+  NCCL_CALL(ncclGroupEnd());
+}
+
+/*!
+ * \brief Enqueue the exchange of a ring step on the stream: each worker sends `send` to the next
+ *  worker of the ring and receives `recv` from the previous one.
+ */
+void RingSendRecvOnStream(CCLThreadLocalContext* ctx, const Tensor& send, bool in_group,
+                          const Tensor& recv, deviceStream_t stream) {
+  int num_workers = ctx->worker->num_workers;
+  int num_peers = in_group ? num_workers / ctx->worker->num_groups : num_workers;
+  int rank = ctx->worker->worker_id % num_peers;
+  TVM_FFI_CHECK(DataType(send->dtype) == DataType(recv->dtype), ValueError)
+      << "RingSendRecv requires `send` and `recv` to have the same dtype, but got "
+      << DataType(send->dtype) << " and " << DataType(recv->dtype);
+  int64_t numel = send.Shape().Product();
+  TVM_FFI_CHECK_EQ(numel, recv.Shape().Product(), ValueError)
+      << "RingSendRecv requires `send` and `recv` to have the same size, but got "
+      << send.Shape() << " and " << recv.Shape();
+  ncclComm_t comm = in_group ? ctx->group_comm : ctx->global_comm;
+  ncclDataType_t dtype = AsNCCLDataType(DataType(send->dtype));
+  // The send and the receive are grouped: ungrouped, every worker would block in its send.
+  NCCL_CALL(ncclGroupStart());
+  NCCL_CALL(ncclSend(send->data, numel, dtype, (rank + 1) % num_peers, comm, stream));
+  NCCL_CALL(ncclRecv(recv->data, numel, dtype, (rank + num_peers - 1) % num_peers, comm, stream));
+  NCCL_CALL(ncclGroupEnd());
+}
+
+void RingSendRecv(Tensor send, bool in_group, Tensor recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  RingSendRecvOnStream(ctx, send, in_group, recv, ctx->GetDefaultStream());
+}
+
+int64_t RingSendRecvAsync(Tensor send, bool in_group, Tensor recv) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  deviceStream_t stream = ctx->BeginAsyncCollective();
+  RingSendRecvOnStream(ctx, send, in_group, recv, stream);
+  return ctx->EndAsyncCollective({send, recv});
+}
+
+void RingSendRecvWait(Tensor send, Tensor recv, Tensor after, Tensor out) {
+  CCLThreadLocalContext* ctx = CCLThreadLocalContext::Get();
+  int64_t handle = -1;
+  for (const auto& kv : ctx->pending_collectives) {
+    const std::vector<Tensor>& buffers = kv.second.buffers;
+    if (buffers.size() == 2 && buffers[0]->data == send->data && buffers[1]->data == recv->data) {
+      handle = kv.first;
+      break;
+    }
+  }
+  TVM_FFI_CHECK_NE(handle, -1, ValueError)
+      << "No ring exchange from the given `send` to `recv` is in flight.";
+  ctx->WaitAsyncCollective(handle);
+  Tensor::CopyFromTo(recv.operator->(), out.operator->(), ctx->GetDefaultStream());
 }
 
 void BroadcastFromWorker0(ffi::Optional<Tensor> send, bool in_group, Tensor recv) {
@@ -330,6 +573,9 @@ void SyncWorker() {
   TVM_FFI_ICHECK(ctx->worker != nullptr);
   deviceStream_t stream = ctx->GetDefaultStream();
   StreamSynchronize(stream);
+  if (ctx->comm_stream != nullptr) {
+    StreamSynchronize(ctx->comm_stream);
+  }
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -345,6 +591,24 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            })
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".allgather",
            [](Tensor send, bool in_group, Tensor recv) { nccl::AllGather(send, in_group, recv); })
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".allreduce_async",
+           [](Tensor send, int kind, bool in_group, Tensor recv) -> int64_t {
+             TVM_FFI_CHECK(0 <= kind && kind <= 4, ValueError) << "Unknown ReduceKind: " << kind;
+             return nccl::AllReduceAsync(send, static_cast<ReduceKind>(kind), in_group, recv);
+           })
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".allgather_async", AllGatherAsync)
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".wait", WaitCollective)
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".reduce_scatter",
+           [](Tensor send, int kind, bool in_group, Tensor recv) {
+             TVM_FFI_CHECK(0 <= kind && kind <= 4, ValueError) << "Unknown ReduceKind: " << kind;
+             nccl::ReduceScatter(send, static_cast<ReduceKind>(kind), in_group, recv);
+           })
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".all_to_all",
+           [](Tensor send, ffi::Shape send_splits, ffi::Shape recv_splits, bool in_group,
+              Tensor recv) { nccl::AllToAll(send, send_splits, recv_splits, in_group, recv); })
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".ring_send_recv", RingSendRecv)
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".ring_send_recv_async", RingSendRecvAsync)
+      .def("runtime.disco." TVM_DISCO_CCL_NAME ".ring_send_recv_wait", RingSendRecvWait)
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".broadcast_from_worker0", BroadcastFromWorker0)
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".scatter_from_worker0", ScatterFromWorker0)
       .def("runtime.disco." TVM_DISCO_CCL_NAME ".gather_to_worker0", GatherToWorker0)
@@ -26,6 +26,10 @@
 #include <tvm/runtime/disco/builtin.h>
 #include <tvm/runtime/disco/session.h>
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "../../../support/process_id.h"
 #include "../utils.h"
 
@@ -66,6 +70,26 @@ inline void SetDevice(int device_id) { CUDA_CALL(cudaSetDevice(device_id)); }
 inline void StreamSynchronize(deviceStream_t stream) { CUDA_CALL(cudaStreamSynchronize(stream)); }
 inline void StreamCreate(deviceStream_t* stream) { CUDA_CALL(cudaStreamCreate(stream)); }
 inline void StreamDestroy(deviceStream_t stream) { CUDA_CALL(cudaStreamDestroy(stream)); }
+inline void StreamCreateNonBlocking(deviceStream_t* stream) {
+  CUDA_CALL(cudaStreamCreateWithFlags(stream, cudaStreamNonBlocking));
+}
+
+using deviceEvent_t = cudaEvent_t;
+inline void EventCreate(deviceEvent_t* event) {
+  CUDA_CALL(cudaEventCreateWithFlags(event, cudaEventDisableTiming));
+}
+inline void EventDestroy(deviceEvent_t event) { CUDA_CALL(cudaEventDestroy(event)); }
+inline void EventRecord(deviceEvent_t event, deviceStream_t stream) {
+  CUDA_CALL(cudaEventRecord(event, stream));
+}
+inline void StreamWaitEvent(deviceStream_t stream, deviceEvent_t event) {
+  CUDA_CALL(cudaStreamWaitEvent(stream, event, 0));
+}
+inline void Memcpy2DAsync(void* dst, size_t dpitch, const void* src, size_t spitch, size_t width,
+                          size_t height, deviceStream_t stream) {
+  CUDA_CALL(cudaMemcpy2DAsync(dst, dpitch, src, spitch, width, height, cudaMemcpyDeviceToDevice,
+                              stream));
+}
 
 #else
 
@@ -78,6 +102,26 @@ inline void SetDevice(int device_id) { ROCM_CALL(hipSetDevice(device_id)); }
 inline void StreamSynchronize(deviceStream_t stream) { ROCM_CALL(hipStreamSynchronize(stream)); }
 inline void StreamCreate(deviceStream_t* stream) { ROCM_CALL(hipStreamCreate(stream)); }
 inline void StreamDestroy(deviceStream_t stream) { ROCM_CALL(hipStreamDestroy(stream)); }
+inline void StreamCreateNonBlocking(deviceStream_t* stream) {
+  ROCM_CALL(hipStreamCreateWithFlags(stream, hipStreamNonBlocking));
+}
+
+using deviceEvent_t = hipEvent_t;
+inline void EventCreate(deviceEvent_t* event) {
+  ROCM_CALL(hipEventCreateWithFlags(event, hipEventDisableTiming));
+}
+inline void EventDestroy(deviceEvent_t event) { ROCM_CALL(hipEventDestroy(event)); }
+inline void EventRecord(deviceEvent_t event, deviceStream_t stream) {
+  ROCM_CALL(hipEventRecord(event, stream));
+}
+inline void StreamWaitEvent(deviceStream_t stream, deviceEvent_t event) {
+  ROCM_CALL(hipStreamWaitEvent(stream, event, 0));
+}
+inline void Memcpy2DAsync(void* dst, size_t dpitch, const void* src, size_t spitch, size_t width,
+                          size_t height, deviceStream_t stream) {
+  ROCM_CALL(hipMemcpy2DAsync(dst, dpitch, src, spitch, width, height, hipMemcpyDeviceToDevice,
+                             stream));
+}
 
 #endif
 
@@ -120,16 +164,73 @@ inline ncclDataType_t AsNCCLDataType(runtime::DataType dtype) {
   throw;
 }
 
+/*! \brief An asynchronous collective launched on the communication stream. */
+struct AsyncCollective {
+  /*! \brief The event recorded on the communication stream after the collective. */
+  deviceEvent_t done_event;
+  /*! \brief The buffers used by the collective, kept alive until it is waited. */
+  std::vector<Tensor> buffers;
+};
+
 struct CCLThreadLocalContext {
   DiscoWorker* worker = nullptr;
   int device_id;
   deviceStream_t default_stream = nullptr;
   ncclComm_t global_comm = nullptr;
   ncclComm_t group_comm = nullptr;
+  /*!
+   * \brief The communicator of the workers on the same node, only created when the session
+   * spans multiple nodes.
+   */
+  ncclComm_t node_comm = nullptr;
+  /*!
+   * \brief The communicator of the workers with the same local rank on different nodes, only
+   * created when the session spans multiple nodes.
+   */
+  ncclComm_t cross_node_comm = nullptr;
+  /*! \brief The scratch buffer of hierarchical collectives, grown on demand. */
+  ffi::Optional<Tensor> hierarchical_scratch;
+  /*! \brief The stream that asynchronous collectives run on, created lazily. */
+  deviceStream_t comm_stream = nullptr;
+  /*! \brief The event used to order the communication stream after the compute stream. */
+  deviceEvent_t comm_ready_event = nullptr;
+  /*! \brief The pool of events that can be reused to mark collectives done. */
+  std::vector<deviceEvent_t> free_events;
+  /*! \brief The asynchronous collectives that have not been waited, keyed by handle. */
+  std::unordered_map<int64_t, AsyncCollective> pending_collectives;
+  /*! \brief The handle of the next asynchronous collective. */
+  int64_t next_collective_handle = 0;
 
   ~CCLThreadLocalContext() { Clear(); }
 
   void Clear() {
+    if (comm_stream) {
+      // Asynchronous collectives still in flight must finish before the comm is destroyed.
+      StreamSynchronize(comm_stream);
+      StreamDestroy(comm_stream);
+      comm_stream = nullptr;
+    }
+    for (auto& kv : pending_collectives) {
+      free_events.push_back(kv.second.done_event);
+    }
+    pending_collectives.clear();
+    for (deviceEvent_t event : free_events) {
+      EventDestroy(event);
+    }
+    free_events.clear();
+    if (comm_ready_event) {
+      EventDestroy(comm_ready_event);
+      comm_ready_event = nullptr;
+    }
+    hierarchical_scratch = std::nullopt;
+    if (node_comm) {
+      NCCL_CALL(ncclCommDestroy(node_comm));
+      node_comm = nullptr;
+    }
+    if (cross_node_comm) {
+      NCCL_CALL(ncclCommDestroy(cross_node_comm));
+      cross_node_comm = nullptr;
+    }
     if (group_comm) {
       NCCL_CALL(ncclCommDestroy(group_comm));
       if (global_comm == group_comm) {
@@ -155,6 +256,71 @@ struct CCLThreadLocalContext {
     return stream == nullptr ? default_stream : stream;
   }
 
+  /*!
+   * \brief Get the communication stream for an asynchronous collective, ordered after all the
+   * work enqueued so far on the default stream.
+   */
+  deviceStream_t BeginAsyncCollective() {
+    if (comm_stream == nullptr) {
+      StreamCreateNonBlocking(&comm_stream);
+      EventCreate(&comm_ready_event);
+    }
+    EventRecord(comm_ready_event, GetDefaultStream());
+    StreamWaitEvent(comm_stream, comm_ready_event);
+    return comm_stream;
+  }
+
+  /*!
+   * \brief Mark the end of an asynchronous collective launched on the communication stream.
+   * \param buffers The buffers of the collective, kept alive until it is waited.
+   * \return The handle to be waited by `WaitAsyncCollective`.
+   */
+  int64_t EndAsyncCollective(std::vector<Tensor> buffers) {
+    deviceEvent_t event;
+    if (free_events.empty()) {
+      EventCreate(&event);
+    } else {
+      event = free_events.back();
+      free_events.pop_back();
+    }
+    EventRecord(event, comm_stream);
+    int64_t handle = next_collective_handle++;
+    pending_collectives.emplace(handle, AsyncCollective{event, std::move(buffers)});
+    return handle;
+  }
+
+  /*!
+   * \brief Order the default stream after the given asynchronous collective.
+   * This does not block the host.
+   */
+  void WaitAsyncCollective(int64_t handle) {
+    auto it = pending_collectives.find(handle);
+    TVM_FFI_CHECK(it != pending_collectives.end(), ValueError)
+        << "The asynchronous collective handle " << handle
+        << " does not exist or has already been waited.";
+    StreamWaitEvent(GetDefaultStream(), it->second.done_event);
+    free_events.push_back(it->second.done_event);
+    pending_collectives.erase(it);
+  }
+
+  /*!
+   * \brief Whether collectives on the given communicator run hierarchically, i.e. within each
+   * node and then across nodes. Only the global communicator of a multi-node session does.
+   */
+  bool UseHierarchicalComm(bool in_group) const {
+    return node_comm != nullptr && (in_group ? group_comm : global_comm) == global_comm;
+  }
+
+  /*! \brief Get a scratch buffer of at least `nbytes` bytes on the device of the worker. */
+  void* GetHierarchicalScratch(int64_t nbytes) {
+    if (!hierarchical_scratch.has_value() ||
+        hierarchical_scratch.value().Shape().Product() < nbytes) {
+      hierarchical_scratch = Tensor::Empty(ffi::Shape({nbytes}), DataType::UInt(8),
+                                           Device{TVM_DISCO_DEVICE_TYPE, device_id});
+    }
+    return hierarchical_scratch.value()->data;
+  }
+
   static CCLThreadLocalContext* Get();
 };
 
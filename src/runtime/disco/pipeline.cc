@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file pipeline.cc
+ * \brief Pipeline-parallel scheduling of micro-batches over disco worker groups.
+ */
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/disco/builtin.h>
+#include <tvm/runtime/disco/disco_worker.h>
+
+#include <chrono>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief Get the view of the `index`-th of `num_micro_batches` slices of `tensor` along axis 0. */
+Tensor MicroBatchView(const Tensor& tensor, int64_t num_micro_batches, int64_t index) {
+  std::vector<int64_t> shape(tensor.Shape().begin(), tensor.Shape().end());
+  shape[0] /= num_micro_batches;
+  int64_t nbytes = GetDataSize(*tensor.operator->()) / num_micro_batches;
+  return tensor.CreateView(ffi::Shape(shape), tensor->dtype, index * nbytes);
+}
+
+void CheckMicroBatchTensor(const ffi::Optional<Tensor>& tensor, int64_t num_micro_batches,
+                           const char* name) {
+  TVM_FFI_CHECK(tensor.has_value(), ValueError)
+      << "The " << name << " tensor must be provided on workers of the " << name << " stage";
+  TVM_FFI_CHECK(tensor.value()->ndim > 0 && tensor.value()->shape[0] % num_micro_batches == 0,
+                ValueError)
+      << "The leading dimension of the " << name << " tensor " << tensor.value().Shape()
+      << " is not divisible by the number of micro-batches " << num_micro_batches;
+}
+
+ffi::Shape PipelineForward(ffi::Module mod, ffi::Array<ffi::String> stage_funcs,
+                           int64_t num_micro_batches, ffi::Optional<Tensor> input,
+                           ffi::Shape activation_shape, DataType activation_dtype,
+                           ffi::Optional<Tensor> output, bool measure_time) {
+  DiscoWorker* worker = DiscoWorker::ThreadLocal();
+  int64_t num_stages = worker->num_groups;
+  int64_t group_size = worker->num_workers / worker->num_groups;
+  int64_t stage = worker->worker_id / group_size;
+  TVM_FFI_CHECK_EQ(stage_funcs.size(), num_stages, ValueError)
+      << "The number of stage functions " << stage_funcs.size()
+      << " does not match the number of worker groups " << num_stages;
+  TVM_FFI_CHECK_GT(num_micro_batches, 0, ValueError)
+      << "The number of micro-batches must be positive";
+  ffi::Optional<ffi::Function> stage_func = mod->GetFunction(stage_funcs[stage]);
+  TVM_FFI_CHECK(stage_func.has_value(), ValueError)
+      << "Cannot find the function `" << stage_funcs[stage] << "` of stage " << stage;
+
+  bool is_first_stage = stage == 0;
+  bool is_last_stage = stage == num_stages - 1;
+  if (is_first_stage) {
+    CheckMicroBatchTensor(input, num_micro_batches, "input");
+  }
+  if (is_last_stage) {
+    CheckMicroBatchTensor(output, num_micro_batches, "output");
+  }
+  ffi::Optional<Tensor> recv_buffer;
+  if (!is_first_stage) {
+    recv_buffer = DiscoEmptyTensor(activation_shape, activation_dtype, std::nullopt);
+  }
+
+  // Run `f` and return its time in microseconds. The device is synchronized around `f` only
+  // when time is measured, since the work is otherwise asynchronous.
+  auto f_timed = [measure_time](auto f) -> int64_t {
+    if (!measure_time) {
+      f();
+      return 0;
+    }
+    SyncWorker();
+    auto start = std::chrono::steady_clock::now();
+    f();
+    SyncWorker();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  };
+
+  // At tick `t`, stage `s` runs micro-batch `t - s`, so that all stages are busy once the
+  // pipeline is filled. Each stage then sends its output to the next stage, which receives it
+  // as the input of the next tick. Sends are issued before receives: the last stage only
+  // receives, so the chain of sends and receives always makes progress.
+  int64_t num_ticks = num_micro_batches + num_stages - 1;
+  int64_t busy_ticks = 0;
+  int64_t compute_us = 0;
+  int64_t comm_us = 0;
+  for (int64_t tick = 0; tick < num_ticks; ++tick) {
+    int64_t micro_batch = tick - stage;
+    ffi::Optional<Tensor> stage_output;
+    if (micro_batch >= 0 && micro_batch < num_micro_batches) {
+      compute_us += f_timed([&]() {
+        Tensor stage_input = is_first_stage
+                                 ? MicroBatchView(input.value(), num_micro_batches, micro_batch)
+                                 : recv_buffer.value();
+        Tensor result = (*stage_func)(stage_input).cast<Tensor>();
+        if (is_last_stage) {
+          MicroBatchView(output.value(), num_micro_batches, micro_batch).CopyFrom(result);
+        } else {
+          stage_output = result;
+        }
+      });
+      ++busy_ticks;
+    }
+    int64_t next_micro_batch = micro_batch + 1;
+    bool recv_next = !is_first_stage && next_micro_batch >= 0 &&
+                     next_micro_batch < num_micro_batches;
+    if (stage_output.has_value() || recv_next) {
+      comm_us += f_timed([&]() {
+        if (stage_output.has_value()) {
+          SendToNextGroup(stage_output.value());
+        }
+        if (recv_next) {
+          RecvFromPrevGroup(recv_buffer.value());
+        }
+      });
+    }
+  }
+  return ffi::Shape({num_ticks, busy_ticks, compute_us, comm_us});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("runtime.disco.pipeline_forward", PipelineForward);
+}
+
+}  // namespace runtime
+}  // namespace tvm
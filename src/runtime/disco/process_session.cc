@@ -22,12 +22,18 @@
 #include <tvm/runtime/disco/disco_worker.h>
 #include <tvm/runtime/object.h>
 
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
 #include <memory>
 #include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "../../support/pipe.h"
+#include "../../support/shm_ring_buffer.h"
 #include "../minrpc/rpc_reference.h"
 #include "./bcast_session.h"
 #include "./disco_worker_thread.h"
@@ -37,25 +43,75 @@
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief The channel between the controller and a worker process.
+ *
+ * Controller-to-worker messages go through a shared-memory ring buffer when it is available,
+ * which avoids a pipe write and read per broadcast. Worker-to-controller replies, as well as
+ * the fallback on platforms without shared memory, go through pipes. The pipes also tell
+ * either side when the other process exits.
+ */
 class DiscoProcessChannel final : public DiscoChannel {
  public:
-  DiscoProcessChannel(int64_t controler_to_worker_fd, int64_t worker_to_controler_fd)
+  /*! \brief The capacity of the controller-to-worker shared-memory ring buffer. */
+  static constexpr size_t kShmCapacity = 1 << 20;
+
+  DiscoProcessChannel(int64_t controler_to_worker_fd, int64_t worker_to_controler_fd,
+                      bool is_controller)
       : controller_to_worker_pipe_(controler_to_worker_fd),
         worker_to_controller_pipe_(worker_to_controler_fd),
-        controler_to_worker_(&controller_to_worker_pipe_),
-        worker_to_controler_(&worker_to_controller_pipe_) {}
+        worker_to_controler_(&worker_to_controller_pipe_) {
+    // The controller creates the ring buffer and sends its name through the pipe, where an
+    // empty name means the pipe itself is used.
+    if (is_controller) {
+      controller_to_worker_shm_ = support::ShmRingBuffer::Create(
+          kShmCapacity, [fd = worker_to_controler_fd]() { return !IsPipeHungUp(fd); });
+      std::string name =
+          controller_to_worker_shm_ != nullptr ? controller_to_worker_shm_->name() : "";
+      controller_to_worker_pipe_.Write(static_cast<uint64_t>(name.size()));
+      controller_to_worker_pipe_.WriteArray(name.data(), name.size());
+    } else {
+      uint64_t name_size = 0;
+      TVM_FFI_ICHECK(controller_to_worker_pipe_.Read(&name_size));
+      std::string name(name_size, '\0');
+      TVM_FFI_ICHECK(controller_to_worker_pipe_.ReadArray(name.data(), name_size));
+      if (!name.empty()) {
+        controller_to_worker_shm_ = support::ShmRingBuffer::Open(
+            name, [fd = controler_to_worker_fd]() { return !IsPipeHungUp(fd); });
+      }
+    }
+    support::Stream* stream = &controller_to_worker_pipe_;
+    if (controller_to_worker_shm_ != nullptr) {
+      stream = controller_to_worker_shm_.get();
+    }
+    controler_to_worker_ = std::make_unique<DiscoStreamMessageQueue>(stream);
+  }
 
   DiscoProcessChannel(DiscoProcessChannel&& other) = delete;
   DiscoProcessChannel(const DiscoProcessChannel& other) = delete;
 
-  void Send(const ffi::PackedArgs& args) { controler_to_worker_.Send(args); }
-  ffi::PackedArgs Recv() { return controler_to_worker_.Recv(); }
+  void Send(const ffi::PackedArgs& args) { controler_to_worker_->Send(args); }
+  ffi::PackedArgs Recv() { return controler_to_worker_->Recv(); }
   void Reply(const ffi::PackedArgs& args) { worker_to_controler_.Send(args); }
   ffi::PackedArgs RecvReply() { return worker_to_controler_.Recv(); }
 
+  /*! \brief Check whether the write end of the pipe whose read end is `fd` has been closed. */
+  static bool IsPipeHungUp(int64_t fd) {
+#ifndef _WIN32
+    struct pollfd pfd;
+    pfd.fd = static_cast<int>(fd);
+    pfd.events = 0;
+    pfd.revents = 0;
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+#else
+    return false;
+#endif
+  }
+
   support::Pipe controller_to_worker_pipe_;
   support::Pipe worker_to_controller_pipe_;
-  DiscoStreamMessageQueue controler_to_worker_;
+  std::unique_ptr<support::ShmRingBuffer> controller_to_worker_shm_;
+  std::unique_ptr<DiscoStreamMessageQueue> controler_to_worker_;
   DiscoStreamMessageQueue worker_to_controler_;
 };
 
@@ -78,7 +134,8 @@ class ProcessSessionObj final : public BcastSessionObj {
       write_fds.push_back(fds[1]);
     }
     for (int i = 0; i < num_workers - 1; ++i) {
-      workers_.emplace_back(std::make_unique<DiscoProcessChannel>(write_fds[i], read_fds[i]));
+      workers_.emplace_back(std::make_unique<DiscoProcessChannel>(write_fds[i], read_fds[i],
+                                                                  /*is_controller=*/true));
     }
   }
 
@@ -96,6 +153,7 @@ class ProcessSessionObj final : public BcastSessionObj {
   int64_t GetNumWorkers() { return workers_.size() + 1; }
 
   ffi::Any DebugGetFromRemote(int64_t reg_id, int worker_id) {
+    CheckNotRecordingBatch("DebugGetFromRemote");
     if (worker_id == 0) {
       this->SyncWorker(worker_id);
       return worker_0_->worker->register_file.at(reg_id);
@@ -116,6 +174,7 @@ class ProcessSessionObj final : public BcastSessionObj {
   }
 
   void DebugSetRegister(int64_t reg_id, ffi::AnyView value, int worker_id) {
+    CheckNotRecordingBatch("DebugSetRegister");
     if (worker_id == 0) {
       this->SyncWorker(worker_id);
       worker_0_->worker->SetRegister(reg_id, value);
@@ -189,7 +248,7 @@ void WorkerProcess(int worker_id, int num_workers, int num_group, int64_t read_f
                    int64_t write_fd) {
   TVM_FFI_ICHECK_EQ(num_workers % num_group, 0)
       << "The number of workers should be divisible by the number of worker group.";
-  DiscoProcessChannel channel(read_fd, write_fd);
+  DiscoProcessChannel channel(read_fd, write_fd, /*is_controller=*/false);
   DiscoWorker worker(worker_id, num_workers, num_group, nullptr, &channel);
   worker.MainLoop();
 }
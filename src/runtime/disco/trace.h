@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file trace.h
+ * \brief Per-worker timeline recording for disco sessions.
+ */
+#ifndef TVM_RUNTIME_DISCO_TRACE_H_
+#define TVM_RUNTIME_DISCO_TRACE_H_
+
+#include <tvm/ffi/extra/json.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/string.h>
+#include <tvm/runtime/disco/builtin.h>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Records the timeline of the commands executed by the current disco worker.
+ *
+ * Timestamps are wall-clock microseconds of the worker process, so the controller can align
+ * the timelines of different workers after estimating their clock offsets. While tracing is
+ * enabled, the device is synchronized around every traced region so that a duration covers
+ * the device work it launched, including the time spent waiting on peers in a collective.
+ */
+class DiscoTracer {
+ public:
+  /*! \brief A single completed region on the worker timeline. */
+  struct Event {
+    std::string name;
+    std::string category;
+    int64_t start_us;
+    int64_t duration_us;
+  };
+
+  /*! \brief The tracer of the current worker thread. */
+  static DiscoTracer* ThreadLocal() {
+    static thread_local DiscoTracer inst;
+    return &inst;
+  }
+
+  /*! \brief The wall-clock time, in microseconds, used by all events. */
+  static int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
+
+  bool enabled() const { return enabled_; }
+
+  /*! \brief Start recording, discarding the events of any previous trace. */
+  void Start() {
+    events_.clear();
+    enabled_ = true;
+  }
+
+  /*! \brief Stop recording and return the recorded events as a JSON array. */
+  ffi::String Stop() {
+    enabled_ = false;
+    namespace json = ffi::json;
+    json::Array events;
+    for (const Event& e : events_) {
+      json::Object obj;
+      obj.Set(ffi::String("name"), ffi::String(e.name));
+      obj.Set(ffi::String("cat"), ffi::String(e.category));
+      obj.Set(ffi::String("ts"), e.start_us);
+      obj.Set(ffi::String("dur"), e.duration_us);
+      events.push_back(std::move(obj));
+    }
+    events_.clear();
+    return json::Stringify(events);
+  }
+
+  /*!
+   * \brief Run `f` as a traced region. When tracing is disabled `f` is called directly.
+   * Regions may nest, e.g. the collectives issued by a traced VM function.
+   * \param name The name of the region.
+   * \param category The category of the region, e.g. "call" or "ccl".
+   * \param f The callable to run.
+   */
+  template <typename FCall>
+  void Trace(const std::string& name, const char* category, FCall f) {
+    if (!enabled_) {
+      f();
+      return;
+    }
+    SyncWorker();
+    int64_t start = NowUs();
+    f();
+    SyncWorker();
+    events_.push_back(Event{name, category, start, NowUs() - start});
+  }
+
+  /*! \brief Remember the name of the global function held by a register. */
+  void SetFuncName(int64_t reg_id, std::string name) {
+    if (name == "ffi.ModuleGetFunction") {
+      module_get_function_reg_ = reg_id;
+    }
+    func_names_[reg_id] = std::move(name);
+  }
+
+  /*! \brief Forget the function name of a register that was freed. */
+  void ClearFuncName(int64_t reg_id) {
+    if (!func_names_.empty()) {
+      func_names_.erase(reg_id);
+    }
+    if (reg_id == module_get_function_reg_) {
+      module_get_function_reg_ = -1;
+    }
+  }
+
+  /*!
+   * \brief Observe a call before it runs, so that functions looked up from a module are named
+   * after the module function rather than after the register holding them.
+   */
+  void OnCall(int64_t ret_reg_id, int64_t func_reg_id, const ffi::PackedArgs& args) {
+    if (func_reg_id != module_get_function_reg_ || args.size() < 2) return;
+    if (auto opt_str = args[1].as<ffi::String>()) {
+      func_names_[ret_reg_id] = *opt_str;
+    }
+  }
+
+  /*! \brief The name of the function held by a register, used to name call events. */
+  std::string GetFuncName(int64_t reg_id) const {
+    auto it = func_names_.find(reg_id);
+    return it == func_names_.end() ? "reg" + std::to_string(reg_id) : it->second;
+  }
+
+ private:
+  bool enabled_ = false;
+  std::vector<Event> events_;
+  int64_t module_get_function_reg_ = -1;
+  std::unordered_map<int64_t, std::string> func_names_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_DISCO_TRACE_H_
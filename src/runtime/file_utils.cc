@@ -28,6 +28,14 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/io.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <fstream>
 #include <utility>
 #include <vector>
@@ -158,6 +166,52 @@ void LoadBinaryFromFile(const std::string& file_name, std::string* data) {
   fs.read(&(*data)[0], size);
 }
 
+MappedFile::MappedFile(const std::string& file_name) {
+#ifndef _WIN32
+  int fd = open(file_name.c_str(), O_RDONLY);
+  TVM_FFI_ICHECK_GE(fd, 0) << "Cannot open " << file_name;
+  struct stat st;
+  TVM_FFI_ICHECK_EQ(fstat(fd, &st), 0) << "Cannot stat " << file_name;
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ != 0) {
+    void* ptr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr != MAP_FAILED) {
+      data_ = static_cast<const char*>(ptr);
+      mapped_ = true;
+    }
+  }
+  close(fd);
+  if (mapped_ || size_ == 0) {
+    return;
+  }
+#endif
+  LoadBinaryFromFile(file_name, &buffer_);
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+}
+
+void MappedFile::Prefetch(size_t offset, size_t nbytes) const {
+#ifndef _WIN32
+  if (!mapped_ || offset >= size_) {
+    return;
+  }
+  nbytes = std::min(nbytes, size_ - offset);
+  // madvise requires a page-aligned address.
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t aligned_offset = offset / page_size * page_size;
+  madvise(const_cast<char*>(data_) + aligned_offset, nbytes + (offset - aligned_offset),
+          MADV_WILLNEED);
+#endif
+}
+
 void SaveBinaryToFile(const std::string& file_name, const std::string& data) {
   std::ofstream fs(file_name, std::ios::out | std::ios::binary);
   TVM_FFI_ICHECK(!fs.fail()) << "Cannot open " << file_name;
@@ -66,6 +66,44 @@ std::string GetFileBasename(const std::string& file_name);
  */
 void LoadBinaryFromFile(const std::string& file_name, std::string* data);
 
+/*!
+ * \brief A read-only view of a binary file mapped into memory, so that only the pages
+ * being accessed are read from disk. On platforms without mmap, the whole file is read
+ * into an in-memory buffer instead.
+ */
+class MappedFile {
+ public:
+  /*!
+   * \brief Map a binary file into memory.
+   * \param file_name The name of the file.
+   */
+  explicit MappedFile(const std::string& file_name);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /*! \return The pointer to the beginning of the file content. */
+  const char* data() const { return data_; }
+  /*! \return The size of the file in bytes. */
+  size_t size() const { return size_; }
+  /*!
+   * \brief Hint the OS to asynchronously read ahead the given byte range. No-op if unsupported.
+   * \param offset The byte offset of the range.
+   * \param nbytes The number of bytes of the range.
+   */
+  void Prefetch(size_t offset, size_t nbytes) const;
+
+ private:
+  /*! \brief The beginning of the mapped file content. */
+  const char* data_ = nullptr;
+  /*! \brief The size of the file in bytes. */
+  size_t size_ = 0;
+  /*! \brief Whether `data_` is mapped, or points into `buffer_`. */
+  bool mapped_ = false;
+  /*! \brief The in-memory buffer used when mmap is not available. */
+  std::string buffer_;
+};
+
 /*!
  * \brief Load binary file into a in-memory buffer.
  * \param file_name The name of the file.
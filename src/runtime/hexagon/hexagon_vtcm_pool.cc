@@ -75,7 +75,8 @@ void* HexagonVtcmPool::Allocate(size_t nbytes) {
     auto last_free_entry = free_.end();
     last_free_entry--;
     TVM_FFI_ICHECK(last_free_entry->second >= nbytes)
-        << "Not enough contiguous VTCM space at the end to allocate";
+        << "Not enough contiguous VTCM space at the end to allocate " << nbytes << " bytes, "
+        << last_free_entry->second << " bytes are free at the end";
     char* ptr = last_free_entry->first + (last_free_entry->second - nbytes);
     allocations_.emplace_back(std::pair<char*, size_t>(ptr, nbytes));
     last_free_entry->second -= nbytes;
@@ -97,7 +98,7 @@ void* HexagonVtcmPool::Allocate(size_t nbytes) {
     }
   }
   TVM_FFI_ICHECK(entry_to_allocate->second >= nbytes)
-      << "Not enough contiguous VTCM space to allocate";
+      << "Not enough contiguous VTCM space to allocate " << nbytes << " bytes";
   char* ptr = entry_to_allocate->first;
   allocations_.emplace(allocations_.end(), std::pair<char*, size_t>(ptr, nbytes));
 
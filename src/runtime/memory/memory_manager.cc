@@ -21,24 +21,120 @@
  * \file tvm/runtime/memory/memory_manager.cc
  * \brief Allocate and manage memory for the runtime.
  */
+#include <tvm/ffi/container/map.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/memory/memory_manager.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <utility>
 
+#include "../../support/env.h"
+#include "../../support/str_escape.h"
 #include "naive_allocator.h"
 #include "pooled_allocator.h"
+#include "pooled_best_fit_allocator.h"
 
 namespace tvm {
 namespace runtime {
 namespace memory {
 
+/*! \brief Bookkeeping of the live buffers handed out to users. */
+struct AllocationTracker {
+  struct Record {
+    Device device;
+    size_t size;
+    std::string tag;
+  };
+  struct CallSite {
+    size_t live_bytes{0};
+    size_t live_count{0};
+    size_t total_count{0};
+  };
+  struct DeviceUsage {
+    size_t in_use{0};
+    size_t peak_in_use{0};
+    std::map<std::string, CallSite> call_sites;
+  };
+
+  std::mutex mu;
+  std::atomic<bool> enabled{false};
+  /*! \brief Number of tracked live buffers, lets TrackFree skip the lock when zero. */
+  std::atomic<size_t> num_live{0};
+  std::unordered_map<const void*, Record> live;
+  std::unordered_map<Device, DeviceUsage> usage;
+
+  static AllocationTracker* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    static auto* inst = new AllocationTracker();
+    return inst;
+  }
+};
+
+thread_local std::string current_allocation_tag;
+
+AllocationTagScope::AllocationTagScope(std::string tag) : prev_(std::move(current_allocation_tag)) {
+  current_allocation_tag = std::move(tag);
+}
+
+AllocationTagScope::~AllocationTagScope() { current_allocation_tag = std::move(prev_); }
+
+const std::string& AllocationTagScope::Current() { return current_allocation_tag; }
+
+void MemoryManager::SetAllocationTracking(bool enable) {
+  AllocationTracker::Global()->enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool MemoryManager::AllocationTrackingEnabled() {
+  return AllocationTracker::Global()->enabled.load(std::memory_order_relaxed);
+}
+
+void MemoryManager::TrackAlloc(const Buffer& buffer) {
+  AllocationTracker* tracker = AllocationTracker::Global();
+  if (!tracker->enabled.load(std::memory_order_relaxed) || buffer.data == nullptr) return;
+  std::string tag = AllocationTagScope::Current();
+  if (tag.empty()) tag = "<unknown>";
+  std::lock_guard<std::mutex> lock(tracker->mu);
+  if (!tracker->live.emplace(buffer.data, AllocationTracker::Record{buffer.device, buffer.size, tag})
+           .second) {
+    return;
+  }
+  tracker->num_live.fetch_add(1, std::memory_order_relaxed);
+  AllocationTracker::DeviceUsage& usage = tracker->usage[buffer.device];
+  usage.in_use += buffer.size;
+  usage.peak_in_use = std::max(usage.peak_in_use, usage.in_use);
+  AllocationTracker::CallSite& site = usage.call_sites[tag];
+  site.live_bytes += buffer.size;
+  site.live_count += 1;
+  site.total_count += 1;
+}
+
+void MemoryManager::TrackFree(const Buffer& buffer) {
+  AllocationTracker* tracker = AllocationTracker::Global();
+  if (tracker->num_live.load(std::memory_order_relaxed) == 0) return;
+  std::lock_guard<std::mutex> lock(tracker->mu);
+  auto it = tracker->live.find(buffer.data);
+  if (it == tracker->live.end()) return;
+  AllocationTracker::DeviceUsage& usage = tracker->usage[it->second.device];
+  usage.in_use -= it->second.size;
+  AllocationTracker::CallSite& site = usage.call_sites[it->second.tag];
+  site.live_bytes -= it->second.size;
+  site.live_count -= 1;
+  tracker->live.erase(it);
+  tracker->num_live.fetch_sub(1, std::memory_order_relaxed);
+}
+
 Storage::Storage(Buffer buffer, Allocator* allocator) {
   auto n = ffi::make_object<StorageObj>();
   n->buffer = std::move(buffer);
   n->allocator = allocator;
+  if (allocator) {
+    MemoryManager::TrackAlloc(n->buffer);
+  }
   data_ = std::move(n);
 }
 
@@ -133,6 +229,9 @@ MemoryManager* MemoryManager::Global() {
 
 std::string DeviceTypeStr(DLDeviceType type) {
   switch (type) {
+    case kDLCUDA:
+      return "cuda";
+      break;
     case kDLOpenCL:
       return "opencl";
       break;
@@ -162,9 +261,20 @@ Allocator* GetDeviceSpecificAllocator(Device dev, AllocatorType type) {
       }
       case kPooled: {
         VLOG(1) << "New pooled allocator for " << dev;
-        allocator = new PooledAllocator();
+        allocator = new PooledAllocator(
+            PooledAllocator::kDefaultPageSize,
+            support::GetEnv("TVM_POOLED_ALLOCATOR_THREAD_CACHE", true));
         break;
       }
+      case kPooledBestFit: {
+        VLOG(1) << "New pooled best-fit allocator for " << dev;
+        allocator = new PooledBestFitAllocator();
+        break;
+      }
+      case kStreamOrdered: {
+        TVM_FFI_THROW(InternalError) << "Stream-ordered allocator is not available for " << dev
+                                     << ", it requires a CUDA device and TVM built with CUDA";
+      }
       default:
         TVM_FFI_THROW(InternalError) << "Unknown allocator type: " << type;
     }
@@ -204,6 +314,90 @@ Allocator* MemoryManager::GetAllocator(Device dev, AllocatorType type) {
   return it->second.at(type).get();
 }
 
+AllocatorStats MemoryManager::GetStats(Device dev, AllocatorType type) {
+  return MemoryManager::GetAllocator(dev, type)->GetStats();
+}
+
+std::string AllocatorTypeStr(AllocatorType type) {
+  switch (type) {
+    case kNaive:
+      return "naive";
+    case kPooled:
+      return "pooled";
+    case kPooledBestFit:
+      return "pooled_best_fit";
+    case kStreamOrdered:
+      return "stream_ordered";
+    default:
+      return "unknown";
+  }
+}
+
+std::string MemoryManager::MemoryReport() {
+  MemoryManager* m = MemoryManager::Global();
+  AllocationTracker* tracker = AllocationTracker::Global();
+  std::lock_guard<std::mutex> lock(m->mu_);
+  std::lock_guard<std::mutex> tracker_lock(tracker->mu);
+  // Report every device that has an allocator or tracked usage.
+  std::vector<Device> devices;
+  for (const auto& kv : m->allocators_) devices.push_back(kv.first);
+  for (const auto& kv : tracker->usage) {
+    if (!m->allocators_.count(kv.first)) devices.push_back(kv.first);
+  }
+
+  std::ostringstream os;
+  os << "{\"tracking\":" << (tracker->enabled.load() ? "true" : "false") << ",\"devices\":[";
+  for (size_t i = 0; i < devices.size(); ++i) {
+    const Device& dev = devices[i];
+    std::ostringstream dev_str;
+    dev_str << dev;
+    os << (i ? "," : "") << "{\"device\":\"" << dev_str.str() << "\",\"allocators\":[";
+    size_t reserved = 0;
+    size_t cached = 0;
+    auto alloc_it = m->allocators_.find(dev);
+    if (alloc_it != m->allocators_.end()) {
+      size_t j = 0;
+      for (const auto& [type, alloc] : alloc_it->second) {
+        AllocatorStats stats = alloc->GetStats();
+        size_t alloc_cached = 0;
+        std::ostringstream hist;
+        size_t k = 0;
+        for (const auto& [size, count] : alloc->CachedBlocks()) {
+          alloc_cached += size * count;
+          hist << (k++ ? "," : "") << "{\"size\":" << size << ",\"count\":" << count << "}";
+        }
+        reserved += alloc->UsedMemory();
+        cached += alloc_cached;
+        os << (j++ ? "," : "") << "{\"type\":\"" << AllocatorTypeStr(type) << "\""
+           << ",\"reserved_bytes\":" << alloc->UsedMemory()
+           << ",\"cached_bytes\":" << alloc_cached << ",\"cached_histogram\":[" << hist.str()
+           << "],\"thread_cache_hits\":" << stats.thread_cache_hits
+           << ",\"thread_cache_misses\":" << stats.thread_cache_misses
+           << ",\"pool_hits\":" << stats.pool_hits
+           << ",\"thread_cache_steals\":" << stats.thread_cache_steals
+           << ",\"device_allocs\":" << stats.device_allocs << "}";
+      }
+    }
+    os << "],\"reserved_bytes\":" << reserved << ",\"cached_bytes\":" << cached;
+    auto usage_it = tracker->usage.find(dev);
+    if (usage_it != tracker->usage.end()) {
+      const AllocationTracker::DeviceUsage& usage = usage_it->second;
+      os << ",\"in_use_bytes\":" << usage.in_use << ",\"peak_in_use_bytes\":" << usage.peak_in_use
+         << ",\"call_sites\":[";
+      size_t j = 0;
+      for (const auto& [tag, site] : usage.call_sites) {
+        os << (j++ ? "," : "") << "{\"name\":\"" << support::StrEscape(tag.data(), tag.size())
+           << "\",\"live_bytes\":" << site.live_bytes << ",\"live_count\":" << site.live_count
+           << ",\"total_count\":" << site.total_count << "}";
+      }
+      os << "]";
+    }
+    os << "}";
+  }
+  os << "]}";
+  return os.str();
+}
+
 void MemoryManager::Clear() {
   MemoryManager* m = MemoryManager::Global();
   std::lock_guard<std::mutex> lock(m->mu_);
@@ -222,8 +416,12 @@ Tensor Allocator::Empty(ffi::Shape shape, DLDataType dtype, DLDevice dev,
    public:
     explicit BufferAlloc(Buffer buffer) : buffer_(buffer) {}
 
-    void AllocData(DLTensor* tensor) { tensor->data = buffer_.data; }
+    void AllocData(DLTensor* tensor) {
+      tensor->data = buffer_.data;
+      MemoryManager::TrackAlloc(buffer_);
+    }
     void FreeData(DLTensor* tensor) {
+      MemoryManager::TrackFree(buffer_);
       MemoryManager::GetAllocator(buffer_.device, buffer_.alloc_type)->Free(buffer_);
     }
 
@@ -268,7 +466,28 @@ void Allocator::Clear() {
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("vm.builtin.memory_manager.clear", MemoryManager::Clear);
+  refl::GlobalDef()
+      .def("vm.builtin.memory_manager.clear", MemoryManager::Clear)
+      .def("vm.builtin.memory_manager.set_allocation_tracking",
+           MemoryManager::SetAllocationTracking)
+      .def("vm.builtin.memory_manager.report", MemoryManager::MemoryReport)
+      .def("vm.builtin.memory_manager.get_stats",
+           [](Device dev, int alloc_type) {
+             AllocatorStats stats = MemoryManager::GetStats(dev, AllocatorType(alloc_type));
+             return ffi::Map<ffi::String, int64_t>{
+                 {"thread_cache_hits", stats.thread_cache_hits},
+                 {"thread_cache_misses", stats.thread_cache_misses},
+                 {"pool_hits", stats.pool_hits},
+                 {"thread_cache_steals", stats.thread_cache_steals},
+                 {"device_allocs", stats.device_allocs}};
+           })
+      .def("vm.builtin.memory_manager.set_high_water_mark", [](Device dev, int64_t nbytes) {
+        auto* alloc = dynamic_cast<PooledBestFitAllocator*>(
+            MemoryManager::GetOrCreateAllocator(dev, kPooledBestFit));
+        TVM_FFI_ICHECK(alloc != nullptr)
+            << "The allocator of " << dev << " does not support a high-water mark";
+        alloc->SetHighWaterMark(static_cast<size_t>(nbytes));
+      });
 }
 
 }  // namespace memory
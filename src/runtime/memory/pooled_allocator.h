@@ -27,34 +27,77 @@
 #include <tvm/runtime/memory/memory_manager.h>
 
 #include <atomic>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace tvm {
 namespace runtime {
 namespace memory {
 
+/*!
+ * \brief A pooled allocator that reuses buffers of the same rounded size.
+ *
+ * When the thread cache is enabled, each calling thread keeps a small
+ * magazine of recently freed buffers per size in front of the shared pool,
+ * so that steady-state Alloc/Free pairs on one thread do not contend on the
+ * shared lock. Full magazines spill half of their content to the shared pool,
+ * and a shared-pool miss takes a cached buffer of the same size from other
+ * threads before going to the device.
+ */
 class PooledAllocator : public Allocator {
  public:
   static constexpr size_t kDefaultPageSize = 4096;
+  /*! \brief Maximum number of buffers of one size cached per thread. */
+  static constexpr size_t kMagazineSize = 16;
+  /*! \brief Maximum bytes cached per thread. */
+  static constexpr size_t kMaxThreadCacheBytes = 64 << 20;
 
-  explicit PooledAllocator(size_t page_size = kDefaultPageSize)
-      : Allocator(kPooled), page_size_(page_size), used_memory_(0) {}
+  explicit PooledAllocator(size_t page_size = kDefaultPageSize, bool enable_thread_cache = false)
+      : Allocator(kPooled),
+        page_size_(page_size),
+        used_memory_(0),
+        enable_thread_cache_(enable_thread_cache),
+        id_(NextAllocatorId()) {}
 
   ~PooledAllocator() { ReleaseAll(); }
 
   Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) override {
-    std::lock_guard<std::recursive_mutex> lock(mu_);
     size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
+    if (enable_thread_cache_) {
+      ThreadCache* cache = GetThreadCache();
+      std::lock_guard<std::mutex> cache_lock(cache->mu);
+      auto it = cache->bins.find(size);
+      if (it != cache->bins.end() && !it->second.empty()) {
+        Buffer ret = it->second.back();
+        it->second.pop_back();
+        cache->cached_bytes -= size;
+        thread_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return ret;
+      }
+      thread_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::recursive_mutex> lock(mu_);
     auto&& it = memory_pool_.find(size);
     if (it != memory_pool_.end() && !it->second.empty()) {
       auto&& pool = it->second;
       auto ret = pool.back();
       pool.pop_back();
+      pool_hits_.fetch_add(1, std::memory_order_relaxed);
       return ret;
     }
+    if (enable_thread_cache_) {
+      Buffer ret;
+      if (StealFromThreadCaches(size, &ret)) {
+        thread_cache_steals_.fetch_add(1, std::memory_order_relaxed);
+        return ret;
+      }
+    }
     Buffer buf;
     buf.device = dev;
     buf.size = size;
@@ -69,6 +112,7 @@ class PooledAllocator : public Allocator {
     }
 
     used_memory_.fetch_add(size, std::memory_order_relaxed);
+    device_allocs_.fetch_add(1, std::memory_order_relaxed);
     VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
     return buf;
   }
@@ -78,16 +122,58 @@ class PooledAllocator : public Allocator {
     if (AllowMemoryScope(mem_scope)) {
       return Allocator::Alloc(dev, shape, type_hint, mem_scope);
     }
-    TVM_FFI_THROW(InternalError) << "This alloc should be implemented";
-    return {};
+    // The memory of the other scopes, e.g. the VTCM of Hexagon, is scarce, and is not pooled
+    // but given back to the device once freed.
+    size_t nbytes = 1;
+    for (int i = 0; i < static_cast<int>(shape.size()); ++i) {
+      nbytes *= static_cast<size_t>(shape[i]);
+    }
+    nbytes *= (type_hint.bits * type_hint.lanes + 7) / 8;
+    Buffer buf;
+    buf.device = dev;
+    buf.size = nbytes;
+    buf.alloc_type = kPooled;
+    buf.data = DeviceAPI::Get(dev)->AllocDataSpace(dev, shape.size(), shape.data(), type_hint,
+                                                   ffi::String(mem_scope));
+    {
+      std::lock_guard<std::recursive_mutex> lock(mu_);
+      scoped_buffers_.insert(buf.data);
+      num_scoped_buffers_.store(scoped_buffers_.size(), std::memory_order_relaxed);
+    }
+    used_memory_.fetch_add(nbytes, std::memory_order_relaxed);
+    device_allocs_.fetch_add(1, std::memory_order_relaxed);
+    VLOG(1) << "allocate " << nbytes << " B of scope " << mem_scope << ", used memory "
+            << used_memory_ << " B";
+    return buf;
   }
 
   void Free(const Buffer& buffer) override {
-    std::lock_guard<std::recursive_mutex> lock(mu_);
-    if (memory_pool_.find(buffer.size) == memory_pool_.end()) {
-      memory_pool_.emplace(buffer.size, std::vector<Buffer>{});
+    if (num_scoped_buffers_.load(std::memory_order_relaxed) > 0 && FreeScopedBuffer(buffer)) {
+      return;
     }
-    memory_pool_.at(buffer.size).push_back(buffer);
+    std::vector<Buffer> spill;
+    if (enable_thread_cache_) {
+      ThreadCache* cache = GetThreadCache();
+      std::lock_guard<std::mutex> cache_lock(cache->mu);
+      std::vector<Buffer>& bin = cache->bins[buffer.size];
+      if (bin.size() < kMagazineSize && cache->cached_bytes + buffer.size <= kMaxThreadCacheBytes) {
+        bin.push_back(buffer);
+        cache->cached_bytes += buffer.size;
+        return;
+      }
+      // Rebalance: move half of the full magazine to the shared pool.
+      size_t keep = bin.size() / 2;
+      for (size_t i = keep; i < bin.size(); ++i) {
+        cache->cached_bytes -= bin[i].size;
+        spill.push_back(bin[i]);
+      }
+      bin.resize(keep);
+    }
+    // NOTE: the thread cache lock is released before taking the shared lock.
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    std::vector<Buffer>& pool = memory_pool_[buffer.size];
+    pool.insert(pool.end(), spill.begin(), spill.end());
+    pool.push_back(buffer);
     VLOG(1) << "reclaim buffer " << buffer.size;
   }
 
@@ -95,7 +181,40 @@ class PooledAllocator : public Allocator {
 
   size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
 
+  AllocatorStats GetStats() const override {
+    AllocatorStats stats;
+    stats.thread_cache_hits = thread_cache_hits_.load(std::memory_order_relaxed);
+    stats.thread_cache_misses = thread_cache_misses_.load(std::memory_order_relaxed);
+    stats.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+    stats.thread_cache_steals = thread_cache_steals_.load(std::memory_order_relaxed);
+    stats.device_allocs = device_allocs_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  std::vector<std::pair<size_t, size_t>> CachedBlocks() const override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    std::map<size_t, size_t> hist;
+    for (const auto& [size, pool] : memory_pool_) {
+      if (!pool.empty()) hist[size] += pool.size();
+    }
+    for (const auto& cache : thread_caches_) {
+      std::lock_guard<std::mutex> cache_lock(cache->mu);
+      for (const auto& [size, bin] : cache->bins) {
+        if (!bin.empty()) hist[size] += bin.size();
+      }
+    }
+    return std::vector<std::pair<size_t, size_t>>(hist.begin(), hist.end());
+  }
+
  protected:
+  /*! \brief Per-thread magazines of freed buffers, keyed by size. */
+  struct ThreadCache {
+    /*! \brief Only contended when another thread steals or releases the cache. */
+    std::mutex mu;
+    std::unordered_map<size_t, std::vector<Buffer>> bins;
+    size_t cached_bytes{0};
+  };
+
   virtual void* DeviceAllocDataSpace(Device dev, size_t nbytes, size_t alignment,
                                      DLDataType type_hint) {
     return DeviceAPI::Get(dev)->AllocDataSpace(dev, nbytes, alignment, type_hint);
@@ -105,8 +224,32 @@ class PooledAllocator : public Allocator {
     DeviceAPI::Get(dev)->FreeDataSpace(dev, ptr);
   }
 
+  /*! \brief Give a buffer of a memory scope back to the device, if the buffer is one. */
+  bool FreeScopedBuffer(const Buffer& buffer) {
+    {
+      std::lock_guard<std::recursive_mutex> lock(mu_);
+      if (scoped_buffers_.erase(buffer.data) == 0) return false;
+      num_scoped_buffers_.store(scoped_buffers_.size(), std::memory_order_relaxed);
+    }
+    DeviceAPI::Get(buffer.device)->FreeDataSpace(buffer.device, buffer.data);
+    used_memory_.fetch_sub(buffer.size, std::memory_order_relaxed);
+    VLOG(1) << "free " << buffer.size << " B of a memory scope, used memory " << used_memory_
+            << " B";
+    return true;
+  }
+
   virtual void ReleaseAll() {
     std::lock_guard<std::recursive_mutex> lock(mu_);
+    for (const auto& cache : thread_caches_) {
+      std::lock_guard<std::mutex> cache_lock(cache->mu);
+      for (auto const& it : cache->bins) {
+        for (auto const& buf : it.second) {
+          DeviceFreeDataSpace(buf.device, buf.data);
+        }
+      }
+      cache->bins.clear();
+      cache->cached_bytes = 0;
+    }
     for (auto const& it : memory_pool_) {
       auto const& pool = it.second;
       for (auto const& buf : pool) {
@@ -118,11 +261,85 @@ class PooledAllocator : public Allocator {
     VLOG(1) << "release all buffers";
   }
 
+  /*!
+   * \brief Get the cache of the calling thread, creating and registering it on first use.
+   * \note Caches are keyed by a process-unique allocator id rather than by address,
+   *       so a new allocator at a recycled address never sees a stale cache.
+   */
+  ThreadCache* GetThreadCache() {
+    static thread_local std::unordered_map<uint64_t, std::shared_ptr<ThreadCache>> caches;
+    auto it = caches.find(id_);
+    if (it != caches.end()) return it->second.get();
+    auto cache = std::make_shared<ThreadCache>();
+    {
+      std::lock_guard<std::recursive_mutex> lock(mu_);
+      thread_caches_.push_back(cache);
+    }
+    caches.emplace(id_, cache);
+    return cache.get();
+  }
+
+  /*!
+   * \brief Take a cached buffer of the given size from the thread caches.
+   * \note Caches of exited threads are drained into the shared pool along the way.
+   *       Must be called with mu_ held.
+   */
+  bool StealFromThreadCaches(size_t size, Buffer* ret) {
+    bool found = false;
+    for (auto it = thread_caches_.begin(); it != thread_caches_.end();) {
+      // Hold a local reference so that erasing from the registry keeps the cache alive.
+      std::shared_ptr<ThreadCache> cache = *it;
+      std::lock_guard<std::mutex> cache_lock(cache->mu);
+      if (!found) {
+        auto bin = cache->bins.find(size);
+        if (bin != cache->bins.end() && !bin->second.empty()) {
+          *ret = bin->second.back();
+          bin->second.pop_back();
+          cache->cached_bytes -= size;
+          found = true;
+        }
+      }
+      if (cache.use_count() == 2) {
+        // The owning thread has exited, only the registry and the local copy remain.
+        for (auto& [bin_size, bin] : cache->bins) {
+          std::vector<Buffer>& pool = memory_pool_[bin_size];
+          pool.insert(pool.end(), bin.begin(), bin.end());
+        }
+        cache->bins.clear();
+        cache->cached_bytes = 0;
+        it = thread_caches_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return found;
+  }
+
+  static uint64_t NextAllocatorId() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
  protected:
   size_t page_size_;
   std::atomic<size_t> used_memory_;
   std::unordered_map<size_t, std::vector<Buffer>> memory_pool_;
-  std::recursive_mutex mu_;
+  mutable std::recursive_mutex mu_;
+  /*! \brief Whether to keep per-thread caches in front of the shared pool. */
+  bool enable_thread_cache_;
+  /*! \brief The process-unique id of the allocator. */
+  uint64_t id_;
+  /*! \brief All thread caches of this allocator. */
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches_;
+  /*! \brief The live buffers of memory scopes, which bypass the pool. */
+  std::unordered_set<void*> scoped_buffers_;
+  /*! \brief The size of scoped_buffers_, lets Free skip the lock when zero. */
+  std::atomic<size_t> num_scoped_buffers_{0};
+  std::atomic<int64_t> thread_cache_hits_{0};
+  std::atomic<int64_t> thread_cache_misses_{0};
+  std::atomic<int64_t> pool_hits_{0};
+  std::atomic<int64_t> thread_cache_steals_{0};
+  std::atomic<int64_t> device_allocs_{0};
 };
 
 }  // namespace memory
@@ -0,0 +1,334 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/memory/pooled_best_fit_allocator.h
+ * \brief A pooled allocator with size-class bins and best-fit reuse of large blocks.
+ *
+ * Small requests are rounded up to a power-of-two size class and served from
+ * per-class free lists. Large requests are served best-fit from the cached
+ * blocks; a larger block is split and the remainder stays in the pool, and
+ * freed blocks are coalesced with their free neighbours within the same
+ * device allocation. When the amount of memory held from the device exceeds
+ * the high-water mark, cached blocks are released back to the device.
+ */
+#ifndef TVM_RUNTIME_MEMORY_POOLED_BEST_FIT_ALLOCATOR_H_
+#define TVM_RUNTIME_MEMORY_POOLED_BEST_FIT_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/memory/memory_manager.h>
+
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../support/env.h"
+
+namespace tvm {
+namespace runtime {
+namespace memory {
+
+class PooledBestFitAllocator : public Allocator {
+ public:
+  static constexpr size_t kDefaultPageSize = 4096;
+  /*! \brief Requests of at least this size are served from the splittable large pool. */
+  static constexpr size_t kLargeBlockSize = 1 << 20;
+  /*! \brief A split only happens when the remainder is at least this large. */
+  static constexpr size_t kMinSplitRemainder = 1 << 16;
+
+  /*!
+   * \param page_size The allocation granularity.
+   * \param high_water_mark Maximum bytes held from the device before cached
+   *        blocks are released, 0 means unlimited. When not set, it is read
+   *        from the TVM_POOLED_ALLOCATOR_HIGH_WATER_MARK environment variable.
+   */
+  explicit PooledBestFitAllocator(size_t page_size = kDefaultPageSize,
+                                  size_t high_water_mark = 0)
+      : Allocator(kPooledBestFit),
+        page_size_(page_size),
+        high_water_mark_(high_water_mark != 0
+                             ? high_water_mark
+                             : support::GetEnv("TVM_POOLED_ALLOCATOR_HIGH_WATER_MARK", size_t(0))),
+        used_memory_(0) {}
+
+  ~PooledBestFitAllocator() { Trim(0); }
+
+  Buffer Alloc(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
+    if (size >= kLargeBlockSize && SupportsSplit(dev) && alignment <= page_size_) {
+      return AllocLarge(dev, size, alignment, type_hint);
+    }
+    return AllocSmall(dev, SizeClass(size), alignment, type_hint);
+  }
+
+  Buffer Alloc(Device dev, ffi::Shape shape, DLDataType type_hint,
+               const std::string& mem_scope) override {
+    if (AllowMemoryScope(mem_scope)) {
+      return Allocator::Alloc(dev, shape, type_hint, mem_scope);
+    }
+    TVM_FFI_THROW(InternalError) << "This alloc should be implemented";
+    return {};
+  }
+
+  void Free(const Buffer& buffer) override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    auto it = blocks_.find(static_cast<char*>(buffer.data));
+    if (it != blocks_.end()) {
+      FreeLarge(it);
+    } else {
+      small_pool_[buffer.size].push_back(buffer);
+    }
+    VLOG(1) << "reclaim buffer " << buffer.size;
+    if (high_water_mark_ != 0 && used_memory_.load(std::memory_order_relaxed) > high_water_mark_) {
+      Trim(high_water_mark_);
+    }
+  }
+
+  void Clear() override { Trim(0); }
+
+  size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
+
+  std::vector<std::pair<size_t, size_t>> CachedBlocks() const override {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    std::map<size_t, size_t> hist;
+    for (const auto& [size, pool] : small_pool_) {
+      if (!pool.empty()) hist[size] += pool.size();
+    }
+    for (const auto& [size, ptr] : free_blocks_) {
+      hist[size] += 1;
+    }
+    return std::vector<std::pair<size_t, size_t>>(hist.begin(), hist.end());
+  }
+
+  /*!
+   * \brief Set the high-water mark and trim the cached blocks if it is exceeded.
+   * \param high_water_mark Maximum bytes held from the device, 0 means unlimited.
+   */
+  void SetHighWaterMark(size_t high_water_mark) {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    high_water_mark_ = high_water_mark;
+    if (high_water_mark_ != 0) Trim(high_water_mark_);
+  }
+
+  /*!
+   * \brief Release cached (unused) blocks back to the device.
+   * \param target Stop releasing once the memory held from the device is at most target bytes.
+   * \note Blocks that are in use are never released.
+   */
+  void Trim(size_t target) {
+    std::lock_guard<std::recursive_mutex> lock(mu_);
+    for (auto& [size, pool] : small_pool_) {
+      while (!pool.empty() && used_memory_.load(std::memory_order_relaxed) > target) {
+        const Buffer& buf = pool.back();
+        DeviceFreeDataSpace(buf.device, buf.data);
+        used_memory_.fetch_sub(buf.size, std::memory_order_relaxed);
+        pool.pop_back();
+      }
+    }
+    for (auto it = segments_.begin();
+         it != segments_.end() && used_memory_.load(std::memory_order_relaxed) > target;) {
+      auto blk_it = blocks_.find(it->first);
+      TVM_FFI_ICHECK(blk_it != blocks_.end());
+      // A segment can be released once it has coalesced back into a single free block.
+      if (blk_it->second.is_free && blk_it->second.size == it->second.size) {
+        RemoveFromFreeIndex(blk_it->first, blk_it->second.size);
+        blocks_.erase(blk_it);
+        DeviceFreeDataSpace(it->second.device, it->first);
+        used_memory_.fetch_sub(it->second.size, std::memory_order_relaxed);
+        it = segments_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    VLOG(1) << "trim cached buffers, used memory " << used_memory_ << " B";
+  }
+
+ protected:
+  /*! \brief A device allocation that backs one or more large blocks. */
+  struct Segment {
+    Device device;
+    size_t size;
+  };
+
+  /*! \brief A contiguous range inside a segment. */
+  struct Block {
+    size_t size;
+    /*! \brief The base address of the owning segment. */
+    char* segment;
+    bool is_free;
+  };
+
+  virtual void* DeviceAllocDataSpace(Device dev, size_t nbytes, size_t alignment,
+                                     DLDataType type_hint) {
+    return DeviceAPI::Get(dev)->AllocDataSpace(dev, nbytes, alignment, type_hint);
+  }
+
+  virtual void DeviceFreeDataSpace(Device dev, void* ptr) {
+    DeviceAPI::Get(dev)->FreeDataSpace(dev, ptr);
+  }
+
+  /*!
+   * \brief Whether device pointers can be offset to address a sub-range of an allocation.
+   * \note Backends that hand out opaque buffer handles cannot be split.
+   */
+  static bool SupportsSplit(Device dev) {
+    switch (static_cast<int>(dev.device_type)) {
+      case kDLCPU:
+      case kDLCUDA:
+      case kDLCUDAHost:
+      case kDLCUDAManaged:
+      case kDLROCM:
+      case kDLROCMHost:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /*! \brief Round a page-aligned size up to its power-of-two size class. */
+  size_t SizeClass(size_t size) const {
+    size_t cls = page_size_;
+    while (cls < size) cls <<= 1;
+    return cls;
+  }
+
+  /*! \brief Allocate from the device, releasing cached blocks and retrying once on failure. */
+  void* AllocWithRetry(Device dev, size_t size, size_t alignment, DLDataType type_hint) {
+    if (high_water_mark_ != 0 && used_memory_.load(std::memory_order_relaxed) + size >
+                                     high_water_mark_) {
+      Trim(high_water_mark_ > size ? high_water_mark_ - size : 0);
+    }
+    try {
+      return DeviceAllocDataSpace(dev, size, alignment, type_hint);
+    } catch (InternalError& err) {
+      LOG(WARNING) << "PooledBestFitAllocator got InternalError during allocation: " << err.what();
+      LOG(WARNING) << "Trying to release all cached memory and reallocate...";
+      Trim(0);
+      return DeviceAllocDataSpace(dev, size, alignment, type_hint);
+    }
+  }
+
+  Buffer AllocSmall(Device dev, size_t size, size_t alignment, DLDataType type_hint) {
+    auto it = small_pool_.find(size);
+    if (it != small_pool_.end() && !it->second.empty()) {
+      Buffer ret = it->second.back();
+      it->second.pop_back();
+      return ret;
+    }
+    Buffer buf;
+    buf.device = dev;
+    buf.size = size;
+    buf.alloc_type = kPooledBestFit;
+    buf.data = AllocWithRetry(dev, size, alignment, type_hint);
+    used_memory_.fetch_add(size, std::memory_order_relaxed);
+    VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
+    return buf;
+  }
+
+  Buffer AllocLarge(Device dev, size_t size, size_t alignment, DLDataType type_hint) {
+    char* ptr = nullptr;
+    auto free_it = free_blocks_.lower_bound(size);
+    if (free_it != free_blocks_.end()) {
+      // best fit: the smallest cached block that can hold the request.
+      ptr = free_it->second;
+      free_blocks_.erase(free_it);
+      Block& blk = blocks_.at(ptr);
+      blk.is_free = false;
+      if (blk.size - size >= kMinSplitRemainder) {
+        Block rest{blk.size - size, blk.segment, true};
+        blk.size = size;
+        blocks_.emplace(ptr + size, rest);
+        free_blocks_.emplace(rest.size, ptr + size);
+      }
+    } else {
+      ptr = static_cast<char*>(AllocWithRetry(dev, size, alignment, type_hint));
+      segments_.emplace(ptr, Segment{dev, size});
+      blocks_.emplace(ptr, Block{size, ptr, false});
+      used_memory_.fetch_add(size, std::memory_order_relaxed);
+      VLOG(1) << "allocate " << size << " B, used memory " << used_memory_ << " B";
+    }
+    Buffer buf;
+    buf.device = dev;
+    buf.size = blocks_.at(ptr).size;
+    buf.alloc_type = kPooledBestFit;
+    buf.data = ptr;
+    return buf;
+  }
+
+  void FreeLarge(std::map<char*, Block>::iterator it) {
+    it->second.is_free = true;
+    // coalesce with the following block.
+    auto next = std::next(it);
+    if (next != blocks_.end() && next->second.is_free &&
+        next->second.segment == it->second.segment &&
+        it->first + it->second.size == next->first) {
+      RemoveFromFreeIndex(next->first, next->second.size);
+      it->second.size += next->second.size;
+      blocks_.erase(next);
+    }
+    // coalesce with the preceding block.
+    if (it != blocks_.begin()) {
+      auto prev = std::prev(it);
+      if (prev->second.is_free && prev->second.segment == it->second.segment &&
+          prev->first + prev->second.size == it->first) {
+        RemoveFromFreeIndex(prev->first, prev->second.size);
+        prev->second.size += it->second.size;
+        blocks_.erase(it);
+        it = prev;
+      }
+    }
+    free_blocks_.emplace(it->second.size, it->first);
+  }
+
+  void RemoveFromFreeIndex(char* ptr, size_t size) {
+    auto range = free_blocks_.equal_range(size);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == ptr) {
+        free_blocks_.erase(it);
+        return;
+      }
+    }
+  }
+
+ protected:
+  size_t page_size_;
+  size_t high_water_mark_;
+  std::atomic<size_t> used_memory_;
+  /*! \brief Free lists of the power-of-two size classes. */
+  std::unordered_map<size_t, std::vector<Buffer>> small_pool_;
+  /*! \brief Device allocations backing the large blocks, keyed by base address. */
+  std::unordered_map<char*, Segment> segments_;
+  /*! \brief All large blocks keyed by address, used to find neighbours when coalescing. */
+  std::map<char*, Block> blocks_;
+  /*! \brief Free large blocks ordered by size for best-fit lookup. */
+  std::multimap<size_t, char*> free_blocks_;
+  mutable std::recursive_mutex mu_;
+};
+
+}  // namespace memory
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_MEMORY_POOLED_BEST_FIT_ALLOCATOR_H_
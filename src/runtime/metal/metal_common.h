@@ -28,6 +28,8 @@
 #import <Metal/MTLBuffer.h>
 #import <Metal/MTLCommandBuffer.h>
 #import <Metal/MTLCommandQueue.h>
+#import <Metal/MTLComputeCommandEncoder.h>
+#import <Metal/MTLComputePipeline.h>
 #import <Metal/MTLDevice.h>
 #import <Metal/MTLLibrary.h>
 #include <tvm/ffi/function.h>
@@ -37,6 +39,7 @@
 
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -104,12 +107,23 @@ class AutoReleasePoolWrapper {
 
 /*!
  * \brief Structure for error handling in queues
+ *
+ * The kernels are batched: their dispatches are encoded into a single compute encoder of a
+ * pending command buffer, which is committed once it holds kMaxNumDispatchesPerCommandBuffer
+ * dispatches, or before any other command buffer of the stream, so that the queue order is kept.
  */
 class Stream {
  public:
+  /*! \brief The maximum number of kernels encoded into a command buffer before it is committed. */
+  static constexpr const int kMaxNumDispatchesPerCommandBuffer = 64;
+
   explicit Stream(id<MTLDevice> device) { queue_ = [device newCommandQueue]; }
-  ~Stream() { [queue_ release]; }
+  ~Stream() {
+    FlushComputeEncoder();
+    [queue_ release];
+  }
   id<MTLCommandBuffer> GetCommandBuffer(std::string label = "", bool attach_error_callback = true) {
+    FlushComputeEncoder();
     id<MTLCommandBuffer> cb = [queue_ commandBuffer];
     if (!label.empty()) {
       cb.label = [NSString stringWithUTF8String:label.c_str()];
@@ -132,9 +146,87 @@ class Stream {
 
   const std::string& ErrorDescription() const { return error_description_; }
 
+  /*!
+   * \brief Get the compute encoder to encode the dispatch of a kernel into.
+   * \param func_name The name of the kernel, reported if the command buffer fails.
+   */
+  id<MTLComputeCommandEncoder> GetComputeEncoder(const std::string& func_name) {
+    if (pending_func_names_.size() >= kMaxNumDispatchesPerCommandBuffer) {
+      FlushComputeEncoder();
+    }
+    if (pending_cb_ == nil) {
+      pending_cb_ = [[queue_ commandBuffer] retain];
+      pending_cb_.label = @"TVMKernels";
+      pending_encoder_ = [[pending_cb_ computeCommandEncoder] retain];
+    }
+    pending_func_names_.push_back(func_name);
+    return pending_encoder_;
+  }
+
+  /*! \brief Set the pipeline state of the compute encoder, unless it is already set. */
+  void SetComputePipelineState(id<MTLComputePipelineState> state) {
+    if (bound_pipeline_state_ != state) {
+      [pending_encoder_ setComputePipelineState:state];
+      bound_pipeline_state_ = state;
+    }
+  }
+
+  /*!
+   * \brief Bind a buffer of the compute encoder, unless it is already bound.
+   *
+   * The bindings of an encoder are kept across its dispatches.  A buffer is not freed while it is
+   * bound, as freeing a buffer synchronizes the stream, which commits the encoder.
+   */
+  void SetBuffer(id<MTLBuffer> buffer, size_t index) {
+    if (index >= bound_buffers_.size()) {
+      bound_buffers_.resize(index + 1, nil);
+    }
+    if (bound_buffers_[index] != buffer) {
+      [pending_encoder_ setBuffer:buffer offset:0 atIndex:index];
+      bound_buffers_[index] = buffer;
+    }
+  }
+
+  /*! \brief End the compute encoder, and commit its command buffer. */
+  void FlushComputeEncoder() {
+    if (pending_cb_ == nil) return;
+    [pending_encoder_ endEncoding];
+    // attach error message with function names
+    std::vector<std::string> func_names = std::move(pending_func_names_);
+    [pending_cb_ addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+      if (buffer.status == MTLCommandBufferStatusError) {
+        TVM_FFI_ICHECK(buffer.error != nil);
+        std::ostringstream os;
+        os << "GPUError happens after running ";
+        for (size_t i = 0; i < func_names.size(); ++i) {
+          os << (i ? ", " : "") << func_names[i];
+        }
+        os << ": " << buffer.error.localizedDescription.UTF8String;
+        this->SetError(os.str());
+      }
+    }];
+    [pending_cb_ commit];
+    [pending_encoder_ release];
+    [pending_cb_ release];
+    pending_encoder_ = nil;
+    pending_cb_ = nil;
+    pending_func_names_.clear();
+    bound_pipeline_state_ = nil;
+    bound_buffers_.clear();
+  }
+
  private:
   // Queue
   id<MTLCommandQueue> queue_;
+  // The command buffer the kernels are encoded into, nil if none is pending
+  id<MTLCommandBuffer> pending_cb_{nil};
+  // The compute encoder of the pending command buffer
+  id<MTLComputeCommandEncoder> pending_encoder_{nil};
+  // The kernels encoded into the pending command buffer
+  std::vector<std::string> pending_func_names_;
+  // The pipeline state and the buffers bound to the compute encoder
+  id<MTLComputePipelineState> bound_pipeline_state_{nil};
+  std::vector<id<MTLBuffer>> bound_buffers_;
   // Check if error happened in one previous run
   bool error_happened_{false};
   // error description
@@ -168,6 +260,11 @@ class MetalWorkspace final : public DeviceAPI {
   TVMStreamHandle CreateStream(Device dev) final;
   void FreeStream(Device dev, TVMStreamHandle stream) final;
   void StreamSync(Device dev, TVMStreamHandle stream) final;
+  TVMEventHandle CreateEvent(Device dev) final;
+  void FreeEvent(Device dev, TVMEventHandle event) final;
+  void RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) final;
+  void StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) final;
+  void EventSync(Device dev, TVMEventHandle event) final;
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final;
   void FreeWorkspace(Device dev, void* data) final;
   void ReinitializeDefaultStreams();
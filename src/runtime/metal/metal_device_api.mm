@@ -312,6 +312,63 @@ void MetalWorkspace::StreamSync(Device dev, TVMStreamHandle stream) {
   };
 }
 
+/*!
+ * \brief The event of a Metal device, the value of a MTLEvent signaled by the command buffer
+ * committed when it is recorded.
+ */
+struct MetalEvent {
+  id<MTLEvent> event = nil;
+  uint64_t value = 0;
+  id<MTLCommandBuffer> signal_cb = nil;
+};
+
+TVMEventHandle MetalWorkspace::CreateEvent(Device dev) {
+  MetalEvent* evt = new MetalEvent();
+  evt->event = [GetDevice(dev) newEvent];
+  return static_cast<TVMEventHandle>(evt);
+}
+
+void MetalWorkspace::FreeEvent(Device dev, TVMEventHandle event) {
+  MetalEvent* evt = static_cast<MetalEvent*>(event);
+  if (evt->signal_cb != nil) [evt->signal_cb release];
+  [evt->event release];
+  delete evt;
+}
+
+void MetalWorkspace::RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) {
+  AUTORELEASEPOOL {
+    MetalEvent* evt = static_cast<MetalEvent*>(event);
+    Stream* s = CastStreamOrGetDefault(stream, dev.device_id);
+    id<MTLCommandBuffer> cb = s->GetCommandBuffer(/*label=*/"TVMRecordEvent");
+    [cb encodeSignalEvent:evt->event value:++evt->value];
+    [cb commit];
+    if (evt->signal_cb != nil) [evt->signal_cb release];
+    evt->signal_cb = [cb retain];
+  };
+}
+
+void MetalWorkspace::StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) {
+  AUTORELEASEPOOL {
+    MetalEvent* evt = static_cast<MetalEvent*>(event);
+    TVM_FFI_ICHECK(evt->signal_cb != nil) << "The event to wait for is not recorded";
+    Stream* s = CastStreamOrGetDefault(stream, dev.device_id);
+    id<MTLCommandBuffer> cb = s->GetCommandBuffer(/*label=*/"TVMStreamWaitEvent");
+    [cb encodeWaitForEvent:evt->event value:evt->value];
+    [cb commit];
+  };
+}
+
+void MetalWorkspace::EventSync(Device dev, TVMEventHandle event) {
+  AUTORELEASEPOOL {
+    MetalEvent* evt = static_cast<MetalEvent*>(event);
+    TVM_FFI_ICHECK(evt->signal_cb != nil) << "The event to wait for is not recorded";
+    [evt->signal_cb waitUntilCompleted];
+    if (evt->signal_cb.status == MTLCommandBufferStatusError) {
+      LOG(FATAL) << "GPUError: " << evt->signal_cb.error.localizedDescription.UTF8String;
+    }
+  };
+}
+
 void* MetalWorkspace::AllocWorkspace(Device dev, size_t size, DLDataType type_hint) {
   return MetalThreadEntry::ThreadLocal()->pool.AllocWorkspace(dev, size);
 }
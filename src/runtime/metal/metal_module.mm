@@ -29,7 +29,6 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <array>
 #include <mutex>
-#include <sstream>
 #include <string>
 #include "../../support/bytes_io.h"
 #include "../file_utils.h"
@@ -213,14 +212,13 @@ class MetalWrappedFunc {
       int blockSize = wl.block_dim(0) * wl.block_dim(1) * wl.block_dim(2);
       auto maxTotalThreadsPerThreadgroup = scache_[device_id].maxTotalThreadsPerThreadgroup;
       TVM_FFI_ICHECK_LE(blockSize, maxTotalThreadsPerThreadgroup);
-      // attach error message directly in this functio
-      id<MTLCommandBuffer> cb = stream->GetCommandBuffer(/*label=*/"TVMKernel:" + func_name_,
-                                                         /*attach_error_callback=*/false);
-      id<MTLComputeCommandEncoder> encoder = [cb computeCommandEncoder];
-      [encoder setComputePipelineState:scache_[device_id]];
+      // The dispatch is batched with the other kernels of the stream, and the stream only
+      // rebinds the pipeline state and the buffers that changed since the previous kernel.
+      id<MTLComputeCommandEncoder> encoder = stream->GetComputeEncoder(func_name_);
+      stream->SetComputePipelineState(scache_[device_id]);
       for (size_t i = 0; i < num_buffer_args_; ++i) {
         void* buf = args[static_cast<int>(i)].cast<void*>();
-        [encoder setBuffer:(id<MTLBuffer>)(buf) offset:0 atIndex:i];
+        stream->SetBuffer((id<MTLBuffer>)(buf), i);
       }
       if (num_pack_args_ != 0) {
         [encoder setBytes:pack_args
@@ -231,18 +229,6 @@ class MetalWrappedFunc {
       MTLSize dimGrid = MTLSizeMake(wl.grid_dim(0), wl.grid_dim(1), wl.grid_dim(2));
       MTLSize dimBlock = MTLSizeMake(wl.block_dim(0), wl.block_dim(1), wl.block_dim(2));
       [encoder dispatchThreadgroups:dimGrid threadsPerThreadgroup:dimBlock];
-      [encoder endEncoding];
-      // attach error message with function name
-      [cb addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
-        if (buffer.status == MTLCommandBufferStatusError) {
-          TVM_FFI_ICHECK(buffer.error != nil);
-          std::ostringstream os;
-          os << "GPUError happens after running " << func_name_ << ": "
-             << buffer.error.localizedDescription.UTF8String;
-          stream->SetError(os.str());
-        }
-      }];
-      [cb commit];
     };
   }
 
@@ -17,10 +17,14 @@
  * under the License.
  */
 
+#include <poll.h>
 #include <unistd.h>
 
 #include <cstdlib>
+#include <memory>
+#include <string>
 
+#include "../../../support/shm_ring_buffer.h"
 #include "minrpc_server.h"
 
 namespace tvm {
@@ -38,20 +42,63 @@ class PosixIOHandler {
 
   void MessageDone() {}
 
-  ssize_t PosixRead(void* data, size_t size) { return read(read_fd_, data, size); }
+  ssize_t PosixRead(void* data, size_t size) {
+    if (shm_read_ != nullptr) return static_cast<ssize_t>(shm_read_->Read(data, size));
+    return read(read_fd_, data, size);
+  }
 
-  ssize_t PosixWrite(const void* data, size_t size) { return write(write_fd_, data, size); }
+  ssize_t PosixWrite(const void* data, size_t size) {
+    if (shm_write_ != nullptr) return static_cast<ssize_t>(shm_write_->Write(data, size));
+    return write(write_fd_, data, size);
+  }
 
   void Exit(int code) { exit(code); }
 
   void Close() {
+    shm_read_.reset();
+    shm_write_.reset();
     if (read_fd_ != 0) close(read_fd_);
     if (write_fd_ != 0) close(write_fd_);
   }
 
+  /*!
+   * \brief Answer the shared-memory handshake of the pipe client.
+   *
+   *  On success, all the later traffic goes through the ring buffers, while the pipes are only
+   *  used to detect when the client exits.
+   * \param names The ring buffer names, formatted as "<client-to-server>:<server-to-client>".
+   */
+  void AcceptSharedMemory(const std::string& names) {
+    char accepted = 0;
+    size_t pos = names.find(':');
+    if (pos != std::string::npos) {
+      auto client_alive = [fd = read_fd_]() { return !IsPipeHungUp(fd); };
+      try {
+        shm_read_ = support::ShmRingBuffer::Open(names.substr(0, pos), client_alive);
+        shm_write_ = support::ShmRingBuffer::Open(names.substr(pos + 1), client_alive);
+        accepted = 1;
+      } catch (const ffi::Error&) {
+        shm_read_.reset();
+        shm_write_.reset();
+      }
+    }
+    if (write(write_fd_, &accepted, 1) != 1) exit(-1);
+  }
+
  private:
+  /*! \brief Check whether the write end of the pipe whose read end is `fd` has been closed. */
+  static bool IsPipeHungUp(int fd) {
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = 0;
+    pfd.revents = 0;
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+  }
+
   int read_fd_{0};
   int write_fd_{1};
+  std::unique_ptr<support::ShmRingBuffer> shm_read_;
+  std::unique_ptr<support::ShmRingBuffer> shm_write_;
 };
 
 /*! \brief Type for the posix version of min rpc server. */
@@ -64,6 +111,10 @@ int main(int argc, char* argv[]) {
   if (argc != 3) return -1;
   // pass the descriptor via arguments.
   tvm::runtime::PosixIOHandler handler(atoi(argv[1]), atoi(argv[2]));
+  // the pipe client proposes shared-memory ring buffers through the environment.
+  if (const char* shm_names = getenv("TVM_RPC_PIPE_SHM")) {
+    handler.AcceptSharedMemory(shm_names);
+  }
   tvm::runtime::PosixMinRPCServer server(&handler);
   bool is_running = true;
   while (is_running) {
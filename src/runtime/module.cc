@@ -82,6 +82,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   TVM_INIT_CONTEXT_FUNC(TVMBackendAllocWorkspace);
   TVM_INIT_CONTEXT_FUNC(TVMBackendFreeWorkspace);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelLaunch);
+  TVM_INIT_CONTEXT_FUNC(TVMBackendParallelLaunchChunked);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelBarrier);
 
   refl::GlobalDef().def("runtime.RuntimeEnabled", RuntimeEnabled);
@@ -362,6 +362,11 @@ class OpenCLWorkspace : public DeviceAPI {
   void SetPerfHint(Device dev, cl_uint perf_hint);
   void FreeDataSpace(Device dev, void* ptr) final;
   void StreamSync(Device dev, TVMStreamHandle stream) final;
+  TVMEventHandle CreateEvent(Device dev) final;
+  void FreeEvent(Device dev, TVMEventHandle event) final;
+  void RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) final;
+  void StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) final;
+  void EventSync(Device dev, TVMEventHandle event) final;
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final;
   void FreeWorkspace(Device dev, void* data) final;
   size_t GetDataSize(const DLTensor& arr,
@@ -401,6 +406,8 @@ class OpenCLThreadEntry {
     cl_kernel kernel{nullptr};
     // timestamp used to recognize stale kernel
     size_t version{0};
+    // The values of the scalar arguments set on the kernel, which it keeps across launches.
+    std::vector<uint64_t> scalar_args;
   };
   /*! \brief The current device */
   Device device;
@@ -531,6 +538,9 @@ class OpenCLModuleNode : public OpenCLModuleNodeBase {
                           const std::string& func_name, const KTRefEntry& e) override;
 
  private:
+  // create the kernel of a created program, and install it to thread local entry
+  cl_kernel CreateKernel(cl::OpenCLThreadEntry* t, const std::string& func_name,
+                         const KTRefEntry& e);
   // the binary data
   std::string data_;
   // The format
@@ -591,6 +591,45 @@ void OpenCLWorkspace::StreamSync(Device dev, TVMStreamHandle stream) {
   OPENCL_CALL(clFinish(this->GetQueue(dev)));
 }
 
+// An event is a marker of the queue of the device, null until it is recorded.
+TVMEventHandle OpenCLWorkspace::CreateEvent(Device dev) { return new cl_event(nullptr); }
+
+void OpenCLWorkspace::FreeEvent(Device dev, TVMEventHandle event) {
+  cl_event* evt = static_cast<cl_event*>(event);
+  if (*evt != nullptr) {
+    OPENCL_CALL(clReleaseEvent(*evt));
+  }
+  delete evt;
+}
+
+void OpenCLWorkspace::RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) {
+  this->Init();
+  TVM_FFI_ICHECK(stream == nullptr);
+  cl_event* evt = static_cast<cl_event*>(event);
+  if (*evt != nullptr) {
+    OPENCL_CALL(clReleaseEvent(*evt));
+    *evt = nullptr;
+  }
+  cl_command_queue queue = this->GetQueue(dev);
+  OPENCL_CALL(clEnqueueMarkerWithWaitList(queue, 0, nullptr, evt));
+  OPENCL_CALL(clFlush(queue));
+}
+
+void OpenCLWorkspace::StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) {
+  this->Init();
+  TVM_FFI_ICHECK(stream == nullptr);
+  cl_event* evt = static_cast<cl_event*>(event);
+  TVM_FFI_ICHECK(*evt != nullptr) << "The event to wait for is not recorded";
+  // The barrier also orders the queue after the markers of the queues of the other devices.
+  OPENCL_CALL(clEnqueueBarrierWithWaitList(this->GetQueue(dev), 1, evt, nullptr));
+}
+
+void OpenCLWorkspace::EventSync(Device dev, TVMEventHandle event) {
+  cl_event* evt = static_cast<cl_event*>(event);
+  TVM_FFI_ICHECK(*evt != nullptr) << "The event to wait for is not recorded";
+  OPENCL_CALL(clWaitForEvents(1, evt));
+}
+
 void* OpenCLWorkspace::AllocWorkspace(Device dev, size_t size, DLDataType type_hint) {
   this->Init();
   cl::BufferDescriptor* ret_buffer = nullptr;
@@ -26,16 +26,27 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/support/io.h>
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "../../support/bytes_io.h"
+#include "../../support/env.h"
 #include "../source_utils.h"
 #include "opencl_common.h"
 
 namespace tvm {
 namespace runtime {
 
+namespace cl {
+std::string GetDeviceInfo(cl_device_id pid, cl_device_info param_name);
+}  // namespace cl
+
 class OpenCLWrappedFunc {
  public:
   // initialize the OpenCL function.
@@ -59,20 +70,34 @@ class OpenCLWrappedFunc {
     if (entry_.kernel_id >= t->kernel_table.size()) {
       t->kernel_table.resize(entry_.kernel_id + 1);
     }
-    const auto& e = t->kernel_table[entry_.kernel_id];
+    auto& e = t->kernel_table[entry_.kernel_id];
     cl_kernel kernel = e.kernel;
     if (kernel == nullptr || e.version != entry_.version) {
       kernel = m_->InstallKernel(w_, t, func_name_, entry_);
     }
     ThreadWorkLoad wl = launch_param_config_.Extract(args);
     cl_uint work_dim = static_cast<cl_uint>(launch_param_config_.work_dim());
-    // setup arguments.
+    // setup arguments.  The kernel keeps its arguments across launches, so the scalar arguments
+    // that did not change since the last launch on this thread are not set again.  The buffers
+    // are always set, as a released buffer handle may be reused by a new buffer.
+    bool set_all_args = e.scalar_args.size() != arg_size_.size();
+    if (set_all_args) {
+      e.scalar_args.assign(arg_size_.size(), 0);
+    }
     for (cl_uint i = 0; i < arg_size_.size(); ++i) {
       void* arg = nullptr;
       if (args[i].as<void*>()) {
         arg = static_cast<cl::BufferDescriptor*>(void_args[i])->buffer;
       } else {
         arg = void_args[i];
+        if (arg_size_[i] <= sizeof(uint64_t)) {
+          uint64_t value = 0;
+          std::memcpy(&value, arg, arg_size_[i]);
+          if (!set_all_args && e.scalar_args[i] == value) {
+            continue;
+          }
+          e.scalar_args[i] = value;
+        }
       }
       OPENCL_CALL(clSetKernelArg(kernel, i, arg_size_[i], arg));
     }
@@ -212,6 +237,86 @@ void OpenCLModuleNode::Init() {
       << "The number of parsed kernel sources does not match the number of kernel functions";
 }
 
+namespace {
+
+/*! \brief The 64-bit FNV-1a hash, which unlike std::hash is stable across processes. */
+uint64_t StableHash(const std::string& data, uint64_t hash = 14695981039346656037ULL) {
+  for (unsigned char c : data) {
+    hash = (hash ^ c) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/*! \brief The file caching the binary of a program, keyed by the device, driver and source. */
+std::string ProgramCachePath(const std::string& cache_dir, cl_device_id dev,
+                             const std::string& source) {
+  uint64_t hash = StableHash(cl::GetDeviceInfo(dev, CL_DEVICE_NAME));
+  hash = StableHash(cl::GetDeviceInfo(dev, CL_DRIVER_VERSION), hash);
+  hash = StableHash(source, hash);
+  std::ostringstream os;
+  os << cache_dir << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << ".clbin";
+  return os.str();
+}
+
+/*!
+ * \brief Create and build a program from a cached binary.
+ * \return The program, or nullptr if there is no usable binary in the cache.
+ */
+cl_program LoadCachedProgram(cl_context context, cl_device_id dev, const std::string& path) {
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  if (!fs) {
+    return nullptr;
+  }
+  std::string binary((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+  if (binary.empty()) {
+    return nullptr;
+  }
+  const unsigned char* s = reinterpret_cast<const unsigned char*>(binary.data());
+  size_t len = binary.length();
+  cl_int binary_status = CL_SUCCESS;
+  cl_int err = CL_SUCCESS;
+  cl_program program = clCreateProgramWithBinary(context, 1, &dev, &len, &s, &binary_status, &err);
+  if (err != CL_SUCCESS || binary_status != CL_SUCCESS) {
+    if (program != nullptr) clReleaseProgram(program);
+    return nullptr;
+  }
+  if (clBuildProgram(program, 1, &dev, nullptr, nullptr, nullptr) != CL_SUCCESS) {
+    clReleaseProgram(program);
+    return nullptr;
+  }
+  return program;
+}
+
+/*! \brief Write the binary of a built program to the cache, atomically for concurrent readers. */
+void SaveCachedProgram(cl_program program, const std::string& path) {
+  size_t size = 0;
+  if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &size, nullptr) !=
+          CL_SUCCESS ||
+      size == 0) {
+    return;
+  }
+  std::vector<unsigned char> binary(size);
+  unsigned char* data = binary.data();
+  if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &data, nullptr) !=
+      CL_SUCCESS) {
+    return;
+  }
+  std::string tmp_path = path + ".tmp" + std::to_string(reinterpret_cast<uintptr_t>(program));
+  {
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+    if (!fs) {
+      LOG(WARNING) << "Cannot write the OpenCL program cache file " << tmp_path;
+      return;
+    }
+    fs.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+  }
+}
+
+}  // namespace
+
 bool OpenCLModuleNode::IsProgramCreated(const std::string& func_name, int device_id) {
   auto size = programs_[func_name].size();
   if (size > 0 && programs_[func_name][device_id] != nullptr) return true;
@@ -231,7 +336,20 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
   auto platform = w->device_info[did].platform_id;
   if (!IsProgramCreated(func_name, device_id)) {
     // create program
+    std::string cache_path;
     if (fmt_ == "cl") {
+      // The binaries of the programs built from source are cached in
+      // TVM_OPENCL_PROGRAM_CACHE_DIR, if set, as building them can take seconds on mobile GPUs.
+      std::string cache_dir = support::GetEnv("TVM_OPENCL_PROGRAM_CACHE_DIR", std::string());
+      if (!cache_dir.empty()) {
+        cache_path = ProgramCachePath(cache_dir, w->devices[device_id], parsed_kernels_[func_name]);
+        cl_program program =
+            LoadCachedProgram(w->contexts[platform], w->devices[device_id], cache_path);
+        if (program != nullptr) {
+          programs_[func_name][device_id] = program;
+          return CreateKernel(t, func_name, e);
+        }
+      }
       const char* s = parsed_kernels_[func_name].c_str();
       size_t len = parsed_kernels_[func_name].length();
       cl_int err;
@@ -265,13 +383,22 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
                                    << "\nError: " << cl::CLGetErrorString(err) << "\n"
                                    << log;
     }
+    if (!cache_path.empty()) {
+      SaveCachedProgram(programs_[func_name][device_id], cache_path);
+    }
   }
-  // build kernel
+  return CreateKernel(t, func_name, e);
+}
+
+cl_kernel OpenCLModuleNode::CreateKernel(cl::OpenCLThreadEntry* t, const std::string& func_name,
+                                         const KTRefEntry& e) {
+  int device_id = t->device.device_id;
   cl_int err;
   cl_kernel kernel = clCreateKernel(programs_[func_name][device_id], func_name.c_str(), &err);
   OPENCL_CHECK_ERROR(err);
   t->kernel_table[e.kernel_id].kernel = kernel;
   t->kernel_table[e.kernel_id].version = e.version;
+  t->kernel_table[e.kernel_id].scalar_args.clear();
   kernels_.push_back(kernel);
   return kernel;
 }
@@ -125,6 +125,7 @@ cl_kernel OpenCLSPIRVModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenC
   OPENCL_CHECK_ERROR(err);
   t->kernel_table[e.kernel_id].kernel = kernel;
   t->kernel_table[e.kernel_id].version = e.version;
+  t->kernel_table[e.kernel_id].scalar_args.clear();
   kernels_.push_back(kernel);
   return kernel;
 }
@@ -325,6 +325,10 @@ inline ffi::Function PackFuncVoidAddr(F f, const ffi::Array<DLDataType>& arg_typ
     return detail::PackFuncVoidAddr_<4>(f, codes);
   } else if (num_void_args <= 8) {
     return detail::PackFuncVoidAddr_<8>(f, codes);
+  } else if (num_void_args <= 16) {
+    // The fused kernels commonly take more than 8 arguments, which are kept on the stack too
+    // rather than allocated on the heap for every launch.
+    return detail::PackFuncVoidAddr_<16>(f, codes);
   } else {
     return detail::PackFuncVoidAddr_<0>(f, codes);
   }
@@ -687,10 +687,21 @@ Report Profiler::Report() {
         std::max(overall_time_us, row["Duration (us)"].as<DurationNode>()->microseconds);
   }
 
-  // Calculate percentages
+  // Calculate percentages, and the achieved throughput of the calls of the estimated costs
   for (auto& row : rows) {
-    row["Percent"] = ObjectRef(ffi::make_object<PercentNode>(
-        row["Duration (us)"].as<DurationNode>()->microseconds / overall_time_us * 100));
+    double us = row["Duration (us)"].as<DurationNode>()->microseconds;
+    row["Percent"] = ObjectRef(ffi::make_object<PercentNode>(us / overall_time_us * 100));
+    if (us <= 0) {
+      continue;
+    }
+    if (auto it = row.find("FLOPs"); it != row.end() && it->second.as<CountNode>()) {
+      double flops = it->second.as<CountNode>()->value;
+      row["GFLOP/s"] = ObjectRef(ffi::make_object<RatioNode>(flops / us / 1e3));
+    }
+    if (auto it = row.find("DRAM Bytes"); it != row.end() && it->second.as<CountNode>()) {
+      double nbytes = it->second.as<CountNode>()->value;
+      row["GB/s"] = ObjectRef(ffi::make_object<RatioNode>(nbytes / us / 1e3));
+    }
   }
 
   // convert to map
@@ -214,6 +214,34 @@ class ROCMDeviceAPI final : public DeviceAPI {
     ROCM_CALL(hipStreamSynchronize(static_cast<hipStream_t>(stream)));
   }
 
+  TVMEventHandle CreateEvent(Device dev) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    hipEvent_t evt;
+    ROCM_CALL(hipEventCreateWithFlags(&evt, hipEventDisableTiming));
+    return static_cast<TVMEventHandle>(evt);
+  }
+
+  void FreeEvent(Device dev, TVMEventHandle event) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    ROCM_CALL(hipEventDestroy(static_cast<hipEvent_t>(event)));
+  }
+
+  void RecordEvent(Device dev, TVMEventHandle event, TVMStreamHandle stream) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    ROCM_CALL(hipEventRecord(static_cast<hipEvent_t>(event), static_cast<hipStream_t>(stream)));
+  }
+
+  void StreamWaitEvent(Device dev, TVMStreamHandle stream, TVMEventHandle event) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    ROCM_CALL(
+        hipStreamWaitEvent(static_cast<hipStream_t>(stream), static_cast<hipEvent_t>(event), 0));
+  }
+
+  void EventSync(Device dev, TVMEventHandle event) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    ROCM_CALL(hipEventSynchronize(static_cast<hipEvent_t>(event)));
+  }
+
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final {
     return ROCMThreadEntry::ThreadLocal()->pool.AllocWorkspace(dev, size);
   }
@@ -31,6 +31,7 @@
 #include <array>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "../../support/bytes_io.h"
@@ -46,7 +47,7 @@ namespace runtime {
 // Module to support thread-safe multi-GPU execution.
 // hipModule_t is a per-GPU module
 // The runtime will contain a per-device module table
-// The modules will be lazily loaded
+// The modules will be lazily loaded, unless warmed up with runtime.rocm_module_warmup
 class ROCMModuleNode : public ffi::ModuleObj {
  public:
   explicit ROCMModuleNode(std::string data, std::string fmt,
@@ -102,14 +103,25 @@ class ROCMModuleNode : public ffi::ModuleObj {
     return "";
   }
 
-  // get a CUfunction from primary context in device_id
-  hipFunction_t GetFunc(int device_id, const std::string& func_name) {
-    std::lock_guard<std::mutex> lock(mutex_);
+  /*!
+   * \brief Load the code object of the module on a device.
+   * \note The caller holds the lock of the device.
+   */
+  void LoadModule(int device_id) {
     // must recheck under the lock scope
-
     if (module_[device_id] == nullptr) {
       ROCM_DRIVER_CALL(hipModuleLoadData(&(module_[device_id]), data_.c_str()));
     }
+  }
+  /*! \brief Load the module on a device ahead of its first launch. */
+  void Warmup(int device_id) {
+    std::lock_guard<std::mutex> lock(mutex_[device_id]);
+    LoadModule(device_id);
+  }
+  // get a CUfunction from primary context in device_id
+  hipFunction_t GetFunc(int device_id, const std::string& func_name) {
+    std::lock_guard<std::mutex> lock(mutex_[device_id]);
+    LoadModule(device_id);
     hipFunction_t func;
     hipError_t result = hipModuleGetFunction(&func, module_[device_id], func_name.c_str());
     if (result != hipSuccess) {
@@ -120,11 +132,8 @@ class ROCMModuleNode : public ffi::ModuleObj {
   }
   // get a global var from primary context in device_id
   hipDeviceptr_t GetGlobal(int device_id, const std::string& global_name, size_t expect_nbytes) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    // must recheck under the lock scope
-    if (module_[device_id] == nullptr) {
-      ROCM_DRIVER_CALL(hipModuleLoadData(&(module_[device_id]), data_.c_str()));
-    }
+    std::lock_guard<std::mutex> lock(mutex_[device_id]);
+    LoadModule(device_id);
     hipDeviceptr_t global = nullptr;
     size_t nbytes = 0;
 
@@ -146,8 +155,8 @@ class ROCMModuleNode : public ffi::ModuleObj {
   std::string assembly_;
   // the internal modules per GPU, to be lazily initialized.
   std::array<hipModule_t, kMaxNumGPUs> module_;
-  // internal mutex when updating the module
-  std::mutex mutex_;
+  // internal mutex per GPU when updating the module, so that the GPUs load it in parallel
+  std::array<std::mutex, kMaxNumGPUs> mutex_;
 };
 
 // a wrapped function class to get packed func.
@@ -236,9 +245,64 @@ ffi::Module ROCMModuleLoadFromBytes(const ffi::Bytes& bytes) {
   return ROCMModuleCreate(data, fmt, fmap, std::string(), std::string());
 }
 
+void CollectROCMModules(const ffi::Module& mod, std::vector<ROCMModuleNode*>* rocm_modules) {
+  if (std::string(mod->kind()) == "hip") {
+    rocm_modules->push_back(static_cast<ROCMModuleNode*>(mod.operator->()));
+  }
+  for (const Any& import : mod->imports()) {
+    CollectROCMModules(import.cast<ffi::Module>(), rocm_modules);
+  }
+}
+
+/*!
+ * \brief Load the ROCm modules of a module on the devices, one thread per device, so that the
+ *  code objects are loaded ahead of the first launch and not serialized across the devices.
+ * \param mod The module, whose imports are warmed up too.
+ * \param device_ids The devices, all the visible devices when empty.
+ */
+void ROCMModuleWarmup(ffi::Module mod, ffi::Array<int64_t> device_ids) {
+  std::vector<ROCMModuleNode*> rocm_modules;
+  CollectROCMModules(mod, &rocm_modules);
+  if (rocm_modules.empty()) return;
+  if (device_ids.empty()) {
+    int num_devices = 0;
+    ROCM_CALL(hipGetDeviceCount(&num_devices));
+    for (int i = 0; i < num_devices; ++i) {
+      device_ids.push_back(i);
+    }
+  }
+  std::vector<std::thread> threads;
+  std::vector<std::string> errors(device_ids.size());
+  for (size_t i = 0; i < device_ids.size(); ++i) {
+    int device_id = static_cast<int>(device_ids[i]);
+    TVM_FFI_ICHECK(device_id >= 0 && device_id < kMaxNumGPUs)
+        << "ValueError: Invalid ROCm device " << device_id;
+    threads.emplace_back([&rocm_modules, &errors, i, device_id]() {
+      try {
+        ROCM_CALL(hipSetDevice(device_id));
+        for (ROCMModuleNode* m : rocm_modules) {
+          m->Warmup(device_id);
+        }
+      } catch (const std::exception& e) {
+        errors[i] = e.what();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < errors.size(); ++i) {
+    if (!errors[i].empty()) {
+      TVM_FFI_THROW(ROCMError) << "Failed to load the ROCm modules on device " << device_ids[i]
+                               << ": " << errors[i];
+    }
+  }
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
+      .def("runtime.rocm_module_warmup", ROCMModuleWarmup)
       .def("ffi.Module.load_from_bytes.hsaco", ROCMModuleLoadFromBytes)
       .def("ffi.Module.load_from_bytes.hip", ROCMModuleLoadFromBytes)
       .def("ffi.Module.load_from_file.hsaco", ROCMModuleLoadFile)
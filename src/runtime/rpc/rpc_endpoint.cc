@@ -32,6 +32,7 @@
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <memory>
 #include <string>
 #include <utility>
@@ -111,6 +112,9 @@ class RPCEndpoint::EventHandler : public support::Stream {
                           RPCSession::FEncodeReturn setreturn) {
     std::swap(client_mode_, client_mode);
     std::swap(async_server_mode_, async_server_mode);
+    bool handling_event = true;
+    std::swap(handling_event_, handling_event);
+    served_async_ = served_async_ || async_server_mode_;
 
     RPCCode status = RPCCode::kNone;
 
@@ -152,6 +156,7 @@ class RPCEndpoint::EventHandler : public support::Stream {
       }
     }
 
+    std::swap(handling_event_, handling_event);
     std::swap(async_server_mode_, async_server_mode);
     std::swap(client_mode_, client_mode);
     return status;
@@ -340,6 +345,10 @@ class RPCEndpoint::EventHandler : public support::Stream {
   bool client_mode_{false};
   // Whether current handler is in the async server mode.
   bool async_server_mode_{false};
+  // Whether the handler is running HandleNextEvent.
+  bool handling_event_{false};
+  // Whether the handler has served requests in the async server mode.
+  bool served_async_{false};
   // Internal arena
   support::Arena arena_;
   // internal arena for temp objects
@@ -351,6 +360,8 @@ class RPCEndpoint::EventHandler : public support::Stream {
     if (state != kCopyAckReceived) {
       TVM_FFI_ICHECK_EQ(pending_request_bytes_, 0U) << "state=" << state;
     }
+    bool resume_async = served_async_ && !handling_event_ && state_ == kWaitForAsyncCallback &&
+                        state == kRecvPacketNumBytes;
     // need to actively flush the writer
     // so the data get pushed out.
     if (state_ == kWaitForAsyncCallback) {
@@ -363,6 +374,13 @@ class RPCEndpoint::EventHandler : public support::Stream {
       // recycle arena for the next session.
       this->RecycleAll();
     }
+    // The client may pipeline requests, e.g. the blocks of a large copy, which are buffered
+    // while an async callback is pending. When the callback completes outside of the io
+    // handler, no new bytes may arrive to trigger their processing, so handle them now.
+    if (resume_async && this->Ready()) {
+      this->HandleNextEvent(false, true, [](ffi::PackedArgs) {});
+      flush_writer_();
+    }
   }
 
   // handler for initial header read
@@ -771,6 +789,7 @@ void RPCEndpoint::Init() {
   // Quick function to for syscall remote.
   syscall_remote_ = ffi::Function([this](ffi::PackedArgs all_args, ffi::Any* rv) {
     std::lock_guard<std::mutex> lock(mutex_);
+    CompleteAllPipelined();
     RPCCode code = static_cast<RPCCode>(all_args[0].cast<int>());
     ffi::PackedArgs args = all_args.Slice(1);
 
@@ -815,6 +834,8 @@ std::shared_ptr<RPCEndpoint> RPCEndpoint::Create(std::unique_ptr<RPCChannel> cha
 RPCEndpoint::~RPCEndpoint() { this->Shutdown(); }
 
 void RPCEndpoint::Shutdown() {
+  // The replies of the pipelined requests are no longer received.
+  pending_.clear();
   if (channel_ != nullptr) {
     RPCCode code = RPCCode::kShutdown;
     uint64_t packet_nbytes = sizeof(code);
@@ -872,6 +893,7 @@ int RPCEndpoint::ServerAsyncIOEventHandler(const std::string& in_bytes, int even
 
 void RPCEndpoint::InitRemoteSession(ffi::PackedArgs args) {
   std::lock_guard<std::mutex> lock(mutex_);
+  CompleteAllPipelined();
   RPCCode code = RPCCode::kInitServer;
   std::string protocol_ver = kRPCProtocolVer;
   uint64_t length = protocol_ver.length();
@@ -895,7 +917,13 @@ void RPCEndpoint::InitRemoteSession(ffi::PackedArgs args) {
 void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, ffi::PackedArgs args,
                            RPCSession::FEncodeReturn encode_return) {
   std::lock_guard<std::mutex> lock(mutex_);
+  CompleteAllPipelined();
+  WriteCallFunc(h, args);
+  RPCCode code = HandleUntilReturnEvent(true, encode_return);
+  TVM_FFI_ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+}
 
+void RPCEndpoint::WriteCallFunc(RPCSession::PackedFuncHandle h, ffi::PackedArgs args) {
   handler_->ValidateArguments(args);
   RPCCode code = RPCCode::kCallFunc;
   uint64_t handle = reinterpret_cast<uint64_t>(h);
@@ -908,13 +936,9 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, ffi::PackedArgs args,
   handler_->Write(code);
   handler_->Write(handle);
   handler_->SendPackedSeq(args.data(), args.size(), true);
-
-  code = HandleUntilReturnEvent(true, encode_return);
-  TVM_FFI_ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
 }
 
-void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+void RPCEndpoint::WriteCopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
   RPCCode code = RPCCode::kCopyToRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(ffi::GetDataSize(*to));
@@ -930,11 +954,9 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
   RPCReference::SendDLTensor(handler_, to);
   handler_->Write(nbytes);
   handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
-  TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kReturn);
 }
 
-void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+void RPCEndpoint::WriteCopyFromRemote(DLTensor* from, uint64_t nbytes) {
   RPCCode code = RPCCode::kCopyFromRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(ffi::GetDataSize(*from));
@@ -949,12 +971,176 @@ void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes
   handler_->Write(code);
   RPCReference::SendDLTensor(handler_, from);
   handler_->Write(nbytes);
-  TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kCopyAck);
+}
 
+void RPCEndpoint::RecvCopyFromRemote(void* to_bytes, uint64_t nbytes) {
+  TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kCopyAck);
   handler_->ReadArray(reinterpret_cast<char*>(to_bytes), nbytes);
   handler_->FinishCopyAck();
 }
 
+void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CompleteAllPipelined();
+  WriteCopyToRemote(from_bytes, to, nbytes);
+  TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kReturn);
+}
+
+void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CompleteAllPipelined();
+  WriteCopyFromRemote(from, nbytes);
+  RecvCopyFromRemote(to_bytes, nbytes);
+}
+
+void RPCEndpoint::CopyToRemoteStream(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                     uint64_t block_size, int window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CompleteAllPipelined();
+  TVM_FFI_ICHECK_GT(block_size, 0U);
+  TVM_FFI_ICHECK_GT(window, 0);
+  const uint64_t num_blocks = (nbytes + block_size - 1) / block_size;
+  uint64_t num_sent = 0, num_acked = 0;
+  auto wait_ack = [this, &num_acked]() {
+    // Count the block before waiting, so that a failed block is not waited for again.
+    ++num_acked;
+    TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kReturn);
+  };
+  try {
+    while (num_acked < num_blocks) {
+      // The requests are flushed to the channel when waiting for the next acknowledgement.
+      while (num_sent < num_blocks && num_sent - num_acked < static_cast<uint64_t>(window)) {
+        uint64_t offset = num_sent * block_size;
+        to->byte_offset = offset;
+        WriteCopyToRemote(static_cast<char*>(from_bytes) + offset, to,
+                          std::min(block_size, nbytes - offset));
+        ++num_sent;
+      }
+      wait_ack();
+    }
+  } catch (const std::exception&) {
+    // Consume the replies of the blocks still in flight to keep the channel in sync.
+    while (num_acked < num_sent) {
+      try {
+        wait_ack();
+      } catch (const std::exception&) {
+      }
+    }
+    throw;
+  }
+}
+
+void RPCEndpoint::CopyFromRemoteStream(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                       uint64_t block_size, int window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CompleteAllPipelined();
+  TVM_FFI_ICHECK_GT(block_size, 0U);
+  TVM_FFI_ICHECK_GT(window, 0);
+  const uint64_t num_blocks = (nbytes + block_size - 1) / block_size;
+  uint64_t num_sent = 0, num_received = 0;
+  auto recv_block = [this, &num_received, to_bytes, nbytes, block_size]() {
+    uint64_t offset = num_received * block_size;
+    // Count the block before waiting, so that a failed block is not waited for again.
+    ++num_received;
+    RecvCopyFromRemote(static_cast<char*>(to_bytes) + offset,
+                       std::min(block_size, nbytes - offset));
+  };
+  try {
+    while (num_received < num_blocks) {
+      while (num_sent < num_blocks && num_sent - num_received < static_cast<uint64_t>(window)) {
+        uint64_t offset = num_sent * block_size;
+        from->byte_offset = offset;
+        WriteCopyFromRemote(from, std::min(block_size, nbytes - offset));
+        ++num_sent;
+      }
+      recv_block();
+    }
+  } catch (const std::exception&) {
+    while (num_received < num_sent) {
+      try {
+        recv_block();
+      } catch (const std::exception&) {
+      }
+    }
+    throw;
+  }
+}
+
+void RPCEndpoint::FlushWriter() {
+  while (writer_.bytes_available() != 0) {
+    writer_.ReadWithCallback(
+        [this](const void* data, size_t size) { return channel_->Send(data, size); },
+        writer_.bytes_available());
+  }
+}
+
+uint64_t RPCEndpoint::PushPipelined(RPCCode code, void* to_bytes, uint64_t nbytes,
+                                    RPCSession::FAsyncCallback callback) {
+  // Send the request right away so that the remote starts on it.
+  FlushWriter();
+  pending_.push_back(PendingRequest{++last_request_id_, code, to_bytes, nbytes, callback});
+  return last_request_id_;
+}
+
+void RPCEndpoint::CompleteOldestPipelined() {
+  // Pop the request first, so that a failed request is not waited for again.
+  PendingRequest req = std::move(pending_.front());
+  pending_.pop_front();
+  ffi::AnyView void_args[1] = {nullptr};
+  try {
+    if (req.code == RPCCode::kCallFunc) {
+      RPCCode code = HandleUntilReturnEvent(
+          true, [&req](ffi::PackedArgs args) { req.callback(RPCCode::kReturn, args); });
+      TVM_FFI_ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+      return;
+    } else if (req.code == RPCCode::kCopyToRemote) {
+      TVM_FFI_ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kReturn);
+    } else {
+      RecvCopyFromRemote(req.to_bytes, req.nbytes);
+    }
+  } catch (const std::exception& e) {
+    ffi::AnyView error_args[1] = {e.what()};
+    req.callback(RPCCode::kException, ffi::PackedArgs(error_args, 1));
+    return;
+  }
+  req.callback(RPCCode::kReturn, ffi::PackedArgs(void_args, 1));
+}
+
+uint64_t RPCEndpoint::CallFuncPipelined(RPCSession::PackedFuncHandle h, ffi::PackedArgs args,
+                                        RPCSession::FAsyncCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (pending_.size() >= kMaxPipelinedRequests) CompleteOldestPipelined();
+  WriteCallFunc(h, args);
+  return PushPipelined(RPCCode::kCallFunc, nullptr, 0, callback);
+}
+
+uint64_t RPCEndpoint::CopyToRemotePipelined(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                            RPCSession::FAsyncCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto is_copy_from = [](const PendingRequest& req) {
+    return req.code == RPCCode::kCopyFromRemote;
+  };
+  while (pending_.size() >= kMaxPipelinedRequests ||
+         std::any_of(pending_.begin(), pending_.end(), is_copy_from)) {
+    CompleteOldestPipelined();
+  }
+  WriteCopyToRemote(from_bytes, to, nbytes);
+  return PushPipelined(RPCCode::kCopyToRemote, nullptr, 0, callback);
+}
+
+uint64_t RPCEndpoint::CopyFromRemotePipelined(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                              RPCSession::FAsyncCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (pending_.size() >= kMaxPipelinedRequests) CompleteOldestPipelined();
+  WriteCopyFromRemote(from, nbytes);
+  return PushPipelined(RPCCode::kCopyFromRemote, to_bytes, nbytes, callback);
+}
+
+void RPCEndpoint::WaitPipelined(uint64_t request_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (!pending_.empty() && pending_.front().id <= request_id) CompleteOldestPipelined();
+}
+
 // SysCallEventHandler functions
 void RPCGetGlobalFunc(RPCSession* handler, ffi::PackedArgs args, ffi::Any* rv) {
   auto name = args[0].cast<std::string>();
@@ -1124,57 +1310,46 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
   }
 
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
-    RPCCode code = RPCCode::kCopyToRemote;
-    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
-    uint64_t rpc_max_size = GetRPCMaxTransferSize();
-    TVM_FFI_ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* from_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
-    }
-
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
-    }
+    uint64_t block_size = GetCopyBlockSize(remote_to, RPCCode::kCopyToRemote, nbytes);
+    endpoint_->CopyToRemoteStream(local_from_bytes, remote_to, nbytes, block_size,
+                                  GetCopyWindow());
   }
 
   void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) final {
-    RPCCode code = RPCCode::kCopyFromRemote;
-    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_from, code, nbytes);
-    uint64_t rpc_max_size = GetRPCMaxTransferSize();
-    TVM_FFI_ICHECK_GT(rpc_max_size, overhead) << "CopyFromRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* to_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, block_size);
-    }
+    uint64_t block_size = GetCopyBlockSize(remote_from, RPCCode::kCopyFromRemote, nbytes);
+    endpoint_->CopyFromRemoteStream(remote_from, local_to_bytes, nbytes, block_size,
+                                    GetCopyWindow());
+  }
 
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, remainder_bytes);
-    }
+  uint64_t PipelinedCallFunc(PackedFuncHandle func, ffi::PackedArgs args,
+                             FAsyncCallback callback) final {
+    return endpoint_->CallFuncPipelined(func, args, callback);
+  }
+
+  uint64_t PipelinedCopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes,
+                                 FAsyncCallback on_complete) final {
+    uint64_t block_size = GetCopyBlockSize(remote_to, RPCCode::kCopyToRemote, nbytes);
+    return PipelinedCopyBlocks(
+        remote_to, nbytes, block_size, on_complete,
+        [&](uint64_t offset, uint64_t block_nbytes, FAsyncCallback callback) {
+          return endpoint_->CopyToRemotePipelined(static_cast<char*>(local_from_bytes) + offset,
+                                                  remote_to, block_nbytes, callback);
+        });
   }
 
+  uint64_t PipelinedCopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes,
+                                   FAsyncCallback on_complete) final {
+    uint64_t block_size = GetCopyBlockSize(remote_from, RPCCode::kCopyFromRemote, nbytes);
+    return PipelinedCopyBlocks(
+        remote_from, nbytes, block_size, on_complete,
+        [&](uint64_t offset, uint64_t block_nbytes, FAsyncCallback callback) {
+          return endpoint_->CopyFromRemotePipelined(
+              remote_from, static_cast<char*>(local_to_bytes) + offset, block_nbytes, callback);
+        });
+  }
+
+  void WaitPipelined(uint64_t request_id) final { endpoint_->WaitPipelined(request_id); }
+
   void FreeHandle(void* handle) final { endpoint_->SysCallRemote(RPCCode::kFreeHandle, handle); }
 
   void SetDevice(Device dev) final { endpoint_->SysCallRemote(RPCCode::kDevSetDevice, dev); }
@@ -1270,8 +1445,95 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     return (uint64_t)rpc_chunk_max_size_bytes_;
   }
 
+  /*!
+   * \brief The number of bytes of tensor data in each block of a remote copy.
+   *
+   *  Blocks are bounded by the max transfer size of the remote and, so that a large copy is
+   *  pipelined, by TVM_RPC_COPY_BLOCK_BYTES (default 4MB, 0 to disable the bound).
+   */
+  uint64_t GetCopyBlockSize(DLTensor* tensor, RPCCode code, uint64_t nbytes) {
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(tensor, code, nbytes);
+    uint64_t rpc_max_size = GetRPCMaxTransferSize();
+    TVM_FFI_ICHECK_GT(rpc_max_size, overhead) << RPCCodeToString(code) << ": Invalid block size!";
+    uint64_t block_size = rpc_max_size - overhead;
+    if (copy_block_bytes_ < 0) {
+      const char* val = getenv("TVM_RPC_COPY_BLOCK_BYTES");
+      copy_block_bytes_ = val ? std::max(atoll(val), 0LL) : kDefaultCopyBlockBytes;
+    }
+    if (copy_block_bytes_ > 0) {
+      block_size = std::min(block_size, static_cast<uint64_t>(copy_block_bytes_));
+    }
+    return block_size;
+  }
+
+  /*!
+   * \brief The number of blocks of a remote copy in flight, set by TVM_RPC_COPY_WINDOW.
+   *
+   *  Remotes that report a max transfer size, such as the CRT server, do not buffer more
+   *  than one packet, so they default to a window of one block.
+   */
+  int GetCopyWindow() {
+    if (copy_window_ <= 0) {
+      const char* val = getenv("TVM_RPC_COPY_WINDOW");
+      if (val && atoi(val) > 0) {
+        copy_window_ = atoi(val);
+      } else {
+        bool limited_packet_size = GetRPCMaxTransferSize() != kRPCMaxTransferSizeBytesDefault;
+        copy_window_ = limited_packet_size ? 1 : kDefaultCopyWindow;
+      }
+    }
+    return copy_window_;
+  }
+
+  /*!
+   * \brief Issue a pipelined copy as a sequence of blocks.
+   *
+   *  `on_complete` is called once, with the reply of the last block, or with the first
+   *  exception raised by any block.
+   *
+   * \param remote The remote array, its byte_offset is set to the offset of each block.
+   * \param nbytes The size of the memory in bytes.
+   * \param block_size The maximum number of bytes in each block.
+   * \param on_complete The callback to signal copy complete.
+   * \param fissue Issue the block at the offset with the size and the callback.
+   * \return The id of the request of the last block.
+   */
+  template <typename FIssue>
+  uint64_t PipelinedCopyBlocks(DLTensor* remote, uint64_t nbytes, uint64_t block_size,
+                               FAsyncCallback on_complete, FIssue fissue) {
+    const uint64_t num_blocks = std::max<uint64_t>((nbytes + block_size - 1) / block_size, 1);
+    auto error = std::make_shared<std::string>();
+    auto failed = std::make_shared<bool>(false);
+    uint64_t request_id = 0;
+    for (uint64_t i = 0; i < num_blocks; ++i) {
+      uint64_t offset = i * block_size;
+      bool is_last = i + 1 == num_blocks;
+      remote->byte_offset = offset;
+      auto callback = [this, error, failed, is_last, on_complete](RPCCode status,
+                                                                    ffi::PackedArgs args) {
+        if (status == RPCCode::kException && !*failed) {
+          *failed = true;
+          *error = args[0].cast<std::string>();
+        }
+        if (!is_last) return;
+        if (*failed) {
+          this->SendException(on_complete, error->c_str());
+        } else {
+          on_complete(status, args);
+        }
+      };
+      request_id = fissue(offset, std::min(block_size, nbytes - offset), callback);
+    }
+    return request_id;
+  }
+
+  static constexpr int64_t kDefaultCopyBlockBytes = 4 << 20;
+  static constexpr int kDefaultCopyWindow = 4;
+
   std::shared_ptr<RPCEndpoint> endpoint_;
   int64_t rpc_chunk_max_size_bytes_ = -1;
+  int64_t copy_block_bytes_ = -1;
+  int copy_window_ = -1;
 };
 
 std::shared_ptr<RPCSession> CreateClientSession(std::shared_ptr<RPCEndpoint> endpoint) {
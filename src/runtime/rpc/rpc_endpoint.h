@@ -26,6 +26,7 @@
 
 #include <tvm/ffi/function.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -159,6 +160,76 @@ class RPCEndpoint {
    * \param type_hint Hint of content data type.
    */
   void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
+  /*!
+   * \brief Copy bytes into remote array content as a stream of blocks.
+   *
+   *  Up to `window` blocks are sent before the acknowledgement of the first one is awaited,
+   *  so the transfer of a block overlaps with the remote handling of the previous ones.
+   *
+   * \param from_bytes The source host data.
+   * \param to The target array, its byte_offset is set to the offset of each block.
+   * \param nbytes The size of the memory in bytes.
+   * \param block_size The maximum number of bytes in each block.
+   * \param window The maximum number of blocks in flight.
+   */
+  void CopyToRemoteStream(void* from_bytes, DLTensor* to, uint64_t nbytes, uint64_t block_size,
+                          int window);
+  /*!
+   * \brief Copy bytes from remote array content as a stream of blocks.
+   *
+   *  Up to `window` block requests are sent before the first block is received.
+   *
+   * \param from The source array, its byte_offset is set to the offset of each block.
+   * \param to_bytes The target host data.
+   * \param nbytes The size of the memory in bytes.
+   * \param block_size The maximum number of bytes in each block.
+   * \param window The maximum number of blocks in flight.
+   */
+  void CopyFromRemoteStream(DLTensor* from, void* to_bytes, uint64_t nbytes, uint64_t block_size,
+                            int window);
+  /*!
+   * \brief Call into remote function without waiting for its return.
+   *
+   *  The remote handles the requests in order, so the replies of the pipelined requests
+   *  complete in the order they were issued. A synchronous request first completes all
+   *  the pipelined ones. At most kMaxPipelinedRequests are kept in flight.
+   *
+   * \param handle The function handle.
+   * \param args The argument values, serialized before the function returns.
+   * \param callback The callback to pass the return value or exception.
+   * \return The id of the request.
+   */
+  uint64_t CallFuncPipelined(RPCSession::PackedFuncHandle handle, ffi::PackedArgs args,
+                             RPCSession::FAsyncCallback callback);
+  /*!
+   * \brief Copy bytes into remote array content without waiting for the acknowledgement.
+   *
+   *  The copy-from-remote requests in flight are completed first, as their replies carry
+   *  the data and the channel could otherwise fill up in both directions.
+   *
+   * \param from_bytes The source host data, copied before the function returns.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param callback The callback to signal copy complete.
+   * \return The id of the request.
+   */
+  uint64_t CopyToRemotePipelined(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                 RPCSession::FAsyncCallback callback);
+  /*!
+   * \brief Copy bytes from remote array content without waiting for the data.
+   * \param from The source array.
+   * \param to_bytes The target host data, which must stay alive until the callback is called.
+   * \param nbytes The size of the memory in bytes.
+   * \param callback The callback to signal copy complete.
+   * \return The id of the request.
+   */
+  uint64_t CopyFromRemotePipelined(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                   RPCSession::FAsyncCallback callback);
+  /*!
+   * \brief Wait until a pipelined request, and all the ones issued before it, complete.
+   * \param request_id The id of the request.
+   */
+  void WaitPipelined(uint64_t request_id);
 
   /*!
    * \brief Call a remote defined system function with arguments.
@@ -197,6 +268,40 @@ class RPCEndpoint {
   support::RingBuffer reader_, writer_;
   // Event handler.
   std::shared_ptr<EventHandler> handler_;
+  // Write a copy-to-remote request without waiting for its acknowledgement.
+  void WriteCopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes);
+  // Write a copy-from-remote request without waiting for the data.
+  void WriteCopyFromRemote(DLTensor* from, uint64_t nbytes);
+  // Wait for the data of a copy-from-remote request.
+  void RecvCopyFromRemote(void* to_bytes, uint64_t nbytes);
+  // Write a function call request without waiting for its return.
+  void WriteCallFunc(RPCSession::PackedFuncHandle h, ffi::PackedArgs args);
+  // Send the buffered requests to the channel.
+  void FlushWriter();
+  // Record a pipelined request whose request is written and flushed.
+  uint64_t PushPipelined(RPCCode code, void* to_bytes, uint64_t nbytes,
+                         RPCSession::FAsyncCallback callback);
+  // Wait for the reply of the oldest pipelined request and call its callback.
+  void CompleteOldestPipelined();
+  // Complete all the pipelined requests, called before a synchronous request.
+  void CompleteAllPipelined() {
+    while (!pending_.empty()) CompleteOldestPipelined();
+  }
+  /*! \brief The maximum number of pipelined requests in flight. */
+  static constexpr size_t kMaxPipelinedRequests = 64;
+  /*! \brief A pipelined request whose reply has not been received. */
+  struct PendingRequest {
+    uint64_t id;
+    RPCCode code;
+    // The target host data of a copy-from-remote request.
+    void* to_bytes;
+    uint64_t nbytes;
+    RPCSession::FAsyncCallback callback;
+  };
+  // The pipelined requests in flight, in issue order.
+  std::deque<PendingRequest> pending_;
+  // The id of the last pipelined request.
+  uint64_t last_request_id_{0};
   // syscall remote with specified function code.
   ffi::Function syscall_remote_;
   // The name of the session.
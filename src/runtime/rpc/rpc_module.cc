@@ -21,6 +21,7 @@
  * \file rpc_module.cc
  * \brief RPC runtime module.
  */
+#include <tvm/ffi/extra/json.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ffi/string.h>
@@ -30,7 +31,10 @@
 #include <chrono>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 #if defined(_M_X64) || defined(__x86_64__)
 #include <immintrin.h>
 #endif
@@ -74,6 +78,51 @@ Tensor TensorFromRemoteOpaqueHandle(std::shared_ptr<RPCSession> sess, void* hand
   return Tensor::FromNDAlloc(RemoteSpaceAlloc(space), shape, template_tensor->dtype, dev);
 }
 
+/*! \brief The result of a pipelined request, filled in when the request completes. */
+struct RPCPipelinedResult {
+  bool done{false};
+  bool failed{false};
+  std::string error;
+  ffi::Any value;
+};
+
+/*!
+ * \brief The pipelined call being issued by rpc.CallPipelined on the current thread.
+ *
+ *  While it is set, a remote function issues a pipelined request and records it here instead
+ *  of waiting for its return.
+ */
+struct RPCPipelinedCall {
+  std::shared_ptr<RPCSession> sess;
+  uint64_t request_id{0};
+  std::shared_ptr<RPCPipelinedResult> result;
+
+  static RPCPipelinedCall*& ThreadLocal() {
+    static thread_local RPCPipelinedCall* inst = nullptr;
+    return inst;
+  }
+};
+
+/*!
+ * \brief Create the future of a pipelined request.
+ * \param sess The session of the request, nullptr if the request already completed.
+ * \param request_id The id of the request.
+ * \param result The result of the request.
+ * \return A function that waits for the request and returns its result.
+ */
+ffi::Function MakeRPCFuture(std::shared_ptr<RPCSession> sess, uint64_t request_id,
+                            std::shared_ptr<RPCPipelinedResult> result) {
+  return ffi::Function::FromTyped([sess, request_id, result]() -> ffi::Any {
+    if (sess != nullptr) sess->WaitPipelined(request_id);
+    TVM_FFI_CHECK(result->done, RPCError)
+        << "The RPC session was shut down before the pipelined request completed";
+    if (result->failed) {
+      TVM_FFI_THROW(RPCError) << result->error;
+    }
+    return result->value;
+  });
+}
+
 /*!
  * \brief A wrapped remote function as a ffi::Function.
  */
@@ -137,8 +186,29 @@ class RPCWrappedFunc : public Object {
         }
       }
     }
-    auto set_return = [this, rv](ffi::PackedArgs args) { this->WrapRemoteReturnToValue(args, rv); };
-    sess_->CallFunc(handle_, ffi::PackedArgs(packed_args.data(), packed_args.size()), set_return);
+    ffi::PackedArgs remote_args(packed_args.data(), packed_args.size());
+    if (RPCPipelinedCall* call = RPCPipelinedCall::ThreadLocal()) {
+      // Only the outermost remote call is pipelined.
+      RPCPipelinedCall::ThreadLocal() = nullptr;
+      auto result = std::make_shared<RPCPipelinedResult>();
+      auto on_complete = [sess = sess_, result](RPCCode status, ffi::PackedArgs args) {
+        result->done = true;
+        if (status == RPCCode::kException) {
+          result->failed = true;
+          result->error = args[0].cast<std::string>();
+        } else {
+          WrapRemoteReturnToValue(sess, args, &result->value);
+        }
+      };
+      call->request_id = sess_->PipelinedCallFunc(handle_, remote_args, on_complete);
+      call->sess = sess_;
+      call->result = result;
+      return;
+    }
+    auto set_return = [this, rv](ffi::PackedArgs args) {
+      WrapRemoteReturnToValue(sess_, args, rv);
+    };
+    sess_->CallFunc(handle_, remote_args, set_return);
   }
 
   ~RPCWrappedFunc() {
@@ -157,8 +227,9 @@ class RPCWrappedFunc : public Object {
 
   // unwrap a remote value to the underlying handle.
   void* UnwrapRemoteValueToHandle(const ffi::AnyView& arg) const;
-  // wrap a remote return via Set
-  void WrapRemoteReturnToValue(ffi::PackedArgs args, ffi::Any* rv) const;
+  // wrap a remote return of the session via Set
+  static void WrapRemoteReturnToValue(const std::shared_ptr<RPCSession>& sess,
+                                      ffi::PackedArgs args, ffi::Any* rv);
 
   // remove a remote session mask
   Device RemoveSessMask(Device dev) const {
@@ -289,7 +360,8 @@ void* RPCWrappedFunc::UnwrapRemoteValueToHandle(const AnyView& arg) const {
   }
 }
 
-void RPCWrappedFunc::WrapRemoteReturnToValue(ffi::PackedArgs args, ffi::Any* rv) const {
+void RPCWrappedFunc::WrapRemoteReturnToValue(const std::shared_ptr<RPCSession>& sess,
+                                             ffi::PackedArgs args, ffi::Any* rv) {
   int type_index = args[0].cast<int>();
   if (type_index == ffi::TypeIndex::kTVMFFINone) {
     *rv = nullptr;
@@ -297,21 +369,21 @@ void RPCWrappedFunc::WrapRemoteReturnToValue(ffi::PackedArgs args, ffi::Any* rv)
   } else if (type_index == ffi::TypeIndex::kTVMFFIFunction) {
     TVM_FFI_ICHECK_EQ(args.size(), 2);
     void* handle = args[1].cast<void*>();
-    auto wf = std::make_shared<RPCWrappedFunc>(handle, sess_);
+    auto wf = std::make_shared<RPCWrappedFunc>(handle, sess);
     *rv = ffi::Function(
         [wf](ffi::PackedArgs args, ffi::Any* rv) { return wf->operator()(args, rv); });
   } else if (type_index == ffi::TypeIndex::kTVMFFIModule) {
     TVM_FFI_ICHECK_EQ(args.size(), 2);
     void* handle = args[1].cast<void*>();
-    auto n = ffi::make_object<RPCModuleNode>(handle, sess_);
+    auto n = ffi::make_object<RPCModuleNode>(handle, sess);
     *rv = ffi::Module(n);
   } else if (type_index == ffi::TypeIndex::kTVMFFITensor ||
              type_index == ffi::TypeIndex::kTVMFFIDLTensorPtr) {
     TVM_FFI_ICHECK_EQ(args.size(), 3);
     auto tensor = args[1].cast<DLTensor*>();
     void* nd_handle = args[2].cast<void*>();
-    *rv = TensorFromRemoteOpaqueHandle(sess_, tensor->data, tensor,
-                                       AddRPCSessionMask(tensor->device, sess_->table_index()),
+    *rv = TensorFromRemoteOpaqueHandle(sess, tensor->data, tensor,
+                                       AddRPCSessionMask(tensor->device, sess->table_index()),
                                        nd_handle);
   } else if (type_index == ffi::TypeIndex::kTVMFFIBytes ||
              type_index == ffi::TypeIndex::kTVMFFIStr ||
@@ -322,7 +394,7 @@ void RPCWrappedFunc::WrapRemoteReturnToValue(ffi::PackedArgs args, ffi::Any* rv)
   } else if (type_index >= ffi::TypeIndex::kTVMFFIStaticObjectBegin) {
     TVM_FFI_ICHECK_EQ(args.size(), 2);
     void* handle = args[1].cast<void*>();
-    auto n = ffi::make_object<RPCObjectRefObj>(handle, sess_);
+    auto n = ffi::make_object<RPCObjectRefObj>(handle, sess);
     *rv = ObjectRef(n);
   } else {
     TVM_FFI_ICHECK_EQ(args.size(), 2);
@@ -393,6 +465,103 @@ inline void CPUCacheFlush(int begin_index, const ffi::PackedArgs& args) {
   }
 }
 
+/*!
+ * \brief Time a batch of functions on a local device, so that a remote client can measure many
+ *  candidates in a single round trip. The arguments of each function are allocated here.
+ *
+ *  The packed arguments are the device type and id, the time evaluator configuration (number,
+ *  repeat, min_repeat_ms, limit_zero_time_iterations, cooldown_interval_ms, repeats_to_cooldown,
+ *  cache_flush_bytes and the name of the preprocessing function), the name of the function used
+ *  to fill the arguments, the number of times to allocate the arguments and the arguments
+ *  info, followed by a (module, function name) pair per function. The arguments info is a JSON
+ *  array holding, for each function, the list of its arguments as ["TENSOR", dtype, shape].
+ *
+ * \return A JSON array holding, for each function, either {"costs": [...]} with the durations
+ *  in seconds of every repeat of every allocation, or {"error": message}.
+ */
+ffi::String RPCBatchTimeEvaluate(ffi::PackedArgs args) {
+  namespace json = ffi::json;
+  constexpr int kNumConfigArgs = 13;
+  TVM_FFI_ICHECK_GE(args.size(), kNumConfigArgs);
+  TVM_FFI_CHECK_EQ((args.size() - kNumConfigArgs) % 2, 0, ValueError)
+      << "Expect a (module, function name) pair per function to be timed";
+  Device dev;
+  dev.device_type = static_cast<DLDeviceType>(args[0].cast<int>());
+  dev.device_id = args[1].cast<int>();
+  int number = args[2].cast<int>();
+  int repeat = args[3].cast<int>();
+  int min_repeat_ms = args[4].cast<int>();
+  int limit_zero_time_iterations = args[5].cast<int>();
+  int cooldown_interval_ms = args[6].cast<int>();
+  int repeats_to_cooldown = args[7].cast<int>();
+  int cache_flush_bytes = args[8].cast<int>();
+  std::string f_preproc_name = args[9].cast<std::string>();
+  std::string f_fill_name = args[10].cast<std::string>();
+  int alloc_repeat = args[11].cast<int>();
+  json::Array args_info = json::Parse(args[12].cast<std::string>()).cast<json::Array>();
+  int num_funcs = (args.size() - kNumConfigArgs) / 2;
+  TVM_FFI_CHECK_EQ(static_cast<int>(args_info.size()), num_funcs, ValueError)
+      << "Expect the arguments info of every function to be timed";
+
+  auto get_global = [](const std::string& name) {
+    if (name.empty()) return ffi::Function();
+    auto pf = tvm::ffi::Function::GetGlobal(name);
+    TVM_FFI_ICHECK(pf.has_value()) << "Cannot find " << name << " in the global function";
+    return *pf;
+  };
+  ffi::Function f_preproc = get_global(f_preproc_name);
+  ffi::Function f_fill = get_global(f_fill_name);
+
+  json::Array results;
+  for (int i = 0; i < num_funcs; ++i) {
+    json::Object result;
+    // A failing function does not prevent the others in the batch from being timed.
+    try {
+      ffi::Module mod = args[kNumConfigArgs + 2 * i].cast<ffi::Module>();
+      std::string name = args[kNumConfigArgs + 2 * i + 1].cast<std::string>();
+      ffi::Optional<ffi::Function> pf = mod->GetFunction(name);
+      TVM_FFI_ICHECK(pf.has_value()) << "Cannot find `" << name << "` in the module";
+      ffi::Function ftimer = profiling::WrapTimeEvaluator(
+          *pf, dev, number, repeat, min_repeat_ms, limit_zero_time_iterations,
+          cooldown_interval_ms, repeats_to_cooldown, cache_flush_bytes, f_preproc);
+      json::Array costs;
+      for (int r = 0; r < alloc_repeat; ++r) {
+        std::vector<Tensor> tensors;
+        for (const ffi::Any& info : args_info[i].cast<json::Array>()) {
+          json::Array arg = info.cast<json::Array>();
+          TVM_FFI_CHECK(arg.size() == 3 && arg[0].cast<ffi::String>() == "TENSOR", ValueError)
+              << "Unsupported argument info: " << json::Stringify(arg);
+          std::vector<int64_t> shape;
+          for (const ffi::Any& dim : arg[2].cast<json::Array>()) {
+            shape.push_back(dim.cast<int64_t>());
+          }
+          Tensor tensor = Tensor::Empty(ffi::Shape(shape),
+                                        ffi::StringToDLDataType(arg[1].cast<ffi::String>()), dev);
+          if (f_fill != nullptr) {
+            f_fill(tensor);
+          }
+          tensors.push_back(tensor);
+        }
+        std::vector<ffi::AnyView> packed_args(tensors.begin(), tensors.end());
+        DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+        ffi::Any rv;
+        ftimer.CallPacked(ffi::PackedArgs(packed_args.data(), packed_args.size()), &rv);
+        ffi::Bytes blob = rv.cast<ffi::Bytes>();
+        for (size_t offset = 0; offset + sizeof(double) <= blob.size(); offset += sizeof(double)) {
+          double cost;
+          std::memcpy(&cost, blob.data() + offset, sizeof(double));
+          costs.push_back(cost);
+        }
+      }
+      result.Set(ffi::String("costs"), std::move(costs));
+    } catch (const std::exception& e) {
+      result.Set(ffi::String("error"), ffi::String(e.what()));
+    }
+    results.push_back(std::move(result));
+  }
+  return json::Stringify(results);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -443,6 +612,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                    cooldown_interval_ms, repeats_to_cooldown, cache_flush_bytes, f_preproc);
              }
            })
+      .def_packed("runtime.RPCBatchTimeEvaluator",
+                  [](ffi::PackedArgs args, ffi::Any* rv) { *rv = RPCBatchTimeEvaluate(args); })
       .def_packed("cache_flush_cpu_non_first_arg",
                   [](ffi::PackedArgs args, ffi::Any* rv) { CPUCacheFlush(1, args); });
 }
@@ -459,6 +630,44 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            });
 }
 
+/*!
+ * \brief Get the session and the remote view of the remote tensor of a pipelined copy.
+ * \param host The host tensor of the copy.
+ * \param remote The remote tensor of the copy.
+ */
+std::pair<std::shared_ptr<RPCSession>, DLTensor> GetPipelinedCopyRemote(const Tensor& host,
+                                                                        const Tensor& remote) {
+  TVM_FFI_CHECK(IsRPCSessionDevice(remote->device), ValueError)
+      << "Expect a remote tensor, but got a tensor on " << remote->device;
+  TVM_FFI_CHECK_EQ(host->device.device_type, kDLCPU, ValueError)
+      << "Expect a host tensor, but got a tensor on " << host->device;
+  TVM_FFI_CHECK_EQ(GetDataSize(*host.operator->()), GetDataSize(*remote.operator->()), ValueError)
+      << "The host and remote tensors of a copy must have the same size";
+  std::shared_ptr<RPCSession> sess = RPCSession::Get(GetRPCSessionIndex(remote->device));
+  TVM_FFI_ICHECK(sess != nullptr) << "The session of the remote tensor is closed";
+  DLTensor remote_view = *remote.operator->();
+  remote_view.device = RemoveRPCSessionMask(remote->device);
+  remote_view.data = static_cast<const RemoteSpace*>(remote->data)->data;
+  return {sess, remote_view};
+}
+
+/*!
+ * \brief The completion callback of a pipelined copy, whose result is the target tensor.
+ *  The target tensor is kept alive until the copy completes.
+ */
+RPCSession::FAsyncCallback MakePipelinedCopyCallback(std::shared_ptr<RPCPipelinedResult> result,
+                                                     Tensor target) {
+  return [result, target](RPCCode status, ffi::PackedArgs args) {
+    result->done = true;
+    if (status == RPCCode::kException) {
+      result->failed = true;
+      result->error = args[0].cast<std::string>();
+    } else {
+      result->value = target;
+    }
+  };
+}
+
 // functions to access an RPC module.
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
@@ -487,7 +696,49 @@ TVM_FFI_STATIC_INIT_BLOCK() {
               void* tensor_handle) -> Tensor {
              return TensorFromRemoteOpaqueHandle(RPCModuleGetSession(mod), remote_array,
                                                  template_tensor, dev, tensor_handle);
-           });
+           })
+      .def_packed("rpc.CallPipelined",
+                  [](ffi::PackedArgs args, ffi::Any* rv) {
+                    TVM_FFI_CHECK_GE(args.size(), 1, ValueError)
+                        << "rpc.CallPipelined expects the remote function to call";
+                    ffi::Function func = args[0].cast<ffi::Function>();
+                    RPCPipelinedCall call;
+                    RPCPipelinedCall::ThreadLocal() = &call;
+                    ffi::Any value;
+                    try {
+                      func.CallPacked(args.Slice(1), &value);
+                    } catch (...) {
+                      RPCPipelinedCall::ThreadLocal() = nullptr;
+                      throw;
+                    }
+                    RPCPipelinedCall::ThreadLocal() = nullptr;
+                    if (call.result == nullptr) {
+                      // Not a remote function, it already ran to completion.
+                      call.result = std::make_shared<RPCPipelinedResult>();
+                      call.result->done = true;
+                      call.result->value = std::move(value);
+                    }
+                    *rv = MakeRPCFuture(call.sess, call.request_id, call.result);
+                  })
+      .def("rpc.CopyToRemotePipelined",
+           [](Tensor from, Tensor to) {
+             auto [sess, remote_to] = GetPipelinedCopyRemote(from, to);
+             void* from_bytes = static_cast<char*>(from->data) + from->byte_offset;
+             auto result = std::make_shared<RPCPipelinedResult>();
+             uint64_t nbytes = GetDataSize(*from.operator->());
+             uint64_t request_id = sess->PipelinedCopyToRemote(
+                 from_bytes, &remote_to, nbytes, MakePipelinedCopyCallback(result, to));
+             return MakeRPCFuture(sess, request_id, result);
+           })
+      .def("rpc.CopyFromRemotePipelined", [](Tensor from, Tensor to) {
+        auto [sess, remote_from] = GetPipelinedCopyRemote(to, from);
+        void* to_bytes = static_cast<char*>(to->data) + to->byte_offset;
+        auto result = std::make_shared<RPCPipelinedResult>();
+        uint64_t nbytes = GetDataSize(*to.operator->());
+        uint64_t request_id = sess->PipelinedCopyFromRemote(
+            &remote_from, to_bytes, nbytes, MakePipelinedCopyCallback(result, to));
+        return MakeRPCFuture(sess, request_id, result);
+      });
 }
 
 }  // namespace runtime
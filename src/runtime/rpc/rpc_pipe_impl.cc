@@ -25,6 +25,7 @@
 #if defined(__linux__) || defined(__ANDROID__)
 
 #include <errno.h>
+#include <poll.h>
 #include <signal.h>
 #include <sys/types.h>
 #include <tvm/ffi/function.h>
@@ -33,8 +34,12 @@
 
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "../../support/pipe.h"
+#include "../../support/shm_ring_buffer.h"
 #include "rpc_endpoint.h"
 #include "rpc_local_session.h"
 
@@ -76,7 +81,53 @@ class PipeChannel final : public RPCChannel {
   pid_t child_pid_;
 };
 
-ffi::Module CreatePipeClient(std::vector<std::string> cmd) {
+/*!
+ * \brief Pipe channel that moves the payload through a pair of shared-memory ring buffers.
+ *
+ * The pipes are kept open so that either side notices when the other process exits,
+ * but no data goes through them once the server has accepted the ring buffers.
+ */
+class ShmPipeChannel final : public RPCChannel {
+ public:
+  ShmPipeChannel(std::unique_ptr<PipeChannel> pipe, std::unique_ptr<support::ShmRingBuffer> send,
+                 std::unique_ptr<support::ShmRingBuffer> recv)
+      : pipe_(std::move(pipe)), send_(std::move(send)), recv_(std::move(recv)) {}
+
+  size_t Send(const void* data, size_t size) final { return send_->Write(data, size); }
+
+  size_t Recv(void* data, size_t size) final { return recv_->Read(data, size); }
+
+ private:
+  std::unique_ptr<PipeChannel> pipe_;
+  std::unique_ptr<support::ShmRingBuffer> send_;
+  std::unique_ptr<support::ShmRingBuffer> recv_;
+};
+
+/*! \brief Check whether the write end of the pipe whose read end is `fd` has been closed. */
+static bool IsPipeHungUp(int fd) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = 0;
+  pfd.revents = 0;
+  return poll(&pfd, 1, 0) == 1 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+}
+
+/*!
+ * \brief Create an RPC client that talks to a child process through pipes.
+ *
+ * The file descriptors of the pipes are appended to `cmd`. When `shm_capacity` is not zero,
+ * the client also proposes a pair of shared-memory ring buffers of that capacity through the
+ * TVM_RPC_PIPE_SHM environment variable of the child, formatted as
+ * "<client-to-server>:<server-to-client>". A server that supports it opens the ring buffers and
+ * answers with a single byte over the pipe, 1 if all the later traffic uses the ring buffers and
+ * 0 if it stays on the pipes. Only request shared memory from servers that answer, such as the
+ * popen server of rpc.with_minrpc.
+ *
+ * \param cmd The command to start the server.
+ * \param shm_capacity The capacity of each shared-memory ring buffer, 0 to only use the pipes.
+ * \return The client session.
+ */
+ffi::Module CreatePipeClient(std::vector<std::string> cmd, size_t shm_capacity) {
   int parent2child[2];
   int child2parent[2];
   TVM_FFI_ICHECK_EQ(pipe(parent2child), 0);
@@ -87,6 +138,18 @@ ffi::Module CreatePipeClient(std::vector<std::string> cmd) {
   int child_read = parent2child[0];
   int child_write = child2parent[1];
 
+  std::unique_ptr<support::ShmRingBuffer> send_shm, recv_shm;
+  if (shm_capacity != 0) {
+    auto child_alive = [parent_read]() { return !IsPipeHungUp(parent_read); };
+    send_shm = support::ShmRingBuffer::Create(shm_capacity, child_alive);
+    recv_shm = support::ShmRingBuffer::Create(shm_capacity, child_alive);
+    if (send_shm == nullptr || recv_shm == nullptr) {
+      send_shm.reset();
+      recv_shm.reset();
+    }
+  }
+  std::string shm_env = send_shm != nullptr ? send_shm->name() + ":" + recv_shm->name() : "";
+
   pid_t pid = fork();
   if (pid == 0) {
     // child process
@@ -101,14 +164,31 @@ ffi::Module CreatePipeClient(std::vector<std::string> cmd) {
     argv.push_back(sread_pipe.data());
     argv.push_back(swrite_pipe.data());
     argv.push_back(nullptr);
+    if (shm_env.empty()) {
+      unsetenv("TVM_RPC_PIPE_SHM");
+    } else {
+      setenv("TVM_RPC_PIPE_SHM", shm_env.c_str(), 1);
+    }
     execvp(argv[0], &argv[0]);
   }
   // parent process
   close(child_read);
   close(child_write);
 
-  auto endpt = RPCEndpoint::Create(std::make_unique<PipeChannel>(parent_read, parent_write, pid),
-                                   "pipe", "pipe");
+  auto pipe_channel = std::make_unique<PipeChannel>(parent_read, parent_write, pid);
+  std::unique_ptr<RPCChannel> channel;
+  char accepted = 0;
+  if (send_shm != nullptr) {
+    TVM_FFI_ICHECK_EQ(pipe_channel->Recv(&accepted, 1), 1)
+        << "RPC server " << cmd[0] << " exited before answering the shared-memory handshake";
+  }
+  if (accepted) {
+    channel = std::make_unique<ShmPipeChannel>(std::move(pipe_channel), std::move(send_shm),
+                                               std::move(recv_shm));
+  } else {
+    channel = std::move(pipe_channel);
+  }
+  auto endpt = RPCEndpoint::Create(std::move(channel), "pipe", "pipe");
   endpt->InitRemoteSession(ffi::PackedArgs(nullptr, 0));
   return CreateRPCSessionModule(CreateClientSession(endpt));
 }
@@ -120,7 +200,17 @@ TVM_FFI_STATIC_INIT_BLOCK() {
     for (int i = 0; i < args.size(); ++i) {
       cmd.push_back(args[i].cast<std::string>());
     }
-    *rv = CreatePipeClient(cmd);
+    *rv = CreatePipeClient(cmd, 0);
+  });
+  refl::GlobalDef().def_packed("rpc.CreateShmPipeClient", [](ffi::PackedArgs args, ffi::Any* rv) {
+    TVM_FFI_ICHECK_GE(args.size(), 2) << "Expect the ring buffer capacity and the command";
+    int64_t shm_capacity = args[0].cast<int64_t>();
+    TVM_FFI_CHECK_GE(shm_capacity, 0, ValueError) << "The ring buffer capacity cannot be negative";
+    std::vector<std::string> cmd;
+    for (int i = 1; i < args.size(); ++i) {
+      cmd.push_back(args[i].cast<std::string>());
+    }
+    *rv = CreatePipeClient(cmd, static_cast<size_t>(shm_capacity));
   });
 }
 
@@ -86,6 +86,24 @@ void RPCSession::AsyncStreamWait(Device dev, TVMStreamHandle stream,
   }
 }
 
+uint64_t RPCSession::PipelinedCallFunc(PackedFuncHandle func, ffi::PackedArgs args,
+                                       FAsyncCallback callback) {
+  this->AsyncCallFunc(func, args, callback);
+  return ++last_pipelined_request_id_;
+}
+
+uint64_t RPCSession::PipelinedCopyToRemote(void* local_from_bytes, DLTensor* remote_to,
+                                           uint64_t nbytes, FAsyncCallback on_complete) {
+  this->AsyncCopyToRemote(local_from_bytes, remote_to, nbytes, on_complete);
+  return ++last_pipelined_request_id_;
+}
+
+uint64_t RPCSession::PipelinedCopyFromRemote(DLTensor* remote_from, void* local_to_bytes,
+                                             uint64_t nbytes, FAsyncCallback on_complete) {
+  this->AsyncCopyFromRemote(remote_from, local_to_bytes, nbytes, on_complete);
+  return ++last_pipelined_request_id_;
+}
+
 class RPCSessTable {
  public:
   static constexpr int kMaxRPCSession = 32;
@@ -237,6 +237,54 @@ class RPCSession {
    */
   virtual void AsyncStreamWait(Device dev, TVMStreamHandle stream, FAsyncCallback on_compelte);
 
+  // Pipelined variant of API
+  // These APIs are used by the RPC client to keep several requests in flight.
+  // Requests are handled by the remote in the order they are issued, and their
+  // callbacks are called in the same order. A callback is only called while the
+  // issuing thread is inside a session API, e.g. WaitPipelined or the next
+  // synchronous request, which first completes all the pipelined ones.
+  //
+  // The default implementation runs the request synchronously.
+
+  /*!
+   * \brief Call func without waiting for its return.
+   * \param func The function handle.
+   * \param args The packed arguments, which are serialized before the function returns.
+   * \param callback The callback to pass the return value or exception.
+   * \return The id of the request, to be passed to WaitPipelined.
+   */
+  virtual uint64_t PipelinedCallFunc(PackedFuncHandle func, ffi::PackedArgs args,
+                                     FAsyncCallback callback);
+
+  /*!
+   * \brief Pipelined version of CopyToRemote.
+   * \param local_from_bytes The source host data, which is copied before the function returns.
+   * \param remote_to The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param on_complete The callback to signal copy complete.
+   * \return The id of the request, to be passed to WaitPipelined.
+   */
+  virtual uint64_t PipelinedCopyToRemote(void* local_from_bytes, DLTensor* remote_to,
+                                         uint64_t nbytes, FAsyncCallback on_complete);
+
+  /*!
+   * \brief Pipelined version of CopyFromRemote.
+   * \param remote_from The source array.
+   * \param local_to_bytes The target host data.
+   * \param nbytes The size of the memory in bytes.
+   * \param on_complete The callback to signal copy complete.
+   * \return The id of the request, to be passed to WaitPipelined.
+   * \note local_to_bytes must stay alive until on_complete is called.
+   */
+  virtual uint64_t PipelinedCopyFromRemote(DLTensor* remote_from, void* local_to_bytes,
+                                           uint64_t nbytes, FAsyncCallback on_complete);
+
+  /*!
+   * \brief Wait until a pipelined request, and all the ones issued before it, complete.
+   * \param request_id The id of the request.
+   */
+  virtual void WaitPipelined(uint64_t request_id) {}
+
   /*!
    * \return The session table index of the session.
    */
@@ -264,6 +312,8 @@ class RPCSession {
  private:
   /*! \brief index of this session in RPC session table */
   int table_index_{0};
+  /*! \brief The id of the last request run by the default pipelined APIs. */
+  uint64_t last_pipelined_request_id_{0};
   /*! \brief Insert the current session to the session table.*/
   static void InsertToSessionTable(std::shared_ptr<RPCSession> sess);
   // friend declaration
@@ -24,6 +24,7 @@
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/base.h>
+#include <tvm/runtime/builtin_fp16.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/tensor.h>
@@ -234,6 +235,40 @@ void Tensor::CopyFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle stre
   DeviceAPI::Get(dev)->CopyDataFromTo(const_cast<DLTensor*>(from), to, stream);
 }
 
+/*!
+ * \brief Convert the elements of a CPU tensor between float32 and float16 or bfloat16.
+ * \param from The source tensor.
+ * \param to The destination tensor, of the same shape.
+ */
+void TensorConvertFloat(const DLTensor* from, DLTensor* to) {
+  TVM_FFI_ICHECK(from->device.device_type == kDLCPU && to->device.device_type == kDLCPU)
+      << "TensorConvertFloat expects CPU tensors";
+  TVM_FFI_ICHECK(IsContiguous(*from) && IsContiguous(*to))
+      << "TensorConvertFloat expects contiguous tensors";
+  int64_t n = 1;
+  TVM_FFI_ICHECK_EQ(from->ndim, to->ndim) << "TensorConvertFloat expects tensors of the same shape";
+  for (int i = 0; i < from->ndim; ++i) {
+    TVM_FFI_ICHECK_EQ(from->shape[i], to->shape[i])
+        << "TensorConvertFloat expects tensors of the same shape";
+    n *= from->shape[i];
+  }
+  DataType from_dtype(from->dtype), to_dtype(to->dtype);
+  const void* src = static_cast<const char*>(from->data) + from->byte_offset;
+  void* dst = static_cast<char*>(to->data) + to->byte_offset;
+  if (from_dtype == DataType::Float(32) && to_dtype == DataType::Float(16)) {
+    TVMConvertFloatToHalf(static_cast<const float*>(src), static_cast<uint16_t*>(dst), n);
+  } else if (from_dtype == DataType::Float(16) && to_dtype == DataType::Float(32)) {
+    TVMConvertHalfToFloat(static_cast<const uint16_t*>(src), static_cast<float*>(dst), n);
+  } else if (from_dtype == DataType::Float(32) && to_dtype == DataType::BFloat(16)) {
+    TVMConvertFloatToBFloat16(static_cast<const float*>(src), static_cast<uint16_t*>(dst), n);
+  } else if (from_dtype == DataType::BFloat(16) && to_dtype == DataType::Float(32)) {
+    TVMConvertBFloat16ToFloat(static_cast<const uint16_t*>(src), static_cast<float*>(dst), n);
+  } else {
+    TVM_FFI_THROW(ValueError) << "TensorConvertFloat does not support the conversion from "
+                              << from_dtype << " to " << to_dtype;
+  }
+}
+
 }  // namespace runtime
 }  // namespace tvm
 
@@ -249,5 +284,6 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("runtime.TVMTensorCopyToBytes",
            [](DLTensor* arr, void* data, size_t nbytes) { Tensor::CopyToBytes(arr, data, nbytes); })
       .def("runtime.TVMTensorCopyFromTo",
-           [](DLTensor* from, DLTensor* to) { Tensor::CopyFromTo(from, to); });
+           [](DLTensor* from, DLTensor* to) { Tensor::CopyFromTo(from, to); })
+      .def("runtime.TVMTensorConvertFloat", TensorConvertFloat);
 }
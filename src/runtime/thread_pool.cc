@@ -33,8 +33,10 @@
 #endif
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstring>
+#include <iomanip>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -42,6 +44,7 @@
 #include <thread>
 #include <vector>
 
+#include "../support/env.h"
 #include "../support/utils.h"
 const constexpr int kL1CacheBytes = 64;
 
@@ -50,6 +53,7 @@ namespace runtime {
 namespace {
 using support::IsNumber;
 constexpr uint32_t kDefaultSpinCount = 300000;
+constexpr int kDefaultChunksPerWorker = 4;
 
 uint32_t GetSpinCount() {
   const char* val = getenv("TVM_THREAD_POOL_SPIN_COUNT");
@@ -59,11 +63,199 @@ uint32_t GetSpinCount() {
   return atoi(val);
 }
 
+int GetChunksPerWorker() {
+  const char* val = getenv("TVM_THREAD_POOL_CHUNKS_PER_WORKER");
+  if (!val || atoi(val) <= 0) {
+    return kDefaultChunksPerWorker;
+  }
+  return atoi(val);
+}
+
 }  // namespace
 
 // stride in the page, fit to cache line.
 constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
 
+/*!
+ * \brief Opt-in tracing of the thread pool hot path.
+ *
+ *  Each thread records launch, task, wait and sleep events into its own ring buffer, so
+ *  the disabled path costs one relaxed atomic load and the enabled path takes no lock.
+ *  The events are dumped in the Chrome trace event format (chrome://tracing, Perfetto).
+ *  Tracing is enabled by TVM_THREAD_POOL_TRACE=1 or runtime.threadpool_trace_enable, and
+ *  TVM_THREAD_POOL_TRACE_CAPACITY sets the number of events kept per thread.
+ */
+class ThreadPoolTracer {
+ public:
+  enum EventKind : uint8_t {
+    kLaunch,
+    kTaskBegin,
+    kTaskEnd,
+    kWaitBegin,
+    kWaitEnd,
+    kSleepBegin,
+    kSleepEnd,
+  };
+
+  static ThreadPoolTracer* Global() {
+    // NOTE: explicitly use new so that worker threads exiting late can still record.
+    static auto* inst = new ThreadPoolTracer();
+    return inst;
+  }
+
+  /*!
+   * \brief Record an event of the calling thread.
+   * \param kind The event kind.
+   * \param value The task id of task events, the number of tasks of launch events.
+   */
+  static void Record(EventKind kind, int32_t value = -1) {
+    if (!enabled_.load(std::memory_order_relaxed)) return;
+    Global()->LocalBuffer()->Push(kind, value, Global()->Now());
+  }
+
+  /*! \brief Name the trace track of the calling thread after its worker id. */
+  static void SetWorkerId(int worker_id) { worker_id_ = worker_id; }
+
+  void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  /*!
+   * \brief Drop recorded events, and the buffers of threads that have exited.
+   * \note Call it while the pool is idle.
+   */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<ThreadBuffer>> alive;
+    for (auto& buf : buffers_) {
+      // Only the registry and the thread_local owner hold the buffer.
+      if (buf.use_count() > 1) {
+        buf->count.store(0, std::memory_order_relaxed);
+        alive.push_back(buf);
+      }
+    }
+    buffers_ = std::move(alive);
+  }
+
+  /*!
+   * \brief Dump the recorded events as Chrome trace JSON.
+   * \note Events recorded concurrently with the dump may be torn, disable tracing first.
+   */
+  std::string DumpJSON() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    auto begin_event = [&](const char* name, const char* phase, int tid) {
+      os << (first ? "" : ",") << "\n  {\"name\": \"" << name << "\", \"ph\": \"" << phase
+         << "\", \"pid\": 0, \"tid\": " << tid;
+      first = false;
+    };
+    for (const auto& buf : buffers_) {
+      begin_event("thread_name", "M", buf->tid);
+      os << ", \"args\": {\"name\": \"" << buf->name << "\"}}";
+      uint64_t count = buf->count.load(std::memory_order_acquire);
+      uint64_t start = count > buf->ring.size() ? count - buf->ring.size() : 0;
+      // Skip the ends whose begins have been overwritten by the ring buffer.
+      int depth = 0;
+      for (uint64_t i = start; i < count; ++i) {
+        const Event& e = buf->ring[i & buf->mask];
+        const char* name = nullptr;
+        bool is_begin = false;
+        switch (e.kind) {
+          case kLaunch:
+            begin_event("launch", "i", buf->tid);
+            os << ", \"s\": \"t\", \"ts\": " << e.ts * 1e-3
+               << ", \"args\": {\"num_task\": " << e.value << "}}";
+            continue;
+          case kTaskBegin:
+          case kTaskEnd:
+            name = "task";
+            is_begin = e.kind == kTaskBegin;
+            break;
+          case kWaitBegin:
+          case kWaitEnd:
+            name = "wait";
+            is_begin = e.kind == kWaitBegin;
+            break;
+          case kSleepBegin:
+          case kSleepEnd:
+            name = "sleep";
+            is_begin = e.kind == kSleepBegin;
+            break;
+        }
+        if (!is_begin && depth == 0) continue;
+        depth += is_begin ? 1 : -1;
+        begin_event(name, is_begin ? "B" : "E", buf->tid);
+        os << ", \"ts\": " << e.ts * 1e-3;
+        if (e.kind == kTaskBegin) os << ", \"args\": {\"task_id\": " << e.value << "}";
+        os << "}";
+      }
+    }
+    os << "\n]}\n";
+    return os.str();
+  }
+
+ private:
+  struct Event {
+    uint64_t ts;
+    int32_t value;
+    EventKind kind;
+  };
+  /*! \brief Single-writer ring buffer of one thread. */
+  struct ThreadBuffer {
+    ThreadBuffer(int tid, std::string name, size_t capacity)
+        : tid(tid), name(std::move(name)), ring(capacity), mask(capacity - 1) {}
+    void Push(EventKind kind, int32_t value, uint64_t ts) {
+      uint64_t idx = count.load(std::memory_order_relaxed);
+      ring[idx & mask] = Event{ts, value, kind};
+      count.store(idx + 1, std::memory_order_release);
+    }
+    int tid;
+    std::string name;
+    std::vector<Event> ring;
+    uint64_t mask;
+    std::atomic<uint64_t> count{0};
+  };
+
+  ThreadPoolTracer() : epoch_(std::chrono::steady_clock::now()) {
+    // Round the capacity up to a power of two for cheap wrapping.
+    size_t capacity = support::GetEnv("TVM_THREAD_POOL_TRACE_CAPACITY", size_t(1) << 16);
+    capacity_ = 1;
+    while (capacity_ < capacity) capacity_ <<= 1;
+    enabled_.store(support::GetEnv("TVM_THREAD_POOL_TRACE", false), std::memory_order_relaxed);
+  }
+
+  uint64_t Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                epoch_)
+        .count();
+  }
+
+  ThreadBuffer* LocalBuffer() {
+    static thread_local std::shared_ptr<ThreadBuffer> local;
+    if (local == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      int tid = next_tid_++;
+      std::string name = worker_id_ < 0 ? "main " + std::to_string(tid)
+                                          : "worker " + std::to_string(worker_id_);
+      local = std::make_shared<ThreadBuffer>(tid, std::move(name), capacity_);
+      buffers_.push_back(local);
+    }
+    return local.get();
+  }
+
+  static std::atomic<bool> enabled_;
+  static thread_local int worker_id_;
+  std::chrono::steady_clock::time_point epoch_;
+  size_t capacity_;
+  std::mutex mutex_;
+  int next_tid_{0};
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+std::atomic<bool> ThreadPoolTracer::enabled_{false};
+thread_local int ThreadPoolTracer::worker_id_ = -1;
+
 /*!
  * \brief Thread local main environment.
  */
@@ -75,6 +267,7 @@ class ParallelLauncher {
     this->cdata = cdata;
     this->flambda = flambda;
     this->env.num_task = num_task;
+    this->num_chunk = 0;
     has_error_.store(false);
     // reshape
     if (static_cast<size_t>(num_task) > par_errors_.size()) {
@@ -93,7 +286,30 @@ class ParallelLauncher {
       this->env.sync_handle = nullptr;
     }
   }
+  // Reset the request of a chunked launch served by num_task workers.
+  void InitChunked(FTVMParallelLambda flambda, void* cdata, int num_task, int num_chunk) {
+    this->Init(flambda, cdata, num_task, false);
+    this->num_chunk = num_chunk;
+    this->env.num_task = num_chunk;
+    next_chunk_.store(0, std::memory_order_relaxed);
+  }
   ~ParallelLauncher() { delete[] sync_counter_; }
+  // Claim and run chunks until none is left, then signal the job of task_id.
+  void RunChunks(int task_id) {
+    int chunk;
+    while ((chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed)) < num_chunk) {
+      ThreadPoolTracer::Record(ThreadPoolTracer::kTaskBegin, chunk);
+      int ret = (*flambda)(chunk, &env, cdata);
+      ThreadPoolTracer::Record(ThreadPoolTracer::kTaskEnd);
+      if (ret != 0) {
+        // Stop the other workers from claiming further chunks.
+        next_chunk_.store(num_chunk, std::memory_order_relaxed);
+        SignalJobError(task_id);
+        return;
+      }
+    }
+    SignalJobFinish();
+  }
   // Wait n jobs to finish
   int WaitForJobs() {
     while (num_pending_.load() != 0) {
@@ -131,6 +347,8 @@ class ParallelLauncher {
   void* cdata;
   // Local env
   TVMParallelGroupEnv env;
+  // Number of chunks of a chunked launch, 0 when each task runs exactly once.
+  int num_chunk{0};
   // Whether this thread is worker of the pool.
   // used to prevent recursive launch.
   bool is_worker{false};
@@ -140,6 +358,8 @@ class ParallelLauncher {
   std::atomic<int32_t> num_pending_;
   // Whether error has been countered.
   std::atomic<bool> has_error_;
+  // The next unclaimed chunk of a chunked launch.
+  std::atomic<int32_t> next_chunk_{0};
   // The counter page.
   std::atomic<int32_t>* sync_counter_{nullptr};
   // The error message
@@ -187,8 +407,12 @@ class SpscTaskQueue {
       tvm::runtime::threading::YieldThread();
     }
     if (pending_.fetch_sub(1) == 0) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      cv_.wait(lock, [this] { return pending_.load() >= 0 || exit_now_.load(); });
+      ThreadPoolTracer::Record(ThreadPoolTracer::kSleepBegin);
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_.load() >= 0 || exit_now_.load(); });
+      }
+      ThreadPoolTracer::Record(ThreadPoolTracer::kSleepEnd);
     }
     if (exit_now_.load(std::memory_order_relaxed)) {
       return false;
@@ -301,6 +525,7 @@ class ThreadPool {
           << " workers=" << num_workers_used_ << " request=" << num_task;
     }
     launcher->Init(flambda, cdata, num_task, need_sync != 0);
+    ThreadPoolTracer::Record(ThreadPoolTracer::kLaunch, num_task);
     SpscTaskQueue::Task tsk;
     tsk.launcher = launcher;
     // if worker0 is taken by the main, queues_[0] is abandoned
@@ -311,13 +536,45 @@ class ThreadPool {
     // use the main thread to run task 0
     if (exclude_worker0_) {
       TVMParallelGroupEnv* penv = &(tsk.launcher->env);
-      if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
+      ThreadPoolTracer::Record(ThreadPoolTracer::kTaskBegin, 0);
+      int ret = (*tsk.launcher->flambda)(0, penv, cdata);
+      ThreadPoolTracer::Record(ThreadPoolTracer::kTaskEnd);
+      if (ret == 0) {
         tsk.launcher->SignalJobFinish();
       } else {
         tsk.launcher->SignalJobError(tsk.task_id);
       }
     }
+    ThreadPoolTracer::Record(ThreadPoolTracer::kWaitBegin);
     int res = launcher->WaitForJobs();
+    ThreadPoolTracer::Record(ThreadPoolTracer::kWaitEnd);
+    return res;
+  }
+
+  int LaunchChunked(FTVMParallelLambda flambda, void* cdata, int num_chunk) {
+    ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
+    TVM_FFI_ICHECK(!launcher->is_worker)
+        << "Cannot launch parallel job inside worker, consider fuse then parallel";
+    static int chunks_per_worker = GetChunksPerWorker();
+    if (num_chunk <= 0) {
+      num_chunk = num_workers_used_ * chunks_per_worker;
+    }
+    // Each worker (and the main thread) claims chunks until all of them are taken.
+    int num_task = std::min(num_workers_used_, num_chunk);
+    launcher->InitChunked(flambda, cdata, num_task, num_chunk);
+    ThreadPoolTracer::Record(ThreadPoolTracer::kLaunch, num_chunk);
+    SpscTaskQueue::Task tsk;
+    tsk.launcher = launcher;
+    for (int i = exclude_worker0_; i < num_task; ++i) {
+      tsk.task_id = i;
+      queues_[i]->Push(tsk);
+    }
+    if (exclude_worker0_) {
+      launcher->RunChunks(0);
+    }
+    ThreadPoolTracer::Record(ThreadPoolTracer::kWaitBegin);
+    int res = launcher->WaitForJobs();
+    ThreadPoolTracer::Record(ThreadPoolTracer::kWaitEnd);
     return res;
   }
 
@@ -356,15 +613,23 @@ class ThreadPool {
     SpscTaskQueue* queue = queues_[worker_id].get();
     SpscTaskQueue::Task task;
     ParallelLauncher::ThreadLocal()->is_worker = true;
+    ThreadPoolTracer::SetWorkerId(worker_id);
     // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
     // the global first use of the ThreadPool.
     // TODO(tulloch): should we make this configurable via standard APIs?
     static size_t spin_count = GetSpinCount();
     while (queue->Pop(&task, spin_count)) {
       TVM_FFI_ICHECK(task.launcher != nullptr);
+      if (task.launcher->num_chunk != 0) {
+        task.launcher->RunChunks(task.task_id);
+        continue;
+      }
       TVMParallelGroupEnv* penv = &(task.launcher->env);
       void* cdata = task.launcher->cdata;
-      if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
+      ThreadPoolTracer::Record(ThreadPoolTracer::kTaskBegin, task.task_id);
+      int ret = (*task.launcher->flambda)(task.task_id, penv, cdata);
+      ThreadPoolTracer::Record(ThreadPoolTracer::kTaskEnd);
+      if (ret == 0) {
         task.launcher->SignalJobFinish();
       } else {
         task.launcher->SignalJobError(task.task_id);
@@ -403,7 +668,12 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                     }
                     threading::Configure(mode, nthreads, cpus);
                   })
-      .def("runtime.NumThreads", []() -> int32_t { return threading::NumThreads(); });
+      .def("runtime.NumThreads", []() -> int32_t { return threading::NumThreads(); })
+      .def("runtime.threadpool_trace_enable",
+           [](bool enabled) { ThreadPoolTracer::Global()->SetEnabled(enabled); })
+      .def("runtime.threadpool_trace_clear", []() { ThreadPoolTracer::Global()->Clear(); })
+      .def("runtime.threadpool_trace_dump",
+           []() -> ffi::String { return ThreadPoolTracer::Global()->DumpJSON(); });
 }
 
 namespace threading {
@@ -508,6 +778,31 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
   }
 }
 
+int TVMBackendParallelLaunchChunked(FTVMParallelLambda flambda, void* cdata, int num_chunk) {
+  int num_workers = tvm::runtime::threading::MaxConcurrency();
+  if (num_workers == 1) {
+    TVMParallelGroupEnv env;
+    env.num_task = 1;
+    env.sync_handle = nullptr;
+    return (*flambda)(0, &env, cdata);
+  } else {
+#if !TVM_THREADPOOL_USE_OPENMP
+    return tvm::runtime::ThreadPool::ThreadLocal()->LaunchChunked(flambda, cdata, num_chunk);
+#else
+    if (num_chunk <= 0) num_chunk = num_workers * tvm::runtime::GetChunksPerWorker();
+    TVMParallelGroupEnv env;
+    env.num_task = num_chunk;
+    env.sync_handle = nullptr;
+    std::atomic<bool> has_error{false};
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_workers)
+    for (int chunk = 0; chunk < num_chunk; ++chunk) {
+      if ((*flambda)(chunk, &env, cdata) != 0) has_error.store(true);
+    }
+    return has_error.load() ? -1 : 0;
+#endif
+  }
+}
+
 int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) {
 #if TVM_THREADPOOL_USE_OPENMP
 #pragma omp barrier
@@ -25,6 +25,7 @@
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/tensor.h>
 #include <tvm/runtime/threading_backend.h>
 
 #if defined(__linux__) || defined(__ANDROID__)
@@ -37,6 +38,8 @@
 #endif
 #if defined(__linux__)
 #include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 #if defined(__hexagon__)
 extern "C" {
@@ -49,7 +52,10 @@ extern "C" {
 #define HEXAGON_STACK_ALIGNMENT 32
 #endif
 #include <algorithm>
+#include <cstdint>
+#include <string>
 #include <thread>
+#include <vector>
 #define CURRENT_THREAD_HANDLE (static_cast<std::thread::native_handle_type>(0))
 namespace tvm {
 namespace runtime {
@@ -142,6 +148,125 @@ void SetThreadAffinity(std::thread::native_handle_type thread,
 #endif
 }
 
+namespace {
+
+#if defined(__linux__)
+// Parse a sysfs CPU or node list such as "0-3,8-11".
+std::vector<unsigned int> ParseIdList(const std::string& list) {
+  std::vector<unsigned int> ids;
+  std::istringstream is(list);
+  std::string range;
+  while (std::getline(is, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    size_t dash = range.find('-');
+    unsigned int first = std::stoul(range.substr(0, dash));
+    unsigned int last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+    for (unsigned int id = first; id <= last; ++id) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+#endif
+
+/*! \brief The NUMA topology of the system, discovered once from sysfs. */
+struct NumaTopology {
+  /*! \brief The NUMA node of each logical CPU. */
+  std::vector<int> node_of_cpu;
+  /*! \brief The largest NUMA node id plus one. */
+  int num_nodes{1};
+
+  static const NumaTopology& Global() {
+    static NumaTopology inst;
+    return inst;
+  }
+
+ private:
+  NumaTopology() {
+#if defined(__linux__)
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string nodes;
+    if (!online.fail() && std::getline(online, nodes)) {
+      for (unsigned int node : ParseIdList(nodes)) {
+        std::ifstream ifs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string cpus;
+        if (ifs.fail() || !std::getline(ifs, cpus)) continue;
+        for (unsigned int cpu : ParseIdList(cpus)) {
+          if (cpu >= node_of_cpu.size()) node_of_cpu.resize(cpu + 1, 0);
+          node_of_cpu[cpu] = static_cast<int>(node);
+        }
+        num_nodes = std::max(num_nodes, static_cast<int>(node) + 1);
+      }
+    }
+#endif
+  }
+};
+
+#if defined(__linux__) && defined(SYS_mbind)
+// Memory policies of mbind(2), defined here to avoid depending on libnuma.
+constexpr int kMPolBind = 2;
+constexpr int kMPolInterleave = 3;
+constexpr unsigned kMPolMFMove = 1 << 1;
+
+bool ApplyMemoryPolicy(void* ptr, size_t size, int mode, const std::vector<int>& nodes) {
+  const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  // Only touch the pages fully covered by the range, the others may be shared with
+  // neighbouring allocations.
+  uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + page_size - 1) / page_size * page_size;
+  uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size) / page_size * page_size;
+  if (begin >= end) return false;
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;  // NOLINT(runtime/int)
+  int max_node = *std::max_element(nodes.begin(), nodes.end());
+  std::vector<unsigned long> mask(max_node / kBitsPerWord + 1, 0);  // NOLINT(runtime/int)
+  for (int node : nodes) {
+    mask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+  }
+  long ret = syscall(SYS_mbind, begin, end - begin, mode, mask.data(),  // NOLINT(runtime/int)
+                     mask.size() * kBitsPerWord + 1, kMPolMFMove);
+  return ret == 0;
+}
+#endif
+
+}  // namespace
+
+int NumaNodeCount() { return NumaTopology::Global().num_nodes; }
+
+int NumaNodeOfCpu(unsigned int cpu) {
+  const NumaTopology& topo = NumaTopology::Global();
+  return cpu < topo.node_of_cpu.size() ? topo.node_of_cpu[cpu] : 0;
+}
+
+int CurrentNumaNode() {
+#if defined(__linux__)
+  if (NumaNodeCount() == 1) return 0;
+  int cpu = sched_getcpu();
+  return cpu < 0 ? 0 : NumaNodeOfCpu(cpu);
+#else
+  return 0;
+#endif
+}
+
+bool BindMemoryToNumaNode(void* ptr, size_t size, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (NumaNodeCount() == 1) return false;
+  return ApplyMemoryPolicy(ptr, size, kMPolBind, {node});
+#else
+  return false;
+#endif
+}
+
+bool InterleaveMemoryAcrossNumaNodes(void* ptr, size_t size) {
+#if defined(__linux__) && defined(SYS_mbind)
+  int num_nodes = NumaNodeCount();
+  if (num_nodes == 1) return false;
+  std::vector<int> nodes(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) nodes[i] = i;
+  return ApplyMemoryPolicy(ptr, size, kMPolInterleave, nodes);
+#else
+  return false;
+#endif
+}
+
 thread_local int max_concurrency = 0;
 class ThreadGroup::Impl {
  public:
@@ -327,9 +452,13 @@ class ThreadGroup::Impl {
       max_freqs.push_back(std::make_pair(i, cur_freq));
     }
 
+    // Cores of the same frequency are grouped by NUMA node, so that consecutive workers
+    // fill up one node before spilling to the next one.
     auto fcmpbyfreq = [](const std::pair<unsigned int, int64_t>& a,
                          const std::pair<unsigned int, int64_t>& b) {
-      return a.second == b.second ? a.first < b.first : a.second > b.second;
+      if (a.second != b.second) return a.second > b.second;
+      int node_a = NumaNodeOfCpu(a.first), node_b = NumaNodeOfCpu(b.first);
+      return node_a == node_b ? a.first < b.first : node_a < node_b;
     };
     std::stable_sort(max_freqs.begin(), max_freqs.end(), fcmpbyfreq);
     int64_t big_freq = max_freqs.begin()->second;
@@ -440,10 +569,18 @@ int MaxConcurrency() {
 // to CPUs.
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def(
-      "tvm.runtime.threading.set_current_thread_affinity", [](ffi::Shape cpu_ids) {
-        SetThreadAffinity(CURRENT_THREAD_HANDLE,
-                          std::vector<unsigned int>{cpu_ids.begin(), cpu_ids.end()});
+  refl::GlobalDef()
+      .def("tvm.runtime.threading.set_current_thread_affinity",
+           [](ffi::Shape cpu_ids) {
+             SetThreadAffinity(CURRENT_THREAD_HANDLE,
+                               std::vector<unsigned int>{cpu_ids.begin(), cpu_ids.end()});
+           })
+      .def("runtime.NumaNodeCount", []() -> int { return NumaNodeCount(); })
+      .def("runtime.numa_interleave_tensor", [](Tensor tensor) -> bool {
+        TVM_FFI_ICHECK_EQ(tensor->device.device_type, kDLCPU)
+            << "Only host tensors can be interleaved across NUMA nodes";
+        return InterleaveMemoryAcrossNumaNodes(static_cast<char*>(tensor->data) + tensor->byte_offset,
+                                               GetDataSize(*tensor.operator->()));
       });
 }
 
@@ -51,6 +51,11 @@ constexpr const int kIntAttnWorkspaceByte = 8 * 1024 * 1024;
 constexpr const int kFloatAttnWorkspaceByte = 768 * 1024 * 1024;
 /*! \brief The id of the temporary logical page, which is useful for sliding window. */
 constexpr const int kPagedKVCacheTempPageId = -1;
+/*!
+ * \brief The id of the first internal sequence created by the prefix cache.
+ * It is kept far away from user sequence ids and the temporary ids used by PopN.
+ */
+constexpr const int64_t kPrefixCacheSeqIdBegin = std::numeric_limits<int64_t>::min() / 2;
 
 /*!
  * \brief The supported attention kinds in PagedKVCache.
@@ -96,8 +101,9 @@ inline ffi::Shape GetKVCacheShape(AttnKind attn_kind, int64_t num_total_pages, i
 struct Block {
   /*!
    * \brief The ids of the pages in the block.
-   * Each page can only be used by a unique block (in other
-   * words, different blocks do not share pages).
+   * The full pages are used by a unique block. The page that a sequence
+   * is forked inside is shared by the blocks on both sides of the fork,
+   * and is copied on write.
    */
   std::vector<int32_t> page_ids;
   /*! \brief The total sequence length in the block. */
@@ -386,6 +392,25 @@ class HostMemoryVector {
 
   void clear() { current_size_ = 0; }
 
+  /*!
+   * \brief Resize the vector to the given size, growing the reserved storage when needed.
+   * \note The values of the newly added elements are undefined.
+   */
+  void resize(int64_t new_size) {
+    TVM_FFI_ICHECK_GE(new_size, 0);
+    if (new_size > reserved_size_) {
+      int64_t new_reserved_size = std::max<int64_t>(reserved_size_, 1);
+      while (new_reserved_size < new_size) {
+        new_reserved_size *= 2;
+      }
+      Tensor new_data = Tensor::Empty({new_reserved_size}, data_->dtype, data_->device);
+      std::memcpy(new_data->data, data_->data, current_size_ * DataType(data_->dtype).bytes());
+      data_ = new_data;
+      reserved_size_ = new_reserved_size;
+    }
+    current_size_ = new_size;
+  }
+
   /*! \brief Return the vector as an Tensor. */
   Tensor as_tensor() { return data_.CreateView({current_size_}, data_->dtype); }
 
@@ -515,14 +540,20 @@ class PagedKVCacheAuxDataManager {
 /*!
  * \brief The plain auxiliary data manager class.
  * It simply issues one host-to-device copy operation for each `CopyXXXAsync`.
+ * Every auxiliary array has its standalone device buffer, and thus a fixed address.
+ * When `fixed_capacity_page_indices` is true, the page indices are returned as
+ * the full-capacity buffer, so that the array shapes seen by the attention kernels
+ * only depend on the batch size.
  */
 class PlainPagedKVCacheAuxDataManager : public PagedKVCacheAuxDataManager {
  public:
   explicit PlainPagedKVCacheAuxDataManager(int64_t reserved_num_seqs, int64_t num_total_pages,
                                            int64_t prefill_chunk_size, DLDataType dtype_aux,
                                            Device device, Device preferred_host_device,
-                                           TVMStreamHandle copy_stream)
-      : PagedKVCacheAuxDataManager(dtype_aux, device, preferred_host_device, copy_stream) {
+                                           TVMStreamHandle copy_stream,
+                                           bool fixed_capacity_page_indices = false)
+      : PagedKVCacheAuxDataManager(dtype_aux, device, preferred_host_device, copy_stream),
+        fixed_capacity_page_indices_(fixed_capacity_page_indices) {
     for (int d = 0; d < kPagedKVCacheMaxBlockDepth; ++d) {
       qo_indptr_on_depths_device_.push_back(
           Tensor::Empty({reserved_num_seqs + 1}, dtype_aux_, device));
@@ -575,7 +606,7 @@ class PlainPagedKVCacheAuxDataManager : public PagedKVCacheAuxDataManager {
     Tensor view = page_indices_on_depths_device_[depth].CreateView(
         {static_cast<int64_t>(data->size())}, dtype_aux_);
     CopyVecDataToArray(view, data->data());
-    return view;
+    return fixed_capacity_page_indices_ ? page_indices_on_depths_device_[depth] : view;
   }
   Tensor CopyLastPageLenOnDepthAsync(HostMemoryVector* data, int depth) final {
     Tensor view = length_info_on_depths_device_[depth].CreateView(
@@ -745,6 +776,8 @@ class PlainPagedKVCacheAuxDataManager : public PagedKVCacheAuxDataManager {
     Tensor::CopyFromTo(&copy_src, &copy_dst, copy_stream_);
   }
 
+  /*! \brief Whether to return the page indices as the full-capacity buffer. */
+  const bool fixed_capacity_page_indices_;
   std::vector<Tensor> qo_indptr_on_depths_device_;
   std::vector<Tensor> page_indptr_on_depths_device_;
   std::vector<Tensor> page_indices_on_depths_device_;
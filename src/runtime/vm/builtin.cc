@@ -34,6 +34,8 @@
 #include <tvm/runtime/vm/bytecode.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <algorithm>
+#include <map>
 #include <unordered_map>
 
 namespace tvm {
@@ -45,6 +47,55 @@ using tvm::runtime::Tensor;
 //-------------------------------------------------
 //  Shape/StructInfo handling.
 //-------------------------------------------------
+/*!
+ * \brief The VM extension holding the shape heaps of the frames. A heap is reused by the frames
+ *  of the functions of its size once the frame that allocated it returns, so that a function called
+ *  in a loop, e.g. the decoding of a model, does not allocate a heap per call.
+ */
+class ShapeHeapPoolExtensionNode : public VMExtensionNode {
+ public:
+  Tensor GetShapeHeap(VirtualMachine* vm, int64_t size) {
+    std::vector<Tensor>& heaps = heaps_[size];
+    for (const Tensor& heap : heaps) {
+      // Only the pool refers to the heaps of the frames that returned.
+      if (heap.use_count() == 1) {
+        return heap;
+      }
+    }
+    // use host allocator, which is always last element.
+    size_t host_device_index = vm->devices.size() - 1;
+    // specially handle hexagon on-device RT.
+    // TODO(relax-team): visit and consider other possible choices.
+    if (vm->devices[0].device_type == kDLHexagon) {
+      host_device_index = 0;
+    } else {
+      TVM_FFI_ICHECK_EQ(vm->devices[host_device_index].device_type, kDLCPU);
+    }
+    auto* alloc = vm->allocators[host_device_index];
+    heaps.push_back(
+        alloc->Empty({size}, DLDataType{kDLInt, 64, 1}, vm->devices[host_device_index]));
+    return heaps.back();
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("vm.ShapeHeapPoolExtension", ShapeHeapPoolExtensionNode,
+                                    VMExtensionNode);
+
+ private:
+  /*! \brief The heaps allocated, keyed by their size. */
+  std::unordered_map<int64_t, std::vector<Tensor>> heaps_;
+};
+
+/*! \brief Managed reference to ShapeHeapPoolExtensionNode. */
+class ShapeHeapPoolExtension : public VMExtension {
+ public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(ShapeHeapPoolExtension, VMExtension,
+                                             ShapeHeapPoolExtensionNode);
+  static ShapeHeapPoolExtension Create() {
+    return ShapeHeapPoolExtension(ffi::make_object<ShapeHeapPoolExtensionNode>());
+  }
+};
+
 /*!
  * \brief Builtin function to allocate shape heap.
  * \param ctx_ptr The context module pointer.
@@ -53,17 +104,7 @@ using tvm::runtime::Tensor;
  */
 Tensor AllocShapeHeap(void* ctx_ptr, int64_t size) {
   VirtualMachine* vm = static_cast<VirtualMachine*>(ctx_ptr);
-  // use host allocator, which is always last element.
-  size_t host_device_index = vm->devices.size() - 1;
-  // specially handle hexagon on-device RT.
-  // TODO(relax-team): visit and consider other possible choices.
-  if (vm->devices[0].device_type == kDLHexagon) {
-    host_device_index = 0;
-  } else {
-    TVM_FFI_ICHECK_EQ(vm->devices[host_device_index].device_type, kDLCPU);
-  }
-  auto* alloc = vm->allocators[host_device_index];
-  return alloc->Empty({size}, DLDataType{kDLInt, 64, 1}, vm->devices[host_device_index]);
+  return vm->GetOrCreateExtension<ShapeHeapPoolExtension>()->GetShapeHeap(vm, size);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -124,14 +165,18 @@ TVM_FFI_STATIC_INIT_BLOCK() {
  */
 void MatchShape(ffi::PackedArgs args, ffi::Any* rv) {
   // input shape the first argument can take in tensor, DLTensor* or shape.
-  ffi::Shape input_shape;
-  if (auto opt_tensor = args[0].as<Tensor>()) {
-    input_shape = opt_tensor.value().Shape();
-  } else if (auto opt_dltensor = args[0].try_cast<DLTensor*>()) {
+  // The shape is read in place, without creating a Shape for the DLTensor*.
+  const int64_t* input_shape;
+  int64_t input_ndim;
+  ffi::Shape shape_holder;
+  if (auto opt_dltensor = args[0].try_cast<DLTensor*>()) {
     DLTensor* ptr = opt_dltensor.value();
-    input_shape = ffi::Shape(ptr->shape, ptr->shape + ptr->ndim);
+    input_shape = ptr->shape;
+    input_ndim = ptr->ndim;
   } else {
-    input_shape = args[0].cast<ffi::Shape>();
+    shape_holder = args[0].cast<ffi::Shape>();
+    input_shape = shape_holder.data();
+    input_ndim = static_cast<int64_t>(shape_holder.size());
   }
   auto heap = args[1].try_cast<DLTensor*>();
   int64_t* heap_data = heap.has_value() ? static_cast<int64_t*>((*heap)->data) : nullptr;
@@ -140,10 +185,12 @@ void MatchShape(ffi::PackedArgs args, ffi::Any* rv) {
   TVM_FFI_ICHECK_LE(kBeginCode + size * 2, args.size());
   // a function that lazily get context for error reporting
   const int64_t kErrorContextOffset = kBeginCode + size * 2;
-  ffi::Optional<ffi::String> err_ctx = args[kErrorContextOffset].cast<ffi::String>();
+  auto err_ctx = [&]() {
+    return args[kErrorContextOffset].cast<ffi::Optional<ffi::String>>().value_or("");
+  };
 
-  TVM_FFI_CHECK_EQ(input_shape.size(), size, RuntimeError)
-      << err_ctx.value_or("") << " match_cast shape size mismatch.";
+  TVM_FFI_CHECK_EQ(input_ndim, size, RuntimeError)
+      << err_ctx() << " match_cast shape size mismatch.";
 
   for (int64_t i = 0; i < size; ++i) {
     MatchShapeCode code = static_cast<MatchShapeCode>(args[kBeginCode + i * 2].cast<int>());
@@ -151,7 +198,7 @@ void MatchShape(ffi::PackedArgs args, ffi::Any* rv) {
 
     if (code == MatchShapeCode::kAssertEqualToImm) {
       TVM_FFI_CHECK_EQ(input_shape[i], reg, RuntimeError)
-          << err_ctx.value_or("") << " match_cast error, "
+          << err_ctx() << " match_cast error, "
           << " shape[" << i << "]"
           << " mismatch to specified constant.";
     } else if (code == MatchShapeCode::kStoreToHeap) {
@@ -160,7 +207,7 @@ void MatchShape(ffi::PackedArgs args, ffi::Any* rv) {
     } else {
       TVM_FFI_ICHECK(code == MatchShapeCode::kAssertEqualToLoad);
       TVM_FFI_CHECK_EQ(input_shape[i], heap_data[reg], RuntimeError)
-          << err_ctx.value_or("") << " match_cast error, "
+          << err_ctx() << " match_cast error, "
           << " shape[" << i << "]"
           << " mismatch to a previous populated value.";
     }
@@ -243,30 +290,25 @@ TVM_FFI_STATIC_INIT_BLOCK() {
 void CheckTensorInfo(ffi::PackedArgs args, ffi::Any* rv) {
   ffi::AnyView arg = args[0];
   int ndim = args[1].cast<int>();
-  DataType dtype;
-  ffi::Optional<ffi::String> err_ctx;
-
-  if (args.size() == 3) {
-    dtype = DataType::Void();
-    err_ctx = args[2].cast<ffi::Optional<ffi::String>>();
-  } else {
-    dtype = args[2].cast<DataType>();
-    err_ctx = args[3].cast<ffi::Optional<ffi::String>>();
-  }
+  DataType dtype = args.size() == 3 ? DataType::Void() : args[2].cast<DataType>();
+  // The error context is only read when the check fails.
+  auto err_ctx = [&]() {
+    return args[args.size() - 1].cast<ffi::Optional<ffi::String>>().value_or("");
+  };
 
   auto opt_ptr = arg.try_cast<DLTensor*>();
   TVM_FFI_CHECK(opt_ptr.has_value(), TypeError)
-      << err_ctx.value_or("") << " expect a Tensor but get " << arg.GetTypeKey();
+      << err_ctx() << " expect a Tensor but get " << arg.GetTypeKey();
 
   DLTensor* ptr = opt_ptr.value();
   if (ndim != -1) {
     TVM_FFI_CHECK(ptr->ndim == ndim, ValueError)
-        << err_ctx.value_or("") << " expect Tensor with ndim " << ndim << " but get " << ptr->ndim;
+        << err_ctx() << " expect Tensor with ndim " << ndim << " but get " << ptr->ndim;
   }
 
   if (dtype != DataType::Void()) {
     TVM_FFI_CHECK(DataType(ptr->dtype) == dtype, ValueError)
-        << err_ctx.value_or("") << " expect Tensor with dtype " << dtype << " but get "
+        << err_ctx() << " expect Tensor with dtype " << dtype << " but get "
         << DataType(ptr->dtype);
   }
 }
@@ -408,6 +450,69 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       });
 }
 
+/*!
+ * \brief The VM extension holding the workspaces shared by the functions of a module
+ * that never run concurrently, see `StaticPlanBlockMemory`.
+ */
+class SharedWorkspaceExtensionNode : public VMExtensionNode {
+ public:
+  /*!
+   * \brief Get the workspace of the given index on the given device, allocating it
+   * on first use. A workspace smaller than the requested size is reallocated to at
+   * least twice its size, so that growing requests of dynamic shapes reallocate it
+   * only a logarithmic number of times.
+   */
+  Storage GetWorkspace(void* ctx_ptr, ffi::Shape buffer_shape, Index device_index,
+                       DLDataType dtype_hint, ffi::String mem_scope, int64_t workspace_index) {
+    TVM_FFI_ICHECK_EQ(buffer_shape.size(), 1) << "The shared workspace is expected to be 1-d";
+    auto key = std::make_pair(workspace_index, device_index);
+    int64_t size = buffer_shape[0];
+    if (auto it = workspaces_.find(key); it != workspaces_.end()) {
+      int64_t cur_size = it->second->buffer.size;
+      if (cur_size >= size) {
+        return it->second;
+      }
+      size = std::max(size, cur_size * 2);
+      // Release the old workspace before allocating the new one.
+      workspaces_.erase(it);
+    }
+    Storage storage =
+        VMAllocStorage(ctx_ptr, ffi::Shape({size}), device_index, dtype_hint, mem_scope);
+    workspaces_[key] = storage;
+    return storage;
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("vm.SharedWorkspaceExtension", SharedWorkspaceExtensionNode,
+                                    VMExtensionNode);
+
+ private:
+  /*! \brief The workspaces, keyed by the workspace index and the device index. */
+  std::map<std::pair<int64_t, Index>, Storage> workspaces_;
+};
+
+/*! \brief Managed reference to SharedWorkspaceExtensionNode. */
+class SharedWorkspaceExtension : public VMExtension {
+ public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(SharedWorkspaceExtension, VMExtension,
+                                             SharedWorkspaceExtensionNode);
+  static SharedWorkspaceExtension Create() {
+    return SharedWorkspaceExtension(ffi::make_object<SharedWorkspaceExtensionNode>());
+  }
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("vm.builtin.alloc_shared_workspace",
+                        [](void* ctx_ptr, ffi::Shape buffer_shape, Index device_index,
+                           DLDataType dtype_hint, ffi::String mem_scope, int64_t workspace_index) {
+                          VirtualMachine* vm = static_cast<VirtualMachine*>(ctx_ptr);
+                          auto extension = vm->GetOrCreateExtension<SharedWorkspaceExtension>();
+                          return extension->GetWorkspace(ctx_ptr, buffer_shape, device_index,
+                                                         dtype_hint, mem_scope, workspace_index);
+                        });
+}
+
 //-------------------------------------------------
 //  Closure function handling, calling convention
 //-------------------------------------------------
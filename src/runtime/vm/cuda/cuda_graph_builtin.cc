@@ -28,6 +28,9 @@
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <algorithm>
+#include <list>
+
 #include "../../../support/utils.h"
 #include "../../cuda/cuda_common.h"
 namespace tvm {
@@ -80,6 +83,7 @@ struct CUDAGraphCapturedState {
   CUDAGraphCapturedState& operator=(CUDAGraphCapturedState&& other) {
     std::swap(states, other.states);
     std::swap(exec, other.exec);
+    std::swap(lru_pos, other.lru_pos);
     return *this;
   }
 
@@ -96,6 +100,8 @@ struct CUDAGraphCapturedState {
   ObjectRef states;
   /*! \brief The instantiated cuda graph */
   cudaGraphExec_t exec = nullptr;
+  /*! \brief The position of the graph in the launch order of the graphs of its capture function */
+  std::list<ffi::Shape>::iterator lru_pos;
 };
 
 class ScopedCUDAStream {
@@ -148,19 +154,27 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
    * tuple contains the intermediate tensors that will be used outside the capture function.
    * \param args The static arguments of the capture function
    * \param entry_index The unique index of the capture function used for lookup.
+   * \param shape_expr The values of the symbolic variables the capture function depends on.
+   * \param buckets The values of each symbolic variable to capture, empty to capture any value.
+   * The capture function is run without CUDA graph for the values outside of the buckets.
+   * \param max_num_graphs The maximum number of graphs kept for the capture function, evicting
+   * the least recently launched one, or 0 for no limit.
    * \return The return value of the capture function.
    */
   ObjectRef RunOrCapture(VirtualMachine* vm, const ObjectRef& capture_func, Any args,
-                         int64_t entry_index, ffi::Optional<ffi::Shape> shape_expr) {
+                         int64_t entry_index, ffi::Optional<ffi::Shape> shape_expr,
+                         ffi::Array<ffi::Shape> buckets = {}, int64_t max_num_graphs = 0) {
     CUDAGraphCaptureKey entry_key{entry_index, shape_expr};
     if (auto it = capture_cache_.find(entry_key); it != capture_cache_.end()) {
       // Launch CUDA graph
-      const auto& [states, exec] = it->second;
+      auto& entry = it->second;
+      std::list<ffi::Shape>& lru = lru_[entry_index];
+      lru.splice(lru.begin(), lru, entry.lru_pos);
       int device_id;
       CUDA_CALL(cudaGetDevice(&device_id));
-      CUDA_CALL(
-          cudaGraphLaunch(exec, static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, device_id))));
-      return states;
+      CUDA_CALL(cudaGraphLaunch(
+          entry.exec, static_cast<cudaStream_t>(TVMFFIEnvGetStream(kDLCUDA, device_id))));
+      return entry.states;
     }
 
     // Set up arguments for the graph execution
@@ -177,6 +191,9 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
     // of the CUDA module such as loading module data, setting kernel attributes.
     vm->InvokeClosurePacked(capture_func, ffi::PackedArgs(packed_args.data(), nargs),
                             &capture_func_rv);
+    if (!InBuckets(entry_key.shape_expr, buckets)) {
+      return capture_func_rv.cast<ObjectRef>();
+    }
 
     // Run the graph in capture mode
     cudaGraph_t graph;
@@ -194,6 +211,12 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
 
     ObjectRef states = entry.states;
 
+    std::list<ffi::Shape>& lru = lru_[entry_index];
+    if (max_num_graphs > 0 && static_cast<int64_t>(lru.size()) >= max_num_graphs) {
+      capture_cache_.erase(CUDAGraphCaptureKey{entry_index, lru.back()});
+      lru.pop_back();
+    }
+    entry.lru_pos = lru.insert(lru.begin(), entry_key.shape_expr);
     capture_cache_[entry_key] = std::move(entry);
 
     return states;
@@ -223,6 +246,22 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
                                     VMExtensionNode);
 
  private:
+  /*! \brief Whether each value of the shape expr is in the buckets of its symbolic variable. */
+  static bool InBuckets(const ffi::Shape& shape_expr, const ffi::Array<ffi::Shape>& buckets) {
+    if (buckets.empty()) {
+      return true;
+    }
+    TVM_FFI_ICHECK_EQ(buckets.size(), shape_expr.size());
+    for (size_t i = 0; i < shape_expr.size(); ++i) {
+      const ffi::Shape& values = buckets[i];
+      if (!values.empty() &&
+          std::find(values.begin(), values.end(), shape_expr[i]) == values.end()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   /*!
    * \brief The cache of captured cuda graphs. The key is a unique index for the capture function.
    * The value is the result of the capture.
@@ -235,6 +274,11 @@ class CUDAGraphExtensionNode : public VMExtensionNode {
    * The value is the cached allocations, which is a tuple of storages.
    */
   std::unordered_map<int64_t, ObjectRef> alloc_cache_;
+  /*!
+   * \brief The shape exprs of the cached graphs of each capture function, from the most recently
+   * launched one.
+   */
+  std::unordered_map<int64_t, std::list<ffi::Shape>> lru_;
 };
 
 /*! Managed reference to CUDAGraphExtensionNode */
@@ -253,18 +297,24 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef()
       .def_packed("vm.builtin.cuda_graph.run_or_capture",
                   [](ffi::PackedArgs args, ffi::Any* rv) {
-                    TVM_FFI_ICHECK(args.size() == 5 || args.size() == 4);
+                    TVM_FFI_ICHECK(args.size() >= 4 && args.size() <= 7 && args.size() != 6);
                     VirtualMachine* vm = VirtualMachine::GetContextPtr(args[0]);
                     auto extension = vm->GetOrCreateExtension<CUDAGraphExtension>();
                     auto capture_func = args[1].cast<ObjectRef>();
                     Any func_args = args[2];
                     int64_t entry_index = args[3].cast<int64_t>();
                     ffi::Optional<ffi::Shape> shape_expr = std::nullopt;
-                    if (args.size() == 5) {
+                    if (args.size() >= 5) {
                       shape_expr = args[4].cast<ffi::Shape>();
                     }
+                    ffi::Array<ffi::Shape> buckets;
+                    int64_t max_num_graphs = 0;
+                    if (args.size() == 7) {
+                      buckets = args[5].cast<ffi::Array<ffi::Shape>>();
+                      max_num_graphs = args[6].cast<int64_t>();
+                    }
                     *rv = extension->RunOrCapture(vm, capture_func, func_args, entry_index,
-                                                  shape_expr);
+                                                  shape_expr, buckets, max_num_graphs);
                   })
       .def_packed("vm.builtin.cuda_graph.get_cached_alloc", [](ffi::PackedArgs args, ffi::Any* rv) {
         TVM_FFI_ICHECK_EQ(args.size(), 3);
@@ -22,13 +22,17 @@
  */
 
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/vm/executable.h>
 #include <tvm/runtime/vm/vm.h>
 #include <tvm/support/io.h>
 
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include "../../support/bytes_io.h"
 #include "../file_utils.h"
@@ -40,6 +44,14 @@ namespace vm {
 /*! \brief The magic number for the serialized VM bytecode file  */
 constexpr uint64_t kTVMVMBytecodeMagic = 0xD225DE2F4214151D;
 constexpr uint64_t kTVMVMBytecodeMagicV2 = 0xD225DE2F4214151E;
+/*! \brief The magic number of the format whose tensor constants have aligned payloads. */
+constexpr uint64_t kTVMVMBytecodeMagicV3 = 0xD225DE2F4214151F;
+/*! \brief The magic number of the format with the debug section after the code section. */
+constexpr uint64_t kTVMVMBytecodeMagicV4 = 0xD225DE2F42141520;
+/*! \brief The magic number of the format with the cost section after the debug section. */
+constexpr uint64_t kTVMVMBytecodeMagicV5 = 0xD225DE2F42141521;
+/*! \brief The size from which the payload of a tensor constant starts on a page of its own. */
+constexpr size_t kConstantPageSize = 4096;
 
 #define STREAM_CHECK(val, section)                                                  \
   TVM_FFI_ICHECK(val) << "Invalid VM file format in the " << section << " section." \
@@ -145,7 +157,7 @@ Instruction VMExecutable::GetInstruction(Index i) const {
 }
 
 void SaveHeader(support::Stream* strm) {
-  uint64_t header = kTVMVMBytecodeMagicV2;
+  uint64_t header = kTVMVMBytecodeMagicV5;
   strm->Write(header);
   std::string version = VM_VERSION;
   strm->Write(version);
@@ -155,7 +167,10 @@ uint64_t LoadHeader(support::Stream* strm) {
   // Check header.
   uint64_t header;
   STREAM_CHECK(strm->Read(&header), "header");
-  STREAM_CHECK((header == kTVMVMBytecodeMagic) || (header == kTVMVMBytecodeMagicV2), "header");
+  STREAM_CHECK((header == kTVMVMBytecodeMagic) || (header == kTVMVMBytecodeMagicV2) ||
+                   (header == kTVMVMBytecodeMagicV3) || (header == kTVMVMBytecodeMagicV4) ||
+                   (header == kTVMVMBytecodeMagicV5),
+               "header");
 
   // Check version.
   std::string version;
@@ -184,6 +199,12 @@ ffi::Bytes VMExecutable::SaveToBytes() const {
   // Code section.
   SaveCodeSection(&strm);
 
+  // Debug section.
+  SaveDebugSection(&strm);
+
+  // Cost section.
+  SaveCostSection(&strm);
+
   return ffi::Bytes(std::move(result));
 }
 
@@ -192,7 +213,12 @@ void VMExecutable::WriteToFile(const ffi::String& file_name, const ffi::String&
 }
 
 ffi::Module VMExecutable::LoadFromBytes(const ffi::Bytes& bytes) {
-  support::BytesInStream strm(bytes);
+  return LoadFromMemory(bytes.data(), bytes.size(), std::make_shared<ffi::Bytes>(bytes));
+}
+
+ffi::Module VMExecutable::LoadFromMemory(const char* data, size_t size,
+                                         const std::shared_ptr<void>& owner) {
+  support::BytesInStream strm(data, size);
 
   ObjectPtr<VMExecutable> exec = ffi::make_object<VMExecutable>();
 
@@ -202,24 +228,37 @@ ffi::Module VMExecutable::LoadFromBytes(const ffi::Bytes& bytes) {
   // Global section.
   exec->LoadGlobalSection(&strm);
 
-  if (kTVMVMBytecodeMagicV2 == header_magic) {
+  if (header_magic != kTVMVMBytecodeMagic) {
     // Memory Scopes
     exec->LoadMemoryScopeSection(&strm);
   }
 
   // Constant section.
-  exec->LoadConstantSection(&strm);
+  exec->LoadConstantSection(&strm,
+                            header_magic == kTVMVMBytecodeMagicV3 ||
+                                header_magic == kTVMVMBytecodeMagicV4 ||
+                                header_magic == kTVMVMBytecodeMagicV5,
+                            owner);
 
   // Code section.
   exec->LoadCodeSection(&strm);
 
+  if (header_magic == kTVMVMBytecodeMagicV4 || header_magic == kTVMVMBytecodeMagicV5) {
+    // Debug section.
+    exec->LoadDebugSection(&strm);
+  }
+
+  if (header_magic == kTVMVMBytecodeMagicV5) {
+    // Cost section.
+    exec->LoadCostSection(&strm);
+  }
+
   return ffi::Module(exec);
 }
 
 ffi::Module VMExecutable::LoadFromFile(const ffi::String& file_name) {
-  std::string data;
-  runtime::LoadBinaryFromFile(file_name, &data);
-  return VMExecutable::LoadFromBytes(ffi::Bytes(data));
+  auto file = std::make_shared<MappedFile>(file_name);
+  return VMExecutable::LoadFromMemory(file->data(), file->size(), file);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -264,14 +303,92 @@ void VMExecutable::SaveMemoryScopeSection(support::Stream* strm) const {
   }
 }
 
-void VMExecutable::SaveConstantSection(support::Stream* strm) const {
+/*!
+ * \brief Save a tensor constant, with its payload aligned in the output, so that the memory of a
+ *  loaded executable can be viewed by the tensor.
+ */
+void SaveTensorConstant(support::BytesOutStream* strm, const DLTensor* tensor) {
+  strm->Write(tensor->ndim);
+  strm->Write(tensor->dtype);
+  strm->WriteArray(tensor->shape, tensor->ndim);
+  int64_t data_byte_size = static_cast<int64_t>(GetDataSize(*tensor));
+  strm->Write(data_byte_size);
+  // The large payloads start on a page, so that a mapping of the file reads only their pages.
+  size_t alignment = static_cast<size_t>(data_byte_size) >= kConstantPageSize ? kConstantPageSize
+                                                                              : kAllocAlignment;
+  uint64_t padding = (alignment - (strm->Tell() + sizeof(uint64_t)) % alignment) % alignment;
+  strm->Write(padding);
+  std::vector<char> zeros(padding, 0);
+  strm->Write(zeros.data(), padding);
+  if (TVM_FFI_IO_NO_ENDIAN_SWAP && tensor->device.device_type == kDLCPU &&
+      ffi::IsContiguous(*tensor) && tensor->byte_offset == 0) {
+    strm->Write(tensor->data, data_byte_size);
+  } else {
+    std::vector<uint8_t> bytes(data_byte_size);
+    Tensor::CopyToBytes(const_cast<DLTensor*>(tensor), bytes.data(), data_byte_size);
+    if (!TVM_FFI_IO_NO_ENDIAN_SWAP) {
+      ffi::ByteSwap(bytes.data(), (tensor->dtype.bits + 7) / 8,
+                    data_byte_size / ((tensor->dtype.bits + 7) / 8));
+    }
+    strm->Write(bytes.data(), data_byte_size);
+  }
+}
+
+/*!
+ * \brief Load a tensor constant saved by SaveTensorConstant. The tensor views its payload in the
+ *  memory read by the stream when it is aligned, and keeps the owner of the memory alive.
+ */
+Tensor LoadTensorConstant(support::BytesInStream* strm, const std::shared_ptr<void>& owner) {
+  int ndim;
+  DLDataType dtype;
+  STREAM_CHECK(strm->Read(&ndim), "constant tensor");
+  STREAM_CHECK(strm->Read(&dtype), "constant tensor");
+  std::vector<int64_t> shape(ndim);
+  STREAM_CHECK(ndim == 0 || strm->ReadArray(shape.data(), ndim), "constant tensor");
+  int64_t data_byte_size;
+  uint64_t padding;
+  STREAM_CHECK(strm->Read(&data_byte_size), "constant tensor");
+  STREAM_CHECK(strm->Read(&padding), "constant tensor");
+  STREAM_CHECK(strm->ReadInPlace(padding) != nullptr, "constant tensor");
+  const char* payload = strm->ReadInPlace(data_byte_size);
+  STREAM_CHECK(payload != nullptr, "constant tensor");
+  STREAM_CHECK(static_cast<int64_t>(ffi::GetDataSize(ffi::Shape(shape).Product(), dtype)) ==
+                   data_byte_size,
+               "constant tensor");
+
+  Device cpu_dev{kDLCPU, 0};
+  if (TVM_FFI_IO_NO_ENDIAN_SWAP && reinterpret_cast<uintptr_t>(payload) % kAllocAlignment == 0) {
+    // The constants are read-only, so that the tensor can view a read-only mapping of the file.
+    // The pages are only read when the tensor is used, e.g. copied to the device by the VM.
+    class InPlaceAlloc {
+     public:
+      explicit InPlaceAlloc(std::shared_ptr<void> owner) : owner_(std::move(owner)) {}
+      void AllocData(DLTensor* tensor, const char* payload) {
+        tensor->data = const_cast<char*>(payload);
+      }
+      void FreeData(DLTensor* tensor) {}
+
+     private:
+      std::shared_ptr<void> owner_;
+    };
+    return Tensor::FromNDAlloc(InPlaceAlloc(owner), ffi::Shape(shape), dtype, cpu_dev, payload);
+  }
+  Tensor ret = Tensor::Empty(ffi::Shape(shape), dtype, cpu_dev);
+  std::memcpy(ret->data, payload, data_byte_size);
+  if (!TVM_FFI_IO_NO_ENDIAN_SWAP) {
+    ffi::ByteSwap(ret->data, (dtype.bits + 7) / 8, data_byte_size / ((dtype.bits + 7) / 8));
+  }
+  return ret;
+}
+
+void VMExecutable::SaveConstantSection(support::BytesOutStream* strm) const {
   // NOTE: pay close attention to the explicit type in write here
   // so the load/save is 32/64 bit compatible
   strm->Write(static_cast<uint64_t>(this->constants.size()));
   for (const auto& it : this->constants) {
     if (auto opt_nd = it.as<runtime::Tensor>()) {
       strm->Write<int32_t>(ffi::TypeIndex::kTVMFFITensor);
-      runtime::SaveDLTensor(strm, opt_nd.value().operator->());
+      SaveTensorConstant(strm, opt_nd.value().operator->());
     } else if (auto opt_shape = it.as<ffi::Shape>()) {
       ffi::Shape shape = opt_shape.value();
       strm->Write<int32_t>(ffi::TypeIndex::kTVMFFIShape);
@@ -327,7 +444,8 @@ void VMExecutable::LoadMemoryScopeSection(support::Stream* strm) {
   }
 }
 
-void VMExecutable::LoadConstantSection(support::Stream* strm) {
+void VMExecutable::LoadConstantSection(support::BytesInStream* strm, bool aligned_payloads,
+                                       const std::shared_ptr<void>& owner) {
   uint64_t sz;
   // Load the number of constants.
   STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "constant");
@@ -340,7 +458,11 @@ void VMExecutable::LoadConstantSection(support::Stream* strm) {
     int constant_type;
     STREAM_CHECK(strm->Read(&constant_type, sizeof(constant_type)), "constant");
     if (constant_type == ffi::TypeIndex::kTVMFFITensor) {
-      ndarray.Load(strm);
+      if (aligned_payloads) {
+        ndarray = LoadTensorConstant(strm, owner);
+      } else {
+        ndarray.Load(strm);
+      }
       ffi::Any cell;
       cell = ndarray;
       this->constants.push_back(cell);
@@ -391,6 +513,20 @@ void VMExecutable::LoadCodeSection(support::Stream* strm) {
   STREAM_CHECK(strm->Read(&(this->instr_data)), "instr data");
 }
 
+void VMExecutable::SaveDebugSection(support::Stream* strm) const {
+  strm->Write(instr_debug_names);
+}
+
+void VMExecutable::LoadDebugSection(support::Stream* strm) {
+  STREAM_CHECK(strm->Read(&(this->instr_debug_names)), "instr debug names");
+}
+
+void VMExecutable::SaveCostSection(support::Stream* strm) const { strm->Write(kernel_costs); }
+
+void VMExecutable::LoadCostSection(support::Stream* strm) {
+  STREAM_CHECK(strm->Read(&(this->kernel_costs)), "kernel costs");
+}
+
 template <typename T>
 std::string StrJoin(T* items, int offset, int cnt, std::string delim = ", ",
                     std::function<std::string(T)> repr = std::to_string) {
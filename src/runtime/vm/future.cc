@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/future.cc
+ * \brief The future of an asynchronous call of a VM function.
+ */
+#include "future.h"
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/logging.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+ffi::Any VMFutureObj::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return done_; });
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  return result;
+}
+
+bool VMFutureObj::IsDone() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return done_;
+}
+
+void VMFutureObj::SetDone(std::exception_ptr error) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    error_ = error;
+  }
+  cv_.notify_all();
+  if (callback != nullptr && error == nullptr) {
+    callback(result);
+  }
+}
+
+/*!
+ * \brief The thread that waits for the futures of a stream in the order they are submitted, so
+ * that the host thread submitting the calls is never blocked by the devices.
+ */
+class StreamWaiter {
+ public:
+  StreamWaiter() {
+    // The thread is detached, as the waiters live until the process exits.
+    std::thread([this]() { this->Run(); }).detach();
+  }
+
+  void Push(VMFuture future) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(future));
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  void Run() {
+    while (true) {
+      VMFuture future;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !queue_.empty(); });
+        future = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      std::exception_ptr error = nullptr;
+      try {
+        for (const auto& [device, stream] : future->streams) {
+          DeviceAPI::Get(device)->StreamSync(device, stream);
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+      try {
+        future->SetDone(error);
+      } catch (const std::exception& e) {
+        // The error of a callback has no caller to be reported to.
+        LOG(WARNING) << "The callback of a VM future raised an error: " << e.what();
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<VMFuture> queue_;
+};
+
+void SubmitVMFuture(VMFuture future) {
+  if (future->streams.empty()) {
+    future->SetDone(nullptr);
+    return;
+  }
+  static std::mutex mutex;
+  // The waiters are leaked, as their threads may still run when the process exits.
+  static auto* waiters = new std::map<std::pair<int64_t, void*>, std::unique_ptr<StreamWaiter>>();
+  const auto& [device, stream] = future->streams.front();
+  std::pair<int64_t, void*> key{static_cast<int64_t>(device.device_type) << 32 | device.device_id,
+                                stream};
+  StreamWaiter* waiter;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<StreamWaiter>& entry = (*waiters)[key];
+    if (entry == nullptr) {
+      entry = std::make_unique<StreamWaiter>();
+    }
+    waiter = entry.get();
+  }
+  waiter->Push(std::move(future));
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.future_wait", [](VMFuture future) { return future->Wait(); })
+      .def("vm.builtin.future_is_done", [](VMFuture future) { return future->IsDone(); });
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
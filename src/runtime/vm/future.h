@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/future.h
+ * \brief The future of an asynchronous call of a VM function.
+ */
+#ifndef TVM_RUNTIME_VM_FUTURE_H_
+#define TVM_RUNTIME_VM_FUTURE_H_
+
+#include <tvm/ffi/any.h>
+#include <tvm/ffi/function.h>
+#include <tvm/runtime/device_api.h>
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief The future of an asynchronous call of a VM function, which is done when the work of the
+ * call on the streams of the devices is done.
+ */
+class VMFutureObj : public Object {
+ public:
+  /*!
+   * \brief Wait for the call to be done.
+   * \return The result of the call.
+   * \throw The error raised by the wait for the streams.
+   */
+  ffi::Any Wait();
+
+  /*! \brief Whether the call is done. */
+  bool IsDone();
+
+  /*!
+   * \brief Mark the call as done, and run the callback with the result.
+   * \param error The error raised by the wait for the streams, or nullptr when it succeeded.
+   */
+  void SetDone(std::exception_ptr error);
+
+  /*! \brief The result of the call, whose work may still be running on the device. */
+  ffi::Any result;
+  /*! \brief The function called with the result when the call is done, or null. */
+  ffi::Function callback;
+  /*! \brief The streams that the work of the call is submitted to, on each device. */
+  std::vector<std::pair<Device, TVMStreamHandle>> streams;
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.vm.Future", VMFutureObj, Object);
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool done_ = false;
+  std::exception_ptr error_ = nullptr;
+};
+
+/*! \brief Managed reference to VMFutureObj. */
+class VMFuture : public ObjectRef {
+ public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(VMFuture, ObjectRef, VMFutureObj);
+};
+
+/*!
+ * \brief Wait for the streams of the future in the background, and mark it as done when they are.
+ * The futures of a stream are done in the order they are submitted, by one thread per stream.
+ * \param future The future, whose work is submitted to its streams.
+ */
+void SubmitVMFuture(VMFuture future);
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_FUTURE_H_
@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/vm/host_transfer_ring.cc
+ * \brief The ring of the pinned host buffers that the outputs of the VM functions are copied to
+ * asynchronously, e.g. the logits of each decode step.
+ *
+ * A copy into the ring is submitted to a copy stream of the ring, after the work submitted to the
+ * current stream of the device so far, and returns a VM future that is done when the copy is. The
+ * host thread does not wait for the device, so that the CPU work on the outputs of a step, e.g.
+ * the sampling, overlaps with the work of the next step on the device. The host tensor of a copy
+ * is valid until its slot is reused, i.e. for the next num_slots - 1 copies.
+ */
+#include <tvm/ffi/container/shape.h>
+#include <tvm/ffi/memory.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/tensor.h>
+
+#include <vector>
+
+#include "future.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*! \brief An object representing the ring of the pinned host buffers of the copies. */
+class HostTransferRingObj : public Object {
+ public:
+  /*! \brief The device that the tensors are copied from. */
+  Device device;
+  /*! \brief The stream that the copies are submitted to, null on CPU. */
+  TVMStreamHandle copy_stream = nullptr;
+  /*! \brief The host buffer of each slot, in bytes, grown on demand. */
+  std::vector<Tensor> buffers;
+  /*! \brief The future of the last copy of each slot. */
+  std::vector<VMFuture> futures;
+  /*! \brief The tensor of the last copy of each slot, kept alive until the copy is done. */
+  std::vector<Tensor> sources;
+  /*! \brief The slot of the next copy. */
+  int64_t next_slot = 0;
+
+  ~HostTransferRingObj() {
+    for (const VMFuture& future : futures) {
+      if (future.defined()) future->Wait();
+    }
+    if (copy_stream != nullptr) {
+      DeviceAPI::Get(device)->FreeStream(device, copy_stream);
+    }
+  }
+
+  /*!
+   * \brief Copy a tensor of the device into the next slot of the ring.
+   * The copy waits for the work submitted to the current stream of the device so far. When the
+   * last copy of the slot is not done, the host thread waits for it before the slot is reused.
+   * \param tensor The tensor to copy.
+   * \return The future of the copy, whose result is the host tensor.
+   */
+  VMFuture Copy(const Tensor& tensor) {
+    TVM_FFI_ICHECK(tensor->device.device_type == device.device_type &&
+                   tensor->device.device_id == device.device_id)
+        << "ValueError: The tensor is on " << tensor->device << ", but the ring copies from "
+        << device;
+    TVM_FFI_ICHECK(IsContiguous(*tensor.operator->()))
+        << "ValueError: The tensor to copy is not contiguous";
+    int64_t slot = next_slot;
+    next_slot = (next_slot + 1) % static_cast<int64_t>(buffers.size());
+    if (futures[slot].defined()) {
+      futures[slot]->Wait();
+    }
+
+    int64_t nbytes = static_cast<int64_t>(GetDataSize(*tensor.operator->()));
+    if (!buffers[slot].defined() || buffers[slot]->shape[0] < nbytes) {
+      buffers[slot] = Tensor::Empty({nbytes}, DataType::UInt(8), GetPreferredHostDevice(device));
+    }
+    Tensor host = buffers[slot].CreateView(tensor.Shape(), tensor->dtype);
+
+    auto future = ffi::make_object<VMFutureObj>();
+    future->result = host;
+    if (copy_stream != nullptr) {
+      DeviceAPI* api = DeviceAPI::Get(device);
+      api->SyncStreamFromTo(device, api->GetCurrentStream(device), copy_stream);
+      api->CopyDataFromTo(const_cast<DLTensor*>(tensor.operator->()),
+                          const_cast<DLTensor*>(host.operator->()), copy_stream);
+      future->streams.emplace_back(device, copy_stream);
+    } else {
+      host.CopyFrom(tensor);
+    }
+    VMFuture ref(future);
+    futures[slot] = ref;
+    sources[slot] = tensor;
+    SubmitVMFuture(ref);
+    return ref;
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.vm.HostTransferRing", HostTransferRingObj, Object);
+};
+
+/*! \brief reference to the host transfer ring. */
+class HostTransferRing : public ObjectRef {
+ public:
+  /*!
+   * \brief Create the host transfer ring.
+   * \param num_slots The number of the copies whose host tensors are valid at once.
+   * \param device The device that the tensors are copied from.
+   */
+  static HostTransferRing Create(int64_t num_slots, Device device) {
+    TVM_FFI_ICHECK_GT(num_slots, 0) << "The number of slots should be positive";
+    auto n = ffi::make_object<HostTransferRingObj>();
+    n->device = device;
+    if (device.device_type != kDLCPU) {
+      n->copy_stream = DeviceAPI::Get(device)->CreateStream(device);
+    }
+    n->buffers.resize(num_slots);
+    n->futures.resize(num_slots);
+    n->sources.resize(num_slots);
+    return HostTransferRing(n);
+  }
+
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(HostTransferRing, ObjectRef, HostTransferRingObj);
+};
+
+//-------------------------------------------------
+//  Register runtime functions
+//-------------------------------------------------
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.host_transfer_ring_create", HostTransferRing::Create)
+      .def("vm.builtin.host_transfer_ring_copy",
+           [](HostTransferRing ring, Tensor tensor) { return ring->Copy(tensor); })
+      .def("vm.builtin.host_transfer_ring_num_slots",
+           [](HostTransferRing ring) { return static_cast<int64_t>(ring->buffers.size()); });
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
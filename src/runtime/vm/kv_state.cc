@@ -38,6 +38,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("vm.builtin.kv_state_remove_sequence", &KVStateObj::RemoveSequence)
       .def_method("vm.builtin.kv_state_fork_sequence", &KVStateObj::ForkSequence)
       .def_method("vm.builtin.kv_state_popn", &KVStateObj::PopN)
+      .def_method("vm.builtin.kv_state_swap_out", &KVStateObj::SwapOut)
+      .def_method("vm.builtin.kv_state_swap_in", &KVStateObj::SwapIn)
       .def_packed("vm.builtin.kv_state_begin_forward",
                   [](ffi::PackedArgs args, ffi::Any* rv) {
                     TVM_FFI_ICHECK(args.size() == 3 || args.size() == 4)
@@ -61,15 +63,28 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("vm.builtin.kv_cache_disagg_prepare_recv",
                   &AttentionKVCacheObj::DisaggPrepareRecv)
       .def_method("vm.builtin.kv_cache_disagg_mark_send", &AttentionKVCacheObj::DisaggMarkSend)
+      .def_method("vm.builtin.kv_cache_disagg_query_transfer_done",
+                  &AttentionKVCacheObj::DisaggQueryTransferDone)
       .def_method("vm.builtin.attention_kv_cache_enable_sliding_window_for_seq",
                   &AttentionKVCacheObj::EnableSlidingWindowForSeq)
       .def_method("vm.builtin.attention_kv_cache_commit_accepted_token_tree_nodes",
                   &AttentionKVCacheObj::CommitAcceptedTokenTreeNodes)
+      .def_method("vm.builtin.attention_kv_cache_add_sequence_with_prefix_match",
+                  &AttentionKVCacheObj::AddSequenceWithPrefixMatch)
+      .def_method("vm.builtin.attention_kv_cache_cache_prefix", &AttentionKVCacheObj::CachePrefix)
+      .def_method("vm.builtin.attention_kv_cache_clear_prefix_cache",
+                  &AttentionKVCacheObj::ClearPrefixCache)
       .def_method("vm.builtin.attention_kv_cache_empty", &AttentionKVCacheObj::Empty)
       .def_method("vm.builtin.attention_kv_cache_get_num_available_pages",
                   &AttentionKVCacheObj::GetNumAvailablePages)
       .def_method("vm.builtin.attention_kv_cache_get_total_sequence_length",
                   &AttentionKVCacheObj::GetTotalSequenceLength)
+      .def_method("vm.builtin.attention_kv_cache_get_num_pages_of_sequence",
+                  &AttentionKVCacheObj::GetNumPagesOfSequence)
+      .def_method("vm.builtin.attention_kv_cache_get_num_pages_freed_on_remove",
+                  &AttentionKVCacheObj::GetNumPagesFreedOnRemove)
+      .def_method("vm.builtin.attention_kv_cache_get_num_pages_needed_for_append",
+                  &AttentionKVCacheObj::GetNumPagesNeededForAppend)
       .def_method("vm.builtin.attention_kv_cache_get_query_positions",
                   &AttentionKVCacheObj::GetQueryPositions)
       .def_method("vm.builtin.attention_kv_cache_debug_get_kv", &AttentionKVCacheObj::DebugGetKV)
@@ -76,6 +76,25 @@ class KVStateObj : public Object {
    */
   virtual void PopN(int64_t seq_id, int32_t n) = 0;
 
+  /*!
+   * \brief Swap out the K/V state of a sequence to host memory and release
+   * the device memory it exclusively owns. The copy is asynchronous.
+   * A swapped-out sequence cannot be forwarded or forked until swapped in,
+   * while it can still be removed.
+   * \param seq_id The sequence to swap out.
+   * \throws Error if the given sequence id is not valid, or swapping is not supported.
+   */
+  virtual void SwapOut(int64_t seq_id) = 0;
+
+  /*!
+   * \brief Swap the K/V state of a swapped-out sequence back to device.
+   * The copy is asynchronous, and is ordered before the next model forward.
+   * \param seq_id The sequence to swap in.
+   * \throws Error if the given sequence is not swapped out, or there is no
+   * enough device memory to hold its K/V state.
+   */
+  virtual void SwapIn(int64_t seq_id) = 0;
+
   /*!
    * \brief Mark the start of the forward function with the ids of
    * the sequences and the sequence length to forward for each
@@ -135,6 +154,31 @@ class AttentionKVCacheObj : public KVStateObj {
   /*! \brief Get the current total sequence length in the KV cache. */
   virtual int32_t GetTotalSequenceLength() const = 0;
 
+  /*!
+   * \brief Get the number of pages holding the KV data of the given sequence,
+   * including the pages shared with other sequences.
+   * \param seq_id The id of the sequence to query.
+   */
+  virtual int32_t GetNumPagesOfSequence(int64_t seq_id) const = 0;
+
+  /*!
+   * \brief Get the number of pages that removing the given sequence would free,
+   * which excludes the pages shared with other sequences (e.g., through forking).
+   * \param seq_id The id of the sequence to query.
+   */
+  virtual int32_t GetNumPagesFreedOnRemove(int64_t seq_id) const = 0;
+
+  /*!
+   * \brief Get the number of free pages needed to append the given number of
+   * tokens to the given sequence in the next round of forward.
+   * For a swapped-out sequence, the pages to swap in the sequence are included.
+   * \param seq_id The id of the sequence to query.
+   * \param append_length The number of tokens to append.
+   * \note When sliding window is enabled for the sequence, the pages slid out
+   * in the forward are not deducted, so the result is an upper bound.
+   */
+  virtual int32_t GetNumPagesNeededForAppend(int64_t seq_id, int64_t append_length) const = 0;
+
   /************** Sequence Management **************/
 
   /*!
@@ -158,6 +202,33 @@ class AttentionKVCacheObj : public KVStateObj {
   virtual void CommitAcceptedTokenTreeNodes(const IntTuple& seq_ids,
                                             const IntTuple& leaf_indices) = 0;
 
+  /*!
+   * \brief Add a new sequence to the KV cache, reusing the KV data of the
+   * longest prefix of the given tokens that is present in the prefix cache.
+   * At least one token is always left unmatched, so that the caller can run
+   * the forward of the remaining tokens to obtain the next-token logits.
+   * \param seq_id The id of the new sequence to be added.
+   * \param token_ids The token ids of the new sequence.
+   * \return The length of the reused prefix. The KV data of the tokens after
+   * this length is expected to be appended through BeginForward.
+   */
+  virtual int64_t AddSequenceWithPrefixMatch(int64_t seq_id, const IntTuple& token_ids) = 0;
+
+  /*!
+   * \brief Insert the KV data of the given sequence into the prefix cache,
+   * so that later sequences with the same leading tokens can reuse it.
+   * Only the full pages covered by the token ids are cached.
+   * Cached KV data is retained after the sequence is removed, and is evicted
+   * in the least-recently-used order when the KV cache runs out of pages.
+   * \param seq_id The id of the sequence whose KV data is cached.
+   * \param token_ids The token ids whose KV data are stored in the sequence,
+   * starting from position 0.
+   */
+  virtual void CachePrefix(int64_t seq_id, const IntTuple& token_ids) = 0;
+
+  /*! \brief Drop all the KV data retained by the prefix cache. */
+  virtual void ClearPrefixCache() = 0;
+
   /*! \brief Prepare for the disaggregation KV data receive for the specified sequence and length.*/
   virtual IntTuple DisaggPrepareRecv(int64_t seq_id, int length) = 0;
 
@@ -166,6 +237,14 @@ class AttentionKVCacheObj : public KVStateObj {
                               const IntTuple& compressed_remote_position_map,
                               int32_t recver_pe_offset) = 0;
 
+  /*!
+   * \brief Query whether all the KV data sends issued so far have completed.
+   * The query does not block. Sends are issued layer by layer during the
+   * forward, so a true return means the receivers hold the complete KV data.
+   * \return Whether there are no pending KV data sends.
+   */
+  virtual bool DisaggQueryTransferDone() = 0;
+
   /************** Attention **************/
 
   /*!
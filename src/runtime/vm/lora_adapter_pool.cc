@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/vm/lora_adapter_pool.cc
+ * \brief The pool of the LoRA adapters of a model, which lets the requests of one batch use
+ * different adapters.
+ *
+ * The weights of the adapters are stored in slots, the leading dimension of the weights of the
+ * pool, in the same way as the pages of the paged KV cache. The models take the weights of the
+ * pool and the slot of each token, e.g. with `nn.llm.lora_bgmv`, so that a batch with different
+ * adapters runs in one step. The adapters are loaded into the free slots, or into the slots of
+ * the adapters least recently used when the pool is full.
+ */
+#include <tvm/ffi/container/array.h>
+#include <tvm/ffi/container/shape.h>
+#include <tvm/ffi/memory.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/tensor.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*! \brief An object representing the pool of the LoRA adapters of a model. */
+class LoRAAdapterPoolObj : public Object {
+ public:
+  /*! \brief The weights of the pool, each of shape (num_slots, *shape of the weight). */
+  ffi::Array<Tensor> weights;
+  /*! \brief The slot of each adapter loaded. */
+  std::unordered_map<std::string, int64_t> adapter_slots;
+  /*! \brief The adapter of each slot, empty for the free slots. */
+  std::vector<std::string> slot_adapters;
+  /*! \brief The step at which each slot was last used. */
+  std::vector<int64_t> slot_last_used;
+  /*! \brief The number of lookups so far, i.e. the index of the current step. */
+  int64_t step = 0;
+
+  /*!
+   * \brief Load an adapter into the pool, and return its slot. The adapter loaded already is
+   * overwritten in place. Otherwise a free slot is taken, or the slot of the adapter least
+   * recently used, which must not have been used in the current step.
+   * \param name The name of the adapter.
+   * \param adapter_weights The weights of the adapter, one for each weight of the pool. The
+   * adapters of a smaller rank are zero-padded to the rank of the pool.
+   */
+  int64_t Load(const std::string& name, const ffi::Array<Tensor>& adapter_weights) {
+    TVM_FFI_ICHECK(!name.empty()) << "The name of an adapter should not be empty";
+    TVM_FFI_ICHECK_EQ(adapter_weights.size(), weights.size())
+        << "The adapter has " << adapter_weights.size() << " weights, but the pool has "
+        << weights.size();
+    int64_t slot = GetSlotToLoad(name);
+    for (size_t i = 0; i < weights.size(); ++i) {
+      const Tensor& pool_weight = weights[i];
+      const Tensor& weight = adapter_weights[i];
+      std::vector<int64_t> slot_shape(pool_weight->shape + 1,
+                                      pool_weight->shape + pool_weight->ndim);
+      TVM_FFI_ICHECK(std::vector<int64_t>(weight->shape, weight->shape + weight->ndim) ==
+                     slot_shape)
+          << "The shape of weight " << i << " of adapter \"" << name
+          << "\" does not match the shape of the slots of the pool";
+      TVM_FFI_ICHECK(DataType(weight->dtype) == DataType(pool_weight->dtype))
+          << "The weight " << i << " of adapter \"" << name << "\" has dtype "
+          << ffi::DLDataTypeToString(weight->dtype) << ", but the pool has dtype "
+          << ffi::DLDataTypeToString(pool_weight->dtype);
+      size_t slot_nbytes = GetDataSize(*weight.operator->());
+      pool_weight.CreateView(weight.Shape(), weight->dtype, slot * slot_nbytes).CopyFrom(weight);
+    }
+    if (!slot_adapters[slot].empty() && slot_adapters[slot] != name) {
+      adapter_slots.erase(slot_adapters[slot]);
+    }
+    adapter_slots[name] = slot;
+    slot_adapters[slot] = name;
+    slot_last_used[slot] = step;
+    return slot;
+  }
+
+  /*!
+   * \brief Get the slots of the adapters of the requests of a step, and mark them as used in the
+   * step, so that they are not evicted by the adapters loaded before the step runs.
+   * \param names The adapter of each request, empty for the requests without an adapter.
+   * \return The slot of each request, -1 for the requests without an adapter.
+   */
+  ffi::Shape Lookup(const ffi::Array<ffi::String>& names) {
+    ++step;
+    std::vector<int64_t> slots;
+    slots.reserve(names.size());
+    for (const ffi::String& name : names) {
+      if (name.empty()) {
+        slots.push_back(-1);
+        continue;
+      }
+      auto it = adapter_slots.find(name);
+      TVM_FFI_ICHECK(it != adapter_slots.end())
+          << "The adapter \"" << name << "\" is not loaded in the pool";
+      slot_last_used[it->second] = step;
+      slots.push_back(it->second);
+    }
+    return ffi::Shape(slots);
+  }
+
+  /*! \brief Remove an adapter from the pool, freeing its slot. */
+  void Remove(const std::string& name) {
+    auto it = adapter_slots.find(name);
+    TVM_FFI_ICHECK(it != adapter_slots.end())
+        << "The adapter \"" << name << "\" is not loaded in the pool";
+    slot_adapters[it->second].clear();
+    adapter_slots.erase(it);
+  }
+
+  /*! \brief The number of the free slots of the pool. */
+  int64_t GetNumFreeSlots() const {
+    return static_cast<int64_t>(slot_adapters.size() - adapter_slots.size());
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.vm.LoRAAdapterPool", LoRAAdapterPoolObj, Object);
+
+ private:
+  int64_t GetSlotToLoad(const std::string& name) const {
+    auto it = adapter_slots.find(name);
+    if (it != adapter_slots.end()) {
+      return it->second;
+    }
+    int64_t lru_slot = -1;
+    for (int64_t slot = 0; slot < static_cast<int64_t>(slot_adapters.size()); ++slot) {
+      if (slot_adapters[slot].empty()) {
+        return slot;
+      }
+      if (lru_slot == -1 || slot_last_used[slot] < slot_last_used[lru_slot]) {
+        lru_slot = slot;
+      }
+    }
+    TVM_FFI_ICHECK(lru_slot != -1 && slot_last_used[lru_slot] < step)
+        << "The pool has no slot for adapter \"" << name
+        << "\", as all its adapters are used by the current step";
+    return lru_slot;
+  }
+};
+
+/*! \brief reference to the LoRA adapter pool. */
+class LoRAAdapterPool : public ObjectRef {
+ public:
+  /*!
+   * \brief Create the LoRA adapter pool.
+   * \param num_slots The number of the adapters that the pool holds at once.
+   * \param weight_shapes The shape of each weight of an adapter, e.g. of the A and the B matrices
+   * of each layer.
+   * \param dtype The dtype of the weights.
+   * \param device The device of the weights.
+   */
+  static LoRAAdapterPool Create(int64_t num_slots, ffi::Array<ffi::Shape> weight_shapes,
+                                DLDataType dtype, Device device) {
+    TVM_FFI_ICHECK_GT(num_slots, 0) << "The number of slots should be positive";
+    auto n = ffi::make_object<LoRAAdapterPoolObj>();
+    for (const ffi::Shape& shape : weight_shapes) {
+      std::vector<int64_t> pool_shape{num_slots};
+      pool_shape.insert(pool_shape.end(), shape.begin(), shape.end());
+      Tensor weight = Tensor::Empty(ffi::Shape(pool_shape), dtype, device);
+      n->weights.push_back(weight);
+    }
+    n->slot_adapters.resize(num_slots);
+    n->slot_last_used.resize(num_slots, 0);
+    return LoRAAdapterPool(n);
+  }
+
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(LoRAAdapterPool, ObjectRef, LoRAAdapterPoolObj);
+};
+
+//-------------------------------------------------
+//  Register runtime functions
+//-------------------------------------------------
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.lora_adapter_pool_create", LoRAAdapterPool::Create)
+      .def("vm.builtin.lora_adapter_pool_load",
+           [](LoRAAdapterPool pool, ffi::String name, ffi::Array<Tensor> adapter_weights) {
+             return pool->Load(name, adapter_weights);
+           })
+      .def("vm.builtin.lora_adapter_pool_lookup",
+           [](LoRAAdapterPool pool, ffi::Array<ffi::String> names) { return pool->Lookup(names); })
+      .def("vm.builtin.lora_adapter_pool_remove",
+           [](LoRAAdapterPool pool, ffi::String name) { pool->Remove(name); })
+      .def("vm.builtin.lora_adapter_pool_get_weights",
+           [](LoRAAdapterPool pool) { return pool->weights; })
+      .def("vm.builtin.lora_adapter_pool_get_num_free_slots",
+           [](LoRAAdapterPool pool) { return pool->GetNumFreeSlots(); });
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -29,6 +29,8 @@
 #include <tvm/runtime/tensor.h>
 
 #include <algorithm>
+#include <cstring>
+#include <map>
 #include <numeric>
 #include <unordered_map>
 #include <utility>
@@ -69,6 +71,14 @@ namespace vm {
  *   - step 3. use `EndForward` to mark the end of forwarding this round.
  *     After calling `EndForward`, it is required to call `BeginForward`
  *     before calling any `Attention`.
+ * - It supports automatic prefix caching. `CachePrefix` retains the
+ * full pages of a sequence in a radix tree keyed by page token ids,
+ * and `AddSequenceWithPrefixMatch` adds a sequence sharing the pages
+ * of the longest cached prefix. The retained pages are evicted in LRU
+ * order when the KV cache runs out of free pages.
+ * - It supports swapping sequences out to host memory with `SwapOut`
+ * and back with `SwapIn`. The page copies run on the copy stream, and
+ * are overlapped with the CPU work of the next `BeginForward`.
  */
 class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
  private:
@@ -113,8 +123,25 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   /*! \brief The optional RoPE extension factors for RoPE scaling. */
   const ffi::Optional<Tensor> rope_ext_factors_;
 
-  /*! \brief The KV cache dtype. */
+  /*! \brief The dtype of the attention inputs and outputs. */
+  const DataType dtype_;
+  /*!
+   * \brief The dtype of the KV data stored in pages. It can be a narrower dtype
+   * (e.g., float8) than the attention dtype, in which case the KV data is
+   * converted when appended to the pages and when loaded by the attention kernels.
+   */
   const DataType kv_dtype_;
+  /*!
+   * \brief Whether the KV cache runs in CUDA graph mode. In this mode
+   * - the auxiliary device arrays are allocated at full capacity with fixed addresses,
+   * and the page table array is always presented with its full capacity,
+   * - the auxiliary arrays are synchronized to device at the end of BeginForward,
+   * so that the attention functions do not issue any host-side copy.
+   * Therefore an attention forward whose batch size and kernel selection
+   * (number of depths, decode/prefill kernel) stay unchanged can be captured
+   * once and replayed after each BeginForward.
+   */
+  const bool enable_cuda_graph_;
   /*! \brief We fix int32 to be the index dtype of auxiliary data. */
   const DLDataType dtype_aux_ = DLDataType(DataType::Int(32, 1));
 
@@ -133,6 +160,16 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   Tensor nvshmem_pages_;
   /*! \brief The list of ids of released pages for page reuse. */
   std::vector<int32_t> free_page_ids_;
+  /*!
+   * \brief The number of blocks holding each page. A page is held by more than one block when
+   * a sequence is forked inside it, and is copied on write, see ReserveAppendLengthInSeq.
+   */
+  std::vector<int32_t> page_ref_cnt_;
+  /*!
+   * \brief The number of the valid tokens in each page held by more than one block, i.e. the
+   * length of the longest holder in the page. Only the holders of this length write in place.
+   */
+  std::vector<int32_t> page_shared_length_;
   /*! \brief The mapping from sequence ids to sequences. */
   std::unordered_map<int64_t, Sequence> seq_map_;
 
@@ -143,6 +180,75 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   /*! \brief The list of free available blocks (in their indices). */
   std::vector<int32_t> free_block_idx_;
 
+  /********************* Prefix Cache Structures *********************/
+
+  /*!
+   * \brief A node of the prefix cache radix tree. Each node stands for one
+   * full page of tokens, and the path from the root to a node stands for
+   * the token prefix whose KV data is cached.
+   */
+  struct PrefixCacheNode {
+    /*! \brief The token ids of the page this node stands for. */
+    std::vector<int64_t> page_token_ids;
+    /*! \brief The parent node id, or -1 for the nodes of the first page. */
+    int32_t parent = -1;
+    /*! \brief The number of pages from the root to this node (inclusive). */
+    int32_t depth = 0;
+    /*! \brief The internal sequence that holds the KV data up to this node. */
+    int64_t cache_seq_id = 0;
+  };
+  /*! \brief An internal sequence retained by the prefix cache. */
+  struct PrefixCacheEntry {
+    /*! \brief The ids of the tree nodes whose KV data is held by this sequence. */
+    std::vector<int32_t> node_ids;
+    /*! \brief The logical time of the last lookup hitting this entry, for LRU eviction. */
+    uint64_t last_access = 0;
+  };
+  /*! \brief The prefix cache tree nodes. */
+  std::unordered_map<int32_t, PrefixCacheNode> prefix_cache_nodes_;
+  /*!
+   * \brief The tree edges, mapping (parent node id, page token ids) to the child node id.
+   * The ordered map makes the children of a node adjacent, which eviction relies on.
+   */
+  std::map<std::pair<int32_t, std::vector<int64_t>>, int32_t> prefix_cache_children_;
+  /*! \brief The mapping from internal sequence ids to prefix cache entries. */
+  std::unordered_map<int64_t, PrefixCacheEntry> prefix_cache_entries_;
+  /*! \brief The id of the next created prefix cache node. */
+  int32_t next_prefix_cache_node_id_ = 0;
+  /*! \brief The id of the next created prefix cache internal sequence. */
+  int64_t next_prefix_cache_seq_id_ = kPrefixCacheSeqIdBegin;
+  /*! \brief The logical clock of prefix cache accesses. */
+  uint64_t prefix_cache_clock_ = 0;
+
+  /********************* Host Swap Structures *********************/
+
+  /*!
+   * \brief A sequence swapped out to host memory. The blocks exclusively owned
+   * by the sequence are released, and their pages are kept in a host buffer.
+   * The blocks shared with other sequences stay on device.
+   */
+  struct SwappedSequence {
+    /*! \brief The sequence status at swap-out. */
+    Sequence seq;
+    /*!
+     * \brief The last block kept on device, which the swapped-out blocks follow.
+     * The sequence keeps a reference of this block so that it is not released.
+     */
+    int32_t parent_block_idx;
+    /*! \brief The start position of the swapped-out KV data. -1 means nothing is swapped. */
+    int32_t start_pos = -1;
+    /*! \brief The length of the swapped-out KV data. */
+    int32_t length = 0;
+    /*! \brief The number of pages in the host buffer. */
+    int32_t num_pages = 0;
+    /*! \brief The host buffer, which stores the pages layer by layer. */
+    Tensor host_pages;
+  };
+  /*! \brief The mapping from sequence ids to the swapped-out sequences. */
+  std::unordered_map<int64_t, SwappedSequence> swapped_seq_map_;
+  /*! \brief The host buffers read by the in-flight swap-in copies. */
+  std::vector<Tensor> swap_in_host_buffers_;
+
   /*********** Current Batch Info & Auxiliary Arrays on Device ***********/
   //-------------------------------------------
   // The following fields are auxiliary arrays on device.
@@ -171,6 +277,15 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   std::vector<bool> use_decode_kernel_;
   /*! \brief Whether the attention request is a decode request, set in BeginForwardFunction. */
   bool is_decode_request_;
+  /*!
+   * \brief Whether the auxiliary arrays of the last forward can be patched in place
+   * by the next forward, when it is a decode step over the same batch.
+   * It requires the last forward to be a plain single-depth decode.
+   * Any sequence or block mutation outside BeginForward resets it.
+   */
+  bool incremental_decode_aux_valid_ = false;
+  /*! \brief The last block of each sequence in the last incrementally patchable forward. */
+  std::vector<int32_t> incremental_decode_block_ids_;
   /*! \brief The KV transfer recver disco group's PE offset in this forward.
              If no KV is transfered, recver is -1.
              Assume that all the KV are transfered to the same recver in the forward.
@@ -184,6 +299,14 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   Tensor temp_attn_q_device_;
   Tensor temp_attn_k_device_;
   Tensor temp_attn_v_device_;
+  /*!
+   * \brief The second pair of temporary k/v arrays used by odd layers when KV transfer
+   * is enabled. The KV transfer of one layer reads its k/v data on the transfer stream
+   * while the next layer writes its own k/v data, so adjacent layers must not share
+   * the temporary k/v arrays.
+   */
+  Tensor temp_attn_k_transfer_device_;
+  Tensor temp_attn_v_transfer_device_;
   Tensor temp_attn_output_device_;
   Tensor temp_attn_lse_device_;
   Tensor merged_attn_lse_device_;
@@ -255,6 +378,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   ffi::Optional<ffi::Function> f_transpose_append_mla_;
   ffi::Optional<ffi::Function> f_transfer_kv_;
   ffi::Optional<ffi::Function> f_transfer_kv_page_to_page_ = std::nullopt;
+  ffi::Optional<ffi::Function> f_transfer_kv_query_done_ = std::nullopt;
   ffi::Function f_compact_copy_;
   std::unique_ptr<RaggedPrefillFunc> f_attention_prefill_ragged_;
   std::unique_ptr<PagedPrefillFunc> f_attention_prefill_;
@@ -287,7 +411,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       int64_t num_total_pages, int64_t prefill_chunk_size, bool support_sliding_window,
       RoPEMode rope_mode, double rotary_scale, double rotary_theta,
       ffi::Optional<Tensor> rope_ext_factors, bool enable_kv_transfer, DLDataType dtype,
-      Device device, ffi::Optional<ffi::Function> f_transpose_append_mha,
+      DLDataType kv_dtype, bool enable_cuda_graph, Device device,
+      ffi::Optional<ffi::Function> f_transpose_append_mha,
       ffi::Optional<ffi::Function> f_transpose_append_mla, ffi::Function f_compact_copy,
       std::unique_ptr<RaggedPrefillFunc> f_attention_prefill_ragged,
       std::unique_ptr<PagedPrefillFunc> f_attention_prefill,
@@ -320,7 +445,9 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         rotary_scale_(rotary_scale),
         rotary_theta_(rotary_theta),
         rope_ext_factors_(std::move(rope_ext_factors)),
-        kv_dtype_(DataType(dtype)),
+        dtype_(DataType(dtype)),
+        kv_dtype_(DataType(kv_dtype)),
+        enable_cuda_graph_(enable_cuda_graph),
         f_transpose_append_mha_(std::move(f_transpose_append_mha)),
         f_transpose_append_mla_(std::move(f_transpose_append_mla)),
         f_compact_copy_(std::move(f_compact_copy)),
@@ -342,6 +469,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     if (std::find(attn_kinds_.begin(), attn_kinds_.end(), AttnKind::kMLA) != attn_kinds_.end()) {
       TVM_FFI_ICHECK(!support_sliding_window_) << "Sliding window not supported yet for MLA";
       TVM_FFI_ICHECK(!enable_kv_transfer) << "KV transfer not supported yet for MLA";
+      TVM_FFI_ICHECK(dtype_ == kv_dtype_) << "KV data type conversion not supported yet for MLA";
     }
 
     pages_.reserve(num_layers);
@@ -350,6 +478,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       for (AttnKind attn_kind : attn_kinds_) {
         TVM_FFI_ICHECK(attn_kind == AttnKind::kMHA);
       }
+      TVM_FFI_ICHECK(dtype_ == kv_dtype_)
+          << "KV transfer does not support KV data type conversion yet.";
       const auto f_nvshmem_init =
           tvm::ffi::Function::GetGlobal("runtime.disco.nvshmem.init_nvshmem");
       TVM_FFI_ICHECK(f_nvshmem_init.has_value())
@@ -371,16 +501,20 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       const auto f_transfer_kv_ptr = tvm::ffi::Function::GetGlobal("nvshmem.KVTransfer");
       const auto f_transfer_kv_page_to_page_ptr =
           tvm::ffi::Function::GetGlobal("nvshmem.KVTransferPageToPage");
+      const auto f_transfer_kv_query_done_ptr =
+          tvm::ffi::Function::GetGlobal("nvshmem.KVTransferQueryDone");
       TVM_FFI_ICHECK(f_transfer_kv_ptr.has_value());
       TVM_FFI_ICHECK(f_transfer_kv_page_to_page_ptr.has_value());
+      TVM_FFI_ICHECK(f_transfer_kv_query_done_ptr.has_value());
       f_transfer_kv_ = *f_transfer_kv_ptr;
       f_transfer_kv_page_to_page_ = *f_transfer_kv_page_to_page_ptr;
+      f_transfer_kv_query_done_ = *f_transfer_kv_query_done_ptr;
     } else {
       for (int i = 0; i < num_layers; ++i) {
         ffi::Shape kv_cache_shape =
             GetKVCacheShape(attn_kinds_[layer_id_begin_offset_ + i], num_total_pages,
                             reserved_num_seqs, num_kv_heads, page_size, qk_head_dim, v_head_dim);
-        pages_.push_back(Tensor::Empty(kv_cache_shape, dtype, device));
+        pages_.push_back(Tensor::Empty(kv_cache_shape, kv_dtype, device));
       }
     }
 
@@ -476,6 +610,12 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
           Tensor::Empty({prefill_chunk_size_, num_kv_heads, qk_head_dim}, dtype, device);
       temp_attn_v_device_ =
           Tensor::Empty({prefill_chunk_size_, num_kv_heads, v_head_dim}, dtype, device);
+      if (enable_kv_transfer) {
+        temp_attn_k_transfer_device_ =
+            Tensor::Empty({prefill_chunk_size_, num_kv_heads, qk_head_dim}, dtype, device);
+        temp_attn_v_transfer_device_ =
+            Tensor::Empty({prefill_chunk_size_, num_kv_heads, v_head_dim}, dtype, device);
+      }
     }
     temp_attn_output_device_ =
         Tensor::Empty({prefill_chunk_size_, num_qo_heads, v_head_dim}, dtype, device);
@@ -486,6 +626,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     for (int64_t page_id = num_total_pages - 1; page_id >= 0; --page_id) {
       free_page_ids_.push_back(page_id);
     }
+    page_ref_cnt_.assign(num_total_pages, 0);
+    page_shared_length_.assign(num_total_pages, 0);
 
     // If the device is CUDA/ROCm, we create a standalone copy stream, in
     // purpose to hide the latency of auxiliary stream copy.
@@ -500,8 +642,18 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     // Create the auxiliary data manager for attention.
     // We only use the merged aux data for CUDA, since direct pointer
     // operations may have issues on other platforms.
-    if (device_.device_type == DLDeviceType::kDLCUDA ||
-        device_.device_type == DLDeviceType::kDLCPU) {
+    // In CUDA graph mode, each auxiliary array lives at a fixed address instead,
+    // so that the captured kernels remain valid across forwards.
+    if (enable_cuda_graph_) {
+      TVM_FFI_ICHECK(!NeedKernelBeginForward())
+          << "CUDA graph mode of KV cache only supports TIR attention kernels.";
+      TVM_FFI_ICHECK(!support_sliding_window_ && !enable_kv_transfer)
+          << "CUDA graph mode of KV cache does not support sliding window or KV transfer.";
+      aux_data_manager_ = std::make_unique<PlainPagedKVCacheAuxDataManager>(
+          reserved_num_seqs, num_total_pages, prefill_chunk_size, dtype_aux_, device,
+          preferred_host_device, copy_stream_, /*fixed_capacity_page_indices=*/true);
+    } else if (device_.device_type == DLDeviceType::kDLCUDA ||
+               device_.device_type == DLDeviceType::kDLCPU) {
       aux_data_manager_ = std::make_unique<CachedPagedKVCacheAuxDataManager>(
           reserved_num_seqs, num_total_pages, prefill_chunk_size, dtype_aux_, device,
           preferred_host_device, copy_stream_);
@@ -535,15 +687,23 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     for (int64_t page_id = num_total_pages_ - 1; page_id >= 0; --page_id) {
       free_page_ids_.push_back(page_id);
     }
+    std::fill(page_ref_cnt_.begin(), page_ref_cnt_.end(), 0);
     global_block_pool_.clear();
     free_block_idx_.clear();
+    prefix_cache_nodes_.clear();
+    prefix_cache_children_.clear();
+    prefix_cache_entries_.clear();
+    swapped_seq_map_.clear();
+    ReleaseSwapInHostBuffers();
     dirty_aux_data_device_ = false;
+    incremental_decode_aux_valid_ = false;
   }
 
   /************** Sequence Management **************/
 
   void AddSequence(int64_t seq_id) final {
-    TVM_FFI_ICHECK(seq_map_.find(seq_id) == seq_map_.end())
+    TVM_FFI_ICHECK(seq_map_.find(seq_id) == seq_map_.end() &&
+                   swapped_seq_map_.find(seq_id) == swapped_seq_map_.end())
         << "The sequence \"" << seq_id << "\" is already in the KV cache.";
     int32_t block_idx = GetFreeBlock();
     seq_map_.insert({seq_id, Sequence(&global_block_pool_, block_idx)});
@@ -551,34 +711,31 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   }
 
   void RemoveSequence(int64_t seq_id) final {
+    incremental_decode_aux_valid_ = false;
+    auto swapped_it = swapped_seq_map_.find(seq_id);
+    if (swapped_it != swapped_seq_map_.end()) {
+      // The swapped-out KV data only lives in the host buffer, which is dropped with the entry.
+      if (swapped_it->second.parent_block_idx != -1) {
+        ReleaseBlockReference(swapped_it->second.parent_block_idx);
+      }
+      swapped_seq_map_.erase(swapped_it);
+      return;
+    }
     auto it = seq_map_.find(seq_id);
     TVM_FFI_ICHECK(it != seq_map_.end())
         << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
-    int32_t block_idx = it->second.last_block_idx;
-    // The block should have at least one reference, which comes from the sequence.
-    TVM_FFI_ICHECK_GE(global_block_pool_[block_idx].external_ref_cnt, 1);
-    while (block_idx != -1 && global_block_pool_[block_idx].external_ref_cnt == 1) {
-      // - Free pages in the last block.
-      for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
-        free_page_ids_.push_back(page_id);
-      }
-      free_block_idx_.push_back(block_idx);
-      block_idx = global_block_pool_[block_idx].parent_idx;
-    }
-    // - Decrease the external reference of the parent block.
-    if (block_idx != -1) {
-      TVM_FFI_ICHECK_GT(global_block_pool_[block_idx].external_ref_cnt, 1);
-      --global_block_pool_[block_idx].external_ref_cnt;
-    }
+    ReleaseBlockReference(it->second.last_block_idx);
     seq_map_.erase(it);
     dirty_aux_data_device_ = true;
   }
 
   void ForkSequence(int64_t parent_seq_id, int64_t child_seq_id, int64_t fork_pos = -1) final {
+    incremental_decode_aux_valid_ = false;
     auto parent_it = seq_map_.find(parent_seq_id);
     TVM_FFI_ICHECK(parent_it != seq_map_.end())
         << "The parent sequence \"" << parent_seq_id << "\" cannot be found in KV cache.";
-    TVM_FFI_ICHECK(seq_map_.find(child_seq_id) == seq_map_.end())
+    TVM_FFI_ICHECK(seq_map_.find(child_seq_id) == seq_map_.end() &&
+                   swapped_seq_map_.find(child_seq_id) == swapped_seq_map_.end())
         << "The child sequence \"" << child_seq_id << "\" is already in the KV cache.";
     TVM_FFI_ICHECK_GE(fork_pos, -1)
         << "The forked position should be non-negative, or -1 for last position as default.";
@@ -676,11 +833,23 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       global_block_pool_[child_block_idx].seq_length = in_page_offset;
 
       if (in_page_offset > 0) {
-        // Fork within a page and copy common page to child block partially
         int32_t src_page_id = global_block_pool_[forked_block_idx].page_ids[0];
-        int32_t tgt_page_id = GetFreePage();
-        global_block_pool_[child_block_idx].page_ids.push_back(tgt_page_id);
-        CopySinglePage(src_page_id, tgt_page_id, in_page_offset);
+        if (parent_it->second.sliding_window_size != -1) {
+          // Fork within a page and copy common page to child block partially, as the pages
+          // of the sliding window are moved in place.
+          int32_t tgt_page_id = GetFreePage();
+          global_block_pool_[child_block_idx].page_ids.push_back(tgt_page_id);
+          CopySinglePage(src_page_id, tgt_page_id, in_page_offset);
+        } else {
+          // Fork within a page and share the page with the child block, which is copied when
+          // a holder not of the longest length in the page writes into it.
+          if (page_ref_cnt_[src_page_id] == 1) {
+            page_shared_length_[src_page_id] =
+                std::min<int64_t>(page_size_, global_block_pool_[forked_block_idx].seq_length);
+          }
+          ++page_ref_cnt_[src_page_id];
+          global_block_pool_[child_block_idx].page_ids.push_back(src_page_id);
+        }
       }
       break;
     }
@@ -742,6 +911,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
 
   void EnableSlidingWindowForSeq(int64_t seq_id, int32_t sliding_window_size,
                                  int32_t attn_sink_size) final {
+    incremental_decode_aux_valid_ = false;
     // If per layer sliding window exists, enable sliding window for sequence
     TVM_FFI_ICHECK(support_sliding_window_ || support_layer_sliding_window_)
         << "The KV cache does not support sliding window.";
@@ -772,6 +942,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   }
 
   void PopN(int64_t seq_id, int32_t n) final {
+    incremental_decode_aux_valid_ = false;
     auto it = seq_map_.find(seq_id);
     TVM_FFI_ICHECK(it != seq_map_.end())
         << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
@@ -792,7 +963,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         n -= global_block_pool_[block_idx].seq_length;
         it->second.seq_length -= global_block_pool_[block_idx].seq_length;
         for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
-          free_page_ids_.push_back(page_id);
+          ReleasePage(page_id);
         }
         free_block_idx_.push_back(block_idx);
         block_idx = global_block_pool_[block_idx].parent_idx;
@@ -804,7 +975,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         int64_t tgt_npage =
             (global_block_pool_[block_idx].seq_length - n + page_size_ - 1) / page_size_;
         while (cur_npage > tgt_npage) {
-          free_page_ids_.push_back(global_block_pool_[block_idx].page_ids.back());
+          ReleasePage(global_block_pool_[block_idx].page_ids.back());
           global_block_pool_[block_idx].page_ids.pop_back();
           --cur_npage;
         }
@@ -832,10 +1003,201 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     dirty_aux_data_device_ = true;
   }
 
+  /************** Prefix Cache **************/
+
+  int64_t AddSequenceWithPrefixMatch(int64_t seq_id, const IntTuple& token_ids) final {
+    TVM_FFI_ICHECK(seq_map_.find(seq_id) == seq_map_.end())
+        << "The sequence \"" << seq_id << "\" is already in the KV cache.";
+    // Leave at least one token unmatched, so that the sequence has a non-empty forward.
+    int64_t max_num_pages =
+        token_ids.empty() ? 0 : (static_cast<int64_t>(token_ids.size()) - 1) / page_size_;
+    int32_t node_id = -1;
+    for (int64_t page = 0; page < max_num_pages; ++page) {
+      int32_t child_id = FindPrefixCacheChild(node_id, token_ids, page);
+      if (child_id == -1) {
+        break;
+      }
+      node_id = child_id;
+    }
+    if (node_id == -1) {
+      AddSequence(seq_id);
+      return 0;
+    }
+
+    const PrefixCacheNode& node = prefix_cache_nodes_.at(node_id);
+    int64_t prefix_length = static_cast<int64_t>(node.depth) * page_size_;
+    prefix_cache_entries_.at(node.cache_seq_id).last_access = ++prefix_cache_clock_;
+    // The fork position is page-aligned, so the child shares all the prefix pages
+    // with the cached sequence and no page copy happens.
+    ForkSequence(node.cache_seq_id, seq_id, prefix_length);
+    return prefix_length;
+  }
+
+  void CachePrefix(int64_t seq_id, const IntTuple& token_ids) final {
+    auto it = seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(it != seq_map_.end())
+        << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    TVM_FFI_ICHECK_EQ(it->second.sliding_window_size, -1)
+        << "The sequence \"" << seq_id
+        << "\" is enabled with sliding window and thus its KV data cannot be cached.";
+    TVM_FFI_ICHECK_LE(static_cast<int64_t>(token_ids.size()), it->second.seq_length)
+        << "The number of token ids " << token_ids.size() << " exceeds the length of sequence \""
+        << seq_id << "\", which is " << it->second.seq_length << ".";
+
+    // Walk down the tree along the pages that are already cached.
+    int64_t num_pages = static_cast<int64_t>(token_ids.size()) / page_size_;
+    int64_t num_matched_pages = 0;
+    int32_t node_id = -1;
+    for (; num_matched_pages < num_pages; ++num_matched_pages) {
+      int32_t child_id = FindPrefixCacheChild(node_id, token_ids, num_matched_pages);
+      if (child_id == -1) {
+        break;
+      }
+      node_id = child_id;
+    }
+    if (node_id != -1) {
+      prefix_cache_entries_.at(prefix_cache_nodes_.at(node_id).cache_seq_id).last_access =
+          ++prefix_cache_clock_;
+    }
+    if (num_matched_pages == num_pages) {
+      return;
+    }
+
+    // Retain the full pages of the sequence in a new internal sequence,
+    // which holds the tree nodes of the pages not cached yet.
+    int64_t cache_seq_id = next_prefix_cache_seq_id_++;
+    ForkSequence(seq_id, cache_seq_id, num_pages * page_size_);
+    PrefixCacheEntry& entry = prefix_cache_entries_[cache_seq_id];
+    for (int64_t page = num_matched_pages; page < num_pages; ++page) {
+      int32_t child_id = next_prefix_cache_node_id_++;
+      PrefixCacheNode& child = prefix_cache_nodes_[child_id];
+      child.page_token_ids = GetPageTokenIds(token_ids, page);
+      child.parent = node_id;
+      child.depth = page + 1;
+      child.cache_seq_id = cache_seq_id;
+      prefix_cache_children_.insert({{node_id, child.page_token_ids}, child_id});
+      entry.node_ids.push_back(child_id);
+      node_id = child_id;
+    }
+    entry.last_access = ++prefix_cache_clock_;
+  }
+
+  void ClearPrefixCache() final {
+    for (const auto& kv : prefix_cache_entries_) {
+      RemoveSequence(kv.first);
+    }
+    prefix_cache_entries_.clear();
+    prefix_cache_nodes_.clear();
+    prefix_cache_children_.clear();
+  }
+
+  /************** Host Swap **************/
+
+  void SwapOut(int64_t seq_id) final {
+    incremental_decode_aux_valid_ = false;
+    auto it = seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(it != seq_map_.end())
+        << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    TVM_FFI_ICHECK_EQ(it->second.sliding_window_size, -1)
+        << "The sequence \"" << seq_id
+        << "\" is enabled with sliding window and thus cannot be swapped out.";
+    TVM_FFI_ICHECK(it->second.accepted_indices_committed)
+        << "The sequence's token tree computed in the last round of forward has not been "
+           "committed with accepted nodes.";
+
+    // Collect the blocks exclusively owned by the sequence, starting from the root side.
+    std::vector<int32_t> exclusive_blocks;
+    int32_t block_idx = it->second.last_block_idx;
+    while (block_idx != -1 && global_block_pool_[block_idx].external_ref_cnt == 1) {
+      exclusive_blocks.push_back(block_idx);
+      block_idx = global_block_pool_[block_idx].parent_idx;
+    }
+    std::reverse(exclusive_blocks.begin(), exclusive_blocks.end());
+
+    // The reference of block_idx, from either the first exclusive block or the
+    // sequence itself, is kept by the swapped-out sequence.
+    SwappedSequence swapped{it->second, block_idx};
+    if (!exclusive_blocks.empty()) {
+      // The exclusive blocks are merged into one when swapped in.
+      // This is valid since all blocks except the last one are page-aligned.
+      std::vector<int32_t> page_ids;
+      swapped.start_pos = global_block_pool_[exclusive_blocks[0]].start_pos;
+      for (int32_t exclusive_block_idx : exclusive_blocks) {
+        const Block& block = global_block_pool_[exclusive_block_idx];
+        if (exclusive_block_idx != exclusive_blocks.back()) {
+          TVM_FFI_ICHECK_EQ(static_cast<int64_t>(block.page_ids.size()) * page_size_,
+                            block.seq_length);
+        }
+        swapped.length += block.seq_length;
+        page_ids.insert(page_ids.end(), block.page_ids.begin(), block.page_ids.end());
+      }
+      swapped.num_pages = page_ids.size();
+      if (!page_ids.empty()) {
+        Device host_device = GetPreferredHostDevice(device_);
+        memory::Allocator* allocator = memory::MemoryManager::GetOrCreateAllocator(
+            host_device, memory::AllocatorType::kPooled);
+        swapped.host_pages = allocator->Empty({swapped.num_pages * GetNumBytesPerPage()},
+                                              DataType::UInt(8), host_device);
+        CopyPagesWithHost(page_ids, swapped.host_pages, /*to_host=*/true);
+      }
+      // The released pages can be reused right away, since the copies are
+      // ordered before any attention computation of the next forward.
+      for (int32_t exclusive_block_idx : exclusive_blocks) {
+        for (int32_t page_id : global_block_pool_[exclusive_block_idx].page_ids) {
+          ReleasePage(page_id);
+        }
+        free_block_idx_.push_back(exclusive_block_idx);
+      }
+    }
+    seq_map_.erase(it);
+    swapped_seq_map_.emplace(seq_id, std::move(swapped));
+    dirty_aux_data_device_ = true;
+  }
+
+  void SwapIn(int64_t seq_id) final {
+    incremental_decode_aux_valid_ = false;
+    auto it = swapped_seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(it != swapped_seq_map_.end())
+        << "The sequence \"" << seq_id << "\" is not swapped out.";
+    const SwappedSequence& swapped = it->second;
+    Sequence seq = swapped.seq;
+    if (swapped.start_pos == -1) {
+      // Nothing was swapped out, and the sequence still holds its last block.
+      seq.last_block_idx = swapped.parent_block_idx;
+    } else {
+      while (static_cast<int32_t>(free_page_ids_.size()) < swapped.num_pages &&
+             EvictPrefixCacheEntry()) {
+      }
+      TVM_FFI_ICHECK_GE(static_cast<int32_t>(free_page_ids_.size()), swapped.num_pages)
+          << "The KV cache does not have enough free pages to swap in sequence \"" << seq_id
+          << "\", which requires " << swapped.num_pages << " pages.";
+      std::vector<int32_t> page_ids;
+      page_ids.reserve(swapped.num_pages);
+      for (int32_t i = 0; i < swapped.num_pages; ++i) {
+        page_ids.push_back(GetFreePage());
+      }
+      if (!page_ids.empty()) {
+        CopyPagesWithHost(page_ids, swapped.host_pages, /*to_host=*/false);
+        swap_in_host_buffers_.push_back(swapped.host_pages);
+      }
+      int32_t block_idx = GetFreeBlock();
+      Block& block = global_block_pool_[block_idx];
+      block.page_ids = std::move(page_ids);
+      block.start_pos = swapped.start_pos;
+      block.seq_length = swapped.length;
+      block.parent_idx = swapped.parent_block_idx;
+      block.external_ref_cnt = 1;
+      seq.last_block_idx = block_idx;
+    }
+    seq_map_.insert({seq_id, seq});
+    swapped_seq_map_.erase(it);
+    dirty_aux_data_device_ = true;
+  }
+
   /************** Raw Info Query **************/
 
   bool Empty() const final {
-    return seq_map_.empty() &&                                     //
+    return seq_map_.empty() && swapped_seq_map_.empty() &&         //
            free_block_idx_.size() == global_block_pool_.size() &&  //
            free_page_ids_.size() == static_cast<size_t>(num_total_pages_);
   }
@@ -845,11 +1207,58 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
   int32_t GetTotalSequenceLength() const final {
     int32_t total_seq_len = 0;
     for (const auto& it : seq_map_) {
+      // The internal sequences of the prefix cache are not counted.
+      if (prefix_cache_entries_.count(it.first)) {
+        continue;
+      }
       total_seq_len += it.second.seq_length;
     }
     return total_seq_len;
   }
 
+  int32_t GetNumPagesOfSequence(int64_t seq_id) const final {
+    int32_t num_pages = 0;
+    int32_t block_idx = GetLastDeviceBlockOfSequence(seq_id);
+    while (block_idx != -1) {
+      num_pages += global_block_pool_[block_idx].page_ids.size();
+      block_idx = global_block_pool_[block_idx].parent_idx;
+    }
+    return num_pages;
+  }
+
+  int32_t GetNumPagesFreedOnRemove(int64_t seq_id) const final {
+    // Follow the way ReleaseBlockReference releases the blocks.
+    int32_t num_pages = 0;
+    int32_t block_idx = GetLastDeviceBlockOfSequence(seq_id);
+    while (block_idx != -1 && global_block_pool_[block_idx].external_ref_cnt == 1) {
+      for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
+        // The pages shared with the forks of the sequence stay with the forks.
+        num_pages += page_ref_cnt_[page_id] == 1;
+      }
+      block_idx = global_block_pool_[block_idx].parent_idx;
+    }
+    return num_pages;
+  }
+
+  int32_t GetNumPagesNeededForAppend(int64_t seq_id, int64_t append_length) const final {
+    TVM_FFI_ICHECK_GE(append_length, 0) << "The append length cannot be negative.";
+    auto swapped_it = swapped_seq_map_.find(seq_id);
+    if (swapped_it != swapped_seq_map_.end() && swapped_it->second.start_pos != -1) {
+      // The swapped-out KV data is restored to a new block at swap-in.
+      const SwappedSequence& swapped = swapped_it->second;
+      int64_t tgt_npage = (swapped.length + append_length + page_size_ - 1) / page_size_;
+      return swapped.num_pages + std::max<int64_t>(tgt_npage - swapped.num_pages, 0);
+    }
+    // Follow the way ReserveAppendLengthInSeq reserves the pages.
+    const Block& block = global_block_pool_[GetLastDeviceBlockOfSequence(seq_id)];
+    int64_t cur_npage = block.page_ids.size();
+    int64_t tgt_npage = (block.seq_length - block.sink_length + block.sliding_window_offset +
+                         append_length + page_size_ - 1) /
+                        page_size_;
+    int64_t num_copied_pages = append_length > 0 && GetPageIndexToCopyOnWrite(block) != -1;
+    return std::max<int64_t>(tgt_npage - cur_npage, 0) + num_copied_pages;
+  }
+
   /************** Attention **************/
 
   void BeginForward(const ffi::Shape& seq_ids, const ffi::Shape& append_lengths,
@@ -863,6 +1272,12 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     TVM_FFI_ICHECK_EQ(seq_ids.size(), append_lengths.size())
         << "The seq_ids size (" << seq_ids.size() << ") and append_lengths size ("
         << append_lengths.size() << ") mismatch.";
+    bool same_batch_as_last_forward = incremental_decode_aux_valid_ &&
+                                      !opt_token_tree_parent_ptr.defined() &&
+                                      seq_ids.size() == cur_seq_ids_.size();
+    for (int i = 0; same_batch_as_last_forward && i < static_cast<int>(seq_ids.size()); ++i) {
+      same_batch_as_last_forward = seq_ids[i] == cur_seq_ids_[i];
+    }
     cur_batch_size_ = seq_ids.size();
     cur_seq_ids_ = seq_ids;
     cur_append_lengths_ = append_lengths;
@@ -893,6 +1308,14 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       }
     }
 
+    if (same_batch_as_last_forward && is_decode_request_ &&
+        IncrementalDecodeBeginForward(sequences)) {
+      if (enable_cuda_graph_) {
+        ComputeStreamWaitForCopyStream();
+      }
+      return;
+    }
+
     auto [block_ids_on_depths, trailing_blocks] =
         GetBlockIdsOnDepth(sequences, global_block_pool_, cur_batch_size_);
     num_depths_ =
@@ -1187,12 +1610,37 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         sequences[i]->kv_transfer_metadata.local_position_map.clear();
       }
     }
+
+    // Record whether the next decode step over the same batch can patch the auxiliary arrays.
+    incremental_decode_aux_valid_ = is_decode_request_ && !opt_token_tree_parent_ptr.defined() &&
+                                    num_depths_ == 1 && !support_sliding_window_ &&
+                                    !support_layer_sliding_window_ && !transfer_kv_ &&
+                                    !page_to_page_transfer_kv_;
+    incremental_decode_block_ids_.clear();
+    if (incremental_decode_aux_valid_) {
+      for (const Sequence* sequence : sequences) {
+        incremental_decode_block_ids_.push_back(sequence->last_block_idx);
+      }
+    }
+    if (enable_cuda_graph_) {
+      ComputeStreamWaitForCopyStream();
+    }
   }
 
   void EndForward() final {
     if (kv_transfer_stream_ != nullptr) {
       DeviceAPI::Get(device_)->SyncStreamFromTo(device_, kv_transfer_stream_, compute_stream_);
     }
+    // The swap-in copies have been overlapped with this round of forward.
+    ReleaseSwapInHostBuffers();
+  }
+
+  bool DisaggQueryTransferDone() final {
+    if (!f_transfer_kv_query_done_.defined()) {
+      // KV transfer is not enabled.
+      return true;
+    }
+    return f_transfer_kv_query_done_.value()(kv_transfer_stream_).cast<bool>();
   }
 
   ffi::Shape DisaggPrepareRecv(int64_t seq_id, int append_length) final {
@@ -1227,6 +1675,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
 
   void DisaggMarkSend(int64_t seq_id, int64_t begin,
                       const ffi::Shape& compressed_remote_position_map, int32_t recver_pe_offset) {
+    incremental_decode_aux_valid_ = false;
     TVM_FFI_ICHECK(f_transfer_kv_.defined());
     auto it = seq_map_.find(seq_id);
     TVM_FFI_ICHECK(it != seq_map_.end())
@@ -1284,9 +1733,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     int64_t local_layer_id = layer_id - layer_id_begin_offset_;
     TVM_FFI_ICHECK_GE(local_layer_id, 0);
     TVM_FFI_ICHECK_LT(local_layer_id, num_layers_);
-    Tensor pages = pages_[local_layer_id];
-    TVM_FFI_ICHECK(qkv_data.DataType() == pages.DataType());
-    TVM_FFI_ICHECK(o_data.DataType() == pages.DataType());
+    TVM_FFI_ICHECK(qkv_data.DataType() == dtype_);
+    TVM_FFI_ICHECK(o_data.DataType() == dtype_);
     TVM_FFI_ICHECK(attn_kinds_[layer_id] == AttnKind::kMHA ||
                    attn_kinds_[layer_id] == AttnKind::kMHASliding);
 
@@ -1317,10 +1765,15 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
 
     Tensor q_data = temp_attn_q_device_.CreateView({total_seq_length, num_qo_heads_, qk_head_dim_},
                                                    qkv_data->dtype);
-    Tensor k_data = temp_attn_k_device_.CreateView({total_seq_length, num_kv_heads_, qk_head_dim_},
-                                                   qkv_data->dtype);
-    Tensor v_data = temp_attn_v_device_.CreateView({total_seq_length, num_kv_heads_, qk_head_dim_},
-                                                   qkv_data->dtype);
+    // When KV transfer is on, adjacent layers alternate between two pairs of temporary
+    // k/v arrays, so that the transfer of one layer overlaps with the next layer.
+    bool use_transfer_temp_kv = transfer_kv_ && local_layer_id % 2 == 1;
+    Tensor k_data =
+        (use_transfer_temp_kv ? temp_attn_k_transfer_device_ : temp_attn_k_device_)
+            .CreateView({total_seq_length, num_kv_heads_, qk_head_dim_}, qkv_data->dtype);
+    Tensor v_data =
+        (use_transfer_temp_kv ? temp_attn_v_transfer_device_ : temp_attn_v_device_)
+            .CreateView({total_seq_length, num_kv_heads_, qk_head_dim_}, qkv_data->dtype);
 
     Tensor qkv_data_view = qkv_data;
     Tensor o_data_view = o_data;
@@ -1331,10 +1784,6 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
           o_data.CreateView({total_seq_length, num_qo_heads_, qk_head_dim_}, qkv_data->dtype);
     }
     // Part 2. Split fused qkv and apply rotary embedding to q/k data.
-    if (transfer_kv_) {
-      // The the compute stream needs to wait for the KV transfer stream.
-      DeviceAPI::Get(device_)->SyncStreamFromTo(device_, kv_transfer_stream_, compute_stream_);
-    }
     if (!rope_ext_factors_.defined()) {
       f_split_rotary_(qkv_data_view, q_rope_position_map_view_, q_data, k_data, v_data,
                       static_cast<int>(rope_mode_ == RoPEMode::kNormal));
@@ -1364,6 +1813,11 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     if (transfer_kv_) {
       // FIXME: if the sender and recver's PP/TP degree do not match, we will need to first
       // get the view of remote pages, and then take the specific remote layer.
+      // The compute stream waits for the transfer of the previous layer, which is the
+      // last layer that reads the temporary k/v arrays the next layer is going to write.
+      // The transfer of this layer then overlaps with the attention of this layer and
+      // the computation up to the attention of the next layer.
+      DeviceAPI::Get(device_)->SyncStreamFromTo(device_, kv_transfer_stream_, compute_stream_);
       // The KV transfer stream nees to wait for the compute stream.
       DeviceAPI::Get(device_)->SyncStreamFromTo(device_, compute_stream_, kv_transfer_stream_);
       f_transfer_kv_.value()(pages_[local_layer_id], k_data, v_data,
@@ -1385,11 +1839,10 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     int64_t local_layer_id = layer_id - layer_id_begin_offset_;
     TVM_FFI_ICHECK_GE(local_layer_id, 0);
     TVM_FFI_ICHECK_LT(local_layer_id, num_layers_);
-    Tensor pages = pages_[local_layer_id];
-    TVM_FFI_ICHECK(q_data.DataType() == pages.DataType());
-    TVM_FFI_ICHECK(k_data.DataType() == pages.DataType());
-    TVM_FFI_ICHECK(v_data.DataType() == pages.DataType());
-    TVM_FFI_ICHECK(o_data.DataType() == pages.DataType());
+    TVM_FFI_ICHECK(q_data.DataType() == dtype_);
+    TVM_FFI_ICHECK(k_data.DataType() == dtype_);
+    TVM_FFI_ICHECK(v_data.DataType() == dtype_);
+    TVM_FFI_ICHECK(o_data.DataType() == dtype_);
     AttnKind attn_kind = attn_kinds_[layer_id];
 
     // q_data: (num_total_length, num_qo_heads, qk_head_dim)
@@ -1428,9 +1881,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     int64_t local_layer_id = layer_id - layer_id_begin_offset_;
     TVM_FFI_ICHECK_GE(local_layer_id, 0);
     TVM_FFI_ICHECK_LT(local_layer_id, num_layers_);
-    Tensor pages = pages_[local_layer_id];
-    TVM_FFI_ICHECK(q_data.DataType() == pages.DataType());
-    TVM_FFI_ICHECK(o_data.DataType() == pages.DataType());
+    TVM_FFI_ICHECK(q_data.DataType() == dtype_);
+    TVM_FFI_ICHECK(o_data.DataType() == dtype_);
     AttnKind attn_kind = attn_kinds_[layer_id];
 
     // q_data: (num_total_length, num_qo_heads, qk_head_dim)
@@ -1503,6 +1955,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
 
   void CommitAcceptedTokenTreeNodes(const ffi::Shape& seq_ids,
                                     const ffi::Shape& leaf_indices) final {
+    incremental_decode_aux_valid_ = false;
     TVM_FFI_ICHECK_EQ(seq_ids.size(), leaf_indices.size())
         << "The given seq_ids and leaf_indices have different size.";
     int num_seq_to_commit = seq_ids.size();
@@ -1515,7 +1968,8 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
       TVM_FFI_ICHECK(it != seq_map_.end())
           << "The sequence \"" << seq_ids[i] << "\" cannot be found in KV cache.";
       sequences.push_back(&it->second);
-      is_chain = it->second.is_chain;
+      // KV compaction is needed as long as any sequence in the batch has a non-chain tree.
+      is_chain = is_chain && it->second.is_chain;
       TVM_FFI_ICHECK(leaf_indices[i] == -1 || !it->second.accepted_indices_committed)
           << "The accepted nodes of sequence " << seq_ids[i] << " are already committed.";
       TVM_FFI_ICHECK_GE(leaf_indices[i], -1)
@@ -1712,13 +2166,44 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
  private:
   /*! \brief Get a new free page and return its id. */
   int32_t GetFreePage() {
+    // Reclaim the pages retained by the prefix cache when no free page is left.
+    while (free_page_ids_.empty() && EvictPrefixCacheEntry()) {
+    }
     // Find a page from the free page pools.
     TVM_FFI_ICHECK(!free_page_ids_.empty()) << "The KV cache is full. No page can be allocated.";
     int32_t page_id = free_page_ids_.back();
     free_page_ids_.pop_back();
+    page_ref_cnt_[page_id] = 1;
     return page_id;
   }
 
+  /*! \brief Release the reference of a block to a page, freeing the page when it is the last. */
+  void ReleasePage(int32_t page_id) {
+    TVM_FFI_ICHECK_GT(page_ref_cnt_[page_id], 0);
+    if (--page_ref_cnt_[page_id] == 0) {
+      free_page_ids_.push_back(page_id);
+    }
+  }
+
+  /*!
+   * \brief Get the index in the block of the page that the next KV values of the block are
+   * written into, if it is a page shared with other blocks that the block cannot write in place,
+   * or -1 otherwise.
+   */
+  int32_t GetPageIndexToCopyOnWrite(const Block& block) const {
+    int32_t offset = block.seq_length - block.sink_length + block.sliding_window_offset;
+    int32_t page_idx = offset / page_size_;
+    if (page_idx >= static_cast<int32_t>(block.page_ids.size())) {
+      return -1;
+    }
+    int32_t page_id = block.page_ids[page_idx];
+    if (page_id == kPagedKVCacheTempPageId || page_ref_cnt_[page_id] == 1 ||
+        page_shared_length_[page_id] == offset % page_size_) {
+      return -1;
+    }
+    return page_idx;
+  }
+
   /*! \brief Get a new free block and return its index. */
   int32_t GetFreeBlock() {
     if (!free_block_idx_.empty()) {
@@ -1734,6 +2219,181 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     return block_idx;
   }
 
+  /*!
+   * \brief Release one reference of the given block. The block and its ancestors
+   * that are no longer referenced are freed together with their pages.
+   */
+  /*!
+   * \brief Get the last block on device of the given sequence, or -1 if the sequence
+   * is swapped out and does not have any block on device.
+   */
+  int32_t GetLastDeviceBlockOfSequence(int64_t seq_id) const {
+    auto it = seq_map_.find(seq_id);
+    if (it != seq_map_.end()) {
+      return it->second.last_block_idx;
+    }
+    auto swapped_it = swapped_seq_map_.find(seq_id);
+    TVM_FFI_ICHECK(swapped_it != swapped_seq_map_.end())
+        << "The sequence \"" << seq_id << "\" cannot be found in KV cache.";
+    return swapped_it->second.parent_block_idx;
+  }
+
+  void ReleaseBlockReference(int32_t block_idx) {
+    // The block should have at least one reference, which comes from the releaser.
+    TVM_FFI_ICHECK_GE(global_block_pool_[block_idx].external_ref_cnt, 1);
+    while (block_idx != -1 && global_block_pool_[block_idx].external_ref_cnt == 1) {
+      // - Free pages in the last block.
+      for (int32_t page_id : global_block_pool_[block_idx].page_ids) {
+        ReleasePage(page_id);
+      }
+      free_block_idx_.push_back(block_idx);
+      block_idx = global_block_pool_[block_idx].parent_idx;
+    }
+    // - Decrease the external reference of the parent block.
+    if (block_idx != -1) {
+      TVM_FFI_ICHECK_GT(global_block_pool_[block_idx].external_ref_cnt, 1);
+      --global_block_pool_[block_idx].external_ref_cnt;
+    }
+  }
+
+  /*! \brief Get the number of bytes of a page across all layers. */
+  int64_t GetNumBytesPerPage() const {
+    int64_t num_bytes = 0;
+    for (const Tensor& pages : pages_) {
+      num_bytes += GetDataSize(*pages.operator->()) / pages->shape[0];
+    }
+    return num_bytes;
+  }
+
+  /*!
+   * \brief Copy the KV data of the given pages between device and a host buffer
+   * on the copy stream. The host buffer stores the pages layer by layer, and
+   * runs of consecutive page ids are copied together.
+   */
+  void CopyPagesWithHost(const std::vector<int32_t>& page_ids, const Tensor& host_pages,
+                         bool to_host) {
+    DeviceAPI* device_api = DeviceAPI::Get(device_);
+    if (copy_stream_ != nullptr) {
+      // Order the copies after the computation that accesses the pages.
+      device_api->SyncStreamFromTo(device_, compute_stream_, copy_stream_);
+    }
+    int64_t host_offset = 0;
+    for (const Tensor& pages : pages_) {
+      int64_t page_bytes = GetDataSize(*pages.operator->()) / pages->shape[0];
+      for (size_t begin = 0; begin < page_ids.size();) {
+        size_t end = begin + 1;
+        while (end < page_ids.size() && page_ids[end] == page_ids[end - 1] + 1) {
+          ++end;
+        }
+        int64_t num_bytes = static_cast<int64_t>(end - begin) * page_bytes;
+        DLTensor device_view = *pages.operator->();
+        DLTensor host_view = *host_pages.operator->();
+        for (DLTensor* view : {&device_view, &host_view}) {
+          view->ndim = 1;
+          view->shape = &num_bytes;
+          view->strides = nullptr;
+          view->dtype = DataType::UInt(8);
+        }
+        device_view.byte_offset += page_ids[begin] * page_bytes;
+        host_view.byte_offset += host_offset + begin * page_bytes;
+        if (to_host) {
+          device_api->CopyDataFromTo(&device_view, &host_view, copy_stream_);
+        } else {
+          device_api->CopyDataFromTo(&host_view, &device_view, copy_stream_);
+        }
+        begin = end;
+      }
+      host_offset += page_ids.size() * page_bytes;
+    }
+  }
+
+  /*! \brief Wait for the in-flight swap-in copies and release their host buffers. */
+  void ReleaseSwapInHostBuffers() {
+    if (swap_in_host_buffers_.empty()) {
+      return;
+    }
+    DeviceAPI::Get(device_)->StreamSync(device_, copy_stream_);
+    swap_in_host_buffers_.clear();
+  }
+
+  /*! \brief Get the token ids of the given page from the token id list. */
+  std::vector<int64_t> GetPageTokenIds(const IntTuple& token_ids, int64_t page) const {
+    std::vector<int64_t> page_token_ids;
+    page_token_ids.reserve(page_size_);
+    for (int64_t i = page * page_size_; i < (page + 1) * page_size_; ++i) {
+      page_token_ids.push_back(token_ids[i]);
+    }
+    return page_token_ids;
+  }
+
+  /*!
+   * \brief Find the prefix cache child node of the given node, which matches
+   * the given page of the token ids.
+   * \return The id of the child node, or -1 when there is no match.
+   */
+  int32_t FindPrefixCacheChild(int32_t node_id, const IntTuple& token_ids, int64_t page) const {
+    auto it = prefix_cache_children_.find({node_id, GetPageTokenIds(token_ids, page)});
+    return it == prefix_cache_children_.end() ? -1 : it->second;
+  }
+
+  /*!
+   * \brief Evict the least recently used prefix cache entry whose removal
+   * releases at least one page.
+   * \return Whether an entry is evicted.
+   */
+  bool EvictPrefixCacheEntry() {
+    auto victim = prefix_cache_entries_.end();
+    for (auto it = prefix_cache_entries_.begin(); it != prefix_cache_entries_.end(); ++it) {
+      if (victim != prefix_cache_entries_.end() &&
+          victim->second.last_access <= it->second.last_access) {
+        continue;
+      }
+      // Entries whose pages are all shared with other sequences release nothing.
+      bool release_pages = false;
+      int32_t block_idx = seq_map_.at(it->first).last_block_idx;
+      while (block_idx != -1 && global_block_pool_[block_idx].external_ref_cnt == 1) {
+        if (!global_block_pool_[block_idx].page_ids.empty()) {
+          release_pages = true;
+          break;
+        }
+        block_idx = global_block_pool_[block_idx].parent_idx;
+      }
+      if (release_pages) {
+        victim = it;
+      }
+    }
+    if (victim == prefix_cache_entries_.end()) {
+      return false;
+    }
+
+    int64_t cache_seq_id = victim->first;
+    std::vector<int32_t> node_ids = std::move(victim->second.node_ids);
+    prefix_cache_entries_.erase(victim);
+    // The nodes of an entry form a chain. Process them from the deepest one.
+    // A node that still has children is covered by the sequence of its child,
+    // so the node and all its ancestors are handed over to that sequence.
+    std::sort(node_ids.begin(), node_ids.end(), [this](int32_t lhs, int32_t rhs) {
+      return prefix_cache_nodes_.at(lhs).depth > prefix_cache_nodes_.at(rhs).depth;
+    });
+    for (size_t i = 0; i < node_ids.size(); ++i) {
+      auto child_it = prefix_cache_children_.lower_bound({node_ids[i], {}});
+      if (child_it != prefix_cache_children_.end() && child_it->first.first == node_ids[i]) {
+        int64_t heir_seq_id = prefix_cache_nodes_.at(child_it->second).cache_seq_id;
+        PrefixCacheEntry& heir = prefix_cache_entries_.at(heir_seq_id);
+        for (size_t j = i; j < node_ids.size(); ++j) {
+          prefix_cache_nodes_.at(node_ids[j]).cache_seq_id = heir_seq_id;
+          heir.node_ids.push_back(node_ids[j]);
+        }
+        break;
+      }
+      const PrefixCacheNode& node = prefix_cache_nodes_.at(node_ids[i]);
+      prefix_cache_children_.erase(std::make_pair(node.parent, node.page_token_ids));
+      prefix_cache_nodes_.erase(node_ids[i]);
+    }
+    RemoveSequence(cache_seq_id);
+    return true;
+  }
+
   void ConstructTokenTreeMask(const std::vector<Sequence*>& sequences,
                               const ffi::Shape& token_tree_parent_ptr,
                               const std::vector<std::vector<int32_t>>& block_ids_on_depths,
@@ -1905,7 +2565,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     // - Free the pages that are fully slidden.
     while (page_idx_after_sliding > num_sink_pages) {
       if (block.page_ids[num_sink_pages] != kPagedKVCacheTempPageId) {
-        free_page_ids_.push_back(block.page_ids[num_sink_pages]);
+        ReleasePage(block.page_ids[num_sink_pages]);
       }
       block.page_ids.erase(block.page_ids.begin() + num_sink_pages);
       --page_idx_after_sliding;
@@ -1946,6 +2606,26 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
         << "The block is " << block.external_ref_cnt - 1
         << "-time referenced by other blocks, thus cannot accept new KV values.";
 
+    // ==================== Copy on write ====================
+    // The page of the block that the values are written into may be shared with other blocks,
+    // which read its leading tokens. The block writes in place when it holds the most tokens of
+    // the page, as no other block reads the positions it writes, and copies the page otherwise.
+    int32_t write_offset = block.seq_length - block.sink_length + block.sliding_window_offset;
+    int32_t cow_page_idx = GetPageIndexToCopyOnWrite(block);
+    if (cow_page_idx != -1) {
+      int32_t src_page_id = block.page_ids[cow_page_idx];
+      int32_t tgt_page_id = GetFreePage();
+      CopySinglePage(src_page_id, tgt_page_id, write_offset % page_size_);
+      ReleasePage(src_page_id);
+      block.page_ids[cow_page_idx] = tgt_page_id;
+    } else if (write_offset / page_size_ < static_cast<int64_t>(block.page_ids.size())) {
+      int32_t page_id = block.page_ids[write_offset / page_size_];
+      if (page_id != kPagedKVCacheTempPageId && page_ref_cnt_[page_id] > 1) {
+        page_shared_length_[page_id] =
+            std::min<int64_t>(page_size_, write_offset % page_size_ + append_length);
+      }
+    }
+
     // ==================== Reserve ====================
     // The reservation is based on the current sequence length.
     // If "current sequence + append length" does not exceed the
@@ -1980,6 +2660,100 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
     dirty_aux_data_device_ = true;
   }
 
+  /*!
+   * \brief The BeginForward path of a decode step over the same batch as the last forward,
+   * which was a single-depth decode. In this case every sequence grows by exactly one token,
+   * so instead of rebuilding the auxiliary arrays from the block structures, we patch the
+   * page table (appending the newly reserved pages) and the per-sequence lengths in place.
+   * The sequence lengths and k_ragged_rope_pos_offset are expected to be updated already.
+   * \return A boolean indicating whether the incremental path applies.
+   * If false, nothing is changed and the caller falls back to the full update.
+   */
+  bool IncrementalDecodeBeginForward(const std::vector<Sequence*>& sequences) {
+    TVM_FFI_ICHECK_EQ(num_depths_, 1);
+    if (static_cast<int64_t>(incremental_decode_block_ids_.size()) != cur_batch_size_) {
+      return false;
+    }
+    for (int i = 0; i < cur_batch_size_; ++i) {
+      // A sequence copying a shared page on write changes the pages before its last one.
+      if (sequences[i]->last_block_idx != incremental_decode_block_ids_[i] ||
+          sequences[i]->seq_length - 1 >= sequences[i]->kv_transfer_metadata.start ||
+          GetPageIndexToCopyOnWrite(global_block_pool_[sequences[i]->last_block_idx]) != -1) {
+        return false;
+      }
+    }
+
+    if (append_before_attn_) {
+      for (int i = 0; i < cur_batch_size_; ++i) {
+        ReserveAppendLengthInSeq(sequences[i], /*append_length=*/1);
+      }
+    }
+
+    // - Patch the page table. The pages of each sequence can only have grown at the end,
+    // so we shift the page segments back-to-front and write the new pages in place.
+    HostMemoryVector& page_indptr_h = page_indptr_on_depths_host_[0];
+    HostMemoryVector& page_indices_h = page_indices_on_depths_host_[0];
+    TVM_FFI_ICHECK_EQ(page_indptr_h.size(), cur_batch_size_ + 1);
+    int32_t* page_indptr = page_indptr_h.data();
+    int64_t num_new_pages = 0;
+    for (int i = 0; i < cur_batch_size_; ++i) {
+      const Block& block = global_block_pool_[sequences[i]->last_block_idx];
+      int64_t num_added = static_cast<int64_t>(block.page_ids.size()) -
+                          (page_indptr[i + 1] - page_indptr[i]);
+      TVM_FFI_ICHECK_GE(num_added, 0);
+      num_new_pages += num_added;
+    }
+    if (num_new_pages > 0) {
+      page_indices_h.resize(page_indices_h.size() + num_new_pages);
+      int32_t* page_indices = page_indices_h.data();
+      int64_t shift = num_new_pages;
+      for (int i = cur_batch_size_ - 1; i >= 0 && shift > 0; --i) {
+        const Block& block = global_block_pool_[sequences[i]->last_block_idx];
+        int32_t begin = page_indptr[i];
+        int32_t num_old_pages = page_indptr[i + 1] - begin;
+        shift -= static_cast<int64_t>(block.page_ids.size()) - num_old_pages;
+        if (shift > 0) {
+          std::memmove(page_indices + begin + shift, page_indices + begin,
+                       num_old_pages * sizeof(int32_t));
+        }
+        for (int j = num_old_pages; j < static_cast<int>(block.page_ids.size()); ++j) {
+          page_indices[begin + shift + j] = block.page_ids[j];
+        }
+      }
+    }
+    int32_t* last_page_len = last_page_len_on_depths_host_[0].data();
+    for (int i = 0; i < cur_batch_size_; ++i) {
+      const Block& block = global_block_pool_[sequences[i]->last_block_idx];
+      page_indptr[i + 1] = page_indptr[i] + block.page_ids.size();
+      last_page_len[i] =
+          (block.seq_length - block.sink_length + block.sliding_window_offset - 1) % page_size_ +
+          1;
+    }
+
+    if (!append_before_attn_) {
+      for (int i = 0; i < cur_batch_size_; ++i) {
+        ReserveAppendLengthInSeq(sequences[i], /*append_length=*/1);
+      }
+    }
+
+    // - Patch the position maps of the single token appended to each sequence.
+    // The KV transfer maps stay all "-1" as in the last forward.
+    TVM_FFI_ICHECK_EQ(append_position_map_host_.size(), cur_batch_size_);
+    TVM_FFI_ICHECK_EQ(kv_transfer_remote_position_map_host_.size(), cur_batch_size_);
+    int32_t* q_rope_position_map = q_rope_position_map_host_.data();
+    int32_t* append_position_map = append_position_map_host_.data();
+    for (int i = 0; i < cur_batch_size_; ++i) {
+      const Block& block = global_block_pool_[sequences[i]->last_block_idx];
+      int32_t offset_in_block = block.seq_length - 1;
+      q_rope_position_map[i] = k_ragged_rope_pos_offset_host_[i];
+      append_position_map[i] =
+          block.page_ids[offset_in_block / page_size_] * page_size_ + offset_in_block % page_size_;
+    }
+    incremental_decode_aux_valid_ = true;
+    dirty_aux_data_device_ = true;
+    return true;
+  }
+
   /*! \brief Check whether BeginForward for kernels is needed. */
   bool NeedKernelBeginForward() {
     std::vector<AttnBackendFunc*> funcs = {f_attention_prefill_.get(),
@@ -2040,7 +2814,7 @@ class PagedAttentionKVCacheObj : public AttentionKVCacheObj {
               d, temp_float_attn_workspace_, temp_int_attn_workspace_[d + 1],
               temp_int_pinned_attn_workspace_[d + 1], &page_indptr_on_depths_host_[d],
               cur_batch_size_, page_size_, num_qo_heads_, num_kv_heads_, qk_head_dim_, v_head_dim_,
-              rope_mode_, kv_dtype_, kv_dtype_, copy_stream_);
+              rope_mode_, dtype_, kv_dtype_, copy_stream_);
         }
       } else {
         if (f_attention_prefill_ != nullptr &&
@@ -2457,7 +3231,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def_packed(
       "vm.builtin.paged_attention_kv_cache_create", [](ffi::PackedArgs args, ffi::Any* rv) {
         // Todo: cuda graph arg
-        TVM_FFI_ICHECK(args.size() == 28 || args.size() == 29)
+        TVM_FFI_ICHECK(args.size() >= 28 && args.size() <= 30)
             << "Invalid number of KV cache constructor args: " << args.size();
         ffi::Shape cache_config = args[0].cast<ffi::Shape>();
         ffi::Shape layer_indptr_tuple = args[1].cast<ffi::Shape>();
@@ -2510,6 +3284,16 @@ TVM_FFI_STATIC_INIT_BLOCK() {
         if (auto opt_nd = args[11].as<Tensor>()) {
           rope_ext_factors = opt_nd.value();
         }
+        // The optional args[28] specifies the dtype of the KV data stored in pages.
+        // By default the pages use the same dtype as `init`.
+        DLDataType kv_dtype = init->dtype;
+        if (args.size() >= 29) {
+          if (auto opt_kv_dtype = args[28].as<DLDataType>()) {
+            kv_dtype = opt_kv_dtype.value();
+          }
+        }
+        // The optional args[29] specifies whether to enable the CUDA graph mode.
+        bool enable_cuda_graph = args.size() == 30 && args[29].cast<bool>();
         auto f_convert_optional_packed_func = [&args](int arg_idx) -> ffi::Optional<ffi::Function> {
           if (auto opt_func = args[arg_idx].as<ffi::Function>()) {
             return opt_func.value();
@@ -2544,7 +3328,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
             num_kv_heads, qk_head_dim, v_head_dim, attn_kinds_vec, reserved_num_seqs,
             num_total_pages, prefill_chunk_size, support_sliding_window, RoPEMode(rope_mode),
             rotary_scale, rotary_theta, std::move(rope_ext_factors), enable_kv_transfer,  //
-            init->dtype, init->device,                                                    //
+            init->dtype, kv_dtype, enable_cuda_graph, init->device,                       //
             std::move(f_transpose_append_mha), std::move(f_transpose_append_mla),
             std::move(f_compact_copy), std::move(f_attention_prefill_ragged),
             std::move(f_attention_prefill), std::move(f_attention_decode),
@@ -23,7 +23,9 @@
 
 #include <tvm/ffi/reflection/registry.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "kv_state.h"
@@ -53,8 +55,17 @@ class RNNStateImpObj : public RNNStateObj {
     int64_t available_history_num = 0;
     /*! \brief The index of history slot in the storage. */
     int64_t history_slot_id = 0;
-    /*! \brief The index of seq slot in the storage. */
+    /*!
+     * \brief The index of seq slot in the storage.
+     * The slot may be shared with forked sequences, and is copied before being written.
+     */
     int64_t seq_slot_id;
+    /*!
+     * \brief The checkpoints of the sequence state, as pairs of the sequence position
+     * and the checkpoint slot id, sorted by position in ascending order.
+     * Checkpoint slots may be shared with forked sequences.
+     */
+    std::vector<std::pair<int64_t, int64_t>> checkpoints;
 
     /*! \brief Constructor. */
     explicit Sequence(int64_t seq_slot_id) : seq_slot_id(seq_slot_id) {}
@@ -81,6 +92,13 @@ class RNNStateImpObj : public RNNStateObj {
    * The array has `num_states_per_layer_` Tensors
    */
   const ffi::Array<Tensor> init_layer_value_;
+  /*!
+   * \brief The sequence length interval between two state checkpoints of a sequence.
+   * Zero means checkpointing is disabled.
+   */
+  const int64_t checkpoint_interval_;
+  /*! \brief The max number of checkpoints in the checkpoint storage. */
+  const int64_t num_checkpoints_;
 
   /*! \brief We fix int32 to be the index dtype of auxiliary data. */
   const DLDataType dtype_aux_ = DLDataType(DataType::Int(32, 1));
@@ -97,6 +115,17 @@ class RNNStateImpObj : public RNNStateObj {
   ffi::Array<ffi::Array<Tensor>> storages_;
   /*! \brief The list of ids of released seq slot for reuse. */
   std::vector<int64_t> free_slot_ids_;
+  /*! \brief The number of sequences referencing each seq slot. */
+  std::vector<int64_t> slot_ref_counts_;
+  /*!
+   * \brief The storages of state checkpoints, organized in the same way as `storages_`.
+   * Each Tensor has layout `(num_checkpoints, state_size)`.
+   */
+  ffi::Array<ffi::Array<Tensor>> checkpoint_storages_;
+  /*! \brief The list of ids of released checkpoint slots for reuse. */
+  std::vector<int64_t> free_checkpoint_ids_;
+  /*! \brief The number of sequences referencing each checkpoint slot. */
+  std::vector<int64_t> checkpoint_ref_counts_;
   /*! \brief The mapping from sequence ids to sequences. */
   std::unordered_map<int64_t, Sequence> seq_map_;
 
@@ -161,12 +190,16 @@ class RNNStateImpObj : public RNNStateObj {
                           DLDevice device,                   //
                           ffi::Array<ffi::Function> f_gets,  //
                           ffi::Array<ffi::Function> f_sets,  //
-                          ffi::Array<Tensor> init_layer_value)
+                          ffi::Array<Tensor> init_layer_value,  //
+                          int64_t checkpoint_interval = 0,      //
+                          int64_t num_checkpoints = 0)
       : num_layers_(num_layers),
         reserved_num_seqs_(reserved_num_seqs),
         num_states_per_layer_(init_layer_value.size()),
         max_history_(max_history),
         init_layer_value_(init_layer_value),
+        checkpoint_interval_(checkpoint_interval),
+        num_checkpoints_(num_checkpoints),
         f_gets_(std::move(f_gets)),
         f_sets_(std::move(f_sets)) {
     // Allocate the storage for the space state models.
@@ -184,6 +217,24 @@ class RNNStateImpObj : public RNNStateObj {
       }
       storages_.push_back(layer_storages);
     }
+    // Allocate the storage for the state checkpoints.
+    if (checkpoint_interval_ > 0) {
+      TVM_FFI_ICHECK_GT(num_checkpoints_, 0)
+          << "At least 1 checkpoint slot is needed when checkpointing is enabled";
+      checkpoint_storages_.reserve(num_layers_);
+      for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+        ffi::Array<Tensor> layer_storages;
+        layer_storages.reserve(num_states_per_layer_);
+        for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
+          ffi::Shape state_shape = init_layer_value[state_id].Shape();
+          std::vector<ffi::ShapeObj::index_type> storage_shape = {num_checkpoints_};
+          storage_shape.insert(storage_shape.end(), state_shape.begin(), state_shape.end());
+          layer_storages.push_back(
+              Tensor::Empty(storage_shape, init_layer_value[state_id].DataType(), device));
+        }
+        checkpoint_storages_.push_back(layer_storages);
+      }
+    }
 
     TVM_FFI_ICHECK_GT(max_history_, 0) << "At least 1 history slot to store the current state";
 
@@ -202,6 +253,14 @@ class RNNStateImpObj : public RNNStateObj {
     for (int64_t slot_id = reserved_num_seqs_ - 1; slot_id >= 0; --slot_id) {
       free_slot_ids_.push_back(slot_id);
     }
+    slot_ref_counts_.assign(reserved_num_seqs_, 0);
+    free_checkpoint_ids_.clear();
+    if (checkpoint_interval_ > 0) {
+      for (int64_t checkpoint_id = num_checkpoints_ - 1; checkpoint_id >= 0; --checkpoint_id) {
+        free_checkpoint_ids_.push_back(checkpoint_id);
+      }
+    }
+    checkpoint_ref_counts_.assign(num_checkpoints_, 0);
     dirty_aux_data_device_ = false;
   }
 
@@ -229,6 +288,17 @@ class RNNStateImpObj : public RNNStateObj {
     cur_append_lengths_ = append_lengths;
     cur_seq_ids_ = seq_ids;
 
+    // The states of the sequences in this round are going to be written.
+    // Copy the seq slots shared with other sequences before that.
+    for (int64_t seq_id : seq_ids) {
+      auto it = seq_map_.find(seq_id);
+      TVM_FFI_ICHECK(it != seq_map_.end())
+          << "The sequence \"" << seq_id << "\" cannot be found in the space state storage.";
+      if (slot_ref_counts_[it->second.seq_slot_id] > 1) {
+        CopySeqSlotOnWrite(&it->second);
+      }
+    }
+
     if (dirty_aux_data_device_) {
       SyncAuxArrayToDevice();
     }
@@ -250,6 +320,9 @@ class RNNStateImpObj : public RNNStateObj {
             std::min(it->second.available_history_num + 1, max_history_ - 1);
       }
       it->second.history_slot_id = (it->second.history_slot_id + 1) % max_history_;
+      if (checkpoint_interval_ > 0) {
+        MaybeCheckpoint(&it->second);
+      }
     }
     // TODO(Siyuan): We need to update history_slot_id_device_ (on device) as well.
     // There are two ways to do this:
@@ -310,17 +383,7 @@ class RNNStateImpObj : public RNNStateObj {
         << "The sequence \"" << seq_id << "\" is already in the space state storage.";
     int64_t seq_slot_id = GetFreeSlot();
     seq_map_.insert({seq_id, Sequence(seq_slot_id)});
-
-    // Initialize the state data with the init value.
-    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
-      for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
-        DLTensor dst =
-            GetStatePtrBySeqHistory(layer_id, state_id, seq_slot_id, /*history_slot_id=*/0);
-        Tensor init = init_layer_value_[state_id];
-        Tensor::CopyFromTo(init.operator->(), &dst);
-      }
-    }
-
+    InitSeqSlot(seq_slot_id);
     dirty_aux_data_device_ = true;
   }
 
@@ -329,7 +392,10 @@ class RNNStateImpObj : public RNNStateObj {
     TVM_FFI_ICHECK(it != seq_map_.end())
         << "The sequence \"" << seq_id << "\" cannot be found in the space state storage.";
 
-    free_slot_ids_.push_back(it->second.seq_slot_id);
+    ReleaseSlot(it->second.seq_slot_id);
+    for (const auto& [pos, checkpoint_id] : it->second.checkpoints) {
+      ReleaseCheckpoint(checkpoint_id);
+    }
     seq_map_.erase(it);
 
     dirty_aux_data_device_ = true;
@@ -341,20 +407,59 @@ class RNNStateImpObj : public RNNStateObj {
                                                 << "\" cannot be found in space state storage.";
     TVM_FFI_ICHECK(seq_map_.find(child_seq_id) == seq_map_.end())
         << "The child sequence \"" << child_seq_id << "\" is already in the space state storage.";
+    const Sequence& parent = parent_it->second;
+    if (fork_pos == -1) {
+      fork_pos = parent.seq_length;
+    }
+    TVM_FFI_ICHECK(fork_pos >= 0 && fork_pos <= parent.seq_length)
+        << "The forking position " << fork_pos << " is invalid, the legal forking position is "
+        << "within [0, " << parent.seq_length << "] and -1 for the last position.";
+    if (fork_pos == 0) {
+      AddSequence(child_seq_id);
+      return;
+    }
 
-    // Create a child block with the parent block pointer.
-    int64_t child_slot_id = GetFreeSlot();
-    seq_map_.insert({child_seq_id, Sequence::Fork(parent_it->second, child_slot_id)});
-
-    // Copy the parent state data to the child state data.
-    int64_t parent_slot_id = parent_it->second.seq_slot_id;
-    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
-      for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
-        DLTensor copy_src = GetStatePtrBySeq(layer_id, state_id, parent_slot_id);
-        DLTensor copy_dst = GetStatePtrBySeq(layer_id, state_id, child_slot_id);
-        Tensor::CopyFromTo(&copy_src, &copy_dst);
+    Sequence child = Sequence::Fork(parent, parent.seq_slot_id);
+    // The child inherits the parent checkpoints up to the forking position.
+    child.checkpoints.clear();
+    for (const auto& [pos, checkpoint_id] : parent.checkpoints) {
+      if (pos > fork_pos) break;
+      child.checkpoints.push_back({pos, checkpoint_id});
+    }
+    int64_t num_rollback = parent.seq_length - fork_pos;
+    bool fork_from_history = num_rollback <= parent.available_history_num;
+    TVM_FFI_ICHECK(fork_from_history ||
+                   (!child.checkpoints.empty() && child.checkpoints.back().first == fork_pos))
+        << "The state of sequence \"" << parent_seq_id << "\" at position " << fork_pos
+        << " is neither in the history nor checkpointed, and cannot be forked.";
+    if (fork_from_history) {
+      // The state at the forking position is in the history of the parent seq slot.
+      // The child shares the seq slot with the parent, which is copied on write.
+      child.seq_length = fork_pos;
+      child.available_history_num -= num_rollback;
+      child.history_slot_id =
+          (child.history_slot_id - num_rollback + max_history_) % max_history_;
+      ++slot_ref_counts_[child.seq_slot_id];
+    } else {
+      // Restore the state at the forking position from a checkpoint.
+      child.seq_slot_id = GetFreeSlot();
+      child.seq_length = fork_pos;
+      child.available_history_num = 0;
+      child.history_slot_id = 0;
+      int64_t checkpoint_id = child.checkpoints.back().second;
+      for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+        for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
+          DLTensor copy_src = GetCheckpointPtr(layer_id, state_id, checkpoint_id);
+          DLTensor copy_dst = GetStatePtrBySeqHistory(layer_id, state_id, child.seq_slot_id,
+                                                      /*history_slot_id=*/0);
+          Tensor::CopyFromTo(&copy_src, &copy_dst);
+        }
       }
     }
+    for (const auto& [pos, checkpoint_id] : child.checkpoints) {
+      ++checkpoint_ref_counts_[checkpoint_id];
+    }
+    seq_map_.insert({child_seq_id, std::move(child)});
     dirty_aux_data_device_ = true;
   }
 
@@ -371,9 +476,23 @@ class RNNStateImpObj : public RNNStateObj {
     it->second.seq_length -= n;
     it->second.available_history_num -= n;
     it->second.history_slot_id = (it->second.history_slot_id - n + max_history_) % max_history_;
+    // Drop the checkpoints beyond the new sequence length.
+    std::vector<std::pair<int64_t, int64_t>>& checkpoints = it->second.checkpoints;
+    while (!checkpoints.empty() && checkpoints.back().first > it->second.seq_length) {
+      ReleaseCheckpoint(checkpoints.back().second);
+      checkpoints.pop_back();
+    }
     dirty_aux_data_device_ = true;
   }
 
+  void SwapOut(int64_t seq_id) final {
+    TVM_FFI_THROW(InternalError) << "RNN state does not support swapping sequences out.";
+  }
+
+  void SwapIn(int64_t seq_id) final {
+    TVM_FFI_THROW(InternalError) << "RNN state does not support swapping sequences in.";
+  }
+
  private:
   /*! \brief Get a new free block and return its index. */
   int32_t GetFreeSlot() {
@@ -381,9 +500,80 @@ class RNNStateImpObj : public RNNStateObj {
         << "The Sequence slot is full, cannot accept new sequence.";
     int32_t seq_slot_id = free_slot_ids_.back();
     free_slot_ids_.pop_back();
+    slot_ref_counts_[seq_slot_id] = 1;
     return seq_slot_id;
   }
 
+  /*! \brief Drop one reference to the given seq slot, and free it when unreferenced. */
+  void ReleaseSlot(int64_t seq_slot_id) {
+    TVM_FFI_ICHECK_GT(slot_ref_counts_[seq_slot_id], 0);
+    if (--slot_ref_counts_[seq_slot_id] == 0) {
+      free_slot_ids_.push_back(seq_slot_id);
+    }
+  }
+
+  /*! \brief Drop one reference to the given checkpoint, and free it when unreferenced. */
+  void ReleaseCheckpoint(int64_t checkpoint_id) {
+    TVM_FFI_ICHECK_GT(checkpoint_ref_counts_[checkpoint_id], 0);
+    if (--checkpoint_ref_counts_[checkpoint_id] == 0) {
+      free_checkpoint_ids_.push_back(checkpoint_id);
+    }
+  }
+
+  /*! \brief Initialize the state data of the given seq slot with the init value. */
+  void InitSeqSlot(int64_t seq_slot_id) {
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
+        DLTensor dst =
+            GetStatePtrBySeqHistory(layer_id, state_id, seq_slot_id, /*history_slot_id=*/0);
+        Tensor init = init_layer_value_[state_id];
+        Tensor::CopyFromTo(init.operator->(), &dst);
+      }
+    }
+  }
+
+  /*!
+   * \brief Move the given sequence, whose seq slot is shared with other sequences,
+   * to a private copy of the seq slot.
+   */
+  void CopySeqSlotOnWrite(Sequence* seq) {
+    int64_t new_slot_id = GetFreeSlot();
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
+        DLTensor copy_src = GetStatePtrBySeq(layer_id, state_id, seq->seq_slot_id);
+        DLTensor copy_dst = GetStatePtrBySeq(layer_id, state_id, new_slot_id);
+        Tensor::CopyFromTo(&copy_src, &copy_dst);
+      }
+    }
+    ReleaseSlot(seq->seq_slot_id);
+    seq->seq_slot_id = new_slot_id;
+    dirty_aux_data_device_ = true;
+  }
+
+  /*!
+   * \brief Checkpoint the current state of the given sequence if it has advanced by
+   * at least the checkpoint interval since its last checkpoint.
+   * No checkpoint is taken when the checkpoint storage is full.
+   */
+  void MaybeCheckpoint(Sequence* seq) {
+    int64_t last_pos = seq->checkpoints.empty() ? 0 : seq->checkpoints.back().first;
+    if (seq->seq_length - last_pos < checkpoint_interval_ || free_checkpoint_ids_.empty()) {
+      return;
+    }
+    int64_t checkpoint_id = free_checkpoint_ids_.back();
+    free_checkpoint_ids_.pop_back();
+    checkpoint_ref_counts_[checkpoint_id] = 1;
+    for (int64_t layer_id = 0; layer_id < num_layers_; ++layer_id) {
+      for (int64_t state_id = 0; state_id < num_states_per_layer_; ++state_id) {
+        DLTensor copy_src =
+            GetStatePtrBySeqHistory(layer_id, state_id, seq->seq_slot_id, seq->history_slot_id);
+        DLTensor copy_dst = GetCheckpointPtr(layer_id, state_id, checkpoint_id);
+        Tensor::CopyFromTo(&copy_src, &copy_dst);
+      }
+    }
+    seq->checkpoints.push_back({seq->seq_length, checkpoint_id});
+  }
+
   DLTensor GetStatePtrBySeqHistory(int64_t layer_id, int64_t state_id, int64_t seq_slot_id,
                                    int64_t history_slot_id) {
     Tensor state = storages_[layer_id][state_id];
@@ -417,6 +607,22 @@ class RNNStateImpObj : public RNNStateObj {
     return _state;
   }
 
+  DLTensor GetCheckpointPtr(int64_t layer_id, int64_t state_id, int64_t checkpoint_id) {
+    Tensor checkpoint = checkpoint_storages_[layer_id][state_id];
+    int64_t state_size = 1;
+    for (int64_t i = 1; i < checkpoint->ndim; ++i) {
+      state_size *= checkpoint->shape[i];
+    }
+    int64_t elem_offset = checkpoint_id * state_size;
+    // Create a new DLTensor with the same shape and dtype as the state.
+    DLTensor _state = *(checkpoint.operator->());
+    _state.byte_offset = elem_offset * checkpoint->dtype.bits / 8;
+    _state.ndim = checkpoint->ndim - 1;
+    _state.shape = const_cast<int64_t*>(_state.shape + 1);
+    _state.strides = const_cast<int64_t*>(_state.strides + 1);
+    return _state;
+  }
+
   /*!
    * \brief Synchronize auxiliary arrays to device.
    * \note This method resets the dirty flag to false, and needs to be
@@ -468,12 +674,24 @@ class RNNStateImpObj : public RNNStateObj {
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("vm.builtin.rnn_state_create", [](int64_t num_layers,                //
-                                                          int64_t reserved_num_seqs,         //
-                                                          int64_t max_history,               //
-                                                          ffi::Array<ffi::Function> f_gets,  //
-                                                          ffi::Array<ffi::Function> f_sets,  //
-                                                          ffi::Array<Tensor> init_layer_value) {
+  refl::GlobalDef().def_packed("vm.builtin.rnn_state_create", [](ffi::PackedArgs args,
+                                                                 ffi::Any* rv) {
+    // Arguments: num_layers, reserved_num_seqs, max_history, f_gets, f_sets, init_layer_value,
+    // and optionally checkpoint_interval and num_checkpoints.
+    TVM_FFI_ICHECK(args.size() == 6 || args.size() == 8)
+        << "Invalid number of RNN state create arguments " << args.size();
+    int64_t num_layers = args[0].cast<int64_t>();
+    int64_t reserved_num_seqs = args[1].cast<int64_t>();
+    int64_t max_history = args[2].cast<int64_t>();
+    ffi::Array<ffi::Function> f_gets = args[3].cast<ffi::Array<ffi::Function>>();
+    ffi::Array<ffi::Function> f_sets = args[4].cast<ffi::Array<ffi::Function>>();
+    ffi::Array<Tensor> init_layer_value = args[5].cast<ffi::Array<Tensor>>();
+    int64_t checkpoint_interval = 0;
+    int64_t num_checkpoints = 0;
+    if (args.size() == 8) {
+      checkpoint_interval = args[6].cast<int64_t>();
+      num_checkpoints = args[7].cast<int64_t>();
+    }
     TVM_FFI_ICHECK_GT(num_layers, 0) << "The number of layers should be greater than 0.";
     TVM_FFI_ICHECK_GT(reserved_num_seqs, 0)
         << "The number of reserved sequences should be greater than 0.";
@@ -481,6 +699,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
         << "The maximum history length should be greater or equal than 0.";
     TVM_FFI_ICHECK_GT(init_layer_value.size(), 0)
         << "The number of states per layer should be greater than 0.";
+    TVM_FFI_ICHECK_GE(checkpoint_interval, 0)
+        << "The checkpoint interval should be greater or equal than 0.";
+    TVM_FFI_ICHECK_GE(num_checkpoints, 0)
+        << "The number of checkpoints should be greater or equal than 0.";
     Device device = init_layer_value[0]->device;
     for (const Tensor& state : init_layer_value) {
       TVM_FFI_ICHECK(state->device.device_type == device.device_type &&
@@ -493,10 +715,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
     TVM_FFI_ICHECK_EQ(f_sets.size(), init_layer_value.size())
         << "The number of state setters should be the same as the number of states per layer, "
         << "but got " << f_sets.size() << " and " << init_layer_value.size() << " respectively.";
-    ObjectPtr<RNNStateImpObj> n =
-        ffi::make_object<RNNStateImpObj>(num_layers, reserved_num_seqs, max_history, device,
-                                         std::move(f_gets), std::move(f_sets), init_layer_value);
-    return RNNState(std::move(n));
+    ObjectPtr<RNNStateImpObj> n = ffi::make_object<RNNStateImpObj>(
+        num_layers, reserved_num_seqs, max_history, device, std::move(f_gets), std::move(f_sets),
+        init_layer_value, checkpoint_interval, num_checkpoints);
+    *rv = RNNState(std::move(n));
   });
 }
 
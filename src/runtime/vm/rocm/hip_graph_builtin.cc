@@ -0,0 +1,334 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/rocm/hip_graph_builtin.cc
+ * \brief The HIP graph related builtin functions for Relax virtual machine.
+ *
+ * This is the ROCm counterpart of cuda_graph_builtin.cc, launching the regions lifted by
+ * RewriteHIPGraph with HIP graphs.
+ */
+
+#include <tvm/ffi/container/array.h>
+#include <tvm/ffi/extra/c_env_api.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <algorithm>
+#include <list>
+
+#include "../../../support/utils.h"
+#include "../../rocm/rocm_common.h"
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+namespace {
+
+struct HIPGraphCaptureKey {
+  // The unique index of the capture function within the module
+  int64_t index;
+  // The symbolic variables the capture function depends on. When the capture function is ran with
+  // different symbolic variable values, the HIP graph will be re-captured as a different version,
+  // identified by this shape tuple. This is default constructed as an empty tuple.
+  ffi::Shape shape_expr;
+
+  HIPGraphCaptureKey(int64_t index, const ffi::Optional<ffi::Shape>& shape_expr) : index(index) {
+    if (shape_expr) {
+      this->shape_expr = shape_expr.value();
+    }
+  }
+};
+
+struct HIPGraphCaptureKeyHash {
+  size_t operator()(const HIPGraphCaptureKey& key) const {
+    std::hash<int64_t> hash_fn;
+    size_t hash = hash_fn(key.index);
+    for (const auto& shape : key.shape_expr) {
+      support::HashCombine(hash, hash_fn(shape));
+    }
+    return hash;
+  }
+};
+
+struct HIPGraphCaptureKeyEqual {
+  bool operator()(const HIPGraphCaptureKey& lhs, const HIPGraphCaptureKey& rhs) const {
+    return lhs.index == rhs.index && std::equal(lhs.shape_expr.begin(), lhs.shape_expr.end(),
+                                                rhs.shape_expr.begin(), rhs.shape_expr.end());
+  }
+};
+
+/*! \brief The captured state of a HIP graph */
+struct HIPGraphCapturedState {
+  HIPGraphCapturedState() {}
+
+  HIPGraphCapturedState(const HIPGraphCapturedState&) = delete;
+  HIPGraphCapturedState(HIPGraphCapturedState&& other) { *this = std::move(other); }
+
+  HIPGraphCapturedState& operator=(const HIPGraphCapturedState&) = delete;
+  HIPGraphCapturedState& operator=(HIPGraphCapturedState&& other) {
+    std::swap(states, other.states);
+    std::swap(exec, other.exec);
+    std::swap(lru_pos, other.lru_pos);
+    return *this;
+  }
+
+  ~HIPGraphCapturedState() {
+    if (exec) {
+      ROCM_CALL(hipGraphExecDestroy(exec));
+    }
+  }
+
+  /*!
+   * \brief Tuple of intemediate tensors in the capture func that will be used outside the
+   * capture func
+   */
+  ObjectRef states;
+  /*! \brief The instantiated hip graph */
+  hipGraphExec_t exec = nullptr;
+  /*! \brief The position of the graph in the launch order of the graphs of its capture function */
+  std::list<ffi::Shape>::iterator lru_pos;
+};
+
+class ScopedHIPStream {
+ public:
+  ScopedHIPStream() { ROCM_CALL(hipStreamCreate(&stream_)); }
+  ~ScopedHIPStream() { hipStreamDestroy(stream_); }
+  ScopedHIPStream(const ScopedHIPStream&) = delete;
+  ScopedHIPStream(ScopedHIPStream&&) = delete;
+  ScopedHIPStream& operator=(const ScopedHIPStream&) = delete;
+  ScopedHIPStream& operator=(ScopedHIPStream&&) = delete;
+
+  operator hipStream_t() const { return stream_; }
+
+ private:
+  hipStream_t stream_;
+};
+
+class HIPCaptureStream {
+ public:
+  explicit HIPCaptureStream(hipGraph_t* graph) : output_graph_(graph) {
+    ROCM_CALL(hipGetDevice(&device_id_));
+    TVM_FFI_CHECK_SAFE_CALL(
+        TVMFFIEnvSetStream(kDLROCM, device_id_, capture_stream_,
+                           reinterpret_cast<TVMFFIStreamHandle*>(&prev_default_stream_)));
+    ROCM_CALL(hipStreamBeginCapture(capture_stream_, hipStreamCaptureModeGlobal));
+  }
+  ~HIPCaptureStream() noexcept(false) {
+    hipStreamEndCapture(capture_stream_, output_graph_);
+    TVM_FFI_CHECK_SAFE_CALL(TVMFFIEnvSetStream(kDLROCM, device_id_, prev_default_stream_, nullptr));
+  }
+
+ private:
+  int device_id_;
+  hipStream_t prev_default_stream_;
+  ScopedHIPStream capture_stream_;
+
+  hipGraph_t* output_graph_;
+};
+
+}  // namespace
+
+/*! \brief The VM extension of HIP graph. */
+class HIPGraphExtensionNode : public VMExtensionNode {
+ public:
+  /*!
+   * \brief Launch the hip graph if it has been cached, otherwise execute it in capture mode.
+   * \param vm The virtual machine.
+   * \param capture_func The function of type (args...) -> Tuple[ObjectRef], where 'args' are the
+   * static arguments that are the same for all invocations of the capture function, the returned
+   * tuple contains the intermediate tensors that will be used outside the capture function.
+   * \param args The static arguments of the capture function
+   * \param entry_index The unique index of the capture function used for lookup.
+   * \param shape_expr The values of the symbolic variables the capture function depends on.
+   * \param buckets The values of each symbolic variable to capture, empty to capture any value.
+   * The capture function is run without HIP graph for the values outside of the buckets.
+   * \param max_num_graphs The maximum number of graphs kept for the capture function, evicting
+   * the least recently launched one, or 0 for no limit.
+   * \return The return value of the capture function.
+   */
+  ObjectRef RunOrCapture(VirtualMachine* vm, const ObjectRef& capture_func, Any args,
+                         int64_t entry_index, ffi::Optional<ffi::Shape> shape_expr,
+                         ffi::Array<ffi::Shape> buckets = {}, int64_t max_num_graphs = 0) {
+    HIPGraphCaptureKey entry_key{entry_index, shape_expr};
+    if (auto it = capture_cache_.find(entry_key); it != capture_cache_.end()) {
+      // Launch HIP graph
+      auto& entry = it->second;
+      std::list<ffi::Shape>& lru = lru_[entry_index];
+      lru.splice(lru.begin(), lru, entry.lru_pos);
+      int device_id;
+      ROCM_CALL(hipGetDevice(&device_id));
+      ROCM_CALL(hipGraphLaunch(
+          entry.exec, static_cast<hipStream_t>(TVMFFIEnvGetStream(kDLROCM, device_id))));
+      return entry.states;
+    }
+
+    // Set up arguments for the graph execution
+    ffi::Array<Any> tuple_args = args.cast<ffi::Array<Any>>();
+    int nargs = static_cast<int>(tuple_args.size());
+
+    std::vector<AnyView> packed_args(nargs);
+    for (int i = 0; i < nargs; ++i) {
+      packed_args[i] = tuple_args[i];
+    }
+
+    ffi::Any capture_func_rv;
+    // Run the function without HIP graph. This is a warm up step to do necessary initialization
+    // of the ROCm module such as loading module data, setting kernel attributes.
+    vm->InvokeClosurePacked(capture_func, ffi::PackedArgs(packed_args.data(), nargs),
+                            &capture_func_rv);
+    if (!InBuckets(entry_key.shape_expr, buckets)) {
+      return capture_func_rv.cast<ObjectRef>();
+    }
+
+    // Run the graph in capture mode
+    hipGraph_t graph;
+
+    {
+      HIPCaptureStream capture_stream(&graph);
+      vm->InvokeClosurePacked(capture_func, ffi::PackedArgs(packed_args.data(), nargs),
+                              &capture_func_rv);
+    }
+
+    HIPGraphCapturedState entry;
+    entry.states = capture_func_rv.cast<ObjectRef>();
+    ROCM_CALL(hipGraphInstantiate(&entry.exec, graph, NULL, NULL, 0));
+    ROCM_CALL(hipGraphDestroy(graph));
+
+    ObjectRef states = entry.states;
+
+    std::list<ffi::Shape>& lru = lru_[entry_index];
+    if (max_num_graphs > 0 && static_cast<int64_t>(lru.size()) >= max_num_graphs) {
+      capture_cache_.erase(HIPGraphCaptureKey{entry_index, lru.back()});
+      lru.pop_back();
+    }
+    entry.lru_pos = lru.insert(lru.begin(), entry_key.shape_expr);
+    capture_cache_[entry_key] = std::move(entry);
+
+    return states;
+  }
+
+  /*!
+   * \brief Get the cached allocation from the cache or run the allocation function.
+   * \param vm The virtual machine.
+   * \param alloc_func The function of type () -> ObjectRef, where the returned object is the
+   * tuple of allocated storage objects.
+   * \param entry_index The unique index of the allocation function used for lookup.
+   */
+  ObjectRef GetCachedAllocation(VirtualMachine* vm, const ObjectRef& alloc_func,
+                                int64_t entry_index) {
+    if (auto it = alloc_cache_.find(entry_index); it != alloc_cache_.end()) {
+      return it->second;
+    }
+    ffi::Any alloc_func_rv;
+    vm->InvokeClosurePacked(alloc_func, ffi::PackedArgs(nullptr, 0), &alloc_func_rv);
+    ObjectRef alloc_result = alloc_func_rv.cast<ObjectRef>();
+    alloc_cache_[entry_index] = alloc_result;
+    return alloc_result;
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("vm.HIPGraphExtension", HIPGraphExtensionNode,
+                                    VMExtensionNode);
+
+ private:
+  /*! \brief Whether each value of the shape expr is in the buckets of its symbolic variable. */
+  static bool InBuckets(const ffi::Shape& shape_expr, const ffi::Array<ffi::Shape>& buckets) {
+    if (buckets.empty()) {
+      return true;
+    }
+    TVM_FFI_ICHECK_EQ(buckets.size(), shape_expr.size());
+    for (size_t i = 0; i < shape_expr.size(); ++i) {
+      const ffi::Shape& values = buckets[i];
+      if (!values.empty() &&
+          std::find(values.begin(), values.end(), shape_expr[i]) == values.end()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*!
+   * \brief The cache of captured hip graphs. The key is a unique index for the capture function.
+   * The value is the result of the capture.
+   */
+  std::unordered_map<HIPGraphCaptureKey, HIPGraphCapturedState, HIPGraphCaptureKeyHash,
+                     HIPGraphCaptureKeyEqual>
+      capture_cache_;
+  /*!
+   * \brief The cache of allocations. The key is a unique index for the allocation function.
+   * The value is the cached allocations, which is a tuple of storages.
+   */
+  std::unordered_map<int64_t, ObjectRef> alloc_cache_;
+  /*!
+   * \brief The shape exprs of the cached graphs of each capture function, from the most recently
+   * launched one.
+   */
+  std::unordered_map<int64_t, std::list<ffi::Shape>> lru_;
+};
+
+/*! Managed reference to HIPGraphExtensionNode */
+class HIPGraphExtension : public VMExtension {
+ public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(HIPGraphExtension, VMExtension,
+                                             HIPGraphExtensionNode);
+  static HIPGraphExtension Create() {
+    auto data_ = ffi::make_object<HIPGraphExtensionNode>();
+    return HIPGraphExtension(std::move(data_));
+  }
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def_packed("vm.builtin.hip_graph.run_or_capture",
+                  [](ffi::PackedArgs args, ffi::Any* rv) {
+                    TVM_FFI_ICHECK(args.size() >= 4 && args.size() <= 7 && args.size() != 6);
+                    VirtualMachine* vm = VirtualMachine::GetContextPtr(args[0]);
+                    auto extension = vm->GetOrCreateExtension<HIPGraphExtension>();
+                    auto capture_func = args[1].cast<ObjectRef>();
+                    Any func_args = args[2];
+                    int64_t entry_index = args[3].cast<int64_t>();
+                    ffi::Optional<ffi::Shape> shape_expr = std::nullopt;
+                    if (args.size() >= 5) {
+                      shape_expr = args[4].cast<ffi::Shape>();
+                    }
+                    ffi::Array<ffi::Shape> buckets;
+                    int64_t max_num_graphs = 0;
+                    if (args.size() == 7) {
+                      buckets = args[5].cast<ffi::Array<ffi::Shape>>();
+                      max_num_graphs = args[6].cast<int64_t>();
+                    }
+                    *rv = extension->RunOrCapture(vm, capture_func, func_args, entry_index,
+                                                  shape_expr, buckets, max_num_graphs);
+                  })
+      .def_packed("vm.builtin.hip_graph.get_cached_alloc", [](ffi::PackedArgs args, ffi::Any* rv) {
+        TVM_FFI_ICHECK_EQ(args.size(), 3);
+        VirtualMachine* vm = VirtualMachine::GetContextPtr(args[0]);
+        auto extension = vm->GetOrCreateExtension<HIPGraphExtension>();
+        auto alloc_func = args[1].cast<ObjectRef>();
+        int64_t entry_index = args[2].cast<int64_t>();
+        *rv = extension->GetCachedAllocation(vm, alloc_func, entry_index);
+      });
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/stream_builtin.cc
+ * \brief The builtin functions for Relax virtual machine to run kernels on several streams.
+ */
+
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief The side streams of the devices of a VM.
+ *
+ * The stream 0 of a device is the stream that is current when the VM switches away from it, i.e.
+ * the stream the VM runs on, and the streams 1, 2, ... are side streams created on first use and
+ * freed with the VM.
+ */
+class StreamPoolExtensionNode : public VMExtensionNode {
+ public:
+  ~StreamPoolExtensionNode() {
+    for (auto& state : states_) {
+      for (TVMStreamHandle stream : state.side_streams) {
+        if (stream != nullptr) {
+          DeviceAPI::Get(state.device)->FreeStream(state.device, stream);
+        }
+      }
+    }
+  }
+
+  /*! \brief Make a stream of a device the current stream. */
+  void SetStream(VirtualMachine* vm, int64_t device_index, int64_t stream_index) {
+    DeviceState& state = GetState(vm, device_index);
+    if (stream_index == state.current_index) return;
+    if (state.current_index == 0) {
+      state.main_stream = DeviceAPI::Get(state.device)->GetCurrentStream(state.device);
+    }
+    TVMStreamHandle stream = GetStream(&state, stream_index);
+    DeviceAPI::Get(state.device)->SetStream(state.device, stream);
+    state.current_index = stream_index;
+  }
+
+  /*! \brief Make a stream wait for the work submitted to another stream so far. */
+  void Wait(VirtualMachine* vm, int64_t device_index, int64_t src_index, int64_t dst_index) {
+    DeviceState& state = GetState(vm, device_index);
+    if (src_index == dst_index) return;
+    TVMStreamHandle src = GetStream(&state, src_index);
+    TVMStreamHandle dst = GetStream(&state, dst_index);
+    DeviceAPI::Get(state.device)->SyncStreamFromTo(state.device, src, dst);
+  }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("vm.StreamPoolExtension", StreamPoolExtensionNode,
+                                    VMExtensionNode);
+
+ private:
+  /*! \brief The streams of a device. */
+  struct DeviceState {
+    /*! \brief The device. */
+    Device device;
+    /*! \brief The index of the current stream. */
+    int64_t current_index = 0;
+    /*! \brief The stream 0, valid while another stream is current. */
+    TVMStreamHandle main_stream = nullptr;
+    /*! \brief The side streams, from the stream 1. */
+    std::vector<TVMStreamHandle> side_streams;
+  };
+
+  DeviceState& GetState(VirtualMachine* vm, int64_t device_index) {
+    TVM_FFI_ICHECK(device_index >= 0 && device_index < static_cast<int64_t>(vm->devices.size()))
+        << "ValueError: The device index " << device_index << " is out of the "
+        << vm->devices.size() << " devices of the VM";
+    if (states_.size() < vm->devices.size()) {
+      states_.resize(vm->devices.size());
+    }
+    DeviceState& state = states_[device_index];
+    state.device = vm->devices[device_index];
+    return state;
+  }
+
+  TVMStreamHandle GetStream(DeviceState* state, int64_t stream_index) {
+    TVM_FFI_ICHECK_GE(stream_index, 0) << "ValueError: The stream index cannot be negative";
+    if (stream_index == 0) {
+      return state->current_index == 0
+                 ? DeviceAPI::Get(state->device)->GetCurrentStream(state->device)
+                 : state->main_stream;
+    }
+    if (state->side_streams.size() < static_cast<size_t>(stream_index)) {
+      state->side_streams.resize(stream_index, nullptr);
+    }
+    TVMStreamHandle& stream = state->side_streams[stream_index - 1];
+    if (stream == nullptr) {
+      stream = DeviceAPI::Get(state->device)->CreateStream(state->device);
+    }
+    return stream;
+  }
+
+  /*! \brief The streams of each device of the VM. */
+  std::vector<DeviceState> states_;
+};
+
+/*! Managed reference to StreamPoolExtensionNode */
+class StreamPoolExtension : public VMExtension {
+ public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(StreamPoolExtension, VMExtension,
+                                             StreamPoolExtensionNode);
+  static StreamPoolExtension Create() {
+    return StreamPoolExtension(ffi::make_object<StreamPoolExtensionNode>());
+  }
+};
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("vm.builtin.stream.set",
+           [](void* ctx_ptr, Index device_index, int64_t stream_index) {
+             VirtualMachine* vm = static_cast<VirtualMachine*>(ctx_ptr);
+             auto extension = vm->GetOrCreateExtension<StreamPoolExtension>();
+             extension->SetStream(vm, device_index, stream_index);
+           })
+      .def("vm.builtin.stream.wait",
+           [](void* ctx_ptr, Index device_index, int64_t src_index, int64_t dst_index) {
+             VirtualMachine* vm = static_cast<VirtualMachine*>(ctx_ptr);
+             auto extension = vm->GetOrCreateExtension<StreamPoolExtension>();
+             extension->Wait(vm, device_index, src_index, dst_index);
+           });
+}
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
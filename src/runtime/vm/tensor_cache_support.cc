@@ -38,9 +38,25 @@
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/runtime/tensor.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/runtime/vm/tensor_cache_support.h>
 
+#ifdef TVM_ZSTD_ENABLED
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../../support/utils.h"
@@ -72,12 +88,35 @@ TensorCacheMetadata::FileRecord::ParamRecord JSONAsParamRecord(const json::Objec
   return result;
 }
 
+TensorCacheMetadata::FileRecord::Compression JSONAsCompression(const json::Object& json) {
+  TensorCacheMetadata::FileRecord::Compression result;
+  result.codec = json["codec"].cast<ffi::String>();
+  result.byte_shuffle = json.count("byteShuffle") ? json["byteShuffle"].cast<int64_t>() : 0;
+  result.chunk_nbytes = json["chunkNbytes"].cast<int64_t>();
+  json::Array chunks = json["chunks"].cast<json::Array>();
+  result.chunks.reserve(chunks.size());
+  for (const ffi::Any& nbytes : chunks) {
+    result.chunks.push_back(nbytes.cast<int64_t>());
+  }
+  TVM_FFI_CHECK_EQ(result.codec, "zstd", ValueError)
+      << "Only `zstd` compression of the shards is supported";
+  TVM_FFI_CHECK_GT(result.chunk_nbytes, 0, ValueError) << "The chunks should not be empty";
+  return result;
+}
+
 TensorCacheMetadata::FileRecord JSONAsFileRecord(const json::Object& json) {
   json::Array records = json["records"].cast<json::Array>();
   TensorCacheMetadata::FileRecord result;
   result.data_path = json["dataPath"].cast<ffi::String>();
   result.format = json["format"].cast<ffi::String>();
   result.nbytes = json["nbytes"].cast<int64_t>();
+  if (json.count("compression")) {
+    result.compression = JSONAsCompression(json["compression"].cast<json::Object>());
+    int64_t chunk_nbytes = result.compression->chunk_nbytes;
+    TVM_FFI_CHECK_EQ(static_cast<int64_t>(result.compression->chunks.size()),
+                     (result.nbytes + chunk_nbytes - 1) / chunk_nbytes, ValueError)
+        << "The chunks of " << result.data_path << " do not match its size";
+  }
   result.records.reserve(records.size());
   for (const ffi::Any& item : records) {
     result.records.push_back(JSONAsParamRecord(item.cast<json::Object>()));
@@ -151,22 +190,259 @@ void CopyTensorFromBytes(Tensor param, const void* data, size_t nbytes,
   DeviceAPI::Get(device)->StreamSync(device, nullptr);
 }
 
+/*!
+ * \brief A process-wide store of the parameters loaded on each device, deduplicated by content, so
+ *  that the VMs of the models sharing weights, e.g. the LoRA adapters of a base model, share one
+ *  copy of them on each device. It is disabled by default, as a VM updating a parameter in place
+ *  would then update the parameter of the other VMs too.
+ *
+ * The store holds a reference to each parameter, and releases the ones that no one else holds when
+ * the parameters of a tensor cache are loaded.
+ */
+class WeightStore {
+ public:
+  static WeightStore* Global() {
+    static WeightStore* inst = new WeightStore();
+    return inst;
+  }
+
+  /*!
+   * \brief Get the parameter of the raw data on the device, loading it if the store has none.
+   * \param param The record of the parameter.
+   * \param device The device of the parameter.
+   * \param raw_data The raw data of the parameter, i.e. its `nbytes` bytes in the file.
+   * \param f_load The function loading the parameter from the raw data.
+   */
+  Tensor GetOrLoad(const TensorCacheMetadata::FileRecord::ParamRecord& param, Device device,
+                   const char* raw_data, const std::function<Tensor()>& f_load) {
+    if (!enabled_) {
+      return f_load();
+    }
+    // The 64-bit hash of the content, under the same shape, dtype, format and size in bytes, is
+    // taken as the identity of the parameter.
+    std::ostringstream key;
+    key << static_cast<int>(device.device_type) << ":" << device.device_id << ":" << param.dtype;
+    for (int64_t dim : param.shape) {
+      key << ":" << dim;
+    }
+    key << ":" << param.format << ":" << param.nbytes << ":"
+        << std::hash<std::string_view>()(std::string_view(raw_data, param.nbytes));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = weights_.find(key.str());
+      if (it != weights_.end()) {
+        return it->second;
+      }
+    }
+    // Parameters are loaded outside of the lock, so that the VMs load different ones in parallel.
+    Tensor weight = f_load();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return weights_.emplace(key.str(), weight).first->second;
+  }
+
+  /*! \brief Release the parameters that only the store holds. */
+  void ReleaseUnused() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = weights_.begin(); it != weights_.end();) {
+      it = it->second.use_count() == 1 ? weights_.erase(it) : std::next(it);
+    }
+  }
+
+  /*! \brief The total size in bytes of the parameters in the store. */
+  int64_t NumBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t num_bytes = 0;
+    for (const auto& kv : weights_) {
+      num_bytes += static_cast<int64_t>(GetDataSize(*kv.second.operator->()));
+    }
+    return num_bytes;
+  }
+
+  void SetEnabled(bool enabled) {
+    enabled_ = enabled;
+    if (!enabled) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      weights_.clear();
+    }
+  }
+
+ private:
+  /*! \brief Whether the parameters loaded are deduplicated. */
+  std::atomic<bool> enabled_{false};
+  /*! \brief The mutex of the parameters, as the VMs may be loaded by different threads. */
+  std::mutex mutex_;
+  /*! \brief The parameters, by device and content. */
+  std::unordered_map<std::string, Tensor> weights_;
+};
+
 Tensor TensorCacheMetadata::FileRecord::ParamRecord::Load(
     Device device, const std::string* raw_data, ffi::Optional<Tensor>* staging_buffer) const {
-  Tensor arr = Tensor::Empty(shape, dtype, device);
-  if (dtype == DataType::Float(32) && format == "f32-to-bf16") {
-    // decode bf16 to f32
-    std::vector<uint16_t> buffer(nbytes / 2);
-    std::vector<uint32_t> decoded(nbytes / 2);
-    std::memcpy(buffer.data(), raw_data->data() + byte_offset, nbytes);
-    for (size_t i = 0; i < buffer.size(); ++i) {
-      decoded[i] = static_cast<uint32_t>(buffer[i]) << 16;
+  return Load(device, raw_data->data(), staging_buffer);
+}
+
+/*! \brief Whether the parameter is stored in an encoded format that must be decoded on host. */
+bool NeedsDecoding(const TensorCacheMetadata::FileRecord::ParamRecord& param) {
+  return param.dtype == DataType::Float(32) && param.format == "f32-to-bf16";
+}
+
+/*! \brief Decode the bf16 raw data of a parameter to f32. */
+std::vector<uint32_t> DecodeBF16ToF32(const char* data, int64_t nbytes) {
+  std::vector<uint16_t> buffer(nbytes / 2);
+  std::vector<uint32_t> decoded(nbytes / 2);
+  std::memcpy(buffer.data(), data, nbytes);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    decoded[i] = static_cast<uint32_t>(buffer[i]) << 16;
+  }
+  return decoded;
+}
+
+Tensor TensorCacheMetadata::FileRecord::ParamRecord::Load(
+    Device device, const char* raw_data, ffi::Optional<Tensor>* staging_buffer) const {
+  return WeightStore::Global()->GetOrLoad(*this, device, raw_data + byte_offset, [&]() {
+    Tensor arr = Tensor::Empty(shape, dtype, device);
+    if (NeedsDecoding(*this)) {
+      std::vector<uint32_t> decoded = DecodeBF16ToF32(raw_data + byte_offset, nbytes);
+      CopyTensorFromBytes(arr, decoded.data(), decoded.size() * sizeof(uint32_t), staging_buffer);
+    } else {
+      CopyTensorFromBytes(arr, raw_data + byte_offset, nbytes, staging_buffer);
+    }
+    return arr;
+  });
+}
+
+/*! \brief Check the data read from a shard file against its record. */
+void CheckRawShard(const TensorCacheMetadata::FileRecord& record, const std::string& file_data) {
+  TVM_FFI_CHECK_EQ(record.format, "raw-shard", ValueError)
+      << "Only `raw-shard` format is supported";
+  int64_t file_nbytes = record.nbytes;
+  if (record.compression.has_value()) {
+    const std::vector<int64_t>& chunks = record.compression->chunks;
+    file_nbytes = std::accumulate(chunks.begin(), chunks.end(), int64_t(0));
+  }
+  TVM_FFI_CHECK_EQ(file_nbytes, file_data.length(), ValueError)
+      << "Encountered an corrupted parameter shard. It means it is not downloaded "
+         "completely or downloading is interrupted. Please try to download again.";
+}
+
+/*! \brief Undo the byte shuffle of the elements of `elem_size` bytes of the data. */
+void ByteUnshuffle(const char* src, int64_t nbytes, int64_t elem_size, char* dst) {
+  // The shuffled data is the first bytes of all the elements, then their second bytes, and so
+  // on, followed by the trailing bytes that do not make an element.
+  int64_t num_elems = nbytes / elem_size;
+  for (int64_t b = 0; b < elem_size; ++b) {
+    const char* plane = src + b * num_elems;
+    for (int64_t i = 0; i < num_elems; ++i) {
+      dst[i * elem_size + b] = plane[i];
     }
-    CopyTensorFromBytes(arr, decoded.data(), decoded.size() * sizeof(uint32_t), staging_buffer);
-  } else {
-    CopyTensorFromBytes(arr, raw_data->data() + byte_offset, nbytes, staging_buffer);
   }
-  return arr;
+  std::memcpy(dst + num_elems * elem_size, src + num_elems * elem_size,
+              nbytes - num_elems * elem_size);
+}
+
+/*! \brief Decompress a chunk of a compressed shard file into its `nbytes` raw bytes. */
+void DecompressChunk(const TensorCacheMetadata::FileRecord::Compression& compression,
+                     const char* src, int64_t src_nbytes, char* dst, int64_t nbytes) {
+#ifdef TVM_ZSTD_ENABLED
+  std::string shuffled;
+  char* out = dst;
+  if (compression.byte_shuffle > 1) {
+    shuffled.resize(nbytes);
+    out = shuffled.data();
+  }
+  size_t result = ZSTD_decompress(out, nbytes, src, src_nbytes);
+  TVM_FFI_CHECK(!ZSTD_isError(result), ValueError)
+      << "Failed to decompress a chunk of the shard: " << ZSTD_getErrorName(result);
+  TVM_FFI_CHECK_EQ(static_cast<int64_t>(result), nbytes, ValueError)
+      << "Encountered an corrupted parameter shard, whose chunk is decompressed to " << result
+      << " bytes rather than " << nbytes << " bytes. Please try to download again.";
+  if (compression.byte_shuffle > 1) {
+    ByteUnshuffle(shuffled.data(), nbytes, compression.byte_shuffle, dst);
+  }
+#else
+  TVM_FFI_THROW(RuntimeError) << "Cannot decompress the `" << compression.codec
+                              << "` shards, as TVM is not built with USE_ZSTD";
+#endif
+}
+
+/*!
+ * \brief Decompress the consecutive chunks of a compressed shard file, in parallel.
+ * \param record The record of the file.
+ * \param file_data The compressed data of the chunks, from the beginning of the chunk `begin`.
+ * \param begin The index of the first chunk.
+ * \param end The index after the last chunk.
+ * \param raw_data The raw data of the chunks.
+ */
+void DecompressChunks(const TensorCacheMetadata::FileRecord& record, const char* file_data,
+                      int64_t begin, int64_t end, std::string* raw_data) {
+  const TensorCacheMetadata::FileRecord::Compression& compression = record.compression.value();
+  int64_t chunk_nbytes = compression.chunk_nbytes;
+  int64_t raw_begin = begin * chunk_nbytes;
+  int64_t raw_end = std::min(end * chunk_nbytes, record.nbytes);
+  raw_data->resize(std::max<int64_t>(raw_end - raw_begin, 0));
+  if (begin >= end) {
+    return;
+  }
+  std::vector<int64_t> src_offsets(end - begin + 1, 0);
+  for (int64_t i = begin; i < end; ++i) {
+    src_offsets[i - begin + 1] = src_offsets[i - begin] + compression.chunks[i];
+  }
+  auto f_decompress = [&](int64_t i) {
+    int64_t nbytes = std::min(chunk_nbytes, record.nbytes - i * chunk_nbytes);
+    DecompressChunk(compression, file_data + src_offsets[i - begin], compression.chunks[i],
+                    raw_data->data() + (i - begin) * chunk_nbytes, nbytes);
+  };
+  // The chunks are split across the threads, and this thread decompresses a share of them too.
+  int64_t num_threads = std::min<int64_t>(end - begin, std::max(threading::MaxConcurrency(), 1));
+  std::vector<std::future<void>> workers;
+  for (int64_t t = 1; t < num_threads; ++t) {
+    workers.push_back(std::async(std::launch::async, [&, t]() {
+      for (int64_t i = begin + t; i < end; i += num_threads) {
+        f_decompress(i);
+      }
+    }));
+  }
+  for (int64_t i = begin; i < end; i += num_threads) {
+    f_decompress(i);
+  }
+  for (std::future<void>& worker : workers) {
+    worker.get();
+  }
+}
+
+void TensorCacheMetadata::FileRecord::ReadRawData(const std::string& file_path,
+                                                  std::string* raw_data) const {
+  if (!compression.has_value()) {
+    LoadBinaryFromFile(file_path, raw_data);
+    CheckRawShard(*this, *raw_data);
+    return;
+  }
+  std::string file_data;
+  LoadBinaryFromFile(file_path, &file_data);
+  CheckRawShard(*this, file_data);
+  DecompressChunks(*this, file_data.data(), 0, compression->chunks.size(), raw_data);
+}
+
+/*! \brief A shard file read into host memory, with its encoded parameters decoded. */
+struct HostShard {
+  /*! \brief The raw data of the shard file. */
+  std::string raw_data;
+  /*! \brief The decoded data of each parameter, which is empty if no decoding is needed. */
+  std::vector<std::vector<uint32_t>> decoded;
+};
+
+/*! \brief Read a shard file and decode its parameters on host. */
+HostShard ReadHostShard(const TensorCacheMetadata::FileRecord& record,
+                        const std::string& path_prefix) {
+  HostShard shard;
+  record.ReadRawData(path_prefix + "/" + record.data_path, &shard.raw_data);
+  shard.decoded.resize(record.records.size());
+  for (size_t i = 0; i < record.records.size(); ++i) {
+    const TensorCacheMetadata::FileRecord::ParamRecord& param = record.records[i];
+    if (NeedsDecoding(param)) {
+      shard.decoded[i] = DecodeBF16ToF32(shard.raw_data.data() + param.byte_offset, param.nbytes);
+    }
+  }
+  return shard;
 }
 
 TVM_DLL ffi::Array<Tensor> TensorCacheMetadata::FileRecord::Load(
@@ -174,11 +450,7 @@ TVM_DLL ffi::Array<Tensor> TensorCacheMetadata::FileRecord::Load(
     const std::string& path_prefix,  //
     std::string* raw_data_buffer,    //
     ffi::Optional<Tensor>* staging_buffer) const {
-  LoadBinaryFromFile(path_prefix + "/" + this->data_path, raw_data_buffer);
-  TVM_FFI_CHECK_EQ(this->format, "raw-shard", ValueError) << "Only `raw-shard` format is supported";
-  TVM_FFI_CHECK_EQ(this->nbytes, raw_data_buffer->length(), ValueError)
-      << "Encountered an corrupted parameter shard. It means it is not downloaded "
-         "completely or downloading is interrupted. Please try to download again.";
+  this->ReadRawData(path_prefix + "/" + this->data_path, raw_data_buffer);
   ffi::Array<Tensor> result;
   result.reserve(this->records.size());
   for (const ParamRecord& nd_rec : this->records) {
@@ -232,6 +504,7 @@ class TensorCache {
   static void Load(const std::string& cache_path, int device_type, int device_id) {
     DLDevice device{static_cast<DLDeviceType>(device_type), device_id};
     TensorCacheMetadata metadata = TensorCacheMetadata::Load(cache_path);
+    WeightStore::Global()->ReleaseUnused();
     ffi::Optional<Tensor> staging_buffer;
     std::string raw_data;
     ffi::Array<Tensor> params;
@@ -249,10 +522,256 @@ class TensorCache {
     }
   }
 
+  /*!
+   * \brief Load parameters from path and append them, pipelining the loading of shard files.
+   * While the parameters of one shard file are uploaded to the device, the next shard file
+   * is read from disk, decompressed and decoded on host in a background thread.
+   * \param cache_path The cache to path.
+   * \param device_type The type of device to be loaded.
+   * \param device_id The device id.
+   * \param progress_callback The optional callback invoked as `(loaded_bytes, total_bytes)`
+   * after the parameters of each shard file are uploaded.
+   */
+  static void LoadPipelined(const std::string& cache_path, int device_type, int device_id,
+                            ffi::Optional<ffi::Function> progress_callback) {
+    DLDevice device{static_cast<DLDeviceType>(device_type), device_id};
+    TensorCacheMetadata metadata = TensorCacheMetadata::Load(cache_path);
+    WeightStore::Global()->ReleaseUnused();
+    const std::vector<TensorCacheMetadata::FileRecord>& records = metadata.records;
+    int num_files = records.size();
+    int64_t total_bytes = 0;
+    for (const TensorCacheMetadata::FileRecord& shard_rec : records) {
+      total_bytes += shard_rec.nbytes;
+    }
+    auto f_read = [&records, &cache_path](int i) { return ReadHostShard(records[i], cache_path); };
+
+    ffi::Optional<Tensor> staging_buffer;
+    int64_t loaded_bytes = 0;
+    // At most two shard files are in host memory: the one being uploaded and the one being read.
+    std::future<HostShard> next_shard;
+    if (num_files > 0) {
+      next_shard = std::async(std::launch::async, f_read, 0);
+    }
+    for (int i = 0; i < num_files; ++i) {
+      const TensorCacheMetadata::FileRecord& shard_rec = records[i];
+      HostShard shard;
+      try {
+        shard = next_shard.get();
+      } catch (const std::runtime_error& e) {
+        TVM_FFI_THROW(ValueError) << "Error when loading parameters from " << shard_rec.data_path
+                                  << ": " << e.what();
+      }
+      if (i + 1 < num_files) {
+        next_shard = std::async(std::launch::async, f_read, i + 1);
+      }
+      for (size_t j = 0; j < shard_rec.records.size(); ++j) {
+        const TensorCacheMetadata::FileRecord::ParamRecord& param = shard_rec.records[j];
+        const char* raw_data = shard.raw_data.data() + param.byte_offset;
+        Tensor arr = WeightStore::Global()->GetOrLoad(param, device, raw_data, [&]() {
+          Tensor arr = Tensor::Empty(param.shape, param.dtype, device);
+          if (NeedsDecoding(param)) {
+            const std::vector<uint32_t>& decoded = shard.decoded[j];
+            CopyTensorFromBytes(arr, decoded.data(), decoded.size() * sizeof(uint32_t),
+                                &staging_buffer);
+          } else {
+            CopyTensorFromBytes(arr, raw_data, param.nbytes, &staging_buffer);
+          }
+          return arr;
+        });
+        Update(param.name, arr, true);
+      }
+      loaded_bytes += shard_rec.nbytes;
+      if (progress_callback.has_value()) {
+        (*progress_callback)(loaded_bytes, total_bytes);
+      }
+    }
+  }
+
  private:
   ffi::Map<ffi::String, Tensor> pool_;
 };
 
+/*!
+ * \brief A stream of the parameters of a Tensor cache, loaded one at a time in the order they are
+ * fetched, e.g. by a weight-transform function of `LazyTransformParams` whose `fget_item` is
+ * `vm.builtin.tensor_cache.stream_get`. While a parameter is transformed on the device, the next
+ * ones are read from disk and decoded on host in the background. The stream does not hold a
+ * parameter after it is fetched, so its device memory is freed as soon as the transform drops it,
+ * and at most `prefetch_depth` parameters are in host memory at once.
+ */
+class TensorCacheStreamObj : public Object {
+ public:
+  ~TensorCacheStreamObj() {
+    // Wait for the reads in flight, as they refer to the records of the stream.
+    pending_.clear();
+  }
+
+  /*!
+   * \brief Fetch a parameter of the stream onto the device, and start reading the parameters
+   * following it.
+   * \param index The index of the parameter.
+   * \return The parameter, which is not held by the stream.
+   */
+  Tensor Get(int64_t index) {
+    TVM_FFI_ICHECK(index >= 0 && index < static_cast<int64_t>(params_.size()))
+        << "Parameter index " << index << " is out of range of the " << params_.size()
+        << " parameters of the stream";
+    HostParam host;
+    try {
+      auto it = pending_.find(index);
+      if (it != pending_.end()) {
+        host = it->second.get();
+        pending_.erase(it);
+      } else {
+        host = ReadHostParam(index);
+      }
+    } catch (const std::runtime_error& e) {
+      TVM_FFI_THROW(ValueError) << "Error when loading parameter " << params_[index]->name
+                                << " from " << files_[index]->data_path << ": " << e.what();
+    }
+    // The reads of the next parameters overlap with the upload and the transform of this one.
+    next_index_ = std::max(next_index_, index + 1);
+    while (static_cast<int64_t>(pending_.size()) < prefetch_depth_ &&
+           next_index_ < static_cast<int64_t>(params_.size())) {
+      int64_t next = next_index_++;
+      if (!pending_.count(next)) {
+        pending_[next] = std::async(std::launch::async, [this, next]() {
+          return ReadHostParam(next);
+        });
+      }
+    }
+    const TensorCacheMetadata::FileRecord::ParamRecord& param = *params_[index];
+    Tensor arr = Tensor::Empty(param.shape, param.dtype, device_);
+    if (NeedsDecoding(param)) {
+      CopyTensorFromBytes(arr, host.decoded.data(), host.decoded.size() * sizeof(uint32_t),
+                          &staging_buffer_);
+    } else {
+      CopyTensorFromBytes(arr, host.raw_data.data(), param.nbytes, &staging_buffer_);
+    }
+    return arr;
+  }
+
+  /*! \brief The number of the parameters of the stream. */
+  int64_t NumParams() const { return static_cast<int64_t>(params_.size()); }
+
+  static constexpr const bool _type_mutable = true;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("relax.vm.TensorCacheStream", TensorCacheStreamObj, Object);
+
+ private:
+  friend class TensorCacheStream;
+
+  /*! \brief The data of a parameter read into host memory, decoded if needed. */
+  struct HostParam {
+    std::string raw_data;
+    std::vector<uint32_t> decoded;
+  };
+
+  /*! \brief Read the bytes of one parameter from its shard file, and decode them on host. */
+  HostParam ReadHostParam(int64_t index) const {
+    const TensorCacheMetadata::FileRecord& file = *files_[index];
+    const TensorCacheMetadata::FileRecord::ParamRecord& param = *params_[index];
+    TVM_FFI_CHECK_EQ(file.format, "raw-shard", ValueError)
+        << "Only `raw-shard` format is supported";
+    HostParam host;
+    std::ifstream fs(metadata_.path + "/" + file.data_path, std::ios::in | std::ios::binary);
+    TVM_FFI_CHECK(!fs.fail(), ValueError) << "Cannot open " << file.data_path;
+    // Only the bytes of the parameter are read, or the compressed chunks covering them.
+    int64_t read_offset = param.byte_offset;
+    int64_t read_nbytes = param.nbytes;
+    int64_t begin = 0, end = 0;
+    if (file.compression.has_value()) {
+      const std::vector<int64_t>& chunks = file.compression->chunks;
+      int64_t chunk_nbytes = file.compression->chunk_nbytes;
+      begin = param.byte_offset / chunk_nbytes;
+      end = std::max(begin, (param.byte_offset + param.nbytes + chunk_nbytes - 1) / chunk_nbytes);
+      TVM_FFI_CHECK_LE(end, static_cast<int64_t>(chunks.size()), ValueError)
+          << "The chunks of the shard do not cover parameter " << param.name;
+      read_offset = std::accumulate(chunks.begin(), chunks.begin() + begin, int64_t(0));
+      read_nbytes = std::accumulate(chunks.begin() + begin, chunks.begin() + end, int64_t(0));
+    }
+    host.raw_data.resize(read_nbytes);
+    fs.seekg(read_offset);
+    fs.read(host.raw_data.data(), read_nbytes);
+    TVM_FFI_CHECK(!fs.fail(), ValueError)
+        << "Encountered an corrupted parameter shard. It means it is not downloaded "
+           "completely or downloading is interrupted. Please try to download again.";
+    if (file.compression.has_value()) {
+      std::string raw_chunks;
+      DecompressChunks(file, host.raw_data.data(), begin, end, &raw_chunks);
+      int64_t chunk_offset = param.byte_offset - begin * file.compression->chunk_nbytes;
+      host.raw_data = raw_chunks.substr(chunk_offset, param.nbytes);
+    }
+    if (NeedsDecoding(param)) {
+      host.decoded = DecodeBF16ToF32(host.raw_data.data(), param.nbytes);
+      host.raw_data.clear();
+    }
+    return host;
+  }
+
+  /*! \brief The metadata of the Tensor cache. */
+  TensorCacheMetadata metadata_;
+  /*! \brief The record of each parameter of the stream. */
+  std::vector<const TensorCacheMetadata::FileRecord::ParamRecord*> params_;
+  /*! \brief The shard file of each parameter of the stream. */
+  std::vector<const TensorCacheMetadata::FileRecord*> files_;
+  /*! \brief The device to load the parameters onto. */
+  Device device_;
+  /*! \brief The maximum number of the parameters read ahead. */
+  int64_t prefetch_depth_;
+  /*! \brief The index of the next parameter to read ahead. */
+  int64_t next_index_ = 0;
+  /*! \brief The reads in flight, by the index of their parameter. */
+  std::unordered_map<int64_t, std::future<HostParam>> pending_;
+  /*! \brief The staging buffer of the OpenCL uploads. */
+  ffi::Optional<Tensor> staging_buffer_;
+};
+
+/*! \brief Managed reference to TensorCacheStreamObj. */
+class TensorCacheStream : public ObjectRef {
+ public:
+  /*!
+   * \brief Create a stream of the parameters of a Tensor cache.
+   * \param cache_path The path to the Tensor cache.
+   * \param device_type The type of device to be loaded.
+   * \param device_id The device id.
+   * \param names The names of the parameters, in the order of their indices in the stream, or all
+   * the parameters of the cache in their order in it when empty.
+   * \param prefetch_depth The maximum number of the parameters read ahead.
+   */
+  static TensorCacheStream Create(const std::string& cache_path, int device_type, int device_id,
+                                  const ffi::Array<ffi::String>& names, int64_t prefetch_depth) {
+    TVM_FFI_ICHECK_GE(prefetch_depth, 0) << "The prefetch depth should be non-negative";
+    auto n = ffi::make_object<TensorCacheStreamObj>();
+    n->metadata_ = TensorCacheMetadata::Load(cache_path);
+    n->device_ = DLDevice{static_cast<DLDeviceType>(device_type), device_id};
+    n->prefetch_depth_ = prefetch_depth;
+    std::unordered_map<std::string, size_t> name_to_index;
+    for (const TensorCacheMetadata::FileRecord& file : n->metadata_.records) {
+      for (const TensorCacheMetadata::FileRecord::ParamRecord& param : file.records) {
+        name_to_index[param.name] = n->params_.size();
+        n->params_.push_back(&param);
+        n->files_.push_back(&file);
+      }
+    }
+    if (!names.empty()) {
+      std::vector<const TensorCacheMetadata::FileRecord::ParamRecord*> params;
+      std::vector<const TensorCacheMetadata::FileRecord*> files;
+      for (const ffi::String& name : names) {
+        auto it = name_to_index.find(name);
+        TVM_FFI_CHECK(it != name_to_index.end(), ValueError)
+            << "Cannot find parameter in cache: " << name;
+        params.push_back(n->params_[it->second]);
+        files.push_back(n->files_[it->second]);
+      }
+      n->params_ = std::move(params);
+      n->files_ = std::move(files);
+    }
+    return TensorCacheStream(n);
+  }
+
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(TensorCacheStream, ObjectRef, TensorCacheStreamObj);
+};
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -283,7 +802,18 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                   })
       .def("vm.builtin.tensor_cache.remove", TensorCache::Remove)
       .def("vm.builtin.tensor_cache.clear", TensorCache::Clear)
-      .def("vm.builtin.tensor_cache.load", TensorCache::Load);
+      .def("vm.builtin.tensor_cache.load", TensorCache::Load)
+      .def("vm.builtin.tensor_cache.load_pipelined", TensorCache::LoadPipelined)
+      .def("vm.builtin.tensor_cache.stream_create", TensorCacheStream::Create)
+      .def("vm.builtin.tensor_cache.stream_get",
+           [](TensorCacheStream stream, int64_t index) { return stream->Get(index); })
+      .def("vm.builtin.tensor_cache.stream_num_params",
+           [](TensorCacheStream stream) { return stream->NumParams(); })
+      .def("vm.builtin.weight_store.set_enabled",
+           [](bool enabled) { WeightStore::Global()->SetEnabled(enabled); })
+      .def("vm.builtin.weight_store.release_unused",
+           []() { WeightStore::Global()->ReleaseUnused(); })
+      .def("vm.builtin.weight_store.num_bytes", []() { return WeightStore::Global()->NumBytes(); });
 }
 
 // This param module node can be useful to get param dict in RPC mode
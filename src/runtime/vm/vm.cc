@@ -21,15 +21,21 @@
  * \file src/runtime/vm/vm.cc
  */
 #include <dlpack/dlpack.h>
+#include <tvm/ffi/container/map.h>
 #include <tvm/ffi/function.h>
 #include <tvm/runtime/memory/memory_manager.h>
 #include <tvm/runtime/nvtx.h>
 #include <tvm/runtime/profiling.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/runtime/vm/vm.h>
 
+#include <memory>
 #include <optional>
 #include <thread>
 
+#include "../../support/env.h"
+#include "future.h"
+
 namespace tvm {
 namespace runtime {
 namespace vm {
@@ -158,6 +164,8 @@ using RegType = ffi::Any;
  * from a function call.
  */
 struct VMFrame {
+  /*! \brief The index of the function that owns the frame. */
+  Index func_idx{-1};
   /*! \brief The return program counter. */
   Index return_pc;
   /*! \brief Statically allocated space for objects */
@@ -173,17 +181,89 @@ struct VMFrame {
   void Clear() {
     this->caller_return_register = 0;
     this->call_args.clear();
+    // Only object registers hold references; POD registers (int, float,
+    // dtype, opaque handles) are left in place and get overwritten on reuse.
     for (RegType& reg : register_file) {
-      reg = nullptr;
+      if (reg.type_index() >= ffi::TypeIndex::kTVMFFIStaticObjectBegin) {
+        reg = nullptr;
+      }
     }
   }
 
   void ResetForRecycle(Index pc, Index register_file_size) {
     this->return_pc = pc;
-    this->register_file.resize(register_file_size);
+    if (static_cast<Index>(this->register_file.size()) != register_file_size) {
+      this->register_file.resize(register_file_size);
+    }
   }
 };
 
+/*!
+ * \brief A pre-decoded VM instruction.
+ *
+ * The decoded table is built once at load time and is indexed by pc, so the
+ * jump offsets of the original bytecode remain valid. Call instructions carry
+ * a resolved callee and a pre-bound argument template in which immediates,
+ * constants, function-table entries and special registers are already filled
+ * in; only register arguments are patched at dispatch time.
+ *
+ * A Call that is immediately followed by a Ret or a Goto is fused into a
+ * single superinstruction so that the common "call then leave" and
+ * "call then jump" sequences take one trip through the dispatch loop.
+ */
+struct VMDecodedInstr {
+  enum class Kind : int {
+    kCall = 0,
+    kCallRet = 1,
+    kCallGoto = 2,
+    kRet = 3,
+    kGoto = 4,
+    kIf = 5,
+  };
+  /*! \brief The kind of the decoded instruction. */
+  Kind kind;
+  /*! \brief Destination register of a call, or the result/cond register of Ret/If. */
+  RegName reg{0};
+  /*! \brief The register returned by a fused CallRet. */
+  RegName ret_reg{0};
+  /*! \brief Jump offset of Goto, fused CallGoto or the false branch of If. */
+  Index offset{0};
+  /*! \brief The index of the callee in the function table. */
+  Index func_idx{0};
+  /*! \brief The resolved callee if it is a packed function. */
+  const ffi::Function::ContainerType* packed{nullptr};
+  /*! \brief The resolved callee if it is a VM closure. */
+  const VMClosureObj* closure{nullptr};
+  /*!
+   * \brief Argument template, in which the context pointers are left to be filled per call.
+   * \note Views into the constant and function pools of the program, which are not resized
+   * after Init.
+   */
+  std::vector<ffi::AnyView> arg_template;
+  /*! \brief (slot in arg_template, register) pairs that are filled per call. */
+  std::vector<std::pair<int, RegName>> reg_args;
+  /*! \brief The slots in arg_template of the context pointer, filled per call. */
+  std::vector<int> ctx_args;
+};
+
+/*!
+ * \brief The program of a VM initialized for its devices: the constants on the devices, the
+ * functions of the function table and the pre-decoded instructions.
+ *
+ * It does not depend on the state of an execution, and is shared by the VMs forked from the VM,
+ * so that each thread runs its own VM without initializing the program again.
+ */
+struct VMProgram {
+  /*! \brief The global constant pool */
+  std::vector<ffi::Any> const_pool;
+  /*!
+   * \brief Function pool to cache functions in func_table
+   */
+  std::vector<ffi::Any> func_pool;
+  /*! \brief The pre-decoded instructions, indexed by pc. */
+  std::vector<VMDecodedInstr> decoded_instrs;
+};
+
 class VirtualMachineImpl : public VirtualMachine {
  public:
   //---------------------------------------------------
@@ -206,6 +286,7 @@ class VirtualMachineImpl : public VirtualMachine {
   void _SaveClosure(ffi::PackedArgs args, ffi::Any* rv);
   void _InvokeClosure(ffi::PackedArgs args, ffi::Any* rv);
   void _InvokeClosureStateful(std::string func_name);
+  void _InvokeAsync(ffi::PackedArgs args, ffi::Any* rv);
   void _SetInstrument(ffi::PackedArgs args, ffi::Any* rv);
   void _GetOutputArity(ffi::PackedArgs args, ffi::Any* rv);
   void _GetOutput(ffi::PackedArgs args, ffi::Any* rv);
@@ -213,13 +294,18 @@ class VirtualMachineImpl : public VirtualMachine {
   void _SetInputWithParamModule(ffi::PackedArgs args, ffi::Any* rv);
   int _GetFunctionArity(std::string func_name);
   std::string _GetFunctionParamName(std::string func_name, int index);
+  void _SetPredecodedDispatch(bool enable) { this->predecoded_dispatch_ = enable; }
+  void _SetNVTXRanges(bool enable);
+  ffi::Map<ffi::String, int64_t> _GetFrameStats();
   ffi::Function _LookupFunction(const ffi::String& name);
+  ffi::Module _Fork();
 
   TVM_MODULE_VTABLE_BEGIN("relax.VirtualMachine");
   TVM_MODULE_VTABLE_ENTRY_PACKED("vm_initialization", &VirtualMachineImpl::_Init);
   TVM_MODULE_VTABLE_ENTRY_PACKED("save_function", &VirtualMachineImpl::_SaveClosure);
   TVM_MODULE_VTABLE_ENTRY_PACKED("invoke_closure", &VirtualMachineImpl::_InvokeClosure);
   TVM_MODULE_VTABLE_ENTRY("invoke_stateful", &VirtualMachineImpl::_InvokeClosureStateful);
+  TVM_MODULE_VTABLE_ENTRY_PACKED("invoke_async", &VirtualMachineImpl::_InvokeAsync);
   TVM_MODULE_VTABLE_ENTRY_PACKED("set_instrument", &VirtualMachineImpl::_SetInstrument);
   TVM_MODULE_VTABLE_ENTRY_PACKED("get_output_arity", &VirtualMachineImpl::_GetOutputArity);
   TVM_MODULE_VTABLE_ENTRY_PACKED("get_output", &VirtualMachineImpl::_GetOutput);
@@ -228,6 +314,10 @@ class VirtualMachineImpl : public VirtualMachine {
                                  &VirtualMachineImpl::_SetInputWithParamModule);
   TVM_MODULE_VTABLE_ENTRY("get_function_arity", &VirtualMachineImpl::_GetFunctionArity);
   TVM_MODULE_VTABLE_ENTRY("get_function_param_name", &VirtualMachineImpl::_GetFunctionParamName);
+  TVM_MODULE_VTABLE_ENTRY("set_predecoded_dispatch", &VirtualMachineImpl::_SetPredecodedDispatch);
+  TVM_MODULE_VTABLE_ENTRY("get_frame_stats", &VirtualMachineImpl::_GetFrameStats);
+  TVM_MODULE_VTABLE_ENTRY("set_nvtx_ranges", &VirtualMachineImpl::_SetNVTXRanges);
+  TVM_MODULE_VTABLE_ENTRY("fork", &VirtualMachineImpl::_Fork);
   TVM_MODULE_VTABLE_END_WITH_DEFAULT(&VirtualMachineImpl::_LookupFunction);
 
   //--------------------------------------------------
@@ -316,6 +406,12 @@ class VirtualMachineImpl : public VirtualMachine {
    */
   void InitFuncPool();
 
+  /*!
+   * \brief Build the pre-decoded instruction table.
+   * \note Must run after the constant and function pools are set up.
+   */
+  void InitDecodedInstrs();
+
   /*!
    * \brief A RAII wrapper that pushes and pops VM frames.
    */
@@ -327,9 +423,10 @@ class VirtualMachineImpl : public VirtualMachine {
     }
     ~FrameGuard() {
       TVM_FFI_ICHECK_GT(vm->frames_.size(), 0);
-      vm->pc_ = vm->frames_.back()->return_pc;
-      vm->frames_.back()->Clear();
-      vm->frame_free_list_.emplace_back(std::move(vm->frames_.back()));
+      std::unique_ptr<VMFrame>& frame = vm->frames_.back();
+      vm->pc_ = frame->return_pc;
+      frame->Clear();
+      vm->frame_pool_[frame->func_idx].emplace_back(std::move(frame));
       vm->frames_.pop_back();
     }
   };
@@ -339,17 +436,27 @@ class VirtualMachineImpl : public VirtualMachine {
   /*!
    * \brief Push a call frame onto the call stack.
    * \param ret_pc The program counter to return to.
-   * \param vm_func The function to be pushed to the call stack.
+   * \param func_idx The index of the function to be pushed to the call stack.
    * \return A RAII wrapper that pops the frame when going out of scope.
+   * \note Frames are pooled per function, so a recycled frame already has a
+   *       register file of the right size and steady state is allocation-free.
    */
-  FrameGuard PushFrame(Index ret_pc, const VMFuncInfo& vm_func) {
+  FrameGuard PushFrame(Index ret_pc, Index func_idx) {
+    const VMFuncInfo& vm_func = exec_->func_table[func_idx];
+    if (frame_pool_.size() <= static_cast<size_t>(func_idx)) {
+      frame_pool_.resize(exec_->func_table.size());
+    }
+    std::vector<std::unique_ptr<VMFrame>>& pool = frame_pool_[func_idx];
     std::unique_ptr<VMFrame> new_frame;
-    if (!frame_free_list_.empty()) {
-      new_frame = std::move(frame_free_list_.back());
-      frame_free_list_.pop_back();
+    if (!pool.empty()) {
+      new_frame = std::move(pool.back());
+      pool.pop_back();
       new_frame->ResetForRecycle(ret_pc, vm_func.register_file_size);
+      ++frame_reuse_count_;
     } else {
       new_frame = std::make_unique<VMFrame>(ret_pc, vm_func.register_file_size);
+      new_frame->func_idx = func_idx;
+      ++frame_alloc_count_;
     }
     return FrameGuard(this, std::move(new_frame));
   }
@@ -395,6 +502,16 @@ class VirtualMachineImpl : public VirtualMachine {
   /*! \brief Run VM dispatch loop. */
   void RunLoop();
 
+  /*! \brief Run VM dispatch loop over the pre-decoded instruction table. */
+  void RunLoopPredecoded();
+
+  /*!
+   * \brief Run a pre-decoded call.
+   * \param curr_frame The current frame.
+   * \param instr The decoded call instruction.
+   */
+  TVM_ALWAYS_INLINE void RunDecodedCall(VMFrame* curr_frame, const VMDecodedInstr& instr);
+
   /*!
    * \brief Retrieve the name of the function identified by the given index.
    * \param idx The index into the VM executable function table.
@@ -418,12 +535,18 @@ class VirtualMachineImpl : public VirtualMachine {
   //--------------------------------------------------------
   /*! \brief The loaded executable. */
   ObjectPtr<VMExecutable> exec_;
-  /*! \brief The global constant pool */
-  std::vector<ffi::Any> const_pool_;
+  /*! \brief The program initialized for the devices, shared with the forked VMs. */
+  std::shared_ptr<VMProgram> program_;
   /*!
-   * \brief Function pool to cache functions in func_table
+   * \brief Whether to dispatch through the pre-decoded table.
+   * \note Falls back to the bytecode interpreter when an instrument is set.
    */
-  std::vector<ffi::Any> func_pool_;
+  bool predecoded_dispatch_{true};
+  /*!
+   * \brief The name of the NVTX range of each instruction, i.e. its callee and the Relax binding
+   *  it computes, or empty when the instructions are not put in NVTX ranges.
+   */
+  std::vector<std::string> nvtx_instr_names_;
   //--------------------------------------------------------
   // Executor interface support
   //--------------------------------------------------------
@@ -442,9 +565,13 @@ class VirtualMachineImpl : public VirtualMachine {
    */
   std::vector<std::unique_ptr<VMFrame>> frames_;
   /*!
-   * \brief A free list of frame
+   * \brief Recycled frames, indexed by the function that owns them.
    */
-  std::vector<std::unique_ptr<VMFrame>> frame_free_list_;
+  std::vector<std::vector<std::unique_ptr<VMFrame>>> frame_pool_;
+  /*! \brief Number of frames allocated so far. */
+  int64_t frame_alloc_count_{0};
+  /*! \brief Number of frame pushes served from the pool. */
+  int64_t frame_reuse_count_{0};
 
   /*! \brief The virtual machine PC. */
   Index pc_{0};
@@ -470,18 +597,32 @@ void VirtualMachineImpl::Init(const std::vector<Device>& devices,
     this->devices.push_back(devices[i]);
     this->allocators.push_back(alloc);
   }
+  this->program_ = std::make_shared<VMProgram>();
   // Setup constant sections.
-  this->const_pool_.reserve(exec_->constants.size());
+  program_->const_pool.reserve(exec_->constants.size());
   for (size_t i = 0; i < exec_->constants.size(); ++i) {
     if (auto opt_nd = exec_->constants[i].as<Tensor>()) {
-      this->const_pool_.push_back(
+      program_->const_pool.push_back(
           ConvertRegToDevice(opt_nd.value(), devices[0], allocators[0], exec_->memory_scopes[i]));
     } else {
-      this->const_pool_.push_back(exec_->constants[i]);
+      program_->const_pool.push_back(exec_->constants[i]);
+    }
+  }
+  // Spread the host constant weights over the memory of all NUMA nodes, as the workers
+  // of every node read them.
+  if (devices[0].device_type == kDLCPU && threading::NumaNodeCount() > 1 &&
+      support::GetEnv("TVM_NUMA_INTERLEAVE_CONSTANTS", false)) {
+    for (const ffi::Any& constant : program_->const_pool) {
+      if (auto opt_nd = constant.as<Tensor>()) {
+        const DLTensor* tensor = opt_nd.value().operator->();
+        threading::InterleaveMemoryAcrossNumaNodes(
+            static_cast<char*>(tensor->data) + tensor->byte_offset, GetDataSize(*tensor));
+      }
     }
   }
   // Setup function sections.
   this->InitFuncPool();
+  this->InitDecodedInstrs();
 }
 
 VMFuncInfo VirtualMachineImpl::LookupVMFuncInfo(const std::string& func_name) {
@@ -628,10 +769,11 @@ ffi::Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const ffi::Strin
     ffi::Optional<ffi::Function> tir_func = GetFuncFromImports("__vmtir__" + finfo.name);
     TVM_FFI_ICHECK(tir_func.has_value())
         << "Cannot find underlying compiled tir function of VMTIRFunc " << finfo.name;
-    auto impl = ffi::Function([this, finfo, tir_func](ffi::PackedArgs args, ffi::Any* rv) {
+    // The closure runs on the VM of the context, as it is shared with the forked VMs.
+    auto impl = ffi::Function([finfo, tir_func](ffi::PackedArgs args, ffi::Any* rv) {
       // Per convention, ctx ptr is a VirtualMachine*
       VirtualMachine* ctx_ptr = static_cast<VirtualMachine*>(args[0].cast<void*>());
-      TVM_FFI_ICHECK(ctx_ptr == this);
+      const VMProgram& program = *static_cast<VirtualMachineImpl*>(ctx_ptr)->program_;
       TVM_FFI_ICHECK_EQ(args.size() - 1, finfo.num_args)
           << "Function " << finfo.name << " expects " << finfo.num_args << " arguments";
       TVM_FFI_ICHECK_GE(finfo.register_file_size, finfo.num_args + 1);
@@ -640,8 +782,8 @@ ffi::Optional<VMClosure> VirtualMachineImpl::GetClosureInternal(const ffi::Strin
         reg_file[i] = args[i + 1];
       }
       void* reg_anylist_handle = reg_file.data();
-      void* const_anylist_handle = this->const_pool_.data();
-      void* func_anylist_handle = this->func_pool_.data();
+      void* const_anylist_handle = const_cast<ffi::Any*>(program.const_pool.data());
+      void* func_anylist_handle = const_cast<ffi::Any*>(program.func_pool.data());
       (*tir_func)(static_cast<void*>(ctx_ptr), reg_anylist_handle, const_anylist_handle,
                   func_anylist_handle);
       // Return value always stored after inputs.
@@ -658,9 +800,15 @@ RegType VirtualMachineImpl::InvokeBytecode(Index gf_idx, const std::vector<RegTy
   const VMFuncInfo& gfunc = exec_->func_table[gf_idx];
   TVM_FFI_ICHECK(gfunc.kind == VMFuncInfo::FuncKind::kVMFunc);
 
+  // Attribute tracked allocations to the running function.
+  std::optional<memory::AllocationTagScope> alloc_tag;
+  if (MemoryManager::AllocationTrackingEnabled()) {
+    alloc_tag.emplace(gfunc.name);
+  }
+
   // Get the curr instr which might be a potential caller.
   Instruction curr_instr = exec_->GetInstruction(pc_);
-  auto guard = PushFrame(this->pc_, gfunc);
+  auto guard = PushFrame(this->pc_, gf_idx);
   // Get new frame and set the caller info.
   VMFrame* curr_frame = frames_.back().get();
   if (curr_instr.op == Opcode::Call) {
@@ -695,7 +843,7 @@ RegType VirtualMachineImpl::InvokeBytecode(Index gf_idx, const std::vector<RegTy
 }
 
 void VirtualMachineImpl::InitFuncPool() {
-  func_pool_.resize(exec_->func_table.size());
+  program_->func_pool.resize(exec_->func_table.size());
 
   for (size_t func_index = 0; func_index < exec_->func_table.size(); ++func_index) {
     const VMFuncInfo& info = exec_->func_table[func_index];
@@ -710,19 +858,134 @@ void VirtualMachineImpl::InitFuncPool() {
           << "Error: Cannot find ffi::Function " << info.name
           << " in either Relax VM kernel library, or in TVM runtime ffi::Function registry, or in "
              "global Relax functions of the VM executable";
-      func_pool_[func_index] = *func;
+      program_->func_pool[func_index] = *func;
 
     } else {
       TVM_FFI_ICHECK(info.kind == VMFuncInfo::FuncKind::kVMFunc ||
                      info.kind == VMFuncInfo::FuncKind::kVMTIRFunc);
       auto clo = this->GetClosure(info.name);
-      func_pool_[func_index] = clo;
+      program_->func_pool[func_index] = clo;
+    }
+  }
+}
+
+void VirtualMachineImpl::InitDecodedInstrs() {
+  size_t num_instrs = exec_->instr_offset.size();
+  program_->decoded_instrs.clear();
+  program_->decoded_instrs.resize(num_instrs);
+  for (size_t pc = 0; pc < num_instrs; ++pc) {
+    Instruction instr = exec_->GetInstruction(pc);
+    VMDecodedInstr& decoded = program_->decoded_instrs[pc];
+    switch (instr.op) {
+      case Opcode::Call: {
+        decoded.kind = VMDecodedInstr::Kind::kCall;
+        decoded.reg = instr.dst;
+        decoded.func_idx = instr.func_idx;
+        TVM_FFI_ICHECK_LT(static_cast<size_t>(instr.func_idx), program_->func_pool.size());
+        ObjectRef callee = program_->func_pool[instr.func_idx].cast<ObjectRef>();
+        decoded.packed = callee.as<ffi::Function::ContainerType>();
+        decoded.closure = callee.as<VMClosureObj>();
+        TVM_FFI_ICHECK(decoded.packed != nullptr || decoded.closure != nullptr)
+            << "Function expects a closure or ffi::Function ";
+        int offset = decoded.closure != nullptr ? 1 : 0;
+        decoded.arg_template.resize(offset + instr.num_args);
+        if (decoded.closure != nullptr) {
+          decoded.ctx_args.push_back(0);
+        }
+        for (Index i = 0; i < instr.num_args; ++i) {
+          Instruction::Arg arg = instr.args[i];
+          int slot = offset + i;
+          switch (arg.kind()) {
+            case Instruction::ArgKind::kRegister: {
+              if (arg.value() == Instruction::kVoidRegister) {
+                decoded.arg_template[slot] = nullptr;
+              } else if (arg.value() == Instruction::kVMRegister) {
+                decoded.ctx_args.push_back(slot);
+              } else {
+                TVM_FFI_ICHECK_LT(arg.value(), Instruction::kBeginSpecialReg);
+                decoded.reg_args.emplace_back(slot, arg.value());
+              }
+              break;
+            }
+            case Instruction::ArgKind::kImmediate: {
+              decoded.arg_template[slot] = arg.value();
+              break;
+            }
+            case Instruction::ArgKind::kConstIdx: {
+              decoded.arg_template[slot] = program_->const_pool[arg.value()];
+              break;
+            }
+            case Instruction::ArgKind::kFuncIdx: {
+              TVM_FFI_ICHECK_LT(static_cast<size_t>(arg.value()), program_->func_pool.size());
+              decoded.arg_template[slot] = program_->func_pool[arg.value()];
+              break;
+            }
+            default: {
+              TVM_FFI_THROW(ValueError) << "Unknown argument kind: " << int(arg.kind());
+            }
+          }
+        }
+        // Fuse with the following Ret/Goto. The following instruction keeps its
+        // own decoded entry, so branches that target it directly stay valid.
+        if (pc + 1 < num_instrs) {
+          Instruction next = exec_->GetInstruction(pc + 1);
+          if (next.op == Opcode::Ret) {
+            decoded.kind = VMDecodedInstr::Kind::kCallRet;
+            decoded.ret_reg = next.result;
+          } else if (next.op == Opcode::Goto) {
+            decoded.kind = VMDecodedInstr::Kind::kCallGoto;
+            decoded.offset = next.pc_offset;
+          }
+        }
+        break;
+      }
+      case Opcode::Ret: {
+        decoded.kind = VMDecodedInstr::Kind::kRet;
+        decoded.reg = instr.result;
+        break;
+      }
+      case Opcode::Goto: {
+        decoded.kind = VMDecodedInstr::Kind::kGoto;
+        decoded.offset = instr.pc_offset;
+        break;
+      }
+      case Opcode::If: {
+        decoded.kind = VMDecodedInstr::Kind::kIf;
+        decoded.reg = instr.cond;
+        decoded.offset = instr.false_offset;
+        break;
+      }
+    }
+  }
+}
+
+void VirtualMachineImpl::_SetNVTXRanges(bool enable) {
+  nvtx_instr_names_.clear();
+  if (!enable) {
+    return;
+  }
+  TVM_FFI_ICHECK(exec_ != nullptr) << "The executable is not loaded";
+  size_t num_instrs = exec_->instr_offset.size();
+  nvtx_instr_names_.resize(num_instrs);
+  for (size_t pc = 0; pc < num_instrs; ++pc) {
+    Instruction instr = exec_->GetInstruction(pc);
+    if (instr.op != Opcode::Call) {
+      continue;
     }
+    std::string name = "RelaxVM: " + GetFuncName(instr.func_idx);
+    if (pc < exec_->instr_debug_names.size() && !exec_->instr_debug_names[pc].empty()) {
+      name += " (" + exec_->instr_debug_names[pc] + ")";
+    }
+    nvtx_instr_names_[pc] = std::move(name);
   }
 }
 
 void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
   DLOG(INFO) << "\n  pc = " << pc_ << ", execute: " << GetFuncName(instr.func_idx);
+  std::optional<NVTXScopedRange> nvtx_scope;
+  if (!nvtx_instr_names_.empty()) {
+    nvtx_scope.emplace(nvtx_instr_names_[pc_]);
+  }
   int args_begin_offset = instrument_ != nullptr ? 4 : 0;
   // Use the call arg stack from the current frame to increase reuse
   // and avoid re-allocation
@@ -745,12 +1008,12 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
         break;
       }
       case Instruction::ArgKind::kConstIdx: {
-        call_args[arg_index] = this->const_pool_[arg.value()];
+        call_args[arg_index] = program_->const_pool[arg.value()];
         break;
       }
       case Instruction::ArgKind::kFuncIdx: {
-        TVM_FFI_ICHECK_LT(static_cast<size_t>(arg.value()), this->func_pool_.size());
-        call_args[arg_index] = this->func_pool_[arg.value()];
+        TVM_FFI_ICHECK_LT(static_cast<size_t>(arg.value()), program_->func_pool.size());
+        call_args[arg_index] = program_->func_pool[arg.value()];
         break;
       }
       default: {
@@ -761,13 +1024,13 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
   ffi::PackedArgs args(call_args.data() + args_begin_offset, instr.num_args);
   ffi::Any ret;
 
-  TVM_FFI_ICHECK_LT(static_cast<size_t>(instr.func_idx), this->func_pool_.size());
+  TVM_FFI_ICHECK_LT(static_cast<size_t>(instr.func_idx), program_->func_pool.size());
 
   if (instrument_ == nullptr) {
-    this->InvokeClosurePacked(func_pool_[instr.func_idx].cast<ObjectRef>(), args, &ret);
+    this->InvokeClosurePacked(program_->func_pool[instr.func_idx].cast<ObjectRef>(), args, &ret);
   } else {
     // insert light-weight instrument callback
-    call_args[0] = func_pool_[instr.func_idx];
+    call_args[0] = program_->func_pool[instr.func_idx];
     call_args[1] = GetFuncName(instr.func_idx);
     call_args[2] = true;
     call_args[3] = nullptr;
@@ -789,7 +1052,8 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
       ret_kind = opt_int.value();
     }
     if (ret_kind != static_cast<int>(VMInstrumentReturnKind::kSkipRun)) {
-      this->InvokeClosurePacked(func_pool_[instr.func_idx].cast<ObjectRef>(), args, &ret);
+      this->InvokeClosurePacked(program_->func_pool[instr.func_idx].cast<ObjectRef>(), args,
+                                &ret);
       call_args[2] = false;
       call_args[3] = ret;
       instrument_.CallPacked(call_args.data(), call_args.size(), &rv);
@@ -805,7 +1069,95 @@ void VirtualMachineImpl::RunInstrCall(VMFrame* curr_frame, Instruction instr) {
   pc_++;
 }
 
+void VirtualMachineImpl::RunDecodedCall(VMFrame* curr_frame, const VMDecodedInstr& instr) {
+  std::optional<NVTXScopedRange> nvtx_scope;
+  if (!nvtx_instr_names_.empty()) {
+    nvtx_scope.emplace(nvtx_instr_names_[pc_]);
+  }
+  // Use the call arg stack from the current frame, so that re-entrant
+  // calls of the same instruction never observe each other's arguments.
+  std::vector<ffi::AnyView>& call_args = curr_frame->call_args;
+  call_args.assign(instr.arg_template.begin(), instr.arg_template.end());
+  for (int slot : instr.ctx_args) {
+    call_args[slot] = static_cast<void*>(static_cast<VirtualMachine*>(this));
+  }
+  for (const auto& [slot, reg] : instr.reg_args) {
+    call_args[slot] = curr_frame->register_file[reg];
+  }
+  ffi::Any ret;
+  if (instr.packed != nullptr) {
+    instr.packed->CallPacked(call_args.data(), call_args.size(), &ret);
+  } else {
+    NVTXScopedRange scope("RelaxVM: " + instr.closure->func_name);
+    instr.closure->impl.CallPacked(call_args.data(), call_args.size(), &ret);
+  }
+  if (instr.reg < Instruction::kBeginSpecialReg) {
+    WriteRegister(curr_frame, instr.reg, ret);
+  }
+}
+
+void VirtualMachineImpl::RunLoopPredecoded() {
+  VMFrame* curr_frame = frames_.back().get();
+  const VMDecodedInstr* instrs = program_->decoded_instrs.data();
+  size_t num_instrs = program_->decoded_instrs.size();
+
+  auto f_return = [&](RegName result) {
+    return_value_ = ReadRegister(curr_frame, result);
+    if (frames_.size() > 1) {
+      // return from a local call.
+      VMFrame* parent_frame = frames_.end()[-2].get();
+      WriteRegister(parent_frame, curr_frame->caller_return_register, return_value_);
+    }
+  };
+
+  while (true) {
+    TVM_FFI_ICHECK_LT(static_cast<size_t>(pc_), num_instrs) << "run into invalid section";
+    const VMDecodedInstr& instr = instrs[pc_];
+    switch (instr.kind) {
+      case VMDecodedInstr::Kind::kCall: {
+        // pc_ must point to the call while it runs, see InvokeBytecode.
+        RunDecodedCall(curr_frame, instr);
+        pc_++;
+        break;
+      }
+      case VMDecodedInstr::Kind::kCallRet: {
+        RunDecodedCall(curr_frame, instr);
+        f_return(instr.ret_reg);
+        return;
+      }
+      case VMDecodedInstr::Kind::kCallGoto: {
+        RunDecodedCall(curr_frame, instr);
+        pc_ += 1 + instr.offset;
+        break;
+      }
+      case VMDecodedInstr::Kind::kRet: {
+        f_return(instr.reg);
+        return;
+      }
+      case VMDecodedInstr::Kind::kGoto: {
+        pc_ += instr.offset;
+        break;
+      }
+      case VMDecodedInstr::Kind::kIf: {
+        int64_t cond_val = ReadRegister(curr_frame, instr.reg).cast<int64_t>();
+        if (cond_val != 0) {
+          pc_++;
+        } else {
+          TVM_FFI_ICHECK_GT(instr.offset, 1);
+          pc_ += instr.offset;
+        }
+        break;
+      }
+    }
+  }
+}
+
 void VirtualMachineImpl::RunLoop() {
+  if (predecoded_dispatch_ && instrument_ == nullptr && program_ != nullptr &&
+      program_->decoded_instrs.size() == exec_->instr_offset.size()) {
+    this->RunLoopPredecoded();
+    return;
+  }
   VMFrame* curr_frame = frames_.back().get();
 
   while (true) {
@@ -883,6 +1235,30 @@ void VirtualMachineImpl::_InvokeClosure(ffi::PackedArgs args, ffi::Any* rv) {
   this->InvokeClosurePacked(args[0].cast<ObjectRef>(), args.Slice(1), rv);
 }
 
+void VirtualMachineImpl::_InvokeAsync(ffi::PackedArgs args, ffi::Any* rv) {
+  TVM_FFI_ICHECK_GE(args.size(), 2) << "invoke_async expects the function name and the callback";
+  VMClosure clo = this->GetClosure(args[0].cast<ffi::String>());
+  auto future = ffi::make_object<VMFutureObj>();
+  if (auto callback = args[1].cast<ffi::Optional<ffi::Function>>()) {
+    future->callback = callback.value();
+  }
+  // The host code of the function runs in this thread, which returns once the kernels are
+  // submitted to the streams, and the future waits for the streams in the background.
+  this->InvokeClosurePacked(clo, args.Slice(2), &future->result);
+  for (const Device& device : devices) {
+    bool seen = false;
+    for (const auto& [d, stream] : future->streams) {
+      seen = seen || (d.device_type == device.device_type && d.device_id == device.device_id);
+    }
+    if (!seen && device.device_type != kDLCPU) {
+      future->streams.emplace_back(device, DeviceAPI::Get(device)->GetCurrentStream(device));
+    }
+  }
+  VMFuture ref(future);
+  SubmitVMFuture(ref);
+  *rv = ref;
+}
+
 void VirtualMachineImpl::_InvokeClosureStateful(std::string func_name) {
   const std::unordered_map<std::string, Index>& m = this->exec_->func_map;
   if (m.find(func_name) == m.end()) {
@@ -893,8 +1269,8 @@ void VirtualMachineImpl::_InvokeClosureStateful(std::string func_name) {
                               << "; use `set_input` first.";
     return;
   }
-  outputs_[func_name] = this->InvokeClosureInternal(func_pool_[m.at(func_name)].cast<ObjectRef>(),
-                                                    inputs_[func_name]);
+  outputs_[func_name] = this->InvokeClosureInternal(
+      program_->func_pool[m.at(func_name)].cast<ObjectRef>(), inputs_[func_name]);
 }
 
 void VirtualMachineImpl::_SetInstrument(ffi::PackedArgs args, ffi::Any* rv) {
@@ -957,6 +1333,16 @@ std::string VirtualMachineImpl::_GetFunctionParamName(std::string func_name, int
   return vm_func.param_names[index];
 }
 
+ffi::Map<ffi::String, int64_t> VirtualMachineImpl::_GetFrameStats() {
+  int64_t pooled = 0;
+  for (const auto& pool : frame_pool_) {
+    pooled += static_cast<int64_t>(pool.size());
+  }
+  return {{"frame_alloc_count", frame_alloc_count_},
+          {"frame_reuse_count", frame_reuse_count_},
+          {"pooled_frames", pooled}};
+}
+
 ffi::Function VirtualMachineImpl::_LookupFunction(const ffi::String& name) {
   if (ffi::Optional<VMClosure> opt = this->GetClosureInternal(name, true)) {
     return ffi::Function([clo = opt.value(), _self = ffi::GetRef<ffi::Module>(this)](
@@ -969,6 +1355,22 @@ ffi::Function VirtualMachineImpl::_LookupFunction(const ffi::String& name) {
   return ffi::Function(nullptr);
 }
 
+ffi::Module VirtualMachineImpl::_Fork() {
+  TVM_FFI_ICHECK(program_ != nullptr) << "The VM should be initialized before being forked.";
+  // The fork shares the program and the allocators, and has its own state of execution, so
+  // that it runs concurrently with this VM in another thread.
+  auto n = ffi::make_object<VirtualMachineImpl>();
+  n->exec_ = exec_;
+  n->imports_ = imports_;
+  n->devices = devices;
+  n->allocators = allocators;
+  n->program_ = program_;
+  n->predecoded_dispatch_ = predecoded_dispatch_;
+  n->nvtx_instr_names_ = nvtx_instr_names_;
+  n->saved_closures_ = saved_closures_;
+  return ffi::Module(n);
+}
+
 //----------------------------------------------------------------
 // Profiler can be optionally disabled via a macro to reduce dep.
 //----------------------------------------------------------------
@@ -980,6 +1382,9 @@ ffi::Function VirtualMachineImpl::_LookupFunction(const ffi::String& name) {
  */
 class VirtualMachineProfiler : public VirtualMachineImpl {
  public:
+  // The profiler instruments RunInstrCall, so keep the bytecode interpreter.
+  VirtualMachineProfiler() { this->predecoded_dispatch_ = false; }
+
   ffi::Optional<ffi::Function> GetFunction(const ffi::String& name) override {
     ObjectPtr<Object> sptr_to_self = ffi::GetObjectPtr<Object>(this);
     if (name == "profile") {
@@ -994,7 +1399,8 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
           }
         }
 
-        prof_ = profiling::Profiler(devices, {}, {{ffi::String("Executor"), ffi::String("VM")}});
+        prof_ = profiling::Profiler(devices, collectors_,
+                                    {{ffi::String("Executor"), ffi::String("VM")}});
 
         auto inputs = GetInputsFor(f_name);
 
@@ -1025,6 +1431,13 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
           ClearInputsFor(f_name);
         }
       });
+    } else if (name == "set_profiler_collectors") {
+      return ffi::Function([sptr_to_self, this](ffi::PackedArgs args, ffi::Any* rv) {
+        collectors_.clear();
+        for (const auto& collector : args[0].cast<ffi::Array<profiling::MetricCollector>>()) {
+          collectors_.push_back(collector);
+        }
+      });
     } else {
       return VirtualMachineImpl::GetFunction(name);
     }
@@ -1054,13 +1467,26 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
           auto reg = ReadRegister(curr_frame, arg.value());
           f_check_tensor_arg(reg);
         } else if (arg.kind() == Instruction::ArgKind::kConstIdx) {
-          const auto& const_val = this->const_pool_[arg.value()];
+          const auto& const_val = program_->const_pool[arg.value()];
           f_check_tensor_arg(const_val);
         }
       }
 
       std::unordered_map<std::string, ffi::Any> metrics;
       metrics["Argument Shapes"] = profiling::ShapeString(arrs);
+      // The estimated costs of the PrimFunc, from which the report derives its throughput.
+      auto it = exec_->kernel_costs.find(f_name);
+      if (it != exec_->kernel_costs.end()) {
+        auto [flops, nbytes] = it->second;
+        metrics["FLOPs"] =
+            ObjectRef(ffi::make_object<profiling::CountNode>(static_cast<int64_t>(flops)));
+        metrics["DRAM Bytes"] =
+            ObjectRef(ffi::make_object<profiling::CountNode>(static_cast<int64_t>(nbytes)));
+        if (nbytes > 0) {
+          metrics["Arithmetic Intensity"] =
+              ObjectRef(ffi::make_object<profiling::RatioNode>(flops / nbytes));
+        }
+      }
 
       // If a suitable device is found, enable profiling.
       if (dev) {
@@ -1078,6 +1504,8 @@ class VirtualMachineProfiler : public VirtualMachineImpl {
 
  private:
   std::optional<profiling::Profiler> prof_;
+  /*! \brief The metric collectors of the next profiles, e.g. of hardware counters. */
+  std::vector<profiling::MetricCollector> collectors_;
 };
 
 ObjectPtr<VirtualMachine> VirtualMachine::CreateProfiler() {
@@ -38,12 +38,26 @@ VkBufferCreateInfo MakeBufferCreateInfo(size_t nbytes, VkBufferUsageFlags usage)
 }
 
 VulkanBuffer::VulkanBuffer(const VulkanDevice& device, size_t nbytes, VkBufferUsageFlags usage,
-                           uint32_t mem_type_index)
+                           uint32_t mem_type_index, VulkanMemoryAllocator* allocator)
     : device_(device) {
   // Create a buffer
   VkBufferCreateInfo buffer_info = MakeBufferCreateInfo(nbytes, usage);
   VULKAN_CALL(vkCreateBuffer(device, &buffer_info, nullptr, &buffer));
 
+  if (allocator) {
+    VkDeviceSize dedicated_nbytes = 0;
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, buffer, &requirements);
+    if (!UseDedicatedAllocation(device, buffer, &dedicated_nbytes) &&
+        allocator->CanAllocate(requirements.size)) {
+      allocation_ = allocator->Allocate(requirements, mem_type_index);
+      allocator_ = allocator;
+      memory = allocation_.memory;
+      VULKAN_CALL(vkBindBufferMemory(device, buffer, memory, allocation_.offset));
+      return;
+    }
+  }
+
   // Allocate memory
   VkMemoryAllocateInfo mem_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
   mem_info.allocationSize = buffer_info.size;
@@ -64,26 +78,38 @@ VulkanBuffer::VulkanBuffer(const VulkanDevice& device, size_t nbytes, VkBufferUs
   VULKAN_CALL(vkBindBufferMemory(device, buffer, memory, 0));
 }
 
+std::atomic<uint64_t> VulkanBuffer::num_destroyed_{0};
+
 VulkanBuffer::~VulkanBuffer() {
   if (buffer) {
     vkDestroyBuffer(device_, buffer, nullptr);
+    num_destroyed_.fetch_add(1, std::memory_order_relaxed);
   }
-  if (memory) {
+  if (allocator_) {
+    allocator_->Free(allocation_);
+  } else if (memory) {
     vkFreeMemory(device_, memory, nullptr);
   }
 }
 
 VulkanBuffer::VulkanBuffer(VulkanBuffer&& other)
-    : device_(other.device_), buffer(other.buffer), memory(other.memory) {
+    : device_(other.device_),
+      buffer(other.buffer),
+      memory(other.memory),
+      allocator_(other.allocator_),
+      allocation_(other.allocation_) {
   other.device_ = VK_NULL_HANDLE;
   other.buffer = VK_NULL_HANDLE;
   other.memory = VK_NULL_HANDLE;
+  other.allocator_ = nullptr;
 }
 
 VulkanBuffer& VulkanBuffer::operator=(VulkanBuffer&& other) {
   std::swap(device_, other.device_);
   std::swap(buffer, other.buffer);
   std::swap(memory, other.memory);
+  std::swap(allocator_, other.allocator_);
+  std::swap(allocation_, other.allocation_);
   return *this;
 }
 
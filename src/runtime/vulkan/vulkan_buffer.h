@@ -22,9 +22,12 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
+#include "vulkan_memory_allocator.h"
+
 namespace tvm {
 namespace runtime {
 namespace vulkan {
@@ -46,9 +49,13 @@ class VulkanBuffer {
    * \param mem_type_index The memory type to index.  This should be
    * an index to a compatible memory located in
    * VkPhysicalDeviceMemoryProperties.
+   *
+   * \param allocator If given, the memory is sub-allocated from its
+   * memory blocks, unless the buffer needs a dedicated allocation or
+   * is too large.  The allocator should outlive the VulkanBuffer.
    */
   VulkanBuffer(const VulkanDevice& device, size_t nbytes, VkBufferUsageFlags usage,
-               uint32_t mem_type_index);
+               uint32_t mem_type_index, VulkanMemoryAllocator* allocator = nullptr);
 
   //! \brief Destructor, deallocates the memory and buffer.
   ~VulkanBuffer();
@@ -61,15 +68,21 @@ class VulkanBuffer {
   VulkanBuffer(VulkanBuffer&&);
   VulkanBuffer& operator=(VulkanBuffer&&);
 
+  /*! \brief The number of buffers destroyed so far, after which the cached descriptor sets may
+   * refer to handles that are reused by new buffers.
+   */
+  static uint64_t NumDestroyed() { return num_destroyed_.load(std::memory_order_relaxed); }
+
  private:
   /*! \brief Whether this buffer should be allocated using dedicated
    * allocation
    *
    * In typical usage, there will be one VkDeviceMemory that has a
-   * large number of VkBuffers pointing to it.  Currently, the TVM
-   * Vulkan runtime has a single VkBuffer for each VkDeviceMemory.  In
-   * this case, there can be performance benefits by explicitly
-   * marking this as a dedicated allocation.  The function returns
+   * large number of VkBuffers pointing to it, as sub-allocated by a
+   * VulkanMemoryAllocator.  Buffers that are not sub-allocated have a
+   * single VkDeviceMemory of their own.  In this case, there can be
+   * performance benefits by explicitly marking this as a dedicated
+   * allocation.  The function returns
    * true if the device supports the dedicated allocation extension,
    * and the buffer either requires or has better performance with a
    * dedicated allocation.
@@ -100,10 +113,23 @@ class VulkanBuffer {
   //! \brief Handle to the logical buffer on the device
   VkBuffer buffer{VK_NULL_HANDLE};
 
-  //! \brief Handle to the physical device memory
+  /*! \brief Handle to the physical device memory
+   *
+   * If the buffer is sub-allocated, the memory block it is bound to,
+   * shared with other buffers.
+   */
   VkDeviceMemory memory{VK_NULL_HANDLE};
 
+  //! \brief The allocator the memory is sub-allocated from, if any
+  VulkanMemoryAllocator* allocator_{nullptr};
+
+  //! \brief The range of the memory block, if sub-allocated
+  VulkanMemoryAllocation allocation_;
+
   friend class VulkanHostVisibleBuffer;
+
+ private:
+  static std::atomic<uint64_t> num_destroyed_;
 };
 
 /*! \brief A struct to represent Vulkan buffers backed by host visible memory */
@@ -351,6 +351,17 @@ VulkanDevice::VulkanDevice(const VulkanInstance& instance, VkPhysicalDevice phy_
     queue_insert_debug_utils_label_functions =
         std::make_unique<VulkanQueueInsertDebugUtilsLabelFunctions>(instance);
   }
+
+  // Sub-allocate the compute buffers from large memory blocks, unless
+  // disabled by an environment variable.  The blocks are kept to a
+  // fraction of the heap on devices with little memory.
+  if (!support::BoolEnvironmentVar("TVM_VULKAN_DISABLE_SUBALLOCATION")) {
+    VkDeviceSize block_size = VulkanMemoryAllocator::kDefaultBlockSize;
+    if (compute_memory_size > 0) {
+      block_size = std::min<VkDeviceSize>(block_size, compute_memory_size / 16);
+    }
+    compute_memory_allocator = std::make_unique<VulkanMemoryAllocator>(device_, block_size);
+  }
 }
 
 VulkanDevice::~VulkanDevice() {
@@ -361,6 +372,7 @@ VulkanDevice::~VulkanDevice() {
   stream_per_thread.Clear();
   staging_buffer_per_thread.Clear();
   uniform_buffer_per_thread.Clear();
+  compute_memory_allocator.reset();
 
   if (device_) {
     vkDestroyDevice(device_, nullptr);
@@ -393,6 +405,7 @@ void VulkanDevice::do_swap(VulkanDevice&& other) {
             other.queue_insert_debug_utils_label_functions);
   std::swap(compute_mtype_index, other.compute_mtype_index);
   std::swap(compute_memory_size, other.compute_memory_size);
+  std::swap(compute_memory_allocator, other.compute_memory_allocator);
   std::swap(queue, other.queue);
   std::swap(queue_family_index, other.queue_family_index);
   std::swap(physical_device_, other.physical_device_);
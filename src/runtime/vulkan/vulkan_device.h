@@ -225,6 +225,8 @@ class VulkanDevice {
   uint32_t compute_mtype_index{0};
   // maximum memory size for compute
   int64_t compute_memory_size{0};
+  // Sub-allocator of the compute memory, nullptr if disabled
+  std::unique_ptr<VulkanMemoryAllocator> compute_memory_allocator{nullptr};
 
   // queue family_index;
   uint32_t queue_family_index{uint32_t(-1)};
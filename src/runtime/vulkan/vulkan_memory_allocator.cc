@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "vulkan_memory_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "vulkan_common.h"
+
+namespace tvm {
+namespace runtime {
+namespace vulkan {
+
+VulkanMemoryAllocator::VulkanMemoryAllocator(VkDevice device, VkDeviceSize block_size)
+    : device_(device), block_size_(block_size) {}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+  for (const auto& kv : block_of_memory_) {
+    vkFreeMemory(device_, kv.first, nullptr);
+  }
+}
+
+bool VulkanMemoryAllocator::AllocateFromBlock(Block* block, VkDeviceSize nbytes,
+                                              VkDeviceSize alignment, VkDeviceSize* offset) {
+  for (auto it = block->free_ranges.begin(); it != block->free_ranges.end(); ++it) {
+    VkDeviceSize begin = it->first;
+    VkDeviceSize end = it->first + it->second;
+    VkDeviceSize aligned = (begin + alignment - 1) / alignment * alignment;
+    if (aligned + nbytes > end) {
+      continue;
+    }
+    block->free_ranges.erase(it);
+    // The padding before the aligned offset and the rest of the range stay free.
+    if (aligned > begin) {
+      block->free_ranges.emplace(begin, aligned - begin);
+    }
+    if (aligned + nbytes < end) {
+      block->free_ranges.emplace(aligned + nbytes, end - aligned - nbytes);
+    }
+    block->used_bytes += nbytes;
+    *offset = aligned;
+    return true;
+  }
+  return false;
+}
+
+VulkanMemoryAllocation VulkanMemoryAllocator::Allocate(const VkMemoryRequirements& requirements,
+                                                       uint32_t mem_type_index) {
+  TVM_FFI_ICHECK(CanAllocate(requirements.size))
+      << "Cannot sub-allocate " << requirements.size << " bytes from blocks of " << block_size_
+      << " bytes";
+  TVM_FFI_ICHECK(requirements.memoryTypeBits & (1u << mem_type_index))
+      << "The memory type " << mem_type_index << " cannot back the buffer";
+  VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  VulkanMemoryAllocation allocation;
+  allocation.size = requirements.size;
+  auto& blocks = blocks_[mem_type_index];
+  for (const auto& block : blocks) {
+    if (AllocateFromBlock(block.get(), requirements.size, alignment, &allocation.offset)) {
+      allocation.memory = block->memory;
+      return allocation;
+    }
+  }
+
+  auto block = std::make_unique<Block>();
+  VkMemoryAllocateInfo mem_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+  mem_info.allocationSize = block_size_;
+  mem_info.memoryTypeIndex = mem_type_index;
+  VULKAN_CALL(vkAllocateMemory(device_, &mem_info, nullptr, &block->memory));
+  block->mem_type_index = mem_type_index;
+  block->free_ranges.emplace(0, block_size_);
+  TVM_FFI_ICHECK(AllocateFromBlock(block.get(), requirements.size, alignment, &allocation.offset));
+  allocation.memory = block->memory;
+  block_of_memory_[block->memory] = block.get();
+  blocks.push_back(std::move(block));
+  return allocation;
+}
+
+void VulkanMemoryAllocator::Free(const VulkanMemoryAllocation& allocation) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto block_it = block_of_memory_.find(allocation.memory);
+  TVM_FFI_ICHECK(block_it != block_of_memory_.end())
+      << "The memory was not allocated by this allocator";
+  Block* block = block_it->second;
+
+  // Return the range, merged with the free ranges next to it.
+  VkDeviceSize begin = allocation.offset;
+  VkDeviceSize end = allocation.offset + allocation.size;
+  auto next = block->free_ranges.lower_bound(begin);
+  if (next != block->free_ranges.end() && next->first == end) {
+    end += next->second;
+    next = block->free_ranges.erase(next);
+  }
+  if (next != block->free_ranges.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == begin) {
+      begin = prev->first;
+      block->free_ranges.erase(prev);
+    }
+  }
+  block->free_ranges.emplace(begin, end - begin);
+  block->used_bytes -= allocation.size;
+
+  // Give an empty block back to the driver, unless it is the last one of its memory type.
+  auto& blocks = blocks_[block->mem_type_index];
+  if (block->used_bytes == 0 && blocks.size() > 1) {
+    vkFreeMemory(device_, block->memory, nullptr);
+    block_of_memory_.erase(block_it);
+    blocks.erase(std::find_if(blocks.begin(), blocks.end(),
+                              [block](const auto& b) { return b.get() == block; }));
+  }
+}
+
+size_t VulkanMemoryAllocator::NumBlocks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return block_of_memory_.size();
+}
+
+}  // namespace vulkan
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TVM_RUNTIME_VULKAN_VULKAN_MEMORY_ALLOCATOR_H_
+#define TVM_RUNTIME_VULKAN_VULKAN_MEMORY_ALLOCATOR_H_
+
+#include <vulkan/vulkan_core.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vulkan {
+
+/*! \brief A range of a memory block, to which a VkBuffer is bound. */
+struct VulkanMemoryAllocation {
+  //! \brief The memory block the range belongs to
+  VkDeviceMemory memory{VK_NULL_HANDLE};
+  //! \brief The offset of the range in the memory block
+  VkDeviceSize offset{0};
+  //! \brief The size of the range
+  VkDeviceSize size{0};
+};
+
+/*! \brief Sub-allocates device memory out of large memory blocks
+ *
+ * Drivers limit the number of VkDeviceMemory allocations
+ * (maxMemoryAllocationCount, as low as 4096), and vkAllocateMemory
+ * is slow on many mobile GPUs.  Instead of one VkDeviceMemory per
+ * buffer, the allocator allocates blocks of memory per memory type,
+ * and binds the buffers to ranges of them, found first-fit.  Freed
+ * ranges are merged with their neighbours, and a block is returned to
+ * the driver once empty, except for the last block of a memory type,
+ * which is kept for the next allocations.
+ *
+ * Requests larger than half a block are not sub-allocated, and should
+ * get a memory allocation of their own.
+ */
+class VulkanMemoryAllocator {
+ public:
+  /* \brief Create an allocator for a device
+   *
+   * \param device The device to allocate memory on.  It should
+   * outlive the allocator.
+   *
+   * \param block_size The size in bytes of the memory blocks.
+   */
+  VulkanMemoryAllocator(VkDevice device, VkDeviceSize block_size);
+
+  //! \brief Destructor, frees the memory blocks.
+  ~VulkanMemoryAllocator();
+
+  // Forbid copy/move, the buffers refer to the allocator
+  VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+  VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+
+  /*! \brief Whether a request of the given size is sub-allocated */
+  bool CanAllocate(VkDeviceSize nbytes) const { return nbytes <= block_size_ / 2; }
+
+  /*! \brief Allocate a range for a buffer
+   *
+   * \param requirements The memory requirements of the buffer.
+   *
+   * \param mem_type_index The memory type to allocate from.  Should be
+   * allowed by requirements.memoryTypeBits.
+   */
+  VulkanMemoryAllocation Allocate(const VkMemoryRequirements& requirements,
+                                  uint32_t mem_type_index);
+
+  /*! \brief Return a range to its memory block */
+  void Free(const VulkanMemoryAllocation& allocation);
+
+  /*! \brief The number of memory blocks currently allocated */
+  size_t NumBlocks() const;
+
+  /*! \brief The default size of the memory blocks, 64MB */
+  static constexpr const VkDeviceSize kDefaultBlockSize = 64 << 20;
+
+ private:
+  struct Block {
+    VkDeviceMemory memory{VK_NULL_HANDLE};
+    uint32_t mem_type_index{0};
+    // The free ranges of the block, from offset to size
+    std::map<VkDeviceSize, VkDeviceSize> free_ranges;
+    // The number of bytes in use
+    VkDeviceSize used_bytes{0};
+  };
+
+  /*! \brief Find a free range of a block, and mark it as used */
+  static bool AllocateFromBlock(Block* block, VkDeviceSize nbytes, VkDeviceSize alignment,
+                                VkDeviceSize* offset);
+
+  VkDevice device_{VK_NULL_HANDLE};
+  VkDeviceSize block_size_;
+  // The blocks of each memory type
+  std::unordered_map<uint32_t, std::vector<std::unique_ptr<Block>>> blocks_;
+  // The blocks, by their memory handle
+  std::unordered_map<VkDeviceMemory, Block*> block_of_memory_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace vulkan
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VULKAN_VULKAN_MEMORY_ALLOCATOR_H_
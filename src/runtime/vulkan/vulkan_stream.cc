@@ -99,9 +99,7 @@ void VulkanStream::LaunchDeferred(const std::function<void()>& deferred_initiali
 
   // If the new kernel uses the same buffers in the same descriptor
   // set as an already-queued kernel, we don't need to initialize it
-  // again.  Since every VulkanWrappedFunc owns a single descriptor
-  // set, unless the same function is called with the same buffer
-  // arguments, deferred_initializer() will always be called.
+  // again.
   if (!std::any_of(deferred_tokens_[deferred_token.descriptor_set_].begin(),
                    deferred_tokens_[deferred_token.descriptor_set_].end(),
                    [&](const VulkanStreamToken& token) {
@@ -117,6 +115,15 @@ void VulkanStream::LaunchDeferred(const std::function<void()>& deferred_initiali
   deferred_tokens_[deferred_token.descriptor_set_].push_back(deferred_token);
 }
 
+const std::vector<VulkanStreamToken>* VulkanStream::QueuedTokens(
+    VkDescriptorSet descriptor_set) const {
+  auto it = deferred_tokens_.find(descriptor_set);
+  if (it == deferred_tokens_.end() || it->second.empty()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
 void VulkanStream::Synchronize() {
   if (!device_->UseImmediate()) {
     for (const auto& deferred_kernel : deferred_kernels_) {
@@ -100,6 +100,12 @@ class VulkanStream {
                       const std::function<void(VulkanStreamState*)>& deferred_kernel,
                       const VulkanStreamToken& deferred_token);
 
+  /*! \brief The kernels queued with a descriptor set, or nullptr if none is queued.
+   *
+   * Can only be called if device.UseImmediate() is false.
+   */
+  const std::vector<VulkanStreamToken>* QueuedTokens(VkDescriptorSet descriptor_set) const;
+
   // reset profiler state
   void ProfilerReset() {
     if (profiler_) {
@@ -21,6 +21,7 @@
 
 #include <tvm/support/io.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "../../support/bytes_io.h"
@@ -113,14 +114,81 @@ void VulkanWrappedFunc::operator()(ffi::PackedArgs args, ffi::Any* rv,
   }
 
   // Otherwise, the more expensive deferred path.
+  VulkanStreamToken deferred_token;
+  deferred_token.buffers_.resize(descriptor_buffers.size());
+  for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
+    deferred_token.buffers_[i] = descriptor_buffers[i].buffer;
+  }
+  bool needs_update = true;
+  {
+    // Pick a descriptor set that does not force the queued kernels to be submitted first: one
+    // that is queued with the same buffers, or else one that no queued kernel uses.  A set that
+    // was last written with the same buffers is not written again, unless a buffer was destroyed
+    // since then, as its handle may have been reused.
+    std::lock_guard<std::mutex> lock(pipeline->descriptor_set_mutex);
+    const VulkanStream& stream = device.ThreadLocalStream();
+    uint64_t num_destroyed_buffers = VulkanBuffer::NumDestroyed();
+    VulkanDescriptorSet* chosen = nullptr;
+    VulkanDescriptorSet* unused = nullptr;
+    for (VulkanDescriptorSet& set : pipeline->descriptor_sets) {
+      const auto* tokens = stream.QueuedTokens(set.descriptor_set);
+      if (tokens == nullptr) {
+        if (set.buffers == deferred_token.buffers_ &&
+            set.num_destroyed_buffers == num_destroyed_buffers) {
+          chosen = &set;
+          needs_update = false;
+          break;
+        }
+        if (unused == nullptr) {
+          unused = &set;
+        }
+      } else if (std::any_of(tokens->begin(), tokens->end(), [&](const VulkanStreamToken& token) {
+                   return token.buffers_ == deferred_token.buffers_;
+                 })) {
+        chosen = &set;
+        needs_update = false;
+        break;
+      }
+    }
+    if (chosen == nullptr) {
+      chosen = unused;
+    }
+    if (chosen == nullptr && pipeline->descriptor_sets.size() < kMaxNumDescriptorSets) {
+      VkDescriptorSetAllocateInfo alloc_info;
+      alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      alloc_info.pNext = nullptr;
+      alloc_info.descriptorPool = pipeline->descriptor_pool;
+      alloc_info.descriptorSetCount = 1;
+      alloc_info.pSetLayouts = &(pipeline->descriptor_set_layout);
+      VulkanDescriptorSet set;
+      VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &(set.descriptor_set)));
+      pipeline->descriptor_sets.push_back(std::move(set));
+      chosen = &pipeline->descriptor_sets.back();
+    }
+    if (chosen == nullptr) {
+      // All the sets are in use, LaunchDeferred submits the queued kernels before reusing one.
+      chosen = &pipeline->descriptor_sets[0];
+    }
+    if (needs_update) {
+      chosen->buffers = deferred_token.buffers_;
+      chosen->num_destroyed_buffers = num_destroyed_buffers;
+    }
+    deferred_token.descriptor_set_ = chosen->descriptor_set;
+  }
+  VkDescriptorSet descriptor_set = deferred_token.descriptor_set_;
+
   std::vector<ArgUnion64> pack_args_storage(pack_args, pack_args + num_pack_args_);
-  const auto& deferred_initializer = [&device, pipeline, descriptor_buffers]() {
+  const auto& deferred_initializer = [&device, pipeline, descriptor_buffers, descriptor_set,
+                                      needs_update]() {
+    if (!needs_update) {
+      return;
+    }
     std::vector<VkWriteDescriptorSet> write_descriptor_sets;
     write_descriptor_sets.resize(descriptor_buffers.size());
     for (size_t i = 0; i < write_descriptor_sets.size(); i++) {
       write_descriptor_sets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
       write_descriptor_sets[i].pNext = nullptr;
-      write_descriptor_sets[i].dstSet = pipeline->descriptor_set;
+      write_descriptor_sets[i].dstSet = descriptor_set;
       write_descriptor_sets[i].dstBinding = i;
       write_descriptor_sets[i].dstArrayElement = 0;
       write_descriptor_sets[i].descriptorCount = 1;
@@ -138,14 +206,13 @@ void VulkanWrappedFunc::operator()(ffi::PackedArgs args, ffi::Any* rv,
     vkUpdateDescriptorSets(device, write_descriptor_sets.size(), write_descriptor_sets.data(), 0,
                            nullptr);
   };
-  const auto& deferred_kernel = [this, pipeline, wl, pack_args_storage, nbytes_scalars,
-                                 device_id](VulkanStreamState* state) {
+  const auto& deferred_kernel = [this, pipeline, wl, pack_args_storage, nbytes_scalars, device_id,
+                                 descriptor_set](VulkanStreamState* state) {
     auto& device = VulkanDeviceAPI::Global()->device(device_id);
 
     vkCmdBindPipeline(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
     vkCmdBindDescriptorSets(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
-                            pipeline->pipeline_layout, 0, 1, &(pipeline->descriptor_set), 0,
-                            nullptr);
+                            pipeline->pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
 
     if (pipeline->use_ubo) {
       auto& ubo = device.ThreadLocalUniformBuffer(nbytes_scalars);
@@ -167,12 +234,6 @@ void VulkanWrappedFunc::operator()(ffi::PackedArgs args, ffi::Any* rv,
                          VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
                          1, &barrier_info, 0, nullptr, 0, nullptr);
   };
-  VulkanStreamToken deferred_token;
-  deferred_token.descriptor_set_ = pipeline->descriptor_set;
-  deferred_token.buffers_.resize(descriptor_buffers.size());
-  for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
-    deferred_token.buffers_[i] = descriptor_buffers[i].buffer;
-  }
   device.ThreadLocalStream().LaunchDeferred(deferred_initializer, deferred_kernel, deferred_token);
 
   if (device.UseDebugUtilsLabel()) {
@@ -325,7 +386,10 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
     descrip_pool_cinfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     descrip_pool_cinfo.pNext = nullptr;
     descrip_pool_cinfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-    descrip_pool_cinfo.maxSets = 1;
+    descrip_pool_cinfo.maxSets = kMaxNumDescriptorSets;
+    for (auto& pool_size : descriptor_set_pool_sizes) {
+      pool_size.descriptorCount *= kMaxNumDescriptorSets;
+    }
     descrip_pool_cinfo.poolSizeCount = descriptor_set_pool_sizes.size();
     descrip_pool_cinfo.pPoolSizes = descriptor_set_pool_sizes.data();
     VULKAN_CALL(
@@ -337,7 +401,9 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
     alloc_info.descriptorPool = pe->descriptor_pool;
     alloc_info.descriptorSetCount = 1;
     alloc_info.pSetLayouts = &(pe->descriptor_set_layout);
-    VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &(pe->descriptor_set)));
+    VulkanDescriptorSet set;
+    VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &(set.descriptor_set)));
+    pe->descriptor_sets.push_back(std::move(set));
   }
 
   VkPushConstantRange crange;
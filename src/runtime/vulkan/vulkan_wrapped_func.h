@@ -39,12 +39,27 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
+/*! \brief The maximum number of descriptor sets of a pipeline without push descriptors. */
+static constexpr const uint32_t kMaxNumDescriptorSets = 16;
+
+/*! \brief A descriptor set of a pipeline, and the buffers it was last written with. */
+struct VulkanDescriptorSet {
+  VkDescriptorSet descriptor_set{VK_NULL_HANDLE};
+  std::vector<VkBuffer> buffers;
+  // The number of Vulkan buffers destroyed when the set was written.
+  uint64_t num_destroyed_buffers{0};
+};
+
 struct VulkanPipeline {
   VulkanDevice* device{nullptr};
   VkShaderModule shader{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptor_set_layout{VK_NULL_HANDLE};
   VkDescriptorPool descriptor_pool{VK_NULL_HANDLE};
-  VkDescriptorSet descriptor_set{VK_NULL_HANDLE};
+  // The descriptor sets, allocated on demand, so that the dispatches of different buffers can be
+  // queued in the same command buffer.
+  std::vector<VulkanDescriptorSet> descriptor_sets;
+  // Guards accesses to `descriptor_sets`
+  std::mutex descriptor_set_mutex;
   VkPipelineLayout pipeline_layout{VK_NULL_HANDLE};
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkDescriptorUpdateTemplateKHR descriptor_update_template{VK_NULL_HANDLE};
@@ -23,6 +23,8 @@
  */
 #include "workspace_pool.h"
 
+#include <tvm/runtime/threading_backend.h>
+
 #include <memory>
 
 namespace tvm {
@@ -33,8 +35,8 @@ constexpr size_t kWorkspacePageSize = 4 << 10;
 
 class WorkspacePool::Pool {
  public:
-  // constructor
-  Pool() {
+  // constructor, numa_node is the node to place the pages on, -1 for no placement.
+  explicit Pool(int numa_node = -1) : numa_node_(numa_node) {
     // safe guard header on each list.
     Entry e;
     e.data = nullptr;
@@ -58,11 +60,11 @@ class WorkspacePool::Pool {
       if (e.size < nbytes) {
         // resize the page
         device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+        e.data = AllocPage(dev, device, nbytes, type);
         e.size = nbytes;
       }
     } else if (free_list_.size() == 1) {
-      e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+      e.data = AllocPage(dev, device, nbytes, type);
       e.size = nbytes;
     } else {
       if (free_list_.back().size >= nbytes) {
@@ -77,13 +79,20 @@ class WorkspacePool::Pool {
         e = free_list_.back();
         free_list_.pop_back();
         device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+        e.data = AllocPage(dev, device, nbytes, type);
         e.size = nbytes;
       }
     }
     allocated_.push_back(e);
     return e.data;
   }
+  // whether data is allocated from this pool and not yet freed
+  bool Owns(void* data) const {
+    for (size_t i = 1; i < allocated_.size(); ++i) {
+      if (allocated_[i].data == data) return true;
+    }
+    return false;
+  }
   // free resource back to pool
   void Free(void* data) {
     Entry e;
@@ -122,6 +131,15 @@ class WorkspacePool::Pool {
   }
 
  private:
+  void* AllocPage(Device dev, DeviceAPI* device, size_t nbytes, DLDataType type) {
+    void* data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+    if (numa_node_ >= 0) {
+      threading::BindMemoryToNumaNode(data, nbytes, numa_node_);
+    }
+    return data;
+  }
+  /*! \brief The NUMA node the pages are placed on, -1 for no placement */
+  int numa_node_;
   /*! \brief a single entry in the pool */
   struct Entry {
     void* data;
@@ -133,15 +151,17 @@ class WorkspacePool::Pool {
   std::vector<Entry> allocated_;
 };
 
-WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device)
-    : device_type_(device_type), device_(device) {}
+WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device, bool numa_aware)
+    : num_numa_nodes_(numa_aware ? threading::NumaNodeCount() : 1),
+      device_type_(device_type),
+      device_(device) {}
 
 WorkspacePool::~WorkspacePool() {
   for (size_t i = 0; i < array_.size(); ++i) {
     if (array_[i] != nullptr) {
       Device dev;
       dev.device_type = device_type_;
-      dev.device_id = static_cast<int>(i);
+      dev.device_id = static_cast<int>(i) / num_numa_nodes_;
       array_[i]->Release(dev, device_);
       delete array_[i];
     }
@@ -149,19 +169,35 @@ WorkspacePool::~WorkspacePool() {
 }
 
 void* WorkspacePool::AllocWorkspace(Device dev, size_t size) {
-  if (static_cast<size_t>(dev.device_id) >= array_.size()) {
-    array_.resize(dev.device_id + 1, nullptr);
+  int node = num_numa_nodes_ > 1 ? threading::CurrentNumaNode() : 0;
+  size_t index = static_cast<size_t>(dev.device_id) * num_numa_nodes_ + node;
+  if (index >= array_.size()) {
+    array_.resize((dev.device_id + 1) * num_numa_nodes_, nullptr);
   }
-  if (array_[dev.device_id] == nullptr) {
-    array_[dev.device_id] = new Pool();
+  if (array_[index] == nullptr) {
+    array_[index] = new Pool(num_numa_nodes_ > 1 ? node : -1);
   }
-  return array_[dev.device_id]->Alloc(dev, device_, size);
+  return array_[index]->Alloc(dev, device_, size);
 }
 
 void WorkspacePool::FreeWorkspace(Device dev, void* ptr) {
-  TVM_FFI_ICHECK(static_cast<size_t>(dev.device_id) < array_.size() &&
-                 array_[dev.device_id] != nullptr);
-  array_[dev.device_id]->Free(ptr);
+  size_t index = static_cast<size_t>(dev.device_id) * num_numa_nodes_;
+  TVM_FFI_ICHECK(index < array_.size()) << "trying to free things that has not been allocated";
+  if (num_numa_nodes_ > 1) {
+    // The thread may have migrated to another node since the allocation.
+    size_t current = index + threading::CurrentNumaNode();
+    if (array_[current] == nullptr || !array_[current]->Owns(ptr)) {
+      for (int node = 0; node < num_numa_nodes_; ++node) {
+        if (array_[index + node] != nullptr && array_[index + node]->Owns(ptr)) {
+          current = index + node;
+          break;
+        }
+      }
+    }
+    index = current;
+  }
+  TVM_FFI_ICHECK(array_[index] != nullptr);
+  array_[index]->Free(ptr);
 }
 
 }  // namespace runtime
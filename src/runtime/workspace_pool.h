@@ -48,8 +48,10 @@ class TVM_DLL WorkspacePool {
    * \brief Create pool with specific device type and device.
    * \param device_type The device type.
    * \param device_api The device API.
+   * \param numa_aware Whether to keep a separate pool per NUMA node of the host, and place
+   *        the pages of each pool on its node. Only meaningful for host memory.
    */
-  WorkspacePool(DLDeviceType device_type, DeviceAPI* device_api);
+  WorkspacePool(DLDeviceType device_type, DeviceAPI* device_api, bool numa_aware = false);
   /*! \brief destructor */
   ~WorkspacePool();
   /*!
@@ -68,8 +70,10 @@ class TVM_DLL WorkspacePool {
 
  private:
   class Pool;
-  /*! \brief pool of device local array */
+  /*! \brief pool of device local array, indexed by device_id * num_numa_nodes_ + node */
   std::vector<Pool*> array_;
+  /*! \brief number of NUMA nodes pools are kept for, 1 when not NUMA aware */
+  int num_numa_nodes_;
   /*! \brief device type this pool support */
   DLDeviceType device_type_;
   /*! \brief The device API */
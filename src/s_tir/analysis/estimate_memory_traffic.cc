@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file estimate_memory_traffic.cc
+ * \brief Estimate the DRAM traffic of the PrimFuncs, the memory term of their roofline.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_map>
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+/*! \brief Collect whether each buffer is read (bit 0) or written (bit 1), by its data var. */
+class BufferAccessMaskCollector : public StmtExprVisitor {
+ public:
+  std::unordered_map<const VarNode*, int> masks;
+
+ private:
+  void VisitExpr_(const BufferLoadNode* op) final {
+    masks[op->buffer->data.get()] |= 1;
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    masks[op->buffer->data.get()] |= 2;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const SBlockNode* op) final {
+    // The regions of the blocks also cover the opaque accesses, e.g. of the tensor intrinsics.
+    for (const BufferRegion& region : op->reads) {
+      masks[region->buffer->data.get()] |= 1;
+    }
+    for (const BufferRegion& region : op->writes) {
+      masks[region->buffer->data.get()] |= 2;
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::tvm_access_ptr()) && op->args.size() == 5) {
+      const auto* rw_mask = op->args[4].as<IntImmNode>();
+      if (const auto* data = op->args[1].as<VarNode>()) {
+        masks[data] |= rw_mask != nullptr ? (rw_mask->value & 3) : 3;
+      }
+      for (size_t i = 2; i < op->args.size(); ++i) {
+        this->VisitExpr(op->args[i]);
+      }
+      return;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode* op) final {
+    // The other uses of a data pointer, e.g. by the extern calls, may both read and write it.
+    if (op->dtype.is_handle()) {
+      masks[op] |= 3;
+    }
+  }
+};
+
+ffi::Optional<int64_t> EstimateTIRMemoryTraffic(const PrimFunc& func) {
+  BufferAccessMaskCollector collector;
+  collector(func->body);
+  int64_t total = 0;
+  for (const Var& param : func->params) {
+    auto it = func->buffer_map.find(param);
+    if (it == func->buffer_map.end()) {
+      continue;
+    }
+    const Buffer& buffer = (*it).second;
+    auto mask = collector.masks.find(buffer->data.get());
+    if (mask == collector.masks.end() || mask->second == 0) {
+      continue;
+    }
+    int64_t bytes = buffer->dtype.bytes() * buffer->dtype.lanes();
+    for (const PrimExpr& dim : buffer->shape) {
+      const auto* extent = dim.as<IntImmNode>();
+      if (extent == nullptr) {
+        return std::nullopt;
+      }
+      bytes *= extent->value;
+    }
+    total += bytes * ((mask->second & 1) + ((mask->second >> 1) & 1));
+  }
+  return total;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.analysis.EstimateTIRMemoryTraffic", EstimateTIRMemoryTraffic);
+}
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -0,0 +1,466 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+/*! \brief The measured candidates of a workload, i.e. of one tuning context. */
+struct GBDTFeatureGroup {
+  /*! \brief The feature rows of all candidates, row-major. */
+  std::vector<float> features;
+  /*! \brief The rows of the i-th candidate are [row_offsets[i], row_offsets[i + 1]). */
+  std::vector<int64_t> row_offsets{0};
+  /*! \brief The median running time of each candidate. */
+  std::vector<double> costs;
+  /*! \brief The minimum of `costs`. */
+  double min_cost = 1e10;
+};
+
+/*! \brief A regression tree; internal nodes have `feature >= 0`. */
+struct GBDTTree {
+  /*! \brief The feature an internal node splits on, or -1 for a leaf. */
+  std::vector<int32_t> feature;
+  /*! \brief An internal node goes to `left` if the feature is less than `value`. */
+  std::vector<int32_t> left;
+  std::vector<int32_t> right;
+  /*! \brief The split threshold of an internal node, or the output of a leaf. */
+  std::vector<float> value;
+
+  double Predict(const float* row) const {
+    int node = 0;
+    while (feature[node] >= 0) {
+      node = row[feature[node]] < value[node] ? left[node] : right[node];
+    }
+    return value[node];
+  }
+
+  int AddNode() {
+    feature.push_back(-1);
+    left.push_back(-1);
+    right.push_back(-1);
+    value.push_back(0.0f);
+    return static_cast<int>(feature.size()) - 1;
+  }
+};
+
+/*!
+ * \brief Gradient-boosted regression trees trained and evaluated in C++.
+ *
+ * The objective is the pack-sum squared error of XGBModel: the score of a candidate is the sum of
+ * the tree outputs over its feature rows, fitted to `min_cost / cost` of its workload, and the
+ * error of each candidate is weighted by its label so that the fast candidates matter most.
+ * Features are bucketed into per-feature quantile histograms, so that finding the best split of a
+ * node costs a pass over its rows per feature.
+ */
+class GBDTCostModelNode : public CostModelNode {
+ public:
+  /*! \brief The feature extractor. */
+  FeatureExtractor extractor;
+  /*! \brief The number of samples before the model gives predictions other than random ones. */
+  int num_warmup_samples;
+  /*! \brief Whether to retrain only when the data has grown by 20% since the last training. */
+  bool adaptive_training;
+  /*! \brief The number of boosting rounds, i.e. of trees. */
+  int num_rounds;
+  /*! \brief The maximum depth of a tree. */
+  int max_depth;
+  /*! \brief The shrinkage applied to the output of each tree. */
+  double learning_rate;
+  /*! \brief The L2 regularization on the leaf outputs. */
+  double reg_lambda;
+  /*! \brief The minimum sum of hessians in a child of a split. */
+  double min_child_weight;
+  /*! \brief The maximum number of histogram bins per feature. */
+  int max_bin;
+  /*! \brief The random state used for the predictions before warmup. */
+  support::LinearCongruentialEngine::TRandState rand_state = 1;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<GBDTCostModelNode>()
+        .def_ro("extractor", &GBDTCostModelNode::extractor)
+        .def_ro("num_warmup_samples", &GBDTCostModelNode::num_warmup_samples)
+        .def_ro("adaptive_training", &GBDTCostModelNode::adaptive_training)
+        .def_ro("num_rounds", &GBDTCostModelNode::num_rounds)
+        .def_ro("max_depth", &GBDTCostModelNode::max_depth)
+        .def_ro("learning_rate", &GBDTCostModelNode::learning_rate)
+        .def_ro("reg_lambda", &GBDTCostModelNode::reg_lambda)
+        .def_ro("min_child_weight", &GBDTCostModelNode::min_child_weight)
+        .def_ro("max_bin", &GBDTCostModelNode::max_bin);
+  }
+
+  void Load(const ffi::String& path) final {
+    std::ifstream is(path.operator std::string(), std::ifstream::binary);
+    TVM_FFI_CHECK(is.is_open(), ValueError) << "Cannot open file: " << path;
+    std::string blob((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    support::BytesInStream strm(blob);
+    std::string magic;
+    TVM_FFI_CHECK(strm.Read(&magic) && magic == kMagic, ValueError)
+        << "Not a GBDTCostModel file: " << path;
+    uint64_t num_groups = 0, num_trees = 0;
+    bool ok = strm.Read(&num_features_) && strm.Read(&data_size_) &&
+              strm.Read(&last_train_size_) && strm.Read(&num_groups);
+    data_.clear();
+    for (uint64_t i = 0; ok && i < num_groups; ++i) {
+      std::string group_hash;
+      ok = strm.Read(&group_hash);
+      GBDTFeatureGroup& group = data_[group_hash];
+      ok = ok && strm.Read(&group.features) && strm.Read(&group.row_offsets) &&
+           strm.Read(&group.costs) && strm.Read(&group.min_cost);
+    }
+    ok = ok && strm.Read(&num_trees);
+    trees_.clear();
+    trees_.resize(ok ? num_trees : 0);
+    for (GBDTTree& tree : trees_) {
+      ok = ok && strm.Read(&tree.feature) && strm.Read(&tree.left) && strm.Read(&tree.right) &&
+           strm.Read(&tree.value);
+    }
+    TVM_FFI_CHECK(ok, ValueError) << "Corrupted GBDTCostModel file: " << path;
+  }
+
+  void Save(const ffi::String& path) final {
+    std::string blob;
+    support::BytesOutStream strm(&blob);
+    strm.Write(std::string(kMagic));
+    strm.Write(num_features_);
+    strm.Write(data_size_);
+    strm.Write(last_train_size_);
+    strm.Write(static_cast<uint64_t>(data_.size()));
+    for (const auto& [group_hash, group] : data_) {
+      strm.Write(group_hash);
+      strm.Write(group.features);
+      strm.Write(group.row_offsets);
+      strm.Write(group.costs);
+      strm.Write(group.min_cost);
+    }
+    strm.Write(static_cast<uint64_t>(trees_.size()));
+    for (const GBDTTree& tree : trees_) {
+      strm.Write(tree.feature);
+      strm.Write(tree.left);
+      strm.Write(tree.right);
+      strm.Write(tree.value);
+    }
+    std::ofstream os(path.operator std::string(), std::ofstream::binary);
+    TVM_FFI_CHECK(os.is_open(), ValueError) << "Cannot open file: " << path;
+    os.write(blob.data(), blob.size());
+  }
+
+  void Update(const TuneContext& context, const ffi::Array<MeasureCandidate>& candidates,
+              const ffi::Array<RunnerResult>& results) final {
+    TVM_FFI_ICHECK_EQ(candidates.size(), results.size());
+    if (candidates.empty()) {
+      return;
+    }
+    ffi::Array<runtime::Tensor> batch = extractor->ExtractBatch(context, candidates);
+    const float* features = static_cast<const float*>(batch[0]->data);
+    const int64_t* offsets = static_cast<const int64_t*>(batch[1]->data);
+    int64_t num_features = batch[0]->shape[1];
+    if (offsets[candidates.size()] == 0) {
+      return;
+    }
+    TVM_FFI_CHECK(num_features_ == -1 || num_features_ == num_features, ValueError)
+        << "The feature length changed from " << num_features_ << " to " << num_features;
+    num_features_ = num_features;
+    ffi::String group_hash =
+        context->mod.has_value() ? SHash2Hex(context->mod.value()) : SHash2Hex(ObjectRef());
+    GBDTFeatureGroup& group = data_[group_hash];
+    for (int i = 0, n = candidates.size(); i < n; ++i) {
+      // Candidates without any feature row cannot be scored, so they are not learnt from
+      if (offsets[i] == offsets[i + 1]) {
+        continue;
+      }
+      group.features.insert(group.features.end(), features + offsets[i] * num_features,
+                            features + offsets[i + 1] * num_features);
+      group.row_offsets.push_back(group.row_offsets.back() + offsets[i + 1] - offsets[i]);
+      group.costs.push_back(MedianCost(results[i]));
+      group.min_cost = std::min(group.min_cost, group.costs.back());
+      ++data_size_;
+    }
+    if (adaptive_training && data_size_ - last_train_size_ < last_train_size_ / 5) {
+      // Set a training threshold related to `last_train_size_` to reduce the training overhead
+      // when there are too many results
+      return;
+    }
+    last_train_size_ = data_size_;
+    Train(std::max(1, context->num_threads));
+  }
+
+  std::vector<double> Predict(const TuneContext& context,
+                              const ffi::Array<MeasureCandidate>& candidates) final {
+    int n = candidates.size();
+    std::vector<double> result(n, 0.0);
+    if (data_size_ < num_warmup_samples || trees_.empty()) {
+      support::LinearCongruentialEngine rand_engine(&rand_state);
+      std::uniform_real_distribution<double> dist(0.0, 1.0);
+      for (double& score : result) {
+        score = dist(rand_engine);
+      }
+      return result;
+    }
+    if (n == 0) {
+      return result;
+    }
+    ffi::Array<runtime::Tensor> batch = extractor->ExtractBatch(context, candidates);
+    const float* features = static_cast<const float*>(batch[0]->data);
+    const int64_t* offsets = static_cast<const int64_t*>(batch[1]->data);
+    TVM_FFI_CHECK(offsets[n] == 0 || batch[0]->shape[1] == num_features_, ValueError)
+        << "The feature length changed from " << num_features_ << " to " << batch[0]->shape[1];
+    support::parallel_for_dynamic(0, n, std::max(1, context->num_threads), [&](int, int i) {
+      double score = 0.0;
+      for (int64_t r = offsets[i]; r < offsets[i + 1]; ++r) {
+        for (const GBDTTree& tree : trees_) {
+          score += tree.Predict(features + r * num_features_);
+        }
+      }
+      result[i] = score;
+    });
+    return result;
+  }
+
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.GBDTCostModel", GBDTCostModelNode,
+                                    CostModelNode);
+
+ private:
+  static constexpr const char* kMagic = "TVMGBDT1";
+  /*! \brief Below this many histogram updates a node is split on the calling thread. */
+  static constexpr int64_t kMinParallelWork = 1 << 16;
+
+  static double MedianCost(const RunnerResult& result) {
+    ffi::Array<FloatImm> run_secs = result->run_secs.value_or({});
+    if (run_secs.empty()) {
+      return 1e10;
+    }
+    std::vector<double> v;
+    for (const FloatImm& f : run_secs) {
+      v.push_back(f->value);
+    }
+    std::sort(v.begin(), v.end());
+    int n = v.size();
+    return n % 2 == 0 ? (v[n / 2 - 1] + v[n / 2]) * 0.5 : v[n / 2];
+  }
+
+  /*! \brief Retrain all trees from scratch on the collected data. */
+  void Train(int num_threads) {
+    // Step 1. Gather the data points of all groups
+    std::vector<const float*> rows;
+    std::vector<int32_t> row_to_sample;
+    std::vector<double> labels;
+    for (const auto& [group_hash, group] : data_) {
+      for (size_t i = 0; i < group.costs.size(); ++i) {
+        for (int64_t r = group.row_offsets[i]; r < group.row_offsets[i + 1]; ++r) {
+          rows.push_back(group.features.data() + r * num_features_);
+          row_to_sample.push_back(labels.size());
+        }
+        labels.push_back(group.min_cost / group.costs[i]);
+      }
+    }
+    int64_t num_rows = rows.size();
+    int num_features = num_features_;
+    // Step 2. Bucket each feature into quantile bins, stored column by column
+    std::vector<std::vector<float>> cuts(num_features);
+    std::vector<uint8_t> bins(num_rows * num_features);
+    support::parallel_for_dynamic(0, num_features, num_threads, [&](int, int f) {
+      std::vector<float> column(num_rows);
+      for (int64_t r = 0; r < num_rows; ++r) {
+        column[r] = rows[r][f];
+      }
+      std::sort(column.begin(), column.end());
+      int64_t num_unique = 0;
+      for (int64_t r = 0; r < num_rows && num_unique <= max_bin; ++r) {
+        num_unique += (r == 0 || column[r - 1] < column[r]);
+      }
+      // A cut `c` separates the values below `c` from the others, so the minimum is never a cut
+      std::vector<float>& cut = cuts[f];
+      if (num_unique <= max_bin) {
+        std::unique_copy(column.begin(), column.end(), std::back_inserter(cut));
+        if (!cut.empty()) cut.erase(cut.begin());
+      } else {
+        for (int b = 1; b < max_bin; ++b) {
+          float v = column[b * num_rows / max_bin];
+          if (v > column[0] && (cut.empty() || cut.back() < v)) cut.push_back(v);
+        }
+      }
+      uint8_t* bin = bins.data() + f * num_rows;
+      for (int64_t r = 0; r < num_rows; ++r) {
+        bin[r] = std::upper_bound(cut.begin(), cut.end(), rows[r][f]) - cut.begin();
+      }
+    });
+    // Step 3. Boost the trees on the pack-sum squared error
+    std::vector<double> sample_scores(labels.size(), 0.0);
+    std::vector<double> row_scores(num_rows);
+    std::vector<double> grad(num_rows), hess(num_rows);
+    trees_.clear();
+    for (int round = 0; round < num_rounds; ++round) {
+      for (int64_t r = 0; r < num_rows; ++r) {
+        double y = labels[row_to_sample[r]];
+        grad[r] = (sample_scores[row_to_sample[r]] - y) * y;
+        hess[r] = y;
+      }
+      trees_.push_back(BuildTree(bins, cuts, grad, hess, num_threads, &row_scores));
+      for (int64_t r = 0; r < num_rows; ++r) {
+        sample_scores[row_to_sample[r]] += row_scores[r];
+      }
+    }
+  }
+
+  /*!
+   * \brief Grow one tree on the binned features.
+   * \param row_scores Receives the output of the tree on each row.
+   */
+  GBDTTree BuildTree(const std::vector<uint8_t>& bins, const std::vector<std::vector<float>>& cuts,
+                     const std::vector<double>& grad, const std::vector<double>& hess,
+                     int num_threads, std::vector<double>* row_scores) {
+    struct Split {
+      double gain = 0.0;
+      int feature = -1;
+      int bin = -1;
+    };
+    int64_t num_rows = grad.size();
+    int num_features = cuts.size();
+    GBDTTree tree;
+    // The rows of each pending node, grown depth first
+    std::vector<std::tuple<int, int, std::vector<int64_t>>> stack;
+    std::vector<int64_t> all_rows(num_rows);
+    std::iota(all_rows.begin(), all_rows.end(), 0);
+    stack.emplace_back(tree.AddNode(), 0, std::move(all_rows));
+    while (!stack.empty()) {
+      int node = std::get<0>(stack.back());
+      int depth = std::get<1>(stack.back());
+      std::vector<int64_t> node_rows = std::move(std::get<2>(stack.back()));
+      stack.pop_back();
+      double sum_grad = 0.0, sum_hess = 0.0;
+      for (int64_t r : node_rows) {
+        sum_grad += grad[r];
+        sum_hess += hess[r];
+      }
+      double parent_gain = sum_grad * sum_grad / (sum_hess + reg_lambda);
+      std::vector<Split> splits(num_features);
+      auto f_find_split = [&](int, int f) {
+        int num_bins = cuts[f].size() + 1;
+        if (num_bins < 2) return;
+        std::vector<double> hist_grad(num_bins, 0.0), hist_hess(num_bins, 0.0);
+        const uint8_t* bin = bins.data() + f * num_rows;
+        for (int64_t r : node_rows) {
+          hist_grad[bin[r]] += grad[r];
+          hist_hess[bin[r]] += hess[r];
+        }
+        double left_grad = 0.0, left_hess = 0.0;
+        for (int b = 0; b + 1 < num_bins; ++b) {
+          left_grad += hist_grad[b];
+          left_hess += hist_hess[b];
+          double right_grad = sum_grad - left_grad, right_hess = sum_hess - left_hess;
+          if (left_hess < min_child_weight || right_hess < min_child_weight) continue;
+          double gain = left_grad * left_grad / (left_hess + reg_lambda) +
+                        right_grad * right_grad / (right_hess + reg_lambda) - parent_gain;
+          if (gain > splits[f].gain) splits[f] = Split{gain, f, b};
+        }
+      };
+      if (depth < max_depth && node_rows.size() >= 2) {
+        if (static_cast<int64_t>(node_rows.size()) * num_features < kMinParallelWork) {
+          for (int f = 0; f < num_features; ++f) f_find_split(0, f);
+        } else {
+          support::parallel_for_dynamic(0, num_features, num_threads, f_find_split);
+        }
+      }
+      Split best;
+      for (const Split& split : splits) {
+        if (split.gain > best.gain) best = split;
+      }
+      if (best.feature == -1) {
+        float output = -sum_grad / (sum_hess + reg_lambda) * learning_rate;
+        tree.value[node] = output;
+        for (int64_t r : node_rows) {
+          (*row_scores)[r] = output;
+        }
+        continue;
+      }
+      std::vector<int64_t> left_rows, right_rows;
+      const uint8_t* bin = bins.data() + best.feature * num_rows;
+      for (int64_t r : node_rows) {
+        (bin[r] <= best.bin ? left_rows : right_rows).push_back(r);
+      }
+      int left = tree.AddNode();
+      int right = tree.AddNode();
+      tree.feature[node] = best.feature;
+      tree.value[node] = cuts[best.feature][best.bin];
+      tree.left[node] = left;
+      tree.right[node] = right;
+      stack.emplace_back(left, depth + 1, std::move(left_rows));
+      stack.emplace_back(right, depth + 1, std::move(right_rows));
+    }
+    return tree;
+  }
+
+  /*! \brief The length of the feature vectors, or -1 before any data. */
+  int64_t num_features_ = -1;
+  /*! \brief The number of data points collected. */
+  int64_t data_size_ = 0;
+  /*! \brief The number of data points at the last training. */
+  int64_t last_train_size_ = 0;
+  /*! \brief The data points of each workload, keyed by the structural hash of the workload. */
+  std::map<std::string, GBDTFeatureGroup> data_;
+  /*! \brief The trained trees. */
+  std::vector<GBDTTree> trees_;
+};
+
+CostModel CostModel::GBDTCostModel(FeatureExtractor extractor, int num_warmup_samples,
+                                   bool adaptive_training, int num_rounds, int max_depth,
+                                   double learning_rate, double reg_lambda,
+                                   double min_child_weight, int max_bin, int64_t seed) {
+  TVM_FFI_CHECK(num_rounds > 0, ValueError) << "`num_rounds` must be positive";
+  TVM_FFI_CHECK(max_depth > 0, ValueError) << "`max_depth` must be positive";
+  TVM_FFI_CHECK(2 <= max_bin && max_bin <= 255, ValueError) << "`max_bin` must be in [2, 255]";
+  ObjectPtr<GBDTCostModelNode> n = ffi::make_object<GBDTCostModelNode>();
+  n->extractor = std::move(extractor);
+  n->num_warmup_samples = num_warmup_samples;
+  n->adaptive_training = adaptive_training;
+  n->num_rounds = num_rounds;
+  n->max_depth = max_depth;
+  n->learning_rate = learning_rate;
+  n->reg_lambda = reg_lambda;
+  n->min_child_weight = min_child_weight;
+  n->max_bin = max_bin;
+  support::LinearCongruentialEngine(&n->rand_state).Seed(seed);
+  return CostModel(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { GBDTCostModelNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.CostModelGBDTCostModel", CostModel::GBDTCostModel);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
@@ -17,8 +17,16 @@
  * under the License.
  */
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/analysis.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "../module_equality.h"
+#include "../trace_apply.h"
 #include "../utils.h"
 
 namespace tvm {
@@ -220,6 +228,101 @@ ffi::Optional<IRModule> DatabaseNode::QueryIRModule(const IRModule& mod, const T
   }
 }
 
+/*!
+ * \brief The structure of the anchor block of a module, ignoring loop extents and buffer shapes,
+ *  or an empty string if the module has no anchor block.
+ */
+std::string AnchorBlockStructure(const IRModule& mod) {
+  const tir::SBlockNode* block = tir::FindAnchorBlock(mod);
+  if (block == nullptr) {
+    return "";
+  }
+  std::ostringstream os;
+  os << block->name_hint << '|';
+  for (const tir::IterVar& iter : block->iter_vars) {
+    os << static_cast<int>(iter->iter_type);
+  }
+  for (const tir::BufferRegion& region : block->reads) {
+    os << "|r:" << region->buffer->dtype << 'x' << region->region.size();
+  }
+  for (const tir::BufferRegion& region : block->writes) {
+    os << "|w:" << region->buffer->dtype << 'x' << region->region.size();
+  }
+  // The visitor does not enter the shapes of the buffers, only the indices of their accesses
+  auto f_visit = [&os](const ObjectRef& obj) {
+    os << '|' << obj->GetTypeKey();
+    if (const auto* load = obj.as<tir::BufferLoadNode>()) {
+      os << ':' << load->buffer->name;
+    } else if (const auto* store = obj.as<tir::BufferStoreNode>()) {
+      os << ':' << store->buffer->name;
+    } else if (const auto* var = obj.as<tir::VarNode>()) {
+      os << ':' << var->name_hint;
+    } else if (const auto* imm = obj.as<IntImmNode>()) {
+      os << ':' << imm->value;
+    } else if (const auto* imm = obj.as<FloatImmNode>()) {
+      os << ':' << imm->value;
+    }
+  };
+  tir::PostOrderVisit(block->body, f_visit);
+  if (block->init.defined()) {
+    os << "|init";
+    tir::PostOrderVisit(block->init.value(), f_visit);
+  }
+  return os.str();
+}
+
+ffi::Array<TuningRecord> DatabaseNode::QueryFuzzyTuningRecords(const IRModule& mod,
+                                                               const Target& target, int top_k) {
+  ffi::Array<TuningRecord> results;
+  std::string structure = AnchorBlockStructure(mod);
+  if (structure.empty() || top_k <= 0) {
+    return results;
+  }
+  // Step 1. Collect the valid records of the other workloads with the same structure
+  std::unordered_map<const WorkloadNode*, bool> workload_matches;
+  std::vector<TuningRecord> candidates;
+  for (const TuningRecord& record : this->GetAllTuningRecords()) {
+    if (!record->IsValid()) {
+      continue;
+    }
+    if (target.defined() && record->target.defined() &&
+        record->target.value()->kind->name != target->kind->name) {
+      continue;
+    }
+    auto it = workload_matches.find(record->workload.get());
+    if (it == workload_matches.end()) {
+      const IRModule& other = record->workload->mod;
+      bool matches =
+          !this->GetModuleEquality().Equal(other, mod) && AnchorBlockStructure(other) == structure;
+      it = workload_matches.emplace(record->workload.get(), matches).first;
+    }
+    if (it->second) {
+      candidates.push_back(record);
+    }
+  }
+  // Step 2. Adapt the traces of the best records to the given module
+  std::stable_sort(candidates.begin(), candidates.end(), SortTuningRecordByMeanRunSecs());
+  Workload workload(mod);
+  std::unordered_set<const WorkloadNode*> failed_workloads;
+  for (const TuningRecord& record : candidates) {
+    if (static_cast<int>(results.size()) >= top_k) {
+      break;
+    }
+    if (failed_workloads.count(record->workload.get())) {
+      continue;
+    }
+    if (ffi::Optional<s_tir::Trace> trace = AdaptTraceToModule(record->trace, mod)) {
+      results.push_back(TuningRecord(/*trace=*/trace.value(), /*workload=*/workload,
+                                     /*run_secs=*/std::nullopt, /*target=*/record->target,
+                                     /*args_info=*/std::nullopt));
+    } else {
+      // The records of a workload share its loop structure, so they are likely to fail as well
+      failed_workloads.insert(record->workload.get());
+    }
+  }
+  return results;
+}
+
 void DatabaseNode::DumpPruned(Database destination) {
   std::unordered_map<Workload, TuningRecord, ObjectPtrHash, ObjectPtrEqual> workload2record;
   for (const TuningRecord& record : this->GetAllTuningRecords()) {
@@ -323,6 +426,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("s_tir.meta_schedule.DatabaseQueryTuningRecord", &DatabaseNode::QueryTuningRecord)
       .def_method("s_tir.meta_schedule.DatabaseQuerySchedule", &DatabaseNode::QuerySchedule)
       .def_method("s_tir.meta_schedule.DatabaseQueryIRModule", &DatabaseNode::QueryIRModule)
+      .def_method("s_tir.meta_schedule.DatabaseQueryFuzzyTuningRecords",
+                  &DatabaseNode::QueryFuzzyTuningRecords)
       .def_method("s_tir.meta_schedule.DatabaseDumpPruned", &DatabaseNode::DumpPruned)
       .def("s_tir.meta_schedule.DatabasePyDatabase", Database::PyDatabase);
 }
@@ -16,8 +16,11 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../../../support/str_escape.h"
@@ -396,6 +399,223 @@ Any JSONLoads(std::string str) {
   return JSONParser(st, ed).Get();
 }
 
+/*! \brief The tags of the values in the binary encoding of json objects. */
+enum class BinaryJSONTag : uint8_t {
+  kNull = 0,
+  kFalse = 1,
+  kTrue = 2,
+  kInteger = 3,    // followed by a zigzag varint
+  kFloat = 4,      // followed by 8 bytes of the double
+  kString = 5,     // followed by a varint length and the bytes
+  kStringRef = 6,  // followed by a varint index of a previous kString
+  kArray = 7,      // followed by a varint length and the elements
+  kDict = 8,       // followed by a varint length and the key-value pairs
+};
+
+/*!
+ * \brief Encodes json objects in a compact binary form. Repeated strings, e.g. the names of the
+ * instructions and of the attributes in a trace, are written only once and referred to by their
+ * index afterwards.
+ */
+class BinaryJSONWriter {
+ public:
+  explicit BinaryJSONWriter(std::string* os) : os_(os) {}
+
+  void Write(const Any& json_obj) {
+    switch (json_obj.type_index()) {
+      case ffi::TypeIndex::kTVMFFINone:
+        return WriteTag(BinaryJSONTag::kNull);
+      case ffi::TypeIndex::kTVMFFIBool:
+        return WriteTag(json_obj.cast<bool>() ? BinaryJSONTag::kTrue : BinaryJSONTag::kFalse);
+      case ffi::TypeIndex::kTVMFFIInt:
+        return WriteInteger(json_obj.cast<int64_t>());
+      case ffi::TypeIndex::kTVMFFIFloat:
+        return WriteFloat(json_obj.cast<double>());
+      default:
+        break;
+    }
+    if (const auto* int_imm = json_obj.as<IntImmNode>()) {
+      if (int_imm->dtype == DataType::Bool()) {
+        WriteTag(int_imm->value ? BinaryJSONTag::kTrue : BinaryJSONTag::kFalse);
+      } else {
+        WriteInteger(int_imm->value);
+      }
+    } else if (const auto* float_imm = json_obj.as<FloatImmNode>()) {
+      WriteFloat(float_imm->value);
+    } else if (auto opt_str = json_obj.as<ffi::String>()) {
+      WriteString(*opt_str);
+    } else if (const auto* array = json_obj.as<ffi::ArrayObj>()) {
+      WriteTag(BinaryJSONTag::kArray);
+      WriteVarint(array->size());
+      for (const Any& elem : *array) {
+        Write(elem);
+      }
+    } else if (const auto* dict = json_obj.as<ffi::MapObj>()) {
+      WriteTag(BinaryJSONTag::kDict);
+      WriteVarint(dict->size());
+      for (const auto& kv : *dict) {
+        auto key = kv.first.try_cast<ffi::String>();
+        TVM_FFI_CHECK(key.has_value(), TypeError)
+            << "Only string keys are supported in JSON dumps, but got: " << kv.first.GetTypeKey();
+        WriteString(key.value());
+        Write(kv.second);
+      }
+    } else if (json_obj.as<tir::IndexMapNode>()) {
+      WriteString(SaveJSON(json_obj));
+    } else {
+      TVM_FFI_THROW(TypeError) << "Unsupported type in JSON object: " << json_obj.GetTypeKey();
+    }
+  }
+
+ private:
+  void WriteTag(BinaryJSONTag tag) { os_->push_back(static_cast<char>(tag)); }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      os_->push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    os_->push_back(static_cast<char>(value));
+  }
+
+  void WriteInteger(int64_t value) {
+    WriteTag(BinaryJSONTag::kInteger);
+    WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+
+  void WriteFloat(double value) {
+    WriteTag(BinaryJSONTag::kFloat);
+    os_->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void WriteString(const ffi::String& str) {
+    std::string key(str.data(), str.size());
+    auto [it, inserted] = strings_.emplace(std::move(key), strings_.size());
+    if (!inserted) {
+      WriteTag(BinaryJSONTag::kStringRef);
+      WriteVarint(it->second);
+      return;
+    }
+    WriteTag(BinaryJSONTag::kString);
+    WriteVarint(str.size());
+    os_->append(str.data(), str.size());
+  }
+
+  /*! \brief The output buffer */
+  std::string* os_;
+  /*! \brief The strings written so far and their indices */
+  std::unordered_map<std::string, uint64_t> strings_;
+};
+
+/*! \brief Decodes json objects written by BinaryJSONWriter. */
+class BinaryJSONReader {
+ public:
+  explicit BinaryJSONReader(const char* st, const char* ed) : cur_(st), end_(ed) {}
+
+  Any Read() {
+    BinaryJSONTag tag = static_cast<BinaryJSONTag>(ReadByte());
+    switch (tag) {
+      case BinaryJSONTag::kNull:
+        return Any(nullptr);
+      case BinaryJSONTag::kFalse:
+        return Any(false);
+      case BinaryJSONTag::kTrue:
+        return Any(true);
+      case BinaryJSONTag::kInteger: {
+        uint64_t value = ReadVarint();
+        return Any(static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1)));
+      }
+      case BinaryJSONTag::kFloat: {
+        double value;
+        std::memcpy(&value, ReadBytes(sizeof(value)), sizeof(value));
+        return Any(value);
+      }
+      case BinaryJSONTag::kString:
+      case BinaryJSONTag::kStringRef:
+        return ReadString(tag);
+      case BinaryJSONTag::kArray: {
+        uint64_t n = ReadVarint();
+        ffi::Array<Any> results;
+        results.reserve(n);
+        for (uint64_t i = 0; i < n; ++i) {
+          results.push_back(Read());
+        }
+        return results;
+      }
+      case BinaryJSONTag::kDict: {
+        uint64_t n = ReadVarint();
+        ffi::Map<ffi::String, ffi::Any> results;
+        for (uint64_t i = 0; i < n; ++i) {
+          ffi::String key = ReadString(static_cast<BinaryJSONTag>(ReadByte()));
+          results.Set(key, Read());
+        }
+        return results;
+      }
+      default:
+        break;
+    }
+    TVM_FFI_THROW(ValueError) << "Unknown tag in binary JSON: " << static_cast<int>(tag);
+    throw;
+  }
+
+ private:
+  const char* ReadBytes(size_t n) {
+    TVM_FFI_CHECK_LE(n, static_cast<size_t>(end_ - cur_), ValueError)
+        << "Unexpected end of binary JSON";
+    const char* result = cur_;
+    cur_ += n;
+    return result;
+  }
+
+  uint8_t ReadByte() { return static_cast<uint8_t>(*ReadBytes(1)); }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = ReadByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    TVM_FFI_THROW(ValueError) << "Malformed varint in binary JSON";
+    throw;
+  }
+
+  ffi::String ReadString(BinaryJSONTag tag) {
+    if (tag == BinaryJSONTag::kStringRef) {
+      uint64_t index = ReadVarint();
+      TVM_FFI_CHECK_LT(index, strings_.size(), ValueError)
+          << "Invalid string reference in binary JSON";
+      return strings_[index];
+    }
+    TVM_FFI_CHECK(tag == BinaryJSONTag::kString, ValueError)
+        << "Expect a string in binary JSON, but gets tag: " << static_cast<int>(tag);
+    uint64_t n = ReadVarint();
+    const char* data = ReadBytes(n);
+    strings_.push_back(ffi::String(data, n));
+    return strings_.back();
+  }
+
+  /*! \brief The current pointer */
+  const char* cur_;
+  /*! \brief End of the buffer */
+  const char* end_;
+  /*! \brief The strings read so far, indexed by their order of appearance */
+  std::vector<ffi::String> strings_;
+};
+
+std::string BinaryJSONDumps(Any json_obj) {
+  std::string result;
+  BinaryJSONWriter(&result).Write(json_obj);
+  return result;
+}
+
+Any BinaryJSONLoads(const std::string& bytes) {
+  const char* st = bytes.data();
+  return BinaryJSONReader(st, st + bytes.size()).Read();
+}
+
 }  // namespace meta_schedule
 }  // namespace s_tir
 }  // namespace tvm
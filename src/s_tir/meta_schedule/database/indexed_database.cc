@@ -0,0 +1,507 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+/*!
+ * \brief An entry of the index file of an IndexedDatabase. There is one entry per tuning record,
+ * in the order of commit, so that the records can be ranked without being loaded.
+ */
+struct IndexedDatabaseEntry {
+  /*! \brief The index of the workload in the workload file. */
+  uint32_t workload_index;
+  /*! \brief Whether the tuning record is valid, see `TuningRecordNode::IsValid`. */
+  uint32_t is_valid;
+  /*! \brief The offset of the tuning record in the tuning record file. */
+  uint64_t offset;
+  /*! \brief The mean run seconds of the tuning record. */
+  double mean_run_secs;
+};
+
+static_assert(sizeof(IndexedDatabaseEntry) == 24, "IndexedDatabaseEntry must be packed");
+
+/*!
+ * \brief The header of each file of an IndexedDatabase. The offsets and the hash codes stored in
+ * the files are only meaningful for the same module equality, so it is part of the header.
+ * \param mod_eq_name The name of the module equality.
+ * \return The header.
+ */
+inline std::string IndexedDatabaseHeader(const std::string& mod_eq_name) {
+  return "TVMSIDB1 " + mod_eq_name + "\n";
+}
+
+/*!
+ * \brief Check the header of a file of an IndexedDatabase.
+ * \param path The path to the file.
+ * \param header The expected header.
+ * \param allow_missing Whether to create the file when the given path is not found.
+ */
+void IndexedDatabaseCheckFile(const std::string& path, const std::string& header,
+                              bool allow_missing) {
+  if (!std::filesystem::exists(path)) {
+    TVM_FFI_CHECK(allow_missing, ValueError) << "File doesn't exist: " << path;
+    std::ofstream os(path, std::ofstream::binary);
+    TVM_FFI_CHECK(os.good(), ValueError) << "Cannot create new file: " << path;
+    os.write(header.data(), header.size());
+    return;
+  }
+  std::ifstream is(path, std::ifstream::binary);
+  TVM_FFI_CHECK(is.good(), ValueError) << "Cannot open the file to read: " << path;
+  std::string actual(header.size(), '\0');
+  is.read(actual.data(), actual.size());
+  TVM_FFI_CHECK(is.good() && actual == header, ValueError)
+      << "The file is not an IndexedDatabase file using the module equality of header `"
+      << header.substr(0, header.size() - 1) << "`: " << path;
+}
+
+/*!
+ * \brief Read bytes at the given offset of a file.
+ * \param is The input stream of the file.
+ * \param path The path to the file, for error messages.
+ * \param offset The offset to read from.
+ * \param nbytes The number of bytes to read.
+ * \return The bytes read.
+ */
+std::string IndexedDatabaseReadAt(std::ifstream* is, const std::string& path, uint64_t offset,
+                                  uint64_t nbytes) {
+  std::string result(nbytes, '\0');
+  // Reading up to the end of the file sets eofbit, which must be cleared before seeking again.
+  is->clear();
+  is->seekg(offset);
+  is->read(result.data(), nbytes);
+  TVM_FFI_CHECK(is->good(), ValueError)
+      << "Unable to read " << nbytes << " bytes at offset " << offset << " of file " << path;
+  return result;
+}
+
+/*!
+ * \brief An advisory lock on the lock file of an IndexedDatabase, held in its scope. Writers hold
+ *  it exclusively while appending, and readers hold it shared while reading the new entries.
+ */
+class IndexedDatabaseLock {
+ public:
+  IndexedDatabaseLock(int fd, bool exclusive) : fd_(fd) {
+#ifndef _WIN32
+    if (fd_ == -1) return;
+    while (flock(fd_, exclusive ? LOCK_EX : LOCK_SH) != 0) {
+      TVM_FFI_CHECK(errno == EINTR, ValueError) << "Cannot lock the database: " << strerror(errno);
+    }
+#endif
+  }
+
+  ~IndexedDatabaseLock() {
+#ifndef _WIN32
+    if (fd_ != -1) {
+      flock(fd_, LOCK_UN);
+    }
+#endif
+  }
+
+ private:
+  int fd_;
+};
+
+/*!
+ * \brief A database that keeps an append-only index of its tuning records on disk. Opening it
+ *  only reads the index, while the workloads and the tuning records are loaded on demand.
+ *
+ * The database consists of three append-only files in a directory:
+ * - `workload.bin`: per workload, its hash code, the size of its module and the module in the
+ *   format of `SaveJSON`.
+ * - `tuning_record.bin`: per tuning record, its size and its JSON form, see
+ *   `TuningRecordNode::AsJSON`, encoded by `BinaryJSONDumps`.
+ * - `index.bin`: per tuning record, an IndexedDatabaseEntry.
+ * The files are written in the native byte order. A tuning record is written before its entry in
+ * the index, so that an interrupted commit is never visible.
+ *
+ * Multiple processes may share the database: commits are serialized by an advisory lock on the
+ * file `lock`, and each query first reads the entries appended by other processes, so the results
+ * of concurrent tuning jobs are visible without reopening the database. Locking is not supported
+ * on Windows, where only one process may write to the database at a time.
+ */
+class IndexedDatabaseNode : public DatabaseNode {
+ public:
+  explicit IndexedDatabaseNode(ffi::String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name) {}
+
+  /*! \brief A tuning record in the index, loaded from the tuning record file on demand. */
+  struct RecordEntry {
+    /*! \brief The entry of the tuning record in the index file. */
+    IndexedDatabaseEntry index;
+    /*! \brief The tuning record, if loaded. */
+    ffi::Optional<TuningRecord> record;
+  };
+
+  /*! \brief A workload in the workload file, loaded on demand. */
+  struct WorkloadEntry {
+    /*! \brief The hash code of the workload. */
+    Workload::THashCode shash;
+    /*! \brief The offset of the serialized module in the workload file. */
+    uint64_t offset;
+    /*! \brief The size of the serialized module. */
+    uint64_t nbytes;
+    /*! \brief The workload, if loaded. */
+    ffi::Optional<Workload> workload;
+    /*! \brief The tuning records of the workload, sorted by mean run seconds then commit order. */
+    std::vector<RecordEntry> records;
+  };
+
+  /*! \brief The path to the directory of the database */
+  ffi::String path;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<IndexedDatabaseNode>().def_ro("path", &IndexedDatabaseNode::path);
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.IndexedDatabase", IndexedDatabaseNode,
+                                    DatabaseNode);
+
+  ~IndexedDatabaseNode() {
+#ifndef _WIN32
+    if (lock_fd_ != -1) {
+      close(lock_fd_);
+    }
+#endif
+  }
+
+  /*!
+   * \brief Open the files of the database and read its index.
+   * \param allow_missing Whether to create the database when the given path is not found.
+   * \param mod_eq_name The name of the module equality, recorded in the files.
+   */
+  void Open(bool allow_missing, const std::string& mod_eq_name) {
+    if (allow_missing) {
+      std::filesystem::create_directories(path.c_str());
+    }
+    path_workload_ = path + "/workload.bin";
+    path_tuning_record_ = path + "/tuning_record.bin";
+    path_index_ = path + "/index.bin";
+#ifndef _WIN32
+    std::string path_lock = path + "/lock";
+    lock_fd_ = open(path_lock.c_str(), O_RDWR | O_CREAT, 0644);
+    TVM_FFI_CHECK(lock_fd_ != -1, ValueError)
+        << "Cannot open the lock file: " << path_lock << ", " << strerror(errno);
+#endif
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/true);
+    std::string header = IndexedDatabaseHeader(mod_eq_name);
+    IndexedDatabaseCheckFile(path_workload_, header, allow_missing);
+    IndexedDatabaseCheckFile(path_index_, header, allow_missing);
+    IndexedDatabaseCheckFile(path_tuning_record_, header, allow_missing);
+    // Everything after the headers is read by the first refresh
+    workload_end_ = index_end_ = header.size();
+    workload_reader_.open(path_workload_, std::ifstream::binary);
+    record_reader_.open(path_tuning_record_, std::ifstream::binary);
+    index_reader_.open(path_index_, std::ifstream::binary);
+    workload_writer_.open(path_workload_, std::ofstream::binary | std::ofstream::app);
+    record_writer_.open(path_tuning_record_, std::ofstream::binary | std::ofstream::app);
+    index_writer_.open(path_index_, std::ofstream::binary | std::ofstream::app);
+    TVM_FFI_CHECK(workload_writer_.good() && record_writer_.good() && index_writer_.good(),
+                  ValueError)
+        << "Cannot open the files of the database to write: " << path;
+    RefreshForWrite();
+  }
+
+ public:
+  bool HasWorkload(const IRModule& mod) {
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/false);
+    Refresh();
+    return FindWorkload(mod, GetModuleEquality().Hash(mod)) != -1;
+  }
+
+  Workload CommitWorkload(const IRModule& mod) {
+    Workload::THashCode shash = GetModuleEquality().Hash(mod);
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/true);
+    RefreshForWrite();
+    int workload_index = FindWorkload(mod, shash);
+    if (workload_index != -1) {
+      return LoadWorkload(workload_index);
+    }
+    TVM_FFI_ICHECK_LT(workloads_.size(), std::numeric_limits<uint32_t>::max());
+    std::string json_mod = SaveJSON(mod);
+    uint64_t meta[2] = {shash, json_mod.size()};
+    workload_writer_.write(reinterpret_cast<const char*>(meta), sizeof(meta));
+    workload_writer_.write(json_mod.data(), json_mod.size());
+    workload_writer_.flush();
+    TVM_FFI_CHECK(workload_writer_.good(), ValueError)
+        << "Cannot write to the file: " << path_workload_;
+    Workload workload(mod, shash);
+    shash2idx_.emplace(shash, static_cast<int>(workloads_.size()));
+    workloads_.push_back(
+        WorkloadEntry{shash, workload_end_ + sizeof(meta), json_mod.size(), workload, {}});
+    workload_end_ += sizeof(meta) + json_mod.size();
+    return workload;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) {
+    std::string bytes = BinaryJSONDumps(record->AsJSON());
+    uint64_t nbytes = bytes.size();
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/true);
+    RefreshForWrite();
+    int workload_index = FindWorkload(record->workload);
+    TVM_FFI_CHECK(workload_index != -1, ValueError)
+        << "The workload of the tuning record is not committed to the database";
+    IndexedDatabaseEntry index;
+    index.workload_index = workload_index;
+    index.is_valid = record->IsValid();
+    index.offset = std::filesystem::file_size(path_tuning_record_);
+    index.mean_run_secs = SortTuningRecordByMeanRunSecs::Mean(record->run_secs.value_or({}));
+    record_writer_.write(reinterpret_cast<const char*>(&nbytes), sizeof(nbytes));
+    record_writer_.write(bytes.data(), nbytes);
+    record_writer_.flush();
+    TVM_FFI_CHECK(record_writer_.good(), ValueError)
+        << "Cannot write to the file: " << path_tuning_record_;
+    index_writer_.write(reinterpret_cast<const char*>(&index), sizeof(index));
+    index_writer_.flush();
+    TVM_FFI_CHECK(index_writer_.good(), ValueError) << "Cannot write to the file: " << path_index_;
+    index_end_ += sizeof(index);
+    ++num_records_;
+    std::vector<RecordEntry>& records = workloads_[workload_index].records;
+    auto it = std::upper_bound(records.begin(), records.end(), index.mean_run_secs,
+                               [](double mean_run_secs, const RecordEntry& entry) {
+                                 return mean_run_secs < entry.index.mean_run_secs;
+                               });
+    records.insert(it, RecordEntry{index, record});
+  }
+
+  ffi::Array<TuningRecord> GetTopK(const Workload& workload, int top_k) {
+    TVM_FFI_CHECK_GE(top_k, 0, ValueError) << "top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/false);
+    Refresh();
+    int workload_index = FindWorkload(workload);
+    if (workload_index == -1) {
+      return {};
+    }
+    ffi::Array<TuningRecord> results;
+    results.reserve(top_k);
+    for (RecordEntry& entry : workloads_[workload_index].records) {
+      if (!entry.index.is_valid) {
+        continue;
+      }
+      results.push_back(LoadRecord(&entry));
+      if (results.size() == static_cast<size_t>(top_k)) {
+        break;
+      }
+    }
+    return results;
+  }
+
+  ffi::Array<TuningRecord> GetAllTuningRecords() {
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/false);
+    Refresh();
+    std::vector<RecordEntry*> entries;
+    entries.reserve(num_records_);
+    for (WorkloadEntry& workload : workloads_) {
+      for (RecordEntry& entry : workload.records) {
+        entries.push_back(&entry);
+      }
+    }
+    // Records are appended to the file in the order of commit
+    std::sort(entries.begin(), entries.end(), [](const RecordEntry* a, const RecordEntry* b) {
+      return std::make_pair(a->index.mean_run_secs, a->index.offset) <
+             std::make_pair(b->index.mean_run_secs, b->index.offset);
+    });
+    ffi::Array<TuningRecord> results;
+    results.reserve(entries.size());
+    for (RecordEntry* entry : entries) {
+      results.push_back(LoadRecord(entry));
+    }
+    return results;
+  }
+
+  int64_t Size() {
+    IndexedDatabaseLock lock(lock_fd_, /*exclusive=*/false);
+    Refresh();
+    return num_records_;
+  }
+
+ private:
+  /*!
+   * \brief Read the workloads and the index entries appended since the last refresh, by this or
+   *  by other processes. Must be called with the lock held.
+   */
+  void Refresh() {
+    // Only the hash codes and the sizes of the workloads are read.
+    uint64_t workload_size = std::filesystem::file_size(path_workload_);
+    for (uint64_t meta[2]; workload_end_ + sizeof(meta) <= workload_size;) {
+      std::string bytes =
+          IndexedDatabaseReadAt(&workload_reader_, path_workload_, workload_end_, sizeof(meta));
+      std::memcpy(meta, bytes.data(), sizeof(meta));
+      if (workload_end_ + sizeof(meta) + meta[1] > workload_size) {
+        break;
+      }
+      shash2idx_.emplace(meta[0], static_cast<int>(workloads_.size()));
+      workloads_.push_back(WorkloadEntry{meta[0], workload_end_ + sizeof(meta), meta[1], {}, {}});
+      workload_end_ += sizeof(meta) + meta[1];
+    }
+    uint64_t index_size = std::filesystem::file_size(path_index_);
+    uint64_t n = (index_size - index_end_) / sizeof(IndexedDatabaseEntry);
+    if (n == 0) {
+      return;
+    }
+    std::vector<IndexedDatabaseEntry> entries(n);
+    std::string bytes =
+        IndexedDatabaseReadAt(&index_reader_, path_index_, index_end_, n * sizeof(entries[0]));
+    std::memcpy(entries.data(), bytes.data(), bytes.size());
+    // The new entries of each workload are sorted, then merged with the sorted existing ones.
+    std::unordered_map<uint32_t, size_t> num_existing;
+    for (const IndexedDatabaseEntry& entry : entries) {
+      TVM_FFI_CHECK_LT(entry.workload_index, workloads_.size(), ValueError)
+          << "The index refers to a workload that does not exist: " << path_index_;
+      std::vector<RecordEntry>& records = workloads_[entry.workload_index].records;
+      num_existing.emplace(entry.workload_index, records.size());
+      records.push_back(RecordEntry{entry, std::nullopt});
+    }
+    auto by_mean_run_secs = [](const RecordEntry& a, const RecordEntry& b) {
+      return a.index.mean_run_secs < b.index.mean_run_secs;
+    };
+    for (const auto& [workload_index, num] : num_existing) {
+      std::vector<RecordEntry>& records = workloads_[workload_index].records;
+      std::stable_sort(records.begin() + num, records.end(), by_mean_run_secs);
+      std::inplace_merge(records.begin(), records.begin() + num, records.end(), by_mean_run_secs);
+    }
+    index_end_ += n * sizeof(IndexedDatabaseEntry);
+    num_records_ += n;
+  }
+
+  /*!
+   * \brief Refresh, then drop the partial entries left by a process that was interrupted while
+   *  committing, so that new entries can be appended. Must be called with the exclusive lock held.
+   */
+  void RefreshForWrite() {
+    Refresh();
+    if (std::filesystem::file_size(path_workload_) != workload_end_) {
+      std::filesystem::resize_file(path_workload_, workload_end_);
+    }
+    if (std::filesystem::file_size(path_index_) != index_end_) {
+      std::filesystem::resize_file(path_index_, index_end_);
+    }
+  }
+
+  /*! \brief Load the workload of the given index from the workload file if not loaded yet. */
+  Workload LoadWorkload(int workload_index) {
+    WorkloadEntry& entry = workloads_[workload_index];
+    if (!entry.workload.defined()) {
+      std::string json_mod =
+          IndexedDatabaseReadAt(&workload_reader_, path_workload_, entry.offset, entry.nbytes);
+      entry.workload = Workload(LoadJSON(json_mod).cast<IRModule>(), entry.shash);
+    }
+    return entry.workload.value();
+  }
+
+  /*! \brief Load the given tuning record from the tuning record file if not loaded yet. */
+  TuningRecord LoadRecord(RecordEntry* entry) {
+    if (!entry->record.defined()) {
+      uint64_t nbytes;
+      std::string size = IndexedDatabaseReadAt(&record_reader_, path_tuning_record_,
+                                               entry->index.offset, sizeof(nbytes));
+      std::memcpy(&nbytes, size.data(), sizeof(nbytes));
+      std::string bytes = IndexedDatabaseReadAt(&record_reader_, path_tuning_record_,
+                                                entry->index.offset + sizeof(nbytes), nbytes);
+      Workload workload = LoadWorkload(entry->index.workload_index);
+      entry->record = TuningRecord::FromJSON(BinaryJSONLoads(bytes).cast<ObjectRef>(), workload);
+    }
+    return entry->record.value();
+  }
+
+  /*!
+   * \brief Find the workload equal to the given module, loading the workloads of the same hash.
+   * \return The index of the workload, or -1 if not found.
+   */
+  int FindWorkload(const IRModule& mod, Workload::THashCode shash) {
+    auto range = shash2idx_.equal_range(shash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (GetModuleEquality().Equal(LoadWorkload(it->second)->mod, mod)) {
+        return it->second;
+      }
+    }
+    return -1;
+  }
+
+  /*! \brief Find the given workload, which is usually returned by `CommitWorkload`. */
+  int FindWorkload(const Workload& workload) {
+    auto range = shash2idx_.equal_range(workload->shash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (workloads_[it->second].workload.same_as(workload)) {
+        return it->second;
+      }
+    }
+    return FindWorkload(workload->mod, workload->shash);
+  }
+
+  /*! \brief The paths to the files of the database */
+  std::string path_workload_, path_tuning_record_, path_index_;
+  /*! \brief All the workloads in the database, in the order of the workload file */
+  std::vector<WorkloadEntry> workloads_;
+  /*! \brief The indices of the workloads, by their hash codes */
+  std::unordered_multimap<Workload::THashCode, int> shash2idx_;
+  /*! \brief The number of tuning records in the database */
+  int64_t num_records_ = 0;
+  /*! \brief The sizes of the workload file and the index file read so far */
+  uint64_t workload_end_ = 0, index_end_ = 0;
+  /*! \brief The file descriptor of the lock file, or -1 if locking is not supported */
+  int lock_fd_ = -1;
+  /*! \brief The streams to read the files */
+  std::ifstream workload_reader_, record_reader_, index_reader_;
+  /*! \brief The streams to append to the files */
+  std::ofstream workload_writer_, record_writer_, index_writer_;
+};
+
+Database Database::IndexedDatabase(ffi::String path, bool allow_missing, ffi::String mod_eq_name) {
+  ObjectPtr<IndexedDatabaseNode> n = ffi::make_object<IndexedDatabaseNode>(mod_eq_name);
+  n->path = path;
+  n->Open(allow_missing, mod_eq_name);
+  return Database(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { IndexedDatabaseNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.DatabaseIndexedDatabase", Database::IndexedDatabase);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
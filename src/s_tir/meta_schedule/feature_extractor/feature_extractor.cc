@@ -18,12 +18,58 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include <algorithm>
+
 #include "../utils.h"
 
 namespace tvm {
 namespace s_tir {
 namespace meta_schedule {
 
+ffi::Array<tvm::runtime::Tensor> FeatureExtractorNode::ExtractBatch(
+    const TuneContext& context, const ffi::Array<MeasureCandidate>& candidates) {
+  ffi::Array<tvm::runtime::Tensor> features = this->ExtractFrom(context, candidates);
+  TVM_FFI_ICHECK_EQ(features.size(), candidates.size());
+  int n = features.size();
+  int64_t num_cols = -1;
+  runtime::Tensor row_offsets = runtime::Tensor::Empty(
+      /*shape=*/{n + 1}, /*dtype=*/DLDataType{kDLInt, 64, 1}, /*ctx=*/DLDevice{kDLCPU, 0});
+  int64_t* offsets = static_cast<int64_t*>(row_offsets->data);
+  offsets[0] = 0;
+  for (int i = 0; i < n; ++i) {
+    const runtime::Tensor& feature = features[i];
+    TVM_FFI_CHECK_EQ(feature->ndim, 2, ValueError)
+        << "The features of a candidate must be a 2-dimensional tensor";
+    TVM_FFI_CHECK(feature.DataType() == DataType::Float(32) ||
+                      feature.DataType() == DataType::Float(64),
+                  ValueError)
+        << "The features of a candidate must be float32 or float64, but gets: "
+        << feature.DataType();
+    TVM_FFI_CHECK(num_cols == -1 || feature->shape[1] == num_cols, ValueError)
+        << "The features of all candidates must have the same length";
+    num_cols = feature->shape[1];
+    offsets[i + 1] = offsets[i] + feature->shape[0];
+  }
+  runtime::Tensor result = runtime::Tensor::Empty(
+      /*shape=*/{offsets[n], std::max<int64_t>(num_cols, 0)},
+      /*dtype=*/DLDataType{kDLFloat, 32, 1}, /*ctx=*/DLDevice{kDLCPU, 0});
+  float* data = static_cast<float*>(result->data);
+  for (const runtime::Tensor& feature : features) {
+    runtime::Tensor cpu_feature = feature;
+    if (feature->device.device_type != kDLCPU || !ffi::IsContiguous(*feature.operator->())) {
+      cpu_feature = feature.CopyTo(DLDevice{kDLCPU, 0});
+    }
+    const char* src = static_cast<const char*>(cpu_feature->data) + cpu_feature->byte_offset;
+    int64_t size = cpu_feature->shape[0] * cpu_feature->shape[1];
+    if (cpu_feature.DataType() == DataType::Float(32)) {
+      data = std::copy_n(reinterpret_cast<const float*>(src), size, data);
+    } else {
+      data = std::copy_n(reinterpret_cast<const double*>(src), size, data);
+    }
+  }
+  return {result, row_offsets};
+}
+
 ffi::Array<tvm::runtime::Tensor> PyFeatureExtractorNode::ExtractFrom(
     const TuneContext& context, const ffi::Array<MeasureCandidate>& candidates) {
   TVM_FFI_ICHECK(f_extract_from != nullptr)
@@ -60,6 +106,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef()
       .def_method("s_tir.meta_schedule.FeatureExtractorExtractFrom",
                   &FeatureExtractorNode::ExtractFrom)
+      .def_method("s_tir.meta_schedule.FeatureExtractorExtractBatch",
+                  &FeatureExtractorNode::ExtractBatch)
       .def("s_tir.meta_schedule.FeatureExtractorPyFeatureExtractor",
            FeatureExtractor::PyFeatureExtractor);
 }
@@ -20,6 +20,8 @@
 #include <tvm/s_tir/transform.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 #include <numeric>
@@ -1383,22 +1385,33 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
         .def_ro("feature_vector_length", &PerStoreFeatureNode::feature_vector_length);
   }
 
-  void ExtractSingle(IRModule mod, bool is_gpu, std::vector<std::vector<double>>* results) {
+  /*!
+   * \brief Extract the features of a module, one row per store.
+   * \param mod The module to extract features from.
+   * \param is_gpu Whether the target is a GPU.
+   * \param feature_group6 The workload features appended to each row, or nullptr if not extracted.
+   * \param row The buffer reused to export each row.
+   * \param f_row The callback receiving each row.
+   */
+  template <typename FRow>
+  void ExtractRows(IRModule mod, bool is_gpu, const s_tir::group6::Feature* feature_group6,
+                   std::vector<double>* row, FRow f_row) {
     static tvm::transform::Sequential passes = s_tir::transform::PassListForPerStoreFeature();
     mod = passes(std::move(mod));
     std::vector<s_tir::Feature> features = s_tir::PerStoreFeatureCollector::Collect(
         is_gpu, this->cache_line_bytes, this->arith_intensity_curve_num_samples, mod);
-    int n_features = features.size();
-    results->resize(n_features);
-    for (int i = 0; i < n_features; ++i) {
-      const s_tir::Feature& feature = features[i];
-      std::vector<double>& result = (*results)[i];
-      result.reserve(feature_vector_length);
-      feature.group1->Export(&result);
-      feature.group2->Export(&result, this->buffers_per_store);
-      feature.group3->Export(&result);
-      feature.group4->Export(&result, feature.group5->outer_prod);
-      feature.group5->Export(&result);
+    for (const s_tir::Feature& feature : features) {
+      row->clear();
+      row->reserve(feature_vector_length);
+      feature.group1->Export(row);
+      feature.group2->Export(row, this->buffers_per_store);
+      feature.group3->Export(row);
+      feature.group4->Export(row, feature.group5->outer_prod);
+      feature.group5->Export(row);
+      if (feature_group6 != nullptr) {
+        feature_group6->Export(row);
+      }
+      f_row(*row);
     }
   }
 
@@ -1415,17 +1428,63 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
     auto f = [this, is_gpu, &feature_group6, &candidates, &results](int, int task_id) -> void {
       const auto& candidate = candidates[task_id];
       std::vector<std::vector<double>> features;
-      ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
-      if (extract_workload) {
-        for (auto& feature : features) {
-          feature_group6->Export(&feature);
-        }
-      }
+      std::vector<double> row;
+      ExtractRows(DeepCopyIRModule(candidate->sch->mod()), is_gpu, feature_group6.get(), &row,
+                  [&features](const std::vector<double>& row) { features.push_back(row); });
       results[task_id] = s_tir::utils::AsTensor(features, this->feature_vector_length);
     };
     support::parallel_for_dynamic(0, candidates.size(), tune_context->num_threads, f);
     return results;
   }
+
+  ffi::Array<runtime::Tensor> ExtractBatch(const TuneContext& tune_context,
+                                           const ffi::Array<MeasureCandidate>& candidates) final {
+    auto& target_keys = tune_context->target.value()->keys;
+    bool is_gpu = std::find(target_keys.begin(), target_keys.end(), "gpu") != target_keys.end();
+    std::unique_ptr<s_tir::group6::Feature> feature_group6 = nullptr;
+    if (extract_workload) {
+      feature_group6 = std::make_unique<s_tir::group6::Feature>(tune_context->mod.value());
+    }
+    int n = candidates.size();
+    int num_threads = std::max(1, std::min(tune_context->num_threads, n));
+    // Each thread appends the rows of its candidates to its own arena, so the only allocations
+    // are the growth of the arenas, which are then copied once into the contiguous matrix.
+    struct ThreadArena {
+      std::vector<float> data;
+      std::vector<double> row;
+    };
+    std::vector<ThreadArena> arenas(num_threads);
+    // Per candidate, the thread that extracted it, and its offset and rows in the arena
+    std::vector<std::array<int64_t, 3>> spans(n);
+    auto f = [&](int thread_id, int task_id) -> void {
+      ThreadArena& arena = arenas[thread_id];
+      int64_t offset = arena.data.size();
+      ExtractRows(DeepCopyIRModule(candidates[task_id]->sch->mod()), is_gpu, feature_group6.get(),
+                  &arena.row, [&arena](const std::vector<double>& row) {
+                    arena.data.insert(arena.data.end(), row.begin(), row.end());
+                  });
+      int64_t num_rows = (arena.data.size() - offset) / feature_vector_length;
+      spans[task_id] = {thread_id, offset, num_rows};
+    };
+    support::parallel_for_dynamic(0, n, num_threads, f);
+    runtime::Tensor row_offsets = runtime::Tensor::Empty(
+        /*shape=*/{n + 1}, /*dtype=*/DLDataType{kDLInt, 64, 1}, /*ctx=*/DLDevice{kDLCPU, 0});
+    int64_t* offsets = static_cast<int64_t*>(row_offsets->data);
+    offsets[0] = 0;
+    for (int i = 0; i < n; ++i) {
+      offsets[i + 1] = offsets[i] + spans[i][2];
+    }
+    runtime::Tensor features = runtime::Tensor::Empty(
+        /*shape=*/{offsets[n], feature_vector_length}, /*dtype=*/DLDataType{kDLFloat, 32, 1},
+        /*ctx=*/DLDevice{kDLCPU, 0});
+    float* data = static_cast<float*>(features->data);
+    for (int i = 0; i < n; ++i) {
+      const auto& [thread_id, offset, num_rows] = spans[i];
+      std::copy_n(arenas[thread_id].data.data() + offset, num_rows * feature_vector_length,
+                  data + offsets[i] * feature_vector_length);
+    }
+    return {features, row_offsets};
+  }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.PerStoreFeature", PerStoreFeatureNode,
                                     FeatureExtractorNode);
 };
@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+/*! \brief The ranks of the values, from 0 for the smallest one, ties broken by position. */
+static std::vector<double> Ranks(const std::vector<double>& values) {
+  int n = values.size();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&values](int a, int b) { return values[a] < values[b]; });
+  std::vector<double> ranks(n);
+  for (int i = 0; i < n; ++i) {
+    ranks[order[i]] = i;
+  }
+  return ranks;
+}
+
+/*! \brief The Spearman rank correlation of two sequences of the same length. */
+static double RankCorrelation(const std::vector<double>& a, const std::vector<double>& b) {
+  TVM_FFI_ICHECK_EQ(a.size(), b.size());
+  int n = a.size();
+  std::vector<double> ra = Ranks(a);
+  std::vector<double> rb = Ranks(b);
+  double mean = (n - 1) * 0.5;
+  double cov = 0.0, var_a = 0.0, var_b = 0.0;
+  for (int i = 0; i < n; ++i) {
+    cov += (ra[i] - mean) * (rb[i] - mean);
+    var_a += (ra[i] - mean) * (ra[i] - mean);
+    var_b += (rb[i] - mean) * (rb[i] - mean);
+  }
+  if (var_a * var_b == 0.0) {
+    return 0.0;
+  }
+  return cov / std::sqrt(var_a * var_b);
+}
+
+class LogMetricsNode : public MeasureCallbackNode {
+ public:
+  /*! \brief The JSON-lines file to append the metrics to. */
+  ffi::String path;
+  /*! \brief The number of rounds logged for each task. */
+  std::unordered_map<int, int> num_rounds_;
+  /*! \brief The time the callback was created. */
+  std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+  void Apply(const TaskScheduler& task_scheduler, int task_id,
+             const ffi::Array<MeasureCandidate>& measure_candidates,
+             const ffi::Array<BuilderResult>& builder_results,
+             const ffi::Array<RunnerResult>& runner_results) final {
+    auto _ = Profiler::TimedScope("MeasureCallback/LogMetrics");
+    const TaskRecord& task = task_scheduler->tasks_[task_id];
+    TVM_FFI_ICHECK_EQ(measure_candidates.size(), builder_results.size());
+    TVM_FFI_ICHECK_EQ(runner_results.size(), builder_results.size());
+    int n = builder_results.size();
+    int num_build_failed = 0;
+    int num_run_failed = 0;
+    ffi::Array<MeasureCandidate> measured;
+    std::vector<double> throughputs;
+    double round_best_ms = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < n; ++i) {
+      if (builder_results[i]->error_msg.has_value()) {
+        ++num_build_failed;
+      } else if (runner_results[i]->error_msg.has_value() ||
+                 !runner_results[i]->run_secs.defined()) {
+        ++num_run_failed;
+      } else {
+        double run_ms = GetRunMsMedian(runner_results[i]);
+        measured.push_back(measure_candidates[i]);
+        throughputs.push_back(1.0 / std::max(run_ms, 1e-12));
+        round_best_ms = std::min(round_best_ms, run_ms);
+      }
+    }
+    // The latencies of this round are recorded after all the callbacks ran
+    double best_ms = round_best_ms;
+    for (double ms : task->latency_ms) {
+      best_ms = std::min(best_ms, ms);
+    }
+    double elapsed_sec =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+
+    ffi::Map<ffi::String, ffi::Any> metrics{
+        {"task_id", Integer(task_id)},
+        {"task_name", task->ctx->task_name.value_or("")},
+        {"round", Integer(num_rounds_[task_id]++)},
+        {"elapsed_sec", FloatImm(DataType::Float(64), elapsed_sec)},
+        {"num_candidates", Integer(n)},
+        {"num_build_failed", Integer(num_build_failed)},
+        {"num_run_failed", Integer(num_run_failed)},
+        {"num_measured", Integer(static_cast<int>(measured.size()))},
+    };
+    if (!measured.empty()) {
+      metrics.Set("round_best_ms", FloatImm(DataType::Float(64), round_best_ms));
+    }
+    // Failed trials are recorded with a huge latency
+    if (best_ms < 1e9) {
+      metrics.Set("best_ms", FloatImm(DataType::Float(64), best_ms));
+    }
+    ffi::Map<ffi::String, ffi::Any> search;
+    for (const auto& kv : task->ctx->search_strategy.value()->GetStats()) {
+      search.Set(kv.first, Integer(kv.second));
+    }
+    if (!search.empty()) {
+      metrics.Set("search", search);
+    }
+    // The cost model is expected to not have seen this round yet, see `LogMetrics`
+    if (task_scheduler->cost_model_.defined() && measured.size() >= 2) {
+      std::vector<double> scores =
+          task_scheduler->cost_model_.value()->Predict(task->ctx, measured);
+      metrics.Set("cost_model_rank_corr",
+                  FloatImm(DataType::Float(64), RankCorrelation(scores, throughputs)));
+    }
+    JSONFileAppendLine(path, JSONDumps(metrics));
+  }
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<LogMetricsNode>().def_ro("path", &LogMetricsNode::path);
+  }
+
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.LogMetrics", LogMetricsNode,
+                                    MeasureCallbackNode);
+};
+
+MeasureCallback MeasureCallback::LogMetrics(ffi::String path) {
+  ObjectPtr<LogMetricsNode> n = ffi::make_object<LogMetricsNode>();
+  n->path = std::move(path);
+  return MeasureCallback(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  LogMetricsNode::RegisterReflection();
+  refl::GlobalDef().def("s_tir.meta_schedule.MeasureCallbackLogMetrics",
+                        MeasureCallback::LogMetrics);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
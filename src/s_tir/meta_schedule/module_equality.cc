@@ -25,28 +25,34 @@
 
 #include <memory>
 
+#include "../../support/structural_hash_cache.h"
+
 namespace tvm {
 namespace s_tir {
 namespace meta_schedule {
 
+// The equalities memoize the hashes of the modules, since the databases and the search
+// strategies hash and compare the same modules many times. The hashes are unchanged, so that
+// they match the ones stored in the existing databases.
 class ModuleEqualityStructural : public ModuleEquality {
  public:
-  size_t Hash(IRModule mod) const { return ffi::StructuralHash()(mod); }
-  bool Equal(IRModule lhs, IRModule rhs) const { return ffi::StructuralEqual()(lhs, rhs); }
+  size_t Hash(IRModule mod) const { return cache_.Hash(mod); }
+  bool Equal(IRModule lhs, IRModule rhs) const { return cache_.Equal(lhs, rhs); }
   ffi::String GetName() const { return "structural"; }
+
+ private:
+  mutable support::StructuralHashCache cache_;
 };
 
 class ModuleEqualityIgnoreTensor : public ModuleEquality {
  public:
-  size_t Hash(IRModule mod) const {
-    return tvm::ffi::StructuralHash::Hash(mod, /*map_free_vars=*/false,
-                                          /*skip_tensor_content=*/true);
-  }
-  bool Equal(IRModule lhs, IRModule rhs) const {
-    return tvm::ffi::StructuralEqual::Equal(lhs, rhs, /*map_free_vars=*/false,
-                                            /*skip_tensor_content=*/true);
-  }
+  size_t Hash(IRModule mod) const { return cache_.Hash(mod); }
+  bool Equal(IRModule lhs, IRModule rhs) const { return cache_.Equal(lhs, rhs); }
   ffi::String GetName() const { return "ignore-tensor"; }
+
+ private:
+  mutable support::StructuralHashCache cache_{/*map_free_vars=*/false,
+                                              /*skip_tensor_content=*/true};
 };
 
 // The Tensor-ignoring variant of structural equal / hash is used for the module equality
@@ -55,24 +61,25 @@ class ModuleEqualityAnchorBlock : public ModuleEquality {
   size_t Hash(IRModule mod) const {
     auto anchor_block = tir::FindAnchorBlock(mod);
     if (anchor_block) {
-      return ffi::StructuralHash::Hash(ffi::GetRef<tir::SBlock>(anchor_block),
-                                       /*map_free_vars=*/false,
-                                       /*skip_tensor_content=*/true);
+      return block_cache_.Hash(ffi::GetRef<tir::SBlock>(anchor_block));
     }
-    return ModuleEqualityIgnoreTensor().Hash(mod);
+    return ignore_tensor_.Hash(mod);
   }
   bool Equal(IRModule lhs, IRModule rhs) const {
     auto anchor_block_lhs = tir::FindAnchorBlock(lhs);
     auto anchor_block_rhs = tir::FindAnchorBlock(rhs);
     if (anchor_block_lhs && anchor_block_rhs) {
-      return tvm::ffi::StructuralEqual::Equal(ffi::GetRef<tir::SBlock>(anchor_block_lhs),
-                                              ffi::GetRef<tir::SBlock>(anchor_block_rhs),
-                                              /*map_free_vars=*/false,
-                                              /*skip_tensor_content=*/true);
+      return block_cache_.Equal(ffi::GetRef<tir::SBlock>(anchor_block_lhs),
+                                ffi::GetRef<tir::SBlock>(anchor_block_rhs));
     }
-    return ModuleEqualityIgnoreTensor().Equal(lhs, rhs);
+    return ignore_tensor_.Equal(lhs, rhs);
   }
   ffi::String GetName() const { return "anchor-block"; }
+
+ private:
+  mutable support::StructuralHashCache block_cache_{/*map_free_vars=*/false,
+                                                    /*skip_tensor_content=*/true};
+  ModuleEqualityIgnoreTensor ignore_tensor_;
 };
 
 std::unique_ptr<ModuleEquality> ModuleEquality::Create(const std::string& mod_eq_name) {
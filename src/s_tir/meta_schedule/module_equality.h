@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 namespace tvm {
 namespace s_tir {
@@ -75,6 +76,39 @@ class ModuleEqual {
   const ModuleEquality& mod_eq_;
 };
 
+/*! \brief An auxiliary data structure to help deduplicate IRModules */
+class IRModuleSet {
+ public:
+  explicit IRModuleSet(const ModuleEquality& mod_eq)
+      : tab_(/*bucket_count*/ 0, ItemHash(), ItemEqual(mod_eq)) {}
+
+  /*! \brief Add an IRModule to the set */
+  void Add(const IRModule& mod, size_t shash) { tab_.insert(Item{mod, shash}); }
+  /*! \brief Check if the IRModule is in the set */
+  bool Has(const IRModule& mod, size_t shash) const { return tab_.count(Item{mod, shash}); }
+
+ private:
+  struct Item {
+    IRModule mod;
+    size_t shash;
+  };
+  struct ItemHash {
+    size_t operator()(const Item& hash) const { return hash.shash; }
+  };
+  struct ItemEqual {
+    explicit ItemEqual(const ModuleEquality& mod_eq) : mod_eq_(mod_eq) {}
+    ItemEqual& operator=(const ItemEqual& other) { return *this; }
+
+    bool operator()(const Item& lhs, const Item& rhs) const {
+      return lhs.shash == rhs.shash && mod_eq_.Equal(lhs.mod, rhs.mod);
+    }
+
+    const ModuleEquality& mod_eq_;
+  };
+
+  std::unordered_set<Item, ItemHash, ItemEqual> tab_;
+};
+
 }  // namespace meta_schedule
 }  // namespace s_tir
 }  // namespace tvm
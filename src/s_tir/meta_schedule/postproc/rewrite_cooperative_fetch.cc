@@ -74,17 +74,23 @@ ffi::Optional<SBlockRV> ParseAnnotate(const Schedule& sch, const Instruction& in
  * \brief Parse instruction: sch.annotate(..., attr::warp_execution)
  * \param sch The schedule
  * \param inst The instruction to be parsed
- * \return Whether ths parsing is successful
+ * \return The number of warps executing the block, 0 if the parsing fails
  */
-bool ParseWarpExecutionAnn(const Schedule& sch, const Instruction& inst) {
+int64_t ParseWarpExecutionAnn(const Schedule& sch, const Instruction& inst) {
   static InstructionKind inst_kind_annotate = InstructionKind::Get("Annotate");
   if (!inst->kind.same_as(inst_kind_annotate)) {
-    return false;
+    return 0;
   }
   TVM_FFI_ICHECK_EQ(inst->inputs.size(), 2);
   TVM_FFI_ICHECK_EQ(inst->attrs.size(), 1);
   ffi::String ann_key = Downcast<ffi::String>(inst->attrs[0]);
-  return ann_key == s_tir::attr::warp_execution;
+  if (ann_key != s_tir::attr::warp_execution) {
+    return 0;
+  }
+  if (const auto* num_warps = inst->inputs[1].as<IntImmNode>()) {
+    return std::max<int64_t>(num_warps->value, 1);
+  }
+  return 1;
 }
 
 size_t GetMaxUsedDtypeBytes(SBlock block) {
@@ -167,8 +173,8 @@ bool RewriteCooperativeFetchNode::Apply(const s_tir::Schedule& sch) {
       thread_extent_y = new_thread_extent.value()->value;
       continue;
     }
-    if (s_tir::ParseWarpExecutionAnn(sch, inst)) {
-      thread_extent_x = thread_warp_size_;
+    if (int64_t num_warps = s_tir::ParseWarpExecutionAnn(sch, inst)) {
+      thread_extent_x = thread_warp_size_ * num_warps;
       continue;
     }
     ffi::Optional<s_tir::SBlockRV> opt_block_rv = s_tir::ParseAnnotate(sch, inst, &vector_lane);
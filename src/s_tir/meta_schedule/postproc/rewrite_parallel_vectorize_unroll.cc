@@ -100,13 +100,14 @@ struct ParsedAnnotation {
   int max_vectorize_extent;
   int unroll_explicit;
   int unroll_implicit;
+  int prefetch_distance;
   int num_parallel_loops;
   int num_vectorize_loops;
 };
 
 bool ParseAnnotation(const SBlock& block, ParsedAnnotation* parsed) {
   bool found = false;
-  *parsed = ParsedAnnotation{-1, -1, -1, -1, -1, -1};
+  *parsed = ParsedAnnotation{-1, -1, -1, -1, -1, -1, -1};
   for (const auto& ann : block->annotations) {
     if (ann.first == s_tir::attr::meta_schedule_parallel) {
       found = true;
@@ -128,6 +129,11 @@ bool ParseAnnotation(const SBlock& block, ParsedAnnotation* parsed) {
       if (auto opt_int_imm = ann.second.try_cast<IntImm>()) {
         parsed->unroll_implicit = (*opt_int_imm)->value;
       }
+    } else if (ann.first == s_tir::attr::meta_schedule_software_prefetch) {
+      found = true;
+      if (auto opt_int_imm = ann.second.try_cast<IntImm>()) {
+        parsed->prefetch_distance = (*opt_int_imm)->value;
+      }
     }
   }
   return found;
@@ -147,6 +153,9 @@ void RemoveParsedAnn(const Schedule& sch, const SBlockRV& block_rv,
   if (parsed.unroll_implicit != -1) {
     sch->Unannotate(block_rv, s_tir::attr::meta_schedule_unroll_implicit);
   }
+  if (parsed.prefetch_distance != -1) {
+    sch->Unannotate(block_rv, s_tir::attr::meta_schedule_software_prefetch);
+  }
 }
 
 int CalculateNumRewritableLoops(const ffi::Array<StmtSRef>& loop_srefs,
@@ -407,6 +416,23 @@ void RewriteUnroll(const Schedule& sch, int unroll_explicit, int max_step, const
                 IntImm(DataType::Int(32), unroll_explicit));
 }
 
+void RewriteSoftwarePrefetch(const Schedule& sch, int distance,
+                             const ffi::Array<LoopRV>& loop_rvs) {
+  if (distance <= 0) {
+    return;
+  }
+  // Prefetch in the innermost loop that is run iteration by iteration.
+  for (auto it = loop_rvs.rbegin(); it != loop_rvs.rend(); ++it) {
+    const ForNode* loop = TVM_SREF_TO_FOR(sch->GetSRef(*it));
+    if (loop->thread_binding.defined() || loop->kind == ForKind::kVectorized) {
+      continue;
+    }
+    sch->Annotate(*it, s_tir::attr::software_prefetch_distance,
+                  IntImm(DataType::Int(32), distance));
+    return;
+  }
+}
+
 }  // namespace s_tir
 
 namespace s_tir {
@@ -451,6 +477,10 @@ class RewriteParallelVectorizeUnrollNode : public PostprocNode {
             int max_step = parsed.unroll_explicit + parsed.unroll_implicit + 1;
             s_tir::RewriteUnroll(sch, unroll_explicit, max_step, block_rv, loop_rvs[0]);
           }
+          // SoftwarePrefetch
+          if (parsed.prefetch_distance != -1) {
+            s_tir::RewriteSoftwarePrefetch(sch, parsed.prefetch_distance, loop_rvs);
+          }
         } catch (const s_tir::ScheduleError& e) {
           DLOG(WARNING) << "Failed to apply parallelization/vectorization: " << e.what();
           return false;
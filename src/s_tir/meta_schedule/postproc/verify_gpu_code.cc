@@ -73,8 +73,9 @@ class ThreadExtentChecker : private StmtVisitor {
 
   void VisitStmt_(const SBlockNode* block) {
     int old_thread_idx_x = thread_idx_x;
-    if (block->annotations.count(s_tir::attr::warp_execution)) {
-      thread_idx_x = thread_warp_size_;
+    if (ffi::Optional<Integer> num_warps =
+            GetAnn<Integer>(block, s_tir::attr::warp_execution)) {
+      thread_idx_x = thread_warp_size_ * std::max<int64_t>(num_warps.value()->value, 1);
     }
     if (ffi::Optional<Integer> low_inclusive =
             GetAnn<Integer>(block, s_tir::attr::meta_schedule_thread_extent_low_inclusive)) {
@@ -37,6 +37,19 @@ RunnerResult::RunnerResult(ffi::Optional<ffi::Array<FloatImm>> run_secs,
                            ffi::Optional<ffi::String> error_msg) {
   ObjectPtr<RunnerResultNode> n = ffi::make_object<RunnerResultNode>();
   n->run_secs = run_secs;
+  if (run_secs.has_value() && run_secs.value().size() >= 2) {
+    int num = run_secs.value().size();
+    double mean = 0.0;
+    for (const FloatImm& sec : run_secs.value()) {
+      mean += sec->value;
+    }
+    mean /= num;
+    double var = 0.0;
+    for (const FloatImm& sec : run_secs.value()) {
+      var += (sec->value - mean) * (sec->value - mean);
+    }
+    n->run_secs_variance = FloatImm(DataType::Float(64), var / (num - 1));
+  }
   n->error_msg = error_msg;
   this->data_ = n;
 }
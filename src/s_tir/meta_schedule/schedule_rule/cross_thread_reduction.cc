@@ -116,6 +116,13 @@ class CrossThreadReductionNode : public ScheduleRuleNode {
         tmp_sch->Split(fused_reduce_loop, {std::nullopt, thread_extent});
     tmp_sch->Bind(split_res[1], "threadIdx.x");
 
+    // Step 6. When the reduction is too short to fill a warp, also try reducing several rows in
+    // each warp, for which LowerThreadAllreduce emits a segmented sub-warp shuffle reduction.
+    if (!fusible) {
+      if (ffi::Optional<s_tir::Schedule> multi_row_sch = ApplyMultiRow(sch, block_rv)) {
+        return {tmp_sch, multi_row_sch.value(), sch};
+      }
+    }
     return {tmp_sch, sch};
   }
 
@@ -126,6 +133,49 @@ class CrossThreadReductionNode : public ScheduleRuleNode {
   }
 
  private:
+  /*!
+   * \brief Bind the whole reduction loop of a block to threadIdx.x and the innermost spatial loop,
+   * split by the number of rows that fit in a warp, to threadIdx.y, so that one warp reduces
+   * several independent rows.
+   * \param sch The TensorIR schedule
+   * \param block_rv The reduction block
+   * \return The new schedule, or nullopt if the reduction extent is not a constant smaller than and
+   * dividing the warp size, or the rows cannot be split evenly.
+   */
+  ffi::Optional<s_tir::Schedule> ApplyMultiRow(const s_tir::Schedule& sch,
+                                               const s_tir::SBlockRV& block_rv) {
+    s_tir::Schedule multi_row_sch = sch->Copy();
+    multi_row_sch->Seed(sch->ForkSeed());
+    size_t num_spatial_loops;
+    s_tir::LoopRV fused_reduce_loop;
+    ReorderAndFuseReductionLoops(multi_row_sch, block_rv, &fused_reduce_loop, &num_spatial_loops);
+    if (num_spatial_loops == 0) {
+      return std::nullopt;
+    }
+    const auto* reduce_extent = multi_row_sch->Get(fused_reduce_loop)->extent.as<IntImmNode>();
+    if (reduce_extent == nullptr || reduce_extent->value < 2 || reduce_extent->value >= warp_size ||
+        warp_size % reduce_extent->value != 0) {
+      return std::nullopt;
+    }
+    s_tir::LoopRV row_loop = multi_row_sch->GetLoops(block_rv)[num_spatial_loops - 1];
+    const auto* row_extent = multi_row_sch->Get(row_loop)->extent.as<IntImmNode>();
+    if (row_extent == nullptr) {
+      return std::nullopt;
+    }
+    int64_t rows_per_warp = warp_size / reduce_extent->value;
+    while (rows_per_warp > 1 && row_extent->value % rows_per_warp != 0) {
+      rows_per_warp /= 2;
+    }
+    if (rows_per_warp < 2) {
+      return std::nullopt;
+    }
+    const ffi::Array<s_tir::LoopRV>& row_split =
+        multi_row_sch->Split(row_loop, {std::nullopt, Integer(rows_per_warp)});
+    multi_row_sch->Bind(row_split[1], "threadIdx.y");
+    multi_row_sch->Bind(fused_reduce_loop, "threadIdx.x");
+    return multi_row_sch;
+  }
+
   /*!
    * \brief Check whether the input block is in thread scope, i.e., some of its outer loop is
    * bound to threadIdx.
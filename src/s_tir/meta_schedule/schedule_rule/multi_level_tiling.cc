@@ -314,6 +314,13 @@ std::vector<State> MultiLevelTilingNode::AddReadReuse(State state) const {
       SBlockRV cache_read_block = sch->CacheRead(block_rv, i, config.scope, {block_rv});
       // Insert cache_read block to the proper place
       sch->ComputeAt(cache_read_block, loop_rv, true);
+      // Inline the copies that pad the input, so that the cache read pads it
+      for (const SBlockRV& producer : sch->GetProducers(cache_read_block)) {
+        if (s_tir::GetAnn<Integer>(sch->GetSRef(producer),
+                                   s_tir::attr::meta_schedule_inline_into_cache_read)) {
+          sch->ComputeInline(producer);
+        }
+      }
       // Fuse the iterators of the cache_read
       ffi::Array<LoopRV> buffer_loops = sch->GetLoops(cache_read_block);
       sch->Fuse(ffi::Array<LoopRV>{buffer_loops.end() - buffer_ndim,  //
@@ -53,7 +53,8 @@ struct TensorCoreIntrinGroup {
    *  - compute
    *  - store
    * The values of the keys should be the names of the corresponding intrinsics and should be
-   * registered via TensorIntrin.Register beforehand.
+   * registered via TensorIntrin.Register beforehand. load_a and load_b can be omitted for the
+   * wgmma intrinsics, which read both multiplicands from the shared memory.
    */
   static TensorCoreIntrinGroup FromConfig(const ffi::Map<ffi::String, ffi::String>& config);
 };
@@ -68,9 +69,12 @@ TensorCoreIntrinGroup TensorCoreIntrinGroup::FromConfig(
   };
   TensorCoreIntrinGroup intrin_group;
   f_initialize_intrin("init", &intrin_group.init_intrin);
-  f_initialize_intrin("load_a", &intrin_group.load_a_intrin);
-  f_initialize_intrin("load_b", &intrin_group.load_b_intrin);
   f_initialize_intrin("compute", &intrin_group.compute_intrin);
+  if (!support::StartsWith(intrin_group.compute_intrin, "wgmma") || config.count("load_a") ||
+      config.count("load_b")) {
+    f_initialize_intrin("load_a", &intrin_group.load_a_intrin);
+    f_initialize_intrin("load_b", &intrin_group.load_b_intrin);
+  }
   f_initialize_intrin("store", &intrin_group.store_intrin);
   return intrin_group;
 }
@@ -89,6 +93,8 @@ class TensorCoreStateNode : public StateNode {
   s_tir::SBlockRV tensor_core_reindex_store;
   /*! \brief Flag to indicate its a WMMA or MMA intrin group */
   bool is_mma;
+  /*! \brief Flag to indicate its a WGMMA intrin group */
+  bool is_wgmma;
   /*! \brief Flag to indicate whether to use async software pipeline */
   bool use_async;
 
@@ -124,6 +130,7 @@ TensorCoreState::TensorCoreState(TensorCoreIntrinGroup intrin_group,
   node->block_rv = std::move(block_rv);
   node->tiles = std::move(tiles);
   node->is_mma = support::StartsWith(intrin_group.compute_intrin, "mma_sync");
+  node->is_wgmma = support::StartsWith(intrin_group.compute_intrin, "wgmma_sync");
   node->use_async = use_async;
   data_ = std::move(node);
 }
@@ -151,6 +158,8 @@ class MultiLevelTilingTensorCoreNode : public MultiLevelTilingNode {
   inline std::vector<State> MMAAddReadReuse(TensorCoreState state) const;
   // Subrule: Add tensorized load
   inline std::vector<State> AddReadReuseTensorCore(TensorCoreState state) const;
+  // Subrule: Add the swizzled shared memory layout read by wgmma
+  inline std::vector<State> WGMMAAddReadReuseTensorCore(TensorCoreState state) const;
   // Subrule: Add tensorized store
   inline std::vector<State> AddWriteReuseTensorCore(TensorCoreState state) const;
   // Subrule: Add software pipeline
@@ -163,6 +172,10 @@ class MultiLevelTilingTensorCoreNode : public MultiLevelTilingNode {
   // Basically same with MultiLevelTilingNode::TileLoopNest, but change SamplePerfectTile to
   // SamplePartitionedTile
   inline std::vector<State> MMATileLoopNest(TensorCoreState state) const;
+  // Subrule: tile loop nest for wgmma
+  // Basically same with MultiLevelTilingNode::TileLoopNest, but split the reduction loop so that
+  // the shared memory tiles of the multiplicands are a row of the 128B swizzle in K
+  inline std::vector<State> WGMMATileLoopNest(TensorCoreState state) const;
 
   // Override ApplySubRules to apply tensorization-specific sub-rules
   std::vector<State> ApplySubRules(std::vector<State> states) final;
@@ -267,6 +280,9 @@ std::vector<State> MultiLevelTilingTensorCoreNode::ApplySubRules(std::vector<Sta
   });
   states = SubRule(std::move(states), [&](State state) {
     TensorCoreState tc_state = Downcast<TensorCoreState>(state);
+    if (tc_state->is_wgmma) {
+      return WGMMATileLoopNest(tc_state);
+    }
     return tc_state->is_mma ? MMATileLoopNest(tc_state) : TileLoopNest(state, 2);
   });
   states = SubRule(std::move(states), [&](State state) {
@@ -431,9 +447,108 @@ std::vector<State> MultiLevelTilingTensorCoreNode::MMATileLoopNest(TensorCoreSta
   return {state};
 }
 
+std::vector<State> MultiLevelTilingTensorCoreNode::WGMMATileLoopNest(
+    TensorCoreState state) const {
+  Schedule& sch = state->sch;
+  const SBlockRV& block_rv = state->block_rv;
+  if (r_indices_.size() < 2) {
+    LOG(DEBUG) << "The WGMMA tensor core needs at least two levels of reduction tiles";
+    return {};
+  }
+  // The reduction loop iterates over the K dimension of the tensor intrin. Each row of the 128B
+  // swizzle of the multiplicands holds `num_k_per_row` of them.
+  int64_t num_k_per_row = [&]() {
+    tir::SBlock intrin_block =
+        Downcast<tir::SBlockRealize>(
+            tir::TensorIntrin::Get(state->intrin_group.compute_intrin).value()->desc->body)
+            ->block;
+    tir::Buffer buffer_a = intrin_block->reads[1]->buffer;
+    int64_t k_dim = Downcast<IntImm>(buffer_a->shape[1])->value;
+    return 128 / (k_dim * buffer_a->dtype.bytes());
+  }();
+  // Step 1. Assuming trivial binding, pair the loops and their iter-var-types
+  ffi::Array<LoopRV> loops = sch->GetLoops(block_rv);
+  std::vector<IterVarType> iter_types = GetSBlockVarTypes(sch->GetSRef(state->block_rv));
+  TVM_FFI_ICHECK_EQ(loops.size(), iter_types.size());
+  int num_spatial_loops = std::count(iter_types.begin(), iter_types.end(), IterVarType::kDataPar);
+  int num_reduction_loops =
+      std::count(iter_types.begin(), iter_types.end(), IterVarType::kCommReduce);
+  if (num_spatial_loops < 2 || num_reduction_loops != 1) {
+    LOG(DEBUG) << "The WGMMA tensor core only supports a single reduction loop now";
+    return {};
+  }
+  // Step 2. For each loop axis, tile it. The outer spatial loops other than the inner two are
+  // fused into the outermost tile.
+  int num_skipped_spatial_loops = num_spatial_loops - 2;
+  ffi::Array<LoopRV> skipped_outer_spatial_loops;
+  std::vector<ffi::Array<LoopRV>> tiles(s_indices_.size() + r_indices_.size());
+  std::vector<ffi::Array<s_tir::ExprRV>> tile_factors(tiles.size());
+  for (int i = 0, n = loops.size(); i < n; ++i) {
+    LoopRV loop = loops[i];
+    if (iter_types[i] == IterVarType::kDataPar) {
+      if (num_skipped_spatial_loops > 0) {
+        skipped_outer_spatial_loops.push_back(loop);
+        --num_skipped_spatial_loops;
+        continue;
+      }
+      const int n_tiles = s_indices_.size();
+      if (n_tiles == 1) {
+        tiles[s_indices_[0]].push_back(loop);
+        continue;
+      }
+      auto [factors, splits] = SplitLoop(sch, block_rv, loop, n_tiles);
+      for (int j = 0; j < n_tiles; ++j) {
+        tiles[s_indices_[j]].push_back(splits[j]);
+        tile_factors[s_indices_[j]].push_back(factors[j]);
+      }
+    } else if (iter_types[i] == IterVarType::kCommReduce) {
+      const int64_t* extent = s_tir::GetLoopIntExtent(sch->Get(loop).get());
+      if (extent == nullptr || *extent % num_k_per_row != 0) {
+        LOG(DEBUG) << "The reduction loop of WGMMA tensor core should be divisible by "
+                   << num_k_per_row;
+        return {};
+      }
+      // The first level iterates over the rows and the second level over a row, so that the
+      // read reuse under the first level caches a row.
+      ffi::Array<s_tir::ExprRV> factors{Integer(*extent / num_k_per_row), Integer(num_k_per_row)};
+      while (factors.size() < r_indices_.size()) {
+        factors.push_back(Integer(1));
+      }
+      ffi::Array<LoopRV> splits = sch->Split(loop, {factors.begin(), factors.end()});
+      for (int j = 0, n_tiles = r_indices_.size(); j < n_tiles; ++j) {
+        tiles[r_indices_[j]].push_back(splits[j]);
+        tile_factors[r_indices_[j]].push_back(factors[j]);
+      }
+    }
+  }
+  state->tile_factors = std::move(tile_factors);
+  // Step 3. Reorder to organize the tiles
+  sch->Reorder(support::ConcatArrayList<LoopRV>(tiles.begin(), tiles.end()));
+  // Step 4. Bind the tiles to threads
+  int n_binds = std::min(tile_binds.size(), tiles.size());
+  if (skipped_outer_spatial_loops.size() && n_binds) {
+    tiles[0].insert(tiles[0].begin(), skipped_outer_spatial_loops.begin(),
+                    skipped_outer_spatial_loops.end());
+  }
+  for (int i = 0; i < n_binds; ++i) {
+    LoopRV fused = sch->Fuse(tiles[i]);
+    sch->Bind(fused, tile_binds[i]);
+    tiles[i] = {fused};
+  }
+  state->tiles = ffi::Array<ffi::Array<LoopRV>>{tiles.begin(), tiles.end()};
+  if (this->thread_warp_size_ != -1) {
+    // Each warpgroup has 4 warps.
+    sch->Annotate(block_rv, s_tir::attr::meta_schedule_thread_extent_low_inclusive,
+                  Integer(4 * this->thread_warp_size_));
+    sch->Annotate(block_rv, s_tir::attr::meta_schedule_thread_extent_high_inclusive,
+                  Integer(this->max_threads_per_block_));
+  }
+  return {state};
+}
+
 std::vector<State> MultiLevelTilingTensorCoreNode::TransformIntermediateOutputLayout(
     TensorCoreState state) {
-  if (state->is_mma) {
+  if (state->is_mma || state->is_wgmma) {
     return {state};
   }
   // Transform the intermediate output to packed layout
@@ -532,6 +647,25 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddWriteReuseTensorCore(
     state->sch->ReverseComputeInline(state->tensor_core_reindex_store);
     return {state};
   }
+  if (state->is_wgmma) {
+    // The accumulator of each warpgroup is stored by the warpgroup, then the write reuse block
+    // copies it cooperatively.
+    if (!state->write_reuse.count(0)) {
+      return {};
+    }
+    Schedule& sch = state->sch;
+    SBlockRV accumulator =
+        sch->WriteAt(state->tiles[2].back(), state->block_rv, 0, "wgmma.accumulator");
+    sch->ReverseComputeInline(state->tensor_core_reindex_store);
+    TileAndAnnotateTensorize(&sch, accumulator, state->intrin_group.store_intrin, "");
+    int buffer_ndim = static_cast<int>(
+        sch->Get(state->write_reuse.at(0))->reads[0]->buffer->shape.size());
+    ffi::Array<LoopRV> buffer_loops = sch->GetLoops(state->write_reuse.at(0));
+    TVM_FFI_ICHECK_GE(static_cast<int>(buffer_loops.size()), buffer_ndim);
+    sch->Fuse(ffi::Array<LoopRV>{buffer_loops.end() - buffer_ndim, buffer_loops.end()});
+    AnnotateCooperativeFetching(&sch, state->write_reuse.at(0));
+    return {state};
+  }
   // Add the cache write stage for Tensor Core
   Schedule& sch = state->sch;
   auto cache_write = sch->CacheWrite(state->block_rv, 0, "wmma.accumulator");
@@ -600,6 +734,9 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddWriteReuseTensorCore(
 
 std::vector<State> MultiLevelTilingTensorCoreNode::AddReadReuseTensorCore(
     TensorCoreState state) const {
+  if (state->is_wgmma) {
+    return WGMMAAddReadReuseTensorCore(state);
+  }
   const ffi::Array<LoopRV>& r_tiles = state->tiles[r_indices_[1]];
   Schedule& sch = state->sch;
   TVM_FFI_CHECK(!r_tiles.empty(), ValueError)
@@ -638,6 +775,47 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddReadReuseTensorCore(
   return {state};
 }
 
+std::vector<State> MultiLevelTilingTensorCoreNode::WGMMAAddReadReuseTensorCore(
+    TensorCoreState state) const {
+  Schedule& sch = state->sch;
+  // The shared memory tiles are a row of the 128B swizzle in K only if they are cached under the
+  // first level of reduction tiles and above the second one.
+  auto f_is_under = [&](const SBlockRV& block, const LoopRV& loop) {
+    tir::StmtSRef loop_sref = sch->GetSRef(loop);
+    for (const tir::StmtSRefNode* p = sch->GetSRef(block)->parent; p != nullptr; p = p->parent) {
+      if (p == loop_sref.get()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (int i = 0; i < 2; ++i) {
+    if (!state->read_reuse.count(i)) {
+      return {};
+    }
+    const s_tir::SBlockRV cache_read = state->read_reuse.at(i);
+    if (!f_is_under(cache_read, state->tiles[r_indices_[0]].back()) ||
+        f_is_under(cache_read, state->tiles[r_indices_[1]].back())) {
+      return {};
+    }
+    const tir::SBlockNode* cache_read_block = sch->GetSRef(cache_read)->StmtAs<tir::SBlockNode>();
+    tir::Buffer cache_read_buffer =
+        s_tir::GetNthAccessBuffer(sch->state(), ffi::GetRef<tir::SBlock>(cache_read_block), 0,
+                                  s_tir::BufferIndexType::kWrite);
+    if (cache_read_buffer->dtype.bits() != 16) {
+      TVM_PY_LOG(INFO, logger) << "The 128B swizzle of wgmma is only supported for 16-bit "
+                               << "multiplicands, but got " << cache_read_buffer->dtype;
+      return {};
+    }
+    // Inline the reindex / padding block
+    sch->ComputeInline(sch->GetProducers(cache_read)[0]);
+    // Rows of 64 16-bit elements are permuted to the 128B swizzle.
+    sch->Annotate(cache_read, "permuted_layout",
+                  ffi::String(std::string("g2s_") + std::string(i == 0 ? "A" : "B")));
+  }
+  return {state};
+}
+
 std::vector<State> MultiLevelTilingTensorCoreNode::AddSoftwarePipeline(
     TensorCoreState state) const {
   if (!use_software_pipeline) {
@@ -663,6 +841,30 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddSoftwarePipeline(
     return {state};
   }
 
+  if (state->is_wgmma) {
+    // wgmma reads the multiplicands from the shared memory, so there is no inner pipeline.
+    // The outer pipeline prefetches the shared memory tiles by one iteration:
+    //
+    // prologue:
+    //   load tile 0 to shared memory
+    // body:
+    //   for k0 in [0, K0 - 1):
+    //     load tile k0 + 1 to shared memory
+    //     compute matmul with tile k0
+    // epilogue:
+    //   compute matmul with tile K0 - 1
+    //
+    sch->Annotate(state->tiles[r_indices_[0]].back(), s_tir::attr::software_pipeline_stage,
+                  ffi::Array<Integer>{0, 0, 1});
+    sch->Annotate(state->tiles[r_indices_[0]].back(), s_tir::attr::software_pipeline_order,
+                  ffi::Array<Integer>{0, 1, 2});
+    if (state->use_async) {
+      sch->Annotate(state->tiles[r_indices_[0]].back(),
+                    s_tir::attr::software_pipeline_async_stages, ffi::Array<Integer>{0});
+    }
+    return {state};
+  }
+
   for (int i = 0; i < 2; ++i) {
     const s_tir::SBlockRV cache_read = state->read_reuse.at(i);
     if (state->is_mma) {
@@ -706,10 +908,8 @@ std::vector<State> MultiLevelTilingTensorCoreNode::AddSoftwarePipeline(
   // epilogue:
   //   compute matmul with fragment K1 - 1
   //
-  sch->Annotate(state->tiles[r_indices_[1]].back(), s_tir::attr::software_pipeline_stage,
-                ffi::Array<Integer>{0, 0, 1});
-  sch->Annotate(state->tiles[r_indices_[1]].back(), s_tir::attr::software_pipeline_order,
-                ffi::Array<Integer>{0, 1, 2});
+  // which double buffers the fragments in registers.
+  sch->DoubleBufferFragments(state->tiles[r_indices_[1]].back());
   if (state->is_mma && state->use_async) {
     sch->Annotate(state->tiles[r_indices_[0]].back(), s_tir::attr::software_pipeline_async_stages,
                   ffi::Array<Integer>{0});
@@ -905,7 +1105,9 @@ inline std::vector<State> MultiLevelTilingTensorCoreNode::TransformForTensorizat
                        state->intrin_group.compute_intrin);
   state->sch->Annotate(state->block_rv, s_tir::attr::meta_schedule_auto_tensorize_init,
                        state->intrin_group.init_intrin);
-  state->sch->Annotate(state->block_rv, s_tir::attr::warp_execution, Integer(1));
+  // wgmma is executed by a warpgroup of 4 warps.
+  state->sch->Annotate(state->block_rv, s_tir::attr::warp_execution,
+                       Integer(state->is_wgmma ? 4 : 1));
   return {std::move(state)};
 }
 
@@ -0,0 +1,173 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+class PadToTileNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {
+    TVM_FFI_ICHECK(context->target.defined());
+    is_cpu = context->target.value()->GetTargetDeviceType() == kDLCPU;
+  }
+
+  // Inherited from ScheduleRuleNode
+  ffi::Array<s_tir::Schedule> Apply(const s_tir::Schedule& sch,
+                                    const s_tir::SBlockRV& block_rv) final;
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<PadToTileNode> n = ffi::make_object<PadToTileNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ private:
+  /*! \brief Pad the block to the padding, and lower the copies of its padded inputs. */
+  void Pad(const s_tir::Schedule& sch, const s_tir::SBlockRV& block_rv,
+           const ffi::Array<Integer>& padding) const;
+
+ public:
+  /*! \brief The candidates of the tile size that the iterators of the block are padded to. */
+  ffi::Array<Integer> tile_sizes;
+  /*! \brief The maximum ratio of the padded iteration space to the original one, minus one. */
+  double max_overhead;
+  /*! \brief Whether the target is a CPU, where the inputs are not cached by the tiling. */
+  bool is_cpu = false;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<PadToTileNode>()
+        .def_ro("tile_sizes", &PadToTileNode::tile_sizes)
+        .def_ro("max_overhead", &PadToTileNode::max_overhead);
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.PadToTile", PadToTileNode,
+                                    ScheduleRuleNode);
+};
+
+ffi::Array<s_tir::Schedule> PadToTileNode::Apply(const s_tir::Schedule& sch,
+                                                 const s_tir::SBlockRV& block_rv) {
+  // Step 0. Check the conditions of this rule: a reduction block with static extents.
+  const tir::StmtSRef& block_sref = sch->GetSRef(block_rv);
+  const tir::SBlockNode* block = TVM_SREF_TO_SBLOCK(block_sref);
+  tir::StmtSRef scope_sref = GetScopeRoot(sch->state(), block_sref,
+                                          /*require_stage_pipeline=*/false);
+  if (HasBeenMultiLevelTiled(block_sref) ||
+      !IsReductionBlock(sch->state(), block_sref, scope_sref)) {
+    return {sch};
+  }
+  std::vector<int64_t> extents;
+  for (const tir::IterVar& iter : block->iter_vars) {
+    const auto* extent = iter->dom->extent.as<IntImmNode>();
+    if (extent == nullptr) {
+      return {sch};
+    }
+    extents.push_back(extent->value);
+  }
+  // Step 1. Create one schedule for each tile size that some iterator is not a multiple of, and
+  // that pads the iteration space within the overhead. The tilings of the padded block are then
+  // sampled by the rules that follow, so the padding and the tiling are tuned jointly.
+  ffi::Array<s_tir::Schedule> res;
+  std::vector<std::vector<int64_t>> tried;
+  for (const Integer& tile_size : tile_sizes) {
+    int64_t tile = tile_size->value;
+    std::vector<int64_t> padding;
+    std::vector<int64_t> padded_extents;
+    double ratio = 1.0;
+    bool needs_padding = false;
+    for (int64_t extent : extents) {
+      // The iterators shorter than a tile are kept, e.g. the batch of 1 of a GEMV.
+      int64_t pad = extent > tile && extent % tile != 0 ? tile : 1;
+      needs_padding = needs_padding || pad != 1;
+      padded_extents.push_back((extent + pad - 1) / pad * pad);
+      ratio *= static_cast<double>(padded_extents.back()) / extent;
+      padding.push_back(pad);
+    }
+    // Tile sizes that pad to the same extents give the same design space.
+    if (!needs_padding || ratio > 1.0 + max_overhead ||
+        std::find(tried.begin(), tried.end(), padded_extents) != tried.end()) {
+      continue;
+    }
+    tried.push_back(padded_extents);
+    s_tir::Schedule sch_tmp = sch->Copy();
+    sch_tmp->Seed(sch->ForkSeed());
+    try {
+      Pad(sch_tmp, block_rv, ffi::Array<Integer>(padding.begin(), padding.end()));
+      res.push_back(sch_tmp);
+    } catch (const tvm::runtime::Error& e) {
+    }
+  }
+  res.push_back(sch);
+  return res;
+}
+
+void PadToTileNode::Pad(const s_tir::Schedule& sch, const s_tir::SBlockRV& block_rv,
+                        const ffi::Array<Integer>& padding) const {
+  ffi::Array<s_tir::SBlockRV> producers_before = sch->GetProducers(block_rv);
+  sch->PadEinsum(block_rv, padding);
+  // The new producers are the copies of the inputs into the padded buffers.
+  for (const s_tir::SBlockRV& producer : sch->GetProducers(block_rv)) {
+    const tir::StmtSRef& producer_sref = sch->GetSRef(producer);
+    bool is_new = true;
+    for (const s_tir::SBlockRV& old_producer : producers_before) {
+      is_new = is_new && !sch->GetSRef(old_producer).same_as(producer_sref);
+    }
+    if (!is_new) {
+      continue;
+    }
+    if (is_cpu) {
+      // The GEMM reads the padded buffer directly: the copy is split into a fill of the padding
+      // and a copy of the in-bound region, neither of which is predicated per element.
+      sch->DecomposePadding(producer, sch->GetLoops(producer)[0]);
+    } else {
+      // The copy is inlined into the read cache of the tiling, so that the global memory is read
+      // once, by the predicated copy into the shared memory.
+      sch->Annotate(producer, s_tir::attr::meta_schedule_inline_into_cache_read, Integer(1));
+    }
+  }
+}
+
+ScheduleRule ScheduleRule::PadToTile(ffi::Array<Integer> tile_sizes, double max_overhead) {
+  TVM_FFI_ICHECK_GE(max_overhead, 0) << "The maximum padding overhead should be non-negative";
+  for (const Integer& tile_size : tile_sizes) {
+    TVM_FFI_ICHECK_GT(tile_size->value, 0) << "The tile sizes should be positive";
+  }
+  ObjectPtr<PadToTileNode> n = ffi::make_object<PadToTileNode>();
+  n->tile_sizes = std::move(tile_sizes);
+  n->max_overhead = max_overhead;
+  return ScheduleRule(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { PadToTileNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.ScheduleRulePadToTile", ScheduleRule::PadToTile);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
@@ -0,0 +1,184 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+class RollingBufferFusionNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+
+  // Inherited from ScheduleRuleNode
+  ffi::Array<s_tir::Schedule> Apply(const s_tir::Schedule& sch,
+                                    const s_tir::SBlockRV& block_rv) final;
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<RollingBufferFusionNode> n = ffi::make_object<RollingBufferFusionNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ private:
+  /*! \brief The producers of the block that can be computed row by row under its loops. */
+  ffi::Array<s_tir::SBlockRV> GetFusibleProducers(const s_tir::Schedule& sch,
+                                                  const s_tir::SBlockRV& block_rv) const;
+  /*!
+   * \brief Split the loop of the consumer into tiles, compute the producers under the tiles, and
+   * fold their buffers into rolling buffers when the tiles overlap.
+   * \return Whether a buffer of the producers is folded
+   */
+  bool Fuse(const s_tir::Schedule& sch, const ffi::Array<s_tir::SBlockRV>& producers,
+            const s_tir::LoopRV& loop) const;
+
+ public:
+  /*! \brief The maximum number of rows of the consumer computed per iteration of the fused loop. */
+  int max_rows_per_tile;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<RollingBufferFusionNode>().def_ro(
+        "max_rows_per_tile", &RollingBufferFusionNode::max_rows_per_tile);
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.RollingBufferFusion",
+                                    RollingBufferFusionNode, ScheduleRuleNode);
+};
+
+ffi::Array<s_tir::SBlockRV> RollingBufferFusionNode::GetFusibleProducers(
+    const s_tir::Schedule& sch, const s_tir::SBlockRV& block_rv) const {
+  const tir::StmtSRef& block_sref = sch->GetSRef(block_rv);
+  ffi::Array<s_tir::SBlockRV> result;
+  for (const s_tir::SBlockRV& producer : sch->GetProducers(block_rv)) {
+    const tir::StmtSRef& producer_sref = sch->GetSRef(producer);
+    tir::StmtSRef scope_sref = GetScopeRoot(sch->state(), producer_sref,
+                                            /*require_stage_pipeline=*/false);
+    // The intermediate tensor of the chain: a convolution or a pooling, only read by the block.
+    if (HasBeenMultiLevelTiled(producer_sref) ||
+        !IsReductionBlock(sch->state(), producer_sref, scope_sref) ||
+        IsOutputBlock(sch->state(), producer_sref, scope_sref) ||
+        TVM_SREF_TO_SBLOCK(producer_sref)->writes.size() != 1) {
+      continue;
+    }
+    ffi::Array<s_tir::SBlockRV> consumers = sch->GetConsumers(producer);
+    if (consumers.size() == 1 && sch->GetSRef(consumers[0]).same_as(block_sref)) {
+      result.push_back(producer);
+    }
+  }
+  return result;
+}
+
+ffi::Array<s_tir::Schedule> RollingBufferFusionNode::Apply(const s_tir::Schedule& sch,
+                                                           const s_tir::SBlockRV& block_rv) {
+  // Step 0. Check the conditions of this rule: the consumer of a chain, not scheduled yet.
+  const tir::StmtSRef& block_sref = sch->GetSRef(block_rv);
+  tir::StmtSRef scope_sref = GetScopeRoot(sch->state(), block_sref,
+                                          /*require_stage_pipeline=*/false);
+  if (HasBeenMultiLevelTiled(block_sref) ||
+      !IsReductionBlock(sch->state(), block_sref, scope_sref) ||
+      !IsTrivialBinding(sch->state(), block_sref)) {
+    return {sch};
+  }
+  ffi::Array<s_tir::SBlockRV> producers = GetFusibleProducers(sch, block_rv);
+  if (producers.empty()) {
+    return {sch};
+  }
+  // Step 1. Fuse the producers under each outer spatial loop of the consumer in turn, until the
+  // tiles of the loop overlap, e.g. under the rows of a convolution in NHWC or NCHW layout.
+  ffi::Optional<s_tir::Schedule> without_rolling = std::nullopt;
+  for (const s_tir::LoopRV& loop : sch->GetLoops(block_rv)) {
+    const tir::StmtSRef& loop_sref = sch->GetSRef(loop);
+    if (GetLoopIterType(loop_sref) != tir::IterVarType::kDataPar) {
+      break;
+    }
+    const int64_t* extent = GetLoopIntExtent(loop_sref);
+    if (extent == nullptr || *extent == 1) {
+      continue;
+    }
+    s_tir::Schedule fused = sch->Copy();
+    fused->Seed(sch->ForkSeed());
+    bool rolled = false;
+    try {
+      rolled = Fuse(fused, producers, loop);
+    } catch (const tvm::runtime::Error& e) {
+      continue;
+    }
+    if (rolled) {
+      return {fused, sch};
+    }
+    if (!without_rolling.defined()) {
+      without_rolling = fused;
+    }
+  }
+  // Step 2. Without overlapping tiles, e.g. for a pointwise consumer, the producers are fused
+  // under the outermost loop, and their buffers are compacted to a tile when lowered.
+  if (without_rolling.defined()) {
+    return {without_rolling.value(), sch};
+  }
+  return {sch};
+}
+
+bool RollingBufferFusionNode::Fuse(const s_tir::Schedule& sch,
+                                   const ffi::Array<s_tir::SBlockRV>& producers,
+                                   const s_tir::LoopRV& loop) const {
+  // The number of rows per tile is sampled, so that it is tuned by the mutation of the tile sizes.
+  ffi::Array<s_tir::ExprRV> factors = sch->SamplePerfectTile(
+      loop, /*n=*/2, /*max_innermost_factor=*/max_rows_per_tile);
+  ffi::Array<s_tir::LoopRV> split = sch->Split(loop, {factors.begin(), factors.end()});
+  for (const s_tir::SBlockRV& producer : producers) {
+    sch->ComputeAt(producer, split[0], /*preserve_unit_loops=*/true);
+  }
+  bool rolled = false;
+  for (const s_tir::SBlockRV& producer : producers) {
+    try {
+      // The rows that the tiles share are kept in the buffer instead of being recomputed.
+      sch->RollingBuffer(producer, /*write_buffer_index=*/0);
+      rolled = true;
+    } catch (const tvm::runtime::Error& e) {
+    }
+  }
+  if (rolled) {
+    // The tiles of a line buffer are computed in order, each one reusing the rows of the previous
+    // one, so the loop is kept out of the parallelization of the outer loops.
+    sch->Annotate(split[0], s_tir::attr::meta_schedule_rolling_buffer, Integer(1));
+  }
+  return rolled;
+}
+
+ScheduleRule ScheduleRule::RollingBufferFusion(int max_rows_per_tile) {
+  TVM_FFI_ICHECK_GT(max_rows_per_tile, 0) << "The number of rows per tile should be positive";
+  ObjectPtr<RollingBufferFusionNode> n = ffi::make_object<RollingBufferFusionNode>();
+  n->max_rows_per_tile = max_rows_per_tile;
+  return ScheduleRule(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { RollingBufferFusionNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.ScheduleRuleRollingBufferFusion",
+                        ScheduleRule::RollingBufferFusion);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
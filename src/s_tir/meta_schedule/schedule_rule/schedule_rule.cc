@@ -90,7 +90,8 @@ ffi::Array<ScheduleRule> ScheduleRule::DefaultLLVM() {
 }
 
 ffi::Array<ScheduleRule> ScheduleRule::DefaultX86(const ffi::String& type) {
-  static const ffi::Map<ffi::String, ffi::String> intrins = {{"vnni", "dot_16x4_vnni"},
+  static const ffi::Map<ffi::String, ffi::String> intrins = {{"amx", "dot_16x16x64_amx"},
+                                                             {"vnni", "dot_16x4_vnni"},
                                                              {"avx512", "dot_16x4_avx512"}};
   return {
       ScheduleRule::ApplyCustomRule(),
@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/stmt.h>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+class SoftwarePrefetchNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+
+  // Inherited from ScheduleRuleNode
+  ffi::Array<s_tir::Schedule> Apply(const s_tir::Schedule& sch,
+                                    const s_tir::SBlockRV& root_rv) final {
+    // Only mark the root block, as the loops to prefetch in are only known after the
+    // parallelization and vectorization of the post processor.
+    if (sch->GetSRef(root_rv)->parent != nullptr || prefetch_distances.empty()) {
+      return {sch};
+    }
+    int n = prefetch_distances.size();
+    double prob = 1.0 / n;
+    ffi::Array<FloatImm> probs(n, FloatImm(DataType::Float(32), prob));
+    PrimExpr distance = sch->SampleCategorical(prefetch_distances, probs);
+    sch->Annotate(root_rv, s_tir::attr::meta_schedule_software_prefetch, distance);
+    return {sch};
+  }
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<SoftwarePrefetchNode> n = ffi::make_object<SoftwarePrefetchNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ public:
+  /*! \brief The options of the prefetch distance in loop iterations, where 0 disables it. */
+  ffi::Array<Integer> prefetch_distances;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<SoftwarePrefetchNode>().def_ro("prefetch_distances",
+                                                   &SoftwarePrefetchNode::prefetch_distances);
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.SoftwarePrefetch", SoftwarePrefetchNode,
+                                    ScheduleRuleNode);
+};
+
+ScheduleRule ScheduleRule::SoftwarePrefetch(ffi::Array<Integer> prefetch_distances) {
+  for (const Integer& distance : prefetch_distances) {
+    TVM_FFI_ICHECK_GE(distance->value, 0)
+        << "The prefetch distance is expected to be non-negative, but got " << distance;
+  }
+  ObjectPtr<SoftwarePrefetchNode> n = ffi::make_object<SoftwarePrefetchNode>();
+  n->prefetch_distances = prefetch_distances;
+  return ScheduleRule(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { SoftwarePrefetchNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.ScheduleRuleSoftwarePrefetch",
+                        ScheduleRule::SoftwarePrefetch);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
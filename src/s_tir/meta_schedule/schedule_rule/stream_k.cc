@@ -0,0 +1,188 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+namespace meta_schedule {
+
+class StreamKNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {
+    TVM_FFI_ICHECK(context->target.defined());
+    Target target = context->target.value();
+    ffi::Optional<Integer> opt_max_threads_per_block =
+        target->GetAttr<Integer>("max_threads_per_block");
+    if (!opt_max_threads_per_block.defined()) {
+      TVM_PY_LOG(WARNING, context->logger)
+          << "Target does not have attribute \"max_threads_per_block\", therefore the "
+             "rule StreamK will not be applied";
+    }
+    max_threads_per_block = opt_max_threads_per_block.value_or(Integer(-1))->value;
+  }
+
+  // Inherited from ScheduleRuleNode
+  ffi::Array<s_tir::Schedule> Apply(const s_tir::Schedule& sch,
+                                    const s_tir::SBlockRV& block_rv) final;
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<StreamKNode> n = ffi::make_object<StreamKNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ private:
+  /*!
+   * \brief Split the reduction of the block into `num_splits` partial reductions computed by a
+   * persistent grid of `num_blocks` thread blocks, followed by the fixup in the same kernel.
+   */
+  void SplitReduction(const s_tir::Schedule& sch, const s_tir::SBlockRV& block_rv,
+                      int64_t spatial_extent, int64_t num_splits) const;
+
+ public:
+  /*! \brief The number of threads of each thread block. */
+  int64_t thread_extent;
+  /*! \brief The candidates of the number of splits of the reduction. */
+  ffi::Array<Integer> split_factors;
+  /*! \brief The maximum number of thread blocks that are resident on the device at once. */
+  int64_t max_concurrent_blocks;
+  /*! \brief The maximum number of threads per block, from the target. */
+  int64_t max_threads_per_block = -1;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<StreamKNode>()
+        .def_ro("thread_extent", &StreamKNode::thread_extent)
+        .def_ro("split_factors", &StreamKNode::split_factors)
+        .def_ro("max_concurrent_blocks", &StreamKNode::max_concurrent_blocks)
+        .def_ro("max_threads_per_block", &StreamKNode::max_threads_per_block);
+  }
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.StreamK", StreamKNode, ScheduleRuleNode);
+};
+
+ffi::Array<s_tir::Schedule> StreamKNode::Apply(const s_tir::Schedule& sch,
+                                               const s_tir::SBlockRV& block_rv) {
+  // Step 0. Check the conditions of this rule.
+  if (max_threads_per_block == -1 || thread_extent > max_threads_per_block) {
+    return {sch};
+  }
+  const tir::StmtSRef& block_sref = sch->GetSRef(block_rv);
+  if (!NeedsRFactorOrCrossThreadReduction(sch->state(), block_sref,
+                                          max_concurrent_blocks * thread_extent, thread_extent)) {
+    return {sch};
+  }
+  // Step 1. Compute the extents of the spatial and reduction loops. The split only pays off when
+  // the spatial loops alone cannot occupy the device.
+  int64_t spatial_extent = 1;
+  int64_t reduce_extent = 1;
+  for (const tir::StmtSRef& loop_sref : tir::GetLoops(block_sref)) {
+    int64_t extent = *GetLoopIntExtent(loop_sref);
+    if (GetLoopIterType(loop_sref) == tir::kDataPar) {
+      spatial_extent *= extent;
+    } else {
+      reduce_extent *= extent;
+    }
+  }
+  int64_t spatial_blocks = (spatial_extent + thread_extent - 1) / thread_extent;
+  if (spatial_blocks * 2 > max_concurrent_blocks) {
+    return {sch};
+  }
+  // Step 2. Create one schedule for each number of splits that divides the reduction and keeps
+  // all the thread blocks resident, as the fixup waits on a grid-wide barrier.
+  ffi::Array<s_tir::Schedule> res;
+  for (const Integer& factor : split_factors) {
+    int64_t num_splits = factor->value;
+    if (num_splits <= 1 || reduce_extent % num_splits != 0 ||
+        (num_splits * spatial_extent + thread_extent - 1) / thread_extent > max_concurrent_blocks) {
+      continue;
+    }
+    s_tir::Schedule sch_tmp = sch->Copy();
+    sch_tmp->Seed(sch->ForkSeed());
+    try {
+      SplitReduction(sch_tmp, block_rv, spatial_extent, num_splits);
+      res.push_back(sch_tmp);
+    } catch (const tvm::runtime::Error& e) {
+    }
+  }
+  res.push_back(sch);
+  return res;
+}
+
+void StreamKNode::SplitReduction(const s_tir::Schedule& sch, const s_tir::SBlockRV& block_rv,
+                                 int64_t spatial_extent, int64_t num_splits) const {
+  // Step 1. Fuse the reduction loops and split out the partial reductions.
+  size_t num_spatial_loops;
+  s_tir::LoopRV fused_reduce_loop;
+  ReorderAndFuseReductionLoops(sch, block_rv, &fused_reduce_loop, &num_spatial_loops);
+  ffi::Array<s_tir::LoopRV> split_loops =
+      sch->Split(fused_reduce_loop, {Integer(num_splits), std::nullopt});
+  // Step 2. Compute the partial reductions with one thread per partial sum of an output element.
+  s_tir::SBlockRV block_rf = sch->RFactor(split_loops[0], /*factor_axis=*/0);
+  ffi::Array<s_tir::LoopRV> rf_loops = sch->GetLoops(block_rf);
+  TVM_FFI_ICHECK_EQ(rf_loops.size(), num_spatial_loops + 2);
+  ffi::Array<s_tir::LoopRV> rf_parallel_loops{rf_loops[num_spatial_loops]};
+  for (size_t i = 0; i < num_spatial_loops; ++i) {
+    rf_parallel_loops.push_back(rf_loops[i]);
+  }
+  ffi::Array<s_tir::LoopRV> rf_order = rf_parallel_loops;
+  rf_order.push_back(rf_loops[num_spatial_loops + 1]);
+  sch->Reorder(rf_order);
+  s_tir::LoopRV rf_fused = sch->Fuse(rf_parallel_loops);
+  ffi::Array<s_tir::LoopRV> rf_split = sch->Split(rf_fused, {std::nullopt, Integer(thread_extent)});
+  sch->Bind(rf_split[0], "blockIdx.x");
+  sch->Bind(rf_split[1], "threadIdx.x");
+  // Step 3. Reduce the partial sums on the same grid, each thread striding over the outputs.
+  int64_t num_blocks = (num_splits * spatial_extent + thread_extent - 1) / thread_extent;
+  ffi::Array<s_tir::LoopRV> wb_loops = sch->GetLoops(block_rv);
+  TVM_FFI_ICHECK_EQ(wb_loops.size(), num_spatial_loops + 1);
+  s_tir::LoopRV wb_fused = sch->Fuse({wb_loops.begin(), wb_loops.begin() + num_spatial_loops});
+  ffi::Array<s_tir::LoopRV> wb_split =
+      sch->Split(wb_fused, {Integer(num_blocks), Integer(thread_extent), std::nullopt});
+  sch->Bind(wb_split[0], "blockIdx.x");
+  sch->Bind(wb_split[1], "threadIdx.x");
+  // Step 4. Merge the two kernels, with a grid-wide barrier between the partial reductions and
+  // the fixup.
+  sch->MergeKernels(rf_split[0], wb_split[0]);
+}
+
+ScheduleRule ScheduleRule::StreamK(int thread_extent, ffi::Array<Integer> split_factors,
+                                   int max_concurrent_blocks) {
+  TVM_FFI_ICHECK_GT(thread_extent, 0) << "The thread extent should be positive";
+  TVM_FFI_ICHECK_GT(max_concurrent_blocks, 0)
+      << "The maximum number of concurrent blocks should be positive";
+  ObjectPtr<StreamKNode> n = ffi::make_object<StreamKNode>();
+  n->thread_extent = thread_extent;
+  n->split_factors = std::move(split_factors);
+  n->max_concurrent_blocks = max_concurrent_blocks;
+  return ScheduleRule(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() { StreamKNode::RegisterReflection(); }
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.meta_schedule.ScheduleRuleStreamK", ScheduleRule::StreamK);
+}
+
+}  // namespace meta_schedule
+}  // namespace s_tir
+}  // namespace tvm
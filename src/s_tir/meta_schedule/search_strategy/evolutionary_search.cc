@@ -19,6 +19,7 @@
 
 #include <tvm/ffi/reflection/registry.h>
 
+#include <future>
 #include <mutex>
 
 #include "../module_equality.h"
@@ -37,39 +38,6 @@ using s_tir::Schedule;
 
 /**************** Data Structure ****************/
 
-/*! \brief An auxiliary data structure to help deduplicate IRModules */
-class IRModuleSet {
- public:
-  explicit IRModuleSet(const ModuleEquality& mod_eq)
-      : tab_(/*bucket_count*/ 0, ItemHash(), ItemEqual(mod_eq)) {}
-
-  /*! \brief Add an IRModule to the set */
-  void Add(const IRModule& mod, size_t shash) { tab_.insert(Item{mod, shash}); }
-  /*! \brief Check if the IRModule is in the set */
-  bool Has(const IRModule& mod, size_t shash) const { return tab_.count(Item{mod, shash}); }
-
- private:
-  struct Item {
-    IRModule mod;
-    size_t shash;
-  };
-  struct ItemHash {
-    size_t operator()(const Item& hash) const { return hash.shash; }
-  };
-  struct ItemEqual {
-    explicit ItemEqual(const ModuleEquality& mod_eq) : mod_eq_(mod_eq) {}
-    ItemEqual& operator=(const ItemEqual& other) { return *this; }
-
-    bool operator()(const Item& lhs, const Item& rhs) const {
-      return lhs.shash == rhs.shash && mod_eq_.Equal(lhs.mod, rhs.mod);
-    }
-
-    const ModuleEquality& mod_eq_;
-  };
-
-  std::unordered_set<Item, ItemHash, ItemEqual> tab_;
-};
-
 /*!
  * \brief A heap with a size up-limit. If overflow happens, it evicted the worst items.
  * \note It maintains a min heap in terms of `Item::score`. Therefore, when
@@ -214,16 +182,18 @@ struct ConcurrentBitmask {
 /*!
  * \brief Assemble measure candidates from the given candidate traces.
  * \param traces The picked candidate traces.
+ * \param num_threads The number of threads to assemble the candidates with.
  * \return The assembled measure candidates.
  */
-ffi::Array<MeasureCandidate> AssembleCandidates(const std::vector<Schedule>& picks) {
-  ffi::Array<MeasureCandidate> measure_inputs;
-  measure_inputs.reserve(picks.size());
-  for (const Schedule& sch : picks) {
-    measure_inputs.push_back(
-        MeasureCandidate(sch, ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true)));
-  }
-  return measure_inputs;
+ffi::Array<MeasureCandidate> AssembleCandidates(const std::vector<Schedule>& picks,
+                                                int num_threads) {
+  std::vector<MeasureCandidate> measure_inputs(picks.size(), MeasureCandidate{ffi::UnsafeInit()});
+  support::parallel_for_dynamic(0, picks.size(), num_threads, [&](int thread_id, int i) {
+    const Schedule& sch = picks[i];
+    measure_inputs[i] =
+        MeasureCandidate(sch, ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true));
+  });
+  return ffi::Array<MeasureCandidate>(measure_inputs.begin(), measure_inputs.end());
 }
 
 /*!
@@ -239,7 +209,8 @@ std::vector<double> PredictNormalizedScore(const std::vector<Schedule>& candidat
   auto _ = Profiler::TimedScope("EvoSearch/Evolve/PredictNormalizedScore");
   TVM_FFI_ICHECK(!candidates.empty())
       << "Candidates given for score prediction can not be empty list!";
-  std::vector<double> scores = cost_model->Predict(context, AssembleCandidates(candidates));
+  std::vector<double> scores =
+      cost_model->Predict(context, AssembleCandidates(candidates, context->num_threads));
   for (double& score : scores) {
     score = std::max(0.0, score);
   }
@@ -259,10 +230,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     int max_trials;
     /*! \brief The number of trials per iteration. */
     int num_trials_per_iter;
-    /*! \brief `[st, ed)` are the indices of the next batch of candidates. */
+    /*! \brief The index of the first candidate in the next batch. */
     int st;
-    /*! \brief `[st, ed)` are the indices of the next batch of candidates. */
-    int ed;
     /*! \brief The counter of returning empty results. */
     int num_empty_iters;
     /*! \brief The design spaces. Decisions are not used so traces only. */
@@ -270,9 +239,9 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     /*! \brief Pre thread data including module to be tuned and random state. */
     std::vector<PerThreadData> per_thread_data_;
     /*!
-     * \brief The workloads that are already measured.
-     * TODO(junrushao1994): add records from the database to avoid re-measuring.
-     * */
+     * \brief The postprocessed workloads that are already measured, including the top records
+     *  picked from the database, so that duplicates are never measured again.
+     */
     IRModuleSet measured_workloads_;
     /*! \brief A Database for selecting useful candidates. */
     Database database_{ffi::UnsafeInit()};
@@ -280,6 +249,18 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     CostModel cost_model_{ffi::UnsafeInit()};
     /*! \brief The token registered for the given workload in database. */
     Workload token_{ffi::UnsafeInit()};
+    /*!
+     * \brief The batch following the one last returned, generated in the background while the
+     *  last batch is being built and measured. Only valid in the pipelined mode.
+     */
+    std::future<ffi::Optional<ffi::Array<MeasureCandidate>>> next_batch_;
+    /*!
+     * \brief The traces of similar workloads adapted to the workload being tuned, used to fill
+     *  up the measured part of the initial population. Only used when transferring records.
+     */
+    std::vector<s_tir::Trace> transferred_traces_;
+    /*! \brief The counters of how the candidates were produced. */
+    SearchStats stats_;
 
     explicit State(EvolutionarySearchNode* self, int max_trials, int num_trials_per_iter,
                    ffi::Array<Schedule> design_space_schedules, Database database,
@@ -288,7 +269,6 @@ class EvolutionarySearchNode : public SearchStrategyNode {
           max_trials(max_trials),
           num_trials_per_iter(num_trials_per_iter),
           st(0),
-          ed(num_trials_per_iter),
           num_empty_iters(0),
           measured_workloads_(database->GetModuleEquality()) {
       design_spaces.reserve(design_space_schedules.size());
@@ -305,6 +285,13 @@ class EvolutionarySearchNode : public SearchStrategyNode {
       this->database_ = database;
       this->cost_model_ = cost_model;
       this->token_ = database->CommitWorkload(mod);
+      if (self->transfer_records) {
+        tvm::Target target = ctx->target.value_or(tvm::Target());
+        int num = self->population_size * self->init_measured_ratio;
+        for (const TuningRecord& record : database->QueryFuzzyTuningRecords(mod, target, num)) {
+          this->transferred_traces_.push_back(record->trace);
+        }
+      }
     }
 
     /*!
@@ -336,6 +323,12 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      */
     inline std::vector<Schedule> PickWithEpsGreedy(const std::vector<Schedule>& inits,
                                                    const std::vector<Schedule>& bests, int num);
+    /*!
+     * \brief Generate the batch of candidates starting at the given trial index.
+     * \param begin The index of the first candidate in the batch.
+     * \return The generated candidates, or nullopt if the search is finished.
+     */
+    inline ffi::Optional<ffi::Array<MeasureCandidate>> GenerateBatch(int begin);
     /*! \brief An interface method to be called by it's counterpart in EvolutionarySearchNode */
     inline ffi::Optional<ffi::Array<MeasureCandidate>> GenerateMeasureCandidates();
     /*! \brief An interface method to be called by it's counterpart in EvolutionarySearchNode */
@@ -347,6 +340,12 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * \return The calculated hash.
      */
     inline size_t ModuleHash(const IRModule& mod) const;
+    /*!
+     * \brief Compute the hashes of the modules of the given schedules in parallel.
+     * \param schs The schedules.
+     * \return The calculated hashes.
+     */
+    inline std::vector<size_t> ModuleHashes(const std::vector<Schedule>& schs) const;
   };
 
   /*! \brief The tuning context of the evolutionary search strategy. */
@@ -385,6 +384,17 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   /*** Configuration: pick states for measurement ***/
   /*! \brief The ratio of measurements to use randomly sampled states. */
   double eps_greedy;
+  /*!
+   * \brief Whether to evolve the next batch while the current one is being built and measured.
+   * The next batch then sees the cost model and the database before the results of the current
+   * batch are committed, i.e. they are stale by exactly one batch.
+   */
+  bool pipelined;
+  /*!
+   * \brief Whether to seed the initial population with the best records of workloads that only
+   * differ from the tuned one in loop extents, when not enough records of the tuned one exist.
+   */
+  bool transfer_records;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -398,7 +408,9 @@ class EvolutionarySearchNode : public SearchStrategyNode {
         .def_ro("genetic_num_iters", &EvolutionarySearchNode::genetic_num_iters)
         .def_ro("genetic_mutate_prob", &EvolutionarySearchNode::genetic_mutate_prob)
         .def_ro("genetic_max_fail_count", &EvolutionarySearchNode::genetic_max_fail_count)
-        .def_ro("eps_greedy", &EvolutionarySearchNode::eps_greedy);
+        .def_ro("eps_greedy", &EvolutionarySearchNode::eps_greedy)
+        .def_ro("pipelined", &EvolutionarySearchNode::pipelined)
+        .def_ro("transfer_records", &EvolutionarySearchNode::transfer_records);
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.EvolutionarySearch",
                                     EvolutionarySearchNode, SearchStrategyNode);
@@ -459,6 +471,13 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     this->state_->NotifyRunnerResults(measure_candidates, results);
   }
 
+  ffi::Map<ffi::String, int64_t> GetStats() const final {
+    if (this->state_ == nullptr) {
+      return {};
+    }
+    return this->state_->stats_.AsMap();
+  }
+
   SearchStrategy Clone() const final {
     ObjectPtr<EvolutionarySearchNode> n = ffi::make_object<EvolutionarySearchNode>();
     n->population_size = this->population_size;
@@ -470,6 +489,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     n->genetic_mutate_prob = this->genetic_mutate_prob;
     n->genetic_max_fail_count = this->genetic_max_fail_count;
     n->eps_greedy = this->eps_greedy;
+    n->pipelined = this->pipelined;
+    n->transfer_records = this->transfer_records;
     n->ctx_ = this->ctx_;
     n->rand_state_ = this->rand_state_;
     n->state_ = nullptr;  // cleared the state
@@ -485,11 +506,19 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   for (TuningRecord record : top_records) {
     measured_traces.push_back(record->trace);
   }
+  // Fill up with the traces transferred from similar workloads, which are allowed to fail
+  int num_measured = measured_traces.size();
+  for (const s_tir::Trace& trace : this->transferred_traces_) {
+    if (static_cast<int>(measured_traces.size()) >= num) {
+      break;
+    }
+    measured_traces.push_back(trace);
+  }
   int actual_num = measured_traces.size();
-  ThreadedTraceApply pp(self->postprocs_);
+  ThreadedTraceApply pp(self->postprocs_, &this->stats_);
   std::vector<Schedule> results(actual_num, Schedule{nullptr});
-  auto f_proc_measured = [this, &measured_traces, &results, &pp](int thread_id,
-                                                                 int trace_id) -> void {
+  auto f_proc_measured = [this, &measured_traces, &results, &pp, num_measured](
+                             int thread_id, int trace_id) -> void {
     PerThreadData& data = this->per_thread_data_.at(thread_id);
     TRandState* rand_state = &data.rand_state;
     const IRModule& mod = data.mod;
@@ -498,18 +527,31 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     TVM_FFI_ICHECK(!result.defined());
     if (ffi::Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
       result = sch.value();
-    } else {
+    } else if (trace_id < num_measured) {
       TVM_FFI_THROW(ValueError) << "Cannot postprocess the trace:\n" << trace;
       throw;
     }
   };
   support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_measured);
+  // The records in the database are measured already, possibly in an earlier session
+  for (int i = 0; i < num_measured; ++i) {
+    if (results[i].defined()) {
+      IRModule mod = results[i]->mod();
+      size_t shash = ModuleHash(mod);
+      if (!this->measured_workloads_.Has(mod, shash)) {
+        this->measured_workloads_.Add(mod, shash);
+      }
+    }
+  }
+  results.erase(std::remove_if(results.begin(), results.end(),
+                               [](const Schedule& sch) { return !sch.defined(); }),
+                results.end());
   return results;
 }
 
 std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int num) {
   auto _ = Profiler::TimedScope("EvoSearch/SampleInitPopulation");
-  ThreadedTraceApply pp(self->postprocs_);
+  ThreadedTraceApply pp(self->postprocs_, &this->stats_);
   std::vector<Schedule> out_schs;
   int fail_count = 0;
   while (static_cast<int>(out_schs.size()) < self->init_min_unmeasured &&
@@ -560,14 +602,17 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
     {
       auto _ = Profiler::TimedScope("EvoSearch/Evolve/Misc");
       TVM_FFI_ICHECK_EQ(scores.size(), population.size());
+      std::vector<size_t> shashes = ModuleHashes(population);
       for (int i = 0, n = population.size(); i < n; ++i) {
         Schedule sch = population.at(i);
         IRModule mod = sch->mod();
-        size_t shash = ModuleHash(mod);
+        size_t shash = shashes.at(i);
         double score = scores.at(i);
         if (!exists.Has(mod, shash)) {
           exists.Add(mod, shash);
           heap.Push(sch, score);
+        } else {
+          ++this->stats_.num_duplicated;
         }
       }
       // Discontinue once it reaches end of search
@@ -575,13 +620,15 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
         break;
       }
       // Set threaded samplers, with probability from predicated normalized throughput
-      for (PerThreadData& data : this->per_thread_data_) {
-        data.Set(scores, self->genetic_mutate_prob, self->mutator_probs_);
-      }
+      support::parallel_for_dynamic(
+          0, this->per_thread_data_.size(), self->ctx_->num_threads, [&](int thread_id, int i) {
+            this->per_thread_data_.at(i).Set(scores, self->genetic_mutate_prob,
+                                             self->mutator_probs_);
+          });
     }
     {
       auto _ = Profiler::TimedScope("EvoSearch/Evolve/Mutation");
-      ThreadedTraceApply pp(self->postprocs_);
+      ThreadedTraceApply pp(self->postprocs_, &this->stats_);
       ConcurrentBitmask cbmask(self->population_size);
       std::vector<Schedule> next_population(self->population_size, Schedule{nullptr});
       // The worker function
@@ -698,22 +745,20 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickWithEpsGreedy(
     if (!measured_workloads.Has(mod, shash)) {
       measured_workloads.Add(mod, shash);
       results.push_back(sch);
+    } else {
+      ++this->stats_.num_duplicated;
     }
   }
+  this->stats_.num_picked += results.size();
   return results;
 }
 
-ffi::Optional<ffi::Array<MeasureCandidate>>
-EvolutionarySearchNode::State::GenerateMeasureCandidates() {
-  if (st >= max_trials) {
+ffi::Optional<ffi::Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateBatch(
+    int begin) {
+  if (begin >= max_trials) {
     return std::nullopt;
   }
-  int sample_num = num_trials_per_iter;
-  if (ed > max_trials) {
-    sample_num = max_trials - st;
-    ed = max_trials;
-  }
-  TVM_FFI_ICHECK_LT(st, ed);
+  int sample_num = std::min(num_trials_per_iter, max_trials - begin);
   int pop = self->population_size;
   std::vector<Schedule> inits;
   inits.reserve(pop);
@@ -743,20 +788,49 @@ EvolutionarySearchNode::State::GenerateMeasureCandidates() {
       return std::nullopt;
     }
   }
-  return AssembleCandidates(picks);
+  return AssembleCandidates(picks, self->ctx_->num_threads);
+}
+
+ffi::Optional<ffi::Array<MeasureCandidate>>
+EvolutionarySearchNode::State::GenerateMeasureCandidates() {
+  ffi::Optional<ffi::Array<MeasureCandidate>> candidates;
+  if (next_batch_.valid()) {
+    candidates = next_batch_.get();
+  } else {
+    std::lock_guard<std::mutex> lock(TuningStateMutex());
+    candidates = GenerateBatch(st);
+  }
+  if (self->pipelined && candidates.defined()) {
+    // The scheduler advances `st` by the size of this batch once its results are in.
+    int next_begin = st + candidates.value().size();
+    next_batch_ = std::async(std::launch::async, [this, next_begin]() {
+      std::lock_guard<std::mutex> lock(TuningStateMutex());
+      return GenerateBatch(next_begin);
+    });
+  }
+  return candidates;
 }
 
 void EvolutionarySearchNode::State::NotifyRunnerResults(
     const ffi::Array<MeasureCandidate>& measure_candidates,
     const ffi::Array<RunnerResult>& results) {
   st += results.size();
-  ed += results.size();
 }
 
 size_t EvolutionarySearchNode::State::ModuleHash(const IRModule& mod) const {
   return database_->GetModuleEquality().Hash(mod);
 }
 
+std::vector<size_t> EvolutionarySearchNode::State::ModuleHashes(
+    const std::vector<Schedule>& schs) const {
+  auto _ = Profiler::TimedScope("EvoSearch/Evolve/Misc/ModuleHash");
+  std::vector<size_t> shashes(schs.size());
+  support::parallel_for_dynamic(0, schs.size(), self->ctx_->num_threads, [&](int thread_id, int i) {
+    shashes[i] = ModuleHash(schs[i]->mod());
+  });
+  return shashes;
+}
+
 SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         //
                                                   double init_measured_ratio,  //
                                                   int init_min_unmeasured,     //
@@ -764,7 +838,9 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
                                                   int genetic_num_iters,       //
                                                   double genetic_mutate_prob,  //
                                                   int genetic_max_fail_count,  //
-                                                  double eps_greedy) {
+                                                  double eps_greedy,           //
+                                                  bool pipelined,              //
+                                                  bool transfer_records) {
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(init_measured_ratio, "Initial measured ratio");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(genetic_mutate_prob, "Mutation probability");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(eps_greedy, "Greedy pick probability");
@@ -778,6 +854,8 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
   n->genetic_max_fail_count = genetic_max_fail_count;
   n->genetic_mutate_prob = genetic_mutate_prob;
   n->eps_greedy = eps_greedy;
+  n->pipelined = pipelined;
+  n->transfer_records = transfer_records;
   return SearchStrategy(n);
 }
 
@@ -18,6 +18,7 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include "../module_equality.h"
 #include "../utils.h"
 
 namespace tvm {
@@ -44,15 +45,26 @@ class ReplayTraceNode : public SearchStrategyNode {
 
     /*! \brief The module to be tuned. */
     ffi::Array<IRModule> per_thread_mod_{nullptr};
+    /*! \brief The database, which owns the module equality used for deduplication. */
+    ffi::Optional<Database> database_;
+    /*! \brief The module equality used for deduplication when there is no database. */
+    std::unique_ptr<ModuleEquality> mod_eq_;
+    /*! \brief The postprocessed workloads generated so far, so that none is measured twice. */
+    IRModuleSet measured_workloads_;
+    /*! \brief The counters of how the candidates were produced. */
+    SearchStats stats_;
 
     explicit State(ReplayTraceNode* self, ffi::Array<s_tir::Trace> design_spaces, int max_trials,
-                   int num_trials_per_iter)
+                   int num_trials_per_iter, ffi::Optional<Database> database)
         : self(self),
           design_spaces(design_spaces),
           max_trials(max_trials),
           num_trials_per_iter(num_trials_per_iter),
           st(0),
-          ed(num_trials_per_iter) {
+          ed(num_trials_per_iter),
+          database_(database),
+          mod_eq_(database.has_value() ? nullptr : ModuleEquality::Create("structural")),
+          measured_workloads_(ModEq()) {
       IRModule mod = self->mod_.value();
       this->per_thread_mod_.reserve(self->num_threads_);
       for (int i = 0; i < self->num_threads_; i++) {
@@ -61,6 +73,13 @@ class ReplayTraceNode : public SearchStrategyNode {
     }
 
     inline ffi::Optional<ffi::Array<MeasureCandidate>> GenerateMeasureCandidates();
+    /*! \brief The module equality used for deduplication. */
+    const ModuleEquality& ModEq() const {
+      return database_.has_value() ? database_.value()->GetModuleEquality() : *mod_eq_;
+    }
+    /*! \brief Sample candidates from the design spaces, `std::nullopt` for the failed ones. */
+    inline ffi::Array<ffi::Optional<MeasureCandidate>> SampleCandidates(ThreadedTraceApply* pp,
+                                                                         int num);
     inline void NotifyRunnerResults(const ffi::Array<RunnerResult>& results);
   };
 
@@ -114,8 +133,8 @@ class ReplayTraceNode : public SearchStrategyNode {
     for (const s_tir::Schedule& space : design_spaces) {
       design_space_traces.push_back(space->trace().value()->Simplified(true));
     }
-    this->state_ =
-        std::make_unique<State>(this, design_space_traces, max_trials, num_trials_per_iter);
+    this->state_ = std::make_unique<State>(this, design_space_traces, max_trials,
+                                           num_trials_per_iter, database);
   }
 
   void PostTuning() final {
@@ -134,6 +153,13 @@ class ReplayTraceNode : public SearchStrategyNode {
     this->state_->NotifyRunnerResults(results);
   }
 
+  ffi::Map<ffi::String, int64_t> GetStats() const final {
+    if (this->state_ == nullptr) {
+      return {};
+    }
+    return this->state_->stats_.AsMap();
+  }
+
   SearchStrategy Clone() const final {
     ObjectPtr<ReplayTraceNode> n = ffi::make_object<ReplayTraceNode>();
     n->max_fail_count = this->max_fail_count;
@@ -150,11 +176,39 @@ ReplayTraceNode::State::GenerateMeasureCandidates() {
   }
   ed = std::min(ed, max_trials);
   TVM_FFI_ICHECK_LT(st, ed);
+  ThreadedTraceApply pp(self->postprocs_, &this->stats_);
+  ffi::Array<MeasureCandidate> filtered;
+  filtered.reserve(ed - st);
+  // Candidates lowering to a workload generated before are dropped and sampled again, as long as
+  // new workloads keep showing up
+  for (int num = ed - st; num > 0;) {
+    int num_duplicates = 0;
+    for (const ffi::Optional<MeasureCandidate>& result : SampleCandidates(&pp, num)) {
+      if (!result.has_value()) {
+        continue;
+      }
+      IRModule mod = result.value()->sch->mod();
+      size_t shash = ModEq().Hash(mod);
+      if (measured_workloads_.Has(mod, shash)) {
+        ++num_duplicates;
+        ++stats_.num_duplicated;
+      } else {
+        measured_workloads_.Add(mod, shash);
+        filtered.push_back(result.value());
+      }
+    }
+    num = num_duplicates < num ? num_duplicates : 0;
+  }
+  stats_.num_picked += filtered.size();
+  return filtered;
+}
+
+inline ffi::Array<ffi::Optional<MeasureCandidate>> ReplayTraceNode::State::SampleCandidates(
+    ThreadedTraceApply* pp, int num) {
   std::vector<TRandState> per_thread_rand_state = ForkSeed(&self->rand_state_, self->num_threads_);
-  ffi::Array<ffi::Optional<MeasureCandidate>> per_task_result(ed - st, std::nullopt);
-  ThreadedTraceApply pp(self->postprocs_);
-  auto f_worker = [this, &per_thread_rand_state, &per_task_result, &pp](int thread_id,
-                                                                        int task_id) -> void {
+  ffi::Array<ffi::Optional<MeasureCandidate>> per_task_result(num, std::nullopt);
+  auto f_worker = [this, &per_thread_rand_state, &per_task_result, pp](int thread_id,
+                                                                       int task_id) -> void {
     TRandState& rand_state = per_thread_rand_state[thread_id];
     IRModule mod = this->per_thread_mod_[thread_id];
 
@@ -162,7 +216,7 @@ ReplayTraceNode::State::GenerateMeasureCandidates() {
       int design_space_index = s_tir::SampleInt(&rand_state, 0, design_spaces.size());
       s_tir::Trace trace = design_spaces[design_space_index];
       s_tir::Trace new_trace = s_tir::Trace(trace->insts, {});
-      if (ffi::Optional<s_tir::Schedule> opt_sch = pp.Apply(mod, new_trace, &rand_state)) {
+      if (ffi::Optional<s_tir::Schedule> opt_sch = pp->Apply(mod, new_trace, &rand_state)) {
         s_tir::Schedule sch = opt_sch.value();
         ffi::Array<ArgInfo> args_info = ArgInfo::FromEntryFunc(sch->mod(), /*remove_preproc=*/true);
         per_task_result.Set(task_id, MeasureCandidate(sch, args_info));
@@ -170,14 +224,8 @@ ReplayTraceNode::State::GenerateMeasureCandidates() {
       }
     }
   };
-  support::parallel_for_dynamic(0, ed - st, self->num_threads_, f_worker);
-  ffi::Array<MeasureCandidate> filtered;
-  filtered.reserve(ed - st);
-  for (ffi::Optional<MeasureCandidate> result : per_task_result)
-    if (result.has_value()) {
-      filtered.push_back(*std::move(result));
-    }
-  return filtered;
+  support::parallel_for_dynamic(0, num, self->num_threads_, f_worker);
+  return per_task_result;
 }
 
 inline void ReplayTraceNode::State::NotifyRunnerResults(const ffi::Array<RunnerResult>& results) {
@@ -107,7 +107,8 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                   &SearchStrategyNode::GenerateMeasureCandidates)
       .def_method("s_tir.meta_schedule.SearchStrategyNotifyRunnerResults",
                   &SearchStrategyNode::NotifyRunnerResults)
-      .def_method("s_tir.meta_schedule.SearchStrategyClone", &SearchStrategyNode::Clone);
+      .def_method("s_tir.meta_schedule.SearchStrategyClone", &SearchStrategyNode::Clone)
+      .def_method("s_tir.meta_schedule.SearchStrategyGetStats", &SearchStrategyNode::GetStats);
 }
 
 }  // namespace meta_schedule
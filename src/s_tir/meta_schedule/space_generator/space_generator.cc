@@ -29,6 +29,11 @@ ffi::String GetRuleKindFromTarget(const Target& target) {
   if (target->kind->name == "llvm") {
     static auto target_has_feature_fn_ptr =
         tvm::ffi::Function::GetGlobalRequired("target.target_has_feature");
+    bool have_amx = target_has_feature_fn_ptr("amx-tile", target).cast<bool>() &&
+                    target_has_feature_fn_ptr("amx-int8", target).cast<bool>();
+    if (have_amx) {
+      return "amx";
+    }
     bool have_avx512vnni = target_has_feature_fn_ptr("avx512vnni", target).cast<bool>();
     bool have_avxvnni = target_has_feature_fn_ptr("avxvnni", target).cast<bool>();
     if (have_avx512vnni || have_avxvnni) {
@@ -114,6 +119,10 @@ void SpaceGeneratorNode::InitializeWithTuneContext(const TuneContext& context) {
       default_sch_rules = ScheduleRule::DefaultHexagon();
       default_postprocs = Postproc::DefaultHexagon();
       default_mutator_probs = Mutator::DefaultHexagon();
+    } else if (kind == "amx") {
+      default_sch_rules = ScheduleRule::DefaultX86("amx");
+      default_postprocs = Postproc::DefaultCPUTensorization();
+      default_mutator_probs = Mutator::DefaultLLVM();
     } else if (kind == "vnni") {
       default_sch_rules = ScheduleRule::DefaultX86("vnni");
       default_postprocs = Postproc::DefaultCPUTensorization();
@@ -18,6 +18,9 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include <chrono>
+#include <cmath>
+
 #include "../utils.h"
 
 namespace tvm {
@@ -29,16 +32,34 @@ class GradientBasedNode final : public TaskSchedulerNode {
  public:
   double alpha;
   int window_size;
+  /*!
+   * \brief The number of rounds without improvement after which a task is retired, or 0 to never
+   * retire a task early.
+   */
+  int plateau_rounds;
+  /*!
+   * \brief The relative improvement over `plateau_rounds` rounds below which a task is considered
+   * plateaued. The measurement noise of the task is used instead if it is larger.
+   */
+  double plateau_tolerance;
+  /*! \brief The wall-clock budget of the whole tuning in seconds, or non-positive for no limit. */
+  double time_budget_secs;
   support::LinearCongruentialEngine::TRandState rand_state;
 
   int round_robin_rounds_;
   std::vector<std::vector<double>> best_latency_history_;
+  /*! \brief The sum and the count of the relative standard deviations of the measured runs. */
+  std::vector<std::pair<double, int>> noise_;
+  std::chrono::steady_clock::time_point tune_start_;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
     refl::ObjectDef<GradientBasedNode>()
         .def_ro("alpha", &GradientBasedNode::alpha)
-        .def_ro("window_size", &GradientBasedNode::window_size);
+        .def_ro("window_size", &GradientBasedNode::window_size)
+        .def_ro("plateau_rounds", &GradientBasedNode::plateau_rounds)
+        .def_ro("plateau_tolerance", &GradientBasedNode::plateau_tolerance)
+        .def_ro("time_budget_secs", &GradientBasedNode::time_budget_secs);
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("s_tir.meta_schedule.GradientBased", GradientBasedNode,
                                     TaskSchedulerNode);
@@ -50,7 +71,9 @@ class GradientBasedNode final : public TaskSchedulerNode {
             ffi::Optional<CostModel> cost_model) final {
     int n_tasks = tasks.size();
     round_robin_rounds_ = 0;
-    best_latency_history_.resize(n_tasks, std::vector<double>());
+    best_latency_history_.assign(n_tasks, std::vector<double>());
+    noise_.assign(n_tasks, {0.0, 0});
+    tune_start_ = std::chrono::steady_clock::now();
     TaskSchedulerNode::Tune(tasks, task_weights, max_trials_global, max_trials_per_task,
                             num_trials_per_iter, builder, runner, measure_callbacks, database,
                             cost_model);
@@ -74,21 +97,41 @@ class GradientBasedNode final : public TaskSchedulerNode {
       }
       ++round_robin_rounds_;
     }
-    // Step 2. Collect the tasks that are not terminated yet
+    // Step 2. Stop once the time budget is used up; every task has been measured once by now
+    if (time_budget_secs > 0) {
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                     tune_start_)
+                           .count();
+      if (elapsed >= time_budget_secs) {
+        TVM_PY_LOG(INFO, this->logger)
+            << "Time budget of " << time_budget_secs << "s is used up, stop tuning";
+        return -1;
+      }
+    }
+    // Step 3. Collect the tasks that are not terminated yet, and retire those that plateaued, so
+    // that their remaining trials in the global budget go to the other tasks
     std::vector<int> tasks_alive;
     {
       tasks_alive.reserve(n_tasks);
       for (int i = 0; i < n_tasks; ++i) {
         this->TouchTask(i);
-        if (!this->tasks_[i]->is_terminated) {
-          tasks_alive.push_back(i);
+        if (this->tasks_[i]->is_terminated) {
+          continue;
+        }
+        if (!this->tasks_[i]->runner_futures.defined() && IsPlateaued(i)) {
+          TVM_PY_LOG(INFO, this->logger)
+              << "Task #" << i << " has not improved in " << plateau_rounds
+              << " rounds, retiring it";
+          this->TerminateTask(i);
+          continue;
         }
+        tasks_alive.push_back(i);
       }
       if (tasks_alive.empty()) {
         return -1;
       }
     }
-    // Step 3. Calculate the gradient of each task alive
+    // Step 4. Calculate the gradient of each task alive
     std::vector<double> grad;
     grad.reserve(n_tasks);
     for (int task_id : tasks_alive) {
@@ -107,7 +150,7 @@ class GradientBasedNode final : public TaskSchedulerNode {
         grad.push_back(-1e9);
       }
     }
-    // Step 4. Select the task with the largest gradient
+    // Step 5. Select the task with the largest gradient
     auto max_grad = std::max_element(grad.begin(), grad.end());
     auto min_grad = std::min_element(grad.begin(), grad.end());
     int task_id = -1;
@@ -130,16 +173,57 @@ class GradientBasedNode final : public TaskSchedulerNode {
           *std::min_element(task->latency_ms.begin(),  //
                             task->latency_ms.end()));
     }
+    for (const RunnerResult& result : results) {
+      ffi::Array<FloatImm> run_secs = result->run_secs.value_or({});
+      int n = run_secs.size();
+      if (n < 2) {
+        continue;
+      }
+      double sum = 0.0, sum_sq = 0.0;
+      for (const FloatImm& sec : run_secs) {
+        sum += sec->value;
+        sum_sq += sec->value * sec->value;
+      }
+      double mean = sum / n;
+      if (mean > 0) {
+        double var = std::max(0.0, sum_sq / n - mean * mean);
+        noise_.at(task_id).first += std::sqrt(var) / mean;
+        noise_.at(task_id).second += 1;
+      }
+    }
     return results;
   }
+
+ private:
+  /*!
+   * \brief Whether the best latency of a task improved by less than the tolerance, or than the
+   * measurement noise of the task, over the last `plateau_rounds` rounds.
+   */
+  bool IsPlateaued(int task_id) const {
+    const std::vector<double>& best_latency = this->best_latency_history_.at(task_id);
+    int n = best_latency.size();
+    if (plateau_rounds <= 0 || n <= plateau_rounds || best_latency[n - 1] >= 1e9) {
+      return false;
+    }
+    const auto& [noise_sum, noise_count] = this->noise_.at(task_id);
+    double noise = noise_count > 0 ? noise_sum / noise_count : 0.0;
+    double before = best_latency[n - 1 - plateau_rounds];
+    return before - best_latency[n - 1] <= std::max(plateau_tolerance, noise) * before;
+  }
 };
 
 TaskScheduler TaskScheduler::GradientBased(ffi::Function logger, double alpha, int window_size,
+                                           int plateau_rounds, double plateau_tolerance,
+                                           double time_budget_secs,
                                            support::LinearCongruentialEngine::TRandState seed) {
+  TVM_FFI_CHECK_GE(plateau_rounds, 0, ValueError) << "`plateau_rounds` must be non-negative";
   ObjectPtr<GradientBasedNode> n = ffi::make_object<GradientBasedNode>();
   n->logger = logger;
   n->alpha = alpha;
   n->window_size = window_size;
+  n->plateau_rounds = plateau_rounds;
+  n->plateau_tolerance = plateau_tolerance;
+  n->time_budget_secs = time_budget_secs;
   n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
   return TaskScheduler(n);
 }
@@ -240,9 +240,12 @@ ffi::Array<RunnerResult> TaskSchedulerNode::JoinRunningTask(int task_id) {
   TVM_FFI_ICHECK(task->builder_results.defined());
   TVM_FFI_ICHECK_EQ(results.size(), task->measure_candidates.value().size());
   TVM_FFI_ICHECK_EQ(results.size(), task->builder_results.value().size());
-  for (const MeasureCallback& callback : this->measure_callbacks_) {
-    callback->Apply(ffi::GetRef<TaskScheduler>(this), task_id, task->measure_candidates.value(),
-                    task->builder_results.value(), results);
+  {
+    std::lock_guard<std::mutex> lock(TuningStateMutex());
+    for (const MeasureCallback& callback : this->measure_callbacks_) {
+      callback->Apply(ffi::GetRef<TaskScheduler>(this), task_id, task->measure_candidates.value(),
+                      task->builder_results.value(), results);
+    }
   }
   TaskCleanUp(task, task_id, results);
   TVM_PY_LOG_CLEAR_SCREEN(this->logger);
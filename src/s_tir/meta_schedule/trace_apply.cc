@@ -22,6 +22,7 @@
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -268,9 +269,61 @@ void ScheduleUsingAnchorTrace(Schedule sch, const Trace& anchor_trace, const tvm
   }
 }
 
+// Rescale the tile sizes of a loop to a new extent, keeping the inner factors as close as possible
+std::vector<int64_t> RescaleTileSizes(const std::vector<int64_t>& tiles, int64_t extent) {
+  int n = tiles.size();
+  std::vector<int64_t> result(n, 1);
+  int64_t remaining = extent;
+  for (int i = n - 1; i >= 1; --i) {
+    int64_t factor = std::max<int64_t>(1, std::min(tiles[i], remaining));
+    while (remaining % factor != 0) {
+      --factor;
+    }
+    result[i] = factor;
+    remaining /= factor;
+  }
+  result[0] = remaining;
+  return result;
+}
+
+ffi::Optional<Trace> AdaptTraceToModule(const Trace& trace, const IRModule& mod) {
+  static auto kind_sample_perfect_tile = InstructionKind::Get("SamplePerfectTile");
+  Schedule sch = Schedule::Traced(mod, /*seed=*/-1, /*debug_mask=*/0,
+                                  /*error_render_level=*/s_tir::ScheduleErrorRenderLevel::kNone);
+  auto f_decision_provider = [&sch](const Instruction& inst, const ffi::Array<Any>& inputs,
+                                    const ffi::Array<Any>& attrs, const Any& decision) -> Any {
+    if (!inst->kind.same_as(kind_sample_perfect_tile) || decision == nullptr) {
+      return decision;
+    }
+    const auto* extent = sch->Get(inputs[0].cast<LoopRV>())->extent.as<IntImmNode>();
+    if (extent == nullptr) {
+      // Let the sampling pick new tile sizes for a dynamic extent
+      return Any(nullptr);
+    }
+    std::vector<int64_t> tiles;
+    for (const Integer& tile : decision.cast<ffi::Array<Integer>>()) {
+      tiles.push_back(tile->value);
+    }
+    ffi::Array<Integer> result;
+    for (int64_t tile : RescaleTileSizes(tiles, extent->value)) {
+      result.push_back(Integer(tile));
+    }
+    return result;
+  };
+  try {
+    trace->ApplyToSchedule(sch, /*remove_postproc=*/true, f_decision_provider);
+  } catch (const std::exception& e) {
+    DLOG(WARNING) << "Cannot adapt the trace to the module: " << e.what();
+    return std::nullopt;
+  }
+  return sch->trace().value();
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("s_tir.meta_schedule.ScheduleUsingAnchorTrace", ScheduleUsingAnchorTrace);
+  refl::GlobalDef()
+      .def("s_tir.meta_schedule.ScheduleUsingAnchorTrace", ScheduleUsingAnchorTrace)
+      .def("s_tir.meta_schedule.AdaptTraceToModule", AdaptTraceToModule);
 }
 
 }  // namespace meta_schedule
@@ -43,6 +43,19 @@ namespace meta_schedule {
 void ScheduleUsingAnchorTrace(s_tir::Schedule sch, const s_tir::Trace& anchor_trace,
                               const tvm::Target& target);
 
+/*!
+ * \brief Replay a trace tuned on another workload onto a module whose blocks have the same
+ * structure but different loop extents, e.g. the same dense layer with a different hidden size.
+ * The tile sizes sampled by the trace are rescaled to the loop extents of the new module: each
+ * inner factor becomes the largest divisor of the remaining extent not exceeding the original
+ * factor, and the outermost factor takes what is left.
+ * \param trace The trace to be adapted.
+ * \param mod The module to replay the trace onto.
+ * \return The trace with its decisions adapted to `mod`, without postprocessing instructions, or
+ *  std::nullopt if the trace cannot be replayed onto `mod`.
+ */
+ffi::Optional<s_tir::Trace> AdaptTraceToModule(const s_tir::Trace& trace, const IRModule& mod);
+
 }  // namespace meta_schedule
 }  // namespace s_tir
 }  // namespace tvm
@@ -45,6 +45,8 @@
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -213,6 +215,20 @@ Any JSONLoads(std::string json_str);
  */
 std::string JSONDumps(Any json_obj);
 
+/*!
+ * \brief Encodes a json object in a compact binary form.
+ * \param json_obj The json object.
+ * \return The encoded bytes.
+ */
+std::string BinaryJSONDumps(Any json_obj);
+
+/*!
+ * \brief Decodes a json object encoded by BinaryJSONDumps.
+ * \param bytes The encoded bytes.
+ * \return The json object, with the same value types as those produced by JSONLoads.
+ */
+Any BinaryJSONLoads(const std::string& bytes);
+
 /*!
  * \brief Converts a structural hash code to string
  * \param hash_code The hash code
@@ -301,14 +317,42 @@ inline s_tir::SBlockRV GetRVFromSRef(const s_tir::Schedule& sch, const tir::Stmt
   return sch->GetSBlock(block->name_hint, global_var_name);
 }
 
+/*!
+ * \brief Thread-safe counters of how a search strategy produced its measure candidates,
+ * accumulated since the pre-tuning of the strategy.
+ */
+struct SearchStats {
+  /*! \brief The number of schedules created by replaying a trace. */
+  std::atomic<int64_t> num_sampled{0};
+  /*! \brief The number of sampled schedules rejected by a postprocessor. */
+  std::atomic<int64_t> num_postproc_failed{0};
+  /*! \brief The number of valid schedules dropped as duplicates of another one. */
+  std::atomic<int64_t> num_duplicated{0};
+  /*! \brief The number of schedules returned as measure candidates. */
+  std::atomic<int64_t> num_picked{0};
+
+  /*! \brief The counters keyed by their names. */
+  ffi::Map<ffi::String, int64_t> AsMap() const {
+    return {{"num_sampled", num_sampled.load()},
+            {"num_postproc_failed", num_postproc_failed.load()},
+            {"num_duplicated", num_duplicated.load()},
+            {"num_picked", num_picked.load()}};
+  }
+};
+
 /*!
  * \brief A helper data structure that replays a trace and collects failure counts
  * for each postprocessor
  */
 struct ThreadedTraceApply {
-  /*! \brief Constructor */
-  explicit ThreadedTraceApply(const ffi::Array<Postproc>& postprocs)
-      : n_(postprocs.size()), items_(new Item[n_]) {
+  /*!
+   * \brief Constructor
+   * \param postprocs The postprocessors to apply after the trace.
+   * \param stats The counters to update with every application, or nullptr.
+   */
+  explicit ThreadedTraceApply(const ffi::Array<Postproc>& postprocs,
+                              SearchStats* stats = nullptr)
+      : n_(postprocs.size()), items_(new Item[n_]), stats_(stats) {
     for (int i = 0; i < n_; ++i) {
       items_[i].postproc = postprocs[i];
       items_[i].fail_counter = 0;
@@ -335,6 +379,9 @@ struct ThreadedTraceApply {
 
     trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
     sch->EnterPostproc();
+    if (stats_ != nullptr) {
+      ++stats_->num_sampled;
+    }
 
     for (int i = 0; i < n_; ++i) {
       Item& item = items_[i];
@@ -352,6 +399,9 @@ struct ThreadedTraceApply {
       }
       if (!success) {
         item.fail_counter++;
+        if (stats_ != nullptr) {
+          ++stats_->num_postproc_failed;
+        }
         return std::nullopt;
       }
     }
@@ -385,6 +435,8 @@ struct ThreadedTraceApply {
   int n_;
   /*! \brief The pointer to the list of postprocessor items. */
   Item* items_;
+  /*! \brief The search counters to update, not owned. */
+  SearchStats* stats_;
 };
 
 /*!
@@ -582,6 +634,17 @@ inline double Sum(const ffi::Array<FloatImm>& arr) {
   return sum;
 }
 
+/*!
+ * \brief The mutex guarding the database and the cost model shared by the tasks during tuning.
+ * Search strategies that generate candidates in the background hold it while they query the
+ * database and the cost model, and the task scheduler holds it while the measure callbacks
+ * update them.
+ */
+inline std::mutex& TuningStateMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
 /*! \brief Collecting all the blocks */
 class SBlockCollector : public tir::StmtVisitor {
  public:
@@ -657,6 +657,32 @@ void ConcreteScheduleNode::Unroll(const LoopRV& loop_rv) {
   TVM_TIR_SCHEDULE_END("unroll", this->error_render_level_);
 }
 
+void ConcreteScheduleNode::WarpSpecialize(const LoopRV& loop_rv, int num_producer_threads,
+                                          int num_stages) {
+  TVM_TIR_SCHEDULE_BEGIN();
+  s_tir::WarpSpecialize(state_, this->GetSRef(loop_rv), num_producer_threads, num_stages);
+  this->state_->DebugVerify();
+  TVM_TIR_SCHEDULE_END("warp-specialize", this->error_render_level_);
+}
+
+void ConcreteScheduleNode::DoubleBufferFragments(const LoopRV& loop_rv) {
+  TVM_TIR_SCHEDULE_BEGIN();
+  s_tir::DoubleBufferFragments(state_, this->GetSRef(loop_rv));
+  this->state_->DebugVerify();
+  TVM_TIR_SCHEDULE_END("double-buffer-fragments", this->error_render_level_);
+}
+
+LoopRV ConcreteScheduleNode::MergeKernels(const LoopRV& first_loop_rv,
+                                          const LoopRV& second_loop_rv) {
+  StmtSRef result{nullptr};
+  TVM_TIR_SCHEDULE_BEGIN();
+  result =
+      s_tir::MergeKernels(state_, this->GetSRef(first_loop_rv), this->GetSRef(second_loop_rv));
+  TVM_TIR_SCHEDULE_END("merge-kernels", this->error_render_level_);
+  this->state_->DebugVerify();
+  return CreateRV<LoopRV>(result);
+}
+
 /******** Schedule: Insert cache stages ********/
 
 SBlockRV ConcreteScheduleNode::CacheRead(const SBlockRV& block_rv, int read_buffer_index,
@@ -119,6 +119,9 @@ class ConcreteScheduleNode : public ScheduleNode {
   void Vectorize(const LoopRV& loop_rv) override;
   void Bind(const LoopRV& loop_rv, const ffi::String& thread_axis) override;
   void Unroll(const LoopRV& loop_rv) override;
+  void WarpSpecialize(const LoopRV& loop_rv, int num_producer_threads, int num_stages) override;
+  void DoubleBufferFragments(const LoopRV& loop_rv) override;
+  LoopRV MergeKernels(const LoopRV& first_loop_rv, const LoopRV& second_loop_rv) override;
   /******** Schedule: Insert cache stages ********/
   SBlockRV CacheRead(const SBlockRV& block_rv, int read_buffer_index,
                      const ffi::String& storage_scope,
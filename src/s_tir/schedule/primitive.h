@@ -331,6 +331,41 @@ TVM_DLL void Bind(ScheduleState self, const StmtSRef& loop_sref, const ffi::Stri
  * \param loop_sref The loop to be unrolled
  */
 TVM_DLL void Unroll(ScheduleState self, const StmtSRef& loop_sref);
+/*!
+ * \brief Specialize the warps of a serial loop under the threadIdx.x binding into producers and
+ * consumers. It requires:
+ * 1) The loop is serial, and is under a loop bound to threadIdx.x
+ * 2) The number of producer threads is a positive multiple of the warp size
+ * 3) The number of stages is positive
+ * \param self The state of the schedule
+ * \param loop_sref The sref of the loop to be warp specialized
+ * \param num_producer_threads The number of producer threads
+ * \param num_stages The number of stages of the shared memory buffers
+ */
+TVM_DLL void WarpSpecialize(ScheduleState self, const StmtSRef& loop_sref,
+                            int num_producer_threads, int num_stages);
+/*!
+ * \brief Double buffer the register fragments loaded in a serial loop. It requires:
+ * 1) The loop is serial, and its body is a sequence of statements
+ * 2) The leading statements load register fragments from shared memory, and the rest do not
+ * \param self The state of the schedule
+ * \param loop_sref The sref of the loop whose fragments are double buffered
+ */
+TVM_DLL void DoubleBufferFragments(ScheduleState self, const StmtSRef& loop_sref);
+/*!
+ * \brief Merge two adjacent kernels into one kernel that runs the second after a global barrier.
+ * It requires:
+ * 1) The loops are bound to the same block index with the same range, and are not under another
+ * thread binding
+ * 2) The second loop directly follows the first loop
+ * 3) The nested thread bindings of the kernels match
+ * \param self The state of the schedule
+ * \param first_sref The sref of the outermost loop of the first kernel
+ * \param second_sref The sref of the outermost loop of the second kernel
+ * \return The sref of the outermost loop of the merged kernel
+ */
+TVM_DLL StmtSRef MergeKernels(ScheduleState self, const StmtSRef& first_sref,
+                              const StmtSRef& second_sref);
 /******** Schedule: Insert cache stages ********/
 /*!
  * \brief Create a block that reads a buffer region into a read cache. It requires:
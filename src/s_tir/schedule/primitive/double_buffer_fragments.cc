@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+class DoubleBufferFragmentsError : public ScheduleError {
+ public:
+  explicit DoubleBufferFragmentsError(IRModule mod, For loop, ffi::String reason)
+      : mod_(std::move(mod)), loop_(std::move(loop)), reason_(std::move(reason)) {}
+
+  ffi::String FastErrorString() const final {
+    return "ScheduleError: The fragments of the loop cannot be double buffered because " +
+           std::string(reason_);
+  }
+
+  ffi::String DetailRenderTemplate() const final {
+    return "The fragments of the loop {0} cannot be double buffered because " +
+           std::string(reason_);
+  }
+
+  IRModule mod() const final { return mod_; }
+  ffi::Array<ObjectRef> LocationsOfInterest() const final { return {loop_}; }
+
+ private:
+  IRModule mod_;
+  For loop_;
+  ffi::String reason_;
+};
+
+/*!
+ * \brief Whether a statement of the loop body only loads fragments: all its outermost blocks write
+ *  register level buffers, e.g. the tensor core fragments loaded by ldmatrix, from shared memory.
+ */
+static bool IsFragmentLoad(const Stmt& stmt) {
+  bool has_block = false;
+  bool is_load = true;
+  PreOrderVisit(stmt, [&](const ObjectRef& node) {
+    const auto* block = node.as<SBlockNode>();
+    if (block == nullptr) {
+      return true;
+    }
+    has_block = true;
+    bool reads_shared = false;
+    for (const BufferRegion& read : block->reads) {
+      runtime::StorageScope scope = runtime::StorageScope::Create(read->buffer.scope());
+      reads_shared = reads_shared || scope.rank == runtime::StorageRank::kShared;
+    }
+    bool writes_fragment = !block->writes.empty();
+    for (const BufferRegion& write : block->writes) {
+      switch (runtime::StorageScope::Create(write->buffer.scope()).rank) {
+        case runtime::StorageRank::kWarp:
+        case runtime::StorageRank::kLocal:
+        case runtime::StorageRank::kWMMAMatrixA:
+        case runtime::StorageRank::kWMMAMatrixB:
+        case runtime::StorageRank::kMMAMatrixA:
+        case runtime::StorageRank::kMMAMatrixB:
+          break;
+        default:
+          writes_fragment = false;
+      }
+    }
+    is_load = is_load && reads_shared && writes_fragment;
+    // The blocks nested in a blockized load are covered by its regions.
+    return false;
+  });
+  return has_block && is_load;
+}
+
+void DoubleBufferFragments(ScheduleState self, const StmtSRef& loop_sref) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop_sref);
+  For loop_ref = ffi::GetRef<For>(loop);
+  if (loop->kind != ForKind::kSerial) {
+    throw DoubleBufferFragmentsError(self->mod, loop_ref, "it is not a serial loop");
+  }
+  const auto* seq = loop->body.as<SeqStmtNode>();
+  if (seq == nullptr) {
+    throw DoubleBufferFragmentsError(self->mod, loop_ref,
+                                     "its body is not a sequence of statements");
+  }
+  // The leading statements load the fragments of an iteration, the rest computes with them.
+  int num_loads = 0;
+  while (num_loads < static_cast<int>(seq->seq.size()) && IsFragmentLoad(seq->seq[num_loads])) {
+    ++num_loads;
+  }
+  if (num_loads == 0) {
+    throw DoubleBufferFragmentsError(
+        self->mod, loop_ref,
+        "its body does not start with loads of register fragments from shared memory");
+  }
+  if (num_loads == static_cast<int>(seq->seq.size())) {
+    throw DoubleBufferFragmentsError(self->mod, loop_ref,
+                                     "its body has no statement computing with the fragments");
+  }
+  for (int i = num_loads; i < static_cast<int>(seq->seq.size()); ++i) {
+    if (IsFragmentLoad(seq->seq[i])) {
+      throw DoubleBufferFragmentsError(
+          self->mod, loop_ref, "the loads of register fragments are not before its computation");
+    }
+  }
+  // Loading the fragments one iteration ahead makes InjectSoftwarePipeline allocate two versions
+  // of them, so that iteration k + 1 loads while iteration k computes.
+  ffi::Array<Integer> stages;
+  ffi::Array<Integer> orders;
+  for (int i = 0; i < static_cast<int>(seq->seq.size()); ++i) {
+    stages.push_back(Integer(i < num_loads ? 0 : 1));
+    orders.push_back(Integer(i));
+  }
+  ObjectPtr<ForNode> n = ffi::make_object<ForNode>(*loop);
+  n->annotations.Set(s_tir::attr::software_pipeline_stage, stages);
+  n->annotations.Set(s_tir::attr::software_pipeline_order, orders);
+  self->Replace(loop_sref, For(n), {});
+}
+
+/******** InstructionKind Registration ********/
+
+struct DoubleBufferFragmentsTraits : public UnpackedInstTraits<DoubleBufferFragmentsTraits> {
+  static constexpr const char* kName = "DoubleBufferFragments";
+  static constexpr bool kIsPure = false;
+
+ private:
+  static constexpr size_t kNumInputs = 1;
+  static constexpr size_t kNumAttrs = 0;
+  static constexpr size_t kNumDecisions = 0;
+
+  static void UnpackedApplyToSchedule(Schedule sch, LoopRV loop_rv) {
+    return sch->DoubleBufferFragments(loop_rv);
+  }
+
+  static ffi::String UnpackedAsPython(ffi::Array<ffi::String> outputs, ffi::String loop_rv) {
+    PythonAPICall py("double_buffer_fragments");
+    py.Input("loop", loop_rv);
+    return py.Str();
+  }
+
+  template <typename>
+  friend struct ::tvm::s_tir::UnpackedInstTraits;
+};
+
+TVM_REGISTER_INST_KIND_TRAITS(DoubleBufferFragmentsTraits);
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -0,0 +1,218 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+class MergeKernelsError : public ScheduleError {
+ public:
+  explicit MergeKernelsError(IRModule mod, For first, For second, ffi::String reason)
+      : mod_(std::move(mod)),
+        first_(std::move(first)),
+        second_(std::move(second)),
+        reason_(std::move(reason)) {}
+
+  ffi::String FastErrorString() const final {
+    return "ScheduleError: The kernels cannot be merged because " + std::string(reason_);
+  }
+
+  ffi::String DetailRenderTemplate() const final {
+    return "The kernels of the loops {0} and {1} cannot be merged because " +
+           std::string(reason_);
+  }
+
+  IRModule mod() const final { return mod_; }
+  ffi::Array<ObjectRef> LocationsOfInterest() const final { return {first_, second_}; }
+
+ private:
+  IRModule mod_;
+  For first_;
+  For second_;
+  ffi::String reason_;
+};
+
+/*! \brief Whether two loops are bound to the same thread axis with the same range. */
+bool IsSameThreadBinding(const ForNode* a, const ForNode* b) {
+  arith::Analyzer analyzer;
+  return a->thread_binding.defined() && b->thread_binding.defined() &&
+         a->thread_binding.value()->thread_tag == b->thread_binding.value()->thread_tag &&
+         analyzer.CanProveEqual(a->min, b->min) && analyzer.CanProveEqual(a->extent, b->extent);
+}
+
+/*! \brief Collect the blocks of a statement in pre-order. */
+ffi::Array<SBlock> CollectBlocks(const Stmt& stmt) {
+  ffi::Array<SBlock> blocks;
+  PreOrderVisit(stmt, [&blocks](const ObjectRef& obj) {
+    if (const auto* block = obj.as<SBlockNode>()) {
+      blocks.push_back(ffi::GetRef<SBlock>(block));
+    }
+    return true;
+  });
+  return blocks;
+}
+
+StmtSRef MergeKernels(ScheduleState self, const StmtSRef& first_sref,
+                      const StmtSRef& second_sref) {
+  const ForNode* first = TVM_SREF_TO_FOR(first_sref);
+  const ForNode* second = TVM_SREF_TO_FOR(second_sref);
+  For first_ref = ffi::GetRef<For>(first);
+  For second_ref = ffi::GetRef<For>(second);
+  auto error = [&](const std::string& reason) {
+    return MergeKernelsError(self->mod, first_ref, second_ref, reason);
+  };
+
+  // Step 1. Check that the loops are the outermost thread bindings of two adjacent kernels.
+  if (!first->thread_binding.defined() ||
+      std::string(first->thread_binding.value()->thread_tag).rfind("blockIdx", 0) != 0) {
+    throw error("the first loop is not bound to a block index");
+  }
+  if (!IsSameThreadBinding(first, second)) {
+    throw error("the loops are not bound to the same block index with the same range");
+  }
+  for (const StmtSRefNode* sref = first_sref->parent; sref != nullptr; sref = sref->parent) {
+    const auto* loop = sref->StmtAs<ForNode>();
+    if (loop != nullptr && loop->thread_binding.defined()) {
+      throw error("the loops are under the thread binding of the loop " +
+                  loop->loop_var->name_hint);
+    }
+  }
+  if (first_sref->parent == nullptr || first_sref->parent != second_sref->parent) {
+    throw error("the loops do not have the same parent");
+  }
+  StmtSRef parent_sref = ffi::GetRef<StmtSRef>(first_sref->parent);
+  Stmt parent_body;
+  if (const auto* block = parent_sref->StmtAs<SBlockNode>()) {
+    parent_body = block->body;
+  } else {
+    parent_body = TVM_SREF_TO_FOR(parent_sref)->body;
+  }
+  const auto* seq = parent_body.as<SeqStmtNode>();
+  int index = -1;
+  if (seq != nullptr) {
+    for (int i = 0; i + 1 < static_cast<int>(seq->seq.size()); ++i) {
+      if (seq->seq[i].get() == first && seq->seq[i + 1].get() == second) {
+        index = i;
+        break;
+      }
+    }
+  }
+  if (index == -1) {
+    throw error("the second loop does not directly follow the first loop");
+  }
+
+  // Step 2. Merge the nested thread bindings of the kernels, and run the bodies of the second
+  // kernel after those of the first.
+  ffi::Map<Var, PrimExpr> vmap;
+  ffi::Map<SBlock, SBlock> block_sref_reuse;
+  // The blocks of the second kernel are rewritten to the loop variables of the first one.
+  auto substitute = [&](const Stmt& body) {
+    Stmt new_body = Substitute(body, vmap);
+    ffi::Array<SBlock> old_blocks = CollectBlocks(body);
+    ffi::Array<SBlock> new_blocks = CollectBlocks(new_body);
+    TVM_FFI_ICHECK_EQ(old_blocks.size(), new_blocks.size());
+    for (size_t i = 0; i < old_blocks.size(); ++i) {
+      if (!old_blocks[i].same_as(new_blocks[i])) {
+        block_sref_reuse.Set(old_blocks[i], new_blocks[i]);
+      }
+    }
+    return new_body;
+  };
+  std::function<Stmt(const ForNode*, const ForNode*)> merge = [&](const ForNode* a,
+                                                                  const ForNode* b) -> Stmt {
+    vmap.Set(b->loop_var, a->loop_var);
+    const auto* inner_a = a->body.as<ForNode>();
+    const auto* inner_b = b->body.as<ForNode>();
+    bool bound_a = inner_a != nullptr && inner_a->thread_binding.defined();
+    bool bound_b = inner_b != nullptr && inner_b->thread_binding.defined();
+    Stmt body;
+    if (bound_a && bound_b && IsSameThreadBinding(inner_a, inner_b)) {
+      body = merge(inner_a, inner_b);
+    } else if (bound_a || bound_b) {
+      throw error("the thread bindings of the kernels do not match");
+    } else {
+      body = SeqStmt::Flatten(a->body, substitute(b->body));
+    }
+    ObjectPtr<ForNode> n = ffi::make_object<ForNode>(*a);
+    n->body = std::move(body);
+    return For(n);
+  };
+  For merged = Downcast<For>(merge(first, second));
+  merged.CopyOnWrite()->annotations.Set(s_tir::attr::pragma_global_barrier, Integer(1));
+
+  // Step 3. Replace the two kernels with the merged one.
+  StmtSRef scope_root = GetScopeRoot(self, first_sref, /*require_stage_pipeline=*/false);
+  ffi::Array<Stmt> new_seq;
+  for (int i = 0; i < static_cast<int>(seq->seq.size()); ++i) {
+    if (i == index) {
+      new_seq.push_back(merged);
+    } else if (i != index + 1) {
+      new_seq.push_back(seq->seq[i]);
+    }
+  }
+  Stmt new_body = new_seq.size() == 1 ? new_seq[0] : SeqStmt(new_seq);
+  if (const auto* block = parent_sref->StmtAs<SBlockNode>()) {
+    ObjectPtr<SBlockNode> n = ffi::make_object<SBlockNode>(*block);
+    n->body = std::move(new_body);
+    SBlock new_block(n);
+    block_sref_reuse.Set(ffi::GetRef<SBlock>(block), new_block);
+    self->Replace(parent_sref, new_block, block_sref_reuse);
+  } else {
+    ObjectPtr<ForNode> n = ffi::make_object<ForNode>(*TVM_SREF_TO_FOR(parent_sref));
+    n->body = std::move(new_body);
+    self->Replace(parent_sref, For(n), block_sref_reuse);
+  }
+  self->UpdateScopeSBlockInfo(GetSBlockRealize(self, scope_root));
+  return self->stmt2ref.at(merged.get());
+}
+
+/******** InstructionKind Registration ********/
+
+struct MergeKernelsTraits : public UnpackedInstTraits<MergeKernelsTraits> {
+  static constexpr const char* kName = "MergeKernels";
+  static constexpr bool kIsPure = false;
+
+ private:
+  static constexpr size_t kNumInputs = 2;
+  static constexpr size_t kNumAttrs = 0;
+  static constexpr size_t kNumDecisions = 0;
+
+  static LoopRV UnpackedApplyToSchedule(Schedule sch, LoopRV first_loop_rv,
+                                        LoopRV second_loop_rv) {
+    return sch->MergeKernels(first_loop_rv, second_loop_rv);
+  }
+
+  static ffi::String UnpackedAsPython(ffi::Array<ffi::String> outputs, ffi::String first_loop_rv,
+                                      ffi::String second_loop_rv) {
+    PythonAPICall py("merge_kernels");
+    py.Input("first_loop", first_loop_rv);
+    py.Input("second_loop", second_loop_rv);
+    py.SingleOutput(outputs);
+    return py.Str();
+  }
+
+  template <typename>
+  friend struct ::tvm::s_tir::UnpackedInstTraits;
+};
+
+TVM_REGISTER_INST_KIND_TRAITS(MergeKernelsTraits);
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+class WarpSpecializeError : public ScheduleError {
+ public:
+  explicit WarpSpecializeError(IRModule mod, For loop, ffi::String reason)
+      : mod_(std::move(mod)), loop_(std::move(loop)), reason_(std::move(reason)) {}
+
+  ffi::String FastErrorString() const final {
+    return "ScheduleError: The loop cannot be warp specialized because " + std::string(reason_);
+  }
+
+  ffi::String DetailRenderTemplate() const final {
+    return "The loop {0} cannot be warp specialized because " + std::string(reason_);
+  }
+
+  IRModule mod() const final { return mod_; }
+  ffi::Array<ObjectRef> LocationsOfInterest() const final { return {loop_}; }
+
+ private:
+  IRModule mod_;
+  For loop_;
+  ffi::String reason_;
+};
+
+void WarpSpecialize(ScheduleState self, const StmtSRef& loop_sref, int num_producer_threads,
+                    int num_stages) {
+  const ForNode* loop = TVM_SREF_TO_FOR(loop_sref);
+  For loop_ref = ffi::GetRef<For>(loop);
+  if (loop->kind != ForKind::kSerial) {
+    throw WarpSpecializeError(self->mod, loop_ref, "it is not a serial loop");
+  }
+  if (num_producer_threads <= 0 || num_producer_threads % 32 != 0) {
+    throw WarpSpecializeError(
+        self->mod, loop_ref,
+        "the number of producer threads is not a positive multiple of the warp size, but " +
+            std::to_string(num_producer_threads));
+  }
+  if (num_stages <= 0) {
+    throw WarpSpecializeError(self->mod, loop_ref,
+                              "the number of stages is not positive, but " +
+                                  std::to_string(num_stages));
+  }
+  // The producers are added along threadIdx.x, which has to be bound above the loop.
+  bool under_thread_x = false;
+  for (const StmtSRefNode* sref = loop_sref->parent; sref != nullptr; sref = sref->parent) {
+    const auto* parent = sref->StmtAs<ForNode>();
+    if (parent != nullptr && parent->thread_binding.defined() &&
+        parent->thread_binding.value()->thread_tag == "threadIdx.x") {
+      under_thread_x = true;
+      break;
+    }
+  }
+  if (!under_thread_x) {
+    throw WarpSpecializeError(self->mod, loop_ref, "it is not under a loop bound to threadIdx.x");
+  }
+
+  ObjectPtr<ForNode> n = ffi::make_object<ForNode>(*loop);
+  n->annotations.Set(s_tir::attr::warp_specialize_producer_threads,
+                     Integer(num_producer_threads));
+  n->annotations.Set(s_tir::attr::warp_specialize_num_stages, Integer(num_stages));
+  self->Replace(loop_sref, For(n), {});
+}
+
+/******** InstructionKind Registration ********/
+
+struct WarpSpecializeTraits : public UnpackedInstTraits<WarpSpecializeTraits> {
+  static constexpr const char* kName = "WarpSpecialize";
+  static constexpr bool kIsPure = false;
+
+ private:
+  static constexpr size_t kNumInputs = 1;
+  static constexpr size_t kNumAttrs = 2;
+  static constexpr size_t kNumDecisions = 0;
+
+  static void UnpackedApplyToSchedule(Schedule sch, LoopRV loop_rv, Integer num_producer_threads,
+                                      Integer num_stages) {
+    return sch->WarpSpecialize(loop_rv, num_producer_threads.IntValue(), num_stages.IntValue());
+  }
+
+  static ffi::String UnpackedAsPython(ffi::Array<ffi::String> outputs, ffi::String loop_rv,
+                                      Integer num_producer_threads, Integer num_stages) {
+    PythonAPICall py("warp_specialize");
+    py.Input("loop", loop_rv);
+    py.Input("num_producer_threads", num_producer_threads);
+    py.Input("num_stages", num_stages);
+    return py.Str();
+  }
+
+  template <typename>
+  friend struct ::tvm::s_tir::UnpackedInstTraits;
+};
+
+TVM_REGISTER_INST_KIND_TRAITS(WarpSpecializeTraits);
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -199,7 +199,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def_method("s_tir.schedule.ScheduleParallel", &ScheduleNode::Parallel)
       .def_method("s_tir.schedule.ScheduleVectorize", &ScheduleNode::Vectorize)
       .def_method("s_tir.schedule.ScheduleBind", &ScheduleNode::Bind)
-      .def_method("s_tir.schedule.ScheduleUnroll", &ScheduleNode::Unroll);
+      .def_method("s_tir.schedule.ScheduleUnroll", &ScheduleNode::Unroll)
+      .def_method("s_tir.schedule.ScheduleWarpSpecialize", &ScheduleNode::WarpSpecialize)
+      .def_method("s_tir.schedule.ScheduleDoubleBufferFragments",
+                  &ScheduleNode::DoubleBufferFragments)
+      .def_method("s_tir.schedule.ScheduleMergeKernels", &ScheduleNode::MergeKernels);
 }
 /******** (FFI) Insert cache stages ********/
 TVM_FFI_STATIC_INIT_BLOCK() {
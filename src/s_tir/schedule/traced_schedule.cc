@@ -355,6 +355,41 @@ void TracedScheduleNode::Unroll(const LoopRV& loop_rv) {
                                       /*outputs=*/{}));
 }
 
+void TracedScheduleNode::WarpSpecialize(const LoopRV& loop_rv, int num_producer_threads,
+                                        int num_stages) {
+  ConcreteScheduleNode::WarpSpecialize(loop_rv, num_producer_threads, num_stages);
+
+  static const InstructionKind& kind = InstructionKind::Get("WarpSpecialize");
+  trace_->Append(/*inst=*/Instruction(
+      /*kind=*/kind,
+      /*inputs=*/{loop_rv},
+      /*attrs=*/{Integer(num_producer_threads), Integer(num_stages)},
+      /*outputs=*/{}));
+}
+
+void TracedScheduleNode::DoubleBufferFragments(const LoopRV& loop_rv) {
+  ConcreteScheduleNode::DoubleBufferFragments(loop_rv);
+
+  static const InstructionKind& kind = InstructionKind::Get("DoubleBufferFragments");
+  trace_->Append(/*inst=*/Instruction(
+      /*kind=*/kind,
+      /*inputs=*/{loop_rv},
+      /*attrs=*/{},
+      /*outputs=*/{}));
+}
+
+LoopRV TracedScheduleNode::MergeKernels(const LoopRV& first_loop_rv,
+                                        const LoopRV& second_loop_rv) {
+  LoopRV result = ConcreteScheduleNode::MergeKernels(first_loop_rv, second_loop_rv);
+
+  static const InstructionKind& kind = InstructionKind::Get("MergeKernels");
+  trace_->Append(/*inst=*/Instruction(/*kind=*/kind,
+                                      /*inputs=*/{first_loop_rv, second_loop_rv},
+                                      /*attrs=*/{},
+                                      /*outputs=*/{result}));
+  return result;
+}
+
 /******** Schedule: Insert cache stages ********/
 SBlockRV TracedScheduleNode::CacheRead(const SBlockRV& block_rv, int read_buffer_index,
                                        const ffi::String& storage_scope,
@@ -81,6 +81,9 @@ class TracedScheduleNode : public ConcreteScheduleNode {
   void Vectorize(const LoopRV& loop_rv) final;
   void Bind(const LoopRV& loop_rv, const ffi::String& thread_axis) final;
   void Unroll(const LoopRV& loop_rv) final;
+  void WarpSpecialize(const LoopRV& loop_rv, int num_producer_threads, int num_stages) final;
+  void DoubleBufferFragments(const LoopRV& loop_rv) final;
+  LoopRV MergeKernels(const LoopRV& first_loop_rv, const LoopRV& second_loop_rv) final;
   /******** Schedule: Insert cache stages ********/
   SBlockRV CacheRead(const SBlockRV& block_rv, int read_buffer_index,
                      const ffi::String& storage_scope,
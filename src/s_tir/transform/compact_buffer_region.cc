@@ -22,6 +22,7 @@
  * \brief Compact the buffer size into its exact need.
  */
 
+#include <tvm/arith/analyzer.h>
 #include <tvm/arith/int_set.h>
 #include <tvm/arith/int_solver.h>
 #include <tvm/ffi/reflection/registry.h>
@@ -48,13 +49,13 @@ using support::NDIntSet;
 /*! \brief a more constrained bound estimate for n-dimentional int set */
 NDIntSet NDIntSetEval(Region region, PrimExpr predicate,
                       const std::unordered_map<const VarNode*, arith::IntSet>& dom_map,
-                      arith::Analyzer* analyzer) {
+                      arith::Analyzer* analyzer, arith::ProofStrength strength) {
   std::unordered_map<Var, Range, ObjectPtrHash, ObjectPtrEqual> var_dom;
   for (const auto& it : dom_map) {
     var_dom[ffi::GetRef<Var>(it.first)] = it.second.CoverRange(Range::FromMinExtent(0, 0));
   }
   ffi::Optional<ffi::Array<arith::IntSet>> eval_res =
-      arith::EstimateRegionUpperBound(region, var_dom, predicate, analyzer);
+      arith::EstimateRegionUpperBound(region, var_dom, predicate, analyzer, strength);
 
   if (eval_res.defined()) {
     return NDIntSet(eval_res.value().begin(), eval_res.value().end());
@@ -105,8 +106,8 @@ class Var2BufferCollector : public StmtExprVisitor {
 class BufferAccessRegionCollector : public StmtExprVisitor {
  public:
   static std::unordered_map<Buffer, Region, ObjectPtrHash, ObjectPtrEqual> Collect(
-      const PrimFunc& f, bool collect_inbound) {
-    BufferAccessRegionCollector region_collector(collect_inbound);
+      const PrimFunc& f, bool collect_inbound, arith::ProofStrength strength) {
+    BufferAccessRegionCollector region_collector(collect_inbound, strength);
 
     // collect buffer var to aliased buffer mapping
     Var2BufferCollector var2buffer_collector;
@@ -129,7 +130,8 @@ class BufferAccessRegionCollector : public StmtExprVisitor {
         : buffer(buffer), accessed_region(region) {}
   };
 
-  explicit BufferAccessRegionCollector(bool collect_inbound) : collect_inbound_(collect_inbound) {}
+  explicit BufferAccessRegionCollector(bool collect_inbound, arith::ProofStrength strength)
+      : collect_inbound_(collect_inbound), strength_(strength) {}
 
   /**************** Visitor overload ****************/
 
@@ -377,7 +379,7 @@ class BufferAccessRegionCollector : public StmtExprVisitor {
                             return normalize_pred(x) && normalize_pred(y);
                           }));
       NDIntSet nd_int_set =
-          NDIntSetEval(buffer_region->region, predicate, dom_map_, &dom_analyzer_);
+          NDIntSetEval(buffer_region->region, predicate, dom_map_, &dom_analyzer_, strength_);
 
       // Step 3. Restore the non-relaxed ancestor loops domain
       for (size_t i = 0; i < n_ancestor_loops; ++i) {
@@ -485,6 +487,9 @@ class BufferAccessRegionCollector : public StmtExprVisitor {
   /*! \brief Only collect accessed region within original buffer shape bound. */
   bool collect_inbound_{true};
 
+  /*! \brief The proof strength of the region analysis. */
+  arith::ProofStrength strength_{arith::ProofStrength::kDefault};
+
   /*! \brief The iteration scopes from the current node up to the root. */
   std::vector<IterVar> ancestor_iters_;
 
@@ -744,10 +749,17 @@ Stmt BufferCompactorCompact(
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("s_tir.compact_buffer_region_proof_strength", Integer);
+
 Pass CompactBufferAllocation(bool is_strict) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     PrimFuncNode* fptr = f.CopyOnWrite();
-    auto region = BufferAccessRegionCollector::Collect(f, /*collect_inbound=*/is_strict);
+    auto strength = static_cast<arith::ProofStrength>(
+        ctx->GetConfig<Integer>("s_tir.compact_buffer_region_proof_strength", Integer(0))
+            .value()
+            ->value);
+    auto region =
+        BufferAccessRegionCollector::Collect(f, /*collect_inbound=*/is_strict, strength);
     auto storage_align = CollectStorageAlignAnnotation(f->body);
     fptr->body = BufferCompactorCompact(f, region, storage_align);
     return f;
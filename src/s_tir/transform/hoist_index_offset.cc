@@ -0,0 +1,226 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file hoist_index_offset.cc
+ * \brief Hoist the loop-invariant offsets of the affine buffer indices out of each loop level.
+ */
+#include <tvm/arith/pattern.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/transform.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <functional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+// The flattened index of a buffer access in a loop nest, e.g. i * 256 + j * 16 + k, is
+// recomputed in full at every iteration of the innermost loop. For each loop, the indices that
+// are affine in the loop variable are split into an offset that is invariant in the loop, which
+// is bound by a LetStmt right above the loop, and the scaled loop variable. As the loops are
+// visited from the innermost, the offsets bound for an inner loop are split in turn at the outer
+// levels, so that each loop level only adds its own term to the offset of the enclosing level:
+//
+//   for i:
+//     offset_i = i * 256
+//     for j:
+//       offset_j = offset_i + j * 16
+//       for k:
+//         A[offset_j + k] = ...
+//
+// Only the accesses to global buffers are rewritten, so that the index patterns of the shared,
+// local and warp buffers, on which the lowering of the synchronizations and of the warp memory
+// rely, are kept.
+class LoopOffsetRewriter : public StmtExprMutator {
+ public:
+  LoopOffsetRewriter(Var loop_var, const Stmt& body,
+                     std::unordered_set<const VarNode*>* offset_vars)
+      : loop_var_(std::move(loop_var)), offset_vars_(offset_vars) {
+    PostOrderVisit(body, [this](const ObjectRef& node) {
+      if (const auto* op = node.as<ForNode>()) {
+        inner_vars_.insert(op->loop_var.get());
+      } else if (const auto* op = node.as<LetStmtNode>()) {
+        inner_vars_.insert(op->var.get());
+      } else if (const auto* op = node.as<LetNode>()) {
+        inner_vars_.insert(op->var.get());
+      } else if (const auto* op = node.as<AllocateNode>()) {
+        inner_vars_.insert(op->buffer_var.get());
+      } else if (const auto* op = node.as<AllocateConstNode>()) {
+        inner_vars_.insert(op->buffer_var.get());
+      } else if (const auto* op = node.as<AttrStmtNode>()) {
+        if (const auto* iv = op->node.as<IterVarNode>()) {
+          inner_vars_.insert(iv->var.get());
+        }
+      }
+    });
+  }
+
+  /*! \brief The offsets to bind above the loop, in the order of their creation. */
+  const std::vector<std::pair<Var, PrimExpr>>& hoisted() const { return hoisted_; }
+
+ private:
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    BufferLoad load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    if (load->buffer.scope() == "global") {
+      load.CopyOnWrite()->indices = load->indices.Map([this](PrimExpr e) { return Rewrite(e); });
+    }
+    return load;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    BufferStore store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
+    if (store->buffer.scope() == "global") {
+      store.CopyOnWrite()->indices =
+          store->indices.Map([this](PrimExpr e) { return Rewrite(e); });
+    }
+    return store;
+  }
+
+  Stmt VisitStmt_(const LetStmtNode* op) final {
+    if (!offset_vars_->count(op->var.get())) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    Stmt body = this->VisitStmt(op->body);
+    // The offset of an inner loop that is invariant in this loop moves above it as a whole.
+    if (IsDefinedOutside(op->value) && !UsesVar(op->value, IsLoopVar())) {
+      hoisted_.emplace_back(op->var, op->value);
+      return body;
+    }
+    PrimExpr value = Rewrite(op->value);
+    if (value.same_as(op->value) && body.same_as(op->body)) {
+      return ffi::GetRef<Stmt>(op);
+    }
+    return LetStmt(op->var, value, body, op->span);
+  }
+
+  /*! \brief Split an index that is affine in the loop variable into a hoisted offset and the
+   *  scaled loop variable. */
+  PrimExpr Rewrite(const PrimExpr& index) {
+    if (const auto* ramp = index.as<RampNode>()) {
+      PrimExpr base = Rewrite(ramp->base);
+      return base.same_as(ramp->base) ? index : Ramp(base, ramp->stride, ramp->lanes);
+    }
+    if (index.dtype() != loop_var_.dtype() || !IsDefinedOutside(index) ||
+        !UsesVar(index, IsLoopVar())) {
+      return index;
+    }
+    ffi::Array<PrimExpr> coeffs = arith::DetectLinearEquation(index, {loop_var_});
+    if (coeffs.size() != 2 || !coeffs[0].defined() || !coeffs[1].defined()) {
+      return index;
+    }
+    PrimExpr coeff = coeffs[0];
+    PrimExpr base = coeffs[1];
+    const int64_t* scale = as_const_int(coeff);
+    // Nothing is saved by hoisting a base that is a single variable or constant.
+    if (scale == nullptr || *scale == 0 || base.as<VarNode>() || base.as<IntImmNode>() ||
+        UsesVar(base, IsLoopVar()) || SideEffect(base) > CallEffectKind::kPure) {
+      return index;
+    }
+    Var offset = GetOffset(base);
+    return *scale == 1 ? offset + loop_var_ : offset + loop_var_ * coeff;
+  }
+
+  /*! \brief Get the variable of a hoisted offset, creating it if needed. */
+  Var GetOffset(const PrimExpr& base) {
+    for (const auto& [var, value] : hoisted_) {
+      if (ExprDeepEqual()(value, base)) {
+        return var;
+      }
+    }
+    Var offset("offset", base.dtype());
+    hoisted_.emplace_back(offset, base);
+    offset_vars_->insert(offset.get());
+    return offset;
+  }
+
+  /*! \brief Whether the expression only uses the variables defined outside the loop. */
+  bool IsDefinedOutside(const PrimExpr& e) const {
+    return !UsesVar(e, [this](const VarNode* var) { return inner_vars_.count(var) != 0; });
+  }
+
+  std::function<bool(const VarNode*)> IsLoopVar() const {
+    return [this](const VarNode* var) { return var == loop_var_.get(); };
+  }
+
+  /*! \brief The loop variable. */
+  Var loop_var_;
+  /*! \brief The variables defined in the body of the loop. */
+  std::unordered_set<const VarNode*> inner_vars_;
+  /*! \brief The variables of the offsets bound by this pass. */
+  std::unordered_set<const VarNode*>* offset_vars_;
+  /*! \brief The offsets to bind above the loop. */
+  std::vector<std::pair<Var, PrimExpr>> hoisted_;
+};
+
+class IndexOffsetHoister : public StmtExprMutator {
+ public:
+  static Stmt Hoist(Stmt stmt) { return IndexOffsetHoister()(std::move(stmt)); }
+
+ private:
+  Stmt VisitStmt_(const ForNode* op) final {
+    For loop = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    if ((loop->kind != ForKind::kSerial && loop->kind != ForKind::kUnrolled) ||
+        !loop->loop_var.dtype().is_int()) {
+      return loop;
+    }
+    LoopOffsetRewriter rewriter(loop->loop_var, loop->body, &offset_vars_);
+    Stmt body = rewriter(loop->body);
+    if (rewriter.hoisted().empty()) {
+      return loop;
+    }
+    loop.CopyOnWrite()->body = body;
+    Stmt stmt = loop;
+    for (auto it = rewriter.hoisted().rbegin(); it != rewriter.hoisted().rend(); ++it) {
+      stmt = LetStmt(it->first, it->second, stmt);
+    }
+    return stmt;
+  }
+
+  /*! \brief The variables of the offsets bound by this pass. */
+  std::unordered_set<const VarNode*> offset_vars_;
+};
+
+namespace transform {
+
+Pass HoistIndexOffset() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = IndexOffsetHoister::Hoist(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.HoistIndexOffset", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.transform.HoistIndexOffset", HoistIndexOffset);
+}
+
+}  // namespace transform
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -0,0 +1,222 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inject_software_prefetch.cc
+ * \brief Prefetch the global buffer loads of the annotated CPU loops a number of iterations ahead.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/stmt.h>
+#include <tvm/s_tir/transform.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+/*!
+ * \brief Collect the global buffer loads in a loop body whose address only depends on the loop
+ *  variable and the variables defined outside the loop. The vectorized loops of the body become
+ *  ramps of the indices later, and the loads in them are collected at their first lane.
+ */
+class PrefetchCandidateCollector : public StmtExprVisitor {
+ public:
+  static std::vector<BufferLoad> Collect(const Var& loop_var, const Stmt& body) {
+    PrefetchCandidateCollector collector(loop_var);
+    PostOrderVisit(body, [&collector](const ObjectRef& node) {
+      if (const auto* op = node.as<ForNode>()) {
+        if (op->kind == ForKind::kVectorized) {
+          collector.vectorized_vars_.Set(op->loop_var, op->min);
+        } else {
+          collector.inner_vars_.insert(op->loop_var.get());
+        }
+      } else if (const auto* op = node.as<LetStmtNode>()) {
+        collector.inner_vars_.insert(op->var.get());
+      } else if (const auto* op = node.as<LetNode>()) {
+        collector.inner_vars_.insert(op->var.get());
+      }
+    });
+    collector(body);
+    return std::move(collector.loads_);
+  }
+
+ private:
+  explicit PrefetchCandidateCollector(Var loop_var) : loop_var_(std::move(loop_var)) {}
+
+  void VisitStmt_(const IfThenElseNode* op) final {
+    this->VisitExpr(op->condition);
+    ++conditional_depth_;
+    this->VisitStmt(op->then_case);
+    if (op->else_case) {
+      this->VisitStmt(op->else_case.value());
+    }
+    --conditional_depth_;
+  }
+
+  void VisitExpr_(const SelectNode* op) final {
+    this->VisitExpr(op->condition);
+    ++conditional_depth_;
+    this->VisitExpr(op->true_value);
+    this->VisitExpr(op->false_value);
+    --conditional_depth_;
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (!op->op.same_as(builtin::if_then_else())) {
+      StmtExprVisitor::VisitExpr_(op);
+      return;
+    }
+    this->VisitExpr(op->args[0]);
+    ++conditional_depth_;
+    this->VisitExpr(op->args[1]);
+    this->VisitExpr(op->args[2]);
+    --conditional_depth_;
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    StmtExprVisitor::VisitExpr_(op);
+    if (op->buffer.scope() != "global" || op->indices.empty()) {
+      return;
+    }
+    BufferLoad load = ffi::GetRef<BufferLoad>(op);
+    if (!vectorized_vars_.empty()) {
+      load.CopyOnWrite()->indices = load->indices.Map([this](const PrimExpr& index) {
+        return analyzer_.Simplify(Substitute(index, vectorized_vars_));
+      });
+    }
+    // The loads in the index of a prefetch run in the prefetched iteration, which is not safe
+    // if the original load is guarded by a condition.
+    bool has_load = false;
+    for (const PrimExpr& index : load->indices) {
+      if (!index.dtype().is_int() && !index.dtype().is_uint()) {
+        return;
+      }
+      if (UsesVar(index, [this](const VarNode* var) { return inner_vars_.count(var) != 0; })) {
+        return;
+      }
+      PostOrderVisit(index, [&has_load](const ObjectRef& node) {
+        if (node.as<BufferLoadNode>()) has_load = true;
+      });
+    }
+    if (has_load && conditional_depth_ > 0) {
+      return;
+    }
+    if (!UsesVar(load, [this](const VarNode* var) { return var == loop_var_.get(); })) {
+      return;
+    }
+    for (const BufferLoad& other : loads_) {
+      if (other->buffer.same_as(load->buffer) && ExprDeepEqual()(other, load)) {
+        return;
+      }
+    }
+    loads_.push_back(load);
+  }
+
+  /*! \brief The loop variable. */
+  Var loop_var_;
+  /*! \brief The variables defined in the loop body, except the vectorized loops. */
+  std::unordered_set<const VarNode*> inner_vars_;
+  /*! \brief The vectorized loops of the loop body, mapped to their first iteration. */
+  ffi::Map<Var, PrimExpr> vectorized_vars_;
+  /*! \brief The analyzer simplifying the indices at the first lane. */
+  arith::Analyzer analyzer_;
+  /*! \brief The number of conditions the visitor is under. */
+  int conditional_depth_{0};
+  /*! \brief The loads to prefetch, in the order of their first use. */
+  std::vector<BufferLoad> loads_;
+};
+
+class SoftwarePrefetchInjector : public StmtExprMutator {
+ private:
+  Stmt VisitStmt_(const ForNode* op) final {
+    For loop = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    auto distance = loop->annotations.Get(s_tir::attr::software_prefetch_distance);
+    if (!distance) {
+      return loop;
+    }
+    loop.CopyOnWrite()->annotations.erase(s_tir::attr::software_prefetch_distance);
+    const auto* imm = distance.value().as<IntImmNode>();
+    TVM_FFI_ICHECK(imm) << "The prefetch distance of the loop " << loop->loop_var
+                        << " is expected to be an integer, but got " << distance.value();
+    if (imm->value <= 0 || (loop->kind != ForKind::kSerial && loop->kind != ForKind::kParallel &&
+                            loop->kind != ForKind::kUnrolled)) {
+      return loop;
+    }
+    std::vector<BufferLoad> loads = PrefetchCandidateCollector::Collect(loop->loop_var, loop->body);
+    if (loads.empty()) {
+      return loop;
+    }
+    // Prefetch the loads of `distance` iterations later, clamped to the last iteration so that
+    // the loads in the indices stay within the loop range.
+    const Var& v = loop->loop_var;
+    PrimExpr ahead = min(v + make_const(v.dtype(), imm->value), loop->min + loop->extent - 1);
+    ffi::Array<Stmt> seq;
+    for (const BufferLoad& load : loads) {
+      ffi::Array<PrimExpr> indices = load->indices.Map([&](const PrimExpr& index) {
+        PrimExpr scalar = index.as<RampNode>() ? index.as<RampNode>()->base : index;
+        return Substitute(scalar, {{v, ahead}});
+      });
+      PrimExpr address = Call(DataType::Handle(), builtin::address_of(),
+                              {BufferLoad(load->buffer, indices)});
+      seq.push_back(Evaluate(Call(DataType::Int(32), builtin::prefetch(),
+                                  {address, make_const(DataType::Int(32), 0),
+                                   make_const(DataType::Int(32), 3),
+                                   make_const(DataType::Int(32), 1)})));
+    }
+    seq.push_back(loop->body);
+    loop.CopyOnWrite()->body = SeqStmt::Flatten(seq);
+    return loop;
+  }
+};
+
+namespace transform {
+
+Pass InjectSoftwarePrefetch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    // Only the CPU backends lower the prefetch builtin.
+    if (auto target = f->GetAttr<Target>(tvm::attr::kTarget)) {
+      if (target.value()->GetTargetDeviceType() != kDLCPU) {
+        return f;
+      }
+    }
+    auto* n = f.CopyOnWrite();
+    n->body = SoftwarePrefetchInjector()(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.InjectSoftwarePrefetch", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.transform.InjectSoftwarePrefetch", InjectSoftwarePrefetch);
+}
+
+}  // namespace transform
+
+}  // namespace s_tir
+}  // namespace tvm
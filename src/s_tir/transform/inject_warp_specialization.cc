@@ -0,0 +1,788 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inject_warp_specialization.cc
+ * \brief Split the threads of a kernel into producer warps, which run the copies of a loop into
+ *  shared memory, and consumer warps, which run the rest of the kernel, synchronized by mbarriers.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/stmt.h>
+#include <tvm/s_tir/transform.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../../tir/transform/ir_utils.h"
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+namespace {
+
+bool IsSharedScope(const Var& buffer_var) {
+  ffi::String scope = GetPtrStorageScope(buffer_var);
+  return scope == "shared" || scope == "shared.dyn";
+}
+
+bool IsSharedSync(const CallNode* call) {
+  if (!call->op.same_as(builtin::tvm_storage_sync())) return false;
+  const auto* scope = call->args[0].as<StringImmNode>();
+  return scope && (scope->value == "shared" || scope->value == "shared.dyn");
+}
+
+Stmt StorageSync() {
+  return Evaluate(Call(DataType::Int(32), builtin::tvm_storage_sync(), {StringImm("shared")}));
+}
+
+Stmt BarrierCall(const Op& op, ffi::Array<PrimExpr> args) {
+  return Evaluate(Call(DataType::Void(), op, std::move(args)));
+}
+
+/*!
+ * \brief The (pointer, offset) argument indices of the intrinsics that address shared memory by
+ *  its data pointer and an offset in elements of the allocation.
+ */
+std::pair<int, int> GetPointerOffsetArgs(const CallNode* call) {
+  if (call->op.same_as(builtin::ptx_tma_load()) || call->op.same_as(builtin::ptx_cp_async()) ||
+      call->op.same_as(builtin::ptx_cp_async_bulk())) {
+    return {0, 1};
+  }
+  if (call->op.same_as(builtin::ptx_ldmatrix())) {
+    return {5, 6};
+  }
+  return {-1, -1};
+}
+
+/*! \brief Replace the body of a single-body statement. */
+Stmt ReplaceBody(const Stmt& stmt, Stmt body) {
+  if (const auto* op = stmt.as<ForNode>()) {
+    For n = ffi::GetRef<For>(op);
+    n.CopyOnWrite()->body = std::move(body);
+    return n;
+  } else if (const auto* op = stmt.as<LetStmtNode>()) {
+    LetStmt n = ffi::GetRef<LetStmt>(op);
+    n.CopyOnWrite()->body = std::move(body);
+    return n;
+  } else if (const auto* op = stmt.as<AttrStmtNode>()) {
+    AttrStmt n = ffi::GetRef<AttrStmt>(op);
+    n.CopyOnWrite()->body = std::move(body);
+    return n;
+  } else if (const auto* op = stmt.as<AllocateNode>()) {
+    Allocate n = ffi::GetRef<Allocate>(op);
+    n.CopyOnWrite()->body = std::move(body);
+    return n;
+  } else if (const auto* op = stmt.as<DeclBufferNode>()) {
+    DeclBuffer n = ffi::GetRef<DeclBuffer>(op);
+    n.CopyOnWrite()->body = std::move(body);
+    return n;
+  }
+  TVM_FFI_THROW(InternalError) << "Unexpected statement " << stmt->GetTypeKey();
+}
+
+/*! \brief Whether a statement of the loop body is a copy from global to shared memory. */
+class ProducerDetector : public StmtExprVisitor {
+ public:
+  /*! \brief Return the shared memory buffers the statement copies into, or nothing. */
+  static std::vector<Var> Detect(const Stmt& stmt) {
+    ProducerDetector detector;
+    detector(stmt);
+    if (!detector.is_copy_ || detector.written_.empty()) return {};
+    return detector.written_;
+  }
+
+ private:
+  void VisitStmt_(const BufferStoreNode* op) final {
+    if (IsSharedScope(op->buffer->data)) {
+      AddWritten(op->buffer->data);
+    } else {
+      is_copy_ = false;
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    ffi::String scope = GetPtrStorageScope(op->buffer->data);
+    if (scope != "global" && scope != "") {
+      is_copy_ = false;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::ptx_tma_load())) {
+      const auto* shared = op->args[0].as<VarNode>();
+      TVM_FFI_ICHECK(shared) << "ptx_tma_load expects a shared memory pointer";
+      AddWritten(ffi::GetRef<Var>(shared));
+    } else if (SideEffect(ffi::GetRef<Call>(op)) > CallEffectKind::kReadState) {
+      is_copy_ = false;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void AddWritten(const Var& var) {
+    for (const Var& written : written_) {
+      if (written.same_as(var)) return;
+    }
+    written_.push_back(var);
+  }
+
+  bool is_copy_ = true;
+  std::vector<Var> written_;
+};
+
+/*! \brief The shared memory buffer with a version for each stage. */
+struct StagedBuffer {
+  /*! \brief The bytes of a stage. */
+  int64_t stage_bytes;
+  /*! \brief The dtype of the allocation. */
+  DataType alloc_dtype;
+};
+
+/*! \brief Get the staged version of a buffer, whose shape covers all the stages. */
+Buffer RemapStagedBuffer(const Buffer& buffer,
+                         const std::unordered_map<const VarNode*, StagedBuffer>& staged,
+                         int num_stages, std::unordered_map<const BufferNode*, Buffer>* remap) {
+  auto it = remap->find(buffer.get());
+  if (it != remap->end()) return it->second;
+  TVM_FFI_ICHECK_EQ(buffer->shape.size(), 1U)
+      << "InjectWarpSpecialization expects the flattened buffer " << buffer->name;
+  int64_t stage_elems = staged.at(buffer->data.get()).stage_bytes / buffer->dtype.bytes();
+  Buffer new_buffer = buffer;
+  new_buffer.CopyOnWrite()->shape = {
+      buffer->shape[0] + IntImm(buffer->shape[0].dtype(), stage_elems * (num_stages - 1))};
+  remap->emplace(buffer.get(), new_buffer);
+  return new_buffer;
+}
+
+/*!
+ * \brief Rewrite the accesses of the staged buffers in the loop body to the version of the stage,
+ *  and for the producers, make the async copies complete on the barrier of the stage.
+ */
+class StageRewriter : public StmtExprMutator {
+ public:
+  StageRewriter(const std::unordered_map<const VarNode*, StagedBuffer>* staged,
+                std::unordered_map<const BufferNode*, Buffer>* buffer_remap,
+                int num_stages, PrimExpr stage, ffi::Optional<PrimExpr> full_barrier)
+      : staged_(staged),
+        buffer_remap_(buffer_remap),
+        num_stages_(num_stages),
+        stage_(std::move(stage)),
+        full_barrier_(std::move(full_barrier)) {}
+
+ private:
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    BufferStore store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
+    if (staged_->count(store->buffer->data.get())) {
+      auto* n = store.CopyOnWrite();
+      n->indices = OffsetIndices(store->buffer, store->indices);
+      n->buffer = RemapStagedBuffer(store->buffer, *staged_, num_stages_, buffer_remap_);
+    }
+    return store;
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    BufferLoad load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    if (staged_->count(load->buffer->data.get())) {
+      auto* n = load.CopyOnWrite();
+      n->indices = OffsetIndices(load->buffer, load->indices);
+      n->buffer = RemapStagedBuffer(load->buffer, *staged_, num_stages_, buffer_remap_);
+    }
+    return load;
+  }
+
+  PrimExpr VisitExpr_(const VarNode* op) final {
+    TVM_FFI_ICHECK(!staged_->count(op))
+        << "InjectWarpSpecialization cannot give a version to each stage of " << op->name_hint
+        << ", whose pointer is used directly";
+    return ffi::GetRef<Var>(op);
+  }
+
+  PrimExpr VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::tvm_access_ptr())) {
+      const auto* data = op->args[1].as<VarNode>();
+      if (data && staged_->count(data)) {
+        DataType dtype = op->args[0].dtype();
+        PrimExpr offset = this->VisitExpr(op->args[2]);
+        return Call(op->dtype, op->op,
+                    {op->args[0], op->args[1], offset + StageOffset(data, dtype, offset.dtype()),
+                     this->VisitExpr(op->args[3]), op->args[4]},
+                    op->span);
+      }
+    }
+    Call call = ffi::GetRef<Call>(op);
+    auto [ptr_index, offset_index] = GetPointerOffsetArgs(op);
+    const VarNode* ptr = ptr_index >= 0 ? op->args[ptr_index].as<VarNode>() : nullptr;
+    if (ptr && staged_->count(ptr)) {
+      ffi::Array<PrimExpr> args;
+      for (int i = 0; i < static_cast<int>(op->args.size()); ++i) {
+        args.push_back(i == ptr_index ? op->args[i] : this->VisitExpr(op->args[i]));
+      }
+      const StagedBuffer& info = staged_->at(ptr);
+      PrimExpr offset = args[offset_index];
+      args.Set(offset_index, offset + StageOffset(ptr, info.alloc_dtype, offset.dtype()));
+      call = Call(op->dtype, op->op, args, op->span);
+    } else {
+      call = Downcast<Call>(StmtExprMutator::VisitExpr_(op));
+    }
+    if (full_barrier_.defined()) {
+      if (call->op.same_as(builtin::ptx_tma_load())) {
+        call.CopyOnWrite()->args.Set(3, full_barrier_.value());
+      } else if (call->op.same_as(builtin::ptx_cp_async_bulk())) {
+        call.CopyOnWrite()->args.Set(5, full_barrier_.value());
+      }
+    }
+    return call;
+  }
+
+  Stmt VisitStmt_(const EvaluateNode* op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    const auto* call = Downcast<Evaluate>(stmt)->value.as<CallNode>();
+    if (!full_barrier_.defined() || call == nullptr) {
+      return stmt;
+    }
+    // The async copies add their bytes to the transactions the barrier of the stage waits for.
+    PrimExpr bytes;
+    if (call->op.same_as(builtin::ptx_tma_load())) {
+      int rank = Downcast<IntImm>(call->args[5])->value;
+      int64_t box_bytes = call->dtype.bytes();
+      for (int i = 0; i < rank; ++i) {
+        box_bytes *= Downcast<IntImm>(call->args[6 + rank + i])->value;
+      }
+      bytes = IntImm(DataType::Int(32), box_bytes);
+    } else if (call->op.same_as(builtin::ptx_cp_async_bulk())) {
+      bytes = cast(DataType::Int(32), call->args[4]);
+    } else {
+      return stmt;
+    }
+    return SeqStmt(
+        {BarrierCall(builtin::ptx_barrier_expect_tx(), {full_barrier_.value(), bytes}), stmt});
+  }
+
+  PrimExpr StageOffset(const VarNode* data, DataType unit, DataType index_dtype) {
+    const StagedBuffer& info = staged_->at(data);
+    TVM_FFI_ICHECK_EQ(info.stage_bytes % unit.bytes(), 0)
+        << "The stage of " << data->name_hint << " is not a multiple of the " << unit
+        << " elements that access it";
+    return cast(index_dtype, stage_) * IntImm(index_dtype, info.stage_bytes / unit.bytes());
+  }
+
+  ffi::Array<PrimExpr> OffsetIndices(const Buffer& buffer, const ffi::Array<PrimExpr>& indices) {
+    TVM_FFI_ICHECK_EQ(indices.size(), 1U)
+        << "InjectWarpSpecialization expects the flattened buffer " << buffer->name;
+    PrimExpr index = indices[0];
+    DataType unit = buffer->dtype.with_lanes(1);
+    if (const auto* ramp = index.as<RampNode>()) {
+      PrimExpr base = ramp->base + StageOffset(buffer->data.get(), unit, ramp->base.dtype());
+      return {Ramp(base, ramp->stride, ramp->lanes)};
+    }
+    return {index + StageOffset(buffer->data.get(), unit, index.dtype())};
+  }
+
+  const std::unordered_map<const VarNode*, StagedBuffer>* staged_;
+  std::unordered_map<const BufferNode*, Buffer>* buffer_remap_;
+  int num_stages_;
+  PrimExpr stage_;
+  ffi::Optional<PrimExpr> full_barrier_;
+};
+
+/*! \brief Rewrite the shared memory barriers of a role into named barriers of its threads. */
+class NamedBarrierRewriter : public StmtExprMutator {
+ public:
+  NamedBarrierRewriter(int barrier_id, int thread_count)
+      : barrier_id_(barrier_id), thread_count_(thread_count) {}
+
+ private:
+  PrimExpr VisitExpr_(const CallNode* op) final {
+    if (IsSharedSync(op)) {
+      return Call(DataType::Void(), builtin::ptx_bar_sync(),
+                  {IntImm(DataType::Int(32), barrier_id_),
+                   IntImm(DataType::Int(32), thread_count_)});
+    }
+    return StmtExprMutator::VisitExpr_(op);
+  }
+
+  int barrier_id_;
+  int thread_count_;
+};
+
+/*! \brief Remove the shared memory allocations, to declare them before the roles split. */
+class SharedAllocationHoister : public StmtExprMutator {
+ public:
+  std::vector<Allocate> allocs;
+  std::vector<DeclBuffer> decls;
+
+ private:
+  Stmt VisitStmt_(const AllocateNode* op) final {
+    if (!IsSharedScope(op->buffer_var)) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    TVM_FFI_ICHECK_GT(op->ConstantAllocationSize(), 0)
+        << "InjectWarpSpecialization expects the shared memory allocation " << op->buffer_var
+        << " to have a constant size";
+    allocs.push_back(ffi::GetRef<Allocate>(op));
+    hoisted_.insert(op->buffer_var.get());
+    return this->VisitStmt(op->body);
+  }
+
+  Stmt VisitStmt_(const DeclBufferNode* op) final {
+    if (!IsSharedScope(op->buffer->data)) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    decls.push_back(ffi::GetRef<DeclBuffer>(op));
+    return this->VisitStmt(op->body);
+  }
+
+  std::unordered_set<const VarNode*> hoisted_;
+};
+
+/*! \brief Remove the nested bindings of threadIdx.x, using the variable of the outermost one. */
+class ThreadBindingRemover : public StmtExprMutator {
+ public:
+  explicit ThreadBindingRemover(Var thread_var) : thread_var_(std::move(thread_var)) {}
+
+ private:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      if (iv->thread_tag == "threadIdx.x") {
+        Stmt body = this->VisitStmt(op->body);
+        if (!iv->var.same_as(thread_var_)) {
+          body = Substitute(body, ffi::Map<Var, PrimExpr>{{iv->var, thread_var_}});
+        }
+        return body;
+      }
+    }
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Var thread_var_;
+};
+
+/*! \brief Replace a loop by another statement. */
+class LoopReplacer : public StmtExprMutator {
+ public:
+  LoopReplacer(const ForNode* loop, Stmt new_stmt) : loop_(loop), new_stmt_(std::move(new_stmt)) {}
+
+ private:
+  Stmt VisitStmt_(const ForNode* op) final {
+    if (op == loop_) return new_stmt_;
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  const ForNode* loop_;
+  Stmt new_stmt_;
+};
+
+/*! \brief Find the warp specialized loop, and the statements from the kernel body to it. */
+class LoopFinder : public StmtVisitor {
+ public:
+  const ForNode* loop = nullptr;
+  std::vector<const StmtNode*> path;
+
+ private:
+  void VisitStmt(const Stmt& stmt) final {
+    stack_.push_back(stmt.get());
+    StmtVisitor::VisitStmt(stmt);
+    stack_.pop_back();
+  }
+
+  void VisitStmt_(const ForNode* op) final {
+    if (op->annotations.count(s_tir::attr::warp_specialize_producer_threads)) {
+      TVM_FFI_ICHECK(loop == nullptr)
+          << "InjectWarpSpecialization expects one warp specialized loop in a kernel";
+      loop = op;
+      path = stack_;
+      return;
+    }
+    StmtVisitor::VisitStmt_(op);
+  }
+
+  std::vector<const StmtNode*> stack_;
+};
+
+/*! \brief Check that the staged buffers are not accessed outside the warp specialized loop. */
+class OutsideAccessChecker : public StmtExprVisitor {
+ public:
+  OutsideAccessChecker(const ForNode* loop,
+                       const std::unordered_map<const VarNode*, StagedBuffer>* staged)
+      : loop_(loop), staged_(staged) {}
+
+ private:
+  void VisitStmt_(const ForNode* op) final {
+    if (op != loop_) StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitStmt_(const BufferStoreNode* op) final {
+    Check(op->buffer->data.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitExpr_(const BufferLoadNode* op) final {
+    Check(op->buffer->data.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+  void VisitExpr_(const VarNode* op) final { Check(op); }
+
+  void Check(const VarNode* var) {
+    TVM_FFI_ICHECK(!staged_->count(var))
+        << "InjectWarpSpecialization expects the shared memory buffer " << var->name_hint
+        << " written by the producers to be only accessed in the warp specialized loop";
+  }
+
+  const ForNode* loop_;
+  const std::unordered_map<const VarNode*, StagedBuffer>* staged_;
+};
+
+}  // namespace
+
+class WarpSpecializer : public StmtExprMutator {
+ private:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key != tir::attr::thread_extent) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    IterVar iv = Downcast<IterVar>(op->node);
+    if (iv->thread_tag != "threadIdx.x") {
+      if (iv->thread_tag == "threadIdx.y" || iv->thread_tag == "threadIdx.z") {
+        other_thread_dims_.push_back(iv->thread_tag);
+        Stmt stmt = StmtExprMutator::VisitStmt_(op);
+        other_thread_dims_.pop_back();
+        return stmt;
+      }
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    LoopFinder finder;
+    finder(op->body);
+    if (finder.loop == nullptr) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    return Specialize(op);
+  }
+
+  Stmt Specialize(const AttrStmtNode* op) {
+    IterVar iv = Downcast<IterVar>(op->node);
+    Var tx = iv->var;
+    const auto* extent = op->value.as<IntImmNode>();
+    TVM_FFI_ICHECK(extent) << "InjectWarpSpecialization expects a constant threadIdx.x extent";
+    TVM_FFI_ICHECK(other_thread_dims_.empty())
+        << "InjectWarpSpecialization expects the threads to be only bound to threadIdx.x, but "
+        << other_thread_dims_[0] << " is used";
+    int num_consumers = extent->value;
+    TVM_FFI_ICHECK_EQ(num_consumers % 32, 0)
+        << "InjectWarpSpecialization expects the threadIdx.x extent to be a multiple of the warp "
+           "size, but got "
+        << num_consumers;
+    PostOrderVisit(op->body, [](const ObjectRef& node) {
+      if (const auto* attr = node.as<AttrStmtNode>()) {
+        if (attr->attr_key == tir::attr::thread_extent) {
+          std::string tag = Downcast<IterVar>(attr->node)->thread_tag;
+          TVM_FFI_ICHECK(tag != "threadIdx.y" && tag != "threadIdx.z")
+              << "InjectWarpSpecialization expects the threads to be only bound to threadIdx.x, "
+                 "but "
+              << tag << " is used";
+        }
+      } else if (const auto* call = node.as<CallNode>()) {
+        TVM_FFI_ICHECK(!call->op.same_as(builtin::create_barriers()))
+            << "InjectWarpSpecialization expects the kernel not to create its own barriers";
+      }
+    });
+
+    // Step 1. Drop the nested bindings of threadIdx.x, whose extent is about to change, and
+    // hoist the shared memory allocations so that both roles use the same buffers.
+    Stmt body = ThreadBindingRemover(tx)(op->body);
+    SharedAllocationHoister hoister;
+    body = hoister(body);
+
+    LoopFinder finder;
+    finder(body);
+    const ForNode* loop = finder.loop;
+    int num_producers =
+        Downcast<Integer>(loop->annotations.at(s_tir::attr::warp_specialize_producer_threads))
+            ->value;
+    int num_stages = 2;
+    if (auto stages = loop->annotations.Get(s_tir::attr::warp_specialize_num_stages)) {
+      num_stages = Downcast<Integer>(stages.value())->value;
+    }
+    TVM_FFI_ICHECK(num_producers > 0 && num_producers % 32 == 0)
+        << "InjectWarpSpecialization expects the number of producer threads to be a positive "
+           "multiple of the warp size, but got "
+        << num_producers;
+    TVM_FFI_ICHECK_GT(num_stages, 0);
+    TVM_FFI_ICHECK(loop->HasTrivialStep())
+        << "InjectWarpSpecialization expects the warp specialized loop to have unit step";
+    TVM_FFI_ICHECK(!UsesVar(loop->min, [&](const VarNode* v) { return v == tx.get(); }) &&
+                   !UsesVar(loop->extent, [&](const VarNode* v) { return v == tx.get(); }))
+        << "InjectWarpSpecialization expects the warp specialized loop to run the same "
+           "iterations on all threads";
+
+    // Step 2. Split the loop body into the copies into shared memory and the rest.
+    std::vector<Stmt> loop_wrappers;
+    Stmt seq_stmt = loop->body;
+    while (seq_stmt->IsInstance<LetStmtNode>() || seq_stmt->IsInstance<AttrStmtNode>() ||
+           seq_stmt->IsInstance<AllocateNode>() || seq_stmt->IsInstance<DeclBufferNode>()) {
+      loop_wrappers.push_back(seq_stmt);
+      if (const auto* let = seq_stmt.as<LetStmtNode>()) {
+        seq_stmt = let->body;
+      } else if (const auto* attr = seq_stmt.as<AttrStmtNode>()) {
+        seq_stmt = attr->body;
+      } else if (const auto* alloc = seq_stmt.as<AllocateNode>()) {
+        seq_stmt = alloc->body;
+      } else {
+        seq_stmt = Downcast<DeclBuffer>(seq_stmt)->body;
+      }
+    }
+    ffi::Array<Stmt> children;
+    if (const auto* seq = seq_stmt.as<SeqStmtNode>()) {
+      children = seq->seq;
+    } else {
+      children = {seq_stmt};
+    }
+    ffi::Array<Stmt> producer_stmts, consumer_stmts;
+    std::vector<Var> staged_vars;
+    for (const Stmt& child : children) {
+      std::vector<Var> written = ProducerDetector::Detect(child);
+      if (written.empty()) {
+        consumer_stmts.push_back(child);
+        continue;
+      }
+      producer_stmts.push_back(child);
+      for (const Var& var : written) {
+        if (std::find_if(staged_vars.begin(), staged_vars.end(),
+                         [&](const Var& v) { return v.same_as(var); }) == staged_vars.end()) {
+          staged_vars.push_back(var);
+        }
+      }
+    }
+    TVM_FFI_ICHECK(!producer_stmts.empty())
+        << "InjectWarpSpecialization expects the warp specialized loop to copy from global to "
+           "shared memory";
+    TVM_FFI_ICHECK(!consumer_stmts.empty())
+        << "InjectWarpSpecialization expects the warp specialized loop to compute on the copies";
+
+    // Step 3. Give a version to each stage of the buffers written by the producers.
+    std::unordered_map<const VarNode*, StagedBuffer> staged;
+    for (const Var& var : staged_vars) {
+      auto it = std::find_if(hoister.allocs.begin(), hoister.allocs.end(),
+                             [&](const Allocate& alloc) { return alloc->buffer_var.same_as(var); });
+      TVM_FFI_ICHECK(it != hoister.allocs.end())
+          << "InjectWarpSpecialization expects the allocation of " << var << " in the kernel";
+      staged[var.get()] = {(*it)->ConstantAllocationSize() * (*it)->dtype.bytes(), (*it)->dtype};
+    }
+    for (const Stmt& stmt : consumer_stmts) {
+      PostOrderVisit(stmt, [&](const ObjectRef& node) {
+        if (const auto* store = node.as<BufferStoreNode>()) {
+          TVM_FFI_ICHECK(!staged.count(store->buffer->data.get()))
+              << "InjectWarpSpecialization expects the consumers not to write "
+              << store->buffer->name << ", which the producers copy into";
+        }
+      });
+    }
+    OutsideAccessChecker(loop, &staged)(body);
+
+    DataType index_dtype = loop->loop_var.dtype();
+    PrimExpr iter = loop->loop_var - loop->min;
+    PrimExpr stage = cast(DataType::Int(32), floormod(iter, num_stages));
+    PrimExpr round = cast(DataType::Int(32), floordiv(iter, num_stages));
+    PrimExpr full_barrier = stage;
+    PrimExpr empty_barrier = stage + num_stages;
+    std::unordered_map<const BufferNode*, Buffer> buffer_remap;
+    auto wrap_loop_body = [&](Stmt stmt) {
+      for (auto it = loop_wrappers.rbegin(); it != loop_wrappers.rend(); ++it) {
+        stmt = ReplaceBody(*it, stmt);
+      }
+      return stmt;
+    };
+    auto make_loop = [&](Stmt loop_body) {
+      For new_loop = ffi::GetRef<For>(loop);
+      auto* n = new_loop.CopyOnWrite();
+      n->body = std::move(loop_body);
+      n->annotations.erase(s_tir::attr::warp_specialize_producer_threads);
+      n->annotations.erase(s_tir::attr::warp_specialize_num_stages);
+      return new_loop;
+    };
+
+    // Step 4. The consumers wait for the copies of the stage, and release the stage after their
+    // computation.
+    StageRewriter consumer_rewriter(&staged, &buffer_remap, num_stages, stage, std::nullopt);
+    ffi::Array<Stmt> consumer_seq;
+    consumer_seq.push_back(BarrierCall(builtin::ptx_wait_barrier(),
+                                       {full_barrier, floormod(round, 2)}));
+    for (const Stmt& stmt : consumer_stmts) {
+      consumer_seq.push_back(consumer_rewriter(stmt));
+    }
+    consumer_seq.push_back(BarrierCall(builtin::ptx_arrive_barrier(), {empty_barrier}));
+    For consumer_loop = make_loop(wrap_loop_body(SeqStmt(consumer_seq)));
+
+    // Step 5. The producers wait for the release of the stage before overwriting it, copy for all
+    // the consumer threads, and arrive on the barrier of the stage after their copies.
+    StageRewriter producer_rewriter(&staged, &buffer_remap, num_stages, stage, full_barrier);
+    int num_rounds = (num_consumers + num_producers - 1) / num_producers;
+    Var round_var("producer_round", tx.dtype());
+    PrimExpr virtual_tx = tx - num_consumers;
+    if (num_rounds > 1) virtual_tx = virtual_tx + round_var * num_producers;
+    Stmt copies = Substitute(wrap_loop_body(SeqStmt::Flatten(producer_stmts)),
+                             ffi::Map<Var, PrimExpr>{{tx, virtual_tx}});
+    copies = producer_rewriter(copies);
+    if (num_rounds * num_producers != num_consumers) {
+      copies = IfThenElse(virtual_tx < num_consumers, copies);
+    }
+    if (num_rounds > 1) {
+      copies = For(round_var, IntImm(tx.dtype(), 0), IntImm(tx.dtype(), num_rounds),
+                   ForKind::kSerial, copies);
+    }
+    Stmt wait_release = BarrierCall(builtin::ptx_wait_barrier(),
+                                    {empty_barrier, floormod(round + 1, 2)});
+    For producer_loop = make_loop(SeqStmt::Flatten(
+        IfThenElse(iter >= IntImm(index_dtype, num_stages), wait_release), copies,
+        BarrierCall(builtin::ptx_arrive_barrier(), {full_barrier})));
+
+    // Step 6. The consumers run the kernel with the new loop, and the producers only the loop.
+    Stmt consumer_body = LoopReplacer(loop, consumer_loop)(body);
+    consumer_body = NamedBarrierRewriter(1, num_consumers)(consumer_body);
+    Stmt producer_body = PrunePath(body, finder.path, 0, loop, producer_loop, tx);
+
+    ffi::Array<Stmt> init;
+    for (int i = 0; i < num_stages; ++i) {
+      init.push_back(BarrierCall(builtin::ptx_init_barrier_thread_count(),
+                                 {IntImm(DataType::Int(32), i), num_producers}));
+      init.push_back(BarrierCall(builtin::ptx_init_barrier_thread_count(),
+                                 {IntImm(DataType::Int(32), num_stages + i), num_consumers}));
+    }
+    Stmt new_body = SeqStmt(
+        {BarrierCall(builtin::create_barriers(), {IntImm(DataType::Int(32), 2 * num_stages)}),
+         StorageSync(),
+         IfThenElse(tx == IntImm(tx.dtype(), 0), SeqStmt(init)), StorageSync(),
+         IfThenElse(tx < IntImm(tx.dtype(), num_consumers), consumer_body, producer_body)});
+    for (auto it = hoister.decls.rbegin(); it != hoister.decls.rend(); ++it) {
+      DeclBuffer decl = *it;
+      if (staged.count(decl->buffer->data.get())) {
+        decl.CopyOnWrite()->buffer =
+            RemapStagedBuffer(decl->buffer, staged, num_stages, &buffer_remap);
+      }
+      new_body = DeclBuffer(decl->buffer, new_body, decl->span);
+    }
+    for (auto it = hoister.allocs.rbegin(); it != hoister.allocs.rend(); ++it) {
+      Allocate alloc = *it;
+      ffi::Array<PrimExpr> extents = alloc->extents;
+      if (staged.count(alloc->buffer_var.get())) {
+        extents.Set(0, extents[0] * num_stages);
+      }
+      new_body = Allocate(alloc->buffer_var, alloc->dtype, extents, alloc->condition, new_body,
+                          alloc->annotations, alloc->span);
+    }
+
+    IterVar new_iv = iv;
+    if (iv->dom.defined()) {
+      new_iv = IterVar(Range::FromMinExtent(iv->dom->min, num_consumers + num_producers), tx,
+                       iv->iter_type, iv->thread_tag, iv->span);
+    }
+    Stmt result = AttrStmt(new_iv, op->attr_key, IntImm(op->value.dtype(),
+                                                        num_consumers + num_producers),
+                           new_body, op->span);
+    // The roles duplicate the definitions on the path to the loop.
+    return ConvertSSA(result);
+  }
+
+  /*! \brief Keep only the statements from the kernel body to the loop, for the producers. */
+  static Stmt PrunePath(const Stmt& stmt, const std::vector<const StmtNode*>& path, size_t depth,
+                        const ForNode* loop, const Stmt& new_loop, const Var& tx) {
+    if (stmt.get() == loop) {
+      return new_loop;
+    }
+    TVM_FFI_ICHECK_LT(depth + 1, path.size());
+    TVM_FFI_ICHECK_EQ(stmt.get(), path[depth]);
+    auto uses_tx = [&](const PrimExpr& e) {
+      return UsesVar(e, [&](const VarNode* v) { return v == tx.get(); });
+    };
+    auto prune_child = [&](const Stmt& child) {
+      return PrunePath(child, path, depth + 1, loop, new_loop, tx);
+    };
+    const StmtNode* next = path[depth + 1];
+    if (const auto* seq = stmt.as<SeqStmtNode>()) {
+      for (const Stmt& child : seq->seq) {
+        if (child.get() == next) return prune_child(child);
+      }
+    } else if (const auto* op = stmt.as<IfThenElseNode>()) {
+      TVM_FFI_ICHECK(!uses_tx(op->condition))
+          << "InjectWarpSpecialization expects the warp specialized loop not to be under a "
+             "thread dependent condition";
+      if (op->then_case.get() == next) {
+        return IfThenElse(op->condition, prune_child(op->then_case));
+      }
+      return IfThenElse(!op->condition, prune_child(op->else_case.value()));
+    } else if (const auto* op = stmt.as<ForNode>()) {
+      TVM_FFI_ICHECK(!uses_tx(op->min) && !uses_tx(op->extent))
+          << "InjectWarpSpecialization expects the loops around the warp specialized loop to "
+             "run the same iterations on all threads";
+      return ReplaceBody(stmt, prune_child(op->body));
+    } else if (const auto* op = stmt.as<LetStmtNode>()) {
+      TVM_FFI_ICHECK(!uses_tx(op->value))
+          << "InjectWarpSpecialization expects the bindings around the warp specialized loop "
+             "not to depend on the thread";
+      return ReplaceBody(stmt, prune_child(op->body));
+    } else if (const auto* op = stmt.as<AllocateNode>()) {
+      Stmt child = prune_child(op->body);
+      // The allocations of the consumers are not needed by the producers.
+      if (!UsesVar(child, [&](const VarNode* v) { return v == op->buffer_var.get(); })) {
+        return child;
+      }
+      return ReplaceBody(stmt, child);
+    } else if (const auto* op = stmt.as<DeclBufferNode>()) {
+      Stmt child = prune_child(op->body);
+      if (!UsesVar(child, [&](const VarNode* v) { return v == op->buffer->data.get(); })) {
+        return child;
+      }
+      return ReplaceBody(stmt, child);
+    } else if (const auto* op = stmt.as<AttrStmtNode>()) {
+      return ReplaceBody(stmt, prune_child(op->body));
+    }
+    TVM_FFI_THROW(InternalError) << "InjectWarpSpecialization does not support the "
+                                 << stmt->GetTypeKey() << " around the warp specialized loop";
+  }
+
+  std::vector<std::string> other_thread_dims_;
+};
+
+namespace transform {
+
+Pass InjectWarpSpecialization() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = WarpSpecializer()(n->body);
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.InjectWarpSpecialization", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.transform.InjectWarpSpecialization", InjectWarpSpecialization);
+}
+
+}  // namespace transform
+
+}  // namespace s_tir
+}  // namespace tvm
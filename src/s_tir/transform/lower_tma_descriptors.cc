@@ -0,0 +1,203 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file lower_tma_descriptors.cc
+ * \brief Create the TMA descriptors of the tile copies on the host, and lower the copies to
+ *  cp.async.bulk.tensor with the descriptors passed to the kernel.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/type.h>
+#include <tvm/s_tir/transform.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+class TMADescriptorLowerer : public StmtExprMutator {
+ public:
+  explicit TMADescriptorLowerer(const PrimFunc& func) {
+    for (const Var& param : func->params) {
+      host_vars_.insert(param.get());
+    }
+    for (const auto& [param, buffer] : func->buffer_map) {
+      auto add_vars = [this](const PrimExpr& e) {
+        PostOrderVisit(e, [this](const ObjectRef& node) {
+          if (const auto* var = node.as<VarNode>()) host_vars_.insert(var);
+        });
+      };
+      add_vars(buffer->data);
+      add_vars(buffer->elem_offset);
+      for (const PrimExpr& e : buffer->shape) add_vars(e);
+      for (const PrimExpr& e : buffer->strides) add_vars(e);
+    }
+  }
+
+  /*! \brief Rewrite the body, and create the descriptors at its beginning. */
+  Stmt Rewrite(const Stmt& body) {
+    Stmt stmt = this->VisitStmt(body);
+    for (auto it = descriptors_.rbegin(); it != descriptors_.rend(); ++it) {
+      Call alloca(DataType::Handle(), builtin::tvm_stack_alloca(),
+                  {StringImm("tensormap"), IntImm(DataType::Int(32), 1)});
+      stmt = LetStmt(it->tensor_map, alloca, SeqStmt({it->init, stmt}));
+    }
+    return stmt;
+  }
+
+ private:
+  /*! \brief A TMA descriptor of a global tensor and a box shape. */
+  struct Descriptor {
+    /*! \brief The variable of the descriptor. */
+    Var tensor_map;
+    /*! \brief The dtype of the global tensor. */
+    DataType dtype;
+    /*! \brief The global pointer, swizzle kind, global shape and box shape. */
+    ffi::Array<PrimExpr> key;
+    /*! \brief The host statement that encodes the descriptor. */
+    Stmt init;
+  };
+
+  PrimExpr VisitExpr_(const CallNode* op) final {
+    if (!op->op.same_as(builtin::ptx_tma_load())) {
+      return StmtExprMutator::VisitExpr_(op);
+    }
+    Call call = Downcast<Call>(StmtExprMutator::VisitExpr_(op));
+    const ffi::Array<PrimExpr>& args = call->args;
+    TVM_FFI_ICHECK_GE(args.size(), 6U) << "ptx_tma_load expects at least 6 arguments";
+    int rank = Downcast<IntImm>(args[5])->value;
+    TVM_FFI_ICHECK(rank >= 1 && rank <= 5)
+        << "ptx_tma_load supports tensors of 1 to 5 dimensions, but got " << rank;
+    TVM_FFI_ICHECK_EQ(args.size(), 6 + 3 * rank)
+        << "ptx_tma_load of a " << rank << "-d tensor expects " << 6 + 3 * rank << " arguments";
+
+    ffi::Array<PrimExpr> key = {args[2], args[4]};
+    for (int i = 0; i < 2 * rank; ++i) {
+      key.push_back(args[6 + i]);
+    }
+    Var tensor_map = GetDescriptor(call->dtype, key, rank);
+
+    ffi::Array<PrimExpr> new_args = {args[0], args[1], tensor_map, args[3]};
+    for (int i = 0; i < rank; ++i) {
+      new_args.push_back(args[6 + 2 * rank + i]);
+    }
+    return Call(call->dtype, builtin::ptx_cp_async_bulk_tensor(), new_args, call->span);
+  }
+
+  /*! \brief Get the descriptor of the key, creating it if needed. */
+  Var GetDescriptor(DataType dtype, const ffi::Array<PrimExpr>& key, int rank) {
+    for (const Descriptor& desc : descriptors_) {
+      if (desc.dtype == dtype && desc.key.size() == key.size() &&
+          std::equal(desc.key.begin(), desc.key.end(), key.begin(), ExprDeepEqual())) {
+        return desc.tensor_map;
+      }
+    }
+    PrimExpr global_ptr = key[0];
+    const auto* global_var = global_ptr.as<VarNode>();
+    TVM_FFI_ICHECK(global_var != nullptr)
+        << "ptx_tma_load expects the global pointer to be a variable, but got " << global_ptr;
+    std::string name = global_var->name_hint;
+    if (name.size() > 5 && name.compare(name.size() - 5, 5, "_data") == 0) {
+      name = name.substr(0, name.size() - 5);
+    }
+    Var tensor_map(name + "_tensor_map", PointerType(TensorMapType()));
+
+    // cuTensorMapEncodeTiled lists the dimensions from the innermost, and the strides of the
+    // dimensions except the innermost in bytes.
+    ffi::Array<PrimExpr> global_shape, global_strides, box_shape;
+    PrimExpr stride = IntImm(DataType::Int(64), dtype.bytes());
+    for (int i = rank - 1; i >= 0; --i) {
+      PrimExpr extent = cast(DataType::Int(64), key[2 + i]);
+      global_shape.push_back(extent);
+      if (i != rank - 1) {
+        global_strides.push_back(stride);
+      }
+      stride = stride * extent;
+      const auto* box = key[2 + rank + i].as<IntImmNode>();
+      TVM_FFI_ICHECK(box && box->value > 0 && box->value <= 256)
+          << "ptx_tma_load expects constant box dimensions in [1, 256], but got "
+          << key[2 + rank + i];
+      box_shape.push_back(IntImm(DataType::Int(32), box->value));
+    }
+
+    ffi::Array<PrimExpr> encode_args = {StringImm("runtime.cuTensorMapEncodeTiled"), tensor_map,
+                                        StringImm(ffi::DLDataTypeToString(dtype)),
+                                        IntImm(DataType::Int(32), rank), global_ptr};
+    for (const ffi::Array<PrimExpr>& values : {global_shape, global_strides, box_shape}) {
+      for (const PrimExpr& value : values) {
+        encode_args.push_back(value);
+      }
+    }
+    // The elements of the box are dense.
+    for (int i = 0; i < rank; ++i) {
+      encode_args.push_back(IntImm(DataType::Int(32), 1));
+    }
+    // No interleave, the swizzle kind, 128B L2 promotion and zero filling of out-of-bound
+    // elements, which are the settings of the common GEMM and attention kernels.
+    encode_args.push_back(IntImm(DataType::Int(32), 0));
+    encode_args.push_back(cast(DataType::Int(32), key[1]));
+    encode_args.push_back(IntImm(DataType::Int(32), 2));
+    encode_args.push_back(IntImm(DataType::Int(32), 0));
+    Stmt init = Evaluate(Call(DataType::Int(32), builtin::tvm_call_packed(), encode_args));
+
+    for (const Var& var : UndefinedVars(init, {tensor_map})) {
+      TVM_FFI_ICHECK(host_vars_.count(var.get()))
+          << "ptx_tma_load expects the global tensor and its shape to be defined on the host, "
+          << "but " << var << " is not a parameter of the function";
+    }
+    descriptors_.push_back({tensor_map, dtype, key, init});
+    return tensor_map;
+  }
+
+  /*! \brief The variables defined on the host before the body. */
+  std::unordered_set<const VarNode*> host_vars_;
+  /*! \brief The descriptors to create, in the order of their first use. */
+  std::vector<Descriptor> descriptors_;
+};
+
+namespace transform {
+
+Pass LowerTMADescriptors() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    TMADescriptorLowerer lowerer(f);
+    auto* n = f.CopyOnWrite();
+    n->body = lowerer.Rewrite(n->body);
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.LowerTMADescriptors", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.transform.LowerTMADescriptors", LowerTMADescriptors);
+}
+
+}  // namespace transform
+
+}  // namespace s_tir
+}  // namespace tvm
@@ -749,7 +749,7 @@ class ThreadExtentCollector : public StmtVisitor {
   void VisitStmt_(const SBlockNode* op) final {
     if (ffi::Optional<Integer> warp_execution = GetAnn<Integer>(op, "warp_execution")) {
       if (warp_execution.value()->value != 0) {
-        thread_extent_.Set("threadIdx.x", Integer(32));
+        thread_extent_.Set("threadIdx.x", Integer(32 * warp_execution.value()->value));
       }
     }
     StmtVisitor::VisitStmt_(op);
@@ -0,0 +1,242 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file merge_parallel_launch.cc
+ * \brief Merge the consecutive parallel loops of the CPU functions into one parallel launch, and
+ *  run the parallel launches with little work serially.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/transform.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_set>
+#include <vector>
+
+#include "../../tir/transform/ir_utils.h"
+
+namespace tvm {
+namespace s_tir {
+using namespace tvm::tir;
+
+TVM_REGISTER_PASS_CONFIG_OPTION("s_tir.merge_parallel_launch", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("s_tir.parallel_launch_min_work", Integer);
+
+/*!
+ * \brief Estimate the number of statements executed by a statement, as an expression of the
+ *  variables defined outside of it. The loops whose extent is defined inside count once.
+ */
+class WorkEstimator : public StmtVisitor {
+ public:
+  static PrimExpr Estimate(const Stmt& stmt) {
+    WorkEstimator estimator;
+    estimator(stmt);
+    return estimator.work_;
+  }
+
+ private:
+  void VisitStmt_(const ForNode* op) final {
+    PrimExpr outer_work = work_;
+    work_ = make_const(DataType::Int(64), 0);
+    inner_vars_.insert(op->loop_var.get());
+    this->VisitStmt(op->body);
+    bool invariant_extent = !UsesVar(op->extent, [this](const VarNode* var) {
+      return inner_vars_.count(var) != 0;
+    });
+    PrimExpr body_work = work_;
+    if (invariant_extent) {
+      body_work = cast(DataType::Int(64), op->extent) * body_work;
+    }
+    work_ = outer_work + body_work;
+  }
+
+  void VisitStmt_(const LetStmtNode* op) final {
+    inner_vars_.insert(op->var.get());
+    StmtVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final { work_ = work_ + 1; }
+
+  void VisitStmt_(const EvaluateNode* op) final { work_ = work_ + 1; }
+
+  /*! \brief The work of the statements visited so far at the current loop level. */
+  PrimExpr work_ = make_const(DataType::Int(64), 0);
+  /*! \brief The variables defined inside the statement. */
+  std::unordered_set<const VarNode*> inner_vars_;
+};
+
+/*! \brief Rewrite the parallel loops of a statement to serial loops. */
+class ParallelLoopSerializer : public StmtMutator {
+ private:
+  Stmt VisitStmt_(const ForNode* op) final {
+    For loop = Downcast<For>(StmtMutator::VisitStmt_(op));
+    if (loop->kind == ForKind::kParallel) {
+      loop.CopyOnWrite()->kind = ForKind::kSerial;
+    }
+    return loop;
+  }
+};
+
+class ParallelLaunchMerger : public StmtMutator {
+ public:
+  ParallelLaunchMerger(bool merge, int64_t min_work) : merge_(merge), min_work_(min_work) {}
+
+  /*! \brief Whether a launch has been guarded by its amount of work. */
+  bool guarded() const { return guarded_; }
+
+ private:
+  /*! \brief Whether the statement is a parallel loop that launches on its own. */
+  static bool IsLaunch(const Stmt& stmt) {
+    const auto* loop = stmt.as<ForNode>();
+    return loop != nullptr && loop->kind == ForKind::kParallel && is_zero(loop->min) &&
+           !loop->annotations.count(tir::attr::parallel_work_stealing);
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    if (op->kind == ForKind::kParallel) {
+      // The parallel loops inside are either nested or part of this launch.
+      return GuardLaunch(ffi::GetRef<Stmt>(op));
+    }
+    return StmtMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == "pragma_parallel_launch_point") {
+      return ffi::GetRef<Stmt>(op);
+    }
+    return StmtMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode* op) final {
+    if (!merge_) {
+      return StmtMutator::VisitStmt_(op);
+    }
+    ffi::Array<Stmt> seq;
+    for (size_t i = 0; i < op->seq.size();) {
+      size_t end = i;
+      while (end < op->seq.size() && IsLaunch(op->seq[end])) {
+        ++end;
+      }
+      if (end - i < 2) {
+        seq.push_back(this->VisitStmt(op->seq[i]));
+        ++i;
+        continue;
+      }
+      // Each loop but the last waits for all the tasks before the next loop starts.
+      ffi::Array<Stmt> loops;
+      for (size_t j = i; j < end; ++j) {
+        Stmt loop = op->seq[j];
+        if (j + 1 < end) {
+          loop = AttrStmt(make_zero(DataType::Int(32)), "pragma_parallel_barrier_when_finish", 1,
+                          loop);
+        }
+        loops.push_back(loop);
+      }
+      Stmt launch = AttrStmt(make_zero(DataType::Int(32)), "pragma_parallel_launch_point", 1,
+                             SeqStmt(loops));
+      seq.push_back(GuardLaunch(launch));
+      i = end;
+    }
+    return seq.size() == 1 ? seq[0] : SeqStmt(seq);
+  }
+
+  /*! \brief Run the launch serially when it has less work than the threshold. */
+  Stmt GuardLaunch(Stmt launch) {
+    if (min_work_ <= 0) {
+      return launch;
+    }
+    PrimExpr work = WorkEstimator::Estimate(launch);
+    arith::Analyzer analyzer;
+    work = analyzer.Simplify(work);
+    if (const auto* imm = work.as<IntImmNode>()) {
+      if (imm->value >= min_work_) {
+        return launch;
+      }
+    }
+    guarded_ = true;
+    Stmt serial = ParallelLoopSerializer()(StripLaunchPoint(launch));
+    PrimExpr cond = work < make_const(DataType::Int(64), min_work_);
+    if (is_one(analyzer.Simplify(cond))) {
+      return serial;
+    }
+    return IfThenElse(cond, serial, launch);
+  }
+
+  /*! \brief Remove the launch point and barriers of a merged launch. */
+  static Stmt StripLaunchPoint(const Stmt& launch) {
+    const auto* attr = launch.as<AttrStmtNode>();
+    if (attr == nullptr || attr->attr_key != "pragma_parallel_launch_point") {
+      return launch;
+    }
+    ffi::Array<Stmt> loops;
+    for (const Stmt& stmt : Downcast<SeqStmt>(attr->body)->seq) {
+      const auto* barrier = stmt.as<AttrStmtNode>();
+      loops.push_back(barrier != nullptr ? barrier->body : stmt);
+    }
+    return SeqStmt(loops);
+  }
+
+  /*! \brief Whether to merge the consecutive parallel loops. */
+  bool merge_;
+  /*! \brief The work below which a launch runs serially, or 0 to always launch. */
+  int64_t min_work_;
+  /*! \brief Whether a launch has been guarded by its amount of work. */
+  bool guarded_{false};
+};
+
+namespace transform {
+
+Pass MergeParallelLaunch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    bool merge = ctx->GetConfig<Bool>("s_tir.merge_parallel_launch", Bool(false)).value();
+    int64_t min_work =
+        ctx->GetConfig<Integer>("s_tir.parallel_launch_min_work", Integer(0)).value()->value;
+    if (!merge && min_work <= 0) {
+      return f;
+    }
+    // Only the CPU backends launch the parallel loops on a thread pool.
+    if (auto target = f->GetAttr<Target>(tvm::attr::kTarget)) {
+      if (target.value()->GetTargetDeviceType() != kDLCPU) {
+        return f;
+      }
+    }
+    ParallelLaunchMerger merger(merge, min_work);
+    auto* n = f.CopyOnWrite();
+    n->body = merger(std::move(n->body));
+    if (merger.guarded()) {
+      // The serial copies of the launches redefine their variables.
+      n->body = tir::ConvertSSA(std::move(n->body));
+    }
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.MergeParallelLaunch", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("s_tir.transform.MergeParallelLaunch", MergeParallelLaunch);
+}
+
+}  // namespace transform
+
+}  // namespace s_tir
+}  // namespace tvm
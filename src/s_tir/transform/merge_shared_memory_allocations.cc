@@ -23,6 +23,7 @@
  * This pass merges multiple TIR-level dynamic or static shared memory allocations into one
  * allocation.
  */
+#include <tvm/arith/analyzer.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/s_tir/transform.h>
@@ -30,10 +31,14 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <numeric>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "../../runtime/thread_storage_scope.h"
 #include "../../support/arena.h"
@@ -90,7 +95,8 @@ class AllocateCollector : public StmtExprVisitor {
 //
 class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
  public:
-  explicit SharedMemLinearAccessPatternFinder(bool is_dynamic = true) : is_dynamic_(is_dynamic) {}
+  explicit SharedMemLinearAccessPatternFinder(bool is_dynamic = true, bool fine_liveness = false)
+      : is_dynamic_(is_dynamic), fine_liveness_(fine_liveness) {}
   /*! \brief record the touch list of statement. */
   struct StmtEntry {
     // The statement
@@ -102,6 +108,14 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     int64_t scope_pair_offset{0};
     // The buffer variables this statement touched.
     std::vector<const VarNode*> touched;
+    // Whether the nested scope runs at most once each time its parent runs, so that the
+    // accesses within it are linearly ordered relative to the rest of the parent.
+    bool executed_once{false};
+    // Whether the nested scope runs exactly once each time its parent runs.
+    bool executed_always{false};
+    // Whether the statement is a barrier of the shared memory that is always reached, i.e.
+    // only nested in scopes that run exactly once.
+    bool is_sync{false};
   };
   // The scope of each allocation
   struct AllocEntry {
@@ -129,7 +143,7 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     if (it != alloc_info_.end() && it->second.alloc) {
       TVM_FFI_ICHECK_LT(it->second.level, scope_.size());
       if (IsAppropriateSharedMemory(ffi::GetRef<Var>(buf))) {
-        scope_[it->second.level].touched.push_back(buf);
+        Touch(buf, it->second.level);
       }
     }
     StmtEntry e = scope_.back();
@@ -146,7 +160,11 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     StmtExprVisitor::VisitStmt_(op);
     StmtEntry e = scope_.back();
     scope_.pop_back();
-    if (e.touched.size() != 0) {
+    if (fine_liveness_ && IsSharedMemorySync(op->value)) {
+      e.is_sync = std::all_of(scope_.begin(), scope_.end(),
+                              [](const StmtEntry& scope) { return scope.executed_always; });
+    }
+    if (e.touched.size() != 0 || e.is_sync) {
       e.stmt = op;
       linear_seq_.push_back(e);
     }
@@ -161,7 +179,7 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
       TVM_FFI_ICHECK_LT(it->second.level, scope_.size())
           << "Load memory in places other than store.";
       if (IsAppropriateSharedMemory(ffi::GetRef<Var>(buf))) {
-        scope_[it->second.level].touched.push_back(buf);
+        Touch(buf, it->second.level);
       }
     }
   }
@@ -183,14 +201,16 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     if (it != alloc_info_.end() && it->second.alloc) {
       TVM_FFI_ICHECK_LT(it->second.level, scope_.size());
       if (IsAppropriateSharedMemory(ffi::GetRef<Var>(buf))) {
-        scope_[it->second.level].touched.push_back(buf);
+        Touch(buf, it->second.level);
       }
     }
   }
 
   template <typename T>
-  void VisitNewScope(const T* op) {
+  void VisitNewScope(const T* op, bool executed_once = false, bool executed_always = false) {
     scope_.push_back(StmtEntry());
+    scope_.back().executed_once = executed_once;
+    scope_.back().executed_always = executed_always;
     StmtEntry e;
     e.stmt = op;
     int64_t begin_index = static_cast<int64_t>(linear_seq_.size());
@@ -213,7 +233,7 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     // Only record the outer most thread extent.
     if (op->attr_key == tir::attr::thread_extent && !in_thread_env_) {
       in_thread_env_ = true;
-      VisitNewScope(op);
+      VisitNewScope(op, /*executed_once=*/true, /*executed_always=*/true);
       in_thread_env_ = false;
     } else if (op->attr_key == tir::attr::extern_scope) {
       VisitNewScope(op);
@@ -224,13 +244,17 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     }
   }
 
-  void VisitStmt_(const IfThenElseNode* op) final { VisitNewScope(op); }
+  void VisitStmt_(const IfThenElseNode* op) final { VisitNewScope(op, /*executed_once=*/true); }
 
-  void VisitStmt_(const ForNode* op) final { VisitNewScope(op); }
+  void VisitStmt_(const ForNode* op) final {
+    VisitNewScope(op, is_one(op->extent), is_one(op->extent));
+  }
 
   void VisitStmt_(const WhileNode* op) final { VisitNewScope(op); }
 
-  void VisitStmt_(const AssertStmtNode* op) final { VisitNewScope(op); }
+  void VisitStmt_(const AssertStmtNode* op) final {
+    VisitNewScope(op, /*executed_once=*/true, /*executed_always=*/true);
+  }
 
   // linearized access sequence.
   std::vector<StmtEntry> linear_seq_;
@@ -238,12 +262,40 @@ class SharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
   std::unordered_map<const VarNode*, AllocEntry> alloc_info_;
 
  private:
+  /*!
+   * \brief Record an access of a buffer allocated at the given level of the scope stack.
+   *
+   * With fine liveness, the access is recorded at the innermost scope that is only reached
+   * through scopes that run at most once, e.g. the thread environment and the branches of an
+   * IfThenElse, rather than at the statement of the allocation level. The live range of the
+   * buffer then follows the linear order of its accesses, while the scopes that repeat, such as
+   * loops, still keep it alive across all their iterations.
+   */
+  void Touch(const VarNode* buf, size_t level) {
+    size_t depth = level;
+    while (fine_liveness_ && depth + 1 < scope_.size() && scope_[depth].executed_once) {
+      ++depth;
+    }
+    scope_[depth].touched.push_back(buf);
+  }
   // Wrapper function to determine if the shared memory allocation for a variable is appropriate.
   bool IsAppropriateSharedMemory(const Var& var) {
     return is_dynamic_ ? IsDynamicSharedMemory(var) : IsStaticSharedMemory(var);
   }
+  /*! \brief Whether the expression is a barrier of the shared memory of all the threads. */
+  static bool IsSharedMemorySync(const PrimExpr& value) {
+    const auto* call = value.as<CallNode>();
+    if (call == nullptr || !call->op.same_as(builtin::tvm_storage_sync()) || call->args.empty()) {
+      return false;
+    }
+    const auto* scope = call->args[0].as<StringImmNode>();
+    return scope && (scope->value == "shared" || scope->value == "shared.dyn");
+  }
   // Whether do dyanmic analysis.
   bool is_dynamic_{true};
+  // Whether to record the accesses at the innermost scopes that run at most once, and the
+  // barriers of the shared memory.
+  bool fine_liveness_{false};
   // Whether already in thread env.
   bool in_thread_env_{false};
   // The scope stack.
@@ -268,15 +320,32 @@ class SharedMemoryRewriter : public StmtExprMutator {
    * \brief plan the memory reuse for all the buffer allocated in the statement
    * \param stmt the statement
    */
-  void PlanReuse(const Stmt& stmt, bool is_dynamic = true) {
+  void PlanReuse(const Stmt& stmt, bool is_dynamic = true, bool interval_packing = false) {
+    if (interval_packing) {
+      SharedMemLinearAccessPatternFinder finder(is_dynamic, /*fine_liveness=*/true);
+      finder(stmt);
+      if (this->PlanIntervalPacking(finder.linear_seq_)) {
+        return;
+      }
+    }
     SharedMemLinearAccessPatternFinder finder(is_dynamic);
     finder(stmt);
     this->LivenessAnalysis(finder.linear_seq_);
     this->PlanMemory(finder.linear_seq_);
   }
 
+  /*! \brief The size in bytes of the merged allocation, defined once the body is rewritten. */
+  PrimExpr merged_alloc_size() const { return merged_alloc_size_; }
+
  private:
   Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == tir::attr::thread_extent && !allocated_ && packed_) {
+      // The offsets are already planned by interval packing.
+      allocated_ = true;
+      Allocate new_body(merged_buf_var_, DataType::UInt(8), {merged_alloc_size_}, const_true(),
+                        StmtExprMutator::VisitStmt(op->body));
+      return AttrStmt(op->node, op->attr_key, op->value, new_body, op->span);
+    }
     if (op->attr_key == tir::attr::thread_extent && !allocated_) {
       // Allocate one dynamic shared memory allocation at the beginning of thread scope
       int max_layer_num = 0;
@@ -491,6 +560,92 @@ class SharedMemoryRewriter : public StmtExprMutator {
     }
   }
 
+  /*!
+   * \brief Plan the byte offsets of the buffers by interval packing of their live ranges.
+   *
+   * The live range of a buffer spans from its first access in the linear pattern to the first
+   * barrier of the shared memory after its last access, since other threads may access the
+   * buffer until then. Only the barriers that are always reached count; without one, the buffer
+   * stays live until the end. The buffers are placed from the largest to the smallest, each at
+   * the lowest aligned offset that does not overlap a placed buffer with an intersecting live
+   * range. Unlike the reuse of free storage entries, a buffer can be placed in any gap between
+   * the live buffers, which gives a tighter footprint for the kernels with several phases.
+   *
+   * \param seq the linear pattern of storage access
+   * \return Whether the offsets are planned, false if a buffer has a symbolic size.
+   */
+  bool PlanIntervalPacking(const std::vector<StmtEntry>& seq) {
+    struct LiveInterval {
+      const VarNode* buffer;
+      size_t begin;
+      size_t end;
+      int64_t bytes;
+      int64_t align;
+    };
+    std::vector<LiveInterval> intervals;
+    std::unordered_map<const VarNode*, size_t> interval_index;
+    for (size_t i = 0; i < seq.size(); ++i) {
+      // The touches of a nested scope are recorded at its end entry.
+      int64_t offset = seq[i].scope_pair_offset;
+      const StmtEntry& s = offset > 0 ? seq[i + offset] : seq[i];
+      for (const VarNode* buffer : s.touched) {
+        auto [it, inserted] = interval_index.emplace(buffer, intervals.size());
+        if (inserted) {
+          TVM_FFI_ICHECK(shmem_allocs_.count(buffer));
+          const AllocateNode* alloc = shmem_allocs_[buffer];
+          int64_t num_elements = alloc->ConstantAllocationSize();
+          if (num_elements == 0) {
+            return false;
+          }
+          int64_t elem_bytes = alloc->dtype.bytes();
+          intervals.push_back({buffer, i, i, num_elements * elem_bytes * alloc->dtype.lanes(),
+                               elem_bytes});
+        }
+        intervals[it->second].end = i;
+      }
+    }
+    for (LiveInterval& interval : intervals) {
+      size_t end = interval.end + 1;
+      while (end < seq.size() && !seq[end].is_sync) {
+        ++end;
+      }
+      interval.end = end;
+    }
+    if (intervals.empty()) {
+      return false;
+    }
+
+    std::vector<size_t> order(intervals.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return intervals[a].bytes > intervals[b].bytes; });
+    std::vector<int64_t> offsets(intervals.size(), -1);
+    int64_t total_bytes = 0;
+    for (size_t i : order) {
+      const LiveInterval& cur = intervals[i];
+      // The address ranges of the placed buffers that are live at the same time.
+      std::vector<std::pair<int64_t, int64_t>> conflicts;
+      for (size_t j = 0; j < intervals.size(); ++j) {
+        const LiveInterval& other = intervals[j];
+        if (offsets[j] >= 0 && other.begin <= cur.end && cur.begin <= other.end) {
+          conflicts.emplace_back(offsets[j], offsets[j] + other.bytes);
+        }
+      }
+      std::sort(conflicts.begin(), conflicts.end());
+      int64_t offset = 0;
+      for (const auto& [lo, hi] : conflicts) {
+        if (offset + cur.bytes <= lo) break;
+        offset = std::max(offset, (hi + cur.align - 1) / cur.align * cur.align);
+      }
+      offsets[i] = offset;
+      buffer_byte_offsets_[cur.buffer] = make_const(DataType::Int(32), offset);
+      total_bytes = std::max(total_bytes, offset + cur.bytes);
+    }
+    merged_alloc_size_ = make_const(DataType::Int(32), total_bytes);
+    packed_ = true;
+    return true;
+  }
+
   /*!
    * \brief Memory plan algorithm
    * \param seq the linear pattern of storage access
@@ -660,6 +815,8 @@ class SharedMemoryRewriter : public StmtExprMutator {
   std::unordered_map<const BufferNode*, Buffer> buffer_remap_;
   // The flag indicating whether the merged buffer has been allocated
   bool allocated_{false};
+  // The flag indicating whether the offsets are planned by interval packing
+  bool packed_{false};
   // Locations of free ops.
   std::unordered_map<const Object*, EventEntry> event_map_;
   // constant size free map.
@@ -672,13 +829,42 @@ class SharedMemoryRewriter : public StmtExprMutator {
   support::Arena arena_;
 };
 
-Stmt MergeSharedMemoryAllocations(Stmt stmt, bool merge_static_smem) {
+/*! \brief The total size in bytes of the given shared memory allocations. */
+PrimExpr TotalAllocationBytes(
+    const std::unordered_map<const VarNode*, const AllocateNode*>& shmem_allocs) {
+  PrimExpr total = 0;
+  for (const auto& [buffer, alloc] : shmem_allocs) {
+    PrimExpr size = alloc->dtype.bytes() * alloc->dtype.lanes();
+    for (const PrimExpr& extent : alloc->extents) {
+      size = size * extent;
+    }
+    total = total + size;
+  }
+  return total;
+}
+
+Stmt MergeSharedMemoryAllocations(Stmt stmt, bool merge_static_smem, bool interval_packing,
+                                  const ffi::String& report_name) {
   AllocateCollector collector;
   collector(stmt);
   if (collector.dyn_shmem_allocs_.size() > 1) {
     SharedMemoryRewriter rewriter(collector.dyn_shmem_allocs_);
-    rewriter.PlanReuse(stmt);
+    rewriter.PlanReuse(stmt, true, interval_packing);
     stmt = rewriter(std::move(stmt));
+    if (!report_name.empty()) {
+      arith::Analyzer analyzer;
+      LOG(INFO) << "MergeSharedMemoryAllocations: kernel " << report_name << " uses "
+                << analyzer.Simplify(rewriter.merged_alloc_size())
+                << " bytes of dynamic shared memory, merged from "
+                << collector.dyn_shmem_allocs_.size() << " allocations of "
+                << analyzer.Simplify(TotalAllocationBytes(collector.dyn_shmem_allocs_))
+                << " bytes";
+    }
+  } else if (!report_name.empty() && collector.dyn_shmem_allocs_.size() == 1) {
+    arith::Analyzer analyzer;
+    LOG(INFO) << "MergeSharedMemoryAllocations: kernel " << report_name << " uses "
+              << analyzer.Simplify(TotalAllocationBytes(collector.dyn_shmem_allocs_))
+              << " bytes of dynamic shared memory";
   }
   if (merge_static_smem && collector.static_shmem_allocs_.size() > 1) {
     SharedMemoryRewriter rewriter(collector.static_shmem_allocs_, false);
@@ -690,11 +876,21 @@ Stmt MergeSharedMemoryAllocations(Stmt stmt, bool merge_static_smem) {
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("s_tir.merge_shared_memory_interval_packing", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("s_tir.merge_shared_memory_report", Bool);
+
 Pass MergeSharedMemoryAllocations() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
     bool merge_static_smem = ctx->GetConfig<Bool>("tir.merge_static_smem", Bool(false)).value();
+    bool interval_packing =
+        ctx->GetConfig<Bool>("s_tir.merge_shared_memory_interval_packing", Bool(false)).value();
+    ffi::String report_name;
+    if (ctx->GetConfig<Bool>("s_tir.merge_shared_memory_report", Bool(false)).value()) {
+      report_name = f->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol).value_or("<anonymous>");
+    }
     auto* n = f.CopyOnWrite();
-    n->body = s_tir::MergeSharedMemoryAllocations(std::move(n->body), merge_static_smem);
+    n->body = s_tir::MergeSharedMemoryAllocations(std::move(n->body), merge_static_smem,
+                                                  interval_packing, report_name);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "s_tir.MergeSharedMemoryAllocations", {});
@@ -22,6 +22,7 @@
  */
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/s_tir/stmt.h>
 #include <tvm/s_tir/transform.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
@@ -462,8 +463,28 @@ Stmt ThreadSync(Stmt stmt, std::string storage_scope) {
   return ThreadSyncInserter(sync_scope, planner.syncs_inserted_)(std::move(stmt));
 }
 
+/*! \brief Insert the global barriers of the kernels merged by the merge_kernels primitive. */
+class GlobalBarrierInjector : public StmtMutator {
+ private:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == s_tir::attr::pragma_global_barrier) {
+      return ThreadSync(op->body, "global");
+    }
+    return StmtMutator::VisitStmt_(op);
+  }
+};
+
 namespace transform {
 
+Pass InjectGlobalBarrier() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = GlobalBarrierInjector()(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "s_tir.InjectGlobalBarrier", {});
+}
+
 Pass ThreadSync(ffi::String storage_scope) {
   auto pass_func = [storage_scope](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
@@ -475,8 +496,9 @@ Pass ThreadSync(ffi::String storage_scope) {
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("s_tir.transform.ThreadSync",
-                        static_cast<Pass (*)(ffi::String)>(ThreadSync));
+  refl::GlobalDef()
+      .def("s_tir.transform.ThreadSync", static_cast<Pass (*)(ffi::String)>(ThreadSync))
+      .def("s_tir.transform.InjectGlobalBarrier", InjectGlobalBarrier);
 }
 
 }  // namespace transform
@@ -31,7 +31,8 @@ namespace s_tir {
 using namespace tvm::tir;
 
 /*!
- * \brief Rewriter for all m16n8k8.matrix[A/B/C] buffer. This pass mainly do two things:
+ * \brief Rewriter for all m16n8k8.matrix[A/B/C] and wgmma.accumulator buffer. This pass mainly
+ *   do two things:
  *     1. Lower m16n8k8.matrix[A/B/C] buffer to local registers, where each thread holds their
  *        own part of the matrix;
  *     2. Rewrite access of m16n8k8.matrixC so it can access the correct part of the matrix.
@@ -41,6 +42,10 @@ using namespace tvm::tir;
  *   We cannot use this kind of opaque access in matrixC too since the ptx stmatrix is only
  *   supported for sm90 or higher. Therefore, writeback of matrixC is limited to the
  *   transparent way.
+ *   wgmma.accumulator is lowered in the same way. Each 64 x 8 block of it is held by a
+ *   warpgroup, where a thread holds 2 x 2 elements, i.e. the shape is changed from [i, j] to
+ *   [i // 64, j // 8, 2, 2]. Please refer to get_index_wgmma_C in
+ *   python/tvm/s_tir/tensor_intrin/cuda.py.
  */
 class MmaBufferLayoutTransformer : public StmtExprMutator {
  public:
@@ -118,6 +123,28 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
         this->buffer_map_.insert({buffer, new_buffer});
         this->buffer_var_map_.insert({buffer->data, new_buffer->data});
         return new_buffer;
+
+      } else if (buffer.scope() == "wgmma.accumulator") {
+        // wgmma.accumulator
+        // bi = 64, bj = 8
+        size_t size = buffer->shape.size();
+        TVM_FFI_ICHECK_GE(size, 2);
+        const IntImmNode* dim0 = buffer->shape[size - 2].as<IntImmNode>();
+        const IntImmNode* dim1 = buffer->shape[size - 1].as<IntImmNode>();
+        TVM_FFI_ICHECK(dim0 != nullptr && dim1 != nullptr);
+        TVM_FFI_ICHECK(dim0->value % 64 == 0 && dim1->value % 8 == 0);
+        std::vector<PrimExpr> new_shape;
+        for (size_t i = 0; i < size - 2; ++i) {
+          new_shape.push_back(buffer->shape[i]);
+        }
+        new_shape.insert(new_shape.end(),
+                         {Integer(dim0->value / 64), Integer(dim1->value / 8), 2, 2});
+
+        Buffer new_buffer = decl_buffer(std::move(new_shape), buffer->dtype, buffer->name, "local",
+                                        buffer->axis_separators);
+        this->buffer_map_.insert({buffer, new_buffer});
+        this->buffer_var_map_.insert({buffer->data, new_buffer->data});
+        return new_buffer;
       }
       return buffer;
     };
@@ -137,6 +164,9 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
         auto new_indices = index_map->MapIndices(store->indices, &analyzer);
         n->buffer = buffer_map_[store->buffer];
         n->indices = std::move(new_indices);
+      } else if (store->buffer.scope() == "wgmma.accumulator") {
+        n->buffer = buffer_map_[store->buffer];
+        n->indices = WGMMAAccumulatorIndices(store->indices);
       } else if (store->buffer.scope() == "m16n8k8.matrixA" ||
                  store->buffer.scope() == "m16n8k8.matrixB") {
         n->buffer = buffer_map_[store->buffer];
@@ -156,6 +186,9 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
         auto new_indices = index_map->MapIndices(load->indices, &analyzer);
         n->buffer = buffer_map_[load->buffer];
         n->indices = std::move(new_indices);
+      } else if (load->buffer.scope() == "wgmma.accumulator") {
+        n->buffer = buffer_map_[load->buffer];
+        n->indices = WGMMAAccumulatorIndices(load->indices);
       } else if (load->buffer.scope() == "m16n8k8.matrixA" ||
                  load->buffer.scope() == "m16n8k8.matrixB") {
         n->buffer = buffer_map_[load->buffer];
@@ -172,6 +205,20 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
   }
 
  private:
+  /*! \brief Map the indices [..., i, j] of wgmma.accumulator to the lowered local buffer. */
+  ffi::Array<PrimExpr> WGMMAAccumulatorIndices(const ffi::Array<PrimExpr>& indices) {
+    size_t size = indices.size();
+    TVM_FFI_ICHECK_GE(size, 2);
+    ffi::Array<PrimExpr> result{indices.begin(), indices.end() - 2};
+    const PrimExpr& i = indices[size - 2];
+    const PrimExpr& j = indices[size - 1];
+    for (PrimExpr index : {floordiv(i, 64), floordiv(j, 8), floormod(floordiv(i, 8), 2),
+                           floormod(j, 2)}) {
+      result.push_back(analyzer.Simplify(index));
+    }
+    return result;
+  }
+
   std::unordered_map<Buffer, Buffer, ObjectPtrHash, ObjectPtrEqual> buffer_map_;
   std::unordered_map<Var, Var> buffer_var_map_;
   arith::Analyzer analyzer;
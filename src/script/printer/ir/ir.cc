@@ -17,6 +17,14 @@
  * under the License.
  */
 #include <tvm/ir/type.h>
+#include <tvm/runtime/threading_backend.h>
+#include <tvm/support/parallel_for.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include "./utils.h"
 
@@ -55,59 +63,88 @@ struct SortableFunction {
   }
 };
 
+std::vector<SortableFunction> SortFunctions(const IRModule& mod) {
+  std::vector<SortableFunction> functions;
+  for (const auto& kv : mod->functions) {
+    functions.push_back(SortableFunction(kv));
+  }
+  std::sort(functions.begin(), functions.end());
+  return functions;
+}
+
+/*!
+ * \brief Enter the frame of a module.
+ * \return The doc of the module.
+ */
+IdDoc EnterModuleFrame(const IRModule& mod, const IRDocsifier& d, const IRFrame& f) {
+  f->AddDispatchToken(d, "ir");
+  IdDoc module_doc = d->Define(mod, f, GetBindingName(d).value_or("Module"));
+  f->global_infos = &mod->global_infos;
+  return module_doc;
+}
+
+/*! \brief Declare the GlobalVars of a module in its frame. */
+void DeclareGlobalVars(const IRModule& mod, const std::vector<SortableFunction>& functions,
+                       const AccessPath& p, const IRDocsifier& d, const IRFrame& f) {
+  for (const auto& entry : functions) {
+    const GlobalVar& gv = entry.gv;
+    d->Define(gv, f, [=]() {
+      return d->AsDoc<ExprDoc>(mod, p->Attr("global_vars"))->Attr(gv->name_hint);
+    });
+  }
+}
+
+/*! \brief Add the statements of the attributes and the global infos of a module. */
+void AddModulePrelude(const IRModule& mod, const AccessPath& p, const IRDocsifier& d,
+                      const IRFrame& f) {
+  if (mod->attrs.defined() && !mod->attrs->dict.empty()) {
+    f->stmts.push_back(
+        ExprStmtDoc(IR(d, "module_attrs")  //
+                        ->Call({d->AsDoc<ExprDoc>(mod->attrs, p->Attr("attrs"))})));
+  }
+  if (mod->global_infos.defined() && !mod->global_infos.empty()) {
+    f->stmts.push_back(
+        ExprStmtDoc(IR(d, "module_global_infos")  //
+                        ->Call({d->AsDoc<ExprDoc>(mod->global_infos, p->Attr("global_infos"))})));
+  }
+}
+
+/*! \brief Convert a function of a module to the statement in the body of the module. */
+StmtDoc FunctionToStmtDoc(const SortableFunction& entry, const AccessPath& p,
+                          const IRDocsifier& d) {
+  const GlobalVar& gv = entry.gv;
+  const BaseFunc& base_func = entry.func;
+  d->cfg->binding_names.push_back(gv->name_hint);
+  Doc doc = d->AsDoc(base_func, p->Attr("functions")->MapItem(gv));
+  d->cfg->binding_names.pop_back();
+  if (const auto* stmt_block = doc.as<StmtBlockDocNode>()) {
+    StmtDoc stmt = stmt_block->stmts.back();
+    stmt->source_paths = std::move(doc->source_paths);
+    return stmt;
+  } else if (auto stmt = doc.as<StmtDoc>()) {
+    return stmt.value();
+  } else if (auto func = doc.as<FunctionDoc>()) {
+    return func.value();
+  } else if (auto expr = doc.as<ExprDoc>()) {
+    return AssignDoc(IdDoc(gv->name_hint), expr.value(), std::nullopt);
+  }
+  TVM_FFI_THROW(TypeError) << "Expected IRModule to only contain functions, "
+                           << " but mod[" << gv->name_hint << "] with type  "
+                           << base_func->GetTypeKey() << " produced Doc type of "
+                           << doc->GetTypeKey();
+}
+
 TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
     .set_dispatch<IRModule>("", [](IRModule mod, AccessPath p, IRDocsifier d) -> Doc {
-      std::vector<SortableFunction> functions;
-      for (const auto& kv : mod->functions) {
-        functions.push_back(SortableFunction(kv));
-      }
-      std::sort(functions.begin(), functions.end());
+      std::vector<SortableFunction> functions = SortFunctions(mod);
       With<IRFrame> f(d);
-      (*f)->AddDispatchToken(d, "ir");
-      IdDoc module_doc = d->Define(mod, f(), GetBindingName(d).value_or("Module"));
-      (*f)->global_infos = &mod->global_infos;
-      if (mod->attrs.defined() && !mod->attrs->dict.empty()) {
-        (*f)->stmts.push_back(
-            ExprStmtDoc(IR(d, "module_attrs")  //
-                            ->Call({d->AsDoc<ExprDoc>(mod->attrs, p->Attr("attrs"))})));
-      }
-      if (mod->global_infos.defined() && !mod->global_infos.empty()) {
-        (*f)->stmts.push_back(ExprStmtDoc(
-            IR(d, "module_global_infos")  //
-                ->Call({d->AsDoc<ExprDoc>(mod->global_infos, p->Attr("global_infos"))})));
-      }
+      IdDoc module_doc = EnterModuleFrame(mod, d, *f);
+      AddModulePrelude(mod, p, d, *f);
       // Declare GlobalVars first
-      IdDoc module_alias = d->cfg->module_alias.empty() ? module_doc : IdDoc(d->cfg->module_alias);
-      for (const auto& entry : functions) {
-        const GlobalVar& gv = entry.gv;
-        d->Define(gv, f(), [=]() {
-          return d->AsDoc<ExprDoc>(mod, p->Attr("global_vars"))->Attr(gv->name_hint);
-        });
-      }
+      DeclareGlobalVars(mod, functions, p, d, *f);
       // Print functions
       for (const auto& entry : functions) {
-        const GlobalVar& gv = entry.gv;
-        const BaseFunc& base_func = entry.func;
-        d->cfg->binding_names.push_back(gv->name_hint);
-        Doc doc = d->AsDoc(base_func, p->Attr("functions")->MapItem(gv));
-        d->cfg->binding_names.pop_back();
-        if (const auto* stmt_block = doc.as<StmtBlockDocNode>()) {
-          (*f)->stmts.push_back(stmt_block->stmts.back());
-          (*f)->stmts.back()->source_paths = std::move(doc->source_paths);
-        } else if (auto stmt = doc.as<StmtDoc>()) {
-          (*f)->stmts.push_back(stmt.value());
-        } else if (auto func = doc.as<FunctionDoc>()) {
-          (*f)->stmts.push_back(func.value());
-        } else if (auto expr = doc.as<ExprDoc>()) {
-          ExprDoc lhs = IdDoc(gv->name_hint);
-          AssignDoc assignment(lhs, expr.value(), std::nullopt);
-          (*f)->stmts.push_back(assignment);
-        } else {
-          TVM_FFI_THROW(TypeError)
-              << "Expected IRModule to only contain functions, "
-              << " but mod[" << gv->name_hint << "] with type  " << base_func->GetTypeKey()
-              << " produced Doc type of " << doc->GetTypeKey();
-        }
+        (*f)->stmts.push_back(FunctionToStmtDoc(entry, p, d));
       }
       return HeaderWrapper(d, ClassDoc(module_doc, {IR(d, "ir_module")}, (*f)->stmts));
     });
@@ -160,10 +197,116 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
           });
     });
 
+/*! \brief The text of a function of a module, printed in the body of the module. */
+struct FunctionScript {
+  /*! \brief The text, from the new line before the function. */
+  std::string text;
+  /*! \brief Whether the function is printed as a `def`, which is followed by an empty line. */
+  bool is_function_def = false;
+  /*! \brief Whether the function refers to the metadata. */
+  bool has_metadata = false;
+  /*! \brief The IR prefixes used by the function. */
+  std::unordered_set<std::string> ir_usage;
+};
+
+/*!
+ * \brief Print a module to a stream, with the same text as `TVMScriptPrinter::Script`.
+ *
+ * The functions are docsified and printed in parallel, each by its own docsifier, so that only
+ * the docs of the functions being printed are alive at once, instead of the doc of the whole
+ * module. The modules that need the metadata, line numbers or underlines, which are shared by
+ * all the functions, are printed by `TVMScriptPrinter::Script` instead.
+ *
+ * \param mod The module to be printed.
+ * \param cfg The printer config.
+ * \param num_threads The number of threads printing the functions, or 0 for all the cores.
+ * \param os The output stream.
+ */
+void ScriptIRModuleToStream(const IRModule& mod, const PrinterConfig& cfg, int num_threads,
+                            std::ostream& os) {
+  if (cfg->print_line_numbers || !cfg->path_to_underline.empty() ||
+      !cfg->obj_to_underline.empty()) {
+    os << TVMScriptPrinter::Script(mod, cfg);
+    return;
+  }
+  if (num_threads <= 0) {
+    num_threads = runtime::threading::MaxConcurrency();
+  }
+  AccessPath p = AccessPath::Root();
+  std::vector<SortableFunction> functions = SortFunctions(mod);
+  std::vector<FunctionScript> scripts(functions.size());
+  support::parallel_for_dynamic(
+      0, static_cast<int>(functions.size()), num_threads, [&](int thread_id, int i) {
+        // The binding names of the config are modified while docsifying.
+        PrinterConfig func_cfg(ffi::make_object<PrinterConfigNode>(*cfg.get()));
+        IRDocsifier d(func_cfg);
+        With<IRFrame> f(d);
+        IdDoc module_doc = EnterModuleFrame(mod, d, *f);
+        DeclareGlobalVars(mod, functions, p, d, *f);
+        StmtDoc stmt = FunctionToStmtDoc(functions[i], p, d);
+        FunctionScript& script = scripts[i];
+        script.is_function_def = stmt->IsInstance<FunctionDocNode>();
+        script.has_metadata = !d->metadata.empty();
+        script.ir_usage = d->ir_usage;
+        // Print the function in the body of the module, to be indented in the same way, and drop
+        // the line of the class.
+        std::string text = DocToPythonScript(ClassDoc(module_doc, {}, {stmt}), func_cfg);
+        script.text = text.substr(text.find('\n'));
+      });
+
+  IRDocsifier d(cfg);
+  With<IRFrame> f(d);
+  IdDoc module_doc = EnterModuleFrame(mod, d, *f);
+  AddModulePrelude(mod, p, d, *f);
+  bool has_metadata = !d->metadata.empty();
+  for (const FunctionScript& script : scripts) {
+    has_metadata |= script.has_metadata;
+    d->ir_usage.insert(script.ir_usage.begin(), script.ir_usage.end());
+  }
+  if (has_metadata) {
+    os << TVMScriptPrinter::Script(mod, cfg);
+    return;
+  }
+  bool empty_prelude = (*f)->stmts.empty();
+  std::string header = DocToPythonScript(
+      HeaderWrapper(d, ClassDoc(module_doc, {IR(d, "ir_module")}, (*f)->stmts)), cfg);
+  // The class without statements is printed with `pass`, which the functions replace.
+  std::string pass_line = "\n" + std::string(cfg->indent_spaces, ' ') + "pass";
+  if (empty_prelude && !scripts.empty() && header.size() >= pass_line.size() &&
+      header.compare(header.size() - pass_line.size(), pass_line.size(), pass_line) == 0) {
+    header.resize(header.size() - pass_line.size());
+  }
+  os << header;
+  for (size_t i = 0; i < scripts.size(); ++i) {
+    os << scripts[i].text;
+    if (scripts[i].is_function_def && i + 1 < scripts.size()) {
+      os << "\n";
+    }
+    std::string().swap(scripts[i].text);
+  }
+}
+
 std::string ReprPrintIRModule(const ObjectRef& mod, const PrinterConfig& cfg) {
   return ReprPrintIR(mod, cfg);
 }
 
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("script.printer.IRModuleScriptParallel",
+           [](IRModule mod, PrinterConfig cfg, int num_threads) {
+             std::ostringstream os;
+             ScriptIRModuleToStream(mod, cfg, num_threads, os);
+             return os.str();
+           })
+      .def("script.printer.IRModuleScriptToFile",
+           [](IRModule mod, PrinterConfig cfg, int num_threads, ffi::String path) {
+             std::ofstream os(std::string(path));
+             TVM_FFI_ICHECK(os) << "Cannot open " << path << " for writing";
+             ScriptIRModuleToStream(mod, cfg, num_threads, os);
+           });
+}
+
 TVM_SCRIPT_REPR(GlobalVarNode, ReprPrintIR);
 TVM_SCRIPT_REPR(DictAttrsNode, ReprPrintIR);
 TVM_SCRIPT_REPR(FuncTypeNode, ReprPrintIR);
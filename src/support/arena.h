@@ -70,6 +70,41 @@ class SimplePageAllocator {
 
 using Arena = GenericArena<SimplePageAllocator>;
 
+/*!
+ * \brief An allocator of the standard containers that allocates from an arena, e.g. for the
+ *  temporary data of a pass, whose nodes are then freed at once with the arena.
+ * \tparam T The value type of the allocator.
+ * \note The memory deallocated is only reclaimed when the arena is destroyed, so the containers
+ *  that shrink and grow many times keep all the memory they ever allocated.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}  // NOLINT(*)
+
+  T* allocate(size_t n) { return arena_->template allocate_<T>(static_cast<int>(n)); }
+  void deallocate(T* ptr, size_t n) {}
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+  /*! \brief The arena to allocate from. */
+  Arena* arena_;
+};
+
 /*!
  * \brief Link list node
  * \tparam T the content data type
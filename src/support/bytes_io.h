@@ -66,6 +66,18 @@ class BytesInStream : public Stream {
     return 0;
   }
 
+  /*!
+   * \brief Read a region of the memory in place, without copying it.
+   * \param size The number of bytes of the region.
+   * \return The pointer to the region, or nullptr if fewer bytes are left in the stream.
+   */
+  const char* ReadInPlace(size_t size) {
+    if (size > size_ - pos_) return nullptr;
+    const char* ptr = data_ + pos_;
+    pos_ += size;
+    return ptr;
+  }
+
  private:
   const char* data_;
   size_t size_;
@@ -93,6 +105,9 @@ class BytesOutStream : public Stream {
     return 0;
   }
 
+  /*! \return The size of the buffer, i.e. the offset of the next byte written in it. */
+  size_t Tell() const { return buffer_->size(); }
+
  private:
   std::string* buffer_;
 };
@@ -122,6 +122,10 @@
 #define TVM_INFO_USE_OPENMP "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_PERF_EVENT
+#define TVM_INFO_USE_PERF_EVENT "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_DEBUG_WITH_ABI_CHANGE
 #define TVM_INFO_DEBUG_WITH_ABI_CHANGE "NOT-FOUND"
 #endif
@@ -166,6 +170,10 @@
 #define TVM_INFO_USE_DNNL "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_BENCHMARK
+#define TVM_INFO_USE_BENCHMARK "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_CUDNN
 #define TVM_INFO_USE_CUDNN "NOT-FOUND"
 #endif
@@ -186,6 +194,10 @@
 #define TVM_INFO_USE_SORT "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_ZSTD
+#define TVM_INFO_USE_ZSTD "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_RANDOM
 #define TVM_INFO_USE_RANDOM "NOT-FOUND"
 #endif
@@ -266,6 +278,7 @@ TVM_DLL ffi::Map<ffi::String, ffi::String> GetLibInfo() {
       {"USE_AMX", TVM_INFO_USE_AMX},
       {"USE_DNNL", TVM_INFO_USE_DNNL},
       {"USE_GTEST", TVM_INFO_USE_GTEST},
+      {"USE_BENCHMARK", TVM_INFO_USE_BENCHMARK},
       {"USE_HEXAGON", TVM_INFO_USE_HEXAGON},
       {"USE_HEXAGON_RPC", TVM_INFO_USE_HEXAGON_RPC},
       {"USE_HEXAGON_SDK", TVM_INFO_USE_HEXAGON_SDK},
@@ -283,7 +296,9 @@ TVM_DLL ffi::Map<ffi::String, ffi::String> GetLibInfo() {
       {"USE_OPENCL_EXTN_QCOM", TVM_INFO_USE_OPENCL_EXTN_QCOM},
       {"USE_OPENCL_GTEST", TVM_INFO_USE_OPENCL_GTEST},
       {"USE_OPENMP", TVM_INFO_USE_OPENMP},
+      {"USE_PERF_EVENT", TVM_INFO_USE_PERF_EVENT},
       {"USE_RANDOM", TVM_INFO_USE_RANDOM},
+      {"USE_ZSTD", TVM_INFO_USE_ZSTD},
       {"TVM_DEBUG_WITH_ABI_CHANGE", TVM_INFO_TVM_DEBUG_WITH_ABI_CHANGE},
       {"TVM_LOG_BEFORE_THROW", TVM_INFO_TVM_LOG_BEFORE_THROW},
       {"USE_HIPBLAS", TVM_INFO_USE_HIPBLAS},
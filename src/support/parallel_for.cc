@@ -24,7 +24,14 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -47,50 +54,153 @@ std::vector<std::vector<int>> rr_partitioner(int begin, int end, int step, int n
   return ret;
 }
 
-void parallel_for(int begin, int end, const std::function<void(int)>& f, int step,
-                  const PartitionerFuncType partitioner) {
-  static bool GLOBAL_PARALLEL_FOR_FLAG{false};
-  static std::mutex M_GLOBAL_PARALLEL_FOR_FLAG;
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    TVM_FFI_ICHECK(!GLOBAL_PARALLEL_FOR_FLAG)
-        << "There's another parallel_for running. Maybe you're "
-        << "currently inside another parallel_for loop.";
-    GLOBAL_PARALLEL_FOR_FLAG = true;
+namespace {
+
+/*!
+ * \brief The partitions of one parallel_for call.
+ *
+ * Partitions are claimed through an atomic counter, so the calling thread and any pool
+ * worker holding a ticket of the group can run them. The group outlives the call while
+ * tickets are still queued, but then all its partitions have been claimed and `f` is
+ * never touched again.
+ */
+struct TaskGroup {
+  TaskGroup(const std::vector<std::vector<int>>* partitions, const std::function<void(int)>* f)
+      : partitions(partitions),
+        f(f),
+        num_partitions(static_cast<int>(partitions->size())),
+        num_pending(num_partitions) {}
+
+  /*! \brief Run partitions until all of them have been claimed. */
+  void RunAvailable() {
+    for (int i; (i = next.fetch_add(1)) < num_partitions;) {
+      try {
+        for (int index : (*partitions)[i]) {
+          (*f)(index);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+      }
+      if (num_pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+      }
+    }
   }
 
-  int default_num_threads = std::thread::hardware_concurrency();
-  const auto& run_partitions = partitioner(begin, end, step, default_num_threads);
+  /*! \brief Wait until every claimed partition has finished. */
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return num_pending.load() == 0; });
+  }
 
-  std::vector<std::thread> threads;
-  threads.reserve(run_partitions.size());
-  std::vector<std::future<void>> res_vec;
-  res_vec.reserve(run_partitions.size());
-  for (const auto& run_partition : run_partitions) {
-    std::packaged_task<void(const std::vector<int>&, const std::function<void(int)>&)> task(
-        [](const std::vector<int>& run_partition, const std::function<void(int)>& f) {
-          for (const auto& i : run_partition) {
-            f(i);
-          }
-        });
-    res_vec.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), run_partition, f);
+  const std::vector<std::vector<int>>* partitions;
+  const std::function<void(int)>* f;
+  const int num_partitions;
+  std::atomic<int> next{0};
+  std::atomic<int> num_pending;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr error;
+};
+
+/*!
+ * \brief The worker threads shared by all parallel_for calls in the process.
+ *
+ * Workers pick up tickets of task groups and help running them. A thread that waits on its
+ * own group always runs the unclaimed partitions inline first, so nested parallel_for calls
+ * cannot deadlock even when every worker is busy.
+ */
+class TaskPool {
+ public:
+  static TaskPool* Global() {
+    static TaskPool inst;
+    return &inst;
   }
 
-  for (auto&& thread : threads) {
-    thread.join();
+  int NumWorkers() const { return static_cast<int>(workers_.size()); }
+
+  void Submit(const std::shared_ptr<TaskGroup>& group, int num_tickets) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int i = 0; i < num_tickets; ++i) {
+        tickets_.push_back(group);
+      }
+    }
+    if (num_tickets == 1) {
+      cv_.notify_one();
+    } else {
+      cv_.notify_all();
+    }
+  }
+
+ private:
+  TaskPool() {
+    int num_workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    for (int i = 0; i < num_workers; ++i) {
+      workers_.emplace_back([this] { this->RunWorker(); });
+    }
   }
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    TVM_FFI_ICHECK(GLOBAL_PARALLEL_FOR_FLAG);
-    GLOBAL_PARALLEL_FOR_FLAG = false;
+
+  ~TaskPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      exit_now_ = true;
+    }
+    cv_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
   }
-  try {
-    for (auto&& i : res_vec) {
-      i.get();
+
+  void RunWorker() {
+    while (true) {
+      std::shared_ptr<TaskGroup> group;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return exit_now_ || !tickets_.empty(); });
+        if (exit_now_) return;
+        group = std::move(tickets_.front());
+        tickets_.pop_front();
+      }
+      group->RunAvailable();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<TaskGroup>> tickets_;
+  bool exit_now_{false};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace
+
+void parallel_for(int begin, int end, const std::function<void(int)>& f, int step,
+                  const PartitionerFuncType partitioner) {
+  int default_num_threads = std::thread::hardware_concurrency();
+  const auto& run_partitions = partitioner(begin, end, step, default_num_threads);
+  if (run_partitions.empty()) {
+    return;
+  }
+
+  TaskPool* pool = TaskPool::Global();
+  auto group = std::make_shared<TaskGroup>(&run_partitions, &f);
+  int num_tickets = std::min(pool->NumWorkers(), static_cast<int>(run_partitions.size()) - 1);
+  if (num_tickets > 0) {
+    pool->Submit(group, num_tickets);
+  }
+  // The calling thread takes part in the work, then waits for the stolen partitions.
+  group->RunAvailable();
+  group->Wait();
+
+  if (group->error) {
+    try {
+      std::rethrow_exception(group->error);
+    } catch (const std::exception& e) {
+      TVM_FFI_THROW(InternalError) << "Parallel_for error with " << e.what();
     }
-  } catch (const std::exception& e) {
-    TVM_FFI_THROW(InternalError) << "Parallel_for error with " << e.what();
   }
 }
 
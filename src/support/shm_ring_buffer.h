@@ -0,0 +1,342 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file shm_ring_buffer.h
+ * \brief Single-producer single-consumer ring buffer in shared memory, used for IPC.
+ */
+#ifndef TVM_SUPPORT_SHM_RING_BUFFER_H_
+#define TVM_SUPPORT_SHM_RING_BUFFER_H_
+
+#include <tvm/ffi/extra/c_env_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/support/io.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace tvm {
+namespace support {
+
+/*!
+ * \brief A byte stream over a single-producer single-consumer ring buffer placed in shared
+ *  memory, so that two processes can exchange data without going through the kernel.
+ *
+ *  Both sides spin briefly and then sleep on a futex when the ring buffer is empty (reader)
+ *  or full (writer). A side only issues a wakeup when the other side is sleeping.
+ *
+ *  Shared-memory ring buffers are only supported on Linux. Elsewhere, `Create` returns
+ *  nullptr and the caller should fall back to a pipe.
+ */
+class ShmRingBuffer : public tvm::support::Stream {
+ public:
+  /*!
+   * \brief Create a new shared-memory ring buffer.
+   * \param capacity The capacity of the ring buffer in bytes.
+   * \param peer_alive The callback that checks whether the peer process is still alive.
+   * \return The created ring buffer, or nullptr if shared memory is not available.
+   */
+  static std::unique_ptr<ShmRingBuffer> Create(size_t capacity,
+                                               std::function<bool()> peer_alive) {
+#ifdef __linux__
+    static std::atomic<int> counter{0};
+    std::string name = "/dev/shm/tvm-disco-" + std::to_string(getpid()) + "-" +
+                       std::to_string(counter.fetch_add(1));
+    int fd = open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1) return nullptr;
+    size_t map_size = sizeof(Header) + capacity;
+    if (ftruncate(fd, map_size) != 0) {
+      close(fd);
+      unlink(name.c_str());
+      return nullptr;
+    }
+    void* base = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+      unlink(name.c_str());
+      return nullptr;
+    }
+    Header* header = new (base) Header();
+    header->capacity = capacity;
+    return std::unique_ptr<ShmRingBuffer>(
+        new ShmRingBuffer(std::move(name), base, map_size, std::move(peer_alive)));
+#else
+    return nullptr;
+#endif
+  }
+
+  /*!
+   * \brief Open a shared-memory ring buffer created by another process.
+   *  The shared-memory file is unlinked once it is mapped.
+   * \param name The name of the ring buffer.
+   * \param peer_alive The callback that checks whether the peer process is still alive.
+   * \return The opened ring buffer.
+   */
+  static std::unique_ptr<ShmRingBuffer> Open(const std::string& name,
+                                             std::function<bool()> peer_alive) {
+#ifdef __linux__
+    int fd = open(name.c_str(), O_RDWR);
+    TVM_FFI_ICHECK_NE(fd, -1) << "Cannot open shared memory " << name << ": " << strerror(errno);
+    struct stat st;
+    TVM_FFI_ICHECK_EQ(fstat(fd, &st), 0) << "Cannot stat shared memory " << name;
+    size_t map_size = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    TVM_FFI_ICHECK(base != MAP_FAILED)
+        << "Cannot map shared memory " << name << ": " << strerror(errno);
+    unlink(name.c_str());
+    return std::unique_ptr<ShmRingBuffer>(
+        new ShmRingBuffer(name, base, map_size, std::move(peer_alive)));
+#else
+    TVM_FFI_THROW(InternalError) << "Shared-memory ring buffer is only supported on Linux";
+    return nullptr;
+#endif
+  }
+
+  /*! \brief destructor */
+  ~ShmRingBuffer() {
+#ifdef __linux__
+    Close();
+    munmap(base_, map_size_);
+    unlink(name_.c_str());
+#endif
+  }
+
+  /*! \return The name of the ring buffer, used to open it from another process. */
+  const std::string& name() const { return name_; }
+
+  using Stream::Read;
+  using Stream::Write;
+
+  /*!
+   * \brief Read data from the ring buffer, blocking until `size` bytes are read.
+   * \param ptr pointer to a memory buffer
+   * \param size block size
+   * \return the size of data read, which is less than `size` only when the peer is closed.
+   */
+  size_t Read(void* ptr, size_t size) final {
+    size_t nread = 0;
+#ifdef __linux__
+    uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    while (nread < size) {
+      uint64_t head = header_->head.load();
+      if (head == tail) {
+        bool ready = WaitUntil([&]() { return header_->head.load() != tail; },
+                               &header_->data_seq, &header_->reader_waiting);
+        if (!ready) break;
+        continue;
+      }
+      size_t nchunk = std::min<uint64_t>(head - tail, size - nread);
+      CopyFromRing(tail, static_cast<char*>(ptr) + nread, nchunk);
+      tail += nchunk;
+      nread += nchunk;
+      header_->tail.store(tail);
+      Notify(&header_->space_seq, &header_->writer_waiting);
+    }
+#endif
+    return nread;
+  }
+
+  /*!
+   * \brief Write data to the ring buffer, blocking until all the data is written.
+   * \param ptr pointer to a memory buffer
+   * \param size block size
+   * \return the size of data written
+   */
+  size_t Write(const void* ptr, size_t size) final {
+    size_t nwrite = 0;
+#ifdef __linux__
+    const uint64_t capacity = header_->capacity;
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    while (nwrite < size) {
+      uint64_t tail = header_->tail.load();
+      if (head - tail == capacity) {
+        bool ready = WaitUntil([&]() { return head - header_->tail.load() != capacity; },
+                               &header_->space_seq, &header_->writer_waiting);
+        TVM_FFI_ICHECK(ready) << "The reader of shared memory " << name_ << " has exited";
+        continue;
+      }
+      size_t nchunk = std::min<uint64_t>(capacity - (head - tail), size - nwrite);
+      CopyToRing(head, static_cast<const char*>(ptr) + nwrite, nchunk);
+      head += nchunk;
+      nwrite += nchunk;
+      header_->head.store(head);
+      Notify(&header_->data_seq, &header_->reader_waiting);
+    }
+#endif
+    return nwrite;
+  }
+
+  /*! \brief Mark the ring buffer as closed and wake up the peer. */
+  void Close() {
+#ifdef __linux__
+    header_->closed.store(1);
+    header_->data_seq.fetch_add(1);
+    header_->space_seq.fetch_add(1);
+    FutexWake(&header_->data_seq);
+    FutexWake(&header_->space_seq);
+#endif
+  }
+
+ private:
+  /*! \brief The number of polls before sleeping on the futex. */
+  static constexpr int kSpinCount = 4096;
+  /*! \brief The timeout of each futex wait in milliseconds, after which the peer is checked. */
+  static constexpr int kWaitTimeoutMs = 100;
+
+  /*! \brief The control block at the beginning of the shared memory. */
+  struct Header {
+    /*! \brief The total number of bytes ever written. Only updated by the writer. */
+    alignas(64) std::atomic<uint64_t> head{0};
+    /*! \brief The total number of bytes ever read. Only updated by the reader. */
+    alignas(64) std::atomic<uint64_t> tail{0};
+    /*! \brief The futex word waited on by the reader, bumped when data is written. */
+    alignas(64) std::atomic<uint32_t> data_seq{0};
+    /*! \brief Whether the reader is sleeping on `data_seq`. */
+    std::atomic<uint32_t> reader_waiting{0};
+    /*! \brief The futex word waited on by the writer, bumped when data is read. */
+    alignas(64) std::atomic<uint32_t> space_seq{0};
+    /*! \brief Whether the writer is sleeping on `space_seq`. */
+    std::atomic<uint32_t> writer_waiting{0};
+    /*! \brief Whether either side has closed the ring buffer. */
+    alignas(64) std::atomic<uint32_t> closed{0};
+    /*! \brief The capacity of the data region in bytes. */
+    uint64_t capacity{0};
+  };
+  static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                    std::atomic<uint32_t>::is_always_lock_free,
+                "Shared-memory ring buffer requires lock-free atomics");
+
+  ShmRingBuffer(std::string name, void* base, size_t map_size, std::function<bool()> peer_alive)
+      : name_(std::move(name)),
+        base_(base),
+        map_size_(map_size),
+        header_(static_cast<Header*>(base)),
+        data_(static_cast<char*>(base) + sizeof(Header)),
+        peer_alive_(std::move(peer_alive)) {}
+
+#ifdef __linux__
+  /*!
+   * \brief Wait until `fready` holds, spinning first and then sleeping on the futex `seq`.
+   * \return Whether `fready` holds. False means the ring buffer is closed or the peer exited.
+   */
+  template <typename FReady>
+  bool WaitUntil(FReady fready, std::atomic<uint32_t>* seq, std::atomic<uint32_t>* waiting) {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (fready()) return true;
+    }
+    while (true) {
+      // Load the futex word before announcing the wait and re-checking the condition,
+      // so that a notification in between makes the futex wait return immediately.
+      uint32_t cur_seq = seq->load();
+      waiting->store(1);
+      if (fready()) {
+        waiting->store(0);
+        return true;
+      }
+      if (header_->closed.load()) {
+        waiting->store(0);
+        return false;
+      }
+      bool timed_out = FutexWait(seq, cur_seq);
+      waiting->store(0);
+      if (fready()) return true;
+      if (timed_out && peer_alive_ != nullptr && !peer_alive_()) return false;
+    }
+  }
+
+  /*! \brief Bump the futex word `seq` and wake up the peer if it is sleeping on it. */
+  static void Notify(std::atomic<uint32_t>* seq, std::atomic<uint32_t>* waiting) {
+    seq->fetch_add(1);
+    if (waiting->load()) {
+      FutexWake(seq);
+    }
+  }
+
+  /*! \return Whether the wait timed out. */
+  static bool FutexWait(std::atomic<uint32_t>* addr, uint32_t expected) {
+    struct timespec timeout;
+    timeout.tv_sec = kWaitTimeoutMs / 1000;
+    timeout.tv_nsec = (kWaitTimeoutMs % 1000) * 1000000L;
+    long ret = syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),  // NOLINT(runtime/int)
+                       FUTEX_WAIT, expected, &timeout, nullptr, 0);
+    if (ret == -1 && errno == EINTR && TVMFFIEnvCheckSignals() != 0) {
+      throw ffi::EnvErrorAlreadySet();
+    }
+    return ret == -1 && errno == ETIMEDOUT;
+  }
+
+  static void FutexWake(std::atomic<uint32_t>* addr) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE, INT_MAX, nullptr, nullptr,
+            0);
+  }
+#endif
+
+  /*! \brief Copy `size` bytes starting at stream position `pos` out of the ring. */
+  void CopyFromRing(uint64_t pos, char* dst, size_t size) const {
+    size_t offset = pos % header_->capacity;
+    size_t ncopy = std::min<size_t>(size, header_->capacity - offset);
+    std::memcpy(dst, data_ + offset, ncopy);
+    std::memcpy(dst + ncopy, data_, size - ncopy);
+  }
+
+  /*! \brief Copy `size` bytes into the ring starting at stream position `pos`. */
+  void CopyToRing(uint64_t pos, const char* src, size_t size) {
+    size_t offset = pos % header_->capacity;
+    size_t ncopy = std::min<size_t>(size, header_->capacity - offset);
+    std::memcpy(data_ + offset, src, ncopy);
+    std::memcpy(data_, src + ncopy, size - ncopy);
+  }
+
+  /*! \brief The name of the shared-memory file. */
+  std::string name_;
+  /*! \brief The base address of the mapping. */
+  void* base_;
+  /*! \brief The size of the mapping in bytes. */
+  size_t map_size_;
+  /*! \brief The control block. */
+  Header* header_;
+  /*! \brief The data region right after the control block. */
+  char* data_;
+  /*! \brief The callback that checks whether the peer process is still alive. */
+  std::function<bool()> peer_alive_;
+};
+
+}  // namespace support
+}  // namespace tvm
+
+#endif  // TVM_SUPPORT_SHM_RING_BUFFER_H_
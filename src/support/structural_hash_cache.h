@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership. The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file support/structural_hash_cache.h
+ * \brief A memo of the structural hashes of IR nodes, for code that hashes and compares the
+ *  same nodes repeatedly.
+ */
+#ifndef TVM_SUPPORT_STRUCTURAL_HASH_CACHE_H_
+#define TVM_SUPPORT_STRUCTURAL_HASH_CACHE_H_
+
+#include <tvm/ffi/extra/structural_equal.h>
+#include <tvm/ffi/extra/structural_hash.h>
+#include <tvm/runtime/object.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace tvm {
+namespace support {
+
+/*!
+ * \brief StructuralHashCache memoizes the structural hash of the nodes it hashes, and uses it
+ *  to short-circuit structural equality.
+ *
+ * The cache keeps the nodes it hashed alive. A node that is referenced by the cache is never
+ * mutated in place by copy-on-write, so the memoized hash of a node stays valid for as long as
+ * the node is in the cache. The hashes are the ones of ffi::StructuralHash with the same
+ * options, so they can be mixed with hashes computed without the cache.
+ *
+ * The cache is thread-safe. When it holds `max_size` nodes it is cleared.
+ *
+ * \code
+ *
+ * StructuralHashCache cache;
+ * uint64_t hash = cache.Hash(mod);  // traverses mod
+ * hash = cache.Hash(mod);           // free
+ * cache.Equal(mod, other);          // false without traversal if the hashes differ
+ *
+ * \endcode
+ */
+class StructuralHashCache {
+ public:
+  /*!
+   * \brief Constructor
+   * \param map_free_vars Whether free variables are mapped, as in ffi::StructuralHash.
+   * \param skip_tensor_content Whether the content of tensors is ignored.
+   * \param max_size The number of nodes after which the cache is cleared.
+   */
+  explicit StructuralHashCache(bool map_free_vars = false, bool skip_tensor_content = false,
+                               size_t max_size = 4096)
+      : map_free_vars_(map_free_vars),
+        skip_tensor_content_(skip_tensor_content),
+        max_size_(max_size) {}
+
+  /*! \brief The structural hash of the node, computed once per node. */
+  uint64_t Hash(const ObjectRef& node) {
+    if (!node.defined()) {
+      return ffi::StructuralHash::Hash(node, map_free_vars_, skip_tensor_content_);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = table_.find(node.get());
+      if (it != table_.end()) {
+        return it->second.second;
+      }
+    }
+    uint64_t hash = ffi::StructuralHash::Hash(node, map_free_vars_, skip_tensor_content_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (table_.size() >= max_size_) {
+      table_.clear();
+    }
+    table_.emplace(node.get(), std::make_pair(node, hash));
+    return hash;
+  }
+
+  /*!
+   * \brief The structural equality of two nodes, which is false without a traversal when their
+   *  hashes differ, and true when they are the same node.
+   */
+  bool Equal(const ObjectRef& lhs, const ObjectRef& rhs) {
+    if (lhs.same_as(rhs)) {
+      return true;
+    }
+    if (Hash(lhs) != Hash(rhs)) {
+      return false;
+    }
+    return ffi::StructuralEqual::Equal(lhs, rhs, map_free_vars_, skip_tensor_content_);
+  }
+
+  /*! \brief Drop the memoized hashes, and the references to their nodes. */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table_.clear();
+  }
+
+  /*! \brief The number of memoized hashes. */
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return table_.size();
+  }
+
+ private:
+  bool map_free_vars_;
+  bool skip_tensor_content_;
+  size_t max_size_;
+  mutable std::mutex mutex_;
+  /*! \brief The memoized hash of each node, with a reference that keeps the node alive. */
+  std::unordered_map<const Object*, std::pair<ObjectRef, uint64_t>> table_;
+};
+
+}  // namespace support
+}  // namespace tvm
+
+#endif  // TVM_SUPPORT_STRUCTURAL_HASH_CACHE_H_
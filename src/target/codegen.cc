@@ -21,9 +21,11 @@
  * \file codegen.cc
  * \brief Common utilities to generated C style code.
  */
+#include <tvm/ffi/extra/structural_hash.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/runtime/base.h>
 #include <tvm/runtime/module.h>
 #include <tvm/support/io.h>
@@ -35,15 +37,128 @@
 
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <optional>
+#include <random>
 #include <sstream>
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "../runtime/file_utils.h"
 #include "../support/bytes_io.h"
 
 namespace tvm {
 namespace codegen {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("target.build_cache_dir", ffi::String);
+
+/*!
+ * \brief An on-disk cache of the runtime modules generated by `Build`, shared across processes.
+ *
+ * An entry is keyed by the structural hash of the module to build, the target, the pass config
+ * and the TVM version, so any of them changing misses the cache. Modules that are binary
+ * serializable are stored as their bytes, and LLVM modules as their LLVM IR, which makes a
+ * cache hit skip the code generation and the optimization of the IR. Other modules, and
+ * modules with imports, are never cached.
+ */
+class BuildCache {
+ public:
+  /*! \brief The cache configured in the current pass context, if any. */
+  static std::optional<BuildCache> Current(const IRModule& mod, const Target& target) {
+    transform::PassContext ctx = transform::PassContext::Current();
+    ffi::Optional<ffi::String> dir = ctx->GetConfig<ffi::String>("target.build_cache_dir");
+    if (!dir.has_value() || dir.value().empty()) {
+      return std::nullopt;
+    }
+    ffi::Map<ffi::String, Any> config = ctx->config;
+    config.erase("target.build_cache_dir");
+    uint64_t hash;
+    try {
+      hash = ffi::StructuralHash()(ffi::Array<Any>{mod, ffi::String(target->str()), config,
+                                                   ffi::String(TVM_VERSION)});
+    } catch (const ffi::Error& e) {
+      // The pass config holds values without a structural hash, e.g. Python callbacks
+      return std::nullopt;
+    }
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << hash;
+    std::filesystem::path path(std::string(dir.value()));
+    std::filesystem::create_directories(path);
+    return BuildCache(path / (os.str() + "." + target->kind->name));
+  }
+
+  /*! \brief Load the cached module, or std::nullopt if the entry is missing. */
+  std::optional<ffi::Module> Load() const {
+    if (!std::filesystem::exists(path_)) {
+      return std::nullopt;
+    }
+    std::string blob;
+    runtime::LoadBinaryFromFile(path_.string(), &blob);
+    support::BytesInStream stream(blob.data(), blob.size());
+    std::string kind, payload;
+    if (!stream.Read(&kind) || !stream.Read(&payload)) {
+      return std::nullopt;
+    }
+    if (kind == "llvm") {
+      std::string ll_path = TempPath(".ll");
+      runtime::SaveBinaryToFile(ll_path, payload);
+      auto loader = ffi::Function::GetGlobal("ffi.Module.load_from_file.ll");
+      TVM_FFI_ICHECK(loader.has_value()) << "ffi.Module.load_from_file.ll is not enabled";
+      ffi::Module m = (*loader)(ll_path, std::string("ll")).cast<ffi::Module>();
+      std::filesystem::remove(ll_path);
+      return m;
+    }
+    auto loader = ffi::Function::GetGlobal("ffi.Module.load_from_bytes." + kind);
+    if (!loader.has_value()) {
+      return std::nullopt;
+    }
+    return (*loader)(ffi::Bytes(payload)).cast<ffi::Module>();
+  }
+
+  /*! \brief Store the module, unless it can neither be serialized nor saved as LLVM IR. */
+  void Save(const ffi::Module& m) const {
+    if (!m->imports().empty()) {
+      return;
+    }
+    std::string kind = m->kind();
+    std::string payload;
+    if (m->GetPropertyMask() & ffi::Module::kBinarySerializable) {
+      payload = m->SaveToBytes();
+    } else if (kind == "llvm") {
+      std::string ll_path = TempPath(".ll");
+      m->WriteToFile(ll_path, "ll");
+      runtime::LoadBinaryFromFile(ll_path, &payload);
+      std::filesystem::remove(ll_path);
+    } else {
+      return;
+    }
+    std::string blob;
+    support::BytesOutStream stream(&blob);
+    stream.Write(kind);
+    stream.Write(payload);
+    // Write to a private file first, so that concurrent builds never read a partial entry
+    std::string tmp_path = TempPath(".tmp");
+    runtime::SaveBinaryToFile(tmp_path, blob);
+    std::filesystem::rename(tmp_path, path_);
+  }
+
+ private:
+  explicit BuildCache(std::filesystem::path path) : path_(std::move(path)) {}
+
+  /*! \brief A path next to the entry that no other process or thread uses. */
+  std::string TempPath(const std::string& ext) const {
+    std::ostringstream os;
+    os << path_.string() << "." << std::hex << std::random_device()() << ext;
+    return os.str();
+  }
+
+  /*! \brief The path of the entry. */
+  std::filesystem::path path_;
+};
+
 ffi::Module Build(IRModule mod, Target target) {
   if (transform::PassContext::Current()
           ->GetConfig<Bool>("tir.disable_assert", Bool(false))
@@ -51,11 +166,21 @@ ffi::Module Build(IRModule mod, Target target) {
     mod = tir::transform::SkipAssert()(mod);
   }
 
+  std::optional<BuildCache> cache = BuildCache::Current(mod, target);
+  if (cache.has_value()) {
+    if (std::optional<ffi::Module> cached = cache->Load()) {
+      return cached.value();
+    }
+  }
   // the build function.
   std::string build_f_name = "target.build." + target->kind->name;
   const auto bf = tvm::ffi::Function::GetGlobal(build_f_name);
   TVM_FFI_ICHECK(bf.has_value()) << build_f_name << " is not enabled";
-  return (*bf)(mod, target).cast<ffi::Module>();
+  ffi::Module m = (*bf)(mod, target).cast<ffi::Module>();
+  if (cache.has_value()) {
+    cache->Save(m);
+  }
+  return m;
 }
 
 /*! \brief Helper class to serialize module */
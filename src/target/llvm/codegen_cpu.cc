@@ -38,6 +38,7 @@
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InlineAsm.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/MDBuilder.h>
@@ -49,6 +50,12 @@
 #endif
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
+#if LLVM_VERSION_MAJOR >= 17
+#include <llvm/TargetParser/Triple.h>
+#else
+#include <llvm/ADT/Triple.h>
+#endif
+#include <llvm/Transforms/Utils/Cloning.h>
 #include <llvm/Transforms/Utils/ModuleUtils.h>
 #include <tvm/runtime/base.h>
 #include <tvm/runtime/module.h>
@@ -65,6 +72,8 @@
 namespace tvm {
 namespace codegen {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("target.llvm_multiversion_mcpus", ffi::Array<ffi::String>);
+
 // Make these non-inline because of std::unique_ptr. See comment in
 // codegen_llvm.cc for more information.
 CodeGenCPU::CodeGenCPU() = default;
@@ -130,6 +139,7 @@ void CodeGenCPU::Init(const std::string& module_name, LLVMTarget* llvm_target,
       false);
   // Defined in include/tvm/runtime/c_backend_api.h:
   // int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task);
+  // int TVMBackendParallelLaunchChunked(FTVMParallelLambda flambda, void* cdata, int num_chunk);
   ftype_tvm_parallel_launch_ = llvm::FunctionType::get(
       t_int_, {llvmGetPointerTo(ftype_tvm_parallel_lambda_, 0), t_void_p_, t_int_}, false);
   // Defined in include/tvm/runtime/c_backend_api.h:
@@ -166,6 +176,9 @@ void CodeGenCPU::Init(const std::string& module_name, LLVMTarget* llvm_target,
     f_tvm_parallel_launch_ =
         llvm::Function::Create(ftype_tvm_parallel_launch_, llvm::Function::ExternalLinkage,
                                "TVMBackendParallelLaunch", module_.get());
+    f_tvm_parallel_launch_chunked_ =
+        llvm::Function::Create(ftype_tvm_parallel_launch_, llvm::Function::ExternalLinkage,
+                               "TVMBackendParallelLaunchChunked", module_.get());
     f_tvm_parallel_barrier_ =
         llvm::Function::Create(ftype_tvm_parallel_barrier_, llvm::Function::ExternalLinkage,
                                "TVMBackendParallelBarrier", module_.get());
@@ -225,6 +238,9 @@ void CodeGenCPU::AddFunction(const GlobalVar& gvar, const PrimFunc& func) {
           std::make_pair(global_symbol.value().operator std::string(), function_));
     }
   }
+  if (func->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol)) {
+    exported_functions_.push_back(function_);
+  }
   AddDebugInformation(function_, func->params.Map(GetType));
 }
 
@@ -277,9 +293,228 @@ std::unique_ptr<llvm::Module> CodeGenCPU::Finish() {
   if (dbg_info_ != nullptr) {
     dbg_info_->di_builder_->finalize();
   }
+  if (!GetPGOInstrumentFile().empty()) {
+    AddProfileWriteFunction();
+  }
+  auto mcpus = tvm::transform::PassContext::Current()->GetConfig<ffi::Array<ffi::String>>(
+      "target.llvm_multiversion_mcpus");
+  if (mcpus && mcpus.value().size()) {
+    AddCPUDispatch(mcpus.value());
+  }
   return CodeGenLLVM::Finish();
 }
 
+void CodeGenCPU::AddCPUDispatch(const ffi::Array<ffi::String>& mcpus) {
+  TVM_FFI_ICHECK(llvm_target_->GetOrCreateTargetMachine()->getTargetTriple().getArch() ==
+                 llvm::Triple::x86_64)
+      << "target.llvm_multiversion_mcpus is only supported for x86-64 targets";
+  // The variants, from the highest level, which are tried first.
+  std::vector<std::pair<int, std::string>> variants;
+  for (const ffi::String& mcpu : mcpus) {
+    static const char* levels[] = {"x86-64-v2", "x86-64-v3", "x86-64-v4"};
+    auto it = std::find(std::begin(levels), std::end(levels), std::string(mcpu));
+    TVM_FFI_ICHECK(it != std::end(levels))
+        << "target.llvm_multiversion_mcpus expects x86-64 micro-architecture levels, i.e. "
+        << "x86-64-v2, x86-64-v3 or x86-64-v4, but got " << mcpu;
+    variants.emplace_back(static_cast<int>(it - std::begin(levels)) + 2, mcpu);
+  }
+  std::sort(variants.rbegin(), variants.rend());
+  variants.erase(std::unique(variants.begin(), variants.end()), variants.end());
+
+  // Collect the functions defined in the module that an exported function reaches, through calls
+  // or function pointers such as the parallel lambdas.
+  auto reachable = [](llvm::Function* root) {
+    std::vector<llvm::Function*> functions = {root};
+    std::unordered_set<llvm::Function*> visited = {root};
+    for (size_t i = 0; i < functions.size(); ++i) {
+      for (llvm::BasicBlock& block : *functions[i]) {
+        for (llvm::Instruction& inst : block) {
+          for (llvm::Value* operand : inst.operands()) {
+            auto* callee = llvm::dyn_cast<llvm::Function>(operand->stripPointerCasts());
+            if (callee != nullptr && !callee->isDeclaration() && visited.insert(callee).second) {
+              functions.push_back(callee);
+            }
+          }
+        }
+      }
+    }
+    return functions;
+  };
+
+  // The dispatchers have no debug information.
+  builder_->SetCurrentDebugLocation(llvm::DebugLoc());
+  llvm::Function* f_level = GetCPULevelFunction();
+  for (llvm::Function* function : exported_functions_) {
+    std::vector<llvm::Function*> functions = reachable(function);
+    std::vector<llvm::Function*> entries;
+    for (const auto& [level, mcpu] : variants) {
+      // Clone the functions, and redirect the references among them to the clones.
+      std::unordered_map<llvm::Function*, llvm::Function*> clones;
+      for (llvm::Function* func : functions) {
+        llvm::ValueToValueMapTy vmap;
+        llvm::Function* clone = llvm::CloneFunction(func, vmap);
+        clone->setName(func->getName() + "." + mcpu);
+        clone->setLinkage(llvm::GlobalValue::InternalLinkage);
+        clone->setDLLStorageClass(llvm::GlobalValue::DefaultStorageClass);
+        clone->setComdat(nullptr);
+        clone->addFnAttr("target-cpu", mcpu);
+        clones[func] = clone;
+      }
+      for (const auto& [func, clone] : clones) {
+        for (llvm::BasicBlock& block : *clone) {
+          for (llvm::Instruction& inst : block) {
+            for (llvm::Use& use : inst.operands()) {
+              auto* callee = llvm::dyn_cast<llvm::Function>(use.get()->stripPointerCasts());
+              auto it = clones.find(callee);
+              if (it != clones.end()) {
+                use.set(llvm::ConstantExpr::getPointerCast(it->second, use.get()->getType()));
+              }
+            }
+          }
+        }
+      }
+      entries.push_back(clones.at(function));
+    }
+
+    // The baseline keeps the original body, and the exported function becomes the dispatcher.
+    llvm::ValueToValueMapTy vmap;
+    llvm::Function* baseline = llvm::CloneFunction(function, vmap);
+    baseline->setName(function->getName() + ".default");
+    baseline->setLinkage(llvm::GlobalValue::InternalLinkage);
+    baseline->setDLLStorageClass(llvm::GlobalValue::DefaultStorageClass);
+    baseline->setComdat(nullptr);
+    llvm::GlobalValue::LinkageTypes linkage = function->getLinkage();
+    function->deleteBody();
+    function->setLinkage(linkage);
+
+    llvm::LLVMContext* ctx = llvm_target_->GetContext();
+    builder_->SetInsertPoint(llvm::BasicBlock::Create(*ctx, "entry", function));
+    std::vector<llvm::Value*> args;
+    for (llvm::Argument& arg : function->args()) {
+      args.push_back(&arg);
+    }
+    auto tail_call = [&](llvm::Function* callee) {
+      llvm::CallInst* call = builder_->CreateCall(callee, args);
+      call->setTailCall(true);
+      if (function->getReturnType()->isVoidTy()) {
+        builder_->CreateRetVoid();
+      } else {
+        builder_->CreateRet(call);
+      }
+    };
+    llvm::Value* cpu_level = builder_->CreateCall(f_level, {});
+    for (size_t i = 0; i < variants.size(); ++i) {
+      auto* then_block = llvm::BasicBlock::Create(*ctx, "variant_" + variants[i].second, function);
+      auto* else_block = llvm::BasicBlock::Create(*ctx, "next", function);
+      builder_->CreateCondBr(builder_->CreateICmpSGE(cpu_level, ConstInt32(variants[i].first)),
+                             then_block, else_block);
+      builder_->SetInsertPoint(then_block);
+      tail_call(entries[i]);
+      builder_->SetInsertPoint(else_block);
+    }
+    tail_call(baseline);
+  }
+}
+
+llvm::Function* CodeGenCPU::GetCPULevelFunction() {
+  llvm::LLVMContext* ctx = llvm_target_->GetContext();
+  auto* cache = new llvm::GlobalVariable(*module_, t_int32_, false,
+                                         llvm::GlobalValue::InternalLinkage, ConstInt32(-1),
+                                         "__tvm_cpu_level");
+  cache->setAlignment(llvm::Align(4));
+  llvm::Function* function =
+      llvm::Function::Create(llvm::FunctionType::get(t_int32_, {}, false),
+                             llvm::Function::InternalLinkage, "__tvm_get_cpu_level", module_.get());
+  SetTargetAttributes(function);
+  auto* entry = llvm::BasicBlock::Create(*ctx, "entry", function);
+  auto* detect = llvm::BasicBlock::Create(*ctx, "detect", function);
+  auto* read_xcr0 = llvm::BasicBlock::Create(*ctx, "read_xcr0", function);
+  auto* finish = llvm::BasicBlock::Create(*ctx, "finish", function);
+  auto* cached = llvm::BasicBlock::Create(*ctx, "cached", function);
+
+  // The level is detected once, racing threads store the same value.
+  builder_->SetInsertPoint(entry);
+  llvm::LoadInst* level = builder_->CreateAlignedLoad(t_int32_, cache, llvm::Align(4));
+  level->setAtomic(llvm::AtomicOrdering::Monotonic);
+  builder_->CreateCondBr(builder_->CreateICmpSGE(level, ConstInt32(0)), cached, detect);
+  builder_->SetInsertPoint(cached);
+  builder_->CreateRet(level);
+
+  builder_->SetInsertPoint(detect);
+  llvm::StructType* t_cpuid = llvm::StructType::get(*ctx, {t_int32_, t_int32_, t_int32_, t_int32_});
+  llvm::InlineAsm* cpuid = llvm::InlineAsm::get(
+      llvm::FunctionType::get(t_cpuid, {t_int32_, t_int32_}, false), "cpuid",
+      "={ax},={bx},={cx},={dx},{ax},{cx},~{dirflag},~{fpsr},~{flags}", false);
+  auto const_uint32 = [this](uint32_t value) { return llvm::ConstantInt::get(t_int32_, value); };
+  auto call_cpuid = [&](uint32_t leaf) {
+    return builder_->CreateCall(cpuid, {const_uint32(leaf), ConstInt32(0)});
+  };
+  llvm::Value* max_leaf = builder_->CreateExtractValue(call_cpuid(0), 0);
+  llvm::Value* ecx1 = builder_->CreateExtractValue(call_cpuid(1), 2);
+  llvm::Value* ebx7 = builder_->CreateSelect(builder_->CreateICmpUGE(max_leaf, ConstInt32(7)),
+                                             builder_->CreateExtractValue(call_cpuid(7), 1),
+                                             ConstInt32(0));
+  llvm::Value* ecx_ext = builder_->CreateExtractValue(call_cpuid(0x80000001U), 2);
+  auto has_bits = [&](llvm::Value* value, uint32_t mask) {
+    return builder_->CreateICmpEQ(builder_->CreateAnd(value, const_uint32(mask)),
+                                  const_uint32(mask));
+  };
+  // xgetbv is only available if the OS enables it, i.e. OSXSAVE is set.
+  builder_->CreateCondBr(has_bits(ecx1, 1U << 27), read_xcr0, finish);
+  builder_->SetInsertPoint(read_xcr0);
+  llvm::StructType* t_xgetbv = llvm::StructType::get(*ctx, {t_int32_, t_int32_});
+  llvm::InlineAsm* xgetbv =
+      llvm::InlineAsm::get(llvm::FunctionType::get(t_xgetbv, {t_int32_}, false), "xgetbv",
+                           "={ax},={dx},{cx},~{dirflag},~{fpsr},~{flags}", false);
+  llvm::Value* xcr0_value =
+      builder_->CreateExtractValue(builder_->CreateCall(xgetbv, {ConstInt32(0)}), 0);
+  builder_->CreateBr(finish);
+
+  builder_->SetInsertPoint(finish);
+  llvm::PHINode* xcr0 = builder_->CreatePHI(t_int32_, 2);
+  xcr0->addIncoming(ConstInt32(0), detect);
+  xcr0->addIncoming(xcr0_value, read_xcr0);
+  // The features of the levels in the x86-64 psABI.
+  // v2: SSE3, SSSE3, CMPXCHG16B, SSE4.1, SSE4.2, POPCNT and LAHF-SAHF.
+  llvm::Value* v2 = builder_->CreateAnd(has_bits(ecx1, 0x00982201U), has_bits(ecx_ext, 0x1U));
+  // v3: AVX, AVX2, BMI1, BMI2, F16C, FMA, LZCNT, MOVBE and the OS saving the AVX state.
+  llvm::Value* v3 = builder_->CreateAnd(
+      builder_->CreateAnd(v2, has_bits(ecx1, 0x38401000U)),
+      builder_->CreateAnd(builder_->CreateAnd(has_bits(ebx7, 0x128U), has_bits(ecx_ext, 0x20U)),
+                          has_bits(xcr0, 0x6U)));
+  // v4: AVX512F, AVX512BW, AVX512CD, AVX512DQ, AVX512VL and the OS saving the AVX-512 state.
+  llvm::Value* v4 = builder_->CreateAnd(
+      v3, builder_->CreateAnd(has_bits(ebx7, 0xD0030000U), has_bits(xcr0, 0xE6U)));
+  llvm::Value* detected = builder_->CreateSelect(
+      v4, ConstInt32(4),
+      builder_->CreateSelect(v3, ConstInt32(3), builder_->CreateSelect(v2, ConstInt32(2),
+                                                                       ConstInt32(1))));
+  llvm::StoreInst* store = builder_->CreateAlignedStore(detected, cache, llvm::Align(4));
+  store->setAtomic(llvm::AtomicOrdering::Monotonic);
+  builder_->CreateRet(detected);
+  return function;
+}
+
+void CodeGenCPU::AddProfileWriteFunction() {
+  // The profile runtime of compiler-rt, linked with the exported library, writes the counters.
+  llvm::FunctionType* ftype_write = llvm::FunctionType::get(t_int_, {}, false);
+  llvm::FunctionCallee write_file =
+      module_->getOrInsertFunction("__llvm_profile_write_file", ftype_write);
+  std::string name =
+      std::string(ffi::symbol::tvm_ffi_symbol_prefix) + "__tvm_llvm_profile_write_file";
+  llvm::Function* function = llvm::Function::Create(
+      ftype_tvm_ffi_c_func_, llvm::Function::ExternalLinkage, name, module_.get());
+  function->setCallingConv(llvm::CallingConv::C);
+  function->setDLLStorageClass(llvm::GlobalValue::DLLStorageClassTypes::DLLExportStorageClass);
+  SetTargetAttributes(function);
+  llvm::BasicBlock* entry =
+      llvm::BasicBlock::Create(*llvm_target_->GetContext(), "entry", function);
+  builder_->SetInsertPoint(entry);
+  // The runtime reports its own errors, and the function returns None.
+  builder_->CreateCall(write_file, {});
+  builder_->CreateRet(ConstInt32(0));
+}
+
 CodeGenLLVM::TypedPointer CodeGenCPU::CreateStructRefPtr(DataType t, llvm::Value* buf,
                                                          llvm::Value* index, int kind) {
   if (kind < builtin::kArrKindBound_) {
@@ -476,6 +711,8 @@ void CodeGenCPU::InitGlobalContext(bool dynamic_lookup) {
                          "__TVMFFIErrorSetRaisedFromCStr");
       gv_tvm_parallel_launch_ = InitContextPtr(llvmGetPointerTo(ftype_tvm_parallel_launch_, 0),
                                                "__TVMBackendParallelLaunch");
+      gv_tvm_parallel_launch_chunked_ = InitContextPtr(
+          llvmGetPointerTo(ftype_tvm_parallel_launch_, 0), "__TVMBackendParallelLaunchChunked");
       gv_tvm_parallel_barrier_ = InitContextPtr(llvmGetPointerTo(ftype_tvm_parallel_barrier_, 0),
                                                 "__TVMBackendParallelBarrier");
       // Mark as context functions
@@ -639,7 +876,8 @@ void CodeGenCPU::UnpackClosureData(TypedPointer cdata, const ffi::Array<Var>& vf
   }
 }
 
-void CodeGenCPU::CreateParallelLaunch(const Stmt& body, int num_task, std::string name) {
+void CodeGenCPU::CreateParallelLaunch(const Stmt& body, int num_task, std::string name,
+                                      bool chunked) {
   // closure data
   llvm::Function* f =
       llvm::Function::Create(ftype_tvm_parallel_lambda_, llvm::Function::PrivateLinkage,
@@ -650,10 +888,12 @@ void CodeGenCPU::CreateParallelLaunch(const Stmt& body, int num_task, std::strin
   ffi::Array<Var> vfields = tir::UndefinedVars(body, {});
   uint64_t nbytes;
   TypedPointer cdata = PackClosureData(vfields, &nbytes, "closure_" + name);
+  llvm::Value* launch_func =
+      chunked ? RuntimeTVMParallelLaunchChunked() : RuntimeTVMParallelLaunch();
 #if TVM_LLVM_VERSION >= 90
-  auto launch_callee = llvm::FunctionCallee(ftype_tvm_parallel_launch_, RuntimeTVMParallelLaunch());
+  auto launch_callee = llvm::FunctionCallee(ftype_tvm_parallel_launch_, launch_func);
 #else
-  auto launch_callee = RuntimeTVMParallelLaunch();
+  auto launch_callee = launch_func;
 #endif
   llvm::BasicBlock* par_launch_end = CheckCallSuccess(builder_->CreateCall(
       launch_callee,
@@ -975,6 +1215,11 @@ llvm::Value* CodeGenCPU::RuntimeTVMParallelLaunch() {
   return GetContextPtr(gv_tvm_parallel_launch_);
 }
 
+llvm::Value* CodeGenCPU::RuntimeTVMParallelLaunchChunked() {
+  if (f_tvm_parallel_launch_chunked_ != nullptr) return f_tvm_parallel_launch_chunked_;
+  return GetContextPtr(gv_tvm_parallel_launch_chunked_);
+}
+
 llvm::Value* CodeGenCPU::RuntimeTVMParallelBarrier() {
   if (f_tvm_parallel_barrier_ != nullptr) return f_tvm_parallel_barrier_;
   return GetContextPtr(gv_tvm_parallel_barrier_);
@@ -1162,9 +1407,19 @@ void CodeGenCPU::VisitStmt_(const ForNode* op) {
     TVM_FFI_ICHECK(op->HasTrivialStep())
         << "Parallel launch require canonical loop with trivial loop step";
     if (parallel_env_.penv == nullptr) {
+      // The launch only holds this loop, so its chunks can be executed in any order.
+      bool chunked = llvm_target_->GetParallelWorkStealing();
+      if (auto opt = op->annotations.Get(tir::attr::parallel_work_stealing)) {
+        if (auto flag = opt.value().try_cast<bool>()) {
+          chunked = flag.value();
+        } else if (auto imm = opt.value().try_cast<IntImm>()) {
+          chunked = imm.value()->value != 0;
+        }
+      }
       auto copy_node = For(ffi::make_object<ForNode>(*op));
       CreateParallelLaunch(copy_node, 0,
-                           std::string("loop_parallel_") + op->loop_var->name_hint.c_str());
+                           std::string("loop_parallel_") + op->loop_var->name_hint.c_str(),
+                           chunked);
     } else {
       // already in parallel env.
       TVM_FFI_ICHECK(parallel_env_.task_id.defined());
@@ -79,6 +79,23 @@ class CodeGenCPU : public CodeGenLLVM {
 
  protected:
   void AddStartupFunction() final;
+  /*!
+   * \brief Add the packed function `__tvm_llvm_profile_write_file`, which writes the raw profile
+   *  of the code instrumented for profile-guided optimization.
+   */
+  void AddProfileWriteFunction();
+  /*!
+   * \brief Compile the exported functions for each of the x86-64 micro-architecture levels, and
+   *  turn the exported functions into dispatchers that call the variant of the highest level the
+   *  CPU supports.
+   * \param mcpus The levels to be compiled for, e.g. x86-64-v3.
+   */
+  void AddCPUDispatch(const ffi::Array<ffi::String>& mcpus);
+  /*!
+   * \brief Get the function that returns the x86-64 micro-architecture level of the CPU, from 1 to
+   *  4, detected with cpuid on the first call.
+   */
+  llvm::Function* GetCPULevelFunction();
   // meta data
   llvm::MDNode* md_tbaa_ctx_ptr_{nullptr};
   // TVM related data types
@@ -119,6 +136,7 @@ class CodeGenCPU : public CodeGenLLVM {
   llvm::Value* RuntimeTVMGetFuncFromEnv();
   llvm::Value* RuntimeTVMFFIErrorSetRaisedFromCStr();
   llvm::Value* RuntimeTVMParallelLaunch();
+  llvm::Value* RuntimeTVMParallelLaunchChunked();
   llvm::Value* RuntimeTVMParallelBarrier();
   llvm::Value* CreateStaticHandle();
   llvm::Value* GetPackedFuncHandle(const std::string& str);
@@ -141,8 +159,9 @@ class CodeGenCPU : public CodeGenLLVM {
   llvm::Value* CreateCallTracePacked(const CallNode* op);
   // Create static initialization
   void CreateStaticInit(const std::string& init_fname, const Stmt& body);
-  // Create parallel launch
-  void CreateParallelLaunch(const Stmt& body, int num_task, std::string name = "");
+  // Create parallel launch, chunked launches let idle workers pick up the remaining work.
+  void CreateParallelLaunch(const Stmt& body, int num_task, std::string name = "",
+                            bool chunked = false);
   // Create a new compute scope.
   void CreateComputeScope(const AttrStmtNode* op);
   // Check if the call to packed function is successful
@@ -160,6 +179,7 @@ class CodeGenCPU : public CodeGenLLVM {
   llvm::GlobalVariable* gv_tvm_get_func_from_env_{nullptr};
   llvm::GlobalVariable* gv_tvm_ffi_set_last_error_c_str_{nullptr};
   llvm::GlobalVariable* gv_tvm_parallel_launch_{nullptr};
+  llvm::GlobalVariable* gv_tvm_parallel_launch_chunked_{nullptr};
   llvm::GlobalVariable* gv_tvm_parallel_barrier_{nullptr};
   std::unordered_map<ffi::String, llvm::GlobalVariable*> gv_func_map_;
   // context for direct dynamic lookup
@@ -167,6 +187,7 @@ class CodeGenCPU : public CodeGenLLVM {
   llvm::Function* f_tvm_get_func_from_env_{nullptr};
   llvm::Function* f_tvm_ffi_set_raised_by_c_str_{nullptr};
   llvm::Function* f_tvm_parallel_launch_{nullptr};
+  llvm::Function* f_tvm_parallel_launch_chunked_{nullptr};
   llvm::Function* f_tvm_parallel_barrier_{nullptr};
   llvm::Function* f_tvm_register_system_symbol_{nullptr};
   // Current parallel environment scope.
@@ -175,6 +196,8 @@ class CodeGenCPU : public CodeGenLLVM {
   std::unordered_map<std::string, llvm::GlobalVariable*> func_handle_map_;
   // List of symbols to be exported to TVM system lib.
   std::vector<std::pair<std::string, llvm::Constant*>> export_system_symbols_;
+  // The exported functions, which are multi-versioned by AddCPUDispatch.
+  std::vector<llvm::Function*> exported_functions_;
   // List of functions to be registered in the FuncRegistry, if generated.
   std::vector<std::pair<std::string, llvm::Function*>> registry_functions_;
 
@@ -75,6 +75,7 @@
 #include <llvm/IR/Verifier.h>  // For VerifierPass
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/StandardInstrumentations.h>
+#include <llvm/Support/VirtualFileSystem.h>
 #include <llvm/TargetParser/Host.h>
 #else
 #include <llvm/IR/LegacyPassManager.h>
@@ -91,6 +92,7 @@
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/Utils/ModuleUtils.h>
+#include <tvm/ir/transform.h>
 #include <tvm/runtime/base.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/tir/op.h>
@@ -111,6 +113,9 @@
 namespace tvm {
 namespace codegen {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("target.llvm_pgo_instrument", ffi::String);
+TVM_REGISTER_PASS_CONFIG_OPTION("target.llvm_pgo_profile", ffi::String);
+
 // CodeGenLLVM has members of type std::unique_ptr<T>. These members will be
 // instantiated in the constructor, which will requre that the type T is
 // complete at that point. Put the constructor (and destructor) here, since
@@ -413,10 +418,41 @@ llvm::Value* CodeGenLLVM::CreateStorageSync(const CallNode* op) {
   TVM_FFI_THROW(InternalError) << "not implemented";
 }
 
+std::string CodeGenLLVM::GetPGOInstrumentFile() {
+  return transform::PassContext::Current()
+      ->GetConfig<ffi::String>("target.llvm_pgo_instrument", ffi::String(""))
+      .value();
+}
+
+std::string CodeGenLLVM::GetPGOProfileFile() {
+  return transform::PassContext::Current()
+      ->GetConfig<ffi::String>("target.llvm_pgo_profile", ffi::String(""))
+      .value();
+}
+
 #if TVM_LLVM_VERSION >= 160
 
 // Use new pass manager
 
+std::optional<llvm::PGOOptions> CodeGenLLVM::GetPGOOptions() const {
+  std::string instrument_file = GetPGOInstrumentFile();
+  std::string profile_file = GetPGOProfileFile();
+  TVM_FFI_ICHECK(instrument_file.empty() || profile_file.empty())
+      << "target.llvm_pgo_instrument and target.llvm_pgo_profile cannot be both set";
+  if (instrument_file.empty() && profile_file.empty()) {
+    return std::nullopt;
+  }
+  // The instrumented code writes the raw profile to instrument_file, and the optimized code
+  // reads the indexed profile merged from the raw profiles by llvm-profdata.
+  auto action = instrument_file.empty() ? llvm::PGOOptions::IRUse : llvm::PGOOptions::IRInstr;
+  std::string file = instrument_file.empty() ? profile_file : instrument_file;
+#if TVM_LLVM_VERSION >= 170
+  return llvm::PGOOptions(file, "", "", "", llvm::vfs::getRealFileSystem(), action);
+#else
+  return llvm::PGOOptions(file, "", "", llvm::vfs::getRealFileSystem(), action);
+#endif
+}
+
 void CodeGenLLVM::Optimize() {
   llvm::TargetMachine* tm = llvm_target_->GetOrCreateTargetMachine();
 
@@ -425,7 +461,7 @@ void CodeGenLLVM::Optimize() {
 
   llvm::PipelineTuningOptions pto = llvm::PipelineTuningOptions();
   llvm::PassInstrumentationCallbacks pic;
-  llvm::PassBuilder builder(tm, pto, std::nullopt, &pic);
+  llvm::PassBuilder builder(tm, pto, GetPGOOptions(), &pic);
 
   llvm::LoopAnalysisManager lam;
   llvm::FunctionAnalysisManager fam;
@@ -509,6 +545,8 @@ class MPassManager : public llvm::legacy::PassManager {
 void CodeGenLLVM::InitPassManagerBuilder(llvm::PassManagerBuilder* builder) {}
 
 void CodeGenLLVM::Optimize() {
+  TVM_FFI_ICHECK(GetPGOInstrumentFile().empty() && GetPGOProfileFile().empty())
+      << "Profile-guided optimization requires LLVM 16 or later";
   // pass manager
   FPassManager fpass(module_.get());
   MPassManager mpass;
@@ -1390,8 +1428,37 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
     }
     llvm::Type* return_type = GetLLVMType(ffi::GetRef<PrimExpr>(op));
     llvm::Function* f = GetIntrinsicDecl(id, return_type, arg_type);
+#if TVM_LLVM_VERSION >= 110
+    if (f == nullptr) {
+      // bf16 is stored as uint16 in TIR, so the overloaded intrinsics on vectors of bfloat, e.g.
+      // bfdot, are looked up with the vectors of i16 taken as vectors of bfloat.
+      auto as_bfloat = [this](llvm::Type* type) -> llvm::Type* {
+        if (type->isVectorTy() && type->getScalarType()->isIntegerTy(16)) {
+          return llvm::VectorType::get(llvm::Type::getBFloatTy(*llvm_target_->GetContext()),
+                                       llvm::cast<llvm::VectorType>(type)->getElementCount());
+        }
+        return type;
+      };
+      std::vector<llvm::Type*> bfloat_arg_type;
+      for (llvm::Type* type : arg_type) {
+        bfloat_arg_type.push_back(as_bfloat(type));
+      }
+      f = GetIntrinsicDecl(id, as_bfloat(return_type), bfloat_arg_type);
+    }
+#endif
     TVM_FFI_ICHECK(f) << "Cannot find intrinsic declaration, possible type mismatch: "
                       << llvmGetIntrinName(id);
+    // The vector operands of the same width in another element type, e.g. the bf16 operands
+    // stored as uint16, are bitcast to the parameter types of the intrinsic.
+    llvm::FunctionType* f_type = f->getFunctionType();
+    for (size_t i = 0; i < arg_value.size() && i < f_type->getNumParams(); ++i) {
+      llvm::Type* param_type = f_type->getParamType(i);
+      llvm::Type* value_type = arg_value[i]->getType();
+      if (param_type != value_type && param_type->isVectorTy() && value_type->isVectorTy() &&
+          param_type->getPrimitiveSizeInBits() == value_type->getPrimitiveSizeInBits()) {
+        arg_value[i] = builder_->CreateBitCast(arg_value[i], param_type);
+      }
+    }
     // In earlier versions of LLVM's, the prefetch intrinsic is not
     // overloaded, and always takes the first argument as i8*.  If
     // this is the case, this argument should insert a cast to i8*.
@@ -1404,7 +1471,12 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
             builder_->CreatePointerCast(arg_value[0], llvmGetPointerTo(t_char_, addrspace));
       }
     }
-    return builder_->CreateCall(f, arg_value);
+    llvm::Value* result = builder_->CreateCall(f, arg_value);
+    if (result->getType() != return_type && result->getType()->isVectorTy() &&
+        return_type->isVectorTy()) {
+      result = builder_->CreateBitCast(result, return_type);
+    }
+    return result;
   } else if (op->op.same_as(builtin::bitwise_and())) {
     return builder_->CreateAnd(MakeValue(op->args[0]), MakeValue(op->args[1]));
   } else if (op->op.same_as(builtin::bitwise_or())) {
@@ -1558,6 +1630,33 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
     llvm::Function* f = GetIntrinsicDecl(id, DTypeToLLVMType(op->dtype),
                                          {builder_->getInt32Ty(), builder_->getInt32Ty()});
     return builder_->CreateCall(f, {MakeValue(op->args[0]), MakeValue(op->args[1])});
+#endif
+#if TVM_LLVM_VERSION >= 120
+  } else if (op->op.same_as(builtin::vector_reduce_add()) ||
+             op->op.same_as(builtin::vector_reduce_mul())) {
+    bool is_add = op->op.same_as(builtin::vector_reduce_add());
+    llvm::Value* vec = MakeValue(op->args[0]);
+    if (!op->dtype.is_float()) {
+      return is_add ? builder_->CreateAddReduce(vec) : builder_->CreateMulReduce(vec);
+    }
+    // The reduction of floats is ordered unless reassociation is allowed, which would defeat
+    // the point of reducing in vector registers.
+    llvm::Type* type = DTypeToLLVMType(op->dtype);
+    llvm::CallInst* call =
+        is_add ? builder_->CreateFAddReduce(llvm::ConstantFP::getNegativeZero(type), vec)
+               : builder_->CreateFMulReduce(llvm::ConstantFP::get(type, 1.0), vec);
+    call->setHasAllowReassoc(true);
+    return call;
+  } else if (op->op.same_as(builtin::vector_reduce_min()) ||
+             op->op.same_as(builtin::vector_reduce_max())) {
+    bool is_min = op->op.same_as(builtin::vector_reduce_min());
+    llvm::Value* vec = MakeValue(op->args[0]);
+    if (op->dtype.is_float()) {
+      return is_min ? builder_->CreateFPMinReduce(vec) : builder_->CreateFPMaxReduce(vec);
+    }
+    bool is_signed = op->dtype.is_int();
+    return is_min ? builder_->CreateIntMinReduce(vec, is_signed)
+                  : builder_->CreateIntMaxReduce(vec, is_signed);
 #endif
   } else {
     TVM_FFI_THROW(InternalError) << "unknown intrinsic " << op->op;
@@ -43,6 +43,9 @@
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/Support/Casting.h>
+#if TVM_LLVM_VERSION >= 160
+#include <llvm/Support/PGOOptions.h>
+#endif
 #if TVM_LLVM_VERSION >= 140
 #include <llvm/MC/TargetRegistry.h>
 #else
@@ -62,6 +65,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -370,6 +374,20 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   virtual void AddStartupFunction() {}
   // apply optimization on the module.
   virtual void Optimize();
+  /*!
+   * \brief The path of the raw profile written by the code instrumented for profile-guided
+   *  optimization, from the pass config `target.llvm_pgo_instrument`, or empty if disabled.
+   */
+  static std::string GetPGOInstrumentFile();
+  /*!
+   * \brief The path of the indexed profile to optimize the code with, from the pass config
+   *  `target.llvm_pgo_profile`, or empty if disabled.
+   */
+  static std::string GetPGOProfileFile();
+#if TVM_LLVM_VERSION >= 160
+  /*! \brief The options of profile-guided optimization of the pass builder. */
+  std::optional<llvm::PGOOptions> GetPGOOptions() const;
+#endif
   // Get the maximim storage align bits of buffer pointer given storage scope.
   virtual int NativeVectorBits(const runtime::StorageScope& storage_scope) const;
   // Get correct address space depending on the backend
@@ -288,6 +288,11 @@ LLVMTargetInfo::LLVMTargetInfo(LLVMInstance& instance,
     }
   }
 
+  // Dynamic load balancing of parallel loops
+  if (auto flag = target.Get("parallel-work-stealing")) {
+    parallel_work_stealing_ = flag.value().cast<bool>();
+  }
+
   // RISCV code model & vlen
   auto arch = llvm::Triple(triple_).getArch();
   if (arch == llvm::Triple::riscv32 || arch == llvm::Triple::riscv64) {
@@ -591,6 +596,10 @@ std::string LLVMTargetInfo::str() const {
     obj.Set(ffi::String("jit"), ffi::String(jit_engine_));
   }
 
+  if (parallel_work_stealing_) {
+    obj.Set(ffi::String("parallel-work-stealing"), true);
+  }
+
   return std::string(ffi::json::Stringify(obj));
 }
 
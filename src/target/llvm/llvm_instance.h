@@ -262,6 +262,11 @@ class LLVMTargetInfo {
    * \return number of bits for vector width
    */
   const int GetVectorWidth();
+  /*!
+   * \brief Whether parallel loops are launched in chunks that idle workers can steal
+   * \return true if "parallel-work-stealing" is set for this target
+   */
+  bool GetParallelWorkStealing() const { return parallel_work_stealing_; }
   /*!
    * \brief Get the LLVM optimization level
    * \return optimization level for this target
@@ -377,6 +382,7 @@ class LLVMTargetInfo {
   std::shared_ptr<llvm::TargetMachine> target_machine_;
   std::string jit_engine_ = "orcjit";
   int vector_width_{0};
+  bool parallel_work_stealing_{false};
 };
 
 /*!
@@ -28,6 +28,7 @@
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/MCJIT.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h>
 #include <tvm/ffi/reflection/registry.h>
@@ -46,6 +47,8 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
 #if TVM_LLVM_VERSION >= 180
 #include <llvm/TargetParser/Host.h>
 #else
@@ -61,18 +64,24 @@
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/string.h>
 #include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/object.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/support/with.h>
 #include <tvm/target/codegen.h>
 #include <tvm/target/target.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <numeric>
 #include <string>
 #include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -109,6 +118,15 @@ class LLVMModuleNode final : public ffi::ModuleObj {
 
   void Init(const IRModule& mod, const Target& target);
   void Init(std::unique_ptr<llvm::Module> module, std::unique_ptr<LLVMInstance> llvm_instance);
+  /*!
+   * \brief Generate the code of the module as several LLVM modules, optimized and emitted in
+   *  parallel. This module holds the first one and imports the others, which are linked with it
+   *  when the library is exported.
+   * \param mod The module to generate the code of.
+   * \param target The target.
+   * \param num_units The maximum number of LLVM modules.
+   */
+  void InitCodegenUnits(const IRModule& mod, const Target& target, int num_units);
   void LoadIR(const std::string& file_name);
 
   bool ImplementsFunction(const ffi::String& name) final;
@@ -121,11 +139,15 @@ class LLVMModuleNode final : public ffi::ModuleObj {
   bool IsCompatibleWithHost(const llvm::TargetMachine* tm) const;
   void* GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const;
   void* GetFunctionAddr(const std::string& name, const LLVMTarget& llvm_target) const;
+  /*! \brief Emit the object code of the module ahead of the export. */
+  void EmitObjectCode();
 
   // The LLVM scope object.
   std::unique_ptr<LLVMInstance> llvm_instance_;
   // JIT lock
   std::mutex mutex_;
+  // The on-disk cache of the object code compiled by the jit execution engines, if enabled.
+  std::unique_ptr<llvm::ObjectCache> object_cache_;
   // jit execution engines
   llvm::ExecutionEngine* mcjit_ee_{nullptr};
   std::unique_ptr<llvm::orc::LLJIT> orcjit_ee_{nullptr};
@@ -137,6 +159,13 @@ class LLVMModuleNode final : public ffi::ModuleObj {
   /* \brief names of the external functions declared in this module */
   ffi::Array<ffi::String> function_names_;
   std::string jit_engine_;
+  // The object code emitted by EmitObjectCode, empty if it is emitted on export.
+  std::string object_code_;
+  // The other codegen units of the module, which are also imported by it.
+  std::vector<ffi::Module> codegen_units_;
+  // The module exposed as the library context to the JIT code, which is the module holding the
+  // first codegen unit, or this module if unset.
+  LLVMModuleNode* library_ctx_{nullptr};
 };
 
 LLVMModuleNode::~LLVMModuleNode() {
@@ -191,8 +220,19 @@ ffi::Optional<ffi::Function> LLVMModuleNode::GetFunction(const ffi::String& name
   With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
   ffi::String name_with_prefix = ffi::symbol::tvm_ffi_symbol_prefix + name;
   faddr = reinterpret_cast<TVMFFISafeCallType>(GetFunctionAddr(name_with_prefix, *llvm_target));
-  if (faddr == nullptr) return std::nullopt;
   ffi::Module self_strong_ref = ffi::GetRef<ffi::Module>(this);
+  if (faddr == nullptr) {
+    // The function may be generated in another codegen unit, whose JIT code refers to this module
+    // as the library context.
+    for (const ffi::Module& unit : codegen_units_) {
+      if (ffi::Optional<ffi::Function> f = unit->GetFunction(name)) {
+        return ffi::Function([f = f.value(), self_strong_ref](ffi::PackedArgs args, ffi::Any* rv) {
+          f.CallPacked(args, rv);
+        });
+      }
+    }
+    return std::nullopt;
+  }
   return ffi::Function::FromPacked([faddr, self_strong_ref](ffi::PackedArgs args, ffi::Any* rv) {
     TVM_FFI_ICHECK_LT(rv->type_index(), ffi::TypeIndex::kTVMFFIStaticObjectBegin);
     TVM_FFI_CHECK_SAFE_CALL((*faddr)(nullptr, reinterpret_cast<const TVMFFIAny*>(args.data()),
@@ -225,7 +265,7 @@ constexpr auto llvm_assembly_file_target = llvm::CodeGenFileType::AssemblyFile;
 #endif
 
 bool LLVMAddPassesToEmitFile(llvm::TargetMachine* tm, llvm::legacy::PassManager* pm,
-                             llvm::raw_fd_ostream* dest,
+                             llvm::raw_pwrite_stream* dest,
                              decltype(llvm_object_file_target) llvm_file_target) {
 #if TVM_LLVM_VERSION <= 60
   return tm->addPassesToEmitFile(*pm, *dest, llvm_file_target);
@@ -247,7 +287,9 @@ void LLVMModuleNode::WriteToFile(const ffi::String& file_name_str,
       << "Cannot open file: " << file_name << " " << ecode.message();
   bool is_obj_file = fmt == "o" || fmt == "obj";
   bool is_asm_file = fmt == "s" || fmt == "asm";
-  if (is_obj_file || is_asm_file) {
+  if (is_obj_file && !object_code_.empty()) {
+    dest << object_code_;
+  } else if (is_obj_file || is_asm_file) {
     auto llvm_file_target = is_obj_file ? llvm_object_file_target : llvm_assembly_file_target;
 
     With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
@@ -393,9 +435,193 @@ void LLVMModuleNode::LoadIR(const std::string& file_name) {
 }
 
 bool LLVMModuleNode::ImplementsFunction(const ffi::String& name) {
-  return std::find(function_names_.begin(), function_names_.end(),
-                   ffi::symbol::tvm_ffi_symbol_prefix + name) != function_names_.end();
+  if (std::find(function_names_.begin(), function_names_.end(),
+                ffi::symbol::tvm_ffi_symbol_prefix + name) != function_names_.end()) {
+    return true;
+  }
+  return std::any_of(codegen_units_.begin(), codegen_units_.end(),
+                     [&name](const ffi::Module& unit) { return unit->ImplementsFunction(name); });
+}
+
+namespace {
+/*!
+ * \brief Partition the PrimFuncs of a module into at most `num_units` modules of about the same
+ *  size, keeping the functions that call each other in the same module.
+ */
+std::vector<IRModule> PartitionCodegenUnits(const IRModule& mod, int num_units) {
+  std::vector<std::pair<GlobalVar, tir::PrimFunc>> funcs;
+  std::unordered_map<std::string, int> func_index;
+  for (const auto& [gvar, base_func] : mod->functions) {
+    if (auto func = base_func.as<tir::PrimFunc>()) {
+      func_index[gvar->name_hint] = funcs.size();
+      funcs.emplace_back(gvar, func.value());
+    }
+  }
+  // Group the functions connected by calls, and estimate the size of each function by the number
+  // of its IR nodes.
+  std::vector<int> group(funcs.size());
+  std::iota(group.begin(), group.end(), 0);
+  std::function<int(int)> find_group = [&](int i) {
+    return group[i] == i ? i : group[i] = find_group(group[i]);
+  };
+  std::vector<int64_t> size(funcs.size(), 0);
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    tir::PostOrderVisit(funcs[i].second->body, [&](const ObjectRef& obj) {
+      ++size[i];
+      if (const auto* call = obj.as<tir::CallNode>()) {
+        if (const auto* callee = call->op.as<GlobalVarNode>()) {
+          auto it = func_index.find(callee->name_hint);
+          if (it != func_index.end()) {
+            group[find_group(i)] = find_group(it->second);
+          }
+        }
+      }
+    });
+  }
+  std::unordered_map<int, int> group_index;
+  std::vector<std::vector<int>> groups;
+  std::vector<int64_t> group_size;
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    auto [it, inserted] = group_index.emplace(find_group(i), groups.size());
+    if (inserted) {
+      groups.emplace_back();
+      group_size.push_back(0);
+    }
+    groups[it->second].push_back(i);
+    group_size[it->second] += size[i];
+  }
+  // Assign the largest groups first, each to the smallest module so far.
+  std::vector<int> order(groups.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](int a, int b) { return group_size[a] > group_size[b]; });
+  int num_parts = std::min<int>(num_units, groups.size());
+  std::vector<ffi::Map<GlobalVar, BaseFunc>> parts(num_parts);
+  std::vector<int64_t> part_size(num_parts, 0);
+  for (int g : order) {
+    int p = std::min_element(part_size.begin(), part_size.end()) - part_size.begin();
+    for (int i : groups[g]) {
+      parts[p].Set(funcs[i].first, funcs[i].second);
+    }
+    part_size[p] += group_size[g];
+  }
+  std::vector<IRModule> result;
+  for (const ffi::Map<GlobalVar, BaseFunc>& part : parts) {
+    result.emplace_back(part, mod->source_map, mod->attrs);
+  }
+  return result;
 }
+}  // namespace
+
+void LLVMModuleNode::InitCodegenUnits(const IRModule& mod, const Target& target, int num_units) {
+  std::vector<IRModule> parts = PartitionCodegenUnits(mod, num_units);
+  if (parts.size() <= 1) {
+    Init(mod, target);
+    return;
+  }
+  std::vector<ObjectPtr<LLVMModuleNode>> units(parts.size());
+  units[0] = ffi::GetObjectPtr<LLVMModuleNode>(this);
+  for (size_t i = 1; i < parts.size(); ++i) {
+    units[i] = ffi::make_object<LLVMModuleNode>();
+  }
+  // Each unit has its own LLVM context, so that the units can be generated concurrently.
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  support::parallel_for_dynamic(0, parts.size(), parts.size(), [&](int thread_id, int i) {
+    With<transform::PassContext> scope(pass_ctx);
+    units[i]->Init(parts[i], target);
+    units[i]->EmitObjectCode();
+  });
+  for (size_t i = 1; i < parts.size(); ++i) {
+    units[i]->library_ctx_ = this;
+    ffi::Module unit(units[i]);
+    codegen_units_.push_back(unit);
+    this->ImportModule(unit);
+  }
+}
+
+void LLVMModuleNode::EmitObjectCode() {
+  With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+  llvm::SmallString<0> buffer;
+  llvm::raw_svector_ostream dest(buffer);
+  llvm::legacy::PassManager pass;
+  llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
+  auto err = LLVMAddPassesToEmitFile(tm, &pass, &dest, llvm_object_file_target);
+  TVM_FFI_ICHECK(!err) << "Cannot emit target CGFT_ObjectFile";
+  pass.run(*CloneLLVMModule(module_));
+  object_code_ = buffer.str().str();
+}
+
+namespace {
+/*!
+ * \brief An on-disk cache of the object code compiled by the JIT engines, shared across processes.
+ *
+ * An entry is keyed by the MD5 of the LLVM IR, which holds the target metadata, and the LLVM
+ * version, so a JIT module created again by a later process loads the object code instead of
+ * compiling the IR. The cache is enabled by setting TVM_LLVM_JIT_CACHE_DIR to its directory.
+ */
+class JITObjectCache : public llvm::ObjectCache {
+ public:
+  /*! \brief The cache in the directory given by TVM_LLVM_JIT_CACHE_DIR, or nullptr if unset. */
+  static std::unique_ptr<JITObjectCache> Create() {
+    const char* dir = std::getenv("TVM_LLVM_JIT_CACHE_DIR");
+    if (dir == nullptr || dir[0] == '\0') {
+      return nullptr;
+    }
+    if (std::error_code ecode = llvm::sys::fs::create_directories(dir)) {
+      LOG(WARNING) << "Cannot create the JIT object cache directory " << dir << ": "
+                   << ecode.message();
+      return nullptr;
+    }
+    return std::unique_ptr<JITObjectCache>(new JITObjectCache(dir));
+  }
+
+  void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) final {
+    // Write to a temporary file first, so that concurrent processes never read a partial entry.
+    std::string path = GetPath(module);
+    int fd;
+    llvm::SmallString<128> tmp_path;
+    if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%.tmp", fd, tmp_path)) {
+      return;
+    }
+    {
+      llvm::raw_fd_ostream dest(fd, /*shouldClose=*/true);
+      dest << object.getBuffer();
+    }
+    if (llvm::sys::fs::rename(tmp_path, path)) {
+      llvm::sys::fs::remove(tmp_path);
+    }
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) final {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(GetPath(module));
+    if (!buffer) {
+      return nullptr;
+    }
+    return std::move(buffer.get());
+  }
+
+ private:
+  explicit JITObjectCache(std::string dir) : dir_(std::move(dir)) {}
+
+  /*! \brief The path of the entry of a module. */
+  std::string GetPath(const llvm::Module* module) const {
+    std::string ir;
+    llvm::raw_string_ostream os(ir);
+    module->print(os, nullptr);
+    os.flush();
+    llvm::MD5 md5;
+    md5.update(ir);
+    md5.update(std::to_string(TVM_LLVM_VERSION));
+    llvm::MD5::MD5Result result;
+    md5.final(result);
+    return dir_ + "/" + std::string(result.digest().str()) + ".o";
+  }
+
+  /*! \brief The directory of the cache. */
+  std::string dir_;
+};
+}  // namespace
 
 void LLVMModuleNode::InitMCJIT() {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -438,6 +664,10 @@ void LLVMModuleNode::InitMCJIT() {
 #else
                                        << module_->getTargetTriple();
 #endif
+  object_cache_ = JITObjectCache::Create();
+  if (object_cache_ != nullptr) {
+    mcjit_ee_->setObjectCache(object_cache_.get());
+  }
 
   VLOG(2) << "LLVM MCJIT execute " << module_->getModuleIdentifier() << " for triple `"
           << llvm_target->GetTargetTriple() << "`"
@@ -448,7 +678,7 @@ void LLVMModuleNode::InitMCJIT() {
 
   if (void** ctx_addr =
           reinterpret_cast<void**>(GetGlobalAddr(ffi::symbol::tvm_ffi_library_ctx, *llvm_target))) {
-    *ctx_addr = this;
+    *ctx_addr = library_ctx_ != nullptr ? library_ctx_ : this;
   }
 
   ffi::Module::VisitContextSymbols([this, &llvm_target](const ffi::String& name, void* symbol) {
@@ -507,9 +737,11 @@ void LLVMModuleNode::InitORCJIT() {
       << " and ExecutionEngine (" << layout.getStringRepresentation() << ")";
 
   // compiler
+  object_cache_ = JITObjectCache::Create();
   const auto compilerBuilder = [&](const llvm::orc::JITTargetMachineBuilder&)
       -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
-    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(tm));
+    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(tm),
+                                                               object_cache_.get());
   };
 
 #if TVM_LLVM_VERSION >= 130
@@ -599,7 +831,7 @@ void LLVMModuleNode::InitORCJIT() {
 
   if (void** ctx_addr =
           reinterpret_cast<void**>(GetGlobalAddr(ffi::symbol::tvm_ffi_library_ctx, *llvm_target))) {
-    *ctx_addr = this;
+    *ctx_addr = library_ctx_ != nullptr ? library_ctx_ : this;
   }
   ffi::Module::VisitContextSymbols([this, &llvm_target](const ffi::String& name, void* symbol) {
     if (void** ctx_addr = reinterpret_cast<void**>(GetGlobalAddr(name, *llvm_target))) {
@@ -659,13 +891,28 @@ void* LLVMModuleNode::GetFunctionAddr(const std::string& name,
   return nullptr;
 }
 
+TVM_REGISTER_PASS_CONFIG_OPTION("target.llvm_num_codegen_units", Integer);
+
 static void LLVMReflectionRegister() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
       .def("target.build.llvm",
            [](IRModule mod, Target target) -> ffi::Module {
              auto n = ffi::make_object<LLVMModuleNode>();
-             n->Init(mod, target);
+             int64_t num_units = transform::PassContext::Current()
+                                     ->GetConfig<Integer>("target.llvm_num_codegen_units",
+                                                          Integer(1))
+                                     .value()
+                                     ->value;
+             // The units are generated concurrently, which the process-wide LLVM command line
+             // options and the registration of the system library symbols do not support.
+             bool has_cl_opt = target->GetAttr<ffi::Array<ffi::String>>("cl-opt").defined();
+             bool is_system_lib = mod->GetAttr<ffi::String>(tvm::attr::kSystemLibPrefix).defined();
+             if (num_units > 1 && !has_cl_opt && !is_system_lib) {
+               n->InitCodegenUnits(mod, target, num_units);
+             } else {
+               n->Init(mod, target);
+             }
              return ffi::Module(n);
            })
       .def("codegen.LLVMModuleCreate",
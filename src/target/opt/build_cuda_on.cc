@@ -108,5 +108,6 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def("target.build.cuda", BuildCUDA);
 }
 TVM_REGISTER_PASS_CONFIG_OPTION("cuda.kernels_output_dir", ffi::String);
+TVM_REGISTER_PASS_CONFIG_OPTION("cuda.fatbin_archs", ffi::Array<ffi::String>);
 }  // namespace codegen
 }  // namespace tvm
@@ -692,6 +692,11 @@ void CodeGenC::VisitExpr_(const CallNode* op, std::ostream& os) {  // NOLINT(*)
       TVM_FFI_ICHECK_EQ(load->indices.size(), 1)
           << "CodeGenC only supports flat memory allocations.";
       os << "(&(" << GetBufferRef(load->dtype, load->buffer.get(), load->indices[0]) << "))";
+    } else if (op->op.same_as(builtin::prefetch())) {
+      TVM_FFI_ICHECK_EQ(op->args.size(), 4U);
+      // The cache type of llvm.prefetch has no counterpart in __builtin_prefetch.
+      os << "__builtin_prefetch(" << PrintExpr(op->args[0]) << ", " << PrintExpr(op->args[1])
+         << ", " << PrintExpr(op->args[2]) << ")";
     } else if (op->op.same_as(builtin::tvm_struct_get())) {
       TVM_FFI_ICHECK_EQ(op->args.size(), 3U);
       os << GetStructRef(op->dtype, op->args[0], op->args[1], op->args[2].as<IntImmNode>()->value);
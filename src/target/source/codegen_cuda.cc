@@ -1100,6 +1100,40 @@ void CodeGenCUDA::VisitExpr_(const CallNode* op, std::ostream& os) {
       this->stream << PrintLoadMatrixAssembly(trans, num, type, local_ptr, local_elem_offset,
                                               smem_ptr, smem_elem_offset);
     }
+  } else if (op->op.same_as(builtin::ptx_wgmma_ss())) {
+    // arg 0: shape: m64nNkK
+    // arg 1: A precision: fp16, bf16, tf32, e4m3, e5m2, int8 or uint8
+    // arg 2: B precision
+    // arg 3: C precision: fp16, fp32 or int32
+    // arg 4-7: A pointer, offset, leading byte offset and stride byte offset
+    // arg 8-11: B pointer, offset, leading byte offset and stride byte offset
+    // arg 12: swizzle kind of A and B
+    // arg 13: C accumulator pointer
+    // arg 14: C accumulator offset
+    // arg 15: whether to accumulate into C
+    TVM_FFI_ICHECK_EQ(op->args.size(), 16U);
+    need_cast_smem_ptr_to_int_ = true;
+    std::string shape = Downcast<StringImm>(op->args[0])->value;
+    std::string A_dtype = Downcast<StringImm>(op->args[1])->value;
+    std::string B_dtype = Downcast<StringImm>(op->args[2])->value;
+    std::string C_dtype = Downcast<StringImm>(op->args[3])->value;
+    auto get_int = [&](int i) { return static_cast<int>(Downcast<IntImm>(op->args[i])->value); };
+    this->stream << PrintWGMMAAssembly(
+        shape, A_dtype, B_dtype, C_dtype, this->PrintExpr(op->args[4]),
+        this->PrintExpr(op->args[5]), get_int(6), get_int(7), this->PrintExpr(op->args[8]),
+        this->PrintExpr(op->args[9]), get_int(10), get_int(11), get_int(12),
+        this->PrintExpr(op->args[13]), this->PrintExpr(op->args[14]),
+        this->PrintExpr(op->args[15]));
+  } else if (op->op.same_as(builtin::ptx_wgmma_fence())) {
+    this->stream << "__asm__ __volatile__(\"wgmma.fence.sync.aligned;\" ::: \"memory\");\n";
+  } else if (op->op.same_as(builtin::ptx_wgmma_commit_group())) {
+    this->stream << "__asm__ __volatile__(\"wgmma.commit_group.sync.aligned;\" ::: \"memory\");\n";
+  } else if (op->op.same_as(builtin::ptx_wgmma_wait_group())) {
+    int n = Downcast<IntImm>(op->args[0])->value;
+    this->stream << "__asm__ __volatile__(\"wgmma.wait_group.sync.aligned " << n
+                 << ";\" ::: \"memory\");\n";
+  } else if (op->op.same_as(builtin::ptx_fence_proxy_async())) {
+    this->stream << "__asm__ __volatile__(\"fence.proxy.async.shared::cta;\" ::: \"memory\");\n";
   } else if (op->op.same_as(builtin::mma_store())) {
     int m = Downcast<Integer>(op->args[0])->value;
     int n = Downcast<Integer>(op->args[1])->value;
@@ -1179,10 +1213,22 @@ void CodeGenCUDA::VisitExpr_(const CallNode* op, std::ostream& os) {
     std::string src = this->PrintExpr(op->args[2]);
     std::string src_offset = this->PrintExpr(op->args[3]);
     std::string size = this->PrintExpr(op->args[4]);
-    int barrier_id = Downcast<IntImm>(op->args[5])->value;
-    TVM_FFI_ICHECK(barrier_id < barrier_count_);
-    std::string barrier = barrier_name_ + "[" + std::to_string(barrier_id) + "]";
+    std::string barrier = PrintBarrier(op->args[5]);
     this->stream << PrintCpAsyncBulkAsm(dst, dst_offset, src, src_offset, size, barrier);
+  } else if (op->op.same_as(builtin::ptx_cp_async_bulk_tensor())) {
+    need_cast_smem_ptr_to_int_ = true;
+    std::string dst = this->PrintExpr(op->args[0]);
+    std::string dst_offset = this->PrintExpr(op->args[1]);
+    std::string tensor_map = this->PrintExpr(op->args[2]);
+    std::string barrier = PrintBarrier(op->args[3]);
+    std::vector<std::string> coords;
+    for (size_t i = 4; i < op->args.size(); ++i) {
+      coords.push_back("(int)" + this->PrintExpr(op->args[i]));
+    }
+    this->stream << PrintCpAsyncBulkTensorAsm(dst, dst_offset, tensor_map, coords, barrier);
+  } else if (op->op.same_as(builtin::ptx_tma_load())) {
+    TVM_FFI_THROW(InternalError) << "ptx_tma_load is expected to be lowered by the "
+                                 << "LowerTMADescriptors pass before codegen";
   } else if (op->op.same_as(builtin::ptx_commit_group())) {
     this->stream << "__asm__ __volatile__(\"cp.async.commit_group;\");\n\n";
   } else if (op->op.same_as(builtin::ptx_wait_group())) {
@@ -1190,36 +1236,37 @@ void CodeGenCUDA::VisitExpr_(const CallNode* op, std::ostream& os) {
     this->stream << "__asm__ __volatile__(\"cp.async.wait_group " << n << ";\");\n\n";
   } else if (op->op.same_as(builtin::ptx_cp_async_barrier())) {
     need_cast_smem_ptr_to_int_ = true;
-    int barrier_id = Downcast<IntImm>(op->args[0])->value;
-    TVM_FFI_ICHECK(barrier_id < barrier_count_);
-    std::string barrier = barrier_name_ + "[" + std::to_string(barrier_id) + "]";
+    std::string barrier = PrintBarrier(op->args[0]);
     this->stream << PrintCpAsyncBarrierAsm(barrier);
   } else if (op->op.same_as(builtin::ptx_init_barrier_thread_count())) {
     need_cast_smem_ptr_to_int_ = true;
-    int barrier_id = Downcast<IntImm>(op->args[0])->value;
-    TVM_FFI_ICHECK(barrier_id < barrier_count_);
-    std::string barrier = barrier_name_ + "[" + std::to_string(barrier_id) + "]";
+    std::string barrier = PrintBarrier(op->args[0]);
     std::string thread_count = this->PrintExpr(op->args[1]);
     this->stream << PrintInitBarrierThreadCountAsm(barrier, thread_count);
   } else if (op->op.same_as(builtin::ptx_arrive_barrier())) {
     need_cast_smem_ptr_to_int_ = true;
-    int barrier_id = Downcast<IntImm>(op->args[0])->value;
-    TVM_FFI_ICHECK(barrier_id < barrier_count_);
-    std::string barrier = barrier_name_ + "[" + std::to_string(barrier_id) + "]";
+    std::string barrier = PrintBarrier(op->args[0]);
     this->stream << PrintArriveBarrierAsm(barrier);
   } else if (op->op.same_as(builtin::ptx_arrive_barrier_expect_tx())) {
     need_cast_smem_ptr_to_int_ = true;
-    int barrier_id = Downcast<IntImm>(op->args[0])->value;
-    TVM_FFI_ICHECK(barrier_id < barrier_count_);
-    std::string barrier = barrier_name_ + "[" + std::to_string(barrier_id) + "]";
+    std::string barrier = PrintBarrier(op->args[0]);
     std::string byte_count = this->PrintExpr(op->args[1]);
     this->stream << PrintArriveBarrierExpectTxAsm(barrier, byte_count);
+  } else if (op->op.same_as(builtin::ptx_barrier_expect_tx())) {
+    need_cast_smem_ptr_to_int_ = true;
+    std::string barrier = PrintBarrier(op->args[0]);
+    std::string byte_count = this->PrintExpr(op->args[1]);
+    this->stream << PrintBarrierExpectTxAsm(barrier, byte_count);
   } else if (op->op.same_as(builtin::ptx_wait_barrier())) {
     need_cast_smem_ptr_to_int_ = true;
-    int barrier_id = Downcast<IntImm>(op->args[0])->value;
-    TVM_FFI_ICHECK(barrier_id < barrier_count_);
-    std::string barrier = barrier_name_ + "[" + std::to_string(barrier_id) + "]";
-    this->stream << PrintWaitBarrierAsm(barrier);
+    std::string barrier = PrintBarrier(op->args[0]);
+    std::string phase = op->args.size() > 1 ? this->PrintExpr(op->args[1]) : "0";
+    this->stream << PrintWaitBarrierAsm(barrier, phase);
+  } else if (op->op.same_as(builtin::ptx_bar_sync())) {
+    std::string barrier_id = this->PrintExpr(op->args[0]);
+    std::string thread_count = this->PrintExpr(op->args[1]);
+    this->stream << "__asm__ __volatile__(\"bar.sync %0, %1;\" :: \"r\"(" << barrier_id
+                 << "), \"r\"(" << thread_count << ") : \"memory\");\n";
   } else if (op->op.same_as(builtin::create_barriers())) {
     TVM_FFI_ICHECK_EQ(barrier_count_, -1);
     int barrier_count = Downcast<IntImm>(op->args[0])->value;
@@ -1771,6 +1818,15 @@ void CodeGenCUDA::HandleVolatileLoads(const std::string& value, const BufferLoad
   }
 }
 
+std::string CodeGenCUDA::PrintBarrier(const PrimExpr& barrier_id) {
+  TVM_FFI_ICHECK_GT(barrier_count_, 0) << "The barriers are used before create_barriers";
+  if (const auto* imm = barrier_id.as<IntImmNode>()) {
+    TVM_FFI_ICHECK_LT(imm->value, barrier_count_);
+    return barrier_name_ + "[" + std::to_string(imm->value) + "]";
+  }
+  return barrier_name_ + "[" + this->PrintExpr(barrier_id) + "]";
+}
+
 void CodeGenCUDA::PrintVecElemLoadExpr(DataType t, int i, const std::string& value,
                                        std::ostream& os) {
   TVM_FFI_ICHECK_GT(t.lanes(), 1);
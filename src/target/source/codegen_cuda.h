@@ -85,6 +85,9 @@ class CodeGenCUDA final : public CodeGenC {
   // Whether scope such as "__shared__" or "__constant__"  is part of type.
   bool IsScopePartOfType() const final { return false; }
 
+  // Print the reference to the barrier of the given id in the barrier array
+  std::string PrintBarrier(const PrimExpr& barrier_id);
+
   // Whether global barrier is needed.
   bool need_global_barrier_{false};
   // Global barrier state
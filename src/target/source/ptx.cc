@@ -598,6 +598,127 @@ std::string PrintMMAAssembly(const std::string& shape, const std::string& A_layo
   return asm_code;
 }
 
+/*!
+ * \brief Encode the constant fields of a wgmma shared memory matrix descriptor.
+ * \param leading_byte_offset The leading dimension byte offset.
+ * \param stride_byte_offset The stride dimension byte offset.
+ * \param swizzle_kind The swizzle kind, in the encoding of CUtensorMapSwizzle.
+ */
+inline std::string WGMMADescriptorBits(int leading_byte_offset, int stride_byte_offset,
+                                       int swizzle_kind) {
+  TVM_FFI_ICHECK(leading_byte_offset >= 0 && leading_byte_offset % 16 == 0 &&
+                 leading_byte_offset < (1 << 18))
+      << "wgmma expects the leading byte offset to be a multiple of 16 below 2^18, but got "
+      << leading_byte_offset;
+  TVM_FFI_ICHECK(stride_byte_offset >= 0 && stride_byte_offset % 16 == 0 &&
+                 stride_byte_offset < (1 << 18))
+      << "wgmma expects the stride byte offset to be a multiple of 16 below 2^18, but got "
+      << stride_byte_offset;
+  // The descriptor encodes no swizzle, 128B, 64B and 32B swizzle as 0, 1, 2 and 3, while
+  // CUtensorMapSwizzle encodes them as 0, 3, 2 and 1.
+  static const uint64_t desc_swizzle[] = {0, 3, 2, 1};
+  TVM_FFI_ICHECK(swizzle_kind >= 0 && swizzle_kind <= 3)
+      << "wgmma expects a swizzle kind in [0, 3], but got " << swizzle_kind;
+  uint64_t bits = (static_cast<uint64_t>(leading_byte_offset >> 4) << 16) |
+                  (static_cast<uint64_t>(stride_byte_offset >> 4) << 32) |
+                  (desc_swizzle[swizzle_kind] << 62);
+  return std::to_string(bits) + "ULL";
+}
+
+std::string PrintWGMMAAssembly(const std::string& shape, const std::string& A_dtype,
+                               const std::string& B_dtype, const std::string& C_dtype,
+                               const std::string& a_ptr, const std::string& a_elem_offset,
+                               int a_leading_byte_offset, int a_stride_byte_offset,
+                               const std::string& b_ptr, const std::string& b_elem_offset,
+                               int b_leading_byte_offset, int b_stride_byte_offset,
+                               int swizzle_kind, const std::string& c_ptr,
+                               const std::string& c_elem_offset, const std::string& scale_d) {
+  ptx::DataType dtype_a = ptx::DTypeFromString(A_dtype), dtype_b = ptx::DTypeFromString(B_dtype),
+                dtype_c = ptx::DTypeFromString(C_dtype);
+  auto [m, n, k] = ptx::ParseMMAShape(shape);
+  bool is_int = dtype_a == ptx::DataType::kInt8 || dtype_a == ptx::DataType::kUInt8;
+  bool is_fp8 = dtype_a == ptx::DataType::kFloat8_e4m3 || dtype_a == ptx::DataType::kFloat8_e5m2;
+  bool is_16bit = dtype_a == ptx::DataType::kFloat16 || dtype_a == ptx::DataType::kBFloat16;
+  TVM_FFI_ICHECK(is_int || is_fp8 || is_16bit || dtype_a == ptx::DataType::kTensorFloat32)
+      << "wgmma does not support multiplicands of type " << A_dtype;
+  TVM_FFI_ICHECK(is_int || is_fp8 || dtype_a == dtype_b)
+      << "wgmma expects the multiplicands to have the same type, but got " << A_dtype << " and "
+      << B_dtype;
+  if (is_int) {
+    TVM_FFI_ICHECK(dtype_b == ptx::DataType::kInt8 || dtype_b == ptx::DataType::kUInt8);
+    TVM_FFI_ICHECK(dtype_c == ptx::DataType::kInt32)
+        << "wgmma with integer multiplicands accumulates in int32, but got " << C_dtype;
+  } else if (is_fp8) {
+    TVM_FFI_ICHECK(dtype_b == ptx::DataType::kFloat8_e4m3 ||
+                   dtype_b == ptx::DataType::kFloat8_e5m2);
+  }
+  if (!is_int) {
+    TVM_FFI_ICHECK(dtype_c == ptx::DataType::kFloat32 ||
+                   (dtype_c == ptx::DataType::kFloat16 && dtype_a != ptx::DataType::kTensorFloat32))
+        << "wgmma does not support accumulators of type " << C_dtype << " for multiplicands of "
+        << "type " << A_dtype;
+  }
+  int expected_k = 256 / ptx::DTypeBits(dtype_a);
+  TVM_FFI_ICHECK(m == 64 && k == expected_k && n >= 8 && n <= 256 && n % 8 == 0 &&
+                 (!is_int || n <= 32 || n % 16 == 0))
+      << "wgmma does not support the shape " << shape << " for multiplicands of type " << A_dtype;
+
+  // Each of the 128 threads of the warpgroup holds 64 * n / 128 elements of the accumulator,
+  // and fp16 accumulators are packed by two into a register.
+  int num_regs = dtype_c == ptx::DataType::kFloat16 ? n / 4 : n / 2;
+  std::string reg_type = dtype_c == ptx::DataType::kFloat32 ? "f" : "r";
+  std::string ptr_type = dtype_c == ptx::DataType::kFloat32 ? "(float*)" : "(unsigned*)";
+  std::stringstream templates, outputs;
+  templates << "{";
+  for (int i = 0; i < num_regs; ++i) {
+    templates << (i == 0 ? "" : ", ") << "%" << i;
+    outputs << (i == 0 ? "" : ", ") << "\"+" << reg_type << "\"((" << ptr_type << "(" << c_ptr
+            << " + " << c_elem_offset << "))[" << i << "])";
+  }
+  templates << "}, %" << num_regs << ", %" << num_regs + 1 << ", p";
+  // The scales of the multiplicands are only supported for floating point types, and their
+  // transposes only for 16-bit types. The multiplicands are K-major and not negated.
+  if (!is_int) {
+    templates << ", 1, 1";
+  }
+  if (is_16bit) {
+    templates << ", 0, 0";
+  }
+
+  std::string asm_code = R"(
+  {
+    unsigned long long desc_a = {desc_a_bits} | ((cast_smem_ptr_to_int({a_addr}) & 0x3FFFF) >> 4);
+    unsigned long long desc_b = {desc_b_bits} | ((cast_smem_ptr_to_int({b_addr}) & 0x3FFFF) >> 4);
+    __asm__ __volatile__(
+      "{\n"
+      ".reg .pred p;\n"
+      "setp.ne.b32 p, %{scale_d_operand}, 0;\n"
+      "wgmma.mma_async.sync.aligned.{shape}{.dtype}{.atype}{.btype} {templates};\n"
+      "}\n"
+      : {outputs}
+      : "l"(desc_a), "l"(desc_b), "r"((int)({scale_d}))
+      : "memory");
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{desc_a_bits}", WGMMADescriptorBits(a_leading_byte_offset,
+                                                              a_stride_byte_offset, swizzle_kind));
+  replacer.register_rule("{desc_b_bits}", WGMMADescriptorBits(b_leading_byte_offset,
+                                                              b_stride_byte_offset, swizzle_kind));
+  replacer.register_rule("{a_addr}", a_ptr + " + " + a_elem_offset);
+  replacer.register_rule("{b_addr}", b_ptr + " + " + b_elem_offset);
+  replacer.register_rule("{scale_d_operand}", std::to_string(num_regs + 2));
+  replacer.register_rule("{shape}", shape);
+  replacer.register_rule("{.dtype}", ptx::DTypeToString(dtype_c));
+  replacer.register_rule("{.atype}", ptx::DTypeToString(dtype_a));
+  replacer.register_rule("{.btype}", ptx::DTypeToString(dtype_b));
+  replacer.register_rule("{templates}", templates.str());
+  replacer.register_rule("{outputs}", outputs.str());
+  replacer.register_rule("{scale_d}", scale_d);
+  asm_code = replacer.rewrite(asm_code);
+  return asm_code;
+}
+
 inline std::tuple<std::string, std::string> GetLoadMatrixOperands(
     int num, const std::string& local_ptr, const std::string& local_elem_offset) {
   std::stringstream templates, outputs;
@@ -764,6 +885,44 @@ std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
   return asm_code;
 }
 
+std::string PrintCpAsyncBulkTensorAsm(const std::string& shared_ptr,
+                                      const std::string& shared_elem_offset,
+                                      const std::string& tensor_map,
+                                      const std::vector<std::string>& coords,
+                                      const std::string& barrier) {
+  TVM_FFI_ICHECK(!coords.empty() && coords.size() <= 5)
+      << "cp.async.bulk.tensor supports tensors of 1 to 5 dimensions, but got " << coords.size();
+  std::string asm_code = R"(
+  {
+    unsigned int smem_addr_int = cast_smem_ptr_to_int({smem_addr});
+    unsigned int barrier_addr_int = cast_smem_ptr_to_int({barrier});
+    __asm__ __volatile__(
+      "cp.async.bulk.tensor.{rank}d.shared::cluster.global.tile.mbarrier::complete_tx::bytes"
+      " [%0], [%1, {{coord_operands}}], [%2];"
+      :: "r"(smem_addr_int), "l"({tensor_map}), "r"(barrier_addr_int), {coords}
+      : "memory"
+    );
+  }
+)";
+
+  // The coordinates of the PTX instruction start from the innermost dimension.
+  std::string coord_operands, coord_values;
+  for (size_t i = 0; i < coords.size(); ++i) {
+    std::string sep = i == 0 ? "" : ", ";
+    coord_operands += sep + "%" + std::to_string(i + 3);
+    coord_values += sep + "\"r\"(" + coords[coords.size() - 1 - i] + ")";
+  }
+  Replacer replacer;
+  replacer.register_rule("{smem_addr}", shared_ptr + " + " + shared_elem_offset);
+  replacer.register_rule("{tensor_map}", "&" + tensor_map);
+  replacer.register_rule("{barrier}", "&" + barrier);
+  replacer.register_rule("{rank}", std::to_string(coords.size()));
+  replacer.register_rule("{coord_operands}", coord_operands);
+  replacer.register_rule("{coords}", coord_values);
+  asm_code = replacer.rewrite(asm_code);
+  return asm_code;
+}
+
 std::string PrintCpAsyncBarrierAsm(const std::string& barrier) {
   std::string predicated_asm_code = R"(
   {
@@ -838,11 +997,30 @@ std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
   return predicated_asm_code;
 }
 
-std::string PrintWaitBarrierAsm(const std::string& barrier) {
+std::string PrintBarrierExpectTxAsm(const std::string& barrier, const std::string& byte_count) {
+  std::string predicated_asm_code = R"(
+  {
+    unsigned int barrier_addr_int = cast_smem_ptr_to_int({barrier});
+    int byte_count = {byte_count};
+    __asm__ __volatile__(
+      "mbarrier.expect_tx.relaxed.cta.shared::cta.b64 [%0], %1;"
+      :: "r"(barrier_addr_int), "r"(byte_count)
+    );
+  }
+)";
+
+  Replacer replacer;
+  replacer.register_rule("{barrier}", "&" + barrier);
+  replacer.register_rule("{byte_count}", byte_count);
+  predicated_asm_code = replacer.rewrite(predicated_asm_code);
+  return predicated_asm_code;
+}
+
+std::string PrintWaitBarrierAsm(const std::string& barrier, const std::string& phase) {
   std::string predicated_asm_code = R"(
   {
     unsigned int barrier_addr_int = cast_smem_ptr_to_int({barrier});
-    constexpr int phase_bit = 0;
+    int phase_bit = {phase};
     __asm__ __volatile__(
       "{ .reg .pred P; WAIT: mbarrier.try_wait.parity.shared.b64 P, [%0], %1; @P bra.uni DONE; bra.uni WAIT; DONE: }"
       :: "r"(barrier_addr_int), "r"(phase_bit)
@@ -852,6 +1030,7 @@ std::string PrintWaitBarrierAsm(const std::string& barrier) {
 
   Replacer replacer;
   replacer.register_rule("{barrier}", "&" + barrier);
+  replacer.register_rule("{phase}", phase);
   predicated_asm_code = replacer.rewrite(predicated_asm_code);
   return predicated_asm_code;
 }
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace tvm {
 namespace codegen {
@@ -63,6 +64,34 @@ std::string PrintMMAAssembly(const std::string& shape, const std::string& A_layo
                              const std::string& sparsity_selector, const std::string& bit_op,
                              bool sparse, bool saturate);
 
+/*!
+ * \brief Print wgmma assembly string of a warpgroup MMA with both multiplicands in shared memory.
+ * \param shape The shape string m64nNkK.
+ * \param A_dtype The data type of multiplicand A.
+ * \param B_dtype The data type of multiplicand B.
+ * \param C_dtype The data type of accumulator C.
+ * \param a_ptr Pointer to the shared memory of A.
+ * \param a_elem_offset The offset of the first element of A.
+ * \param a_leading_byte_offset The leading dimension byte offset of the descriptor of A.
+ * \param a_stride_byte_offset The stride dimension byte offset of the descriptor of A.
+ * \param b_ptr Pointer to the shared memory of B.
+ * \param b_elem_offset The offset of the first element of B.
+ * \param b_leading_byte_offset The leading dimension byte offset of the descriptor of B.
+ * \param b_stride_byte_offset The stride dimension byte offset of the descriptor of B.
+ * \param swizzle_kind The swizzle kind of A and B, in the encoding of CUtensorMapSwizzle.
+ * \param c_ptr Pointer to the accumulator registers.
+ * \param c_elem_offset The offset of the first element of the accumulator.
+ * \param scale_d Whether to accumulate into C, otherwise C is overwritten.
+ */
+std::string PrintWGMMAAssembly(const std::string& shape, const std::string& A_dtype,
+                               const std::string& B_dtype, const std::string& C_dtype,
+                               const std::string& a_ptr, const std::string& a_elem_offset,
+                               int a_leading_byte_offset, int a_stride_byte_offset,
+                               const std::string& b_ptr, const std::string& b_elem_offset,
+                               int b_leading_byte_offset, int b_stride_byte_offset,
+                               int swizzle_kind, const std::string& c_ptr,
+                               const std::string& c_elem_offset, const std::string& scale_d);
+
 /*!
  * \brief Print ldmatrix assembly string given parameters.
  * \param trans: whether the matrix is loaded in column major format or not.
@@ -123,6 +152,20 @@ std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
                                 const std::string& global_elem_offset, const std::string& bytes,
                                 const std::string& barrier);
 
+/*!
+ * \brief Print ptx async copy of a tile from global to shared memory using cp.async.bulk.tensor
+ * \param shared_ptr: The pointer to the destination shared memory.
+ * \param shared_elem_offset: The offset into the shared memory.
+ * \param tensor_map: The name of the CUtensorMap descriptor of the global tensor.
+ * \param coords: The coordinates of the tile, from the outermost to the innermost dimension.
+ * \param barrier: The name of the barrier in shared memory.
+ */
+std::string PrintCpAsyncBulkTensorAsm(const std::string& shared_ptr,
+                                      const std::string& shared_elem_offset,
+                                      const std::string& tensor_map,
+                                      const std::vector<std::string>& coords,
+                                      const std::string& barrier);
+
 /*!
  * \brief Print ptx async copy barrier using cp.async.mbarrier.arrive
  * \param barrier: The name of the barrier in shared memory.
@@ -152,11 +195,19 @@ std::string PrintArriveBarrierAsm(const std::string& barrier);
 std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
                                           const std::string& byte_count);
 
+/*!
+ * \brief Print ptx expect tx operation using mbarrier.expect_tx
+ * \param barrier: The name of the barrier in shared memory.
+ * \param byte_count: Increases the tx count of the mbarrier object without arriving on it.
+ */
+std::string PrintBarrierExpectTxAsm(const std::string& barrier, const std::string& byte_count);
+
 /*!
  * \brief Print ptx barrier wait using mbarrier.try_wait
  * \param barrier: The name of the barrier in shared memory.
+ * \param phase: The parity of the phase to wait for.
  */
-std::string PrintWaitBarrierAsm(const std::string& barrier);
+std::string PrintWaitBarrierAsm(const std::string& barrier, const std::string& phase = "0");
 
 }  // namespace codegen
 }  // namespace tvm
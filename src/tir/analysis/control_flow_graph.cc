@@ -32,6 +32,7 @@
 #include <tvm/tir/stmt_functor.h>
 
 #include <algorithm>
+#include <list>
 #include <numeric>
 #include <optional>
 #include <queue>
@@ -831,6 +832,44 @@ ControlFlowGraph::ControlFlowGraph(const tir::Stmt& stmt, int64_t max_simplifica
   BackwardPropagateUnusedValues();
 }
 
+namespace {
+/*! \brief A touch pattern cached by ControlFlowGraph::GetOrCreate. */
+struct ControlFlowGraphCacheEntry {
+  Stmt stmt;
+  int64_t max_simplification_steps;
+  size_t max_revisits;
+  std::shared_ptr<const ControlFlowGraph> graph;
+};
+
+std::list<ControlFlowGraphCacheEntry>* ControlFlowGraphCache() {
+  // The passes of a module may run in parallel, so each thread has its own cache.
+  static thread_local std::list<ControlFlowGraphCacheEntry> cache;
+  return &cache;
+}
+}  // namespace
+
+std::shared_ptr<const ControlFlowGraph> ControlFlowGraph::GetOrCreate(
+    const Stmt& stmt, int64_t max_simplification_steps, size_t max_revisits) {
+  std::list<ControlFlowGraphCacheEntry>* cache = ControlFlowGraphCache();
+  for (auto it = cache->begin(); it != cache->end(); ++it) {
+    if (it->stmt.same_as(stmt) && it->max_simplification_steps == max_simplification_steps &&
+        it->max_revisits == max_revisits) {
+      // The entries are kept in the order of their last use.
+      cache->splice(cache->begin(), *cache, it);
+      return cache->front().graph;
+    }
+  }
+  auto graph = std::make_shared<const ControlFlowGraph>(stmt, max_simplification_steps,
+                                                        max_revisits);
+  cache->push_front({stmt, max_simplification_steps, max_revisits, graph});
+  if (cache->size() > kCacheSize) {
+    cache->pop_back();
+  }
+  return graph;
+}
+
+void ControlFlowGraph::ClearCache() { ControlFlowGraphCache()->clear(); }
+
 void ControlFlowGraph::RemoveStore(const tir::BufferStore& store) {
   size_t context_index = [&]() {
     auto it = control_flow_lookup_.find(store.get());
@@ -29,6 +29,7 @@
 #include <tvm/tir/stmt.h>
 #include <tvm/tir/var.h>
 
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -402,6 +403,27 @@ class ControlFlowGraph {
   explicit ControlFlowGraph(const Stmt& stmt, int64_t max_simplification_steps = 0,
                             size_t max_revisits = 5);
 
+  /*! \brief Get the touch pattern of a TIR statement, reusing the one extracted from the same
+   * statement with the same parameters in this thread.
+   *
+   * The statements are immutable, so that the touch pattern of a statement is valid as long as a
+   * pass keeps it, e.g. the passes that leave the body of a function unchanged, and the mutations
+   * produce new statements, whose touch pattern is extracted again.  The touch patterns of the
+   * last `kCacheSize` statements are cached, and keep their statements alive.
+   *
+   * \note The touch pattern returned is shared, and must be copied to be modified,
+   * e.g. with `RemoveStore`.
+   */
+  static std::shared_ptr<const ControlFlowGraph> GetOrCreate(const Stmt& stmt,
+                                                             int64_t max_simplification_steps = 0,
+                                                             size_t max_revisits = 5);
+
+  /*! \brief Clear the touch patterns cached by `GetOrCreate` in this thread. */
+  static void ClearCache();
+
+  /*! \brief The number of the touch patterns cached in each thread. */
+  static constexpr size_t kCacheSize = 4;
+
   /* \brief Check if a write is overwritten without impacting final results
    *
    * \param store The store to be examined
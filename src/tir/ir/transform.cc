@@ -27,6 +27,8 @@
 #include <tvm/node/repr_printer.h>
 #include <tvm/tir/transform.h>
 
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace transform {
@@ -113,18 +115,42 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
-  // directly loop over the underlying dict
-  for (auto& kv : *func_dict) {
-    // only picks up tir::PrimFunc
-    if (auto opt_func = kv.second.as<PrimFunc>()) {
-      // reset the original Any state so the value contains only copy
-      // use move semantics as follows to avoid only copy.
-      kv.second.reset();
-      PrimFunc func = *std::move(opt_func);
-      func = pass_func(std::move(func), mod, pass_ctx);
-      kv.second = Any(std::move(func));
-      if (kv.second == nullptr) {
-        deleted_list.push_back(Downcast<GlobalVar>(kv.first));
+  if (pass_info->thread_safe) {
+    // The functions are transformed in parallel against the same module, and the results are
+    // written back in the order of the module once all of them are done.
+    std::vector<PrimFunc> funcs;
+    for (const auto& kv : *func_dict) {
+      if (auto opt_func = kv.second.as<PrimFunc>()) {
+        funcs.push_back(*std::move(opt_func));
+      }
+    }
+    std::vector<Any> results(funcs.size());
+    ParallelForFunctions(pass_info, pass_ctx, funcs.size(),
+                         [&](int i) { results[i] = pass_func(funcs[i], mod, pass_ctx); });
+    funcs.clear();
+    size_t index = 0;
+    for (auto& kv : *func_dict) {
+      if (kv.second.as<PrimFunc>()) {
+        kv.second = std::move(results[index++]);
+        if (kv.second == nullptr) {
+          deleted_list.push_back(Downcast<GlobalVar>(kv.first));
+        }
+      }
+    }
+  } else {
+    // directly loop over the underlying dict
+    for (auto& kv : *func_dict) {
+      // only picks up tir::PrimFunc
+      if (auto opt_func = kv.second.as<PrimFunc>()) {
+        // reset the original Any state so the value contains only copy
+        // use move semantics as follows to avoid only copy.
+        kv.second.reset();
+        PrimFunc func = *std::move(opt_func);
+        func = pass_func(std::move(func), mod, pass_ctx);
+        kv.second = Any(std::move(func));
+        if (kv.second == nullptr) {
+          deleted_list.push_back(Downcast<GlobalVar>(kv.first));
+        }
       }
     }
   }
@@ -140,8 +166,8 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreatePrimFuncPass(std::function<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
                         int opt_level, ffi::String name, tvm::ffi::Array<ffi::String> required,
-                        bool traceable) {
-  PassInfo pass_info = PassInfo(opt_level, name, required, traceable);
+                        bool traceable, bool thread_safe) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, traceable, thread_safe);
   return PrimFuncPass(std::move(pass_func), pass_info);
 }
 
@@ -43,6 +43,8 @@
 namespace tvm {
 namespace tir {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.unpacked_internal_calls", Bool);
+
 namespace {
 class ReturnRewriter : public StmtMutator {
  public:
@@ -126,8 +128,9 @@ class ReturnRewriter : public StmtMutator {
 class SubroutineCallRewriter : public StmtExprMutator {
  public:
   static ffi::Optional<Stmt> Apply(const ffi::Map<GlobalVar, ffi::String>& packed_func_methods,
-                                   Stmt stmt) {
-    SubroutineCallRewriter rewriter(packed_func_methods);
+                                   const ffi::Map<GlobalVar, GlobalVar>& unpacked_entries,
+                                   const IRModule& mod, Stmt stmt) {
+    SubroutineCallRewriter rewriter(packed_func_methods, unpacked_entries, mod);
     stmt = rewriter.VisitStmt(std::move(stmt));
     if (rewriter.made_change_) {
       return stmt;
@@ -137,14 +140,37 @@ class SubroutineCallRewriter : public StmtExprMutator {
   }
 
  private:
-  explicit SubroutineCallRewriter(const ffi::Map<GlobalVar, ffi::String>& packed_func_methods)
-      : packed_func_methods(packed_func_methods) {}
+  explicit SubroutineCallRewriter(const ffi::Map<GlobalVar, ffi::String>& packed_func_methods,
+                                  const ffi::Map<GlobalVar, GlobalVar>& unpacked_entries,
+                                  const IRModule& mod)
+      : packed_func_methods(packed_func_methods), unpacked_entries(unpacked_entries), mod(mod) {}
+
+  /*! \brief Whether the arguments have exactly the dtypes of the parameters of the callee. */
+  bool MatchesSignature(const GlobalVar& gvar, const ffi::Array<PrimExpr>& args) const {
+    const auto* callee = mod->Lookup(gvar).as<PrimFuncNode>();
+    if (callee == nullptr || callee->params.size() != args.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < args.size(); ++i) {
+      if (args[i].dtype() != callee->params[i].dtype()) {
+        return false;
+      }
+    }
+    return true;
+  }
 
   PrimExpr VisitExpr_(const CallNode* op) override {
     auto node = Downcast<Call>(StmtExprMutator::VisitExpr_(op));
 
     if (auto* gvar_ptr = node->op.as<GlobalVarNode>()) {
       auto gvar = ffi::GetRef<GlobalVar>(gvar_ptr);
+      auto unpacked = unpacked_entries.Get(gvar);
+      if (unpacked && MatchesSignature(gvar, node->args)) {
+        // The signature is verified at compile time, so the call can skip the type checks and
+        // argument unpacking of the PackedFunc API.
+        made_change_ = true;
+        return tir::Call(node->dtype, unpacked.value(), node->args, node->span);
+      }
       if (auto symbol = packed_func_methods.Get(gvar)) {
         ffi::Array<PrimExpr> cpacked_args;
         cpacked_args.push_back(tir::StringImm(symbol.value()));
@@ -162,6 +188,8 @@ class SubroutineCallRewriter : public StmtExprMutator {
     return node;
   }
   const ffi::Map<GlobalVar, ffi::String>& packed_func_methods;
+  const ffi::Map<GlobalVar, GlobalVar>& unpacked_entries;
+  const IRModule& mod;
   bool made_change_{false};
 };
 
@@ -410,6 +438,46 @@ PrimFunc MakePackedAPI(PrimFunc func) {
   return func;
 }
 
+/*!
+ * \brief Collect the functions that get an unpacked entry, and the GlobalVars of the entries.
+ *
+ * A function gets an unpacked entry if it is called from within the module, runs on the host and
+ * takes all of its arguments directly, i.e. has no buffer to be unpacked from a DLTensor.
+ */
+ffi::Map<GlobalVar, GlobalVar> CollectUnpackedEntries(
+    const IRModule& mod, const ffi::Map<GlobalVar, ffi::String>& packed_func_methods) {
+  std::unordered_set<const GlobalVarNode*> callees;
+  for (const auto& [gvar, base_func] : mod->functions) {
+    if (auto func = base_func.as<PrimFuncNode>()) {
+      PostOrderVisit(func->body, [&callees](const ObjectRef& node) {
+        if (const auto* call = node.as<CallNode>()) {
+          if (const auto* callee = call->op.as<GlobalVarNode>()) {
+            callees.insert(callee);
+          }
+        }
+      });
+    }
+  }
+
+  ffi::Map<GlobalVar, GlobalVar> unpacked_entries;
+  for (const auto& [gvar, symbol] : packed_func_methods) {
+    if (!callees.count(gvar.get())) {
+      continue;
+    }
+    auto func = Downcast<PrimFunc>(mod->Lookup(gvar));
+    auto target = func->GetAttr<Target>(tvm::attr::kTarget);
+    if (!target || !target.value()->GetHost() || func->buffer_map.size()) {
+      continue;
+    }
+    std::string name = std::string(gvar->name_hint) + "_unpacked";
+    for (int i = 1; mod->ContainGlobalVar(name); ++i) {
+      name = std::string(gvar->name_hint) + "_unpacked_" + std::to_string(i);
+    }
+    unpacked_entries.Set(gvar, GlobalVar(name));
+  }
+  return unpacked_entries;
+}
+
 namespace transform {
 
 Pass MakePackedAPI() {
@@ -424,6 +492,13 @@ Pass MakePackedAPI() {
       }
     }
 
+    // The externally visible functions that are called from within the module get an internal
+    // entry with the signature of the PrimFunc, which the calls bind to directly.
+    ffi::Map<GlobalVar, GlobalVar> unpacked_entries;
+    if (ctx->GetConfig<Bool>("tir.unpacked_internal_calls", Bool(false)).value()) {
+      unpacked_entries = CollectUnpackedEntries(mod, packed_func_methods);
+    }
+
     IRModuleNode* mptr = mod.CopyOnWrite();
     IRModule updates;
 
@@ -432,10 +507,18 @@ Pass MakePackedAPI() {
         auto func = opt.value();
         auto orig_func = func;
 
-        if (auto body = SubroutineCallRewriter::Apply(packed_func_methods, func->body)) {
+        if (auto body = SubroutineCallRewriter::Apply(packed_func_methods, unpacked_entries, mod,
+                                                      func->body)) {
           func.CopyOnWrite()->body = body.value();
         }
 
+        if (auto unpacked_gvar = unpacked_entries.Get(gvar)) {
+          auto target = func->GetAttr<Target>(tvm::attr::kTarget).value();
+          PrimFunc unpacked = WithoutAttr(func, tvm::attr::kGlobalSymbol);
+          unpacked = WithAttr(std::move(unpacked), tvm::attr::kTarget, target->GetHost().value());
+          updates->Add(unpacked_gvar.value(), unpacked);
+        }
+
         func = MakePackedAPI(std::move(func));
 
         if (!func.same_as(orig_func)) {
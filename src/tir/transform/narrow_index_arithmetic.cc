@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file narrow_index_arithmetic.cc
+ * \brief Compute the int64 indices of the GPU kernels in int32 where the ranges allow it.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/transform.h>
+
+#include <vector>
+
+#include "../../arith/ir_mutator_with_analyzer.h"
+
+namespace tvm {
+namespace tir {
+
+// NarrowDataType keeps a variable in int64 as soon as one expression that contains it may not
+// fit into int32, so a single large buffer keeps all the index arithmetic of a kernel in int64.
+// This pass instead narrows each index expression on its own: the sub-expressions of which every
+// node provably fits into int32 are computed in int32 and cast to int64, and the terms of a sum
+// that may not fit, e.g. the base offset of a tile in a large buffer, are kept in int64.
+//
+// Only the indices inside the kernels, i.e. under a thread_extent attribute, are rewritten.
+class IndexArithmeticNarrower : public arith::IRMutatorWithAnalyzer {
+ public:
+  static PrimFunc Rewrite(PrimFunc func) {
+    arith::Analyzer analyzer;
+    IndexArithmeticNarrower narrower(&analyzer);
+    narrower.MarkBufferMapShapes(func);
+    auto* n = func.CopyOnWrite();
+    n->body = narrower(std::move(n->body));
+    return func;
+  }
+
+ private:
+  using Parent = arith::IRMutatorWithAnalyzer;
+  using Parent::VisitExpr_;
+  using Parent::VisitStmt_;
+
+  explicit IndexArithmeticNarrower(arith::Analyzer* analyzer) : Parent(analyzer) {}
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent && !in_kernel_) {
+      in_kernel_ = true;
+      Stmt stmt = Parent::VisitStmt_(op);
+      in_kernel_ = false;
+      return stmt;
+    }
+    return Parent::VisitStmt_(op);
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    BufferLoad load = Downcast<BufferLoad>(Parent::VisitExpr_(op));
+    if (in_kernel_) {
+      load.CopyOnWrite()->indices = load->indices.Map([this](PrimExpr e) { return Narrow(e); });
+    }
+    return load;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode* op) final {
+    BufferStore store = Downcast<BufferStore>(Parent::VisitStmt_(op));
+    if (in_kernel_) {
+      store.CopyOnWrite()->indices = store->indices.Map([this](PrimExpr e) { return Narrow(e); });
+    }
+    return store;
+  }
+
+  /*! \brief Whether the value of the expression provably fits into int32. */
+  bool FitsInt32(const PrimExpr& e) {
+    arith::ConstIntBound bound = analyzer_->const_int_bound(e);
+    return bound->min_value >= min_int32_ && bound->max_value <= max_int32_;
+  }
+
+  /*!
+   * \brief Rewrite an int64 expression to int32, if every node of it fits into int32.
+   * \return The int32 expression, or an undefined expression if it cannot be narrowed.
+   */
+  PrimExpr TryNarrow(const PrimExpr& e) {
+    if (e.dtype() != DataType::Int(64) || !FitsInt32(e)) {
+      return PrimExpr();
+    }
+    if (const auto* imm = e.as<IntImmNode>()) {
+      return IntImm(DataType::Int(32), imm->value);
+    }
+    if (e.as<VarNode>()) {
+      return cast(DataType::Int(32), e);
+    }
+    if (const auto* op = e.as<CastNode>()) {
+      if (op->value.dtype().is_int() || op->value.dtype().is_uint()) {
+        return cast(DataType::Int(32), op->value);
+      }
+      return PrimExpr();
+    }
+    if (const auto* op = e.as<AddNode>()) return TryNarrowBinary<Add>(op);
+    if (const auto* op = e.as<SubNode>()) return TryNarrowBinary<Sub>(op);
+    if (const auto* op = e.as<MulNode>()) return TryNarrowBinary<Mul>(op);
+    if (const auto* op = e.as<FloorDivNode>()) return TryNarrowBinary<FloorDiv>(op);
+    if (const auto* op = e.as<FloorModNode>()) return TryNarrowBinary<FloorMod>(op);
+    if (const auto* op = e.as<DivNode>()) return TryNarrowBinary<Div>(op);
+    if (const auto* op = e.as<ModNode>()) return TryNarrowBinary<Mod>(op);
+    if (const auto* op = e.as<MinNode>()) return TryNarrowBinary<Min>(op);
+    if (const auto* op = e.as<MaxNode>()) return TryNarrowBinary<Max>(op);
+    return PrimExpr();
+  }
+
+  /*! \brief Rewrite a binary operation to int32, if both of its operands can be narrowed. */
+  template <typename TOp, typename TNode>
+  PrimExpr TryNarrowBinary(const TNode* op) {
+    PrimExpr a = TryNarrow(op->a);
+    if (!a.defined()) {
+      return PrimExpr();
+    }
+    PrimExpr b = TryNarrow(op->b);
+    if (!b.defined()) {
+      return PrimExpr();
+    }
+    return TOp(a, b);
+  }
+
+  /*! \brief Whether the expression has arithmetic to be computed, i.e. is not a leaf. */
+  static bool IsArithmetic(const PrimExpr& e) {
+    return !e.as<IntImmNode>() && !e.as<VarNode>() && !e.as<CastNode>();
+  }
+
+  /*! \brief Collect the terms of a sum. */
+  static void CollectTerms(const PrimExpr& e, std::vector<PrimExpr>* terms) {
+    if (const auto* op = e.as<AddNode>()) {
+      CollectTerms(op->a, terms);
+      CollectTerms(op->b, terms);
+    } else {
+      terms->push_back(e);
+    }
+  }
+
+  /*! \brief Narrow the arithmetic of an index expression, keeping its dtype. */
+  PrimExpr Narrow(const PrimExpr& e) {
+    if (const auto* op = e.as<RampNode>()) {
+      return Ramp(Narrow(op->base), op->stride, op->lanes);
+    }
+    if (const auto* op = e.as<BroadcastNode>()) {
+      return Broadcast(Narrow(op->value), op->lanes);
+    }
+    if (e.dtype() != DataType::Int(64)) {
+      return e;
+    }
+    if (IsArithmetic(e)) {
+      if (PrimExpr narrowed = TryNarrow(e); narrowed.defined()) {
+        return cast(DataType::Int(64), narrowed);
+      }
+    }
+    if (e.as<AddNode>()) {
+      // Sum up the terms that fit into int32 in int32, as long as the partial sum fits too, and
+      // add the others in int64.
+      std::vector<PrimExpr> terms;
+      CollectTerms(e, &terms);
+      PrimExpr wide_sum, narrow_sum, narrow_sum_int64;
+      int num_narrow_terms = 0;
+      for (const PrimExpr& term : terms) {
+        PrimExpr narrowed = TryNarrow(term);
+        if (narrowed.defined()) {
+          PrimExpr sum_int64 = narrow_sum_int64.defined() ? narrow_sum_int64 + term : term;
+          if (FitsInt32(sum_int64)) {
+            narrow_sum = narrow_sum.defined() ? Add(narrow_sum, narrowed) : narrowed;
+            narrow_sum_int64 = sum_int64;
+            ++num_narrow_terms;
+            continue;
+          }
+        }
+        PrimExpr wide = Narrow(term);
+        wide_sum = wide_sum.defined() ? Add(wide_sum, wide) : wide;
+      }
+      if (num_narrow_terms == 0) {
+        return wide_sum;
+      }
+      // A single leaf gains nothing from being cast twice.
+      PrimExpr narrow_part = num_narrow_terms == 1 && !IsArithmetic(narrow_sum_int64)
+                                 ? narrow_sum_int64
+                                 : cast(DataType::Int(64), narrow_sum);
+      return wide_sum.defined() ? Add(wide_sum, narrow_part) : narrow_part;
+    }
+    if (const auto* op = e.as<MulNode>()) {
+      return Mul(Narrow(op->a), Narrow(op->b));
+    }
+    return e;
+  }
+
+  /*! \brief Whether the visitor is inside a kernel. */
+  bool in_kernel_{false};
+  /*! \brief The range of int32. */
+  const int64_t min_int32_ = Downcast<IntImm>(min_value(DataType::Int(32)))->value;
+  const int64_t max_int32_ = Downcast<IntImm>(max_value(DataType::Int(32)))->value;
+};
+
+namespace transform {
+
+Pass NarrowIndexArithmetic() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    return IndexArithmeticNarrower::Rewrite(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.NarrowIndexArithmetic", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tir.transform.NarrowIndexArithmetic", NarrowIndexArithmetic);
+}
+
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
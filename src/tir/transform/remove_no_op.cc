@@ -316,7 +316,9 @@ Pass RemoveNoOp() {
                                   .value_or(AttrsWithDefaultValues<RemoveNoOpConfig>());
 
     if (config->use_dataflow_analysis) {
-      touch_pattern.emplace(f->body, config->max_simplification_steps);
+      // The touch pattern is modified by the removal of the stores, so the cached one is copied.
+      touch_pattern.emplace(
+          *ControlFlowGraph::GetOrCreate(f->body, config->max_simplification_steps));
     }
 
     arith::Analyzer analyzer;
@@ -329,7 +331,8 @@ Pass RemoveNoOp() {
     }
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.RemoveNoOp", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.RemoveNoOp", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
@@ -153,10 +153,10 @@ class StmtSimplifier : public IRMutatorWithAnalyzer {
     auto config = config_opt.value_or(AttrsWithDefaultValues<arith::SimplifyConfig>());
     analyzer->rewrite_simplify.SetEnabledExtensions(config->GetEnabledExtensions());
 
-    std::optional<ControlFlowGraph> touch_pattern = std::nullopt;
+    std::shared_ptr<const ControlFlowGraph> touch_pattern = nullptr;
     if (config->propagate_knowns_to_prove_conditional ||
         config->propagate_knowns_to_simplify_expressions) {
-      touch_pattern = ControlFlowGraph(func->body);
+      touch_pattern = ControlFlowGraph::GetOrCreate(func->body);
     }
 
     std::unordered_set<const VarNode*> used_in_buffer_def =
@@ -170,7 +170,7 @@ class StmtSimplifier : public IRMutatorWithAnalyzer {
 
  private:
   explicit StmtSimplifier(Analyzer* analyzer, SimplifyConfig config,
-                          std::optional<ControlFlowGraph> touch_pattern,
+                          std::shared_ptr<const ControlFlowGraph> touch_pattern,
                           std::unordered_set<const VarNode*> used_in_buffer_def)
       : IRMutatorWithAnalyzer(analyzer),
         config_(config),
@@ -322,7 +322,7 @@ class StmtSimplifier : public IRMutatorWithAnalyzer {
   ffi::Optional<Bool> ProveCondition(PrimExpr condition) const {
     condition = Substitute(condition, non_inlined_bindings_);
     if (config_->propagate_knowns_to_prove_conditional) {
-      TVM_FFI_ICHECK(touch_pattern_.has_value());
+      TVM_FFI_ICHECK(touch_pattern_ != nullptr);
       condition = touch_pattern_->SimplifyInContext(condition, current_stmt_.value(), analyzer_);
     } else {
       condition = analyzer_->Simplify(condition);
@@ -335,7 +335,7 @@ class StmtSimplifier : public IRMutatorWithAnalyzer {
   }
 
   SimplifyConfig config_;
-  std::optional<ControlFlowGraph> touch_pattern_;
+  std::shared_ptr<const ControlFlowGraph> touch_pattern_;
 
   ffi::Map<Var, PrimExpr> non_inlined_bindings_;
   ffi::Optional<Stmt> current_stmt_{std::nullopt};
@@ -359,7 +359,8 @@ Pass Simplify() {
 
     return arith::StmtSimplifier::Apply(f, &analyzer, cfg);
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.Simplify", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.Simplify", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
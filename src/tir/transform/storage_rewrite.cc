@@ -39,6 +39,7 @@
 
 #include "../../arith/int_operator.h"
 #include "../../runtime/thread_storage_scope.h"
+#include "../../support/arena.h"
 #include "../ir/buffer_common.h"
 #include "ir_utils.h"
 
@@ -382,6 +383,13 @@ class StoragePlanRewriter : public StmtExprMutator {
   using StmtEntry = LinearAccessPatternFinder::StmtEntry;
   using AllocEntry = LinearAccessPatternFinder::AllocEntry;
 
+  ~StoragePlanRewriter() {
+    // The entries are allocated from the arena, which only frees their memory.
+    for (StorageEntry* e : alloc_vec_) {
+      e->~StorageEntry();
+    }
+  }
+
   Stmt Rewrite(Stmt stmt, bool detect_inplace, bool enable_reuse,
                bool reuse_require_exact_matched_dtype) {
     detect_inplace_ = detect_inplace;
@@ -604,7 +612,7 @@ class StoragePlanRewriter : public StmtExprMutator {
   // Prepare the new allocations
   void PrepareNewAlloc() {
     for (size_t i = 0; i < alloc_vec_.size(); ++i) {
-      StorageEntry* e = alloc_vec_[i].get();
+      StorageEntry* e = alloc_vec_[i];
       attach_map_[e->attach_scope_].push_back(e);
     }
     // find allocation via attach map.
@@ -888,13 +896,12 @@ class StoragePlanRewriter : public StmtExprMutator {
                          const StorageScope& scope, size_t const_nbits) {
     TVM_FFI_ICHECK(op != nullptr);
     // Re-use not successful, allocate a new buffer.
-    auto entry = std::make_unique<StorageEntry>();
-    entry->attach_scope_ = attach_scope;
-    entry->scope = scope;
-    entry->elem_type = op->dtype.element_of();
-    entry->const_nbits = const_nbits;
-    StorageEntry* e = entry.get();
-    alloc_vec_.emplace_back(std::move(entry));
+    StorageEntry* e = arena_.make<StorageEntry>();
+    e->attach_scope_ = attach_scope;
+    e->scope = scope;
+    e->elem_type = op->dtype.element_of();
+    e->const_nbits = const_nbits;
+    alloc_vec_.push_back(e);
     return e;
   }
 
@@ -1001,16 +1008,22 @@ class StoragePlanRewriter : public StmtExprMutator {
   bool detect_inplace_{false};
   // Locations of free ops.
   std::unordered_map<const Object*, EventEntry> event_map_;
+  // The arena of the storage entries and of the nodes of the free lists, which are inserted and
+  // erased at each reuse, freed at once with the rewriter.
+  support::Arena arena_;
   // constant size free map.
-  std::multimap<uint64_t, StorageEntry*> const_free_map_;
+  std::multimap<uint64_t, StorageEntry*, std::less<uint64_t>,
+                support::ArenaAllocator<std::pair<const uint64_t, StorageEntry*>>>
+      const_free_map_{support::ArenaAllocator<std::pair<const uint64_t, StorageEntry*>>(&arena_)};
   // symbolic free list, for non constant items.
-  std::list<StorageEntry*> sym_free_list_;
+  std::list<StorageEntry*, support::ArenaAllocator<StorageEntry*>> sym_free_list_{
+      support::ArenaAllocator<StorageEntry*>(&arena_)};
   // The allocation attach map
   std::unordered_map<const Object*, std::vector<StorageEntry*>> attach_map_;
   // The allocation assign map
   std::unordered_map<const VarNode*, StorageEntry*> alloc_map_;
-  // The allocations
-  std::vector<std::unique_ptr<StorageEntry>> alloc_vec_;
+  // The allocations, in the arena.
+  std::vector<StorageEntry*> alloc_vec_;
   // The buffer objects being remapped
   std::unordered_map<const BufferNode*, Buffer> buffer_remap_;
   // Buffers whose DeclBuffer has been hoisted to be adjacent to the new Allocate location
@@ -25,11 +25,15 @@
 #include <tvm/arith/analyzer.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <sstream>
+#include <string>
 #include <unordered_set>
 
 #include "../../runtime/thread_storage_scope.h"
@@ -44,6 +48,7 @@ struct UnrollLoopConfigNode : public AttrsNodeReflAdapter<UnrollLoopConfigNode>
   int auto_max_extent;
   int explicit_unroll;
   int unroll_local_access;
+  bool auto_unroll_heuristic;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -60,7 +65,12 @@ struct UnrollLoopConfigNode : public AttrsNodeReflAdapter<UnrollLoopConfigNode>
                 "Whether to explicitly unroll the loop instead of setting a pragma",
                 refl::DefaultValue(true))
         .def_ro("unroll_local_access", &UnrollLoopConfigNode::unroll_local_access,
-                "Whether to always unroll local access", refl::DefaultValue(false));
+                "Whether to always unroll local access", refl::DefaultValue(false))
+        .def_ro("auto_unroll_heuristic", &UnrollLoopConfigNode::auto_unroll_heuristic,
+                "Whether to unroll the loops by the cost model of the target when the unrolling "
+                "is not tuned, i.e. neither auto_max_step nor auto_max_extent is set and the "
+                "loops are not under pragma_auto_unroll_max_step",
+                refl::DefaultValue(true));
   }
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tir.transform.UnrollLoopConfig", UnrollLoopConfigNode,
                                     BaseAttrsNode);
@@ -74,6 +84,50 @@ class UnrollLoopConfig : public Attrs {
 TVM_FFI_STATIC_INIT_BLOCK() { UnrollLoopConfigNode::RegisterReflection(); }
 
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.UnrollLoop", UnrollLoopConfig);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.unroll_loop_report", Bool);
+
+// The budgets of the cost model unrolling the loops whose unrolling is not tuned.
+// The estimated instructions of an unrolled loop. The CPU backends unroll the loops by
+// themselves, while the loop overheads of the short GPU kernels are not hidden.
+constexpr int64_t kCPUMaxUnrolledInsts = 32;
+constexpr int64_t kGPUMaxUnrolledInsts = 256;
+// The registers of a multiprocessor and of a thread of the common GPUs.
+constexpr int64_t kGPURegsPerSM = 65536;
+constexpr int64_t kGPUMaxRegsPerThread = 255;
+// The registers of a thread taken by the indices, the addresses and the rest of the kernel.
+constexpr int64_t kGPUBaseRegs = 32;
+
+bool IsLocalBuffer(const Var& buffer_var) {
+  auto storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(buffer_var));
+  return storage_scope.rank == runtime::StorageRank::kLocal ||
+         storage_scope.rank == runtime::StorageRank::kWarp;
+}
+
+// The 32-bit registers holding a value of the type.
+int64_t NumRegisterWords(DataType dtype) { return (dtype.bytes() * dtype.lanes() + 3) / 4; }
+
+// Estimates the instructions of the expressions, and the registers taken by the values they
+// load from the memory, which are all loaded ahead once the loop is unrolled.
+class UnrollCostEstimator : public ExprVisitor {
+ public:
+  void VisitExpr(const PrimExpr& e) final {
+    if (!e->IsInstance<VarNode>() && !e->IsInstance<IntImmNode>() &&
+        !e->IsInstance<FloatImmNode>() && !e->IsInstance<StringImmNode>()) {
+      ++num_insts;
+    }
+    ExprVisitor::VisitExpr(e);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    if (!IsLocalBuffer(op->buffer->data)) {
+      load_words += NumRegisterWords(op->dtype);
+    }
+    ExprVisitor::VisitExpr_(op);
+  }
+
+  int64_t num_insts{0};
+  int64_t load_words{0};
+};
 
 class VarLocalAccessMarker : public ExprVisitor {
  public:
@@ -92,19 +146,33 @@ class VarLocalAccessMarker : public ExprVisitor {
 class LoopUnroller : public StmtExprMutator {
  public:
   explicit LoopUnroller(int auto_max_step, int auto_max_depth, int auto_max_extent,
-                        bool explicit_unroll, bool unroll_local_access)
+                        bool explicit_unroll, bool unroll_local_access, bool auto_unroll_heuristic,
+                        ffi::Optional<Target> target, ffi::String report_name)
       : auto_max_step_(auto_max_step),
         auto_max_depth_(auto_max_depth),
         auto_max_extent_(auto_max_extent),
         explicit_unroll_(explicit_unroll),
-        unroll_local_access_(unroll_local_access) {}
+        unroll_local_access_(unroll_local_access),
+        report_name_(std::move(report_name)) {
+    // The cost model needs the target, and only takes the loops whose unrolling is not tuned.
+    heuristic_ = auto_unroll_heuristic && target.defined() && auto_max_step == 0 &&
+                 auto_max_extent == 0;
+    if (target.defined()) {
+      int dev_type = target.value()->GetTargetDeviceType();
+      is_gpu_ = dev_type == kDLCUDA || dev_type == kDLROCM || dev_type == kDLMetal ||
+                dev_type == kDLVulkan || dev_type == kDLOpenCL || dev_type == kDLWebGPU;
+    }
+  }
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == "pragma_auto_unroll_max_step") {
       int value = static_cast<int>(Downcast<Integer>(op->value)->value);
+      bool heuristic = false;
       std::swap(value, auto_max_step_);
+      std::swap(heuristic, heuristic_);
       Stmt ret = this->VisitStmt(op->body);
       std::swap(value, auto_max_step_);
+      std::swap(heuristic, heuristic_);
       return ret;
     } else if (op->attr_key == "pragma_unroll_explicit") {
       bool explicit_unroll = Downcast<Integer>(op->value)->value;
@@ -112,11 +180,39 @@ class LoopUnroller : public StmtExprMutator {
       Stmt ret = this->VisitStmt(op->body);
       std::swap(explicit_unroll, explicit_unroll_);
       return ret;
+    } else if (op->attr_key == attr::thread_extent) {
+      // The registers of a thread are bounded by the threads of the thread block.
+      IterVar iv = Downcast<IterVar>(op->node);
+      const auto* extent = op->value.as<IntImmNode>();
+      int64_t num_threads = num_threads_;
+      bool in_kernel = in_kernel_;
+      in_kernel_ = true;
+      if (extent != nullptr && std::string(iv->thread_tag).rfind("threadIdx.", 0) == 0) {
+        num_threads_ *= std::max<int64_t>(extent->value, 1);
+      }
+      Stmt ret = StmtExprMutator::VisitStmt_(op);
+      num_threads_ = num_threads;
+      in_kernel_ = in_kernel;
+      return ret;
     } else {
       return StmtExprMutator::VisitStmt_(op);
     }
   }
 
+  Stmt VisitStmt_(const AllocateNode* op) final {
+    // The local allocations of constant sizes are promoted to the registers.
+    int64_t words = 0;
+    if (IsLocalBuffer(op->buffer_var)) {
+      if (auto size = op->ConstantAllocationSize()) {
+        words = size * NumRegisterWords(op->dtype);
+      }
+    }
+    local_words_ += words;
+    Stmt ret = StmtExprMutator::VisitStmt_(op);
+    local_words_ -= words;
+    return ret;
+  }
+
   Stmt VisitStmt_(const ForNode* op) {
     // Post order so we can collect more information
     Stmt stmt = StmtExprMutator::VisitStmt_(op);
@@ -140,8 +236,42 @@ class LoopUnroller : public StmtExprMutator {
       auto_unroll = true;
     }
 
+    // Unroll the loops whose unrolling is not tuned when the cost model of the target allows.
+    int64_t unrolled_insts = inst_count_ * std::max(value, 0);
+    int64_t unrolled_regs = kGPUBaseRegs + local_words_ + load_words_ * std::max(value, 0);
+    int64_t max_regs = std::min(kGPUMaxRegsPerThread, kGPURegsPerSM / num_threads_);
+    bool by_heuristic = false;
+    if (!auto_unroll && heuristic_ && op->kind == ForKind::kSerial && op->HasTrivialStep() &&
+        value > 1 && normal_loop_depth_ == 0 && unroll_depth_ <= auto_max_depth_ &&
+        (!is_gpu_ || in_kernel_)) {
+      by_heuristic = unrolled_insts <= (is_gpu_ ? kGPUMaxUnrolledInsts : kCPUMaxUnrolledInsts) &&
+                     (!is_gpu_ || unrolled_regs <= max_regs);
+      auto_unroll = by_heuristic;
+    }
+
+    if (!report_name_.empty() && value >= 0 &&
+        (op->kind == ForKind::kSerial || op->kind == ForKind::kUnrolled)) {
+      std::ostringstream os;
+      os << "UnrollLoop: kernel " << report_name_ << (auto_unroll ? " unrolls" : " keeps")
+         << " loop " << op->loop_var << " of extent " << value << ", estimated "
+         << unrolled_insts << " unrolled instructions";
+      if (is_gpu_) {
+        os << " and " << unrolled_regs << " of " << max_regs << " registers";
+      }
+      if (op->kind == ForKind::kUnrolled) {
+        os << " (annotated)";
+      } else if (by_heuristic || (!auto_unroll && heuristic_)) {
+        os << " (cost model)";
+      } else {
+        os << " (config)";
+      }
+      LOG(INFO) << os.str();
+    }
+
     if (auto_unroll) {
       step_count_ *= value;
+      inst_count_ *= value;
+      load_words_ *= value;
       unroll_depth_ += 1;
     } else {
       normal_loop_depth_ += 1;
@@ -179,6 +309,13 @@ class LoopUnroller : public StmtExprMutator {
 
   Stmt VisitStmt_(const BufferStoreNode* op) final {
     ++step_count_;
+    UnrollCostEstimator estimator;
+    estimator(op->value);
+    for (const PrimExpr& index : op->indices) {
+      estimator(index);
+    }
+    inst_count_ += estimator.num_insts + 1;
+    load_words_ += estimator.load_words;
     if (unroll_local_access_) {
       auto storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(op->buffer->data));
       if (storage_scope.rank == runtime::StorageRank::kLocal ||
@@ -194,19 +331,29 @@ class LoopUnroller : public StmtExprMutator {
 
   Stmt VisitStmt_(const EvaluateNode* op) final {
     ++step_count_;
+    UnrollCostEstimator estimator;
+    estimator(op->value);
+    inst_count_ += estimator.num_insts;
+    load_words_ += estimator.load_words;
     return StmtExprMutator::VisitStmt_(op);
   }
 
   Stmt VisitStmt_(const SeqStmtNode* op) final {
     auto fmutate = [this](const Stmt& s) {
       int step_count = step_count_;
+      int64_t inst_count = inst_count_;
+      int64_t load_words = load_words_;
       int unroll_depth = unroll_depth_;
       int normal_loop_depth = normal_loop_depth_;
       step_count_ = 0;
+      inst_count_ = 0;
+      load_words_ = 0;
       unroll_depth_ = 0;
       normal_loop_depth_ = 0;
       Stmt ret = this->VisitStmt(s);
       step_count_ += step_count;
+      inst_count_ += inst_count;
+      load_words_ += load_words;
       normal_loop_depth_ = std::max(normal_loop_depth, normal_loop_depth_);
       unroll_depth_ = std::max(unroll_depth_, unroll_depth);
       return ret;
@@ -254,6 +401,20 @@ class LoopUnroller : public StmtExprMutator {
   bool explicit_unroll_;
   // Wether to unroll loops to local access.
   bool unroll_local_access_{false};
+  // Whether to unroll the loops by the cost model, i.e. the unrolling is not tuned.
+  bool heuristic_{false};
+  // Whether the target is a GPU, whose cost model bounds the registers of a thread.
+  bool is_gpu_{false};
+  // Whether in a kernel, and the number of threads of its thread block.
+  bool in_kernel_{false};
+  int64_t num_threads_{1};
+  // The 32-bit words of the local allocations in scope.
+  int64_t local_words_{0};
+  // Estimated instructions and loaded words of the current scope after unrolling.
+  int64_t inst_count_{0};
+  int64_t load_words_{0};
+  // The name of the kernel whose unrolling decisions are logged, empty if not logged.
+  ffi::String report_name_;
   // Number of normal loops in scope
   int normal_loop_depth_{0};
   // number of unrolled cases in current scope.
@@ -266,9 +427,11 @@ class LoopUnroller : public StmtExprMutator {
   arith::Analyzer analyzer_;
 };
 
-Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
+Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg, ffi::Optional<Target> target,
+                const ffi::String& report_name) {
   Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
-                          cfg->explicit_unroll, cfg->unroll_local_access)(stmt);
+                          cfg->explicit_unroll, cfg->unroll_local_access,
+                          cfg->auto_unroll_heuristic, target, report_name)(stmt);
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -285,7 +448,12 @@ Pass UnrollLoop() {
     if (!cfg.defined()) {
       cfg = AttrsWithDefaultValues<UnrollLoopConfig>();
     }
-    n->body = UnrollLoop(std::move(f->body), cfg.value());
+    ffi::String report_name;
+    if (ctx->GetConfig<Bool>("tir.unroll_loop_report", Bool(false)).value()) {
+      report_name = f->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol).value_or("<anonymous>");
+    }
+    n->body = UnrollLoop(std::move(f->body), cfg.value(), f->GetAttr<Target>(tvm::attr::kTarget),
+                         report_name);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {});
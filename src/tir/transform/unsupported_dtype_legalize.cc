@@ -36,6 +36,12 @@
 namespace tvm {
 namespace tir {
 
+/*! \brief Whether the call uses the bits of its arguments, which are not to be promoted. */
+inline bool IsBitwiseUse(const CallNode* op) {
+  return op->op.same_as(builtin::reinterpret()) || op->op.same_as(builtin::call_llvm_intrin()) ||
+         op->op.same_as(builtin::call_llvm_pure_intrin());
+}
+
 // NOTE: do not touch buffer on function boundary
 // remap internal fp8/bf16 buffer to f32 if they meet the following condition
 // - constant allocation size
@@ -112,6 +118,19 @@ class ComputeLegalizePlanner : public StmtExprVisitor {
     }
   }
 
+  void VisitExpr_(const CallNode* op) final {
+    StmtExprVisitor::VisitExpr_(op);
+    // The bits of the buffers that are reinterpreted or passed to LLVM intrinsics, e.g. the bf16
+    // dot products, are used as is, so the buffers keep their data type.
+    if (IsBitwiseUse(op)) {
+      for (const PrimExpr& arg : op->args) {
+        if (const auto* load = arg.as<BufferLoadNode>()) {
+          opaque_var_access_.insert(load->buffer->data);
+        }
+      }
+    }
+  }
+
  private:
   void PopulateBufferRemap(Buffer buf) {
     auto var_it = var_remap_->find(buf->data);
@@ -227,8 +246,9 @@ class ComputeLegalizer : public StmtExprMutator {
   }
 
   PrimExpr VisitExpr_(const CallNode* op) final {
-    // presertve reinterpret<bf16>() behavior.
-    if (op->op.same_as(builtin::reinterpret())) {
+    // presertve reinterpret<bf16>() behavior, and the fp8/bf16 operands of the LLVM intrinsics,
+    // e.g. vdpbf16ps and bfdot, which take them natively.
+    if (IsBitwiseUse(op)) {
       return StmtExprMutator::VisitExpr_(op);
     }
     // update normal computations to return f32 instead.
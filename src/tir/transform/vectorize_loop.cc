@@ -22,7 +22,6 @@
  */
 // Loop vectorizer as in Halide pipeline.
 #include <tvm/arith/analyzer.h>
-#include <tvm/ffi/extra/structural_equal.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/tir/analysis.h>
@@ -33,7 +32,11 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <functional>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../../src/arith/scalable_expression.h"
@@ -83,8 +86,17 @@ bool EnableBufferLevelPredication(Target target) {
     return enable_buffer_predication.value();
   }
 
-  // Use buffer-level predication by default for VLA targets
-  return arith::TargetHasVLA(target);
+  // Use buffer-level predication by default for VLA targets, and for the x86 targets with
+  // AVX-512, whose mask registers make masked loads and stores as cheap as unmasked ones.
+  if (arith::TargetHasVLA(target)) {
+    return true;
+  }
+  if (!target.defined()) {
+    return false;
+  }
+  static auto target_has_feature_fn =
+      tvm::ffi::Function::GetGlobalRequired("target.target_has_feature");
+  return target_has_feature_fn("avx512f", target).cast<bool>();
 }
 
 /*!
@@ -93,7 +105,11 @@ bool EnableBufferLevelPredication(Target target) {
  *
  * \note For now we start with a minimal case targeting block-level predicates
  * produced by the split schedule primitive, with the potential for predicating
- * more complex terms in the future if needed.
+ * more complex terms in the future if needed. The condition must keep a prefix of
+ * the lanes, i.e. be `Ramp(base, 1, lanes) < Broadcast(limit)` or an equivalent
+ * comparison, so that it is the active lane mask of `base` and `limit`. The mask is
+ * then applied to every contiguous access of the statement, whatever its base, e.g.
+ * the accesses shifted by a constant offset or in the last dimension of a buffer.
  *
  * \example
  * Before:
@@ -122,21 +138,36 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
    * stmt if successful.
    */
   std::pair<bool, Stmt> Run(Stmt stmt, PrimExpr condition) {
-    // Check that the condition provided is of the form a < b, for now.
-    if (!condition->IsInstance<LTNode>()) {
-      return {false, stmt};
-    }
-
-    LT lt = Downcast<LT>(condition);
-
     // Check the form of the vectorized condition, we're expecting
-    // Ramp(...) < Broadcast(...)
-    if (!lt->a->IsInstance<RampNode>() || !lt->b->IsInstance<BroadcastNode>()) {
+    // Ramp(...) < Broadcast(...), or Ramp(...) <= Broadcast(...) and their mirrors.
+    PrimExpr ramp, broadcast;
+    bool inclusive = false;
+    if (const auto* op = condition.as<LTNode>()) {
+      ramp = op->a;
+      broadcast = op->b;
+    } else if (const auto* op = condition.as<LENode>()) {
+      ramp = op->a;
+      broadcast = op->b;
+      inclusive = true;
+    } else if (const auto* op = condition.as<GTNode>()) {
+      ramp = op->b;
+      broadcast = op->a;
+    } else if (const auto* op = condition.as<GENode>()) {
+      ramp = op->b;
+      broadcast = op->a;
+      inclusive = true;
+    }
+    const auto* ramp_node = ramp.as<RampNode>();
+    const auto* broadcast_node = broadcast.as<BroadcastNode>();
+    // Only a unit stride keeps a prefix of the lanes active.
+    if (ramp_node == nullptr || broadcast_node == nullptr || !is_one(ramp_node->stride)) {
       return {false, stmt};
     }
 
-    base_ = Downcast<Ramp>(lt->a)->base;
-    limit_ = Downcast<Broadcast>(lt->b)->value;
+    base_ = ramp_node->base;
+    limit_ = inclusive ? broadcast_node->value + 1 : broadcast_node->value;
+    lanes_ = ramp_node->dtype.get_lanes_or_vscale_factor();
+    is_scalable_ = ramp_node->dtype.is_scalable_vector();
 
     // Now we can try to predicate
     Stmt predicated_stmt = StmtExprMutator::operator()(std::move(stmt));
@@ -161,21 +192,24 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
   AccessNode TryPredicateBufferAccess(AccessNode node) {
     num_accesses_analyzed_ += 1;
 
-    // Do not try to predicate non-vectorized accesses
+    // Do not try to predicate non-vectorized accesses. Only the last index can be
+    // a vector, and it must be contiguous for the access to be masked.
     ffi::Array<PrimExpr> indices = node->indices;
-    if (!indices.size() || !indices[0]->IsInstance<RampNode>()) {
+    if (!indices.size() || node->predicate.defined()) {
+      return node;
+    }
+    const auto* ramp = indices.back().as<RampNode>();
+    if (ramp == nullptr || !is_one(ramp->stride)) {
       return node;
     }
-    Ramp ramp = Downcast<Ramp>(node->indices[0]);
 
-    // The vectorized access pattern must match the base of the predicate
-    if (!ffi::StructuralEqual()(ramp->base, base_)) {
+    // The lanes of the access must be the lanes of the predicate
+    if (ramp->dtype.get_lanes_or_vscale_factor() != lanes_ ||
+        ramp->dtype.is_scalable_vector() != is_scalable_) {
       return node;
     }
 
-    DataType buf_predicate_dtype =
-        DataType(DataType::kUInt, 1, ramp->dtype.get_lanes_or_vscale_factor(),
-                 ramp->dtype.is_scalable_vector());
+    DataType buf_predicate_dtype = DataType(DataType::kUInt, 1, lanes_, is_scalable_);
     Call lane_mask = Call(buf_predicate_dtype, builtin::get_active_lane_mask(), {base_, limit_});
 
     num_accesses_rewritten_ += 1;
@@ -189,6 +223,10 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
   /*! \brief The limit of the predicate. The expr specifies the upper bound of the base's
    * evaluated value. */
   PrimExpr limit_;
+  /*! \brief The number of lanes of the predicate, or its vscale factor. */
+  int lanes_ = 0;
+  /*! \brief Whether the predicate is a scalable vector. */
+  bool is_scalable_ = false;
   /*! \brief The number of buffer accesses in the stmt we will analyze. */
   size_t num_accesses_analyzed_ = 0;
   /*! \brief The number of buffer accesses rewritten with predicates. */
@@ -990,10 +1028,16 @@ class LoopVectorizer : public StmtMutator {
             << "Failed to vectorize loop with extent " << op->extent << " for target " << target_;
       }
       TVM_FFI_ICHECK(is_zero(op->min));
+      if (auto reduction = MatchReduction(op)) {
+        return reduction->WithValue(reduction->Combine(reduction->target, reduction->vector));
+      }
       return Vectorizer(op->loop_var, op->extent, target_)(op->body);
-    } else {
-      return StmtMutator::VisitStmt_(op);
+    } else if (op->kind == ForKind::kSerial) {
+      if (auto stmt = TryHoistAccumulator(op)) {
+        return stmt.value();
+      }
     }
+    return StmtMutator::VisitStmt_(op);
   }
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
@@ -1008,6 +1052,156 @@ class LoopVectorizer : public StmtMutator {
   }
 
  private:
+  /*!
+   * \brief A vectorized loop that accumulates into a loop-invariant element,
+   *  `buf[idx] = buf[idx] op value` with op one of add, mul, min and max.
+   */
+  struct Reduction {
+    /*! \brief The original store of the loop body. */
+    BufferStore store;
+    /*! \brief The loaded element that is accumulated into. */
+    PrimExpr target;
+    /*! \brief The vectorized operand of the reduction. */
+    PrimExpr vector;
+    /*! \brief The op that reduces the lanes of a vector into a scalar. */
+    Op reduce_op;
+    /*! \brief The identity of the reduction. */
+    PrimExpr identity;
+    /*! \brief Combine two values of the reduction. */
+    std::function<PrimExpr(PrimExpr, PrimExpr)> combine;
+
+    /*! \brief Combine a value with an operand, reducing the lanes of a vector operand first. */
+    PrimExpr Combine(PrimExpr a, PrimExpr b) const {
+      if (b.dtype().is_scalable_or_fixed_length_vector()) {
+        b = Call(b.dtype().element_of(), reduce_op, {b});
+      }
+      return combine(a, b);
+    }
+
+    /*! \brief The original store with a new value. */
+    Stmt WithValue(PrimExpr value) const {
+      BufferStore result = store;
+      result.CopyOnWrite()->value = value;
+      return result;
+    }
+  };
+
+  /*!
+   * \brief Match a vectorized loop whose body is a reduction into a loop-invariant element,
+   *  which is then computed as one horizontal reduction of the vectorized operand instead of
+   *  a store of all lanes to the same address.
+   */
+  std::optional<Reduction> MatchReduction(const ForNode* op) {
+    // The horizontal reductions are only lowered by the LLVM codegen.
+    if (!target_.defined() || target_->kind->name != "llvm" || !op->extent.as<IntImmNode>()) {
+      return std::nullopt;
+    }
+    const auto* store = op->body.as<BufferStoreNode>();
+    if (store == nullptr || store->predicate.defined() || !store->value.dtype().is_scalar()) {
+      return std::nullopt;
+    }
+    auto uses_loop_var = [&](const VarNode* var) { return var == op->loop_var.get(); };
+    for (const PrimExpr& index : store->indices) {
+      if (UsesVar(index, uses_loop_var)) return std::nullopt;
+    }
+
+    Reduction reduction;
+    reduction.store = ffi::GetRef<BufferStore>(store);
+    DataType dtype = store->value.dtype();
+    PrimExpr a, b;
+    if (const auto* add = store->value.as<AddNode>()) {
+      a = add->a;
+      b = add->b;
+      reduction.reduce_op = builtin::vector_reduce_add();
+      reduction.identity = make_zero(dtype);
+      reduction.combine = [](PrimExpr x, PrimExpr y) { return x + y; };
+    } else if (const auto* mul = store->value.as<MulNode>()) {
+      a = mul->a;
+      b = mul->b;
+      reduction.reduce_op = builtin::vector_reduce_mul();
+      reduction.identity = make_const(dtype, 1);
+      reduction.combine = [](PrimExpr x, PrimExpr y) { return x * y; };
+    } else if (const auto* min = store->value.as<MinNode>()) {
+      a = min->a;
+      b = min->b;
+      reduction.reduce_op = builtin::vector_reduce_min();
+      reduction.identity = max_value(dtype);
+      reduction.combine = [](PrimExpr x, PrimExpr y) { return Min(x, y); };
+    } else if (const auto* max = store->value.as<MaxNode>()) {
+      a = max->a;
+      b = max->b;
+      reduction.reduce_op = builtin::vector_reduce_max();
+      reduction.identity = min_value(dtype);
+      reduction.combine = [](PrimExpr x, PrimExpr y) { return Max(x, y); };
+    } else {
+      return std::nullopt;
+    }
+
+    auto is_target = [&](const PrimExpr& e) {
+      const auto* load = e.as<BufferLoadNode>();
+      return load && load->buffer.same_as(store->buffer) && !load->predicate.defined() &&
+             load->indices.size() == store->indices.size() &&
+             std::equal(load->indices.begin(), load->indices.end(), store->indices.begin(),
+                        ExprDeepEqual());
+    };
+    if (!is_target(a)) std::swap(a, b);
+    if (!is_target(a) || !UsesVar(b, uses_loop_var)) {
+      return std::nullopt;
+    }
+    bool reads_target = false;
+    PostOrderVisit(b, [&](const ObjectRef& node) {
+      if (const auto* load = node.as<BufferLoadNode>()) {
+        reads_target |= load->buffer->data.same_as(store->buffer->data);
+      }
+    });
+    if (reads_target) {
+      return std::nullopt;
+    }
+
+    Stmt vectorized = Vectorizer(op->loop_var, op->extent, target_)(Evaluate(b));
+    const auto* evaluate = vectorized.as<EvaluateNode>();
+    if (evaluate == nullptr || !evaluate->value.dtype().is_fixed_length_vector()) {
+      return std::nullopt;
+    }
+    reduction.target = a;
+    reduction.vector = evaluate->value;
+    return reduction;
+  }
+
+  /*!
+   * \brief Accumulate the reduction of a vectorized loop nested in a serial loop in a vector,
+   *  so that the lanes are only reduced once after the serial loop.
+   */
+  std::optional<Stmt> TryHoistAccumulator(const ForNode* op) {
+    const auto* inner = op->body.as<ForNode>();
+    if (inner == nullptr || inner->kind != ForKind::kVectorized || !is_zero(inner->min)) {
+      return std::nullopt;
+    }
+    auto reduction = MatchReduction(inner);
+    if (!reduction) {
+      return std::nullopt;
+    }
+    auto uses_outer_var = [&](const VarNode* var) { return var == op->loop_var.get(); };
+    for (const PrimExpr& index : reduction->store->indices) {
+      if (UsesVar(index, uses_outer_var)) return std::nullopt;
+    }
+
+    DataType vec_dtype = reduction->vector.dtype();
+    int lanes = vec_dtype.lanes();
+    Buffer acc = decl_buffer({lanes}, vec_dtype.element_of(),
+                             reduction->store->buffer->name + "_acc", "local");
+    ffi::Array<PrimExpr> ramp = {Ramp(0, 1, lanes)};
+    Stmt init = BufferStore(acc, Broadcast(reduction->identity, lanes), ramp);
+    Stmt update = BufferStore(acc, reduction->combine(BufferLoad(acc, ramp), reduction->vector),
+                              ramp);
+    For loop = ffi::GetRef<For>(op);
+    loop.CopyOnWrite()->body = update;
+    Stmt finalize =
+        reduction->WithValue(reduction->Combine(reduction->target, BufferLoad(acc, ramp)));
+    Stmt body = SeqStmt({init, loop, finalize});
+    return Allocate(acc->data, acc->dtype, acc->shape, const_true(), DeclBuffer(acc, body));
+  }
+
   Target target_ = Target::Current();
 };
 
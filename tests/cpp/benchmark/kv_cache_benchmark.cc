@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file kv_cache_benchmark.cc
+ * \brief Benchmarks of the preparation of the forward steps of the paged KV cache.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/ffi/container/array.h>
+#include <tvm/ffi/function.h>
+#include <tvm/runtime/tensor.h>
+
+#include <numeric>
+#include <vector>
+
+#include "../../../src/runtime/vm/kv_state.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+constexpr int64_t kNumLayers = 2;
+constexpr int64_t kPageSize = 16;
+constexpr int64_t kMaxSequenceLength = 512;
+constexpr int64_t kMaxAppendLength = 128;
+
+/*!
+ * \brief Create a paged KV cache on CPU for `num_sequences` sequences of at most
+ * kMaxSequenceLength tokens, each appended at most kMaxAppendLength tokens by a step. The
+ * attention functions are never called by BeginForward, and are placeholders.
+ */
+AttentionKVCache CreateKVCache(int64_t num_sequences) {
+  ffi::Function nop = ffi::Function::FromPacked([](ffi::PackedArgs args, ffi::Any* rv) {});
+  ffi::Array<ffi::Any> tir_func{ffi::String("tir"), nop};
+  ffi::Array<ffi::Any> no_func;
+  ffi::Function create =
+      ffi::Function::GetGlobalRequired("vm.builtin.paged_attention_kv_cache_create");
+  ffi::Shape cache_config{num_sequences, num_sequences * kMaxSequenceLength,
+                          num_sequences * kMaxAppendLength, kPageSize, 0};
+  Tensor init = Tensor::Empty({1}, DataType::Float(16), Device{kDLCPU, 0});
+  return create(cache_config, ffi::Shape{0, kNumLayers}, /*num_qo_heads=*/int64_t(8),
+                /*num_kv_heads=*/int64_t(2), /*qk_head_dim=*/int64_t(64),
+                /*v_head_dim=*/int64_t(64), ffi::Shape(std::vector<int64_t>(kNumLayers, 0)),
+                /*enable_kv_transfer=*/false, /*rope_mode=*/0, /*rotary_scale=*/1.0,
+                /*rotary_theta=*/10000.0, /*rope_ext_factors=*/nullptr, init,
+                /*f_transpose_append_mha=*/nullptr, /*f_transpose_append_mla=*/nullptr,
+                tir_func, tir_func, tir_func, no_func, no_func, no_func, no_func, no_func,
+                ffi::Array<ffi::Function>{nop}, nop, nop, nop, nop)
+      .cast<AttentionKVCache>();
+}
+
+void AddSequences(const AttentionKVCache& kv_cache, int64_t num_sequences) {
+  for (int64_t seq_id = 0; seq_id < num_sequences; ++seq_id) {
+    kv_cache->AddSequence(seq_id);
+  }
+}
+
+/*! \brief BeginForward and EndForward of a step that appends the same length to each sequence. */
+void BM_KVCacheBeginForward(benchmark::State& state) {
+  int64_t batch_size = state.range(0);
+  int64_t append_length = state.range(1);
+  AttentionKVCache kv_cache = CreateKVCache(batch_size);
+  AddSequences(kv_cache, batch_size);
+  std::vector<int64_t> seq_ids(batch_size);
+  std::iota(seq_ids.begin(), seq_ids.end(), 0);
+  IntTuple seq_ids_tuple(seq_ids);
+  IntTuple append_lengths(std::vector<int64_t>(batch_size, append_length));
+  int64_t sequence_length = 0;
+  for (auto _ : state) {
+    if (sequence_length + append_length > kMaxSequenceLength) {
+      state.PauseTiming();
+      kv_cache->Clear();
+      AddSequences(kv_cache, batch_size);
+      sequence_length = 0;
+      state.ResumeTiming();
+    }
+    kv_cache->BeginForward(seq_ids_tuple, append_lengths);
+    kv_cache->EndForward();
+    sequence_length += append_length;
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size * append_length);
+}
+// The decode steps of a batch, and the prefill steps of chunks of 128 tokens.
+BENCHMARK(BM_KVCacheBeginForward)->ArgsProduct({{1, 8, 64, 256}, {1, kMaxAppendLength}});
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
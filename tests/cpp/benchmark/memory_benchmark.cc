@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file memory_benchmark.cc
+ * \brief Benchmarks of the allocators of the memory manager.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/memory/memory_manager.h>
+
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace memory {
+namespace {
+
+constexpr size_t kAlignment = 64;
+
+void BM_PooledAllocatorAllocFree(benchmark::State& state) {
+  Device dev{kDLCPU, 0};
+  size_t nbytes = static_cast<size_t>(state.range(0));
+  Allocator* allocator = MemoryManager::GetOrCreateAllocator(dev, kPooled);
+  // Fill the pool, so that the loop measures the reuse of the free pages.
+  allocator->Free(allocator->Alloc(dev, nbytes, kAlignment, DataType::Float(32)));
+  for (auto _ : state) {
+    Buffer buffer = allocator->Alloc(dev, nbytes, kAlignment, DataType::Float(32));
+    benchmark::DoNotOptimize(buffer.data);
+    allocator->Free(buffer);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PooledAllocatorAllocFree)->RangeMultiplier(64)->Range(64, 64 << 20);
+
+void BM_PooledAllocatorAllocFreeBatch(benchmark::State& state) {
+  Device dev{kDLCPU, 0};
+  int64_t num_buffers = state.range(0);
+  Allocator* allocator = MemoryManager::GetOrCreateAllocator(dev, kPooled);
+  std::vector<Buffer> buffers;
+  buffers.reserve(num_buffers);
+  for (auto _ : state) {
+    // The buffers of different sizes are alive at once, as the activations of a model are.
+    for (int64_t i = 0; i < num_buffers; ++i) {
+      size_t nbytes = static_cast<size_t>(4096 * (i % 16 + 1));
+      buffers.push_back(allocator->Alloc(dev, nbytes, kAlignment, DataType::Float(32)));
+    }
+    for (const Buffer& buffer : buffers) {
+      allocator->Free(buffer);
+    }
+    buffers.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * num_buffers);
+}
+BENCHMARK(BM_PooledAllocatorAllocFreeBatch)->Arg(16)->Arg(256);
+
+}  // namespace
+}  // namespace memory
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tensor_cache_benchmark.cc
+ * \brief Benchmarks of the loading of the weights of a model from the tensor cache.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/ffi/function.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+/*!
+ * \brief Write a tensor cache of `num_params` float32 parameters of `param_nbytes` bytes each, in
+ * one shard of the raw format.
+ * \return The directory of the tensor cache.
+ */
+std::string WriteTensorCache(int64_t num_params, int64_t param_nbytes) {
+  std::filesystem::path dir = std::filesystem::temp_directory_path() /
+                              ("tvm_tensor_cache_benchmark_" + std::to_string(num_params) + "_" +
+                               std::to_string(param_nbytes));
+  std::filesystem::create_directories(dir);
+  std::ostringstream records;
+  for (int64_t i = 0; i < num_params; ++i) {
+    records << (i == 0 ? "" : ", ") << "{\"name\": \"param_" << i << "\", \"shape\": ["
+            << param_nbytes / 4 << "], \"dtype\": \"float32\", \"format\": \"raw\", "
+            << "\"nbytes\": " << param_nbytes << ", \"byteOffset\": " << i * param_nbytes << "}";
+  }
+  {
+    std::ofstream json(dir / "tensor-cache.json");
+    json << "{\"metadata\": {}, \"records\": [{\"dataPath\": \"params_shard_0.bin\", "
+         << "\"format\": \"raw-shard\", \"nbytes\": " << num_params * param_nbytes
+         << ", \"records\": [" << records.str() << "]}]}";
+  }
+  {
+    std::ofstream shard(dir / "params_shard_0.bin", std::ios::binary);
+    std::vector<char> data(param_nbytes, 1);
+    for (int64_t i = 0; i < num_params; ++i) {
+      shard.write(data.data(), param_nbytes);
+    }
+  }
+  return dir.string();
+}
+
+void BM_TensorCacheLoad(benchmark::State& state) {
+  int64_t num_params = state.range(0);
+  int64_t param_nbytes = state.range(1);
+  std::string path = WriteTensorCache(num_params, param_nbytes);
+  ffi::Function load = ffi::Function::GetGlobalRequired("vm.builtin.tensor_cache.load");
+  ffi::Function clear = ffi::Function::GetGlobalRequired("vm.builtin.tensor_cache.clear");
+  // Load the weights from the file in each iteration, instead of sharing the ones loaded before.
+  ffi::Function::GetGlobalRequired("vm.builtin.weight_store.set_enabled")(false);
+  for (auto _ : state) {
+    load(path, static_cast<int>(kDLCPU), 0);
+    state.PauseTiming();
+    clear();
+    state.ResumeTiming();
+  }
+  ffi::Function::GetGlobalRequired("vm.builtin.weight_store.set_enabled")(true);
+  state.SetBytesProcessed(state.iterations() * num_params * param_nbytes);
+  std::filesystem::remove_all(path);
+}
+BENCHMARK(BM_TensorCacheLoad)->Args({256, 64 << 10})->Args({16, 16 << 20})->UseRealTime();
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
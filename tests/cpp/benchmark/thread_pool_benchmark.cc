@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file thread_pool_benchmark.cc
+ * \brief Benchmarks of the launch of the parallel tasks on the thread pool.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/threading_backend.h>
+
+#include <atomic>
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+FTVMParallelLambda count_task = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+  reinterpret_cast<std::atomic<int>*>(cdata)->fetch_add(1, std::memory_order_relaxed);
+  return 0;
+};
+
+void BM_ThreadPoolLaunch(benchmark::State& state) {
+  int num_task = static_cast<int>(state.range(0));
+  std::atomic<int> counter(0);
+  // Start the workers outside of the loop.
+  TVMBackendParallelLaunch(count_task, &counter, num_task);
+  for (auto _ : state) {
+    TVMBackendParallelLaunch(count_task, &counter, num_task);
+  }
+  benchmark::DoNotOptimize(counter.load());
+  state.SetItemsProcessed(state.iterations());
+}
+// 0 launches one task on each worker of the pool.
+BENCHMARK(BM_ThreadPoolLaunch)->Arg(0)->Arg(1)->Arg(4)->UseRealTime();
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
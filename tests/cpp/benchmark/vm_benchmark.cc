@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file vm_benchmark.cc
+ * \brief Benchmarks of the dispatch of the instructions of the relax VM.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/ffi/function.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/exec_builder.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def_packed("testing.benchmark.identity",
+                               [](ffi::PackedArgs args, ffi::Any* rv) { *rv = args[0]; });
+}
+
+/*!
+ * \brief Create a VM whose function "main" calls a packed function `num_calls` times, each on
+ * the result of the previous call, so that each call is one `RunInstrCall`.
+ */
+ffi::Module CreateCallChainVM(int num_calls) {
+  relax::ExecBuilder builder = relax::ExecBuilder::Create();
+  builder->EmitFunction("main", 1, std::nullopt);
+  for (int i = 0; i < num_calls; ++i) {
+    builder->EmitCall("testing.benchmark.identity", {Instruction::Arg::Register(i)}, i + 1);
+  }
+  builder->EmitRet(Instruction::Arg::Register(num_calls));
+  builder->EndFunction("main");
+  ObjectPtr<VirtualMachine> vm = VirtualMachine::Create();
+  vm->LoadExecutable(builder->Get());
+  vm->Init({Device{kDLCPU, 0}}, {memory::AllocatorType::kPooled});
+  return ffi::Module(vm);
+}
+
+void BM_VMRunInstrCall(benchmark::State& state) {
+  int num_calls = static_cast<int>(state.range(0));
+  ffi::Module vm = CreateCallChainVM(num_calls);
+  ffi::Function main = vm->GetFunction("main").value();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(main(int64_t(1)));
+  }
+  state.SetItemsProcessed(state.iterations() * num_calls);
+}
+BENCHMARK(BM_VMRunInstrCall)->Arg(1)->Arg(64)->Arg(1024);
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
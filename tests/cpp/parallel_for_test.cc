@@ -21,6 +21,7 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -90,20 +91,39 @@ TEST(ParallelFor, NestedWithNormalForLoop) {
 }
 
 TEST(ParallelFor, NestedWithParallelFor) {
-  // Currently do not support using nested parallel_for
+  using tvm::support::parallel_for;
+
+  std::vector<std::vector<int>> a(100, std::vector<int>(100, 0));
+  parallel_for(0, 100, [&a](int i) {
+    parallel_for(0, 100, [&a, i](int j) { a[i][j] = i * j; });
+  });
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      TVM_FFI_ICHECK_EQ(a[i][j], i * j);
+    }
+  }
+}
+
+TEST(ParallelFor, NestedException) {
   using tvm::support::parallel_for;
 
   bool exception = false;
   try {
-    parallel_for(0, 100, [](int i) {
-      parallel_for(0, 100, [](int j) {
-        // Blank loop
+    parallel_for(0, 10, [](int i) {
+      parallel_for(0, 10, [i](int j) {
+        if (i == 3 && j == 7) {
+          TVM_FFI_THROW(InternalError) << "error";
+        }
       });
     });
   } catch (const std::exception& e) {
     exception = true;
   }
   TVM_FFI_ICHECK(exception);
+  // The shared pool is still usable after the error.
+  std::atomic<int> count{0};
+  parallel_for(0, 100, [&count](int i) { count++; });
+  TVM_FFI_ICHECK_EQ(count.load(), 100);
 }
 
 TEST(ParallelFor, Exception) {
@@ -22,8 +22,10 @@
 #include <tvm/runtime/memory/memory_manager.h>
 
 #include <exception>
+#include <thread>
 
 #include "../../../../src/runtime/memory/pooled_allocator.h"
+#include "../../../../src/runtime/memory/pooled_best_fit_allocator.h"
 
 namespace tvm {
 namespace runtime {
@@ -176,12 +178,95 @@ TEST_F(TvmVMMemoryManagerTest, PooledAllocWithShape) {
     (void)texture;
     FAIL();
   } catch (std::exception& e) {
-    std::string pattern = "This alloc should be implemented";
+    std::string pattern =
+        "Device does not support allocate data space with specified memory scope: global.texture";
     std::string what = e.what();
     EXPECT_NE(what.find(pattern), std::string::npos) << what;
   }
 }
 
+TEST_F(TvmVMMemoryManagerTest, PooledThreadCache) {
+  Device dev = {kDLCPU, 0};
+  PooledAllocator allocator(PooledAllocator::kDefaultPageSize, /*enable_thread_cache=*/true);
+  auto buff = allocator.Alloc(dev, 64, 32, DataType::Float(32));
+  allocator.Free(buff);
+  // Same thread: served from the thread cache.
+  auto buff2 = allocator.Alloc(dev, 64, 32, DataType::Float(32));
+  EXPECT_EQ(buff2.data, buff.data);
+  AllocatorStats stats = allocator.GetStats();
+  EXPECT_EQ(stats.thread_cache_hits, 1);
+  EXPECT_EQ(stats.device_allocs, 1);
+  allocator.Free(buff2);
+  // Another thread takes the buffer cached by this thread instead of allocating.
+  Buffer other;
+  std::thread worker([&]() { other = allocator.Alloc(dev, 64, 32, DataType::Float(32)); });
+  worker.join();
+  EXPECT_EQ(other.data, buff.data);
+  stats = allocator.GetStats();
+  EXPECT_EQ(stats.thread_cache_steals, 1);
+  EXPECT_EQ(stats.device_allocs, 1);
+  EXPECT_EQ(allocator.UsedMemory(), PooledAllocator::kDefaultPageSize);
+  allocator.Free(other);
+}
+
+TEST_F(TvmVMMemoryManagerTest, PooledBestFitSizeClass) {
+  Device dev = {kDLCPU, 0};
+  Allocator* allocator = MemoryManagerWrapper::GetOrCreateAllocator(dev, kPooledBestFit);
+  EXPECT_EQ(allocator->UsedMemory(), 0);
+  // 5000 bytes rounds to the 8192 byte size class.
+  auto buff = allocator->Alloc(dev, 5000, 32, DataType::Float(32));
+  EXPECT_EQ(buff.size, 8192);
+  EXPECT_EQ(allocator->UsedMemory(), 8192);
+  allocator->Free(buff);
+  // A different size within the same class reuses the cached buffer.
+  auto buff2 = allocator->Alloc(dev, 7000, 32, DataType::Float(32));
+  EXPECT_EQ(buff2.data, buff.data);
+  EXPECT_EQ(allocator->UsedMemory(), 8192);
+  allocator->Free(buff2);
+  allocator->Clear();
+  EXPECT_EQ(allocator->UsedMemory(), 0);
+}
+
+TEST_F(TvmVMMemoryManagerTest, PooledBestFitSplitAndCoalesce) {
+  Device dev = {kDLCPU, 0};
+  PooledBestFitAllocator allocator;
+  size_t large = 8 << 20;
+  auto buff = allocator.Alloc(dev, large, 64, DataType::Float(32));
+  EXPECT_EQ(allocator.UsedMemory(), large);
+  allocator.Free(buff);
+  // Two smaller requests are carved out of the cached block.
+  auto a = allocator.Alloc(dev, 3 << 20, 64, DataType::Float(32));
+  auto b = allocator.Alloc(dev, 2 << 20, 64, DataType::Float(32));
+  EXPECT_EQ(allocator.UsedMemory(), large);
+  EXPECT_EQ(a.data, buff.data);
+  EXPECT_EQ(static_cast<char*>(b.data), static_cast<char*>(a.data) + (3 << 20));
+  allocator.Free(a);
+  allocator.Free(b);
+  // After coalescing the whole block is available again.
+  auto c = allocator.Alloc(dev, large, 64, DataType::Float(32));
+  EXPECT_EQ(c.data, buff.data);
+  EXPECT_EQ(allocator.UsedMemory(), large);
+  allocator.Free(c);
+  allocator.Clear();
+  EXPECT_EQ(allocator.UsedMemory(), 0);
+}
+
+TEST_F(TvmVMMemoryManagerTest, PooledBestFitHighWaterMark) {
+  Device dev = {kDLCPU, 0};
+  size_t large = 4 << 20;
+  PooledBestFitAllocator allocator(PooledBestFitAllocator::kDefaultPageSize, 6 << 20);
+  auto a = allocator.Alloc(dev, large, 64, DataType::Float(32));
+  auto b = allocator.Alloc(dev, large, 64, DataType::Float(32));
+  EXPECT_EQ(allocator.UsedMemory(), 2 * large);
+  // Freeing above the high-water mark releases cached blocks back to the device.
+  allocator.Free(a);
+  EXPECT_EQ(allocator.UsedMemory(), large);
+  allocator.Free(b);
+  EXPECT_EQ(allocator.UsedMemory(), large);
+  allocator.SetHighWaterMark(1 << 20);
+  EXPECT_EQ(allocator.UsedMemory(), 0);
+}
+
 }  // namespace memory
 }  // namespace runtime
 }  // namespace tvm
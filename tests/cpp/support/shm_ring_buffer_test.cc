@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../src/support/shm_ring_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace tvm {
+namespace support {
+namespace {
+
+#ifdef __linux__
+
+TEST(ShmRingBuffer, ReadWriteWrapAround) {
+  std::unique_ptr<ShmRingBuffer> writer = ShmRingBuffer::Create(64, nullptr);
+  ASSERT_NE(writer, nullptr);
+  std::unique_ptr<ShmRingBuffer> reader = ShmRingBuffer::Open(writer->name(), nullptr);
+
+  std::vector<int> data(10000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<int>(i);
+  }
+  std::thread producer([&]() {
+    // Write in chunks that do not divide the capacity, so that writes wrap around.
+    for (size_t i = 0; i < data.size(); i += 7) {
+      size_t n = std::min<size_t>(7, data.size() - i);
+      writer->WriteArray(data.data() + i, n);
+    }
+  });
+  std::vector<int> output(data.size());
+  ASSERT_TRUE(reader->ReadArray(output.data(), output.size()));
+  producer.join();
+  for (size_t i = 0; i < output.size(); ++i) {
+    ASSERT_EQ(output[i], data[i]);
+  }
+}
+
+TEST(ShmRingBuffer, ReadAfterClose) {
+  std::unique_ptr<ShmRingBuffer> writer = ShmRingBuffer::Create(64, nullptr);
+  ASSERT_NE(writer, nullptr);
+  std::unique_ptr<ShmRingBuffer> reader = ShmRingBuffer::Open(writer->name(), nullptr);
+
+  int value = 42;
+  writer->Write(value);
+  writer->Close();
+  int output = 0;
+  // Data written before closing is still readable, after which the stream reports EOF.
+  ASSERT_TRUE(reader->Read(&output));
+  ASSERT_EQ(output, 42);
+  ASSERT_EQ(reader->Read(&output, sizeof(output)), 0);
+}
+
+#endif  // __linux__
+
+}  // namespace
+}  // namespace support
+}  // namespace tvm
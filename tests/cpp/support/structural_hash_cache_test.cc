@@ -0,0 +1,61 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../src/support/structural_hash_cache.h"
+
+#include <gtest/gtest.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+
+namespace tvm {
+namespace support {
+namespace {
+
+TEST(StructuralHashCache, MatchesStructuralHash) {
+  tir::Var x("x");
+  PrimExpr expr = x * 2 + 1;
+  StructuralHashCache cache;
+  EXPECT_EQ(cache.Hash(expr), ffi::StructuralHash::Hash(expr));
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.Hash(expr), ffi::StructuralHash::Hash(expr));
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(StructuralHashCache, Equal) {
+  tir::Var x("x");
+  StructuralHashCache cache;
+  EXPECT_TRUE(cache.Equal(x * 2 + 1, x * 2 + 1));
+  EXPECT_FALSE(cache.Equal(x * 2 + 1, x * 2 + 2));
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(StructuralHashCache, ClearedWhenFull) {
+  tir::Var x("x");
+  StructuralHashCache cache(/*map_free_vars=*/false, /*skip_tensor_content=*/false,
+                            /*max_size=*/2);
+  cache.Hash(x + 1);
+  cache.Hash(x + 2);
+  cache.Hash(x + 3);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+}  // namespace
+}  // namespace support
+}  // namespace tvm
@@ -18,6 +18,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <tvm/ffi/function.h>
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/threading_backend.h>
@@ -123,6 +124,30 @@ TEST(ThreadingBackend, TVMBackendParallelLaunch) {
   EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
 }
 
+TEST(ThreadingBackend, TVMBackendParallelLaunchChunked) {
+  for (int num_chunk : {0, 1, 7, 64}) {
+    std::atomic<size_t> acc(0);
+    EXPECT_EQ(TVMBackendParallelLaunchChunked(atomic_add_task_id, &acc, num_chunk), 0);
+    EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+  }
+}
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchChunkedError) {
+  FTVMParallelLambda fail_last_chunk = [](int task_id, TVMParallelGroupEnv* penv,
+                                          void* cdata) -> int {
+    if (task_id == penv->num_task - 1) {
+      TVMFFIErrorSetRaisedFromCStr("RuntimeError", "chunk failed");
+      return -1;
+    }
+    return 0;
+  };
+  EXPECT_NE(TVMBackendParallelLaunchChunked(fail_last_chunk, nullptr, 16), 0);
+  // The pool is still usable after a failed launch.
+  std::atomic<size_t> acc(0);
+  EXPECT_EQ(TVMBackendParallelLaunchChunked(atomic_add_task_id, &acc, 16), 0);
+  EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+}
+
 TEST(ThreadingBackend, TVMBackendParallelLaunchMultipleThreads) {
   // TODO(tulloch) use parameterised tests when available.
   size_t num_jobs_per_thread = 3;
@@ -192,3 +217,43 @@ TEST(ThreadingBackend, TVMBackendParallelForWithThreadingBackend) {
     EXPECT_EQ(vec[i], i);
   }
 }
+
+TEST(ThreadingBackend, NumaTopology) {
+  using namespace tvm::runtime::threading;
+  int num_nodes = NumaNodeCount();
+  EXPECT_GE(num_nodes, 1);
+  int node = CurrentNumaNode();
+  EXPECT_GE(node, 0);
+  EXPECT_LT(node, num_nodes);
+  for (unsigned int cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+    EXPECT_GE(NumaNodeOfCpu(cpu), 0);
+    EXPECT_LT(NumaNodeOfCpu(cpu), num_nodes);
+  }
+  // Placement is a hint, the data must be preserved whether or not it is applied.
+  std::vector<char> buffer(1 << 20, 1);
+  BindMemoryToNumaNode(buffer.data(), buffer.size(), node);
+  InterleaveMemoryAcrossNumaNodes(buffer.data(), buffer.size());
+  for (char c : buffer) {
+    ASSERT_EQ(c, 1);
+  }
+}
+
+TEST(ThreadingBackend, ThreadPoolTrace) {
+  auto enable = tvm::ffi::Function::GetGlobalRequired("runtime.threadpool_trace_enable");
+  auto clear = tvm::ffi::Function::GetGlobalRequired("runtime.threadpool_trace_clear");
+  auto dump = tvm::ffi::Function::GetGlobalRequired("runtime.threadpool_trace_dump");
+  clear();
+  enable(true);
+  std::atomic<size_t> acc(0);
+  TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0);
+  enable(false);
+  std::string trace = dump().cast<tvm::ffi::String>();
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  // A single-threaded launch bypasses the pool.
+  if (tvm::runtime::threading::MaxConcurrency() > 1) {
+    EXPECT_NE(trace.find("\"name\": \"task\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\": \"launch\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\": \"wait\""), std::string::npos);
+  }
+  clear();
+}
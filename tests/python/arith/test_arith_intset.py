@@ -286,6 +286,31 @@ def test_region_lower_bound_multiple_variables():
     check_region_bound({i: (0, 2), j: (0, 32), k: (0, 32)}, var_dom, mode="lowerbound")
 
 
+def test_region_upper_bound_presburger():
+    i = tvm.tir.Var("i", "int32")
+    j = tvm.tir.Var("j", "int32")
+    var_dom = {
+        i: tvm.ir.Range(begin=0, end=8),
+        j: tvm.ir.Range(begin=0, end=8),
+    }
+    region = [tvm.ir.Range.from_min_extent(i + j, 1), tvm.ir.Range.from_min_extent(i * 2, 2)]
+    predicate = i + j < 4
+    default = tvm.arith.estimate_region_upper_bound(region, var_dom, predicate)
+    result = tvm.arith.estimate_region_upper_bound(
+        region, var_dom, predicate, tvm.arith.ProofStrength.PRESBURGER
+    )
+    analyzer = Analyzer()
+    if tvm.support.libinfo().get("USE_MLIR", "OFF") in ["OFF", "NOT-FOUND", "0", ""]:
+        for intset, expect in zip(result, default):
+            assert analyzer.can_prove_equal(intset.min_value - expect.min_value, 0)
+            assert analyzer.can_prove_equal(intset.max_value - expect.max_value, 0)
+        return
+    # The predicate couples i and j, which the interval analysis cannot account for
+    for intset, (expect_min, expect_max) in zip(result, [(0, 3), (0, 7)]):
+        assert analyzer.can_prove_equal(intset.min_value - expect_min, 0)
+        assert analyzer.can_prove_equal(intset.max_value - expect_max, 0)
+
+
 def test_region_lower_bound_negative_scale():
     i = tvm.tir.Var("i", "int32")
     j = tvm.tir.Var("j", "int32")
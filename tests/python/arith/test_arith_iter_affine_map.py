@@ -1369,5 +1369,39 @@ def test_detect_iter_map_with_bufferload_recursion():
     assert len(result.indices) == 0
 
 
+def test_update_iter_map_for_split():
+    i = tvm.tir.Var("i", "int32")
+    io = tvm.tir.Var("io", "int32")
+    ii = tvm.tir.Var("ii", "int32")
+    res = tvm.arith.detect_iter_map([floordiv(i, 4), floormod(i, 4)], var_dom([(i, 32)]))
+    res = tvm.arith.update_iter_map_for_split(res, i, [io, ii], [8, 4])
+    assert len(res.errors) == 0
+    tvm.ir.assert_structural_equal(convert_iter_expr(res.indices[0]), io)
+    tvm.ir.assert_structural_equal(convert_iter_expr(res.indices[1]), ii)
+
+    # A split across the new loops is a split of their fusion
+    res = tvm.arith.detect_iter_map([floordiv(i, 2), floormod(i, 2)], var_dom([(i, 32)]))
+    res = tvm.arith.update_iter_map_for_split(res, i, [io, ii], [8, 4])
+    analyzer = tvm.arith.Analyzer()
+    assert analyzer.can_prove_equal(convert_iter_expr(res.indices[0]), io * 2 + floordiv(ii, 2))
+
+    # A non-perfect split has to be detected again
+    res = tvm.arith.detect_iter_map([i], var_dom([(i, 30)]))
+    res = tvm.arith.update_iter_map_for_split(res, i, [io, ii], [8, 4])
+    assert len(res.errors) == 1 and len(res.indices) == 0
+
+
+def test_update_iter_map_for_fuse():
+    i = tvm.tir.Var("i", "int32")
+    j = tvm.tir.Var("j", "int32")
+    f = tvm.tir.Var("f", "int32")
+    res = tvm.arith.detect_iter_map([i * 8 + j, floordiv(j, 2)], var_dom([(i, 4), (j, 8)]))
+    res = tvm.arith.update_iter_map_for_fuse(res, [i, j], [4, 8], f)
+    assert len(res.errors) == 0
+    analyzer = tvm.arith.Analyzer()
+    assert analyzer.can_prove_equal(convert_iter_expr(res.indices[0]), f)
+    tvm.ir.assert_structural_equal(convert_iter_expr(res.indices[1]), floormod(floordiv(f, 2), 4))
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -158,5 +158,26 @@ def test_simplify_float_division():
     tvm.ir.assert_structural_equal(ry, sy)
 
 
+def test_simplify_cache():
+    ana = tvm.arith.Analyzer()
+    ana.enable_simplify_cache()
+    x = tir.Var("x", "int32")
+    expr = tir.floordiv(x, 4) * 4 + tir.floormod(x, 4)
+    tvm.ir.assert_structural_equal(ana.simplify(expr), x)
+    tvm.ir.assert_structural_equal(ana.simplify(expr), x)
+    assert ana.simplify_cache_stats["num_hits"] == 1
+
+    # The results under a constraint are not reused outside of its scope
+    cond = tir.Min(x, 8)
+    with ana.constraint_scope(x < 4):
+        tvm.ir.assert_structural_equal(ana.simplify(cond), x)
+    tvm.ir.assert_structural_equal(ana.simplify(cond), cond)
+
+    # Binding a var clears the table
+    ana.bind(x, tvm.ir.Range(0, 4))
+    assert ana.simplify_cache_stats["num_entries"] == 0
+    tvm.ir.assert_structural_equal(ana.simplify(cond), x)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
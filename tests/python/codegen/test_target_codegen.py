@@ -16,10 +16,14 @@
 # under the License.
 # ruff: noqa: F841
 
+import os
+import tempfile
+
 import numpy as np
 import pytest
 
 import tvm
+import tvm.testing
 from tvm.script import tir as T
 
 
@@ -136,5 +140,39 @@ def test_codegen_loop_step(target):
             assert c_result[i] == 0.0
 
 
+@tvm.testing.requires_llvm
+def test_build_cache():
+    def make_func(value):
+        @T.prim_func
+        def func(a: T.handle, b: T.handle):
+            A = T.match_buffer(a, (16,), "float32")
+            B = T.match_buffer(b, (16,), "float32")
+            for i in range(16):
+                B[i] = A[i] + T.float32(value)
+
+        return func
+
+    def build(func, cache_dir):
+        with tvm.transform.PassContext(config={"target.build_cache_dir": cache_dir}):
+            return tvm.compile(func, target="llvm")
+
+    def check(lib, value):
+        a = tvm.runtime.tensor(np.arange(16).astype("float32"))
+        b = tvm.runtime.tensor(np.zeros(16, "float32"))
+        lib(a, b)
+        np.testing.assert_allclose(b.numpy(), a.numpy() + value)
+
+    with tempfile.TemporaryDirectory() as cache_dir:
+        check(build(make_func(1.0), cache_dir), 1.0)
+        entries = sorted(os.listdir(cache_dir))
+        assert entries
+        # The second build of the same kernel hits the cache
+        check(build(make_func(1.0), cache_dir), 1.0)
+        assert sorted(os.listdir(cache_dir)) == entries
+        # Another kernel misses the cache
+        check(build(make_func(2.0), cache_dir), 2.0)
+        assert len(os.listdir(cache_dir)) > len(entries)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -1066,5 +1066,27 @@ def test_cuda_loop_step():
     tvm.testing.assert_allclose(c_nd.numpy(), a_np + b_np)
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_cuda_fatbin_archs_and_warmup():
+    @T.prim_func
+    def add_one(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        for tx in T.thread_binding(128, "threadIdx.x"):
+            B[tx] = A[tx] + T.float32(1)
+
+    dev = tvm.cuda(0)
+    arch = "sm_" + "".join(dev.compute_version.split("."))
+    with tvm.transform.PassContext(config={"cuda.fatbin_archs": [arch]}):
+        lib = tvm.compile(add_one, target="cuda")
+
+    # The modules are loaded on all the devices before the first launch.
+    tvm.get_global_func("runtime.cuda_module_warmup")(lib.mod, [])
+    a_np = np.random.uniform(size=(128,)).astype("float32")
+    a_nd = tvm.runtime.tensor(a_np, dev)
+    b_nd = tvm.runtime.empty((128,), "float32", dev)
+    lib["main"](a_nd, b_nd)
+    tvm.testing.assert_allclose(b_nd.numpy(), a_np + 1)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
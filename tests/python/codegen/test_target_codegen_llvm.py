@@ -16,6 +16,7 @@
 # under the License.
 # ruff: noqa: E501, E731, E741, F841
 import math
+import platform
 import re
 
 import numpy as np
@@ -150,6 +151,42 @@ def test_llvm_multi_parallel():
     tvm.testing.assert_allclose(c.numpy(), np.sqrt(a.numpy() + 1) * 2 + 2, rtol=1e-5)
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize(
+    "target_work_stealing, annotation, expect_chunked",
+    [
+        (False, None, False),
+        (True, None, True),
+        (False, True, True),
+        (True, False, False),
+    ],
+)
+def test_llvm_parallel_work_stealing(target_work_stealing, annotation, expect_chunked):
+    annotations = {} if annotation is None else {"parallel_work_stealing": annotation}
+
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def main(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+            T.func_attr({"tir.noalias": True})
+            for i in T.parallel(128, annotations=annotations):
+                with T.sblock("B"):
+                    v_i = T.axis.spatial(128, i)
+                    B[v_i] = A[v_i] * T.float32(2.0)
+
+    target = tvm.target.Target({"kind": "llvm", "parallel-work-stealing": target_work_stealing})
+    f = tvm.tir.build(Module, target=target)
+    llvm_ir = f.inspect_source()
+    chunked_launch = re.search(r"load [^\n]*@__TVMBackendParallelLaunchChunked\b", llvm_ir)
+    assert (chunked_launch is not None) == expect_chunked
+
+    dev = tvm.cpu(0)
+    a = tvm.runtime.tensor(np.random.uniform(size=128).astype("float32"), dev)
+    b = tvm.runtime.tensor(np.zeros(128, dtype="float32"), dev)
+    f(a, b)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() * 2)
+
+
 @tvm.testing.requires_llvm
 def test_llvm_flip_pipeline():
     def check_llvm(nn, base):
@@ -1283,5 +1320,140 @@ def test_invalid_arguments():
         built(False, tvm.runtime.empty([11], "float32"))
 
 
+
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("dtype", ["float32", "int32"])
+def test_llvm_vector_reduce(dtype):
+    @T.prim_func
+    def func(A: T.Buffer((64,), dtype), B: T.Buffer((2,), dtype)):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        B[0] = T.Cast(dtype, 0)
+        B[1] = A[0]
+        for i_0 in range(8):
+            for i_1 in T.vectorized(8):
+                B[0] = B[0] + A[i_0 * 8 + i_1]
+        for i in T.vectorized(64):
+            B[1] = T.min(B[1], A[i])
+
+    f = tvm.compile(func, target="llvm")
+    ll = f.inspect_source("ll")
+    assert "llvm.vector.reduce" in ll
+
+    dev = tvm.cpu(0)
+    a_np = np.random.randint(-100, 100, size=64).astype(dtype)
+    a = tvm.runtime.tensor(a_np, dev)
+    b = tvm.runtime.tensor(np.zeros(2, dtype=dtype), dev)
+    f(a, b)
+    tvm.testing.assert_allclose(b.numpy(), [a_np.sum(), a_np.min()], rtol=1e-5)
+
+@tvm.testing.requires_llvm
+def test_llvm_codegen_units():
+    """The functions may be generated as several LLVM modules, linked on export"""
+
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def add_one(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            T.func_attr({"target": T.target("llvm")})
+            for i in range(16):
+                B[i] = A[i] + T.float32(1)
+
+        @T.prim_func
+        def times_two(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            T.func_attr({"target": T.target("llvm")})
+            for i in range(16):
+                B[i] = A[i] * T.float32(2)
+
+    with tvm.transform.PassContext(config={"target.llvm_num_codegen_units": 2}):
+        built = tvm.compile(Module)
+    assert len(built.mod.imports) == 1
+
+    temp = utils.tempdir()
+    path = temp.relpath("codegen_units.so")
+    built.export_library(path)
+    loaded = tvm.runtime.load_module(path)
+
+    a_np = np.random.uniform(size=16).astype("float32")
+    for lib in [built, loaded]:
+        a = tvm.runtime.tensor(a_np)
+        b = tvm.runtime.tensor(np.zeros(16, dtype="float32"))
+        lib["add_one"](a, b)
+        tvm.testing.assert_allclose(b.numpy(), a_np + 1)
+        lib["times_two"](a, b)
+        tvm.testing.assert_allclose(b.numpy(), a_np * 2)
+
+
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("jit", ["mcjit", "orcjit"])
+def test_llvm_jit_object_cache(jit, monkeypatch):
+    """The object code compiled by the JIT engines is cached on disk"""
+    temp = utils.tempdir()
+    monkeypatch.setenv("TVM_LLVM_JIT_CACHE_DIR", temp.temp_dir)
+
+    @T.prim_func
+    def add_one(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        for i in range(16):
+            B[i] = A[i] + T.float32(1)
+
+    a_np = np.random.uniform(size=16).astype("float32")
+    for _ in range(2):
+        f = tvm.compile(add_one, target=tvm.target.Target({"kind": "llvm", "jit": jit}))
+        a = tvm.runtime.tensor(a_np)
+        b = tvm.runtime.tensor(np.zeros(16, dtype="float32"))
+        f(a, b)
+        tvm.testing.assert_allclose(b.numpy(), a_np + 1)
+        assert len([name for name in temp.listdir() if name.endswith(".o")]) == 1
+
+
+@tvm.testing.requires_llvm
+def test_llvm_pgo_instrument():
+    """The instrumented code counts the branches and exposes a function to write the profile"""
+    if tvm.target.codegen.llvm_version_major() < 16:
+        pytest.skip("Profile-guided optimization requires LLVM 16 or later")
+
+    @T.prim_func
+    def relu(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        for i in range(16):
+            if A[i] > T.float32(0):
+                B[i] = A[i]
+            else:
+                B[i] = T.float32(0)
+
+    config = {"target.llvm_pgo_instrument": "relu-%p.profraw"}
+    with tvm.transform.PassContext(config=config):
+        mod = tvm.tir.build(relu, target="llvm")
+    ll = mod.inspect_source()
+    assert "__llvm_profile" in ll
+    assert "__tvm_llvm_profile_write_file" in ll
+
+    with tvm.transform.PassContext(config={}):
+        mod = tvm.tir.build(relu, target="llvm")
+    assert "__llvm_profile" not in mod.inspect_source()
+
+
+
+@tvm.testing.requires_llvm
+def test_llvm_multiversion_mcpus():
+    """The exported function dispatches to the variant of the highest level the CPU supports"""
+    if platform.machine() not in ["x86_64", "AMD64"]:
+        pytest.skip("Multi-versioning is only supported on x86-64")
+
+    @T.prim_func
+    def add_one(A: T.Buffer((1024,), "float32"), B: T.Buffer((1024,), "float32")):
+        for i in range(1024):
+            B[i] = A[i] + T.float32(1)
+
+    config = {"target.llvm_multiversion_mcpus": ["x86-64-v3", "x86-64-v4"]}
+    with tvm.transform.PassContext(config=config):
+        mod = tvm.tir.build(add_one, target="llvm")
+    ll = mod.inspect_source()
+    assert ".x86-64-v3" in ll and ".x86-64-v4" in ll
+    assert "__tvm_get_cpu_level" in ll
+
+    a = tvm.runtime.tensor(np.random.rand(1024).astype("float32"))
+    b = tvm.runtime.empty((1024,), "float32")
+    mod(a, b)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1)
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -17,6 +17,8 @@
 # ruff: noqa: E501
 import re
 
+import numpy as np
+
 import tvm
 import tvm.testing
 from tvm.script import ir as I
@@ -250,6 +252,38 @@ def test_opencl_ceil_log2(target):
     _check(target, 32, "float32")
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_opencl
+def test_opencl_program_cache(tmp_path, monkeypatch):
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def main(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32"), x: T.float32):
+            T.func_attr({"tir.noalias": True})
+            for i in T.thread_binding(16, thread="threadIdx.x"):
+                with T.sblock("B"):
+                    v_i = T.axis.spatial(16, i)
+                    B[v_i] = A[v_i] * x
+
+    monkeypatch.setenv("TVM_OPENCL_PROGRAM_CACHE_DIR", str(tmp_path))
+    dev = tvm.device(target, 0)
+    a_np = np.random.uniform(size=16).astype("float32")
+    a = tvm.runtime.tensor(a_np, dev)
+    b = tvm.runtime.empty((16,), "float32", dev)
+
+    tvm.tir.build(Module, target=target)(a, b, 2.0)
+    assert len(list(tmp_path.glob("*.clbin"))) == 1
+    tvm.testing.assert_allclose(b.numpy(), a_np * 2)
+
+    # A new module with the same source loads the binary, and the changed scalar is passed.
+    fun = tvm.tir.build(Module, target=target)
+    fun(a, b, 3.0)
+    tvm.testing.assert_allclose(b.numpy(), a_np * 3)
+    fun(a, b, 3.0)
+    tvm.testing.assert_allclose(b.numpy(), a_np * 3)
+    assert len(list(tmp_path.glob("*.clbin"))) == 1
+
+
 def _get_maximum_kernel_args(source):
     def get_kernel_args(source):
         import re
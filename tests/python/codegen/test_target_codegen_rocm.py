@@ -152,3 +152,21 @@ def test_rocm_vectorized_exp():
     b = tvm.runtime.tensor(np.zeros((4,)).astype("float32"), dev)
     mod(a, b)
     tvm.testing.assert_allclose(b.numpy(), np.exp2(a.numpy()))
+
+
+@tvm.testing.requires_rocm
+def test_rocm_module_warmup():
+    @T.prim_func
+    def add_one(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        for tx in T.thread_binding(128, "threadIdx.x"):
+            B[tx] = A[tx] + T.float32(1)
+
+    lib = tvm.compile(add_one, target="rocm")
+    # The code objects are loaded on all the devices before the first launch.
+    tvm.get_global_func("runtime.rocm_module_warmup")(lib.mod, [])
+    dev = tvm.rocm(0)
+    a_np = np.random.uniform(size=(128,)).astype("float32")
+    a = tvm.runtime.tensor(a_np, dev)
+    b = tvm.runtime.empty((128,), "float32", dev)
+    lib["main"](a, b)
+    tvm.testing.assert_allclose(b.numpy(), a_np + 1)
@@ -291,6 +291,10 @@ def test_batch_matmul():
     verify_batch_matmul(1, 1, 1, 16, 3, mkl, False, False)
     verify_batch_matmul(1, 1, 1, 16, 3, mkl, True, True)
     verify_batch_matmul(1, 1, 1, 16, 3, mkl)
+    # small matrices, as with the heads of an attention
+    verify_batch_matmul(64, 64, 16, 64, 16, cblas)
+    verify_batch_matmul(64, 64, 16, 64, 16, cblas, False, True)
+    verify_batch_matmul(64, 1, 16, 64, 16, cblas, True, False)
 
 
 if __name__ == "__main__":
@@ -187,9 +187,78 @@ def test_random_fill_mt():
     assert no_exception_happened
 
 
+def _philox_reference(seed, positions):
+    """The words of the Philox4x32-10 stream of a seed at the given positions, in numpy."""
+    blocks = positions // 4
+    mask = np.uint64(0xFFFFFFFF)
+    ctr = [blocks & mask, blocks >> np.uint64(32), np.zeros_like(blocks), np.zeros_like(blocks)]
+    keys = [np.uint64(seed) & mask, np.uint64(seed) >> np.uint64(32)]
+    for _ in range(10):
+        prod0 = np.uint64(0xD2511F53) * ctr[0]
+        prod1 = np.uint64(0xCD9E8D57) * ctr[2]
+        ctr = [
+            (prod1 >> np.uint64(32)) ^ ctr[1] ^ keys[0],
+            prod1 & mask,
+            (prod0 >> np.uint64(32)) ^ ctr[3] ^ keys[1],
+            prod0 & mask,
+        ]
+        keys = [(keys[0] + np.uint64(0x9E3779B9)) & mask, (keys[1] + np.uint64(0xBB67AE85)) & mask]
+    words = np.stack(ctr, axis=-1)
+    return words[np.arange(len(positions)), (positions % 4).astype("int64")]
+
+
+def test_philox():
+    """Tests the Philox random functions are deterministic per (seed, offset)"""
+    philox_uniform = tvm.get_global_func("tvm.contrib.random.philox_uniform", True)
+    philox_normal = tvm.get_global_func("tvm.contrib.random.philox_normal", True)
+    if philox_uniform is None or philox_normal is None:
+        print("skip because extern function is not available")
+        return
+    n = 1 << 20
+    seed = 0x1234567890
+
+    def sample(func, offset, size, a, b):
+        value = tvm.runtime.empty((size,), "float32", tvm.cpu())
+        func(seed, offset, a, b, value)
+        return value.numpy()
+
+    # the known answer of Philox4x32-10 for a null counter and key
+    np.testing.assert_equal(
+        _philox_reference(0, np.arange(4, dtype="uint64")),
+        np.array([0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8], dtype="uint64"),
+    )
+    words = _philox_reference(seed, np.arange(3, 3 + 1000, dtype="uint64"))
+    expected = (words >> np.uint64(8)).astype("float32") * np.float32(2**-24)
+    np.testing.assert_equal(sample(philox_uniform, 3, 1000, 0.0, 1.0), expected)
+
+    uniform = sample(philox_uniform, 0, n, 0.0, 1.0)
+    assert abs(np.mean(uniform) - 0.5) < 1e-2
+    assert np.min(uniform) >= 0.0 and np.max(uniform) < 1.0
+    # a range of the stream is the same whatever the call it is drawn by
+    np.testing.assert_equal(sample(philox_uniform, 12345, 1000, 0.0, 1.0), uniform[12345:13345])
+
+    normal = sample(philox_normal, 0, n, 3.0, 4.0)
+    assert abs(np.mean(normal) - 3) < 1e-1
+    assert abs(np.std(normal) - 4) < 1e-2
+    np.testing.assert_equal(sample(philox_normal, 777, 1000, 3.0, 4.0), normal[777:1777])
+
+    # the output does not depend on the number of threads filling it
+    result = {}
+
+    def fill_with_one_thread():
+        tvm.get_global_func("runtime.config_threadpool")(1, 1)
+        result["uniform"] = sample(philox_uniform, 0, n, 0.0, 1.0)
+
+    thread = threading.Thread(target=fill_with_one_thread)
+    thread.start()
+    thread.join()
+    np.testing.assert_equal(result["uniform"], uniform)
+
+
 if __name__ == "__main__":
     test_randint()
     test_uniform()
     test_normal()
     test_random_fill()
     test_random_fill_mt()
+    test_philox()
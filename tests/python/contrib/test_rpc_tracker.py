@@ -20,6 +20,8 @@
 import logging
 import time
 
+import pytest
+
 import tvm
 from tvm import rpc
 
@@ -105,6 +107,78 @@ def check_server_drop():
         print("Skip because tornado is not available")
 
 
+class _FakeServerConn:
+    """The tracker connection of an RPC server, as seen by the schedulers."""
+
+    def __init__(self, port):
+        self.port = port
+        self.pending_matchkeys = set()
+        self.num_puts = 0
+
+    def value(self):
+        self.num_puts += 1
+        matchkey = f"dev:{self.port}:{self.num_puts}"
+        self.pending_matchkeys.add(matchkey)
+        return (self, "127.0.0.1", self.port, matchkey)
+
+
+def _served_ports(sched, num_requests, timeout=None):
+    ports = []
+
+    def _cb(value):
+        ports.append(value[1])
+        return True
+
+    for _ in range(num_requests):
+        sched.request("", 1, _cb, timeout)
+    return ports
+
+
+def _run_session(sched, conn, duration):
+    # The sessions end when the servers become free again.
+    sched._devices[conn].start -= duration  # pylint: disable=protected-access
+    sched.put(conn.value())
+
+
+def test_load_balance_prefers_fast_device():
+    tracker = pytest.importorskip("tvm.rpc.tracker")
+    sched = tracker.LoadBalanceScheduler("dev")
+    fast, slow = _FakeServerConn(9001), _FakeServerConn(9002)
+    sched.put(slow.value())
+    sched.put(fast.value())
+    # The devices not measured yet are assigned FIFO.
+    assert _served_ports(sched, 2) == [9002, 9001]
+    _run_session(sched, slow, 5.0)
+    _run_session(sched, fast, 1.0)
+    assert _served_ports(sched, 1) == [9001]
+    assert not fast.pending_matchkeys and len(slow.pending_matchkeys) == 1
+
+
+def test_load_balance_timeout_and_summary():
+    tracker = pytest.importorskip("tvm.rpc.tracker")
+    sched = tracker.LoadBalanceScheduler("dev")
+    dev0, dev1 = _FakeServerConn(9001), _FakeServerConn(9002)
+    sched.put(dev0.value())
+    sched.put(dev1.value())
+    assert _served_ports(sched, 2, timeout=2.0) == [9001, 9002]
+    _run_session(sched, dev0, 2.5)
+    _run_session(sched, dev1, 0.5)
+    assert _served_ports(sched, 1, timeout=2.0) == [9002]
+
+    summary = sched.summary()
+    assert summary["free"] == 1 and summary["pending"] == 0
+    devices = {dev["addr"]: dev for dev in summary["devices"]}
+    assert devices["127.0.0.1:9001"]["timeouts"] == 1
+    assert not devices["127.0.0.1:9001"]["busy"]
+    assert devices["127.0.0.1:9002"]["timeouts"] == 0
+    assert devices["127.0.0.1:9002"]["busy"]
+    assert devices["127.0.0.1:9002"]["sessions"] == 1
+    assert devices["127.0.0.1:9002"]["sessions_per_min"] > 0
+
+    sched.remove(sched._values[0])  # pylint: disable=protected-access
+    assert [dev["addr"] for dev in sched.summary()["devices"]] == ["127.0.0.1:9002"]
+
+
 if __name__ == "__main__":
     logging.basicConfig(level=logging.INFO)
     check_server_drop()
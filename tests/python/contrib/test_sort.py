@@ -95,6 +95,29 @@ def test_sort_np():
     tvm.testing.assert_allclose(c.numpy(), np_out, rtol=1e-5)
 
 
+def test_sort_large_rows():
+    """Tests argsort and topk on rows long enough to be split across threads"""
+    dev = tvm.cpu(0)
+    # duplicated values check that the result is stable
+    np_data = np.random.randint(0, 1000, size=(2, 300000)).astype("float32")
+    a = tvm.runtime.tensor(np_data, dev)
+
+    argsort = tvm.get_global_func("tvm.contrib.sort.argsort")
+    out = tvm.runtime.tensor(np.zeros(np_data.shape, dtype="int32"), dev)
+    argsort(a, out, -1, True)
+    np.testing.assert_equal(out.numpy(), np.argsort(np_data, axis=-1, kind="stable"))
+
+    k = 10
+    topk = tvm.get_global_func("tvm.contrib.sort.topk")
+    values = tvm.runtime.tensor(np.zeros((2, k), dtype="float32"), dev)
+    indices = tvm.runtime.tensor(np.zeros((2, k), dtype="int64"), dev)
+    topk(a, values, indices, k, -1, "both", False)
+    np_indices = np.argsort(-np_data, axis=-1, kind="stable")[:, :k]
+    np.testing.assert_equal(indices.numpy(), np_indices)
+    np.testing.assert_equal(values.numpy(), np.take_along_axis(np_data, np_indices, axis=-1))
+
+
 if __name__ == "__main__":
     test_sort()
     test_sort_np()
+    test_sort_large_rows()
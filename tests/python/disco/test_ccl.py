@@ -174,6 +174,111 @@ def test_group_allgather(session_kind, ccl):
     )
 
 
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+@pytest.mark.parametrize("ccl", _ccl)
+def test_async_collective(session_kind, ccl):
+    devices = [0, 1]
+    sess = session_kind(num_workers=len(devices))
+    sess.init_ccl(ccl, *devices)
+
+    array_1 = np.arange(12, dtype="float32").reshape(3, 4)
+    array_2 = np.arange(start=1, stop=-11, step=-1, dtype="float32").reshape(3, 4)
+    d_array = sess.empty((3, 4), "float32")
+    d_array.debug_copy_from(0, array_1)
+    d_array.debug_copy_from(1, array_2)
+    d_reduced = sess.empty((3, 4), "float32")
+    d_gathered = sess.empty((6, 4), "float32")
+    # Both collectives are in flight on the communication stream at the same time.
+    reduce_handle = sess.allreduce_async(d_array, d_reduced, op="sum")
+    gather_handle = sess.allgather_async(d_array, d_gathered)
+    sess.wait(gather_handle)
+    sess.wait(reduce_handle)
+    for worker_id in range(2):
+        np.testing.assert_equal(
+            d_reduced.debug_get_from_remote(worker_id).numpy(), array_1 + array_2
+        )
+        np.testing.assert_equal(
+            d_gathered.debug_get_from_remote(worker_id).numpy(),
+            np.concatenate([array_1, array_2]),
+        )
+
+
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+@pytest.mark.parametrize("ccl", _ccl)
+def test_reduce_scatter(session_kind, ccl):
+    devices = [0, 1]
+    sess = session_kind(num_workers=len(devices))
+    sess.init_ccl(ccl, *devices)
+
+    array_1 = np.arange(12, dtype="float32").reshape(4, 3)
+    array_2 = np.arange(start=1, stop=-11, step=-1, dtype="float32").reshape(4, 3)
+    d_src = sess.empty((4, 3), "float32")
+    d_dst = sess.empty((2, 3), "float32")
+    d_src.debug_copy_from(0, array_1)
+    d_src.debug_copy_from(1, array_2)
+    for op, np_op in [  # pylint: disable=invalid-name
+        ("sum", np.add),
+        ("prod", np.multiply),
+        ("min", np.minimum),
+        ("max", np.maximum),
+    ]:
+        sess.reduce_scatter(d_src, d_dst, op=op)
+        expected = np_op(array_1, array_2)
+        np.testing.assert_equal(d_dst.debug_get_from_remote(0).numpy(), expected[:2])
+        np.testing.assert_equal(d_dst.debug_get_from_remote(1).numpy(), expected[2:])
+
+
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+@pytest.mark.parametrize("ccl", _ccl)
+@pytest.mark.parametrize("explicit_splits", [True, False])
+def test_all_to_all(session_kind, ccl, explicit_splits):
+    devices = [0, 1]
+    sess = session_kind(num_workers=len(devices))
+    sess.init_ccl(ccl, *devices)
+
+    array_1 = np.arange(12, dtype="float32").reshape(4, 3)
+    array_2 = np.arange(12, 24, dtype="float32").reshape(4, 3)
+    d_src = sess.empty((4, 3), "float32")
+    d_dst = sess.empty((4, 3), "float32")
+    d_src.debug_copy_from(0, array_1)
+    d_src.debug_copy_from(1, array_2)
+    if explicit_splits:
+        sess.all_to_all(d_src, d_dst, send_splits=[2, 2], recv_splits=[2, 2])
+    else:
+        sess.all_to_all(d_src, d_dst)
+    np.testing.assert_equal(
+        d_dst.debug_get_from_remote(0).numpy(),
+        np.concatenate([array_1[:2], array_2[:2]]),
+    )
+    np.testing.assert_equal(
+        d_dst.debug_get_from_remote(1).numpy(),
+        np.concatenate([array_1[2:], array_2[2:]]),
+    )
+
+
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+@pytest.mark.parametrize("ccl", _ccl)
+@pytest.mark.parametrize("use_async", [True, False])
+def test_ring_send_recv(session_kind, ccl, use_async):
+    devices = [0, 1, 2]
+    sess = session_kind(num_workers=len(devices))
+    sess.init_ccl(ccl, *devices)
+
+    arrays = [np.full((2, 3), i, dtype="float32") for i in range(3)]
+    d_src = sess.empty((2, 3), "float32")
+    d_dst = sess.empty((2, 3), "float32")
+    for worker_id, array in enumerate(arrays):
+        d_src.debug_copy_from(worker_id, array)
+    if use_async:
+        sess.wait(sess.ring_send_recv_async(d_src, d_dst))
+    else:
+        sess.ring_send_recv(d_src, d_dst)
+    for worker_id in range(3):
+        np.testing.assert_equal(
+            d_dst.debug_get_from_remote(worker_id).numpy(), arrays[(worker_id - 1) % 3]
+        )
+
+
 @pytest.mark.parametrize("session_kind", _all_session_kinds)
 @pytest.mark.parametrize("ccl", _ccl)
 @pytest.mark.parametrize("use_explicit_output", [True, False])
@@ -413,6 +518,65 @@ def test_send_to_next_group_receive_from_prev_group(session_kind, ccl):
     np.testing.assert_equal(result_2, array_2)
 
 
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+@pytest.mark.parametrize("ccl", _ccl)
+def test_pipeline_forward(session_kind, ccl):
+    devices = [0, 1]
+    sess = session_kind(num_workers=len(devices), num_groups=2)
+    sess.init_ccl(ccl, *devices)
+
+    # pylint: disable=invalid-name
+    @tvm.script.ir_module
+    class Stages:  # pylint: disable=too-few-public-methods
+        @R.function
+        def stage0(x: R.Tensor((2, 4), "float32")) -> R.Tensor((2, 4), "float32"):
+            R.func_attr({"global_symbol": "stage0"})
+            with R.dataflow():
+                lv0: R.Tensor((2, 4), "float32") = R.add(x, R.const(1, "float32"))
+                R.output(lv0)
+            return lv0
+
+        @R.function
+        def stage1(x: R.Tensor((2, 4), "float32")) -> R.Tensor((2, 4), "float32"):
+            R.func_attr({"global_symbol": "stage1"})
+            with R.dataflow():
+                lv0: R.Tensor((2, 4), "float32") = R.multiply(x, R.const(2, "float32"))
+                R.output(lv0)
+            return lv0
+
+    # pylint: enable=invalid-name
+    _, target = create_device_target(ccl)
+    with target:
+        mod = rx.get_pipeline("zero")(Stages)  # pylint: disable=no-value-for-parameter
+        mod = dl.ApplyDefaultSchedule(dl.gpu.Fallback())(mod)  # pylint: disable=not-callable
+
+    num_micro_batches = 3
+    array = np.arange(24, dtype="float32").reshape(6, 4)
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = tmpdir + "/test.so"
+        tvm.compile(mod, target=target).export_library(path)
+        d_mod = sess.load_vm_module(path)
+
+        d_input = sess.empty((6, 4), "float32")
+        d_output = sess.empty((6, 4), "float32")
+        d_input.debug_copy_from(0, array)
+        d_stats = sess.pipeline_forward(
+            d_mod,
+            ["stage0", "stage1"],
+            num_micro_batches,
+            d_input,
+            (2, 4),
+            "float32",
+            d_output,
+            measure_time=True,
+        )
+        np.testing.assert_equal(d_output.debug_get_from_remote(1).numpy(), (array + 1) * 2)
+        for worker_id in range(2):
+            num_ticks, busy_ticks, _, _ = d_stats.debug_get_from_remote(worker_id)
+            assert num_ticks == num_micro_batches + 1
+            assert busy_ticks == num_micro_batches
+
+
 @pytest.mark.parametrize("session_kind", _all_session_kinds)
 @pytest.mark.parametrize("ccl", _ccl)
 def test_worker2_send_to_worker0(session_kind, ccl):
@@ -669,5 +833,56 @@ def test_attention(session_kind, ccl):  # pylint: disable=too-many-locals,too-ma
     tvm.testing.assert_allclose(Y_result, Y_expected, rtol=1e-3, atol=1e-3)
 
 
+
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+@pytest.mark.parametrize("ccl", _ccl)
+def test_moe_expert_parallel(session_kind, ccl):  # pylint: disable=too-many-locals
+    devices = [0, 1]
+    sess = session_kind(num_workers=len(devices))
+    sess.init_ccl(ccl, *devices)
+
+    # pylint: disable=invalid-name
+    @tvm.script.ir_module
+    class ExpertParallelMoE:  # pylint: disable=too-few-public-methods
+        @R.function
+        def main(
+            x: R.Tensor((4, 3, 8), "float32"),  # the tokens of each of the 4 experts
+            W: R.Tensor((2, 8, 8), "float32"),  # the weights of the 2 local experts
+        ) -> R.Tensor((4, 3, 8), "float32"):
+            R.func_attr({"global_symbol": "main"})
+            with R.dataflow():
+                lv0: R.Tensor((2, 6, 8), "float32") = R.ccl.moe_dispatch(x, 2)
+                lv1: R.Tensor((2, 6, 8), "float32") = R.matmul(lv0, W)
+                lv2: R.Tensor((4, 3, 8), "float32") = R.ccl.moe_combine(lv1, 2)
+                R.output(lv2)
+            return lv2
+
+    # pylint: enable=invalid-name
+    _, target = create_device_target(ccl)
+    with target:
+        mod = rx.get_pipeline("zero")(ExpertParallelMoE)  # pylint: disable=no-value-for-parameter
+        mod = dl.ApplyDefaultSchedule(  # pylint: disable=not-callable
+            dl.gpu.Matmul(),
+            dl.gpu.GEMV(),
+            dl.gpu.Fallback(),
+        )(mod)
+
+    X = [np.random.randn(4, 3, 8).astype("float32") for _ in devices]
+    W = np.random.randn(4, 8, 8).astype("float32")
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = tmpdir + "/test.so"
+        tvm.compile(mod, target=target).export_library(path)
+        vm = sess.load_vm_module(path)
+
+        d_X = sess.empty((4, 3, 8), "float32")
+        d_W = sess.empty((2, 8, 8), "float32")
+        for i in range(len(devices)):
+            d_X.debug_copy_from(i, X[i])
+            d_W.debug_copy_from(i, W[2 * i : 2 * i + 2])
+        d_Y = vm["main"](d_X, d_W)
+        for i in range(len(devices)):
+            Y_result = d_Y.debug_get_from_remote(i).numpy()
+            tvm.testing.assert_allclose(Y_result, np.matmul(X[i], W), rtol=1e-5, atol=1e-5)
+
 if __name__ == "__main__":
     tvm.testing.main()
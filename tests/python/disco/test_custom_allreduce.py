@@ -77,6 +77,68 @@ def test_allreduce(shape, ccl, strategy):
     np.testing.assert_equal(result_2, expected)
 
 
+@pytest.mark.parametrize("ccl", _ccl)
+@pytest.mark.parametrize("strategy", _strategies)
+@pytest.mark.parametrize("out_dtype", ["float32", "float8_e4m3fn"])
+def test_allreduce_residual_rms_norm(ccl, strategy, out_dtype):
+    devices = [0, 1]
+    sess: Session = disco.ProcessSession(num_workers=len(devices))
+    sess.init_ccl(ccl, *devices)
+
+    shape = (4, 128)
+    dtype = "float32"
+    eps = 1e-5
+    falloc_ipc_storage = sess.get_global_func("runtime.disco.cuda_ipc.alloc_storage")
+    falloc_tensor = sess.get_global_func("vm.builtin.alloc_tensor")
+    ffused = sess.get_global_func("runtime.disco.cuda_ipc.custom_allreduce_residual_rms_norm")
+    d_storage = sess.call_packed(falloc_ipc_storage, ShapeTuple(shape), DataType(dtype))
+    d_input = sess.call_packed(falloc_tensor, d_storage, 0, ShapeTuple(shape), DataType(dtype))
+
+    rng = np.random.default_rng(0)
+    array_1 = rng.standard_normal(shape).astype(dtype)
+    array_2 = rng.standard_normal(shape).astype(dtype)
+    residual = rng.standard_normal(shape).astype(dtype)
+    weight = rng.standard_normal(shape[-1:]).astype(dtype)
+    d_input.debug_copy_from(0, array_1)
+    d_input.debug_copy_from(1, array_2)
+    d_residual = sess.empty(shape, dtype)
+    d_weight = sess.empty(shape[-1:], dtype)
+    for worker_id in range(len(devices)):
+        d_residual.debug_copy_from(worker_id, residual)
+        d_weight.debug_copy_from(worker_id, weight)
+    d_residual_out = sess.empty(shape, dtype)
+    d_output = sess.empty(shape, out_dtype)
+    scale = 0.5
+    d_scale = None
+    if out_dtype == "float8_e4m3fn":
+        d_scale = sess.empty((1,), "float32")
+        for worker_id in range(len(devices)):
+            d_scale.debug_copy_from(worker_id, np.array([scale], dtype="float32"))
+
+    sess.call_packed(
+        ffused, d_input, d_residual, d_weight, d_scale, eps, strategy, d_residual_out, d_output
+    )
+    expected_residual = array_1 + array_2 + residual
+    expected = (
+        expected_residual
+        / np.sqrt(np.mean(np.square(expected_residual), axis=-1, keepdims=True) + eps)
+        * weight
+    )
+    for worker_id in range(len(devices)):
+        np.testing.assert_allclose(
+            d_residual_out.debug_get_from_remote(worker_id).numpy(), expected_residual, rtol=1e-6
+        )
+        result = d_output.debug_get_from_remote(worker_id).numpy()
+        if out_dtype == "float8_e4m3fn":
+            np.testing.assert_allclose(
+                result.astype("float32") * scale, expected, rtol=0.125, atol=0.05
+            )
+        else:
+            np.testing.assert_allclose(result, expected, rtol=1e-5, atol=1e-5)
+
+
 if __name__ == "__main__":
     for shape, strategy in product(_shapes, _strategies):
         test_allreduce(shape, "nccl", strategy)
+    for strategy, out_dtype in product(_strategies, ["float32", "float8_e4m3fn"]):
+        test_allreduce_residual_rms_norm("nccl", strategy, out_dtype)
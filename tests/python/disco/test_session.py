@@ -304,6 +304,46 @@ def test_vm_multi_func(session_kind):
             sess._sync_worker(i)
 
 
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+def test_batch(session_kind):
+    num_workers = 4
+    sess = session_kind(num_workers=num_workers)
+    func: di.DPackedFunc = sess.get_global_func("tests.disco.add_one")
+    with sess.batch():
+        result: di.DRef = func(1)
+        # Commands in a batch can depend on the results of earlier commands in the same batch.
+        for _ in range(9):
+            result = func(result)
+        with pytest.raises(ValueError):
+            sess.sync_worker_0()
+    for i in range(num_workers):
+        assert result.debug_get_from_remote(i) == 11
+
+
+@pytest.mark.parametrize("session_kind", _all_session_kinds)
+def test_trace(session_kind):
+    num_workers = 2
+    sess = session_kind(num_workers=num_workers)
+    func: di.DPackedFunc = sess.get_global_func("tests.disco.add_one")
+    sess.start_trace()
+    result: di.DRef = func(1)
+    result = func(result)
+    trace = sess.stop_trace()
+    for i in range(num_workers):
+        assert result.debug_get_from_remote(i) == 3
+
+    assert len(trace.clock_offsets) == num_workers
+    calls = [event for event in trace.events if event["name"] == "tests.disco.add_one"]
+    assert sorted(event["worker"] for event in calls) == [0, 0, 1, 1]
+    assert all(event["cat"] == "call" and event["dur"] >= 0 for event in calls)
+
+    chrome_trace = trace.chrome_trace()
+    assert len([e for e in chrome_trace["traceEvents"] if e["ph"] == "X"]) == len(trace.events)
+    report = trace.report()
+    assert len(report.calls) == len(trace.events)
+    assert "tests.disco.add_one" in report.table()
+
+
 @pytest.mark.parametrize("session_kind", _all_session_kinds)
 @pytest.mark.parametrize("num_workers", [1, 2, 4])
 def test_num_workers(session_kind, num_workers):
@@ -193,5 +193,44 @@ def test_free_var_equal():
     tvm.ir.assert_structural_equal(x, z, map_free_vars=True)
 
 
+def test_module_saveload_binary():
+    from tvm.script import ir as I
+    from tvm.script import relax as R
+    from tvm.script import tir as T
+
+    @I.ir_module
+    class Module:
+        @T.prim_func(private=True)
+        def add_one(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            for i in range(16):
+                B[i] = A[i] + T.float32(1.5)
+
+        @R.function
+        def main(x: R.Tensor((16,), "float32")):
+            cls = Module
+            y = R.call_tir(cls.add_one, (x,), out_sinfo=R.Tensor((16,), "float32"))
+            return y
+
+    data = tvm.ir.save_module_binary(Module)
+    assert len(data) < len(tvm.ir.save_json(Module))
+    assert sorted(tvm.ir.module_binary_function_names(data)) == ["add_one", "main"]
+    tvm.ir.assert_structural_equal(tvm.ir.load_module_binary(data), Module)
+
+    # The loaded functions refer to the GlobalVars of the module.
+    mod = tvm.ir.load_module_binary(data)
+    call = mod["main"].body.blocks[0].bindings[0].value
+    assert call.args[0].same_as(mod.get_global_var("add_one"))
+
+    main_only = tvm.ir.load_module_binary(data, ["main"])
+    assert [gv.name_hint for gv in main_only.get_global_vars()] == ["main"]
+    call = main_only["main"].body.blocks[0].bindings[0].value
+    assert call.args[0].name_hint == "add_one"
+
+    with pytest.raises(ValueError):
+        tvm.ir.load_module_binary(data, ["missing"])
+    with pytest.raises(ValueError):
+        tvm.ir.load_module_binary(data[: len(data) // 2])
+
+
 if __name__ == "__main__":
     tvm.testing.main()
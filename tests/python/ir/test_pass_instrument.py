@@ -19,7 +19,7 @@
 
 import tvm
 from tvm import relax
-from tvm.ir.instrument import PrintAfterAll, PrintBeforeAll
+from tvm.ir.instrument import PassMetricsInstrument, PrintAfterAll, PrintBeforeAll
 from tvm.script import ir as I
 from tvm.script import relax as R
 from tvm.script import tir as T
@@ -61,3 +61,30 @@ def test_relax_print_all_passes(capsys):
     assert "Before Running Pass:" in all_passes_output
     assert "After Running Pass:" in all_passes_output
     assert "pass name: _pipeline" in all_passes_output
+
+
+def test_pass_metrics_instrument():
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def main(A: T.Buffer((16,), "float32")):
+            for i in range(16):
+                if i < 16:
+                    A[i] = T.float32(0)
+
+    metrics = PassMetricsInstrument()
+    with tvm.transform.PassContext(instruments=[metrics]):
+        tvm.transform.Sequential([tvm.tir.transform.Simplify()], name="outer")(Module)
+        table = metrics.render()
+        records = metrics.get_metrics()
+    assert [record["name"] for record in records] == ["outer", "tir.Simplify"]
+    assert records[0]["total_ms"] >= records[1]["total_ms"]
+    assert records[1]["nodes_after"] < records[1]["nodes_before"]
+    rows = [row.split("|") for row in table.splitlines() if "|" in row]
+    assert [cell.strip() for cell in rows[0]][:2] == ["Pass", "Function"]
+    passes = [row[0].strip() for row in rows[1:] if row[0].strip()]
+    assert sorted(passes) == ["outer", "tir.Simplify"]
+    # Simplify removes the condition, so main is listed under both passes with fewer nodes.
+    main_rows = [row for row in rows if row[1].strip() == "main"]
+    assert len(main_rows) == 2
+    assert all(int(row[6]) < int(row[5]) for row in main_rows)
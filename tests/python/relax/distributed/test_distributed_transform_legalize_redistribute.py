@@ -65,5 +65,50 @@ def test_simple():
     tvm.ir.assert_structural_equal(after, Expected)
 
 
+
+def test_expert_all_to_all():
+    @I.ir_module
+    class Before:
+        I.module_attrs({"device_num": 2})
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"),
+            w: R.DTensor((4, 8, 8), "float32", "mesh[0]", "S[0]"),
+        ):
+            R.func_attr({"num_input": 1})
+            # dispatch the tokens to the workers of their experts
+            lv0 = R.dist.redistribute(x, "mesh[0]", "S[0]")
+            lv1 = R.matmul(lv0, w)
+            # combine the outputs back to the workers of the tokens
+            lv2 = R.dist.redistribute(lv1, "mesh[0]", "S[1]")
+            return lv2
+
+    @I.ir_module
+    class Expected:
+        I.module_attrs({"device_num": 2})
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"),
+            w: R.DTensor((4, 8, 8), "float32", "mesh[0]", "S[0]"),
+        ) -> R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"):
+            R.func_attr({"num_input": 1})
+            lv0: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[0]") = R.ccl.moe_dispatch(
+                x, num_workers=2, in_group=False
+            )
+            lv1: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[0]") = R.matmul(
+                lv0, w, out_dtype="void"
+            )
+            lv2: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]") = R.ccl.moe_combine(
+                lv1, num_workers=2, in_group=False
+            )
+            return lv2
+
+    after = relax.distributed.transform.LegalizeRedistribute()(Before)
+    tvm.ir.assert_structural_equal(after, Expected)
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -231,6 +231,93 @@ def test_mlp():
     tvm.ir.assert_structural_equal(mod, Expected)
 
 
+def test_expert_parallel_matmul():
+    # The experts and their weights are sharded along axis 0, the tokens are dispatched to the
+    # workers of their experts and combined back by the redistributes.
+    @I.ir_module
+    class ExpertMatmul:
+        I.module_attrs({"device_num": 2})
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @T.prim_func(private=True)
+        def bmm(
+            A: T.Buffer((T.int64(4), T.int64(6), T.int64(8)), "float32"),
+            B: T.Buffer((T.int64(4), T.int64(8), T.int64(8)), "float32"),
+            matmul: T.Buffer((T.int64(4), T.int64(6), T.int64(8)), "float32"),
+        ):
+            T.func_attr({"tir.noalias": True})
+            # with T.sblock("root"):
+            for b, i0, i1, k in T.grid(T.int64(4), T.int64(6), T.int64(8), T.int64(8)):
+                with T.sblock("matmul"):
+                    v_b, v_i0, v_i1, v_k = T.axis.remap("SSSR", [b, i0, i1, k])
+                    T.reads(A[v_b, v_i0, v_k], B[v_b, v_k, v_i1])
+                    T.writes(matmul[v_b, v_i0, v_i1])
+                    with T.init():
+                        matmul[v_b, v_i0, v_i1] = T.float32(0)
+                    matmul[v_b, v_i0, v_i1] = (
+                        matmul[v_b, v_i0, v_i1] + A[v_b, v_i0, v_k] * B[v_b, v_k, v_i1]
+                    )
+
+        @R.function
+        def foo(
+            x: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"),
+            w: R.DTensor((4, 8, 8), "float32", "mesh[0]", "S[0]"),
+        ) -> R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"):
+            cls = ExpertMatmul
+            lv0 = R.dist.redistribute(x, "mesh[0]", "S[0]")
+            lv1 = R.dist.call_tir(
+                cls.bmm, (lv0, w), out_sinfo=R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[0]")
+            )
+            lv2 = R.dist.redistribute(lv1, "mesh[0]", "S[1]")
+            return lv2
+
+    @I.ir_module
+    class Expected:
+        I.module_attrs({"device_num": 2})
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @T.prim_func(private=True)
+        def bmm1(
+            A: T.Buffer((T.int64(2), T.int64(6), T.int64(8)), "float32"),
+            B: T.Buffer((T.int64(2), T.int64(8), T.int64(8)), "float32"),
+            matmul: T.Buffer((T.int64(2), T.int64(6), T.int64(8)), "float32"),
+        ):
+            T.func_attr({"tir.noalias": True})
+            # with T.sblock("root"):
+            for b, i0, i1, k in T.grid(T.int64(2), T.int64(6), T.int64(8), T.int64(8)):
+                with T.sblock("matmul"):
+                    v_b, v_i0, v_i1, v_k = T.axis.remap("SSSR", [b, i0, i1, k])
+                    T.reads(A[v_b, v_i0, v_k], B[v_b, v_k, v_i1])
+                    T.writes(matmul[v_b, v_i0, v_i1])
+                    with T.init():
+                        matmul[v_b, v_i0, v_i1] = T.float32(0)
+                    matmul[v_b, v_i0, v_i1] = (
+                        matmul[v_b, v_i0, v_i1] + A[v_b, v_i0, v_k] * B[v_b, v_k, v_i1]
+                    )
+
+        @R.function
+        def foo(
+            x: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"),
+            w: R.DTensor((4, 8, 8), "float32", "mesh[0]", "S[0]"),
+        ) -> R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]"):
+            cls = Expected
+            lv0: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[0]") = R.dist.redistribute(
+                x, "mesh[0]", "S[0]"
+            )
+            lv1: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[0]") = R.dist.call_tir_local_view(
+                cls.bmm1, (lv0, w), out_sinfo=R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[0]")
+            )
+            lv2: R.DTensor((4, 6, 8), "float32", "mesh[0]", "S[1]") = R.dist.redistribute(
+                lv1, "mesh[0]", "S[1]"
+            )
+            return lv2
+
+    mod = ExpertMatmul
+    mod = relax.distributed.transform.LowerGlobalViewToLocalView()(mod)
+    mod = relax.transform.DeadCodeElimination()(mod)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
 def test_llama_attention():
     @I.ir_module
     class LlamaAttentionLayer:
@@ -1577,4 +1664,5 @@ def test_llama_attention():
 
 if __name__ == "__main__":
     test_mlp()
+    test_expert_parallel_matmul()
     test_llama_attention()
@@ -300,6 +300,83 @@ def test_mlp_dynamic_shape():
     assert_structural_equal(after, ShardedMLPDynamicShape)
 
 
+def _auto_sharding_mlp():
+    @I.ir_module
+    class MLP:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.Tensor((8, 128), "float32"),
+            weight1: R.Tensor((128, 512), "float32"),
+            weight2: R.Tensor((512, 128), "float32"),
+        ) -> R.Tensor((8, 128), "float32"):
+            lv0 = R.matmul(x, weight1)
+            lv1 = R.nn.gelu(lv0)
+            lv2 = R.matmul(lv1, weight2)
+            return lv2
+
+    return MLP
+
+
+def test_auto_sharding_mlp():
+    # Without memory budget, data parallelism needs no communication.
+    MLP = _auto_sharding_mlp()
+
+    @I.ir_module
+    class ShardedMLP:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((8, 128), "float32", "mesh[0]", "S[0]"),
+            weight1: R.DTensor((128, 512), "float32", "mesh[0]", "R"),
+            weight2: R.DTensor((512, 128), "float32", "mesh[0]", "R"),
+        ) -> R.DTensor((8, 128), "float32", "mesh[0]", "S[0]"):
+            lv0: R.DTensor((8, 512), "float32", "mesh[0]", "S[0]") = R.matmul(
+                x, weight1, out_dtype="void"
+            )
+            lv1: R.DTensor((8, 512), "float32", "mesh[0]", "S[0]") = R.nn.gelu(lv0)
+            lv2: R.DTensor((8, 128), "float32", "mesh[0]", "S[0]") = R.matmul(
+                lv1, weight2, out_dtype="void"
+            )
+            return lv2
+
+    mesh = MLP.global_infos["mesh"][0]
+    after = relax.distributed.transform.PropagateSharding(auto_sharding_mesh=mesh)(MLP)
+    assert_structural_equal(after, ShardedMLP)
+
+
+def test_auto_sharding_mlp_memory_budget():
+    # The replicated weights do not fit in the budget: they are sharded as in Megatron-LM.
+    MLP = _auto_sharding_mlp()
+
+    @I.ir_module
+    class ShardedMLP:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((8, 128), "float32", "mesh[0]", "R"),
+            weight1: R.DTensor((128, 512), "float32", "mesh[0]", "S[1]"),
+            weight2: R.DTensor((512, 128), "float32", "mesh[0]", "S[0]"),
+        ) -> R.DTensor((8, 128), "float32", "mesh[0]", "R"):
+            lv0: R.DTensor((8, 512), "float32", "mesh[0]", "S[1]") = R.matmul(
+                x, weight1, out_dtype="void"
+            )
+            lv1: R.DTensor((8, 512), "float32", "mesh[0]", "S[1]") = R.nn.gelu(lv0)
+            lv2: R.DTensor((8, 128), "float32", "mesh[0]", "R") = R.matmul(
+                lv1, weight2, out_dtype="void"
+            )
+            return lv2
+
+    mesh = MLP.global_infos["mesh"][0]
+    after = relax.distributed.transform.PropagateSharding(
+        auto_sharding_mesh=mesh, memory_budget=300_000
+    )(MLP)
+    assert_structural_equal(after, ShardedMLP)
+
+
 def test_mlp_pipeline_parallelism():
     @I.ir_module
     class PipelineMLP:
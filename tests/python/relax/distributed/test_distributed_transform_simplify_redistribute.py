@@ -0,0 +1,124 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#  type: ignore
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script.parser import ir as I
+from tvm.script.parser import relax as R
+
+
+def test_merge_chain():
+    @I.ir_module
+    class Before:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x1: R.DTensor((128, 128), "float32", "mesh[0]", "R"),
+            x2: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"),
+        ):
+            # merged into one redistribute
+            lv0 = R.dist.redistribute(x1, "mesh[0]", "S[0]")
+            lv1 = R.dist.redistribute(lv0, "mesh[0]", "S[1]")
+            # cancelled
+            lv2 = R.dist.redistribute(x2, "mesh[0]", "R")
+            lv3 = R.dist.redistribute(lv2, "mesh[0]", "S[0]")
+            return (lv1, lv3)
+
+    @I.ir_module
+    class Expected:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x1: R.DTensor((128, 128), "float32", "mesh[0]", "R"),
+            x2: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"),
+        ) -> R.Tuple(
+            R.DTensor((128, 128), "float32", "mesh[0]", "S[1]"),
+            R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"),
+        ):
+            lv1: R.DTensor((128, 128), "float32", "mesh[0]", "S[1]") = R.dist.redistribute(
+                x1, "mesh[0]", "S[1]"
+            )
+            return (lv1, x2)
+
+    after = relax.distributed.transform.SimplifyRedistribute()(Before)
+    tvm.ir.assert_structural_equal(after, Expected)
+
+
+def test_sink_gather_past_elementwise():
+    @I.ir_module
+    class Before:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"),
+        ) -> R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"):
+            lv0 = R.dist.redistribute(x, "mesh[0]", "R")
+            lv1 = R.nn.gelu(lv0)
+            lv2 = R.dist.redistribute(lv1, "mesh[0]", "S[0]")
+            return lv2
+
+    @I.ir_module
+    class Expected:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"),
+        ) -> R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"):
+            lv1: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]") = R.nn.gelu(x)
+            return lv1
+
+    after = relax.distributed.transform.SimplifyRedistribute()(Before)
+    tvm.ir.assert_structural_equal(after, Expected)
+
+
+def test_fuse_reduce_scatter():
+    @I.ir_module
+    class Before:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((128, 128), "float32", "mesh[0]", "R"),
+        ) -> R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"):
+            lv0 = R.ccl.allreduce(x, op_type="sum")
+            lv1 = R.dist.redistribute_replica_to_shard(lv0, num_workers=2, axis=0)
+            return lv1
+
+    @I.ir_module
+    class Expected:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((128, 128), "float32", "mesh[0]", "R"),
+        ) -> R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"):
+            lv1: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]") = R.ccl.reduce_scatter(
+                x, num_workers=2, op_type="sum"
+            )
+            return lv1
+
+    after = relax.distributed.transform.SimplifyRedistribute()(Before)
+    tvm.ir.assert_structural_equal(after, Expected)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
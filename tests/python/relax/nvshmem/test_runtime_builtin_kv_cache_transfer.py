@@ -91,6 +91,7 @@ fnvshmem_get_uid = None
 fnvshmem_init = None
 fdisagg_mark_send = None
 fdisagg_prepare_recv = None
+fdisagg_query_transfer_done = None
 
 ftranspose_append = None
 fcopy_cache = None
@@ -120,6 +121,7 @@ def set_global_func(head_dim, dtype):
     global fattn_prefill_sliding_window, fattn_decode_sliding_window
     global fmerge_state, fsplit_rotary, fattention_rotary, fcopy_single_page, fcompact_copy
     global fnvshmem_get_uid, fnvshmem_init, fdisagg_mark_send, fdisagg_prepare_recv
+    global fdisagg_query_transfer_done
 
     fclear = tvm.get_global_func("vm.builtin.kv_state_clear")
     fadd_sequence = tvm.get_global_func("vm.builtin.kv_state_add_sequence")
@@ -144,6 +146,9 @@ def set_global_func(head_dim, dtype):
     fnvshmem_init = tvm.get_global_func("runtime.disco.nvshmem.init_nvshmem")
     fdisagg_mark_send = tvm.get_global_func("vm.builtin.kv_cache_disagg_mark_send")
     fdisagg_prepare_recv = tvm.get_global_func("vm.builtin.kv_cache_disagg_prepare_recv")
+    fdisagg_query_transfer_done = tvm.get_global_func(
+        "vm.builtin.kv_cache_disagg_query_transfer_done"
+    )
 
     target = tvm.target.Target.from_device(device)
     builts = []
@@ -688,7 +693,10 @@ def test_paged_attention_kv_cache_transfer(kv_cache_and_config):
             fdisagg_mark_send(kv_cache, seq_id, 0, ShapeTuple(remote_pos_maps[seq_id]), 1)
         for batch in prefill_operation_seq:
             apply_attention(kv_cache, rope_mode, batch, cached_k, cached_v, skip_add_sequence=True)
+        while not fdisagg_query_transfer_done(kv_cache):
+            pass
         device.sync()
+        assert fdisagg_query_transfer_done(kv_cache)
         comm.Barrier()
     else:
         remote_pos_maps = []
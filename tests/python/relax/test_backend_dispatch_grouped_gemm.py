@@ -0,0 +1,94 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-docstring
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.relax.backend import DispatchGroupedGEMM
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+def _get_module(dtype):
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            x: R.Tensor((10, 16), dtype),
+            w: R.Tensor((3, 8, 16), dtype),
+            indptr: R.Tensor((3,), "int64"),
+        ):
+            with R.dataflow():
+                gv = R.grouped_matmul(x, w, indptr)
+                R.output(gv)
+            return gv
+
+    return Module
+
+
+def _reference(x, w, indptr):
+    out = np.zeros((x.shape[0], w.shape[1]), dtype="float32")
+    begin = 0
+    for g, end in enumerate(indptr):
+        out[begin:end] = x[begin:end].astype("float32") @ w[g].T.astype("float32")
+        begin = end
+    return out
+
+
+def test_grouped_matmul_legalize():
+    # the last two rows are past the last group
+    x = np.random.uniform(-1, 1, (10, 16)).astype("float32")
+    w = np.random.uniform(-1, 1, (3, 8, 16)).astype("float32")
+    indptr = np.array([3, 3, 8], dtype="int64")
+
+    ex = tvm.compile(_get_module("float32"), target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    out = vm["main"](
+        tvm.runtime.tensor(x), tvm.runtime.tensor(w), tvm.runtime.tensor(indptr)
+    ).numpy()
+    tvm.testing.assert_allclose(out, _reference(x, w, indptr), rtol=1e-5, atol=1e-5)
+
+
+def test_dispatch_generic_is_unchanged():
+    mod = _get_module("float16")
+    with tvm.target.Target({"kind": "cuda", "arch": "sm_80"}):
+        after = DispatchGroupedGEMM()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+@pytest.mark.skipif(
+    not tvm.get_global_func("cutlass.group_gemm", True), reason="CUTLASS group gemm not enabled"
+)
+def test_dispatch_cutlass():
+    mod = _get_module("float16")
+    with tvm.target.Target({"kind": "cuda", "arch": "sm_90a", "libs": ["cutlass"]}):
+        after = DispatchGroupedGEMM()(mod)
+    calls = []
+    relax.analysis.post_order_visit(
+        after["main"].body,
+        lambda e: calls.append(e) if isinstance(e, relax.Call) else None,
+    )
+    packed = [c for c in calls if isinstance(c.args[0], relax.ExternFunc)]
+    assert [c.args[0].global_symbol for c in packed] == ["cutlass.group_gemm"]
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
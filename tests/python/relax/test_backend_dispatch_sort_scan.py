@@ -22,7 +22,7 @@ import pytest
 import tvm
 import tvm.script
 import tvm.testing
-from tvm import relax, tir, topi
+from tvm import relax, te, tir, topi
 from tvm.contrib.thrust import can_use_thrust
 from tvm.ir.base import assert_structural_equal
 from tvm.relax.backend import DispatchSortScan
@@ -435,5 +435,40 @@ def test_dispatch_cumsum_gpu(target, dev):
         tvm.testing.assert_allclose(cumsum.numpy(), np_cumsum)
 
 
+@tvm.testing.requires_cuda
+@pytest.mark.skipif(
+    tvm.get_global_func("tvm.contrib.thrust.segmented_sort", True) is None,
+    reason="thrust is not enabled",
+)
+@pytest.mark.parametrize("is_ascend", [True, False])
+def test_segmented_sort_thrust(is_ascend):
+    offsets_np = np.array([0, 5, 5, 1000, 1003], dtype="int64")
+    np_data = np.random.uniform(size=(1003,)).astype("float32")
+    data = te.placeholder(np_data.shape, "float32", name="data")
+    offsets = te.placeholder(offsets_np.shape, "int64", name="offsets")
+    workspace = te.placeholder((1 << 20,), "uint8", name="workspace")
+    with tvm.target.Target("cuda"):
+        values, indices = topi.gpu.segmented_sort_thrust(
+            data, offsets, is_ascend, "int32", workspace
+        )
+    f = tvm.compile(te.create_prim_func([data, offsets, workspace, values, indices]), "cuda")
+
+    dev = tvm.cuda()
+    tvm_values = tvm.runtime.empty(np_data.shape, "float32", dev)
+    tvm_indices = tvm.runtime.empty(np_data.shape, "int32", dev)
+    f(
+        tvm.runtime.tensor(np_data, dev),
+        tvm.runtime.tensor(offsets_np, dev),
+        tvm.runtime.empty((1 << 20,), "uint8", dev),
+        tvm_values,
+        tvm_indices,
+    )
+    for begin, end in zip(offsets_np[:-1], offsets_np[1:]):
+        segment = np_data[begin:end]
+        order = np.argsort(segment if is_ascend else -segment, kind="stable")
+        tvm.testing.assert_allclose(tvm_values.numpy()[begin:end], segment[order])
+        tvm.testing.assert_allclose(tvm_indices.numpy()[begin:end], order)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -169,6 +169,53 @@ def test_simple_symbolic_shape():
     assert_structural_equal(after, expected)
 
 
+def test_skip_checks():
+    """Without the checks, only the matches that populate the heap are kept."""
+    MS = MatchShapeCode
+
+    @tvm.script.ir_module
+    class Before:
+        @R.function
+        def main(x: R.Tensor(["n", 2, "m"], "float32"), y: R.Tensor([2, 3], "float32")):
+            R.func_attr({"relax.force_pure": True})
+            return x
+
+    sindex = {
+        "n": 0,
+        "m": 1,
+    }
+
+    @tvm.script.ir_module
+    class Expected:
+        @R.function
+        def main(x: R.Tensor(["n", 2, "m"], "float32"), y: R.Tensor([2, 3], "float32")):
+            R.func_attr({"relax.force_pure": True})
+            shape_heap = R.call_builtin_with_ctx(
+                "vm.builtin.alloc_shape_heap",
+                [R.prim_value(2)],
+                sinfo_args=[R.Tensor(ndim=1, dtype="int64")],
+            )
+            _ = R.call_packed(
+                "vm.builtin.match_shape",
+                x,
+                shape_heap,
+                3,
+                MS.STORE_TO_HEAP,
+                sindex["n"],
+                MS.NO_OP,
+                0,
+                MS.STORE_TO_HEAP,
+                sindex["m"],
+                "",
+                sinfo_args=[R.Tuple()],
+            )
+            return x
+
+    with tvm.transform.PassContext(config={"relax.VMShapeLower.skip_checks": True}):
+        after = relax.transform.VMShapeLower(emit_err_ctx=False)(Before)
+    assert_structural_equal(after, Expected)
+
+
 def test_symbolic_compute():
     MS = MatchShapeCode
     MK = MakeShapeCode
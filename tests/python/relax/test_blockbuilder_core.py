@@ -313,6 +313,28 @@ def test_normalize():
     assert isinstance(tuple_2.struct_info.fields[1].fields[1], rx.TensorStructInfo)
 
 
+def test_normalize_already_normalized():
+    x = rx.Var("x", rx.TensorStructInfo([4], "float32"))
+    bb = rx.BlockBuilder()
+    with bb.function("main", [x]):
+        with bb.dataflow():
+            y = bb.emit(rx.op.add(x, x))
+            z = bb.emit_output(rx.op.multiply(y, x))
+        bb.emit_func_output(z)
+    func = bb.get()["main"]
+
+    # Normalizing again, including within another function, returns the same expressions.
+    assert bb.normalize(func).same_as(func)
+    assert bb.normalize(func.body).same_as(func.body)
+    with bb.function("other", [x]):
+        call = bb.normalize(rx.op.add(x, x))
+        assert bb.normalize(call).same_as(call)
+        assert bb.lookup_binding(func.body.blocks[0].bindings[0].var).same_as(
+            func.body.blocks[0].bindings[0].value
+        )
+        bb.emit_func_output(bb.emit(call))
+
+
 def test_tuple_indexing():
     m = tir.Var("m", "int64")
     n = tir.Var("n", "int64")
@@ -494,15 +494,58 @@ def test_cublas_partition_fp8_matmul_multiply():
     assert len(mod["main"].body.blocks[0].bindings) == 1
 
 
-def test_cublas_partition_matmul_without_bias():
-    # cuBLAS does not handle 2D bias (residual input)
+def test_cublas_partition_matmul_residual():
+    # A 2D bias is not a cuBLAS bias vector, it is added as a residual input
     mod = get_relax_matmul_module((16, 32), (32, 32), "float16", "float16", bias_shape=(16, 32))
     mod = partition_for_cublas(mod)
 
+    assert len(mod["main"].body.blocks[0].bindings) == 1
+    assert "fused_relax_matmul_relax_add_cublas" in mod["main"].script()
+
+
+def test_cublas_partition_matmul_residual_not_same_shape():
+    # A residual broadcast along the rows is neither a bias vector nor a C matrix
+    mod = get_relax_matmul_module((16, 32), (32, 32), "float16", "float16", bias_shape=(16, 1))
+    mod = partition_for_cublas(mod)
+
     # R.add is still in the main function
     assert len(mod["main"].body.blocks[0].bindings) == 2
 
 
+@pytest.mark.parametrize(
+    "with_bias, activation, residual_bin_op",
+    [
+        (False, R.nn.relu, None),
+        (False, R.nn.gelu, None),
+        (False, None, R.add),
+        (True, None, R.add),
+    ],
+)
+@pytest.mark.parametrize("transpose_y", [False, True])
+def test_matmul_epilogue_offload(with_bias, activation, residual_bin_op, transpose_y):
+    # The residual is the lhs, so the output has the shape of the lhs
+    x = np.random.randn(16, 32).astype("float16")
+    y = np.random.randn(32, 32).astype("float16")
+    bias = np.random.randn(32).astype("float16")
+    args = (x, y, bias) if with_bias else (x, y)
+
+    mod = get_relax_matmul_module(
+        (16, 32),
+        (32, 32),
+        "float16",
+        bias_shape=(32,) if with_bias else None,
+        transposed_y=transpose_y,
+        activation=activation,
+        residual_bin_op=residual_bin_op,
+    )
+    assert len(partition_for_cublas(mod)["main"].body.blocks[0].bindings) == 1
+
+    out = get_result_with_relax_cublas_offload(mod, args)
+    ref = build_and_run(mod, args, "llvm", legalize=True)
+
+    tvm.testing.assert_allclose(out, ref, rtol=1e-2, atol=1e-2)
+
+
 @pytest.mark.parametrize(
     "M, N, K, was_partitioned", [(16, 8, 32, True), (16, 8, 33, False), (16, 9, 32, False)]
 )
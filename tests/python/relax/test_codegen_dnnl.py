@@ -92,5 +92,29 @@ def test_dnnl_offload():
     tvm.testing.assert_allclose(out, ref, rtol=1e-3, atol=1e-3)
 
 
+def test_dnnl_offload_repeated_calls():
+    # The intermediate buffers of the DNNL runtime are reused across the calls.
+    pat = make_fused_bias_activation_pattern(
+        "relax.nn.conv2d", with_bias=False, activation="relax.nn.relu"
+    )
+    seq = tvm.transform.Sequential(
+        [
+            relax.transform.FuseOpsByPattern([("dnnl.conv2d_relu", pat)]),
+            relax.transform.MergeCompositeFunctions(),
+            relax.transform.RunCodegen(),
+        ]
+    )
+    dev = tvm.cpu()
+    vm = relax.VirtualMachine(tvm.compile(seq(Conv2dReLUx2), "llvm"), dev)
+    weights = [np.random.randn(64, 64, 3, 3).astype("float32") for _ in range(2)]
+
+    for _ in range(3):
+        data_np = np.random.randn(1, 64, 56, 56).astype("float32")
+        inputs = [data_np] + weights
+        ref = build_and_run(Conv2dReLUx2, inputs, legalize=True)
+        out = vm["main"](*[tvm.runtime.tensor(inp, dev) for inp in inputs]).numpy()
+        tvm.testing.assert_allclose(out, ref, rtol=1e-3, atol=1e-3)
+
+
 if __name__ == "__main__":
-    test_dnnl_offload()
+    tvm.testing.main()
@@ -21,6 +21,7 @@ import pytest
 import tvm
 import tvm.testing
 from tvm import relax
+from tvm.contrib import tensorrt
 from tvm.contrib.pickle_memoize import memoize
 from tvm.relax.dpl import is_op, make_fused_bias_activation_pattern, wildcard
 from tvm.script import relax as R
@@ -112,5 +113,29 @@ def test_tensorrt_offload():
     tvm.testing.assert_allclose(out, ref, rtol=1e-3, atol=1e-3)
 
 
+def test_tensorrt_engine_cache(tmp_path):
+    mod = tvm.transform.Sequential(
+        [
+            relax.transform.FuseOpsByPattern(
+                [("tensorrt.nn.relu", is_op("relax.nn.relu")(wildcard()))]
+            ),
+            relax.transform.MergeCompositeFunctions(),
+            relax.transform.RunCodegen(),
+        ]
+    )(Conv2dResidualBlock)
+    dev = tvm.cuda(0)
+    ex = tvm.compile(mod, "cuda")
+    inputs = [
+        tvm.runtime.tensor(np.random.randn(*shape).astype("float32"), dev)
+        for shape in [(1, 64, 56, 56), (64, 64, 3, 3), (64, 64, 3, 3)]
+    ]
+
+    plans = tensorrt.build_engine_cache(
+        relax.VirtualMachine(ex, dev)["main"], [inputs], str(tmp_path)
+    )
+    assert len(plans) > 0
+    assert all(plan.endswith("_b1.plan") for plan in plans)
+
+
 if __name__ == "__main__":
-    test_tensorrt_offload()
+    tvm.testing.main()
@@ -643,5 +643,142 @@ def test_dynamic_mismatch():
     tvm.ir.assert_structural_equal(new_mod, DynamicMistmatchTestCase)
 
 
+def test_inplace_call_tir():
+    @I.ir_module
+    class Before:
+        @T.prim_func(private=True)
+        def fused_add_relu(
+            A: T.Buffer((2, 3), "float32"),
+            B: T.Buffer((2, 3), "float32"),
+            C: T.Buffer((2, 3), "float32"),
+        ):
+            T.func_attr({"tir.noalias": True})
+            T_add = T.alloc_buffer((2, 3))
+            for ax0, ax1 in T.grid(2, 3):
+                with T.sblock("T_add"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    T_add[v_ax0, v_ax1] = A[v_ax0, v_ax1] + B[v_ax0, v_ax1]
+            for ax0, ax1 in T.grid(2, 3):
+                with T.sblock("T_relu"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    C[v_ax0, v_ax1] = T.max(T_add[v_ax0, v_ax1], T.float32(0))
+
+        @R.function
+        def main(x: R.Tensor((2, 3), "float32"), y: R.Tensor((2, 3), "float32")):
+            cls = Before
+            with R.dataflow():
+                # cannot be done in-place: x and y are arguments
+                z = R.call_tir(cls.fused_add_relu, (x, y), out_sinfo=R.Tensor((2, 3), "float32"))
+                v = R.reshape(z, R.shape([2, 3]))  # a view of z
+                # cannot be done in-place: v is a view of z, which is used later
+                w = R.call_tir(cls.fused_add_relu, (v, y), out_sinfo=R.Tensor((2, 3), "float32"))
+                # can be done in-place into w: w is not used later
+                u = R.call_tir(cls.fused_add_relu, (w, z), out_sinfo=R.Tensor((2, 3), "float32"))
+                out = (u, z)
+                R.output(out)
+            return out
+
+    block = Before["main"].body.blocks[0]
+    size_match, exact_match = dataflow_inplace_analysis(block, [], Before)
+    assert size_match == [(3, {0})]
+    assert exact_match == [(3, {0})]
+
+    @I.ir_module
+    class Expected:
+        @T.prim_func(private=True)
+        def fused_add_relu(
+            A: T.Buffer((2, 3), "float32"),
+            B: T.Buffer((2, 3), "float32"),
+            C: T.Buffer((2, 3), "float32"),
+        ):
+            T.func_attr({"tir.noalias": True})
+            T_add = T.alloc_buffer((2, 3))
+            for ax0, ax1 in T.grid(2, 3):
+                with T.sblock("T_add"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    T_add[v_ax0, v_ax1] = A[v_ax0, v_ax1] + B[v_ax0, v_ax1]
+            for ax0, ax1 in T.grid(2, 3):
+                with T.sblock("T_relu"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    C[v_ax0, v_ax1] = T.max(T_add[v_ax0, v_ax1], T.float32(0))
+
+        @T.prim_func(private=True)
+        def fused_add_relu_inplace(A: T.Buffer((2, 3), "float32"), B: T.Buffer((2, 3), "float32")):
+            T.func_attr({"tir.noalias": True})
+            T_add = T.alloc_buffer((2, 3))
+            for ax0, ax1 in T.grid(2, 3):
+                with T.sblock("T_add"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    T_add[v_ax0, v_ax1] = A[v_ax0, v_ax1] + B[v_ax0, v_ax1]
+            for ax0, ax1 in T.grid(2, 3):
+                with T.sblock("T_relu"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    A[v_ax0, v_ax1] = T.max(T_add[v_ax0, v_ax1], T.float32(0))
+
+        @R.function
+        def main(x: R.Tensor((2, 3), "float32"), y: R.Tensor((2, 3), "float32")):
+            cls = Expected
+            with R.dataflow():
+                z = R.call_tir(cls.fused_add_relu, (x, y), out_sinfo=R.Tensor((2, 3), "float32"))
+                v = R.reshape(z, R.shape([2, 3]))
+                w = R.call_tir(cls.fused_add_relu, (v, y), out_sinfo=R.Tensor((2, 3), "float32"))
+                u = R.call_tir_inplace(
+                    cls.fused_add_relu_inplace,
+                    (w, z),
+                    inplace_indices=[0],
+                    out_sinfo=R.Tensor((2, 3), "float32"),
+                )
+                out = (u, z)
+                R.output(out)
+            return out
+
+    new_mod = DataflowUseInplaceCalls()(Before)
+    tvm.ir.assert_structural_equal(new_mod, Expected)
+
+    x = np.random.uniform(-1, 1, (2, 3)).astype("float32")
+    y = np.random.uniform(-1, 1, (2, 3)).astype("float32")
+    z = np.maximum(x + y, 0)
+    w = np.maximum(z + y, 0)
+    u = np.maximum(w + z, 0)
+
+    ex = tvm.compile(new_mod, tvm.target.Target("llvm"))
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    res = vm["main"](tvm.runtime.tensor(x), tvm.runtime.tensor(y))
+    np.testing.assert_allclose(res[0].numpy(), u, rtol=1e-6)
+    np.testing.assert_allclose(res[1].numpy(), z, rtol=1e-6)
+
+
+def test_inplace_call_tir_not_elementwise():
+    @I.ir_module
+    class TransposedAdd:
+        @T.prim_func(private=True)
+        def add_transposed(
+            A: T.Buffer((3, 3), "float32"),
+            B: T.Buffer((3, 3), "float32"),
+            C: T.Buffer((3, 3), "float32"),
+        ):
+            T.func_attr({"tir.noalias": True})
+            for ax0, ax1 in T.grid(3, 3):
+                with T.sblock("T_add"):
+                    v_ax0, v_ax1 = T.axis.remap("SS", [ax0, ax1])
+                    C[v_ax0, v_ax1] = A[v_ax1, v_ax0] + B[v_ax0, v_ax1]
+
+        @R.function
+        def main(x: R.Tensor((3, 3), "float32"), y: R.Tensor((3, 3), "float32")):
+            cls = TransposedAdd
+            with R.dataflow():
+                z = R.call_tir(cls.add_transposed, (x, y), out_sinfo=R.Tensor((3, 3), "float32"))
+                # cannot be done in-place: z is also read transposed
+                w = R.call_tir(cls.add_transposed, (z, z), out_sinfo=R.Tensor((3, 3), "float32"))
+                # can be done in-place into w: it is read at the element written
+                u = R.call_tir(cls.add_transposed, (y, w), out_sinfo=R.Tensor((3, 3), "float32"))
+                R.output(u)
+            return u
+
+    block = TransposedAdd["main"].body.blocks[0]
+    _, exact_match = dataflow_inplace_analysis(block, [], TransposedAdd)
+    assert exact_match == [(2, {1})]
+
+
 if __name__ == "__main__":
     testing.main()
@@ -17,6 +17,7 @@
 # pylint: disable=missing-docstring, invalid-name
 # ruff: noqa: E501, F841
 import numpy as np
+import pytest
 
 import tvm
 import tvm.testing
@@ -1249,6 +1250,136 @@ def test_renormalize_top_p_top_k_prob():
     )
 
 
+def test_batched_sampling_preprocess():
+    batch_size, vocab_size, num_token = 2, 4, 3
+
+    class Model(Module):
+        def foo(
+            self,
+            logits: Tensor,
+            pos2seq_id: Tensor,
+            token_ids: Tensor,
+            token_cnt: Tensor,
+            penalties: Tensor,
+            temperature: Tensor,
+            min_p: Tensor,
+        ):
+            logits = op.apply_penalty_inplace(logits, pos2seq_id, token_ids, token_cnt, penalties)
+            prob = op.softmax_with_temperature(logits, temperature)
+            return op.renormalize_min_p_prob(prob, min_p)
+
+    m = Model()
+    mod, _ = m.export_tvm(
+        spec={
+            "foo": {
+                "logits": spec.Tensor((batch_size, vocab_size), "float32"),
+                "pos2seq_id": spec.Tensor((num_token,), "int32"),
+                "token_ids": spec.Tensor((num_token,), "int32"),
+                "token_cnt": spec.Tensor((num_token,), "int32"),
+                "penalties": spec.Tensor((batch_size, 3), "float32"),
+                "temperature": spec.Tensor((batch_size, 1), "float32"),
+                "min_p": spec.Tensor((batch_size, 1), "float32"),
+            }
+        },
+        debug=True,
+    )
+
+    ex = tvm.compile(mod, "llvm")
+    dev = tvm.cpu()
+    vm = relax.VirtualMachine(ex, dev)
+    effects = vm["_initialize_effect"]()
+
+    logits_np = np.array([[1.0, 2.0, -1.0, 0.5], [0.0, 1.0, 3.0, 2.0]], dtype=np.float32)
+    pos2seq_id_np = np.array([0, 0, 1], dtype=np.int32)
+    token_ids_np = np.array([1, 2, 2], dtype=np.int32)
+    token_cnt_np = np.array([2, 1, 1], dtype=np.int32)
+    penalties_np = np.array([[0.1, 0.2, 2.0], [0.0, 0.0, 1.0]], dtype=np.float32)
+    temperature_np = np.array([[0.7], [0.0]], dtype=np.float32)
+    min_p_np = np.array([[0.2], [0.0]], dtype=np.float32)
+
+    expected = logits_np.copy()
+    for seq_id, token_id, cnt in zip(pos2seq_id_np, token_ids_np, token_cnt_np):
+        presence, frequency, repetition = penalties_np[seq_id]
+        expected[seq_id, token_id] -= presence + cnt * frequency
+        if expected[seq_id, token_id] <= 0:
+            expected[seq_id, token_id] *= repetition
+        else:
+            expected[seq_id, token_id] /= repetition
+    expected = expected / np.maximum(temperature_np, 1e-5)
+    expected = np.exp(expected - expected.max(axis=1, keepdims=True))
+    expected = expected / expected.sum(axis=1, keepdims=True)
+    expected = np.where(expected >= expected.max(axis=1, keepdims=True) * min_p_np, expected, 0)
+    expected = expected / expected.sum(axis=1, keepdims=True)
+
+    inputs = [
+        tvm.runtime.tensor(x, dev)
+        for x in [
+            logits_np,
+            pos2seq_id_np,
+            token_ids_np,
+            token_cnt_np,
+            penalties_np,
+            temperature_np,
+            min_p_np,
+        ]
+    ]
+    res = vm["foo"](*inputs, effects)
+    tvm.testing.assert_allclose(res[0].numpy(), expected, rtol=1e-5, atol=1e-6)
+
+
+def test_apply_bitmask_inplace():
+    batch_size, vocab_size, num_seq = 3, 40, 2
+
+    class Model(Module):
+        def foo(self, logits: Tensor, seq_ids: Tensor, bitmask: Tensor, temperature: Tensor):
+            logits = op.apply_bitmask_inplace(logits, seq_ids, bitmask)
+            return op.softmax_with_temperature(logits, temperature)
+
+    m = Model()
+    mod, _ = m.export_tvm(
+        spec={
+            "foo": {
+                "logits": spec.Tensor((batch_size, vocab_size), "float32"),
+                "seq_ids": spec.Tensor((num_seq,), "int32"),
+                "bitmask": spec.Tensor((num_seq, (vocab_size + 31) // 32), "int32"),
+                "temperature": spec.Tensor((batch_size, 1), "float32"),
+            }
+        },
+        debug=True,
+    )
+
+    ex = tvm.compile(mod, "llvm")
+    dev = tvm.cpu()
+    vm = relax.VirtualMachine(ex, dev)
+    effects = vm["_initialize_effect"]()
+
+    logits_np = np.random.uniform(-1, 1, size=(batch_size, vocab_size)).astype("float32")
+    seq_ids_np = np.array([2, 0], dtype=np.int32)
+    allowed = np.random.uniform(size=(num_seq, vocab_size)) < 0.5
+    allowed[:, 31] = True
+    allowed[:, 32] = False
+    padded = np.zeros((num_seq, 64), dtype=np.uint32)
+    padded[:, :vocab_size] = allowed
+    bitmask_np = (padded.reshape(num_seq, 2, 32) << np.arange(32, dtype=np.uint32)).sum(
+        axis=-1, dtype=np.uint32
+    )
+    temperature_np = np.ones((batch_size, 1), dtype=np.float32)
+
+    expected = logits_np.copy()
+    for i, seq_id in enumerate(seq_ids_np):
+        expected[seq_id] = np.where(allowed[i], expected[seq_id], np.finfo("float32").min)
+    expected = np.exp(expected - expected.max(axis=1, keepdims=True))
+    expected = expected / expected.sum(axis=1, keepdims=True)
+
+    inputs = [
+        tvm.runtime.tensor(x, dev)
+        for x in [logits_np, seq_ids_np, bitmask_np.view(np.int32), temperature_np]
+    ]
+    res = vm["foo"](*inputs, effects)
+    tvm.testing.assert_allclose(res[0].numpy(), expected, rtol=1e-5, atol=1e-6)
+    assert (res[0].numpy()[seq_ids_np][~allowed] == 0).all()
+
+
 def test_sort_argsort_topk():
     class Model(Module):
         def foo(self, x: Tensor):
@@ -1278,5 +1409,139 @@ def test_sort_argsort_topk():
     tvm.ir.assert_structural_equal(mod, Expected)
 
 
+
+@pytest.mark.parametrize("causal", [False, True])
+def test_ring_attn_single_worker(causal):
+    from tvm.relax.frontend.nn.llm import ring_attn  # pylint: disable=import-outside-toplevel
+
+    b, s, h_q, h_kv, d = 2, 8, 4, 2, 16
+    target = tvm.target.Target("llvm")
+
+    class Model(Module):
+        def foo(self, q: Tensor, k: Tensor, v: Tensor):
+            return ring_attn(q, k, v, num_workers=1, target=target, causal=causal)
+
+    mod, _ = Model().export_tvm(
+        spec={
+            "foo": {
+                "q": spec.Tensor((b, s, h_q, d), "float32"),
+                "k": spec.Tensor((b, s, h_kv, d), "float32"),
+                "v": spec.Tensor((b, s, h_kv, d), "float32"),
+            }
+        },
+    )
+    vm = relax.VirtualMachine(tvm.compile(mod, target), tvm.cpu())
+
+    q_np = np.random.uniform(-1, 1, (b, s, h_q, d)).astype("float32")
+    k_np = np.random.uniform(-1, 1, (b, s, h_kv, d)).astype("float32")
+    v_np = np.random.uniform(-1, 1, (b, s, h_kv, d)).astype("float32")
+    inputs = [tvm.runtime.tensor(x) for x in [q_np, k_np, v_np]]
+    output = vm["foo"](*inputs).numpy()
+
+    k_rep = np.repeat(k_np, h_q // h_kv, axis=2)
+    v_rep = np.repeat(v_np, h_q // h_kv, axis=2)
+    scores = np.einsum("bqhd,bkhd->bhqk", q_np, k_rep) / np.sqrt(d)
+    if causal:
+        scores = np.where(np.tril(np.ones((s, s), dtype=bool)), scores, -np.inf)
+    probs = np.exp(scores - scores.max(axis=-1, keepdims=True))
+    probs = probs / probs.sum(axis=-1, keepdims=True)
+    expected = np.einsum("bhqk,bkhd->bqhd", probs, v_rep)
+    tvm.testing.assert_allclose(output, expected, rtol=1e-4, atol=1e-4)
+
+
+def test_ring_attn_overlaps_exchange_with_attention():
+    from tvm.relax.frontend.nn.llm import ring_attn  # pylint: disable=import-outside-toplevel
+
+    class Model(Module):
+        def foo(self, q: Tensor, k: Tensor, v: Tensor):
+            return ring_attn(q, k, v, num_workers=2, target=tvm.target.Target("llvm"))
+
+    mod, _ = Model().export_tvm(
+        spec={
+            "foo": {
+                "q": spec.Tensor((1, 8, 2, 16), "float32"),
+                "k": spec.Tensor((1, 8, 2, 16), "float32"),
+                "v": spec.Tensor((1, 8, 2, 16), "float32"),
+            }
+        },
+    )
+    ops = []
+    for binding in mod["foo"].body.blocks[0].bindings:
+        value = binding.value
+        if isinstance(value, relax.Call) and isinstance(value.op, tvm.ir.Op):
+            if value.op.name.startswith("relax.ccl."):
+                ops.append(value.op.name)
+            elif value.op.name == "relax.call_tir" and "prefill" in value.args[0].name_hint:
+                ops.append("prefill")
+    # The exchange of the keys and values is in flight during the attention of the first step.
+    assert ops == [
+        "relax.ccl.ring_send_recv_start",
+        "relax.ccl.ring_send_recv_start",
+        "prefill",
+        "relax.ccl.ring_send_recv_wait",
+        "relax.ccl.ring_send_recv_wait",
+        "prefill",
+    ]
+
+
+def test_lora_bgmv_with_adapter_pool():
+    from tvm.relax.frontend.nn.llm import lora_bgmv  # pylint: disable=import-outside-toplevel
+
+    num_slots, rank, d_in, d_out = 2, 4, 32, 16
+    f_create = tvm.get_global_func("vm.builtin.lora_adapter_pool_create")
+    f_load = tvm.get_global_func("vm.builtin.lora_adapter_pool_load")
+    f_lookup = tvm.get_global_func("vm.builtin.lora_adapter_pool_lookup")
+    f_get_weights = tvm.get_global_func("vm.builtin.lora_adapter_pool_get_weights")
+
+    class Model(Module):
+        def foo(self, x: Tensor, adapter_ids: Tensor, lora_a: Tensor, lora_b: Tensor):
+            return lora_bgmv(x, adapter_ids, lora_a, lora_b, scaling=0.5)
+
+    mod, _ = Model().export_tvm(
+        spec={
+            "foo": {
+                "x": spec.Tensor((1, "n", d_in), "float32"),
+                "adapter_ids": spec.Tensor(("n",), "int32"),
+                "lora_a": spec.Tensor((num_slots, rank, d_in), "float32"),
+                "lora_b": spec.Tensor((num_slots, d_out, rank), "float32"),
+            }
+        },
+    )
+    vm = relax.VirtualMachine(tvm.compile(mod, "llvm"), tvm.cpu())
+
+    weight_shapes = [tvm.runtime.ShapeTuple((rank, d_in)), tvm.runtime.ShapeTuple((d_out, rank))]
+    pool = f_create(num_slots, weight_shapes, "float32", tvm.cpu())
+    adapters = {
+        name: [
+            np.random.uniform(-1, 1, (rank, d_in)).astype("float32"),
+            np.random.uniform(-1, 1, (d_out, rank)).astype("float32"),
+        ]
+        for name in ["a", "b", "c"]
+    }
+    for name in ["a", "b"]:
+        f_load(pool, name, [tvm.runtime.tensor(w) for w in adapters[name]])
+    f_lookup(pool, ["b"])
+    # The pool is full, and "a" is the adapter least recently used.
+    f_load(pool, "c", [tvm.runtime.tensor(w) for w in adapters["c"]])
+
+    requests = ["c", "", "b", "c"]
+    slots = f_lookup(pool, requests)
+    lengths = [3, 1, 2, 2]
+    adapter_ids = np.repeat(np.array(list(slots), dtype="int32"), lengths)
+    x_np = np.random.uniform(-1, 1, (1, sum(lengths), d_in)).astype("float32")
+    lora_a, lora_b = f_get_weights(pool)
+    output = vm["foo"](
+        tvm.runtime.tensor(x_np), tvm.runtime.tensor(adapter_ids), lora_a, lora_b
+    ).numpy()
+
+    token_adapters = np.repeat(np.array(requests), lengths)
+    expected = np.zeros((1, sum(lengths), d_out), "float32")
+    for i, name in enumerate(token_adapters):
+        if name:
+            a, b = adapters[name]
+            expected[0, i] = 0.5 * (b @ (a @ x_np[0, i]))
+    tvm.testing.assert_allclose(output, expected, rtol=1e-5, atol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
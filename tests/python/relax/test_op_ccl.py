@@ -29,6 +29,12 @@ def test_op_correctness():
     assert relax.op.ccl.allreduce(x).op == Op.get("relax.ccl.allreduce")
     assert relax.op.ccl.broadcast_from_worker0(x).op == Op.get("relax.ccl.broadcast_from_worker0")
     assert relax.op.ccl.allgather(x, 2).op == Op.get("relax.ccl.allgather")
+    assert relax.op.ccl.reduce_scatter(x, 2).op == Op.get("relax.ccl.reduce_scatter")
+    assert relax.op.ccl.all_to_all(x, 2).op == Op.get("relax.ccl.all_to_all")
+    assert relax.op.ccl.moe_dispatch(x, 2).op == Op.get("relax.ccl.moe_dispatch")
+    assert relax.op.ccl.moe_combine(x, 2).op == Op.get("relax.ccl.moe_combine")
+    assert relax.op.ccl.ring_send_recv_start(x).op == Op.get("relax.ccl.ring_send_recv_start")
+    assert relax.op.ccl.ring_send_recv_wait(x, x, x).op == Op.get("relax.ccl.ring_send_recv_wait")
 
 
 def _check_inference(bb: relax.BlockBuilder, call: relax.Call, expected_sinfo: relax.StructInfo):
@@ -142,6 +148,127 @@ def test_allgather_infer_struct_info_more_input_dtype():
     _check_inference(bb, relax.op.ccl.allgather(x2, 2), relax.TensorStructInfo((4, 3), "int64"))
 
 
+def test_reduce_scatter_infer_struct_info():
+    bb = relax.BlockBuilder()
+    x0 = relax.Var("x", R.Tensor((4, 3), "float32"))
+    x1 = relax.Var("x", R.Tensor("float32", ndim=3))
+    x2 = relax.Var("x", R.Tensor("float32", ndim=-1))
+    x3 = relax.Var("x", R.Tensor((6, 4)))
+
+    _check_inference(
+        bb, relax.op.ccl.reduce_scatter(x0, 2), relax.TensorStructInfo((2, 3), "float32")
+    )
+    _check_inference(
+        bb,
+        relax.op.ccl.reduce_scatter(x0, 4, "max"),
+        relax.TensorStructInfo((1, 3), "float32"),
+    )
+    _check_inference(
+        bb, relax.op.ccl.reduce_scatter(x1, 2), relax.TensorStructInfo(dtype="float32", ndim=3)
+    )
+    _check_inference(
+        bb, relax.op.ccl.reduce_scatter(x2, 2), relax.TensorStructInfo(dtype="float32")
+    )
+    _check_inference(
+        bb, relax.op.ccl.reduce_scatter(x3, 3), relax.TensorStructInfo((2, 4), dtype="")
+    )
+
+
+def test_reduce_scatter_infer_struct_info_shape_symbolic():
+    bb = relax.BlockBuilder()
+    m = tir.Var("m", "int64")
+    n = tir.Var("n", "int64")
+    x0 = relax.Var("x", R.Tensor((m, n), "float32"))
+    x1 = relax.Var("x", R.Tensor((4, n), "float32"))
+
+    _check_inference(
+        bb,
+        relax.op.ccl.reduce_scatter(x0, 2),
+        relax.TensorStructInfo((tir.div(m, 2), n), "float32"),
+    )
+    _check_inference(
+        bb, relax.op.ccl.reduce_scatter(x1, 2), relax.TensorStructInfo((2, n), "float32")
+    )
+
+
+def test_reduce_scatter_infer_struct_info_wrong_input():
+    bb = relax.BlockBuilder()
+    x0 = relax.Var("x", R.Tensor((3, 4), "float32"))
+
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.ccl.reduce_scatter(x0, 2))
+    with pytest.raises(AssertionError):
+        relax.op.ccl.reduce_scatter(x0, 3, "mean")
+
+
+def test_all_to_all_infer_struct_info():
+    bb = relax.BlockBuilder()
+    m = tir.Var("m", "int64")
+    x0 = relax.Var("x", R.Tensor((4, 3), "float32"))
+    x1 = relax.Var("x", R.Tensor((m, 3), "float16"))
+    x2 = relax.Var("x", R.Tensor("float32", ndim=-1))
+    x3 = relax.Var("x", R.Tensor((3, 4), "float32"))
+
+    _check_inference(bb, relax.op.ccl.all_to_all(x0, 2), relax.TensorStructInfo((4, 3), "float32"))
+    _check_inference(bb, relax.op.ccl.all_to_all(x1, 2), relax.TensorStructInfo((m, 3), "float16"))
+    _check_inference(bb, relax.op.ccl.all_to_all(x2, 2), relax.TensorStructInfo(dtype="float32"))
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.ccl.all_to_all(x3, 2))
+
+
+def test_moe_dispatch_combine_infer_struct_info():
+    bb = relax.BlockBuilder()
+    m = tir.Var("m", "int64")
+    x0 = relax.Var("x", R.Tensor((4, 3, 8), "float32"))
+    x1 = relax.Var("x", R.Tensor((4, m, 8), "float16"))
+    x2 = relax.Var("x", R.Tensor("float32", ndim=3))
+    x3 = relax.Var("x", R.Tensor((3, 4, 8), "float32"))
+    x4 = relax.Var("x", R.Tensor((4,), "float32"))
+
+    _check_inference(
+        bb, relax.op.ccl.moe_dispatch(x0, 2), relax.TensorStructInfo((2, 6, 8), "float32")
+    )
+    _check_inference(
+        bb, relax.op.ccl.moe_dispatch(x1, 2), relax.TensorStructInfo((2, m * 2, 8), "float16")
+    )
+    _check_inference(
+        bb, relax.op.ccl.moe_dispatch(x2, 2), relax.TensorStructInfo(dtype="float32", ndim=3)
+    )
+    _check_inference(
+        bb, relax.op.ccl.moe_combine(x0, 3), relax.TensorStructInfo((12, 1, 8), "float32")
+    )
+    _check_inference(
+        bb, relax.op.ccl.moe_combine(x3, 2), relax.TensorStructInfo((6, 2, 8), "float32")
+    )
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.ccl.moe_dispatch(x3, 2))
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.ccl.moe_combine(x0, 2))
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.ccl.moe_dispatch(x4, 2))
+
+
+def test_ring_send_recv_infer_struct_info():
+    bb = relax.BlockBuilder()
+    m = tir.Var("m", "int64")
+    x0 = relax.Var("x", R.Tensor((4, 3), "float32"))
+    x1 = relax.Var("x", R.Tensor((m, 3), "float16"))
+    after = relax.Var("after", R.Tensor((2, 2), "float32"))
+
+    _check_inference(
+        bb, relax.op.ccl.ring_send_recv_start(x0), relax.TensorStructInfo((4, 3), "float32")
+    )
+    _check_inference(
+        bb, relax.op.ccl.ring_send_recv_start(x1), relax.TensorStructInfo((m, 3), "float16")
+    )
+    recv = relax.Var("recv", R.Tensor((m, 3), "float16"))
+    _check_inference(
+        bb,
+        relax.op.ccl.ring_send_recv_wait(x1, recv, after),
+        relax.TensorStructInfo((m, 3), "float16"),
+    )
+
+
 def test_broadcast_from_worker0_infer_struct_info():
     bb = relax.BlockBuilder()
     x0 = relax.Var("x", R.Tensor((2, 3), "float32"))
@@ -338,5 +338,43 @@ def test_einsum_infer_struct_info_wrong_inputs():
         bb.normalize(relax.op.einsum(x1, subscripts="ijk"))
 
 
+def test_grouped_matmul_infer_struct_info():
+    bb = relax.BlockBuilder()
+    m = tir.Var("m", "int64")
+    x0 = relax.Var("x", R.Tensor((m, 16), "float16"))
+    x1 = relax.Var("x", R.Tensor("float16", ndim=2))
+    w0 = relax.Var("w", R.Tensor((4, 32, 16), "float16"))
+    indptr0 = relax.Var("indptr", R.Tensor((4,), "int64"))
+
+    _check_inference(
+        bb, relax.op.grouped_matmul(x0, w0, indptr0), relax.TensorStructInfo((m, 32), "float16")
+    )
+    _check_inference(
+        bb,
+        relax.op.grouped_matmul(x1, w0, indptr0),
+        relax.TensorStructInfo(dtype="float16", ndim=2),
+    )
+
+
+def test_grouped_matmul_infer_struct_info_wrong_inputs():
+    bb = relax.BlockBuilder()
+    x0 = relax.Var("x", R.Tensor((8, 16), "float16"))
+    w0 = relax.Var("w", R.Tensor((4, 32, 16), "float16"))
+    w1 = relax.Var("w", R.Tensor((4, 32, 8), "float16"))
+    w2 = relax.Var("w", R.Tensor((32, 16), "float16"))
+    indptr0 = relax.Var("indptr", R.Tensor((4,), "int64"))
+    indptr1 = relax.Var("indptr", R.Tensor((3,), "int64"))
+    indptr2 = relax.Var("indptr", R.Tensor((4,), "float32"))
+
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.grouped_matmul(x0, w1, indptr0))
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.grouped_matmul(x0, w2, indptr0))
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.grouped_matmul(x0, w0, indptr1))
+    with pytest.raises(TVMError):
+        bb.normalize(relax.op.grouped_matmul(x0, w0, indptr2))
+
+
 if __name__ == "__main__":
     tvm.testing.main()
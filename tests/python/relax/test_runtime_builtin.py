@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 # ruff: noqa: F401
+import json
+
 import numpy as np
 import pytest
 
@@ -23,6 +25,7 @@ import tvm.testing
 from tvm.contrib import tvmjs, utils
 from tvm.ir import assert_structural_equal
 from tvm.relax.testing.runtime_builtin import MakeShapeCode, MatchShapeCode
+from tvm.runtime.vm import VMFuture
 
 
 def test_make_shape():
@@ -213,6 +216,120 @@ def test_tensor_cache_update():
         tvm.testing.assert_allclose(v.numpy(), v_np, atol=1e-6, rtol=1e-6)
 
 
+def test_tensor_cache_shared_weights():
+    fload = tvm.get_global_func("vm.builtin.tensor_cache.load")
+    fclear = tvm.get_global_func("vm.builtin.tensor_cache.clear")
+    fget_params = tvm.get_global_func("vm.builtin.param_array_from_cache")
+    fset_enabled = tvm.get_global_func("vm.builtin.weight_store.set_enabled")
+    fnum_bytes = tvm.get_global_func("vm.builtin.weight_store.num_bytes")
+
+    base = np.random.uniform(size=[64, 64]).astype("float32")
+    param_dicts = [
+        {"x_0": base, "x_1": np.random.uniform(size=[64]).astype("float32")},
+        {"x_0": base, "x_1": np.random.uniform(size=[64]).astype("float32")},
+    ]
+    fset_enabled(True)
+    try:
+        params = []
+        for param_dict in param_dicts:
+            temp = utils.tempdir()
+            tvmjs.dump_tensor_cache(param_dict, temp.path, encode_format="raw")
+            fload(str(temp.path), tvm.cpu().dlpack_device_type(), 0)
+            params.append(fget_params("x", -1))
+            fclear()
+        # The base weight is stored once, and only the distinct weights are added.
+        assert fnum_bytes() == (64 * 64 + 64 * 2) * 4
+        for param_dict, res in zip(param_dicts, params):
+            for i, v in enumerate(res):
+                tvm.testing.assert_allclose(v.numpy(), param_dict[f"x_{i}"])
+        # The weights that no cache or VM holds are released on the next load.
+        params.clear()
+        fload(str(temp.path), tvm.cpu().dlpack_device_type(), 0)
+        assert fnum_bytes() == (64 * 64 + 64) * 4
+    finally:
+        fclear()
+        fset_enabled(False)
+
+
+def test_tensor_cache_load_pipelined():
+    fload = tvm.get_global_func("vm.builtin.tensor_cache.load_pipelined")
+    fclear = tvm.get_global_func("vm.builtin.tensor_cache.clear")
+    fget_params = tvm.get_global_func("vm.builtin.param_array_from_cache")
+
+    param_dict = {
+        "x_0": np.array([1, 2, 3], dtype="int32"),
+        "x_1": np.random.uniform(size=[512, 512]).astype("float32"),
+        "x_2": np.random.uniform(size=[512, 512]).astype("float32"),
+        "x_3": np.random.uniform(size=[512, 512]).astype("float32"),
+    }
+
+    temp = utils.tempdir()
+    tvmjs.dump_tensor_cache(param_dict, temp.path, encode_format="f32-to-bf16", shard_cap_mb=1)
+    progress = []
+    fclear()
+    fload(
+        str(temp.path),
+        tvm.cpu().dlpack_device_type(),
+        0,
+        lambda loaded, total: progress.append((loaded, total)),
+    )
+    assert len(progress) > 1
+    assert all(lhs[0] < rhs[0] for lhs, rhs in zip(progress[:-1], progress[1:]))
+    assert progress[-1][0] == progress[-1][1]
+    res = fget_params("x", -1)
+    for i, v in enumerate(res):
+        v_np = param_dict[f"x_{i}"]
+        if v_np.dtype == "float32":
+            v_np = tvmjs._convert_bf16_to_f32(tvmjs._convert_f32_to_bf16(v_np))
+        tvm.testing.assert_allclose(v.numpy(), v_np, atol=1e-6, rtol=1e-6)
+    fclear()
+
+
+@pytest.mark.skipif(
+    tvm.support.libinfo().get("USE_ZSTD", "OFF") != "ON",
+    reason="TVM is not built with USE_ZSTD",
+)
+def test_tensor_cache_compressed():
+    pytest.importorskip("zstandard")
+    fclear = tvm.get_global_func("vm.builtin.tensor_cache.clear")
+    fget_params = tvm.get_global_func("vm.builtin.param_array_from_cache")
+
+    # The bf16 shard is byte-shuffled and split into chunks, which x_1 straddles.
+    param_dict = {
+        "x_0": np.random.uniform(size=[1024, 1024]).astype("float32"),
+        "x_1": np.random.uniform(size=[1000, 1000]).astype("float32"),
+        "x_2": np.random.uniform(size=[512]).astype("float32"),
+    }
+    expected = [
+        tvmjs._convert_bf16_to_f32(tvmjs._convert_f32_to_bf16(param_dict[f"x_{i}"]))
+        for i in range(3)
+    ]
+    temp = utils.tempdir()
+    tvmjs.dump_tensor_cache(param_dict, temp.path, encode_format="f32-to-bf16", compression="zstd")
+    with open(temp.relpath("tensor-cache.json")) as infile:
+        (shard,) = json.load(infile)["records"]
+    assert shard["compression"]["byteShuffle"] == 2
+    assert len(shard["compression"]["chunks"]) > 1
+
+    loaded, _ = tvmjs.load_tensor_cache(temp.path, tvm.cpu())
+    for i in range(3):
+        tvm.testing.assert_allclose(loaded[f"x_{i}"].numpy(), expected[i])
+
+    for fload in ["vm.builtin.tensor_cache.load", "vm.builtin.tensor_cache.load_pipelined"]:
+        fclear()
+        tvm.get_global_func(fload)(str(temp.path), tvm.cpu().dlpack_device_type(), 0)
+        for i, v in enumerate(fget_params("x", -1)):
+            tvm.testing.assert_allclose(v.numpy(), expected[i])
+    fclear()
+
+    stream = tvm.get_global_func("vm.builtin.tensor_cache.stream_create")(
+        str(temp.path), tvm.cpu().dlpack_device_type(), 0, ["x_1", "x_2", "x_0"], 1
+    )
+    fstream_get = tvm.get_global_func("vm.builtin.tensor_cache.stream_get")
+    for index, i in enumerate([1, 2, 0]):
+        tvm.testing.assert_allclose(fstream_get(stream, index).numpy(), expected[i])
+
+
 def test_attention_kv_cache_window_override():
     fcreate = tvm.get_global_func("vm.builtin.attention_kv_cache_create")
     foverride = tvm.get_global_func("vm.builtin.attention_kv_cache_window_override")
@@ -283,5 +400,23 @@ def test_attention_kv_cache_window_override_with_sinks():
     ).all()
 
 
+def test_host_transfer_ring():
+    fcreate = tvm.get_global_func("vm.builtin.host_transfer_ring_create")
+    fcopy = tvm.get_global_func("vm.builtin.host_transfer_ring_copy")
+    ring = fcreate(2, tvm.cpu())
+
+    arrays = [np.random.rand(4, 8).astype("float32"), np.random.rand(16).astype("float16")]
+    futures = [VMFuture(fcopy(ring, tvm.runtime.tensor(arr))) for arr in arrays]
+    for arr, future in zip(arrays, futures):
+        assert future.done()
+        tvm.testing.assert_allclose(future.wait().numpy(), arr)
+
+    # The third copy reuses the slot of the first, whose buffer grows to fit it.
+    large = np.random.rand(64, 8).astype("float32")
+    future = VMFuture(fcopy(ring, tvm.runtime.tensor(large)))
+    tvm.testing.assert_allclose(future.wait().numpy(), large)
+    tvm.testing.assert_allclose(futures[1].wait().numpy(), arrays[1])
+
+
 if __name__ == "__main__":
     tvm.testing.main()
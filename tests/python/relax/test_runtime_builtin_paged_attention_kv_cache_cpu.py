@@ -162,8 +162,9 @@ def set_global_func(head_dim, dtype):
     ) = builts
 
 
-def create_kv_cache(head_dim, dtype, rope_mode, support_sliding_window):
+def create_kv_cache(head_dim, dtype, rope_mode, support_sliding_window, enable_cuda_graph=False):
     fcreate = tvm.get_global_func("vm.builtin.paged_attention_kv_cache_create")
+    extra_args = [tvm.DataType(dtype), True] if enable_cuda_graph else []
     cache = fcreate(
         tvm.runtime.ShapeTuple(
             [
@@ -201,6 +202,7 @@ def create_kv_cache(head_dim, dtype, rope_mode, support_sliding_window):
         fcopy_single_page,
         fcopy_cache,
         fcompact_copy,
+        *extra_args,
     )
     return cache
 
@@ -753,6 +755,219 @@ def test_paged_attention_kv_cache_popn(kv_cache_and_config):
     assert fis_empty(kv_cache), "The KV cache is not empty after removing all sequences"
 
 
+def test_paged_attention_kv_cache_prefix_cache(kv_cache_and_config):
+    kv_cache, rope_mode, support_sliding_window = kv_cache_and_config
+    if support_sliding_window and rope_mode == RopeMode.NORMAL:
+        return
+    fclear(kv_cache)
+    fadd_sequence_with_prefix_match = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_add_sequence_with_prefix_match"
+    )
+    fcache_prefix = tvm.get_global_func("vm.builtin.attention_kv_cache_cache_prefix")
+    fclear_prefix_cache = tvm.get_global_func("vm.builtin.attention_kv_cache_clear_prefix_cache")
+
+    cached_k = {}
+    cached_v = {}
+    tokens = list(range(40))
+    apply_attention(kv_cache, rope_mode, [(0, 40)], cached_k, cached_v)
+    fcache_prefix(kv_cache, 0, ShapeTuple(tokens))
+    prefix_k = cached_k.pop(0)
+    prefix_v = cached_v.pop(0)
+    fremove_sequence(kv_cache, 0)
+    assert not fis_empty(kv_cache), "The cached prefix should outlive its sequence"
+
+    # Only the full pages of the common prefix are reused.
+    matched = fadd_sequence_with_prefix_match(kv_cache, 1, ShapeTuple(tokens[:35] + [100] * 15))
+    assert matched == 2 * page_size
+    cached_k[1] = prefix_k[:, :matched]
+    cached_v[1] = prefix_v[:, :matched]
+    # At least one token is left for forward even when the whole sequence is cached.
+    matched = fadd_sequence_with_prefix_match(kv_cache, 2, ShapeTuple(tokens[:32]))
+    assert matched == page_size
+    cached_k[2] = prefix_k[:, :matched]
+    cached_v[2] = prefix_v[:, :matched]
+    assert fadd_sequence_with_prefix_match(kv_cache, 3, ShapeTuple([100] + tokens[1:])) == 0
+    apply_attention(kv_cache, rope_mode, [(1, 18), (2, 16), (3, 40)], cached_k, cached_v)
+    verify_cached_kv(kv_cache, [1, 2, 3], cached_k, cached_v)
+
+    for seq_id in [1, 2, 3]:
+        fremove_sequence(kv_cache, seq_id)
+    fclear_prefix_cache(kv_cache)
+    assert fis_empty(kv_cache), "The KV cache is not empty after clearing the prefix cache"
+
+
+def test_paged_attention_kv_cache_swap(kv_cache_and_config):
+    kv_cache, rope_mode, support_sliding_window = kv_cache_and_config
+    if support_sliding_window and rope_mode == RopeMode.NORMAL:
+        return
+    fclear(kv_cache)
+    fswap_out = tvm.get_global_func("vm.builtin.kv_state_swap_out")
+    fswap_in = tvm.get_global_func("vm.builtin.kv_state_swap_in")
+    fget_num_available_pages = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_available_pages"
+    )
+
+    cached_k = {}
+    cached_v = {}
+    apply_attention(kv_cache, rope_mode, [(0, 40), (1, 25)], cached_k, cached_v)
+    apply_attention(kv_cache, rope_mode, [((2, 0, 32), 5)], cached_k, cached_v)
+    apply_attention(kv_cache, rope_mode, [(0, 1), (2, 1)], cached_k, cached_v)
+
+    # Only the pages exclusively owned by the sequence are released.
+    num_available_pages = fget_num_available_pages(kv_cache)
+    fswap_out(kv_cache, 0)
+    assert fget_num_available_pages(kv_cache) == num_available_pages + 1
+    fswap_out(kv_cache, 1)
+    assert fget_num_available_pages(kv_cache) == num_available_pages + 3
+    # Reuse the released pages before swapping the sequences back.
+    apply_attention(kv_cache, rope_mode, [(2, 20), (3, 50)], cached_k, cached_v)
+    fswap_in(kv_cache, 1)
+    fswap_in(kv_cache, 0)
+    apply_attention(kv_cache, rope_mode, [(0, 1), (1, 1), (2, 1), (3, 1)], cached_k, cached_v)
+    verify_cached_kv(kv_cache, [0, 1, 2, 3], cached_k, cached_v)
+
+    # A swapped-out sequence can be removed directly.
+    fswap_out(kv_cache, 2)
+    for seq_id in range(4):
+        fremove_sequence(kv_cache, seq_id)
+    assert fis_empty(kv_cache), "The KV cache is not empty after removing all sequences"
+
+
+def test_paged_attention_kv_cache_page_accounting(kv_cache_and_config):
+    kv_cache, rope_mode, support_sliding_window = kv_cache_and_config
+    if support_sliding_window and rope_mode == RopeMode.NORMAL:
+        return
+    fclear(kv_cache)
+    fswap_out = tvm.get_global_func("vm.builtin.kv_state_swap_out")
+    fget_num_available_pages = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_available_pages"
+    )
+    fget_num_pages_of_sequence = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_pages_of_sequence"
+    )
+    fget_num_pages_freed_on_remove = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_pages_freed_on_remove"
+    )
+    fget_num_pages_needed_for_append = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_pages_needed_for_append"
+    )
+
+    cached_k = {}
+    cached_v = {}
+    apply_attention(kv_cache, rope_mode, [(0, 40), (1, 25)], cached_k, cached_v)
+    # Sequence 2 shares the first 2 pages with sequence 0.
+    apply_attention(kv_cache, rope_mode, [((2, 0, 32), 5)], cached_k, cached_v)
+    apply_attention(kv_cache, rope_mode, [(0, 1), (2, 1)], cached_k, cached_v)
+
+    for seq_id, num_pages, num_freed_pages in [(0, 3, 1), (1, 2, 2), (2, 3, 1)]:
+        assert fget_num_pages_of_sequence(kv_cache, seq_id) == num_pages
+        assert fget_num_pages_freed_on_remove(kv_cache, seq_id) == num_freed_pages
+    # Sequence 0 has length 9 and sequence 1 has length 25.
+    assert fget_num_pages_needed_for_append(kv_cache, 0, 7) == 0
+    assert fget_num_pages_needed_for_append(kv_cache, 0, 8) == 1
+    assert fget_num_pages_needed_for_append(kv_cache, 1, 7) == 0
+    assert fget_num_pages_needed_for_append(kv_cache, 1, 40) == 3
+
+    num_available_pages = fget_num_available_pages(kv_cache)
+    fremove_sequence(kv_cache, 2)
+    assert fget_num_available_pages(kv_cache) == num_available_pages + 1
+    # The shared pages are exclusively owned by sequence 0 now.
+    assert fget_num_pages_freed_on_remove(kv_cache, 0) == 3
+
+    # Swapping in sequence 1 needs its 2 pages back.
+    fswap_out(kv_cache, 1)
+    assert fget_num_pages_of_sequence(kv_cache, 1) == 0
+    assert fget_num_pages_freed_on_remove(kv_cache, 1) == 0
+    assert fget_num_pages_needed_for_append(kv_cache, 1, 7) == 2
+    assert fget_num_pages_needed_for_append(kv_cache, 1, 8) == 3
+    for seq_id in range(2):
+        fremove_sequence(kv_cache, seq_id)
+    assert fis_empty(kv_cache), "The KV cache is not empty after removing all sequences"
+
+
+
+def test_paged_attention_kv_cache_copy_on_write_fork(kv_cache_and_config):
+    kv_cache, rope_mode, support_sliding_window = kv_cache_and_config
+    if support_sliding_window and rope_mode == RopeMode.NORMAL:
+        return
+    fclear(kv_cache)
+    fget_num_available_pages = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_available_pages"
+    )
+    fget_num_pages_needed_for_append = tvm.get_global_func(
+        "vm.builtin.attention_kv_cache_get_num_pages_needed_for_append"
+    )
+
+    cached_k = {}
+    cached_v = {}
+    apply_attention(kv_cache, rope_mode, [(0, 20)], cached_k, cached_v)
+    num_available_pages = fget_num_available_pages(kv_cache)
+    # The samples forked inside the last page of sequence 0 share the page.
+    for seq_id in range(1, 9):
+        ffork_sequence(kv_cache, 0, seq_id, -1)
+        cached_k[seq_id] = cached_k[0]
+        cached_v[seq_id] = cached_v[0]
+    ffork_sequence(kv_cache, 1, 9, 18)
+    cached_k[9] = cached_k[1][::, :18]
+    cached_v[9] = cached_v[1][::, :18]
+    assert fget_num_available_pages(kv_cache) == num_available_pages
+    # The longest holder of the page writes in place, and the others copy it.
+    assert fget_num_pages_needed_for_append(kv_cache, 0, 1) == 0
+    assert fget_num_pages_needed_for_append(kv_cache, 1, 1) == 1
+    assert fget_num_pages_needed_for_append(kv_cache, 9, 1) == 1
+
+    apply_attention(kv_cache, rope_mode, [(seq_id, 1) for seq_id in range(10)], cached_k, cached_v)
+    assert fget_num_available_pages(kv_cache) == num_available_pages - 9
+    apply_attention(kv_cache, rope_mode, [(seq_id, 1) for seq_id in range(10)], cached_k, cached_v)
+    verify_cached_kv(kv_cache, list(range(10)), cached_k, cached_v)
+
+    for seq_id in range(10):
+        fremove_sequence(kv_cache, seq_id)
+    assert fis_empty(kv_cache), "The KV cache is not empty after removing all sequences"
+
+
+def test_paged_attention_kv_cache_incremental_decode(kv_cache_and_config):
+    kv_cache, rope_mode, support_sliding_window = kv_cache_and_config
+    if support_sliding_window and rope_mode == RopeMode.NORMAL:
+        return
+    fclear(kv_cache)
+
+    cached_k = {}
+    cached_v = {}
+    apply_attention(kv_cache, rope_mode, [(0, 14), (1, 16), (2, 1), (3, 31)], cached_k, cached_v)
+    # Consecutive decode steps over the same batch, crossing page boundaries.
+    for _ in range(20):
+        apply_attention(kv_cache, rope_mode, [(0, 1), (1, 1), (2, 1), (3, 1)], cached_k, cached_v)
+    verify_cached_kv(kv_cache, [0, 1, 2, 3], cached_k, cached_v)
+
+    # Decode steps after the batch order changes, or after the sequences are mutated.
+    for _ in range(3):
+        apply_attention(kv_cache, rope_mode, [(3, 1), (2, 1), (1, 1), (0, 1)], cached_k, cached_v)
+    fpopn(kv_cache, 1, 3)
+    cached_k[1] = cached_k[1][:, :-3, ...]
+    cached_v[1] = cached_v[1][:, :-3, ...]
+    for _ in range(20):
+        apply_attention(kv_cache, rope_mode, [(3, 1), (2, 1), (1, 1), (0, 1)], cached_k, cached_v)
+    verify_cached_kv(kv_cache, [0, 1, 2, 3], cached_k, cached_v)
+
+
+def test_paged_attention_kv_cache_cuda_graph_mode(kv_cache_and_config):
+    _, rope_mode, support_sliding_window = kv_cache_and_config
+    if support_sliding_window:
+        return
+    # The CUDA graph mode uses fixed-address auxiliary arrays and the full-capacity
+    # page table, which should not change the attention results.
+    kv_cache = create_kv_cache(head_dim, dtype, rope_mode, support_sliding_window, True)
+
+    cached_k = {}
+    cached_v = {}
+    apply_attention(kv_cache, rope_mode, [(0, 14), (1, 33), (2, 5)], cached_k, cached_v)
+    apply_attention(kv_cache, rope_mode, [((3, 1, 32), 7)], cached_k, cached_v)
+    for _ in range(10):
+        apply_attention(kv_cache, rope_mode, [(0, 1), (1, 1), (2, 1), (3, 1)], cached_k, cached_v)
+    verify_cached_kv(kv_cache, [0, 1, 2, 3], cached_k, cached_v)
+
+
 def test_paged_attention_kv_cache_sliding_window(kv_cache_and_config):
     kv_cache, rope_mode, support_sliding_window = kv_cache_and_config
     if not support_sliding_window or rope_mode == RopeMode.NORMAL:
@@ -899,6 +1114,25 @@ def test_paged_attention_kv_cache_tree_attn(kv_cache_and_config):
     for _ in range(5):
         apply_attention(kv_cache, rope_mode, [(0, 1), (1, 1), (2, 1), (3, 1)], cached_k, cached_v)
 
+    # Test the cases where trees of different shapes are mixed with chains in one batch,
+    # and the last sequence in the batch is a chain.
+    apply_attention(
+        kv_cache,
+        rope_mode,
+        [(0, 5), (1, 3), (2, 6), (3, 4)],
+        cached_k,
+        cached_v,
+        token_tree_parent_ptr_list=[
+            [-1, 0, 0, 1, 2],  # two branches
+            [-1, -1, -1],  # three roots
+            [-1, 0, 1, 1, 3, 3],  # branching chain
+            [-1, 0, 1, 2],  # chain of length 4
+        ],
+        accepted_leaf_indices=[4, 2, 5, 3],
+    )
+    for _ in range(5):
+        apply_attention(kv_cache, rope_mode, [(0, 1), (1, 1), (2, 1), (3, 1)], cached_k, cached_v)
+
     # Test the cases where all trees are chains.
     fclear(kv_cache)
     cached_k = {}
@@ -964,6 +1198,12 @@ if __name__ == "__main__":
         test_paged_attention_kv_cache_remove_sequence(cache_and_config)
         test_paged_attention_kv_cache_fork_sequence(cache_and_config)
         test_paged_attention_kv_cache_popn(cache_and_config)
+        test_paged_attention_kv_cache_prefix_cache(cache_and_config)
+        test_paged_attention_kv_cache_swap(cache_and_config)
+        test_paged_attention_kv_cache_page_accounting(cache_and_config)
+        test_paged_attention_kv_cache_copy_on_write_fork(cache_and_config)
+        test_paged_attention_kv_cache_incremental_decode(cache_and_config)
+        test_paged_attention_kv_cache_cuda_graph_mode(cache_and_config)
         test_paged_attention_kv_cache_sliding_window(cache_and_config)
         test_paged_attention_kv_cache_tree_attn(cache_and_config)
         test_paged_attention_kv_cache_unlimited_depth(cache_and_config)
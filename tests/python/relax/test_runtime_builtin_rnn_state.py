@@ -182,6 +182,77 @@ def test_rnn_state_fork_sequence(rnn_state):  # pylint: disable=redefined-outer-
     verify_state(state, [0, 1], [[np_two, np_three], [np_zero, np_one]])
 
 
+@tvm.testing.requires_cuda
+def test_rnn_state_fork_copy_on_write(rnn_state):  # pylint: disable=redefined-outer-name
+    state = rnn_state
+    f_clear(state)
+
+    f_add_sequence(state, 0)
+    f_begin_forward(state, ShapeTuple([0]), ShapeTuple([1]))
+    f_set(state, 0, 0, tvm.runtime.tensor(np_two.reshape(1, 16, 16), device=device))
+    f_set(state, 0, 1, tvm.runtime.tensor(np_three.reshape(1, 32, 32), device=device))
+    f_end_forward(state)
+    # The forked sequences share the seq slot of the parent, so there can be more
+    # sequences than the reserved seq slots.
+    for child_seq_id in range(1, reserved_nseq + 1):
+        f_fork_sequence(state, 0, child_seq_id, -1)
+    verify_state(state, [1, 2], [[np_two, np_three], [np_two, np_three], [np_two, np_three]])
+    # Writing a forked sequence copies the seq slot, and leaves the others untouched.
+    f_begin_forward(state, ShapeTuple([1]), ShapeTuple([1]))
+    f_set(state, 0, 0, tvm.runtime.tensor(np_zero.reshape(1, 16, 16), device=device))
+    f_set(state, 0, 1, tvm.runtime.tensor(np_one.reshape(1, 32, 32), device=device))
+    f_end_forward(state)
+    verify_state(state, [0, 1, 2], [[np_two, np_three], [np_zero, np_one], [np_two, np_three]])
+
+
+@tvm.testing.requires_cuda
+def test_rnn_state_checkpoint():
+    set_global_func()
+    f_create = tvm.get_global_func("vm.builtin.rnn_state_create")
+    init_values = [
+        tvm.runtime.tensor(np_zero, device=device),
+        tvm.runtime.tensor(np_one, device=device),
+    ]
+    checkpoint_interval, num_checkpoints = 2, 4
+    state = f_create(
+        num_layers,
+        reserved_nseq,
+        max_history,
+        f_tir_gets,
+        f_tir_sets,
+        init_values,
+        checkpoint_interval,
+        num_checkpoints,
+    )
+
+    f_add_sequence(state, 0)
+    # Prefill 2 tokens, which cannot be rolled back but is checkpointed at position 2.
+    f_begin_forward(state, ShapeTuple([0]), ShapeTuple([2]))
+    f_set(state, 0, 0, tvm.runtime.tensor(np_two.reshape(1, 16, 16), device=device))
+    f_set(state, 0, 1, tvm.runtime.tensor(np_three.reshape(1, 32, 32), device=device))
+    f_end_forward(state)
+    # Prefill 2 more tokens.
+    f_begin_forward(state, ShapeTuple([0]), ShapeTuple([2]))
+    f_set(state, 0, 0, tvm.runtime.tensor(np_zero.reshape(1, 16, 16), device=device))
+    f_set(state, 0, 1, tvm.runtime.tensor(np_one.reshape(1, 32, 32), device=device))
+    f_end_forward(state)
+    with pytest.raises(tvm.error.TVMError):
+        f_popn(state, 0, 2)  # the prefill input cannot be rolled back
+    with pytest.raises(tvm.error.TVMError):
+        f_fork_sequence(state, 0, 1, 3)  # position 3 is not checkpointed
+    # Fork at the checkpointed position 2.
+    f_fork_sequence(state, 0, 1, 2)
+    verify_state(state, [0, 1], [[np_zero, np_one], [np_two, np_three]])
+    # The child keeps advancing from the checkpointed state.
+    f_begin_forward(state, ShapeTuple([1]), ShapeTuple([1]))
+    f_set(state, 0, 0, tvm.runtime.tensor(np_zero.reshape(1, 16, 16), device=device))
+    f_set(state, 0, 1, tvm.runtime.tensor(np_one.reshape(1, 32, 32), device=device))
+    f_end_forward(state)
+    verify_state(state, [0, 1], [[np_zero, np_one], [np_zero, np_one]])
+    f_popn(state, 1, 1)
+    verify_state(state, [0, 1], [[np_zero, np_one], [np_two, np_three]])
+
+
 def rnn_state_get(
     shape: Sequence[int],
     dtype: str,
@@ -263,3 +334,5 @@ if __name__ == "__main__":
     test_rnn_state_set(rnn_state)
     test_rnn_state_popn(rnn_state)
     test_rnn_state_fork_sequence(rnn_state)
+    test_rnn_state_fork_copy_on_write(rnn_state)
+    test_rnn_state_checkpoint()
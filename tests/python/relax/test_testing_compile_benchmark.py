@@ -0,0 +1,45 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm.relax.testing import compile_benchmark
+
+
+@tvm.testing.requires_llvm
+def test_benchmark_small_llama():
+    mod = compile_benchmark.llama_decoder(
+        num_layers=1, hidden_size=32, num_heads=2, intermediate_size=64, seq_len=4
+    )
+    result = compile_benchmark.benchmark(mod, target="llvm")
+    assert result["total_ms"] > 0
+    assert "FuseOps" in result["passes"]
+    assert sum(result["passes"].values()) <= result["total_ms"]
+    assert compile_benchmark.compare({"llama": result}, {"llama": result}) == []
+
+
+def test_compare():
+    baseline = {"resnet": {"total_ms": 100.0, "passes": {"A": 50.0, "B": 1.0}}}
+    result = {"resnet": {"total_ms": 110.0, "passes": {"A": 70.0, "B": 3.0, "C": 9.0}}}
+    # Only the slowdown of A is above both the tolerance and the minimal delta.
+    regressions = compile_benchmark.compare(result, baseline, tolerance=0.2, min_delta_ms=5.0)
+    assert len(regressions) == 1
+    assert "A took 70.0 ms" in regressions[0]
+    assert compile_benchmark.compare(result, {"vit": baseline["resnet"]}) == []
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
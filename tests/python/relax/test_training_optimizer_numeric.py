@@ -78,6 +78,8 @@ def _test_optimizer(target, dev, np_func, opt_type, *args, **kwargs):
     _assert_run_result_same(tvm_func, np_func, [param_arr, grad_arr, state_arr])
 
 
+fused = tvm.testing.parameter(False, True)
+
 lr, weight_decay = tvm.testing.parameters(
     (0.01, 0),
     (0.01, 0.02),
@@ -85,7 +87,7 @@ lr, weight_decay = tvm.testing.parameters(
 
 
 @tvm.testing.parametrize_targets("llvm")
-def test_sgd(target, dev, lr, weight_decay):
+def test_sgd(target, dev, lr, weight_decay, fused):
     def np_func(param_tuple, grad_tuple, state_tuple):
         num_steps = state_tuple[0]
         param_tuple_new, state_tuple_new = [], []
@@ -96,7 +98,7 @@ def test_sgd(target, dev, lr, weight_decay):
             param_tuple_new.append(param - lr * (grad + weight_decay * param))
         return param_tuple_new, state_tuple_new
 
-    _test_optimizer(target, dev, np_func, SGD, lr, weight_decay)
+    _test_optimizer(target, dev, np_func, SGD, lr, weight_decay, fused=fused)
 
 
 lr, momentum, dampening, weight_decay, nesterov = tvm.testing.parameters(
@@ -107,7 +109,7 @@ lr, momentum, dampening, weight_decay, nesterov = tvm.testing.parameters(
 
 
 @tvm.testing.parametrize_targets("llvm")
-def test_momentum_sgd(target, dev, lr, momentum, dampening, weight_decay, nesterov):
+def test_momentum_sgd(target, dev, lr, momentum, dampening, weight_decay, nesterov, fused):
     def np_func(param_tuple, grad_tuple, state_tuple):
         num_steps = state_tuple[0]
         param_tuple_new, state_tuple_new = [], []
@@ -129,7 +131,16 @@ def test_momentum_sgd(target, dev, lr, momentum, dampening, weight_decay, nester
         return param_tuple_new, state_tuple_new
 
     _test_optimizer(
-        target, dev, np_func, MomentumSGD, lr, momentum, dampening, weight_decay, nesterov
+        target,
+        dev,
+        np_func,
+        MomentumSGD,
+        lr,
+        momentum,
+        dampening,
+        weight_decay,
+        nesterov,
+        fused=fused,
     )
 
 
@@ -140,7 +151,7 @@ lr, betas, eps, weight_decay = tvm.testing.parameters(
 
 
 @tvm.testing.parametrize_targets("llvm")
-def test_adam(target, dev, lr, betas, eps, weight_decay):
+def test_adam(target, dev, lr, betas, eps, weight_decay, fused):
     def np_func(param_tuple, grad_tuple, state_tuple):
         num_steps = state_tuple[0]
         num_steps_new = num_steps + 1
@@ -168,7 +179,7 @@ def test_adam(target, dev, lr, betas, eps, weight_decay):
 
         return param_tuple_new, state_tuple_new
 
-    _test_optimizer(target, dev, np_func, Adam, lr, betas, eps, weight_decay)
+    _test_optimizer(target, dev, np_func, Adam, lr, betas, eps, weight_decay, fused=fused)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,156 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+@I.ir_module
+class Module:
+    @T.prim_func(private=True)
+    def exp(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        for i in range(16):
+            with T.sblock("exp"):
+                vi = T.axis.remap("S", [i])
+                B[vi] = T.exp(A[vi])
+
+    @T.prim_func(private=True)
+    def add(
+        A: T.Buffer((16,), "float32"),
+        B: T.Buffer((16,), "float32"),
+        C: T.Buffer((16,), "float32"),
+    ):
+        for i in range(16):
+            with T.sblock("add"):
+                vi = T.axis.remap("S", [i])
+                C[vi] = A[vi] + B[vi]
+
+    @R.function(pure=False)
+    def main(
+        x: R.Tensor((16,), dtype="float32"), y: R.Tensor((16,), dtype="float32")
+    ) -> R.Tensor((16,), dtype="float32"):
+        cls = Module
+        storage: R.Object = R.memory.alloc_storage(
+            R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+        )
+        a: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+            storage, offset=0, shape=R.shape([16]), dtype="float32"
+        )
+        _: R.Tuple() = cls.exp(x, a)
+        storage1: R.Object = R.memory.alloc_storage(
+            R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+        )
+        b: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+            storage1, offset=0, shape=R.shape([16]), dtype="float32"
+        )
+        _1: R.Tuple() = cls.exp(y, b)
+        c: R.Tensor((16,), dtype="float32") = R.builtin.alloc_tensor(
+            R.shape([16]), dtype="float32", runtime_device_index=0
+        )
+        _2: R.Tuple() = cls.add(a, b, c)
+        _3: R.Tuple() = R.memory.kill_storage(storage)
+        _4: R.Tuple() = R.memory.kill_storage(storage1)
+        return c
+
+
+def _schedule(func):
+    """The kernel calls and the stream builtins of a function, in order."""
+    schedule = []
+    for block in func.body.blocks:
+        for binding in block.bindings:
+            value = binding.value
+            if not isinstance(value, relax.Call):
+                continue
+            if isinstance(value.op, relax.GlobalVar):
+                schedule.append(value.op.name_hint)
+            elif value.op.same_as(tvm.ir.Op.get("relax.call_builtin_with_ctx")):
+                name = value.args[0].global_symbol.split(".")[-1]
+                args = [int(arg.value) for arg in value.args[1].fields]
+                schedule.append((name, *args))
+            elif value.op.name.startswith("relax.memory.kill"):
+                schedule.append("kill")
+    return schedule
+
+
+def test_independent_kernels_on_streams():
+    with tvm.transform.PassContext(config={"relax.backend.max_num_streams": 2}):
+        after = relax.transform.AssignStreams()(Module)
+
+    assert _schedule(after["main"]) == [
+        # fork
+        ("wait", 0, 0, 1),
+        "exp",
+        ("set", 0, 1),
+        "exp",
+        # the add depends on the exp of the stream 1
+        ("wait", 0, 1, 0),
+        ("set", 0, 0),
+        "add",
+        # the storages are freed after the join
+        "kill",
+        "kill",
+    ]
+
+
+def test_disabled_by_default():
+    after = relax.transform.AssignStreams()(Module)
+    tvm.ir.assert_structural_equal(after, Module)
+
+
+def test_reused_storage_is_dependency():
+    @I.ir_module
+    class Reuse:
+        @T.prim_func(private=True)
+        def exp(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            for i in range(16):
+                with T.sblock("exp"):
+                    vi = T.axis.remap("S", [i])
+                    B[vi] = T.exp(A[vi])
+
+        @R.function(pure=False)
+        def main(
+            x: R.Tensor((16,), dtype="float32"),
+            y: R.Tensor((16,), dtype="float32"),
+            z: R.Tensor((16,), dtype="float32"),
+        ) -> R.Tensor((16,), dtype="float32"):
+            cls = Reuse
+            storage: R.Object = R.memory.alloc_storage(
+                R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+            )
+            a: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+                storage, offset=0, shape=R.shape([16]), dtype="float32"
+            )
+            _: R.Tuple() = cls.exp(x, a)
+            _1: R.Tuple() = cls.exp(a, y)
+            # memory planning reuses the storage of a, which the second exp reads
+            b: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+                storage, offset=0, shape=R.shape([16]), dtype="float32"
+            )
+            _2: R.Tuple() = cls.exp(z, b)
+            return b
+
+    with tvm.transform.PassContext(config={"relax.backend.max_num_streams": 2}):
+        after = relax.transform.AssignStreams()(Reuse)
+    tvm.ir.assert_structural_equal(after, Reuse)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
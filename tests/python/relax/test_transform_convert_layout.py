@@ -18,7 +18,7 @@
 
 import tvm
 import tvm.testing
-from tvm.relax.transform import ConvertLayout, Normalize
+from tvm.relax.transform import AutoConvertLayout, ConvertLayout, Normalize
 from tvm.script.parser import ir as I
 from tvm.script.parser import relax as R
 from tvm.script.parser import tir as T
@@ -5583,5 +5583,53 @@ def test_layout_cb():
     verify(Input, Expected, cb=layout_cb)
 
 
+def _conv_chain(num_convs):
+    bb = tvm.relax.BlockBuilder()
+    x = tvm.relax.Var("x", R.Tensor((2, 4, 28, 28), "float32"))
+    weights = [
+        tvm.relax.Var(f"w{i}", R.Tensor((4, 4, 3, 3), "float32")) for i in range(num_convs)
+    ]
+    with bb.function("main", [x, *weights]):
+        with bb.dataflow():
+            lv = x
+            for w in weights:
+                lv = bb.emit(tvm.relax.op.nn.conv2d(lv, w, out_dtype="float32"))
+            gv = bb.emit_output(lv)
+        bb.emit_func_output(gv)
+    return bb.get()
+
+
+def _conv_data_layouts(mod):
+    return [
+        binding.value.attrs.data_layout
+        for binding in mod["main"].body.blocks[0].bindings
+        if isinstance(binding.value, tvm.relax.Call)
+        and binding.value.op == tvm.ir.Op.get("relax.nn.conv2d")
+    ]
+
+
+def test_auto_convert_layout():
+    candidates = {"relax.nn.conv2d": [["NHWC", "OHWI"], ["NCHW", "OIHW"]]}
+    # A single conv2d is not worth transposing its input and output
+    mod = AutoConvertLayout(candidates, fold_constants=False)(_conv_chain(1))
+    assert _conv_data_layouts(mod) == ["NCHW"]
+    # A chain of conv2d pays the transposes once for the preferred layout
+    mod = AutoConvertLayout(candidates, fold_constants=False)(_conv_chain(3))
+    assert _conv_data_layouts(mod) == ["NHWC"] * 3
+
+
+def test_auto_convert_layout_op_cost():
+    candidates = {"relax.nn.conv2d": [["NHWC", "OHWI"], ["NCHW4c", "OIHW4o"]]}
+    seen = []
+
+    def op_cost(call, layouts):
+        seen.append(str(layouts[0]))
+        return 0.0 if layouts[0] == "NCHW4c" else 1e9
+
+    mod = AutoConvertLayout(candidates, op_cost=op_cost, fold_constants=False)(_conv_chain(2))
+    assert _conv_data_layouts(mod) == ["NCHW4c"] * 2
+    assert sorted(set(seen)) == ["NCHW4c", "NHWC"]
+
+
 if __name__ == "__main__":
     tvm.testing.main()
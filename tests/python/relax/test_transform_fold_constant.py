@@ -585,5 +585,71 @@ def test_fold_large_op_with_tensor_input():
     tvm.ir.assert_structural_equal(after, expected)
 
 
+def test_skip_folding_above_max_output_bytes():
+    """Ops whose output is larger than the configured threshold are not folded."""
+
+    @tvm.script.ir_module
+    class Module:
+        @T.prim_func
+        def addone(A: T.Buffer((2048,), "float32"), B: T.Buffer((2048,), "float32")) -> None:
+            for i in range(2048):
+                with T.sblock("addone"):
+                    vi = T.axis.remap("S", [i])
+                    B[vi] = A[vi] + T.float32(1)
+
+        @R.function
+        def before(c0: R.Tensor((2048,), "float32")):
+            cls = Module
+            lv0 = relax.call_tir(cls.addone, (c0,), R.Tensor((2048,), dtype="float32"))
+            return lv0
+
+    before = gen_mod(Module, "before", {"c0": np.arange(2048).astype("float32")})
+    with tvm.transform.PassContext(config={"relax.FoldConstant.max_output_bytes": 4096}):
+        after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, before)
+
+    with tvm.transform.PassContext(config={"relax.FoldConstant.max_output_bytes": 8192}):
+        after = relax.transform.FoldConstant()(before)
+    assert isinstance(after["main"].body.body, relax.Constant)
+
+
+def test_fold_chain_of_distinct_kernels():
+    """The kernels of a chain of folds are built together and folded in order."""
+
+    @tvm.script.ir_module
+    class Module:
+        @T.prim_func
+        def transpose(A: T.Buffer((2, 3), "float32"), B: T.Buffer((3, 2), "float32")) -> None:
+            for i, j in T.grid(3, 2):
+                with T.sblock("transpose"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    B[vi, vj] = A[vj, vi]
+
+        @T.prim_func
+        def addone(A: T.Buffer((3, 2), "float32"), B: T.Buffer((3, 2), "float32")) -> None:
+            for i, j in T.grid(3, 2):
+                with T.sblock("addone"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    B[vi, vj] = A[vi, vj] + T.float32(1)
+
+        @R.function
+        def before(c0: R.Tensor((2, 3), "float32")):
+            cls = Module
+            lv0 = relax.call_tir(cls.transpose, (c0,), R.Tensor((3, 2), dtype="float32"))
+            lv1 = relax.call_tir(cls.addone, (lv0,), R.Tensor((3, 2), dtype="float32"))
+            return lv1
+
+        @R.function
+        def expected(c1: R.Tensor((3, 2), "float32")):
+            return c1
+
+    c0_np = np.arange(2 * 3).astype("float32").reshape(2, 3)
+    c1_np = c0_np.T + 1
+    before = gen_mod(Module, "before", {"c0": c0_np})
+    expected = gen_mod(Module, "expected", {"c1": c1_np})
+    after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, expected)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,98 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+def _pooled_module(pool):
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            w: R.Tensor((1000, 32), "float32"), idx: R.Tensor((16, 4, 8), "int32")
+        ) -> R.Tensor((16, 4, 32), "float32"):
+            with R.dataflow():
+                rows = R.take(w, idx, axis=0)
+                gv = pool(rows, axis=[-2])
+                R.output(gv)
+            return gv
+
+    return Module
+
+
+def _call_tir_names(func):
+    return [
+        binding.value.args[0].name_hint
+        for block in func.body.blocks
+        for binding in block.bindings
+        if isinstance(binding.value, relax.Call)
+        and binding.value.op == tvm.ir.Op.get("relax.call_tir")
+    ]
+
+
+@pytest.mark.parametrize("pool", [R.sum, R.mean])
+def test_fuse_take_pool(pool):
+    mod = relax.transform.FuseEmbeddingBag()(_pooled_module(pool))
+    assert _call_tir_names(mod["main"]) == ["embedding_bag"]
+    assert not any(
+        isinstance(binding.value, relax.Call) and binding.value.op == tvm.ir.Op.get("relax.take")
+        for block in mod["main"].body.blocks
+        for binding in block.bindings
+    )
+
+
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("pool", [R.sum, R.mean])
+def test_fused_numerics(pool):
+    mod = _pooled_module(pool)
+    w = np.random.uniform(-1, 1, size=(1000, 32)).astype("float32")
+    idx = np.random.randint(0, 1000, size=(16, 4, 8)).astype("int32")
+    rows = w[idx]
+    expected = rows.sum(axis=-2) if pool is R.sum else rows.mean(axis=-2)
+
+    fused = relax.transform.FuseEmbeddingBag()(mod)
+    ex = tvm.compile(fused, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    out = vm["main"](tvm.runtime.tensor(w), tvm.runtime.tensor(idx)).numpy()
+    tvm.testing.assert_allclose(out, expected, rtol=1e-5, atol=1e-5)
+
+
+def test_pool_over_other_axis_is_unchanged():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            w: R.Tensor((1000, 32), "float32"), idx: R.Tensor((16, 8), "int32")
+        ) -> R.Tensor((16, 8), "float32"):
+            with R.dataflow():
+                rows = R.take(w, idx, axis=0)
+                gv = R.sum(rows, axis=[-1])
+                R.output(gv)
+            return gv
+
+    mod = relax.transform.FuseEmbeddingBag()(Module)
+    tvm.ir.assert_structural_equal(mod, Module)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -1697,5 +1697,39 @@ def test_packed_params():
     _check(Before, Expected)
 
 
+def test_fusion_policy():
+    def before():
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", R.Tensor([10, 20], "float32"))
+        with bb.function("main", [x]):
+            with bb.dataflow():
+                lv0 = bb.emit_te(topi.sum, x, axis=1)
+                lv1 = bb.emit_te(topi.sum, lv0, axis=0)
+                lv2 = bb.emit_te(topi.exp, lv1)
+                gv = bb.emit_output(lv2)
+            bb.emit_func_output(gv)
+        return relax.transform.AnnotateTIROpPattern()(bb.get())
+
+    def num_kernels(policy):
+        with tvm.transform.PassContext(config={"relax.FuseOps.fusion_policy": policy}):
+            mod = relax.transform.FuseOps()(before())
+        return len(mod["main"].body.blocks[0].bindings)
+
+    # The rules only fuse the second reduction with its epilogue
+    assert num_kernels(lambda mod, producer, consumer: None) == 2
+    # A policy may refuse fusions the rules accept
+    assert num_kernels(lambda mod, producer, consumer: False) == 3
+    # and accept fusions the rules refuse
+    assert num_kernels(lambda mod, producer, consumer: True) == 1
+    seen = []
+
+    def policy(mod, producer, consumer):
+        seen.append((producer.args[0].name_hint, consumer.args[0].name_hint))
+        return None
+
+    num_kernels(policy)
+    assert ("sum", "sum1") in seen
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -1422,5 +1422,29 @@ def test_concat():
     check(mod, [("x.concat", pat_clip)], Expected2)
 
 
+def test_pattern_with_alternative_root_ops():
+    @R.function
+    def func(x: R.Tensor((10,), "float32")):
+        R.func_attr({"global_symbol": "main"})
+        with R.dataflow():
+            lv = R.abs(x)
+            lv1 = R.nn.relu(lv)
+            lv2 = R.add(lv, lv1)
+            gv = R.divide(lv2, x)
+            R.output(gv)
+        return gv
+
+    mod = tvm.IRModule({"main": func})
+    pat_unary = (is_op("relax.abs") | is_op("relax.nn.relu"))(wildcard())
+    mod = relax.transform.FuseOpsByPattern([("x.unary", pat_unary)])(mod)
+
+    composites = sorted(
+        func.attrs["Composite"]
+        for func in mod.functions.values()
+        if func.attrs is not None and "Composite" in func.attrs
+    )
+    assert composites == ["x.unary", "x.unary"]
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
@@ -0,0 +1,99 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax, tir
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+@I.ir_module
+class Module:
+    @T.prim_func(private=True)
+    def scale(a: T.Buffer((4, 8), "float32"), b: T.Buffer((4, 8), "float32")):
+        T.func_attr({"op_pattern": 0})
+        for i, j in T.grid(4, 8):
+            with T.sblock("scale"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                b[vi, vj] = a[vi, vj] * T.float32(2)
+
+    @R.function
+    def independent(
+        q: R.Tensor((4, 8), "float32"), k: R.Tensor((4, 8), "float32")
+    ) -> R.Tuple(R.Tensor((4, 8), "float32"), R.Tensor((4, 8), "float32")):
+        cls = Module
+        with R.dataflow():
+            lv0 = R.call_tir(cls.scale, (q,), out_sinfo=R.Tensor((4, 8), "float32"))
+            lv1 = R.call_tir(cls.scale, (k,), out_sinfo=R.Tensor((4, 8), "float32"))
+            gv = (lv0, lv1)
+            R.output(gv)
+        return gv
+
+    @R.function
+    def dependent(q: R.Tensor((4, 8), "float32")) -> R.Tensor((4, 8), "float32"):
+        cls = Module
+        with R.dataflow():
+            lv0 = R.call_tir(cls.scale, (q,), out_sinfo=R.Tensor((4, 8), "float32"))
+            gv = R.call_tir(cls.scale, (lv0,), out_sinfo=R.Tensor((4, 8), "float32"))
+            R.output(gv)
+        return gv
+
+
+def _grouped_funcs(mod):
+    return [
+        gv.name_hint
+        for gv, func in mod.functions_items()
+        if isinstance(func, relax.Function) and func.attrs and "Primitive" in func.attrs
+    ]
+
+
+def test_group_independent_kernels():
+    mod = relax.transform.HorizontalFuseOps()(Module)
+    assert len(_grouped_funcs(mod)) == 1
+    bindings = mod["independent"].body.blocks[0].bindings
+    # The two kernels are replaced by one call of the grouped function
+    assert isinstance(bindings[0].value.op, relax.GlobalVar)
+    assert bindings[0].value.op.name_hint in _grouped_funcs(mod)
+
+    mod = relax.transform.FuseTIR()(mod)
+    prim_funcs = [func for _, func in mod.functions_items() if isinstance(func, tir.PrimFunc)]
+    calls = [
+        binding.value
+        for binding in mod["independent"].body.blocks[0].bindings
+        if isinstance(binding.value, relax.Call)
+        and binding.value.op == tvm.ir.Op.get("relax.call_tir")
+    ]
+    assert len(calls) == 1
+    assert any(len(func.params) == 4 for func in prim_funcs)
+
+
+def test_dependent_kernels_are_not_grouped():
+    mod = relax.transform.HorizontalFuseOps()(Module)
+    tvm.ir.assert_structural_equal(mod["dependent"], Module["dependent"])
+
+
+def test_max_group_size():
+    with pytest.raises(ValueError):
+        relax.transform.HorizontalFuseOps(max_group_size=1)(Module)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
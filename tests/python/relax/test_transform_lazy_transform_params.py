@@ -20,6 +20,7 @@ import numpy as np
 import tvm
 import tvm.testing
 from tvm import relax
+from tvm.contrib import tvmjs, utils
 from tvm.relax.transform import LazyTransformParams
 from tvm.script import ir as I
 from tvm.script import relax as R
@@ -679,6 +680,62 @@ def test_output():
         tvm.testing.assert_allclose(expected_i, transformed_i)
 
 
+def test_output_from_tensor_cache_stream():
+    target = "llvm"
+    dev = tvm.device(target)
+
+    @I.ir_module
+    class TransformModule:
+        @R.function
+        def transform_params(
+            params: R.Tuple(
+                R.Tensor((3, 64, 3, 3), dtype="float32"),
+                R.Tensor((16, 16, 3, 3), dtype="float32"),
+                R.Tensor((16,), dtype="float32"),
+            ),
+        ):
+            R.func_attr({"relax.force_pure": True})
+            transformed0 = R.permute_dims(params[0], [1, 0, 2, 3])
+            transformed1 = R.multiply(params[1], R.const(2, "float32"))
+            transformed = (transformed0, transformed1, params[2])
+            return transformed
+
+    stream_var = relax.Var("stream", relax.ObjectStructInfo())
+    mod = LazyTransformParams(
+        fget_item="vm.builtin.tensor_cache.stream_get", extra_get_item_params=[stream_var]
+    )(TransformModule)
+    mod = relax.transform.LegalizeOps()(mod)
+    built = tvm.compile(mod, target=target)
+
+    params = {
+        "b": np.random.random(size=(16,)).astype("float32"),
+        "w0": np.random.random(size=(3, 64, 3, 3)).astype("float32"),
+        "w1": np.random.random(size=(16, 16, 3, 3)).astype("float32"),
+    }
+    temp = utils.tempdir()
+    tvmjs.dump_tensor_cache(params, temp.path, encode_format="raw")
+    # The parameters of the function are in a different order than in the cache.
+    names = ["w0", "w1", "b"]
+    stream = tvm.get_global_func("vm.builtin.tensor_cache.stream_create")(
+        str(temp.path), dev.dlpack_device_type(), 0, names, 1
+    )
+    assert tvm.get_global_func("vm.builtin.tensor_cache.stream_num_params")(stream) == 3
+
+    transformed = {}
+
+    @tvm.register_global_func("set_item", override=True)
+    def set_item(i, value):
+        transformed[i] = value.numpy()
+
+    vm = relax.VirtualMachine(built, dev)
+    vm["transform_params"](stream)
+
+    expected = [params["w0"].transpose(1, 0, 2, 3), params["w1"] * 2, params["b"]]
+    assert sorted(transformed) == [0, 1, 2]
+    for i, expected_i in enumerate(expected):
+        tvm.testing.assert_allclose(transformed[i], expected_i)
+
+
 def test_duplicate_outputs():
     """A tensor may be repeated in the output
 
@@ -76,6 +76,73 @@ def test_allgather():
     tvm.ir.assert_structural_equal(mod, Expected)
 
 
+def test_reduce_scatter():
+    # fmt: off
+    @tvm.script.ir_module
+    class ReduceScatter:
+        @R.function
+        def main(x: R.Tensor((10, 10), "float32"))  -> R.Tensor((10, 10), "float32"):
+            gv0: R.Tensor((5, 10), "float32") = R.ccl.reduce_scatter(x, 2)
+            gv1: R.Tensor((5, 10), "float32") = R.ccl.reduce_scatter(x, 2, "avg")
+            return x
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(x: R.Tensor((10, 10), dtype="float32")) -> R.Tensor((10, 10), dtype="float32"):
+            gv0: R.Tensor((5, 10), dtype="float32") = R.call_dps_packed("runtime.disco.reduce_scatter", [x, R.shape([0]), True], out_sinfo=R.Tensor((5, 10), dtype="float32"))
+            gv1: R.Tensor((5, 10), dtype="float32") = R.call_dps_packed("runtime.disco.reduce_scatter", [x, R.shape([4]), True], out_sinfo=R.Tensor((5, 10), dtype="float32"))
+            return x
+    # fmt: on
+
+    mod = LegalizeOps()(ReduceScatter)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
+def test_all_to_all():
+    # fmt: off
+    @tvm.script.ir_module
+    class AllToAll:
+        @R.function
+        def main(x: R.Tensor((10, 10), "float32"))  -> R.Tensor((10, 10), "float32"):
+            gv0: R.Tensor((10, 10), "float32") = R.ccl.all_to_all(x, 2)
+            return gv0
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(x: R.Tensor((10, 10), dtype="float32")) -> R.Tensor((10, 10), dtype="float32"):
+            gv0: R.Tensor((10, 10), dtype="float32") = R.call_dps_packed("runtime.disco.all_to_all", [x, R.shape([]), R.shape([]), True], out_sinfo=R.Tensor((10, 10), dtype="float32"))
+            return gv0
+    # fmt: on
+
+    mod = LegalizeOps()(AllToAll)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
+def test_ring_send_recv():
+    # fmt: off
+    @tvm.script.ir_module
+    class RingSendRecv:
+        @R.function
+        def main(x: R.Tensor((10, 10), "float32"), y: R.Tensor((10, 10), "float32"))  -> R.Tensor((10, 10), "float32"):
+            gv0: R.Tensor((10, 10), "float32") = R.ccl.ring_send_recv_start(x)
+            gv1: R.Tensor((10, 10), "float32") = R.ccl.ring_send_recv_wait(x, gv0, y)
+            return gv1
+
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(x: R.Tensor((10, 10), dtype="float32"), y: R.Tensor((10, 10), dtype="float32")) -> R.Tensor((10, 10), dtype="float32"):
+            gv0: R.Tensor((10, 10), dtype="float32") = R.call_dps_packed("runtime.disco.ring_send_recv_start", [x, True], out_sinfo=R.Tensor((10, 10), dtype="float32"))
+            gv1: R.Tensor((10, 10), dtype="float32") = R.call_dps_packed("runtime.disco.ring_send_recv_wait", [x, gv0, y], out_sinfo=R.Tensor((10, 10), dtype="float32"))
+            return gv1
+    # fmt: on
+
+    mod = LegalizeOps()(RingSendRecv)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
 def test_broadcast_from_zero():
     # fmt: off
     @tvm.script.ir_module
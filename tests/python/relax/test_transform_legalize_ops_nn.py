@@ -16,6 +16,7 @@
 # under the License.
 # ruff: noqa: E501, F821, F841
 
+import numpy as np
 import pytest
 
 import tvm
@@ -3588,6 +3589,42 @@ def test_dynamic_attention():
     LegalizeOps()(Attention)
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("causal_mask", [None, "TopLeft"])
+def test_attention_legalized_to_flash_attention(causal_mask):
+    @tvm.script.ir_module
+    class Attention:
+        @R.function
+        def main(
+            q: R.Tensor((2, 16, 4, 32), "float32"),
+            k: R.Tensor((2, 16, 2, 32), "float32"),
+            v: R.Tensor((2, 16, 2, 32), "float32"),
+        ):
+            gv = R.nn.attention(q, k, v, causal_mask=causal_mask)
+            return gv
+
+    with tvm.target.Target("llvm"):
+        mod = LegalizeOps()(Attention)
+    # The grouped heads are attended to by the flash attention kernel, online over the keys.
+    assert "attention_prefill" in [gvar.name_hint for gvar in mod.get_global_vars()]
+    assert "attention" not in [gvar.name_hint for gvar in mod.get_global_vars()]
+
+    q = np.random.uniform(size=(2, 16, 4, 32)).astype("float32")
+    k = np.random.uniform(size=(2, 16, 2, 32)).astype("float32")
+    v = np.random.uniform(size=(2, 16, 2, 32)).astype("float32")
+    vm = tvm.relax.VirtualMachine(tvm.compile(Attention, target="llvm"), tvm.cpu())
+    out = vm["main"](*[tvm.runtime.tensor(x) for x in [q, k, v]]).numpy()
+
+    k_rep, v_rep = np.repeat(k, 2, axis=2), np.repeat(v, 2, axis=2)
+    scores = np.einsum("bqhd,bkhd->bhqk", q, k_rep) / np.sqrt(32)
+    if causal_mask is not None:
+        scores = np.where(np.tril(np.ones((16, 16), dtype=bool)), scores, -np.inf)
+    probs = np.exp(scores - scores.max(axis=-1, keepdims=True))
+    probs = probs / probs.sum(axis=-1, keepdims=True)
+    expected = np.einsum("bhqk,bkhd->bqhd", probs, v_rep)
+    tvm.testing.assert_allclose(out, expected, rtol=1e-4, atol=1e-4)
+
+
 def test_nll_loss():
     # fmt: off
     @tvm.script.ir_module
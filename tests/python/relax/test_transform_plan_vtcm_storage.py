@@ -0,0 +1,155 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+@I.ir_module
+class Module:
+    @T.prim_func(private=True)
+    def exp(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        for i in range(16):
+            with T.sblock("exp"):
+                vi = T.axis.remap("S", [i])
+                B[vi] = T.exp(A[vi])
+
+    @T.prim_func(private=True)
+    def add(
+        A: T.Buffer((16,), "float32"),
+        B: T.Buffer((16,), "float32"),
+        C: T.Buffer((16,), "float32"),
+    ):
+        for i in range(16):
+            with T.sblock("add"):
+                vi = T.axis.remap("S", [i])
+                C[vi] = A[vi] + B[vi]
+
+    @R.function(pure=False)
+    def main(
+        x: R.Tensor((16,), dtype="float32"), y: R.Tensor((16,), dtype="float32")
+    ) -> R.Tensor((16,), dtype="float32"):
+        cls = Module
+        storage: R.Object = R.memory.alloc_storage(
+            R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+        )
+        a: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+            storage, offset=0, shape=R.shape([16]), dtype="float32"
+        )
+        _: R.Tuple() = cls.exp(x, a)
+        storage1: R.Object = R.memory.alloc_storage(
+            R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+        )
+        b: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+            storage1, offset=0, shape=R.shape([16]), dtype="float32"
+        )
+        _1: R.Tuple() = cls.exp(y, b)
+        storage2: R.Object = R.memory.alloc_storage(
+            R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+        )
+        c: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+            storage2, offset=0, shape=R.shape([16]), dtype="float32"
+        )
+        _2: R.Tuple() = cls.add(a, b, c)
+        return c
+
+
+def _storage_scopes(func):
+    """The storage scopes of the storages of a function, in order."""
+    scopes = []
+    for block in func.body.blocks:
+        for binding in block.bindings:
+            value = binding.value
+            if isinstance(value, relax.Call) and value.op.same_as(
+                tvm.ir.Op.get("relax.memory.alloc_storage")
+            ):
+                scopes.append(value.args[2].value)
+    return scopes
+
+
+def test_intermediates_in_vtcm():
+    with tvm.transform.PassContext(config={"tir.vtcm_capacity": 8192}):
+        after = relax.transform.PlanVTCMStorage()(Module)
+    # the storage of the result lives beyond the function
+    assert _storage_scopes(after["main"]) == ["global.vtcm", "global.vtcm", "global"]
+
+
+def test_shortest_lived_first():
+    # the storages take 2KB each, and only one of them fits
+    with tvm.transform.PassContext(config={"tir.vtcm_capacity": 2048}):
+        after = relax.transform.PlanVTCMStorage()(Module)
+    assert _storage_scopes(after["main"]) == ["global", "global.vtcm", "global"]
+
+
+def test_kernel_vtcm_is_reserved():
+    @I.ir_module
+    class Scratch:
+        @T.prim_func(private=True)
+        def exp(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            with T.sblock("root"):
+                A_vtcm = T.alloc_buffer((1024,), "float32", scope="global.vtcm")
+                for i in range(16):
+                    with T.sblock("load"):
+                        vi = T.axis.remap("S", [i])
+                        A_vtcm[vi] = A[vi]
+                for i in range(16):
+                    with T.sblock("exp"):
+                        vi = T.axis.remap("S", [i])
+                        B[vi] = T.exp(A_vtcm[vi])
+
+        @R.function(pure=False)
+        def main(x: R.Tensor((16,), dtype="float32"), y: R.Tensor((16,), dtype="float32")):
+            cls = Scratch
+            storage: R.Object = R.memory.alloc_storage(
+                R.shape([64]), virtual_device_index=0, storage_scope="global", dtype="float32"
+            )
+            a: R.Tensor((16,), dtype="float32") = R.memory.alloc_tensor(
+                storage, offset=0, shape=R.shape([16]), dtype="float32"
+            )
+            _: R.Tuple() = cls.exp(x, a)
+            _1: R.Tuple() = cls.exp(a, y)
+            return R.tuple()
+
+    # the 4KB of VTCM the kernels allocate leave no room for the storage
+    with tvm.transform.PassContext(config={"tir.vtcm_capacity": 4096}):
+        after = relax.transform.PlanVTCMStorage()(Scratch)
+    assert _storage_scopes(after["main"]) == ["global"]
+
+    with tvm.transform.PassContext(config={"tir.vtcm_capacity": 8192}):
+        after = relax.transform.PlanVTCMStorage()(Scratch)
+    assert _storage_scopes(after["main"]) == ["global.vtcm"]
+
+
+def test_disabled_without_capacity():
+    after = relax.transform.PlanVTCMStorage()(Module)
+    tvm.ir.assert_structural_equal(after, Module)
+
+
+def test_disabled_for_other_targets():
+    with tvm.target.Target("llvm"), tvm.transform.PassContext(
+        config={"tir.vtcm_capacity": 8192}
+    ):
+        after = relax.transform.PlanVTCMStorage()(Module)
+    tvm.ir.assert_structural_equal(after, Module)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
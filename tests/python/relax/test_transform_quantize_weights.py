@@ -0,0 +1,119 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class Linear:
+    @R.function
+    def main(
+        x: R.Tensor((4, 64), "float32"), w: R.Tensor((32, 64), "float32")
+    ) -> R.Tensor((4, 32), "float32"):
+        R.func_attr({"num_input": 1})
+        with R.dataflow():
+            wT = R.permute_dims(w)
+            gv = R.matmul(x, wT)
+            R.output(gv)
+        return gv
+
+
+def _call_tir_names(func):
+    return [
+        binding.value.args[0].name_hint
+        for block in func.body.blocks
+        for binding in block.bindings
+        if isinstance(binding.value, relax.Call)
+        and binding.value.op == tvm.ir.Op.get("relax.call_tir")
+    ]
+
+
+def _quantize_reference(w, dtype, group_size):
+    qmax = {"int4": 7.0, "int8": 127.0}[dtype]
+    groups = w.reshape(w.shape[0], -1, group_size)
+    scale = np.maximum(np.abs(groups).max(axis=-1, keepdims=True), 1e-12) / qmax
+    return (np.clip(np.round(groups / scale), -qmax, qmax) * scale).reshape(w.shape)
+
+
+@pytest.mark.parametrize("dtype", ["int4", "int8", "float8_e4m3fn"])
+def test_quantize_linear(dtype):
+    mod = relax.transform.QuantizeWeights(dtype, group_size=32)(Linear)
+    assert _call_tir_names(mod["main"]) == [f"encode_{dtype}", f"decode_matmul_{dtype}"]
+    quantized_sinfo = mod["main"].body.blocks[0].bindings[1].var.struct_info
+    if dtype == "int4":
+        # Eight 4-bit values are packed in each word
+        tvm.ir.assert_structural_equal(quantized_sinfo, R.Tensor((32, 8), "uint32"))
+    else:
+        tvm.ir.assert_structural_equal(quantized_sinfo, R.Tensor((32, 64), dtype))
+
+
+def test_group_size_not_dividing_is_unchanged():
+    mod = relax.transform.QuantizeWeights("int8", group_size=48)(Linear)
+    tvm.ir.assert_structural_equal(mod, Linear)
+
+
+def test_input_is_not_quantized():
+    @I.ir_module
+    class Matmul:
+        @R.function
+        def main(
+            x: R.Tensor((4, 64), "float32"), y: R.Tensor((64, 32), "float32")
+        ) -> R.Tensor((4, 32), "float32"):
+            R.func_attr({"num_input": 2})
+            with R.dataflow():
+                gv = R.matmul(x, y)
+                R.output(gv)
+            return gv
+
+    mod = relax.transform.QuantizeWeights("int8", group_size=32)(Matmul)
+    tvm.ir.assert_structural_equal(mod, Matmul)
+
+
+def test_lift_quantization_to_weight_prep():
+    mod = relax.transform.QuantizeWeights("int4", group_size=32)(Linear)
+    mod = relax.transform.LiftTransformParams()(mod)
+    assert _call_tir_names(mod["main_transform_params"]) == ["encode_int4"]
+    assert _call_tir_names(mod["main"]) == ["decode_matmul_int4"]
+
+
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("dtype", ["int4", "int8"])
+def test_numeric(dtype):
+    channel_scales = {"w": np.linspace(0.5, 2.0, 64).astype("float32")}
+    mod = relax.transform.QuantizeWeights(dtype, group_size=32, channel_scales=channel_scales)(
+        Linear
+    )
+    ex = tvm.compile(mod, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    x = np.random.rand(4, 64).astype("float32")
+    w = np.random.uniform(-1, 1, (32, 64)).astype("float32")
+    out = vm["main"](tvm.runtime.tensor(x), tvm.runtime.tensor(w)).numpy()
+
+    scales = channel_scales["w"]
+    expected = (x / scales) @ _quantize_reference(w * scales, dtype, 32).T
+    np.testing.assert_allclose(out, expected, rtol=1e-4, atol=1e-4)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
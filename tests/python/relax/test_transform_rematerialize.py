@@ -0,0 +1,98 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+def _get_module(exp_pattern):
+    @I.ir_module
+    class Module:
+        @T.prim_func(private=True)
+        def exp(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            T.func_attr({"op_pattern": exp_pattern})
+            T.evaluate(0)
+
+        @T.prim_func(private=True)
+        def tile(A: T.Buffer((16,), "float32"), B: T.Buffer((64,), "float32")):
+            T.func_attr({"op_pattern": 2})
+            T.evaluate(0)
+
+        @T.prim_func(private=True)
+        def relu(A: T.Buffer((64,), "float32"), B: T.Buffer((64,), "float32")):
+            T.func_attr({"op_pattern": 0})
+            T.evaluate(0)
+
+        @T.prim_func(private=True)
+        def fold(A: T.Buffer((64,), "float32"), B: T.Buffer((16,), "float32")):
+            T.func_attr({"op_pattern": 3})
+            T.evaluate(0)
+
+        @T.prim_func(private=True)
+        def add(
+            A: T.Buffer((16,), "float32"),
+            B: T.Buffer((16,), "float32"),
+            C: T.Buffer((16,), "float32"),
+        ):
+            T.func_attr({"op_pattern": 0})
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((16,), "float32")) -> R.Tensor((16,), "float32"):
+            cls = Module
+            with R.dataflow():
+                a = R.call_tir(cls.exp, (x,), out_sinfo=R.Tensor((16,), "float32"))
+                b = R.call_tir(cls.tile, (a,), out_sinfo=R.Tensor((64,), "float32"))
+                c = R.call_tir(cls.relu, (b,), out_sinfo=R.Tensor((64,), "float32"))
+                d = R.call_tir(cls.fold, (c,), out_sinfo=R.Tensor((16,), "float32"))
+                e = R.call_tir(cls.add, (d, a), out_sinfo=R.Tensor((16,), "float32"))
+                R.output(e)
+            return e
+
+    return Module
+
+
+def test_rematerialize():
+    before = _get_module(exp_pattern=0)
+    after = relax.transform.Rematerialize()(before)
+    bindings = after["main"].body.blocks[0].bindings
+    names = [binding.var.name_hint for binding in bindings]
+    assert names == ["a", "b", "c", "d", "a_remat", "e"]
+    # The recomputation repeats the call of `a`, and replaces its late use
+    assert bindings[4].value.same_as(bindings[0].value)
+    assert bindings[5].value.args[1][1].same_as(bindings[4].var)
+
+
+def test_within_budget_is_unchanged():
+    before = _get_module(exp_pattern=0)
+    after = relax.transform.Rematerialize(memory_budget=1 << 20)(before)
+    tvm.ir.assert_structural_equal(after, before)
+
+
+def test_expensive_op_is_kept():
+    # Recomputing a GEMM-like kernel is not worth the memory
+    before = _get_module(exp_pattern=4)
+    after = relax.transform.Rematerialize()(before)
+    tvm.ir.assert_structural_equal(after, before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -758,6 +758,32 @@ def test_static_args():
     tvm.ir.assert_structural_equal(mod, Expected)
 
 
+def test_hip_graph_builtins_for_rocm():
+    @I.ir_module
+    class Before:
+        @R.function(pure=False)
+        def main():
+            storage0 = R.memory.alloc_storage(R.shape([8]), 0, "global", "float32")
+            alloc0 = R.memory.alloc_tensor(storage0, 0, R.shape([8]), "float32")
+            _ = R.call_packed("dummy_func", alloc0, R.dtype("float32"), R.str("string"))
+            return R.tuple()
+
+    with tvm.target.Target("rocm"):
+        mod = relax.transform.RewriteCUDAGraph()(Before)
+    builtins = [
+        binding.value.args[0].global_symbol
+        for block in mod["main"].body.blocks
+        for binding in block.bindings
+        if isinstance(binding.value, relax.Call)
+        and binding.value.args
+        and isinstance(binding.value.args[0], relax.ExternFunc)
+    ]
+    assert builtins == [
+        "vm.builtin.hip_graph.get_cached_alloc",
+        "vm.builtin.hip_graph.run_or_capture",
+    ]
+
+
 def test_dynamic_capture():
     @I.ir_module
     class Before:
@@ -876,6 +902,60 @@ def test_dynamic_capture():
     tvm.ir.assert_structural_equal(mod, Expected)
 
 
+def test_dynamic_capture_with_buckets():
+    @I.ir_module
+    class Before:
+        @T.prim_func
+        def add_one(x_handle: T.handle, y_handle: T.handle):
+            m = T.int64()
+            x = T.match_buffer(x_handle, (m,), "float32")
+            y = T.match_buffer(y_handle, (m,), "float32")
+            for i in range(m):
+                with T.sblock("add"):
+                    vi = T.axis.remap("S", [i])
+                    y[vi] = x[vi] + T.float32(1)
+
+        @R.function
+        def main(x: R.Tensor(("m",), "float32")) -> R.Tensor(("m",), "float32"):
+            R.func_attr(
+                {
+                    "relax.rewrite_cuda_graph.capture_symbolic_var_buckets": {"m": [8, 16]},
+                    "relax.rewrite_cuda_graph.max_num_graphs": 4,
+                    "relax.force_pure": True,
+                }
+            )
+            m = T.int64()
+            storage: R.Object = R.memory.alloc_storage(R.shape([16]), 0, "global", "float32")
+            alloc1: R.Tensor((m,), "float32") = R.memory.alloc_tensor(
+                storage, 0, R.shape([m]), "float32"
+            )
+            _ = Before.add_one(x, alloc1)
+            storage1: R.Object = R.memory.alloc_storage(R.shape([16]), 0, "global", "float32")
+            alloc2: R.Tensor((m,), "float32") = R.memory.alloc_tensor(
+                storage1, 0, R.shape([m]), "float32"
+            )
+            _ = Before.add_one(alloc1, alloc2)
+            return alloc2
+
+    mod = relax.transform.RewriteCUDAGraph()(Before)
+    # The bucketed variable is captured as with the capture_symbolic_vars hint
+    assert "main_cuda_graph_capture" in [gv.name_hint for gv in mod.get_global_vars()]
+    calls = [
+        binding.value
+        for block in mod["main"].body.blocks
+        for binding in block.bindings
+        if isinstance(binding.value, relax.Call)
+        and binding.value.args
+        and isinstance(binding.value.args[0], relax.ExternFunc)
+        and binding.value.args[0].global_symbol == "vm.builtin.cuda_graph.run_or_capture"
+    ]
+    assert len(calls) == 1
+    _, _, _, shape_expr, buckets, max_num_graphs = calls[0].args[1].fields
+    assert len(shape_expr.values) == 1 and shape_expr.values[0].name == "m"
+    assert [[int(v) for v in bucket.values] for bucket in buckets.fields] == [[8, 16]]
+    assert max_num_graphs.value == 4
+
+
 def test_merge_alloc_funcs():
     @I.ir_module
     class Before:
@@ -0,0 +1,145 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+def _called_ops(mod):
+    ops = []
+
+    def _visit(expr):
+        if isinstance(expr, relax.Call):
+            if isinstance(expr.op, tvm.ir.Op):
+                ops.append(expr.op.name)
+
+    relax.analysis.post_order_visit(mod["main"], _visit)
+    return ops
+
+
+def _run(mod, inputs):
+    vm = relax.VirtualMachine(tvm.compile(mod, target="llvm"), tvm.cpu())
+    return vm["main"](*[tvm.runtime.tensor(x) for x in inputs])
+
+
+def test_slice_rows():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(x: R.Tensor((8, 16), "float32"), y: R.Tensor((4, 16), "float32")):
+            with R.dataflow():
+                s = R.strided_slice(x, axes=[0], begin=[2], end=[6])
+                out = R.add(s, y)
+                R.output(out)
+            return out
+
+    mod = relax.transform.LegalizeOps()(Module)
+    after = relax.transform.RewriteDataflowSlice()(mod)
+    ops = _called_ops(after)
+    assert ops.count("relax.call_tir") == 1
+    assert "relax.memory.view" in ops and "relax.memory.ensure_zero_offset" in ops
+
+    x = np.random.rand(8, 16).astype("float32")
+    y = np.random.rand(4, 16).astype("float32")
+    tvm.testing.assert_allclose(_run(Module, [x, y]).numpy(), x[2:6] + y, rtol=1e-6)
+
+
+def test_split_single_token():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(qkv: R.Tensor((1, 48), "float32")):
+            with R.dataflow():
+                split = R.split(qkv, 3, axis=1)
+                q = split[0]
+                k = split[1]
+                v = split[2]
+                out = R.add(R.multiply(q, k), v)
+                R.output(out)
+            return out
+
+    mod = relax.transform.LegalizeOps()(Module)
+    after = relax.transform.RewriteDataflowSlice()(mod)
+    ops = _called_ops(after)
+    assert ops.count("relax.memory.view") == 3
+    assert ops.count("relax.call_tir") == 2
+
+    qkv = np.random.rand(1, 48).astype("float32")
+    q, k, v = np.split(qkv, 3, axis=1)
+    tvm.testing.assert_allclose(_run(Module, [qkv]).numpy(), q * k + v, rtol=1e-6)
+
+
+def test_dynamic_slice_rows():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(x: R.Tensor(("n", 16), "float32")):
+            n = T.int64()
+            with R.dataflow():
+                s = R.strided_slice(x, axes=[0], begin=[n // 2], end=[n])
+                out = R.exp(s)
+                R.output(out)
+            return out
+
+    mod = relax.transform.LegalizeOps()(Module)
+    after = relax.transform.RewriteDataflowSlice()(mod)
+    assert "relax.memory.view" in _called_ops(after)
+
+    x = np.random.rand(6, 16).astype("float32")
+    tvm.testing.assert_allclose(_run(Module, [x]).numpy(), np.exp(x[3:]), rtol=1e-6)
+
+
+def test_no_rewrite_of_non_contiguous_slice():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(x: R.Tensor((4, 32), "float32")):
+            with R.dataflow():
+                s = R.strided_slice(x, axes=[1], begin=[16], end=[32])
+                out = R.exp(s)
+                R.output(out)
+            return out
+
+    mod = relax.transform.LegalizeOps()(Module)
+    after = relax.transform.RewriteDataflowSlice()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+def test_no_rewrite_of_unaligned_slice():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(x: R.Tensor((8, 3), "float32")):
+            with R.dataflow():
+                s = R.strided_slice(x, axes=[0], begin=[1], end=[5])
+                out = R.exp(s)
+                R.output(out)
+            return out
+
+    mod = relax.transform.LegalizeOps()(Module)
+    after = relax.transform.RewriteDataflowSlice()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,108 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class Linear:
+    @R.function
+    def main(
+        x: R.Tensor((4, 64), "float32"), w: R.Tensor((32, 64), "float32")
+    ) -> R.Tensor((4, 32), "float32"):
+        R.func_attr({"num_input": 1})
+        with R.dataflow():
+            wT = R.permute_dims(w)
+            gv = R.matmul(x, wT)
+            R.output(gv)
+        return gv
+
+
+def _call_tir_names(func):
+    return [
+        binding.value.args[0].name_hint
+        for block in func.body.blocks
+        for binding in block.bindings
+        if isinstance(binding.value, relax.Call)
+        and binding.value.op == tvm.ir.Op.get("relax.call_tir")
+    ]
+
+
+def _prune_2in4(w):
+    """Keep the two values of largest magnitude of each group of four, the earlier on ties."""
+    groups = w.reshape(w.shape[0], -1, 4)
+    order = np.argsort(-np.abs(groups), axis=-1, kind="stable")
+    mask = np.zeros_like(groups, dtype=bool)
+    np.put_along_axis(mask, order[..., :2], True, axis=-1)
+    return np.where(mask, groups, 0).reshape(w.shape)
+
+
+def test_sparsify_linear():
+    mod = relax.transform.SparsifyWeights()(Linear)
+    assert _call_tir_names(mod["main"]) == ["encode_2in4", "sparse_matmul"]
+    encoded_sinfo = mod["main"].body.blocks[0].bindings[0].var.struct_info
+    # Half of the values are kept, and the indices of sixteen of them are packed in each word.
+    tvm.ir.assert_structural_equal(
+        encoded_sinfo,
+        R.Tuple(R.Tensor((32, 32), "float32"), R.Tensor((32, 2), "uint32")),
+    )
+
+
+def test_in_features_not_multiple_of_32_is_unchanged():
+    @I.ir_module
+    class Matmul:
+        @R.function
+        def main(
+            x: R.Tensor((4, 48), "float32"), w: R.Tensor((48, 32), "float32")
+        ) -> R.Tensor((4, 32), "float32"):
+            R.func_attr({"num_input": 1})
+            with R.dataflow():
+                gv = R.matmul(x, w)
+                R.output(gv)
+            return gv
+
+    mod = relax.transform.SparsifyWeights()(Matmul)
+    tvm.ir.assert_structural_equal(mod, Matmul)
+
+
+def test_lift_packing_to_weight_prep():
+    mod = relax.transform.SparsifyWeights()(Linear)
+    mod = relax.transform.LiftTransformParams()(mod)
+    assert _call_tir_names(mod["main_transform_params"]) == ["encode_2in4"]
+    assert _call_tir_names(mod["main"]) == ["sparse_matmul"]
+
+
+@tvm.testing.requires_llvm
+def test_numeric():
+    mod = relax.transform.SparsifyWeights()(Linear)
+    ex = tvm.compile(mod, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    x = np.random.rand(4, 64).astype("float32")
+    w = np.random.uniform(-1, 1, (32, 64)).astype("float32")
+    # A weight pruned to 2:4 is computed exactly, and a dense one is pruned by magnitude.
+    for weight in [_prune_2in4(w), w]:
+        out = vm["main"](tvm.runtime.tensor(x), tvm.runtime.tensor(weight)).numpy()
+        np.testing.assert_allclose(out, x @ _prune_2in4(weight).T, rtol=1e-5, atol=1e-5)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,103 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+def _make_module():
+    @I.ir_module
+    class Module:
+        @T.prim_func(private=True)
+        def add_one(a: T.handle, b: T.handle):
+            n = T.int64()
+            A = T.match_buffer(a, (n, T.int64(4)), "float32")
+            B = T.match_buffer(b, (n, T.int64(4)), "float32")
+            for i, j in T.grid(n, T.int64(4)):
+                with T.sblock("add"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    B[vi, vj] = A[vi, vj] + T.float32(1)
+
+        @R.function
+        def main(x: R.Tensor((8, 4), "float32"), y: R.Tensor((16, 4), "float32")):
+            cls = Module
+            with R.dataflow():
+                a = R.call_tir(cls.add_one, (x,), out_sinfo=R.Tensor((8, 4), "float32"))
+                b = R.call_tir(cls.add_one, (a,), out_sinfo=R.Tensor((8, 4), "float32"))
+                c = R.call_tir(cls.add_one, (y,), out_sinfo=R.Tensor((16, 4), "float32"))
+                R.output(b, c)
+            return (b, c)
+
+    return Module
+
+
+def test_specialize_constant_shapes():
+    mod = relax.transform.SpecializePrimFuncShapes()(_make_module())
+    callees = [binding.value.args[0] for binding in mod["main"].body.blocks[0].bindings]
+    # The calls with the same constants share a specialized function.
+    assert callees[0].same_as(callees[1])
+    assert not callees[0].same_as(callees[2])
+    for callee, extent in zip([callees[0], callees[2]], [8, 16]):
+        func = mod[callee]
+        assert [int(dim) for dim in func.buffer_map[func.params[0]].shape] == [extent, 4]
+    # The symbolic function is no longer used.
+    assert "add_one" not in [gvar.name_hint for gvar in mod.get_global_vars()]
+
+
+def test_symbolic_call_site_is_unchanged():
+    @I.ir_module
+    class Module:
+        @T.prim_func(private=True)
+        def add_one(a: T.handle, b: T.handle):
+            n = T.int64()
+            A = T.match_buffer(a, (n,), "float32")
+            B = T.match_buffer(b, (n,), "float32")
+            for i in range(n):
+                with T.sblock("add"):
+                    vi = T.axis.remap("S", [i])
+                    B[vi] = A[vi] + T.float32(1)
+
+        @R.function
+        def main(x: R.Tensor(("n",), "float32")):
+            n = T.int64()
+            cls = Module
+            y = R.call_tir(cls.add_one, (x,), out_sinfo=R.Tensor((n,), "float32"))
+            return y
+
+    mod = relax.transform.SpecializePrimFuncShapes()(Module)
+    tvm.ir.assert_structural_equal(mod, Module)
+
+
+def test_build_specialized():
+    mod = _make_module()
+    ex = tvm.compile(mod, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    x = np.random.rand(8, 4).astype("float32")
+    y = np.random.rand(16, 4).astype("float32")
+    b, c = vm["main"](tvm.runtime.tensor(x), tvm.runtime.tensor(y))
+    tvm.testing.assert_allclose(b.numpy(), x + 2)
+    tvm.testing.assert_allclose(c.numpy(), y + 1)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,103 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relax, tir
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+
+
+@I.ir_module
+class Module:
+    @T.prim_func(private=True)
+    def add_one(a: T.handle, b: T.handle):
+        n = T.int64()
+        A = T.match_buffer(a, (n, T.int64(4)), "float32")
+        B = T.match_buffer(b, (n, T.int64(4)), "float32")
+        for i, j in T.grid(n, T.int64(4)):
+            with T.sblock("add"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vi, vj] + T.float32(1)
+
+    @R.function
+    def main(x: R.Tensor(("n", 4), "float32")) -> R.Tensor(("n", 4), "float32"):
+        n = T.int64()
+        cls = Module
+        with R.dataflow():
+            y = R.call_tir(cls.add_one, (x,), out_sinfo=R.Tensor((n, 4), "float32"))
+            R.output(y)
+        return y
+
+
+def test_specialize_buckets():
+    mod = relax.transform.SpecializeSymbolicVarBuckets("n", [32, 16])(Module)
+    assert not mod["main"].body.blocks[0].is_dataflow
+    for bucket in [16, 32]:
+        func = mod[f"add_one_n{bucket}"]
+        buf = func.buffer_map[func.params[0]]
+        assert [int(dim) for dim in buf.shape] == [bucket, 4]
+    # The dynamic function is kept as the fallback
+    assert isinstance(mod["add_one"].buffer_map[mod["add_one"].params[0]].shape[0], tir.Var)
+    assert isinstance(mod["main"].body.blocks[0].bindings[0].value, relax.If)
+
+
+def test_unrelated_var_is_unchanged():
+    mod = relax.transform.SpecializeSymbolicVarBuckets("m", [16])(Module)
+    tvm.ir.assert_structural_equal(mod, Module)
+
+
+def test_static_caller_calls_bucket_directly():
+    @I.ir_module
+    class Static:
+        @T.prim_func(private=True)
+        def add_one(a: T.handle, b: T.handle):
+            n = T.int64()
+            A = T.match_buffer(a, (n,), "float32")
+            B = T.match_buffer(b, (n,), "float32")
+            for i in range(n):
+                with T.sblock("add"):
+                    vi = T.axis.remap("S", [i])
+                    B[vi] = A[vi] + T.float32(1)
+
+        @R.function
+        def main(x: R.Tensor((16,), "float32")) -> R.Tensor((16,), "float32"):
+            cls = Static
+            y = R.call_tir(cls.add_one, (x,), out_sinfo=R.Tensor((16,), "float32"))
+            return y
+
+    mod = relax.transform.SpecializeSymbolicVarBuckets("n", [16])(Static)
+    call = mod["main"].body.blocks[0].bindings[0].value
+    assert call.args[0].name_hint == "add_one_n16"
+
+
+@tvm.testing.requires_llvm
+def test_dispatch_by_bucket():
+    mod = relax.transform.SpecializeSymbolicVarBuckets("n", [16, 32])(Module)
+    ex = tvm.compile(mod, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    for n in [16, 20, 32]:
+        x = np.random.rand(n, 4).astype("float32")
+        out = vm["main"](tvm.runtime.tensor(x)).numpy()
+        np.testing.assert_allclose(out, x + 1)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -159,7 +159,7 @@ def test_basic():
             cls = ExpectedLowered
             storage: R.Object = R.vm.alloc_storage(R.shape([32]), R.prim_value(0), R.dtype("uint8"))
             alloc: R.Tensor((2, 4), dtype="float32") = R.vm.alloc_tensor(storage, R.prim_value(0), R.shape([2, 4]), R.dtype("float32"))
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             lv1: R.Tensor((8,), dtype="float32") = R.call_packed("vm.builtin.reshape", alloc, R.shape([8]), sinfo_args=(R.Tensor((8,), dtype="float32"),))
             _ = R.vm.kill_object(alloc)
             storage1: R.Object = R.vm.alloc_storage(R.shape([40]), R.prim_value(0), R.dtype("uint8"))
@@ -724,7 +724,7 @@ def test_symbolic_shape():
             alloc: R.Tensor((m, n), dtype="float32") = R.memory.alloc_tensor(
                 storage, R.prim_value(0), R.shape([m, n]), R.dtype("float32")
             )
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             y: R.Tensor((m, n), dtype="float32") = alloc
             return x
 
@@ -996,7 +996,7 @@ def test_tir_var_upper_bound():
             cls = Expected
             storage: R.Object = R.memory.alloc_storage(R.shape([32]), R.prim_value(0), R.str("global"), R.dtype("float32"))
             alloc: R.Tensor((2, n), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, n]), R.dtype("float32"))
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             lv: R.Tensor((2, n), dtype="float32") = alloc
             lv1: R.Tensor((2 * n,), dtype="float32") = R.reshape(lv, R.shape([2 * n]))
             storage1: R.Object = R.memory.alloc_storage(R.shape([40]), R.prim_value(0), R.str("global"), R.dtype("float32"))
@@ -1103,7 +1103,7 @@ def test_lower_bound_only():
             cls = Expected
             storage: R.Object = R.memory.alloc_storage(R.shape([8 * n]), R.prim_value(0), R.str("global"), R.dtype("float32"))
             alloc: R.Tensor((2, n), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, n]), R.dtype("float32"), R.prim_value(0))
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             lv: R.Tensor((2, n), dtype="float32") = alloc
             lv1: R.Tensor((2 * n,), dtype="float32") = R.reshape(lv, R.shape([2 * n]))
             storage1: R.Object = R.memory.alloc_storage(R.shape([4 * (2 * n)]), R.prim_value(0), R.str("global"), R.dtype("float32"))
@@ -1211,7 +1211,7 @@ def test_upper_and_lower_bounds():
             cls = Expected
             storage: R.Object = R.memory.alloc_storage(R.shape([32]), R.prim_value(0), R.str("global"), R.dtype("float32"))
             alloc: R.Tensor((2, n), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, n]), R.dtype("float32"))
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             lv: R.Tensor((2, n), dtype="float32") = alloc
             lv1: R.Tensor((2 * n,), dtype="float32") = R.reshape(lv, R.shape([2 * n]))
             storage1: R.Object = R.memory.alloc_storage(R.shape([40]), R.prim_value(0), R.str("global"), R.dtype("float32"))
@@ -1550,10 +1550,10 @@ def test_function_independence():
             cls = Expected
             storage: R.Object = R.memory.alloc_storage(R.shape([32]), R.prim_value(0), R.str("global"), R.dtype("float32"))
             alloc: R.Tensor((8,), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([8]), R.dtype("float32"))
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             lv: R.Tensor((8,), dtype="float32") = alloc
             alloc1: R.Tensor((8,), dtype="float32") = R.builtin.alloc_tensor(R.shape([8]), R.dtype("float32"), R.prim_value(0))
-            _1: R.Tuple = cls.exp(lv, alloc1)
+            _1: R.Tuple() = cls.exp(lv, alloc1)
             gv: R.Tensor((8,), dtype="float32") = alloc1
             return gv
 
@@ -1563,10 +1563,10 @@ def test_function_independence():
             cls = Expected
             storage1: R.Object = R.memory.alloc_storage(R.shape([40]), R.prim_value(0), R.str("global"), R.dtype("float32"))
             alloc: R.Tensor((10,), dtype="float32") = R.memory.alloc_tensor(storage1, R.prim_value(0), R.shape([10]), R.dtype("float32"))
-            _: R.Tuple = cls.exp(x, alloc)
+            _: R.Tuple() = cls.exp(x, alloc)
             lv: R.Tensor((10,), dtype="float32") = alloc
             alloc1: R.Tensor((10,), dtype="float32") = R.builtin.alloc_tensor(R.shape([10]), R.dtype("float32"), R.prim_value(0))
-            _1: R.Tuple = cls.exp(lv, alloc1)
+            _1: R.Tuple() = cls.exp(lv, alloc1)
             gv: R.Tensor((10,), dtype="float32") = alloc1
             return gv
     # fmt: on
@@ -1773,5 +1773,163 @@ def test_with_dataflow():
     tvm.ir.assert_structural_equal(after, Expected)
 
 
+def test_arena():
+    # fmt: off
+    @I.ir_module
+    class Before:
+        @T.prim_func
+        def exp(A: T.Buffer((T.int64(2), T.int64(4)), "float32"), B: T.Buffer((T.int64(2), T.int64(4)), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Before
+            alloc: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            alloc2: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _2: R.Tuple() = cls.exp(alloc1, alloc2)
+            alloc3: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _3: R.Tuple() = cls.exp(alloc2, alloc3)
+            return alloc3
+
+    @I.ir_module
+    class Expected:
+        @T.prim_func
+        def exp(A: T.Buffer((T.int64(2), T.int64(4)), "float32"), B: T.Buffer((T.int64(2), T.int64(4)), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Expected
+            storage: R.Object = R.memory.alloc_storage(R.shape([96]), R.prim_value(0), R.str("global"), R.dtype("uint8"))
+            alloc: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(64), R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            alloc2: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _2: R.Tuple() = cls.exp(alloc1, alloc2)
+            alloc3: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0), R.str("global"))
+            _3: R.Tuple() = cls.exp(alloc2, alloc3)
+            return alloc3
+    # fmt: on
+
+    with tvm.transform.PassContext(config={"relax.StaticPlanBlockMemory.arena": True}):
+        mod = relax.transform.StaticPlanBlockMemory()(Before)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
+def test_shared_arena():
+    # fmt: off
+    @I.ir_module
+    class Before:
+        @T.prim_func
+        def exp(A: T.Buffer((T.int64(2), T.int64(4)), "float32"), B: T.Buffer((T.int64(2), T.int64(4)), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def prefill(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Before
+            alloc: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            alloc2: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _2: R.Tuple() = cls.exp(alloc1, alloc2)
+            return alloc2
+
+        @R.function
+        def decode(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Before
+            alloc: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            return alloc1
+
+    @I.ir_module
+    class Expected:
+        @T.prim_func
+        def exp(A: T.Buffer((T.int64(2), T.int64(4)), "float32"), B: T.Buffer((T.int64(2), T.int64(4)), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def prefill(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Expected
+            storage: R.Object = R.call_builtin_with_ctx("vm.builtin.alloc_shared_workspace", (R.shape([96]), R.prim_value(0), R.dtype("uint8"), R.str("global"), R.prim_value(0)), sinfo_args=(R.Object,))
+            alloc: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(64), R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            alloc2: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0), R.str("global"))
+            _2: R.Tuple() = cls.exp(alloc1, alloc2)
+            return alloc2
+
+        @R.function
+        def decode(x: R.Tensor((2, 4), dtype="float32")) -> R.Tensor((2, 4), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Expected
+            storage: R.Object = R.call_builtin_with_ctx("vm.builtin.alloc_shared_workspace", (R.shape([96]), R.prim_value(0), R.dtype("uint8"), R.str("global"), R.prim_value(0)), sinfo_args=(R.Object,))
+            alloc: R.Tensor((2, 4), dtype="float32") = R.memory.alloc_tensor(storage, R.prim_value(0), R.shape([2, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((2, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([2, 4]), R.dtype("float32"), R.prim_value(0), R.str("global"))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            return alloc1
+    # fmt: on
+
+    config = {"relax.StaticPlanBlockMemory.shared_arena_funcs": ["prefill", "decode"]}
+    with tvm.transform.PassContext(config=config):
+        mod = relax.transform.StaticPlanBlockMemory()(Before)
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
+def test_dynamic_arena():
+    # fmt: off
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def exp(var_A: T.handle, var_B: T.handle):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor(("n", 4), dtype="float32")) -> R.Tensor(("n", 4), dtype="float32"):
+            n = T.int64()
+            R.func_attr({"tir_var_upper_bound": {"n": 16}, "relax.force_pure": True})
+            cls = Module
+            alloc: R.Tensor((n, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([n, 4]), R.dtype("float32"), R.prim_value(0))
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((n, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([n, 4]), R.dtype("float32"), R.prim_value(0))
+            _1: R.Tuple() = cls.exp(alloc, alloc1)
+            alloc2: R.Tensor((n, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([n, 4]), R.dtype("float32"), R.prim_value(0))
+            _2: R.Tuple() = cls.exp(alloc1, alloc2)
+            alloc3: R.Tensor((n, 4), dtype="float32") = R.builtin.alloc_tensor(R.shape([n, 4]), R.dtype("float32"), R.prim_value(0))
+            _3: R.Tuple() = cls.exp(alloc2, alloc3)
+            return alloc3
+    # fmt: on
+
+    with tvm.transform.PassContext(config={"relax.StaticPlanBlockMemory.dynamic_arena": True}):
+        mod = relax.transform.StaticPlanBlockMemory()(Module)
+    bindings = mod["main"].body.blocks[0].bindings
+    storage = bindings[0].value
+    assert storage.args[0].global_symbol == "vm.builtin.alloc_shared_workspace"
+    size = storage.args[1].fields[0].values[0]
+    offsets = [binding.value.args[1].value for binding in bindings[1:6:2]]
+    n = mod["main"].params[0].struct_info.shape.values[0]
+
+    def evaluate(expr, value):
+        return int(tvm.arith.Analyzer().simplify(tvm.tir.stmt_functor.substitute(expr, {n: value})))
+
+    # The arena is sized by the actual value of n, within its upper bound 16
+    assert [evaluate(size, 1), evaluate(size, 16)] == [80, 512]
+    assert [evaluate(offset, 1) for offset in offsets] == [0, 64, 0]
+    assert [evaluate(offset, 16) for offset in offsets] == [0, 256, 0]
+
+
 if __name__ == "__main__":
     tvm.testing.main()
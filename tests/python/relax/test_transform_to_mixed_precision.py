@@ -16,6 +16,7 @@
 # under the License.
 
 import numpy as np
+import pytest
 
 import tvm
 import tvm.testing
@@ -1120,5 +1121,31 @@ def test_dynamic_strided_slice():
     _assert_test(Input, Expected)
 
 
+def test_policy_overrides():
+    @I.ir_module
+    class Input:
+        @R.function
+        def main(
+            x: R.Tensor((2, 3, 28, 28), "float32"), w: R.Tensor((4, 3, 3, 3), "float32")
+        ) -> R.Tensor(None, "float32", ndim=4):
+            with R.dataflow():
+                gv: R.Tensor((2, 4, 26, 26), "float32") = R.nn.conv2d(x, w, out_dtype="float32")
+                R.output(gv)
+            return gv
+
+    mod = ToMixedPrecision(op_policy={"relax.nn.conv2d": "never"})(Input)
+    tvm.ir.assert_structural_equal(mod, Input)
+    mod = ToMixedPrecision(fp32_bindings=["gv"])(Input)
+    tvm.ir.assert_structural_equal(mod, Input)
+    # Other bindings are still rewritten.
+    mod = ToMixedPrecision(fp32_bindings=["lv"])(Input)
+    assert not tvm.ir.structural_equal(mod, Input)
+
+    with pytest.raises(ValueError):
+        ToMixedPrecision(op_policy={"relax.nn.conv2d": "sometimes"})(Input)
+    with pytest.raises(ValueError):
+        ToMixedPrecision(op_policy={"relax.nn.relu": "always"})(Input)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -16,7 +16,10 @@
 # under the License.
 """Test Naive allocator with memory scope for Relax VM"""
 
+import json
+
 import numpy as np
+import pytest
 
 import tvm
 import tvm.testing
@@ -74,5 +77,66 @@ def test_alloc_storage_with_scope_global():
     tvm.testing.assert_allclose(output_ref, output)
 
 
+@pytest.mark.parametrize("memory_cfg", ["pooled_best_fit", "stream_ordered"])
+def test_alloc_storage_memory_cfg_cpu(memory_cfg):
+    arg0 = np.random.uniform(size=(2, 2)).astype(np.float32)
+    with tvm.transform.PassContext(opt_level=3):
+        lib = tvm.relax.build(Module, target="llvm", exec_mode="compiled")
+    # stream_ordered is CUDA only and falls back to the pooled allocator on CPU
+    vm_rt = relax.VirtualMachine(lib, tvm.cpu(), memory_cfg=memory_cfg)
+    x = tvm.runtime.tensor(arg0)
+    for _ in range(3):
+        output = vm_rt["main"](x).numpy()
+        tvm.testing.assert_allclose(arg0 + arg0, output)
+
+
+def test_memory_report_call_sites():
+    arg0 = np.random.uniform(size=(2, 2)).astype(np.float32)
+    with tvm.transform.PassContext(opt_level=3):
+        lib = tvm.relax.build(Module, target="llvm", exec_mode="compiled")
+    vm_rt = relax.VirtualMachine(lib, tvm.cpu())
+    x = tvm.runtime.tensor(arg0)
+    set_tracking = tvm.get_global_func("vm.builtin.memory_manager.set_allocation_tracking")
+    report = tvm.get_global_func("vm.builtin.memory_manager.report")
+    set_tracking(True)
+    try:
+        output = vm_rt["main"](x)
+        result = json.loads(report())
+        assert result["tracking"]
+        cpu = [d for d in result["devices"] if "call_sites" in d and d["in_use_bytes"] > 0]
+        assert cpu
+        sites = {site["name"]: site for site in cpu[0]["call_sites"]}
+        assert sites["main"]["live_count"] >= 1
+        assert cpu[0]["peak_in_use_bytes"] >= cpu[0]["in_use_bytes"]
+        del output
+        result = json.loads(report())
+        for dev in result["devices"]:
+            for alloc in dev["allocators"]:
+                assert alloc["cached_bytes"] <= alloc["reserved_bytes"]
+    finally:
+        set_tracking(False)
+
+
+@tvm.testing.requires_cuda
+def test_alloc_storage_stream_ordered_cuda():
+    @I.ir_module
+    class AllocOnly:
+        @R.function(pure=False)
+        def main():
+            storage = R.vm.alloc_storage(
+                R.shape([16]), runtime_device_index=0, dtype="float32", storage_scope="global"
+            )
+            alloc = R.vm.alloc_tensor(storage, offset=0, shape=R.shape([4]), dtype="float32")
+            return alloc
+
+    lib = tvm.relax.build(AllocOnly, target="cuda")
+    dev = tvm.cuda()
+    vm_rt = relax.VirtualMachine(lib, dev, memory_cfg="stream_ordered")
+    for _ in range(3):
+        output = vm_rt["main"]()
+        assert output.shape == (4,)
+        assert output.device == dev
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -17,6 +17,7 @@
 # ruff: noqa: F841
 
 import ctypes
+import threading
 from collections.abc import Callable
 
 import numpy as np
@@ -62,6 +63,23 @@ def test_vm_compile_simple(exec_mode):
     tvm.testing.assert_allclose(inp2.numpy(), inp1.numpy(), rtol=1e-7, atol=1e-7)
 
 
+def test_compile_exec_mode(exec_mode):
+    @tvm.script.ir_module
+    class Module:
+        @R.function
+        def foo(x: R.Tensor((3, 4), "float32"), y: R.Tensor((3, 4), "float32")):
+            z = R.add(x, y)
+            return z
+
+    target = tvm.target.Target("llvm", host="llvm")
+    ex = tvm.compile(Module, target, exec_mode=exec_mode)
+    inp1 = tvm.runtime.tensor(np.random.rand(3, 4).astype(np.float32))
+    inp2 = tvm.runtime.tensor(np.random.rand(3, 4).astype(np.float32))
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    res = vm["foo"](inp1, inp2)
+    tvm.testing.assert_allclose(res.numpy(), inp1.numpy() + inp2.numpy(), rtol=1e-7, atol=1e-7)
+
+
 def test_vm_compile_without_target_arg(exec_mode):
     """Like test_vm_compile_simple, but with a default target"""
 
@@ -185,6 +203,89 @@ def test_vm_compile_e2e(exec_mode):
     tvm.testing.assert_allclose(res.numpy(), np.tile(inp.numpy(), (1, 2)), rtol=1e-7, atol=1e-7)
 
 
+def test_vm_fork_runs_concurrently(exec_mode):
+    @tvm.script.ir_module
+    class Module:
+        @R.function
+        def foo(x: R.Tensor((32, 16), "float32")):
+            with R.dataflow():
+                y = R.add(R.multiply(x, R.const(2.0, "float32")), x)
+                R.output(y)
+            return y
+
+    ex = tvm.compile(Module, tvm.target.Target("llvm", host="llvm"), exec_mode=exec_mode)
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    # Each thread runs its own fork, which shares the constants and functions of the VM.
+    vms = [vm] + [vm.fork() for _ in range(3)]
+    inputs = [np.random.rand(32, 16).astype("float32") for _ in vms]
+    outputs = [None] * len(vms)
+
+    def _run(i):
+        for _ in range(20):
+            outputs[i] = vms[i]["foo"](tvm.runtime.tensor(inputs[i])).numpy()
+
+    threads = [threading.Thread(target=_run, args=(i,)) for i in range(len(vms))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    for inp, out in zip(inputs, outputs):
+        tvm.testing.assert_allclose(out, inp * 3, rtol=1e-6, atol=1e-6)
+
+
+def test_vm_nvtx_ranges(exec_mode):
+    @tvm.script.ir_module
+    class Module:
+        @R.function
+        def foo(x: R.Tensor((4, 4), "float32")):
+            with R.dataflow():
+                y = R.add(x, x)
+                z = R.multiply(y, x)
+                R.output(z)
+            return z
+
+    ex = tvm.compile(Module, tvm.target.Target("llvm", host="llvm"), exec_mode=exec_mode)
+    # The names of the bindings of the instructions are kept by the serialized executable.
+    temp = utils.tempdir()
+    path = temp.relpath("exec.so")
+    ex.export_library(path)
+    vm = relax.VirtualMachine(tvm.runtime.load_module(path), tvm.cpu())
+    vm.set_nvtx_ranges(True)
+    inp = np.random.rand(4, 4).astype("float32")
+    res = vm["foo"](tvm.runtime.tensor(inp))
+    tvm.testing.assert_allclose(res.numpy(), (inp + inp) * inp, rtol=1e-6, atol=1e-6)
+    vm.set_nvtx_ranges(False)
+    res = vm["foo"](tvm.runtime.tensor(inp))
+    tvm.testing.assert_allclose(res.numpy(), (inp + inp) * inp, rtol=1e-6, atol=1e-6)
+
+
+def test_vm_invoke_async(exec_mode):
+    @tvm.script.ir_module
+    class Module:
+        @R.function
+        def foo(x: R.Tensor((4, 4), "float32")):
+            with R.dataflow():
+                y = R.add(x, x)
+                R.output(y)
+            return y
+
+    ex = tvm.compile(Module, tvm.target.Target("llvm", host="llvm"), exec_mode=exec_mode)
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    inp = np.random.rand(4, 4).astype("float32")
+    done = threading.Event()
+    results = []
+
+    def _callback(result):
+        results.append(result.numpy())
+        done.set()
+
+    future = vm.invoke_async("foo", tvm.runtime.tensor(inp), callback=_callback)
+    tvm.testing.assert_allclose(future.wait().numpy(), inp * 2, rtol=1e-6, atol=1e-6)
+    assert future.done()
+    assert done.wait(timeout=10)
+    tvm.testing.assert_allclose(results[0], inp * 2, rtol=1e-6, atol=1e-6)
+
+
 def test_vm_compile_e2e_func_param_with_shape(exec_mode):
     @tvm.script.ir_module
     class TestVMCompileE2E2:
@@ -21,6 +21,7 @@ import pytest
 
 import tvm
 from tvm import TVMError, relax
+from tvm.contrib import utils
 from tvm.relax.testing.vm import check_saved_func
 from tvm.script import relax as R
 
@@ -47,6 +48,29 @@ def test_vm_execute():
     tvm.testing.assert_allclose(add_res.numpy(), a.numpy() + b.numpy(), rtol=1e-7, atol=1e-7)
 
 
+def test_vm_load_constants_from_file():
+    # The payload of the large constant starts on a page of the file, the small one is packed.
+    large = np.random.rand(64, 33).astype("float32")
+    small = np.random.rand(3).astype("float32")
+    ib = relax.ExecBuilder()
+    with ib.function("func0", num_inputs=0):
+        c = ib.convert_constant(tvm.runtime.tensor(large))
+        ib.emit_call("test.vm.add", args=[c, c], dst=ib.r(0))
+        ib.emit_ret(ib.r(0))
+    with ib.function("func1", num_inputs=0):
+        c = ib.convert_constant(tvm.runtime.tensor(small))
+        ib.emit_call("test.vm.add", args=[c, c], dst=ib.r(0))
+        ib.emit_ret(ib.r(0))
+    ex = ib.get()
+    with utils.tempdir() as temp:
+        path = temp.relpath("exec.bin")
+        ex.mod.write_to_file(path)
+        loaded = tvm.get_global_func("relax.ExecutableLoadFromFile")(path)
+        vm = relax.VirtualMachine(loaded, tvm.cpu())
+        tvm.testing.assert_allclose(vm["func0"]().numpy(), large + large, rtol=1e-7, atol=1e-7)
+        tvm.testing.assert_allclose(vm["func1"]().numpy(), small + small, rtol=1e-7, atol=1e-7)
+
+
 def test_vm_multiple_func():
     ib = relax.ExecBuilder()
     with ib.function("func0", num_inputs=2):
@@ -241,6 +265,56 @@ def test_vm_if():
     tvm.testing.assert_allclose(res.numpy(), a.numpy() + b.numpy(), rtol=1e-7, atol=1e-7)
 
 
+@pytest.mark.parametrize("predecoded", [True, False])
+def test_vm_predecoded_dispatch(predecoded):
+    ib = relax.ExecBuilder()
+    with ib.function("inner", num_inputs=2):
+        ib.emit_call("test.vm.add", args=[ib.r(0), ib.r(1)], dst=ib.r(2))
+        ib.emit_ret(ib.r(2))
+    with ib.function("main", num_inputs=3):
+        ib.emit_if(ib.r(0), 3)
+        ib.emit_call("inner", args=[ib.r(1), ib.r(2)], dst=ib.r(3))
+        ib.emit_goto(2)
+        ib.emit_call("test.vm.mul", args=[ib.r(1), ib.r(2)], dst=ib.r(3))
+        ib.emit_call("inner", args=[ib.r(3), ib.r(1)], dst=ib.r(4))
+        ib.emit_ret(ib.r(4))
+    ex = ib.get()
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    vm["set_predecoded_dispatch"](predecoded)
+    a = tvm.runtime.tensor(np.random.rand(4))
+    b = tvm.runtime.tensor(np.random.rand(4))
+    for _ in range(2):
+        res = vm["main"](0, a, b)
+        expected = a.numpy() * b.numpy() + a.numpy()
+        tvm.testing.assert_allclose(res.numpy(), expected, rtol=1e-7, atol=1e-7)
+        res = vm["main"](1, a, b)
+        expected = a.numpy() + b.numpy() + a.numpy()
+        tvm.testing.assert_allclose(res.numpy(), expected, rtol=1e-7, atol=1e-7)
+
+
+def test_vm_frame_pool_steady_state():
+    ib = relax.ExecBuilder()
+    with ib.function("inner", num_inputs=2):
+        ib.emit_call("test.vm.add", args=[ib.r(0), ib.r(1)], dst=ib.r(2))
+        ib.emit_ret(ib.r(2))
+    with ib.function("main", num_inputs=2):
+        ib.emit_call("inner", args=[ib.r(0), ib.r(1)], dst=ib.r(2))
+        ib.emit_call("inner", args=[ib.r(2), ib.r(1)], dst=ib.r(3))
+        ib.emit_ret(ib.r(3))
+    ex = ib.get()
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    a = tvm.runtime.tensor(np.random.rand(4))
+    b = tvm.runtime.tensor(np.random.rand(4))
+    vm["main"](a, b)
+    num_alloc = vm["get_frame_stats"]()["frame_alloc_count"]
+    for _ in range(10):
+        res = vm["main"](a, b)
+    stats = vm["get_frame_stats"]()
+    assert stats["frame_alloc_count"] == num_alloc
+    assert stats["frame_reuse_count"] >= 30
+    tvm.testing.assert_allclose(res.numpy(), a.numpy() + 2 * b.numpy(), rtol=1e-7, atol=1e-7)
+
+
 def test_vm_invoke_closure():
     ib = relax.ExecBuilder()
     with ib.function("lifted_func_1", num_inputs=4):
@@ -15,7 +15,10 @@
 # specific language governing permissions and limitations
 # under the License.
 # ruff: noqa: RUF005
+import json
+
 import numpy as np
+import pytest
 
 import tvm
 import tvm.testing
@@ -63,6 +66,50 @@ def test_conv2d_cpu():
     assert "matmul" in str(report)
 
 
+def test_roofline_metrics():
+    data_np = np.random.randn(1, 64).astype("float32")
+    ex = get_exec(data_np.shape)
+
+    vm = relax.VirtualMachine(ex, tvm.cpu(), profile=True)
+    report = vm.profile("main", tvm.runtime.tensor(data_np))
+    assert "GFLOP/s" in str(report)
+
+    calls = json.loads(report.json())["calls"]
+    matmul_calls = [call for call in calls if "matmul" in call["Name"]["string"]]
+    assert matmul_calls
+    for call in matmul_calls:
+        # A matmul of (1, 64) by (64, 64), reading and writing each buffer once.
+        assert call["FLOPs"]["count"] >= 2 * 64 * 64
+        assert call["DRAM Bytes"]["count"] >= (64 + 64 * 64 + 64) * 4
+        assert call["GFLOP/s"]["ratio"] > 0
+        assert call["GB/s"]["ratio"] > 0
+
+
+@pytest.mark.skipif(
+    tvm.support.libinfo().get("USE_PERF_EVENT", "OFF") != "ON",
+    reason="TVM is not built with USE_PERF_EVENT",
+)
+def test_perf_event_collector():
+    data_np = np.random.randn(1, 64).astype("float32")
+    ex = get_exec(data_np.shape)
+
+    vm = relax.VirtualMachine(ex, tvm.cpu(), profile=True)
+    try:
+        collector = tvm.runtime.profiling.PerfEventMetricCollector(["cycles", "instructions"])
+        report = vm.profile("main", tvm.runtime.tensor(data_np), collectors=[collector])
+    except tvm.error.TVMError as err:
+        if "perf_event_open" in str(err):
+            pytest.skip("perf events are not accessible")
+        raise
+
+    calls = json.loads(report.json())["calls"]
+    matmul_calls = [call for call in calls if "matmul" in call["Name"]["string"]]
+    assert matmul_calls
+    for call in matmul_calls:
+        assert call["instructions"]["count"] > 0
+        assert call["IPC"]["ratio"] > 0
+
+
 def with_rpc(ex, f, data_np):
     temp = utils.tempdir()
     path = temp.relpath("vm_library.so")
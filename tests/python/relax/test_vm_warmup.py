@@ -0,0 +1,81 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+@I.ir_module
+class Module:
+    @R.function
+    def main(
+        x: R.Tensor(("n", 64), "float32"), w: R.Tensor((64, 32), "float32")
+    ) -> R.Tensor(("n", 32), "float32"):
+        R.func_attr({"tir_var_upper_bound": {"n": 16}})
+        with R.dataflow():
+            gv = R.matmul(x, w)
+            R.output(gv)
+        return gv
+
+    @R.function
+    def unbounded(x: R.Tensor(("m",), "float32")) -> R.Tensor(("m",), "float32"):
+        return x
+
+    @R.function
+    def shape_input(s: R.Shape(["k"])) -> R.Shape(["k"]):
+        return s
+
+
+def test_get_warmup_shapes():
+    shapes = relax.analysis.get_warmup_shapes(Module)
+    assert shapes == {"main": [((16, 64), "float32"), ((64, 32), "float32")]}
+
+    shapes = relax.analysis.get_warmup_shapes(Module, var_values={"n": 4, "m": 8})
+    assert shapes["main"] == [((4, 64), "float32"), ((64, 32), "float32")]
+    assert shapes["unbounded"] == [((8,), "float32")]
+    assert "shape_input" not in shapes
+
+
+@tvm.testing.requires_llvm
+def test_warmup():
+    ex = tvm.compile(Module, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    buckets = [
+        relax.analysis.get_warmup_shapes(Module, var_values={"n": n})["main"] for n in [4, 16]
+    ]
+    report = vm.warmup({"main": buckets})
+    assert [call["shapes"][0] for call in report["calls"]] == [(4, 64), (16, 64)]
+    for key in ["module_load", "input_alloc", "first_call", "lazy_init"]:
+        assert report[key] >= 0.0
+    assert report["lazy_init"] <= report["first_call"]
+
+    # The explicit inputs are used as they are.
+    x = tvm.runtime.tensor(np.ones((2, 64), "float32"))
+    report = vm.warmup({"main": [x, ((64, 32), "float32")]})
+    assert [call["shapes"] for call in report["calls"]] == [[(2, 64), (64, 32)]]
+
+    with pytest.raises(TypeError):
+        vm.warmup({"main": [["x"]]})
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -19,6 +19,8 @@ import os
 import subprocess
 import sys
 
+import numpy as np
+
 import tvm
 import tvm.testing
 
@@ -48,5 +50,26 @@ def test_check_if_device_exists():
     )
 
 
+@tvm.testing.parametrize_targets("llvm", "cuda", "rocm", "metal", "opencl", "vulkan")
+def test_event_record_wait_sync(dev):
+    """An event recorded on the default stream can be waited for by a side stream and by the
+    host, and recorded again."""
+    data = np.random.rand(1024).astype("float32")
+    arr = tvm.runtime.tensor(data, dev)
+    stream = dev.create_raw_stream()
+    event = dev.create_raw_event()
+    try:
+        dev.record_event(event)
+        dev.stream_wait_event(event, stream)
+        dev.sync_event(event)
+        dev.record_event(event, stream)
+        dev.sync_event(event)
+    finally:
+        dev.free_raw_event(event)
+        if stream:
+            dev.free_raw_stream(stream)
+    np.testing.assert_array_equal(arr.numpy(), data)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
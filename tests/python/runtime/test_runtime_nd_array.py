@@ -250,5 +250,27 @@ def test_2d_view_of_second_half_of_2d_arr():
     np.testing.assert_equal(tvm_output.numpy(), np_expected)
 
 
+
+def test_convert_float16():
+    convert = tvm.get_global_func("runtime.TVMTensorConvertFloat")
+    np_input = np.random.uniform(-4, 4, size=(3, 37)).astype("float32")
+    half = tvm.runtime.empty(np_input.shape, "float16")
+    convert(tvm.runtime.tensor(np_input), half)
+    np.testing.assert_equal(half.numpy(), np_input.astype("float16"))
+
+    single = tvm.runtime.empty(np_input.shape, "float32")
+    convert(half, single)
+    np.testing.assert_equal(single.numpy(), np_input.astype("float16").astype("float32"))
+
+
+def test_convert_bfloat16():
+    convert = tvm.get_global_func("runtime.TVMTensorConvertFloat")
+    np_input = np.random.uniform(-4, 4, size=(67,)).astype("float32")
+    bf16 = tvm.runtime.empty(np_input.shape, "bfloat16")
+    convert(tvm.runtime.tensor(np_input), bf16)
+    single = tvm.runtime.empty(np_input.shape, "float32")
+    convert(bf16, single)
+    tvm.testing.assert_allclose(single.numpy(), np_input, rtol=1e-2)
+
 if __name__ == "__main__":
     tvm.testing.main()
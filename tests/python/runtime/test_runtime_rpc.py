@@ -159,6 +159,69 @@ def test_rpc_large_array():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_large_array_streamed():
+    # the copy is split into many blocks with several of them in flight
+    os.environ["TVM_RPC_COPY_BLOCK_BYTES"] = str(64 << 10)
+    os.environ["TVM_RPC_COPY_WINDOW"] = "3"
+    try:
+        server = rpc.Server()
+        remote = rpc.connect("127.0.0.1", server.port)
+        dev = remote.cpu(0)
+        a_np = np.random.uniform(size=(1001, 257)).astype("float32")
+        a = tvm.runtime.tensor(a_np, dev)
+        np.testing.assert_equal(a.numpy(), a_np)
+        b = tvm.runtime.empty((16,), "float32", dev)
+        b.copyfrom(a_np[0, :16])
+        np.testing.assert_equal(b.numpy(), a_np[0, :16])
+    finally:
+        del os.environ["TVM_RPC_COPY_BLOCK_BYTES"]
+        del os.environ["TVM_RPC_COPY_WINDOW"]
+
+
+@tvm.testing.requires_rpc
+def test_rpc_pipelined():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+    dev = remote.cpu(0)
+    fecho = remote.get_function("testing.echo")
+    raise_err = remote.get_function("testing.test_raise_error")
+
+    # replies complete in issue order, an error only fails its own future
+    futures = [remote.call_async(fecho, i) for i in range(100)]
+    ferr = remote.call_async(raise_err, "RuntimeError", "msg")
+    flast = remote.call_async(fecho, "xyz")
+    assert flast.result() == "xyz"
+    assert [f.result() for f in futures] == list(range(100))
+    with pytest.raises(tvm.error.RPCError):
+        ferr.result()
+
+    # overlap uploads and downloads, also across several copy blocks
+    os.environ["TVM_RPC_COPY_BLOCK_BYTES"] = str(64 << 10)
+    try:
+        a_nps = [np.random.uniform(size=(257, 129)).astype("float32") for _ in range(4)]
+        remote_tensors = [tvm.runtime.empty(a_np.shape, "float32", dev) for a_np in a_nps]
+        host_tensors = [tvm.runtime.empty(a_np.shape, "float32") for a_np in a_nps]
+        uploads = [
+            remote.copy_to_remote_async(tvm.runtime.tensor(a_np), remote_tensor)
+            for a_np, remote_tensor in zip(a_nps, remote_tensors)
+        ]
+        downloads = [
+            remote.copy_from_remote_async(remote_tensor, host_tensor)
+            for remote_tensor, host_tensor in zip(remote_tensors, host_tensors)
+        ]
+        for a_np, upload, download in zip(a_nps, uploads, downloads):
+            upload.result()
+            np.testing.assert_equal(download.result().numpy(), a_np)
+    finally:
+        del os.environ["TVM_RPC_COPY_BLOCK_BYTES"]
+
+    # a synchronous call waits for the pipelined requests before it
+    fpending = remote.call_async(fecho, 1)
+    assert fecho(2) == 2
+    assert fpending.result() == 1
+
+
 @tvm.testing.skip_if_32bit(reason="skipping test for i386.")
 @tvm.testing.requires_rpc
 def test_rpc_echo():
@@ -223,6 +286,26 @@ def test_rpc_file_exchange():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_upload_cached():
+    cache_dir = utils.tempdir()
+    os.environ["TVM_RPC_ARTIFACT_CACHE_DIR"] = cache_dir.temp_dir
+    try:
+        server = rpc.Server()
+        remote = rpc.connect("127.0.0.1", server.port)
+        blob = bytearray(np.random.randint(0, 10, size=(10)))
+        path = remote.upload_cached(blob, "dat.bin")
+        assert path.startswith(cache_dir.temp_dir) and path.endswith("dat.bin")
+        assert remote.download(path) == blob
+        # the second upload of the same content is a cache hit, even from another session
+        remote = rpc.connect("127.0.0.1", server.port)
+        assert remote.upload_cached(blob, "other.bin").endswith("other.bin")
+        assert remote.upload_cached(blob, "dat.bin") == path
+        assert len(cache_dir.listdir()) == 2
+    finally:
+        del os.environ["TVM_RPC_ARTIFACT_CACHE_DIR"]
+
+
 @tvm.testing.requires_rpc
 @tvm.testing.requires_llvm
 def test_rpc_remote_module():
@@ -294,6 +377,14 @@ def test_rpc_remote_module():
         cost = time_f(a, b).mean
         np.testing.assert_equal(b.numpy(), a.numpy() + 1)
 
+        # payloads larger than the shared-memory ring buffers, and the pipe-only fallback.
+        for shm_capacity in [4096, 0]:
+            remote = tvm.rpc.PopenSession(path_minrpc, shm_capacity=shm_capacity)
+            dev = remote.cpu(0)
+            a_np = np.random.uniform(size=(1 << 16) + 3).astype(A.dtype)
+            a = tvm.runtime.tensor(a_np, dev)
+            np.testing.assert_equal(a.numpy(), a_np)
+
         # change to not executable
         os.chmod(path_minrpc, stat.S_IRUSR)
         with pytest.raises(RuntimeError):
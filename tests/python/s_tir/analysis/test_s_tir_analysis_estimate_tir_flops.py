@@ -22,7 +22,11 @@ import pytest
 
 import tvm.testing
 from tvm.ir import IRModule
-from tvm.s_tir.analysis import estimate_tir_flops
+from tvm.s_tir.analysis import (
+    estimate_tir_flops,
+    estimate_tir_memory_traffic,
+    estimate_tir_roofline,
+)
 from tvm.s_tir.meta_schedule.testing.te_workload import create_te_workload
 from tvm.script import tir as T
 
@@ -141,5 +145,46 @@ def test_flops_with_variable_extent():
     assert estimate_tir_flops(IRModule({"main": flops_with_variable_extent})) == 120
 
 
+@T.prim_func
+def matmul(
+    a: T.Buffer((64, 32), "float32"),
+    b: T.Buffer((32, 16), "float32"),
+    c: T.Buffer((64, 16), "float32"),
+    unused: T.Buffer((1024,), "float32"),
+):
+    for i, j, k in T.grid(64, 16, 32):
+        with T.sblock("matmul"):
+            vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+            with T.init():
+                c[vi, vj] = T.float32(0)
+            c[vi, vj] = c[vi, vj] + a[vi, vk] * b[vk, vj]
+
+
+@T.prim_func
+def copy_with_symbolic_shape(a_handle: T.handle, b_handle: T.handle):
+    n = T.int64()
+    a = T.match_buffer(a_handle, (n,), "float32")
+    b = T.match_buffer(b_handle, (n,), "float32")
+    for i in range(n):
+        with T.sblock("copy"):
+            vi = T.axis.spatial(n, i)
+            b[vi] = a[vi]
+
+
+def test_memory_traffic():
+    # The accumulator is both read and written, and the unused buffer is not accessed.
+    assert estimate_tir_memory_traffic(matmul) == (64 * 32 + 32 * 16 + 2 * 64 * 16) * 4
+    assert estimate_tir_memory_traffic(copy_with_symbolic_shape) is None
+
+
+def test_roofline():
+    roofline = estimate_tir_roofline(IRModule({"matmul": matmul, "copy": copy_with_symbolic_shape}))
+    assert list(roofline.keys()) == ["matmul"]
+    nbytes = (64 * 32 + 32 * 16 + 2 * 64 * 16) * 4
+    assert roofline["matmul"]["flops"] == 2 * 64 * 16 * 32
+    assert roofline["matmul"]["bytes"] == nbytes
+    assert roofline["matmul"]["arithmetic_intensity"] == 2 * 64 * 16 * 32 / nbytes
+
+
 if __name__ == "__main__":
     tvm.testing.main()
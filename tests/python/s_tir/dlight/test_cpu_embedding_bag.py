@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-docstring
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import te, tir, topi
+from tvm.s_tir import dlight as dl
+from tvm.target import Target
+
+
+def _schedule(func):
+    mod = tvm.IRModule({"main": func})
+    with Target("llvm"):
+        return dl.ApplyDefaultSchedule(dl.cpu.EmbeddingBag())(mod)
+
+
+def _loops(func):
+    loops = []
+    tir.stmt_functor.post_order_visit(
+        func.body, lambda node: loops.append(node) if isinstance(node, tir.For) else None
+    )
+    return loops
+
+
+def _run(mod, inputs, out_shape, out_dtype):
+    lib = tvm.compile(mod, target="llvm")
+    args = [tvm.runtime.tensor(x) for x in inputs]
+    out = tvm.runtime.empty(out_shape, out_dtype)
+    lib["main"](*args, out)
+    return out.numpy()
+
+
+@pytest.mark.parametrize("mode", ["sum", "mean"])
+def test_multi_table_embedding_bag(mode):
+    # two tables of 600 and 400 rows, with bags of 6 indices padded by -1
+    weight = te.placeholder((1000, 64), "float32", name="weight")
+    indices = te.placeholder((256, 2, 6), "int32", name="indices")
+    offsets = te.placeholder((2,), "int32", name="offsets")
+    out = topi.nn.embedding_bag(weight, indices, offsets, mode=mode)
+    func = te.create_prim_func([weight, indices, offsets, out])
+    mod = _schedule(func)
+    assert mod["main"].attrs["tir.is_scheduled"]
+    loops = _loops(mod["main"])
+    kinds = [loop.kind for loop in loops]
+    assert tir.ForKind.PARALLEL in kinds
+    assert tir.ForKind.VECTORIZED in kinds
+    assert any("software_prefetch_distance" in loop.annotations for loop in loops)
+
+    w = np.random.uniform(-1, 1, size=(1000, 64)).astype("float32")
+    sizes = np.array([600, 400])
+    idx = np.random.randint(0, 400, size=(256, 2, 6)).astype("int32")
+    idx[:, :, 4:] = np.where(np.random.uniform(size=(256, 2, 2)) < 0.5, -1, idx[:, :, 4:])
+    offs = np.array([0, sizes[0]], dtype="int32")
+    valid = idx >= 0
+    rows = np.where(valid[..., None], w[np.maximum(idx, 0) + offs[None, :, None]], 0)
+    expected = rows.sum(axis=-2)
+    if mode == "mean":
+        expected /= np.maximum(valid.sum(axis=-1), 1)[..., None]
+    tvm.testing.assert_allclose(
+        _run(mod, [w, idx, offs], (256, 2, 64), "float32"), expected, rtol=1e-5, atol=1e-5
+    )
+
+
+def test_half_embedding_bag():
+    weight = te.placeholder((1000, 24), "float16", name="weight")
+    indices = te.placeholder((64, 8), "int64", name="indices")
+    func = te.create_prim_func([weight, indices, topi.nn.embedding_bag(weight, indices)])
+    mod = _schedule(func)
+    assert mod["main"].attrs["tir.is_scheduled"]
+
+    w = np.random.uniform(-1, 1, size=(1000, 24)).astype("float16")
+    idx = np.random.randint(0, 1000, size=(64, 8)).astype("int64")
+    expected = w[idx].astype("float32").sum(axis=-2).astype("float16")
+    tvm.testing.assert_allclose(_run(mod, [w, idx], (64, 24), "float16"), expected, rtol=1e-2)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
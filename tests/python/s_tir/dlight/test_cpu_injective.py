@@ -0,0 +1,109 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-docstring
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import te, tir, topi
+from tvm.s_tir import dlight as dl
+from tvm.target import Target
+
+
+def _schedule(func, *rules):
+    mod = tvm.IRModule({"main": func})
+    with Target("llvm"):
+        return dl.ApplyDefaultSchedule(*rules)(mod)
+
+
+def _loop_kinds(func):
+    kinds = []
+    tir.stmt_functor.post_order_visit(
+        func.body, lambda node: kinds.append(node.kind) if isinstance(node, tir.For) else None
+    )
+    return kinds
+
+
+def _run(mod, inputs, out_shape, out_dtype):
+    lib = tvm.compile(mod, target="llvm")
+    args = [tvm.runtime.tensor(x) for x in inputs]
+    out = tvm.runtime.empty(out_shape, out_dtype)
+    lib["main"](*args, out)
+    return out.numpy()
+
+
+def test_transpose():
+    a = te.placeholder((64, 512), "float32", name="A")
+    func = te.create_prim_func([a, topi.transpose(a, [1, 0])])
+    mod = _schedule(func, dl.cpu.Transpose(), dl.cpu.Injective())
+    assert mod["main"].attrs["tir.is_scheduled"]
+    kinds = _loop_kinds(mod["main"])
+    assert kinds.count(tir.ForKind.VECTORIZED) == 2
+    assert tir.ForKind.UNROLLED in kinds
+    assert tir.ForKind.PARALLEL in kinds
+
+    x = np.random.uniform(size=(64, 512)).astype("float32")
+    tvm.testing.assert_allclose(_run(mod, [x], (512, 64), "float32"), x.T)
+
+
+def test_transpose_keeps_innermost_axis():
+    # the innermost axis is not moved, so the rows are copied contiguously
+    a = te.placeholder((2, 16, 8, 64), "float16", name="A")
+    func = te.create_prim_func([a, topi.transpose(a, [0, 2, 1, 3])])
+    mod = _schedule(func, dl.cpu.Transpose())
+    tvm.ir.assert_structural_equal(mod["main"], func)
+
+    mod = _schedule(func, dl.cpu.Transpose(), dl.cpu.Injective())
+    assert tir.ForKind.VECTORIZED in _loop_kinds(mod["main"])
+    x = np.random.uniform(size=(2, 16, 8, 64)).astype("float16")
+    tvm.testing.assert_allclose(
+        _run(mod, [x], (2, 8, 16, 64), "float16"), x.transpose(0, 2, 1, 3)
+    )
+
+
+def test_take():
+    weight = te.placeholder((1000, 256), "float32", name="weight")
+    indices = te.placeholder((128,), "int32", name="indices")
+    func = te.create_prim_func([weight, indices, topi.take(weight, indices, axis=0)])
+    mod = _schedule(func, dl.cpu.Transpose(), dl.cpu.Injective())
+    kinds = _loop_kinds(mod["main"])
+    assert tir.ForKind.VECTORIZED in kinds
+    assert tir.ForKind.PARALLEL in kinds
+
+    w = np.random.uniform(size=(1000, 256)).astype("float32")
+    idx = np.random.randint(0, 1000, size=(128,)).astype("int32")
+    tvm.testing.assert_allclose(_run(mod, [w, idx], (128, 256), "float32"), w[idx])
+
+
+def test_concatenate():
+    a = te.placeholder((4, 24), "float32", name="A")
+    b = te.placeholder((4, 40), "float32", name="B")
+    func = te.create_prim_func([a, b, topi.concatenate([a, b], axis=1)])
+    mod = _schedule(func, dl.cpu.Transpose(), dl.cpu.Injective())
+    kinds = _loop_kinds(mod["main"])
+    # too small to be worth the parallel tasks
+    assert tir.ForKind.PARALLEL not in kinds
+
+    x = np.random.uniform(size=(4, 24)).astype("float32")
+    y = np.random.uniform(size=(4, 40)).astype("float32")
+    tvm.testing.assert_allclose(
+        _run(mod, [x, y], (4, 64), "float32"), np.concatenate([x, y], axis=1)
+    )
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,70 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-docstring
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import te, tir, topi
+from tvm.s_tir import dlight as dl
+from tvm.target import Target
+
+
+def _thread_extents(func):
+    extents = {}
+
+    def _visit(node):
+        if isinstance(node, tir.For) and node.thread_binding is not None:
+            extents[node.thread_binding.thread_tag] = int(node.extent)
+
+    tir.stmt_functor.post_order_visit(func.body, _visit)
+    return extents
+
+
+@pytest.mark.parametrize("mode", ["sum", "mean"])
+def test_warp_per_bag(mode):
+    weight = te.placeholder((1000, 64), "float16", name="weight")
+    indices = te.placeholder((256, 20), "int32", name="indices")
+    out = topi.nn.embedding_bag(weight, indices, mode=mode)
+    mod = tvm.IRModule({"main": te.create_prim_func([weight, indices, out])})
+    target = Target("nvidia/geforce-rtx-3090-ti")
+    with target:
+        mod = dl.ApplyDefaultSchedule(dl.gpu.EmbeddingBag())(mod)
+    assert mod["main"].attrs["tir.is_scheduled"]
+    extents = _thread_extents(mod["main"])
+    assert extents["threadIdx.x"] == 32
+    assert extents["threadIdx.y"] == 4
+    assert extents["blockIdx.x"] == 64
+
+    if not tvm.testing.device_enabled("cuda"):
+        return
+    dev = tvm.cuda()
+    lib = tvm.compile(mod, target=target)
+    w = np.random.uniform(-1, 1, size=(1000, 64)).astype("float16")
+    idx = np.random.randint(-1, 1000, size=(256, 20)).astype("int32")
+    valid = idx >= 0
+    expected = np.where(valid[..., None], w[np.maximum(idx, 0)].astype("float32"), 0).sum(1)
+    if mode == "mean":
+        expected /= np.maximum(valid.sum(axis=-1), 1)[..., None]
+    res = tvm.runtime.empty((256, 64), "float16", dev)
+    lib["main"](tvm.runtime.tensor(w, dev), tvm.runtime.tensor(idx, dev), res)
+    tvm.testing.assert_allclose(res.numpy(), expected.astype("float16"), rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -219,6 +219,31 @@ def test_meta_schedule_error_handle_time_out():
         assert error_msg.startswith("LocalBuilder: Timeout")
 
 
+def test_meta_schedule_builder_reuses_workers():
+    """Test that the worker processes are kept across builds, and recycled"""
+
+    def initializer():
+        @register_global_func("meta_schedule.builder.test_export_pid")
+        def export_pid(mod: Module) -> str:  # pylint: disable=unused-variable,unused-argument
+            return str(os.getpid())
+
+    def build_pids(builder):
+        builder_inputs = [BuilderInput(MatmulModule, Target("llvm"))]
+        return [result.artifact_path for _ in range(3) for result in builder.build(builder_inputs)]
+
+    builder = LocalBuilder(
+        max_workers=1, f_export="meta_schedule.builder.test_export_pid", initializer=initializer
+    )
+    assert len(set(build_pids(builder))) == 1
+    builder = LocalBuilder(
+        max_workers=1,
+        f_export="meta_schedule.builder.test_export_pid",
+        initializer=initializer,
+        maximum_process_uses=1,
+    )
+    assert len(set(build_pids(builder))) == 3
+
+
 def test_meta_schedule_missing_build_func():
     with pytest.raises(ValueError):
         LocalBuilder(f_build="wrong-name")
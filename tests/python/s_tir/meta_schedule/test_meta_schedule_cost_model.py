@@ -27,9 +27,9 @@ import numpy as np
 
 import tvm
 import tvm.testing
-from tvm.s_tir.meta_schedule.cost_model import PyCostModel, RandomModel, XGBModel
+from tvm.s_tir.meta_schedule.cost_model import GBDTModel, PyCostModel, RandomModel, XGBModel
 from tvm.s_tir.meta_schedule.cost_model.xgb_model import PackSum, _get_custom_call_back
-from tvm.s_tir.meta_schedule.feature_extractor import RandomFeatureExtractor
+from tvm.s_tir.meta_schedule.feature_extractor import PyFeatureExtractor, RandomFeatureExtractor
 from tvm.s_tir.meta_schedule.runner import RunnerResult
 from tvm.s_tir.meta_schedule.search_strategy import MeasureCandidate
 from tvm.s_tir.meta_schedule.tune_context import TuneContext
@@ -258,6 +258,72 @@ def test_meta_schedule_xgb_model_reupdate():
     model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
 
 
+def test_meta_schedule_gbdt_model():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=2, num_rounds=10)
+    update_sample_count = 10
+    predict_sample_count = 100
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for i in range(update_sample_count)],
+        [_dummy_result() for i in range(update_sample_count)],
+    )
+    res = model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
+    assert res.shape == (predict_sample_count,)
+    assert np.isfinite(res).all()
+
+
+def test_meta_schedule_gbdt_model_fit():
+    @derived_object
+    class FixedFeatureExtractor(PyFeatureExtractor):
+        def __init__(self, features):
+            super().__init__()
+            self.features = features
+
+        def extract_from(self, context, candidates):
+            return [tvm.runtime.tensor(x) for x in self.features]
+
+    n = 40
+    features = [np.array([[i, i % 3]], dtype="float32") for i in range(n)]
+    costs = np.arange(n, dtype="float64") + 1.0
+    model = GBDTModel(
+        extractor=FixedFeatureExtractor(features),
+        num_warmup_samples=0,
+        adaptive_training=False,
+    )
+    candidates = [_dummy_candidate() for _ in range(n)]
+    model.update(TuneContext(), candidates, [RunnerResult([c], None) for c in costs])
+    res = model.predict(TuneContext(), candidates)
+    # The labels are `min_cost / cost`, so the fastest candidates get the highest scores
+    assert np.abs(res - costs.min() / costs).max() < 0.05
+    assert np.argmax(res) == 0
+
+
+def test_meta_schedule_gbdt_model_reload():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=10, num_rounds=10)
+    update_sample_count = 20
+    predict_sample_count = 30
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for i in range(update_sample_count)],
+        [_dummy_result() for i in range(update_sample_count)],
+    )
+    with tempfile.NamedTemporaryFile() as path:
+        random_state = model.extractor.random_state  # save feature extractor's random state
+        model.save(path.name)
+        res1 = model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+        new_model = GBDTModel(extractor=extractor, num_warmup_samples=10, num_rounds=10)
+        new_model.load(path.name)
+        model.extractor.random_state = random_state  # load feature extractor's random state
+        res2 = new_model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+    assert (res1 == res2).all()
+
+
 def test_meta_schedule_xgb_model_callback_as_function():
     # pylint: disable=import-outside-toplevel
     from itertools import chain as itertools_chain
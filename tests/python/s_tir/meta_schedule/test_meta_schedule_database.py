@@ -54,6 +54,22 @@ class Matmul:
                 C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
 
 
+@tvm.script.ir_module
+class Matmul256:
+    @T.prim_func
+    def main(a: T.handle, b: T.handle, c: T.handle) -> None:
+        T.func_attr({"global_symbol": "main"})
+        A = T.match_buffer(a, (256, 256), "float32")
+        B = T.match_buffer(b, (256, 256), "float32")
+        C = T.match_buffer(c, (256, 256), "float32")
+        for i, j, k in T.grid(256, 256, 256):
+            with T.sblock("matmul"):
+                vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                with T.init():
+                    C[vi, vj] = 0.0
+                C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
+
+
 @tvm.script.ir_module
 class MatmulRelu:
     @T.prim_func
@@ -91,6 +107,18 @@ def _schedule_matmul(sch: Schedule):
     sch.reorder(i_0, j_0, i_1, j_1, k_0, i_2, j_2, k_1, i_3, j_3)
 
 
+def _schedule_matmul_sampled(sch: Schedule):
+    block = sch.get_sblock("matmul")
+    i, j, k = sch.get_loops(block=block)
+    i_tiles = sch.sample_perfect_tile(i, n=4, decision=[4, 8, 2, 16])
+    j_tiles = sch.sample_perfect_tile(j, n=4, decision=[2, 64, 1, 8])
+    k_tiles = sch.sample_perfect_tile(k, n=2, decision=[256, 4])
+    i_0, i_1, i_2, i_3 = sch.split(loop=i, factors=i_tiles)
+    j_0, j_1, j_2, j_3 = sch.split(loop=j, factors=j_tiles)
+    k_0, k_1 = sch.split(loop=k, factors=k_tiles)
+    sch.reorder(i_0, j_0, i_1, j_1, k_0, i_2, j_2, k_1, i_3, j_3)
+
+
 def _create_schedule(mod: IRModule, sch_fn: Callable[[Schedule], None]) -> Schedule:
     sch = tvm.s_tir.Schedule(mod=mod, debug_mask="all")
     sch_fn(sch)
@@ -586,6 +614,109 @@ def test_json_database_get_top_k(k, expected):
     assert result == expected
 
 
+@pytest.mark.parametrize(
+    "k,expected",
+    [
+        (0, []),
+        (4, [[0.0, 2.0], [2.0], [1.5, 4.5], [3.0, 1e10]]),
+        (5, [[0.0, 2.0], [2.0], [1.5, 4.5], [3.0, 1e10]]),
+    ],
+)
+def test_indexed_database_get_top_k(k, expected):
+    run_secs_list = [[1.5, 4.5], [], [0.0, 2.0], None, [2.0], [3.0, 1e10], [1e10]]
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = ms.database.IndexedDatabase(osp.join(tmpdir, "db"))
+        result = call_get_top_k(run_secs_list, database, k)
+        # The same records are ranked from the index after reopening the database
+        reopened = ms.database.IndexedDatabase(database.path, allow_missing=False)
+        assert len(reopened) == len(run_secs_list)
+        workload = reopened.commit_workload(Matmul)
+        reloaded = [[v.value for v in r.run_secs] for r in reopened.get_top_k(workload, k)]
+    assert result == expected
+    assert reloaded == expected
+
+
+def test_indexed_database_reload():
+    mod: IRModule = Matmul
+    trace = _create_schedule(mod, _schedule_matmul).trace
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = ms.database.IndexedDatabase(osp.join(tmpdir, "db"))
+        token = database.commit_workload(mod)
+        records = [
+            ms.database.TuningRecord(
+                trace,
+                token,
+                run_secs,
+                tvm.target.Target("llvm"),
+                ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+            )
+            for run_secs in [[7.0, 8.0, 9.0], [1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]
+        ]
+        for record in records:
+            database.commit_tuning_record(record)
+        new_database = ms.database.IndexedDatabase(database.path, allow_missing=False)
+        assert new_database.has_workload(mod)
+        assert not new_database.has_workload(MatmulRelu)
+        token = new_database.commit_workload(mod)
+        ret = new_database.get_top_k(token, 2)
+        assert len(ret) == 2
+        _equal_record(ret[0], records[1])
+        _equal_record(ret[1], records[2])
+        all_records = new_database.get_all_tuning_records()
+        assert [r.run_secs[0].value for r in all_records] == [1.0, 4.0, 7.0]
+        with pytest.raises(ValueError):
+            ms.database.IndexedDatabase(database.path, module_equality="ignore-tensor")
+
+
+def test_indexed_database_concurrent_writers():
+    mod: IRModule = Matmul
+    trace = _create_schedule(mod, _schedule_matmul).trace
+    with tempfile.TemporaryDirectory() as tmpdir:
+        # Two handles on one directory behave like two tuning jobs sharing the database
+        db_1 = ms.database.IndexedDatabase(osp.join(tmpdir, "db"))
+        db_2 = ms.database.IndexedDatabase(db_1.path)
+        token_1 = db_1.commit_workload(mod)
+        assert db_2.has_workload(mod)
+        token_2 = db_2.commit_workload(mod)
+        for i in range(4):
+            db = db_1 if i % 2 == 0 else db_2
+            token = token_1 if i % 2 == 0 else token_2
+            db.commit_tuning_record(ms.database.TuningRecord(trace, token, [4.0 - i]))
+        # Each handle sees the records committed by the other one without reopening
+        for db, token in [(db_1, token_1), (db_2, token_2)]:
+            assert len(db) == 4
+            assert [r.run_secs[0].value for r in db.get_top_k(token, 3)] == [1.0, 2.0, 3.0]
+        reopened = ms.database.IndexedDatabase(db_1.path, allow_missing=False)
+        assert len(reopened) == 4
+        assert len(reopened.get_all_tuning_records()) == 4
+
+
+def test_query_fuzzy_tuning_records():
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = _create_tmp_database(tmpdir)
+        workload = database.commit_workload(Matmul)
+        database.commit_tuning_record(
+            ms.database.TuningRecord(
+                _create_schedule(Matmul, _schedule_matmul_sampled).trace,
+                workload,
+                [1.5],
+                tvm.target.Target("llvm"),
+                ms.arg_info.ArgInfo.from_prim_func(func=Matmul["main"]),
+            )
+        )
+        target = tvm.target.Target("llvm")
+        (record,) = database.query_fuzzy_tuning_records(Matmul256, target, top_k=4)
+        assert record.run_secs is None
+        tvm.ir.assert_structural_equal(record.workload.mod, Matmul256)
+        # The tile sizes are rescaled from the extent 1024 to 256
+        decisions = sorted([int(x) for x in d] for d in record.trace.decisions.values())
+        assert decisions == [[1, 8, 2, 16], [1, 32, 1, 8], [64, 4]]
+        sch = Schedule(Matmul256)
+        record.trace.apply_to_schedule(sch, remove_postproc=False)
+        # A workload is not a fuzzy match of itself
+        assert len(database.query_fuzzy_tuning_records(Matmul, target, top_k=4)) == 0
+
+
 def MatmulPrimFunc() -> IRModule:
     return Matmul
 
@@ -19,6 +19,7 @@
 import sys
 from collections.abc import Callable
 
+import numpy as np
 import pytest
 from numpy.testing import assert_allclose
 
@@ -1641,5 +1642,23 @@ def test_negative_extent():
     assert named_features["B0.unique_bytes"] == 0
 
 
+@pytest.mark.parametrize("extract_workload", [False, True])
+def test_extract_batch(extract_workload):
+    extractor = ms.feature_extractor.PerStoreFeature(extract_workload=extract_workload)
+    context = ms.TuneContext(mod=matmul, target=tvm.target.Target("llvm"), num_threads=4)
+    candidates = [
+        _make_candidate(lambda: s_tir.Schedule(matmul)),
+        _make_candidate(lambda: s_tir.Schedule(negative_extent)),
+        _make_candidate(lambda: s_tir.Schedule(LayoutTransform)),
+    ] * 3
+    expected = [f.numpy() for f in extractor.extract_from(context, candidates)]
+    features, row_offsets = extractor.extract_batch(context, candidates)
+    features, row_offsets = features.numpy(), row_offsets.numpy()
+    assert features.dtype == "float32"
+    assert list(row_offsets) == [0] + list(np.cumsum([f.shape[0] for f in expected]))
+    for i, feature in enumerate(expected):
+        assert_allclose(features[row_offsets[i] : row_offsets[i + 1]], feature, rtol=1e-6)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
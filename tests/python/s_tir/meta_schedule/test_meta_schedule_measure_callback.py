@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 # pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import json
+import os
 import re
 import tempfile
 
@@ -173,9 +175,52 @@ def test_meta_schedule_measure_callback_update_cost_model_with_runtime_error():
         )
 
 
+def test_meta_schedule_measure_callback_log_metrics():
+    @ms.derived_object
+    class ConstantRunnerFuture(ms.runner.PyRunnerFuture):
+        def done(self) -> bool:
+            return True
+
+        def result(self) -> ms.runner.RunnerResult:
+            return ms.runner.RunnerResult([1e-3], None)
+
+    @ms.derived_object
+    class ConstantRunner(ms.runner.PyRunner):
+        def run(self, runner_inputs: list[ms.runner.RunnerInput]) -> list[ms.runner.RunnerResult]:
+            return [ConstantRunnerFuture() for _ in runner_inputs]
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        path = os.path.join(work_dir, "metrics.jsonl")
+        ms.tune_tir(
+            mod=Matmul,
+            target={"kind": "llvm", "num-cores": 1},
+            work_dir=work_dir,
+            max_trials_global=10,
+            num_trials_per_iter=5,
+            runner=ConstantRunner(),
+            measure_callbacks=[
+                ms.measure_callback.LogMetrics(path),
+                *ms.measure_callback.MeasureCallback.create("default"),
+            ],
+        )
+        with open(path, encoding="utf-8") as f:
+            rounds = [json.loads(line) for line in f]
+    assert [r["round"] for r in rounds] == list(range(len(rounds)))
+    for r in rounds:
+        assert r["task_id"] == 0
+        assert r["num_build_failed"] + r["num_run_failed"] + r["num_measured"] == r[
+            "num_candidates"
+        ]
+        if r["num_measured"] > 0:
+            assert r["best_ms"] == pytest.approx(1.0)
+        assert r["search"]["num_picked"] >= r["num_candidates"]
+        assert r["search"]["num_sampled"] >= r["search"]["num_postproc_failed"]
+
+
 if __name__ == "__main__":
     test_meta_schedule_measure_callback()
     test_meta_schedule_measure_callback_fail()
     test_meta_schedule_measure_callback_as_string()
     test_meta_schedule_measure_callback_update_cost_model_with_zero()
     test_meta_schedule_measure_callback_update_cost_model_with_runtime_error()
+    test_meta_schedule_measure_callback_log_metrics()
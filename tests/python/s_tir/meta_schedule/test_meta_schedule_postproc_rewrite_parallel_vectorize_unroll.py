@@ -269,5 +269,38 @@ def test_no_unroll_for_spatial_block():
     assert_structural_equal_ignore_global_symbol(mod["main"], expected)
 
 
+
+def test_software_prefetch_innermost_serial_loop():
+    # fmt: off
+    @T.prim_func
+    def before(A: T.Buffer((4096, 64), "float32"), idx: T.Buffer((256,), "int32"), B: T.Buffer((256, 64), "float32")):
+        with T.sblock("root"):
+            T.sblock_attr({"meta_schedule.vectorize": 64, "meta_schedule.software_prefetch": 8})
+            for i, j in T.grid(256, 64):
+                with T.sblock("gather"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    T.reads(A[idx[vi], vj], idx[vi])
+                    T.writes(B[vi, vj])
+                    B[vi, vj] = A[idx[vi], vj]
+
+    @T.prim_func
+    def expected(A: T.Buffer((4096, 64), "float32"), idx: T.Buffer((256,), "int32"), B: T.Buffer((256, 64), "float32")):
+        with T.sblock("root"):
+            for i in T.serial(256, annotations={"software_prefetch_distance": 8}):
+                for j_fused in T.vectorized(64):
+                    with T.sblock("gather"):
+                        vi = T.axis.spatial(256, i)
+                        vj = T.axis.spatial(64, j_fused)
+                        T.reads(A[idx[vi], vj], idx[vi])
+                        T.writes(B[vi, vj])
+                        B[vi, vj] = A[idx[vi], vj]
+    # fmt: on
+
+    sch = Schedule(before)
+    rule = RewriteParallelVectorizeUnroll()
+    assert rule.apply(sch)
+    assert_structural_equal_ignore_global_symbol(sch.mod["main"], expected)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -40,6 +40,7 @@ from tvm.s_tir.meta_schedule.runner import (
     RPCRunner,
     RunnerFuture,
     RunnerInput,
+    RunnerResult,
 )
 from tvm.s_tir.meta_schedule.runner.local_runner import (
     default_alloc_argument as local_default_alloc_argument,
@@ -51,6 +52,11 @@ from tvm.s_tir.meta_schedule.runner.rpc_runner import (
 from tvm.s_tir.meta_schedule.runner.rpc_runner import (
     default_alloc_argument as rpc_default_alloc_argument,
 )
+from tvm.s_tir.meta_schedule.runner.utils import (
+    check_clock_drift,
+    measure_until_stable,
+    median_ci_ratio,
+)
 from tvm.s_tir.meta_schedule.testing.local_rpc import LocalRPC
 from tvm.s_tir.meta_schedule.utils import (
     derived_object,
@@ -303,6 +309,10 @@ def test_meta_schedule_rpc_multiple_runs():
         # Run the module
         runner_futures = runner.run(runner_inputs)
         runner_results = [runner_future.result() for runner_future in runner_futures]
+        # Run the modules again, timed in a single batch
+        runner = RPCRunner(rpc_config, evaluator_config, max_batch_size=len(mods))
+        runner_futures = runner.run(runner_inputs)
+        runner_results += [runner_future.result() for runner_future in runner_futures]
 
     for runner_result in runner_results:
         assert runner_result.error_msg is None
@@ -908,5 +918,76 @@ def test_meta_schedule_local_runner_add_test():
     _clean_build(builder_result.artifact_path)
 
 
+def test_meta_schedule_local_adaptive_run():
+    """Test meta schedule local runner measuring until the median is stable"""
+    mod = MatmulModule
+    builder = LocalBuilder()
+    (builder_result,) = builder.build([BuilderInput(mod, Target("llvm"))])
+    assert builder_result.error_msg is None
+
+    runner_input = RunnerInput(
+        builder_result.artifact_path,
+        "llvm",
+        [
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+            TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        ],
+    )
+    evaluator_config = EvaluatorConfig(
+        number=1,
+        repeat=3,
+        min_repeat_ms=0,
+        max_median_ci=1e-9,
+        max_measure_ms=200,
+    )
+    runner = LocalRunner(timeout_sec=100, evaluator_config=evaluator_config)
+    (runner_future,) = runner.run([runner_input])
+    runner_result = runner_future.result()
+    assert runner_result.error_msg is None
+    # The threshold cannot be met, so the runner keeps measuring until the time is up
+    assert len(runner_result.run_secs) > 3
+    assert runner_result.run_secs_variance is not None
+    _clean_build(builder_result.artifact_path)
+
+
+def test_meta_schedule_measure_until_stable():
+    """Test the stopping rule of the adaptive measurement"""
+    assert median_ci_ratio([1.0]) == float("inf")
+    assert median_ci_ratio([1.0] * 10) == 0.0
+    assert median_ci_ratio([1.0, 2.0, 3.0]) == 0.5
+
+    calls = []
+
+    def f_measure():
+        calls.append(None)
+        return [1.0, 1.0, 1.0 + 0.5**len(calls)]
+
+    config = EvaluatorConfig(max_median_ci=0.01, max_measure_ms=10000)
+    costs = measure_until_stable(f_measure, config)
+    assert len(calls) == 7
+    assert len(costs) == 3 * len(calls)
+    assert median_ci_ratio(costs) <= 0.01
+    # Without a threshold the measurement runs once
+    calls.clear()
+    assert len(measure_until_stable(f_measure, EvaluatorConfig())) == 3
+    assert len(calls) == 1
+    # The clock drift check compares the first and the last third of the costs
+    assert check_clock_drift([1.0, 1.0, 1.5, 1.5, 2.0, 2.0], 0.05)
+    assert not check_clock_drift([1.0, 1.01, 0.99, 1.0, 1.01, 0.99], 0.05)
+    with pytest.raises(ValueError):
+        EvaluatorConfig._normalized(  # pylint: disable=protected-access
+            EvaluatorConfig(enable_cpu_cache_flush=True, enable_gpu_cache_flush=True)
+        )
+
+
+def test_meta_schedule_runner_result_variance():
+    """Test the variance recorded in the runner result"""
+    assert RunnerResult([1.0], None).run_secs_variance is None
+    assert RunnerResult(None, "error").run_secs_variance is None
+    result = RunnerResult([1.0, 2.0, 3.0], None)
+    assert result.run_secs_variance.value == pytest.approx(1.0)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -757,9 +757,42 @@ def test_gpu_argmax_32():
     )
 
 
+def test_gpu_multi_row_small_reduction():
+    @T.prim_func
+    def row_sum(A: T.Buffer((256, 8), "float32"), B: T.Buffer((256,), "float32")) -> None:
+        for i0, i1 in T.grid(256, 8):
+            with T.sblock("row_sum"):
+                i, k = T.axis.remap("SR", [i0, i1])
+                with T.init():
+                    B[i] = T.float32(0)
+                B[i] = B[i] + A[i, k]
+
+    actual = generate_design_space(
+        kind="cuda",
+        mod=row_sum,
+        target=Target("nvidia/geforce-rtx-3090", host="llvm"),
+        types=ms.schedule_rule.CrossThreadReduction,
+    )
+    assert len(actual) == 3
+
+    def _thread_extents(sch):
+        extents = {}
+
+        def _visit(node):
+            if isinstance(node, tvm.tir.For) and node.thread_binding is not None:
+                extents[node.thread_binding.thread_tag] = int(node.extent)
+
+        tvm.tir.stmt_functor.post_order_visit(sch.mod["main"].body, _visit)
+        return extents
+
+    # Each warp of 32 threads reduces 4 rows of 8 elements.
+    assert {"threadIdx.x": 8, "threadIdx.y": 4} in [_thread_extents(sch) for sch in actual]
+
+
 if __name__ == "__main__":
     test_gpu_softmax_mn()
     test_gpu_softmax_mn_after_inline()
     test_gpu_batch_norm_bmn()
     test_gpu_argmax()
     test_gpu_argmax_32()
+    test_gpu_multi_row_small_reduction()
@@ -25,6 +25,7 @@ from tvm.s_tir.meta_schedule.testing.space_generation import (
     print_sketches,
 )
 from tvm.s_tir.tensor_intrin.arm_cpu import DP4A_S8S8S32_INTRIN
+from tvm.s_tir.tensor_intrin.x86 import AMX_DOT_16x16x64_INTRIN as AMX_INTRIN
 from tvm.s_tir.tensor_intrin.x86 import AVX512_DOT_16x4_INTRIN as AVX512_INTRIN
 from tvm.s_tir.tensor_intrin.x86 import VNNI_DOT_16x4_INTRIN as VNNI_INTRIN
 from tvm.script import tir as T
@@ -419,9 +420,46 @@ def test_dp4a_dense_no_tensorize_2():
     )
 
 
+def test_x86_dense_amx():
+    m, n, k = 128, 128, 256
+    X = te.placeholder((m, k), name="X", dtype="uint8")
+    W = te.placeholder((n // 16, k // 4, 16, 4), name="W", dtype="int8")
+    ak = te.reduce_axis((0, k), name="k")
+    matmul = te.compute(
+        (m, n),
+        lambda i, j: te.sum(
+            X[i, ak].astype("int32") * W[j // 16, ak // 4, j % 16, ak % 4].astype("int32"),
+            axis=ak,
+        ),
+        name="compute",
+    )
+    mod = te.create_prim_func([X, W, matmul])
+    actual = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target({"kind": "llvm", "mcpu": "sapphirerapids", "num-cores": 4}),
+        types=None,
+        sch_rules=[
+            ms.schedule_rule.MultiLevelTilingWithIntrin(
+                AMX_INTRIN,
+                structure="SSRSRS",
+                tile_binds=None,
+                max_innermost_factor=64,
+                vector_load_lens=None,
+                reuse_read=None,
+                reuse_write=ms.schedule_rule.ReuseType(req="may", levels=[1, 2], scope="global"),
+            ),
+        ],
+    )
+    assert len(actual) == 3
+    for sch in actual:
+        assert f'"meta_schedule.auto_tensorize": "{AMX_INTRIN}"' in sch.mod.script()
+
+
 if __name__ == "__main__":
     test_x86_conv2d_nchwc()
     test_x86_conv2d_nchwc(AVX512_INTRIN, {"kind": "llvm", "mcpu": "skylake-avx512", "num-cores": 4})
+    test_x86_dense_amx()
     test_dp4a_dense()
     test_dp4a_dense_no_tensorize_1()
     test_dp4a_dense_no_tensorize_2()
@@ -0,0 +1,121 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import tvm
+import tvm.testing
+from tvm.s_tir import meta_schedule as ms
+from tvm.s_tir.meta_schedule.testing import te_workload
+from tvm.s_tir.meta_schedule.testing.space_generation import generate_design_space
+from tvm.target import Target
+from tvm.te import create_prim_func
+
+
+def _block_names(sch):
+    names = []
+
+    def _visit(node):
+        if isinstance(node, tvm.tir.SBlock):
+            names.append(node.name_hint)
+
+    tvm.tir.stmt_functor.post_order_visit(sch.mod["main"].body, _visit)
+    return names
+
+
+def _buffer_shapes(sch):
+    return {
+        buf.name: [int(x) for x in buf.shape]
+        for buf in sch.mod["main"].body.block.alloc_buffers
+    }
+
+
+def test_cpu_matmul_pad_to_tile():
+    mod = create_prim_func(te_workload.matmul(n=127, m=127, k=127))
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.PadToTile(tile_sizes=[16, 32])],
+    )
+    # Both tile sizes pad to 128, the unpadded space is kept.
+    assert len(spaces) == 2
+    padded, unpadded = spaces
+    assert _buffer_shapes(padded) == {
+        "A_pad": [128, 128],
+        "B_pad": [128, 128],
+        "C_pad": [128, 128],
+    }
+    names = _block_names(padded)
+    assert "A_pad_pad_const" in names and "B_pad_pad_const" in names
+    assert _buffer_shapes(unpadded) == {}
+
+
+def test_cpu_matmul_divisible():
+    mod = create_prim_func(te_workload.matmul(n=128, m=128, k=128))
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.PadToTile(tile_sizes=[16, 32])],
+    )
+    assert len(spaces) == 1
+
+
+def test_cpu_matmul_max_overhead():
+    mod = create_prim_func(te_workload.matmul(n=129, m=129, k=129))
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm"),
+        types=None,
+        # Padding to 144 or 160 costs more than 25% of the iteration space.
+        sch_rules=[ms.schedule_rule.PadToTile(tile_sizes=[16, 32], max_overhead=0.25)],
+    )
+    assert len(spaces) == 1
+
+
+def test_cuda_matmul_pad_inlined_into_cache_read():
+    mod = create_prim_func(te_workload.matmul(n=127, m=127, k=127))
+    spaces = generate_design_space(
+        kind="cuda",
+        mod=mod,
+        target=Target("nvidia/geforce-rtx-3080"),
+        types=None,
+        sch_rules=[
+            ms.schedule_rule.PadToTile(tile_sizes=[32]),
+            ms.schedule_rule.MultiLevelTiling(
+                structure="SSSRRSRS",
+                tile_binds=["blockIdx.x", "vthread.x", "threadIdx.x"],
+                max_innermost_factor=64,
+                vector_load_lens=[1, 2, 3, 4],
+                reuse_read=ms.schedule_rule.ReuseType(req="must", levels=[4], scope="shared"),
+                reuse_write=ms.schedule_rule.ReuseType(req="must", levels=[3], scope="local"),
+            ),
+        ],
+    )
+    assert len(spaces) == 2
+    padded = spaces[0]
+    names = _block_names(padded)
+    # The padded copies are fused into the shared memory caches of the tiling.
+    assert "A_pad" not in names and "B_pad" not in names
+    assert "A_pad_shared" in names and "B_pad_shared" in names
+    assert _buffer_shapes(padded)["C_pad"] == [128, 128]
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,159 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import tvm
+import tvm.testing
+from tvm.relax.backend import cpu_generic
+from tvm.s_tir import meta_schedule as ms
+from tvm.s_tir.meta_schedule.testing import te_workload
+from tvm.s_tir.meta_schedule.testing.space_generation import generate_design_space
+from tvm.script import ir as I
+from tvm.script import relax as R
+from tvm.script import tir as T
+from tvm.target import Target
+from tvm.te import create_prim_func
+
+
+# fmt: off
+@T.prim_func
+def pointwise_depthwise(
+    A: T.Buffer((1, 16, 16, 4), "float32"),
+    W0: T.Buffer((8, 4), "float32"),
+    W1: T.Buffer((3, 3, 8), "float32"),
+    C: T.Buffer((1, 14, 14, 8), "float32"),
+):
+    T.func_attr({"global_symbol": "main", "tir.noalias": True})
+    B = T.alloc_buffer((1, 16, 16, 8))
+    for n, h, w, co, ci in T.grid(1, 16, 16, 8, 4):
+        with T.sblock("pointwise"):
+            v_n, v_h, v_w, v_co, v_ci = T.axis.remap("SSSSR", [n, h, w, co, ci])
+            with T.init():
+                B[v_n, v_h, v_w, v_co] = T.float32(0)
+            B[v_n, v_h, v_w, v_co] = (
+                B[v_n, v_h, v_w, v_co] + A[v_n, v_h, v_w, v_ci] * W0[v_co, v_ci]
+            )
+    for n, h, w, c, rh, rw in T.grid(1, 14, 14, 8, 3, 3):
+        with T.sblock("depthwise"):
+            v_n, v_h, v_w, v_c, v_rh, v_rw = T.axis.remap("SSSSRR", [n, h, w, c, rh, rw])
+            with T.init():
+                C[v_n, v_h, v_w, v_c] = T.float32(0)
+            C[v_n, v_h, v_w, v_c] = (
+                C[v_n, v_h, v_w, v_c] + B[v_n, v_h + v_rh, v_w + v_rw, v_c] * W1[v_rh, v_rw, v_c]
+            )
+# fmt: on
+
+
+def _alloc_shapes(sch):
+    return {
+        buf.name: [int(x) for x in buf.shape]
+        for buf in sch.mod["main"].body.block.alloc_buffers
+    }
+
+
+def _loop_annotations(sch):
+    annotations = []
+
+    def _visit(node):
+        if isinstance(node, tvm.tir.For):
+            annotations.extend(node.annotations.keys())
+
+    tvm.tir.stmt_functor.post_order_visit(sch.mod["main"].body, _visit)
+    return annotations
+
+
+def test_rolling_buffer_fusion():
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=pointwise_depthwise,
+        target=Target("llvm --num-cores=4"),
+        types=None,
+        sch_rules=[ms.schedule_rule.RollingBufferFusion(max_rows_per_tile=2)],
+    )
+    assert len(spaces) == 2
+    fused, unfused = spaces
+    (decision,) = fused.trace.decisions.values()
+    rows = int(decision[1])
+    # The line buffer holds the 3 rows of the window of a row of the consumer, plus one row per
+    # additional row of the tile.
+    assert _alloc_shapes(fused)["B"] == [1, rows + 2, 16, 8]
+    assert "meta_schedule.rolling_buffer" in _loop_annotations(fused)
+    assert _alloc_shapes(unfused)["B"] == [1, 16, 16, 8]
+    assert "meta_schedule.rolling_buffer" not in _loop_annotations(unfused)
+
+
+def test_rolling_buffer_fusion_no_chain():
+    mod = create_prim_func(te_workload.conv2d_nhwc(1, 16, 16, 8, 8, 3, 1, 1))
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm --num-cores=4"),
+        types=None,
+        sch_rules=[ms.schedule_rule.RollingBufferFusion()],
+    )
+    # The convolution reads the padding, which is not a reduction.
+    assert len(spaces) == 1
+
+
+def test_conv_chain_fusion_passes():
+    # fmt: off
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            x: R.Tensor((1, 4, 16, 16), "float32"),
+            w0: R.Tensor((8, 4, 1, 1), "float32"),
+            w1: R.Tensor((8, 1, 3, 3), "float32"),
+        ) -> R.Tensor((1, 8, 14, 14), "float32"):
+            with R.dataflow():
+                lv0 = R.nn.conv2d(x, w0)
+                lv1 = R.nn.relu(lv0)
+                gv = R.nn.conv2d(lv1, w1, groups=8)
+                R.output(gv)
+            return gv
+    # fmt: on
+
+    target = Target("llvm --num-cores=4")
+    mod = tvm.transform.Sequential(
+        cpu_generic.conv_chain_fusion_passes(target) + cpu_generic.legalize_passes(target)
+    )(Module)
+    funcs = [func for func in mod.functions.values() if isinstance(func, tvm.tir.PrimFunc)]
+    # Both convolutions and the activation are fused into one PrimFunc.
+    assert len(funcs) == 1
+    spaces = generate_design_space(
+        kind="llvm",
+        mod=tvm.IRModule({"main": funcs[0].with_attr("global_symbol", "main")}),
+        target=target,
+        types=None,
+        sch_rules=[
+            ms.schedule_rule.AutoInline(
+                into_producer=False,
+                into_consumer=True,
+                inline_const_tensor=True,
+                disallow_if_then_else=False,
+                require_injective=True,
+                require_ordered=True,
+                disallow_op=None,
+            ),
+            ms.schedule_rule.RollingBufferFusion(),
+        ],
+    )
+    assert len(spaces) == 2
+    assert "meta_schedule.rolling_buffer" in _loop_annotations(spaces[0])
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
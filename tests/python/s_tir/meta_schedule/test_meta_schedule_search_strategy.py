@@ -123,7 +123,8 @@ def test_meta_schedule_replay_func(
     assert num_trials_each_iter == [7, 7, 6]
 
 
-def test_meta_schedule_evolutionary_search():  # pylint: disable = invalid-name
+@pytest.mark.parametrize("pipelined", [False, True])
+def test_meta_schedule_evolutionary_search(pipelined: bool):  # pylint: disable = invalid-name
     def _schedule_matmul_small(sch: Schedule):
         block = sch.get_sblock("matmul")
         _, j, k = sch.get_loops(block=block)
@@ -154,6 +155,7 @@ def test_meta_schedule_evolutionary_search():  # pylint: disable = invalid-name
             genetic_mutate_prob=0.5,
             genetic_max_fail_count=10,
             eps_greedy=0.9,
+            pipelined=pipelined,
         ),
         target=tvm.target.Target("llvm"),
         num_threads=1,  # because we are using a mutator from the python side
@@ -337,10 +339,44 @@ def test_search_strategy_abstract_class_instantiation():
     assert type(strategy) is not SearchStrategy
 
 
+def test_meta_schedule_replay_trace_deduplicate():  # pylint: disable = invalid-name
+    def _schedule_matmul_tiny(sch: Schedule):
+        block = sch.get_sblock("matmul")
+        _, _, k = sch.get_loops(block=block)
+        _, _ = sch.split(k, sch.sample_perfect_tile(k, n=2))
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(sch_fn=_schedule_matmul_tiny, postprocs=[]),
+        search_strategy=ms.search_strategy.ReplayTrace(),
+    )
+    strategy = context.search_strategy
+    strategy.pre_tuning(
+        max_trials=20,
+        num_trials_per_iter=7,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+    )
+    mods = []
+    candidates = strategy.generate_measure_candidates()
+    while candidates is not None:
+        mods.extend(candidate.sch.mod for candidate in candidates)
+        runner_results = [ms.runner.RunnerResult([0.1], None) for _ in candidates]
+        strategy.notify_runner_results(candidates, runner_results)
+        candidates = strategy.generate_measure_candidates()
+    strategy.post_tuning()
+    # There are only 6 ways to split 32 into 2 factors
+    assert 0 < len(mods) <= 6
+    for i, mod in enumerate(mods):
+        for other in mods[:i]:
+            assert not tvm.ir.structural_equal(mod, other)
+
+
 if __name__ == "__main__":
     test_meta_schedule_replay_func(ms.search_strategy.ReplayFunc)
     test_meta_schedule_replay_func(ms.search_strategy.ReplayTrace)
-    test_meta_schedule_evolutionary_search()
+    test_meta_schedule_replay_trace_deduplicate()
+    test_meta_schedule_evolutionary_search(pipelined=False)
+    test_meta_schedule_evolutionary_search(pipelined=True)
     test_meta_schedule_evolutionary_search_early_stop()
     test_meta_schedule_evolutionary_search_fail_init_population()
     test_search_strategy_abstract_class_instantiation()
@@ -0,0 +1,83 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+
+import tvm
+import tvm.testing
+from tvm.s_tir.schedule.testing import verify_trace_roundtrip
+from tvm.script import tir as T
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+@T.prim_func
+def matmul(
+    A: T.Buffer((128, 128), "float32"),
+    B: T.Buffer((128, 128), "float32"),
+    C: T.Buffer((128, 128), "float32"),
+) -> None:
+    for i, j, k in T.grid(128, 128, 128):
+        with T.sblock("C"):
+            vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+            with T.init():
+                C[vi, vj] = T.float32(0)
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+def _schedule_fragments():
+    """Stage A and B in shared memory per k_outer, and in registers per k_inner."""
+    sch = tvm.s_tir.Schedule(matmul, debug_mask="all")
+    block = sch.get_sblock("C")
+    _, _, k = sch.get_loops(block)
+    k_outer, k_inner = sch.split(k, [None, 8])
+    for i in range(2):
+        shared = sch.cache_read(block, i, "shared")
+        local = sch.cache_read(block, i, "local")
+        sch.compute_at(local, k_inner)
+        sch.compute_at(shared, k_outer)
+    return sch, k_outer, k_inner
+
+
+def test_double_buffer_fragments():
+    sch, _, k_inner = _schedule_fragments()
+    sch.double_buffer_fragments(k_inner)
+    annotations = sch.get(k_inner).annotations
+    assert list(annotations["software_pipeline_stage"]) == [0, 0, 1]
+    assert list(annotations["software_pipeline_order"]) == [0, 1, 2]
+    verify_trace_roundtrip(sch, mod=matmul)
+
+
+def test_double_buffer_fragments_requires_fragment_loads():
+    sch, k_outer, _ = _schedule_fragments()
+    # The body of k_outer starts with the loads from global memory to shared memory.
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.double_buffer_fragments(k_outer)
+
+
+def test_double_buffer_fragments_requires_computation():
+    sch = tvm.s_tir.Schedule(matmul, debug_mask="all")
+    _, _, k = sch.get_loops(sch.get_sblock("C"))
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.double_buffer_fragments(k)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
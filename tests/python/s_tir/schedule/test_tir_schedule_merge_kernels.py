@@ -0,0 +1,119 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+
+import tvm
+import tvm.testing
+from tvm.s_tir.schedule.testing import verify_trace_roundtrip
+from tvm.script import tir as T
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+@T.prim_func
+def two_kernels(A: T.Buffer((1024,), "float32"), C: T.Buffer((1024,), "float32")) -> None:
+    B = T.alloc_buffer((1024,), "float32")
+    for i in range(1024):
+        with T.sblock("B"):
+            vi = T.axis.spatial(1024, i)
+            B[vi] = A[vi] * T.float32(2)
+    for i in range(1024):
+        with T.sblock("C"):
+            vi = T.axis.spatial(1024, i)
+            C[vi] = B[1023 - vi] + T.float32(1)
+
+
+@T.prim_func
+def matvec(
+    A: T.Buffer((64, 4096), "float32"),
+    x: T.Buffer((4096,), "float32"),
+    y: T.Buffer((64,), "float32"),
+) -> None:
+    for i, k in T.grid(64, 4096):
+        with T.sblock("y"):
+            vi, vk = T.axis.remap("SR", [i, k])
+            with T.init():
+                y[vi] = T.float32(0)
+            y[vi] = y[vi] + A[vi, vk] * x[vk]
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+def _bind(sch, block, num_blocks, num_threads):
+    (loop,) = sch.get_loops(block)
+    bx, tx = sch.split(loop, [num_blocks, num_threads])
+    sch.bind(bx, "blockIdx.x")
+    sch.bind(tx, "threadIdx.x")
+    return bx
+
+
+def test_merge_kernels():
+    sch = tvm.s_tir.Schedule(two_kernels, debug_mask="all")
+    bx_b = _bind(sch, sch.get_sblock("B"), 8, 128)
+    bx_c = _bind(sch, sch.get_sblock("C"), 8, 128)
+    merged = sch.merge_kernels(bx_b, bx_c)
+    assert sch.get(merged).annotations["pragma_global_barrier"] == 1
+    root = sch.get(sch.get_sblock("root"))
+    assert isinstance(root.body, tvm.tir.For)
+    # Both blocks are nested in the merged thread bindings.
+    for name in ["B", "C"]:
+        bx, tx = sch.get_loops(sch.get_sblock(name))
+        assert bx.same_as(merged)
+        assert sch.get(tx).thread_binding.thread_tag == "threadIdx.x"
+    verify_trace_roundtrip(sch, mod=two_kernels)
+
+
+def test_merge_kernels_stream_k():
+    sch = tvm.s_tir.Schedule(matvec, debug_mask="all")
+    block = sch.get_sblock("y")
+    _, k = sch.get_loops(block)
+    ko, _ = sch.split(k, [4, None])
+    block_rf = sch.rfactor(ko, factor_axis=0)
+    i, ko, ki = sch.get_loops(block_rf)
+    sch.reorder(ko, i, ki)
+    bx_rf, tx_rf = sch.split(sch.fuse(ko, i), [None, 128])
+    sch.bind(bx_rf, "blockIdx.x")
+    sch.bind(tx_rf, "threadIdx.x")
+    i, _ = sch.get_loops(block)
+    bx, tx, _ = sch.split(i, [2, 128, None])
+    sch.bind(bx, "blockIdx.x")
+    sch.bind(tx, "threadIdx.x")
+    merged = sch.merge_kernels(bx_rf, bx)
+    assert sch.get(merged).annotations["pragma_global_barrier"] == 1
+    verify_trace_roundtrip(sch, mod=matvec)
+
+
+def test_merge_kernels_mismatched_grid():
+    sch = tvm.s_tir.Schedule(two_kernels, debug_mask="all")
+    bx_b = _bind(sch, sch.get_sblock("B"), 8, 128)
+    bx_c = _bind(sch, sch.get_sblock("C"), 4, 256)
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.merge_kernels(bx_b, bx_c)
+
+
+def test_merge_kernels_not_adjacent():
+    sch = tvm.s_tir.Schedule(two_kernels, debug_mask="all")
+    bx_b = _bind(sch, sch.get_sblock("B"), 8, 128)
+    bx_c = _bind(sch, sch.get_sblock("C"), 8, 128)
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.merge_kernels(bx_c, bx_b)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
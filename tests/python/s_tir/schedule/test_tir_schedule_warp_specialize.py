@@ -0,0 +1,76 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+
+import tvm
+import tvm.testing
+from tvm.s_tir.schedule.testing import verify_trace_roundtrip
+from tvm.script import tir as T
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+@T.prim_func
+def matmul(
+    A: T.Buffer((128, 128), "float32"),
+    B: T.Buffer((128, 128), "float32"),
+    C: T.Buffer((128, 128), "float32"),
+) -> None:
+    for i, j, k in T.grid(128, 128, 128):
+        with T.sblock("C"):
+            vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+            with T.init():
+                C[vi, vj] = T.float32(0)
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
+# pylint: enable=no-member,invalid-name,unused-variable
+
+
+def test_warp_specialize():
+    sch = tvm.s_tir.Schedule(matmul, debug_mask="all")
+    i, j, k = sch.get_loops(sch.get_sblock("C"))
+    sch.bind(i, "blockIdx.x")
+    sch.bind(j, "threadIdx.x")
+    sch.warp_specialize(k, num_producer_threads=32, num_stages=3)
+    annotations = sch.get(k).annotations
+    assert annotations["warp_specialize_producer_threads"] == 32
+    assert annotations["warp_specialize_num_stages"] == 3
+    verify_trace_roundtrip(sch, mod=matmul)
+
+
+def test_warp_specialize_requires_thread_binding():
+    sch = tvm.s_tir.Schedule(matmul, debug_mask="all")
+    i, _, k = sch.get_loops(sch.get_sblock("C"))
+    sch.bind(i, "blockIdx.x")
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.warp_specialize(k)
+
+
+def test_warp_specialize_invalid_producer_threads():
+    sch = tvm.s_tir.Schedule(matmul, debug_mask="all")
+    _, j, k = sch.get_loops(sch.get_sblock("C"))
+    sch.bind(j, "threadIdx.x")
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.warp_specialize(k, num_producer_threads=48)
+    with pytest.raises(tvm.s_tir.ScheduleError):
+        sch.warp_specialize(j)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,72 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm import s_tir
+from tvm.script import tir as T
+
+
+def test_offset_per_loop_level():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((4096,), "float32"), B: T.Buffer((4096,), "float32")):
+        for i, j, k in T.grid(16, 16, 16):
+            B[i * 256 + j * 16 + k] = A[i * 256 + j * 16 + k] + T.float32(1)
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((4096,), "float32"), B: T.Buffer((4096,), "float32")):
+        for i in range(16):
+            offset: T.int32 = i * 256
+            for j in range(16):
+                offset_1: T.int32 = offset + j * 16
+                for k in range(16):
+                    B[offset_1 + k] = A[offset_1 + k] + T.float32(1)
+
+    mod = s_tir.transform.HoistIndexOffset()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_keep_shared_index():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((256,), "float32")):
+        A_shared = T.decl_buffer((256,), "float32", scope="shared")
+        for j, k in T.grid(16, 16):
+            A_shared[j * 16 + k] = A[j * 16 + k]
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((256,), "float32")):
+        A_shared = T.decl_buffer((256,), "float32", scope="shared")
+        for j in range(16):
+            offset: T.int32 = j * 16
+            for k in range(16):
+                A_shared[j * 16 + k] = A[offset + k]
+
+    mod = s_tir.transform.HoistIndexOffset()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_non_affine_index():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((256,), "float32")):
+        for i, j in T.grid(16, 16):
+            A[i * 16 + j * j % 16] = T.float32(0)
+
+    mod = s_tir.transform.HoistIndexOffset()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,107 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm import s_tir
+from tvm.script import tir as T
+
+
+def test_prefetch_gather():
+    @T.prim_func(private=True)
+    def before(
+        A: T.Buffer((65536,), "float32"),
+        idx: T.Buffer((1024,), "int32"),
+        B: T.Buffer((1024,), "float32"),
+    ):
+        for i in T.serial(1024, annotations={"software_prefetch_distance": 8}):
+            B[i] = A[idx[i]]
+
+    @T.prim_func(private=True)
+    def expected(
+        A: T.Buffer((65536,), "float32"),
+        idx: T.Buffer((1024,), "int32"),
+        B: T.Buffer((1024,), "float32"),
+    ):
+        for i in range(1024):
+            T.call_intrin("int32", "tir.prefetch", T.address_of(idx[T.min(i + 8, 1023)]), 0, 3, 1)
+            T.call_intrin(
+                "int32", "tir.prefetch", T.address_of(A[idx[T.min(i + 8, 1023)]]), 0, 3, 1
+            )
+            B[i] = A[idx[i]]
+
+    mod = s_tir.transform.InjectSoftwarePrefetch()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_prefetch_vectorized_row():
+    @T.prim_func(private=True)
+    def before(
+        A: T.Buffer((65536,), "float32"),
+        idx: T.Buffer((64,), "int32"),
+        B: T.Buffer((16,), "float32"),
+    ):
+        for j in T.serial(64, annotations={"software_prefetch_distance": 4}):
+            for d in T.vectorized(16):
+                B[d] = B[d] + A[idx[j] * 16 + d]
+
+    @T.prim_func(private=True)
+    def expected(
+        A: T.Buffer((65536,), "float32"),
+        idx: T.Buffer((64,), "int32"),
+        B: T.Buffer((16,), "float32"),
+    ):
+        for j in range(64):
+            T.call_intrin("int32", "tir.prefetch", T.address_of(idx[T.min(j + 4, 63)]), 0, 3, 1)
+            T.call_intrin(
+                "int32", "tir.prefetch", T.address_of(A[idx[T.min(j + 4, 63)] * 16]), 0, 3, 1
+            )
+            for d in T.vectorized(16):
+                B[d] = B[d] + A[idx[j] * 16 + d]
+
+    mod = s_tir.transform.InjectSoftwarePrefetch()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_skip_inner_loop_index():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((4096,), "float32"), B: T.Buffer((4096,), "float32")):
+        for i in T.serial(64, annotations={"software_prefetch_distance": 4}):
+            for j in range(64):
+                B[i * 64 + j] = A[i * 64 + j]
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((4096,), "float32"), B: T.Buffer((4096,), "float32")):
+        for i, j in T.grid(64, 64):
+            B[i * 64 + j] = A[i * 64 + j]
+
+    mod = s_tir.transform.InjectSoftwarePrefetch()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_skip_gpu_target():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((1024,), "float32"), B: T.Buffer((1024,), "float32")):
+        T.func_attr({"target": T.target("cuda")})
+        for i in T.serial(1024, annotations={"software_prefetch_distance": 8}):
+            B[i] = A[i]
+
+    mod = s_tir.transform.InjectSoftwarePrefetch()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
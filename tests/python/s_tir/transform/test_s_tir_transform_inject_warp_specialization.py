@@ -0,0 +1,139 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import tir
+from tvm.script import tir as T
+
+
+def _inject(func):
+    mod = tvm.IRModule.from_expr(func)
+    return tvm.s_tir.transform.InjectWarpSpecialization()(mod)["main"]
+
+
+def _collect(func):
+    calls = {}
+    thread_extents = []
+    allocs = {}
+
+    def fvisit(node):
+        if isinstance(node, tir.Call) and isinstance(node.op, tvm.ir.Op):
+            calls.setdefault(node.op.name, []).append(node)
+        elif isinstance(node, tir.AttrStmt) and node.attr_key == "thread_extent":
+            thread_extents.append(int(node.value))
+        elif isinstance(node, tir.Allocate):
+            allocs[node.buffer_var.name] = [int(e) for e in node.extents]
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, fvisit)
+    return calls, thread_extents, allocs
+
+
+def test_warp_specialize_copy():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((1024,), "float32"), B: T.Buffer((64,), "float32")):
+        tx = T.launch_thread("threadIdx.x", 64)
+        A_shared = T.decl_buffer((64,), "float32", scope="shared")
+        acc = T.decl_buffer((1,), "float32", scope="local")
+        acc[0] = T.float32(0)
+        for k in T.serial(
+            16,
+            annotations={
+                "warp_specialize_producer_threads": 32,
+                "warp_specialize_num_stages": 2,
+            },
+        ):
+            A_shared[tx] = A[k * 64 + tx]
+            T.tvm_storage_sync("shared")
+            acc[0] = acc[0] + A_shared[63 - tx]
+            T.tvm_storage_sync("shared")
+        B[tx] = acc[0]
+
+    after = _inject(before)
+    calls, thread_extents, allocs = _collect(after)
+    # 64 consumers and 32 producers, which copy for two consumer threads each.
+    assert thread_extents == [96]
+    assert allocs["A_shared"] == [128]
+    assert len(calls["tir.create_barriers"]) == 1
+    assert len(calls["tir.ptx_init_barrier_thread_count"]) == 4
+    assert len(calls["tir.ptx_wait_barrier"]) == 2
+    assert len(calls["tir.ptx_arrive_barrier"]) == 2
+    # The barriers of the loop body become named barriers of the consumers.
+    assert len(calls["tir.tvm_storage_sync"]) == 2
+    bar_syncs = calls["tir.ptx_bar_sync"]
+    assert len(bar_syncs) == 2
+    assert all(int(call.args[0]) == 1 and int(call.args[1]) == 64 for call in bar_syncs)
+
+
+def test_warp_specialize_tma():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((64, 256), "float16"), B: T.Buffer((128,), "float32")):
+        tx = T.launch_thread("threadIdx.x", 128)
+        A_shared = T.decl_buffer((1024,), "float16", scope="shared.dyn")
+        acc = T.decl_buffer((1,), "float32", scope="local")
+        acc[0] = T.float32(0)
+        for k in T.serial(
+            16,
+            annotations={
+                "warp_specialize_producer_threads": 32,
+                "warp_specialize_num_stages": 3,
+            },
+        ):
+            if tx == 0:
+                T.evaluate(
+                    T.ptx_tma_load(
+                        "float16", A_shared.data, 0, A.data, 0, 0, 2, 64, 256, 64, 16, 0, k * 16
+                    )
+                )
+            T.tvm_storage_sync("shared.dyn")
+            acc[0] = acc[0] + T.Cast("float32", A_shared[tx * 8])
+            T.tvm_storage_sync("shared.dyn")
+        B[tx] = acc[0]
+
+    after = _inject(before)
+    calls, thread_extents, allocs = _collect(after)
+    assert thread_extents == [160]
+    assert allocs["A_shared"] == [3072]
+    # The TMA copy completes on the barrier of its stage, which expects its bytes.
+    (expect_tx,) = calls["tir.ptx_barrier_expect_tx"]
+    assert int(expect_tx.args[1]) == 64 * 16 * 2
+    (tma_load,) = calls["tir.ptx_tma_load"]
+    assert not isinstance(tma_load.args[3], tir.IntImm)
+    assert not isinstance(tma_load.args[1], tir.IntImm)
+    assert len(calls["tir.ptx_bar_sync"]) == 2
+
+
+def test_warp_specialize_requires_read_only_copies():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((1024,), "float32"), B: T.Buffer((64,), "float32")):
+        tx = T.launch_thread("threadIdx.x", 64)
+        A_shared = T.decl_buffer((64,), "float32", scope="shared")
+        for k in T.serial(16, annotations={"warp_specialize_producer_threads": 32}):
+            A_shared[tx] = A[k * 64 + tx]
+            T.tvm_storage_sync("shared")
+            A_shared[tx] = A_shared[tx] * T.float32(2)
+            T.tvm_storage_sync("shared")
+            B[tx] = B[tx] + A_shared[tx]
+
+    with pytest.raises(tvm.error.InternalError):
+        _inject(before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,100 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import s_tir
+from tvm.script import tir as T
+
+
+def test_lower_tma_descriptor():
+    """The descriptor is encoded on the host once for the tiles of the same tensor and box."""
+
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((64, 256), "float16")):
+        bx = T.launch_thread("blockIdx.x", 4)
+        tx = T.launch_thread("threadIdx.x", 128)
+        A_shared = T.decl_buffer((32, 64), "float16", scope="shared.dyn")
+        if tx == 0:
+            T.evaluate(
+                T.ptx_tma_load(
+                    "float16", A_shared.data, 0, A.data, 0, 0, 2, 64, 256, 16, 64, 0, bx * 64
+                )
+            )
+            T.evaluate(
+                T.ptx_tma_load(
+                    "float16", A_shared.data, 1024, A.data, 0, 0, 2, 64, 256, 16, 64, 16, bx * 64
+                )
+            )
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((64, 256), "float16")):
+        A_tensor_map: T.handle("tensormap") = T.tvm_stack_alloca("tensormap", 1)
+        T.call_packed(
+            "runtime.cuTensorMapEncodeTiled",
+            A_tensor_map,
+            "float16",
+            2,
+            A.data,
+            T.int64(256),
+            T.int64(64),
+            T.int64(512),
+            64,
+            16,
+            1,
+            1,
+            0,
+            0,
+            2,
+            0,
+        )
+        bx = T.launch_thread("blockIdx.x", 4)
+        tx = T.launch_thread("threadIdx.x", 128)
+        A_shared = T.decl_buffer((32, 64), "float16", scope="shared.dyn")
+        if tx == 0:
+            T.evaluate(
+                T.ptx_cp_async_bulk_tensor("float16", A_shared.data, 0, A_tensor_map, 0, 0, bx * 64)
+            )
+            T.evaluate(
+                T.ptx_cp_async_bulk_tensor(
+                    "float16", A_shared.data, 1024, A_tensor_map, 0, 16, bx * 64
+                )
+            )
+
+    after = s_tir.transform.LowerTMADescriptors()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(after["main"], expected)
+
+
+def test_lower_tma_descriptor_requires_host_tensor():
+    @T.prim_func
+    def func(A: T.Buffer((64, 256), "float16")):
+        tx = T.launch_thread("threadIdx.x", 128)
+        A_shared = T.decl_buffer((16, 64), "float16", scope="shared.dyn")
+        B_global = T.decl_buffer((64, 256), "float16")
+        T.evaluate(
+            T.ptx_tma_load(
+                "float16", A_shared.data, 0, B_global.data, 0, 0, 2, 64, 256, 16, 64, 0, 0
+            )
+        )
+
+    with pytest.raises(tvm.error.InternalError):
+        s_tir.transform.LowerTMADescriptors()(tvm.IRModule.from_expr(func))
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -346,5 +346,73 @@ def test_async_copy():
     tvm.ir.assert_structural_equal(After, Expected)
 
 
+
+def test_interval_packing_across_barriers():
+    """Buffers share memory once a barrier follows the last access of the previous one."""
+
+    @I.ir_module
+    class Before:
+        @T.prim_func
+        def main(X: T.Buffer((128,), "float32"), Y: T.Buffer((128,), "float32")):
+            threadIdx_x = T.launch_thread("threadIdx.x", 128)
+            A_sh_data = T.allocate([128], "float32", "shared.dyn")
+            B_sh_data = T.allocate([128], "float32", "shared.dyn")
+            C_sh_data = T.allocate([128], "float32", "shared.dyn")
+            D_sh_data = T.allocate([128], "float32", "shared.dyn")
+            A_sh = T.decl_buffer([128], data=A_sh_data, scope="shared.dyn")
+            B_sh = T.decl_buffer([128], data=B_sh_data, scope="shared.dyn")
+            C_sh = T.decl_buffer([128], data=C_sh_data, scope="shared.dyn")
+            D_sh = T.decl_buffer([128], data=D_sh_data, scope="shared.dyn")
+            A_sh[threadIdx_x] = X[threadIdx_x]
+            B_sh[threadIdx_x] = A_sh[127 - threadIdx_x]
+            T.tvm_storage_sync("shared.dyn")
+            C_sh[threadIdx_x] = B_sh[127 - threadIdx_x]
+            T.tvm_storage_sync("shared.dyn")
+            D_sh[threadIdx_x] = C_sh[127 - threadIdx_x]
+            Y[threadIdx_x] = D_sh[threadIdx_x]
+
+    @I.ir_module
+    class Expected:
+        @T.prim_func
+        def main(X: T.Buffer((128,), "float32"), Y: T.Buffer((128,), "float32")):
+            threadIdx_x = T.launch_thread("threadIdx.x", 128)
+            buf_dyn_shmem = T.allocate([1024], "uint8", "shared.dyn")
+            A_sh = T.decl_buffer((128,), data=buf_dyn_shmem, scope="shared.dyn")
+            B_sh = T.decl_buffer((128,), data=buf_dyn_shmem, scope="shared.dyn")
+            C_sh = T.decl_buffer((128,), data=buf_dyn_shmem, scope="shared.dyn")
+            D_sh = T.decl_buffer((128,), data=buf_dyn_shmem, scope="shared.dyn")
+            A_sh[threadIdx_x] = X[threadIdx_x]
+            B_sh[threadIdx_x + 128] = A_sh[127 - threadIdx_x]
+            T.tvm_storage_sync("shared.dyn")
+            C_sh[threadIdx_x] = B_sh[127 - threadIdx_x + 128]
+            T.tvm_storage_sync("shared.dyn")
+            D_sh[threadIdx_x + 128] = C_sh[127 - threadIdx_x]
+            Y[threadIdx_x] = D_sh[threadIdx_x + 128]
+
+    with tvm.transform.PassContext(config={"s_tir.merge_shared_memory_interval_packing": True}):
+        After = tvm.s_tir.transform.MergeSharedMemoryAllocations()(Before)
+    tvm.ir.assert_structural_equal(After, Expected)
+
+
+def test_interval_packing_without_barrier():
+    """Without a barrier, other threads may still access a dead buffer, so nothing is reused."""
+
+    @I.ir_module
+    class Before:
+        @T.prim_func
+        def main():
+            threadIdx_x = T.launch_thread("threadIdx.x", 128)
+            A_sh_data = T.allocate([128], "float32", "shared.dyn")
+            B_sh_data = T.allocate([128], "float32", "shared.dyn")
+            A_sh = T.decl_buffer([128], data=A_sh_data, scope="shared.dyn")
+            B_sh = T.decl_buffer([128], data=B_sh_data, scope="shared.dyn")
+            A_sh[threadIdx_x] = 0
+            B_sh[threadIdx_x] = 0
+
+    with tvm.transform.PassContext(config={"s_tir.merge_shared_memory_interval_packing": True}):
+        After = tvm.s_tir.transform.MergeSharedMemoryAllocations()(Before)
+    alloc = After["main"].body.body
+    assert isinstance(alloc, tvm.tir.Allocate) and int(alloc.extents[0]) == 1024
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,110 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import s_tir
+from tvm.script import tir as T
+
+
+def _apply(func, config):
+    with tvm.transform.PassContext(config=config):
+        return s_tir.transform.MergeParallelLaunch()(tvm.IRModule.from_expr(func))["main"]
+
+
+def test_merge_consecutive_parallel_loops():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((1024,), "float32"), B: T.Buffer((1024,), "float32")):
+        for i in T.parallel(1024):
+            B[i] = A[i] + T.float32(1)
+        for i in T.parallel(1024):
+            A[i] = B[i] * T.float32(2)
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((1024,), "float32"), B: T.Buffer((1024,), "float32")):
+        with T.attr(0, "pragma_parallel_launch_point", 1):
+            with T.attr(0, "pragma_parallel_barrier_when_finish", 1):
+                for i in T.parallel(1024):
+                    B[i] = A[i] + T.float32(1)
+            for i in T.parallel(1024):
+                A[i] = B[i] * T.float32(2)
+
+    after = _apply(before, {"s_tir.merge_parallel_launch": True})
+    tvm.ir.assert_structural_equal(after, expected)
+
+
+def test_serialize_small_launch():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        for i in T.parallel(16):
+            B[i] = A[i] + T.float32(1)
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        for i in range(16):
+            B[i] = A[i] + T.float32(1)
+
+    after = _apply(before, {"s_tir.parallel_launch_min_work": 1024})
+    tvm.ir.assert_structural_equal(after, expected)
+
+
+def test_guard_dynamic_launch():
+    @T.prim_func(private=True)
+    def before(a: T.handle, b: T.handle):
+        n = T.int64()
+        A = T.match_buffer(a, (n,), "float32")
+        B = T.match_buffer(b, (n,), "float32")
+        for i in T.parallel(n):
+            B[i] = A[i] + T.float32(1)
+
+    after = _apply(before, {"s_tir.parallel_launch_min_work": 1024})
+    assert isinstance(after.body, tvm.tir.IfThenElse)
+    assert after.body.then_case.kind == tvm.tir.ForKind.SERIAL
+    assert after.body.else_case.kind == tvm.tir.ForKind.PARALLEL
+
+
+@tvm.testing.requires_llvm
+def test_merged_launch_correctness():
+    @T.prim_func
+    def func(a: T.handle, c: T.handle):
+        n = T.int32()
+        A = T.match_buffer(a, (n,), "float32")
+        C = T.match_buffer(c, (n,), "float32")
+        B = T.alloc_buffer((n,), "float32")
+        for i in T.parallel(n):
+            with T.sblock("B"):
+                vi = T.axis.spatial(n, i)
+                B[vi] = A[vi] + T.float32(1)
+        for i in T.parallel(n):
+            with T.sblock("C"):
+                vi = T.axis.spatial(n, i)
+                C[vi] = B[n - 1 - vi] * T.float32(2)
+
+    config = {"s_tir.merge_parallel_launch": True, "s_tir.parallel_launch_min_work": 256}
+    with tvm.transform.PassContext(config=config):
+        f = tvm.compile(func, target="llvm")
+    for n in [16, 4096]:
+        a_np = np.random.uniform(size=n).astype("float32")
+        a = tvm.runtime.tensor(a_np)
+        c = tvm.runtime.tensor(np.zeros(n, dtype="float32"))
+        f(a, c)
+        tvm.testing.assert_allclose(c.numpy(), (a_np[::-1] + 1) * 2)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
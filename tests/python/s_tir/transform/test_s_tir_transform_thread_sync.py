@@ -175,9 +175,28 @@ def test_sync_let_stmt():
     tvm.ir.assert_structural_equal(mod["main"], expected)
 
 
+def test_inject_global_barrier():
+    @T.prim_func(private=True)
+    def func(A: T.Buffer((1024,), "float32"), C: T.Buffer((1024,), "float32")):
+        B = T.allocate([1024], "float32", "global")
+        with T.attr(0, "pragma_global_barrier", 1):
+            blockIdx_x = T.launch_thread("blockIdx.x", 8)
+            threadIdx_x = T.launch_thread("threadIdx.x", 128)
+            B_1 = T.Buffer((1024,), data=B)
+            B_1[blockIdx_x * 128 + threadIdx_x] = A[blockIdx_x * 128 + threadIdx_x]
+            C[blockIdx_x * 128 + threadIdx_x] = B_1[1023 - blockIdx_x * 128 - threadIdx_x]
+
+    mod = tvm.IRModule({"main": func})
+    mod = tvm.s_tir.transform.InjectGlobalBarrier()(mod)
+    script = mod.script()
+    assert 'T.tvm_storage_sync("global"' in script
+    assert "pragma_global_barrier" not in script
+
+
 if __name__ == "__main__":
     test_thread_storage_sync()
     test_sync_else_branch()
     test_sync_read_thread_id_independent_location()
     test_sync_shared_dyn()
     test_sync_let_stmt()
+    test_inject_global_barrier()
@@ -0,0 +1,58 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.s_tir
+import tvm.testing
+from tvm import tir
+from tvm.script import tir as T
+
+
+def test_wgmma_accumulator():
+    @T.prim_func
+    def before(C: T.Buffer((128, 16), "float32")):
+        acc = T.alloc_buffer((128, 16), "float32", scope="wgmma.accumulator")
+        for i, j in T.grid(128, 16):
+            acc[i, j] = T.float32(0)
+        for i, j in T.grid(128, 16):
+            C[i, j] = acc[i, j]
+
+    mod = tvm.s_tir.transform.TransformMmaBufferLayout()(tvm.IRModule.from_expr(before))
+    root = mod["before"].body.block
+    (acc,) = root.alloc_buffers
+    assert acc.scope() == "local"
+    assert [int(dim) for dim in acc.shape] == [2, 2, 2, 2]
+
+    stores = []
+    tir.stmt_functor.post_order_visit(
+        root.body, lambda node: stores.append(node) if isinstance(node, tir.BufferStore) else None
+    )
+    acc_store = [store for store in stores if store.buffer.same_as(acc)][0]
+    i, j = 72, 13
+    analyzer = tvm.arith.Analyzer()
+    loop_i = root.body[0].loop_var
+    loop_j = root.body[0].body.loop_var
+    indices = [
+        int(analyzer.simplify(tir.stmt_functor.substitute(index, {loop_i: i, loop_j: j})))
+        for index in acc_store.indices
+    ]
+    # The element (72, 13) is in the second warpgroup tile, the second 8-column block, and is
+    # held as the row 72 % 16 // 8 == 1 and the column 13 % 2 == 1 of its thread.
+    assert indices == [1, 1, 1, 1]
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
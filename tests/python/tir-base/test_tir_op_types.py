@@ -227,6 +227,43 @@ def test_op_ptx_ldmatrix():
     assert expr.op.name == "tir.ptx_ldmatrix"
 
 
+def test_op_ptx_wgmma_ss():
+    buffer_a = tir.decl_buffer([64, 64], "float16", scope="shared.dyn")
+    buffer_b = tir.decl_buffer([128, 64], "float16", scope="shared.dyn")
+    buffer_c = tir.decl_buffer([64], "float32", scope="local")
+    expr = tir.ptx_wgmma_ss(
+        "float32",
+        "m64n128k16",
+        "float16",
+        "float16",
+        "float32",
+        buffer_a.data,
+        0,
+        16,
+        1024,
+        buffer_b.data,
+        0,
+        16,
+        1024,
+        3,
+        buffer_c.data,
+        0,
+    )
+    assert expr.op.name == "tir.ptx_wgmma_ss"
+    assert len(expr.args) == 16
+
+
+def test_op_ptx_wgmma_fence_commit_wait():
+    assert tir.ptx_wgmma_fence().op.name == "tir.ptx_wgmma_fence"
+    assert tir.ptx_wgmma_commit_group().op.name == "tir.ptx_wgmma_commit_group"
+    assert tir.ptx_wgmma_wait_group(0).op.name == "tir.ptx_wgmma_wait_group"
+
+
+def test_op_ptx_fence_proxy_async():
+    expr = tir.ptx_fence_proxy_async()
+    assert expr.op.name == "tir.ptx_fence_proxy_async"
+
+
 def test_op_ptx_cp_async():
     buffer_shared = tir.decl_buffer([16, 16], "float16", scope="shared")
     buffer_local = tir.decl_buffer([8], "float16", scope="local")
@@ -241,6 +278,18 @@ def test_op_ptx_cp_async_bulk():
     assert expr.op.name == "tir.ptx_cp_async_bulk"
 
 
+def test_op_ptx_tma_load():
+    buffer_shared = tir.decl_buffer([16, 64], "float16", scope="shared")
+    buffer_global = tir.decl_buffer([64, 64], "float16")
+    expr = tir.ptx_tma_load(
+        "float16", buffer_shared.data, 0, buffer_global.data, 0, 0, 2, 64, 64, 16, 64, 16, 0
+    )
+    assert expr.op.name == "tir.ptx_tma_load"
+    tensor_map = tir.Var("A_map", tvm.ir.PointerType(tvm.ir.type.TensorMapType()))
+    expr = tir.ptx_cp_async_bulk_tensor("float16", buffer_shared.data, 0, tensor_map, 0, 16, 0)
+    assert expr.op.name == "tir.ptx_cp_async_bulk_tensor"
+
+
 def test_op_ptx_commit_group():
     expr = tir.ptx_commit_group()
     assert expr.op.name == "tir.ptx_commit_group"
@@ -271,9 +320,21 @@ def test_op_ptx_arrive_barrier_expect_tx():
     assert expr.op.name == "tir.ptx_arrive_barrier_expect_tx"
 
 
+def test_op_ptx_barrier_expect_tx():
+    expr = tir.ptx_barrier_expect_tx(0, 32)
+    assert expr.op.name == "tir.ptx_barrier_expect_tx"
+
+
 def test_op_ptx_wait_barrier():
     expr = tir.ptx_wait_barrier(0)
     assert expr.op.name == "tir.ptx_wait_barrier"
+    expr = tir.ptx_wait_barrier(0, 1)
+    assert len(expr.args) == 2
+
+
+def test_op_ptx_bar_sync():
+    expr = tir.ptx_bar_sync(1, 128)
+    assert expr.op.name == "tir.ptx_bar_sync"
 
 
 def test_op_create_barriers():
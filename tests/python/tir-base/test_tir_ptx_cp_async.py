@@ -152,7 +152,52 @@ def test_ptx_cp_async_bulk():
     tvm.testing.assert_allclose(B_nd.numpy(), A_np)
 
 
+@T.prim_func
+def ptx_tma_load(A: T.Buffer((64, 128), "float16"), B: T.Buffer((64, 128), "float16")) -> None:
+    T.func_attr({"global_symbol": "default_function", "tir.noalias": True})
+    bx = T.env_thread("blockIdx.x")
+    tx = T.env_thread("threadIdx.x")
+    T.launch_thread(bx, 2)
+    T.launch_thread(tx, 32)
+    with T.sblock():
+        A_shared = T.alloc_buffer([32, 128], "float16", scope="shared", align=128)
+
+        T.reads(A[bx * 32 : bx * 32 + 32, 0:128])
+        T.writes(B[bx * 32 : bx * 32 + 32, 0:128])
+
+        T.evaluate(T.create_barriers(1, dtype=""))
+        if tx == 0:
+            T.evaluate(T.ptx_init_barrier_thread_count(0, 1, dtype=""))
+        T.evaluate(T.tvm_storage_sync("shared", dtype=""))
+
+        if tx == 0:
+            T.evaluate(
+                T.ptx_tma_load(
+                    A_shared.data, 0, A.data, 0, 0, 2, 64, 128, 32, 128, bx * 32, 0, dtype="float16"
+                )
+            )
+            T.evaluate(T.ptx_arrive_barrier_expect_tx(0, 8192, dtype=""))
+        T.evaluate(T.ptx_wait_barrier(0, dtype=""))
+
+        for i in range(128):
+            B[bx * 32 + tx, i] = A_shared[tx, i]
+
+
+@tvm.testing.requires_cuda_compute_version(9)
+def test_ptx_tma_load():
+    mod = tvm.compile(ptx_tma_load, target="cuda")
+    assert "cp.async.bulk.tensor.2d" in mod.mod.imports[0].inspect_source()
+    A_np = np.random.rand(64, 128).astype("float16")
+    B_np = np.zeros((64, 128)).astype("float16")
+    dev = tvm.cuda(0)
+    A_nd = tvm.runtime.tensor(A_np, device=dev)
+    B_nd = tvm.runtime.tensor(B_np, device=dev)
+    mod(A_nd, B_nd)
+    tvm.testing.assert_allclose(B_nd.numpy(), A_np)
+
+
 if __name__ == "__main__":
     test_ptx_cp_async()
     test_ptx_cp_async_barrier()
     test_ptx_cp_async_bulk()
+    test_ptx_tma_load()
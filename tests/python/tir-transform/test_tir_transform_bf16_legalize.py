@@ -448,8 +448,67 @@ def test_bf16_reduce_wont_legalize():
     tvm.ir.assert_structural_equal(after_storage, BindTarget(target)(after_storage_legalize()))
 
 
+def test_bf16_llvm_intrin_operand_wont_legalize():
+    def get_before():
+        @tvm.script.ir_module
+        class Before:
+            @T.prim_func
+            def main(
+                Aptr: T.handle("bfloat16"),
+                Cptr: T.handle("float32"),
+            ):
+                T.func_attr({"global_symbol": "main"})
+                A = T.decl_buffer((32,), "bfloat16", data=Aptr)
+                B = T.decl_buffer((32,), "bfloat16")
+                C = T.decl_buffer((16,), "float32", data=Cptr)
+                for i in T.grid(32):
+                    B[i] = A[i]
+                C[0:16] = T.call_llvm_pure_intrin(
+                    "float32x16",
+                    "llvm.x86.avx512bf16.dpbf16ps.512",
+                    C[0:16],
+                    A[0:32],
+                    B[0:32],
+                )
+
+        return Before
+
+    def after_storage_legalize():
+        @tvm.script.ir_module
+        class After:
+            @T.prim_func
+            def main(
+                Aptr: T.handle("uint16"),
+                Cptr: T.handle("float32"),
+            ):
+                T.func_attr({"global_symbol": "main"})
+                A = T.decl_buffer((32,), "uint16", data=Aptr)
+                B = T.decl_buffer((32,), "uint16")
+                C = T.decl_buffer((16,), "float32", data=Cptr)
+                for i in T.grid(32):
+                    B[i] = A[i]
+                C[0:16] = T.call_llvm_pure_intrin(
+                    "float32x16",
+                    "llvm.x86.avx512bf16.dpbf16ps.512",
+                    C[0:16],
+                    A[0:32],
+                    B[0:32],
+                )
+
+        return After
+
+    # The bf16 operands of the LLVM intrinsics are neither promoted to float32 nor converted.
+    target = Target("llvm")
+    before = BindTarget(target)(get_before())
+    after_compute = tvm.tir.transform.BF16ComputeLegalize()(before)
+    after_storage = tvm.tir.transform.BF16StorageLegalize()(after_compute)
+    tvm.ir.assert_structural_equal(after_compute, before)
+    tvm.ir.assert_structural_equal(after_storage, BindTarget(target)(after_storage_legalize()))
+
+
 if __name__ == "__main__":
     test_bf16_storage_compute_scope_will_legalize()
     test_bf16_storage_compute_scope_wont_legalize()
     test_bf16_reduce_will_legalize()
     test_bf16_reduce_wont_legalize()
+    test_bf16_llvm_intrin_operand_wont_legalize()
@@ -175,6 +175,40 @@ def test_subroutine_call_to_externally_visible_subroutine():
     )
 
 
+def test_unpacked_call_to_externally_visible_subroutine():
+    """Internal calls may bind to the unpacked entry of a subroutine
+
+    With "tir.unpacked_internal_calls", a call whose arguments match
+    the signature of an externally-visible subroutine calls an
+    internal copy of it directly, while the subroutine itself still
+    uses the PackedFunc API.
+    """
+
+    @I.ir_module
+    class before:
+        @T.prim_func
+        def main(A: T.Buffer(1, "float32")):
+            T.func_attr({"global_symbol": "main", "target": T.target("llvm", host="llvm")})
+            before.subroutine(A.data)
+
+        @T.prim_func
+        def subroutine(A_data: T.handle("float32")):
+            T.func_attr({"global_symbol": "subroutine", "target": T.target("llvm", host="llvm")})
+            T.evaluate(A_data)
+
+    with tvm.transform.PassContext(config={"tir.unpacked_internal_calls": True}):
+        after = tvm.tir.transform.MakePackedAPI()(before)
+
+    assert len(after["subroutine"].params) == 4
+    unpacked = after["subroutine_unpacked"]
+    assert "global_symbol" not in unpacked.attrs
+    assert len(unpacked.params) == 1
+
+    subroutine_call_op = _find_compute_scope(after["main"]).body.value.op
+    assert isinstance(subroutine_call_op, tvm.ir.GlobalVar)
+    assert subroutine_call_op.name_hint == "subroutine_unpacked"
+
+
 def test_function_call_with_wrong_argument_count():
     """Argument counts must be checked before accessing the type codes"""
 
@@ -0,0 +1,84 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm.script import tir as T
+
+
+def test_keep_base_offset_in_int64():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((T.int64(17179869184),), "float32")):
+        blockIdx_x = T.env_thread("blockIdx.x")
+        T.launch_thread(blockIdx_x, 16384)
+        threadIdx_y = T.env_thread("threadIdx.y")
+        T.launch_thread(threadIdx_y, 8)
+        threadIdx_x = T.env_thread("threadIdx.x")
+        T.launch_thread(threadIdx_x, 128)
+        A[
+            T.Cast("int64", blockIdx_x) * T.int64(1048576)
+            + T.Cast("int64", threadIdx_y) * T.int64(128)
+            + T.Cast("int64", threadIdx_x)
+        ] = T.float32(0)
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((T.int64(17179869184),), "float32")):
+        blockIdx_x = T.env_thread("blockIdx.x")
+        T.launch_thread(blockIdx_x, 16384)
+        threadIdx_y = T.env_thread("threadIdx.y")
+        T.launch_thread(threadIdx_y, 8)
+        threadIdx_x = T.env_thread("threadIdx.x")
+        T.launch_thread(threadIdx_x, 128)
+        A[
+            T.Cast("int64", blockIdx_x) * T.int64(1048576)
+            + T.Cast("int64", threadIdx_y * 128 + threadIdx_x)
+        ] = T.float32(0)
+
+    mod = tvm.tir.transform.NarrowIndexArithmetic()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_narrow_whole_index():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((T.int64(17179869184),), "float32")):
+        threadIdx_x = T.env_thread("threadIdx.x")
+        T.launch_thread(threadIdx_x, 128)
+        for i in range(T.int64(4)):
+            A[i * T.int64(128) + T.Cast("int64", threadIdx_x)] = T.float32(0)
+
+    @T.prim_func(private=True)
+    def expected(A: T.Buffer((T.int64(17179869184),), "float32")):
+        threadIdx_x = T.env_thread("threadIdx.x")
+        T.launch_thread(threadIdx_x, 128)
+        for i in range(T.int64(4)):
+            A[T.Cast("int64", T.Cast("int32", i) * 128 + threadIdx_x)] = T.float32(0)
+
+    mod = tvm.tir.transform.NarrowIndexArithmetic()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_skip_host_code():
+    @T.prim_func(private=True)
+    def before(A: T.Buffer((T.int64(17179869184),), "float32")):
+        for i, j in T.grid(T.int64(4), T.int64(128)):
+            A[i * T.int64(128) + j] = T.float32(0)
+
+    mod = tvm.tir.transform.NarrowIndexArithmetic()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], before)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
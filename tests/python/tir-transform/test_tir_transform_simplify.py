@@ -1913,5 +1913,30 @@ def test_nested_if_elimination():
     tvm.ir.assert_structural_equal(after, expected)
 
 
+def test_simplify_functions_in_parallel():
+    """A thread-safe pass gives the same module whatever the number of threads"""
+
+    def _make_func(index):
+        @T.prim_func(private=True)
+        def func(A: T.Buffer((16,), "int32")):
+            for i in range(16):
+                if i < 16:
+                    A[i // 4 * 4 + i % 4] = index
+
+        return func
+
+    mod = tvm.IRModule({f"func{i}": _make_func(i) for i in range(8)})
+    assert tvm.tir.transform.Simplify().info.thread_safe
+
+    with tvm.transform.PassContext(config={"transform.num_function_pass_threads": 1}):
+        expected = tvm.tir.transform.Simplify()(mod)
+    with tvm.transform.PassContext(config={"transform.num_function_pass_threads": 4}):
+        after = tvm.tir.transform.Simplify()(mod)
+    tvm.ir.assert_structural_equal(after, expected)
+    assert [gv.name_hint for gv in after.get_global_vars()] == [
+        gv.name_hint for gv in mod.get_global_vars()
+    ]
+
+
 if __name__ == "__main__":
     tvm.testing.main()
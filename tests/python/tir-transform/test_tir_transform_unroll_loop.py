@@ -156,8 +156,76 @@ def test_unroll_local_access():
     tvm.ir.assert_structural_equal(after, Expected)
 
 
+def _accumulate_module(num_threads, extent):
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def main(B: T.Buffer((8192,), "float32"), C: T.Buffer((1024,), "float32")):
+            T.func_attr({"target": T.target("cuda", host="llvm")})
+            tx = T.launch_thread("threadIdx.x", num_threads)
+            acc_data = T.allocate([1], dtype="float32", scope="local")
+            acc = T.Buffer([1], dtype="float32", data=acc_data)
+            acc[0] = T.float32(0)
+            for i in T.serial(extent):
+                acc[0] = acc[0] + B[tx * extent + i]
+            C[tx] = acc[0]
+
+    return Module
+
+
+def _has_loop(func):
+    loops = []
+    tvm.tir.stmt_functor.post_order_visit(
+        func.body, lambda node: loops.append(node) if isinstance(node, tvm.tir.For) else None
+    )
+    return len(loops) > 0
+
+
+def test_unroll_by_cost_model():
+    after = tvm.tir.transform.UnrollLoop()(_accumulate_module(128, 4))
+    assert not _has_loop(after["main"])
+
+    # The cost model is off without a target, or when disabled.
+    without_target = _accumulate_module(128, 4)
+    without_target["main"] = without_target["main"].without_attr("target")
+    after = tvm.tir.transform.UnrollLoop()(without_target)
+    assert _has_loop(after["main"])
+    with tvm.transform.PassContext(config={"tir.UnrollLoop": {"auto_unroll_heuristic": False}}):
+        after = tvm.tir.transform.UnrollLoop()(_accumulate_module(128, 4))
+    assert _has_loop(after["main"])
+
+    # The loops of too many unrolled instructions are kept.
+    after = tvm.tir.transform.UnrollLoop()(_accumulate_module(128, 256))
+    assert _has_loop(after["main"])
+
+
+def test_cost_model_register_pressure():
+    # The 32 loads of the unrolled loop fit the registers of a thread of 128 threads, but not of
+    # 1024 threads, of 64 registers each.
+    after = tvm.tir.transform.UnrollLoop()(_accumulate_module(128, 32))
+    assert not _has_loop(after["main"])
+    after = tvm.tir.transform.UnrollLoop()(_accumulate_module(1024, 32))
+    assert _has_loop(after["main"])
+
+
+def test_cost_model_respects_tuned_unroll():
+    mod = _accumulate_module(128, 4)
+    body = mod["main"].body
+    mod["main"] = mod["main"].with_body(
+        tvm.tir.AttrStmt(tvm.tir.const(0, "int32"), "pragma_auto_unroll_max_step", 0, body)
+    )
+    after = tvm.tir.transform.UnrollLoop()(mod)
+    assert _has_loop(after["main"])
+    with tvm.transform.PassContext(config={"tir.UnrollLoop": {"auto_max_step": 2}}):
+        after = tvm.tir.transform.UnrollLoop()(_accumulate_module(128, 4))
+    assert _has_loop(after["main"])
+
+
 if __name__ == "__main__":
     test_unroll_local_access()
     test_unroll_loop()
     test_unroll_fake_loop()
     test_unroll_allocations()
+    test_unroll_by_cost_model()
+    test_cost_model_register_pressure()
+    test_cost_model_respects_tuned_unroll()
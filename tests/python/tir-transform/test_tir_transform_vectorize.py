@@ -617,6 +617,139 @@ def test_vectorize_and_predicate_multiple_access_statements():
     tvm.ir.assert_structural_equal(after, expected)
 
 
+def test_vectorize_and_predicate_offset_and_2d_accesses():
+    # The lane mask only depends on the condition, so it applies to the contiguous
+    # accesses with other bases, here shifted and in the last dimension of C.
+    @T.prim_func
+    def before(a: T.handle, b: T.handle, c: T.handle):
+        A = T.match_buffer(a, (18,), "float32")
+        B = T.match_buffer(b, (16,), "float32")
+        C = T.match_buffer(c, (2, 16), "float32")
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i_0 in T.serial(T.ceildiv(14, 4)):
+            for i_1 in T.vectorized(4):
+                if i_0 * 4 + i_1 <= 13:
+                    B[i_0 * 4 + i_1] = A[i_0 * 4 + i_1 + 2]
+                    C[1, i_0 * 4 + i_1] = 1.0
+
+    @T.prim_func
+    def expected(a: T.handle, b: T.handle, c: T.handle):
+        A = T.match_buffer(a, (18,), "float32")
+        B = T.match_buffer(b, (16,), "float32")
+        C = T.match_buffer(c, (2, 16), "float32")
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i_0 in range(4):
+            load_a = T.meta_var(
+                A.vload(
+                    [T.Ramp(i_0 * 4 + 2, 1, 4)],
+                    predicate=T.get_active_lane_mask("uint1x4", i_0 * 4, 14),
+                )
+            )
+            B.vstore(
+                [T.Ramp(i_0 * 4, 1, 4)],
+                load_a,
+                predicate=T.get_active_lane_mask("uint1x4", i_0 * 4, 14),
+            )
+            C.vstore(
+                [1, T.Ramp(i_0 * 4, 1, 4)],
+                T.Broadcast(T.float32(1), 4),
+                predicate=T.get_active_lane_mask("uint1x4", i_0 * 4, 14),
+            )
+
+    mod = tvm.IRModule.from_expr(before)
+    with tvm.transform.PassContext(config={"tir.enable_buffer_level_predication": True}):
+        after = tvm.tir.transform.VectorizeLoop()(mod)["main"]
+    tvm.ir.assert_structural_equal(after, expected)
+
+
+def test_vectorize_and_predicate_by_default_with_avx512():
+    @T.prim_func
+    def before(a: T.handle, b: T.handle):
+        A = T.match_buffer(a, (16,), "float32")
+        B = T.match_buffer(b, (16,), "float32")
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i_0 in T.serial(T.ceildiv(14, 4)):
+            for i_1 in T.vectorized(4):
+                if i_0 * 4 + i_1 < 14:
+                    B[i_0 * 4 + i_1] = A[i_0 * 4 + i_1]
+
+    def num_predicated(func):
+        stores = []
+        tvm.tir.stmt_functor.post_order_visit(
+            func.body,
+            lambda node: (
+                stores.append(node)
+                if isinstance(node, tvm.tir.BufferStore) and node.predicate is not None
+                else None
+            ),
+        )
+        return len(stores)
+
+    mod = tvm.IRModule.from_expr(before)
+    with tvm.target.Target("llvm -mtriple=x86_64-linux-gnu -mcpu=skylake-avx512"):
+        assert num_predicated(tvm.tir.transform.VectorizeLoop()(mod)["main"]) == 1
+    with tvm.target.Target(simple_target):
+        assert num_predicated(tvm.tir.transform.VectorizeLoop()(mod)["main"]) == 0
+
+
+def test_vectorize_reduction_into_invariant_element():
+    @T.prim_func
+    def before(A: T.Buffer((16,), "float32"), B: T.Buffer((2,), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i in T.vectorized(16):
+            B[0] = B[0] + A[i]
+        for i in T.vectorized(16):
+            B[1] = T.max(A[i], B[1])
+
+    @T.prim_func
+    def expected(A: T.Buffer((16,), "float32"), B: T.Buffer((2,), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        B[0] = B[0] + T.vector_reduce_add("float32", A[0:16])
+        B[1] = T.max(B[1], T.vector_reduce_max("float32", A[0:16]))
+
+    with tvm.target.Target(simple_target):
+        mod = tvm.tir.transform.VectorizeLoop()(tvm.IRModule.from_expr(before))
+    tvm.ir.assert_structural_equal(mod["main"], expected)
+
+
+def test_vectorize_reduction_hoists_vector_accumulator():
+    @T.prim_func
+    def before(A: T.Buffer((64,), "int32"), B: T.Buffer((1,), "int32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i_0 in range(16):
+            for i_1 in T.vectorized(4):
+                B[0] = B[0] * A[i_0 * 4 + i_1]
+
+    with tvm.target.Target(simple_target):
+        func = tvm.tir.transform.VectorizeLoop()(tvm.IRModule.from_expr(before))["main"]
+
+    reduce_op = tvm.ir.Op.get("tir.vector_reduce_mul")
+    seq = func.body.body.body
+    assert isinstance(func.body, tvm.tir.Allocate) and func.body.dtype == "int32"
+    assert isinstance(seq, tvm.tir.SeqStmt) and len(seq) == 3
+    init, loop, final = seq
+    assert isinstance(init.value, tvm.tir.Broadcast) and init.value.value.value == 1
+    assert isinstance(loop, tvm.tir.For) and loop.body.value.dtype == "int32x4"
+    assert isinstance(final.value.b, tvm.tir.Call) and final.value.b.op.same_as(reduce_op)
+
+
+def test_vectorize_reduction_requires_invariant_target():
+    @T.prim_func
+    def before(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i in T.vectorized(4):
+            B[0] = B[0] + B[i]
+
+    with tvm.target.Target(simple_target):
+        mod = tvm.tir.transform.VectorizeLoop()(tvm.IRModule.from_expr(before))
+    calls = []
+    tvm.tir.stmt_functor.post_order_visit(
+        mod["main"].body,
+        lambda node: calls.append(node) if isinstance(node, tvm.tir.Call) else None,
+    )
+    assert not any(call.op.name.startswith("tir.vector_reduce") for call in calls)
+
+
 def test_vectorize_and_predicate_invalid_conditions():
     @T.prim_func
     def before(a: T.handle, b: T.handle):
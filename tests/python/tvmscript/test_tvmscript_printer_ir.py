@@ -18,10 +18,15 @@
 
 import pytest
 
+import tvm
+import tvm.testing
 from tvm import IRModule, TVMError
 from tvm.script.ir_builder import IRBuilder
 from tvm.script.ir_builder import ir as I
 from tvm.script.ir_builder import tir as T
+from tvm.script import ir as I_
+from tvm.script import relax as R_
+from tvm.script import tir as T_
 
 
 def _assert_print(obj, expected):
@@ -62,6 +67,39 @@ def test_failed_invalid_prefix():
         mod.script(ir_prefix="2I")
 
 
+def test_parallel_script(tmp_path):
+    @I_.ir_module
+    class Module:
+        @T_.prim_func
+        def add(A: T_.Buffer((8,), "float32"), B: T_.Buffer((8,), "float32")):
+            for i in range(8):
+                B[i] = A[i] + T_.float32(1)
+
+        @T_.prim_func
+        def mul(A: T_.Buffer((8,), "float32"), B: T_.Buffer((8,), "float32")):
+            for i in range(8):
+                B[i] = A[i] * T_.float32(2)
+
+        @R_.function
+        def main(x: R_.Tensor((8,), "float32")) -> R_.Tensor((8,), "float32"):
+            cls = Module
+            y = R_.call_tir(cls.add, (x,), out_sinfo=R_.Tensor((8,), "float32"))
+            z = R_.call_tir(cls.mul, (y,), out_sinfo=R_.Tensor((8,), "float32"))
+            return z
+
+    for num_threads in [1, 2]:
+        assert Module.parallel_script(num_threads=num_threads) == Module.script()
+    assert Module.parallel_script(show_meta=True, indent_spaces=2) == Module.script(
+        show_meta=True, indent_spaces=2
+    )
+
+    path = str(tmp_path / "module.py")
+    Module.write_script(path)
+    with open(path) as f:
+        source = f.read()
+    assert source == Module.script()
+    tvm.ir.assert_structural_equal(tvm.script.from_source(source), Module)
+
+
 if __name__ == "__main__":
-    test_ir_module()
-    test_failed_invalid_prefix()
+    tvm.testing.main()
@@ -27,3 +27,9 @@ python3 -m pip install  -v --target=python ./3rdparty/tvm-ffi/
 find . -type f -path "*.pyc" | xargs rm -f
 
 run_pytest python-topi-nightly tests/python/topi/nightly
+
+# compile-time benchmark, compared against a stored baseline when one is provided
+mkdir -p build/compile_benchmark
+python3 -m tvm.relax.testing.compile_benchmark \
+    --output build/compile_benchmark/results.json \
+    ${TVM_COMPILE_BENCHMARK_BASELINE:+--baseline "${TVM_COMPILE_BENCHMARK_BASELINE}"}
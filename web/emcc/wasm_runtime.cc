@@ -83,8 +83,28 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
   return 0;
 }
 
+int TVMBackendParallelLaunchChunked(FTVMParallelLambda flambda, void* cdata, int num_chunk) {
+  TVMParallelGroupEnv env;
+  env.num_task = 1;
+  flambda(0, &env, cdata);
+  return 0;
+}
+
 int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) { return 0; }
 
+// Wasm has a single memory node.
+namespace tvm {
+namespace runtime {
+namespace threading {
+int NumaNodeCount() { return 1; }
+int NumaNodeOfCpu(unsigned int cpu) { return 0; }
+int CurrentNumaNode() { return 0; }
+bool BindMemoryToNumaNode(void* ptr, size_t size, int node) { return false; }
+bool InterleaveMemoryAcrossNumaNodes(void* ptr, size_t size) { return false; }
+}  // namespace threading
+}  // namespace runtime
+}  // namespace tvm
+
 // --- Environment ffi::Functions for testing ---
 namespace tvm {
 namespace runtime {
@@ -81,6 +81,31 @@ export interface ArtifactCacheTemplate {
     * Note: This is an async function.
    */
   deleteInCache(url: string): Promise<void>;
+
+  /**
+   * Retrieve the data of `url` as a stream of chunks. If the data does not exist in cache, fetch
+   * it, and add it to cache while the stream is read.
+   *
+   * Optional: caches that cannot stream the data do not implement it, and are read with
+   * `fetchWithCache()` instead.
+   *
+   * @param url The url to the data to be cached.
+   * @param signal An optional AbortSignal to abort data retrival.
+   * @return The stream of the data, and a promise resolved once the data is in cache.
+   *
+   * Note: This is an async function.
+   */
+  fetchStreamWithCache?(url: string, signal?: AbortSignal): Promise<ArtifactStream>;
+}
+
+/**
+ * The data of an artifact, as a stream of chunks.
+ */
+export interface ArtifactStream {
+  /** The chunks of the data. */
+  stream: ReadableStream<Uint8Array>;
+  /** Resolved once the data is in cache, after the stream is read. */
+  cached: Promise<void>;
 }
 
 
@@ -139,6 +164,32 @@ export class ArtifactCache implements ArtifactCacheTemplate {
     }
   }
 
+  /**
+   * Stream the corresponding url object, from cache or from the network
+   * @param url url
+   * @param signal an optional abort signal to abort fetching
+   * @returns the stream of the data, and a promise resolved once the data is in cache
+   */
+  async fetchStreamWithCache(url: string, signal?: AbortSignal): Promise<ArtifactStream> {
+    const request = new Request(url, signal ? { signal } : undefined);
+    if (this.cache === undefined) {
+      this.cache = await caches.open(this.scope);
+    }
+    const result = await this.cache.match(request);
+    if (result !== undefined && result.body !== null) {
+      return { stream: result.body, cached: Promise.resolve() };
+    }
+    const response = await fetch(request);
+    if (!response.ok || response.body === null) {
+      throw Error("Cannot fetch " + url + ", status " + response.status);
+    }
+    // One branch is read by the caller while the other one is written to cache.
+    const [stream, cacheStream] = response.body.tee();
+    const cached = this.cache.put(
+      request, new Response(cacheStream, { headers: response.headers }));
+    return { stream: stream, cached: cached };
+  }
+
   /**
    * Determine if all keys exist in the cache
    * @param keys the url key list of the strings
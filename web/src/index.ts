@@ -26,6 +26,7 @@ export {
 } from "./runtime";
 export {
   ArtifactCacheTemplate,
+  ArtifactStream,
   ArtifactCache,
   ArtifactIndexedDBCache,
   hasTensorInCache,
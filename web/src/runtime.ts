@@ -31,6 +31,7 @@ import {
   ArtifactCache,
   ArtifactCacheTemplate,
   ArtifactIndexedDBCache,
+  TensorCacheEntry,
   TensorShardEntry,
 } from "./artifact_cache";
 import * as compact from "./compact";
@@ -1307,7 +1308,7 @@ export class Instance implements Disposable {
 
     const cacheOnly = await artifactCache.hasAllKeys(list.map(key => new URL(key.dataPath, tensorCacheUrl).href));
 
-    // `loading`: we have finished downloading (or already cacheOnly) and are loading onto WebGPU
+    // `loading`: all the shards are in cache (cacheOnly), and are only loaded onto the device
     const reportCallback = (iter: number, loading = false) => {
       // report
       for (let j = 0; j < this.initProgressCallback.length; ++j) {
@@ -1341,90 +1342,128 @@ export class Instance implements Disposable {
       });
     }
 
-    // First download all shards to cache parallely if not yet in cache
-    const downloadCache = async (start: number, end: number) => {
-      // Download params [start, end) from `list`
-      for (let i = start; i < end; i++) {
-        const shard = list[i];
-        const dataUrl = new URL(shard.dataPath, tensorCacheUrl).href;
-        try {
-          await artifactCache.addToCache(dataUrl, "arraybuffer", signal);
-        } catch (err) {
-          this.env.logger("Error: Cannot fetch " + dataUrl + " err= " + err);
-          throw err;
-        }
-        timeElapsed = Math.ceil((perf.now() - tstart) / 1000);
-        fetchedBytes += shard.nbytes;
-        reportCallback(++fetchedShards, /*loading=*/false);
+    // Load a record of a shard, `data` holds the bytes of the shard.
+    const loadRecord = (rec: TensorCacheEntry, data: Uint8Array) => {
+      // A view instead of a copy, the bytes are copied once into the tensor.
+      const recSource = data.subarray(rec.byteOffset, rec.byteOffset + rec.nbytes);
+      // Raw bytes are written to the GPU buffer directly, without a staging CPU tensor.
+      // writeBuffer needs the size to be a multiple of 4.
+      if (device.deviceType === DeviceStrToEnum.webgpu && rec.format === "raw" &&
+          rec.nbytes % 4 === 0) {
+        const gpu_arr = this.withNewScope(() => {
+          return this.detachFromCurrentScope(
+            this.empty(rec.shape, rec.dtype, device)
+          )
+        });
+        gpu_arr.copyFromRawBytes(recSource);
+        this.tensorCacheUpdate(rec.name, gpu_arr, false);
+        gpu_arr.dispose();
+        return;
       }
-    }
-    // We launch 4 parallel for loops to limit the max concurrency to 4 download
-    if (!cacheOnly) {
-      const loopSize = Math.floor(list.length / 4);
-      await Promise.all([
-        downloadCache(0, loopSize),
-        downloadCache(loopSize, 2 * loopSize),
-        downloadCache(2 * loopSize, 3 * loopSize),
-        downloadCache(3 * loopSize, list.length)
-      ]);
-    }
-
-    // Reset for the loading phase to avoid double counting with download phase
-    fetchedBytes = 0;
-    fetchedShards = 0;
+      const cpu_arr = this.withNewScope(() => {
+        return this.detachFromCurrentScope(
+          this.empty(rec.shape, rec.dtype, this.cpu())
+        )
+      });
+      // first sync copy to cpu.
+      this.ctx.arrayDecodeStorage(cpu_arr, recSource, rec.format, rec.dtype);
+      // then async stream into GPU if needed
+      if (device.deviceType === DeviceStrToEnum.cpu) {
+        this.tensorCacheUpdate(rec.name, cpu_arr, false);
+        cpu_arr.dispose();
+      } else {
+        // allocate a gpu arr and async copy to it, the copy reads the cpu arr right away.
+        const gpu_arr = this.withNewScope(() => {
+          return this.detachFromCurrentScope(
+            this.empty(rec.shape, rec.dtype, device)
+          )
+        });
+        gpu_arr.copyFrom(cpu_arr);
+        this.tensorCacheUpdate(rec.name, gpu_arr, false);
+        cpu_arr.dispose();
+        gpu_arr.dispose();
+      }
+    };
 
-    // Then iteratively, load the shard from cache
-    for (let i = 0; i < list.length; ++i) {
+    // Fetch a shard and load its records. When the cache can stream the shard, the records are
+    // loaded as soon as their bytes arrive, while the rest of the shard is still downloading.
+    const loadShard = async (i: number) => {
       const shard = list[i];
       const dataUrl = new URL(shard.dataPath, tensorCacheUrl).href;
-      let buffer;
+      const records = shard.records.slice().sort((a, b) => a.byteOffset - b.byteOffset);
+      let numLoaded = 0;
+      const loadRecordsBefore = (data: Uint8Array, nbytes: number) => {
+        while (numLoaded < records.length &&
+               records[numLoaded].byteOffset + records[numLoaded].nbytes <= nbytes) {
+          const rec = records[numLoaded];
+          try {
+            loadRecord(rec, data);
+          } catch (err) {
+            this.env.logger(
+              "Failed to load shard " + i + "'s record: " + JSON.stringify(rec) + "\n" +
+              "Error: " + err
+            );
+            throw err;
+          }
+          ++numLoaded;
+        }
+      };
       try {
-        buffer = await artifactCache.fetchWithCache(dataUrl, "arraybuffer");
+        if (artifactCache.fetchStreamWithCache !== undefined) {
+          const { stream, cached } = await artifactCache.fetchStreamWithCache(dataUrl, signal);
+          // The chunks are gathered into one buffer, allocated once.
+          const data = new Uint8Array(shard.nbytes);
+          let received = 0;
+          const reader = stream.getReader();
+          while (true) {
+            const { done, value } = await reader.read();
+            if (done) break;
+            if (received + value.length > shard.nbytes) {
+              throw Error("Expect " + shard.nbytes + " bytes in " + dataUrl);
+            }
+            data.set(value, received);
+            received += value.length;
+            loadRecordsBefore(data, received);
+          }
+          await cached;
+          if (received !== shard.nbytes) {
+            throw Error("Expect " + shard.nbytes + " bytes in " + dataUrl + ", got " + received);
+          }
+        } else {
+          const buffer = await artifactCache.fetchWithCache(dataUrl, "arraybuffer", signal);
+          const data = new Uint8Array(buffer);
+          loadRecordsBefore(data, data.length);
+        }
       } catch (err) {
         this.env.logger("Error: Cannot fetch " + dataUrl + " err= " + err);
         throw err;
       }
-      const shardRecords = shard.records;
-      for (let j = 0; j < shardRecords.length; ++j) {
-        try {
-          const rec = shardRecords[j];
-          const cpu_arr = this.withNewScope(() => {
-            return this.detachFromCurrentScope(
-              this.empty(rec.shape, rec.dtype, this.cpu())
-            )
-          });
-          const recSource = buffer.slice(rec.byteOffset, rec.byteOffset + rec.nbytes);
-          // first sync copy to cpu.
-          this.ctx.arrayDecodeStorage(cpu_arr, new Uint8Array(recSource), rec.format, rec.dtype);
-          // then async stream into GPU if needed
-          if (device.deviceType === DeviceStrToEnum.cpu) {
-            this.tensorCacheUpdate(rec.name, cpu_arr, false);
-            cpu_arr.dispose();
-          } else {
-            // allocate a gpu arr and async copy to it.
-            const gpu_arr = this.withNewScope(() => {
-              return this.detachFromCurrentScope(
-                this.empty(rec.shape, rec.dtype, device)
-              )
-            });
-            gpu_arr.copyFrom(cpu_arr);
-            await device.sync();
-            this.tensorCacheUpdate(rec.name, gpu_arr, false);
-            cpu_arr.dispose();
-            gpu_arr.dispose();
-          }
-        } catch (err) {
-          this.env.logger(
-            "Failed to load shard " + i + "'s record: " + JSON.stringify(shardRecords[j]) + "\n" +
-            "Error: " + err
-          );
-          throw err;
-        }
+      if (numLoaded !== records.length) {
+        throw Error("The records of shard " + i + " exceed the bytes of " + dataUrl);
+      }
+      // Wait for the copies of the shard once, rather than after each record.
+      if (device.deviceType !== DeviceStrToEnum.cpu) {
+        await device.sync();
       }
       fetchedBytes += shard.nbytes;
       timeElapsed = Math.ceil((perf.now() - tstart) / 1000);
-      reportCallback(++fetchedShards, /*loading=*/true);
+      reportCallback(++fetchedShards, /*loading=*/cacheOnly);
+    };
+
+    // Fetch and load the shards with at most 4 shards in flight. Each worker takes the next shard
+    // once done with its own, so a large shard does not hold back the others. The shards already in
+    // cache are not fetched again, so an interrupted fetch resumes from the missing shards.
+    let nextShard = 0;
+    const worker = async () => {
+      while (nextShard < list.length) {
+        await loadShard(nextShard++);
+      }
+    };
+    const workers: Array<Promise<void>> = [];
+    for (let i = 0; i < Math.min(4, list.length); ++i) {
+      workers.push(worker());
     }
+    await Promise.all(workers);
   }
 
   /**
@@ -402,10 +402,26 @@ export class WebGPUContext {
   // internal data
   private bufferTable: Array<GPUBuffer | undefined> = [undefined];
   private bufferTableFreeId: Array<number> = [];
-  private podArgStagingBuffers: Array<GPUBuffer> = [];
   private canvasRenderManager?: CanvasRenderManager = undefined;
-  // number of pod arg staging buffers
-  private maxNumPodArgsStagingBuffers = 2;
+  // freed buffers kept for reuse, by size class
+  private bufferPool: Map<number, Array<GPUBuffer>> = new Map();
+  // total size of the buffers in the pool
+  private pooledBytes = 0;
+  // maximum total size of the buffers kept in the pool
+  private maxPooledBytes = 1 << 28;
+  // The dispatches are batched into a single compute pass, submitted at the next sync point.
+  private pendingEncoder?: GPUCommandEncoder = undefined;
+  private pendingComputePass?: GPUComputePassEncoder = undefined;
+  // The pod arguments of the pending dispatches, at dynamic offsets of a single uniform buffer,
+  // which is written once before the pending commands are submitted.
+  private podArgsBuffer?: GPUBuffer = undefined;
+  private podArgsBufferSize = 1 << 16;
+  private podArgsHostData = new Uint8Array(this.podArgsBufferSize);
+  private podArgsOffset = 0;
+  // incremented whenever cached bind groups may refer to a freed buffer
+  private bindGroupCacheEpoch = 0;
+  // maximum number of bind groups cached per shader
+  private maxNumCachedBindGroups = 256;
   // flags for debugging
   // stats of the runtime.
   // peak allocation
@@ -435,9 +451,12 @@ export class WebGPUContext {
     while (this.bufferTable.length != 0) {
       this.bufferTable.pop()?.destroy();
     }
-    while (this.podArgStagingBuffers.length != 0) {
-      this.podArgStagingBuffers.pop()?.destroy();
+    for (const buffers of this.bufferPool.values()) {
+      buffers.forEach((buffer) => buffer.destroy());
     }
+    this.bufferPool.clear();
+    this.pooledBytes = 0;
+    this.podArgsBuffer?.destroy();
     this.device.destroy();
   }
 
@@ -445,9 +464,35 @@ export class WebGPUContext {
    * Wait for all pending GPU tasks to complete
    */
   async sync(): Promise<void> {
+    this.flushPendingCommands();
     await this.device.queue.onSubmittedWorkDone();
   }
 
+  /**
+   * Submit the dispatches batched so far.
+   *
+   * Called before any other queue operation, so that the queue order follows the call order.
+   */
+  flushPendingCommands(): void {
+    if (this.pendingEncoder === undefined || this.pendingComputePass === undefined) {
+      return;
+    }
+    this.pendingComputePass.end();
+    if (this.podArgsBuffer !== undefined && this.podArgsOffset != 0) {
+      this.device.queue.writeBuffer(
+        this.podArgsBuffer,
+        0,
+        this.podArgsHostData as GPUAllowSharedBufferSource,
+        0,
+        this.podArgsOffset
+      );
+    }
+    this.device.queue.submit([this.pendingEncoder.finish()]);
+    this.pendingEncoder = undefined;
+    this.pendingComputePass = undefined;
+    this.podArgsOffset = 0;
+  }
+
   /**
    * Obtain the runtime information in readable format.
    */
@@ -468,6 +513,7 @@ export class WebGPUContext {
     if (this.canvasRenderManager == undefined) {
       throw Error("Do not have a canvas context, call bindCanvas first");
     }
+    this.flushPendingCommands();
     this.canvasRenderManager.draw(this.gpuBufferFromPtr(ptr), height, width);
   }
 
@@ -485,6 +531,7 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
+    this.flushPendingCommands();
     // Perhaps it would be more useful to use a staging buffer?
     this.device.queue.writeBuffer(
       this.gpuBufferFromPtr(toPtr),
@@ -534,37 +581,37 @@ export class WebGPUContext {
   }
 
   /**
-   * Get the pod arg staging buffer
-   * \param nbytes The minimum size.
-   * \return The allocated buffer
+   * Reserve the room of the pod arguments of a dispatch in the pod arguments buffer.
+   * \param nbytes The size of the pod arguments.
+   * \return The offset of the pod arguments in the buffer.
    */
-  private getPodArgsBuffer(nbytes: number): GPUBuffer {
-    let buffer: GPUBuffer | undefined = undefined;
-    if (this.podArgStagingBuffers.length >= this.maxNumPodArgsStagingBuffers) {
-      buffer = this.podArgStagingBuffers.shift();
+  private allocPodArgs(nbytes: number): number {
+    const alignment = this.device.limits.minUniformBufferOffsetAlignment;
+    assert(nbytes <= this.podArgsBufferSize);
+    if (this.podArgsOffset + nbytes > this.podArgsBufferSize) {
+      this.flushPendingCommands();
     }
-    // minimum of 16 bytes
-    let allocSize = 16;
-    if (buffer !== undefined) {
-      allocSize = buffer.size;
-      if (buffer.size < nbytes) {
-        buffer.destroy();
-        buffer = undefined;
-      }
-    }
-    while (allocSize < nbytes) {
-      allocSize *= 2;
-    }
-
-    if (buffer == undefined) {
+    if (this.podArgsBuffer === undefined) {
       // create uniform buffer
-      buffer = tryCreateBuffer(this.device, {
-        size: allocSize,
+      this.podArgsBuffer = tryCreateBuffer(this.device, {
+        size: this.podArgsBufferSize,
         usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
       });
     }
-    assert(nbytes <= buffer.size);
-    return buffer;
+    const offset = this.podArgsOffset;
+    this.podArgsOffset += Math.ceil(nbytes / alignment) * alignment;
+    return offset;
+  }
+
+  /**
+   * Get the compute pass the dispatches are batched into.
+   */
+  private getPendingComputePass(): GPUComputePassEncoder {
+    if (this.pendingEncoder === undefined || this.pendingComputePass === undefined) {
+      this.pendingEncoder = this.device.createCommandEncoder();
+      this.pendingComputePass = this.pendingEncoder.beginComputePass();
+    }
+    return this.pendingComputePass;
   }
 
   /**
@@ -629,7 +676,8 @@ export class WebGPUContext {
       binding: bufferArgIndices.length,
       visibility: GPUShaderStage.COMPUTE,
       buffer: {
-        type: "uniform"
+        type: "uniform",
+        hasDynamicOffset: true
       }
     });
 
@@ -642,6 +690,11 @@ export class WebGPUContext {
 
     // Function to create the pipeline.
     const createShaderFunc = (pipeline: GPUComputePipeline): Function => {
+      // The bind groups of the buffer arguments seen so far, as the pod arguments are bound
+      // through a dynamic offset.
+      const bindGroupCache: Map<string, GPUBindGroup> = new Map();
+      let bindGroupCacheEpoch = this.bindGroupCacheEpoch;
+
       const submitShader = (...args: Array<GPUPointer | number>): void => {
         if (this.debugShaderSubmitLimit != -1 &&
           this.shaderSubmitCounter >= this.debugShaderSubmitLimit) {
@@ -649,10 +702,6 @@ export class WebGPUContext {
           return;
         }
 
-        const commandEncoder = this.device.createCommandEncoder();
-        const compute = commandEncoder.beginComputePass();
-        compute.setPipeline(pipeline);
-        const bindGroupEntries: Array<GPUBindGroupEntry> = [];
         const numBufferOrPodArgs = bufferArgIndices.length + podArgIndices.length;
 
         assert(args.length == numBufferOrPodArgs + dispatchToDim.length);
@@ -686,21 +735,14 @@ export class WebGPUContext {
           assert(wl_x * wl_z >= packDimX);
         }
 
-        for (let i = 0; i < bufferArgIndices.length; ++i) {
-          bindGroupEntries.push({
-            binding: i,
-            resource: {
-              buffer: this.gpuBufferFromPtr(args[bufferArgIndices[i]])
-            }
-          });
-        }
-
         // push pod buffer
         const sizeOfI32 = 4;
-        const podArgBuffer = this.getPodArgsBuffer((podArgIndices.length + 1) * sizeOfI32);
-        const i32View = new Int32Array(podArgIndices.length + 1);
-        const u32View = new Uint32Array(i32View.buffer);
-        const f32View = new Float32Array(i32View.buffer);
+        const podArgsNBytes = (podArgIndices.length + 1) * sizeOfI32;
+        const podArgsOffset = this.allocPodArgs(podArgsNBytes);
+        const i32View = new Int32Array(
+          this.podArgsHostData.buffer, podArgsOffset, podArgIndices.length + 1);
+        const u32View = new Uint32Array(i32View.buffer, podArgsOffset, podArgIndices.length + 1);
+        const f32View = new Float32Array(i32View.buffer, podArgsOffset, podArgIndices.length + 1);
 
         for (let i = 0; i < podArgIndices.length; ++i) {
           const value = args[podArgIndices[i]];
@@ -717,27 +759,45 @@ export class WebGPUContext {
         }
         // always pass in dim z launching grid size in
         u32View[podArgIndices.length] = packDimX;
-        this.device.queue.writeBuffer(podArgBuffer, 0, i32View.buffer);
 
-        bindGroupEntries.push({
-          binding: bufferArgIndices.length,
-          resource: {
-            buffer: podArgBuffer,
-            size: i32View.buffer.byteLength
+        if (bindGroupCacheEpoch != this.bindGroupCacheEpoch ||
+          bindGroupCache.size >= this.maxNumCachedBindGroups) {
+          bindGroupCache.clear();
+          bindGroupCacheEpoch = this.bindGroupCacheEpoch;
+        }
+        const bindGroupKey = bufferArgIndices.map((i) => args[i]).join(",");
+        let bindGroup = bindGroupCache.get(bindGroupKey);
+        if (bindGroup === undefined) {
+          const bindGroupEntries: Array<GPUBindGroupEntry> = [];
+          for (let i = 0; i < bufferArgIndices.length; ++i) {
+            bindGroupEntries.push({
+              binding: i,
+              resource: {
+                buffer: this.gpuBufferFromPtr(args[bufferArgIndices[i]])
+              }
+            });
           }
-        });
-
-        compute.setBindGroup(0, this.device.createBindGroup({
-          layout: bindGroupLayout,
-          entries: bindGroupEntries
-        }));
+          bindGroupEntries.push({
+            binding: bufferArgIndices.length,
+            resource: {
+              buffer: this.podArgsBuffer as GPUBuffer,
+              size: podArgsNBytes
+            }
+          });
+          bindGroup = this.device.createBindGroup({
+            layout: bindGroupLayout,
+            entries: bindGroupEntries
+          });
+          bindGroupCache.set(bindGroupKey, bindGroup);
+        }
 
-        compute.dispatchWorkgroups(workDim[0], workDim[1], workDim[2])
-        compute.end()
-        const command = commandEncoder.finish();
-        this.device.queue.submit([command]);
+        const compute = this.getPendingComputePass();
+        compute.setPipeline(pipeline);
+        compute.setBindGroup(0, bindGroup, [podArgsOffset]);
+        compute.dispatchWorkgroups(workDim[0], workDim[1], workDim[2]);
 
         if (this.debugLogFinish) {
+          this.flushPendingCommands();
           const currCounter = this.shaderSubmitCounter;
           this.device.queue.onSubmittedWorkDone().then(() => {
             console.log("[" + currCounter + "][Debug] finish shader" + finfo.name);
@@ -833,12 +893,18 @@ export class WebGPUContext {
     if (nbytes == 0) {
       nbytes = 1;
     }
-    const buffer = tryCreateBuffer(this.device, {
-      size: nbytes,
-      usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST,
-    });
-    this.currAllocatedBytes += nbytes;
-    this.allAllocatedBytes += nbytes;
+    const allocSize = this.bufferPoolSizeClass(nbytes);
+    let buffer = this.bufferPool.get(allocSize)?.pop();
+    if (buffer !== undefined) {
+      this.pooledBytes -= allocSize;
+    } else {
+      buffer = tryCreateBuffer(this.device, {
+        size: allocSize,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST,
+      });
+    }
+    this.currAllocatedBytes += allocSize;
+    this.allAllocatedBytes += allocSize;
     if (this.currAllocatedBytes > this.peakAllocatedBytes) {
       this.peakAllocatedBytes = this.currAllocatedBytes;
     }
@@ -853,7 +919,40 @@ export class WebGPUContext {
     assert(buffer !== undefined);
     this.bufferTableFreeId.push(idx);
     this.currAllocatedBytes -= buffer.size;
-    buffer.destroy();
+    // the pointer may be reused for another buffer
+    this.bindGroupCacheEpoch += 1;
+    if (this.pooledBytes + buffer.size <= this.maxPooledBytes) {
+      // keep the buffer for reuse, the pending commands that use it are submitted before it is
+      // written again
+      let buffers = this.bufferPool.get(buffer.size);
+      if (buffers === undefined) {
+        buffers = [];
+        this.bufferPool.set(buffer.size, buffers);
+      }
+      buffers.push(buffer);
+      this.pooledBytes += buffer.size;
+    } else {
+      this.flushPendingCommands();
+      buffer.destroy();
+    }
+  }
+
+  /**
+   * The size of the buffers allocated for a request, so that freed buffers can be reused.
+   * Small requests are rounded up to powers of two, and large ones to multiples of 1MB.
+   * @param nbytes The requested size.
+   * @returns The allocation size.
+   */
+  private bufferPoolSizeClass(nbytes: number): number {
+    const largeSizeUnit = 1 << 20;
+    if (nbytes >= largeSizeUnit) {
+      return Math.ceil(nbytes / largeSizeUnit) * largeSizeUnit;
+    }
+    let size = 256;
+    while (size < nbytes) {
+      size *= 2;
+    }
+    return size;
   }
 
   private deviceCopyToGPU(
@@ -862,6 +961,7 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
+    this.flushPendingCommands();
     // Perhaps it would be more useful to use a staging buffer?
     let rawBytes = this.memory.loadRawBytes(from, nbytes);
     if (rawBytes.length % 4 !== 0) {
@@ -886,6 +986,7 @@ export class WebGPUContext {
     to: Pointer,
     nbytes: number
   ): void {
+    this.flushPendingCommands();
     // Perhaps it would be more useful to resuse a staging buffer?
     const gpuTemp = tryCreateBuffer(this.device, {
       size: nbytes,
@@ -917,6 +1018,7 @@ export class WebGPUContext {
     toOffset: number,
     nbytes: number
   ): void {
+    this.flushPendingCommands();
     const copyEncoder = this.device.createCommandEncoder();
     copyEncoder.copyBufferToBuffer(
       this.gpuBufferFromPtr(from),